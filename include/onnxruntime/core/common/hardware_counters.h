@@ -0,0 +1,68 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "core/common/status.h"
+
+namespace onnxruntime {
+namespace profiling {
+
+/*
+Hardware performance counters the profiler can record around each kernel and around the tasks the thread pool
+runs for the kernel, see kOrtSessionOptionsConfigProfilingHardwareCounters.
+*/
+enum HardwareCounter {
+  HW_CPU_CYCLES = 0,
+  HW_INSTRUCTIONS,
+  HW_CACHE_REFERENCES,
+  HW_CACHE_MISSES,
+  HW_BRANCH_MISSES,
+  HW_COUNTER_MAX
+};
+
+// Names of the above counters, as used in the session config entry and in the profile.
+static constexpr const char* hardware_counter_names_[HW_COUNTER_MAX] = {
+    "cycles",
+    "instructions",
+    "cache_references",
+    "cache_misses",
+    "branch_misses"};
+
+// Bit i is set if HardwareCounter i is enabled.
+using HardwareCounterMask = uint32_t;
+
+// Counter values indexed by HardwareCounter.
+using HardwareCounterValues = std::array<uint64_t, HW_COUNTER_MAX>;
+
+/*
+Parses a comma separated list of counter names, e.g. "cycles,instructions,cache_misses".
+*/
+Status ParseHardwareCounters(const std::string& names, HardwareCounterMask& mask);
+
+/*
+Reads the counters in `mask` for the calling thread. The counters of a thread are opened on first use.
+Returns the counters that were read; counters the platform or its permissions do not provide are left out.
+Linux reads all counters via perf_event, Windows only reads the cycle count of the thread.
+*/
+HardwareCounterMask ReadHardwareCounters(HardwareCounterMask mask, HardwareCounterValues& values);
+
+/*
+Adds the counts between `begin` and `end` to `sum`.
+*/
+void AccumulateHardwareCounters(const HardwareCounterValues& begin, const HardwareCounterValues& end,
+                                HardwareCounterValues& sum);
+
+/*
+Formats the counters in `mask` as a JSON object, with the derived instructions per cycle, cache miss rate and,
+if `duration_us` is positive, the memory bandwidth estimated from the cache misses.
+*/
+std::string HardwareCountersToJson(HardwareCounterMask mask, const HardwareCounterValues& counts,
+                                   long long duration_us = 0);
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "core/common/common.h"
@@ -33,6 +36,8 @@ class ORTInvoker {
     }
   }
 
+  ~ORTInvoker();
+
   IExecutionProvider& GetCurrentExecutionProvider() {
     return *execution_provider_;
   }
@@ -46,11 +51,27 @@ class ORTInvoker {
                         const int version = -1);
 
  private:
+  // The single node graph and kernel of an op, reused by the Invoke calls with the same op, attributes and input
+  // types.
+  struct CachedKernel;
+
+  // Returns the cached kernel for the op, creating it on the first call.
+  common::Status GetOrCreateKernel(const std::string& op_name,
+                                   const std::vector<OrtValue>& inputs,
+                                   size_t num_outputs,
+                                   const NodeAttributes* attributes,
+                                   const std::string& domain,
+                                   const int version,
+                                   CachedKernel*& cached_kernel);
+
   std::shared_ptr<IExecutionProvider> execution_provider_;
   const logging::Logger& logger_;
   // custom ops for current execution provider
   // we need the op schema to resolve the output type during invoke
   const IOnnxRuntimeOpSchemaRegistryList& custom_op_registries_;
+
+  std::mutex kernel_cache_mutex_;
+  std::unordered_map<std::string, std::unique_ptr<CachedKernel>> kernel_cache_;
 };
 
 #ifdef __GNUC__
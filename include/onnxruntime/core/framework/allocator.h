@@ -20,16 +20,23 @@ struct OrtArenaCfg {
                   initial_chunk_size_bytes(-1),
                   max_dead_bytes_per_chunk(-1),
                   initial_growth_chunk_size_bytes(-1),
-                  max_power_of_two_extend_bytes(-1) {}
+                  max_power_of_two_extend_bytes(-1),
+                  thread_cache_max_chunk_bytes(-1),
+                  use_cuda_mempool(-1),
+                  cuda_mempool_release_threshold(-1) {}
   OrtArenaCfg(size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes,
               int max_dead_bytes_per_chunk, int initial_growth_chunk_size_bytes,
-              int64_t max_power_of_two_extend_bytes)
+              int64_t max_power_of_two_extend_bytes, int thread_cache_max_chunk_bytes = -1,
+              int use_cuda_mempool = -1, int64_t cuda_mempool_release_threshold = -1)
       : max_mem(max_mem),
         arena_extend_strategy(arena_extend_strategy),
         initial_chunk_size_bytes(initial_chunk_size_bytes),
         max_dead_bytes_per_chunk(max_dead_bytes_per_chunk),
         initial_growth_chunk_size_bytes(initial_growth_chunk_size_bytes),
-        max_power_of_two_extend_bytes(max_power_of_two_extend_bytes) {}
+        max_power_of_two_extend_bytes(max_power_of_two_extend_bytes),
+        thread_cache_max_chunk_bytes(thread_cache_max_chunk_bytes),
+        use_cuda_mempool(use_cuda_mempool),
+        cuda_mempool_release_threshold(cuda_mempool_release_threshold) {}
 
   size_t max_mem;                         // use 0 to allow ORT to choose the default
   int arena_extend_strategy;              // use -1 to allow ORT to choose the default, 0 = kNextPowerOfTwo, 1 = kSameAsRequested
@@ -37,6 +44,9 @@ struct OrtArenaCfg {
   int max_dead_bytes_per_chunk;           // use -1 to allow ORT to choose the default
   int initial_growth_chunk_size_bytes;    // use -1 to allow ORT to choose the default
   int64_t max_power_of_two_extend_bytes;  // use -1 to allow ORT to choose the default
+  int thread_cache_max_chunk_bytes;       // use -1 to allow ORT to choose the default, 0 disables the thread caches
+  int use_cuda_mempool;                   // use -1 to allow ORT to choose the default, 1 = CUDA stream ordered memory pool instead of the arena
+  int64_t cuda_mempool_release_threshold;  // use -1 to allow ORT to choose the default, bytes the CUDA memory pool keeps when trimmed on synchronization
 };
 
 namespace onnxruntime {
@@ -93,6 +103,17 @@ class IAllocator {
   // Each implementation of IAllocator can override and provide their own implementation
   virtual void GetStats(AllocatorStats* /*stats*/) { return; }
 
+  // Returns true if the implementation orders its allocations on the stream they are made on, see AllocStreamOrdered().
+  virtual bool IsStreamOrdered() const { return false; }
+
+  // Allocates memory that the work submitted to `stream` after the call may use. The memory is released in the order
+  // of `stream` when it is freed, so it doesn't wait for the work of other streams.
+  // Called instead of Alloc() when IsStreamOrdered() returns true and the allocation has a stream.
+  virtual void* AllocStreamOrdered(size_t size, Stream* /*stream*/) { return Alloc(size); }
+
+  // Returns the memory cached by the implementation that is not in use to the system.
+  virtual Status Shrink() { return Status::OK(); }
+
   static bool CalcMemSizeForArray(size_t nmemb, size_t size, size_t* out) noexcept {
     return CalcMemSizeForArrayWithAlignment(nmemb, size, 0, out);
   }
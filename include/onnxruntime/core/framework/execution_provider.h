@@ -218,6 +218,14 @@ class IExecutionProvider {
     return Status::OK();
   }
 
+  /**
+     Destroy the instantiated graph of `graph_annotation_id`, so that a later Run with the same annotation id
+     captures it again.
+   */
+  virtual common::Status ReleaseGraph(int /*graph_annotation_id*/) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Releasing a captured graph is not supported by ", type_);
+  }
+
   /**
      Called when session creation is complete
      This provides an opportunity for execution providers to optionally synchronize and
@@ -68,6 +68,10 @@ class KernelDef {
     return variadic_alias_offsets_;
   }
 
+  const std::optional<int>& MayOutputView() const {
+    return output_view_input_;
+  }
+
   OrtMemType InputMemoryType(size_t input_index) const {
     auto it = input_memory_type_args_.find(input_index);
     if (it == input_memory_type_args_.end())
@@ -135,6 +139,9 @@ class KernelDef {
   // output 'i + output_offset' is an alias of input 'i + input_offset' for all i >= 0
   std::optional<std::pair<int, int>> variadic_alias_offsets_;
 
+  // If set, any output may be a view of a contiguous range of this input.
+  std::optional<int> output_view_input_;
+
   // Require input tensors to be allocated contiguously.
   bool allocate_inputs_contiguously_ = false;
 
@@ -240,6 +247,13 @@ class KernelDefBuilder {
   */
   KernelDefBuilder& VariadicAlias(int input_offset, int output_offset);
 
+  /**
+     Specify that the outputs of this kernel may be views of a contiguous range of the
+     input_index-th input, such as the outputs of Split. The kernel requests a view with
+     OpKernelContext::OutputView and must fall back to Output if none is available.
+  */
+  KernelDefBuilder& MayOutputView(int input_index);
+
   /**
      Specify that this kernel requires input tensors to be allocated
      contiguously. This allows kernels to execute as a single large
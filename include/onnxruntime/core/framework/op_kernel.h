@@ -129,6 +129,15 @@ class OpKernel {
     return Status::OK();
   }
 
+  // Override this function to return true if UseSharedPrePackedBuffers() alone fully restores the kernel's
+  // pre-packed state for the provided input index, without a prior call to PrePack().
+  // The pre-packed weights file cache only serves kernels that return true, and the buffers it provides are
+  // read-only views into a file mapping shared with other processes, so the kernel must not write to them.
+  // @param input_idx: The input index of the tensor in this kernel
+  virtual bool CanRestorePrePackedWeightsFromBuffers(int /*input_idx*/) const {
+    return false;
+  }
+
   const OrtDevice GetDevice(OrtMemType mem_type) const;
   const OpKernelInfo& Info() const {
     return *op_kernel_info_;
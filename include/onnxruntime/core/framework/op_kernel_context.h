@@ -75,6 +75,11 @@ class OpKernelContext {
     return *output_ptr;
   }
 
+  // Create the output as a view of 'input' starting at byte_offset instead of allocating it.
+  // This is only possible if the kernel declared the input with KernelDefBuilder::MayOutputView and the allocation
+  // planner made the output a view. Return nullptr otherwise, and the kernel must use Output instead.
+  Tensor* OutputView(int index, const TensorShape& shape, const Tensor& input, size_t byte_offset);
+
 #if !defined(DISABLE_SPARSE_TENSORS)
   // Fetch a sparse-tensor output corresponding to the specified index.
   // shape must specify the shape of the underlying dense-tensor.
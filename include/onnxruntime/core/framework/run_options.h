@@ -40,10 +40,32 @@ struct OrtRunOptions {
   // /include/onnxruntime/core/session/onnxruntime_run_options_config_keys.h
   onnxruntime::ConfigOptions config_options;
 
+  // Called by the GreedySearch and Sampling contrib ops after each generated token.
+  // See OrtApi::RunOptionsSetGenerationStepCallback.
+  OrtGenerationStepCallbackFn generation_step_callback = nullptr;
+  void* generation_step_callback_user_data = nullptr;
+
   OrtRunOptions() = default;
   ~OrtRunOptions() = default;
 };
 
 namespace onnxruntime {
 using RunOptions = ::OrtRunOptions;
+
+// Makes `run_options` the options of the Run executing in the current thread for the lifetime of the object, so the
+// kernels of the Run can read them with OpKernelContextInternal::GetRunOptions.
+class RunOptionsScope {
+ public:
+  explicit RunOptionsScope(const RunOptions* run_options);
+  ~RunOptionsScope();
+
+  RunOptionsScope(const RunOptionsScope&) = delete;
+  RunOptionsScope& operator=(const RunOptionsScope&) = delete;
+
+  // Returns the options of the Run executing in the current thread, nullptr if there is none.
+  static const RunOptions* Current();
+
+ private:
+  const RunOptions* previous_run_options_;
+};
 }  // namespace onnxruntime
@@ -51,6 +51,7 @@ namespace fbs {
 struct Graph;
 struct Node;
 struct NodeEdge;
+enum class TensorDataCompression : int8_t;
 }  // namespace fbs
 
 /**
@@ -1349,8 +1350,14 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
     return outer_scope_node_arg_names_;
   }
 
+  /** Save this Graph to an ORT format flatbuffer.
+  @param initializer_compression Compression to apply to the initializers of this Graph.
+                                 Value-initialized to TensorDataCompression::NONE.
+  */
   common::Status SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
-                                 flatbuffers::Offset<onnxruntime::fbs::Graph>& fbs_graph) const;
+                                 flatbuffers::Offset<onnxruntime::fbs::Graph>& fbs_graph,
+                                 onnxruntime::fbs::TensorDataCompression initializer_compression =
+                                     onnxruntime::fbs::TensorDataCompression{}) const;
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
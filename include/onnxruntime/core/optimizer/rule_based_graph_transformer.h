@@ -75,7 +75,12 @@ class RuleBasedGraphTransformer : public GraphTransformer {
   // Rules that will be evaluated regardless of the op type of the node.
   InlinedVector<std::reference_wrapper<const RewriteRule>> any_op_type_rules_;
 
-  // Performs a single top-down traversal of the graph and applies all registered rules.
+  // Applies the rules registered for the op type of the node, then the rules registered for any op type.
+  common::Status ApplyAllRulesOnNode(Graph& graph, Node& node, RuleEffect& rule_effect,
+                                     const logging::Logger& logger) const;
+
+  // Performs a top-down traversal of the graph and applies all registered rules, then revisits the nodes next to
+  // the rewrites until no rule applies to them.
   common::Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
@@ -39,7 +39,10 @@
 #pragma warning(disable : 4127)
 #pragma warning(disable : 4805)
 #endif
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <vector>
 #include "unsupported/Eigen/CXX11/ThreadPool"
 
 #if defined(__GNUC__)
@@ -48,10 +51,10 @@
 #pragma warning(pop)
 #endif
 #include "core/common/denormal.h"
+#include "core/common/hardware_counters.h"
 #include "core/common/inlined_containers_fwd.h"
 #include "core/common/spin_pause.h"
 #include "core/platform/ort_mutex.h"
-#include "core/platform/ort_spin_lock.h"
 #include "core/platform/Barrier.h"
 
 // ORT thread pool overview
@@ -78,6 +81,11 @@
 //
 //   This spin-then-block behavior is configured via a flag provided
 //   when creating the thread pool, and by the constant spin_count.
+//   Alternatively the spinning can be bounded in time
+//   (ThreadOptions::spin_duration_us), and a parallel section may
+//   request its own spin duration for the workers that ran its tasks,
+//   e.g. a short one when no further work is expected soon, or a long
+//   one when the next section follows shortly.
 //
 // - Although all tasks are simple void()->void functions,
 //   conceptually there are three different kinds:
@@ -152,6 +160,16 @@
 //   active threads over time (when the entire pool is not needed),
 //   and to allow concurrent requests to submit works to their own
 //   respective sets of preferred workers.
+//
+// - Optionally, the workers can be grouped by NUMA node
+//   (ThreadOptions::numa_aware_scheduling).  The grouping is derived
+//   from the workers' affinities.  When enabled, the initial
+//   preferred workers are handed out node by node, wake-ups and
+//   Schedule() stay within the node of the thread concerned, and
+//   work stealing tries victims on the thief's own node before
+//   falling back to the rest of the pool.  This keeps the shards of
+//   one loop, and the data they touch, on a single socket where the
+//   degree of parallelism allows it.
 
 namespace onnxruntime {
 namespace concurrency {
@@ -222,7 +240,7 @@ class ThreadPoolProfiler {
   ThreadPoolProfiler(int, const CHAR_TYPE*){};
   ~ThreadPoolProfiler() = default;
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ThreadPoolProfiler);
-  void Start(){};
+  void Start(profiling::HardwareCounterMask = 0){};
   std::string Stop() { return "not available for minimal build"; }
   void LogStart(){};
   void LogEnd(ThreadPoolEvent){};
@@ -230,6 +248,7 @@ class ThreadPoolProfiler {
   void LogStartAndCoreAndBlock(std::ptrdiff_t){};
   void LogCoreAndBlock(std::ptrdiff_t){};
   void LogThreadId(int){};
+  void LogRunStart(int){};
   void LogRun(int){};
   std::string DumpChildThreadStat() { return {}; }
 };
@@ -248,7 +267,7 @@ class ThreadPoolProfiler {
   ~ThreadPoolProfiler();
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ThreadPoolProfiler);
   using Clock = std::chrono::high_resolution_clock;
-  void Start();                  // called by executor to start profiling
+  void Start(profiling::HardwareCounterMask hardware_counters = 0);  // called by executor to start profiling
   std::string Stop();            // called by executor to stop profiling and return collected numbers
   void LogStart();               // called in main thread to record the starting time point
   void LogEnd(ThreadPoolEvent);  // called in main thread to calculate and save the time elapsed from last start point
@@ -256,6 +275,7 @@ class ThreadPoolProfiler {
   void LogStartAndCoreAndBlock(std::ptrdiff_t block_size);
   void LogCoreAndBlock(std::ptrdiff_t block_size);  // called in main thread to log core and block size for task breakdown
   void LogThreadId(int thread_idx);                 // called in child thread to log its id
+  void LogRunStart(int thread_idx);                 // called in child thread before a run
   void LogRun(int thread_idx);                      // called in child thread to log num of run
   std::string DumpChildThreadStat();                // return all child statitics collected so far
 
@@ -274,6 +294,7 @@ class ThreadPoolProfiler {
     std::string Reset();
   };
   bool enabled_ = false;
+  profiling::HardwareCounterMask hardware_counters_ = 0;
   MainThreadStat& GetMainThreadStat();  // return thread local stat
   int num_threads_;
 #ifdef _MSC_VER
@@ -286,6 +307,10 @@ class ThreadPoolProfiler {
     uint64_t num_run_ = 0;
     onnxruntime::TimePoint last_logged_point_ = Clock::now();
     int32_t core_ = -1;  // core that the child thread is running on
+    // hardware counters read before the current run and summed over the runs since the last dump
+    profiling::HardwareCounterMask hardware_counters_read_ = 0;
+    profiling::HardwareCounterValues hardware_counters_begin_{};
+    profiling::HardwareCounterValues hardware_counters_sum_{};
   };
 #ifdef _MSC_VER
 #pragma warning(pop)
@@ -337,7 +362,7 @@ class ExtendedThreadPoolInterface : public Eigen::ThreadPoolInterface {
   // two loops execute in series in a parallel section. ]
   virtual void RunInParallel(std::function<void(unsigned idx)> fn,
                              unsigned n, std::ptrdiff_t block_size) = 0;
-  virtual void StartProfiling() = 0;
+  virtual void StartProfiling(profiling::HardwareCounterMask hardware_counters) = 0;
   virtual std::string StopProfiling() = 0;
 };
 
@@ -365,6 +390,10 @@ class ThreadPoolParallelSection {
   // Flag to signal termination of the parallel section
   std::atomic<bool> active{false};
 
+  // Duration in microseconds the workers that ran tasks of the section spin for
+  // more work once they complete them, -1 to use the setting of the pool.
+  int spin_duration_us{-1};
+
   // Count of the number of tasks that completed normally.  Other
   // tasks may be running currently, or may be present in work queues,
   // or may have been removed from the queues by
@@ -457,22 +486,22 @@ class RunQueue {
   // PushBack adds w at the end of the queue.
   // If queue is full returns w, otherwise returns default-constructed Work.
   Work PushBack(Work w) {
-#ifdef USE_LOCK_FREE_QUEUE
-    std::lock_guard<OrtSpinLock> mtx(spin_lock_);
-#else
+#ifndef USE_LOCK_FREE_QUEUE
     std::lock_guard<OrtMutex> lock(mutex_);
 #endif
-    unsigned back = back_.load(std::memory_order_relaxed);
-    Elem& e = array_[(back - 1) & kMask];
-    ElemState s = e.state.load(std::memory_order_relaxed);
-    if (s != ElemState::kEmpty ||
-        !e.state.compare_exchange_strong(s, ElemState::kBusy, std::memory_order_acquire))
-      return w;
-    back = ((back - 1) & kMask2) | (back & ~kMask2);
-    back_.store(back, std::memory_order_relaxed);
-    e.w = std::move(w);
-    e.tag = Tag();
-    e.state.store(ElemState::kReady, std::memory_order_release);
+    unsigned back;
+    Elem* e;
+    do {
+      back = back_.load(std::memory_order_relaxed);
+      e = &array_[(back - 1) & kMask];
+      ElemState s = e->state.load(std::memory_order_relaxed);
+      if (s != ElemState::kEmpty ||
+          !e->state.compare_exchange_strong(s, ElemState::kBusy, std::memory_order_acquire))
+        return w;
+    } while (!MoveBackForPush(back, *e));
+    e->w = std::move(w);
+    e->tag = Tag();
+    e->state.store(ElemState::kReady, std::memory_order_release);
     return Work();
   }
 
@@ -481,24 +510,24 @@ class RunQueue {
   // with w_idx.  Typically the tag will be a per-thread ID to distinguish work
   // submitted from different threads.
   PushResult PushBackWithTag(Work w, Tag tag, unsigned& w_idx) {
-#ifdef USE_LOCK_FREE_QUEUE
-    std::lock_guard<OrtSpinLock> mtx(spin_lock_);
-#else
+#ifndef USE_LOCK_FREE_QUEUE
     std::lock_guard<OrtMutex> lock(mutex_);
 #endif
-    unsigned back = back_.load(std::memory_order_relaxed);
-    w_idx = (back - 1) & kMask;
-    Elem& e = array_[w_idx];
-    ElemState s = e.state.load(std::memory_order_relaxed);
-    if (s != ElemState::kEmpty ||
-        !e.state.compare_exchange_strong(s, ElemState::kBusy, std::memory_order_acquire))
-      return PushResult::REJECTED; /* Not enqueued */
+    unsigned back;
+    Elem* e;
+    do {
+      back = back_.load(std::memory_order_relaxed);
+      w_idx = (back - 1) & kMask;
+      e = &array_[w_idx];
+      ElemState s = e->state.load(std::memory_order_relaxed);
+      if (s != ElemState::kEmpty ||
+          !e->state.compare_exchange_strong(s, ElemState::kBusy, std::memory_order_acquire))
+        return PushResult::REJECTED; /* Not enqueued */
+    } while (!MoveBackForPush(back, *e));
     bool was_ready = (((back ^ (front_.load(std::memory_order_relaxed))) & kMask) == 0);
-    back = ((back - 1) & kMask2) | (back & ~kMask2);
-    back_.store(back, std::memory_order_relaxed);
-    e.w = std::move(w);
-    e.tag = tag;
-    e.state.store(ElemState::kReady, std::memory_order_release);
+    e->w = std::move(w);
+    e->tag = tag;
+    e->state.store(ElemState::kReady, std::memory_order_release);
     return was_ready ? PushResult::ACCEPTED_IDLE : PushResult::ACCEPTED_BUSY; /* Enqueued */
   }
 
@@ -506,9 +535,7 @@ class RunQueue {
   Work PopBack() {
     if (Empty())
       return Work();
-#ifdef USE_LOCK_FREE_QUEUE
-    std::lock_guard<OrtSpinLock> mtx(spin_lock_);
-#else
+#ifndef USE_LOCK_FREE_QUEUE
     std::lock_guard<OrtMutex> lock(mutex_);
 #endif
     unsigned back;
@@ -523,8 +550,7 @@ class RunQueue {
       s = e->state.load(std::memory_order_relaxed);
       if (s == ElemState::kRevoked &&
           e->state.compare_exchange_strong(s, ElemState::kBusy, std::memory_order_acquire)) {
-        e->state.store(ElemState::kEmpty, std::memory_order_release);
-        back_.store(back + 1 + (kSize << 1), std::memory_order_relaxed);
+        MoveBackForPop(back, *e);
       }
     } while (s == ElemState::kRevoked);
 
@@ -533,8 +559,7 @@ class RunQueue {
       return Work();
     Work w = std::move(e->w);
     e->tag = Tag();
-    e->state.store(ElemState::kEmpty, std::memory_order_release);
-    back_.store(back + 1 + (kSize << 1), std::memory_order_relaxed);
+    MoveBackForPop(back, *e);
     return w;
   }
 
@@ -552,38 +577,30 @@ class RunQueue {
 
   bool RevokeWithTag(Tag tag, unsigned w_idx) {
     bool revoked = false;
-#ifdef USE_LOCK_FREE_QUEUE
-    std::lock_guard<OrtSpinLock> mtx(spin_lock_);
-#else
+#ifndef USE_LOCK_FREE_QUEUE
     std::lock_guard<OrtMutex> lock(mutex_);
 #endif
     Elem& e = array_[w_idx];
     ElemState s = e.state.load(std::memory_order_relaxed);
 
-    // We have acquired a lock on the queue, synchronizing with
-    // operations aside from the PopFront fast-path.  Synchronize with
-    // that by attempting the same kReady->kBusy transition via CAS.
+    // Synchronize with the other operations on the item by attempting
+    // the same kReady->kBusy transition via CAS.
 
     if (s == ElemState::kReady &&
         e.state.compare_exchange_strong(s, ElemState::kBusy, std::memory_order_acquire)) {
       if (e.tag == tag) {
         unsigned back = back_.load(std::memory_order_relaxed);
-        unsigned back_idx = back & kMask;
-        if (back_idx != w_idx) {
+        e.tag = Tag();
+        e.w = Work();
+        if ((back & kMask) != w_idx) {
           // Item is not at the back of the queue, mark it in-place as revoked
-          e.tag = Tag();
-          e.w = Work();
           e.state.store(ElemState::kRevoked, std::memory_order_release);
-          revoked = true;
         } else {
           // Item being removed as still at the back; shift the back pointer over it,
           // and bump the version number.
-          e.tag = Tag();
-          e.w = Work();
-          e.state.store(ElemState::kEmpty, std::memory_order_release);
-          back_.store(back + 1 + (kSize << 1), std::memory_order_relaxed);
-          revoked = true;
+          MoveBackForPop(back, e);
         }
+        revoked = true;
       } else {
         // Tag mismatch, i.e. work queue slot re-used
         e.state.store(ElemState::kReady, std::memory_order_release);
@@ -628,9 +645,10 @@ class RunQueue {
     Work w;
   };
 
-#ifdef USE_LOCK_FREE_QUEUE
-  OrtSpinLock spin_lock_;
-#else
+  // Operations at the back of the queue may be called from any thread.  By default they are
+  // serialized by mutex_; with USE_LOCK_FREE_QUEUE they update back_ with CAS instead, see
+  // MoveBackForPush and MoveBackForPop.  Either way the owner's operations at the front stay lock-free.
+#ifndef USE_LOCK_FREE_QUEUE
   OrtMutex mutex_;
 #endif
 
@@ -645,6 +663,29 @@ class RunQueue {
   ORT_ALIGN_TO_AVOID_FALSE_SHARING std::atomic<unsigned> back_;
   ORT_ALIGN_TO_AVOID_FALSE_SHARING Elem array_[kSize];
 
+  // Moves the back of the queue over the element e before it, after claiming e (kBusy) for a push at
+  // position back.  Returns false if another thread moved the back since it was read as back, in
+  // which case e is released and the caller retries at the new back.
+  bool MoveBackForPush(unsigned back, Elem& e) {
+    if (back_.compare_exchange_strong(back, ((back - 1) & kMask2) | (back & ~kMask2), std::memory_order_relaxed)) {
+      return true;
+    }
+    e.state.store(ElemState::kEmpty, std::memory_order_release);
+    return false;
+  }
+
+  // Moves the back of the queue past the element e at position back, after taking its work (kBusy),
+  // and bumps the version number.  If an item was pushed behind e since back was read, e is no longer
+  // at the back of the queue and is left revoked in place, to be drained like items revoked by
+  // RevokeWithTag.
+  void MoveBackForPop(unsigned back, Elem& e) {
+    if (back_.compare_exchange_strong(back, back + 1 + (kSize << 1), std::memory_order_relaxed)) {
+      e.state.store(ElemState::kEmpty, std::memory_order_release);
+    } else {
+      e.state.store(ElemState::kRevoked, std::memory_order_release);
+    }
+  }
+
   // SizeOrNotEmpty returns current queue size; if NeedSizeEstimate is false,
   // only whether the size is 0 is guaranteed to be correct.
   // Can be called by any thread at any time.
@@ -722,8 +763,8 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   }
 
  public:
-  void StartProfiling() override {
-    profiler_.Start();
+  void StartProfiling(profiling::HardwareCounterMask hardware_counters) override {
+    profiler_.Start(hardware_counters);
   }
 
   std::string StopProfiling() override {
@@ -774,6 +815,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         num_threads_(num_threads),
         allow_spinning_(allow_spinning),
         set_denormal_as_zero_(thread_options.set_denormal_as_zero),
+        spin_duration_us_(thread_options.spin_duration_us),
         worker_data_(num_threads),
         all_coprimes_(num_threads),
         blocked_(0),
@@ -790,6 +832,10 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       ComputeCoprimes(i, &all_coprimes_.back());
     }
 
+    if (thread_options.numa_aware_scheduling) {
+      InitializeNumaTopology(thread_options);
+    }
+
     // Eigen::MaxSizeVector has neither essential exception safety features
     // such as swap, nor it is movable. So we have to join threads right here
     // on exception
@@ -818,7 +864,10 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
 
   void Schedule(std::function<void()> fn) override {
     PerThread* pt = GetPerThread();
-    int q_idx = Rand(&pt->rand) % num_threads_;
+    // Work scheduled from one of our own workers stays on that worker's NUMA node
+    unsigned q_idx = (numa_aware_ && pt->pool == this)
+                         ? RandomWorkerOnNodeOf(*pt, static_cast<unsigned>(pt->thread_id))
+                         : Rand(&pt->rand) % num_threads_;
     WorkerData& td = worker_data_[q_idx];
     Queue& q = td.queue;
     fn = q.PushBack(std::move(fn));
@@ -1065,8 +1114,13 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
 
     // preferred_workers maps from a par_idx to a q_idx, hence we
     // initialize slots in the range [0,num_threads_]
+    //
+    // With NUMA-aware scheduling the round-robin walks the workers
+    // node by node, so that consecutive par_idx values (and hence the
+    // workers of a loop narrower than the pool) share a node.
     while (preferred_workers.size() <= num_threads_) {
-      preferred_workers.push_back(next_worker++ % num_threads_);
+      unsigned w = next_worker++ % num_threads_;
+      preferred_workers.push_back(numa_aware_ ? numa_ordered_workers_[w] : w);
     }
   }
 
@@ -1104,6 +1158,8 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         // Record the worker thread that actually runs this task.
         // This will form the preferred worker for the next loop.
         UpdatePreferredWorker(preferred_workers, par_idx);
+        // ps may be deallocated once the task is counted as finished.
+        GetPerThread()->section_spin_duration_us = ps.spin_duration_us;
         worker_fn(par_idx);
         ps.tasks_finished++;
       },
@@ -1116,7 +1172,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         ps.tasks.push_back({q_idx, w_idx});
         td.EnsureAwake();
         if (push_status == PushResult::ACCEPTED_BUSY) {
-          worker_data_[Rand(&pt.rand) % num_threads_].EnsureAwake();
+          worker_data_[RandomWorkerOnNodeOf(pt, q_idx)].EnsureAwake();
         }
       }
     }
@@ -1190,6 +1246,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
           // revokes a task, and then sees dispatch_started=true, then
           // it knows it revoked a worker task. ]
           ps.dispatch_started.store(true, std::memory_order_seq_cst);
+          GetPerThread()->section_spin_duration_us = ps.spin_duration_us;
 
           // Schedule tasks par_idx=[current_dop+1,new_dop)
           ScheduleOnPreferredWorkers(pt, ps, preferred_workers, current_dop + 1, new_dop, worker_fn);
@@ -1219,7 +1276,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         if (push_status == PushResult::ACCEPTED_IDLE || push_status == PushResult::ACCEPTED_BUSY) {
           dispatch_td.EnsureAwake();
           if (push_status == PushResult::ACCEPTED_BUSY) {
-            worker_data_[Rand(&pt.rand) % num_threads_].EnsureAwake();
+            worker_data_[RandomWorkerOnNodeOf(pt, static_cast<unsigned>(ps.dispatch_q_idx))].EnsureAwake();
           }
         } else {
           ps.dispatch_q_idx = -1;  // failed to enqueue dispatch_task
@@ -1324,6 +1381,22 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     return -1;
   }
 
+  // OS ids of the NUMA nodes the workers span, empty unless NUMA-aware
+  // scheduling is enabled and the workers span more than one node.
+  const std::vector<int>& NumaNodes() const {
+    return numa_os_nodes_;
+  }
+
+  // Index in NumaNodes() of the node of the calling thread, -1 if it is
+  // not a worker of this pool or NUMA-aware scheduling is not in use.
+  int CurrentThreadNumaNode() const {
+    if (!numa_aware_) {
+      return -1;
+    }
+    const int thread_id = CurrentThreadId();
+    return thread_id < 0 ? -1 : static_cast<int>(numa_node_of_worker_[thread_id]);
+  }
+
   void EnableSpinning() {
     spin_loop_status_ = SpinLoopStatus::kBusy;
   }
@@ -1376,6 +1449,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     int thread_id{-1};                // Worker thread index in pool.
     Tag tag{};                        // Work item tag used to identify this thread.
     bool leading_par_section{false};  // Leading a parallel section (used only for asserts)
+    int section_spin_duration_us{-1};  // Spin duration requested by the section of the last task run, or -1
 
     // When this thread is entering a parallel section, it will
     // initially push work to this set of workers.  The aim is to
@@ -1493,6 +1567,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   const unsigned num_threads_;
   const bool allow_spinning_;
   const bool set_denormal_as_zero_;
+  const int spin_duration_us_;  // -1 to spin for spin_count iterations
   Eigen::MaxSizeVector<WorkerData> worker_data_;
   Eigen::MaxSizeVector<Eigen::MaxSizeVector<unsigned>> all_coprimes_;
   std::atomic<unsigned> blocked_;  // Count of blocked workers, used as a termination condition
@@ -1510,6 +1585,69 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   // Default is no control over spinning
   std::atomic<SpinLoopStatus> spin_loop_status_{SpinLoopStatus::kBusy};
 
+  // NUMA topology of the workers, populated only when NUMA-aware
+  // scheduling is enabled and the workers span more than one node.
+  // Node ids here are dense indices in [0, workers_by_numa_node_.size())
+  // rather than OS node numbers.
+  bool numa_aware_{false};
+  std::vector<unsigned> numa_node_of_worker_;                // q_idx -> node
+  std::vector<std::vector<unsigned>> workers_by_numa_node_;  // node -> q_idx values
+  std::vector<unsigned> numa_ordered_workers_;               // all q_idx values, grouped by node
+  std::vector<int> numa_os_nodes_;                           // node -> OS node id
+
+  // Determine the NUMA node of each worker from the first logical
+  // processor in its affinity.  NUMA-aware scheduling is left disabled
+  // if any worker has no affinity, the OS cannot report the node, or
+  // all workers turn out to share a single node.
+  void InitializeNumaTopology(const ThreadOptions& thread_options) {
+    if (thread_options.affinities.size() < num_threads_) {
+      return;
+    }
+    std::vector<int> os_nodes(num_threads_, -1);
+    for (unsigned i = 0; i < num_threads_; i++) {
+      const auto& affinity = thread_options.affinities[i];
+      if (affinity.empty()) {
+        return;
+      }
+      os_nodes[i] = env_.GetNumaNodeOfLogicalProcessor(affinity[0]);
+      if (os_nodes[i] < 0) {
+        return;
+      }
+    }
+
+    std::vector<int> distinct_nodes(os_nodes);
+    std::sort(distinct_nodes.begin(), distinct_nodes.end());
+    distinct_nodes.erase(std::unique(distinct_nodes.begin(), distinct_nodes.end()), distinct_nodes.end());
+    if (distinct_nodes.size() < 2) {
+      return;
+    }
+
+    numa_node_of_worker_.resize(num_threads_);
+    workers_by_numa_node_.resize(distinct_nodes.size());
+    for (unsigned i = 0; i < num_threads_; i++) {
+      auto node = static_cast<unsigned>(
+          std::lower_bound(distinct_nodes.begin(), distinct_nodes.end(), os_nodes[i]) - distinct_nodes.begin());
+      numa_node_of_worker_[i] = node;
+      workers_by_numa_node_[node].push_back(i);
+    }
+    numa_ordered_workers_.reserve(num_threads_);
+    for (const auto& node_workers : workers_by_numa_node_) {
+      numa_ordered_workers_.insert(numa_ordered_workers_.end(), node_workers.begin(), node_workers.end());
+    }
+    numa_os_nodes_ = std::move(distinct_nodes);
+    numa_aware_ = true;
+  }
+
+  // Pick a random worker to wake or push to.  With NUMA-aware
+  // scheduling the choice is restricted to the node of worker q_idx.
+  unsigned RandomWorkerOnNodeOf(PerThread& pt, unsigned q_idx) {
+    if (!numa_aware_) {
+      return Rand(&pt.rand) % num_threads_;
+    }
+    const auto& node_workers = workers_by_numa_node_[numa_node_of_worker_[q_idx]];
+    return node_workers[Rand(&pt.rand) % node_workers.size()];
+  }
+
   // Wake any blocked workers so that they can cleanly exit WorkerLoop().  For
   // a clean exit, each thread will observe (1) done_ set, indicating that the
   // destructor has been called, (2) all threads blocked, and (3) no
@@ -1534,7 +1672,9 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
 
     constexpr int log2_spin = 20;
     const int spin_count = allow_spinning_ ? (1ull << log2_spin) : 0;
-    const int steal_count = spin_count / 100;
+    const int steal_count = (1 << log2_spin) / 100;
+    // With a spin duration, the clock is read once every kSpinClockCheckInterval iterations.
+    constexpr int kSpinClockCheckInterval = 64;
 
     SetDenormalAsZero(set_denormal_as_zero_);
     profiler_.LogThreadId(thread_id);
@@ -1542,8 +1682,19 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     while (!should_exit) {
       Task t = q.PopFront();
       if (!t) {
-        // Spin waiting for work.
-        for (int i = 0; i < spin_count && !done_; i++) {
+        // Spin waiting for work, for spin_count iterations or for the spin duration if one is set.  The
+        // duration requested by the parallel section of the last task run by this thread takes precedence.
+        int spin_duration_us = pt->section_spin_duration_us >= 0 ? pt->section_spin_duration_us : spin_duration_us_;
+        pt->section_spin_duration_us = -1;
+        if (!allow_spinning_) {
+          spin_duration_us = -1;
+        }
+        const auto spin_end = std::chrono::steady_clock::now() + std::chrono::microseconds(spin_duration_us);
+        for (int i = 0; !done_; i++) {
+          if (spin_duration_us < 0 ? i >= spin_count
+                                   : (i % kSpinClockCheckInterval == 0 && std::chrono::steady_clock::now() >= spin_end)) {
+            break;
+          }
           if (((i + 1) % steal_count == 0)) {
             t = Steal(StealAttemptKind::TRY_ONE);
           } else {
@@ -1625,6 +1776,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
 
       if (t) {
         td.SetActive();
+        profiler_.LogRunStart(thread_id);
         t();
         profiler_.LogRun(thread_id);
         td.SetSpinning();
@@ -1645,18 +1797,38 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   // "snatching" work from a thread which is just about to notice the
   // work itself.
 
+  //
+  // With NUMA-aware scheduling, a worker first attempts to steal from
+  // the other workers on its own node, and only then from the pool as
+  // a whole.
+
   Task Steal(StealAttemptKind steal_kind) {
     PerThread* pt = GetPerThread();
-    unsigned size = num_threads_;
+    if (numa_aware_ && pt->pool == this) {
+      const auto& node_workers = workers_by_numa_node_[numa_node_of_worker_[pt->thread_id]];
+      Task t = StealFromWorkers(*pt, node_workers.data(), static_cast<unsigned>(node_workers.size()), steal_kind);
+      if (t) {
+        return t;
+      }
+    }
+    return StealFromWorkers(*pt, nullptr, num_threads_, steal_kind);
+  }
+
+  // Attempt to steal from the workers listed in workers[0,size), or
+  // from worker indices [0,size) if workers is null.
+
+  Task StealFromWorkers(PerThread& pt, const unsigned* workers, unsigned size, StealAttemptKind steal_kind) {
+    assert(size > 0 && size <= num_threads_);
     unsigned num_attempts = (steal_kind == StealAttemptKind::TRY_ALL) ? size : 1;
-    unsigned r = Rand(&pt->rand);
+    unsigned r = Rand(&pt.rand);
     unsigned inc = all_coprimes_[size - 1][r % all_coprimes_[size - 1].size()];
     unsigned victim = r % size;
 
     for (unsigned i = 0; i < num_attempts; i++) {
       assert(victim < size);
-      if (worker_data_[victim].GetStatus() == WorkerData::ThreadStatus::Active) {
-        Task t = worker_data_[victim].queue.PopBack();
+      WorkerData& td = worker_data_[workers ? workers[victim] : victim];
+      if (td.GetStatus() == WorkerData::ThreadStatus::Active) {
+        Task t = td.queue.PopBack();
         if (t) {
           return t;
         }
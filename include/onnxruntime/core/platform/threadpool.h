@@ -16,11 +16,15 @@ limitations under the License.
 /* Modifications Copyright (c) Microsoft. */
 
 #pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <string>
 #include <vector>
 #include <functional>
 #include <memory>
 #include "core/common/common.h"
+#include "core/common/hardware_counters.h"
 #include "core/platform/env.h"
 
 #include <functional>
@@ -192,12 +196,16 @@ class ThreadPool {
   // Parallel sections are only implemented with the Eigen threadpool.
   // They have no effect when using OpenMP.
   //
-  // Parallel sections may not be nested, and may not be used inside
-  // parallel loops.
+  // Parallel sections may not be used inside parallel loops.  A section
+  // entered while the thread already leads one has no effect.
 
   class ParallelSection {
    public:
     explicit ParallelSection(ThreadPool* tp);
+
+    // As above, with the worker threads that run the section spinning for more work for
+    // spin_duration_us microseconds once the section ends, instead of the setting of the pool.
+    ParallelSection(ThreadPool* tp, int spin_duration_us);
     ~ParallelSection();
 
    private:
@@ -213,6 +221,82 @@ class ThreadPool {
     ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ParallelSection);
   };
 
+  // Priority classes of the parallel loops run in a pool.  They matter when a
+  // pool is shared by several sessions: while a loop of a higher class is
+  // running, the worker threads helping with a loop of a lower class stop
+  // claiming blocks of iterations from it at the next block boundary, and
+  // return to their queues where they pick up the work of the higher class
+  // loop.  The thread that started a loop keeps running it to completion, so
+  // lower class loops are slowed down rather than starved.
+  //
+  // Loops within a multi-loop parallel section keep their workers for the
+  // duration of the section.
+  enum class Priority : int {
+    kLow = 0,
+    kNormal = 1,
+    kHigh = 2,
+  };
+
+  static constexpr int kNumPriorities = 3;
+
+  // Sets the priority class of the parallel loops started by the current
+  // thread for the lifetime of the object.  The default is kNormal.
+  class PriorityScope {
+   public:
+    explicit PriorityScope(Priority priority);
+    ~PriorityScope();
+
+   private:
+    Priority previous_priority_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PriorityScope);
+  };
+
+  // Returns the priority class of the parallel loops started by the current thread.
+  static Priority CurrentPriority();
+
+  // Parses "low", "normal" or "high".
+  static bool TryParsePriority(const std::string& str, Priority& priority);
+
+  using Deadline = std::chrono::steady_clock::time_point;
+
+  // Sets the deadline of the parallel loops started by the current thread for
+  // the lifetime of the object, Deadline::max() for none, which is the default.
+  // Once the deadline has passed, new loops run in the calling thread and the
+  // worker threads helping with a running loop return to their queues at the
+  // next block boundary, so a run that missed its deadline stops taking CPU
+  // from the other runs sharing the pool.
+  class DeadlineScope {
+   public:
+    explicit DeadlineScope(Deadline deadline);
+    ~DeadlineScope();
+
+   private:
+    Deadline previous_deadline_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(DeadlineScope);
+  };
+
+  // Returns the deadline of the parallel loops started by the current thread.
+  static Deadline CurrentDeadline();
+
+  // Caps the degree of parallelism of the parallel loops started by the
+  // current thread for the lifetime of the object, 0 for no cap, which is the
+  // default.  A loop then runs on at most max_degree_of_parallelism threads,
+  // including the calling thread, and DegreeOfParallelism reports the capped
+  // value so callers partition their work accordingly.  This leaves the other
+  // threads of the pool to concurrent runs when a loop scales poorly.
+  class MaxDegreeOfParallelismScope {
+   public:
+    explicit MaxDegreeOfParallelismScope(int max_degree_of_parallelism);
+    ~MaxDegreeOfParallelismScope();
+
+   private:
+    int previous_max_degree_of_parallelism_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MaxDegreeOfParallelismScope);
+  };
+
+  // Returns the cap of the degree of parallelism of the parallel loops started by the current thread, 0 for none.
+  static int CurrentMaxDegreeOfParallelism();
+
   // The below API allows to disable spinning
   // This is used to support real-time scenarios where
   // spinning between relatively infrequent requests
@@ -360,10 +444,24 @@ class ThreadPool {
   // working in combination with the thread initiating the loop.
   static int DegreeOfParallelism(const ThreadPool* tp);
 
+  // Returns the number of threads a parallel loop started by the calling thread may run on, including the calling
+  // thread: the threads of tp plus one, capped by CurrentMaxDegreeOfParallelism(). Unlike DegreeOfParallelism, it
+  // counts threads rather than the shards loops are split into on hybrid cpus.
+  static int MaxParallelThreads(const ThreadPool* tp);
+
+  // Returns the OS ids of the NUMA nodes the threads of tp span when NUMA-aware scheduling is enabled
+  // (ThreadOptions::numa_aware_scheduling) and they span more than one node, an empty vector otherwise.
+  static std::vector<int> GetNumaNodes(const ThreadPool* tp);
+
+  // Returns the index in GetNumaNodes(tp) of the NUMA node of the calling thread if it's a thread of tp,
+  // -1 otherwise.
+  static int CurrentThreadNumaNode(const ThreadPool* tp);
+
   ORT_DISALLOW_COPY_AND_ASSIGNMENT(ThreadPool);
 
   // StartProfiling and StopProfiling are not to be consumed as public-facing API
-  static void StartProfiling(concurrency::ThreadPool* tp);
+  // hardware_counters are read around the tasks of the worker threads and reported in the thread statistics
+  static void StartProfiling(concurrency::ThreadPool* tp, profiling::HardwareCounterMask hardware_counters = 0);
   static std::string StopProfiling(concurrency::ThreadPool* tp);
 
  private:
@@ -373,6 +471,10 @@ class ThreadPool {
   // value returned by DegreeOfParallelism to code using the pool.
   int NumThreads() const;
 
+  // Returns the number of threads, including the calling thread, a parallel loop started by the calling thread may
+  // run on: NumThreads() + 1, capped by CurrentMaxDegreeOfParallelism().
+  int MaxWorkItems() const;
+
   // Returns current thread id between 0 and NumThreads() - 1, if called from a
   // thread in the pool. Returns -1 otherwise.
   int CurrentThreadId() const;
@@ -411,7 +513,7 @@ class ThreadPool {
 
   void Schedule(std::function<void()> fn);
 
-  void StartProfiling();
+  void StartProfiling(profiling::HardwareCounterMask hardware_counters);
 
   std::string StopProfiling();
 
@@ -428,6 +530,20 @@ class ThreadPool {
 
   // Force the thread pool to run in hybrid mode on a normal cpu.
   bool force_hybrid_ = false;
+
+  // Relative throughput of the core classes of a hybrid cpu, calibrated from the loops run in the pool.
+  // Threads on slower cores claim proportionally smaller blocks of iterations. nullptr if not in hybrid mode.
+  class HybridCoreWeights;
+  std::unique_ptr<HybridCoreWeights> hybrid_core_weights_;
+
+  // Returns the slot in hybrid_core_weights_ of the class of the core running the calling thread, -1 if none.
+  int CurrentCoreSlot() const;
+
+  // Returns true if a loop of a higher priority class than `priority` is running in the pool.
+  bool IsHigherPriorityLoopRunning(Priority priority) const;
+
+  // Number of parallel loops running in the pool per priority class.
+  std::array<std::atomic<int>, kNumPriorities> num_running_loops_{};
 };
 
 }  // namespace concurrency
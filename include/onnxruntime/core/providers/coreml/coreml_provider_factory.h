@@ -31,9 +31,14 @@ enum COREMLFlags {
   // Create an MLProgram. By default it will create a NeuralNetwork model. Requires Core ML 5 or later.
   COREML_FLAG_CREATE_MLPROGRAM = 0x010,
 
+  // Keep the compiled CoreML model (.mlmodelc) in the app's caches directory and reuse it when a session creates the
+  // same CoreML model again, instead of compiling it at every session creation.
+  // The cache key is a hash of the generated CoreML model and its weights, the CoreML version and these flags.
+  COREML_FLAG_ENABLE_COMPILED_MODEL_CACHE = 0x020,
+
   // Keep COREML_FLAG_LAST at the end of the enum definition
   // And assign the last COREMLFlag to it
-  COREML_FLAG_LAST = COREML_FLAG_CREATE_MLPROGRAM,
+  COREML_FLAG_LAST = COREML_FLAG_ENABLE_COMPILED_MODEL_CACHE,
 };
 
 #ifdef __cplusplus
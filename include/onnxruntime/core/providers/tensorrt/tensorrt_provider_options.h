@@ -81,4 +81,6 @@ struct OrtTensorRTProviderOptionsV2 {
 
   const char* trt_engine_cache_prefix{nullptr};  // specify engine cache prefix
   int trt_engine_hw_compatible{0};               // Enable hardware compatibility. Default 0 = false, nonzero = true
+  int trt_async_engine_build{0};                 // Build the engines of new shape profiles in the background and run
+                                                 // quickly built engines meanwhile. Default 0 = false, nonzero = true
 };
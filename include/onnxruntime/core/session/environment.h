@@ -10,6 +10,8 @@
 #include "core/platform/threadpool.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocator.h"
+#include "core/framework/prepacked_weights_container.h"
+#include "core/framework/shared_initializer_cache.h"
 
 struct OrtThreadingOptions;
 namespace onnxruntime {
@@ -79,6 +81,22 @@ class Environment {
    */
   Status UnregisterAllocator(const OrtMemoryInfo& mem_info);
 
+  /**
+   * Returns the cache used to deduplicate initializers of the sessions that enable
+   * "session.share_initializers_across_sessions".
+   */
+  SharedInitializerCache& GetSharedInitializerCache() const {
+    return *shared_initializer_cache_;
+  }
+
+  /**
+   * Returns the container used to cache pre-packed weights of the sessions that enable
+   * "session.share_initializers_across_sessions" and were not given a PrepackedWeightsContainer.
+   */
+  PrepackedWeightsContainer& GetSharedPrepackedWeightsContainer() const {
+    return *shared_prepacked_weights_container_;
+  }
+
   Environment() = default;
 
   /**
@@ -99,5 +117,8 @@ class Environment {
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
   bool create_global_thread_pools_{false};
   std::vector<AllocatorPtr> shared_allocators_;
+  std::unique_ptr<SharedInitializerCache> shared_initializer_cache_ = std::make_unique<SharedInitializerCache>();
+  std::unique_ptr<PrepackedWeightsContainer> shared_prepacked_weights_container_ =
+      std::make_unique<PrepackedWeightsContainer>();
 };
 }  // namespace onnxruntime
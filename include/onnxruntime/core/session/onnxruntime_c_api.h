@@ -725,6 +725,19 @@ typedef OrtStatus*(ORT_API_CALL* RegisterCustomOpsFn)(OrtSessionOptions* options
  */
 typedef void (*RunAsyncCallbackFn)(void* user_data, OrtValue** outputs, size_t num_outputs, OrtStatusPtr status);
 
+/** \brief Callback of the GreedySearch and Sampling contrib ops, called after each generated token
+ *
+ * \param[in] user_data User specific data passed to OrtApi::RunOptionsSetGenerationStepCallback
+ * \param[in] next_tokens The token generated for each sequence in this step. A sequence that ended with the
+ *                        end-of-sequence token in this step or earlier gets the padding token.
+ * \param[in] finished Whether each sequence has ended.
+ * \param[in] batch_size Number of values of next_tokens and finished.
+ * \param[in] step Index of the step, 0 for the first generated token.
+ * \return 0 to continue, non-zero to end the generation of all the sequences after this step.
+ */
+typedef int(ORT_API_CALL* OrtGenerationStepCallbackFn)(void* user_data, const int32_t* next_tokens,
+                                                       const bool* finished, size_t batch_size, size_t step);
+
 /** \brief The C API
  *
  * All C API functions are defined inside this structure as pointers to functions.
@@ -2803,6 +2816,17 @@ struct OrtApi {
    *  Use -1 to allow ORT to choose the default 1GB for max_power_of_two_extend_bytes.
    *  Ultimately, the allocation size is determined by the allocation memory request.
    *  Further allocation sizes are governed by the arena extend strategy.
+   * "thread_cache_max_chunk_bytes": Allocations of up to this many bytes are served from per thread free lists in
+   *  front of the arena, so that concurrent small allocations don't contend on the lock of the arena.
+   *  Use -1 to allow ORT to choose the default. Use 0 to disable the thread caches. Thread caches are disabled
+   *  by default.
+   * "use_cuda_mempool": 1 = the CUDA execution provider allocates device memory from a CUDA stream ordered memory
+   *  pool (cudaMallocAsync) instead of the arena. Memory freed on a stream is reused by later allocations of that
+   *  stream without synchronization. The other arena keys don't apply to it. Use -1 to allow ORT to choose the
+   *  default, which is the arena.
+   * "cuda_mempool_release_threshold": Bytes of unused memory the CUDA memory pool keeps reserved when a stream is
+   *  synchronized, the rest is returned to the system. The memory arena shrinkage run option returns all of it.
+   *  Use -1 to allow ORT to choose the default, which keeps all of it.
    *
    * \param[in] arena_config_keys Keys to configure the arena
    * \param[in] arena_config_values Values to configure the arena
@@ -3672,6 +3696,8 @@ struct OrtApi {
    * XNNPACK supported keys:
    *   "intra_op_num_threads": number of thread-pool size to use for XNNPACK execution provider.
    *      default value is 0, which means to use the session thread-pool size.
+   *   "enable_subgraph_compile": set to 1 to compile connected float nodes with static shapes into a single
+   *      XNNPACK runtime instead of running them as individual kernels. Disabled by default.
    *
    * \since Version 1.12.
    */
@@ -4665,6 +4691,126 @@ struct OrtApi {
                   _In_reads_(num_external_initializer_files) char* const* external_initializer_file_buffer_array,
                   _In_reads_(num_external_initializer_files) const size_t* external_initializer_file_lengths,
                   size_t num_external_initializer_files);
+
+  /// \name OrtSession
+  /// @{
+
+  /** \brief Get the latency histograms of the sampling profiler
+   *
+   * The sampling profiler is enabled with the "session.sampled_profiling_rate" session config entry. It measures
+   * one in N Runs and keeps per-node and per-Run latency histograms for the lifetime of the session.
+   * The histograms are returned in the Prometheus text exposition format so they can be served to a scraper as is.
+   *
+   * \param[in] session
+   * \param[in] allocator Allocator used to allocate the returned string.
+   * \param[out] out Null terminated string with the histograms. Must be freed using `allocator`.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.19.
+   */
+  ORT_API2_STATUS(SessionGetSampledProfile, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /// @}
+  /// \name OrtValue
+  /// @{
+
+  /** \brief Get views of all the strings in a string tensor without copying them
+   *
+   * Unlike OrtApi::GetStringTensorContent, which copies every string into one caller provided buffer, this
+   * returns a pointer to and the byte length of each string element as stored in the tensor.
+   * The pointers remain valid as long as `value` is alive and its strings are not modified.
+   *
+   * \param[in] value A string tensor
+   * \param[out] data Set to the UTF-8 contents of each element. The strings are NOT null-terminated.
+   * \param[out] lengths Set to the number of bytes of each element.
+   * \param[in] count Number of entries in `data` and `lengths`. Must match the number of elements in the tensor.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.19.
+   */
+  ORT_API2_STATUS(GetStringTensorElementViews, _In_ const OrtValue* value, _Out_writes_all_(count) const char** data,
+                  _Out_writes_all_(count) size_t* lengths, size_t count);
+
+  /// @}
+  /// \name OrtSession
+  /// @{
+
+  /** \brief Get the calibration statistics collected during the Runs of the session
+   *
+   * The statistics are collected when the "session.collect_tensor_statistics" session config entry is "1". Every
+   * Run adds the float tensors of the main graph to a per-tensor min, max and histogram of absolute values, so
+   * post-training quantization can be calibrated with ordinary Runs instead of a model that outputs every tensor.
+   *
+   * The result is a JSON object keyed by tensor name whose values have the members "count", "min", "max",
+   * "histogram_bin_width" and "histogram". Bin i of "histogram" counts the values whose absolute value is in
+   * [i * histogram_bin_width, (i + 1) * histogram_bin_width).
+   *
+   * \param[in] session
+   * \param[in] allocator Allocator used to allocate the returned string.
+   * \param[out] out Null terminated JSON string with the statistics. Must be freed using `allocator`.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.19.
+   */
+  ORT_API2_STATUS(SessionGetTensorStatistics, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /// @}
+  /// \name OrtRunOptions
+  /// @{
+
+  /** \brief Set a callback called after each token generated by the GreedySearch and Sampling contrib ops
+   *
+   * The callback is called in the thread running the op, once per decoding step with the new token of each
+   * sequence, so the tokens can be streamed while the Run is in progress, including one started with
+   * OrtApi::RunAsync. Returning non-zero from the callback ends the generation, and the Run returns the sequences
+   * generated so far.
+   *
+   * \param[in] options
+   * \param[in] callback The callback, or nullptr to remove it.
+   * \param[in] user_data Passed to the callback.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.19.
+   */
+  ORT_API2_STATUS(RunOptionsSetGenerationStepCallback, _Inout_ OrtRunOptions* options,
+                  _In_opt_ OrtGenerationStepCallbackFn callback, _In_opt_ void* user_data);
+
+  /// @}
+  /// \name OrtIoBinding
+  /// @{
+
+  /** \brief Freeze the bound names, and the types, shapes and locations of the bound values
+   *
+   * For repeated runs that only change the contents of the bound values, e.g. a decode loop. The first
+   * OrtApi::RunWithBinding after this call validates the binding and resolves the inputs, outputs and device copies
+   * once, the later runs reuse them and write the outputs into the values allocated by the first run.
+   * While frozen, OrtApi::BindInput and OrtApi::BindOutput only accept bound names and values of the same type, shape
+   * and location. An input copied to another device when it was bound gets the contents of a new value copied
+   * into its existing device buffer. OrtApi::ClearBoundInputs and OrtApi::ClearBoundOutputs unfreeze the binding.
+   *
+   * \param[in] binding_ptr
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   *
+   * \since Version 1.19.
+   */
+  ORT_API2_STATUS(FreezeIoBinding, _Inout_ OrtIoBinding* binding_ptr);
+
+  /** \brief Unfreeze a binding frozen with OrtApi::FreezeIoBinding, keeping its bound values
+   *
+   * \param[in] binding_ptr
+   *
+   * \since Version 1.19.
+   */
+  void(ORT_API_CALL* UnfreezeIoBinding)(_Inout_ OrtIoBinding* binding_ptr) NO_EXCEPTION ORT_ALL_ARGS_NONNULL;
+
+  /// @}
 };
 
 /*
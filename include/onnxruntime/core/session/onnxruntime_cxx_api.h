@@ -766,6 +766,12 @@ struct RunOptions : detail::Base<OrtRunOptions> {
    * Wraps OrtApi::RunOptionsUnsetTerminate
    */
   RunOptions& UnsetTerminate();
+
+  /** \brief Sets a callback called after each token generated by the GreedySearch and Sampling contrib ops
+   *
+   * Wraps OrtApi::RunOptionsSetGenerationStepCallback
+   */
+  RunOptions& SetGenerationStepCallback(OrtGenerationStepCallbackFn callback, void* user_data);
 };
 
 namespace detail {
@@ -1036,6 +1042,8 @@ struct ConstSessionImpl : Base<T> {
   AllocatedStringPtr GetOverridableInitializerNameAllocated(size_t index, OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetOverridableInitializerName
 
   uint64_t GetProfilingStartTimeNs() const;  ///< Wraps OrtApi::SessionGetProfilingStartTimeNs
+  AllocatedStringPtr GetSampledProfileAllocated(OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetSampledProfile
+  AllocatedStringPtr GetTensorStatisticsAllocated(OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetTensorStatistics
   ModelMetadata GetModelMetadata() const;    ///< Wraps OrtApi::SessionGetModelMetadata
 
   TypeInfo GetInputTypeInfo(size_t index) const;                   ///< Wraps OrtApi::SessionGetInputTypeInfo
@@ -1411,6 +1419,15 @@ struct ConstValueImpl : Base<T> {
   /// <returns>byte length for the specified string element</returns>
   size_t GetStringTensorElementLength(size_t element_index) const;
 
+  /// <summary>
+  /// The API returns pointers to and byte lengths of all UTF-8 encoded string elements
+  /// without copying them. The pointers are valid while the value is alive and its strings are not modified.
+  /// </summary>
+  /// <param name="data">receives a pointer to each string element, not null-terminated</param>
+  /// <param name="lengths">receives the byte length of each string element</param>
+  /// <param name="count">number of entries in data and lengths, must match the tensor element count</param>
+  void GetStringTensorElementViews(const char** data, size_t* lengths, size_t count) const;
+
 #if !defined(DISABLE_SPARSE_TENSORS)
   /// <summary>
   /// The API returns the sparse data format this OrtValue holds in a sparse tensor.
@@ -1851,6 +1868,8 @@ struct IoBindingImpl : ConstIoBindingImpl<T> {
   void ClearBoundOutputs();
   void SynchronizeInputs();
   void SynchronizeOutputs();
+  void Freeze();    ///< Wraps OrtApi::FreezeIoBinding
+  void Unfreeze();  ///< Wraps OrtApi::UnfreezeIoBinding
 };
 
 }  // namespace detail
@@ -2242,6 +2261,31 @@ struct ShapeInferContext {
 
 using ShapeInferFn = Ort::Status (*)(Ort::ShapeInferContext&);
 
+namespace detail {
+// Hands out {input index, output index} pairs through OrtCustomOp::GetMayInplace or OrtCustomOp::GetAliasMap.
+// The arrays are freed by ReleaseIndexPairs, which is used as OrtCustomOp::ReleaseMayInplace/ReleaseAliasMap.
+inline size_t CopyIndexPairs(const std::vector<std::pair<int, int>>& pairs, int** input_index, int** output_index) {
+  *input_index = nullptr;
+  *output_index = nullptr;
+  if (pairs.empty()) {
+    return 0;
+  }
+
+  *input_index = new int[pairs.size()];
+  *output_index = new int[pairs.size()];
+  for (size_t i = 0; i < pairs.size(); ++i) {
+    (*input_index)[i] = pairs[i].first;
+    (*output_index)[i] = pairs[i].second;
+  }
+  return pairs.size();
+}
+
+inline void ReleaseIndexPairs(int* input_index, int* output_index) {
+  delete[] input_index;
+  delete[] output_index;
+}
+}  // namespace detail
+
 #define MAX_CUSTOM_OP_END_VER (1UL << 31) - 1
 
 template <typename TOp, typename TKernel, bool WithStatus = false>
@@ -2305,10 +2349,8 @@ struct CustomOpBase : OrtCustomOp {
       return static_cast<const TOp*>(this_)->end_ver_;
     };
 
-    OrtCustomOp::GetMayInplace = nullptr;
-    OrtCustomOp::ReleaseMayInplace = nullptr;
-    OrtCustomOp::GetAliasMap = nullptr;
-    OrtCustomOp::ReleaseAliasMap = nullptr;
+    SetMayInplaceFn<TOp>(0);
+    SetAliasMapFn<TOp>(0);
   }
 
   // Default implementation of GetExecutionProviderType that returns nullptr to default to the CPU provider
@@ -2374,6 +2416,48 @@ struct CustomOpBase : OrtCustomOp {
     OrtCustomOp::InferOutputShapeFn = {};
   }
 
+  // An op that defines
+  //   static std::vector<std::pair<int, int>> MayInplace();
+  // returning {input index, output index} pairs lets the allocation planner give each of these outputs the buffer
+  // of the input, like KernelDefBuilder::MayInplace does for built-in kernels. GetOutput then returns that buffer
+  // when the input is not used afterwards, so the kernel must support computing in place.
+  template <typename C>
+  decltype(&C::MayInplace) SetMayInplaceFn(decltype(&C::MayInplace)) {
+    OrtCustomOp::GetMayInplace = [](int** input_index, int** output_index) -> size_t {
+      return detail::CopyIndexPairs(C::MayInplace(), input_index, output_index);
+    };
+    OrtCustomOp::ReleaseMayInplace = [](int* input_index, int* output_index) {
+      detail::ReleaseIndexPairs(input_index, output_index);
+    };
+    return {};
+  }
+
+  template <typename C>
+  void SetMayInplaceFn(...) {
+    OrtCustomOp::GetMayInplace = nullptr;
+    OrtCustomOp::ReleaseMayInplace = nullptr;
+  }
+
+  // An op that defines
+  //   static std::vector<std::pair<int, int>> AliasMap();
+  // declares that each of these outputs always shares the buffer of the input, like KernelDefBuilder::Alias.
+  template <typename C>
+  decltype(&C::AliasMap) SetAliasMapFn(decltype(&C::AliasMap)) {
+    OrtCustomOp::GetAliasMap = [](int** input_index, int** output_index) -> size_t {
+      return detail::CopyIndexPairs(C::AliasMap(), input_index, output_index);
+    };
+    OrtCustomOp::ReleaseAliasMap = [](int* input_index, int* output_index) {
+      detail::ReleaseIndexPairs(input_index, output_index);
+    };
+    return {};
+  }
+
+  template <typename C>
+  void SetAliasMapFn(...) {
+    OrtCustomOp::GetAliasMap = nullptr;
+    OrtCustomOp::ReleaseAliasMap = nullptr;
+  }
+
  protected:
   // Helper function that returns a map of session config entries specified by CustomOpBase::GetSessionConfigKeys.
   void GetSessionConfigs(std::unordered_map<std::string, std::string>& out, ConstSessionOptions options) const;
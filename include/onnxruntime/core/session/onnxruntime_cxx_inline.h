@@ -366,6 +366,16 @@ inline void IoBindingImpl<T>::SynchronizeOutputs() {
   ThrowOnError(GetApi().SynchronizeBoundOutputs(this->p_));
 }
 
+template <typename T>
+inline void IoBindingImpl<T>::Freeze() {
+  ThrowOnError(GetApi().FreezeIoBinding(this->p_));
+}
+
+template <typename T>
+inline void IoBindingImpl<T>::Unfreeze() {
+  GetApi().UnfreezeIoBinding(this->p_);
+}
+
 namespace binding_utils {
 inline std::vector<std::string> GetOutputNamesHelper(const OrtIoBinding* binding, OrtAllocator* allocator) {
   std::vector<std::string> result;
@@ -609,6 +619,11 @@ inline RunOptions& RunOptions::UnsetTerminate() {
   return *this;
 }
 
+inline RunOptions& RunOptions::SetGenerationStepCallback(OrtGenerationStepCallbackFn callback, void* user_data) {
+  ThrowOnError(GetApi().RunOptionsSetGenerationStepCallback(p_, callback, user_data));
+  return *this;
+}
+
 namespace detail {
 
 template <typename T>
@@ -1004,6 +1019,20 @@ inline uint64_t ConstSessionImpl<T>::GetProfilingStartTimeNs() const {
   return out;
 }
 
+template <typename T>
+inline AllocatedStringPtr ConstSessionImpl<T>::GetSampledProfileAllocated(OrtAllocator* allocator) const {
+  char* out = nullptr;
+  ThrowOnError(GetApi().SessionGetSampledProfile(this->p_, allocator, &out));
+  return AllocatedStringPtr(out, detail::AllocatedFree(allocator));
+}
+
+template <typename T>
+inline AllocatedStringPtr ConstSessionImpl<T>::GetTensorStatisticsAllocated(OrtAllocator* allocator) const {
+  char* out = nullptr;
+  ThrowOnError(GetApi().SessionGetTensorStatistics(this->p_, allocator, &out));
+  return AllocatedStringPtr(out, detail::AllocatedFree(allocator));
+}
+
 template <typename T>
 inline ModelMetadata ConstSessionImpl<T>::GetModelMetadata() const {
   OrtModelMetadata* out;
@@ -1342,6 +1371,11 @@ inline size_t ConstValueImpl<T>::GetStringTensorElementLength(size_t element_ind
   return out;
 }
 
+template <typename T>
+inline void ConstValueImpl<T>::GetStringTensorElementViews(const char** data, size_t* lengths, size_t count) const {
+  ThrowOnError(GetApi().GetStringTensorElementViews(this->p_, data, lengths, count));
+}
+
 template <typename T>
 template <typename R>
 inline const R* ConstValueImpl<T>::GetTensorData() const {
@@ -1043,6 +1043,8 @@ struct OrtLiteCustomStruct : public OrtLiteCustomOp {
     };
 
     SetShapeInfer<CustomOp>(0);
+    SetMayInplace<CustomOp>(0);
+    SetAliasMap<CustomOp>(0);
   }
 
   template <typename... Args>
@@ -1080,6 +1082,44 @@ struct OrtLiteCustomStruct : public OrtLiteCustomOp {
   void SetShapeInfer(...) {
     OrtCustomOp::InferOutputShapeFn = {};
   }
+
+  // Same as CustomOpBase::SetMayInplaceFn: the struct may define
+  //   static std::vector<std::pair<int, int>> MayInplace();
+  // to let outputs reuse the buffers of inputs, in which case Tensor::Allocate can return the input's data.
+  template <typename C>
+  decltype(&C::MayInplace) SetMayInplace(decltype(&C::MayInplace)) {
+    OrtCustomOp::GetMayInplace = [](int** input_index, int** output_index) -> size_t {
+      return Ort::detail::CopyIndexPairs(C::MayInplace(), input_index, output_index);
+    };
+    OrtCustomOp::ReleaseMayInplace = [](int* input_index, int* output_index) {
+      Ort::detail::ReleaseIndexPairs(input_index, output_index);
+    };
+    return {};
+  }
+
+  template <typename C>
+  void SetMayInplace(...) {
+    OrtCustomOp::GetMayInplace = {};
+    OrtCustomOp::ReleaseMayInplace = {};
+  }
+
+  // Same as CustomOpBase::SetAliasMapFn, for a struct that defines static std::vector<std::pair<int, int>> AliasMap().
+  template <typename C>
+  decltype(&C::AliasMap) SetAliasMap(decltype(&C::AliasMap)) {
+    OrtCustomOp::GetAliasMap = [](int** input_index, int** output_index) -> size_t {
+      return Ort::detail::CopyIndexPairs(C::AliasMap(), input_index, output_index);
+    };
+    OrtCustomOp::ReleaseAliasMap = [](int* input_index, int* output_index) {
+      Ort::detail::ReleaseIndexPairs(input_index, output_index);
+    };
+    return {};
+  }
+
+  template <typename C>
+  void SetAliasMap(...) {
+    OrtCustomOp::GetAliasMap = {};
+    OrtCustomOp::ReleaseAliasMap = {};
+  }
 };  // struct OrtLiteCustomStruct
 
 /////////////////////////// CreateLiteCustomOp ////////////////////////////
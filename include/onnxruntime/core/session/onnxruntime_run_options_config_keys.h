@@ -49,3 +49,21 @@ static const char* const kOrtRunOptionsConfigQnnRpcControlLatency = "qnn.rpc_con
 // If the value is set to -1, cuda graph capture/replay is disabled in that run.
 // User are not expected to set the value to 0 as it is reserved for internal use.
 static const char* const kOrtRunOptionsConfigCudaGraphAnnotation = "gpu_graph_id";
+
+// Priority class of the parallel loops of this run in the intra-op thread pool: "low", "normal" or "high".
+// Overrides the priority class of the session, see kOrtSessionOptionsConfigIntraOpThreadPoolPriority.
+static const char* const kOrtRunOptionsConfigIntraOpThreadPoolPriority = "run.intra_op_thread_pool_priority";
+
+// Latency budget of this run in microseconds, counted from the start of the Run call. Once it is spent, the run
+// fails with an error before its next node, and its parallel loops in the intra-op thread pool stop being split
+// across the worker threads, so that under overload late runs are dropped cheaply instead of delaying the others.
+// Expired runs are counted in a "model_run_deadline_exceeded" profiler event and by the sampling profiler, see
+// kOrtSessionOptionsConfigSampledProfilingRate.
+// Default is "", no deadline.
+static const char* const kOrtRunOptionsConfigLatencyBudgetUs = "run.latency_budget_us";
+
+// Comma separated names of the LoRA adapters to apply in this run. The adapters must have been added to the session
+// with InferenceSession::AddLoraAdapter, and their parameters are fed to the run in addition to the user feeds.
+// An adapter parameter must not be fed by the user or by another active adapter.
+// Default is "", no adapter.
+static const char* const kOrtRunOptionsConfigActiveLoraAdapters = "run.active_lora_adapters";
@@ -20,10 +20,41 @@
 // If the config value is set to "1" then the prepacking is disabled, otherwise prepacking is enabled (default value)
 static const char* const kOrtSessionOptionsConfigDisablePrepacking = "session.disable_prepacking";
 
+// Path of a file used to persist pre-packed weights across sessions and processes.
+// If the file exists and was produced on a machine with the same CPU features, it is memory mapped and the kernels
+// that support it use the pre-packed weights from the mapping instead of pre-packing, so the pages are shared by all
+// the processes using the file. Pre-packed weights that are missing from the file are added to it when the session
+// is initialized. Ignored if prepacking is disabled. Default is empty (no file).
+static const char* const kOrtSessionOptionsConfigPrepackedWeightsCacheFile = "session.prepacked_weights_cache_file";
+
+// Maximum number of memory patterns cached per shape bucket. Only applies if the memory pattern optimization is enabled.
+// By default a memory pattern is only reused for the exact input shapes it was generated for. If this is set to a
+// positive value, input dims are rounded up to the next power of 2 and the inputs falling in the same bucket share a
+// memory pattern that grows to fit the largest shapes seen in the bucket. The least recently used patterns are evicted
+// once there are more buckets than this value. Default is "0" (exact shapes).
+static const char* const kOrtSessionOptionsConfigMemoryPatternBucketCacheSize = "session.memory_pattern_bucket_cache_size";
+
+// Maximum number of memory pattern buffers kept idle per device for reuse by later runs. Only applies if the memory
+// pattern optimization is enabled. Each run places all its intermediates in one buffer sized to the planned peak.
+// By default the buffer is returned to the device allocator when the run ends, so concurrent runs interleave their
+// buffers in the arena. If this is set to a positive value, finished runs return their buffers to a per-session pool
+// and the next runs take the smallest pooled buffer that is large enough, so the allocator is only called when the
+// pool has no such buffer. Set it to the expected number of concurrent Run calls. Default is "0" (no pool).
+static const char* const kOrtSessionOptionsConfigMemoryPatternSlabPoolSize = "session.memory_pattern_slab_pool_size";
+
 // A value of "1" means allocators registered in the env will be used. "0" means the allocators created in the session
 // will be used. Use this to override the usage of env allocators on a per session level.
 static const char* const kOrtSessionOptionsConfigUseEnvAllocators = "session.use_env_allocators";
 
+// A value of "1" shares the initializers of this session with all other sessions in the same env that enable it.
+// Initializers used on CPU are deduplicated by content, so sessions of models that share most of their weights
+// (e.g. fine-tunes of one base model) hold a single copy of each identical weight. The copy is released when the last
+// session using it goes away. Pre-packed weights are cached in the env as well, unless the session was given its own
+// PrepackedWeightsContainer. Initializers with external data are memory mapped and not affected.
+// Default is "0".
+static const char* const kOrtSessionOptionsConfigShareInitializersAcrossSessions =
+    "session.share_initializers_across_sessions";
+
 // Set to 'ORT' (case sensitive) to load an ORT format model.
 // If unset, model type will default to ONNX unless inferred from filename ('.ort' == ORT format) or bytes to be ORT
 static const char* const kOrtSessionOptionsConfigLoadModelFormat = "session.load_model_format";
@@ -67,6 +98,43 @@ static const char* const kOrtSessionOptionsEnableQuantQDQCleanup = "session.enab
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// Enable or disable converting float MatMul nodes with constant weights to DynamicQuantizeMatMul.
+// "0": disable; "1": enable. The default is "0".
+// The weights are quantized to int8 per column and the activations are quantized per row at runtime. This changes the
+// inference results, so it is disabled by default.
+static const char* const kOrtSessionOptionsEnableDynamicQuantizeMatMul = "optimization.enable_dynamic_quantize_matmul";
+
+// Enable or disable SmoothQuant smoothing of the activations of normalization nodes. "0": disable; "1": enable.
+// The default is "0".
+// The per channel activation ranges are read from the model metadata, see onnxruntime/core/optimizer/smooth_quant.h.
+// The smoothing factors are folded into the normalization scale and the weights of the MatMul nodes that consume it,
+// so it is typically combined with "optimization.enable_dynamic_quantize_matmul".
+static const char* const kOrtSessionOptionsEnableSmoothQuant = "optimization.enable_smooth_quant";
+
+// The migration strength alpha of SmoothQuant in [0, 1]. The default is "0.5".
+// Larger values move more of the activation range to the weights.
+static const char* const kOrtSessionOptionsSmoothQuantAlpha = "optimization.smooth_quant_alpha";
+
+// Enable or disable the cost model of the NCHWc layout transformation. "0": disable; "1": enable. The default is "0".
+// If enabled, connected regions of nodes that would use the NCHWc layout are left in NCHW layout when the estimated
+// cost of reordering the tensors at their boundaries exceeds the estimated speedup of their convolutions.
+// Regions with dynamic shapes are always converted.
+static const char* const kOrtSessionOptionsEnableNchwcCostModel = "optimization.enable_nchwc_cost_model";
+
+// Convert the float parts of the model that benefit from lower precision, e.g. MatMul, Gemm and Conv and the
+// elementwise ops next to them, to a lower precision type at session initialization.
+// "": disabled; "fp16": convert to float16; "bf16": convert to bfloat16. The default is "".
+// Reductions, normalizations and other numerically sensitive ops stay in float and graph inputs and outputs keep
+// their type. Nodes without a lower precision kernel in their execution provider run in float with inserted casts.
+static const char* const kOrtSessionOptionsAutoMixedPrecision = "optimization.auto_mixed_precision";
+
+// Comma separated list of additional op types to always convert when auto mixed precision is enabled,
+// e.g. "FusedMatMul,Attention".
+static const char* const kOrtSessionOptionsAutoMixedPrecisionAllowOps = "optimization.auto_mixed_precision_allow_ops";
+
+// Comma separated list of op types to keep in float when auto mixed precision is enabled, e.g. "Add,Mul".
+static const char* const kOrtSessionOptionsAutoMixedPrecisionDenyOps = "optimization.auto_mixed_precision_deny_ops";
+
 // This setting controls whether to enable AheadOfTime function inlining.
 // AOT function inlining examines the graph and attempts to inline as many locally defined functions in the model
 // as possible with the help of enabled execution providers.
@@ -88,7 +156,8 @@ static const char* const kOrtSessionOptionsDisableAheadOfTimeFunctionInlining =
 // Taking the example of "Gelu+Cast+:1:0",
 // > "Gelu+Cast+" is the subgraph string, a valid "subgraph string" should be one subgraph representation
 //    output by ORT graph transformations.
-// > "1" is "optimization strategy", valid values: 0 - disabled, 1 - recompute.
+// > "1" is "optimization strategy", valid values: 0 - disabled, 1 - recompute, 2 - recompute with compromise,
+//    3 - offload to host memory (only for activations produced on CUDA/ROCm).
 // > "0" is "number of subgraph to apply" which is used to control how many subgraphs to apply optimization,
 //    to avoid "oversaving" the memory.
 static const char* const kOrtSessionOptionsMemoryOptimizerApplyConfig = "optimization.memory_optimizer_config";
@@ -117,6 +186,32 @@ static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "
 static const char* const kOrtSessionOptionsConfigAllowInterOpSpinning = "session.inter_op.allow_spinning";
 static const char* const kOrtSessionOptionsConfigAllowIntraOpSpinning = "session.intra_op.allow_spinning";
 
+// Duration in microseconds the intra_op threads spin waiting for work before blocking, when spinning is allowed.
+// A short duration frees the cores sooner between runs, while a duration longer than the gap between the parallel
+// sections of a small model keeps the threads from blocking and paying the OS wake-up latency on every section.
+// "-1": default, threads spin for a fixed number of iterations.
+// "0": threads block as soon as they find no work to run.
+// Parallel sections (ThreadPool::ParallelSection) may request their own duration for the threads that ran them.
+static const char* const kOrtSessionOptionsConfigIntraOpSpinDurationUs = "session.intra_op.spin_duration_us";
+
+// If set to "1", a Run in sequential execution mode enters a single parallel section of the intra_op thread pool for
+// its whole duration. The intra_op threads then stay attached to the Run and spin between the parallel loops of
+// consecutive kernels, and starting a loop only takes pushing it to them. This helps graphs of many small nodes, at
+// the cost of the intra_op threads spinning for the whole Run, and of other work scheduled on the pool (e.g. by other
+// sessions sharing it) waiting for the Run to end.
+// "0": default, each parallel loop or kernel level parallel section dispatches its own work.
+static const char* const kOrtSessionOptionsConfigIntraOpRunParallelSection = "session.intra_op.run_parallel_section";
+
+// Number of timed executions per candidate degree of parallelism used to learn the intra_op parallelism of each CPU
+// node of the main graph and shape of its inputs. The first executions of a node with inputs of a new shape run with
+// its parallel loops capped to 1, 2, 4, ... threads up to all the intra_op threads. The node then runs with the fewest
+// threads that are within 10% of the fastest, which leaves the other threads to concurrent Runs when its loops scale
+// poorly, e.g. the small nodes of a session serving many concurrent requests.
+// Only the first 16 input shapes of a node are learnt.
+// "0": default, the parallel loops of the nodes use all the intra_op threads.
+static const char* const kOrtSessionOptionsConfigIntraOpAdaptiveParallelismSamples =
+    "session.intra_op.adaptive_parallelism_samples";
+
 // Key for using model bytes directly for ORT format
 // If a session is created using an input byte array contains the ORT format model data,
 // By default we will copy the model bytes at the time of session creation to ensure the model bytes
@@ -197,6 +292,133 @@ static const char* const kOrtSessionOptionsConfigStrictAllowReleasedOpsetsOnly =
 // The file saves configuration for partitioning node among logic streams
 static const char* const kNodePartitionConfigFile = "session.node_partition_config_file";
 
+// Assigns the MemcpyFromHost and MemcpyToHost nodes of a device to their own logic stream, separate from the
+// compute nodes of that device. The copies are then issued on a dedicated device stream and synchronized with
+// events, so they can overlap with unrelated compute on the device and with CPU fallback nodes.
+// Only applies when the streams are not given by kNodePartitionConfigFile.
+// "0": copy nodes run on the compute stream of their device. [DEFAULT]
+// "1": copy nodes run on a dedicated copy stream per device.
+static const char* const kOrtSessionOptionsConfigUseDedicatedCopyStream = "session.use_dedicated_copy_stream";
+
+// Partitions the CPU nodes of a graph run with ExecutionMode::ORT_PARALLEL into as many logic streams as there are
+// inter-op threads. Nodes are list scheduled by the length of the longest chain of dependent nodes that follows them,
+// using the node costs of kNodePartitionConfigFile when it is a CriticalPathPartitioner config, e.g. taken from a
+// profile of warm-up runs, and an estimate from the output shapes otherwise.
+// Only applies when kNodePartitionConfigFile does not select another partitioner.
+// "0": the CPU nodes run on a single logic stream. [DEFAULT]
+// "1": the CPU nodes are partitioned along the critical path.
+static const char* const kOrtSessionOptionsConfigCriticalPathPartition = "session.critical_path_partition";
+
+// Streams the weights of device nodes from host memory instead of keeping them resident on the device, so
+// models whose weights don't fit in device memory can run.
+// Constant initializers that are consumed on a non-CPU device from a single logic stream are kept in host memory
+// (pinned memory if the EP provides it, or the memory mapped external data file). Each one is copied to the device
+// on the stream of its consumers a few nodes before its first consumer runs and freed after its last consumer ran.
+// Only applies to the main graph. Streamed weights are not pre-packed.
+// "0": weights are placed on the device when the session is initialized. [DEFAULT]
+// "1": weights are streamed to the device during Run.
+static const char* const kOrtSessionOptionsConfigEnableWeightStreaming = "session.enable_weight_streaming";
+
+// How many nodes of a logic stream ahead of its first consumer the copy of a streamed weight is issued.
+// Larger values hide more of the copy latency at the cost of more weights resident on the device.
+// Only applies when kOrtSessionOptionsConfigEnableWeightStreaming is "1". Default is "16".
+static const char* const kOrtSessionOptionsConfigWeightStreamingPrefetchDistance =
+    "session.weight_streaming_prefetch_distance";
+
+// Maximum number of Run results kept in a least recently used cache of the session. A Run whose feeds and output
+// names are identical to the ones of a cached Run returns copies of the cached outputs without executing the graph.
+// The cache is only used if the outputs of the model only depend on its inputs: it's disabled if the model contains
+// random number generator ops, Dropout in training mode or ops of custom domains, and if graph capture is enabled.
+// Only Runs with CPU tensor feeds and outputs and no pre-allocated outputs are cached.
+// "0": the cache is disabled. [DEFAULT]
+static const char* const kOrtSessionOptionsConfigRunResultCacheSize = "session.run_result_cache_size";
+
+// Capture the kernel calls of the first Run and replay them in later Runs with the same feed and output names,
+// skipping the executor and the per node setup. The intermediate buffers stay allocated between the Runs.
+// Only applies if all the nodes are assigned to the CPU EP, the model has no control flow nodes, the inputs and all
+// node outputs have static shapes (use free dimension overrides for symbolic dimensions), the execution mode is
+// sequential and profiling is disabled. Concurrent Runs don't wait for the replay, they execute the graph as usual.
+// "0": disabled. [DEFAULT]
+// "1": enabled.
+static const char* const kOrtSessionOptionsConfigEnableCpuGraphCapture = "session.enable_cpu_graph_capture";
+
+// Comma separated, ascending batch sizes, e.g. "1,2,4,8,16", to capture a graph per batch size bucket with an EP
+// whose graph capture is enabled (e.g. the CUDA EP with enable_cuda_graph). A Run without an explicit graph
+// annotation id (see kOrtRunOptionsConfigCudaGraphAnnotation) and without pre-allocated outputs copies its feeds into
+// session owned device buffers whose first dimension is padded to the smallest bucket not less than the batch size,
+// captures the graph of the bucket on the first such Run and replays it on the following ones. The outputs are
+// returned as CPU tensors trimmed to the batch size. The batch size is the first dimension of the inputs whose first
+// dimension is symbolic in the model, the padded rows must not affect the other rows (e.g. a batch of images).
+// Inputs of other shapes, or other outputs, are captured in separate graphs. Runs with a batch size above the largest
+// bucket are executed without graph capture. The bucketed Runs of a session are serialized and must use the same
+// thread, as captured graphs are kept per thread. Graph annotation ids from 65536 up are used by the buckets.
+// Default is "", no buckets.
+static const char* const kOrtSessionOptionsConfigGraphCaptureBatchBuckets = "session.graph_capture_batch_buckets";
+
+// Maximum number of graphs captured for kOrtSessionOptionsConfigGraphCaptureBatchBuckets. When a new bucket needs
+// a graph and the limit is reached, the least recently used graph and its buffers are released.
+// The EP must support releasing captured graphs. Default is "0", no limit.
+static const char* const kOrtSessionOptionsConfigGraphCaptureMaxGraphs = "session.graph_capture_max_graphs";
+
+// Only execute the nodes the requested outputs depend on in Runs that fetch a subset of the outputs of the model,
+// e.g. a single head of a multi-head model. The nodes to execute are computed once per set of requested outputs.
+// Values consumed by skipped nodes are released at the end of the Run instead of after their last consumer.
+// Regardless of this setting, RunOptions::only_execute_path_to_fetches prunes a single Run.
+// "0": all nodes are executed. [DEFAULT]
+// "1": enabled.
+static const char* const kOrtSessionOptionsConfigPruneExecutionToFetches = "session.prune_execution_to_fetches";
+
+// Directory of a cache of optimized models, so sessions created again for the same model skip graph optimization.
+// When a session loading an ONNX model is initialized, it looks for an ORT format model in the directory with a
+// name computed from the model, the ORT version, the session options, the execution providers and their options
+// and the instruction set extensions of the CPU. If found, the session uses it instead of the ONNX model. If not,
+// the session saves its optimized model in the directory, as with SessionOptions::optimized_model_filepath.
+// The cache isn't used when SessionOptions::optimized_model_filepath is set, or when any execution provider other
+// than the CPU, CUDA or ROCm EP is registered, as the nodes of compiling EPs aren't compiled in a session saving
+// an ORT format model.
+// Default is "", the cache is disabled.
+static const char* const kOrtSessionOptionsConfigOptimizedModelCacheDir = "session.optimized_model_cache_dir";
+
+// Maximum number of prompts whose past state the GPT subgraph of each BeamSearch and GreedySearch node caches.
+// A later prompt that starts with at least 16 tokens of a cached prompt reuses the past state of the shared prefix,
+// so only its remaining tokens run through the first decoder pass. This helps requests that share a long system
+// prompt. The cache is only used by the CPU EP, for prompts without padding and decoder subgraphs that don't use
+// past_present_share_buffer, and it assumes that the past state only depends on the tokens of the prompt.
+// Default is "0", the cache is disabled.
+static const char* const kOrtSessionOptionsConfigGptPrefixCacheSize = "session.gpt_prefix_cache_size";
+
+// Always-on sampling profiler. One in N Runs measures the latency of each node of the main graph and of the Run,
+// and adds them to in-memory histograms, which OrtApi::SessionGetSampledProfile returns in the Prometheus text
+// format. The other Runs only pay for a counter increment. Unlike SessionOptions::enable_profiling no events are
+// collected or written to a file, so it can stay enabled in production.
+// Nodes of subgraphs and Runs replayed by the CPU graph (see kOrtSessionOptionsConfigEnableCpuGraphCapture) are not
+// measured.
+// Default is "0", the sampling profiler is disabled. "1" measures every Run.
+static const char* const kOrtSessionOptionsConfigSampledProfilingRate = "session.sampled_profiling_rate";
+
+// Collects calibration statistics for post-training quantization during ordinary Runs. Every Run adds the float
+// tensors of the main graph (graph inputs and node outputs in CPU memory) to a per-tensor min, max and histogram of
+// absolute values, which OrtApi::SessionGetTensorStatistics returns as JSON. Unlike calibrating a model rewritten to
+// output every intermediate tensor, the tensors are not copied or kept alive past their last use.
+// Each Run reads every recorded tensor once more, so only enable it for calibration.
+// Default is "0", the statistics are not collected. "1" collects them.
+static const char* const kOrtSessionOptionsConfigCollectTensorStatistics = "session.collect_tensor_statistics";
+
+// Number of bins of the histograms collected with kOrtSessionOptionsConfigCollectTensorStatistics. Must be even.
+// Default is "2048".
+static const char* const kOrtSessionOptionsConfigTensorStatisticsHistogramBins =
+    "session.tensor_statistics_histogram_bins";
+
+// Hardware performance counters the profiler records around each kernel when SessionOptions::enable_profiling is
+// set, as a comma separated list of "cycles", "instructions", "cache_references", "cache_misses" and
+// "branch_misses". They are emitted in a "<node>_hardware_counters" event next to the "<node>_kernel_time" event,
+// with the instructions per cycle, the cache miss rate and the memory bandwidth estimated from the cache misses.
+// The counters of the intra-op thread pool workers are added to the "thread_scheduling_stats" of the kernel.
+// Linux reads the counters via perf_event and needs perf_event_paranoid <= 2, Windows only provides "cycles".
+// Counters that can't be read are left out of the profile.
+// Default is "", no hardware counters are recorded.
+static const char* const kOrtSessionOptionsConfigProfilingHardwareCounters = "session.profiling_hardware_counters";
+
 // This Option allows setting affinities for intra op threads.
 // Affinity string follows format:
 // logical_processor_id,logical_processor_id;logical_processor_id,logical_processor_id
@@ -214,6 +436,42 @@ static const char* const kNodePartitionConfigFile = "session.node_partition_conf
 //    Hence 64-65 is an invalid configuration, because a windows thread cannot be attached to processors across group boundary.
 static const char* const kOrtSessionOptionsConfigIntraOpThreadAffinities = "session.intra_op_thread_affinities";
 
+// This option enables NUMA-aware scheduling in the intra op thread pool.
+// Workers are grouped by the NUMA node of the logical processors they are attached to, and the
+// thread pool prefers to hand work to, and steal work from, workers on the same node as the submitting thread.
+// Option values:
+// - "0": NUMA-aware scheduling is disabled. [DEFAULT]
+// - "1": NUMA-aware scheduling is enabled.
+// Note:
+// 1. It only takes effect when thread affinities are set, either by "session.intra_op_thread_affinities"
+//    or by the default per-core affinities, and the workers span more than one NUMA node.
+// 2. Applies only to internal thread-pools.
+static const char* const kOrtSessionOptionsConfigIntraOpNumaAwareScheduling = "session.intra_op_numa_aware_scheduling";
+
+// This option replicates the prepacked weights of the CPU MatMul kernel in the memory of each NUMA node of the intra
+// op thread pool, and each worker reads the copy of its node. This avoids streaming the weights across the socket
+// interconnect on multi-socket hosts, at the cost of one copy of the weights per node.
+// Option values:
+// - "0": the weights aren't replicated. [DEFAULT]
+// - "1": the weights are replicated.
+// Note:
+// 1. It only takes effect with "session.intra_op_numa_aware_scheduling" when the workers span more than one node.
+// 2. The copies are made by the first run of each kernel.
+static const char* const kOrtSessionOptionsConfigNumaReplicatePrepackedWeights =
+    "session.numa_replicate_prepacked_weights";
+
+// Priority class of the parallel loops of the runs of the session in the intra-op thread pool.
+// Option values:
+// - "low"
+// - "normal" [DEFAULT]
+// - "high"
+// When the intra-op thread pool is shared by several sessions (global thread pools), the worker threads helping
+// with a loop of a lower priority class leave it at the next block boundary while a loop of a higher priority class
+// is running, so latency critical sessions aren't held up by the large parallel loops of other sessions.
+// The thread running a loop always completes it. Can be overridden per run with
+// kOrtRunOptionsConfigIntraOpThreadPoolPriority.
+static const char* const kOrtSessionOptionsConfigIntraOpThreadPoolPriority = "session.intra_op_thread_pool_priority";
+
 // This option will dump out the model to assist debugging any issues with layout transformation,
 // and is primarily intended for developer usage. It is only relevant if an execution provider that requests
 // NHWC layout is enabled such as NNAPI, XNNPACK or QNN.
@@ -265,8 +523,200 @@ static const char* const kOrtSessionOptionEpContextFilePath = "ep.context_file_p
 // "1": dump the EP context into the Onnx model. (default).
 static const char* const kOrtSessionOptionEpContextEmbedMode = "ep.context_embed_mode";
 
+// Share the EP contexts loaded from EP context models between sessions.
+// Graphs in an EP context binary that the loading session doesn't use are kept, and a later session with an EPContext
+// node for one of them uses the already loaded context instead of loading the binary again. e.g. the prefill and
+// decode graphs of an LLM compiled into one context binary can be run by two sessions with one copy of the weights.
+// "0": disable. (default)
+// "1": enable.
+static const char* const kOrtSessionOptionShareEpContexts = "ep.share_ep_contexts";
+
 // Gemm fastmath mode provides fp32 gemm acceleration with bfloat16 based matmul.
 // Option values:
 // - "0": Gemm FastMath mode is not enabled. [DEFAULT]
 // - "1": Gemm FastMath mode is enabled.
 static const char* const kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16 = "mlas.enable_gemm_fastmath_arm64_bfloat16";
+
+// Gemm fastmath mode for x64 processors with AVX512_BF16 or AMX-BF16 support. The fp32 inputs of
+// MatMul are rounded to bfloat16 and the products are accumulated in fp32.
+// Option values:
+// - "0": Gemm FastMath mode is not enabled. [DEFAULT]
+// - "1": Gemm FastMath mode is enabled.
+static const char* const kOrtSessionOptionsMlasGemmFastMathX64Bfloat16 = "mlas.enable_gemm_fastmath_x64_bfloat16";
+
+// Sparse weight GEMM for the CPU MatMul operator. A 2D float initializer B with 2:4 structured sparsity along K
+// (at most two non-zero elements in each group of four consecutive elements of a column) is detected when it is
+// prepacked at session initialization, and only its non-zero elements are kept and multiplied.
+// Option values:
+// - "0": Sparse weight GEMM is not enabled. [DEFAULT]
+// - "1": Sparse weight GEMM is enabled.
+static const char* const kOrtSessionOptionsMlasSparse24Gemm = "mlas.enable_sparse24_gemm";
+
+// Winograd convolution for the CPU Conv operator. 2D 3x3 convolutions with unit strides and dilations and at
+// least 16 input channels and filters are computed with the Winograd F(4x4, 3x3) algorithm, which needs fewer
+// multiplies but rounds differently from the default algorithms.
+// Option values:
+// - "0": Winograd convolution is not enabled. [DEFAULT]
+// - "1": Winograd convolution is enabled.
+static const char* const kOrtSessionOptionsMlasConvWinograd = "mlas.enable_conv_winograd";
+
+// TunableOp for the CPU execution provider. Tunable CPU kernels (currently the float MatMul thread partitioning) time
+// their candidate implementations on the first run of each shape and keep the fastest in the EP's TuningResults.
+// The results can be read back with the session's tuning results API and saved into the model metadata, so later
+// sessions on hosts with the same CPU ISA use them without tuning again.
+// Option values:
+// - "0": TunableOp is not enabled for the CPU EP unless tuning results are loaded. [DEFAULT]
+// - "1": TunableOp is enabled, previously tuned results are used.
+static const char* const kOrtSessionOptionsConfigCpuTunableOpEnable = "session.cpu_tunable_op_enable";
+
+// Option values:
+// - "0": Shapes without tuning results use the default implementation. [DEFAULT]
+// - "1": Shapes without tuning results are tuned on first use. Requires session.cpu_tunable_op_enable.
+static const char* const kOrtSessionOptionsConfigCpuTunableOpTuningEnable = "session.cpu_tunable_op_tuning_enable";
+
+// Upper bound in milliseconds of the time spent timing each candidate implementation. "0" means no bound. [DEFAULT]
+static const char* const kOrtSessionOptionsConfigCpuTunableOpMaxTuningDurationMs =
+    "session.cpu_tunable_op_max_tuning_duration_ms";
+
+// In-process tensor parallelism. A model is split over N CUDA devices by creating N sessions of the same model in one
+// process, the session of rank r running on CUDA device r. No MPI launch and no pre-sharded model are required:
+// - the MLP blocks of the model, i.e. MatMul -> [Add bias] -> activation -> MatMul with constant weights, are
+//   sharded Megatron style, the first weight by columns and the second weight by rows, and an AllReduce summing the
+//   partial results of the ranks is inserted after the second MatMul.
+// - the collective ops of the sessions use NCCL communicators created in the process for devices 0 to N - 1.
+// The N sessions must be run concurrently, e.g. one thread per session, with the same inputs.
+// Requires a build with NCCL. Default is "0", tensor parallelism is disabled.
+static const char* const kOrtSessionOptionsConfigTensorParallelWorldSize = "session.tensor_parallel_world_size";
+
+// The rank of the session for kOrtSessionOptionsConfigTensorParallelWorldSize, in [0, world size).
+static const char* const kOrtSessionOptionsConfigTensorParallelRank = "session.tensor_parallel_rank";
+
+// Pipeline parallelism. A model is split by layer into N stages by creating N sessions of the same model, the session
+// of stage s only keeping the nodes of stage s. The nodes are split in topological order into contiguous stages of
+// about the same size of weights. The inputs of a stage are the model inputs and the outputs of earlier stages it
+// consumes, its outputs are the model outputs and the values later stages consume, so the stages are chained by
+// feeding each stage the outputs of the stages before it. Each stage session can run on its own device, e.g. with
+// the CUDA EP on device s, and the micro-batches of a batch can be pipelined by running stage s on micro-batch i
+// while stage s + 1 runs micro-batch i - 1. Binding the inputs of a stage to the device of the previous stage with
+// IOBinding lets the CUDA EP copy the boundary values peer to peer.
+// Default is "1", the model is not split.
+static const char* const kOrtSessionOptionsConfigPipelineNumStages = "session.pipeline_num_stages";
+
+// The stage of the session for kOrtSessionOptionsConfigPipelineNumStages, in [0, number of stages).
+static const char* const kOrtSessionOptionsConfigPipelineStage = "session.pipeline_stage";
+
+// Back the large CPU buffers of the session, i.e. the regions of the CPU arena, and so the initializers and the
+// prepacked weights, with large pages (2 MB transparent huge pages or hugetlbfs pages on Linux, large pages on
+// Windows, which require the "Lock pages in memory" privilege). This reduces the TLB misses of the GEMMs streaming
+// big weights. Regular pages are used when large pages are unavailable.
+// Applies to the CPU execution provider the session adds when none is registered.
+// "0": disabled. [DEFAULT]
+// "1": enabled.
+static const char* const kOrtSessionOptionsConfigUseLargePages = "session.use_large_pages";
+
+// Lay out all trainable parameters of a training Module in one contiguous buffer, and their gradients in a second
+// one, each parameter and gradient being a view into its buffer. This lets optimizers, gradient all-reduce and
+// checkpointing work on a single flat buffer instead of one tensor per parameter.
+// Only applies when all trainable parameters have the same element type and live on the same device, the parameters
+// are kept as separate buffers otherwise.
+// "0": disabled. [DEFAULT]
+// "1": enabled.
+static const char* const kOrtSessionOptionsConfigTrainingContiguousParameters = "training.contiguous_parameters";
+
+// Assigns the collective communication nodes of a device (NcclAllReduce, NcclAllGather, NcclReduceScatter and the
+// AllReduce, AllGather and AllToAll contrib ops) to their own logic stream, separate from the compute nodes of that
+// device. A collective then starts as soon as its inputs are ready, e.g. the all-reduce of a gradient bucket overlaps
+// with the rest of the backward pass.
+// Only applies when the streams are not given by kNodePartitionConfigFile.
+// "0": collective nodes run on the compute stream of their device. [DEFAULT]
+// "1": collective nodes run on a dedicated collective stream per device.
+static const char* const kOrtSessionOptionsConfigUseDedicatedCollectiveStream = "session.use_dedicated_collective_stream";
+
+// Defers the pre-packing of the constant initializers of a node to the first time its kernel runs, instead of
+// pre-packing all of them during session initialization. Initializers, e.g. memory mapped external data, are then
+// only read and converted for the kernels that actually run, which shortens the session initialization of large
+// models that use a few of their branches. The unpacked initializers are kept alive, as it is not known whether
+// kernels that didn't run yet need them unpacked.
+// Has no effect when pre-packing is disabled with kOrtSessionOptionsConfigDisablePrepacking.
+// "0": constant initializers are pre-packed during session initialization. [DEFAULT]
+// "1": constant initializers are pre-packed the first time a kernel needs them.
+static const char* const kOrtSessionOptionsConfigLazyPrepacking = "session.lazy_prepacking";
+
+// Materializes the constant initializers on a background thread once the session is initialized: completes the
+// pre-packing deferred by kOrtSessionOptionsConfigLazyPrepacking and touches the pages of the initializers in CPU
+// memory, so the first requests neither pre-pack nor page fault while the session is already available.
+// "0": disabled. [DEFAULT]
+// "1": enabled.
+static const char* const kOrtSessionOptionsConfigPrefaultInitializers = "session.prefault_initializers";
+
+// Maximum number of initializers that are deserialized, or nodes whose constant initializers are pre-packed,
+// concurrently on the intra-op thread pool during session initialization. Bounds the temporary memory used while
+// loading. Initializers placed on non-CPU devices are still created one after another, and pre-packing stays serial
+// when pre-packed weights are shared between sessions or cached in a file.
+// "1": initializers are processed one after another. [DEFAULT]
+// "0": use the degree of parallelism of the intra-op thread pool.
+// Any other positive value is capped at the degree of parallelism of the intra-op thread pool.
+static const char* const kOrtSessionOptionsConfigInitializerLoadConcurrency = "session.initializer_load_concurrency";
+
+// Compresses the initializer data of the main graph when the optimized model is saved in ORT format, which reduces
+// the size of the model file for distribution. Initializers that don't get smaller are stored uncompressed.
+// Compressed initializers are decompressed when the model is loaded, so they can't be used directly from the model
+// bytes, see kOrtSessionOptionsConfigUseORTModelBytesForInitializers.
+// "none": initializers are stored uncompressed. [DEFAULT]
+// "lz4": LZ4 block compression.
+// "byte_shuffle_lz4": LZ4 block compression after grouping the bytes of the tensor elements by significance.
+//   Usually compresses float and float16 weights much better than "lz4".
+static const char* const kOrtSessionOptionsConfigSaveOrtFormatInitializerCompression =
+    "session.save_ort_format_initializer_compression";
+
+// Copies the CPU feeds that the run copies to a device to pinned memory first, so that the device copies are
+// asynchronous on the stream of the consuming nodes and overlap with the computation of the nodes that are already
+// running, instead of blocking the host until each copy of pageable memory completes.
+// Requires a pinned allocator registered by the execution provider of the device, e.g. CUDA or ROCm; feeds are
+// copied directly otherwise. The pinned buffers are released once the run completed.
+// "0": disabled. [DEFAULT]
+// "1": enabled.
+static const char* const kOrtSessionOptionsConfigStageFeedsInPinnedMemory = "session.stage_feeds_in_pinned_memory";
+
+// Directory where the TunableOp results of the execution providers are cached across sessions and processes, e.g.
+// ROCm and CUDA. Cached results are loaded when the session is initialized and the results, including any ops tuned
+// while running, are written back when the session is destroyed. One file is kept per execution provider and
+// environment: the file name is derived from the ORT build and the library versions and device model the results
+// were tuned with, so results are never applied to a different device or library version.
+// Loading cached results does not enable TunableOp; enable it with the provider options of the execution provider.
+// The directory is created if it doesn't exist. Disabled if empty. [DEFAULT]
+static const char* const kOrtSessionOptionsConfigTuningResultsCacheDir = "session.tuning_results_cache_dir";
+
+// Comma-separated names of intermediate values of the main graph at which Runs can be cut, to run a model in stages
+// without exporting a model per stage, e.g. to cache encoder results, split a pipeline across hosts or exit early.
+// The cut values become additional outputs of the model that can also be fed:
+// - A Run fetching cut values only executes the nodes they depend on. The fetched values stay on the device that
+//   produced them and hold the state needed to resume.
+// - A Run feeding cut values resumes from them: the nodes producing them and the nodes only they depend on are
+//   skipped. The graph inputs consumed by skipped nodes don't need to be fed.
+// Every output of the node producing a cut value that is consumed by other nodes must be a cut value too.
+// Only supported for ONNX models. Disabled if empty. [DEFAULT]
+static const char* const kOrtSessionOptionsConfigPartialRunCutValues = "session.partial_run_cut_values";
+
+// Early exit points of the main graph, to run a model as a cascade that stops as soon as an intermediate prediction
+// is confident enough, e.g. the auxiliary classifiers of a multi-exit network.
+// The format is "predicate:output1,output2;predicate:output1,output2", with the exit points ordered from the
+// shallowest to the deepest. The predicate is a boolean value with one element computed by the model. The outputs
+// of an exit point are returned in place of the model outputs, in the same order and with the same types.
+// A Run executes the nodes of each exit point in turn and stops at the first one whose predicate is true; the rest
+// of the graph is only executed if no predicate is true.
+// Runs fetching values other than the model outputs, providing pre-allocated outputs, or using a plan with more than
+// one stream or with streamed weights execute the whole graph.
+// Only supported for ONNX models. Disabled if empty. [DEFAULT]
+static const char* const kOrtSessionOptionsConfigEarlyExitPoints = "session.early_exit_points";
+
+// Models to append to the loaded model, so a pipeline of models, e.g. preprocessing, backbone and postprocessing,
+// runs as one graph: the stages share the thread pools and the memory plan, and the values passed between them are
+// not copied. Concurrent Runs of the session overlap the stages of different requests.
+// The format is "stage1.onnx|output=input,output=input;stage2.onnx|output=input". Each input of a stage listed is
+// connected to the output of the model composed so far, which stops being a model output. The other inputs of the
+// stage become model inputs, shared with an existing model input of the same name and type, and the outputs of the
+// stage become model outputs. The nodes and intermediate values of stage N are prefixed with "stage<N>/".
+// The opsets imported by the models must be compatible.
+// Only supported for ONNX models. Disabled if empty. [DEFAULT]
+static const char* const kOrtSessionOptionsConfigComposeModels = "session.compose_models";
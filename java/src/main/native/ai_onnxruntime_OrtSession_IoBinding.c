@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2024 Microsoft Corporation. All rights reserved.
+ * Licensed under the MIT License.
+ */
+#include <jni.h>
+#include <string.h>
+#include "onnxruntime/core/session/onnxruntime_c_api.h"
+#include "OrtJniUtil.h"
+#include "ai_onnxruntime_OrtSession_IoBinding.h"
+
+/*
+ * The IoBinding holds a reference to every bound OrtValue, so a tensor created over a direct ByteBuffer can be bound
+ * once and reused by every run without copying it. The Java side keeps the ByteBuffer reachable while it's bound.
+ */
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    createIoBinding
+ * Signature: (JJ)J
+ */
+JNIEXPORT jlong JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_createIoBinding
+  (JNIEnv * jniEnv, jclass jclazz, jlong apiHandle, jlong sessionHandle) {
+    (void) jclazz; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    OrtIoBinding* binding = NULL;
+    checkOrtStatus(jniEnv, api, api->CreateIoBinding((OrtSession*) sessionHandle, &binding));
+    return (jlong) binding;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    bindInput
+ * Signature: (JJLjava/lang/String;J)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_bindInput
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle, jstring name, jlong valueHandle) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    const char* nameStr = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+    checkOrtStatus(jniEnv, api, api->BindInput((OrtIoBinding*) nativeHandle, nameStr, (const OrtValue*) valueHandle));
+    (*jniEnv)->ReleaseStringUTFChars(jniEnv, name, nameStr);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    bindOutput
+ * Signature: (JJLjava/lang/String;J)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_bindOutput
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle, jstring name, jlong valueHandle) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    const char* nameStr = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+    // A preallocated output, e.g. a tensor over a direct ByteBuffer, is written in place by every run.
+    checkOrtStatus(jniEnv, api, api->BindOutput((OrtIoBinding*) nativeHandle, nameStr, (const OrtValue*) valueHandle));
+    (*jniEnv)->ReleaseStringUTFChars(jniEnv, name, nameStr);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    bindOutputToDevice
+ * Signature: (JJLjava/lang/String;J)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_bindOutputToDevice
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle, jstring name, jlong memoryInfoHandle) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    const char* nameStr = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+    checkOrtStatus(jniEnv, api, api->BindOutputToDevice((OrtIoBinding*) nativeHandle, nameStr,
+                                                        (const OrtMemoryInfo*) memoryInfoHandle));
+    (*jniEnv)->ReleaseStringUTFChars(jniEnv, name, nameStr);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    clearBoundInputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_clearBoundInputs
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle) {
+    (void) jniEnv; (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    api->ClearBoundInputs((OrtIoBinding*) nativeHandle);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    clearBoundOutputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_clearBoundOutputs
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle) {
+    (void) jniEnv; (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    api->ClearBoundOutputs((OrtIoBinding*) nativeHandle);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    synchronizeBoundInputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_synchronizeBoundInputs
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    checkOrtStatus(jniEnv, api, api->SynchronizeBoundInputs((OrtIoBinding*) nativeHandle));
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    synchronizeBoundOutputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_synchronizeBoundOutputs
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    checkOrtStatus(jniEnv, api, api->SynchronizeBoundOutputs((OrtIoBinding*) nativeHandle));
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    run
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_run
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong sessionHandle, jlong nativeHandle, jlong runOptionsHandle) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    checkOrtStatus(jniEnv, api, api->RunWithBinding((OrtSession*) sessionHandle, (const OrtRunOptions*) runOptionsHandle,
+                                                    (const OrtIoBinding*) nativeHandle));
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    getBoundOutputNames
+ * Signature: (JJJ)[Ljava/lang/String;
+ */
+JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_getBoundOutputNames
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle, jlong allocatorHandle) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    OrtAllocator* allocator = (OrtAllocator*) allocatorHandle;
+    char* buffer = NULL;
+    size_t* lengths = NULL;
+    size_t count = 0;
+    OrtErrorCode code = checkOrtStatus(jniEnv, api, api->GetBoundOutputNames((const OrtIoBinding*) nativeHandle,
+                                                                             allocator, &buffer, &lengths, &count));
+    if (code != ORT_OK) {
+      return NULL;
+    }
+
+    jclass stringClazz = (*jniEnv)->FindClass(jniEnv, "java/lang/String");
+    jobjectArray names = (*jniEnv)->NewObjectArray(jniEnv, safecast_size_t_to_jsize(count), stringClazz, NULL);
+    // The names are concatenated in the buffer without terminators.
+    char* name = NULL;
+    size_t maxLength = 0;
+    for (size_t i = 0; i < count; i++) {
+      maxLength = lengths[i] > maxLength ? lengths[i] : maxLength;
+    }
+    name = malloc(maxLength + 1);
+    if (name == NULL) {
+      throwOrtException(jniEnv, 1, "Not enough memory");
+      names = NULL;
+    } else {
+      size_t offset = 0;
+      for (size_t i = 0; i < count; i++) {
+        memcpy(name, buffer + offset, lengths[i]);
+        name[lengths[i]] = '\0';
+        offset += lengths[i];
+        jstring nameStr = (*jniEnv)->NewStringUTF(jniEnv, name);
+        (*jniEnv)->SetObjectArrayElement(jniEnv, names, safecast_size_t_to_jsize(i), nameStr);
+        (*jniEnv)->DeleteLocalRef(jniEnv, nameStr);
+      }
+      free(name);
+    }
+
+    if (buffer != NULL) {
+      checkOrtStatus(jniEnv, api, api->AllocatorFree(allocator, buffer));
+    }
+    if (lengths != NULL) {
+      checkOrtStatus(jniEnv, api, api->AllocatorFree(allocator, lengths));
+    }
+    return names;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    getBoundOutputValues
+ * Signature: (JJJ[Lai/onnxruntime/OnnxValue;)V
+ *
+ * Fills outputValues with the bound outputs in the order of getBoundOutputNames. The slots already holding the
+ * Java value of a preallocated output are left as they are, so reused outputs create no new Java objects.
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_getBoundOutputValues
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle, jlong allocatorHandle, jobjectArray outputValuesArr) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    OrtAllocator* allocator = (OrtAllocator*) allocatorHandle;
+    OrtValue** values = NULL;
+    size_t count = 0;
+    OrtErrorCode code = checkOrtStatus(jniEnv, api, api->GetBoundOutputValues((const OrtIoBinding*) nativeHandle,
+                                                                              allocator, &values, &count));
+    if (code != ORT_OK) {
+      return;
+    }
+
+    jsize numSlots = (*jniEnv)->GetArrayLength(jniEnv, outputValuesArr);
+    for (size_t i = 0; i < count; i++) {
+      jsize slot = safecast_size_t_to_jsize(i);
+      jobject existing = slot < numSlots ? (*jniEnv)->GetObjectArrayElement(jniEnv, outputValuesArr, slot) : NULL;
+      if (slot < numSlots && existing == NULL && !(*jniEnv)->ExceptionCheck(jniEnv)) {
+        // The Java value takes the ownership of the OrtValue.
+        jobject onnxValue = convertOrtValueToONNXValue(jniEnv, api, allocator, values[i]);
+        if (onnxValue != NULL) {
+          (*jniEnv)->SetObjectArrayElement(jniEnv, outputValuesArr, slot, onnxValue);
+          (*jniEnv)->DeleteLocalRef(jniEnv, onnxValue);
+          continue;
+        }
+      }
+      if (existing != NULL) {
+        (*jniEnv)->DeleteLocalRef(jniEnv, existing);
+      }
+      // The value isn't handed to Java, release the reference GetBoundOutputValues added.
+      api->ReleaseValue(values[i]);
+    }
+
+    checkOrtStatus(jniEnv, api, api->AllocatorFree(allocator, values));
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IoBinding
+ * Method:    close
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IoBinding_close
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle) {
+    (void) jniEnv; (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    api->ReleaseIoBinding((OrtIoBinding*) nativeHandle);
+}
@@ -42,6 +42,17 @@ class Attention : public OpKernel, public AttentionCPUBase {
                                size_t input_hidden_size, const T* weights_data,
                                size_t weight_matrix_col_size, PrePackedWeights* prepacked_weights);
 
+  // Computes the S x H_t projection of one head of Q, K or V for one batch, with the bias, into qkv_dest.
+  void ProjectHead(const AttentionParameters& parameters, const T* input_data, const T* weights_data,
+                   const T* bias_data, int batch_index, int head_index, int qkv_index, T* qkv_dest) const;
+
+  // Computes the attention without past or present state one (batch, head) at a time: the Q, K and V of the head are
+  // projected into a buffer of the thread and attended to right away, so the projections of all the heads are never
+  // materialized and the output is written directly in its BxSxNxH_v layout.
+  Status ComputeFusedHeads(const AttentionParameters& parameters, const T* input_data, const T* weights_data,
+                           const T* bias_data, const Tensor* mask_index, Tensor* output,
+                           OpKernelContext* context) const;
+
   std::array<IAllocatorUniquePtr<void>, 3> packed_weights_;
   size_t packed_weights_size_[3] = {0, 0, 0};
   bool is_prepack_ = false;
@@ -190,6 +201,146 @@ Status Attention<T>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& pre
   return Status::OK();
 }
 
+template <typename T>
+void Attention<T>::ProjectHead(const AttentionParameters& parameters, const T* input_data, const T* weights_data,
+                               const T* bias_data, int batch_index, int head_index, int qkv_index,
+                               T* qkv_dest) const {
+  const int sequence_length = parameters.sequence_length;
+  const int input_hidden_size = parameters.input_hidden_size;
+  const int qkv_hidden_size = parameters.hidden_size + parameters.hidden_size + parameters.v_hidden_size;
+  const int head_size = qkv_index == 2 ? parameters.v_head_size : parameters.head_size;
+
+  int input_offset = batch_index * sequence_length * input_hidden_size;
+
+  int weights_offset = 0;
+  int bias_offset = qkv_index * parameters.hidden_size + head_index * head_size;
+
+  if (!is_prepack_) {
+    weights_offset = bias_offset;
+  } else {
+    weights_offset = head_index * head_size;
+  }
+
+  // TODO!! memcpy here makes it not worthwhile to use Gemm batch. Possible to post process?
+  // broadcast NH -> (B.N.S.H) for each of Q, K, V
+  const T* broadcast_data_src = bias_data + bias_offset;
+  T* broadcast_data_dest = qkv_dest;
+
+  for (int seq_index = 0; seq_index < sequence_length; seq_index++) {
+    memcpy(broadcast_data_dest, broadcast_data_src, head_size * sizeof(T));
+    broadcast_data_dest += head_size;
+  }
+
+  //                   original           transposed            iteration
+  // A: input          (BxSxD_i)          (B.)S x D_i           S x D_i
+  // B: weights        (D_ixNxH_t)        D_i x (N.)H_t         D_i x H_t
+  // C: QKV[qkv_index] (BxNxSxH_t)        (B.N.)S x H_t         S x H_t
+  // Here H_t = H + H + H_v is size of one head of Q, K and V
+  if (is_prepack_) {
+    uint8_t* packed_weight;
+    packed_weight = static_cast<uint8_t*>(packed_weights_[qkv_index].get()) +
+                    packed_weights_size_[qkv_index] * (weights_offset / head_size);
+
+    MlasGemm(
+        CblasNoTrans,               // TransA = no
+        sequence_length,            // M      = S
+        head_size,                  // N      = H
+        input_hidden_size,          // K      = D
+        1.0f,                       // alpha
+        input_data + input_offset,  // A
+        input_hidden_size,          // lda    = D
+        packed_weight,              // B
+        1.0f,                       // beta
+        qkv_dest,                   // C
+        head_size,                  // ldc
+        nullptr);                   // use single-thread
+  } else {
+    math::GemmEx<float, ThreadPool>(
+        CblasNoTrans,                   // TransA = no
+        CblasNoTrans,                   // TransB = no
+        sequence_length,                // M      = S
+        head_size,                      // N      = H
+        input_hidden_size,              // K      = D
+        1.0f,                           // alpha
+        input_data + input_offset,      // A
+        input_hidden_size,              // lda    = D
+        weights_data + weights_offset,  // B
+        qkv_hidden_size,                // ldb    = D + D + D_v
+        1.0f,                           // beta
+        qkv_dest,                       // C
+        head_size,                      // ldc
+        nullptr                         // use single-thread
+    );
+  }
+}
+
+template <typename T>
+Status Attention<T>::ComputeFusedHeads(const AttentionParameters& parameters, const T* input_data,
+                                       const T* weights_data, const T* bias_data, const Tensor* mask_index,
+                                       Tensor* output, OpKernelContext* context) const {
+  const int batch_size = parameters.batch_size;
+  const int sequence_length = parameters.sequence_length;
+  const int head_size = parameters.head_size;
+  const int v_head_size = parameters.v_head_size;
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  BufferUniquePtr mask_data_buffer = PrepareMaskData<T>(mask_index, false, batch_size, sequence_length, 0,
+                                                        sequence_length, allocator);
+  const T* mask_data = static_cast<const T*>(mask_data_buffer.get());
+
+  // Q, K and V of one head
+  const size_t head_buffer_size = SafeInt<size_t>(sequence_length) * (head_size + head_size + v_head_size);
+
+  MLAS_FLASH_ATTENTION_PARAMS params;
+  params.BatchSize = 1;
+  params.NumHeads = 1;
+  params.KvNumHeads = 1;
+  params.QSequenceLength = static_cast<size_t>(sequence_length);
+  params.KvSequenceLength = static_cast<size_t>(sequence_length);
+  params.QkHeadSize = static_cast<size_t>(head_size);
+  params.VHeadSize = static_cast<size_t>(v_head_size);
+  params.Scale = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+  params.OutputRowStride = static_cast<size_t>(parameters.v_hidden_size);
+  T* output_data = output->MutableData<T>();
+
+  const double cost = static_cast<double>(sequence_length) *
+                      (static_cast<double>(head_size + head_size + v_head_size) * parameters.input_hidden_size +
+                       static_cast<double>(head_size + v_head_size) * sequence_length);
+
+  ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(batch_size) * num_heads_, cost,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        auto head_buffer = IAllocator::MakeUniquePtr<T>(allocator, head_buffer_size);
+        T* Q = head_buffer.get();
+        T* K = Q + static_cast<size_t>(sequence_length) * head_size;
+        T* V = K + static_cast<size_t>(sequence_length) * head_size;
+
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          const int batch_index = static_cast<int>(i / num_heads_);
+          const int head_index = static_cast<int>(i % num_heads_);
+
+          ProjectHead(parameters, input_data, weights_data, bias_data, batch_index, head_index, 0, Q);
+          ProjectHead(parameters, input_data, weights_data, bias_data, batch_index, head_index, 1, K);
+          ProjectHead(parameters, input_data, weights_data, bias_data, batch_index, head_index, 2, V);
+
+          MLAS_FLASH_ATTENTION_PARAMS head_params = params;
+          head_params.Query = Q;
+          head_params.Key = K;
+          head_params.Value = V;
+          if (mask_data != nullptr) {
+            head_params.Mask = mask_data + SafeInt<size_t>(batch_index) * sequence_length * sequence_length;
+          }
+          head_params.Output = output_data + SafeInt<size_t>(batch_index) * sequence_length * parameters.v_hidden_size +
+                               static_cast<size_t>(head_index) * v_head_size;
+          MlasFlashAttention(head_params, nullptr);
+        }
+      });
+
+  return Status::OK();
+}
+
 template <typename T>
 Status Attention<T>::Compute(OpKernelContext* context) const {
   const Tensor* input = context->Input<Tensor>(0);
@@ -227,12 +378,26 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
   output_shape[2] = static_cast<int64_t>(parameters.v_hidden_size);
   Tensor* output = context->Output(0, output_shape);
 
+  auto* tp = context->GetOperatorThreadPool();
+
+  // Without past or present state, attend to the heads as soon as they are projected, unless there are too few heads
+  // to keep the threads busy: below, the attention of a head also runs in parallel over its rows.
+  if (past == nullptr && relative_position_bias == nullptr && sparse_block_size_ == 0 &&
+      static_cast<std::ptrdiff_t>(batch_size) * num_heads_ >= ThreadPool::DegreeOfParallelism(tp)) {
+    int past_sequence_length = 0;
+    Tensor* present = GetPresent(context, past, batch_size, parameters.v_head_size, sequence_length,
+                                 past_sequence_length);
+    if (present == nullptr) {
+      return ComputeFusedHeads(parameters, input->Data<T>(), weights ? weights->Data<T>() : nullptr,
+                               bias->Data<T>(), mask_index, output, context);
+    }
+  }
+
   constexpr size_t element_size = sizeof(T);
 
   AllocatorPtr allocator;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
 
-  auto* tp = context->GetOperatorThreadPool();
   // Compute Q, K, V
   // gemm_data(BS, D_t) = input(BS, D_i) x weights(D_i, D_t) + bias(D_t), where D_t = D + D + D_v
   // Hidden dimension of input could be larger than that of Q, K and V when model is pruned.
@@ -262,73 +427,11 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
         const int batch_index = static_cast<int>((i / 3) / num_heads_);
         const int head_index = static_cast<int>((i / 3) % num_heads_);
         const int qkv_index = static_cast<int>(i % 3);
+        const int head_size = qkv_head_size[qkv_index];
+        const int qkv_offset = (batch_index * num_heads_ + head_index) * (sequence_length * head_size);
 
-        int input_offset = batch_index * sequence_length * input_hidden_size;
-
-        T* qkv_dest = QKV[qkv_index];
-        int head_size = qkv_head_size[qkv_index];
-        int weights_offset = 0;
-        int bias_offset = qkv_index * parameters.hidden_size + head_index * head_size;
-
-        if (!is_prepack_) {
-          weights_offset = bias_offset;
-        } else {
-          weights_offset = head_index * head_size;
-        }
-
-        int qkv_offset = (batch_index * num_heads_ + head_index) * (sequence_length * head_size);
-
-        // TODO!! memcpy here makes it not worthwhile to use Gemm batch. Possible to post process?
-        // broadcast NH -> (B.N.S.H) for each of Q, K, V
-        const T* broadcast_data_src = bias_data + bias_offset;
-        T* broadcast_data_dest = QKV[qkv_index] + qkv_offset;
-
-        for (int seq_index = 0; seq_index < sequence_length; seq_index++) {
-          memcpy(broadcast_data_dest, broadcast_data_src, head_size * sizeof(T));
-          broadcast_data_dest += head_size;
-        }
-
-        //                   original           transposed            iteration
-        // A: input          (BxSxD_i)          (B.)S x D_i           S x D_i
-        // B: weights        (D_ixNxH_t)        D_i x (N.)H_t         D_i x H_t
-        // C: QKV[qkv_index] (BxNxSxH_t)        (B.N.)S x H_t         S x H_t
-        // Here H_t = H + H + H_v is size of one head of Q, K and V
-        if (is_prepack_) {
-          uint8_t* packed_weight;
-          packed_weight = static_cast<uint8_t*>(packed_weights_[qkv_index].get()) +
-                          packed_weights_size_[qkv_index] * (weights_offset / head_size);
-
-          MlasGemm(
-              CblasNoTrans,               // TransA = no
-              sequence_length,            // M      = S
-              head_size,                  // N      = H
-              input_hidden_size,          // K      = D
-              1.0f,                       // alpha
-              input_data + input_offset,  // A
-              input_hidden_size,          // lda    = D
-              packed_weight,              // B
-              1.0f,                       // beta
-              qkv_dest + qkv_offset,      // C
-              head_size,                  // ldc
-              nullptr);                   // use single-thread
-        } else {
-          math::GemmEx<float, ThreadPool>(
-              CblasNoTrans,                   // TransA = no
-              CblasNoTrans,                   // TransB = no
-              sequence_length,                // M      = S
-              head_size,                      // N      = H
-              input_hidden_size,              // K      = D
-              1.0f,                           // alpha
-              input_data + input_offset,      // A
-              input_hidden_size,              // lda    = D
-              weights_data + weights_offset,  // B
-              qkv_hidden_size,                // ldb    = D + D + D_v
-              1.0f,                           // beta
-              qkv_dest + qkv_offset,          // C
-              head_size,                      // ldc
-              nullptr                         // use single-thread
-          );
-        }
+        ProjectHead(parameters, input_data, weights_data, bias_data, batch_index, head_index, qkv_index,
+                    QKV[qkv_index] + qkv_offset);
       }
     });
   }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstdlib>
 #include <vector>
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
@@ -48,9 +49,28 @@ class AttentionBase {
 
     past_present_share_buffer_ = info.GetAttrOrDefault<int64_t>("past_present_share_buffer", 0LL);
 
+    sparse_block_size_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("sparse_block_size", 0));
+    sparse_local_blocks_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("sparse_local_blocks", 0));
+    sparse_vert_stride_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("sparse_vert_stride", 0));
+    sparse_global_blocks_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("sparse_global_blocks", 0));
+    ORT_ENFORCE(sparse_block_size_ >= 0 && sparse_local_blocks_ >= 0 && sparse_vert_stride_ >= 0 &&
+                    sparse_global_blocks_ >= 0,
+                "The sparse_* attributes must not be negative.");
+    ORT_ENFORCE(sparse_block_size_ == 0 || sparse_local_blocks_ > 0 || sparse_vert_stride_ > 0 ||
+                    sparse_global_blocks_ > 0,
+                "sparse_block_size needs sparse_local_blocks, sparse_vert_stride or sparse_global_blocks.");
+
     require_same_hidden_size_ = require_same_hidden_size;
   }
 
+  // Whether the block of queries at q_block attends to the block of keys at kv_block when sparse_block_size_ > 0.
+  // The blocks are counted from the first token of the total sequence.
+  bool IsSparseBlockAttended(int q_block, int kv_block) const {
+    return q_block < sparse_global_blocks_ || kv_block < sparse_global_blocks_ ||
+           std::abs(q_block - kv_block) < sparse_local_blocks_ ||
+           (sparse_vert_stride_ > 0 && (kv_block + 1) % sparse_vert_stride_ == 0);
+  }
+
   Status CheckMask(const Tensor* mask_index,
                    AttentionMaskType& mask_type,
                    int64_t& max_sequence_length,  // output: max_sequence_length when mask_index is 4D tensor
@@ -76,6 +96,10 @@ class AttentionBase {
   int rotary_embedding_;                   // rotary embedding dimension
   float mask_filter_value_;                // the value to be used for filtered out positions
   float scale_;                            // the scale to be used for softmax
+  int sparse_block_size_;                  // tokens per block of the block sparse pattern, 0 for dense attention
+  int sparse_local_blocks_;                // blocks of keys around the diagonal attended by a block of queries
+  int sparse_vert_stride_;                 // every sparse_vert_stride_-th block of keys is attended by all the queries
+  int sparse_global_blocks_;               // leading blocks that attend to and are attended by all the blocks
 };
 
 }  // namespace contrib
@@ -103,7 +103,8 @@ struct GroupQueryAttentionParameters {
   int local_window_size;
   bool kv_share_buffer;
   bool is_packed_qkv;
-  bool is_prompt;  // determines if seqlens_k is past or kv sequence length tensor
+  bool is_prompt;             // determines if seqlens_k is past or kv sequence length tensor
+  bool is_subsequent_prompt;  // a prompt chunk of more than one token appended to a non-empty KV cache
   bool do_rotary;
   bool rotary_interleaved;
   float scale;
@@ -111,6 +112,8 @@ struct GroupQueryAttentionParameters {
   AttentionQkvFormat past_kv_format;
   int zeros_count;
   int* zero_ptr;
+  int kv_block_size;            // number of tokens per block of a paged KV cache, 0 if not paged
+  int max_blocks_per_sequence;  // number of entries per sequence in the block table of a paged KV cache
 };
 
 // Parameters for sparse attention.
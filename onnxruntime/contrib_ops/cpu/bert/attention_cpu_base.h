@@ -53,28 +53,70 @@ class AttentionCPUBase : public AttentionBase {
     // Total sequence length including that of past state: T = P + L
     const int total_sequence_length = past_sequence_length + kv_sequence_length;
 
-    // Merge causal mask with padding mask, and convert values from 0/1 to -inf/0, then broadcast to 3D (BxSxT).
-    bool causal = (is_unidirectional_ && sequence_length > 1);
-    void* mask_data = nullptr;
-    if (mask_index != nullptr || causal) {
-      size_t mask_data_bytes = SafeInt<size_t>(batch_size) * sequence_length * total_sequence_length * sizeof(T);
-      mask_data = allocator->Alloc(mask_data_bytes);
-      memset(mask_data, 0, mask_data_bytes);
-    }
-    BufferUniquePtr mask_data_buffer(mask_data, BufferDeleter(allocator));
-    const int32_t* mask_index_data = mask_index != nullptr ? mask_index->Data<int32_t>() : nullptr;
-    gsl::span<const int64_t> mask_index_dims = mask_index != nullptr
-                                                   ? mask_index->Shape().GetDims()
-                                                   : gsl::span<const int64_t>{};
-    if (mask_data != nullptr) {
-      PrepareMask(mask_index_data, mask_index_dims, static_cast<T*>(mask_data),
-                  causal, batch_size, sequence_length, past_sequence_length, mask_filter_value_);
-      DUMP_CPU_TENSOR_INIT();
-      DUMP_CPU_TENSOR("Mask3D", static_cast<T*>(mask_data), batch_size, sequence_length, total_sequence_length);
+    // Without past or present state the attention probs are not needed beyond softmax x V, so compute them in
+    // blocks held in cache instead of materializing the BxNxSxT matrix.
+    bool use_flash_attention = false;
+    if constexpr (std::is_same_v<T, float>) {
+      use_flash_attention = past == nullptr && past_sequence_length == 0 && present == nullptr &&
+                            present_key == nullptr && present_value == nullptr && relative_position_bias == nullptr &&
+                            v_hidden_size == num_heads_ * v_head_size;
     }
 
+    // The blocks of a block sparse pattern are skipped by flash attention, otherwise they are masked.
+    const bool use_sparse_block_mask = sparse_block_size_ > 0 && !use_flash_attention;
+
+    BufferUniquePtr mask_data_buffer = PrepareMaskData<T>(mask_index, use_sparse_block_mask, batch_size,
+                                                          sequence_length, past_sequence_length, total_sequence_length,
+                                                          allocator);
+    void* mask_data = mask_data_buffer.get();
+
     float scale = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(qk_head_size)) : scale_;
 
+    if constexpr (std::is_same_v<T, float>) {
+      if (use_flash_attention) {
+        const size_t head_size = static_cast<size_t>(qk_head_size == 0 ? v_head_size : qk_head_size);
+
+        MLAS_FLASH_ATTENTION_PARAMS params;
+        params.BatchSize = static_cast<size_t>(batch_size);
+        params.NumHeads = static_cast<size_t>(num_heads_);
+        params.KvNumHeads = static_cast<size_t>(num_heads_);
+        params.QSequenceLength = static_cast<size_t>(sequence_length);
+        params.KvSequenceLength = static_cast<size_t>(kv_sequence_length);
+        params.QkHeadSize = head_size;
+        params.VHeadSize = static_cast<size_t>(v_head_size);
+        params.Scale = scale;
+        params.Query = Q;
+        params.QueryHeadStride = params.QSequenceLength * head_size;
+        params.QueryBatchStride = params.NumHeads * params.QueryHeadStride;
+        params.Key = K;
+        params.KeyHeadStride = params.KvSequenceLength * head_size;
+        params.KeyBatchStride = params.NumHeads * params.KeyHeadStride;
+        params.Value = V;
+        params.ValueHeadStride = params.KvSequenceLength * params.VHeadSize;
+        params.ValueBatchStride = params.NumHeads * params.ValueHeadStride;
+        params.Mask = static_cast<const float*>(mask_data);
+        params.MaskBatchStride = params.QSequenceLength * params.KvSequenceLength;
+
+        std::vector<uint8_t> block_layout;
+        if (sparse_block_size_ > 0) {
+          const int q_blocks = (sequence_length + sparse_block_size_ - 1) / sparse_block_size_;
+          const int kv_blocks = (kv_sequence_length + sparse_block_size_ - 1) / sparse_block_size_;
+          block_layout.resize(static_cast<size_t>(q_blocks) * kv_blocks);
+          for (int i = 0; i < q_blocks; i++) {
+            for (int j = 0; j < kv_blocks; j++) {
+              block_layout[static_cast<size_t>(i) * kv_blocks + j] = IsSparseBlockAttended(i, j) ? 1 : 0;
+            }
+          }
+          params.BlockLayout = block_layout.data();
+          params.SparseBlockSize = static_cast<size_t>(sparse_block_size_);
+        }
+
+        params.Output = output->MutableData<float>();
+        MlasFlashAttention(params, tp);
+        return Status::OK();
+      }
+    }
+
     const T* past_data = past != nullptr ? past->Data<T>() : nullptr;
     T* present_data = present != nullptr ? present->MutableData<T>() : nullptr;
     const T* past_key_data = past_key != nullptr ? past_key->Data<T>() : nullptr;
@@ -97,19 +139,67 @@ class AttentionCPUBase : public AttentionBase {
                              qk_head_size == 0 ? v_head_size : qk_head_size, past_data, past_key_data,
                              present_data, present_key_data, tp, scale, relative_position_bias_data);
 
-    // Compute the attentionScore * Value: out_tmp(B, N, S, H_v) = attention_probs(B, N, S, T) x V(B, N, T, H_v)
-    auto out_tmp_data =
-        allocator->Alloc(SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * v_head_size * sizeof(T));
-    BufferUniquePtr out_tmp_buffer(out_tmp_data, BufferDeleter(std::move(allocator)));
-
-    ComputeVxAttentionScore(output->MutableData<T>(), static_cast<T*>(out_tmp_data), static_cast<T*>(attention_probs),
+    // Compute the attentionScore * Value: out(B, S, N, H_v) = attention_probs(B, N, S, T) x V(B, N, T, H_v)
+    ComputeVxAttentionScore(output->MutableData<T>(), static_cast<T*>(attention_probs),
                             V, batch_size, sequence_length, kv_sequence_length, past_sequence_length, v_head_size,
                             v_hidden_size, past_data, past_value_data, present_data, present_value_data, tp);
 
     return Status::OK();
   }
 
+  // Merges the causal and block sparse masks with the padding mask, converting the values from 0/1 to -inf/0, and
+  // broadcasts the result to 3D (BxSxT). Returns an empty buffer when no mask applies.
+  template <typename T>
+  BufferUniquePtr PrepareMaskData(const Tensor* mask_index, bool use_sparse_block_mask, int batch_size,
+                                  int sequence_length, int past_sequence_length, int total_sequence_length,
+                                  AllocatorPtr allocator) const {
+    bool causal = (is_unidirectional_ && sequence_length > 1);
+    void* mask_data = nullptr;
+    if (mask_index != nullptr || causal || use_sparse_block_mask) {
+      size_t mask_data_bytes = SafeInt<size_t>(batch_size) * sequence_length * total_sequence_length * sizeof(T);
+      mask_data = allocator->Alloc(mask_data_bytes);
+      memset(mask_data, 0, mask_data_bytes);
+    }
+    BufferUniquePtr mask_data_buffer(mask_data, BufferDeleter(std::move(allocator)));
+    const int32_t* mask_index_data = mask_index != nullptr ? mask_index->Data<int32_t>() : nullptr;
+    gsl::span<const int64_t> mask_index_dims = mask_index != nullptr
+                                                   ? mask_index->Shape().GetDims()
+                                                   : gsl::span<const int64_t>{};
+    if (mask_data != nullptr) {
+      PrepareMask(mask_index_data, mask_index_dims, static_cast<T*>(mask_data),
+                  causal, batch_size, sequence_length, past_sequence_length, mask_filter_value_);
+      if (use_sparse_block_mask) {
+        ApplySparseBlockMask(static_cast<T*>(mask_data), batch_size, sequence_length, past_sequence_length,
+                             total_sequence_length);
+      }
+      DUMP_CPU_TENSOR_INIT();
+      DUMP_CPU_TENSOR("Mask3D", static_cast<T*>(mask_data), batch_size, sequence_length, total_sequence_length);
+    }
+
+    return mask_data_buffer;
+  }
+
  private:
+  // Masks the keys outside of the block sparse pattern with mask_filter_value_. Query s is at position
+  // past_sequence_length + s of the total sequence.
+  template <typename T>
+  void ApplySparseBlockMask(T* mask_data,  // mask of shape BxSxT
+                            int batch_size, int sequence_length, int past_sequence_length,
+                            int total_sequence_length) const {
+    for (int s = 0; s < sequence_length; s++) {
+      const int q_block = (past_sequence_length + s) / sparse_block_size_;
+      for (int t = 0; t < total_sequence_length; t++) {
+        if (IsSparseBlockAttended(q_block, t / sparse_block_size_)) {
+          continue;
+        }
+        for (int b = 0; b < batch_size; b++) {
+          T& mask = mask_data[(static_cast<size_t>(b) * sequence_length + s) * total_sequence_length + t];
+          mask = std::min(mask, static_cast<T>(mask_filter_value_));
+        }
+      }
+    }
+  }
+
   // Helper function to compute the attention probs. It does 2 things:
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T) +
   //                                1 x mask_data(B, N, S, T)
@@ -221,7 +311,6 @@ class AttentionCPUBase : public AttentionBase {
 
   template <typename T>
   void ComputeVxAttentionScore(T* output,                 // buffer for the result with size BxSxNxH_v
-                               T* tmp_buffer,             // buffer for temp use with size is BxNxSxH_v
                                const T* attention_probs,  // Attention probs with size BxNxSxT
                                const T* V,                // V value with size BxNxLxH_v
                                int batch_size,            // batch size
@@ -237,7 +326,6 @@ class AttentionCPUBase : public AttentionBase {
                                ThreadPool* tp) const {
     const int total_sequence_length = past_sequence_length + kv_sequence_length;                   // T = P + L
     const ptrdiff_t past_chunk_length = SafeInt<ptrdiff_t>(past_sequence_length) * v_head_size;    // P x H_v
-    const ptrdiff_t q_input_chunk_length = SafeInt<ptrdiff_t>(sequence_length) * v_head_size;      // S x H_v
     const ptrdiff_t kv_input_chunk_length = SafeInt<ptrdiff_t>(kv_sequence_length) * v_head_size;  // L x H_v
     const ptrdiff_t present_chunk_length = past_chunk_length + kv_input_chunk_length;              // T x H_v
 
@@ -263,11 +351,6 @@ class AttentionCPUBase : public AttentionBase {
       unit_cost.bytes_stored += bytes_to_copy_value;
     }
 
-    const size_t bytes_to_copy_trans = SafeInt<size_t>(v_head_size) * sizeof(T);
-    double bytes_to_copy_trans_all = static_cast<double>(sequence_length * bytes_to_copy_trans);
-    unit_cost.bytes_loaded += bytes_to_copy_trans_all;
-    unit_cost.bytes_stored += bytes_to_copy_trans_all;
-
     ThreadPool::TryParallelFor(
         tp, SafeInt<ptrdiff_t>(batch_size) * num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
           for (std::ptrdiff_t i = begin; i != end; ++i) {
@@ -279,23 +362,16 @@ class AttentionCPUBase : public AttentionBase {
               v = ConcatStateChunk(past_value, v, present_value, past_chunk_length, present_chunk_length, i);
             }
 
-            T* current_tmp_data = reinterpret_cast<T*>(tmp_buffer) + q_input_chunk_length * i;
-            ptrdiff_t attention_probs_offset = SafeInt<ptrdiff_t>(sequence_length) * total_sequence_length * i;
-            math::MatMul<T>(sequence_length, v_head_size, total_sequence_length,
-                            attention_probs + attention_probs_offset, v, current_tmp_data, nullptr);
-
-            // Transpose: out(B, S, N, H_v) -> out_tmp(B, N, S, H_v)
+            // The rows of the head are written v_hidden_size apart, in the (B, S, N, H_v) layout of the output.
             const int batch_index = static_cast<int>(i / num_heads_);
             const int head_index = static_cast<int>(i % num_heads_);
-            T* src = current_tmp_data;
-            ptrdiff_t dest_offset =
+            ptrdiff_t attention_probs_offset = SafeInt<ptrdiff_t>(sequence_length) * total_sequence_length * i;
+            ptrdiff_t output_offset =
                 (SafeInt<ptrdiff_t>(batch_index) * sequence_length * num_heads_ + head_index) * v_head_size;
-            T* dest = output + dest_offset;
-            for (int j = 0; j < sequence_length; j++) {
-              memcpy(dest, src, bytes_to_copy_trans);
-              src += v_head_size;
-              dest += v_hidden_size;
-            }
+            math::GemmEx<T, ThreadPool>(CblasNoTrans, CblasNoTrans, sequence_length, v_head_size,
+                                        total_sequence_length, 1.0f, attention_probs + attention_probs_offset,
+                                        total_sequence_length, v, v_head_size, 0.0f, output + output_offset,
+                                        v_hidden_size, nullptr);
           }
         });
   }
@@ -11,6 +11,9 @@
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
 
+#include <type_traits>
+#include <vector>
+
 namespace onnxruntime {
 namespace contrib {
 
@@ -31,6 +34,9 @@ class GQAAttentionBase {
     rotary_interleaved_ = info.GetAttrOrDefault<int64_t>("rotary_interleaved", 0) == 1;
 
     local_window_size_ = has_local ? static_cast<int>(info.GetAttrOrDefault<int64_t>("local_window_size", -1)) : -1;
+    kv_cache_ring_buffer_ = has_local && info.GetAttrOrDefault<int64_t>("kv_cache_ring_buffer", 0) == 1;
+    ORT_ENFORCE(!kv_cache_ring_buffer_ || local_window_size_ > 0,
+                "A ring buffer KV cache requires local attention, i.e. a positive local_window_size.");
   }
 
   int num_heads_;     // number of attention heads of Q
@@ -39,6 +45,7 @@ class GQAAttentionBase {
   bool do_rotary_;    // whether or not to use rotary embeddings
   bool rotary_interleaved_;
   int local_window_size_;
+  bool kv_cache_ring_buffer_;  // whether the KV cache only keeps the tokens of the local window, in a ring buffer
 
   template <typename T>
   Status ApplyAttention(const T* Q,                                 // Q data with shape BxNxSxH
@@ -50,6 +57,7 @@ class GQAAttentionBase {
                         Tensor* present_key,                        // present K output tensor (if separating present KV)
                         Tensor* present_value,                      // present V output tensor (if separating present KV)
                         const Tensor* seqlens_k,                    // past sequence lengths tensor
+                        const Tensor* block_table,                  // block table of a paged KV cache (optional)
                         GroupQueryAttentionParameters& parameters,  // attention parameters
                         AllocatorPtr allocator,                     // allocator for temporary tensors
                         OpKernelContext* context) const {
@@ -58,6 +66,8 @@ class GQAAttentionBase {
     const int head_size = parameters.head_size;
     const int hidden_size = parameters.hidden_size;
     const bool packed_qkv = parameters.is_packed_qkv;
+    // A prompt chunk after the first one attends to the KV cache like token generation does.
+    const bool is_first_prompt = parameters.is_prompt && !parameters.is_subsequent_prompt;
 
     auto* tp = context->GetOperatorThreadPool();
 
@@ -67,10 +77,14 @@ class GQAAttentionBase {
     }
     int seqlen_present_kv_cache = static_cast<int>(present_key->Shape().GetDims()[2]);
 
-    // Compute the attention score.
-    size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * seqlen_present_kv_cache * sizeof(T);
-    auto attention_probs = allocator->Alloc(bytes);
-    BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
+    // With a paged KV cache, past and present are a pool of fixed size blocks and the block table maps the
+    // sequence positions of each batch entry to blocks, so the past/present sequence length is the one
+    // addressable through the block table.
+    const int32_t* block_table_data = block_table != nullptr ? block_table->Data<int32_t>() : nullptr;
+    if (block_table_data != nullptr) {
+      seqlen_past_kv_cache = parameters.seqlen_past_kv_cache;
+      seqlen_present_kv_cache = parameters.seqlen_present_kv_cache;
+    }
 
     const T* past_key_data = past_key != nullptr ? past_key->Data<T>() : nullptr;
     T* present_key_data = present_key != nullptr ? present_key->MutableData<T>() : nullptr;
@@ -80,21 +94,340 @@ class GQAAttentionBase {
     bool past_present_share_buffer = past_key_data == present_key_data && past_value_data == present_value_data;
 
     const T* k = packed_qkv ? Q + num_heads_ * sequence_length * head_size : K;
-    ComputeAttentionProbs<T>(static_cast<T*>(attention_probs), Q, k, seqlens_k->Data<int32_t>(), batch_size,
-                             sequence_length, seqlen_past_kv_cache, seqlen_present_kv_cache, head_size, past_key_data,
-                             present_key_data, past_present_share_buffer, packed_qkv, tp);
+    const T* v = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
+
+    const PagedKVCache paged_kv_cache{block_table_data, parameters.kv_block_size, parameters.max_blocks_per_sequence};
+    if (block_table_data != nullptr) {
+      // Blocks are updated in place. Without a shared buffer the whole pool has to be carried over to present.
+      if (!past_present_share_buffer) {
+        memcpy(present_key_data, past_key_data, past_key->SizeInBytes());
+        memcpy(present_value_data, past_value_data, past_value->SizeInBytes());
+        past_key_data = present_key_data;
+        past_value_data = present_value_data;
+        past_present_share_buffer = true;
+      }
+
+      WriteToPagedKVCache<T>(k, v, seqlens_k->Data<int32_t>(), is_first_prompt, paged_kv_cache, batch_size,
+                             sequence_length, head_size, present_key_data, present_value_data, packed_qkv, tp);
+    }
+
+    if constexpr (std::is_same_v<T, float>) {
+      if (is_first_prompt && block_table_data == nullptr && present_key_data != nullptr &&
+          present_value_data != nullptr) {
+        CopyPromptKVToPresent(k, v, batch_size, sequence_length, seqlen_present_kv_cache, head_size, present_key_data,
+                              present_value_data, past_present_share_buffer, packed_qkv, tp);
+        ComputePromptFlashAttention(output->MutableData<float>(), Q, k, v, seqlens_k->Data<int32_t>(), batch_size,
+                                    sequence_length, head_size, packed_qkv, tp);
+        return Status::OK();
+      }
+    }
+
+    // Compute the attention score.
+    size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * seqlen_present_kv_cache * sizeof(T);
+    auto attention_probs = allocator->Alloc(bytes);
+    BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
+
+    ComputeAttentionProbs<T>(static_cast<T*>(attention_probs), Q, k, seqlens_k->Data<int32_t>(), is_first_prompt,
+                             batch_size, sequence_length, seqlen_past_kv_cache, seqlen_present_kv_cache, head_size,
+                             past_key_data, present_key_data, past_present_share_buffer, packed_qkv, paged_kv_cache,
+                             tp);
 
     // Compute the attentionScore * Value: out(B, N, S, H_v) = attention_probs(B, N, S, T) x V(B, N, T, H_v)
-    const T* v = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
     ComputeVxAttentionScore(output->MutableData<T>(), static_cast<T*>(attention_probs), v, seqlens_k->Data<int32_t>(),
-                            batch_size, sequence_length, seqlen_past_kv_cache, seqlen_present_kv_cache, head_size,
-                            hidden_size, past_value_data, present_value_data, past_present_share_buffer, packed_qkv,
-                            tp);
+                            is_first_prompt, batch_size, sequence_length, seqlen_past_kv_cache,
+                            seqlen_present_kv_cache, head_size, hidden_size, past_value_data, present_value_data,
+                            past_present_share_buffer, packed_qkv, paged_kv_cache, tp);
+
+    return Status::OK();
+  }
+
+  // Same as ApplyAttention with an int8 KV cache: token t of head n of K (V) is stored as
+  // present_key_scale[b, n, t] x present_key[b, n, t, :], quantized symmetrically with a scale per token.
+  // The QK' and probs x V products convert blocks of the int8 cache to float and fold the scales into the
+  // probs, so the cache is never dequantized as a whole.
+  Status ApplyAttentionWithQuantizedKVCache(const float* Q,                             // Q data with shape BxNxSxH
+                                            const float* K,                             // K data with shape BxN_kvxSxH
+                                            const float* V,                             // V data with shape BxN_kvxSxH
+                                            const Tensor* past_key,                     // int8 past K (optional)
+                                            const Tensor* past_value,                   // int8 past V (optional)
+                                            const Tensor* past_key_scale,               // scales of past K
+                                            const Tensor* past_value_scale,             // scales of past V
+                                            Tensor* output,                             // output tensor
+                                            Tensor* present_key,                        // int8 present K
+                                            Tensor* present_value,                      // int8 present V
+                                            Tensor* present_key_scale,                  // scales of present K
+                                            Tensor* present_value_scale,                // scales of present V
+                                            const Tensor* seqlens_k,                    // past sequence lengths tensor
+                                            GroupQueryAttentionParameters& parameters,  // attention parameters
+                                            AllocatorPtr allocator,                     // allocator for temporaries
+                                            OpKernelContext* context) const {
+    const int batch_size = parameters.batch_size;
+    const int sequence_length = parameters.sequence_length;
+    const int head_size = parameters.head_size;
+    const int hidden_size = parameters.hidden_size;
+    const bool packed_qkv = parameters.is_packed_qkv;
+    const bool is_first_prompt = parameters.is_prompt && !parameters.is_subsequent_prompt;
+
+    auto* tp = context->GetOperatorThreadPool();
+
+    const int seqlen_past_kv_cache = past_key != nullptr ? static_cast<int>(past_key->Shape().GetDims()[2]) : 0;
+    const int seqlen_present_kv_cache = static_cast<int>(present_key->Shape().GetDims()[2]);
+
+    const PastQuantizedKVCache past{past_key != nullptr ? past_key->Data<int8_t>() : nullptr,
+                                    past_value != nullptr ? past_value->Data<int8_t>() : nullptr,
+                                    past_key_scale != nullptr ? past_key_scale->Data<float>() : nullptr,
+                                    past_value_scale != nullptr ? past_value_scale->Data<float>() : nullptr};
+    const PresentQuantizedKVCache present{present_key->MutableData<int8_t>(), present_value->MutableData<int8_t>(),
+                                          present_key_scale->MutableData<float>(),
+                                          present_value_scale->MutableData<float>()};
+
+    const float* k = packed_qkv ? Q + num_heads_ * sequence_length * head_size : K;
+    const float* v = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
+
+    WriteToQuantizedKVCache(k, v, seqlens_k->Data<int32_t>(), is_first_prompt, batch_size, sequence_length,
+                            seqlen_past_kv_cache, seqlen_present_kv_cache, head_size, past, present, packed_qkv, tp);
+
+    // The first prompt attends to the new K and V only, which are still available in float.
+    if (is_first_prompt) {
+      ComputePromptFlashAttention(output->MutableData<float>(), Q, k, v, seqlens_k->Data<int32_t>(), batch_size,
+                                  sequence_length, head_size, packed_qkv, tp);
+      return Status::OK();
+    }
+
+    size_t bytes =
+        SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * seqlen_present_kv_cache * sizeof(float);
+    auto attention_probs = allocator->Alloc(bytes);
+    BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
+
+    ComputeAttentionProbsWithQuantizedKVCache(static_cast<float*>(attention_probs), Q, seqlens_k->Data<int32_t>(),
+                                              is_first_prompt, batch_size, sequence_length,
+                                              seqlen_present_kv_cache, head_size, present, packed_qkv, tp);
+
+    ComputeVxAttentionScoreWithQuantizedKVCache(output->MutableData<float>(), static_cast<float*>(attention_probs),
+                                                seqlens_k->Data<int32_t>(), batch_size, sequence_length,
+                                                seqlen_present_kv_cache, head_size, hidden_size, present, tp);
+
+    return Status::OK();
+  }
+
+  // Same as ApplyAttention with a ring buffer KV cache for local attention: past and present key and value hold the
+  // last `capacity` (at least local_window_size) tokens of each sequence, the token at position p at index
+  // p % capacity, so the cache does not grow with the sequence. The new tokens attend to the cached tokens of their
+  // window and to each other, and are only written to the cache afterwards, so a chunk longer than the capacity never
+  // overwrites a token that it still reads.
+  Status ApplyAttentionWithRingBufferKVCache(const float* Q,                             // Q data with shape BxNxSxH
+                                             const float* K,                             // K data with shape BxN_kvxSxH
+                                             const float* V,                             // V data with shape BxN_kvxSxH
+                                             const Tensor* past_key,                     // past K ring buffer (optional)
+                                             const Tensor* past_value,                   // past V ring buffer (optional)
+                                             Tensor* output,                             // output tensor
+                                             Tensor* present_key,                        // present K ring buffer
+                                             Tensor* present_value,                      // present V ring buffer
+                                             const Tensor* seqlens_k,                    // past sequence lengths tensor
+                                             GroupQueryAttentionParameters& parameters,  // attention parameters
+                                             AllocatorPtr allocator,                     // allocator for temporaries
+                                             OpKernelContext* context) const {
+    const int batch_size = parameters.batch_size;
+    const int sequence_length = parameters.sequence_length;
+    const int head_size = parameters.head_size;
+    const bool packed_qkv = parameters.is_packed_qkv;
+    const bool is_first_prompt = parameters.is_prompt && !parameters.is_subsequent_prompt;
+
+    auto* tp = context->GetOperatorThreadPool();
+
+    const int capacity = static_cast<int>(present_key->Shape().GetDims()[2]);
+    float* present_key_data = present_key->MutableData<float>();
+    float* present_value_data = present_value->MutableData<float>();
+
+    // The ring buffer is updated in place, so a past that doesn't share the buffer is carried over to present first.
+    if (past_key != nullptr && past_value != nullptr) {
+      if (past_key->Data<float>() != present_key_data) {
+        memcpy(present_key_data, past_key->Data<float>(), past_key->SizeInBytes());
+      }
+      if (past_value->Data<float>() != present_value_data) {
+        memcpy(present_value_data, past_value->Data<float>(), past_value->SizeInBytes());
+      }
+    } else {
+      memset(present_key_data, 0, present_key->SizeInBytes());
+      memset(present_value_data, 0, present_value->SizeInBytes());
+    }
+
+    const float* k = packed_qkv ? Q + num_heads_ * sequence_length * head_size : K;
+    const float* v = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
+    const int32_t* seqlens_k_data = seqlens_k->Data<int32_t>();
+
+    // The first prompt attends to the new K and V only.
+    if (is_first_prompt) {
+      ComputePromptFlashAttention(output->MutableData<float>(), Q, k, v, seqlens_k_data, batch_size,
+                                  sequence_length, head_size, packed_qkv, tp);
+    } else {
+      ComputeRingBufferAttention(output->MutableData<float>(), Q, k, v, seqlens_k_data, batch_size, sequence_length,
+                                 capacity, head_size, parameters.hidden_size, present_key_data, present_value_data,
+                                 packed_qkv, allocator, tp);
+    }
+
+    WriteToRingBufferKVCache(k, v, seqlens_k_data, is_first_prompt, batch_size, sequence_length, capacity, head_size,
+                             present_key_data, present_value_data, packed_qkv, tp);
 
     return Status::OK();
   }
 
  private:
+  // Layout of a paged KV cache: a pool of blocks of shape (N_blocks, N_k, S_b, H) and a block table of shape (B, M)
+  // mapping position p of the sequence of batch entry b to token p % S_b of block block_table[b * M + p / S_b].
+  struct PagedKVCache {
+    const int32_t* block_table;   // nullptr if the KV cache is not paged
+    int block_size;               // S_b
+    int max_blocks_per_sequence;  // M
+
+    // Returns the offset of the first token of the chunk of `kv_head_index` in the `i`-th block of `batch_index`.
+    size_t BlockOffset(int batch_index, int i, int kv_num_heads, int kv_head_index, int head_size) const {
+      const size_t block = static_cast<size_t>(block_table[batch_index * max_blocks_per_sequence + i]);
+      return ((block * kv_num_heads + kv_head_index) * block_size) * head_size;
+    }
+  };
+
+  // Helper function to write the new K and V of every sequence to its blocks of a paged KV cache.
+  // New tokens of the first prompt start at position 0, the others end at position seqlens_k[b].
+  template <typename T>
+  void WriteToPagedKVCache(const T* K,                          // new K data. Its size is BxN_kvxSxH
+                           const T* V,                          // new V data. Its size is BxN_kvxSxH
+                           const int32_t* seqlens_k,            // past sequence lengths tensor
+                           bool is_first_prompt,                // whether the new tokens start at position 0
+                           const PagedKVCache& paged_kv_cache,  // layout of the paged KV cache
+                           int batch_size,                      // batch size of self-attention
+                           int sequence_length,                 // sequence length of self-attention (S)
+                           int head_size,                       // head size of self-attention
+                           T* present_key,                      // pool of key blocks
+                           T* present_value,                    // pool of value blocks
+                           bool packed_qkv,                     // whether Q, K, V are packed
+                           ThreadPool* tp) const {
+    const ptrdiff_t packed_batch_stride =
+        packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
+                   : SafeInt<ptrdiff_t>(0);
+    const size_t kv_input_chunk_length = static_cast<size_t>(sequence_length) * head_size;  // S x H
+    const size_t bytes_per_token = SafeInt<size_t>(head_size) * sizeof(T);
+
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles = 0;
+    unit_cost.bytes_loaded = static_cast<double>(2 * sequence_length * bytes_per_token);
+    unit_cost.bytes_stored = static_cast<double>(2 * sequence_length * bytes_per_token);
+
+    ThreadPool::TryParallelFor(
+        tp, SafeInt<ptrdiff_t>(batch_size) * kv_num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t i = begin; i != end; ++i) {
+            const int batch_index = static_cast<int>(i / kv_num_heads_);
+            const int kv_head_index = static_cast<int>(i % kv_num_heads_);
+            const int start_position =
+                is_first_prompt ? 0 : static_cast<int>(seqlens_k[batch_index]) + 1 - sequence_length;
+
+            const size_t input_offset = packed_qkv
+                                            ? packed_batch_stride * batch_index + kv_input_chunk_length * kv_head_index
+                                            : kv_input_chunk_length * i;
+            for (int seq = 0; seq < sequence_length; seq++) {
+              const int position = start_position + seq;
+              const size_t offset = paged_kv_cache.BlockOffset(batch_index, position / paged_kv_cache.block_size,
+                                                               kv_num_heads_, kv_head_index, head_size) +
+                                    static_cast<size_t>(position % paged_kv_cache.block_size) * head_size;
+              memcpy(present_key + offset, K + input_offset + seq * head_size, bytes_per_token);
+              memcpy(present_value + offset, V + input_offset + seq * head_size, bytes_per_token);
+            }
+          }
+        });
+  }
+
+  // Helper function of the prompt to copy the new K and V to the start of each head of present.
+  template <typename T>
+  void CopyPromptKVToPresent(const T* K,                          // new K data. Its size is BxN_kvxSxH
+                             const T* V,                          // new V data. Its size is BxN_kvxSxH
+                             int batch_size,                      // batch size of self-attention
+                             int sequence_length,                 // sequence length of self-attention (S)
+                             int present_buffer_sequence_length,  // sequence length of present state
+                             int head_size,                       // head size of self-attention
+                             T* present_key,                      // present key only
+                             T* present_value,                    // present value only
+                             bool past_present_share_buffer,      // whether present key and value share a buffer
+                             bool packed_qkv,                     // whether Q, K, V are packed
+                             ThreadPool* tp) const {
+    const ptrdiff_t packed_batch_stride =
+        packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
+                   : SafeInt<ptrdiff_t>(0);
+    const size_t kv_input_chunk_length = static_cast<size_t>(sequence_length) * head_size;                     // S x H
+    const size_t present_buff_chunk_length = static_cast<size_t>(present_buffer_sequence_length) * head_size;  // T x H
+
+    if (!past_present_share_buffer) {
+      const size_t present_bytes =
+          SafeInt<size_t>(batch_size) * kv_num_heads_ * present_buff_chunk_length * sizeof(T);
+      memset(present_key, 0, present_bytes);
+      memset(present_value, 0, present_bytes);
+    }
+
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles = 0;
+    unit_cost.bytes_loaded = static_cast<double>(2 * kv_input_chunk_length * sizeof(T));
+    unit_cost.bytes_stored = static_cast<double>(2 * kv_input_chunk_length * sizeof(T));
+
+    ThreadPool::TryParallelFor(
+        tp, SafeInt<ptrdiff_t>(batch_size) * kv_num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t i = begin; i != end; ++i) {
+            const ptrdiff_t batch_index = i / kv_num_heads_;
+            const ptrdiff_t kv_head_index = i % kv_num_heads_;
+            const size_t input_offset = packed_qkv
+                                            ? packed_batch_stride * batch_index + kv_input_chunk_length * kv_head_index
+                                            : kv_input_chunk_length * i;
+            memcpy(present_key + present_buff_chunk_length * i, K + input_offset, kv_input_chunk_length * sizeof(T));
+            memcpy(present_value + present_buff_chunk_length * i, V + input_offset,
+                   kv_input_chunk_length * sizeof(T));
+          }
+        });
+  }
+
+  // Helper function of the prompt to compute
+  //  out(B, S, N, H) = Softmax(causal(1/sqrt(H) x Q x K')) x V
+  // from the new K and V block by block with MlasFlashAttention, without materializing the BxNxSxT attention probs.
+  void ComputePromptFlashAttention(float* output,              // output buffer with size BxSxNxH
+                                   const float* Q,             // Q data. Its size is BxNxSxH
+                                   const float* K,             // new K data. Its size is BxN_kvxSxH
+                                   const float* V,             // new V data. Its size is BxN_kvxSxH
+                                   const int32_t* seqlens_k,   // past sequence lengths tensor
+                                   int batch_size,             // batch size of self-attention
+                                   int sequence_length,        // sequence length of self-attention (S)
+                                   int head_size,              // head size of self-attention
+                                   bool packed_qkv,            // whether Q, K, V are packed
+                                   ThreadPool* tp) const {
+    const size_t chunk_length = static_cast<size_t>(sequence_length) * head_size;  // S x H
+    const size_t packed_batch_stride = packed_qkv ? (num_heads_ + 2 * kv_num_heads_) * chunk_length : 0;
+
+    InlinedVector<int32_t> total_seqlens(batch_size);
+    for (int b = 0; b < batch_size; b++) {
+      total_seqlens[b] = seqlens_k[b] + 1;
+    }
+
+    MLAS_FLASH_ATTENTION_PARAMS params;
+    params.BatchSize = static_cast<size_t>(batch_size);
+    params.NumHeads = static_cast<size_t>(num_heads_);
+    params.KvNumHeads = static_cast<size_t>(kv_num_heads_);
+    params.QSequenceLength = static_cast<size_t>(sequence_length);
+    params.KvSequenceLength = static_cast<size_t>(sequence_length);
+    params.QkHeadSize = static_cast<size_t>(head_size);
+    params.VHeadSize = static_cast<size_t>(head_size);
+    params.Scale = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+    params.Query = Q;
+    params.QueryHeadStride = chunk_length;
+    params.QueryBatchStride = packed_qkv ? packed_batch_stride : params.NumHeads * chunk_length;
+    params.Key = K;
+    params.KeyHeadStride = chunk_length;
+    params.KeyBatchStride = packed_qkv ? packed_batch_stride : params.KvNumHeads * chunk_length;
+    params.Value = V;
+    params.ValueHeadStride = chunk_length;
+    params.ValueBatchStride = params.KeyBatchStride;
+    params.KvValidLengths = total_seqlens.data();
+    params.Causal = true;
+    params.LocalWindowSize = local_window_size_ > 0 ? static_cast<size_t>(local_window_size_) : 0;
+    params.Output = output;
+    MlasFlashAttention(params, tp);
+  }
+
   // Helper function to compute the attention probs. It does 2 things:
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T)
   //  attention_probs(B, N, S, T) = Softmax(attention_probs)
@@ -103,6 +436,7 @@ class GQAAttentionBase {
                              const T* Q,                          // Q data. Its size is BxNxSxH
                              const T* K,                          // k data. Its size is BxNxLxH
                              const int32_t* seqlens_k,            // past sequence lengths tensor
+                             bool is_first_prompt,                // whether the KV cache holds no past tokens
                              int batch_size,                      // batch size of self-attention
                              int sequence_length,                 // sequence length of self-attention (S)
                              int past_buffer_sequence_length,     // sequence length of past state
@@ -112,8 +446,8 @@ class GQAAttentionBase {
                              T* present_key,                      // present key only
                              bool past_present_share_buffer,      // whether present key and value share the same buffer
                              bool packed_qkv,                     // whether Q, K, V are packed
+                             const PagedKVCache& paged_kv_cache,  // layout of the KV cache if it is paged
                              ThreadPool* tp) const {              // thread pool
-    const bool is_prompt = sequence_length != 1;
     const ptrdiff_t packed_batch_stride =
         packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
                    : SafeInt<ptrdiff_t>(0);
@@ -123,7 +457,7 @@ class GQAAttentionBase {
     const size_t past_buff_chunk_length = static_cast<size_t>(past_buffer_sequence_length) * head_size;        // L x H
     const size_t present_buff_chunk_length = static_cast<size_t>(present_buffer_sequence_length) * head_size;  // T x H
 
-    if (!past_present_share_buffer) {
+    if (!past_present_share_buffer && nullptr == paged_kv_cache.block_table) {
       memset(present_key, 0, batch_size * kv_num_heads_ * present_buffer_sequence_length * head_size * sizeof(T));
     }
 
@@ -152,10 +486,9 @@ class GQAAttentionBase {
       for (std::ptrdiff_t i = begin; i != end; ++i) {
         const int batch_index = static_cast<int>(i) / num_heads_;
         const int head_index = static_cast<int>(i) % num_heads_;
-        const int past_seqlen =
-            sequence_length == 1 ? static_cast<int>(seqlens_k[batch_index]) : past_buffer_sequence_length;
-        const size_t past_chunk_length = static_cast<size_t>(past_seqlen) * head_size;
         const int total_seqlen = seqlens_k[batch_index] + 1;
+        const int past_seqlen = is_first_prompt ? 0 : total_seqlen - sequence_length;
+        const size_t past_chunk_length = static_cast<size_t>(past_seqlen) * head_size;
 
         const ptrdiff_t output_offset = SafeInt<ptrdiff_t>(i) * sequence_length * present_buffer_sequence_length;
         T* output = attention_probs + output_offset;
@@ -166,10 +499,10 @@ class GQAAttentionBase {
         } else {
           k = K + kv_input_chunk_length * (i / kv_num_heads_factor);
         }
-        if (nullptr != present_key) {
+        if (nullptr != present_key && nullptr == paged_kv_cache.block_table) {
           k = ConcatStateChunkGQA(past_key, k, present_key, present_buff_chunk_length, past_buff_chunk_length,
-                                  past_chunk_length, kv_input_chunk_length, is_prompt, past_present_share_buffer,
-                                  i / kv_num_heads_factor);
+                                  past_chunk_length, kv_input_chunk_length, is_first_prompt,
+                                  past_present_share_buffer, i / kv_num_heads_factor);
         }
 
         // Compute Q*K' + AttentionMask
@@ -183,33 +516,52 @@ class GQAAttentionBase {
         } else {
           q = Q + q_input_chunk_length * i;
         }
-        math::GemmEx<T, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, total_seqlen, head_size, alpha, q,
-                                    head_size, k, head_size, 0.0f /*bata*/, output, present_buffer_sequence_length,
-                                    nullptr);
-
-        // compute Softmax
-        T* output_softmax = output;
-        for (int seq = 0; seq < sequence_length; seq++) {
-          int seq_causal_length = sequence_length == 1 ? total_seqlen : seq + 1;
-          if (local_window_size_ > 0 && seq_causal_length > local_window_size_ + 1) {
-            for (int total_seq_id = 0; total_seq_id < seq_causal_length - local_window_size_ - 1; total_seq_id++) {
-              output_softmax[total_seq_id] = 0.f;
-            }
-            ComputeAttentionSoftmaxInplace(output_softmax + seq_causal_length - local_window_size_ - 1, 1,
-                                           local_window_size_ + 1, nullptr);
-          } else {
-            ComputeAttentionSoftmaxInplace(output_softmax, 1, seq_causal_length, nullptr);
+        if (nullptr != paged_kv_cache.block_table) {
+          // Q*K' of each block lands in the columns of the block's positions
+          const int block_size = paged_kv_cache.block_size;
+          for (int block = 0; block * block_size < total_seqlen; block++) {
+            const T* k_block = present_key + paged_kv_cache.BlockOffset(batch_index, block, kv_num_heads_,
+                                                                        head_index / kv_num_heads_factor, head_size);
+            math::GemmEx<T, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length,
+                                        std::min(block_size, total_seqlen - block * block_size), head_size, alpha, q,
+                                        head_size, k_block, head_size, 0.0f /*bata*/, output + block * block_size,
+                                        present_buffer_sequence_length, nullptr);
           }
+        } else {
+          math::GemmEx<T, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, total_seqlen, head_size, alpha, q,
+                                      head_size, k, head_size, 0.0f /*bata*/, output, present_buffer_sequence_length,
+                                      nullptr);
+        }
 
-          // set causal [seq_causal_length, total_seqlen) to 0.f
-          for (int total_seq_id = seq_causal_length; total_seq_id < total_seqlen; total_seq_id++) {
-            output_softmax[total_seq_id] = 0.f;
-          }
+        ComputeCausalSoftmax(output, sequence_length, total_seqlen, past_seqlen, present_buffer_sequence_length);
+      }
+    });
+  }
 
-          output_softmax += present_buffer_sequence_length;
+  // Helper function to compute the causal (and local) Softmax of the SxT attention probs of one head in place.
+  // Query `seq` is the token at position past_seqlen + seq of the sequence.
+  template <typename T>
+  void ComputeCausalSoftmax(T* output_softmax, int sequence_length, int total_seqlen, int past_seqlen,
+                            int present_buffer_sequence_length) const {
+    for (int seq = 0; seq < sequence_length; seq++) {
+      int seq_causal_length = past_seqlen + seq + 1;
+      if (local_window_size_ > 0 && seq_causal_length > local_window_size_ + 1) {
+        for (int total_seq_id = 0; total_seq_id < seq_causal_length - local_window_size_ - 1; total_seq_id++) {
+          output_softmax[total_seq_id] = 0.f;
         }
+        ComputeAttentionSoftmaxInplace(output_softmax + seq_causal_length - local_window_size_ - 1, 1,
+                                       local_window_size_ + 1, nullptr);
+      } else {
+        ComputeAttentionSoftmaxInplace(output_softmax, 1, seq_causal_length, nullptr);
       }
-    });
+
+      // set causal [seq_causal_length, total_seqlen) to 0.f
+      for (int total_seq_id = seq_causal_length; total_seq_id < total_seqlen; total_seq_id++) {
+        output_softmax[total_seq_id] = 0.f;
+      }
+
+      output_softmax += present_buffer_sequence_length;
+    }
   }
 
   template <typename T>
@@ -217,6 +569,7 @@ class GQAAttentionBase {
                                const T* attention_probs,            // Attention probs with size BxNxSxT
                                const T* V,                          // V value with size BxN_kvxSxH
                                const int32_t* seqlens_k,            // past sequence lengths tensor
+                               bool is_first_prompt,                // whether the KV cache holds no past tokens
                                int batch_size,                      // batch size
                                int sequence_length,                 // sequence length
                                int past_buffer_sequence_length,     // sequence length in past state
@@ -227,8 +580,8 @@ class GQAAttentionBase {
                                T* present_value,                    // present value only
                                bool past_present_share_buffer,      // whether present key and value share the same buffer
                                bool packed_qkv,                     // whether Q, K, V are packed
+                               const PagedKVCache& paged_kv_cache,  // layout of the KV cache if it is paged
                                ThreadPool* tp) const {
-    const bool is_prompt = sequence_length != 1;
     const ptrdiff_t packed_batch_stride =
         packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
                    : SafeInt<ptrdiff_t>(0);
@@ -237,7 +590,7 @@ class GQAAttentionBase {
     const size_t past_buff_chunk_length = static_cast<size_t>(past_buffer_sequence_length) * head_size;        // L x H
     const size_t present_buff_chunk_length = static_cast<size_t>(present_buffer_sequence_length) * head_size;  // T x H
 
-    if (!past_present_share_buffer) {
+    if (!past_present_share_buffer && nullptr == paged_kv_cache.block_table) {
       memset(present_value, 0, batch_size * kv_num_heads_ * present_buffer_sequence_length * head_size * sizeof(T));
     }
 
@@ -265,10 +618,9 @@ class GQAAttentionBase {
           for (std::ptrdiff_t i = begin; i != end; ++i) {
             const int batch_index = static_cast<int>(i / num_heads_);
             const int head_index = static_cast<int>(i % num_heads_);
-            const int past_seqlen =
-                sequence_length == 1 ? static_cast<int>(seqlens_k[batch_index]) : past_buffer_sequence_length;
-            const size_t past_chunk_length = static_cast<size_t>(past_seqlen) * head_size;
             const int total_seqlen = seqlens_k[batch_index] + 1;
+            const int past_seqlen = is_first_prompt ? 0 : total_seqlen - sequence_length;
+            const size_t past_chunk_length = static_cast<size_t>(past_seqlen) * head_size;
 
             const T* v;
             if (packed_qkv) {
@@ -276,19 +628,429 @@ class GQAAttentionBase {
             } else {
               v = V + kv_input_chunk_length * (i / kv_num_heads_factor);
             }
-            if (nullptr != present_value) {
+            if (nullptr != present_value && nullptr == paged_kv_cache.block_table) {
               v = ConcatStateChunkGQA(past_value, v, present_value, present_buff_chunk_length, past_buff_chunk_length,
-                                      past_chunk_length, kv_input_chunk_length, is_prompt, past_present_share_buffer,
-                                      i / kv_num_heads_factor);
+                                      past_chunk_length, kv_input_chunk_length, is_first_prompt,
+                                      past_present_share_buffer, i / kv_num_heads_factor);
             }
 
             T* output_current = output + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
             ptrdiff_t attention_probs_offset = SafeInt<ptrdiff_t>(sequence_length) * present_buffer_sequence_length * i;
 
-            math::GemmEx<T, ThreadPool>(CblasNoTrans, CblasNoTrans, sequence_length, head_size, total_seqlen,
-                                        1.f, /*alpha*/
-                                        attention_probs + attention_probs_offset, present_buffer_sequence_length, v,
-                                        head_size, 0.0f /*beta*/, output_current, hidden_size, nullptr);
+            if (nullptr != paged_kv_cache.block_table) {
+              // accumulate the product of the probs of each block with the V of the block
+              const int block_size = paged_kv_cache.block_size;
+              for (int block = 0; block * block_size < total_seqlen; block++) {
+                const T* v_block = present_value + paged_kv_cache.BlockOffset(batch_index, block, kv_num_heads_,
+                                                                              head_index / kv_num_heads_factor,
+                                                                              head_size);
+                math::GemmEx<T, ThreadPool>(CblasNoTrans, CblasNoTrans, sequence_length, head_size,
+                                            std::min(block_size, total_seqlen - block * block_size),
+                                            1.f, /*alpha*/
+                                            attention_probs + attention_probs_offset + block * block_size,
+                                            present_buffer_sequence_length, v_block, head_size,
+                                            block == 0 ? 0.0f : 1.0f /*beta*/, output_current, hidden_size, nullptr);
+              }
+            } else {
+              math::GemmEx<T, ThreadPool>(CblasNoTrans, CblasNoTrans, sequence_length, head_size, total_seqlen,
+                                          1.f, /*alpha*/
+                                          attention_probs + attention_probs_offset, present_buffer_sequence_length, v,
+                                          head_size, 0.0f /*beta*/, output_current, hidden_size, nullptr);
+            }
+          }
+        });
+  }
+
+  // Helper function of a ring buffer KV cache to compute
+  //  out(B, S, N, H) = Softmax(local(1/sqrt(H) x Q x K')) x V
+  // for new tokens that follow the tokens in the cache. The keys of a query are the last local_window_size cached
+  // tokens, which are at most two ranges of the ring buffer, followed by the new tokens, so QK' and probs x V are
+  // computed range by range and the probs of only one head per thread are materialized.
+  void ComputeRingBufferAttention(float* output,                // output buffer with size BxSxNxH
+                                  const float* Q,               // Q data. Its size is BxNxSxH
+                                  const float* K,               // new K data. Its size is BxN_kvxSxH
+                                  const float* V,               // new V data. Its size is BxN_kvxSxH
+                                  const int32_t* seqlens_k,     // past sequence lengths tensor
+                                  int batch_size,               // batch size of self-attention
+                                  int sequence_length,          // sequence length of self-attention (S)
+                                  int capacity,                 // number of tokens of the ring buffer
+                                  int head_size,                // head size of self-attention
+                                  int hidden_size,              // hidden size of Output
+                                  const float* present_key,     // key ring buffer with size BxN_kvxCxH
+                                  const float* present_value,   // value ring buffer with size BxN_kvxCxH
+                                  bool packed_qkv,              // whether Q, K, V are packed
+                                  AllocatorPtr allocator,       // allocator for the probs of a head
+                                  ThreadPool* tp) const {
+    const ptrdiff_t packed_batch_stride =
+        packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
+                   : SafeInt<ptrdiff_t>(0);
+    const int kv_num_heads_factor = num_heads_ / kv_num_heads_;
+    const size_t input_chunk_length = static_cast<size_t>(sequence_length) * head_size;  // S x H
+    const size_t cache_chunk_length = static_cast<size_t>(capacity) * head_size;        // C x H
+    const float alpha = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+    const int max_context_length = local_window_size_ + sequence_length;
+
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles =
+        static_cast<double>(SafeInt<ptrdiff_t>(4) * sequence_length * head_size * max_context_length);
+    unit_cost.bytes_loaded =
+        static_cast<double>((sequence_length + 2 * max_context_length) * head_size * sizeof(float));
+    unit_cost.bytes_stored = static_cast<double>(sequence_length * head_size * sizeof(float));
+
+    ThreadPool::TryParallelFor(
+        tp, SafeInt<ptrdiff_t>(batch_size) * num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          void* probs_buffer =
+              allocator->Alloc(SafeInt<size_t>(sequence_length) * max_context_length * sizeof(float));
+          BufferUniquePtr scratch_buffer(probs_buffer, BufferDeleter(allocator));
+          float* probs = static_cast<float*>(probs_buffer);
+
+          for (std::ptrdiff_t i = begin; i != end; ++i) {
+            const int batch_index = static_cast<int>(i / num_heads_);
+            const int head_index = static_cast<int>(i % num_heads_);
+            const int kv_head_index = head_index / kv_num_heads_factor;
+            const int past_seqlen = seqlens_k[batch_index] + 1 - sequence_length;
+
+            // the cached keys are the positions [past_seqlen - cached_length, past_seqlen)
+            const int cached_length = std::min(past_seqlen, local_window_size_);
+            const int context_length = cached_length + sequence_length;
+            const int first_index = (past_seqlen - cached_length) % capacity;
+            const int first_length = std::min(cached_length, capacity - first_index);
+
+            const size_t cache_offset =
+                (static_cast<size_t>(batch_index) * kv_num_heads_ + kv_head_index) * cache_chunk_length;
+            const float* k_cache = present_key + cache_offset;
+            const float* v_cache = present_value + cache_offset;
+
+            const float* q;
+            const float* k;
+            const float* v;
+            if (packed_qkv) {
+              q = Q + packed_batch_stride * batch_index + input_chunk_length * head_index;
+              k = K + packed_batch_stride * batch_index + input_chunk_length * kv_head_index;
+              v = V + packed_batch_stride * batch_index + input_chunk_length * kv_head_index;
+            } else {
+              q = Q + input_chunk_length * i;
+              k = K + input_chunk_length * (batch_index * kv_num_heads_ + kv_head_index);
+              v = V + input_chunk_length * (batch_index * kv_num_heads_ + kv_head_index);
+            }
+
+            // probs(S, cached + S) = Q x [cached K, new K]'
+            if (first_length > 0) {
+              math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, first_length, head_size,
+                                              alpha, q, head_size, k_cache + first_index * head_size, head_size,
+                                              0.0f, probs, context_length, nullptr);
+            }
+            if (cached_length > first_length) {
+              math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length,
+                                              cached_length - first_length, head_size, alpha, q, head_size, k_cache,
+                                              head_size, 0.0f, probs + first_length, context_length, nullptr);
+            }
+            math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, sequence_length, head_size,
+                                            alpha, q, head_size, k, head_size, 0.0f, probs + cached_length,
+                                            context_length, nullptr);
+
+            ComputeCausalSoftmax(probs, sequence_length, context_length, cached_length, context_length);
+
+            // out(S, H) = probs(S, cached + S) x [cached V, new V]
+            float* output_current = output + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
+            if (first_length > 0) {
+              math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasNoTrans, sequence_length, head_size, first_length,
+                                              1.0f, probs, context_length, v_cache + first_index * head_size,
+                                              head_size, 0.0f, output_current, hidden_size, nullptr);
+            }
+            if (cached_length > first_length) {
+              math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasNoTrans, sequence_length, head_size,
+                                              cached_length - first_length, 1.0f, probs + first_length,
+                                              context_length, v_cache, head_size, 1.0f, output_current, hidden_size,
+                                              nullptr);
+            }
+            math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasNoTrans, sequence_length, head_size, sequence_length,
+                                            1.0f, probs + cached_length, context_length, v, head_size,
+                                            cached_length > 0 ? 1.0f : 0.0f, output_current, hidden_size, nullptr);
+          }
+        });
+  }
+
+  // Helper function to write the new K and V of every sequence to a ring buffer KV cache, where the token at
+  // position p is stored at index p % capacity. Only the last `capacity` tokens of a long chunk are kept.
+  void WriteToRingBufferKVCache(const float* K,            // new K data. Its size is BxN_kvxSxH
+                                const float* V,            // new V data. Its size is BxN_kvxSxH
+                                const int32_t* seqlens_k,  // past sequence lengths tensor
+                                bool is_first_prompt,      // whether the new tokens start at position 0
+                                int batch_size,            // batch size of self-attention
+                                int sequence_length,       // sequence length of self-attention (S)
+                                int capacity,              // number of tokens of the ring buffer
+                                int head_size,             // head size of self-attention
+                                float* present_key,        // key ring buffer with size BxN_kvxCxH
+                                float* present_value,      // value ring buffer with size BxN_kvxCxH
+                                bool packed_qkv,           // whether Q, K, V are packed
+                                ThreadPool* tp) const {
+    const ptrdiff_t packed_batch_stride =
+        packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
+                   : SafeInt<ptrdiff_t>(0);
+    const size_t input_chunk_length = static_cast<size_t>(sequence_length) * head_size;  // S x H
+    const size_t cache_chunk_length = static_cast<size_t>(capacity) * head_size;        // C x H
+    const size_t bytes_per_token = SafeInt<size_t>(head_size) * sizeof(float);
+
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles = 0;
+    unit_cost.bytes_loaded = static_cast<double>(2 * std::min(sequence_length, capacity) * bytes_per_token);
+    unit_cost.bytes_stored = unit_cost.bytes_loaded;
+
+    ThreadPool::TryParallelFor(
+        tp, SafeInt<ptrdiff_t>(batch_size) * kv_num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t i = begin; i != end; ++i) {
+            const int batch_index = static_cast<int>(i / kv_num_heads_);
+            const int kv_head_index = static_cast<int>(i % kv_num_heads_);
+            const int total_seqlen = seqlens_k[batch_index] + 1;
+            // the padding after the tokens of a first prompt is not cached
+            const int start_position = is_first_prompt ? 0 : total_seqlen - sequence_length;
+            const int end_position = is_first_prompt ? std::min(total_seqlen, sequence_length) : total_seqlen;
+
+            const size_t input_offset = packed_qkv
+                                            ? packed_batch_stride * batch_index + input_chunk_length * kv_head_index
+                                            : input_chunk_length * i;
+            for (int position = std::max(start_position, end_position - capacity); position < end_position;
+                 position++) {
+              const size_t cache_offset = cache_chunk_length * i + static_cast<size_t>(position % capacity) * head_size;
+              const size_t token_offset = input_offset + static_cast<size_t>(position - start_position) * head_size;
+              memcpy(present_key + cache_offset, K + token_offset, bytes_per_token);
+              memcpy(present_value + cache_offset, V + token_offset, bytes_per_token);
+            }
+          }
+        });
+  }
+
+  // Number of tokens of the int8 KV cache converted to float at a time.
+  static constexpr int kQuantizedKVCacheBlockSize = 64;
+
+  // Int8 K and V of a KV cache with their per-token scales. The data has shape (B, N_kv, S*, H), the scales
+  // (B, N_kv, S*).
+  template <bool is_const>
+  struct QuantizedKVCacheT {
+    std::conditional_t<is_const, const int8_t, int8_t>* key;
+    std::conditional_t<is_const, const int8_t, int8_t>* value;
+    std::conditional_t<is_const, const float, float>* key_scale;
+    std::conditional_t<is_const, const float, float>* value_scale;
+  };
+  using PastQuantizedKVCache = QuantizedKVCacheT<true>;
+  using PresentQuantizedKVCache = QuantizedKVCacheT<false>;
+
+  // Quantizes a token of K or V to int8 with its own symmetric scale.
+  static void QuantizeToken(const float* input, int8_t* output, float* scale, int head_size) {
+    float max_abs = 0.0f;
+    for (int h = 0; h < head_size; h++) {
+      max_abs = std::max(max_abs, std::fabs(input[h]));
+    }
+    *scale = max_abs / 127.0f;
+    MlasQuantizeLinear<int8_t>(input, output, static_cast<size_t>(head_size), *scale != 0.0f ? *scale : 1.0f, 0);
+  }
+
+  // Helper function to copy the past tokens of an int8 KV cache to present, if they do not share a buffer, and
+  // to quantize the new K and V into present after them.
+  void WriteToQuantizedKVCache(const float* K,                          // new K data. Its size is BxN_kvxSxH
+                               const float* V,                          // new V data. Its size is BxN_kvxSxH
+                               const int32_t* seqlens_k,                // past sequence lengths tensor
+                               bool is_first_prompt,                    // whether the KV cache holds no past tokens
+                               int batch_size,                          // batch size of self-attention
+                               int sequence_length,                     // sequence length of self-attention (S)
+                               int past_buffer_sequence_length,         // sequence length of past state
+                               int present_buffer_sequence_length,      // sequence length of present state
+                               int head_size,                           // head size of self-attention
+                               const PastQuantizedKVCache& past,        // past KV cache
+                               const PresentQuantizedKVCache& present,  // present KV cache
+                               bool packed_qkv,                         // whether Q, K, V are packed
+                               ThreadPool* tp) const {
+    const ptrdiff_t packed_batch_stride =
+        packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
+                   : SafeInt<ptrdiff_t>(0);
+    const size_t kv_input_chunk_length = static_cast<size_t>(sequence_length) * head_size;                     // S x H
+    const size_t past_buff_chunk_length = static_cast<size_t>(past_buffer_sequence_length) * head_size;        // S* x H
+    const size_t present_buff_chunk_length = static_cast<size_t>(present_buffer_sequence_length) * head_size;  // T x H
+    const size_t num_chunks = SafeInt<size_t>(batch_size) * kv_num_heads_;
+
+    if (present.key != past.key) {
+      memset(present.key, 0, num_chunks * present_buff_chunk_length);
+      memset(present.key_scale, 0, num_chunks * present_buffer_sequence_length * sizeof(float));
+    }
+    if (present.value != past.value) {
+      memset(present.value, 0, num_chunks * present_buff_chunk_length);
+      memset(present.value_scale, 0, num_chunks * present_buffer_sequence_length * sizeof(float));
+    }
+
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles = static_cast<double>(4 * kv_input_chunk_length);
+    unit_cost.bytes_loaded = static_cast<double>(2 * kv_input_chunk_length * sizeof(float));
+    unit_cost.bytes_stored = static_cast<double>(2 * kv_input_chunk_length);
+
+    ThreadPool::TryParallelFor(
+        tp, static_cast<ptrdiff_t>(num_chunks), unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t i = begin; i != end; ++i) {
+            const int batch_index = static_cast<int>(i / kv_num_heads_);
+            const int kv_head_index = static_cast<int>(i % kv_num_heads_);
+            const int past_seqlen =
+                is_first_prompt ? 0 : static_cast<int>(seqlens_k[batch_index]) + 1 - sequence_length;
+
+            int8_t* present_key = present.key + present_buff_chunk_length * i;
+            int8_t* present_value = present.value + present_buff_chunk_length * i;
+            float* present_key_scale = present.key_scale + static_cast<size_t>(present_buffer_sequence_length) * i;
+            float* present_value_scale = present.value_scale + static_cast<size_t>(present_buffer_sequence_length) * i;
+
+            if (past_seqlen > 0) {
+              const size_t past_scale_offset = static_cast<size_t>(past_buffer_sequence_length) * i;
+              if (past.key != nullptr && past.key != present.key) {
+                memcpy(present_key, past.key + past_buff_chunk_length * i,
+                       static_cast<size_t>(past_seqlen) * head_size);
+                memcpy(present_key_scale, past.key_scale + past_scale_offset, past_seqlen * sizeof(float));
+              }
+              if (past.value != nullptr && past.value != present.value) {
+                memcpy(present_value, past.value + past_buff_chunk_length * i,
+                       static_cast<size_t>(past_seqlen) * head_size);
+                memcpy(present_value_scale, past.value_scale + past_scale_offset, past_seqlen * sizeof(float));
+              }
+            }
+
+            const size_t input_offset = packed_qkv
+                                            ? packed_batch_stride * batch_index + kv_input_chunk_length * kv_head_index
+                                            : kv_input_chunk_length * i;
+            for (int seq = 0; seq < sequence_length; seq++) {
+              const size_t position = static_cast<size_t>(past_seqlen) + seq;
+              QuantizeToken(K + input_offset + seq * head_size, present_key + position * head_size,
+                            present_key_scale + position, head_size);
+              QuantizeToken(V + input_offset + seq * head_size, present_value + position * head_size,
+                            present_value_scale + position, head_size);
+            }
+          }
+        });
+  }
+
+  // Helper function to compute the attention probs from an int8 KV cache:
+  //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T) x key_scale(B, N, T)
+  //  attention_probs(B, N, S, T) = Softmax(attention_probs)
+  void ComputeAttentionProbsWithQuantizedKVCache(float* attention_probs,                  // output of size BxNxSxT
+                                                 const float* Q,                          // Q data. Its size is BxNxSxH
+                                                 const int32_t* seqlens_k,                // past sequence lengths
+                                                 bool is_first_prompt,                    // no past tokens
+                                                 int batch_size,                          // batch size
+                                                 int sequence_length,                     // sequence length (S)
+                                                 int present_buffer_sequence_length,      // present length (T)
+                                                 int head_size,                           // head size of self-attention
+                                                 const PresentQuantizedKVCache& present,  // present KV cache
+                                                 bool packed_qkv,                         // whether Q, K, V are packed
+                                                 ThreadPool* tp) const {
+    const ptrdiff_t packed_batch_stride =
+        packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
+                   : SafeInt<ptrdiff_t>(0);
+    const int kv_num_heads_factor = num_heads_ / kv_num_heads_;
+    const size_t q_input_chunk_length = static_cast<size_t>(sequence_length) * head_size;                      // S x H
+    const size_t present_buff_chunk_length = static_cast<size_t>(present_buffer_sequence_length) * head_size;  // T x H
+    const float alpha = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles =
+        static_cast<double>(SafeInt<ptrdiff_t>(2) * sequence_length * head_size * present_buffer_sequence_length);
+    unit_cost.bytes_loaded =
+        static_cast<double>(sequence_length * head_size * sizeof(float) + present_buff_chunk_length);
+    unit_cost.bytes_stored =
+        static_cast<double>(SafeInt<ptrdiff_t>(sequence_length) * present_buffer_sequence_length * sizeof(float));
+
+    ThreadPool::TryParallelFor(
+        tp, SafeInt<ptrdiff_t>(batch_size) * num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          std::vector<float> key_block(static_cast<size_t>(kQuantizedKVCacheBlockSize) * head_size);
+          for (std::ptrdiff_t i = begin; i != end; ++i) {
+            const int batch_index = static_cast<int>(i) / num_heads_;
+            const int head_index = static_cast<int>(i) % num_heads_;
+            const int total_seqlen = seqlens_k[batch_index] + 1;
+            const std::ptrdiff_t kv_index = i / kv_num_heads_factor;
+
+            float* output = attention_probs + i * sequence_length * present_buffer_sequence_length;
+            const float* q = packed_qkv ? Q + packed_batch_stride * batch_index + q_input_chunk_length * head_index
+                                        : Q + q_input_chunk_length * i;
+            const int8_t* k = present.key + present_buff_chunk_length * kv_index;
+            const float* k_scale = present.key_scale + present_buffer_sequence_length * kv_index;
+
+            for (int start = 0; start < total_seqlen; start += kQuantizedKVCacheBlockSize) {
+              const int block_length = std::min(kQuantizedKVCacheBlockSize, total_seqlen - start);
+              const int8_t* k_block = k + static_cast<size_t>(start) * head_size;
+              for (int j = 0; j < block_length * head_size; j++) {
+                key_block[j] = static_cast<float>(k_block[j]);
+              }
+
+              math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, block_length, head_size,
+                                              alpha, q, head_size, key_block.data(), head_size, 0.0f /*beta*/,
+                                              output + start, present_buffer_sequence_length, nullptr);
+
+              for (int seq = 0; seq < sequence_length; seq++) {
+                float* row = output + static_cast<size_t>(seq) * present_buffer_sequence_length + start;
+                for (int j = 0; j < block_length; j++) {
+                  row[j] *= k_scale[start + j];
+                }
+              }
+            }
+
+            const int past_seqlen = is_first_prompt ? 0 : total_seqlen - sequence_length;
+            ComputeCausalSoftmax(output, sequence_length, total_seqlen, past_seqlen, present_buffer_sequence_length);
+          }
+        });
+  }
+
+  // Helper function to compute out(B, S, N, H) = attention_probs(B, N, S, T) x value_scale(B, N, T) x V(B, N, T, H)
+  // from an int8 KV cache. The scales of V are folded into the probs, which are overwritten.
+  void ComputeVxAttentionScoreWithQuantizedKVCache(float* output,                           // buffer of size BxSxNxH
+                                                   float* attention_probs,                  // probs with size BxNxSxT
+                                                   const int32_t* seqlens_k,                // past sequence lengths
+                                                   int batch_size,                          // batch size
+                                                   int sequence_length,                     // sequence length
+                                                   int present_buffer_sequence_length,      // present length (T)
+                                                   int head_size,                           // head size of Q, K, V
+                                                   int hidden_size,                         // hidden size of Output
+                                                   const PresentQuantizedKVCache& present,  // present cache
+                                                   ThreadPool* tp) const {
+    const int kv_num_heads_factor = num_heads_ / kv_num_heads_;
+    const size_t present_buff_chunk_length = static_cast<size_t>(present_buffer_sequence_length) * head_size;  // T x H
+
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles =
+        static_cast<double>(SafeInt<ptrdiff_t>(2) * sequence_length * head_size * present_buffer_sequence_length);
+    unit_cost.bytes_loaded =
+        static_cast<double>(SafeInt<ptrdiff_t>(sequence_length) * present_buffer_sequence_length * sizeof(float)) +
+        static_cast<double>(present_buff_chunk_length);
+    unit_cost.bytes_stored = static_cast<double>(sequence_length * head_size * sizeof(float));
+
+    ThreadPool::TryParallelFor(
+        tp, SafeInt<ptrdiff_t>(batch_size) * num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          std::vector<float> value_block(static_cast<size_t>(kQuantizedKVCacheBlockSize) * head_size);
+          for (std::ptrdiff_t i = begin; i != end; ++i) {
+            const int batch_index = static_cast<int>(i / num_heads_);
+            const int head_index = static_cast<int>(i % num_heads_);
+            const int total_seqlen = seqlens_k[batch_index] + 1;
+            const std::ptrdiff_t kv_index = i / kv_num_heads_factor;
+
+            float* probs = attention_probs + i * sequence_length * present_buffer_sequence_length;
+            const int8_t* v = present.value + present_buff_chunk_length * kv_index;
+            const float* v_scale = present.value_scale + present_buffer_sequence_length * kv_index;
+            float* output_current = output + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
+
+            for (int seq = 0; seq < sequence_length; seq++) {
+              float* row = probs + static_cast<size_t>(seq) * present_buffer_sequence_length;
+              for (int j = 0; j < total_seqlen; j++) {
+                row[j] *= v_scale[j];
+              }
+            }
+
+            for (int start = 0; start < total_seqlen; start += kQuantizedKVCacheBlockSize) {
+              const int block_length = std::min(kQuantizedKVCacheBlockSize, total_seqlen - start);
+              const int8_t* v_block = v + static_cast<size_t>(start) * head_size;
+              for (int j = 0; j < block_length * head_size; j++) {
+                value_block[j] = static_cast<float>(v_block[j]);
+              }
+
+              math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasNoTrans, sequence_length, head_size, block_length,
+                                              1.f, /*alpha*/
+                                              probs + start, present_buffer_sequence_length, value_block.data(),
+                                              head_size, start == 0 ? 0.0f : 1.0f /*beta*/, output_current,
+                                              hidden_size, nullptr);
+            }
           }
         });
   }
@@ -3,7 +3,6 @@
 
 #include "contrib_ops/cpu/bert/group_query_attention.h"
 #include "contrib_ops/cpu/bert/group_query_attention_helper.h"
-#include "contrib_ops/cpu/bert/rotary_helper.h"
 #include "contrib_ops/cpu/bert/attention_utils.h"
 #include "contrib_ops/cpu/bert/rotary_embedding.h"
 #include "contrib_ops/cpu/bert/rotary_embedding_helper.h"
@@ -30,12 +29,16 @@ ONNX_OPERATOR_TYPED_KERNEL_EX(
     kCpuExecutionProvider,
     KernelDefBuilder()
         .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T_CACHE", {DataTypeImpl::GetTensorType<float>(), DataTypeImpl::GetTensorType<int8_t>()})
         .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>()),
     GroupQueryAttention<float>);
 
 template <typename T>
 GroupQueryAttention<T>::GroupQueryAttention(const OpKernelInfo& info)
-    : OpKernel(info), GQAAttentionBase(info, true) {}
+    : OpKernel(info), GQAAttentionBase(info, true) {
+  const auto& output_defs = info.node().OutputDefs();
+  quantized_kv_cache_ = output_defs.size() > 3 && output_defs[3]->Exists();
+}
 
 template <typename T>
 Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
@@ -48,14 +51,20 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   const Tensor* total_seqlen = context->Input<Tensor>(6);
   const Tensor* cos_cache = context->Input<Tensor>(7);
   const Tensor* sin_cache = context->Input<Tensor>(8);
+  const Tensor* block_table = context->Input<Tensor>(9);
+  const Tensor* past_key_scale = context->Input<Tensor>(10);
+  const Tensor* past_value_scale = context->Input<Tensor>(11);
+
+  // the paged KV cache has no batch dimension, so its past key and value are checked separately
+  const bool is_paged_kv_cache = block_table != nullptr;
 
   GroupQueryAttentionParameters parameters = {};
   constexpr float scale = 1.0f;
   ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckInputs(query,
                                                                 key,
                                                                 value,
-                                                                past_key,
-                                                                past_value,
+                                                                is_paged_kv_cache ? nullptr : past_key,
+                                                                is_paged_kv_cache ? nullptr : past_value,
                                                                 cos_cache,
                                                                 sin_cache,
                                                                 &parameters,
@@ -64,6 +73,55 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
                                                                 seqlens_k,
                                                                 total_seqlen,
                                                                 scale));
+  if (quantized_kv_cache_) {
+    if (is_paged_kv_cache) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "An int8 KV cache cannot be paged.");
+    }
+    ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckQuantizedKVCacheInputs(past_key,
+                                                                                  past_value,
+                                                                                  past_key_scale,
+                                                                                  past_value_scale,
+                                                                                  parameters));
+  } else if (past_key != nullptr && !past_key->IsDataType<T>()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key' and 'past_value' shall have the type of query without "
+                           "present_key_scale and present_value_scale outputs.");
+  }
+  if (is_paged_kv_cache) {
+    ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckPagedKVCacheInputs(past_key,
+                                                                              past_value,
+                                                                              block_table,
+                                                                              seqlens_k,
+                                                                              parameters));
+  }
+
+  if (kv_cache_ring_buffer_) {
+    if (is_paged_kv_cache || quantized_kv_cache_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "A ring buffer KV cache cannot be paged or quantized.");
+    }
+    // The ring buffer keeps at least the tokens of the local window, however long the sequence gets.
+    if (past_key != nullptr && parameters.seqlen_past_kv_cache < local_window_size_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'past_key' and 'past_value' of a ring buffer KV cache shall have at least "
+                             "local_window_size tokens. Got ", parameters.seqlen_past_kv_cache);
+    }
+    parameters.seqlen_present_kv_cache = past_key != nullptr ? parameters.seqlen_past_kv_cache : local_window_size_;
+  }
+
+  if (parameters.is_subsequent_prompt) {
+    // the chunk is appended to the tokens already in the KV cache
+    const int32_t* seqlens_k_data = seqlens_k->Data<int32_t>();
+    for (int b = 0; b < parameters.batch_size; b++) {
+      const int total_seqlen = seqlens_k_data[b] + 1;
+      if (total_seqlen < parameters.sequence_length ||
+          (!kv_cache_ring_buffer_ && total_seqlen > parameters.seqlen_present_kv_cache)) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "seqlens_k of batch entry ", b, " of a prompt chunk shall be in [",
+                               parameters.sequence_length - 1, ", ", parameters.seqlen_present_kv_cache - 1,
+                               "]. Got ", seqlens_k_data[b]);
+      }
+    }
+  }
 
   const int batch_size = parameters.batch_size;
   const int sequence_length = parameters.sequence_length;
@@ -80,8 +138,15 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
 
   std::vector<int64_t> present_k_shape({static_cast<int64_t>(batch_size), static_cast<int64_t>(kv_num_heads_), static_cast<int64_t>(present_kv_seqlen), static_cast<int64_t>(head_size)});
   std::vector<int64_t> present_v_shape({static_cast<int64_t>(batch_size), static_cast<int64_t>(kv_num_heads_), static_cast<int64_t>(present_kv_seqlen), static_cast<int64_t>(head_size)});
-  Tensor* present_k = context->Output(1, present_k_shape);
-  Tensor* present_v = context->Output(2, present_v_shape);
+  Tensor* present_k = is_paged_kv_cache ? context->Output(1, past_key->Shape()) : context->Output(1, present_k_shape);
+  Tensor* present_v = is_paged_kv_cache ? context->Output(2, past_value->Shape()) : context->Output(2, present_v_shape);
+  Tensor* present_k_scale = nullptr;
+  Tensor* present_v_scale = nullptr;
+  if (quantized_kv_cache_) {
+    TensorShape present_scale_shape({batch_size, kv_num_heads_, present_kv_seqlen});
+    present_k_scale = context->Output(3, present_scale_shape);
+    present_v_scale = context->Output(4, present_scale_shape);
+  }
 
   AllocatorPtr allocator;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
@@ -90,7 +155,53 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   OrtValue Q;
   OrtValue K;
   OrtValue V;
-  if (packed_qkv) {
+  if (do_rotary_) {
+    // Tokens of the first prompt start at position 0, the ones of later runs end at position seqlens_k[b].
+    const bool is_first_prompt = parameters.is_prompt && !parameters.is_subsequent_prompt;
+    const int position_ids_format = is_first_prompt ? 0 : 1;
+    std::vector<int64_t> pos_ids(is_first_prompt ? 1 : SafeInt<size_t>(batch_size) * sequence_length);
+    if (is_first_prompt) {
+      pos_ids[0] = static_cast<int64_t>(0);
+    } else {
+      for (int b = 0; b < batch_size; b++) {
+        const int64_t start = static_cast<int64_t>(seqlens_k->Data<int32_t>()[b]) + 1 - sequence_length;
+        for (int s = 0; s < sequence_length; s++) {
+          pos_ids[b * sequence_length + s] = start + s;
+        }
+      }
+    }
+
+    // Q and K are rotated while they are transposed to BNSH, so each element is read and written once. The V heads
+    // of a packed QKV input are copied in the same pass.
+    auto* tp = context->GetOperatorThreadPool();
+    const T* cos_data = cos_cache->Data<T>();
+    const T* sin_data = sin_cache->Data<T>();
+    const int rotary_dim = parameters.rotary_dim;
+    if (packed_qkv) {
+      const int qkv_num_heads = num_heads_ + 2 * kv_num_heads_;
+      Tensor::InitOrtValue(element_type, TensorShape({batch_size, qkv_num_heads, sequence_length, head_size}),
+                           allocator, Q);
+      ORT_RETURN_IF_ERROR(RunRotaryEmbeddingAndTransposeToBNSH<T>(
+          tp, batch_size, sequence_length, qkv_num_heads, num_heads_ + kv_num_heads_, head_size, rotary_dim,
+          pos_ids.data(), position_ids_format, cos_data, sin_data, query->Data<T>(),
+          Q.GetMutable<Tensor>()->MutableData<T>(), rotary_interleaved_));
+    } else {
+      Tensor::InitOrtValue(element_type, TensorShape({batch_size, num_heads_, sequence_length, head_size}),
+                           allocator, Q);
+      Tensor::InitOrtValue(element_type, TensorShape({batch_size, kv_num_heads_, sequence_length, head_size}),
+                           allocator, K);
+      ORT_RETURN_IF_ERROR(RunRotaryEmbeddingAndTransposeToBNSH<T>(
+          tp, batch_size, sequence_length, num_heads_, num_heads_, head_size, rotary_dim,
+          pos_ids.data(), position_ids_format, cos_data, sin_data, query->Data<T>(),
+          Q.GetMutable<Tensor>()->MutableData<T>(), rotary_interleaved_));
+      ORT_RETURN_IF_ERROR(RunRotaryEmbeddingAndTransposeToBNSH<T>(
+          tp, batch_size, sequence_length, kv_num_heads_, kv_num_heads_, head_size, rotary_dim,
+          pos_ids.data(), position_ids_format, cos_data, sin_data, key->Data<T>(),
+          K.GetMutable<Tensor>()->MutableData<T>(), rotary_interleaved_));
+      ORT_RETURN_IF_ERROR(MaybeTransposeToBNSH<T>(
+          allocator, batch_size, kv_num_heads_, sequence_length, head_size, value, V));
+    }
+  } else if (packed_qkv) {
     ORT_RETURN_IF_ERROR(MaybeTransposeToBNSH<T>(
         allocator, batch_size, num_heads_ + 2 * kv_num_heads_, sequence_length, head_size, query, Q));
   } else {
@@ -102,84 +213,25 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
         allocator, batch_size, kv_num_heads_, sequence_length, head_size, value, V));
   }
 
-  if (do_rotary_) {
-    rotary_embedding_helper::RotaryParameters rotary_params = {};
-    rotary_params.batch_size = batch_size;
-    rotary_params.sequence_length = sequence_length;
-    rotary_params.hidden_size = q_hidden_size;
-    rotary_params.head_size = head_size;
-    rotary_params.rotary_embedding_dim = parameters.rotary_dim;
-    rotary_params.num_heads = num_heads_;
-    rotary_params.max_sequence_length = sequence_length;  // unused
-    rotary_params.seq_stride = head_size;
-    rotary_params.head_stride = sequence_length * rotary_params.seq_stride;
-    rotary_params.batch_stride = (packed_qkv ? (num_heads_ + 2 * kv_num_heads_) : num_heads_) * rotary_params.head_stride;
-    rotary_params.position_ids_format = sequence_length == 1 ? 1 : 0;
-    rotary_params.transposed = true;
-    auto* tp = context->GetOperatorThreadPool();
-    std::vector<int64_t> pos_ids(sequence_length == 1 ? batch_size : 1);
-    if (sequence_length == 1) {
-      for (int b = 0; b < batch_size; b++) {
-        pos_ids[b] = static_cast<int64_t>(seqlens_k->Data<int32_t>()[b]);
-      }
-    } else {
-      pos_ids[0] = static_cast<int64_t>(0);
-    }
-    const T* q_input;
-    const T* k_input;
-    T* q_rotary;
-    T* k_rotary;
-    if (packed_qkv) {
-      OrtValue RotaryQKV;
-      Tensor::InitOrtValue(element_type, TensorShape({batch_size, num_heads_ + 2 * kv_num_heads_, sequence_length, head_size}), allocator, RotaryQKV);
-      q_input = Q.Get<Tensor>().Data<T>();
-      k_input = q_input + num_heads_ * sequence_length * head_size;
-      q_rotary = RotaryQKV.GetMutable<Tensor>()->MutableData<T>();
-      k_rotary = q_rotary + num_heads_ * sequence_length * head_size;
-      Q = RotaryQKV;
-    } else {
-      OrtValue RotaryQ;
-      Tensor::InitOrtValue(element_type, TensorShape({batch_size, num_heads_, sequence_length, head_size}), allocator, RotaryQ);
-      OrtValue RotaryK;
-      Tensor::InitOrtValue(element_type, TensorShape({batch_size, kv_num_heads_, sequence_length, head_size}), allocator, RotaryK);
-      q_input = Q.Get<Tensor>().Data<T>();
-      k_input = K.Get<Tensor>().Data<T>();
-      q_rotary = RotaryQ.GetMutable<Tensor>()->MutableData<T>();
-      k_rotary = RotaryK.GetMutable<Tensor>()->MutableData<T>();
-      Q = RotaryQ;
-      K = RotaryK;
-    }
-    ORT_RETURN_IF_ERROR(RunRotaryEmbedding<T>(tp, rotary_params, q_input,
-                                              pos_ids.data(), cos_cache->Data<T>(),
-                                              sin_cache->Data<T>(), q_rotary, rotary_interleaved_));
-
-    rotary_params.num_heads = kv_num_heads_;
-    rotary_params.hidden_size = parameters.kv_hidden_size;
-    if (!packed_qkv) {
-      rotary_params.batch_stride = kv_num_heads_ * rotary_params.head_stride;
-    }
-    ORT_RETURN_IF_ERROR(RunRotaryEmbedding<T>(tp, rotary_params, k_input,
-                                              pos_ids.data(), cos_cache->Data<T>(),
-                                              sin_cache->Data<T>(), k_rotary, rotary_interleaved_));
-    if (packed_qkv) {
-      const T* v_input = k_input + kv_num_heads_ * sequence_length * head_size;
-      T* v_rotary = k_rotary + kv_num_heads_ * sequence_length * head_size;
-      ORT_RETURN_IF_ERROR(rotary_helper::PackVIntoRotaryQKV<T>(tp,
-                                                               parameters.batch_size,
-                                                               parameters.sequence_length,
-                                                               parameters.num_heads,
-                                                               parameters.kv_num_heads,
-                                                               parameters.head_size,
-                                                               v_input,
-                                                               v_rotary));
-    }
-  }
-
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
   // Compute the attention score and apply the score to V
+  if (quantized_kv_cache_) {
+    return ApplyAttentionWithQuantizedKVCache(Q.Get<Tensor>().Data<T>(),
+                                              packed_qkv ? nullptr : K.Get<Tensor>().Data<T>(),
+                                              packed_qkv ? nullptr : V.Get<Tensor>().Data<T>(), past_key, past_value,
+                                              past_key_scale, past_value_scale, output, present_k, present_v,
+                                              present_k_scale, present_v_scale, seqlens_k, parameters, allocator,
+                                              context);
+  }
+  if (kv_cache_ring_buffer_) {
+    return ApplyAttentionWithRingBufferKVCache(Q.Get<Tensor>().Data<T>(),
+                                               packed_qkv ? nullptr : K.Get<Tensor>().Data<T>(),
+                                               packed_qkv ? nullptr : V.Get<Tensor>().Data<T>(), past_key, past_value,
+                                               output, present_k, present_v, seqlens_k, parameters, allocator, context);
+  }
   return ApplyAttention(Q.Get<Tensor>().Data<T>(), packed_qkv ? nullptr : K.Get<Tensor>().Data<T>(),
                         packed_qkv ? nullptr : V.Get<Tensor>().Data<T>(), past_key, past_value, output, present_k, present_v,
-                        seqlens_k, parameters, allocator, context);
+                        seqlens_k, block_table, parameters, allocator, context);
 }
 }  // namespace contrib
 }  // namespace onnxruntime
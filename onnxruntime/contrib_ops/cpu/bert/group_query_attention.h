@@ -15,6 +15,10 @@ class GroupQueryAttention final : public OpKernel, public GQAAttentionBase {
  public:
   GroupQueryAttention(const OpKernelInfo& info);
   Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // present_key/present_value are int8 with per-token scales in the present_key_scale/present_value_scale outputs
+  bool quantized_kv_cache_;
 };
 
 }  // namespace contrib
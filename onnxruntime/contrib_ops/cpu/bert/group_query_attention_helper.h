@@ -219,6 +219,9 @@ Status CheckInputs(const Tensor* query,
   }
 
   bool is_prompt = sequence_length != 1;
+  // A prompt is fed in chunks by passing a total_sequence_length larger than the chunk, then the seqlens_k of
+  // each sequence counts the tokens of the cache and the chunk like in token generation.
+  bool is_subsequent_prompt = is_prompt && total_sequence_length != sequence_length;
 
   if (parameters != nullptr) {
     GroupQueryAttentionParameters* output_parameters = reinterpret_cast<GroupQueryAttentionParameters*>(parameters);
@@ -235,6 +238,7 @@ Status CheckInputs(const Tensor* query,
     output_parameters->is_packed_qkv = is_packed_qkv;
     output_parameters->is_unidirectional = true;
     output_parameters->is_prompt = is_prompt;
+    output_parameters->is_subsequent_prompt = is_subsequent_prompt;
     output_parameters->scale = scale;
     output_parameters->qkv_format = qkv_format;
     output_parameters->past_kv_format = past_kv_format;
@@ -263,6 +267,125 @@ Status CheckInputs(const Tensor* query,
 
   return CheckInputs(query, key, value, past_key, past_value, cos_cache, sin_cache, parameters, num_heads, kv_num_heads, seqlens_k, total_seqlen, scale);
 }
+// Checks the inputs of the paged KV cache layout and updates the parameters from CheckInputs() accordingly.
+// CheckInputs() must be called first with no past key and value as the paged KV cache has no batch dimension.
+// Note: Here M is max_blocks_per_sequence, S_b is kv_block_size and N_blocks is the number of blocks in the pool
+//     past_key                   : (N_blocks, N_k, S_b, H)
+//     past_value                 : (N_blocks, N_k, S_b, H)
+//     block_table                : (B, M) with the index of the i-th block of the sequence of batch entry b
+// The block table entries are only checked when seqlens_k is given, as they can't be read from device memory.
+Status CheckPagedKVCacheInputs(const Tensor* past_key,
+                               const Tensor* past_value,
+                               const Tensor* block_table,
+                               const Tensor* seqlens_k,
+                               GroupQueryAttentionParameters& parameters) {
+  if (past_key == nullptr || past_value == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key' and 'past_value' shall be present when 'block_table' is provided.");
+  }
+
+  const auto& past_key_dims = past_key->Shape().GetDims();
+  if (past_key_dims.size() != 4) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key' is expected to have 4 dimensions, got ",
+                           past_key_dims.size());
+  }
+  if (past_key->Shape() != past_value->Shape()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key' and 'past_value' shall have the same shape with a paged KV cache.");
+  }
+  if (past_key_dims[1] != parameters.kv_num_heads) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key' shall have kv_num_heads");
+  }
+  if (past_key_dims[3] != parameters.head_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key' dimension 3 should be same as head_size, got ",
+                           past_key_dims[3]);
+  }
+
+  const int64_t num_blocks = past_key_dims[0];
+  const int kv_block_size = static_cast<int>(past_key_dims[2]);
+  if (num_blocks <= 0 || kv_block_size <= 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key' shall have at least one block of at least one token.");
+  }
+
+  const auto& block_table_dims = block_table->Shape().GetDims();
+  if (block_table_dims.size() != 2 || block_table_dims[0] != parameters.batch_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "block_table must be shape (batch_size, max_blocks_per_sequence).");
+  }
+  const int max_blocks_per_sequence = static_cast<int>(block_table_dims[1]);
+
+  // Every block that the new tokens are written to, or that attention reads from, must be in the pool
+  const int32_t* seqlens_k_data = seqlens_k == nullptr ? nullptr : seqlens_k->Data<int32_t>();
+  const int32_t* block_table_data = block_table->Data<int32_t>();
+  for (int b = 0; seqlens_k_data != nullptr && b < parameters.batch_size; b++) {
+    const int total_seqlen = seqlens_k_data[b] + 1;
+    const bool is_first_prompt = parameters.is_prompt && !parameters.is_subsequent_prompt;
+    const int end = is_first_prompt ? std::max(parameters.sequence_length, total_seqlen) : total_seqlen;
+    if (seqlens_k_data[b] < 0 || (end + kv_block_size - 1) / kv_block_size > max_blocks_per_sequence) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "block_table has too few blocks for the sequence of batch entry ", b);
+    }
+    for (int i = 0; i < (end + kv_block_size - 1) / kv_block_size; i++) {
+      const int32_t block = block_table_data[b * max_blocks_per_sequence + i];
+      if (block < 0 || block >= num_blocks) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "block_table entry ", block, " of batch entry ", b, " is out of range [0, ",
+                               num_blocks, ").");
+      }
+    }
+  }
+
+  parameters.seqlen_past_kv_cache = max_blocks_per_sequence * kv_block_size;
+  parameters.seqlen_present_kv_cache = max_blocks_per_sequence * kv_block_size;
+  parameters.kv_block_size = kv_block_size;
+  parameters.max_blocks_per_sequence = max_blocks_per_sequence;
+  parameters.kv_share_buffer = true;
+
+  return Status::OK();
+}
+
+// Checks the inputs of an int8 KV cache. CheckInputs() must be called first.
+// Note: Here S* is seqlen_past_kv_cache
+//     past_key, past_value              : (B, N_k, S*, H) of int8 or nullptr
+//     past_key_scale, past_value_scale  : (B, N_k, S*) with the scale of each token or nullptr
+Status CheckQuantizedKVCacheInputs(const Tensor* past_key,
+                                   const Tensor* past_value,
+                                   const Tensor* past_key_scale,
+                                   const Tensor* past_value_scale,
+                                   const GroupQueryAttentionParameters& parameters) {
+  if (past_key == nullptr) {
+    if (past_key_scale != nullptr || past_value_scale != nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 'past_key_scale' and 'past_value_scale' shall be absent without past key and "
+                             "value.");
+    }
+    return Status::OK();
+  }
+
+  if (!past_key->IsDataType<int8_t>() || !past_value->IsDataType<int8_t>()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key' and 'past_value' shall be int8 with an int8 KV cache.");
+  }
+  if (past_key_scale == nullptr || past_value_scale == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key_scale' and 'past_value_scale' shall be present with an int8 KV cache.");
+  }
+
+  const TensorShape expected_scale_shape({parameters.batch_size, parameters.kv_num_heads,
+                                          parameters.seqlen_past_kv_cache});
+  if (past_key_scale->Shape() != expected_scale_shape || past_value_scale->Shape() != expected_scale_shape) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'past_key_scale' and 'past_value_scale' shall have shape ", expected_scale_shape,
+                           ", got ", past_key_scale->Shape(), " and ", past_value_scale->Shape());
+  }
+
+  return Status::OK();
+}
+
 }  // namespace group_query_attention_helper
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -4,8 +4,11 @@
 #include "contrib_ops/cpu/bert/rotary_embedding.h"
 #include "contrib_ops/cpu/bert/rotary_embedding_helper.h"
 
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 
+#include <cstring>
+
 using onnxruntime::concurrency::ThreadPool;
 using namespace onnxruntime::contrib::rotary_embedding_helper;
 
@@ -37,7 +40,6 @@ RotaryEmbedding<T>::RotaryEmbedding(const OpKernelInfo& info) : OpKernel(info) {
   }
 }
 
-// TODO: rotary embedding in place
 template <typename T>
 Status RunRotaryEmbedding(concurrency::ThreadPool* tp, RotaryParameters parameters, const T* input,
                           const int64_t* position_ids, const T* cos_cache, const T* sin_cache, T* output,
@@ -74,23 +76,10 @@ Status RunRotaryEmbedding(concurrency::ThreadPool* tp, RotaryParameters paramete
       const T* cos_data = cos_cache + cache_offset;
       const T* sin_data = sin_cache + cache_offset;
 
-      int cache_idx = 0;
-      T sign = 0;
-      int j = 0;
-      for (int i = 0; i < rotary_emb_dim; i++) {
-        if (interleaved) {
-          cache_idx = (i / 2) % half_rotary_emb_dim;
-          sign = (i % 2 == 0) ? static_cast<T>(-1) : static_cast<T>(1);
-          j = (i % 2 == 0) ? i + 1 : i - 1;  // i - sign
-        } else {
-          cache_idx = i % half_rotary_emb_dim;
-          sign = (i < half_rotary_emb_dim) ? static_cast<T>(-1) : static_cast<T>(1);
-          j = (i + half_rotary_emb_dim) % rotary_emb_dim;
-        }
-        output_data[i] = input_data[i] * cos_data[cache_idx] + sign * input_data[j] * sin_data[cache_idx];
-      }
-      for (int i = rotary_emb_dim; i < head_size; i++) {
-        output_data[i] = input_data[i];
+      MlasRotaryEmbedOneRow(input_data, sin_data, cos_data, rotary_emb_dim, interleaved, output_data);
+      if (rotary_emb_dim < head_size && input_data != output_data) {
+        std::memcpy(output_data + rotary_emb_dim, input_data + rotary_emb_dim,
+                    (head_size - rotary_emb_dim) * sizeof(T));
       }
     }
   });
@@ -102,6 +91,56 @@ template Status RunRotaryEmbedding<float>(concurrency::ThreadPool* tp, RotaryPar
                                           const int64_t* position_ids, const float* cos_cache, const float* sin_cache, float* output,
                                           bool interleaved);
 
+template <typename T>
+Status RunRotaryEmbeddingAndTransposeToBNSH(concurrency::ThreadPool* tp, int batch_size, int sequence_length,
+                                            int num_heads, int rotary_num_heads, int head_size,
+                                            int rotary_embedding_dim, const int64_t* position_ids,
+                                            int position_ids_format, const T* cos_cache, const T* sin_cache,
+                                            const T* input, T* output, bool interleaved) {
+  const int half_rotary_emb_dim = rotary_embedding_dim / 2;
+  const size_t row_size = static_cast<size_t>(head_size) * sizeof(T);
+
+  const int loop_len = batch_size * sequence_length * num_heads;
+  const double cost = static_cast<double>(head_size);
+  ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t ptr = begin; ptr != end; ++ptr) {
+      const int b = static_cast<int>((ptr / num_heads) / sequence_length);
+      const int s = static_cast<int>((ptr / num_heads) % sequence_length);
+      const int n = static_cast<int>(ptr % num_heads);
+
+      // The input is (B, S, N, H) and the output is (B, N, S, H).
+      const T* input_data = input + ptr * head_size;
+      T* output_data = output + ((static_cast<std::ptrdiff_t>(b) * num_heads + n) * sequence_length + s) * head_size;
+
+      if (n >= rotary_num_heads) {
+        std::memcpy(output_data, input_data, row_size);
+        continue;
+      }
+
+      const int position_id = (position_ids_format == 0)
+                                  ? static_cast<int>(position_ids[0]) + s
+                                  : static_cast<int>(position_ids[b * sequence_length + s]);
+      const int cache_offset = position_id * half_rotary_emb_dim;
+
+      MlasRotaryEmbedOneRow(input_data, sin_cache + cache_offset, cos_cache + cache_offset,
+                            rotary_embedding_dim, interleaved, output_data);
+      if (rotary_embedding_dim < head_size) {
+        std::memcpy(output_data + rotary_embedding_dim, input_data + rotary_embedding_dim,
+                    (head_size - rotary_embedding_dim) * sizeof(T));
+      }
+    }
+  });
+
+  return Status::OK();
+}
+
+template Status RunRotaryEmbeddingAndTransposeToBNSH<float>(concurrency::ThreadPool* tp, int batch_size,
+                                                            int sequence_length, int num_heads, int rotary_num_heads,
+                                                            int head_size, int rotary_embedding_dim,
+                                                            const int64_t* position_ids, int position_ids_format,
+                                                            const float* cos_cache, const float* sin_cache,
+                                                            const float* input, float* output, bool interleaved);
+
 template <typename T>
 Status RotaryEmbedding<T>::Compute(OpKernelContext* context) const {
   const Tensor* input = context->Input<Tensor>(0);
@@ -14,6 +14,16 @@ Status RunRotaryEmbedding(onnxruntime::concurrency::ThreadPool* tp, rotary_embed
                           const int64_t* position_ids, const T* cos_cache, const T* sin_cache, T* output,
                           bool interleaved);
 
+// Applies rotary embedding to the first rotary_num_heads heads of a (batch, sequence, num_heads, head_size) input
+// while transposing it to (batch, num_heads, sequence, head_size). The remaining heads are only transposed, so a
+// packed QKV input is split with rotary_num_heads = num_heads + kv_num_heads in a single pass.
+template <typename T>
+Status RunRotaryEmbeddingAndTransposeToBNSH(onnxruntime::concurrency::ThreadPool* tp, int batch_size,
+                                            int sequence_length, int num_heads, int rotary_num_heads, int head_size,
+                                            int rotary_embedding_dim, const int64_t* position_ids,
+                                            int position_ids_format, const T* cos_cache, const T* sin_cache,
+                                            const T* input, T* output, bool interleaved);
+
 template <typename T>
 class RotaryEmbedding final : public OpKernel {
  public:
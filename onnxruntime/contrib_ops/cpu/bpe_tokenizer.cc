@@ -0,0 +1,259 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/bpe_tokenizer.h"
+
+#include "core/common/narrow.h"
+#include "core/framework/op_kernel.h"
+#include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
+#include "re2/re2.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_set>
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace bpe_details {
+
+bool IsSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+// The words of GPT-2: contractions, letters, digits and other characters with an optional leading space, and
+// runs of spaces.
+const re2::RE2& WordExpression() {
+  static const re2::RE2 expression("('s|'t|'re|'ve|'m|'ll|'d| ?\\pL+| ?\\pN+| ?[^\\s\\pL\\pN]+|\\s+)");
+  return expression;
+}
+
+}  // namespace bpe_details
+
+using namespace bpe_details;
+
+Status BpeModel::Load(gsl::span<const std::string> vocab, gsl::span<const std::string> merges) {
+  token_ids_.clear();
+  merge_ranks_.clear();
+
+  token_ids_.reserve(vocab.size());
+  for (size_t id = 0; id < vocab.size(); id++) {
+    token_ids_.emplace(vocab[id], narrow<int64_t>(id));
+  }
+
+  merge_ranks_.reserve(merges.size());
+  for (size_t rank = 0; rank < merges.size(); rank++) {
+    const std::string& merge = merges[rank];
+    const size_t space = merge.find(' ');
+    if (space == std::string::npos || space == 0 || space + 1 == merge.size() ||
+        merge.find(' ', space + 1) != std::string::npos) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Merge ", rank, " '", merge,
+                             "' is not a pair of tokens separated by a space.");
+    }
+    merge_ranks_.emplace(merge, narrow<int>(rank));
+  }
+
+  return Status::OK();
+}
+
+Status BpeModel::Encode(std::string_view text, int64_t unk_token_id, std::vector<int64_t>& ids) const {
+  re2::StringPiece input(text.data(), text.size());
+  re2::StringPiece word;
+  while (!input.empty()) {
+    if (!re2::RE2::Consume(&input, WordExpression(), &word)) {
+      // a byte that isn't valid UTF-8 is a word of its own
+      word = re2::StringPiece(input.data(), 1);
+      input.remove_prefix(1);
+    } else if (word.size() > 1 && IsSpace(word[word.size() - 1]) && !input.empty()) {
+      // like in GPT-2, the last space of a run of spaces before a word belongs to the word
+      word.remove_suffix(1);
+      input = re2::StringPiece(word.data() + word.size(), input.size() + 1);
+    }
+    ORT_RETURN_IF_ERROR(EncodeWord(std::string_view(word.data(), word.size()), unk_token_id, ids));
+  }
+
+  return Status::OK();
+}
+
+Status BpeModel::EncodeWord(std::string_view word, int64_t unk_token_id, std::vector<int64_t>& ids) const {
+  const auto& byte_characters = ByteCharacters();
+  InlinedVector<std::string> symbols;
+  symbols.reserve(word.size());
+  for (char b : word) {
+    std::string symbol;
+    AppendUtf8(byte_characters[static_cast<unsigned char>(b)], symbol);
+    symbols.push_back(std::move(symbol));
+  }
+
+  // A merged token is listed after the merges of its parts, so merging the leftmost pair of the highest priority
+  // one at a time gives the same tokens as merging all the pairs of that priority at once.
+  std::string pair;
+  while (symbols.size() > 1) {
+    int best_rank = std::numeric_limits<int>::max();
+    size_t best = 0;
+    for (size_t i = 0; i + 1 < symbols.size(); i++) {
+      pair.assign(symbols[i]).append(1, ' ').append(symbols[i + 1]);
+      const auto it = merge_ranks_.find(pair);
+      if (it != merge_ranks_.end() && it->second < best_rank) {
+        best_rank = it->second;
+        best = i;
+      }
+    }
+    if (best_rank == std::numeric_limits<int>::max()) {
+      break;
+    }
+    symbols[best] += symbols[best + 1];
+    symbols.erase(symbols.begin() + best + 1);
+  }
+
+  for (const auto& symbol : symbols) {
+    const auto it = token_ids_.find(symbol);
+    if (it != token_ids_.end()) {
+      ids.push_back(it->second);
+    } else if (unk_token_id >= 0) {
+      ids.push_back(unk_token_id);
+    } else {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Token '", symbol,
+                             "' is not in the vocabulary and unk_token_id is not set.");
+    }
+  }
+
+  return Status::OK();
+}
+
+class BpeTokenizer final : public OpKernel {
+ public:
+  explicit BpeTokenizer(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  BpeModel model_;
+  int64_t unk_token_id_;
+  int64_t pad_token_id_;
+};
+
+class BpeDetokenizer final : public OpKernel {
+ public:
+  explicit BpeDetokenizer(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  InlinedVector<std::string> tokens_;
+  std::unordered_set<int64_t> skip_token_ids_;
+};
+
+ONNX_OPERATOR_KERNEL_EX(
+    BpeTokenizer,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<std::string>()),
+    BpeTokenizer);
+
+ONNX_OPERATOR_KERNEL_EX(
+    BpeDetokenizer,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<std::string>()),
+    BpeDetokenizer);
+
+BpeTokenizer::BpeTokenizer(const OpKernelInfo& info) : OpKernel(info) {
+  unk_token_id_ = info.GetAttrOrDefault<int64_t>("unk_token_id", -1);
+  pad_token_id_ = info.GetAttrOrDefault<int64_t>("pad_token_id", 0);
+
+  // The vocabulary is loaded once, when the kernel is created.
+  const Tensor* vocab = nullptr;
+  const Tensor* merges = nullptr;
+  ORT_ENFORCE(info.TryGetConstantInput(1, &vocab), "Input 'vocab' must be a constant initializer.");
+  ORT_ENFORCE(info.TryGetConstantInput(2, &merges), "Input 'merges' must be a constant initializer.");
+  ORT_THROW_IF_ERROR(model_.Load(vocab->DataAsSpan<std::string>(), merges->DataAsSpan<std::string>()));
+}
+
+Status BpeTokenizer::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const auto& input_shape = X->Shape();
+  const auto texts = X->DataAsSpan<std::string>();
+
+  std::vector<std::vector<int64_t>> rows(texts.size());
+  std::vector<Status> statuses(texts.size());
+  concurrency::ThreadPool::TryBatchParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(texts.size()),
+      [&](std::ptrdiff_t i) {
+        statuses[i] = model_.Encode(texts[i], unk_token_id_, rows[i]);
+      },
+      0);
+  for (const auto& status : statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  size_t max_tokens = 0;
+  for (const auto& row : rows) {
+    max_tokens = std::max(max_tokens, row.size());
+  }
+
+  TensorShapeVector output_dims(input_shape.GetDims().begin(), input_shape.GetDims().end());
+  output_dims.push_back(narrow<int64_t>(max_tokens));
+  int64_t* ids = context->Output(0, output_dims)->MutableData<int64_t>();
+  Tensor* lengths = context->Output(1, input_shape);
+
+  for (size_t i = 0; i < rows.size(); i++) {
+    int64_t* row_ids = ids + i * max_tokens;
+    std::copy(rows[i].begin(), rows[i].end(), row_ids);
+    std::fill(row_ids + rows[i].size(), row_ids + max_tokens, pad_token_id_);
+    if (lengths != nullptr) {
+      lengths->MutableData<int64_t>()[i] = narrow<int64_t>(rows[i].size());
+    }
+  }
+
+  return Status::OK();
+}
+
+BpeDetokenizer::BpeDetokenizer(const OpKernelInfo& info) : OpKernel(info) {
+  const auto skip_token_ids = info.GetAttrsOrDefault<int64_t>("skip_token_ids");
+  skip_token_ids_.insert(skip_token_ids.begin(), skip_token_ids.end());
+
+  const Tensor* vocab = nullptr;
+  ORT_ENFORCE(info.TryGetConstantInput(1, &vocab), "Input 'vocab' must be a constant initializer.");
+  const auto vocab_span = vocab->DataAsSpan<std::string>();
+  tokens_.assign(vocab_span.begin(), vocab_span.end());
+}
+
+Status BpeDetokenizer::Compute(OpKernelContext* context) const {
+  const Tensor* ids = context->Input<Tensor>(0);
+  const auto& ids_dims = ids->Shape().GetDims();
+  if (ids_dims.empty()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'ids' must have at least one dimension.");
+  }
+
+  const size_t row_length = narrow<size_t>(ids_dims.back());
+  TensorShape output_shape(ids_dims.subspan(0, ids_dims.size() - 1));
+  std::string* texts = context->Output(0, output_shape)->MutableData<std::string>();
+  const int64_t* ids_data = ids->Data<int64_t>();
+
+  const int64_t vocab_size = narrow<int64_t>(tokens_.size());
+  for (size_t i = 0; i < narrow<size_t>(output_shape.Size()); i++) {
+    std::string& text = texts[i];
+    for (size_t j = 0; j < row_length; j++) {
+      const int64_t id = ids_data[i * row_length + j];
+      if (skip_token_ids_.count(id) != 0) {
+        continue;
+      }
+      if (id < 0 || id >= vocab_size) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Token id ", id, " is out of the vocabulary of ",
+                               vocab_size, " tokens.");
+      }
+      AppendBpeTokenBytes(tokens_[narrow<size_t>(id)], text);
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,130 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/utf8_util.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace bpe_details {
+
+// Byte-level BPE represents every byte by a printable character: bytes 0x21-0x7E, 0xA1-0xAC and 0xAE-0xFF by the
+// character of the same code point, the others by the characters from U+0100 on in byte order.
+constexpr char32_t kByteCharacterEnd = 0x100 + 68;
+
+inline const std::array<char32_t, 256>& ByteCharacters() {
+  static const std::array<char32_t, 256> characters = [] {
+    std::array<char32_t, 256> result{};
+    char32_t next = 0x100;
+    for (size_t b = 0; b < result.size(); b++) {
+      const bool printable = (b >= 0x21 && b <= 0x7E) || (b >= 0xA1 && b <= 0xAC) || (b >= 0xAE && b <= 0xFF);
+      result[b] = printable ? static_cast<char32_t>(b) : next++;
+    }
+    return result;
+  }();
+  return characters;
+}
+
+// The byte represented by each character below kByteCharacterEnd, or -1.
+inline const std::array<int16_t, kByteCharacterEnd>& CharacterBytes() {
+  static const std::array<int16_t, kByteCharacterEnd> bytes = [] {
+    std::array<int16_t, kByteCharacterEnd> result;
+    result.fill(-1);
+    const auto& characters = ByteCharacters();
+    for (size_t b = 0; b < characters.size(); b++) {
+      result[characters[b]] = static_cast<int16_t>(b);
+    }
+    return result;
+  }();
+  return bytes;
+}
+
+inline void AppendUtf8(char32_t c, std::string& text) {
+  if (c < 0x80) {
+    text.push_back(static_cast<char>(c));
+  } else if (c < 0x800) {
+    text.push_back(static_cast<char>(0xC0 | (c >> 6)));
+    text.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+  } else if (c < 0x10000) {
+    text.push_back(static_cast<char>(0xE0 | (c >> 12)));
+    text.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+    text.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+  } else {
+    text.push_back(static_cast<char>(0xF0 | (c >> 18)));
+    text.push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+    text.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+    text.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+  }
+}
+
+// Decodes the UTF-8 character at `pos` of `text`. Returns false if it isn't valid.
+inline bool DecodeUtf8(std::string_view text, size_t pos, size_t& length, char32_t& c) {
+  static constexpr unsigned char kLeadMasks[] = {0, 0x7F, 0x1F, 0x0F, 0x07};
+  if (!utf8_util::utf8_bytes(static_cast<unsigned char>(text[pos]), length) || pos + length > text.size()) {
+    return false;
+  }
+  c = static_cast<unsigned char>(text[pos]) & kLeadMasks[length];
+  for (size_t i = 1; i < length; i++) {
+    const unsigned char b = static_cast<unsigned char>(text[pos + i]);
+    if ((b & 0xC0) != 0x80) {
+      return false;
+    }
+    c = (c << 6) | (b & 0x3F);
+  }
+  return true;
+}
+
+}  // namespace bpe_details
+
+// Appends the bytes represented by the byte-level BPE `token` to `text`. Characters of the token that don't
+// represent a byte, like the ones of special tokens, are appended as they are.
+inline void AppendBpeTokenBytes(std::string_view token, std::string& text) {
+  const auto& character_bytes = bpe_details::CharacterBytes();
+  size_t pos = 0;
+  while (pos < token.size()) {
+    size_t length = 0;
+    char32_t c = 0;
+    if (!bpe_details::DecodeUtf8(token, pos, length, c)) {
+      text.push_back(token[pos]);
+      pos++;
+      continue;
+    }
+    if (c < bpe_details::kByteCharacterEnd && character_bytes[c] >= 0) {
+      text.push_back(static_cast<char>(character_bytes[c]));
+    } else {
+      text.append(token.data() + pos, length);
+    }
+    pos += length;
+  }
+}
+
+// Byte-level BPE model like the one of GPT-2.
+// A token of the vocabulary is the string of the characters of its bytes, e.g. " the" is "Ġthe". The text is split
+// into words, and the characters of each word are merged pairwise in the order of the merges until no pair has one.
+class BpeModel {
+ public:
+  // `vocab` holds the token of each id, `merges` the pairs of tokens to merge as "left right", highest priority first.
+  Status Load(gsl::span<const std::string> vocab, gsl::span<const std::string> merges);
+
+  // Appends the ids of the tokens of `text` to `ids`. A token outside of the vocabulary is mapped to
+  // `unk_token_id`, or is an error if `unk_token_id` is negative.
+  Status Encode(std::string_view text, int64_t unk_token_id, std::vector<int64_t>& ids) const;
+
+ private:
+  Status EncodeWord(std::string_view word, int64_t unk_token_id, std::vector<int64_t>& ids) const;
+
+  InlinedHashMap<std::string, int64_t> token_ids_;
+  InlinedHashMap<std::string, int> merge_ranks_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,105 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/diffusion/bias_add.h"
+
+#include <type_traits>
+#include <vector>
+
+#include "contrib_ops/cpu/diffusion/diffusion_common.h"
+#include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+#define REGISTER_KERNEL_TYPED(T)                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
+      BiasAdd,                                                    \
+      kMSDomain,                                                  \
+      1,                                                          \
+      T,                                                          \
+      kCpuExecutionProvider,                                      \
+      KernelDefBuilder()                                          \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      BiasAdd<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+template <typename T>
+Status BiasAdd<T>::Compute(OpKernelContext* context) const {
+  // Input:  [batch_size, height*width, channels]
+  // Bias:   [channels]
+  // Skip:   [batch_size, height*width, channels]
+  // Output: [batch_size, height*width, channels]
+
+  const Tensor* input = context->Input<Tensor>(0);
+
+  const auto& input_dims = input->Shape().GetDims();
+  if (input_dims.size() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "The input is expected to have 3 dimensions, got ", input_dims.size());
+  }
+
+  const Tensor* bias = context->Input<Tensor>(1);
+  const auto& bias_dims = bias->Shape().GetDims();
+  if (bias_dims.size() != 1) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "The bias is expected to have 1 dimensions, got ", bias_dims.size());
+  }
+  if (bias_dims[0] != input_dims[2]) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Number of channels in the last dimension of input and bias are not the same");
+  }
+
+  const Tensor* skip = context->Input<Tensor>(2);
+  if (skip->Shape() != input->Shape()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Shape of input and skip (residual) shall be the same");
+  }
+
+  Tensor* output = context->Output(0, input->Shape());
+
+  const size_t num_channels = static_cast<size_t>(input_dims[2]);
+  const T* input_data = input->Data<T>();
+  const T* skip_data = skip->Data<T>();
+  T* output_data = output->MutableData<T>();
+
+  std::vector<float> bias_float(num_channels);
+  diffusion::ConvertToFloat(bias->Data<T>(), bias_float.data(), num_channels);
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(input_dims[0] * input_dims[1]),
+      TensorOpCost{static_cast<double>(2 * num_channels * sizeof(T)), static_cast<double>(num_channels * sizeof(T)),
+                   static_cast<double>(2 * num_channels)},
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        if constexpr (std::is_same_v<T, float>) {
+          for (std::ptrdiff_t r = begin; r < end; ++r) {
+            const float* x = input_data + r * num_channels;
+            const float* s = skip_data + r * num_channels;
+            float* y = output_data + r * num_channels;
+            for (size_t c = 0; c < num_channels; ++c) {
+              y[c] = x[c] + bias_float[c] + s[c];
+            }
+          }
+        } else {
+          std::vector<float> x(num_channels);
+          std::vector<float> s(num_channels);
+          for (std::ptrdiff_t r = begin; r < end; ++r) {
+            diffusion::ConvertToFloat(input_data + r * num_channels, x.data(), num_channels);
+            diffusion::ConvertToFloat(skip_data + r * num_channels, s.data(), num_channels);
+            for (size_t c = 0; c < num_channels; ++c) {
+              x[c] += bias_float[c] + s[c];
+            }
+
+            diffusion::ConvertFromFloat(x.data(), output_data + r * num_channels, num_channels);
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/diffusion/bias_split_gelu.h"
+
+#include <vector>
+
+#include "contrib_ops/cpu/diffusion/diffusion_common.h"
+#include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+#define REGISTER_KERNEL_TYPED(T)                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
+      BiasSplitGelu,                                              \
+      kMSDomain,                                                  \
+      1,                                                          \
+      T,                                                          \
+      kCpuExecutionProvider,                                      \
+      KernelDefBuilder()                                          \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      BiasSplitGelu<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+template <typename T>
+Status BiasSplitGelu<T>::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+
+  const auto& input_dims = input->Shape().GetDims();
+  if (input_dims.size() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "input is expected to have 3 dimensions, got ", input_dims.size());
+  }
+
+  if (input_dims[2] % 2 != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "hidden size should be even, got ", input_dims[2]);
+  }
+
+  const Tensor* bias = context->Input<Tensor>(1);
+  const auto& bias_dims = bias->Shape().GetDims();
+  if (bias_dims.size() != 1) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "bias is expected to have 1 dimensions, got ", bias_dims.size());
+  }
+  if (bias_dims[0] != input_dims[2]) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "last dimension of input and bias are not the same");
+  }
+
+  TensorShapeVector output_shape = input->Shape().AsShapeVector();
+  output_shape[2] = input_dims[2] / 2;
+  Tensor* output = context->Output(0, output_shape);
+
+  const size_t hidden_size = static_cast<size_t>(input_dims[2]);
+  const size_t half_hidden_size = hidden_size / 2;
+  const T* input_data = input->Data<T>();
+  T* output_data = output->MutableData<T>();
+
+  std::vector<float> bias_float(hidden_size);
+  diffusion::ConvertToFloat(bias->Data<T>(), bias_float.data(), hidden_size);
+
+  constexpr float kSqrt1_2 = 0.70710678118654752f;
+
+  // Y = (X_left + bias_left) * Gelu(X_right + bias_right), with Gelu(x) = 0.5 * x * (1 + erf(x / sqrt(2))).
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(input_dims[0] * input_dims[1]),
+      TensorOpCost{static_cast<double>(hidden_size * sizeof(T)), static_cast<double>(half_hidden_size * sizeof(T)),
+                   static_cast<double>(hidden_size * 10)},
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        std::vector<float> row(hidden_size);
+        std::vector<float> erf_buffer(half_hidden_size);
+        for (std::ptrdiff_t r = begin; r < end; ++r) {
+          diffusion::ConvertToFloat(input_data + r * hidden_size, row.data(), hidden_size);
+          for (size_t i = 0; i < hidden_size; ++i) {
+            row[i] += bias_float[i];
+          }
+
+          float* left = row.data();
+          float* right = row.data() + half_hidden_size;
+          for (size_t i = 0; i < half_hidden_size; ++i) {
+            erf_buffer[i] = right[i] * kSqrt1_2;
+          }
+
+          MlasComputeErf(erf_buffer.data(), erf_buffer.data(), half_hidden_size);
+
+          for (size_t i = 0; i < half_hidden_size; ++i) {
+            left[i] *= 0.5f * right[i] * (erf_buffer[i] + 1.0f);
+          }
+
+          diffusion::ConvertFromFloat(left, output_data + r * half_hidden_size, half_hidden_size);
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstring>
+
+#include "core/framework/float16.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace diffusion {
+
+// The diffusion kernels compute in float. These convert a contiguous run of elements to and from the tensor type.
+template <typename T>
+inline void ConvertToFloat(const T* source, float* destination, size_t count);
+
+template <>
+inline void ConvertToFloat<float>(const float* source, float* destination, size_t count) {
+  if (source != destination) {
+    memcpy(destination, source, count * sizeof(float));
+  }
+}
+
+template <>
+inline void ConvertToFloat<MLFloat16>(const MLFloat16* source, float* destination, size_t count) {
+  MlasConvertHalfToFloatBuffer(&source->val, destination, count);
+}
+
+template <typename T>
+inline void ConvertFromFloat(const float* source, T* destination, size_t count);
+
+template <>
+inline void ConvertFromFloat<float>(const float* source, float* destination, size_t count) {
+  if (source != destination) {
+    memcpy(destination, source, count * sizeof(float));
+  }
+}
+
+template <>
+inline void ConvertFromFloat<MLFloat16>(const float* source, MLFloat16* destination, size_t count) {
+  MlasConvertFloatToHalfBuffer(source, &destination->val, count);
+}
+
+}  // namespace diffusion
+}  // namespace contrib
+}  // namespace onnxruntime
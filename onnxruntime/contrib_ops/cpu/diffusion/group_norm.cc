@@ -0,0 +1,292 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/diffusion/group_norm.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include "contrib_ops/cpu/diffusion/diffusion_common.h"
+#include "core/common/safeint.h"
+#include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+#define REGISTER_KERNEL_TYPED(T)                                                   \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                   \
+      GroupNorm,                                                                   \
+      kMSDomain,                                                                   \
+      1,                                                                           \
+      T,                                                                           \
+      kCpuExecutionProvider,                                                       \
+      KernelDefBuilder()                                                           \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())                   \
+          .TypeConstraint("M", DataTypeImpl::GetTensorType<float>()),              \
+      GroupNorm<T>);                                                               \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                   \
+      SkipGroupNorm,                                                               \
+      kMSDomain,                                                                   \
+      1,                                                                           \
+      T,                                                                           \
+      kCpuExecutionProvider,                                                       \
+      KernelDefBuilder()                                                           \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())                   \
+          .TypeConstraint("M", DataTypeImpl::GetTensorType<float>()),              \
+      GroupNorm<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+template <typename T>
+GroupNorm<T>::GroupNorm(const OpKernelInfo& op_info) : OpKernel(op_info) {
+  has_skip_ = op_info.GetKernelDef().OpName() == "SkipGroupNorm";
+
+  epsilon_ = op_info.GetAttrOrDefault<float>("epsilon", 1e-5f);
+  ORT_ENFORCE(epsilon_ >= 0);
+
+  ORT_ENFORCE(op_info.GetAttr("groups", &num_groups_).IsOK());
+  ORT_ENFORCE(num_groups_ > 0);
+
+  int64_t activation;
+  ORT_ENFORCE(op_info.GetAttr("activation", &activation).IsOK());
+  ORT_ENFORCE(activation == 0 || activation == 1);  // 0 is None, 1 is Swish
+  use_swish_activation_ = (activation == 1);
+
+  channels_last_ = (op_info.GetAttrOrDefault<int64_t>("channels_last", static_cast<int64_t>(1)) != 0);
+}
+
+template <typename T>
+Status GroupNorm<T>::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* gamma = context->Input<Tensor>(1);
+  const Tensor* beta = context->Input<Tensor>(2);
+
+  const auto& input_dims = input->Shape().GetDims();
+  if (input_dims.size() != 4) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "input is expected to have 4 dimensions, got ", input_dims.size());
+  }
+
+  const int64_t batch_size = input_dims[0];
+  const int64_t num_channels = channels_last_ ? input_dims[3] : input_dims[1];
+  const int64_t image_size = channels_last_ ? input_dims[1] * input_dims[2] : input_dims[2] * input_dims[3];
+
+  if (num_channels % num_groups_ != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "number of channels should be divisible by num_groups");
+  }
+
+  if (gamma->Shape().NumDimensions() != 1 || gamma->Shape()[0] != num_channels) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "gamma is expected to have shape (C), got ", gamma->Shape());
+  }
+
+  if (beta->Shape().NumDimensions() != 1 || beta->Shape()[0] != num_channels) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "beta is expected to have shape (C), got ", beta->Shape());
+  }
+
+  const Tensor* skip = nullptr;
+  const Tensor* bias = nullptr;
+  Tensor* add_out = nullptr;
+  bool broadcast_skip = false;
+  if (has_skip_) {
+    if (!channels_last_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                             "SkipGroupNorm only supports the channels_last layout");
+    }
+
+    skip = context->Input<Tensor>(3);
+    bias = context->Input<Tensor>(4);
+    add_out = context->Output(1, input->Shape());
+
+    if (bias != nullptr && (bias->Shape().NumDimensions() != 1 || bias->Shape()[0] != num_channels)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "bias is expected to have shape (C), got ", bias->Shape());
+    }
+
+    if (skip->Shape() != input->Shape()) {
+      const auto& dims = skip->Shape().GetDims();
+      // The shape of skip can be (N, C) or (N, 1, 1, C) for broadcast.
+      const bool b2 = (dims.size() == 2 && dims[0] == batch_size && dims[1] == num_channels);
+      const bool b4 = (dims.size() == 4 && dims[0] == batch_size &&
+                       dims[1] == 1 && dims[2] == 1 && dims[3] == num_channels);
+      broadcast_skip = b2 || b4;
+      if (!broadcast_skip) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "skip shape is expected to be (N, H, W, C) or (N, 1, 1, C) or (N, C)");
+      }
+    }
+  }
+
+  Tensor* output = context->Output(0, input->Shape());
+  if (input->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  // Rows are the contiguous runs of elements that share a normalization group in NCHW, or a pixel in NHWC.
+  const int64_t row_size = channels_last_ ? num_channels : image_size;
+  const int64_t num_rows = batch_size * (channels_last_ ? image_size : num_channels);
+  const size_t row_length = static_cast<size_t>(row_size);
+
+  // The input as float, with skip and bias added for SkipGroupNorm.
+  const float* x = nullptr;
+  IAllocatorUniquePtr<float> x_buffer;
+  if constexpr (std::is_same_v<T, float>) {
+    if (!has_skip_) {
+      x = input->Data<float>();
+    }
+  }
+
+  if (x == nullptr) {
+    x_buffer = IAllocator::MakeUniquePtr<float>(alloc, SafeInt<size_t>(num_rows) * row_length);
+    float* x_data = x_buffer.get();
+    const T* input_data = input->Data<T>();
+    const T* skip_data = skip != nullptr ? skip->Data<T>() : nullptr;
+    std::vector<float> bias_float;
+    if (bias != nullptr) {
+      bias_float.resize(row_length);
+      diffusion::ConvertToFloat(bias->Data<T>(), bias_float.data(), row_length);
+    }
+
+    T* add_out_data = add_out != nullptr ? add_out->MutableData<T>() : nullptr;
+
+    const double cost = static_cast<double>(row_size) * (has_skip_ ? 4 : 1);
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(num_rows),
+        TensorOpCost{cost * sizeof(T), cost * sizeof(float), cost},
+        [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          std::vector<float> buffer(has_skip_ ? row_length : 0);
+          for (std::ptrdiff_t row = begin; row < end; ++row) {
+            float* x_row = x_data + row * row_size;
+            diffusion::ConvertToFloat(input_data + row * row_size, x_row, row_length);
+            if (!has_skip_) {
+              continue;
+            }
+
+            const int64_t skip_row = broadcast_skip ? row / image_size : row;
+            diffusion::ConvertToFloat(skip_data + skip_row * row_size, buffer.data(), row_length);
+            for (size_t c = 0; c < row_length; ++c) {
+              x_row[c] += buffer[c];
+            }
+
+            for (size_t c = 0; c < bias_float.size(); ++c) {
+              x_row[c] += bias_float[c];
+            }
+
+            if (add_out_data != nullptr) {
+              diffusion::ConvertFromFloat(x_row, add_out_data + row * row_size, row_length);
+            }
+          }
+        });
+
+    x = x_data;
+  }
+
+  // Fold the group statistics, gamma and beta into a per (batch, channel) scale and shift.
+  const int64_t channels_per_group = num_channels / num_groups_;
+  const float* gamma_data = gamma->Data<float>();
+  const float* beta_data = beta->Data<float>();
+  auto scale_shift_buffer = IAllocator::MakeUniquePtr<float>(alloc, SafeInt<size_t>(batch_size) * num_channels * 2);
+  float* scale = scale_shift_buffer.get();
+  float* shift = scale + batch_size * num_channels;
+
+  const double group_size = static_cast<double>(channels_per_group * image_size);
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(batch_size * num_groups_),
+      TensorOpCost{group_size * sizeof(float), 0, group_size * 2},
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t task = begin; task < end; ++task) {
+          const int64_t n = task / num_groups_;
+          const int64_t first_channel = (task % num_groups_) * channels_per_group;
+
+          // float partial sums per run, accumulated in double to keep large images accurate.
+          double sum = 0;
+          double sum_of_squares = 0;
+          const int64_t num_runs = channels_last_ ? image_size : channels_per_group;
+          const int64_t run_size = channels_last_ ? channels_per_group : image_size;
+          for (int64_t run = 0; run < num_runs; ++run) {
+            const float* p = channels_last_
+                                 ? x + (n * image_size + run) * num_channels + first_channel
+                                 : x + (n * num_channels + first_channel + run) * image_size;
+            float run_sum = 0;
+            float run_sum_of_squares = 0;
+            for (int64_t i = 0; i < run_size; ++i) {
+              run_sum += p[i];
+              run_sum_of_squares += p[i] * p[i];
+            }
+
+            sum += run_sum;
+            sum_of_squares += run_sum_of_squares;
+          }
+
+          const double mean = sum / group_size;
+          const double variance = std::max(sum_of_squares / group_size - mean * mean, 0.0);
+          const float inv_std_dev = static_cast<float>(1.0 / std::sqrt(variance + epsilon_));
+          for (int64_t c = first_channel; c < first_channel + channels_per_group; ++c) {
+            const float channel_scale = gamma_data[c] * inv_std_dev;
+            scale[n * num_channels + c] = channel_scale;
+            shift[n * num_channels + c] = beta_data[c] - static_cast<float>(mean) * channel_scale;
+          }
+        }
+      });
+
+  T* output_data = output->MutableData<T>();
+  const double cost = static_cast<double>(row_size) * (use_swish_activation_ ? 16 : 2);
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(num_rows),
+      TensorOpCost{static_cast<double>(row_size) * sizeof(float), static_cast<double>(row_size) * sizeof(T), cost},
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        std::vector<float> y_buffer(std::is_same_v<T, float> ? 0 : row_length);
+        std::vector<float> sigmoid_buffer(use_swish_activation_ ? row_length : 0);
+        for (std::ptrdiff_t row = begin; row < end; ++row) {
+          const float* x_row = x + row * row_size;
+          float* y_row;
+          if constexpr (std::is_same_v<T, float>) {
+            y_row = output_data + row * row_size;
+          } else {
+            y_row = y_buffer.data();
+          }
+
+          if (channels_last_) {
+            const int64_t n = row / image_size;
+            const float* row_scale = scale + n * num_channels;
+            const float* row_shift = shift + n * num_channels;
+            for (size_t c = 0; c < row_length; ++c) {
+              y_row[c] = x_row[c] * row_scale[c] + row_shift[c];
+            }
+          } else {
+            // each row is a single channel of one image
+            const float row_scale = scale[row];
+            const float row_shift = shift[row];
+            for (size_t i = 0; i < row_length; ++i) {
+              y_row[i] = x_row[i] * row_scale + row_shift;
+            }
+          }
+
+          if (use_swish_activation_) {
+            MlasComputeLogistic(y_row, sigmoid_buffer.data(), row_length);
+            for (size_t i = 0; i < row_length; ++i) {
+              y_row[i] *= sigmoid_buffer[i];
+            }
+          }
+
+          if constexpr (!std::is_same_v<T, float>) {
+            diffusion::ConvertFromFloat(y_row, output_data + row * row_size, row_length);
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// GroupNorm and SkipGroupNorm. Statistics and normalization are computed in float, with the optional SiLU applied
+// in the same pass that writes the output.
+template <typename T>
+class GroupNorm final : public OpKernel {
+ public:
+  GroupNorm(const OpKernelInfo& op_kernel_info);
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  bool use_swish_activation_;  // use SiLU (also known as Swish) activation after group normalization?
+  float epsilon_;
+  int64_t num_groups_;
+  bool channels_last_;
+  bool has_skip_;  // true for SkipGroupNorm operator; false for GroupNorm
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
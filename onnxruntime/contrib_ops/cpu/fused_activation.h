@@ -9,6 +9,9 @@
 
 namespace onnxruntime {
 
-common::Status GetFusedActivationAttr(const OpKernelInfo& info, MLAS_ACTIVATION& activation);
+// Reads the activation named by the attribute activation_attr and its parameters from the attribute
+// activation_attr + "_params".
+common::Status GetFusedActivationAttr(const OpKernelInfo& info, MLAS_ACTIVATION& activation,
+                                      const std::string& activation_attr = "activation");
 
 }  // namespace onnxruntime
@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/nn/conv_attributes.h"
+#include "contrib_ops/cpu/fused_activation.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+class FusedDepthwisePointwiseConv final : public OpKernel {
+ public:
+  FusedDepthwisePointwiseConv(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
+    ORT_ENFORCE(GetFusedActivationAttr(info, activation_).IsOK());
+    ORT_ENFORCE(GetFusedActivationAttr(info, pointwise_activation_, "pointwise_activation").IsOK());
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  ConvAttributes conv_attrs_;
+  MLAS_ACTIVATION activation_;
+  MLAS_ACTIVATION pointwise_activation_;
+};
+
+Status FusedDepthwisePointwiseConv::Compute(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
+  const auto* W = context->Input<Tensor>(1);
+  const auto* B = context->Input<Tensor>(2);
+  const auto* PW = context->Input<Tensor>(3);
+  const auto* PB = context->Input<Tensor>(4);
+
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
+
+  const auto& X_shape = X->Shape();
+  const auto& W_shape = W->Shape();
+  const auto& PW_shape = PW->Shape();
+  ORT_RETURN_IF_NOT(X_shape.NumDimensions() == 4, "X must be a 4D tensor");
+
+  const int64_t C = X_shape[1];
+  ORT_RETURN_IF_NOT(conv_attrs_.group == C && W_shape[0] == C,
+                    "Depthwise convolution requires group and filter count to equal the input channels.",
+                    " group: ", conv_attrs_.group, " C: ", C, " W: ", W_shape);
+  ORT_RETURN_IF_NOT(PW_shape.NumDimensions() == 4 && PW_shape[1] == C && PW_shape[2] == 1 && PW_shape[3] == 1,
+                    "Pointwise filter must have shape (M, C, 1, 1). PW: ", PW_shape);
+
+  TensorShapeVector kernel_shape;
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
+
+  ConvAttributes::ConvPadVector pads(conv_attrs_.pads);
+  if (pads.empty()) {
+    pads.resize(kernel_shape.size() * 2, 0);
+  }
+  TensorShapeVector dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_shape.size(), 1);
+  }
+  TensorShapeVector strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_shape.size(), 1);
+  }
+
+  TensorShapeVector Y_dims({X_shape[0], PW_shape[0]});
+  TensorShape input_shape = X_shape.Slice(2);
+  ORT_RETURN_IF_ERROR(conv_attrs_.InferPadsAndOutputShape(input_shape, kernel_shape, strides, dilations, pads, Y_dims));
+  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+
+  // Bail out early if one of the dimensions is zero.
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  MlasConvDepthwisePointwise(
+      X_shape.GetDims().data(),
+      kernel_shape.data(),
+      dilations.data(),
+      pads.data(),
+      strides.data(),
+      Y_dims.data(),
+      X->Data<float>(),
+      W->Data<float>(),
+      B != nullptr ? B->Data<float>() : nullptr,
+      &activation_,
+      PW->Data<float>(),
+      PB != nullptr ? PB->Data<float>() : nullptr,
+      &pointwise_activation_,
+      Y->MutableData<float>(),
+      context->GetOperatorThreadPool());
+
+  return Status::OK();
+}
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    FusedDepthwisePointwiseConv,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedDepthwisePointwiseConv);
+
+}  // namespace contrib
+}  // namespace onnxruntime
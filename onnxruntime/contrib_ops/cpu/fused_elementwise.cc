@@ -0,0 +1,442 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "core/common/inlined_containers.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/reduction/reduction_ops.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+// Number of output elements evaluated at a time. The registers of a tile stay in the L1 cache for the
+// chains of up to a few dozen operators the ElementwiseFusion transformer produces.
+constexpr int64_t kTileSize = 512;
+
+enum class ElementwiseOp {
+  Abs,
+  Add,
+  Div,
+  Erf,
+  Exp,
+  Mul,
+  Neg,
+  Pow,
+  ReduceMax,
+  ReduceMean,
+  ReduceSum,
+  Relu,
+  Sigmoid,
+  Softmax,
+  Sqrt,
+  Sub,
+  Tanh,
+  Where,
+};
+
+bool IsReduction(ElementwiseOp op) {
+  return op == ElementwiseOp::ReduceMax || op == ElementwiseOp::ReduceMean || op == ElementwiseOp::ReduceSum;
+}
+
+// Operators that read a whole row of the last axis.
+bool IsRowOp(ElementwiseOp op) {
+  return IsReduction(op) || op == ElementwiseOp::Softmax;
+}
+
+size_t NumOperands(ElementwiseOp op) {
+  switch (op) {
+    case ElementwiseOp::Add:
+    case ElementwiseOp::Div:
+    case ElementwiseOp::Mul:
+    case ElementwiseOp::Pow:
+    case ElementwiseOp::Sub:
+      return 2;
+    case ElementwiseOp::Where:
+      return 3;
+    default:
+      return 1;
+  }
+}
+
+Status ParseElementwiseOp(const std::string& name, ElementwiseOp& op) {
+  static const InlinedHashMap<std::string, ElementwiseOp> ops{
+      {"Abs", ElementwiseOp::Abs},
+      {"Add", ElementwiseOp::Add},
+      {"Div", ElementwiseOp::Div},
+      {"Erf", ElementwiseOp::Erf},
+      {"Exp", ElementwiseOp::Exp},
+      {"Mul", ElementwiseOp::Mul},
+      {"Neg", ElementwiseOp::Neg},
+      {"Pow", ElementwiseOp::Pow},
+      {"ReduceMax", ElementwiseOp::ReduceMax},
+      {"ReduceMean", ElementwiseOp::ReduceMean},
+      {"ReduceSum", ElementwiseOp::ReduceSum},
+      {"Relu", ElementwiseOp::Relu},
+      {"Sigmoid", ElementwiseOp::Sigmoid},
+      {"Softmax", ElementwiseOp::Softmax},
+      {"Sqrt", ElementwiseOp::Sqrt},
+      {"Sub", ElementwiseOp::Sub},
+      {"Tanh", ElementwiseOp::Tanh},
+      {"Where", ElementwiseOp::Where},
+  };
+
+  auto it = ops.find(name);
+  ORT_RETURN_IF(it == ops.end(), "FusedElementwise does not support operator ", name);
+  op = it->second;
+  return Status::OK();
+}
+
+template <typename Fn>
+void Unary(const float* a, float* y, int64_t n, Fn fn) {
+  for (int64_t i = 0; i < n; ++i) {
+    y[i] = fn(a[i]);
+  }
+}
+
+template <typename Fn>
+void Binary(const float* a, const float* b, float* y, int64_t n, Fn fn) {
+  for (int64_t i = 0; i < n; ++i) {
+    y[i] = fn(a[i], b[i]);
+  }
+}
+
+// Evaluates op on n elements. A reduction writes its result to y[0].
+void Evaluate(ElementwiseOp op, const float* const* x, float* y, int64_t n) {
+  const auto count = static_cast<size_t>(n);
+  switch (op) {
+    case ElementwiseOp::Abs:
+      Unary(x[0], y, n, [](float a) { return std::abs(a); });
+      break;
+    case ElementwiseOp::Add:
+      Binary(x[0], x[1], y, n, [](float a, float b) { return a + b; });
+      break;
+    case ElementwiseOp::Div:
+      Binary(x[0], x[1], y, n, [](float a, float b) { return a / b; });
+      break;
+    case ElementwiseOp::Erf:
+      MlasComputeErf(x[0], y, count);
+      break;
+    case ElementwiseOp::Exp:
+      MlasComputeExp(x[0], y, count);
+      break;
+    case ElementwiseOp::Mul:
+      Binary(x[0], x[1], y, n, [](float a, float b) { return a * b; });
+      break;
+    case ElementwiseOp::Neg:
+      Unary(x[0], y, n, [](float a) { return -a; });
+      break;
+    case ElementwiseOp::Pow:
+      Binary(x[0], x[1], y, n, [](float a, float b) { return b == 2.f ? a * a : std::pow(a, b); });
+      break;
+    case ElementwiseOp::ReduceMax:
+      y[0] = ReduceAggregatorMax<float>::aggall(x[0], n);
+      break;
+    case ElementwiseOp::ReduceMean:
+      y[0] = ReduceAggregatorMean<float>::aggall(x[0], n);
+      break;
+    case ElementwiseOp::ReduceSum:
+      y[0] = ReduceAggregatorSum<float>::aggall(x[0], n);
+      break;
+    case ElementwiseOp::Relu:
+      Unary(x[0], y, n, [](float a) { return std::max(a, 0.f); });
+      break;
+    case ElementwiseOp::Sigmoid:
+      MlasComputeLogistic(x[0], y, count);
+      break;
+    case ElementwiseOp::Softmax:
+      MlasComputeSoftmax(x[0], y, 1, count, false, nullptr);
+      break;
+    case ElementwiseOp::Sqrt:
+      Unary(x[0], y, n, [](float a) { return std::sqrt(a); });
+      break;
+    case ElementwiseOp::Sub:
+      Binary(x[0], x[1], y, n, [](float a, float b) { return a - b; });
+      break;
+    case ElementwiseOp::Tanh:
+      MlasComputeTanh(x[0], y, count);
+      break;
+    case ElementwiseOp::Where:
+      for (int64_t i = 0; i < n; ++i) {
+        y[i] = x[0][i] != 0.f ? x[1][i] : x[2][i];
+      }
+      break;
+  }
+}
+
+// Reads a range of the output elements of an input broadcast to the output shape.
+class BroadcastInput {
+ public:
+  BroadcastInput(const Tensor& input, const TensorShape& output_shape) {
+    if (input.IsDataType<bool>()) {
+      bool_data_ = input.Data<bool>();
+    } else {
+      float_data_ = input.Data<float>();
+    }
+    size_ = input.Shape().Size();
+
+    // The input repeats itself along the output if its dimensions, without leading ones, match the innermost
+    // dimensions of the output. This covers same shaped inputs, scalars and per channel vectors.
+    const auto input_dims = input.Shape().GetDims();
+    const auto output_dims = output_shape.GetDims();
+    size_t leading_ones = 0;
+    while (leading_ones < input_dims.size() && input_dims[leading_ones] == 1) {
+      ++leading_ones;
+    }
+    const auto inner_dims = input_dims.subspan(leading_ones);
+    repeats_ = std::equal(inner_dims.begin(), inner_dims.end(), output_dims.end() - inner_dims.size());
+
+    if (!repeats_) {
+      // strides of the input along each output dimension, zero where the input is broadcast
+      const size_t rank = output_dims.size();
+      const size_t offset = rank - input_dims.size();
+      output_dims_.assign(output_dims.begin(), output_dims.end());
+      strides_.assign(rank, 0);
+      int64_t stride = 1;
+      for (size_t i = input_dims.size(); i-- > 0;) {
+        if (input_dims[i] != 1) {
+          strides_[offset + i] = stride;
+        }
+        stride *= input_dims[i];
+      }
+    }
+  }
+
+  bool IsContiguousFloat(int64_t output_size) const { return float_data_ != nullptr && size_ == output_size; }
+
+  const float* FloatData() const { return float_data_; }
+
+  // Writes the elements [start, start + n) of the broadcast input to y.
+  void Load(int64_t start, int64_t n, float* y) const {
+    if (repeats_ && size_ == 1) {
+      std::fill_n(y, n, Get(0));
+    } else if (repeats_) {
+      int64_t offset = start % size_;
+      for (int64_t i = 0; i < n;) {
+        const int64_t count = std::min(n - i, size_ - offset);
+        Copy(offset, count, y + i);
+        i += count;
+        offset = 0;
+      }
+    } else {
+      for (int64_t i = 0; i < n; ++i) {
+        int64_t index = start + i;
+        int64_t offset = 0;
+        for (size_t d = output_dims_.size(); d-- > 0;) {
+          offset += (index % output_dims_[d]) * strides_[d];
+          index /= output_dims_[d];
+        }
+        y[i] = Get(offset);
+      }
+    }
+  }
+
+ private:
+  float Get(int64_t offset) const {
+    return float_data_ != nullptr ? float_data_[offset] : static_cast<float>(bool_data_[offset]);
+  }
+
+  void Copy(int64_t offset, int64_t n, float* y) const {
+    if (float_data_ != nullptr) {
+      std::copy_n(float_data_ + offset, n, y);
+    } else {
+      std::transform(bool_data_ + offset, bool_data_ + offset + n, y,
+                     [](bool b) { return static_cast<float>(b); });
+    }
+  }
+
+  const float* float_data_{nullptr};
+  const bool* bool_data_{nullptr};
+  int64_t size_{0};
+  bool repeats_{false};
+  TensorShapeVector output_dims_;
+  TensorShapeVector strides_;
+};
+
+Status BroadcastShapes(OpKernelContext* context, TensorShapeVector& output_dims) {
+  for (int i = 0; i < context->InputCount(); ++i) {
+    const auto input_dims = context->Input<Tensor>(i)->Shape().GetDims();
+    if (input_dims.size() > output_dims.size()) {
+      output_dims.insert(output_dims.begin(), input_dims.size() - output_dims.size(), 1);
+    }
+    const size_t offset = output_dims.size() - input_dims.size();
+    for (size_t d = 0; d < input_dims.size(); ++d) {
+      auto& output_dim = output_dims[offset + d];
+      if (output_dim == 1) {
+        output_dim = input_dims[d];
+      } else {
+        ORT_RETURN_IF_NOT(input_dims[d] == 1 || input_dims[d] == output_dim,
+                          "FusedElementwise: input ", i, " cannot be broadcast. Dimension ", d, " is ",
+                          input_dims[d], " but the broadcast dimension is ", output_dim);
+      }
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+class FusedElementwise final : public OpKernel {
+ public:
+  FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+    const auto op_names = info.GetAttrsOrDefault<std::string>("ops");
+    const auto operands = info.GetAttrsOrDefault<int64_t>("operands");
+    ORT_ENFORCE(!op_names.empty(), "FusedElementwise requires at least one operator");
+
+    const auto num_inputs = static_cast<int64_t>(info.GetInputCount());
+    size_t next_operand = 0;
+    for (size_t i = 0; i < op_names.size(); ++i) {
+      ElementwiseOp op;
+      ORT_THROW_IF_ERROR(ParseElementwiseOp(op_names[i], op));
+      const size_t num_operands = NumOperands(op);
+      ORT_ENFORCE(next_operand + num_operands <= operands.size(), "FusedElementwise: too few operands");
+
+      Step step{op, {}};
+      for (size_t j = 0; j < num_operands; ++j) {
+        // an operator reads the inputs or the results of the operators before it
+        const int64_t reg = operands[next_operand++];
+        ORT_ENFORCE(reg >= 0 && reg < num_inputs + static_cast<int64_t>(i),
+                    "FusedElementwise: operator ", i, " reads invalid register ", reg);
+        step.operands[j] = static_cast<size_t>(reg);
+      }
+      row_mode_ = row_mode_ || IsRowOp(op);
+      steps_.push_back(step);
+    }
+    ORT_ENFORCE(next_operand == operands.size(), "FusedElementwise: too many operands");
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  struct Step {
+    ElementwiseOp op;
+    std::array<size_t, 3> operands;
+  };
+
+  InlinedVector<Step> steps_;
+  // evaluate the operators per row of the last axis instead of per tile, as some of them read the whole row
+  bool row_mode_{false};
+};
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  const int num_inputs = context->InputCount();
+
+  // All registers are evaluated in the broadcast shape of the inputs.
+  TensorShapeVector broadcast_dims;
+  ORT_RETURN_IF_ERROR(BroadcastShapes(context, broadcast_dims));
+  ORT_RETURN_IF(row_mode_ && broadcast_dims.empty(), "FusedElementwise: reductions require inputs of rank 1 or more");
+  const TensorShape broadcast_shape(broadcast_dims);
+  const int64_t broadcast_size = broadcast_shape.Size();
+
+  // A register with a last dimension of 1 holds one value per row: the inputs of that shape, the reductions and
+  // the elementwise operators of such registers. Those operators are evaluated once per row.
+  InlinedVector<bool> per_row(num_inputs + steps_.size(), false);
+  if (row_mode_) {
+    for (int i = 0; i < num_inputs; ++i) {
+      const auto& input_shape = context->Input<Tensor>(i)->Shape();
+      per_row[i] = input_shape.NumDimensions() == 0 || input_shape.GetDims().back() == 1;
+    }
+    for (size_t s = 0; s < steps_.size(); ++s) {
+      const auto& step = steps_[s];
+      bool all_per_row = !IsRowOp(step.op);
+      for (size_t j = 0; j < NumOperands(step.op); ++j) {
+        all_per_row = all_per_row && per_row[step.operands[j]];
+      }
+      per_row[num_inputs + s] = IsReduction(step.op) || all_per_row;
+    }
+  }
+
+  const bool reduced_output = per_row.back();
+  TensorShapeVector output_dims(broadcast_dims);
+  if (reduced_output) {
+    output_dims.back() = 1;
+  }
+  Tensor* Y = context->Output(0, TensorShape(output_dims));
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+  ORT_RETURN_IF(broadcast_size == 0, "FusedElementwise: reducing an empty axis is not supported");
+
+  InlinedVector<BroadcastInput> inputs;
+  inputs.reserve(num_inputs);
+  for (int i = 0; i < num_inputs; ++i) {
+    inputs.emplace_back(*context->Input<Tensor>(i), broadcast_shape);
+  }
+
+  float* output = Y->MutableData<float>();
+  const size_t num_registers = inputs.size() + steps_.size();
+  const int64_t tile_size = row_mode_ ? broadcast_dims.back() : kTileSize;
+  const std::ptrdiff_t num_tiles = static_cast<std::ptrdiff_t>((broadcast_size + tile_size - 1) / tile_size);
+
+  const TensorOpCost cost{static_cast<double>(num_inputs * tile_size * sizeof(float)),
+                          static_cast<double>(tile_size * sizeof(float)),
+                          static_cast<double>(steps_.size() * tile_size * 4)};
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), num_tiles, cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // one tile buffer per register, besides full sized float inputs which are read in place and the
+        // result of the last operator which is written to the output
+        std::vector<float> buffer(num_registers * tile_size);
+        InlinedVector<const float*> registers(num_registers);
+
+        for (std::ptrdiff_t tile = first; tile < last; ++tile) {
+          const int64_t start = static_cast<int64_t>(tile) * tile_size;
+          const int64_t n = std::min(tile_size, broadcast_size - start);
+
+          for (size_t i = 0; i < inputs.size(); ++i) {
+            if (inputs[i].IsContiguousFloat(broadcast_size)) {
+              registers[i] = inputs[i].FloatData() + start;
+            } else {
+              float* reg = buffer.data() + i * tile_size;
+              inputs[i].Load(start, n, reg);
+              registers[i] = reg;
+            }
+          }
+
+          for (size_t s = 0; s < steps_.size(); ++s) {
+            const auto& step = steps_[s];
+            const size_t reg_index = inputs.size() + s;
+            const bool is_output = s + 1 == steps_.size();
+            float* y = buffer.data() + reg_index * tile_size;
+            if (is_output) {
+              y = reduced_output ? output + tile : output + start;
+            }
+
+            const std::array<const float*, 3> x{registers[step.operands[0]], registers[step.operands[1]],
+                                                registers[step.operands[2]]};
+            if (per_row[reg_index]) {
+              // computed once and broadcast along the row for the operators that read it
+              Evaluate(step.op, x.data(), y, IsReduction(step.op) ? n : 1);
+              if (!is_output) {
+                std::fill_n(y + 1, n - 1, y[0]);
+              }
+            } else {
+              Evaluate(step.op, x.data(), y, n);
+            }
+            registers[reg_index] = y;
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    FusedElementwise,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T1", {DataTypeImpl::GetTensorType<float>(), DataTypeImpl::GetTensorType<bool>()}),
+    FusedElementwise);
+
+}  // namespace contrib
+}  // namespace onnxruntime
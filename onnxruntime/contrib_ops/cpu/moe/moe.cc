@@ -0,0 +1,308 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/moe/moe.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    MoE,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    MoE<float>);
+
+namespace {
+
+Status CheckExpertsTensor(const Tensor* tensor, const char* name, std::initializer_list<int64_t> expected_dims) {
+  if (tensor != nullptr && tensor->Shape() != TensorShape(expected_dims)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, name, " must have shape ", TensorShape(expected_dims),
+                           ", got ", tensor->Shape());
+  }
+  return Status::OK();
+}
+
+// C = A * B + bias, where A is M x K, B is K x N and bias is broadcast to the rows of C.
+void GemmWithBias(const float* a, const float* b, const float* bias, size_t m, size_t n, size_t k, float* c,
+                  ThreadPool* tp) {
+  float beta = 0.0f;
+  if (bias != nullptr) {
+    for (size_t row = 0; row < m; ++row) {
+      std::memcpy(c + row * n, bias, n * sizeof(float));
+    }
+    beta = 1.0f;
+  }
+  MlasGemm(CblasNoTrans, CblasNoTrans, m, n, k, 1.0f, a, k, b, n, beta, c, n, tp);
+}
+
+}  // namespace
+
+template <typename T>
+MoE<T>::MoE(const OpKernelInfo& info) : OpKernel(info) {
+  k_ = info.GetAttrOrDefault<int64_t>("k", 1);
+  ORT_ENFORCE(k_ > 0, "k must be positive, got ", k_);
+  normalize_routing_weights_ = info.GetAttrOrDefault<int64_t>("normalize_routing_weights", 0) == 1;
+
+  const std::string activation_type = info.GetAttrOrDefault<std::string>("activation_type", "relu");
+  if (activation_type == "relu") {
+    activation_type_ = MoEActivationType::Relu;
+  } else if (activation_type == "gelu") {
+    activation_type_ = MoEActivationType::Gelu;
+  } else if (activation_type == "silu") {
+    activation_type_ = MoEActivationType::Silu;
+  } else if (activation_type == "identity") {
+    activation_type_ = MoEActivationType::Identity;
+  } else {
+    ORT_THROW("Unsupported MoE activation type: ", activation_type);
+  }
+}
+
+template <typename T>
+void MoE<T>::ApplyActivation(float* data, size_t size) const {
+  switch (activation_type_) {
+    case MoEActivationType::Relu:
+      for (size_t i = 0; i < size; ++i) {
+        data[i] = std::max(data[i], 0.0f);
+      }
+      break;
+    case MoEActivationType::Gelu: {
+      // tanh approximation, as used by the CUDA kernel
+      constexpr float kAlpha = 0.7978845608028654f;  // sqrt(2 / pi)
+      constexpr float kBeta = 0.044715f;
+      std::vector<float> tanh_input(size);
+      for (size_t i = 0; i < size; ++i) {
+        tanh_input[i] = kAlpha * (data[i] + kBeta * data[i] * data[i] * data[i]);
+      }
+      MlasComputeTanh(tanh_input.data(), tanh_input.data(), size);
+      for (size_t i = 0; i < size; ++i) {
+        data[i] = 0.5f * data[i] * (1.0f + tanh_input[i]);
+      }
+      break;
+    }
+    case MoEActivationType::Silu: {
+      std::vector<float> sigmoid(size);
+      MlasComputeLogistic(data, sigmoid.data(), size);
+      for (size_t i = 0; i < size; ++i) {
+        data[i] *= sigmoid[i];
+      }
+      break;
+    }
+    case MoEActivationType::Identity:
+      break;
+  }
+}
+
+template <typename T>
+Status MoE<T>::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* router_probs = context->Input<Tensor>(1);
+  const Tensor* fc1_experts_weights = context->Input<Tensor>(2);
+  const Tensor* fc1_experts_bias = context->Input<Tensor>(3);
+  const Tensor* fc2_experts_weights = context->Input<Tensor>(4);
+  const Tensor* fc2_experts_bias = context->Input<Tensor>(5);
+  const Tensor* fc3_experts_weights = context->Input<Tensor>(6);
+  const Tensor* fc3_experts_bias = context->Input<Tensor>(7);
+
+  const auto& input_shape = input->Shape();
+  ORT_RETURN_IF_NOT(input_shape.NumDimensions() == 2 || input_shape.NumDimensions() == 3,
+                    "input must be 2D or 3D, got ", input_shape);
+  ORT_RETURN_IF_NOT(router_probs->Shape().NumDimensions() == 2, "router_probs must be 2D, got ",
+                    router_probs->Shape());
+  ORT_RETURN_IF_NOT(fc1_experts_weights->Shape().NumDimensions() == 3, "fc1_experts_weights must be 3D, got ",
+                    fc1_experts_weights->Shape());
+
+  const int64_t num_rows = input_shape.SizeToDimension(input_shape.NumDimensions() - 1);
+  const int64_t hidden_size = input_shape[input_shape.NumDimensions() - 1];
+  const int64_t num_experts = router_probs->Shape()[1];
+  const int64_t inter_size = fc1_experts_weights->Shape()[2];
+
+  ORT_RETURN_IF_NOT(router_probs->Shape()[0] == num_rows, "router_probs must have shape ",
+                    TensorShape({num_rows, num_experts}), ", got ", router_probs->Shape());
+  ORT_RETURN_IF_NOT(k_ <= num_experts, "k must not be greater than the number of experts, got ", k_, " and ",
+                    num_experts);
+  ORT_RETURN_IF_ERROR(CheckExpertsTensor(fc1_experts_weights, "fc1_experts_weights",
+                                         {num_experts, hidden_size, inter_size}));
+  ORT_RETURN_IF_ERROR(CheckExpertsTensor(fc1_experts_bias, "fc1_experts_bias", {num_experts, inter_size}));
+  ORT_RETURN_IF_ERROR(CheckExpertsTensor(fc2_experts_weights, "fc2_experts_weights",
+                                         {num_experts, inter_size, hidden_size}));
+  ORT_RETURN_IF_ERROR(CheckExpertsTensor(fc2_experts_bias, "fc2_experts_bias", {num_experts, hidden_size}));
+  ORT_RETURN_IF_ERROR(CheckExpertsTensor(fc3_experts_weights, "fc3_experts_weights",
+                                         {num_experts, hidden_size, inter_size}));
+  ORT_RETURN_IF_ERROR(CheckExpertsTensor(fc3_experts_bias, "fc3_experts_bias", {num_experts, inter_size}));
+
+  Tensor* output = context->Output(0, input_shape);
+  if (num_rows == 0) {
+    return Status::OK();
+  }
+
+  ThreadPool* tp = context->GetOperatorThreadPool();
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  const float* input_data = input->Data<float>();
+  const float* router_data = router_probs->Data<float>();
+  const size_t k = static_cast<size_t>(k_);
+  const size_t hidden = static_cast<size_t>(hidden_size);
+  const size_t inter = static_cast<size_t>(inter_size);
+  const size_t num_expanded_rows = SafeInt<size_t>(num_rows) * k;
+
+  // Top-k gating. The j-th expert of row r is at index r * k + j of the expanded rows.
+  std::vector<int64_t> expert_for_expanded_row(num_expanded_rows);
+  std::vector<float> routing_weights(num_expanded_rows);
+  ThreadPool::TryParallelFor(
+      tp, num_rows, static_cast<double>(num_experts) * 4,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        std::vector<int64_t> experts(static_cast<size_t>(num_experts));
+        for (std::ptrdiff_t row = begin; row < end; ++row) {
+          const float* logits = router_data + row * num_experts;
+          const float max_logit = *std::max_element(logits, logits + num_experts);
+          float sum = 0.0f;
+          for (int64_t e = 0; e < num_experts; ++e) {
+            sum += std::exp(logits[e] - max_logit);
+          }
+
+          std::iota(experts.begin(), experts.end(), int64_t{0});
+          std::partial_sort(experts.begin(), experts.begin() + k_, experts.end(), [logits](int64_t a, int64_t b) {
+            return logits[a] > logits[b] || (logits[a] == logits[b] && a < b);
+          });
+
+          float selected_sum = 0.0f;
+          for (size_t j = 0; j < k; ++j) {
+            const size_t idx = static_cast<size_t>(row) * k + j;
+            expert_for_expanded_row[idx] = experts[j];
+            routing_weights[idx] = std::exp(logits[experts[j]] - max_logit) / sum;
+            selected_sum += routing_weights[idx];
+          }
+          if (normalize_routing_weights_) {
+            for (size_t j = 0; j < k; ++j) {
+              routing_weights[static_cast<size_t>(row) * k + j] /= selected_sum;
+            }
+          }
+        }
+      });
+
+  // Group the expanded rows by expert. Rows of the same expert keep their order.
+  std::vector<size_t> expert_offsets(static_cast<size_t>(num_experts) + 1, 0);
+  for (const int64_t expert : expert_for_expanded_row) {
+    ++expert_offsets[expert + 1];
+  }
+  std::partial_sum(expert_offsets.begin(), expert_offsets.end(), expert_offsets.begin());
+
+  std::vector<size_t> permuted_row_for_expanded_row(num_expanded_rows);
+  {
+    std::vector<size_t> next_row(expert_offsets.begin(), expert_offsets.end() - 1);
+    for (size_t i = 0; i < num_expanded_rows; ++i) {
+      permuted_row_for_expanded_row[i] = next_row[expert_for_expanded_row[i]]++;
+    }
+  }
+
+  auto permuted_input = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(num_expanded_rows) * hidden);
+  auto fc1_output = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(num_expanded_rows) * inter);
+  IAllocatorUniquePtr<float> fc3_output;
+  if (fc3_experts_weights != nullptr) {
+    fc3_output = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(num_expanded_rows) * inter);
+  }
+  auto permuted_output = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(num_expanded_rows) * hidden);
+
+  ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_expanded_rows), static_cast<double>(hidden),
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i < end; ++i) {
+          std::memcpy(permuted_input.get() + permuted_row_for_expanded_row[i] * hidden,
+                      input_data + (static_cast<size_t>(i) / k) * hidden, hidden * sizeof(float));
+        }
+      });
+
+  const float* fc1_weights = fc1_experts_weights->Data<float>();
+  const float* fc1_bias = fc1_experts_bias != nullptr ? fc1_experts_bias->Data<float>() : nullptr;
+  const float* fc2_weights = fc2_experts_weights->Data<float>();
+  const float* fc3_weights = fc3_experts_weights != nullptr ? fc3_experts_weights->Data<float>() : nullptr;
+  const float* fc3_bias = fc3_experts_bias != nullptr ? fc3_experts_bias->Data<float>() : nullptr;
+
+  auto run_expert = [&](size_t expert, ThreadPool* gemm_tp) {
+    const size_t first_row = expert_offsets[expert];
+    const size_t rows = expert_offsets[expert + 1] - first_row;
+    const float* a = permuted_input.get() + first_row * hidden;
+    float* fc1_rows = fc1_output.get() + first_row * inter;
+
+    GemmWithBias(a, fc1_weights + expert * hidden * inter, fc1_bias ? fc1_bias + expert * inter : nullptr,
+                 rows, inter, hidden, fc1_rows, gemm_tp);
+    ApplyActivation(fc1_rows, rows * inter);
+
+    if (fc3_weights != nullptr) {
+      float* fc3_rows = fc3_output.get() + first_row * inter;
+      GemmWithBias(a, fc3_weights + expert * hidden * inter, fc3_bias ? fc3_bias + expert * inter : nullptr,
+                   rows, inter, hidden, fc3_rows, gemm_tp);
+      for (size_t i = 0; i < rows * inter; ++i) {
+        fc1_rows[i] *= fc3_rows[i];
+      }
+    }
+
+    // the bias of fc2 is added when the rows are unpermuted
+    GemmWithBias(fc1_rows, fc2_weights + expert * inter * hidden, nullptr, rows, hidden, inter,
+                 permuted_output.get() + first_row * hidden, gemm_tp);
+  };
+
+  // Experts with the most rows first, so that the threads finish at about the same time.
+  std::vector<size_t> active_experts;
+  for (size_t expert = 0; expert < static_cast<size_t>(num_experts); ++expert) {
+    if (expert_offsets[expert + 1] > expert_offsets[expert]) {
+      active_experts.push_back(expert);
+    }
+  }
+  std::stable_sort(active_experts.begin(), active_experts.end(), [&expert_offsets](size_t a, size_t b) {
+    return expert_offsets[a + 1] - expert_offsets[a] > expert_offsets[b + 1] - expert_offsets[b];
+  });
+
+  if (static_cast<int>(active_experts.size()) >= ThreadPool::DegreeOfParallelism(tp)) {
+    // Enough experts to keep all the threads busy, e.g. while decoding: the experts run concurrently with a
+    // single threaded GEMM each.
+    ThreadPool::TrySimpleParallelFor(tp, static_cast<std::ptrdiff_t>(active_experts.size()),
+                                      [&](std::ptrdiff_t i) { run_expert(active_experts[i], nullptr); });
+  } else {
+    for (const size_t expert : active_experts) {
+      run_expert(expert, tp);
+    }
+  }
+
+  // Unpermute the expert outputs and reduce them to the weighted sum of each row.
+  const float* fc2_bias = fc2_experts_bias != nullptr ? fc2_experts_bias->Data<float>() : nullptr;
+  float* output_data = output->MutableData<float>();
+  ThreadPool::TryParallelFor(
+      tp, num_rows, static_cast<double>(hidden * k),
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t row = begin; row < end; ++row) {
+          float* out = output_data + row * hidden;
+          std::fill_n(out, hidden, 0.0f);
+          for (size_t j = 0; j < k; ++j) {
+            const size_t idx = static_cast<size_t>(row) * k + j;
+            const float weight = routing_weights[idx];
+            const float* expert_out = permuted_output.get() + permuted_row_for_expanded_row[idx] * hidden;
+            const float* bias = fc2_bias ? fc2_bias + expert_for_expanded_row[idx] * hidden : nullptr;
+            for (size_t c = 0; c < hidden; ++c) {
+              out[c] += weight * (expert_out[c] + (bias ? bias[c] : 0.0f));
+            }
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
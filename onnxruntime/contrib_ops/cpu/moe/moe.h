@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+enum class MoEActivationType {
+  Relu,
+  Gelu,
+  Silu,
+  Identity,
+};
+
+// Mixture of experts. The rows are routed to the top k experts of a softmax over router_probs, grouped by expert so
+// that each expert runs its FFN as one GEMM per layer over all of its rows, and the expert outputs are scattered
+// back to their rows as a weighted sum.
+template <typename T>
+class MoE final : public OpKernel {
+ public:
+  explicit MoE(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  void ApplyActivation(float* data, size_t size) const;
+
+  int64_t k_;
+  bool normalize_routing_weights_;
+  MoEActivationType activation_type_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -11,6 +11,8 @@
 #include "core/util/qmath.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace onnxruntime {
 namespace contrib {
@@ -35,6 +37,66 @@ void ScaleOutput(const Tensor& scale, Tensor& output) {
 
   BroadcastLooper(broadcast_helper, funcs);
 }
+
+// Converts the int32 gemm results to float when A has one scale per row.
+// Y[m, n] = C[m, n] * a_scale[m] * b_scale[n or 0] + bias[n]
+class RowScaleBiasOutputProcessor : public MLAS_QGEMM_OUTPUT_PROCESSOR {
+ public:
+  RowScaleBiasOutputProcessor(float* output, size_t ldo, const float* row_scales,
+                              const float* col_scales, bool is_col_scale_per_column, const float* bias)
+      : output_(output),
+        ldo_(ldo),
+        row_scales_(row_scales),
+        col_scales_(col_scales),
+        is_col_scale_per_column_(is_col_scale_per_column),
+        bias_(bias) {}
+
+  void Process(const int32_t* C, size_t start_m, size_t start_n, size_t count_m, size_t count_n,
+               size_t ldc) const override {
+    for (size_t m = 0; m < count_m; m++) {
+      const int32_t* c = C + (start_m + m) * ldc + start_n;
+      float* y = output_ + (start_m + m) * ldo_ + start_n;
+      const float row_scale = row_scales_[start_m + m];
+      for (size_t n = 0; n < count_n; n++) {
+        const float col_scale = is_col_scale_per_column_ ? col_scales_[start_n + n] : col_scales_[0];
+        y[n] = static_cast<float>(c[n]) * row_scale * col_scale + (bias_ != nullptr ? bias_[start_n + n] : 0.0f);
+      }
+    }
+  }
+
+ private:
+  float* output_;
+  size_t ldo_;
+  const float* row_scales_;
+  const float* col_scales_;
+  bool is_col_scale_per_column_;
+  const float* bias_;
+};
+
+// Quantizes each row of A symmetrically with its own scale. All rows share the zero point 128, which is what MLAS
+// requires of a uint8 A, so the int8 gemm is unchanged and only the output conversion applies the row scales.
+// Each row is reduced and quantized by the same thread while it is still in cache.
+void QuantizeRowsSymmetric(const float* a_data, uint8_t* a_quant, float* a_scales, size_t rows, size_t row_size,
+                           concurrency::ThreadPool* thread_pool) {
+  constexpr uint8_t kZeroPoint = 128;
+  const TensorOpCost unit_cost{static_cast<double>(row_size) * sizeof(float),
+                               static_cast<double>(row_size) * sizeof(uint8_t),
+                               static_cast<double>(row_size) * 2.0};
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(rows), unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t row = begin; row < end; row++) {
+          const float* row_data = a_data + row * row_size;
+          float min = std::numeric_limits<float>::max();
+          float max = std::numeric_limits<float>::lowest();
+          MlasFindMinMaxElement(row_data, &min, &max, row_size);
+
+          const float abs_max = std::max(std::abs(min), std::abs(max));
+          const float scale = abs_max > 0.0f ? abs_max / 127.0f : 1.0f;
+          a_scales[row] = scale;
+          MlasQuantizeLinear(row_data, a_quant + row * row_size, row_size, scale, kZeroPoint);
+        }
+      });
+}
 }  // namespace
 
 class MatMulIntegerToFloatBase : public MatMulIntegerBase {
@@ -54,7 +116,8 @@ class MatMulIntegerToFloatBase : public MatMulIntegerBase {
                        const Tensor* b_tensor,
                        const Tensor* b_scale,
                        const Tensor* b_zp,
-                       const Tensor* bias_tensor) const;
+                       const Tensor* bias_tensor,
+                       const float* a_row_scales = nullptr) const;
 };
 
 Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
@@ -66,7 +129,8 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
                                                const Tensor* b_tensor,
                                                const Tensor* b_scale_tensor,
                                                const Tensor* b_zp_tensor,
-                                               const Tensor* bias_tensor) const {
+                                               const Tensor* bias_tensor,
+                                               const float* a_row_scales) const {
   MatMulComputeHelper helper;
   ORT_RETURN_IF_ERROR(helper.Compute(a_shape,
                                      b_tensor ? b_tensor->Shape() : b_shape_,
@@ -126,18 +190,33 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
 
   const size_t num_gemms = helper.OutputOffsets().size();
   std::vector<MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR> gemm_scale_procs;
-  gemm_scale_procs.reserve(num_gemms);
+  std::vector<RowScaleBiasOutputProcessor> gemm_row_scale_procs;
+  if (a_row_scales != nullptr) {
+    gemm_row_scale_procs.reserve(num_gemms);
+  } else {
+    gemm_scale_procs.reserve(num_gemms);
+  }
   std::vector<MLAS_GEMM_QUANT_DATA_PARAMS> gemm_data_vec(num_gemms);
 
   for (size_t gemm_idx = 0; gemm_idx < num_gemms; gemm_idx++) {
-    gemm_scale_procs.emplace_back(y_data + helper.OutputOffsets()[gemm_idx],
-                                  gemm_shape.N,
-                                  b_scale_data + helper.RightScaleOffsets()[gemm_idx],
-                                  bias_data,
-                                  MLAS_QGEMM_OUTPUT_MODE::ZeroMode,
-                                  is_b_scale_per_column ? MLAS_QUANTIZATION_GRANULARITY::PerColumn : MLAS_QUANTIZATION_GRANULARITY::PerMatrix);
     auto& params = gemm_data_vec[gemm_idx];
-    params.OutputProcessor = &(gemm_scale_procs[gemm_idx]);
+    if (a_row_scales != nullptr) {
+      gemm_row_scale_procs.emplace_back(y_data + helper.OutputOffsets()[gemm_idx],
+                                        gemm_shape.N,
+                                        a_row_scales + helper.LeftOffsets()[gemm_idx] / gemm_shape.K,
+                                        b_scale_data + helper.RightScaleOffsets()[gemm_idx],
+                                        is_b_scale_per_column,
+                                        bias_data);
+      params.OutputProcessor = &(gemm_row_scale_procs[gemm_idx]);
+    } else {
+      gemm_scale_procs.emplace_back(y_data + helper.OutputOffsets()[gemm_idx],
+                                    gemm_shape.N,
+                                    b_scale_data + helper.RightScaleOffsets()[gemm_idx],
+                                    bias_data,
+                                    MLAS_QGEMM_OUTPUT_MODE::ZeroMode,
+                                    is_b_scale_per_column ? MLAS_QUANTIZATION_GRANULARITY::PerColumn : MLAS_QUANTIZATION_GRANULARITY::PerMatrix);
+      params.OutputProcessor = &(gemm_scale_procs[gemm_idx]);
+    }
     params.A = a_data + helper.LeftOffsets()[gemm_idx];
     params.lda = gemm_shape.K;
     params.ZeroPointA = a_zp;
@@ -157,7 +236,9 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
 
 class DynamicQuantizeMatMul final : public MatMulIntegerToFloatBase {
  public:
-  DynamicQuantizeMatMul(const OpKernelInfo& info) : MatMulIntegerToFloatBase(info) {}
+  DynamicQuantizeMatMul(const OpKernelInfo& info) : MatMulIntegerToFloatBase(info) {
+    per_row_a_quantization_ = info.GetAttrOrDefault<int64_t>("per_row_a_quantization", 0) != 0;
+  }
 
   Status Compute(OpKernelContext* context) const override;
 
@@ -171,6 +252,11 @@ class DynamicQuantizeMatMul final : public MatMulIntegerToFloatBase {
 
  protected:
   int GetBIdx() const override { return IN_B; }
+
+ private:
+  Status ComputePerRow(OpKernelContext* ctx) const;
+
+  bool per_row_a_quantization_{false};
 };
 
 class MatMulIntegerToFloat final : public MatMulIntegerToFloatBase {
@@ -198,7 +284,55 @@ class MatMulIntegerToFloat final : public MatMulIntegerToFloatBase {
   static void FixupScaleTensor(const Tensor*& a_scale_tensor, const Tensor*& b_scale_tensor);
 };
 
+Status DynamicQuantizeMatMul::ComputePerRow(OpKernelContext* ctx) const {
+  const Tensor* a = ctx->Input<Tensor>(IN_A);
+  const Tensor* b = packed_b_ ? nullptr : ctx->Input<Tensor>(IN_B);
+
+  const Tensor* b_scale_tensor = ctx->Input<Tensor>(IN_B_SCALE);
+  const Tensor* b_zp_tensor = ctx->Input<Tensor>(IN_B_ZERO_POINT);
+
+  const TensorShape& a_shape = a->Shape();
+  ORT_RETURN_IF(a_shape.NumDimensions() == 0, "DynamicQuantizeMatMul : A must have at least one dimension.");
+  const size_t num_of_elements = narrow<size_t>(a_shape.Size());
+  const size_t row_size = narrow<size_t>(a_shape[a_shape.NumDimensions() - 1]);
+  const size_t rows = row_size == 0 ? 0 : num_of_elements / row_size;
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
+  auto a_data_quant = IAllocator::MakeUniquePtr<uint8_t>(allocator, num_of_elements);
+  auto a_row_scales = IAllocator::MakeUniquePtr<float>(allocator, std::max<size_t>(rows, 1));
+
+  QuantizeRowsSymmetric(a->Data<float>(), a_data_quant.get(), a_row_scales.get(), rows, row_size,
+                        ctx->GetOperatorThreadPool());
+
+  // the row scales replace the scale of A, and a B scale that is neither per tensor nor per column is applied to
+  // the output afterwards like in Compute()
+  bool is_b_scale_supported = IsBQuantParamSupported(b_scale_tensor->Shape(), b ? b->Shape() : b_shape_);
+  ORT_RETURN_IF_ERROR(ComputeCommon(
+      ctx,
+      a_data_quant.get(),
+      a_shape,
+      1.0f,
+      128,
+      false /*a_is_signed*/,
+      b,
+      is_b_scale_supported ? b_scale_tensor : nullptr,
+      b_zp_tensor,
+      ctx->Input<Tensor>(IN_BIAS),
+      a_row_scales.get()));
+
+  if (!is_b_scale_supported) {
+    ScaleOutput(*b_scale_tensor, *ctx->Output<Tensor>(0));
+  }
+
+  return Status::OK();
+}
+
 Status DynamicQuantizeMatMul::Compute(OpKernelContext* ctx) const {
+  if (per_row_a_quantization_) {
+    return ComputePerRow(ctx);
+  }
+
   const Tensor* a = ctx->Input<Tensor>(IN_A);
   const Tensor* b = packed_b_ ? nullptr : ctx->Input<Tensor>(IN_B);
 
@@ -0,0 +1,190 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/framework/float16.h"
+#include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+class GatherBlockQuantized final : public OpKernel {
+ public:
+  explicit GatherBlockQuantized(const OpKernelInfo& info) : OpKernel(info) {
+    ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("K", &K_));
+    bits_ = info.GetAttrOrDefault<int64_t>("bits", 4);
+    block_size_ = info.GetAttrOrDefault<int64_t>("block_size", 128);
+    ORT_ENFORCE(K_ > 0, "GatherBlockQuantized K must be positive, got ", K_);
+    ORT_ENFORCE(bits_ == 4 || bits_ == 8, "GatherBlockQuantized only supports 4 and 8 bits, got ", bits_);
+    ORT_ENFORCE(block_size_ >= 16 && ((block_size_ - 1) & block_size_) == 0,
+                "GatherBlockQuantized block_size must be a power of 2 and not smaller than 16, got ", block_size_);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  template <typename T, typename Tind>
+  Status ComputeImpl(OpKernelContext* context) const;
+
+  int64_t K_;
+  int64_t bits_;
+  int64_t block_size_;
+};
+
+ONNX_OPERATOR_KERNEL_EX(
+    GatherBlockQuantized,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", std::vector<MLDataType>{DataTypeImpl::GetTensorType<float>(),
+                                                      DataTypeImpl::GetTensorType<MLFloat16>()})
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T3", std::vector<MLDataType>{DataTypeImpl::GetTensorType<uint8_t>(),
+                                                      DataTypeImpl::GetTensorType<float>(),
+                                                      DataTypeImpl::GetTensorType<MLFloat16>()})
+        .TypeConstraint("Tind", std::vector<MLDataType>{DataTypeImpl::GetTensorType<int32_t>(),
+                                                        DataTypeImpl::GetTensorType<int64_t>()}),
+    GatherBlockQuantized);
+
+namespace {
+
+float ToFloat(float value) { return value; }
+float ToFloat(MLFloat16 value) { return value.ToFloat(); }
+
+// Dequantizes one row of `row_size` elements. The scale and zero point of each block are read once and the
+// elements of the block are converted in a tight loop. The row of the quantized matrix is only read, never
+// materialized in float.
+template <typename T, typename TZeroPoint>
+void DequantizeRow(const uint8_t* row_data, const T* row_scales, const TZeroPoint* zero_points, size_t row_index,
+                   size_t row_size, size_t block_size, size_t blocks_per_row, size_t blob_size, size_t zp_row_bytes,
+                   int64_t bits, T* output) {
+  const float default_zero_point = static_cast<float>(1 << (bits - 1));
+  for (size_t block = 0; block < blocks_per_row; ++block) {
+    const float scale = ToFloat(row_scales[block]);
+    float zero_point = default_zero_point;
+    if (zero_points != nullptr) {
+      if constexpr (std::is_same_v<TZeroPoint, uint8_t>) {
+        const uint8_t packed = zero_points[row_index * zp_row_bytes + (bits == 4 ? block / 2 : block)];
+        zero_point = static_cast<float>(bits == 4 ? ((block & 1) ? (packed >> 4) : (packed & 0x0F)) : packed);
+      } else {
+        zero_point = ToFloat(zero_points[row_index * blocks_per_row + block]);
+      }
+    }
+
+    const uint8_t* block_data = row_data + block * blob_size;
+    const size_t begin = block * block_size;
+    const size_t count = std::min(block_size, row_size - begin);
+    T* block_output = output + begin;
+    if (bits == 4) {
+      for (size_t k = 0; k < count; ++k) {
+        const uint8_t packed = block_data[k / 2];
+        const uint8_t q = (k & 1) ? (packed >> 4) : (packed & 0x0F);
+        block_output[k] = T((static_cast<float>(q) - zero_point) * scale);
+      }
+    } else {
+      for (size_t k = 0; k < count; ++k) {
+        block_output[k] = T((static_cast<float>(block_data[k]) - zero_point) * scale);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T, typename Tind>
+Status GatherBlockQuantized::ComputeImpl(OpKernelContext* context) const {
+  const Tensor* data = context->Input<Tensor>(0);
+  const Tensor* indices = context->Input<Tensor>(1);
+  const Tensor* scales = context->Input<Tensor>(2);
+  const Tensor* zero_points = context->Input<Tensor>(3);
+
+  const size_t row_size = narrow<size_t>(K_);
+  const size_t block_size = narrow<size_t>(block_size_);
+  const size_t blocks_per_row = (row_size + block_size - 1) / block_size;
+  const size_t blob_size = block_size * narrow<size_t>(bits_) / 8;
+  const size_t row_bytes = blocks_per_row * blob_size;
+  const size_t zp_row_bytes = (blocks_per_row * narrow<size_t>(bits_) + 7) / 8;
+
+  const auto& data_shape = data->Shape();
+  ORT_RETURN_IF_NOT(data_shape.NumDimensions() >= 1, "GatherBlockQuantized data must have rank larger than zero.");
+  const int64_t num_rows = data_shape[0];
+  ORT_RETURN_IF_NOT(data_shape.Size() == SafeInt<int64_t>(num_rows) * row_bytes,
+                    "GatherBlockQuantized data shape ", data_shape, " does not match [N][", blocks_per_row, "][",
+                    blob_size, "] for K=", K_, ", bits=", bits_, " and block_size=", block_size_);
+  ORT_RETURN_IF_NOT(scales->Shape().Size() == SafeInt<int64_t>(num_rows) * blocks_per_row,
+                    "GatherBlockQuantized scales must have ", num_rows * static_cast<int64_t>(blocks_per_row),
+                    " elements, got shape ", scales->Shape());
+
+  const bool packed_zero_points = zero_points != nullptr && zero_points->IsDataType<uint8_t>();
+  if (zero_points != nullptr) {
+    ORT_RETURN_IF_NOT(packed_zero_points || zero_points->DataType() == scales->DataType(),
+                      "GatherBlockQuantized zero_points must be uint8 or have the type of scales.");
+    const size_t expected = packed_zero_points ? zp_row_bytes : blocks_per_row;
+    ORT_RETURN_IF_NOT(zero_points->Shape().Size() == SafeInt<int64_t>(num_rows) * expected,
+                      "GatherBlockQuantized zero_points must have ", num_rows * static_cast<int64_t>(expected),
+                      " elements, got shape ", zero_points->Shape());
+  }
+
+  const auto indices_span = indices->DataAsSpan<Tind>();
+  for (const Tind index : indices_span) {
+    if (index < -num_rows || index >= num_rows) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "indices element out of data bounds, idx=", index,
+                             " must be within the inclusive range [", -num_rows, ",", num_rows - 1, "]");
+    }
+  }
+
+  TensorShapeVector output_dims(indices->Shape().GetDims().begin(), indices->Shape().GetDims().end());
+  output_dims.push_back(K_);
+  Tensor* output = context->Output(0, TensorShape(output_dims));
+  if (indices_span.empty()) {
+    return Status::OK();
+  }
+
+  const uint8_t* data_ptr = data->Data<uint8_t>();
+  const T* scales_ptr = scales->Data<T>();
+  T* output_ptr = output->MutableData<T>();
+
+  const TensorOpCost cost{static_cast<double>(row_bytes + blocks_per_row * sizeof(T)),
+                          static_cast<double>(row_size * sizeof(T)),
+                          static_cast<double>(row_size * 2)};
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(indices_span.size()), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          int64_t index = static_cast<int64_t>(indices_span[static_cast<size_t>(i)]);
+          index = index < 0 ? index + num_rows : index;
+          const size_t row = static_cast<size_t>(index);
+          T* output_row = output_ptr + static_cast<size_t>(i) * row_size;
+          if (zero_points == nullptr || packed_zero_points) {
+            DequantizeRow<T, uint8_t>(data_ptr + row * row_bytes, scales_ptr + row * blocks_per_row,
+                                      packed_zero_points ? zero_points->Data<uint8_t>() : nullptr, row, row_size,
+                                      block_size, blocks_per_row, blob_size, zp_row_bytes, bits_, output_row);
+          } else {
+            DequantizeRow<T, T>(data_ptr + row * row_bytes, scales_ptr + row * blocks_per_row,
+                                zero_points->Data<T>(), row, row_size, block_size, blocks_per_row, blob_size,
+                                zp_row_bytes, bits_, output_row);
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+Status GatherBlockQuantized::Compute(OpKernelContext* context) const {
+  const Tensor* indices = context->Input<Tensor>(1);
+  const bool is_float = context->Input<Tensor>(2)->IsDataType<float>();
+  if (indices->IsDataType<int32_t>()) {
+    return is_float ? ComputeImpl<float, int32_t>(context) : ComputeImpl<MLFloat16, int32_t>(context);
+  }
+  return is_float ? ComputeImpl<float, int64_t>(context) : ComputeImpl<MLFloat16, int64_t>(context);
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -102,8 +102,10 @@ class MatMulNBits final : public OpKernel {
       has_unquantized_zero_point_ = type != ONNX_NAMESPACE::TensorProto_DataType_UINT8;
     }
 
-    ORT_ENFORCE(nbits_ == 4,
-                "Only 4b quantization is supported for MatMulNBits op, additional bits support is planned.");
+    ORT_ENFORCE(nbits_ == 2 || nbits_ == 3 || nbits_ == 4,
+                "Only 2b, 3b and 4b quantization is supported for MatMulNBits op, additional bits support is planned.");
+    ORT_ENFORCE(info.GetAttrOrDefault<std::string>("activation", "").empty(),
+                "The activation attribute of MatMulNBits is not supported by the CPU execution provider.");
 #ifdef ORT_NEURAL_SPEED
     const Tensor* tensor_B = nullptr;
     const Tensor* tensor_scale = nullptr;
@@ -126,6 +128,8 @@ class MatMulNBits final : public OpKernel {
   Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  bool CanRestorePrePackedWeightsFromBuffers(int input_idx) const override;
+
  private:
   const size_t K_;
   const size_t N_;
@@ -264,6 +268,17 @@ Status MatMulNBits::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prep
   return Status::OK();
 }
 
+bool MatMulNBits::CanRestorePrePackedWeightsFromBuffers(int input_idx) const {
+#if defined(ORT_NEURAL_SPEED)
+  // B, scales and zero points are packed into the same buffer in place by successive PrePack() calls
+  ORT_UNUSED_PARAMETER(input_idx);
+  return false;
+#else   // defined(ORT_NEURAL_SPEED)
+  // packed_b_ is the only state produced by PrePack() and MLAS only reads from it
+  return input_idx == InputIndex::B;
+#endif  // defined(ORT_NEURAL_SPEED)
+}
+
 Status MatMulNBits::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
   const Tensor* a = ctx->Input<Tensor>(InputIndex::A);
@@ -378,8 +393,21 @@ Status MatMulNBits::Compute(OpKernelContext* ctx) const {
   AllocatorPtr allocator;
   ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
   auto tmp_b_data_ptr = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(K_) * N_);
-  if ((reorder_idx_data == nullptr) && (!zero_points || !zero_points->IsDataType<float>())) {
-    // dequantize b, only 4b quantization is supported for now
+  if (nbits_ != 4) {
+    // !!!!!!!!!!!!!! naive implementation, need to be optimized !!!!!!!!!!!!!!
+    if (zero_points && zero_points->IsDataType<float>()) {
+      DequantizeBlockwiseNBits<float, float>(
+          tmp_b_data_ptr.get(), b_data, scales_data, static_cast<const float*>(zero_points_data), reorder_idx_data,
+          static_cast<int32_t>(block_size_), static_cast<int32_t>(nbits_), static_cast<int32_t>(K_),
+          static_cast<int32_t>(N_), thread_pool);
+    } else {
+      DequantizeBlockwiseNBits<float, uint8_t>(
+          tmp_b_data_ptr.get(), b_data, scales_data, static_cast<const uint8_t*>(zero_points_data), reorder_idx_data,
+          static_cast<int32_t>(block_size_), static_cast<int32_t>(nbits_), static_cast<int32_t>(K_),
+          static_cast<int32_t>(N_), thread_pool);
+    }
+  } else if ((reorder_idx_data == nullptr) && (!zero_points || !zero_points->IsDataType<float>())) {
+    // dequantize b
     MlasDequantizeBlockwise<float, 4>(
         tmp_b_data_ptr.get(),                           // dequantized output
         b_data,                                         // quantized input
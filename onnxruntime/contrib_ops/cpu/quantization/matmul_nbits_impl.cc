@@ -95,6 +95,76 @@ void DequantizeBlockwise(
       });
 }
 
+namespace {
+
+// Reads the `bits`-bit value at `index` of a little endian bit stream.
+inline uint8_t GetBitStreamValue(const uint8_t* stream, int32_t bits, int64_t index) {
+  const int64_t bit_offset = index * bits;
+  const int32_t shift = static_cast<int32_t>(bit_offset % 8);
+  uint32_t value = static_cast<uint32_t>(stream[bit_offset / 8]) >> shift;
+  if (shift + bits > 8) {
+    value |= static_cast<uint32_t>(stream[bit_offset / 8 + 1]) << (8 - shift);
+  }
+  return static_cast<uint8_t>(value & ((1u << bits) - 1));
+}
+
+}  // namespace
+
+template <typename inputT, typename zeroT>
+void DequantizeBlockwiseNBits(
+    inputT* output,
+    const uint8_t* quant_data,
+    const inputT* scales_data,
+    const zeroT* zero_points,
+    const int32_t* reorder_idx,
+    int32_t block_size,
+    int32_t bits,
+    int32_t K,
+    int32_t N,
+    onnxruntime::concurrency::ThreadPool* pool) {
+  const int32_t blocks_per_col = (K + block_size - 1) / block_size;
+  const int64_t blob_size = (static_cast<int64_t>(block_size) * bits + 7) / 8;
+  const int64_t zero_point_col_size = (static_cast<int64_t>(blocks_per_col) * bits + 7) / 8;
+  const float default_zero_point = static_cast<float>(1 << (bits - 1));
+
+  const TensorOpCost cost{static_cast<double>(blocks_per_col * blob_size),
+                          static_cast<double>(K) * sizeof(inputT),
+                          static_cast<double>(K) * 4.0};
+  concurrency::ThreadPool::TryParallelFor(
+      pool, static_cast<std::ptrdiff_t>(N), cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t n = begin; n < end; ++n) {
+          const uint8_t* quant_col = quant_data + n * blocks_per_col * blob_size;
+          for (int32_t k = 0; k < K; ++k) {
+            const int32_t block = k / block_size;
+            const int32_t group = reorder_idx ? reorder_idx[k] : block;
+            const float scale = static_cast<float>(scales_data[n * blocks_per_col + group]);
+
+            float zero_point = default_zero_point;
+            if (zero_points) {
+              if constexpr (std::is_same_v<zeroT, inputT>) {
+                zero_point = static_cast<float>(zero_points[n * blocks_per_col + group]);
+              } else {
+                zero_point = static_cast<float>(GetBitStreamValue(zero_points + n * zero_point_col_size, bits, group));
+              }
+            }
+
+            const uint8_t value = GetBitStreamValue(quant_col + block * blob_size, bits, k % block_size);
+            output[n * K + k] = static_cast<inputT>((static_cast<float>(value) - zero_point) * scale);
+          }
+        }
+      });
+}
+
+template void DequantizeBlockwiseNBits<float, uint8_t>(
+    float* output, const uint8_t* quant_data, const float* scales_data,
+    const uint8_t* zero_points, const int32_t* reorder_idx, int32_t block_size,
+    int32_t bits, int32_t K, int32_t N, onnxruntime::concurrency::ThreadPool* thread_pool);
+
+template void DequantizeBlockwiseNBits<float, float>(
+    float* output, const uint8_t* quant_data, const float* scales_data,
+    const float* zero_points, const int32_t* reorder_idx, int32_t block_size,
+    int32_t bits, int32_t K, int32_t N, onnxruntime::concurrency::ThreadPool* thread_pool);
+
 template void DequantizeBlockwise<float, uint8_t>(
     float* output, const uint8_t* quant_data, const float* scales_data,
     const uint8_t* zero_points, const int32_t* reorder_idx, int32_t block_size,
@@ -23,7 +23,14 @@ class QGemm : protected GemmBase, public MatMulIntegerBase {
     const auto& b_shape = b ? b->Shape() : b_shape_;
 
     const auto* c = context->Input<Tensor>(IN_C);
-    GemmHelper helper(a->Shape(), trans_A_ != CblasNoTrans,
+
+    // Without transA, the leading dimensions of A are flattened into M like in MatMul.
+    const auto& a_dims = a->Shape().GetDims();
+    ORT_RETURN_IF(a_dims.size() > 2 && trans_A_ != CblasNoTrans, "QGemm : A must be 2D if transA is set");
+    const TensorShape a_shape = a_dims.size() > 2 ? TensorShape({a->Shape().SizeToDimension(a_dims.size() - 1),
+                                                                 a_dims.back()})
+                                                  : a->Shape();
+    GemmHelper helper(a_shape, trans_A_ != CblasNoTrans,
                       b_shape, trans_B_ != CblasNoTrans,
                       c != nullptr ? c->Shape() : TensorShape({}));
     if (!helper.State().IsOK())
@@ -67,7 +74,13 @@ class QGemm : protected GemmBase, public MatMulIntegerBase {
       }
     }
 
-    auto y = context->Output(OUT_Y, {M, N});
+    TensorShapeVector y_dims(a_dims.begin(), a_dims.end());
+    if (a_dims.size() > 2) {
+      y_dims.back() = N;
+    } else {
+      y_dims = {M, N};
+    }
+    auto y = context->Output(OUT_Y, y_dims);
     if (M == 0 || N == 0) return Status::OK();
 
     // prepare output buffer of GEMM
@@ -0,0 +1,170 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "core/common/narrow.h"
+#include "core/framework/float16.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+class EmbeddingBag final : public OpKernel {
+ public:
+  explicit EmbeddingBag(const OpKernelInfo& info) : OpKernel(info) {
+    const std::string mode = info.GetAttrOrDefault<std::string>("mode", "sum");
+    ORT_ENFORCE(mode == "sum" || mode == "mean", "EmbeddingBag mode must be 'sum' or 'mean', got ", mode);
+    mean_ = mode == "mean";
+    keepdims_ = info.GetAttrOrDefault<int64_t>("keepdims", 0) != 0;
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  bool mean_;
+  bool keepdims_;
+};
+
+ONNX_OPERATOR_KERNEL_EX(
+    EmbeddingBag,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", std::vector<MLDataType>{DataTypeImpl::GetTensorType<float>(),
+                                                     DataTypeImpl::GetTensorType<MLFloat16>()})
+        .TypeConstraint("Tind", std::vector<MLDataType>{DataTypeImpl::GetTensorType<int32_t>(),
+                                                        DataTypeImpl::GetTensorType<int64_t>()}),
+    EmbeddingBag);
+
+namespace {
+
+template <typename Tind>
+Status CheckIndices(gsl::span<const Tind> indices, int64_t num_rows) {
+  for (const Tind index : indices) {
+    if (index < -num_rows || index >= num_rows) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "EmbeddingBag indices element out of data bounds, idx=",
+                             index, " must be within the inclusive range [", -num_rows, ",", num_rows - 1, "]");
+    }
+  }
+  return Status::OK();
+}
+
+// Accumulates the rows of each bag in float straight into its output row, so the gathered rows are never written to
+// memory. Bags are independent, so they are split across the threads without any synchronization. Float16 rows are
+// converted a row at a time into a float scratch buffer of the thread.
+template <typename T, typename Tind>
+void ComputeBags(const T* weight, const Tind* indices, T* output, size_t num_bags, size_t bag_size, size_t dim,
+                 int64_t num_rows, bool mean, concurrency::ThreadPool* tp) {
+  const float scale = mean && bag_size > 0 ? 1.0f / static_cast<float>(bag_size) : 1.0f;
+  const TensorOpCost cost{static_cast<double>(bag_size * (dim * sizeof(T) + sizeof(Tind))),
+                          static_cast<double>(dim * sizeof(T)),
+                          static_cast<double>(bag_size * dim)};
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_bags), cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> accumulator;
+        std::vector<float> row_buffer;
+        if constexpr (!std::is_same_v<T, float>) {
+          accumulator.resize(dim);
+          row_buffer.resize(dim);
+        }
+
+        for (std::ptrdiff_t bag = first; bag < last; ++bag) {
+          const Tind* bag_indices = indices + static_cast<size_t>(bag) * bag_size;
+          T* output_row = output + static_cast<size_t>(bag) * dim;
+          float* acc = nullptr;
+          if constexpr (std::is_same_v<T, float>) {
+            acc = output_row;
+          } else {
+            acc = accumulator.data();
+          }
+          std::fill_n(acc, dim, 0.0f);
+
+          for (size_t i = 0; i < bag_size; ++i) {
+            int64_t index = static_cast<int64_t>(bag_indices[i]);
+            index = index < 0 ? index + num_rows : index;
+            const T* row = weight + static_cast<size_t>(index) * dim;
+
+            const float* row_data = nullptr;
+            if constexpr (std::is_same_v<T, float>) {
+              row_data = row;
+            } else {
+              MlasConvertHalfToFloatBuffer(reinterpret_cast<const unsigned short*>(row), row_buffer.data(), dim);
+              row_data = row_buffer.data();
+            }
+            for (size_t d = 0; d < dim; ++d) {
+              acc[d] += row_data[d];
+            }
+          }
+
+          if constexpr (std::is_same_v<T, float>) {
+            if (scale != 1.0f) {
+              for (size_t d = 0; d < dim; ++d) {
+                acc[d] *= scale;
+              }
+            }
+          } else {
+            for (size_t d = 0; d < dim; ++d) {
+              output_row[d] = MLFloat16(acc[d] * scale);
+            }
+          }
+        }
+      });
+}
+
+template <typename T, typename Tind>
+Status ComputeImpl(const Tensor& weight, const Tensor& indices, Tensor& output, bool mean,
+                   concurrency::ThreadPool* tp) {
+  const int64_t num_rows = weight.Shape()[0];
+  ORT_RETURN_IF_ERROR(CheckIndices(indices.DataAsSpan<Tind>(), num_rows));
+
+  const auto& indices_shape = indices.Shape();
+  const size_t bag_size = narrow<size_t>(indices_shape[indices_shape.NumDimensions() - 1]);
+  const size_t num_bags = narrow<size_t>(indices_shape.SizeToDimension(indices_shape.NumDimensions() - 1));
+  const size_t dim = narrow<size_t>(weight.Shape()[1]);
+
+  ComputeBags<T, Tind>(weight.Data<T>(), indices.Data<Tind>(), output.MutableData<T>(), num_bags, bag_size, dim,
+                       num_rows, mean, tp);
+  return Status::OK();
+}
+
+}  // namespace
+
+Status EmbeddingBag::Compute(OpKernelContext* context) const {
+  const Tensor* weight = context->Input<Tensor>(0);
+  const Tensor* indices = context->Input<Tensor>(1);
+  const auto& weight_shape = weight->Shape();
+  const auto& indices_shape = indices->Shape();
+
+  ORT_RETURN_IF_NOT(weight_shape.NumDimensions() == 2, "EmbeddingBag weight must be 2D, got shape ", weight_shape);
+  ORT_RETURN_IF_NOT(indices_shape.NumDimensions() >= 1, "EmbeddingBag indices must have rank larger than zero.");
+
+  TensorShapeVector output_dims(indices_shape.GetDims().begin(), indices_shape.GetDims().end() - 1);
+  if (keepdims_) {
+    output_dims.push_back(1);
+  }
+  output_dims.push_back(weight_shape[1]);
+  Tensor* output = context->Output(0, TensorShape(output_dims));
+  if (output->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  const bool is_float = weight->IsDataType<float>();
+  if (indices->IsDataType<int32_t>()) {
+    return is_float ? ComputeImpl<float, int32_t>(*weight, *indices, *output, mean_, tp)
+                    : ComputeImpl<MLFloat16, int32_t>(*weight, *indices, *output, mean_, tp);
+  }
+  return is_float ? ComputeImpl<float, int64_t>(*weight, *indices, *output, mean_, tp)
+                  : ComputeImpl<MLFloat16, int64_t>(*weight, *indices, *output, mean_, tp);
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -23,6 +23,8 @@ namespace transformers {
 
 using namespace onnxruntime::controlflow;  // namespace of IControlFlowKernel
 
+class GptPrefixCache;
+
 class BeamSearch : public IControlFlowKernel {
  public:
   BeamSearch(const OpKernelInfo& info, std::unique_ptr<BeamSearchParameters> param = std::make_unique<BeamSearchParameters>())
@@ -160,6 +162,10 @@ class BeamSearch : public IControlFlowKernel {
   std::unique_ptr<GptSubgraph> init_run_gpt_subgraph_;
   std::unique_ptr<GptSubgraph> gpt_subgraph_;
 
+  // Past state of the GPT subgraph for prompts of earlier runs, nullptr if kOrtSessionOptionsConfigGptPrefixCacheSize
+  // is not set.
+  std::shared_ptr<GptPrefixCache> gpt_prefix_cache_;
+
   // Relevant only for T5
   // Same concept as above.
   // The encoder will be used for the first run and the decoder will
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "contrib_ops/cpu/transformers/beam_search_impl_base.h"
+#include "contrib_ops/cpu/transformers/gpt_prefix_cache.h"
 
 #include "core/common/span_utils.h"
 
@@ -65,6 +66,11 @@ class BeamSearchGpt : public BeamSearchBase<T> {
   }
 #endif
 
+  // Use `prefix_cache` for the past state of the prompts, it may be nullptr.
+  void SetPrefixCache(GptPrefixCache* prefix_cache) {
+    prefix_cache_ = prefix_cache;
+  }
+
   // Execute beam search in iterations util stopping criteria is reached.
   // In each iteration, GPT subgraph is called, and next token for each sequence is generated.
   Status Execute(const FeedsFetchesManager* init_run_feeds_fetches_manager,
@@ -108,6 +114,8 @@ class BeamSearchGpt : public BeamSearchBase<T> {
 
   const void* cuda_device_prop_ = nullptr;
   int cuda_device_arch_ = 0;
+
+  GptPrefixCache* prefix_cache_ = nullptr;
 };
 
 template <typename T>
@@ -211,7 +219,7 @@ Status BeamSearchGpt<T>::Execute(const FeedsFetchesManager* init_run_feeds_fetch
   // Initialize resources
   this->beam_scorer_ = create_beam_scorer_func_
                            ? create_beam_scorer_func_(*parameters, this->temp_space_allocator_, this->cpu_allocator_, this->ort_stream_)
-                           : std::make_unique<BeamSearchScorer>(*parameters, this->cpu_allocator_);
+                           : std::make_unique<BeamSearchScorer>(*parameters, this->cpu_allocator_, this->thread_pool_);
 
   BeamSearchCpuState cpu_state{*parameters,
                                this->cpu_allocator_,
@@ -224,6 +232,20 @@ Status BeamSearchGpt<T>::Execute(const FeedsFetchesManager* init_run_feeds_fetch
   ORT_RETURN_IF_ERROR(CreateInitialFeeds(cpu_state.sequence_lengths, expanded_input_ids_in_cpu, feeds, buffer,
                                          gpt_subgraph_.has_decoder_masked_attention_));
 
+  // Prompts of the first run cached after it, empty when the prefix cache isn't used.
+  gsl::span<const int32_t> prompt_to_cache;
+  if (prefix_cache_ != nullptr && !this->IsCuda() && !gpt_subgraph_.past_present_share_buffer_ &&
+      GptPrefixCache::CanUse(feeds, gpt_subgraph_.GetFirstPastInputIndex(), gpt_subgraph_.num_layers)) {
+    prompt_to_cache = expanded_input_ids_in_cpu.Get<Tensor>().DataAsSpan<int32_t>().subspan(
+        0, static_cast<size_t>(parameters->sequence_length));
+    const int prefix_length = prefix_cache_->ApplyToInitialFeeds(feeds, gpt_subgraph_.GetFirstPastInputIndex(),
+                                                                 gpt_subgraph_.num_layers, this->cpu_allocator_);
+    if (prefix_length > 0) {
+      LOGS(this->context_.Logger(), VERBOSE) << "Reusing the cached past state of " << prefix_length
+                                             << " prompt tokens.";
+    }
+  }
+
   if (gpt_subgraph_.past_present_share_buffer_) {  // Reuse past and present
     fetches.reserve(static_cast<size_t>(gpt_subgraph_.GetFirstPresentOutputIndex()) + gpt_subgraph_.num_layers);
     fetches.resize(gpt_subgraph_.GetFirstPresentOutputIndex(), OrtValue());
@@ -323,6 +345,14 @@ Status BeamSearchGpt<T>::Execute(const FeedsFetchesManager* init_run_feeds_fetch
 
     ORT_RETURN_IF_ERROR(status);
 
+    if (iteration_counter == 1 && !prompt_to_cache.empty()) {
+      prefix_cache_->Insert(prompt_to_cache,
+                            gsl::make_span(fetches).subspan(
+                                static_cast<size_t>(gpt_subgraph_.GetFirstPresentOutputIndex()),
+                                static_cast<size_t>(gpt_subgraph_.num_layers)),
+                            this->cpu_allocator_);
+    }
+
     const OrtValue& logits = fetches[0];
     gsl::span<int32_t> beam_next_tokens;
     ORT_RETURN_IF_ERROR(this->GenerateNextToken(logits,
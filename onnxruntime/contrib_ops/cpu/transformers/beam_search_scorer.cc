@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <atomic>
 #include <queue>
 #include <math.h>
 #include "core/common/common.h"
@@ -19,9 +20,12 @@ namespace contrib {
 namespace transformers {
 using ::onnxruntime::rnn::detail::Allocate;
 
-void BeamHypotheses::Init(float length_penalty, gsl::span<HypothesisScore> beams) {
+void BeamHypotheses::Init(float length_penalty, gsl::span<HypothesisScore> beams,
+                          gsl::span<int32_t> hypothesis_buffer) {
   beams_ = beams;
   beams_used_ = 0;
+  hypothesis_buffer_ = hypothesis_buffer;
+  hypothesis_buffer_used_ = 0;
   length_penalty_ = length_penalty;
   done_ = false;
 }
@@ -45,6 +49,16 @@ void BeamHypotheses::Add(gsl::span<const int32_t>& hypothesis, float sum_logprob
   beams_[index] = HypothesisScore{hypothesis, score};
 }
 
+void BeamHypotheses::Clone(gsl::span<const int32_t> sequence, float sum_logprobs) {
+  ORT_ENFORCE(hypothesis_buffer_used_ + sequence.size() <= hypothesis_buffer_.size());
+  auto clone = hypothesis_buffer_.subspan(hypothesis_buffer_used_, sequence.size());
+  gsl::copy(sequence, clone);
+  hypothesis_buffer_used_ += sequence.size();
+
+  auto hypothesis = ReinterpretAsSpan<const int32_t>(clone);
+  Add(hypothesis, sum_logprobs);
+}
+
 bool BeamHypotheses::CanImprove(float best_sum_logprobs, int current_length) const {
   float current_score = best_sum_logprobs / pow(static_cast<float>(current_length), length_penalty_);
   return beams_.back().score < current_score;
@@ -73,7 +87,8 @@ void BeamHypotheses::Output(
 }
 
 BeamSearchScorer::BeamSearchScorer(const IGenerationParameters& parameters,
-                                   AllocatorPtr& allocator)
+                                   AllocatorPtr& allocator,
+                                   concurrency::ThreadPool* thread_pool)
     : batch_size_{static_cast<size_t>(parameters.batch_size)},
       num_beams_{static_cast<size_t>(parameters.num_beams)},
       max_length_{static_cast<size_t>(parameters.max_length)},
@@ -81,105 +96,119 @@ BeamSearchScorer::BeamSearchScorer(const IGenerationParameters& parameters,
       pad_token_id_{parameters.pad_token_id},
       eos_token_id_{parameters.eos_token_id},
       early_stopping_{parameters.early_stopping},
-      not_done_count_{parameters.batch_size} {
+      not_done_count_{parameters.batch_size},
+      thread_pool_{thread_pool} {
   size_t batch_beam_size = batch_size_ * num_beams_;
 
-  auto beams = Allocate<HypothesisScore>(allocator, batch_beam_size, hypothesis_scores_ptr_);
-  beam_hyps_ = Allocate<BeamHypotheses>(allocator, batch_size_, beam_hyps_ptr_);
-  for (size_t i = 0; i < batch_size_; i++)
-    beam_hyps_[i].Init(parameters.length_penalty, beams.subspan(i * num_beams_, num_beams_));
-
   next_beam_scores_ = Allocate<float>(allocator, batch_beam_size, next_beam_scores_ptr_);
   next_beam_tokens_ = Allocate<int32_t>(allocator, batch_beam_size, next_beam_tokens_ptr_);
   next_beam_indices_ = Allocate<int32_t>(allocator, batch_beam_size, next_beam_indices_ptr_);
 
   // Space to store intermediate sequence with length sequence_length, sequence_length + 1, ..., max_sequence_length.
+  // At most num_beams_ hypotheses of a batch entry finish in a step.
   size_t per_beam = (SafeInt<size_t>(max_length_) * (max_length_ + 1) - (parameters.sequence_length - 1) * parameters.sequence_length) / 2;
-  hypothesis_buffer_ = Allocate<int32_t>(allocator, batch_beam_size * per_beam, hypothesis_buffer_ptr_);
-}
+  size_t per_batch = SafeInt<size_t>(num_beams_) * per_beam;
+  auto hypothesis_buffer = Allocate<int32_t>(allocator, SafeInt<size_t>(batch_size_) * per_batch, hypothesis_buffer_ptr_);
 
-void BeamSearchScorer::Process(ISequences& sequences,
-                               gsl::span<const float>& next_scores,
-                               gsl::span<const int32_t>& next_tokens,
-                               gsl::span<const int32_t>& next_indices) {
-  // Sequences shape is (batch_size * num_beams, total_sequence_length)
-  // It contains word ID of whole sequence generated so far.
-  // It is different from subgraph input_ids, which only need one word when past state is not empty.
+  auto beams = Allocate<HypothesisScore>(allocator, batch_beam_size, hypothesis_scores_ptr_);
+  beam_hyps_ = Allocate<BeamHypotheses>(allocator, batch_size_, beam_hyps_ptr_);
+  for (size_t i = 0; i < batch_size_; i++)
+    beam_hyps_[i].Init(parameters.length_penalty, beams.subspan(i * num_beams_, num_beams_),
+                       hypothesis_buffer.subspan(i * per_batch, per_batch));
+}
 
+bool BeamSearchScorer::ProcessBatch(size_t batch,
+                                    ISequences& sequences,
+                                    gsl::span<const float>& next_scores,
+                                    gsl::span<const int32_t>& next_tokens,
+                                    gsl::span<const int32_t>& next_indices) {
   const int sequence_length = sequences.GetSequenceLength();
 
-  ORT_ENFORCE(next_scores.size() == next_tokens.size());
-  ORT_ENFORCE(next_scores.size() == next_indices.size());
+  BeamHypotheses& beam_hyp = beam_hyps_[batch];
+  if (beam_hyp.done_) {
+    ORT_ENFORCE(beam_hyp.beams_used_ == gsl::narrow_cast<int>(num_beams_),
+                "Batch can only be done if all beams have been generated");
 
-  for (size_t batch = 0; batch < batch_size_; batch++) {
-    BeamHypotheses& beam_hyp = beam_hyps_[batch];
-    if (beam_hyp.done_) {
-      ORT_ENFORCE(beam_hyp.beams_used_ == gsl::narrow_cast<int>(num_beams_),
-                  "Batch can only be done if all beams have been generated");
-
-      // Pad the batch.
-      for (size_t j = 0; j < num_beams_; j++) {
-        next_beam_scores_[batch * num_beams_ + j] = 0.0f;
-        next_beam_tokens_[batch * num_beams_ + j] = pad_token_id_;
-        next_beam_indices_[batch * num_beams_ + j] = 0;
-      }
-      continue;
+    // Pad the batch.
+    for (size_t j = 0; j < num_beams_; j++) {
+      next_beam_scores_[batch * num_beams_ + j] = 0.0f;
+      next_beam_tokens_[batch * num_beams_ + j] = pad_token_id_;
+      next_beam_indices_[batch * num_beams_ + j] = 0;
     }
+    return false;
+  }
 
-    // Next tokens for this sentence.
-    size_t beam_idx = 0;
-    size_t top_k = 2 * num_beams_;
-    for (size_t j = 0; j < top_k; j++) {
-      int32_t next_token = next_tokens[batch * top_k + j];
-      float next_score = next_scores[batch * top_k + j];
-      int32_t next_index = next_indices[batch * top_k + j];
-
-      int batch_beam_idx = static_cast<int>(batch * num_beams_) + next_index;
-      // Add to generated hypotheses if end of sentence.
-      if ((eos_token_id_ >= 0) && (next_token == eos_token_id_)) {
-        bool is_beam_token_worse_than_top_num_beams = (j >= num_beams_);
-        if (is_beam_token_worse_than_top_num_beams) {
-          continue;
-        }
-
-        // Clone the sequence and append to buffer.
-        gsl::span<const int32_t> src = sequences.GetSequence(batch_beam_idx);
-        auto clone = hypothesis_buffer_.subspan(static_cast<size_t>(hypothesis_buffer_used_), sequence_length);
-
-        gsl::copy(src, clone);
-        hypothesis_buffer_used_ += sequence_length;
-        auto sequence = ReinterpretAsSpan<const int32_t>(clone);
-        beam_hyp.Add(sequence, next_score);
-      } else {
-        // Add next predicted token since it is not eos_token.
-        next_beam_scores_[batch * num_beams_ + beam_idx] = next_score;
-        next_beam_tokens_[batch * num_beams_ + beam_idx] = next_token;
-        next_beam_indices_[batch * num_beams_ + beam_idx] = batch_beam_idx;
-        ++beam_idx;
+  // Next tokens for this sentence.
+  size_t beam_idx = 0;
+  size_t top_k = 2 * num_beams_;
+  for (size_t j = 0; j < top_k; j++) {
+    int32_t next_token = next_tokens[batch * top_k + j];
+    float next_score = next_scores[batch * top_k + j];
+    int32_t next_index = next_indices[batch * top_k + j];
+
+    int batch_beam_idx = static_cast<int>(batch * num_beams_) + next_index;
+    // Add to generated hypotheses if end of sentence.
+    if ((eos_token_id_ >= 0) && (next_token == eos_token_id_)) {
+      bool is_beam_token_worse_than_top_num_beams = (j >= num_beams_);
+      if (is_beam_token_worse_than_top_num_beams) {
+        continue;
       }
 
-      // Once the beam for next step is full, don't add more tokens to it.
-      if (beam_idx == num_beams_)
-        break;
+      // Clone the sequence and append to buffer.
+      beam_hyp.Clone(sequences.GetSequence(batch_beam_idx), next_score);
+    } else {
+      // Add next predicted token since it is not eos_token.
+      next_beam_scores_[batch * num_beams_ + beam_idx] = next_score;
+      next_beam_tokens_[batch * num_beams_ + beam_idx] = next_token;
+      next_beam_indices_[batch * num_beams_ + beam_idx] = batch_beam_idx;
+      ++beam_idx;
     }
 
-    ORT_ENFORCE(beam_idx == num_beams_);
-    ORT_ENFORCE(static_cast<size_t>(hypothesis_buffer_used_) <= hypothesis_buffer_.size());
+    // Once the beam for next step is full, don't add more tokens to it.
+    if (beam_idx == num_beams_)
+      break;
+  }
 
-    //  Check if we are done so that we can save a pad step if all(done)
-    if (static_cast<size_t>(beam_hyp.beams_used_) < num_beams_)
-      continue;
+  ORT_ENFORCE(beam_idx == num_beams_);
 
-    if (!early_stopping_) {
-      gsl::span<const float> topk_scores = next_scores.subspan(batch * num_beams_, top_k);
-      const auto best_sum_logprobs = std::max_element(topk_scores.begin(), topk_scores.end());
-      if (beam_hyp.CanImprove(*best_sum_logprobs, sequence_length))
-        continue;
-    }
+  //  Check if we are done so that we can save a pad step if all(done)
+  if (static_cast<size_t>(beam_hyp.beams_used_) < num_beams_)
+    return false;
 
-    beam_hyp.done_ = true;
-    not_done_count_--;
+  if (!early_stopping_) {
+    gsl::span<const float> topk_scores = next_scores.subspan(batch * num_beams_, top_k);
+    const auto best_sum_logprobs = std::max_element(topk_scores.begin(), topk_scores.end());
+    if (beam_hyp.CanImprove(*best_sum_logprobs, sequence_length))
+      return false;
   }
+
+  beam_hyp.done_ = true;
+  return true;
+}
+
+void BeamSearchScorer::Process(ISequences& sequences,
+                               gsl::span<const float>& next_scores,
+                               gsl::span<const int32_t>& next_tokens,
+                               gsl::span<const int32_t>& next_indices) {
+  // Sequences shape is (batch_size * num_beams, total_sequence_length)
+  // It contains word ID of whole sequence generated so far.
+  // It is different from subgraph input_ids, which only need one word when past state is not empty.
+
+  ORT_ENFORCE(next_scores.size() == next_tokens.size());
+  ORT_ENFORCE(next_scores.size() == next_indices.size());
+
+  // Each batch entry writes its own slice of the next beams and its own hypotheses.
+  std::atomic<int> done_count{0};
+  concurrency::ThreadPool::TryBatchParallelFor(
+      thread_pool_, static_cast<std::ptrdiff_t>(batch_size_),
+      [&](std::ptrdiff_t batch) {
+        if (ProcessBatch(static_cast<size_t>(batch), sequences, next_scores, next_tokens, next_indices)) {
+          done_count.fetch_add(1, std::memory_order_relaxed);
+        }
+      },
+      0);
+
+  not_done_count_ -= done_count.load();
 }
 
 template <typename T>
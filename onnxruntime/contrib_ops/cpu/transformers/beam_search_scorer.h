@@ -10,6 +10,7 @@
 #include "core/framework/allocator.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/cpu/containers.h"
 #include "contrib_ops/cpu/transformers/sequences.h"
@@ -25,8 +26,13 @@ struct HypothesisScore {
 };
 
 struct BeamHypotheses {
-  // As these are constructed as an uninitialized array of memory, we need an Init method
-  void Init(float length_penalty, gsl::span<HypothesisScore> beams);
+  // As these are constructed as an uninitialized array of memory, we need an Init method.
+  // `hypothesis_buffer` holds the clones of the hypotheses of this batch entry only, so batch entries are
+  // processed independently.
+  void Init(float length_penalty, gsl::span<HypothesisScore> beams, gsl::span<int32_t> hypothesis_buffer);
+
+  // Copy a finished sequence into hypothesis_buffer_ and add it
+  void Clone(gsl::span<const int32_t> sequence, float sum_logprobs);
 
   // Add a new hypothesis
   void Add(gsl::span<const int32_t>& hypothesis, float sum_logprobs);
@@ -43,13 +49,17 @@ struct BeamHypotheses {
 
   gsl::span<HypothesisScore> beams_;  // Beam width sized array of hypotheses, sorted by highest scoring
   int beams_used_;                    // Number of elements used in beams_
+  gsl::span<int32_t> hypothesis_buffer_;
+  size_t hypothesis_buffer_used_;  // Offset of available buffer, or length of used buffer.
   float length_penalty_;
   bool done_;
 };
 
 struct BeamSearchScorer : IBeamScorer {
+  // Batch entries are scored in parallel on `thread_pool` when it's provided.
   BeamSearchScorer(const IGenerationParameters& parameters,
-                   AllocatorPtr& allocator);
+                   AllocatorPtr& allocator,
+                   concurrency::ThreadPool* thread_pool = nullptr);
 
   void Process(ISequences& sequences,
                gsl::span<const float>& next_scores,
@@ -65,6 +75,14 @@ struct BeamSearchScorer : IBeamScorer {
 
   bool IsDone() const override { return not_done_count_ == 0; }
 
+  // Selects the next beams of a batch entry and adds its finished hypotheses. Returns true if the entry
+  // just became done.
+  bool ProcessBatch(size_t batch,
+                    ISequences& sequences,
+                    gsl::span<const float>& next_scores,
+                    gsl::span<const int32_t>& next_tokens,
+                    gsl::span<const int32_t>& next_indices);
+
   gsl::span<float> GetNextScores() override { return next_beam_scores_; }
   gsl::span<int32_t> GetNextTokens() override { return next_beam_tokens_; }
   gsl::span<int32_t> GetNextIndicesCPU() override { return next_beam_indices_; }
@@ -77,6 +95,7 @@ struct BeamSearchScorer : IBeamScorer {
   int eos_token_id_;
   bool early_stopping_;
   int not_done_count_;  // When zero, every batch entry is done (starts at batch_size_)
+  concurrency::ThreadPool* thread_pool_;
 
   IAllocatorUniquePtr<float> next_beam_scores_ptr_;
   gsl::span<float> next_beam_scores_;
@@ -87,9 +106,7 @@ struct BeamSearchScorer : IBeamScorer {
   IAllocatorUniquePtr<int32_t> next_beam_indices_ptr_;
   gsl::span<int32_t> next_beam_indices_;
 
-  IAllocatorUniquePtr<int32_t> hypothesis_buffer_ptr_;  // Allocated buffer to hold all hypotheses
-  gsl::span<int32_t> hypothesis_buffer_;                // Span of the allocated buffer
-  int hypothesis_buffer_used_{};                        // Offset of available buffer, or length of used buffer.
+  IAllocatorUniquePtr<int32_t> hypothesis_buffer_ptr_;  // Allocated buffer to hold all hypotheses, split per batch entry
 
   IAllocatorUniquePtr<HypothesisScore> hypothesis_scores_ptr_;  // num_beams_ * batch_size_, divided into num_beams_ chunks per BeamHypothesis in beam_hyps_
   IAllocatorUniquePtr<BeamHypotheses> beam_hyps_ptr_;
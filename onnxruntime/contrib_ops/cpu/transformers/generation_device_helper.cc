@@ -7,6 +7,7 @@
 #include "core/providers/cpu/math/top_k.h"
 #include "core/providers/cpu/math/softmax_shared.h"
 #include "core/providers/cpu/generator/random.h"
+#include "core/common/inlined_containers.h"
 #include "core/common/safeint.h"
 #include <gsl/gsl>
 #include "contrib_ops/cpu/transformers/sequences.h"
@@ -555,7 +556,50 @@ Status DeviceCopy(gsl::span<T> target, gsl::span<const T> source, Stream* /*stre
   return Status::OK();
 }
 
-// Copy present state to past state for GPT model
+// Reorder the beams of `state`, which has `beam_indices.size()` blocks of `block_size` elements, so that block j
+// holds the former block beam_indices[j]. The state is updated in place: only the blocks of beams that continue
+// another beam are written, and a block is staged first when it's overwritten but still a source of another beam.
+template <typename T>
+void ReorderBeamsInPlace(gsl::span<T> state,
+                         gsl::span<const int32_t> beam_indices,
+                         size_t block_size,
+                         AllocatorPtr allocator) {
+  const size_t batch_beam_size = beam_indices.size();
+  InlinedVector<int32_t> staged_index(batch_beam_size, -1);
+  int32_t num_staged = 0;
+  for (size_t j = 0; j < batch_beam_size; j++) {
+    const size_t beam_index = static_cast<size_t>(beam_indices[j]);
+    if (beam_index != j && beam_indices[beam_index] != static_cast<int32_t>(beam_index) &&
+        staged_index[beam_index] < 0) {
+      staged_index[beam_index] = num_staged++;
+    }
+  }
+
+  IAllocatorUniquePtr<T> staging;
+  if (num_staged > 0) {
+    staging = IAllocator::MakeUniquePtr<T>(allocator, SafeInt<size_t>(num_staged) * block_size);
+    for (size_t j = 0; j < batch_beam_size; j++) {
+      if (staged_index[j] >= 0) {
+        std::copy_n(state.data() + j * block_size, block_size, staging.get() + staged_index[j] * block_size);
+      }
+    }
+  }
+
+  for (size_t j = 0; j < batch_beam_size; j++) {
+    const size_t beam_index = static_cast<size_t>(beam_indices[j]);
+    if (beam_index == j) {
+      continue;
+    }
+
+    const T* source = staged_index[beam_index] >= 0 ? staging.get() + staged_index[beam_index] * block_size
+                                                    : state.data() + beam_index * block_size;
+    std::copy_n(source, block_size, state.data() + j * block_size);
+  }
+}
+
+// Copy present state to past state for GPT model.
+// The present state is an output of the last subgraph run that isn't used elsewhere, so it's reordered in place
+// and fed as the past state.
 template <typename T>
 void PickGptPastState(const std::vector<OrtValue>& last_outputs,
                       std::vector<OrtValue>& next_inputs,
@@ -569,30 +613,17 @@ void PickGptPastState(const std::vector<OrtValue>& last_outputs,
 
     // shape is like (2, batch_beam_size, 12, past_seq_len, 64)
     const TensorShape& past_shape = present.Get<Tensor>().Shape();
-    auto block_size_per_beam = past_shape[2] * past_shape[3] * past_shape[4];
-    auto past_key_size = past_shape[1] * past_shape[2] * past_shape[3] * past_shape[4];
-
-    // Create a tensor with same shape.
-    // TODO(tianleiwu): allocate one buffer for all layers
-    OrtValue past;
-    auto past_type = DataTypeImpl::GetType<T>();
-    Tensor::InitOrtValue(past_type, past_shape, allocator, past);
-
-    gsl::span<T> past_span = gsl::make_span<T>(past.GetMutable<Tensor>()->MutableData<T>(), onnxruntime::narrow<size_t>(past_shape.Size()));
-    gsl::span<const T> present_span = gsl::make_span<const T>(present.Get<Tensor>().Data<T>(), onnxruntime::narrow<size_t>(past_shape.Size()));
-    for (size_t j = 0; j < beam_indices.size(); j++) {
-      int32_t beam_index = beam_indices[j];
-      gsl::span<const T> present_key = present_span.subspan(beam_index * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::span<const T> present_value = present_span.subspan(past_key_size + beam_index * SafeInt<size_t>(block_size_per_beam),
-                                                              onnxruntime::narrow<size_t>(block_size_per_beam));
-
-      gsl::span<T> past_key = past_span.subspan(j * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::span<T> past_value = past_span.subspan(past_key_size + j * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::copy(present_key, past_key);
-      gsl::copy(present_value, past_value);
-    }
+    ORT_ENFORCE(past_shape[1] == static_cast<int64_t>(beam_indices.size()));
+    auto block_size_per_beam = onnxruntime::narrow<size_t>(past_shape[2] * past_shape[3] * past_shape[4]);
+    auto past_key_size = onnxruntime::narrow<size_t>(past_shape[1] * past_shape[2] * past_shape[3] * past_shape[4]);
+
+    gsl::span<T> present_span = gsl::make_span<T>(const_cast<T*>(present.Get<Tensor>().Data<T>()),
+                                                  onnxruntime::narrow<size_t>(past_shape.Size()));
+    ReorderBeamsInPlace<T>(present_span.subspan(0, past_key_size), beam_indices, block_size_per_beam, allocator);
+    ReorderBeamsInPlace<T>(present_span.subspan(past_key_size, past_key_size), beam_indices, block_size_per_beam,
+                           allocator);
 
-    next_inputs[gpt_subgraph_first_past_input_idx + i] = past;
+    next_inputs[gpt_subgraph_first_past_input_idx + i] = present;
   }
 }
 
@@ -756,7 +787,7 @@ Status CreateEncoderInputs(
   return Status::OK();
 }
 
-// Copy present state to past state for T5 model
+// Copy present state to past state for T5 model, the present state is reordered in place like in PickGptPastState.
 template <typename T>
 void PickT5PastState(const std::vector<OrtValue>& last_outputs,
                      std::vector<OrtValue>& next_inputs,
@@ -770,23 +801,14 @@ void PickT5PastState(const std::vector<OrtValue>& last_outputs,
 
     // shape is like (batch_beam_size, 12, past_seq_len, 64)
     const TensorShape& past_shape = present.Get<Tensor>().Shape();
-    auto block_size_per_beam = past_shape[1] * past_shape[2] * past_shape[3];
-
-    // Create a tensor with same shape.
-    // TODO(tianleiwu): allocate one buffer for all layers
-    OrtValue past;
-    Tensor::InitOrtValue(DataTypeImpl::GetType<T>(), past_shape, allocator, past);
-
-    gsl::span<T> past_span = gsl::make_span<T>(past.GetMutable<Tensor>()->MutableData<T>(), onnxruntime::narrow<size_t>(past_shape.Size()));
-    gsl::span<const T> present_span = gsl::make_span<const T>(present.Get<Tensor>().Data<T>(), onnxruntime::narrow<size_t>(past_shape.Size()));
-    for (size_t j = 0; j < beam_indices.size(); j++) {
-      int32_t beam_index = beam_indices[j];
-      gsl::span<const T> present_beam = present_span.subspan(beam_index * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::span<T> past_beam = past_span.subspan(j * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::copy(present_beam, past_beam);
-    }
+    ORT_ENFORCE(past_shape[0] == static_cast<int64_t>(beam_indices.size()));
+    auto block_size_per_beam = onnxruntime::narrow<size_t>(past_shape[1] * past_shape[2] * past_shape[3]);
+
+    gsl::span<T> present_span = gsl::make_span<T>(const_cast<T*>(present.Get<Tensor>().Data<T>()),
+                                                  onnxruntime::narrow<size_t>(past_shape.Size()));
+    ReorderBeamsInPlace<T>(present_span, beam_indices, block_size_per_beam, allocator);
 
-    next_inputs[t5_decoder_first_past_input_idx + i] = past;
+    next_inputs[t5_decoder_first_past_input_idx + i] = present;
   }
 }
 
@@ -0,0 +1,269 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/transformers/gpt_prefix_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "core/common/parse_string.h"
+#include "core/common/safeint.h"
+#include "core/framework/config_options.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensor.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+namespace {
+
+bool IsCpuTensor(const OrtValue& value) {
+  return value.IsAllocated() && value.IsTensor() &&
+         value.Get<Tensor>().Location().device.Type() == OrtDevice::CPU;
+}
+
+// Copies the positions [offset, offset + length) of each row of a (batch_beam_size, sequence_length) tensor.
+OrtValue CutRows(const OrtValue& value, int64_t offset, int64_t length, const AllocatorPtr& allocator) {
+  const Tensor& tensor = value.Get<Tensor>();
+  const int64_t batch_beam_size = tensor.Shape()[0];
+  const int64_t sequence_length = tensor.Shape()[1];
+
+  OrtValue result;
+  Tensor::InitOrtValue(tensor.DataType(), TensorShape{batch_beam_size, length}, allocator, result);
+  const int32_t* src = tensor.Data<int32_t>();
+  int32_t* dst = result.GetMutable<Tensor>()->MutableData<int32_t>();
+  for (int64_t row = 0; row < batch_beam_size; ++row) {
+    std::copy_n(src + row * sequence_length + offset, length, dst + row * length);
+  }
+
+  return result;
+}
+
+}  // namespace
+
+GptPrefixCache::GptPrefixCache(size_t capacity) : capacity_(capacity) {
+  ORT_ENFORCE(capacity_ > 0, "The capacity of the GPT prefix cache must be positive.");
+}
+
+std::shared_ptr<GptPrefixCache> GptPrefixCache::Create(const ConfigOptions& config_options) {
+  const std::string capacity_str = config_options.GetConfigOrDefault(kOrtSessionOptionsConfigGptPrefixCacheSize, "0");
+  size_t capacity = 0;
+  ORT_ENFORCE(TryParseStringWithClassicLocale<size_t>(capacity_str, capacity),
+              "Invalid value for ", kOrtSessionOptionsConfigGptPrefixCacheSize, ": ", capacity_str);
+  return capacity > 0 ? std::make_shared<GptPrefixCache>(capacity) : nullptr;
+}
+
+bool GptPrefixCache::CanUse(gsl::span<const OrtValue> feeds, int first_past_input_index, int num_layers) {
+  const size_t end = static_cast<size_t>(first_past_input_index) + static_cast<size_t>(num_layers);
+  if (feeds.size() < end ||
+      !std::all_of(feeds.begin(), feeds.begin() + end, [](const OrtValue& value) { return IsCpuTensor(value); })) {
+    return false;
+  }
+
+  // the past state of the first run is empty unless the subgraph shares the past and present buffers
+  for (size_t i = static_cast<size_t>(first_past_input_index); i < end; ++i) {
+    const auto& past_shape = feeds[i].Get<Tensor>().Shape();
+    if (past_shape.NumDimensions() != 5 || past_shape[3] != 0) {
+      return false;
+    }
+  }
+
+  // cached past state is keyed on token positions, which padding shifts
+  auto attention_mask = feeds[2].Get<Tensor>().DataAsSpan<int32_t>();
+  return std::all_of(attention_mask.begin(), attention_mask.end(), [](int32_t mask) { return mask == 1; });
+}
+
+std::vector<uint32_t> GptPrefixCache::BlockHashes(gsl::span<const int32_t> tokens) {
+  const size_t num_blocks = tokens.size() / kBlockSize;
+  std::vector<uint32_t> hashes;
+  hashes.reserve(num_blocks);
+
+  uint32_t hash = 0;
+  for (size_t i = 0; i < num_blocks; ++i) {
+    MurmurHash3::x86_32(tokens.data() + i * kBlockSize, static_cast<int>(kBlockSize * sizeof(int32_t)), hash, &hash);
+    hashes.push_back(hash);
+  }
+
+  return hashes;
+}
+
+std::list<GptPrefixCache::Entry>::iterator GptPrefixCache::FindLongestPrefix(gsl::span<const int32_t> tokens,
+                                                                             gsl::span<const uint32_t> hashes,
+                                                                             size_t max_length,
+                                                                             size_t& prefix_length) {
+  for (size_t i = hashes.size(); i-- > 0;) {
+    auto it = index_.find(hashes[i]);
+    if (it == index_.end()) {
+      continue;
+    }
+
+    const auto& cached_tokens = it->second->tokens;
+    size_t length = (i + 1) * kBlockSize;
+    if (cached_tokens.size() < length || !std::equal(tokens.begin(), tokens.begin() + length, cached_tokens.begin())) {
+      continue;
+    }
+
+    const size_t limit = std::min(max_length, cached_tokens.size());
+    while (length < limit && tokens[length] == cached_tokens[length]) {
+      ++length;
+    }
+
+    prefix_length = length;
+    return it->second;
+  }
+
+  return entries_.end();
+}
+
+int GptPrefixCache::ApplyToInitialFeeds(std::vector<OrtValue>& feeds, int first_past_input_index, int num_layers,
+                                        const AllocatorPtr& allocator) {
+  const Tensor& input_ids = feeds[0].Get<Tensor>();
+  const int64_t batch_beam_size = input_ids.Shape()[0];
+  const int64_t sequence_length = input_ids.Shape()[1];
+  if (sequence_length <= static_cast<int64_t>(kBlockSize)) {
+    return 0;
+  }
+
+  // The past state feeds have one length, so the prefix is shared by all the prompts.
+  // At least one token is left for the first run to compute the logits of.
+  auto ids = input_ids.DataAsSpan<int32_t>();
+  auto first_prompt = ids.subspan(0, static_cast<size_t>(sequence_length));
+  size_t max_length = static_cast<size_t>(sequence_length) - 1;
+  for (int64_t row = 1; row < batch_beam_size && max_length >= kBlockSize; ++row) {
+    auto prompt = ids.subspan(static_cast<size_t>(row * sequence_length), static_cast<size_t>(sequence_length));
+    max_length = static_cast<size_t>(
+        std::mismatch(first_prompt.begin(), first_prompt.begin() + max_length, prompt.begin()).first -
+        first_prompt.begin());
+  }
+
+  if (max_length < kBlockSize) {
+    return 0;
+  }
+
+  const auto hashes = BlockHashes(first_prompt.subspan(0, max_length));
+
+  // Share the cached past state under the lock, copy it outside of it.
+  size_t prefix_length = 0;
+  std::vector<OrtValue> cached_past;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = FindLongestPrefix(first_prompt, hashes, max_length, prefix_length);
+    if (it == entries_.end()) {
+      return 0;
+    }
+
+    entries_.splice(entries_.begin(), entries_, it);
+    cached_past = it->past;
+  }
+
+  const int64_t prefix = static_cast<int64_t>(prefix_length);
+  feeds[0] = CutRows(feeds[0], prefix, sequence_length - prefix, allocator);
+  feeds[1] = CutRows(feeds[1], prefix, sequence_length - prefix, allocator);
+
+  for (int layer = 0; layer < num_layers; ++layer) {
+    const Tensor& cached = cached_past[layer].Get<Tensor>();
+    const int64_t num_heads = cached.Shape()[2];
+    const int64_t cached_length = cached.Shape()[3];
+    const int64_t head_size = cached.Shape()[4];
+
+    OrtValue past;
+    Tensor::InitOrtValue(cached.DataType(), TensorShape{2, batch_beam_size, num_heads, prefix, head_size},
+                         allocator, past);
+
+    const size_t element_size = cached.DataType()->Size();
+    const size_t head_bytes = SafeInt<size_t>(prefix) * head_size * element_size;
+    const size_t cached_head_bytes = SafeInt<size_t>(cached_length) * head_size * element_size;
+    const auto* src = static_cast<const char*>(cached.DataRaw());
+    auto* dst = static_cast<char*>(past.GetMutable<Tensor>()->MutableDataRaw());
+    for (int64_t i = 0; i < 2; ++i) {
+      for (int64_t row = 0; row < batch_beam_size; ++row) {
+        for (int64_t head = 0; head < num_heads; ++head) {
+          std::memcpy(dst, src + static_cast<size_t>(i * num_heads + head) * cached_head_bytes, head_bytes);
+          dst += head_bytes;
+        }
+      }
+    }
+
+    feeds[static_cast<size_t>(first_past_input_index) + layer] = std::move(past);
+  }
+
+  return static_cast<int>(prefix_length);
+}
+
+void GptPrefixCache::Insert(gsl::span<const int32_t> prompt, gsl::span<const OrtValue> presents,
+                            const AllocatorPtr& allocator) {
+  if (prompt.size() < kBlockSize ||
+      !std::all_of(presents.begin(), presents.end(), [](const OrtValue& value) { return IsCpuTensor(value); })) {
+    return;
+  }
+
+  Entry entry;
+  entry.keys = BlockHashes(prompt);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t prefix_length = 0;
+    auto it = FindLongestPrefix(prompt, entry.keys, prompt.size(), prefix_length);
+    if (it != entries_.end() && prefix_length == prompt.size()) {
+      entries_.splice(entries_.begin(), entries_, it);
+      return;
+    }
+  }
+
+  entry.tokens.assign(prompt.begin(), prompt.end());
+  entry.past.reserve(presents.size());
+  for (const auto& value : presents) {
+    const Tensor& present = value.Get<Tensor>();
+    const auto& shape = present.Shape();
+    if (shape.NumDimensions() != 5 || shape[0] != 2 || shape[3] != static_cast<int64_t>(prompt.size())) {
+      return;
+    }
+
+    OrtValue past;
+    Tensor::InitOrtValue(present.DataType(), TensorShape{2, 1, shape[2], shape[3], shape[4]}, allocator, past);
+
+    // keep the first row of the key and value halves
+    const size_t row_bytes = SafeInt<size_t>(shape.SizeFromDimension(2)) * present.DataType()->Size();
+    const auto* src = static_cast<const char*>(present.DataRaw());
+    auto* dst = static_cast<char*>(past.GetMutable<Tensor>()->MutableDataRaw());
+    std::memcpy(dst, src, row_bytes);
+    std::memcpy(dst + row_bytes, src + static_cast<size_t>(shape[1]) * row_bytes, row_bytes);
+
+    entry.past.push_back(std::move(past));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (entries_.size() == capacity_) {
+    EvictLeastRecentlyUsed();
+  }
+
+  entries_.push_front(std::move(entry));
+  for (uint32_t key : entries_.front().keys) {
+    // a newer prompt with the same prefix takes over the key
+    index_[key] = entries_.begin();
+  }
+}
+
+void GptPrefixCache::EvictLeastRecentlyUsed() {
+  auto last = std::prev(entries_.end());
+  for (uint32_t key : last->keys) {
+    auto it = index_.find(key);
+    if (it != index_.end() && it->second == last) {
+      index_.erase(it);
+    }
+  }
+
+  entries_.pop_back();
+}
+
+size_t GptPrefixCache::Size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
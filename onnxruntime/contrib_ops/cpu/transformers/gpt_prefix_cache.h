@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+
+namespace onnxruntime {
+struct ConfigOptions;
+
+namespace contrib {
+namespace transformers {
+
+/**
+ * Bounded LRU cache of the past state the GPT subgraph of BeamSearch and GreedySearch computes for prompts, see
+ * kOrtSessionOptionsConfigGptPrefixCacheSize.
+ *
+ * An entry holds the tokens of a prompt and the present_* outputs of the first subgraph run for it. Entries are
+ * indexed by a MurmurHash3 of each prefix of the prompt that is a multiple of kBlockSize tokens long, and a hash
+ * match is confirmed by comparing the tokens. A later prompt that starts with a cached prefix feeds the cached
+ * past state of that prefix and only runs its remaining tokens through the first subgraph run.
+ *
+ * Only unpadded prompts in CPU memory are cached, and the subgraph must not use past_present_share_buffer, in which
+ * the past state of the first run is a buffer of max_length positions.
+ */
+class GptPrefixCache {
+ public:
+  // Prefixes are looked up in blocks of this many tokens, a match is then extended token by token.
+  static constexpr size_t kBlockSize = 16;
+
+  // `capacity` is the maximum number of entries, it must be positive.
+  explicit GptPrefixCache(size_t capacity);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GptPrefixCache);
+
+  // Returns the cache configured by kOrtSessionOptionsConfigGptPrefixCacheSize, or nullptr if it's disabled.
+  static std::shared_ptr<GptPrefixCache> Create(const ConfigOptions& config_options);
+
+  // Returns whether the feeds of the first subgraph run, created by GptSubgraph::CreateInitialFeeds, can use the
+  // cache: they are in CPU memory and the attention mask has no padding.
+  static bool CanUse(gsl::span<const OrtValue> feeds, int first_past_input_index, int num_layers);
+
+  // If all the prompts in `feeds` start with the same cached prefix, cuts the longest one that leaves at least one
+  // token of the prompts from the input_ids and position_ids feeds, and replaces the empty past state feeds with
+  // the cached ones of the prefix. Returns the length of the prefix, 0 if none was found. Thread safe.
+  int ApplyToInitialFeeds(std::vector<OrtValue>& feeds, int first_past_input_index, int num_layers,
+                          const AllocatorPtr& allocator);
+
+  // Caches the present_* outputs of the first subgraph run for `prompt`, the tokens of the first row of its
+  // input_ids before ApplyToInitialFeeds. Only the first row of `presents` is stored. Prompts shorter than
+  // kBlockSize tokens or already cached are not inserted. Thread safe.
+  void Insert(gsl::span<const int32_t> prompt, gsl::span<const OrtValue> presents, const AllocatorPtr& allocator);
+
+  size_t Size() const;
+
+ private:
+  struct Entry {
+    std::vector<int32_t> tokens;
+    std::vector<uint32_t> keys;  // hash of the first (i + 1) * kBlockSize tokens
+    std::vector<OrtValue> past;  // per layer, shape (2, 1, num_heads, tokens.size(), head_size)
+  };
+
+  static std::vector<uint32_t> BlockHashes(gsl::span<const int32_t> tokens);
+
+  // Returns the entry sharing the longest prefix of at most `max_length` tokens with `tokens` and the length of the
+  // prefix, or entries_.end(). `hashes` are the BlockHashes of the first `max_length` tokens.
+  // Must be called with mutex_ held.
+  std::list<Entry>::iterator FindLongestPrefix(gsl::span<const int32_t> tokens, gsl::span<const uint32_t> hashes,
+                                               size_t max_length, size_t& prefix_length);
+
+  void EvictLeastRecentlyUsed();
+
+  const size_t capacity_;
+
+  mutable std::mutex mutex_;
+  std::list<Entry> entries_;  // most recently used first
+  InlinedHashMap<uint32_t, std::list<Entry>::iterator> index_;
+};
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -21,6 +21,8 @@ namespace transformers {
 
 using namespace onnxruntime::controlflow;  // namespace of IControlFlowKernel
 
+class GptPrefixCache;
+
 class GreedySearch : public IControlFlowKernel {
  public:
   explicit GreedySearch(const OpKernelInfo& info)
@@ -113,6 +115,10 @@ class GreedySearch : public IControlFlowKernel {
   std::unique_ptr<GptSubgraph> init_run_gpt_subgraph_;
   std::unique_ptr<GptSubgraph> gpt_subgraph_;
 
+  // Past state of the GPT subgraph for prompts of earlier runs, nullptr if kOrtSessionOptionsConfigGptPrefixCacheSize
+  // is not set.
+  std::shared_ptr<GptPrefixCache> gpt_prefix_cache_;
+
   // Relevant only for T5
   // Same concept as above.
   // The encoder will be used for the first run and the decoder will
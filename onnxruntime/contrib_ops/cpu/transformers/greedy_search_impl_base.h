@@ -2,10 +2,12 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <algorithm>
 #include <random>
 #include <vector>
 #include "contrib_ops/cpu/transformers/generation_shared.h"
 #include "contrib_ops/cpu/transformers/generate_impl_base.h"
+#include "contrib_ops/cpu/transformers/stop_string_detector.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -49,7 +51,7 @@ struct SamplingState : public ISamplingState<T> {
       }
     } else {
       // TODO: Some buffer can be reused for CPU
-      this->sorted_scores = AllocateBuffer<T>(cpu_allocator, sorted_scores_buffer_, SafeInt<size_t>(total_count), stream);
+      this->sorted_indices = AllocateBuffer<size_t>(cpu_allocator, sorted_indices_buffer_, SafeInt<size_t>(total_count), stream);
       this->cumulative_probs = AllocateBuffer<T>(cpu_allocator, cumulative_probs_buffer_, SafeInt<size_t>(total_count), stream);
     }
   }
@@ -66,7 +68,7 @@ struct SamplingState : public ISamplingState<T> {
   IAllocatorUniquePtr<void> h_sampled_all_buffer_;
   IAllocatorUniquePtr<void> d_indices_buffer_;
   IAllocatorUniquePtr<void> d_presence_mask_buffer_;
-  IAllocatorUniquePtr<void> sorted_scores_buffer_;
+  IAllocatorUniquePtr<void> sorted_indices_buffer_;
   IAllocatorUniquePtr<void> cumulative_probs_buffer_;
 };
 
@@ -201,6 +203,9 @@ class GreedySearchBase : public GenerateBase {
 
   ParametersT* parameters_;
 
+  // Ends a sequence when its text ends with one of the optional stop strings of GreedySearch.
+  StopStringDetector stop_string_detector_;
+
   // Device specific functions
   GenerationDeviceHelper::GreedySearchProcessLogitsFunc<T> process_logits_func_;
 };
@@ -211,12 +216,15 @@ Status GreedySearchBase<T, ParametersT>::CheckInputs(const OpKernelContextIntern
   //   input_ids          : (batch_size, sequence_length)
   //   vocab_mask         : (vocab_size) or nullptr
   //   decoder_input_ids  : (batch_size, initial_decode_sequence_length)
+  // Input 7 is presence_mask of Sampling, and vocab of GreedySearch.
+  constexpr bool is_sampling = std::is_same<ParametersT, SamplingParameters>::value;
+  const Tensor* presence_mask = is_sampling ? context.Input<Tensor>(7) : nullptr;
   ORT_RETURN_IF_ERROR(this->CheckInputsImpl(parameters_,
                                             context.Input<Tensor>(0),     // input_ids
                                             context.Input<Tensor>(4),     // vocab_mask
                                             context.Input<Tensor>(5),     // prefix_vocab_mask
                                             context.Input<Tensor>(6),     // attention_mask
-                                            context.Input<Tensor>(7),     // presence_mask
+                                            presence_mask,
                                             context.Input<Tensor>(10)));  // decoder_input_ids
 
   return Status::OK();
@@ -240,6 +248,20 @@ Status GreedySearchBase<T, ParametersT>::Initialize() {
     this->logits_processors_.Init(*parameters_);
   }
 
+  if constexpr (!std::is_same<ParametersT, SamplingParameters>::value) {
+    const Tensor* vocab = this->context_.Input<Tensor>(7);
+    const Tensor* stop_strings = this->context_.Input<Tensor>(8);
+    if (stop_strings != nullptr) {
+      if (vocab == nullptr) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "Input 'vocab' is required when input 'stop_strings' is provided.");
+      }
+      ORT_RETURN_IF_ERROR(stop_string_detector_.Init(vocab->DataAsSpan<std::string>(),
+                                                     stop_strings->DataAsSpan<std::string>(),
+                                                     parameters_->batch_size));
+    }
+  }
+
   return Status::OK();
 }
 
@@ -273,11 +295,25 @@ Status GreedySearchBase<T, ParametersT>::GenerateNextToken(
     if (next_tokens[batch_id] == eos_token_id || eos_meet[batch_id] == true) {
       eos_meet[batch_id] = true;
       next_tokens[batch_id] = parameters_->pad_token_id;
+    } else if (stop_string_detector_.IsEnabled() && stop_string_detector_.Append(batch_id, next_tokens[batch_id])) {
+      // the token that completes a stop string is kept, and the sequence ends after it
+      eos_meet[batch_id] = true;
     }
   }
 
   greedy_state.sequences.AppendNextTokenToSequences(next_tokens);
 
+  // Stream the tokens to the callback of the run, which may end the generation of all the sequences.
+  const RunOptions* run_options = this->context_.GetRunOptions();
+  if (run_options != nullptr && run_options->generation_step_callback != nullptr) {
+    const int stop = run_options->generation_step_callback(run_options->generation_step_callback_user_data,
+                                                           next_tokens.data(), eos_meet.data(), next_tokens.size(),
+                                                           static_cast<size_t>(counter - 1));
+    if (stop != 0) {
+      std::fill(eos_meet.begin(), eos_meet.end(), true);
+    }
+  }
+
 #ifdef DEBUG_GENERATION
   greedy_state.sequences.PrintSequences(&cpu_dumper_);
 #endif
@@ -7,6 +7,7 @@
 
 #include "core/common/span_utils.h"
 #include "contrib_ops/cpu/transformers/greedy_search_impl_base.h"
+#include "contrib_ops/cpu/transformers/gpt_prefix_cache.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -79,6 +80,11 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
   }
 #endif
 
+  // Use `prefix_cache` for the past state of the prompts, it may be nullptr.
+  void SetPrefixCache(GptPrefixCache* prefix_cache) {
+    prefix_cache_ = prefix_cache;
+  }
+
   // Execute beam search in iterations util stopping criteria is reached.
   // In each iteration, GPT subgraph is called, and next token for each sequence is generated.
   Status Execute(const FeedsFetchesManager* init_run_feeds_fetches_manager,
@@ -116,6 +122,8 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
 
   const void* cuda_device_prop_ = nullptr;
   int cuda_device_arch_ = 0;
+
+  GptPrefixCache* prefix_cache_ = nullptr;
 };
 
 template <typename T, typename ParametersT>
@@ -230,6 +238,20 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
   OrtValue expanded_input_ids_in_cpu;
   ORT_RETURN_IF_ERROR(CreateInitialFeeds(greedy_state.sequence_lengths, expanded_input_ids_in_cpu, feeds, buffer));
 
+  // Prompts of the first run cached after it, empty when the prefix cache isn't used.
+  gsl::span<const int32_t> prompt_to_cache;
+  if (prefix_cache_ != nullptr && !this->IsCuda() && !gpt_subgraph_.past_present_share_buffer_ &&
+      GptPrefixCache::CanUse(feeds, gpt_subgraph_.GetFirstPastInputIndex(), gpt_subgraph_.num_layers)) {
+    prompt_to_cache = expanded_input_ids_in_cpu.Get<Tensor>().DataAsSpan<int32_t>().subspan(
+        0, static_cast<size_t>(parameters->sequence_length));
+    const int prefix_length = prefix_cache_->ApplyToInitialFeeds(feeds, gpt_subgraph_.GetFirstPastInputIndex(),
+                                                                 gpt_subgraph_.num_layers, this->cpu_allocator_);
+    if (prefix_length > 0) {
+      LOGS(this->context_.Logger(), VERBOSE) << "Reusing the cached past state of " << prefix_length
+                                             << " prompt tokens.";
+    }
+  }
+
   if (gpt_subgraph_.past_present_share_buffer_) {  // Reuse past and present
     fetches.reserve(static_cast<size_t>(gpt_subgraph_.GetFirstPresentOutputIndex()) + gpt_subgraph_.num_layers);
     fetches.resize(gpt_subgraph_.GetFirstPresentOutputIndex(), OrtValue());
@@ -312,6 +334,14 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
 
     ORT_RETURN_IF_ERROR(status);
 
+    if (iteration_counter == 1 && !prompt_to_cache.empty()) {
+      prefix_cache_->Insert(prompt_to_cache,
+                            gsl::make_span(fetches).subspan(
+                                static_cast<size_t>(gpt_subgraph_.GetFirstPresentOutputIndex()),
+                                static_cast<size_t>(gpt_subgraph_.num_layers)),
+                            this->cpu_allocator_);
+    }
+
     const OrtValue& logits = fetches[0];
     gsl::span<int32_t> next_tokens;
 
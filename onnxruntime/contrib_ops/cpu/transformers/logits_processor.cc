@@ -37,24 +37,28 @@ RepetitionPenaltyLogitsProcessor<T>::RepetitionPenaltyLogitsProcessor(float pena
 template <typename T>
 void RepetitionPenaltyLogitsProcessor<T>::Process(const ISequences* sequences,
                                                   NextTokenScores<T>& next_token_scores) {
-  const int batch_beam_size = next_token_scores.batch_beam_size;
-  for (int i = 0; i < batch_beam_size; i++) {
-    gsl::span<T> beam_token_scores = next_token_scores.GetScores(i);
-    gsl::span<const int32_t> sequence = sequences->GetSequence(i);
-
-    // Find unique word IDs in sequence.
-    std::unordered_set<int32_t> unique_word_ids;
-    for (const auto& word_id : sequence) {
-      unique_word_ids.insert(word_id);
-    }
+  for (int i = 0; i < next_token_scores.batch_beam_size; i++) {
+    ProcessBeam(sequences, i, next_token_scores.GetScores(i));
+  }
+}
 
-    for (const int32_t word_id : unique_word_ids) {
-      T score = beam_token_scores[word_id];
+template <typename T>
+void RepetitionPenaltyLogitsProcessor<T>::ProcessBeam(const ISequences* sequences, int batch_beam_index,
+                                                      gsl::span<T> beam_token_scores) {
+  gsl::span<const int32_t> sequence = sequences->GetSequence(batch_beam_index);
+
+  // Find unique word IDs in sequence.
+  std::unordered_set<int32_t> unique_word_ids;
+  for (const auto& word_id : sequence) {
+    unique_word_ids.insert(word_id);
+  }
 
-      // If score < 0, then repetition penalty > 1.0 has to multiplied to reduce the previous token probability,
-      // This assumes that scores are either positive (like ctrl) or negative (like GPT-2), but not a mixture.
-      beam_token_scores[word_id] = (score < 0 ? score * penalty_ : score / penalty_);
-    }
+  for (const int32_t word_id : unique_word_ids) {
+    T score = beam_token_scores[word_id];
+
+    // If score < 0, then repetition penalty > 1.0 has to multiplied to reduce the previous token probability,
+    // This assumes that scores are either positive (like ctrl) or negative (like GPT-2), but not a mixture.
+    beam_token_scores[word_id] = (score < 0 ? score * penalty_ : score / penalty_);
   }
 }
 
@@ -65,33 +69,36 @@ NoRepeatNGramLogitsProcessor<T>::NoRepeatNGramLogitsProcessor(int ngram_size) :
 template <typename T>
 void NoRepeatNGramLogitsProcessor<T>::Process(const ISequences* sequences,
                                               NextTokenScores<T>& next_token_scores) {
+  for (int i = 0; i < next_token_scores.batch_beam_size; i++) {
+    ProcessBeam(sequences, i, next_token_scores.GetScores(i));
+  }
+}
+
+template <typename T>
+void NoRepeatNGramLogitsProcessor<T>::ProcessBeam(const ISequences* sequences, int batch_beam_index,
+                                                  gsl::span<T> beam_token_scores) {
   if (ngram_size_ == 0 || ngram_size_ > sequences->GetSequenceLength()) {
     return;
   }
 
   const gsl::index prefix_length = static_cast<gsl::index>(ngram_size_) - 1;
-  int batch_beam_size = next_token_scores.batch_beam_size;
-
-  for (int i = 0; i < batch_beam_size; i++) {
-    gsl::span<T> beam_token_scores = next_token_scores.GetScores(i);
-    gsl::span<const int32_t> sequence = sequences->GetSequence(i);
-
-    gsl::span<const int32_t> prefix = sequence.subspan(sequence.size() - prefix_length);
-    ORT_ENFORCE(prefix.size() == narrow<size_t>(prefix_length));
-
-    std::unordered_set<int32_t> blocked_word_ids;
-    for (int j = 0; j <= static_cast<int>(sequence.size()) - ngram_size_; j++) {
-      // Here we use naive algorithm for matching. The complexity is O(batch_beam_size * ngram_size * sequence_length)
-      // TODO(tianleiwu): build N-Gram index (hash table with prefix of length NGram - 1 as key,
-      //                  and list of last word of NGram as value) for fast matching.
-      if (ngram_size_ == 1 || SpanEq(prefix, sequence.subspan(j, prefix_length))) {
-        blocked_word_ids.insert(sequence[static_cast<gsl::index>(j) + prefix_length]);
-      }
+  gsl::span<const int32_t> sequence = sequences->GetSequence(batch_beam_index);
+
+  gsl::span<const int32_t> prefix = sequence.subspan(sequence.size() - prefix_length);
+  ORT_ENFORCE(prefix.size() == narrow<size_t>(prefix_length));
+
+  std::unordered_set<int32_t> blocked_word_ids;
+  for (int j = 0; j <= static_cast<int>(sequence.size()) - ngram_size_; j++) {
+    // Here we use naive algorithm for matching. The complexity is O(batch_beam_size * ngram_size * sequence_length)
+    // TODO(tianleiwu): build N-Gram index (hash table with prefix of length NGram - 1 as key,
+    //                  and list of last word of NGram as value) for fast matching.
+    if (ngram_size_ == 1 || SpanEq(prefix, sequence.subspan(j, prefix_length))) {
+      blocked_word_ids.insert(sequence[static_cast<gsl::index>(j) + prefix_length]);
     }
+  }
 
-    for (const int32_t word_id : blocked_word_ids) {
-      beam_token_scores[word_id] = std::numeric_limits<T>::lowest();
-    }
+  for (const int32_t word_id : blocked_word_ids) {
+    beam_token_scores[word_id] = std::numeric_limits<T>::lowest();
   }
 }
 
@@ -183,7 +190,7 @@ void PresencePenaltyLogitsProcessor<T>::Process(const ISequences*,
   assert(!presence_mask_.empty());
 
   T* p = next_token_scores.scores.data();
-  for (size_t i = 0; i < next_token_scores.scores.size(); i++) {
+  for (size_t i = 0; i < next_token_scores.scores.size(); i++, p++) {
     *p -= presence_mask_[i] * presence_penalty_;
   }
 }
@@ -204,12 +211,55 @@ void LogitsProcessorList::Process(const ISequences* sequences,
                                   gsl::span<float>& next_token_scores,
                                   int step) {
   NextTokenScores<float> input_scores = {next_token_scores, batch_beam_size_, vocab_size_};
-  for (size_t i = 0; i < processor_list_.size(); i++) {
-    // Prefix vocab mask is applied to first iteration only.
-    if (step > 1 && processor_list_[i] == prefix_vocab_mask_processor_.get()) {
-      continue;
+
+  const int32_t* vocab_mask = vocab_mask_.empty() ? nullptr : vocab_mask_.data();
+  // Prefix vocab mask is applied to first iteration only.
+  const bool apply_prefix_vocab_mask = step <= 1 && !prefix_vocab_mask_.empty();
+  const int disabled_eos_token_id = (min_length_ > 0 && sequences->GetSequenceLength() < min_length_)
+                                        ? eos_token_id_
+                                        : -1;
+  const bool apply_presence_penalty = !presence_mask_.empty() && presence_penalty_ != 0.0f;
+  const bool sweep = vocab_mask != nullptr || apply_prefix_vocab_mask || disabled_eos_token_id >= 0 ||
+                     temperature_ != 1.0f || apply_presence_penalty;
+
+  for (int i = 0; i < batch_beam_size_; i++) {
+    gsl::span<float> beam_token_scores = input_scores.GetScores(i);
+
+    if (repetition_penalty_processor_) {
+      repetition_penalty_processor_->ProcessBeam(sequences, i, beam_token_scores);
+    }
+
+    if (no_repeat_ngram_processor_) {
+      no_repeat_ngram_processor_->ProcessBeam(sequences, i, beam_token_scores);
+    }
+
+    if (sweep) {
+      const size_t batch_offset = SafeInt<size_t>(i / num_beams_) * vocab_size_;
+      const int32_t* prefix_vocab_mask = apply_prefix_vocab_mask ? prefix_vocab_mask_.data() + batch_offset : nullptr;
+      const int32_t* presence_mask = apply_presence_penalty ? presence_mask_.data() + batch_offset : nullptr;
+
+      float* scores = beam_token_scores.data();
+      for (int j = 0; j < vocab_size_; j++) {
+        float score = scores[j];
+        if ((vocab_mask != nullptr && vocab_mask[j] == 0) ||
+            (prefix_vocab_mask != nullptr && prefix_vocab_mask[j] == 0) ||
+            j == disabled_eos_token_id) {
+          score = std::numeric_limits<float>::lowest();
+        }
+
+        score /= temperature_;
+
+        if (presence_mask != nullptr) {
+          score -= presence_mask[j] * presence_penalty_;
+        }
+
+        scores[j] = score;
+      }
+    }
+
+    if (timestamp_processor_) {
+      timestamp_processor_->ProcessBeam(sequences, i, beam_token_scores);
     }
-    processor_list_[i]->Process(sequences, input_scores);
   }
 }
 
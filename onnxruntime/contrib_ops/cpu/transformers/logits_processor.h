@@ -74,6 +74,9 @@ class RepetitionPenaltyLogitsProcessor : public ILogitsProcessor<T> {
   void Process(const ISequences* sequences,
                NextTokenScores<T>& next_token_scores) override;
 
+  // Processes the scores of one beam, Process does it for every beam.
+  void ProcessBeam(const ISequences* sequences, int batch_beam_index, gsl::span<T> beam_token_scores);
+
  private:
   float penalty_;
 };
@@ -86,6 +89,9 @@ class NoRepeatNGramLogitsProcessor : public ILogitsProcessor<T> {
   void Process(const ISequences* sequences,
                NextTokenScores<T>& next_token_scores) override;
 
+  // Processes the scores of one beam, Process does it for every beam.
+  void ProcessBeam(const ISequences* sequences, int batch_beam_index, gsl::span<T> beam_token_scores);
+
  private:
   int ngram_size_;
 };
@@ -178,106 +184,109 @@ class TimestampLogitsProcessor : public ILogitsProcessor<T> {
 
   void Process(const ISequences* sequences,
                NextTokenScores<T>& next_token_scores) override {
-    const int batch_beam_size = next_token_scores.batch_beam_size;
-    const int vocab_size = next_token_scores.vocab_size;
-    for (int i = 0; i < batch_beam_size; i++) {
-      gsl::span<T> beam_token_scores = next_token_scores.GetScores(i);
-      gsl::span<const int32_t> sequence = sequences->GetSequence(i);
-      const size_t seq_length = sequence.size();
-
-      // Find first timestamp
-      size_t sample_begin = 0;
-      for (size_t j = 0; j < seq_length; j++) {
-        sample_begin++;
-        if (sequence[j] >= beginning_timestamp_token_id_) {
-          break;
-        }
+    for (int i = 0; i < next_token_scores.batch_beam_size; i++) {
+      ProcessBeam(sequences, i, next_token_scores.GetScores(i));
+    }
+  }
+
+  // Processes the scores of one beam, Process does it for every beam.
+  void ProcessBeam(const ISequences* sequences, int batch_beam_index, gsl::span<T> beam_token_scores) {
+    const int vocab_size = static_cast<int>(beam_token_scores.size());
+    gsl::span<const int32_t> sequence = sequences->GetSequence(batch_beam_index);
+    const size_t seq_length = sequence.size();
+
+    // Find first timestamp
+    size_t sample_begin = 0;
+    for (size_t j = 0; j < seq_length; j++) {
+      sample_begin++;
+      if (sequence[j] >= beginning_timestamp_token_id_) {
+        break;
       }
+    }
 
-      // Suppress tokens
-      for (int j = 0; j < vocab_size; j++) {
-        // Suppress notimestamps and solm tokens
-        if (j == no_timestamps_token_id_ || j == start_of_lm_token_id_) {
-          beam_token_scores[j] = std::numeric_limits<T>::lowest();
-        }
+    // Suppress tokens
+    for (int j = 0; j < vocab_size; j++) {
+      // Suppress notimestamps and solm tokens
+      if (j == no_timestamps_token_id_ || j == start_of_lm_token_id_) {
+        beam_token_scores[j] = std::numeric_limits<T>::lowest();
+      }
 
-        // Suppress sot, translate and transcribe tokens
-        if (seq_length > sample_begin) {
-          if (j == start_of_transcript_token_id_ || j == translate_token_id_ || j == transcribe_token_id_) {
-            beam_token_scores[j] = std::numeric_limits<T>::lowest();
-          }
+      // Suppress sot, translate and transcribe tokens
+      if (seq_length > sample_begin) {
+        if (j == start_of_transcript_token_id_ || j == translate_token_id_ || j == transcribe_token_id_) {
+          beam_token_scores[j] = std::numeric_limits<T>::lowest();
         }
       }
+    }
 
-      // Timestamps should be in pair except the first one
-      const bool last_was_timestamp = seq_length > 0 && sequence.back() >= beginning_timestamp_token_id_;
-      const bool penultimate_was_timestamp = seq_length <= sample_begin || sequence[seq_length - 2] >= beginning_timestamp_token_id_;
-      if (last_was_timestamp) {
-        if (penultimate_was_timestamp) {
-          // If timestamps show up in pair, or it's the first timestamp, no more timestamp is generated
-          for (int j = beginning_timestamp_token_id_; j < vocab_size; j++) {
-            beam_token_scores[j] = std::numeric_limits<T>::lowest();
-          }
-        } else {
-          // If timestamp doesn't show up in pair, generate timestamp
-          for (int j = 0; j < end_of_text_token_id_; j++) {
-            beam_token_scores[j] = std::numeric_limits<T>::lowest();
-          }
+    // Timestamps should be in pair except the first one
+    const bool last_was_timestamp = seq_length > 0 && sequence.back() >= beginning_timestamp_token_id_;
+    const bool penultimate_was_timestamp = seq_length <= sample_begin || sequence[seq_length - 2] >= beginning_timestamp_token_id_;
+    if (last_was_timestamp) {
+      if (penultimate_was_timestamp) {
+        // If timestamps show up in pair, or it's the first timestamp, no more timestamp is generated
+        for (int j = beginning_timestamp_token_id_; j < vocab_size; j++) {
+          beam_token_scores[j] = std::numeric_limits<T>::lowest();
+        }
+      } else {
+        // If timestamp doesn't show up in pair, generate timestamp
+        for (int j = 0; j < end_of_text_token_id_; j++) {
+          beam_token_scores[j] = std::numeric_limits<T>::lowest();
         }
       }
+    }
 
-      // Find timestamp tokens
-      std::vector<int32_t> timestamps;
-      for (const auto& word_id : sequence) {
-        if (word_id >= beginning_timestamp_token_id_) {
-          timestamps.push_back(word_id);
-        }
+    // Find timestamp tokens
+    std::vector<int32_t> timestamps;
+    for (const auto& word_id : sequence) {
+      if (word_id >= beginning_timestamp_token_id_) {
+        timestamps.push_back(word_id);
       }
+    }
 
-      // Timestamps will not decrease
-      const size_t timestamps_len = timestamps.size();
-      if (timestamps_len > 0) {
-        int timestamp_last = 0;
-        if (last_was_timestamp && !penultimate_was_timestamp) {
-          // For single timestamp at the end, next timestamp must not be smaller
-          timestamp_last = timestamps.back();
-        } else {
-          // For paired timestamp at the end, next timestamp must be greater
-          timestamp_last = timestamps.back() + 1;
-        }
+    // Timestamps will not decrease
+    const size_t timestamps_len = timestamps.size();
+    if (timestamps_len > 0) {
+      int timestamp_last = 0;
+      if (last_was_timestamp && !penultimate_was_timestamp) {
+        // For single timestamp at the end, next timestamp must not be smaller
+        timestamp_last = timestamps.back();
+      } else {
+        // For paired timestamp at the end, next timestamp must be greater
+        timestamp_last = timestamps.back() + 1;
+      }
 
-        for (int j = beginning_timestamp_token_id_; j < timestamp_last; j++) {
-          beam_token_scores[j] = std::numeric_limits<T>::lowest();
-        }
+      for (int j = beginning_timestamp_token_id_; j < timestamp_last; j++) {
+        beam_token_scores[j] = std::numeric_limits<T>::lowest();
       }
+    }
 
-      if (seq_length == sample_begin) {
-        const int last_allowed = beginning_timestamp_token_id_ + max_initial_timestamp_index_;
-        for (int j = last_allowed + 1; j < vocab_size; j++) {
-          beam_token_scores[j] = std::numeric_limits<T>::lowest();
-        }
+    if (seq_length == sample_begin) {
+      const int last_allowed = beginning_timestamp_token_id_ + max_initial_timestamp_index_;
+      for (int j = last_allowed + 1; j < vocab_size; j++) {
+        beam_token_scores[j] = std::numeric_limits<T>::lowest();
       }
+    }
 
-      // Caculate logsumexp on timestamps
-      float timestamp_logprob = std::numeric_limits<T>::lowest();
-      {
-        float logsumexp = 0.0f;
-        const float logprob_max = *std::max_element(beam_token_scores.begin() + beginning_timestamp_token_id_, beam_token_scores.end());
-        for (int j = beginning_timestamp_token_id_; j < vocab_size; ++j) {
-          if (beam_token_scores[j] > std::numeric_limits<T>::lowest()) {
-            logsumexp += expf(beam_token_scores[j] - logprob_max);
-          }
-        }
-        if (logsumexp > 0.0f) {
-          timestamp_logprob = logf(logsumexp) + logprob_max;
+    // Caculate logsumexp on timestamps
+    float timestamp_logprob = std::numeric_limits<T>::lowest();
+    {
+      float logsumexp = 0.0f;
+      const float logprob_max = *std::max_element(beam_token_scores.begin() + beginning_timestamp_token_id_, beam_token_scores.end());
+      for (int j = beginning_timestamp_token_id_; j < vocab_size; ++j) {
+        if (beam_token_scores[j] > std::numeric_limits<T>::lowest()) {
+          logsumexp += expf(beam_token_scores[j] - logprob_max);
         }
       }
+      if (logsumexp > 0.0f) {
+        timestamp_logprob = logf(logsumexp) + logprob_max;
+      }
+    }
 
-      const float max_text_token_logprob = *std::max_element(beam_token_scores.begin(), beam_token_scores.begin() + beginning_timestamp_token_id_);
-      if (timestamp_logprob > max_text_token_logprob) {
-        for (int j = 0; j < beginning_timestamp_token_id_; ++j) {
-          beam_token_scores[j] = std::numeric_limits<T>::lowest();
-        }
+    const float max_text_token_logprob = *std::max_element(beam_token_scores.begin(), beam_token_scores.begin() + beginning_timestamp_token_id_);
+    if (timestamp_logprob > max_text_token_logprob) {
+      for (int j = 0; j < beginning_timestamp_token_id_; ++j) {
+        beam_token_scores[j] = std::numeric_limits<T>::lowest();
       }
     }
   }
@@ -293,6 +302,11 @@ class TimestampLogitsProcessor : public ILogitsProcessor<T> {
   int max_initial_timestamp_index_;
 };
 
+// Applies the logits processors enabled by the generation parameters to the scores of each beam in one pass:
+// the processors that depend on the sequence of the beam are applied to the scores of the beam first, then the
+// vocabulary masks, the minimum length, the temperature and the presence penalty, which only depend on the token
+// and the beam, are applied in a single sweep of the scores. The processors are applied in the same order as when
+// each of them processes all the scores in turn.
 class LogitsProcessorList : public ILogitsProcessorList {
  public:
   LogitsProcessorList() = default;
@@ -304,51 +318,28 @@ class LogitsProcessorList : public ILogitsProcessorList {
  private:
   template <typename GenerationParametersT>
   void LogitsProcessorInitImpl(const GenerationParametersT& parameters) {
-    processor_list_.clear();
-
+    repetition_penalty_processor_.reset();
     if (parameters.repetition_penalty != 1.0f) {  // 1.0 means no penalty
       repetition_penalty_processor_ = std::make_unique<RepetitionPenaltyLogitsProcessor<float>>(
           parameters.repetition_penalty);
-      processor_list_.push_back(repetition_penalty_processor_.get());
     }
 
+    no_repeat_ngram_processor_.reset();
     if (parameters.no_repeat_ngram_size > 0) {
       no_repeat_ngram_processor_ = std::make_unique<
           NoRepeatNGramLogitsProcessor<float>>(parameters.no_repeat_ngram_size);
-      processor_list_.push_back(no_repeat_ngram_processor_.get());
     }
 
-    if (!parameters.vocab_mask.empty()) {
-      vocab_mask_processor_ = std::make_unique<VocabMaskLogitsProcessor<float>>(parameters.vocab_mask);
-      processor_list_.push_back(vocab_mask_processor_.get());
-    }
-
-    if (!parameters.prefix_vocab_mask.empty()) {
-      prefix_vocab_mask_processor_ = std::make_unique<
-          PrefixVocabMaskLogitsProcessor<float>>(parameters.prefix_vocab_mask,
-                                                 parameters.batch_size);
-      processor_list_.push_back(prefix_vocab_mask_processor_.get());
-    }
-
-    if (parameters.min_length > 0) {
-      min_length_processor_ = std::make_unique<MinLengthLogitsProcessor<float>>(parameters.min_length,
-                                                                                parameters.eos_token_id);
-      processor_list_.push_back(min_length_processor_.get());
-    }
-
-    if (parameters.temperature > 0) {
-      temperature_processor_ = std::make_unique<TemperatureLogitsProcessor<float>>(parameters.temperature);
-      processor_list_.push_back(temperature_processor_.get());
-    }
-
-    if (!parameters.presence_mask.empty()) {
-      presence_penalty_processor_ = std::make_unique<
-          PresencePenaltyLogitsProcessor<float>>(parameters.presence_mask,
-                                                 parameters.presence_penalty);
-      processor_list_.push_back(presence_penalty_processor_.get());
-    }
+    vocab_mask_ = parameters.vocab_mask;
+    prefix_vocab_mask_ = parameters.prefix_vocab_mask;
+    min_length_ = parameters.min_length;
+    eos_token_id_ = parameters.eos_token_id;
+    temperature_ = parameters.temperature > 0 ? parameters.temperature : 1.0f;
+    presence_mask_ = parameters.presence_mask;
+    presence_penalty_ = parameters.presence_penalty;
 
     // Add timestamp processor for whisper model
+    timestamp_processor_.reset();
     if (parameters.model_type == IGenerationParameters::kModelTypeWhisper && parameters.logits_processor == IGenerationParameters::kLogitsProcessorTypeWhisper) {
       constexpr int max_initial_timestamp_index = 50;
       // Token ids are passed below in the order that they appear in the tokenizer
@@ -360,25 +351,30 @@ class LogitsProcessorList : public ILogitsProcessorList {
                                                                                parameters.no_timestamps_token_id,
                                                                                parameters.beginning_timestamp_token_id,
                                                                                max_initial_timestamp_index);
-      processor_list_.push_back(timestamp_processor_.get());
     }
 
     batch_beam_size_ = parameters.BatchBeamSize();
     vocab_size_ = parameters.vocab_size;
+    num_beams_ = parameters.BatchBeamSize() / parameters.batch_size;
   }
 
   int batch_beam_size_;
   int vocab_size_;
-  InlinedVector<ILogitsProcessor<float>*> processor_list_;
+  int num_beams_;
 
+  // Processors that depend on the sequence of the beam.
   std::unique_ptr<RepetitionPenaltyLogitsProcessor<float>> repetition_penalty_processor_;
   std::unique_ptr<NoRepeatNGramLogitsProcessor<float>> no_repeat_ngram_processor_;
-  std::unique_ptr<VocabMaskLogitsProcessor<float>> vocab_mask_processor_;
-  std::unique_ptr<PrefixVocabMaskLogitsProcessor<float>> prefix_vocab_mask_processor_;
-  std::unique_ptr<MinLengthLogitsProcessor<float>> min_length_processor_;
-  std::unique_ptr<TemperatureLogitsProcessor<float>> temperature_processor_;
-  std::unique_ptr<PresencePenaltyLogitsProcessor<float>> presence_penalty_processor_;
   std::unique_ptr<TimestampLogitsProcessor<float>> timestamp_processor_;
+
+  // Parameters of the processors applied in the sweep of the scores.
+  gsl::span<const int32_t> vocab_mask_;         // shape (vocab_size), tokens with mask value 0 are disabled
+  gsl::span<const int32_t> prefix_vocab_mask_;  // shape (batch_size, vocab_size), only applied in the first step
+  int min_length_ = 0;                          // the eos token is disabled in shorter sequences
+  int eos_token_id_ = -1;
+  float temperature_ = 1.0f;
+  gsl::span<const int32_t> presence_mask_;  // shape (batch_size, vocab_size)
+  float presence_penalty_ = 0.0f;
 };
 
 }  // namespace transformers
@@ -6,52 +6,51 @@ namespace onnxruntime {
 namespace contrib {
 namespace SamplingCpuHelper {
 
+// Tokens of a row are selected in chunks of this many tokens, doubling for every chunk, so only the most probable
+// tokens that top_p keeps and one more chunk are sorted.
+constexpr size_t kTopPFirstChunkSize = 64;
+
+// Moves the indices of the most probable tokens, by decreasing probability, to the beginning of `indices` and
+// returns how many of them top_p sampling keeps. `probs` are the probabilities of the tokens of a row.
+// It keeps the same tokens as sorting the whole row and filtering its cumulative probabilities, i.e. the tokens
+// whose more probable tokens have a total probability below top_p (up to top_p when custom_sampling is set), and
+// at least min_tokens_to_keep tokens (one token when custom_sampling is set).
 template <typename T>
-void filter_scores(std::vector<size_t>& sorted_indice,
-                   gsl::span<T>& next_token_score,
-                   const transformers::IGenerationParameters* parameters,
-                   size_t chunk_offset,
-                   size_t offset) {
-  size_t real_index = sorted_indice[chunk_offset + offset];
-  next_token_score[chunk_offset + real_index] = (T)parameters->filter_value;
-}
-
-template <typename T>
-void cumulate_and_filter_custom(gsl::span<T>& next_token_scores,
-                                gsl::span<T>& cumulative_probs,
-                                const transformers::IGenerationParameters* parameters,
-                                std::vector<size_t>& sorted_indices) {
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    size_t offset = i * parameters->vocab_size;
-    if (cumulative_probs[offset] > parameters->top_p) {
-      filter_scores(sorted_indices, next_token_scores, parameters, offset, 1);
-    }
-    for (size_t j = 1; j < static_cast<size_t>(parameters->vocab_size) - 1; j++) {
-      cumulative_probs[j + offset] += cumulative_probs[j + offset - 1];
-      if (cumulative_probs[j + offset] > parameters->top_p) {
-        filter_scores(sorted_indices, next_token_scores, parameters, offset, j + 1);
-      }
+size_t select_top_p(gsl::span<const T> probs,
+                    gsl::span<size_t> indices,
+                    const transformers::IGenerationParameters* parameters) {
+  const size_t vocab_size = probs.size();
+  std::iota(indices.begin(), indices.end(), size_t{0});
+  auto greater = [&probs](size_t i1, size_t i2) { return probs[i1] > probs[i2]; };
+
+  const float top_p = parameters->top_p;
+  const size_t min_tokens_to_keep = parameters->custom_sampling
+                                        ? 1
+                                        : static_cast<size_t>(std::max(parameters->min_tokens_to_keep, 0));
+
+  // total probability of the selected tokens
+  float cumulative_prob = 0.0f;
+  size_t selected = 0;
+  for (size_t chunk_size = kTopPFirstChunkSize; selected < vocab_size; chunk_size *= 2) {
+    const size_t chunk_end = std::min(vocab_size, selected + chunk_size);
+    auto chunk_begin_iter = indices.begin() + selected;
+    auto chunk_end_iter = indices.begin() + chunk_end;
+    if (chunk_end < vocab_size) {
+      std::nth_element(chunk_begin_iter, chunk_end_iter, indices.end(), greater);
     }
-  }
-}
+    std::sort(chunk_begin_iter, chunk_end_iter, greater);
 
-template <typename T>
-void cumulate_and_filter(gsl::span<T>& next_token_scores,
-                         gsl::span<T>& cumulative_probs,
-                         const transformers::IGenerationParameters* parameters,
-                         std::vector<size_t>& sorted_indices) {
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    size_t offset = i * parameters->vocab_size;
-    if (cumulative_probs[offset] <= 1 - parameters->top_p) {
-      filter_scores(sorted_indices, next_token_scores, parameters, offset, 0);
-    }
-    for (size_t j = 1; j < static_cast<size_t>(parameters->vocab_size) - static_cast<size_t>(parameters->min_tokens_to_keep); j++) {
-      cumulative_probs[j + offset] += cumulative_probs[j + offset - 1];
-      if (cumulative_probs[j + offset] <= 1 - parameters->top_p) {
-        filter_scores(sorted_indices, next_token_scores, parameters, offset, j);
+    for (; selected < chunk_end; ++selected) {
+      const bool keep = selected < min_tokens_to_keep ||
+                        (parameters->custom_sampling ? cumulative_prob <= top_p : cumulative_prob < top_p);
+      if (!keep) {
+        return selected;
       }
+      cumulative_prob += static_cast<float>(probs[indices[selected]]);
     }
   }
+
+  return vocab_size;
 }
 
 template <typename T>
@@ -64,55 +63,33 @@ Status Sample(AllocatorPtr& allocator,
               const IConsoleDumper* dumper) {
   ORT_UNUSED_PARAMETER(dumper);
 
-  gsl::span<T>& sorted_scores = sampling_state->sorted_scores;
-  memcpy(sorted_scores.data(), next_token_scores.data(), next_token_scores.size_bytes());
-  std::vector<size_t> sorted_indices(static_cast<size_t>(parameters->batch_size) * static_cast<size_t>(parameters->vocab_size));
-
-  std::function<bool(T, T)> predicator;
-  if (parameters->custom_sampling) {
-    predicator = std::greater<T>();
-  } else {
-    predicator = std::less<T>();
-  }
-
-  // TODO: This could be optimized with allocated buffer and handwritten sort algorithm
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    auto indices_begin = sorted_indices.begin() + i * parameters->vocab_size;
-    auto indices_end = sorted_indices.begin() + (i + 1) * parameters->vocab_size;
-    gsl::span<T> next_token_score = next_token_scores.subspan(i * parameters->vocab_size, parameters->vocab_size);
-    std::iota(indices_begin, indices_end, 0);
-    std::sort(indices_begin, indices_end,
-              [&next_token_score, &predicator](size_t i1, size_t i2) {
-                return predicator(next_token_score[i1], next_token_score[i2]);
-              });
-
-    std::sort(sorted_scores.begin() + i * parameters->vocab_size,
-              sorted_scores.begin() + (i + 1) * parameters->vocab_size,
-              predicator);
-  }
-
-#ifdef DEBUG_GENERATION
-  dumper->Print("sorted_scores", sorted_scores.data(), parameters->batch_size, parameters->vocab_size);
-  dumper->Print("sorted_indices", sorted_indices.data(), parameters->batch_size, parameters->vocab_size);
-#endif
+  const size_t vocab_size = static_cast<size_t>(parameters->vocab_size);
 
+  // The probabilities don't depend on the order of the tokens, so they are computed before the selection.
   gsl::span<T>& cumulative_probs = sampling_state->cumulative_probs;
-
   ORT_RETURN_IF_ERROR(SoftmaxCPU<T>(parameters->batch_size,
                                     parameters->vocab_size,
-                                    sorted_scores.data(),
+                                    next_token_scores.data(),
                                     cumulative_probs.data(),
                                     false,
                                     thread_pool));
 
-  if (parameters->custom_sampling) {
-    cumulate_and_filter_custom(next_token_scores, cumulative_probs, parameters, sorted_indices);
-  } else {
-    cumulate_and_filter(next_token_scores, cumulative_probs, parameters, sorted_indices);
-  }
+  gsl::span<size_t>& sorted_indices = sampling_state->sorted_indices;
+  concurrency::ThreadPool::TryBatchParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(parameters->batch_size),
+      [&](std::ptrdiff_t i) {
+        const size_t offset = static_cast<size_t>(i) * vocab_size;
+        gsl::span<T> next_token_score = next_token_scores.subspan(offset, vocab_size);
+        gsl::span<size_t> indices = sorted_indices.subspan(offset, vocab_size);
+        const size_t num_kept = select_top_p<T>(cumulative_probs.subspan(offset, vocab_size), indices, parameters);
+        for (size_t j = num_kept; j < vocab_size; j++) {
+          next_token_score[indices[j]] = (T)parameters->filter_value;
+        }
+      },
+      0);
 
 #ifdef DEBUG_GENERATION
-  dumper->Print("cumulative_probs after filtering", cumulative_probs.data(), parameters->batch_size, parameters->vocab_size);
+  dumper->Print("probs", cumulative_probs.data(), parameters->batch_size, parameters->vocab_size);
   dumper->Print("next_token_scores after filtering", next_token_scores.data(), parameters->batch_size, parameters->vocab_size);
 #endif
 
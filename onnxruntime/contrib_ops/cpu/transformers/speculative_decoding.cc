@@ -0,0 +1,384 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#include "core/common/safeint.h"
+#include "core/framework/feeds_fetches_manager.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/session_state.h"
+#include "core/framework/utils.h"
+#include <gsl/gsl>
+#include "contrib_ops/cpu/transformers/generation_device_helper.h"
+#include "contrib_ops/cpu/transformers/speculative_decoding.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    SpeculativeDecoding,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    (*KernelDefBuilder::Create())
+        .TypeConstraint("I", DataTypeImpl::GetTensorType<int32_t>()),
+    transformers::SpeculativeDecoding);
+
+namespace transformers {
+
+namespace {
+
+// Feeds of a GPT subgraph and the number of tokens of the sequences its past state holds.
+struct DecoderState {
+  const SessionState* session_state = nullptr;
+  const FeedsFetchesManager* feeds_fetches_manager = nullptr;
+  GptSubgraph* subgraph = nullptr;
+
+  // input_ids, position_ids, attention_mask, past_0, past_1, ..., followed by the implicit inputs.
+  std::vector<OrtValue> feeds;
+  int num_cached_tokens = 0;
+};
+
+// Tokens generated so far, with the attention mask and position ids of every column.
+struct SequencesState {
+  int batch_size;
+  int sequence_length;  // length of the prompt
+  int max_length;
+
+  std::vector<int32_t> tokens;          // (batch_size, max_length)
+  std::vector<int32_t> prompt_mask;     // (batch_size, sequence_length)
+  std::vector<int32_t> prompt_lengths;  // number of non padding tokens of each prompt
+
+  int32_t& Token(int batch_id, int column) {
+    return tokens[SafeInt<size_t>(batch_id) * max_length + column];
+  }
+};
+
+int32_t ArgMax(const Tensor& logits, int batch_id, int row) {
+  const auto& dims = logits.Shape().GetDims();
+  const int64_t num_rows = dims[1];
+  const int64_t vocab_size = dims[2];
+  const float* row_logits = logits.Data<float>() + (batch_id * num_rows + row) * vocab_size;
+  return static_cast<int32_t>(std::max_element(row_logits, row_logits + vocab_size) - row_logits);
+}
+
+// Executes the subgraph and replaces the past state in the feeds with the present state it outputs.
+Status RunDecoder(OpKernelContextInternal& context, DecoderState& decoder, int num_new_tokens, OrtValue& logits) {
+  std::vector<OrtValue> fetches;
+  ORT_RETURN_IF_ERROR(utils::ExecuteSubgraph(*decoder.session_state,
+                                             *decoder.feeds_fetches_manager,
+                                             decoder.feeds,
+                                             fetches,
+                                             {},
+                                             ExecutionMode::ORT_SEQUENTIAL,
+                                             context.GetTerminateFlag(),
+                                             context.Logger(),
+                                             context.GetComputeStream()));
+
+  const int first_past_input_index = decoder.subgraph->GetFirstPastInputIndex();
+  const int first_present_output_index = decoder.subgraph->GetFirstPresentOutputIndex();
+  for (int layer = 0; layer < decoder.subgraph->num_layers; ++layer) {
+    decoder.feeds[SafeInt<size_t>(first_past_input_index) + layer] =
+        std::move(fetches[SafeInt<size_t>(first_present_output_index) + layer]);
+  }
+
+  logits = std::move(fetches[0]);
+  decoder.num_cached_tokens += num_new_tokens;
+  return Status::OK();
+}
+
+// Sets input_ids, position_ids and attention_mask to feed the tokens in [decoder.num_cached_tokens, end).
+void UpdateFeeds(const SequencesState& sequences, int end, AllocatorPtr allocator, DecoderState& decoder) {
+  const int start = decoder.num_cached_tokens;
+  const int batch_size = sequences.batch_size;
+  auto int32_type = DataTypeImpl::GetType<int32_t>();
+
+  OrtValue input_ids;
+  OrtValue position_ids;
+  TensorShape input_ids_shape{batch_size, end - start};
+  Tensor::InitOrtValue(int32_type, input_ids_shape, allocator, input_ids);
+  Tensor::InitOrtValue(int32_type, input_ids_shape, allocator, position_ids);
+  int32_t* input_ids_data = input_ids.GetMutable<Tensor>()->MutableData<int32_t>();
+  int32_t* position_ids_data = position_ids.GetMutable<Tensor>()->MutableData<int32_t>();
+
+  OrtValue attention_mask;
+  Tensor::InitOrtValue(int32_type, TensorShape{batch_size, end}, allocator, attention_mask);
+  int32_t* mask_data = attention_mask.GetMutable<Tensor>()->MutableData<int32_t>();
+
+  for (int b = 0; b < batch_size; ++b) {
+    for (int c = start; c < end; ++c) {
+      *input_ids_data++ = sequences.tokens[SafeInt<size_t>(b) * sequences.max_length + c];
+      *position_ids_data++ = sequences.prompt_lengths[b] + (c - sequences.sequence_length);
+    }
+
+    // Generated tokens are never masked.
+    const int32_t* prompt_mask = sequences.prompt_mask.data() + SafeInt<size_t>(b) * sequences.sequence_length;
+    mask_data = std::copy(prompt_mask, prompt_mask + sequences.sequence_length, mask_data);
+    mask_data = std::fill_n(mask_data, end - sequences.sequence_length, 1);
+  }
+
+  decoder.feeds[0] = std::move(input_ids);
+  decoder.feeds[1] = std::move(position_ids);
+  decoder.feeds[2] = std::move(attention_mask);
+}
+
+// Drops the past state of the tokens at or after `length`, which is how rejected draft tokens are rolled back.
+void TruncatePastState(int length, AllocatorPtr allocator, DecoderState& decoder) {
+  if (length >= decoder.num_cached_tokens) {
+    return;
+  }
+
+  const int first_past_input_index = decoder.subgraph->GetFirstPastInputIndex();
+  for (int layer = 0; layer < decoder.subgraph->num_layers; ++layer) {
+    OrtValue& past_value = decoder.feeds[SafeInt<size_t>(first_past_input_index) + layer];
+    const Tensor& past = past_value.Get<Tensor>();
+
+    // Past state shape is like (2, batch_size, num_heads, past_seq_len, head_size).
+    TensorShape truncated_shape = past.Shape();
+    const int64_t past_seq_len = truncated_shape[3];
+    const size_t num_chunks = SafeInt<size_t>(truncated_shape.SizeToDimension(3));
+    const size_t head_bytes = SafeInt<size_t>(truncated_shape[4]) * past.DataType()->Size();
+    truncated_shape[3] = length;
+
+    OrtValue truncated_value;
+    Tensor::InitOrtValue(past.DataType(), truncated_shape, allocator, truncated_value);
+
+    const char* source = static_cast<const char*>(past.DataRaw());
+    char* target = static_cast<char*>(truncated_value.GetMutable<Tensor>()->MutableDataRaw());
+    for (size_t i = 0; i < num_chunks; ++i) {
+      memcpy(target, source, head_bytes * length);
+      target += head_bytes * length;
+      source += head_bytes * past_seq_len;
+    }
+
+    past_value = std::move(truncated_value);
+  }
+
+  decoder.num_cached_tokens = length;
+}
+
+}  // namespace
+
+void SpeculativeDecoding::Init(const OpKernelInfo& info) {
+  eos_token_id_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("eos_token_id", -1));
+  pad_token_id_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("pad_token_id", -1));
+  num_speculative_tokens_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("num_speculative_tokens", 4));
+  ORT_ENFORCE(num_speculative_tokens_ > 0, "num_speculative_tokens shall be a positive integer, got ",
+              num_speculative_tokens_);
+
+  // Make sure the subgraph attributes are present.
+  ONNX_NAMESPACE::GraphProto proto;
+  ORT_ENFORCE(info.GetAttr<ONNX_NAMESPACE::GraphProto>("draft_decoder", &proto).IsOK());
+  ORT_ENFORCE(info.GetAttr<ONNX_NAMESPACE::GraphProto>("decoder", &proto).IsOK());
+}
+
+Status SpeculativeDecoding::SetupSubgraphExecutionInfo(const SessionState& session_state,
+                                                       const std::string& attribute_name,
+                                                       const SessionState& subgraph_session_state) {
+  const auto& node = Node();
+  if (attribute_name != "decoder" && attribute_name != "draft_decoder") {
+    return Status::OK();
+  }
+
+  std::unique_ptr<GptSubgraph>& gpt_subgraph = (attribute_name == "decoder") ? gpt_subgraph_ : draft_gpt_subgraph_;
+  ORT_ENFORCE(gpt_subgraph == nullptr, "SetupSubgraphExecutionInfo should only be called once for each subgraph.");
+  gpt_subgraph = std::make_unique<GptSubgraph>(node, attribute_name, subgraph_session_state.GetGraphViewer());
+  ORT_RETURN_IF_ERROR(gpt_subgraph->Setup(session_state, subgraph_session_state));
+
+  // The past state is truncated after verification, which requires a past state sized to the tokens it holds.
+  ORT_RETURN_IF(gpt_subgraph->past_present_share_buffer_,
+                "SpeculativeDecoding does not support past_present_share_buffer in the ", attribute_name, " subgraph");
+  ORT_RETURN_IF(gpt_subgraph->IsOutputFloat16(),
+                "SpeculativeDecoding only supports float logits in the ", attribute_name, " subgraph");
+
+  if (attribute_name == "decoder") {
+    decoder_feeds_fetches_manager_ = gpt_subgraph->GetFeedsFetchesManager();
+  } else {
+    draft_decoder_feeds_fetches_manager_ = gpt_subgraph->GetFeedsFetchesManager();
+  }
+
+  if (gpt_subgraph_ != nullptr && draft_gpt_subgraph_ != nullptr) {
+    ORT_RETURN_IF(gpt_subgraph_->vocab_size != draft_gpt_subgraph_->vocab_size,
+                  "draft_decoder and decoder subgraphs shall have the same vocabulary size, got ",
+                  draft_gpt_subgraph_->vocab_size, " and ", gpt_subgraph_->vocab_size);
+  }
+
+  return Status::OK();
+}
+
+Status SpeculativeDecoding::Compute(OpKernelContext* ctx) const {
+  auto* ctx_internal = static_cast<OpKernelContextInternal*>(ctx);
+
+  auto* decoder_session_state = ctx_internal->SubgraphSessionState("decoder");
+  ORT_ENFORCE(decoder_session_state, "Subgraph SessionState was not found for 'decoder' attribute.");
+  ORT_ENFORCE(decoder_feeds_fetches_manager_, "CreateFeedsFetchesManager must be called prior to execution of graph.");
+
+  auto* draft_decoder_session_state = ctx_internal->SubgraphSessionState("draft_decoder");
+  ORT_ENFORCE(draft_decoder_session_state, "Subgraph SessionState was not found for 'draft_decoder' attribute.");
+  ORT_ENFORCE(draft_decoder_feeds_fetches_manager_,
+              "CreateFeedsFetchesManager must be called prior to execution of graph.");
+
+  const Tensor* input_ids = ctx->Input<Tensor>(0);
+  const auto& input_ids_dims = input_ids->Shape().GetDims();
+  ORT_RETURN_IF(input_ids_dims.size() != 2,
+                "Input 'input_ids' is expected to have 2 dimensions, got ", input_ids_dims.size());
+
+  const Tensor* max_length_tensor = ctx->Input<Tensor>(1);
+  ORT_RETURN_IF(max_length_tensor == nullptr || max_length_tensor->Shape().Size() != 1,
+                "Input 'max_length' is expected to have 1 element");
+
+  SequencesState sequences;
+  sequences.batch_size = static_cast<int>(input_ids_dims[0]);
+  sequences.sequence_length = static_cast<int>(input_ids_dims[1]);
+  sequences.max_length = *max_length_tensor->Data<int32_t>();
+  ORT_RETURN_IF(sequences.max_length <= sequences.sequence_length,
+                "max_length (", sequences.max_length, ") shall be greater than input sequence length (",
+                sequences.sequence_length, ")");
+
+  const OrtValue* attn_mask_value = ctx_internal->GetInputOrtValue(2);
+  if (attn_mask_value != nullptr) {
+    ORT_RETURN_IF(attn_mask_value->Get<Tensor>().Shape() != input_ids->Shape(),
+                  "Input 'attention_mask' is expected to have same shape as input_ids");
+  }
+
+  const int batch_size = sequences.batch_size;
+  const int sequence_length = sequences.sequence_length;
+  const int max_length = sequences.max_length;
+
+  int64_t sequences_dims[] = {batch_size, max_length};
+  Tensor* output_sequences = ctx->Output(0, TensorShape(&sequences_dims[0], 2));
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
+
+  sequences.tokens.assign(SafeInt<size_t>(batch_size) * max_length, pad_token_id_);
+  sequences.prompt_lengths.resize(batch_size);
+  gsl::span<int32_t> prompt_lengths = gsl::make_span(sequences.prompt_lengths);
+
+  DecoderState decoder{decoder_session_state, decoder_feeds_fetches_manager_, gpt_subgraph_.get()};
+  DecoderState draft_decoder{draft_decoder_session_state, draft_decoder_feeds_fetches_manager_,
+                             draft_gpt_subgraph_.get()};
+
+  // Both subgraphs consume the whole prompt in their first run.
+  for (DecoderState* state : {&decoder, &draft_decoder}) {
+    IAllocatorUniquePtr<char> buffer;
+    OrtValue expanded_input_ids;
+    ORT_RETURN_IF_ERROR(state->subgraph->CreateInitialFeeds(
+        *input_ids, ctx_internal->GetImplicitInputs(), 1, pad_token_id_, prompt_lengths, expanded_input_ids,
+        attn_mask_value, state->feeds, GenerationCpuDeviceHelper::CreateGptInputs,
+        GenerationCpuDeviceHelper::AddToFeeds, buffer, ctx->GetComputeStream()));
+  }
+
+  gsl::span<const int32_t> prompt_tokens = input_ids->DataAsSpan<int32_t>();
+  gsl::span<const int32_t> prompt_mask = decoder.feeds[2].Get<Tensor>().DataAsSpan<int32_t>();
+  sequences.prompt_mask.assign(prompt_mask.begin(), prompt_mask.end());
+  for (int b = 0; b < batch_size; ++b) {
+    std::copy_n(prompt_tokens.data() + SafeInt<size_t>(b) * sequence_length, sequence_length,
+                &sequences.Token(b, 0));
+  }
+
+  OrtValue logits;
+  OrtValue draft_logits;
+  ORT_RETURN_IF_ERROR(RunDecoder(*ctx_internal, decoder, sequence_length, logits));
+  ORT_RETURN_IF_ERROR(RunDecoder(*ctx_internal, draft_decoder, sequence_length, draft_logits));
+
+  std::vector<bool> eos_meet(batch_size, false);
+  int num_finished = 0;
+
+  // Appends the choice of the decoder at row `row` of its logits as the token of column `column`.
+  auto append_token = [&](int row, int column) {
+    for (int b = 0; b < batch_size; ++b) {
+      if (eos_meet[b]) {
+        sequences.Token(b, column) = pad_token_id_;
+        continue;
+      }
+
+      const int32_t token = ArgMax(logits.Get<Tensor>(), b, row);
+      sequences.Token(b, column) = token;
+      if (token == eos_token_id_) {
+        eos_meet[b] = true;
+        ++num_finished;
+      }
+    }
+  };
+
+  append_token(sequence_length - 1, sequence_length);
+  int current_length = sequence_length + 1;
+  int num_accepted_tokens = 0;
+
+  while (current_length < max_length && num_finished < batch_size) {
+    // The draft decoder proposes the next tokens greedily.
+    const int num_draft_tokens = std::min(num_speculative_tokens_, max_length - current_length);
+    for (int i = 0; i < num_draft_tokens; ++i) {
+      const int num_new_tokens = current_length + i - draft_decoder.num_cached_tokens;
+      UpdateFeeds(sequences, current_length + i, allocator, draft_decoder);
+      ORT_RETURN_IF_ERROR(RunDecoder(*ctx_internal, draft_decoder, num_new_tokens, draft_logits));
+
+      for (int b = 0; b < batch_size; ++b) {
+        sequences.Token(b, current_length + i) =
+            eos_meet[b] ? pad_token_id_ : ArgMax(draft_logits.Get<Tensor>(), b, num_new_tokens - 1);
+      }
+    }
+
+    // The decoder scores the last accepted token and all the proposed tokens in one run.
+    // Row r of its logits chooses the token of column current_length + r.
+    const int first_row_column = decoder.num_cached_tokens + 1;
+    const int num_new_tokens = current_length + num_draft_tokens - decoder.num_cached_tokens;
+    UpdateFeeds(sequences, current_length + num_draft_tokens, allocator, decoder);
+    ORT_RETURN_IF_ERROR(RunDecoder(*ctx_internal, decoder, num_new_tokens, logits));
+
+    // Accept the longest proposed prefix that every unfinished sequence agrees on.
+    const int row_offset = current_length - first_row_column;
+    int num_accepted = num_draft_tokens;
+    for (int b = 0; b < batch_size; ++b) {
+      if (eos_meet[b]) {
+        continue;
+      }
+
+      for (int j = 0; j < num_accepted; ++j) {
+        if (ArgMax(logits.Get<Tensor>(), b, row_offset + j) != sequences.Token(b, current_length + j)) {
+          num_accepted = j;
+          break;
+        }
+      }
+    }
+
+    // The accepted tokens are those chosen by the decoder, followed by its choice after them
+    // unless max_length is reached.
+    const int num_appended = std::min(num_accepted + 1, max_length - current_length);
+    for (int j = 0; j < num_appended; ++j) {
+      append_token(row_offset + j, current_length + j);
+    }
+
+    num_accepted_tokens += num_accepted;
+    current_length += num_appended;
+
+    // Roll back the past state of the rejected tokens. The last accepted token is fed in the next run.
+    TruncatePastState(current_length - 1, allocator, decoder);
+    TruncatePastState(current_length - 1, allocator, draft_decoder);
+  }
+
+  // Clear the proposed tokens that were not accepted before the last iteration.
+  for (int b = 0; b < batch_size; ++b) {
+    std::fill(&sequences.Token(b, 0) + current_length, &sequences.Token(b, 0) + max_length, pad_token_id_);
+  }
+
+  gsl::copy(gsl::make_span(sequences.tokens), output_sequences->MutableDataAsSpan<int32_t>());
+
+  Tensor* output_num_accepted_tokens = ctx->Output(1, TensorShape({1}));
+  if (output_num_accepted_tokens != nullptr) {
+    *output_num_accepted_tokens->MutableData<int32_t>() = num_accepted_tokens;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <memory>
+#include <string>
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/controlflow/utils.h"
+#include "contrib_ops/cpu/transformers/subgraph_gpt.h"
+
+namespace onnxruntime {
+class FeedsFetchesManager;
+
+namespace contrib {
+namespace transformers {
+
+using namespace onnxruntime::controlflow;  // namespace of IControlFlowKernel
+
+// Speculative decoding for GPT-2 like models.
+// In each iteration the `draft_decoder` subgraph proposes num_speculative_tokens tokens greedily, one at a time,
+// and the `decoder` subgraph scores all of them in a single run. The longest prefix of the proposal that matches
+// the greedy choice of the decoder is accepted together with the next token of the decoder, and the past state of
+// both subgraphs is truncated to the accepted tokens. The output is the same as GreedySearch with `decoder`.
+class SpeculativeDecoding : public IControlFlowKernel {
+ public:
+  explicit SpeculativeDecoding(const OpKernelInfo& info) : IControlFlowKernel(info) {
+    Init(info);
+  }
+
+  void Init(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* ctx) const override;
+
+  Status SetupSubgraphExecutionInfo(const SessionState& session_state,
+                                    const std::string& attribute_name,
+                                    const SessionState& subgraph_session_state) override;
+
+ private:
+  std::unique_ptr<GptSubgraph> draft_gpt_subgraph_;
+  std::unique_ptr<GptSubgraph> gpt_subgraph_;
+
+  FeedsFetchesManager* draft_decoder_feeds_fetches_manager_ = nullptr;
+  FeedsFetchesManager* decoder_feeds_fetches_manager_ = nullptr;
+
+  int eos_token_id_ = -1;
+  int pad_token_id_ = -1;
+  int num_speculative_tokens_ = 4;
+};
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
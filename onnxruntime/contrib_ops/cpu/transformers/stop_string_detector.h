@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "contrib_ops/cpu/bpe_tokenizer.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+// Detects stop strings in the text of the generated tokens of each sequence, so that generation can end on a
+// string that spans several tokens. Only the last bytes of the text that could still start a stop string are kept.
+class StopStringDetector {
+ public:
+  // `vocab` holds the byte-level BPE token of each id.
+  Status Init(gsl::span<const std::string> vocab, gsl::span<const std::string> stop_strings, int batch_size) {
+    vocab_ = vocab;
+    stop_strings_.clear();
+    max_stop_length_ = 0;
+    for (const auto& stop_string : stop_strings) {
+      if (stop_string.empty()) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'stop_strings' shall not contain empty strings.");
+      }
+      stop_strings_.push_back(stop_string);
+      max_stop_length_ = std::max(max_stop_length_, stop_string.size());
+    }
+    tails_.assign(stop_strings_.empty() ? 0 : static_cast<size_t>(batch_size), std::string());
+    return Status::OK();
+  }
+
+  bool IsEnabled() const {
+    return !stop_strings_.empty();
+  }
+
+  // Appends the text of `token_id` to the sequence `batch_id`. Returns true if the text now ends a stop string.
+  bool Append(size_t batch_id, int32_t token_id) {
+    if (token_id < 0 || static_cast<size_t>(token_id) >= vocab_.size()) {
+      return false;
+    }
+
+    std::string& tail = tails_[batch_id];
+    const size_t old_size = tail.size();
+    AppendBpeTokenBytes(vocab_[static_cast<size_t>(token_id)], tail);
+
+    bool found = false;
+    for (const auto& stop_string : stop_strings_) {
+      // a match that is new ends in the bytes just appended
+      const size_t start = old_size + 1 > stop_string.size() ? old_size + 1 - stop_string.size() : 0;
+      if (tail.find(stop_string, start) != std::string::npos) {
+        found = true;
+        break;
+      }
+    }
+
+    if (tail.size() >= max_stop_length_) {
+      tail.erase(0, tail.size() - (max_stop_length_ - 1));
+    }
+    return found;
+  }
+
+ private:
+  gsl::span<const std::string> vocab_;
+  std::vector<std::string> stop_strings_;
+  std::vector<std::string> tails_;
+  size_t max_stop_length_ = 0;
+};
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
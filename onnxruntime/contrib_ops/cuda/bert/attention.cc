@@ -40,6 +40,9 @@ REGISTER_KERNEL_TYPED(MLFloat16)
 
 template <typename T>
 Attention<T>::Attention(const OpKernelInfo& info) : CudaKernel(info), AttentionBase(info, false) {
+  ORT_ENFORCE(sparse_block_size_ == 0,
+              "Block sparse Attention does not support CUDA kernel. Consider using SparseAttention instead.");
+
   disable_fused_self_attention_ =
       sizeof(T) != 2 ||
       ParseEnvironmentVariableWithDefault<bool>(attention::kDisableFusedSelfAttention, false);
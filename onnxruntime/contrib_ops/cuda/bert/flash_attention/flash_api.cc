@@ -514,6 +514,11 @@ Status mha_fwd_kvcache(const cudaDeviceProp& dprops,
     params.page_block_size = page_block_size;
     params.k_batch_stride = page_block_size * num_heads_k * head_size;
     params.v_batch_stride = page_block_size * num_heads_k * head_size;
+    if (!past_bsnh) {
+      // each block is (num_heads_k, page_block_size, head_size)
+      params.k_head_stride = page_block_size * head_size;
+      params.v_head_stride = page_block_size * head_size;
+    }
   } else {
     params.block_table = nullptr;
     params.block_table_batch_stride = 0;
@@ -26,6 +26,7 @@ namespace cuda {
       kCudaExecutionProvider,                                            \
       (*KernelDefBuilder::Create())                                      \
           .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())         \
+          .TypeConstraint("T_CACHE", DataTypeImpl::GetTensorType<T>())   \
           .TypeConstraint("M", {DataTypeImpl::GetTensorType<int32_t>()}) \
           .MayInplace(3, 1)                                              \
           .MayInplace(4, 2)                                              \
@@ -48,6 +49,8 @@ GroupQueryAttention<T>::GroupQueryAttention(const OpKernelInfo& info)
   is_past_bsnh_ = false;
   is_unidirectional_ = true;
   local_window_size_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("local_window_size", -1));
+  ORT_ENFORCE(info.GetAttrOrDefault<int64_t>("kv_cache_ring_buffer", 0) == 0,
+              "A ring buffer KV cache (kv_cache_ring_buffer) is only supported on CPU.");
   do_rotary_ = info.GetAttrOrDefault<int64_t>("do_rotary", 0) == 1;
   rotary_interleaved_ = info.GetAttrOrDefault<int64_t>("rotary_interleaved", 0) == 1;
   scale_ = info.GetAttrOrDefault<float>("scale", 0.0f);
@@ -82,17 +85,21 @@ Status GroupQueryAttention<T>::ComputeInternal(OpKernelContext* context) const {
   const Tensor* total_seqlen = context->Input<Tensor>(6);
   const Tensor* cos_cache = context->Input<Tensor>(7);
   const Tensor* sin_cache = context->Input<Tensor>(8);
+  const Tensor* block_table = context->Input<Tensor>(9);
+
+  // the paged KV cache has no batch dimension, so its past key and value are checked separately
+  const bool is_paged_kv_cache = block_table != nullptr;
 
   auto& device_prop = GetDeviceProp();
-  GroupQueryAttentionParameters parameters;
+  GroupQueryAttentionParameters parameters = {};
   typedef typename ToCudaType<T>::MappedType CudaT;
   GroupQueryAttentionData<CudaT> data;
 
   ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckInputs(query,
                                                                 key,
                                                                 value,
-                                                                past_key,
-                                                                past_value,
+                                                                is_paged_kv_cache ? nullptr : past_key,
+                                                                is_paged_kv_cache ? nullptr : past_value,
                                                                 cos_cache,
                                                                 sin_cache,
                                                                 &parameters,
@@ -103,6 +110,14 @@ Status GroupQueryAttention<T>::ComputeInternal(OpKernelContext* context) const {
                                                                 is_past_bsnh_,
                                                                 scale_,
                                                                 device_prop.maxThreadsPerBlock));
+  if (is_paged_kv_cache) {
+    // seqlens_k is in device memory, the flash attention kernels don't read blocks past the end of each sequence
+    ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckPagedKVCacheInputs(past_key,
+                                                                              past_value,
+                                                                              block_table,
+                                                                              nullptr,
+                                                                              parameters));
+  }
   parameters.local_window_size = local_window_size_;
   parameters.is_unidirectional = is_unidirectional_;
   parameters.zeros_count = kZerosCount;
@@ -155,6 +170,14 @@ Status GroupQueryAttention<T>::ComputeInternal(OpKernelContext* context) const {
   auto out_accum_buffer = GetScratchBuffer<void>(0, context->GetComputeStream());          // nullptr
 #endif
 
+  // The flash attention kernels read K and V in tiles of up to 256 tokens, a tile must not span two blocks.
+  constexpr int kPagedKVBlockSizeMultiple = 256;
+  if (is_paged_kv_cache && (!use_flash_attention || parameters.kv_block_size % kPagedKVBlockSizeMultiple != 0)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                           "Paged KV cache (block_table) on CUDA requires flash attention and a block size that is a "
+                           "multiple of ", kPagedKVBlockSizeMultiple, ". Got block size ", parameters.kv_block_size);
+  }
+
 #if USE_MEMORY_EFFICIENT_ATTENTION
   int sm = (device_prop.major * 10) + device_prop.minor;
   bool use_memory_efficient_attention =
@@ -215,8 +238,8 @@ Status GroupQueryAttention<T>::ComputeInternal(OpKernelContext* context) const {
         parameters.batch_size, parameters.kv_num_heads, parameters.seqlen_present_kv_cache, parameters.head_size};
   }
   TensorShape present_shape(present_dims);
-  Tensor* present_key = context->Output(1, present_shape);
-  Tensor* present_value = context->Output(2, present_shape);
+  Tensor* present_key = context->Output(1, is_paged_kv_cache ? past_key->Shape() : present_shape);
+  Tensor* present_value = context->Output(2, is_paged_kv_cache ? past_value->Shape() : present_shape);
 
   data.query = reinterpret_cast<const CudaT*>(query->Data<T>());
   data.key = key == nullptr ? nullptr : reinterpret_cast<const CudaT*>(key->Data<T>());
@@ -231,9 +254,20 @@ Status GroupQueryAttention<T>::ComputeInternal(OpKernelContext* context) const {
   data.use_memory_efficient_attention = use_memory_efficient_attention;
   if (data.past_key == data.present_key) {
     parameters.kv_share_buffer = true;
+  } else if (is_paged_kv_cache) {
+    // the new tokens are written into the blocks of the pool, carry the pool over to present first
+    cudaStream_t stream = Stream(context);
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(data.present_key, data.past_key, past_key->SizeInBytes(),
+                                         cudaMemcpyDeviceToDevice, stream));
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(data.present_value, data.past_value, past_value->SizeInBytes(),
+                                         cudaMemcpyDeviceToDevice, stream));
+    parameters.kv_share_buffer = true;
   } else {
     parameters.kv_share_buffer = false;
   }
+  if (is_paged_kv_cache) {
+    data.block_table = const_cast<int*>(block_table->Data<int>());
+  }
   // Flash Buffers
   if (softmax_lse_buffer != nullptr) {
     data.softmax_lse = reinterpret_cast<CudaT*>(softmax_lse_buffer.get());
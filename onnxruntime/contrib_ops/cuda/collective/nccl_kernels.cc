@@ -9,7 +9,11 @@
 #include <netdb.h>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "nccl_kernels.h"
 #include "mpi_include.h"
@@ -18,7 +22,9 @@
 #include "core/providers/cuda/math/matmul.h"
 #include "core/providers/cuda/tensor/transpose.h"
 #include "core/providers/cuda/cuda_check_memory.h"
+#include "core/common/parse_string.h"
 #include "core/platform/env_var_utils.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -228,11 +234,42 @@ NcclContext::NcclContext() {
   ORT_ENFORCE(ret.IsOK());
 }
 
+NcclContext::NcclContext(ncclComm_t comm, int rank, int world_size)
+    : comm_(comm), rank_(rank), world_size_(world_size), in_process_(true) {
+}
+
+NcclContext* NcclContext::GetInProcessContext(int world_size, int rank) {
+  static std::mutex mutex;
+  static std::unordered_map<int, std::vector<std::unique_ptr<NcclContext>>> contexts_by_world_size;
+
+  ORT_ENFORCE(rank >= 0 && rank < world_size, "Invalid rank ", rank, " for world size ", world_size);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& contexts = contexts_by_world_size[world_size];
+  if (contexts.empty()) {
+    // a single call creates the communicators of all the ranks, ncclCommInitRank would block until the sessions of
+    // all the ranks are created
+    std::vector<ncclComm_t> comms(world_size);
+    std::vector<int> devices(world_size);
+    std::iota(devices.begin(), devices.end(), 0);
+    ORT_THROW_IF_ERROR(NCCL_CALL(ncclCommInitAll(comms.data(), world_size, devices.data())));
+    for (int r = 0; r < world_size; ++r) {
+      contexts.push_back(std::unique_ptr<NcclContext>(new NcclContext(comms[r], r, world_size)));
+    }
+  }
+
+  return contexts[rank].get();
+}
+
 NcclContext::~NcclContext() {
   if (comm_ != nullptr) {
     ncclCommDestroy(comm_);
   }
 
+  if (in_process_) {
+    return;
+  }
+
 #ifdef USE_MPI
   int is_mpi_finalized = 0;
   MPI_Finalized(&is_mpi_finalized);
@@ -243,6 +280,25 @@ NcclContext::~NcclContext() {
 }
 
 NcclKernel::NcclKernel(const OpKernelInfo& info) : CudaKernel(info) {
+  int world_size = 0;
+  const std::string world_size_str =
+      info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsConfigTensorParallelWorldSize, "0");
+  ORT_ENFORCE(TryParseStringWithClassicLocale(world_size_str, world_size),
+              "Invalid value for ", kOrtSessionOptionsConfigTensorParallelWorldSize, ": ", world_size_str);
+
+  if (world_size > 1) {
+    int rank = -1;
+    const std::string rank_str =
+        info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsConfigTensorParallelRank, "");
+    ORT_ENFORCE(TryParseStringWithClassicLocale(rank_str, rank),
+                "Invalid value for ", kOrtSessionOptionsConfigTensorParallelRank, ": ", rank_str);
+    const auto* cuda_ep = static_cast<const CUDAExecutionProvider*>(info.GetExecutionProvider());
+    ORT_ENFORCE(cuda_ep->GetDeviceId() == rank, "The session of tensor parallel rank ", rank,
+                " must run on CUDA device ", rank, ", got device ", cuda_ep->GetDeviceId());
+    nccl_ = NcclContext::GetInProcessContext(world_size, rank);
+    return;
+  }
+
   static NcclContext context;
   nccl_ = &context;
 }
@@ -260,6 +316,14 @@ Status AllReduce::ComputeInternal(OpKernelContext* context) const {
   void* output_data = context->Output(0, in_shape)->MutableDataRaw();
 
 #ifndef USE_ROCM
+  // The custom all-reduce exchanges CUDA IPC handles between processes, the ranks in this process use NCCL.
+  if (nccl_->IsInProcess()) {
+    ncclDataType_t dtype = GetNcclDataType(input_tensor->DataType());
+    NCCL_RETURN_IF_ERROR(ncclAllReduce(input_data, output_data, input_count, dtype, ncclSum, nccl_->Comm(),
+                                       Stream(context)));
+    return Status::OK();
+  }
+
   return FuncCustomAllReduce(nccl_,
                              Stream(context),
                              input_data,
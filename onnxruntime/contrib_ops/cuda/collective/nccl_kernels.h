@@ -38,6 +38,11 @@ class NcclContext final {
   NcclContext();
   ~NcclContext();
 
+  // Returns the context of `rank` in a communicator over the CUDA devices 0 to `world_size` - 1 of this process,
+  // see kOrtSessionOptionsConfigTensorParallelWorldSize. The communicators of all ranks are created together on first
+  // use and live until the process exits.
+  static NcclContext* GetInProcessContext(int world_size, int rank);
+
   ncclComm_t Comm() {
     return comm_;
   }
@@ -50,10 +55,18 @@ class NcclContext final {
     return world_size_;
   }
 
+  // True if all the ranks are in this process.
+  bool IsInProcess() const {
+    return in_process_;
+  }
+
  private:
+  NcclContext(ncclComm_t comm, int rank, int world_size);
+
   ncclComm_t comm_;
   int rank_;
   int world_size_;
+  bool in_process_ = false;
 };
 
 class NcclKernel : public ::onnxruntime::cuda::CudaKernel {
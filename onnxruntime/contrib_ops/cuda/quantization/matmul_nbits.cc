@@ -23,6 +23,7 @@ Status MatMulNBits<T>::ComputeInternal(OpKernelContext* ctx) const {
   const Tensor* scales = ctx->Input<Tensor>(2);
   const Tensor* zero_points = ctx->Input<Tensor>(3);
   const Tensor* reorder_idx = ctx->Input<Tensor>(4);
+  const Tensor* bias = ctx->Input<Tensor>(5);
 
   const auto* a_data = a->Data<T>();
   const uint8_t* blob_data = b->Data<uint8_t>();
@@ -31,6 +32,7 @@ Status MatMulNBits<T>::ComputeInternal(OpKernelContext* ctx) const {
   const auto* reorder_idx_data = reorder_idx == nullptr ? nullptr : reorder_idx->Data<int32_t>();
 
   typedef typename ToCudaType<T>::MappedType CudaT;
+  const auto* bias_data = bias == nullptr ? nullptr : reinterpret_cast<const CudaT*>(bias->Data<T>());
 
   constexpr bool transa = false;
   constexpr bool transb = true;
@@ -39,14 +41,38 @@ Status MatMulNBits<T>::ComputeInternal(OpKernelContext* ctx) const {
   ORT_RETURN_IF_ERROR(
       helper.Compute(a->Shape(), b_shape, transa, transb));
 
-  Tensor* Y = ctx->Output(0, helper.OutputShape());
+  // swiglu multiplies the two halves of the N columns, so the output has N / 2 of them
+  const bool is_swiglu = activation_ == MatMulNBitsActivation::kSwiGlu;
+  TensorShape output_shape = helper.OutputShape();
+  if (is_swiglu) {
+    output_shape[output_shape.NumDimensions() - 1] = N_ / 2;
+  }
+
+  Tensor* Y = ctx->Output(0, output_shape);
   // Bail out early if the output is going to be empty
   if (Y->Shape().Size() == 0) return Status::OK();
 
+  cudaStream_t stream = static_cast<cudaStream_t>(ctx->GetComputeStream()->GetHandle());
+
+  // The GEMM writes to the output directly unless the swiglu epilogue reduces it afterwards.
+  IAllocatorUniquePtr<T> gemm_output_ptr;
+  auto* gemm_output = reinterpret_cast<CudaT*>(Y->MutableData<T>());
+  if (is_swiglu) {
+    gemm_output_ptr = GetScratchBuffer<T>(helper.M() * N_, ctx->GetComputeStream());
+    gemm_output = reinterpret_cast<CudaT*>(gemm_output_ptr.get());
+  }
+
+  auto run_epilogue = [&]() -> Status {
+    return LaunchMatMulNBitsEpilogue(reinterpret_cast<CudaT*>(Y->MutableData<T>()), gemm_output, bias_data,
+                                     SafeInt<int>(helper.M()), SafeInt<int>(is_swiglu ? N_ / 2 : N_),
+                                     activation_, stream);
+  };
+
+  // The GEMV kernel adds the bias and applies the activation itself, except for swiglu.
   bool is_4bit_done = (reorder_idx_data == nullptr) &&
                       (!zero_points || !zero_points->IsDataType<T>()) &&
                       TryMatMul4Bits(
-                          reinterpret_cast<CudaT*>(Y->MutableData<T>()),
+                          gemm_output,
                           reinterpret_cast<const CudaT*>(a_data),
                           blob_data,
                           reinterpret_cast<const CudaT*>(scales_data),
@@ -56,10 +82,12 @@ Status MatMulNBits<T>::ComputeInternal(OpKernelContext* ctx) const {
                           SafeInt<int>(helper.K()),
                           SafeInt<int>(block_size_),
                           SafeInt<int>(GetDeviceProp().sharedMemPerBlock),
-                          static_cast<cudaStream_t>(ctx->GetComputeStream()->GetHandle()));
+                          stream,
+                          is_swiglu ? nullptr : bias_data,
+                          is_swiglu ? MatMulNBitsActivation::kNone : activation_);
 
   if (is_4bit_done) {
-    return Status::OK();
+    return is_swiglu ? run_epilogue() : Status::OK();
   }
 
   int64_t K_padded = (K_ + block_size_ - 1) / block_size_ * block_size_;
@@ -132,12 +160,16 @@ delete[] b_data_cpu;
         reinterpret_cast<const CudaT*>(a_data),
         helper.Lda(transa),
         &zero,
-        reinterpret_cast<CudaT*>(Y->MutableData<T>()),
+        gemm_output,
         helper.Ldc(),
         GetDeviceProp(),
         UseTF32()));
   }
 
+  if (bias_data != nullptr || activation_ != MatMulNBitsActivation::kNone) {
+    ORT_RETURN_IF_ERROR(run_epilogue());
+  }
+
   return Status::OK();
 }
 
@@ -2,6 +2,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <cub/cub.cuh>
 #include <cublas_v2.h>
 #include <cuda_fp16.h>
@@ -168,6 +169,17 @@ __device__ __forceinline__ void AccumulateEightElements(uint32_t values_quant, f
   sums[7] += v7 * a_vec_1.w;
 }
 
+__device__ __forceinline__ float ApplyActivation(float x, MatMulNBitsActivation activation) {
+  switch (activation) {
+    case MatMulNBitsActivation::kSilu:
+      return x / (1.f + __expf(-x));
+    case MatMulNBitsActivation::kGelu:
+      return 0.5f * x * (1.f + erff(x * 0.70710678118654752f));
+    default:
+      return x;
+  }
+}
+
 constexpr int kColsPerThreadBlock = 8;
 constexpr int kElementsPerThreadPerIteration = 8;
 constexpr int kWarpSize = GPU_WARP_SIZE;
@@ -177,6 +189,8 @@ constexpr int kWarpSize = GPU_WARP_SIZE;
 // The thread block size is (kWarpSize, kColsPerThreadBlock) and grid size is (N/kColsPerThreadBlock, 1)
 // Each thread block computes [1, K] x [kColsPerThreadBlock, (K + block_size - 1)/block_size, blob],
 //     i.e., computing kColsPerThreadBlock per block and a warp reduce (1, K) x (K)
+// The bias and the activation are applied by the lane writing the reduced sum, so they cost no extra pass over the
+// output.
 template <class T, int block_size, bool has_zero_point>
 __global__ void __launch_bounds__(kWarpSize * kColsPerThreadBlock) MatMulFloatInt4Kernel(
     T* output,
@@ -187,7 +201,9 @@ __global__ void __launch_bounds__(kWarpSize * kColsPerThreadBlock) MatMulFloatIn
     int m,
     int n,
     int k,
-    int blocks_per_K) {
+    int blocks_per_K,
+    const T* bias,
+    MatMulNBitsActivation activation) {
   const int n_block_id = blockIdx.x;
   const int m_id = blockIdx.y;
   const int lane_id = threadIdx.x;
@@ -268,7 +284,10 @@ __global__ void __launch_bounds__(kWarpSize * kColsPerThreadBlock) MatMulFloatIn
   }
 
   if (lane_id == 0) {
-    output[m_id * n + n_id] = sum;
+    if (bias != nullptr) {
+      sum += static_cast<float>(bias[n_id]);
+    }
+    output[m_id * n + n_id] = ApplyActivation(sum, activation);
   }
 }  // namespace cuda
 
@@ -284,8 +303,10 @@ bool TryMatMul4Bits(
     int k,
     int block_size,
     int shared_mem_per_block,
-    cudaStream_t stream) {
-  if (n % kColsPerThreadBlock != 0 || k % 8 != 0 || m > 1) {
+    cudaStream_t stream,
+    const T* bias,
+    MatMulNBitsActivation activation) {
+  if (n % kColsPerThreadBlock != 0 || k % 8 != 0 || m > 1 || activation == MatMulNBitsActivation::kSwiGlu) {
     return false;
   }
   dim3 blocks((n + kColsPerThreadBlock - 1) / kColsPerThreadBlock, m);
@@ -300,10 +321,12 @@ bool TryMatMul4Bits(
 #define MatMulFloatInt4KernelDispatch(block_size)                                              \
   if (nullptr != zero_points) {                                                                \
     MatMulFloatInt4Kernel<T, block_size, true><<<blocks, threads, shared_mem_size, stream>>>(  \
-        output, a_data, b_data_quant, scales_data, zero_points, m, n, k, blocks_per_K);        \
+        output, a_data, b_data_quant, scales_data, zero_points, m, n, k, blocks_per_K,         \
+        bias, activation);                                                                     \
   } else {                                                                                     \
     MatMulFloatInt4Kernel<T, block_size, false><<<blocks, threads, shared_mem_size, stream>>>( \
-        output, a_data, b_data_quant, scales_data, zero_points, m, n, k, blocks_per_K);        \
+        output, a_data, b_data_quant, scales_data, zero_points, m, n, k, blocks_per_K,         \
+        bias, activation);                                                                     \
   }
 
   if (16 == block_size) {
@@ -334,7 +357,9 @@ template bool TryMatMul4Bits<float>(
     int k,
     int block_size,
     int shared_mem_per_block,
-    cudaStream_t stream);
+    cudaStream_t stream,
+    const float* bias,
+    MatMulNBitsActivation activation);
 
 template bool TryMatMul4Bits<half>(
     half* output,
@@ -347,6 +372,80 @@ template bool TryMatMul4Bits<half>(
     int k,
     int block_size,
     int shared_mem_per_block,
+    cudaStream_t stream,
+    const half* bias,
+    MatMulNBitsActivation activation);
+
+template <class T>
+__global__ void MatMulNBitsEpilogueKernel(
+    T* output,
+    const T* input,
+    const T* bias,
+    int m,
+    int n,
+    MatMulNBitsActivation activation) {
+  const int64_t size = static_cast<int64_t>(m) * n;
+  for (int64_t i = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x; i < size;
+       i += static_cast<int64_t>(gridDim.x) * blockDim.x) {
+    const int64_t row = i / n;
+    const int col = static_cast<int>(i % n);
+    if (activation == MatMulNBitsActivation::kSwiGlu) {
+      const T* input_row = input + row * 2 * n;
+      float gate = static_cast<float>(input_row[col]);
+      float up = static_cast<float>(input_row[n + col]);
+      if (bias != nullptr) {
+        gate += static_cast<float>(bias[col]);
+        up += static_cast<float>(bias[n + col]);
+      }
+      output[i] = static_cast<T>(ApplyActivation(gate, MatMulNBitsActivation::kSilu) * up);
+    } else {
+      float value = static_cast<float>(input[i]);
+      if (bias != nullptr) {
+        value += static_cast<float>(bias[col]);
+      }
+      output[i] = static_cast<T>(ApplyActivation(value, activation));
+    }
+  }
+}
+
+template <class T>
+Status LaunchMatMulNBitsEpilogue(
+    T* output,
+    const T* input,
+    const T* bias,
+    int m,
+    int n,
+    MatMulNBitsActivation activation,
+    cudaStream_t stream) {
+  const int64_t size = static_cast<int64_t>(m) * n;
+  if (size == 0) {
+    return Status::OK();
+  }
+
+  constexpr int kMaxBlocks = 65535;
+  const int blocks = static_cast<int>(std::min<int64_t>(CeilDiv(size, GridDim::maxThreadsPerBlock), kMaxBlocks));
+  MatMulNBitsEpilogueKernel<T><<<blocks, GridDim::maxThreadsPerBlock, 0, stream>>>(
+      output, input, bias, m, n, activation);
+
+  return CUDA_CALL(cudaGetLastError());
+}
+
+template Status LaunchMatMulNBitsEpilogue<float>(
+    float* output,
+    const float* input,
+    const float* bias,
+    int m,
+    int n,
+    MatMulNBitsActivation activation,
+    cudaStream_t stream);
+
+template Status LaunchMatMulNBitsEpilogue<half>(
+    half* output,
+    const half* input,
+    const half* bias,
+    int m,
+    int n,
+    MatMulNBitsActivation activation,
     cudaStream_t stream);
 
 }  // namespace cuda
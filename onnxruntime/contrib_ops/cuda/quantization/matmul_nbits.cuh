@@ -8,6 +8,18 @@ namespace onnxruntime {
 namespace contrib {
 namespace cuda {
 
+// Elementwise epilogue applied to the output of MatMulNBits, see the 'activation' attribute.
+enum class MatMulNBitsActivation {
+  kNone,
+  kSilu,
+  kGelu,
+  // The GEMM output has 2 * N columns, the gate in the first N and the up projection in the last N.
+  // The result is silu(gate) * up.
+  kSwiGlu,
+};
+
+// Fused 4 bits GEMV for a single row of A. The bias, if any, is added and `activation` applied before the output
+// is written. kSwiGlu isn't supported here, the caller runs LaunchMatMulNBitsEpilogue on the full GEMM output instead.
 template <class T>
 bool TryMatMul4Bits(
     T* output,
@@ -20,6 +32,20 @@ bool TryMatMul4Bits(
     int k,
     int block_size,
     int shared_mem_per_block,
+    cudaStream_t stream,
+    const T* bias = nullptr,
+    MatMulNBitsActivation activation = MatMulNBitsActivation::kNone);
+
+// Adds the bias and applies `activation` to the [m, n] GEMM output `input`, or to the [m, 2 * n] one for kSwiGlu,
+// writing the [m, n] result to `output`. `output` may alias `input` unless `activation` is kSwiGlu.
+template <class T>
+Status LaunchMatMulNBitsEpilogue(
+    T* output,
+    const T* input,
+    const T* bias,
+    int m,
+    int n,
+    MatMulNBitsActivation activation,
     cudaStream_t stream);
 
 }  // namespace cuda
@@ -10,6 +10,7 @@
 #include "core/common/safeint.h"
 #include "core/providers/cuda/cuda_kernel.h"
 #include "core/providers/cuda/shared_inc/fpgeneric.h"
+#include "contrib_ops/cuda/quantization/matmul_nbits.cuh"
 
 namespace onnxruntime {
 namespace contrib {
@@ -24,6 +25,18 @@ class MatMulNBits final : public CudaKernel {
     ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("N", &N_));
     ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("block_size", &block_size_));
     ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("bits", &nbits_));
+
+    const std::string activation = info.GetAttrOrDefault<std::string>("activation", "");
+    if (activation == "silu") {
+      activation_ = MatMulNBitsActivation::kSilu;
+    } else if (activation == "gelu") {
+      activation_ = MatMulNBitsActivation::kGelu;
+    } else if (activation == "swiglu") {
+      ORT_ENFORCE(N_ % 2 == 0, "N must be even for the swiglu activation, got ", N_);
+      activation_ = MatMulNBitsActivation::kSwiGlu;
+    } else {
+      ORT_ENFORCE(activation.empty(), "Unsupported MatMulNBits activation: ", activation);
+    }
   }
 
   Status ComputeInternal(OpKernelContext* context) const override;
@@ -34,6 +47,7 @@ class MatMulNBits final : public CudaKernel {
   int64_t block_size_;
   int64_t nbits_;
   bool column_wise_quant_blk_{true};
+  MatMulNBitsActivation activation_{MatMulNBitsActivation::kNone};
 };
 
 }  // namespace cuda
@@ -22,6 +22,8 @@ ONNX_OPERATOR_KERNEL_EX(
         .InputMemoryType(OrtMemTypeCPUInput, 2)    // 'min_length' needs to be on CPU
         .InputMemoryType(OrtMemTypeCPUInput, 3)    // 'repetition_penalty' needs to be on CPU
         .InputMemoryType(OrtMemTypeCPUInput, 6)    // 'custom_attention_mask' needs to be on CPU
+        .InputMemoryType(OrtMemTypeCPUInput, 7)    // 'vocab' needs to be on CPU
+        .InputMemoryType(OrtMemTypeCPUInput, 8)    // 'stop_strings' needs to be on CPU
         .OutputMemoryType(OrtMemTypeCPUOutput, 0)  // 'sequences' output on CPU
         .TypeConstraint("T", {DataTypeImpl::GetTensorType<float>(),
                               DataTypeImpl::GetTensorType<MLFloat16>()}),
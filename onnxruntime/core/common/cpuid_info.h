@@ -29,6 +29,7 @@ class CPUIDInfo {
   // ARM
   bool HasArmNeonDot() const { return has_arm_neon_dot_; }
   bool HasArmNeon_I8MM() const { return has_arm_neon_i8mm_; }
+  bool HasArmSVE() const { return has_arm_sve_; }
   bool HasArmSVE_I8MM() const { return has_arm_sve_i8mm_; }
   bool HasArmNeon_BF16() const { return has_arm_neon_bf16_; }
 
@@ -88,6 +89,13 @@ class CPUIDInfo {
     return is_armv8_narrow_ld_[coreIdx];
   }
 
+  /**
+   * @brief Identifies the kind of core running the current thread on hybrid CPUs, i.e. the core type
+   *        (performance or efficient) on x86 and the micro-architecture on ARM
+   * @return class of the current core, -1 if the CPU isn't hybrid or the class cannot be determined
+   */
+  int32_t GetCurrentCoreClass() const;
+
   bool HasFp16VectorAcceleration() const {
     return has_fp16_;
   }
@@ -104,6 +112,7 @@ class CPUIDInfo {
   bool has_sse3_{false};
   bool has_sse4_1_{false};
   bool is_hybrid_{false};
+  bool has_hybrid_core_type_{false};  // CPUID leaf 0x1A is available
 
   std::vector<uint32_t> core_uarchs_;  // micro-arch of each core
 
@@ -115,6 +124,7 @@ class CPUIDInfo {
   bool has_arm_neon_dot_{false};
   bool has_fp16_{false};
   bool has_arm_neon_i8mm_{false};
+  bool has_arm_sve_{false};
   bool has_arm_sve_i8mm_{false};
   bool has_arm_neon_bf16_{false};
 
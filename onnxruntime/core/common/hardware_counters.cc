@@ -0,0 +1,195 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/hardware_counters.h"
+
+#include <memory>
+#include <sstream>
+
+#include "core/common/common.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#elif defined(_WIN32)
+#include <Windows.h>
+#endif
+
+namespace onnxruntime {
+namespace profiling {
+
+namespace {
+
+// bytes transferred from memory per cache miss
+constexpr uint64_t kCacheLineBytes = 64;
+
+#if defined(__linux__)
+// The counters of a thread, read with a single read() of the group leader.
+class PerfEventGroup {
+ public:
+  explicit PerfEventGroup(HardwareCounterMask mask) {
+    static constexpr uint64_t configs[HW_COUNTER_MAX] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_REFERENCES,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES};
+
+    for (int counter = 0; counter < HW_COUNTER_MAX; ++counter) {
+      if ((mask & (1u << counter)) == 0) {
+        continue;
+      }
+
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = configs[counter];
+      attr.read_format = PERF_FORMAT_GROUP;
+      // user space only, which the default perf_event_paranoid level allows
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+
+      // this thread on any CPU
+      const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader_fd_, 0));
+      if (fd < 0) {
+        continue;
+      }
+      if (leader_fd_ < 0) {
+        leader_fd_ = fd;
+      }
+      fds_[num_counters_] = fd;
+      counters_[num_counters_++] = counter;
+      available_ |= 1u << counter;
+    }
+  }
+
+  ~PerfEventGroup() {
+    for (size_t i = 0; i < num_counters_; ++i) {
+      close(fds_[i]);
+    }
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PerfEventGroup);
+
+  HardwareCounterMask Read(HardwareCounterValues& values) const {
+    if (leader_fd_ < 0) {
+      return 0;
+    }
+
+    // number of counters followed by their values in the order they were opened
+    uint64_t buffer[1 + HW_COUNTER_MAX];
+    const auto size = static_cast<ssize_t>((1 + num_counters_) * sizeof(uint64_t));
+    if (read(leader_fd_, buffer, sizeof(buffer)) != size) {
+      return 0;
+    }
+    for (size_t i = 0; i < num_counters_; ++i) {
+      values[counters_[i]] = buffer[1 + i];
+    }
+    return available_;
+  }
+
+ private:
+  int leader_fd_{-1};
+  size_t num_counters_{0};
+  std::array<int, HW_COUNTER_MAX> fds_{};
+  std::array<int, HW_COUNTER_MAX> counters_{};
+  HardwareCounterMask available_{0};
+};
+#endif
+
+}  // namespace
+
+Status ParseHardwareCounters(const std::string& names, HardwareCounterMask& mask) {
+  mask = 0;
+  std::istringstream ss(names);
+  std::string name;
+  while (std::getline(ss, name, ',')) {
+    if (name.empty()) {
+      continue;
+    }
+    int counter = 0;
+    while (counter < HW_COUNTER_MAX && name != hardware_counter_names_[counter]) {
+      ++counter;
+    }
+    ORT_RETURN_IF(counter == HW_COUNTER_MAX, "Unknown hardware counter: ", name);
+    mask |= 1u << counter;
+  }
+  return Status::OK();
+}
+
+HardwareCounterMask ReadHardwareCounters(HardwareCounterMask mask, HardwareCounterValues& values) {
+  if (mask == 0) {
+    return 0;
+  }
+#if defined(__linux__)
+  // reopened if the thread is asked for different counters, e.g. by another session
+  thread_local std::unique_ptr<PerfEventGroup> group;
+  thread_local HardwareCounterMask group_mask = 0;
+  if (!group || group_mask != mask) {
+    group.reset();
+    group = std::make_unique<PerfEventGroup>(mask);
+    group_mask = mask;
+  }
+  return group->Read(values);
+#elif defined(_WIN32)
+  if ((mask & (1u << HW_CPU_CYCLES)) == 0) {
+    return 0;
+  }
+  ULONG64 cycles = 0;
+  if (!QueryThreadCycleTime(GetCurrentThread(), &cycles)) {
+    return 0;
+  }
+  values[HW_CPU_CYCLES] = cycles;
+  return 1u << HW_CPU_CYCLES;
+#else
+  ORT_UNUSED_PARAMETER(values);
+  return 0;
+#endif
+}
+
+void AccumulateHardwareCounters(const HardwareCounterValues& begin, const HardwareCounterValues& end,
+                                HardwareCounterValues& sum) {
+  for (size_t i = 0; i < sum.size(); ++i) {
+    sum[i] += end[i] - begin[i];
+  }
+}
+
+std::string HardwareCountersToJson(HardwareCounterMask mask, const HardwareCounterValues& counts,
+                                   long long duration_us) {
+  const auto has = [mask](HardwareCounter counter) { return (mask & (1u << counter)) != 0; };
+
+  std::ostringstream ss;
+  ss << "{";
+  const char* separator = "";
+  for (int counter = 0; counter < HW_COUNTER_MAX; ++counter) {
+    if (has(static_cast<HardwareCounter>(counter))) {
+      ss << separator << "\"" << hardware_counter_names_[counter] << "\": " << counts[counter];
+      separator = ", ";
+    }
+  }
+
+  if (has(HW_CPU_CYCLES) && has(HW_INSTRUCTIONS) && counts[HW_CPU_CYCLES] > 0) {
+    ss << separator << "\"ipc\": "
+       << static_cast<double>(counts[HW_INSTRUCTIONS]) / static_cast<double>(counts[HW_CPU_CYCLES]);
+    separator = ", ";
+  }
+  if (has(HW_CACHE_REFERENCES) && has(HW_CACHE_MISSES) && counts[HW_CACHE_REFERENCES] > 0) {
+    ss << separator << "\"cache_miss_rate\": "
+       << static_cast<double>(counts[HW_CACHE_MISSES]) / static_cast<double>(counts[HW_CACHE_REFERENCES]);
+    separator = ", ";
+  }
+  if (has(HW_CACHE_MISSES) && duration_us > 0) {
+    // bytes per nanosecond is GB/s
+    ss << separator << "\"memory_bandwidth_gbps\": "
+       << static_cast<double>(counts[HW_CACHE_MISSES] * kCacheLineBytes) / (static_cast<double>(duration_us) * 1000.0);
+  }
+  ss << "}";
+  return ss.str();
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
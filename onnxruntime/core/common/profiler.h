@@ -9,6 +9,7 @@
 #include <iostream>
 #include <tuple>
 
+#include "core/common/hardware_counters.h"
 #include "core/common/profiler_common.h"
 #include "core/common/logging/logging.h"
 #include "core/platform/ort_mutex.h"
@@ -60,6 +61,17 @@ class Profiler {
   bool IsEnabled() const {
     return enabled_;
   }
+  /*
+  Hardware counters to record around each kernel, none by default.
+  */
+  HardwareCounterMask GetHardwareCounters() const {
+    return hardware_counters_;
+  }
+
+  void SetHardwareCounters(HardwareCounterMask hardware_counters) {
+    hardware_counters_ = hardware_counters;
+  }
+
   /*
   Return the stored start time of profiler.
   On some platforms, this timer may not be as precise as nanoseconds
@@ -149,6 +161,7 @@ class Profiler {
   Events events_;
   bool max_events_reached{false};
   bool profile_with_logger_{false};
+  HardwareCounterMask hardware_counters_{0};
   const size_t max_num_events_{global_max_num_events_.load()};
 
 #ifdef ENABLE_STATIC_PROFILER_INSTANCE
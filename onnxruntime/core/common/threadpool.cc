@@ -13,6 +13,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 
@@ -63,8 +64,9 @@ ThreadPoolProfiler::~ThreadPoolProfiler() {
   enabled_ = false;
 }
 
-void ThreadPoolProfiler::Start() {
+void ThreadPoolProfiler::Start(profiling::HardwareCounterMask hardware_counters) {
   enabled_ = true;
+  hardware_counters_ = hardware_counters;
 }
 
 ThreadPoolProfiler::MainThreadStat& ThreadPoolProfiler::GetMainThreadStat() {
@@ -202,8 +204,22 @@ void ThreadPoolProfiler::LogThreadId(int thread_idx) {
   child_thread_stats_[thread_idx].thread_id_ = std::this_thread::get_id();
 }
 
+void ThreadPoolProfiler::LogRunStart(int thread_idx) {
+  if (enabled_ && hardware_counters_ != 0) {
+    auto& stat = child_thread_stats_[thread_idx];
+    stat.hardware_counters_read_ = profiling::ReadHardwareCounters(hardware_counters_, stat.hardware_counters_begin_);
+  }
+}
+
 void ThreadPoolProfiler::LogRun(int thread_idx) {
   if (enabled_) {
+    if (hardware_counters_ != 0 && child_thread_stats_[thread_idx].hardware_counters_read_ != 0) {
+      auto& stat = child_thread_stats_[thread_idx];
+      profiling::HardwareCounterValues end{};
+      if (profiling::ReadHardwareCounters(hardware_counters_, end) == stat.hardware_counters_read_) {
+        profiling::AccumulateHardwareCounters(stat.hardware_counters_begin_, end, stat.hardware_counters_sum_);
+      }
+    }
     child_thread_stats_[thread_idx].num_run_++;
     auto now = Clock::now();
     if (child_thread_stats_[thread_idx].core_ < 0 ||
@@ -235,8 +251,14 @@ std::string ThreadPoolProfiler::DumpChildThreadStat() {
   for (int i = 0; i < num_threads_; ++i) {
     ss << "\"" << child_thread_stats_[i].thread_id_ << "\": {"
        << "\"num_run\": " << child_thread_stats_[i].num_run_ << ", "
-       << "\"core\": " << child_thread_stats_[i].core_ << "}"
-       << (i == num_threads_ - 1 ? "" : ",");
+       << "\"core\": " << child_thread_stats_[i].core_;
+    if (child_thread_stats_[i].hardware_counters_read_ != 0) {
+      ss << ", \"hardware_counters\": "
+         << profiling::HardwareCountersToJson(child_thread_stats_[i].hardware_counters_read_,
+                                              child_thread_stats_[i].hardware_counters_sum_);
+      child_thread_stats_[i].hardware_counters_sum_ = {};
+    }
+    ss << "}" << (i == num_threads_ - 1 ? "" : ",");
   }
   return ss.str();
 }
@@ -369,6 +391,96 @@ class alignas(CACHE_LINE_BYTES) LoopCounter {
 #pragma warning(pop) /* Padding added in LoopCounterShard, LoopCounter */
 #endif
 
+// Weights of the core classes (CPUIDInfo::GetCurrentCoreClass) of a hybrid cpu, as a fraction of kFullWeight.
+// The fastest class has kFullWeight, and a class running at half its speed converges to kFullWeight / 2.
+//
+// Each loop records the iterations run and the time spent per class, and once it completes the throughput
+// of every class relative to the fastest one in that loop is folded into the weights with an exponential
+// moving average.  Comparing classes within a loop keeps the weights independent of the cost of the loops.
+class ThreadPool::HybridCoreWeights {
+ public:
+  static constexpr int kMaxClasses = 4;
+  static constexpr int32_t kFullWeight = 1024;
+  static constexpr int32_t kMinWeight = kFullWeight / 8;
+
+  struct LoopSample {
+    std::atomic<uint64_t> iterations{0};
+    std::atomic<uint64_t> nanoseconds{0};
+  };
+  using LoopSamples = std::array<LoopSample, kMaxClasses>;
+
+  HybridCoreWeights() {
+    for (int i = 0; i < kMaxClasses; i++) {
+      classes_[i].store(-1, std::memory_order_relaxed);
+      weights_[i].store(kFullWeight, std::memory_order_relaxed);
+    }
+  }
+
+  // Returns the slot of core_class, registering it on first use.  Returns -1 if core_class is -1 or
+  // all the slots are used by other classes.
+  int Slot(int32_t core_class) {
+    if (core_class < 0) {
+      return -1;
+    }
+    for (int i = 0; i < kMaxClasses; i++) {
+      int32_t c = classes_[i].load(std::memory_order_relaxed);
+      if (c == -1 && classes_[i].compare_exchange_strong(c, core_class, std::memory_order_relaxed)) {
+        return i;
+      }
+      if (c == core_class) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  // Scales a block size by the weight of the slot, keeping at least one iteration.
+  std::ptrdiff_t Scale(std::ptrdiff_t block_size, int slot) const {
+    if (slot < 0) {
+      return block_size;
+    }
+    const int32_t weight = weights_[slot].load(std::memory_order_relaxed);
+    return std::max<std::ptrdiff_t>(1, (block_size * weight) / kFullWeight);
+  }
+
+  void Record(LoopSamples& samples, int slot, uint64_t iterations, uint64_t nanoseconds) const {
+    if (slot >= 0 && iterations > 0) {
+      samples[slot].iterations.fetch_add(iterations, std::memory_order_relaxed);
+      samples[slot].nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    }
+  }
+
+  void Update(const LoopSamples& samples) {
+    std::array<double, kMaxClasses> throughput{};
+    double fastest = 0;
+    int num_sampled = 0;
+    for (int i = 0; i < kMaxClasses; i++) {
+      const uint64_t iterations = samples[i].iterations.load(std::memory_order_relaxed);
+      const uint64_t nanoseconds = samples[i].nanoseconds.load(std::memory_order_relaxed);
+      if (iterations > 0 && nanoseconds > 0) {
+        throughput[i] = static_cast<double>(iterations) / static_cast<double>(nanoseconds);
+        fastest = std::max(fastest, throughput[i]);
+        num_sampled++;
+      }
+    }
+    // Nothing to compare against unless at least two classes ran the loop.
+    if (num_sampled < 2) {
+      return;
+    }
+    for (int i = 0; i < kMaxClasses; i++) {
+      if (throughput[i] > 0) {
+        const int32_t sample = static_cast<int32_t>(kFullWeight * throughput[i] / fastest);
+        const int32_t weight = weights_[i].load(std::memory_order_relaxed);
+        weights_[i].store(std::clamp((3 * weight + sample) / 4, kMinWeight, kFullWeight), std::memory_order_relaxed);
+      }
+    }
+  }
+
+ private:
+  std::array<std::atomic<int32_t>, kMaxClasses> classes_;
+  std::array<std::atomic<int32_t>, kMaxClasses> weights_;
+};
+
 ThreadPool::ThreadPool(Env* env,
                        const ThreadOptions& thread_options,
                        const NAME_CHAR_TYPE* name,
@@ -396,7 +508,23 @@ ThreadPool::ThreadPool(Env* env,
                                                 *env,
                                                 thread_options_);
     underlying_threadpool_ = extended_eigen_threadpool_.get();
+
+    if (force_hybrid_ || CPUIDInfo::GetCPUIDInfo().IsHybrid()) {
+      hybrid_core_weights_ = std::make_unique<HybridCoreWeights>();
+    }
+  }
+}
+
+int ThreadPool::CurrentCoreSlot() const {
+  if (!hybrid_core_weights_) {
+    return -1;
   }
+  int32_t core_class = CPUIDInfo::GetCPUIDInfo().GetCurrentCoreClass();
+  // A forced hybrid pool on a cpu with a single kind of cores treats all of them as one class.
+  if (core_class == -1 && force_hybrid_) {
+    core_class = 0;
+  }
+  return hybrid_core_weights_->Slot(core_class);
 }
 
 ThreadPool::~ThreadPool() = default;
@@ -415,12 +543,73 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
     return;
   }
 
+  // Loops of a run that missed its deadline are not split into shards, see DeadlineScope.
+  const Deadline deadline = CurrentDeadline();
+  const bool has_deadline = deadline != Deadline::max();
+  if (has_deadline && std::chrono::steady_clock::now() >= deadline) {
+    fn(0, total);
+    return;
+  }
+
+  // Helping threads yield to the loops of higher priority classes at block boundaries, see Priority,
+  // and leave the loop once its deadline has passed.
+  const Priority priority = CurrentPriority();
+  auto& num_running_loops = num_running_loops_[static_cast<int>(priority)];
+  num_running_loops.fetch_add(1, std::memory_order_relaxed);
+  auto loop_done = gsl::finally([&num_running_loops]() { num_running_loops.fetch_sub(1, std::memory_order_relaxed); });
+  auto should_yield = [this, priority, has_deadline, deadline](unsigned idx) {
+    return idx != 0 && (IsHigherPriorityLoopRunning(priority) ||
+                        (has_deadline && std::chrono::steady_clock::now() >= deadline));
+  };
+
+  // On hybrid cpus the threads on slower cores claim smaller blocks, so the loop doesn't wait on them at its end.
+  HybridCoreWeights::LoopSamples samples;
+  auto update_weights = gsl::finally([this, &samples]() {
+    if (hybrid_core_weights_) {
+      hybrid_core_weights_->Update(samples);
+    }
+  });
+
+  // Looks up the core class of the thread running a work item, and records the iterations the work item ran
+  // and the time it took for that class.
+  class CoreClassTimer {
+   public:
+    CoreClassTimer(ThreadPool& tp, HybridCoreWeights::LoopSamples& samples)
+        : weights_(tp.hybrid_core_weights_.get()), samples_(samples), slot_(tp.CurrentCoreSlot()) {
+      if (slot_ >= 0) {
+        start_ = std::chrono::steady_clock::now();
+      }
+    }
+
+    ~CoreClassTimer() {
+      if (slot_ >= 0) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+        weights_->Record(samples_, slot_, iterations_, static_cast<uint64_t>(elapsed.count()));
+      }
+    }
+
+    std::ptrdiff_t Scale(std::ptrdiff_t block_size) const {
+      return slot_ >= 0 ? weights_->Scale(block_size, slot_) : block_size;
+    }
+
+    void Count(uint64_t iterations) {
+      iterations_ += iterations;
+    }
+
+   private:
+    HybridCoreWeights* weights_;
+    HybridCoreWeights::LoopSamples& samples_;
+    const int slot_;
+    std::chrono::steady_clock::time_point start_;
+    uint64_t iterations_ = 0;
+  };
+
   auto d_of_p = DegreeOfParallelism(this);
   if (thread_options_.dynamic_block_base_ <= 0) {
     // Split the work across threads in the pool.  Each work item will run a loop claiming iterations,
     // hence we need at most one for each thread, even if the number of blocks of iterations is larger.
     auto num_blocks = total / block_size;
-    auto num_threads_inc_main = NumThreads() + 1;
+    auto num_threads_inc_main = MaxWorkItems();
     int num_work_items = static_cast<int>(std::min(static_cast<std::ptrdiff_t>(num_threads_inc_main), num_blocks));
     assert(num_work_items > 0);
 
@@ -429,9 +618,13 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
       unsigned my_home_shard = lc.GetHomeShard(idx);
       unsigned my_shard = my_home_shard;
       uint64_t my_iter_start, my_iter_end;
-      while (lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end, block_size)) {
+      CoreClassTimer timer(*this, samples);
+      const std::ptrdiff_t my_block_size = timer.Scale(block_size);
+      while (!should_yield(idx) &&
+             lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end, my_block_size)) {
         fn(static_cast<std::ptrdiff_t>(my_iter_start),
            static_cast<std::ptrdiff_t>(my_iter_end));
+        timer.Count(my_iter_end - my_iter_start);
       }
     };
     // Run the work in the thread pool (and in the current thread).  Synchronization with helping
@@ -444,22 +637,24 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
     alignas(CACHE_LINE_BYTES) std::atomic<std::ptrdiff_t> left{total};
     LoopCounter lc(total, d_of_p, base_block_size);
     std::function<void(unsigned)> run_work = [&](unsigned idx) {
-      std::ptrdiff_t b = base_block_size;
+      CoreClassTimer timer(*this, samples);
+      std::ptrdiff_t b = timer.Scale(base_block_size);
       unsigned my_home_shard = lc.GetHomeShard(idx);
       unsigned my_shard = my_home_shard;
       uint64_t my_iter_start, my_iter_end;
-      while (lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end, b)) {
+      while (!should_yield(idx) && lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end, b)) {
         fn(static_cast<std::ptrdiff_t>(my_iter_start),
            static_cast<std::ptrdiff_t>(my_iter_end));
+        timer.Count(my_iter_end - my_iter_start);
         auto todo = left.fetch_sub(static_cast<std::ptrdiff_t>(my_iter_end - my_iter_start), std::memory_order_relaxed);
         if (b > 1) {
-          b = static_cast<std::ptrdiff_t>(std::max(1LL, std::llroundl(static_cast<long double>(todo) / num_of_blocks)));
+          b = timer.Scale(static_cast<std::ptrdiff_t>(std::max(1LL, std::llroundl(static_cast<long double>(todo) / num_of_blocks))));
         }
       }
     };
     // Distribute task among all threads in the pool, reduce number of work items if
     // num_of_blocks is smaller than number of threads.
-    RunInParallel(run_work, std::min(NumThreads() + 1, num_of_blocks), base_block_size);
+    RunInParallel(run_work, std::min(MaxWorkItems(), num_of_blocks), base_block_size);
   }
 }
 
@@ -479,9 +674,9 @@ void ThreadPool::Schedule(std::function<void()> fn) {
   }
 }
 
-void ThreadPool::StartProfiling() {
+void ThreadPool::StartProfiling(profiling::HardwareCounterMask hardware_counters) {
   if (underlying_threadpool_) {
-    underlying_threadpool_->StartProfiling();
+    underlying_threadpool_->StartProfiling(hardware_counters);
   }
 }
 
@@ -495,29 +690,102 @@ std::string ThreadPool::StopProfiling() {
 
 namespace {
 thread_local std::optional<ThreadPoolParallelSection> current_parallel_section;
+thread_local const ThreadPool* current_parallel_section_pool = nullptr;
+thread_local ThreadPool::Priority current_priority = ThreadPool::Priority::kNormal;
+thread_local ThreadPool::Deadline current_deadline = ThreadPool::Deadline::max();
+thread_local int current_max_degree_of_parallelism = 0;
+}  // namespace
+
+ThreadPool::PriorityScope::PriorityScope(Priority priority) : previous_priority_(current_priority) {
+  current_priority = priority;
+}
+
+ThreadPool::PriorityScope::~PriorityScope() {
+  current_priority = previous_priority_;
+}
+
+ThreadPool::Priority ThreadPool::CurrentPriority() {
+  return current_priority;
+}
+
+ThreadPool::DeadlineScope::DeadlineScope(Deadline deadline) : previous_deadline_(current_deadline) {
+  current_deadline = deadline;
+}
+
+ThreadPool::DeadlineScope::~DeadlineScope() {
+  current_deadline = previous_deadline_;
+}
+
+ThreadPool::Deadline ThreadPool::CurrentDeadline() {
+  return current_deadline;
+}
+
+ThreadPool::MaxDegreeOfParallelismScope::MaxDegreeOfParallelismScope(int max_degree_of_parallelism)
+    : previous_max_degree_of_parallelism_(current_max_degree_of_parallelism) {
+  current_max_degree_of_parallelism = max_degree_of_parallelism;
+}
+
+ThreadPool::MaxDegreeOfParallelismScope::~MaxDegreeOfParallelismScope() {
+  current_max_degree_of_parallelism = previous_max_degree_of_parallelism_;
+}
+
+int ThreadPool::CurrentMaxDegreeOfParallelism() {
+  return current_max_degree_of_parallelism;
+}
+
+bool ThreadPool::TryParsePriority(const std::string& str, Priority& priority) {
+  if (str == "low") {
+    priority = Priority::kLow;
+  } else if (str == "normal") {
+    priority = Priority::kNormal;
+  } else if (str == "high") {
+    priority = Priority::kHigh;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool ThreadPool::IsHigherPriorityLoopRunning(Priority priority) const {
+  for (int p = static_cast<int>(priority) + 1; p < kNumPriorities; ++p) {
+    if (num_running_loops_[p].load(std::memory_order_relaxed) > 0) {
+      return true;
+    }
+  }
+  return false;
 }
 
 ThreadPool::ParallelSection::ParallelSection(ThreadPool* tp) {
-  ORT_ENFORCE(!current_parallel_section.has_value(), "Nested parallelism not supported");
   ORT_ENFORCE(!ps_);
   tp_ = tp;
-  if (tp && tp->underlying_threadpool_) {
+  // A section entered while the thread already leads one, e.g. by a kernel running in a section that spans the
+  // whole Run, has no effect: the loops of the outer section's pool keep running in the outer section, and the
+  // loops of other pools run on their own.
+  if (tp && tp->underlying_threadpool_ && !current_parallel_section.has_value()) {
     current_parallel_section.emplace();
+    current_parallel_section_pool = tp;
     ps_ = &*current_parallel_section;
     tp_->underlying_threadpool_->StartParallelSection(*ps_);
   }
 }
 
+ThreadPool::ParallelSection::ParallelSection(ThreadPool* tp, int spin_duration_us) : ParallelSection(tp) {
+  if (ps_) {
+    ps_->spin_duration_us = spin_duration_us;
+  }
+}
+
 ThreadPool::ParallelSection::~ParallelSection() {
-  if (current_parallel_section) {
+  if (ps_) {
     tp_->underlying_threadpool_->EndParallelSection(*ps_);
     current_parallel_section.reset();
+    current_parallel_section_pool = nullptr;
   }
 }
 
 void ThreadPool::RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) {
   if (underlying_threadpool_) {
-    if (current_parallel_section.has_value()) {
+    if (current_parallel_section.has_value() && current_parallel_section_pool == this) {
       underlying_threadpool_->RunInParallelSection(*current_parallel_section,
                                                    std::move(fn),
                                                    n, block_size);
@@ -546,6 +814,11 @@ bool ThreadPool::ShouldParallelizeLoop(const std::ptrdiff_t num_iterations,
     return false;
   }
 
+  // Nor loops capped to the calling thread, see MaxDegreeOfParallelismScope.
+  if (CurrentMaxDegreeOfParallelism() == 1) {
+    return false;
+  }
+
   return true;
 }
 
@@ -637,21 +910,33 @@ bool ThreadPool::ShouldParallelize(const concurrency::ThreadPool* tp) {
 
 int ThreadPool::DegreeOfParallelism(const concurrency::ThreadPool* tp) {
   // When not using OpenMP, we parallelize over the N threads created by the pool
-  // tp, plus 1 for the thread entering a loop.
+  // tp, plus 1 for the thread entering a loop, unless the loops of the thread are capped to fewer.
   if (tp) {
+    const int num_threads = tp->MaxWorkItems();
     if (tp->force_hybrid_ || CPUIDInfo::GetCPUIDInfo().IsHybrid()) {
-      return ((tp->NumThreads() + 1)) * TaskGranularityFactor;
+      return num_threads * TaskGranularityFactor;
     } else {
-      return ((tp->NumThreads() + 1));
+      return num_threads;
     }
   } else {
     return 1;
   }
 }
 
-void ThreadPool::StartProfiling(concurrency::ThreadPool* tp) {
+int ThreadPool::MaxParallelThreads(const concurrency::ThreadPool* tp) {
+  return tp ? tp->MaxWorkItems() : 1;
+}
+
+int ThreadPool::MaxWorkItems() const {
+  const int max_degree_of_parallelism = CurrentMaxDegreeOfParallelism();
+  const int num_threads_inc_main = NumThreads() + 1;
+  return max_degree_of_parallelism > 0 ? std::min(num_threads_inc_main, max_degree_of_parallelism)
+                                       : num_threads_inc_main;
+}
+
+void ThreadPool::StartProfiling(concurrency::ThreadPool* tp, profiling::HardwareCounterMask hardware_counters) {
   if (tp) {
-    tp->StartProfiling();
+    tp->StartProfiling(hardware_counters);
   }
 }
 
@@ -686,6 +971,20 @@ int ThreadPool::NumThreads() const {
 
 // Return ID of the current thread within this pool.  Returns -1 for a thread outside the
 // current pool.
+std::vector<int> ThreadPool::GetNumaNodes(const ThreadPool* tp) {
+  if (tp == nullptr || tp->extended_eigen_threadpool_ == nullptr) {
+    return {};
+  }
+  return tp->extended_eigen_threadpool_->NumaNodes();
+}
+
+int ThreadPool::CurrentThreadNumaNode(const ThreadPool* tp) {
+  if (tp == nullptr || tp->extended_eigen_threadpool_ == nullptr) {
+    return -1;
+  }
+  return tp->extended_eigen_threadpool_->CurrentThreadNumaNode();
+}
+
 int ThreadPool::CurrentThreadId() const {
   if (underlying_threadpool_) {
     return underlying_threadpool_->CurrentThreadId();
@@ -2,9 +2,13 @@
 // Licensed under the MIT License.
 
 #include "core/eager/ort_kernel_invoker.h"
+
+#include <algorithm>
+
 #include "core/optimizer/optimizer_execution_frame.h"
 #include "core/common/logging/logging.h"
 #include "core/graph/model.h"
+#include "core/framework/config_options.h"
 #include "core/framework/op_kernel.h"
 #include "core/session/ort_env.h"
 #include "core/graph/constants.h"
@@ -13,84 +17,165 @@ namespace onnxruntime {
 
 #define ORT_EAGER_ONNX_OPSET_VERSION 14
 
-common::Status ORTInvoker::Invoke(const std::string& op_name,
-                                  // optional inputs / outputs?
-                                  const std::vector<OrtValue>& inputs,
-                                  std::vector<OrtValue>& outputs,
-                                  const NodeAttributes* attributes,
-                                  const std::string& domain,
-                                  const int version) {
+struct ORTInvoker::CachedKernel {
+  std::unique_ptr<Model> model;
+  // referenced by info
+  std::function<bool(const std::string&)> is_sparse_initializer_func;
+  std::unique_ptr<OptimizerExecutionFrame::Info> info;
+  std::unique_ptr<const OpKernel> kernel;
+  std::vector<int> feed_mlvalue_idxs;
+  std::vector<int> fetch_mlvalue_idxs;
+
+  // the values of the frame, reused by the calls that don't run concurrently
+  std::mutex value_storage_mutex;
+  InlinedVector<OrtValue> value_storage;
+};
+
+ORTInvoker::~ORTInvoker() = default;
+
+// The kernel only depends on the op, its attributes and the input types: the graph of the op has no shapes and the
+// inputs are fed rather than being constant initializers.
+static std::string GetKernelCacheKey(const std::string& op_name,
+                                     const std::vector<OrtValue>& inputs,
+                                     size_t num_outputs,
+                                     const NodeAttributes* attributes,
+                                     const std::string& domain,
+                                     const int version) {
+  std::string key;
+  key.append(domain).append(1, '\0').append(op_name).append(1, '\0');
+  key.append(std::to_string(version)).append(1, '\0').append(std::to_string(num_outputs)).append(1, '\0');
+  for (const auto& input : inputs) {
+    key.append(std::to_string(input.Get<Tensor>().GetElementType())).append(1, ',');
+  }
+
+  if (attributes != nullptr) {
+    std::vector<const std::string*> names;
+    names.reserve(attributes->size());
+    for (const auto& attribute : *attributes) {
+      names.push_back(&attribute.first);
+    }
+
+    std::sort(names.begin(), names.end(), [](const std::string* a, const std::string* b) { return *a < *b; });
+    for (const auto* name : names) {
+      key.append(1, '\0').append(*name).append(1, '\0').append(attributes->at(*name).SerializeAsString());
+    }
+  }
+
+  return key;
+}
+
+common::Status ORTInvoker::GetOrCreateKernel(const std::string& op_name,
+                                             const std::vector<OrtValue>& inputs,
+                                             size_t num_outputs,
+                                             const NodeAttributes* attributes,
+                                             const std::string& domain,
+                                             const int version,
+                                             CachedKernel*& cached_kernel) {
+  std::string key = GetKernelCacheKey(op_name, inputs, num_outputs, attributes, domain, version);
+  std::lock_guard<std::mutex> lock(kernel_cache_mutex_);
+  auto it = kernel_cache_.find(key);
+  if (it != kernel_cache_.end()) {
+    cached_kernel = it->second.get();
+    return Status::OK();
+  }
+
   std::unordered_map<std::string, int> domain_version_map = {{kOnnxDomain, ORT_EAGER_ONNX_OPSET_VERSION},
                                                              {kMSDomain, 1}};
+  auto entry = std::make_unique<CachedKernel>();
   // create a graph
-  Model model("test",
-              false,
-              ModelMetaData(),
-              ORT_TSTR(""),
-              custom_op_registries_,
-              domain_version_map,
-              {},
-              logger_);
+  entry->model = std::make_unique<Model>("test",
+                                         false,
+                                         ModelMetaData(),
+                                         ORT_TSTR(""),
+                                         custom_op_registries_,
+                                         domain_version_map,
+                                         std::vector<ONNX_NAMESPACE::FunctionProto>{},
+                                         logger_);
 
   std::vector<onnxruntime::NodeArg*> input_args;
   std::vector<onnxruntime::NodeArg*> output_args;
 
   input_args.reserve(inputs.size());
-  output_args.reserve(outputs.size());
+  output_args.reserve(num_outputs);
 
-  Graph& graph = model.MainGraph();
-  std::unordered_map<std::string, OrtValue> initializer_map;
+  Graph& graph = entry->model->MainGraph();
   size_t i = 0;
 
-  for (auto input : inputs) {
+  for (const auto& input : inputs) {
     std::string name = "I" + std::to_string(i++);
     const Tensor& input_tensor = input.Get<Tensor>();
     ONNX_NAMESPACE::TypeProto input_tensor_type;
     input_tensor_type.mutable_tensor_type()->set_elem_type(input_tensor.GetElementType());
     auto& arg = graph.GetOrCreateNodeArg(name, &input_tensor_type);
     input_args.push_back(&arg);
-    initializer_map[name] = input;
   }
 
-  for (i = 0; i < outputs.size(); ++i) {
+  for (i = 0; i < num_outputs; ++i) {
     auto& arg = graph.GetOrCreateNodeArg("O" + std::to_string(i), nullptr);
     output_args.push_back(&arg);
   }
 
   auto& node = graph.AddNode("node1", op_name, "eager mode node", input_args, output_args, attributes, domain);
+  graph.SetInputs(input_args);
   ORT_RETURN_IF_ERROR(graph.Resolve());
 
   node.SetExecutionProviderType(execution_provider_->Type());
-  std::vector<const Node*> frame_nodes{&node};
 
-  OptimizerExecutionFrame::Info info({&node}, initializer_map, graph.ModelPath(), *execution_provider_, [](std::string const&) { return false; });
+  entry->is_sparse_initializer_func = [](const std::string&) { return false; };
+  entry->info = std::make_unique<OptimizerExecutionFrame::Info>(
+      std::vector<const Node*>{&node}, std::unordered_map<std::string, OrtValue>{}, graph.ModelPath(),
+      *execution_provider_, entry->is_sparse_initializer_func);
   const KernelCreateInfo* kernel_create_info = nullptr;
-  ORT_RETURN_IF_ERROR(info.TryFindKernel(&node, &kernel_create_info));
+  ORT_RETURN_IF_ERROR(entry->info->TryFindKernel(&node, &kernel_create_info));
   if (!kernel_create_info) {
     ORT_THROW("Could not find kernel name:", op_name, ", domain:", domain, ", version:", version);
   }
-  // check whether the inputs are contiguous tensor
-  const auto& may_strided_inputs = kernel_create_info->kernel_def->MayStridedInput();
-  for (i = 0; i < inputs.size(); ++i) {
-    const Tensor& input_tensor = inputs[i].Get<Tensor>();
-    if (!input_tensor.IsContiguous() && std::find(may_strided_inputs.begin(), may_strided_inputs.end(),
-                                                  static_cast<int>(i)) == may_strided_inputs.end())
-      ORT_THROW("kernel name:", op_name, "'s ", i, "th input doesn't support non-contiguous tensor.");
-  }
 
-  auto kernel = info.CreateKernel(&node);
-  if (!kernel) {
+  static const ConfigOptions empty_config_options;
+  entry->kernel = entry->info->CreateKernel(&node, empty_config_options);
+  if (!entry->kernel) {
     ORT_THROW("Could not find kernel name:", op_name, ", domain:", domain, ", version:", version);
   }
 
-  std::vector<int> fetch_mlvalue_idxs;
+  for (const auto* node_in : node.InputDefs()) {
+    entry->feed_mlvalue_idxs.push_back(entry->info->GetMLValueIndex(node_in->Name()));
+  }
+
   for (const auto* node_out : node.OutputDefs()) {
-    fetch_mlvalue_idxs.push_back(info.GetMLValueIndex(node_out->Name()));
+    entry->fetch_mlvalue_idxs.push_back(entry->info->GetMLValueIndex(node_out->Name()));
+  }
+
+  cached_kernel = entry.get();
+  kernel_cache_.emplace(std::move(key), std::move(entry));
+  return Status::OK();
+}
+
+common::Status ORTInvoker::Invoke(const std::string& op_name,
+                                  // optional inputs / outputs?
+                                  const std::vector<OrtValue>& inputs,
+                                  std::vector<OrtValue>& outputs,
+                                  const NodeAttributes* attributes,
+                                  const std::string& domain,
+                                  const int version) {
+  CachedKernel* cached_kernel = nullptr;
+  ORT_RETURN_IF_ERROR(GetOrCreateKernel(op_name, inputs, outputs.size(), attributes, domain, version, cached_kernel));
+
+  // check whether the inputs are contiguous tensor
+  const auto& may_strided_inputs = cached_kernel->kernel->KernelDef().MayStridedInput();
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const Tensor& input_tensor = inputs[i].Get<Tensor>();
+    if (!input_tensor.IsContiguous() && std::find(may_strided_inputs.begin(), may_strided_inputs.end(),
+                                                  static_cast<int>(i)) == may_strided_inputs.end())
+      ORT_THROW("kernel name:", op_name, "'s ", i, "th input doesn't support non-contiguous tensor.");
   }
 
-  OptimizerExecutionFrame frame(info, fetch_mlvalue_idxs, outputs);
-  OpKernelContext op_kernel_context(&frame, kernel.get(), nullptr, nullptr, logger_);
-  ORT_RETURN_IF_ERROR(kernel->Compute(&op_kernel_context));
+  // reuse the values of the previous frame unless another call is using them
+  std::unique_lock<std::mutex> value_storage_lock(cached_kernel->value_storage_mutex, std::try_to_lock);
+  OptimizerExecutionFrame frame(*cached_kernel->info, cached_kernel->feed_mlvalue_idxs, inputs,
+                                cached_kernel->fetch_mlvalue_idxs, outputs,
+                                value_storage_lock.owns_lock() ? &cached_kernel->value_storage : nullptr);
+  OpKernelContext op_kernel_context(&frame, cached_kernel->kernel.get(), nullptr, nullptr, logger_);
+  ORT_RETURN_IF_ERROR(cached_kernel->kernel->Compute(&op_kernel_context));
 
   return frame.GetOutputs(outputs);
 }
@@ -105,6 +105,15 @@ struct OpIdKernelTypeStrArgsEntryBuilder;
 struct KernelTypeStrResolver;
 struct KernelTypeStrResolverBuilder;
 
+struct ValueAllocationPlan;
+struct ValueAllocationPlanBuilder;
+
+struct NodeReleaseList;
+struct NodeReleaseListBuilder;
+
+struct ExecutionPlan;
+struct ExecutionPlanBuilder;
+
 struct InferenceSession;
 struct InferenceSessionBuilder;
 
@@ -291,6 +300,39 @@ inline const char *EnumNameTensorDataType(TensorDataType e) {
   return EnumNamesTensorDataType()[index];
 }
 
+enum class TensorDataCompression : int8_t {
+  NONE = 0,
+  LZ4 = 1,
+  BYTE_SHUFFLE_LZ4 = 2,
+  MIN = NONE,
+  MAX = BYTE_SHUFFLE_LZ4
+};
+
+inline const TensorDataCompression (&EnumValuesTensorDataCompression())[3] {
+  static const TensorDataCompression values[] = {
+    TensorDataCompression::NONE,
+    TensorDataCompression::LZ4,
+    TensorDataCompression::BYTE_SHUFFLE_LZ4
+  };
+  return values;
+}
+
+inline const char * const *EnumNamesTensorDataCompression() {
+  static const char * const names[4] = {
+    "NONE",
+    "LZ4",
+    "BYTE_SHUFFLE_LZ4",
+    nullptr
+  };
+  return names;
+}
+
+inline const char *EnumNameTensorDataCompression(TensorDataCompression e) {
+  if (::flatbuffers::IsOutRange(e, TensorDataCompression::NONE, TensorDataCompression::BYTE_SHUFFLE_LZ4)) return "";
+  const size_t index = static_cast<size_t>(e);
+  return EnumNamesTensorDataCompression()[index];
+}
+
 enum class NodeType : int32_t {
   Primitive = 0,
   Fused = 1,
@@ -1314,7 +1356,8 @@ struct Tensor FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
     VT_DATA_TYPE = 10,
     VT_RAW_DATA = 12,
     VT_STRING_DATA = 14,
-    VT_EXTERNAL_DATA_OFFSET = 16
+    VT_EXTERNAL_DATA_OFFSET = 16,
+    VT_COMPRESSION = 18
   };
   const ::flatbuffers::String *name() const {
     return GetPointer<const ::flatbuffers::String *>(VT_NAME);
@@ -1337,6 +1380,9 @@ struct Tensor FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   int64_t external_data_offset() const {
     return GetField<int64_t>(VT_EXTERNAL_DATA_OFFSET, -1LL);
   }
+  onnxruntime::fbs::TensorDataCompression compression() const {
+    return static_cast<onnxruntime::fbs::TensorDataCompression>(GetField<int8_t>(VT_COMPRESSION, 0));
+  }
   bool Verify(::flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_NAME) &&
@@ -1352,6 +1398,7 @@ struct Tensor FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
            verifier.VerifyVector(string_data()) &&
            verifier.VerifyVectorOfStrings(string_data()) &&
            VerifyField<int64_t>(verifier, VT_EXTERNAL_DATA_OFFSET, 8) &&
+           VerifyField<int8_t>(verifier, VT_COMPRESSION, 1) &&
            verifier.EndTable();
   }
 };
@@ -1381,6 +1428,9 @@ struct TensorBuilder {
   void add_external_data_offset(int64_t external_data_offset) {
     fbb_.AddElement<int64_t>(Tensor::VT_EXTERNAL_DATA_OFFSET, external_data_offset, -1LL);
   }
+  void add_compression(onnxruntime::fbs::TensorDataCompression compression) {
+    fbb_.AddElement<int8_t>(Tensor::VT_COMPRESSION, static_cast<int8_t>(compression), 0);
+  }
   explicit TensorBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -1400,7 +1450,8 @@ inline ::flatbuffers::Offset<Tensor> CreateTensor(
     onnxruntime::fbs::TensorDataType data_type = onnxruntime::fbs::TensorDataType::UNDEFINED,
     ::flatbuffers::Offset<::flatbuffers::Vector<uint8_t>> raw_data = 0,
     ::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<::flatbuffers::String>>> string_data = 0,
-    int64_t external_data_offset = -1LL) {
+    int64_t external_data_offset = -1LL,
+    onnxruntime::fbs::TensorDataCompression compression = onnxruntime::fbs::TensorDataCompression::NONE) {
   TensorBuilder builder_(_fbb);
   builder_.add_external_data_offset(external_data_offset);
   builder_.add_string_data(string_data);
@@ -1409,6 +1460,7 @@ inline ::flatbuffers::Offset<Tensor> CreateTensor(
   builder_.add_dims(dims);
   builder_.add_doc_string(doc_string);
   builder_.add_name(name);
+  builder_.add_compression(compression);
   return builder_.Finish();
 }
 
@@ -1420,7 +1472,8 @@ inline ::flatbuffers::Offset<Tensor> CreateTensorDirect(
     onnxruntime::fbs::TensorDataType data_type = onnxruntime::fbs::TensorDataType::UNDEFINED,
     const std::vector<uint8_t> *raw_data = nullptr,
     const std::vector<::flatbuffers::Offset<::flatbuffers::String>> *string_data = nullptr,
-    int64_t external_data_offset = -1LL) {
+    int64_t external_data_offset = -1LL,
+    onnxruntime::fbs::TensorDataCompression compression = onnxruntime::fbs::TensorDataCompression::NONE) {
   auto name__ = name ? _fbb.CreateString(name) : 0;
   auto doc_string__ = doc_string ? _fbb.CreateString(doc_string) : 0;
   auto dims__ = dims ? _fbb.CreateVector<int64_t>(*dims) : 0;
@@ -1434,7 +1487,8 @@ inline ::flatbuffers::Offset<Tensor> CreateTensorDirect(
       data_type,
       raw_data__,
       string_data__,
-      external_data_offset);
+      external_data_offset,
+      compression);
 }
 
 struct SparseTensor FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
@@ -2971,12 +3025,351 @@ inline ::flatbuffers::Offset<KernelTypeStrResolver> CreateKernelTypeStrResolverD
       op_kernel_type_str_args__);
 }
 
+/// The allocation plan of an OrtValue, see AllocPlanPerValue in
+/// <repo root>/onnxruntime/core/framework/sequential_execution_plan.h
+struct ValueAllocationPlan FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef ValueAllocationPlanBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_ALLOC_KIND = 4,
+    VT_REUSED_BUFFER = 6,
+    VT_DEVICE_TYPE = 8,
+    VT_DEVICE_MEM_TYPE = 10,
+    VT_DEVICE_ID = 12,
+    VT_IS_STRIDED_TENSOR = 14,
+    VT_IS_VIEW = 16
+  };
+  int8_t alloc_kind() const {
+    return GetField<int8_t>(VT_ALLOC_KIND, 0);
+  }
+  int32_t reused_buffer() const {
+    return GetField<int32_t>(VT_REUSED_BUFFER, 0);
+  }
+  int8_t device_type() const {
+    return GetField<int8_t>(VT_DEVICE_TYPE, 0);
+  }
+  int8_t device_mem_type() const {
+    return GetField<int8_t>(VT_DEVICE_MEM_TYPE, 0);
+  }
+  int16_t device_id() const {
+    return GetField<int16_t>(VT_DEVICE_ID, 0);
+  }
+  bool is_strided_tensor() const {
+    return GetField<uint8_t>(VT_IS_STRIDED_TENSOR, 0) != 0;
+  }
+  bool is_view() const {
+    return GetField<uint8_t>(VT_IS_VIEW, 0) != 0;
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<int8_t>(verifier, VT_ALLOC_KIND, 1) &&
+           VerifyField<int32_t>(verifier, VT_REUSED_BUFFER, 4) &&
+           VerifyField<int8_t>(verifier, VT_DEVICE_TYPE, 1) &&
+           VerifyField<int8_t>(verifier, VT_DEVICE_MEM_TYPE, 1) &&
+           VerifyField<int16_t>(verifier, VT_DEVICE_ID, 2) &&
+           VerifyField<uint8_t>(verifier, VT_IS_STRIDED_TENSOR, 1) &&
+           VerifyField<uint8_t>(verifier, VT_IS_VIEW, 1) &&
+           verifier.EndTable();
+  }
+};
+
+struct ValueAllocationPlanBuilder {
+  typedef ValueAllocationPlan Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_alloc_kind(int8_t alloc_kind) {
+    fbb_.AddElement<int8_t>(ValueAllocationPlan::VT_ALLOC_KIND, alloc_kind, 0);
+  }
+  void add_reused_buffer(int32_t reused_buffer) {
+    fbb_.AddElement<int32_t>(ValueAllocationPlan::VT_REUSED_BUFFER, reused_buffer, 0);
+  }
+  void add_device_type(int8_t device_type) {
+    fbb_.AddElement<int8_t>(ValueAllocationPlan::VT_DEVICE_TYPE, device_type, 0);
+  }
+  void add_device_mem_type(int8_t device_mem_type) {
+    fbb_.AddElement<int8_t>(ValueAllocationPlan::VT_DEVICE_MEM_TYPE, device_mem_type, 0);
+  }
+  void add_device_id(int16_t device_id) {
+    fbb_.AddElement<int16_t>(ValueAllocationPlan::VT_DEVICE_ID, device_id, 0);
+  }
+  void add_is_strided_tensor(bool is_strided_tensor) {
+    fbb_.AddElement<uint8_t>(ValueAllocationPlan::VT_IS_STRIDED_TENSOR, static_cast<uint8_t>(is_strided_tensor), 0);
+  }
+  void add_is_view(bool is_view) {
+    fbb_.AddElement<uint8_t>(ValueAllocationPlan::VT_IS_VIEW, static_cast<uint8_t>(is_view), 0);
+  }
+  explicit ValueAllocationPlanBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<ValueAllocationPlan> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<ValueAllocationPlan>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<ValueAllocationPlan> CreateValueAllocationPlan(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    int8_t alloc_kind = 0,
+    int32_t reused_buffer = 0,
+    int8_t device_type = 0,
+    int8_t device_mem_type = 0,
+    int16_t device_id = 0,
+    bool is_strided_tensor = false,
+    bool is_view = false) {
+  ValueAllocationPlanBuilder builder_(_fbb);
+  builder_.add_reused_buffer(reused_buffer);
+  builder_.add_device_id(device_id);
+  builder_.add_is_view(is_view);
+  builder_.add_is_strided_tensor(is_strided_tensor);
+  builder_.add_device_mem_type(device_mem_type);
+  builder_.add_device_type(device_type);
+  builder_.add_alloc_kind(alloc_kind);
+  return builder_.Finish();
+}
+
+/// The indices in ExecutionPlan.release_actions of the values to release after a node ran
+struct NodeReleaseList FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef NodeReleaseListBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_NODE_INDEX = 4,
+    VT_RELEASE_ACTIONS = 6
+  };
+  uint32_t node_index() const {
+    return GetField<uint32_t>(VT_NODE_INDEX, 0);
+  }
+  const ::flatbuffers::Vector<uint32_t> *release_actions() const {
+    return GetPointer<const ::flatbuffers::Vector<uint32_t> *>(VT_RELEASE_ACTIONS);
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_NODE_INDEX, 4) &&
+           VerifyOffset(verifier, VT_RELEASE_ACTIONS) &&
+           verifier.VerifyVector(release_actions()) &&
+           verifier.EndTable();
+  }
+};
+
+struct NodeReleaseListBuilder {
+  typedef NodeReleaseList Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_node_index(uint32_t node_index) {
+    fbb_.AddElement<uint32_t>(NodeReleaseList::VT_NODE_INDEX, node_index, 0);
+  }
+  void add_release_actions(::flatbuffers::Offset<::flatbuffers::Vector<uint32_t>> release_actions) {
+    fbb_.AddOffset(NodeReleaseList::VT_RELEASE_ACTIONS, release_actions);
+  }
+  explicit NodeReleaseListBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<NodeReleaseList> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<NodeReleaseList>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<NodeReleaseList> CreateNodeReleaseList(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t node_index = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<uint32_t>> release_actions = 0) {
+  NodeReleaseListBuilder builder_(_fbb);
+  builder_.add_release_actions(release_actions);
+  builder_.add_node_index(node_index);
+  return builder_.Finish();
+}
+
+inline ::flatbuffers::Offset<NodeReleaseList> CreateNodeReleaseListDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t node_index = 0,
+    const std::vector<uint32_t> *release_actions = nullptr) {
+  auto release_actions__ = release_actions ? _fbb.CreateVector<uint32_t>(*release_actions) : 0;
+  return onnxruntime::fbs::CreateNodeReleaseList(
+      _fbb,
+      node_index,
+      release_actions__);
+}
+
+/// The execution plan of the main graph with a single logic stream, saved after the session state was finalized.
+/// A session with the same execution providers and planner options uses it instead of running the allocation planner.
+struct ExecutionPlan FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef ExecutionPlanBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_EXECUTION_ORDER = 4,
+    VT_ENABLE_MEM_REUSE = 6,
+    VT_VALUE_NAMES = 8,
+    VT_NODE_EXECUTION_ORDER = 10,
+    VT_NODE_EXECUTION_PROVIDERS = 12,
+    VT_VALUE_ALLOCATION_PLANS = 14,
+    VT_RELEASE_VALUE_INDICES = 16,
+    VT_RELEASE_REF_COUNTS = 18,
+    VT_NODE_RELEASE_LISTS = 20
+  };
+  /// the planner options the plan was created with
+  int8_t execution_order() const {
+    return GetField<int8_t>(VT_EXECUTION_ORDER, 0);
+  }
+  bool enable_mem_reuse() const {
+    return GetField<uint8_t>(VT_ENABLE_MEM_REUSE, 0) != 0;
+  }
+  /// the OrtValue names, indexed by OrtValue index
+  const ::flatbuffers::Vector<::flatbuffers::Offset<::flatbuffers::String>> *value_names() const {
+    return GetPointer<const ::flatbuffers::Vector<::flatbuffers::Offset<::flatbuffers::String>> *>(VT_VALUE_NAMES);
+  }
+  /// the node indices in the order of the execution steps
+  const ::flatbuffers::Vector<uint32_t> *node_execution_order() const {
+    return GetPointer<const ::flatbuffers::Vector<uint32_t> *>(VT_NODE_EXECUTION_ORDER);
+  }
+  /// the execution provider of each node, in node_execution_order order
+  const ::flatbuffers::Vector<::flatbuffers::Offset<::flatbuffers::String>> *node_execution_providers() const {
+    return GetPointer<const ::flatbuffers::Vector<::flatbuffers::Offset<::flatbuffers::String>> *>(VT_NODE_EXECUTION_PROVIDERS);
+  }
+  /// indexed by OrtValue index
+  const ::flatbuffers::Vector<::flatbuffers::Offset<onnxruntime::fbs::ValueAllocationPlan>> *value_allocation_plans() const {
+    return GetPointer<const ::flatbuffers::Vector<::flatbuffers::Offset<onnxruntime::fbs::ValueAllocationPlan>> *>(VT_VALUE_ALLOCATION_PLANS);
+  }
+  /// the release actions, as value index and ref count pairs
+  const ::flatbuffers::Vector<uint32_t> *release_value_indices() const {
+    return GetPointer<const ::flatbuffers::Vector<uint32_t> *>(VT_RELEASE_VALUE_INDICES);
+  }
+  const ::flatbuffers::Vector<uint32_t> *release_ref_counts() const {
+    return GetPointer<const ::flatbuffers::Vector<uint32_t> *>(VT_RELEASE_REF_COUNTS);
+  }
+  const ::flatbuffers::Vector<::flatbuffers::Offset<onnxruntime::fbs::NodeReleaseList>> *node_release_lists() const {
+    return GetPointer<const ::flatbuffers::Vector<::flatbuffers::Offset<onnxruntime::fbs::NodeReleaseList>> *>(VT_NODE_RELEASE_LISTS);
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<int8_t>(verifier, VT_EXECUTION_ORDER, 1) &&
+           VerifyField<uint8_t>(verifier, VT_ENABLE_MEM_REUSE, 1) &&
+           VerifyOffset(verifier, VT_VALUE_NAMES) &&
+           verifier.VerifyVector(value_names()) &&
+           verifier.VerifyVectorOfStrings(value_names()) &&
+           VerifyOffset(verifier, VT_NODE_EXECUTION_ORDER) &&
+           verifier.VerifyVector(node_execution_order()) &&
+           VerifyOffset(verifier, VT_NODE_EXECUTION_PROVIDERS) &&
+           verifier.VerifyVector(node_execution_providers()) &&
+           verifier.VerifyVectorOfStrings(node_execution_providers()) &&
+           VerifyOffset(verifier, VT_VALUE_ALLOCATION_PLANS) &&
+           verifier.VerifyVector(value_allocation_plans()) &&
+           verifier.VerifyVectorOfTables(value_allocation_plans()) &&
+           VerifyOffset(verifier, VT_RELEASE_VALUE_INDICES) &&
+           verifier.VerifyVector(release_value_indices()) &&
+           VerifyOffset(verifier, VT_RELEASE_REF_COUNTS) &&
+           verifier.VerifyVector(release_ref_counts()) &&
+           VerifyOffset(verifier, VT_NODE_RELEASE_LISTS) &&
+           verifier.VerifyVector(node_release_lists()) &&
+           verifier.VerifyVectorOfTables(node_release_lists()) &&
+           verifier.EndTable();
+  }
+};
+
+struct ExecutionPlanBuilder {
+  typedef ExecutionPlan Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_execution_order(int8_t execution_order) {
+    fbb_.AddElement<int8_t>(ExecutionPlan::VT_EXECUTION_ORDER, execution_order, 0);
+  }
+  void add_enable_mem_reuse(bool enable_mem_reuse) {
+    fbb_.AddElement<uint8_t>(ExecutionPlan::VT_ENABLE_MEM_REUSE, static_cast<uint8_t>(enable_mem_reuse), 0);
+  }
+  void add_value_names(::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<::flatbuffers::String>>> value_names) {
+    fbb_.AddOffset(ExecutionPlan::VT_VALUE_NAMES, value_names);
+  }
+  void add_node_execution_order(::flatbuffers::Offset<::flatbuffers::Vector<uint32_t>> node_execution_order) {
+    fbb_.AddOffset(ExecutionPlan::VT_NODE_EXECUTION_ORDER, node_execution_order);
+  }
+  void add_node_execution_providers(::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<::flatbuffers::String>>> node_execution_providers) {
+    fbb_.AddOffset(ExecutionPlan::VT_NODE_EXECUTION_PROVIDERS, node_execution_providers);
+  }
+  void add_value_allocation_plans(::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<onnxruntime::fbs::ValueAllocationPlan>>> value_allocation_plans) {
+    fbb_.AddOffset(ExecutionPlan::VT_VALUE_ALLOCATION_PLANS, value_allocation_plans);
+  }
+  void add_release_value_indices(::flatbuffers::Offset<::flatbuffers::Vector<uint32_t>> release_value_indices) {
+    fbb_.AddOffset(ExecutionPlan::VT_RELEASE_VALUE_INDICES, release_value_indices);
+  }
+  void add_release_ref_counts(::flatbuffers::Offset<::flatbuffers::Vector<uint32_t>> release_ref_counts) {
+    fbb_.AddOffset(ExecutionPlan::VT_RELEASE_REF_COUNTS, release_ref_counts);
+  }
+  void add_node_release_lists(::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<onnxruntime::fbs::NodeReleaseList>>> node_release_lists) {
+    fbb_.AddOffset(ExecutionPlan::VT_NODE_RELEASE_LISTS, node_release_lists);
+  }
+  explicit ExecutionPlanBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<ExecutionPlan> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<ExecutionPlan>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<ExecutionPlan> CreateExecutionPlan(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    int8_t execution_order = 0,
+    bool enable_mem_reuse = false,
+    ::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<::flatbuffers::String>>> value_names = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<uint32_t>> node_execution_order = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<::flatbuffers::String>>> node_execution_providers = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<onnxruntime::fbs::ValueAllocationPlan>>> value_allocation_plans = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<uint32_t>> release_value_indices = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<uint32_t>> release_ref_counts = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<onnxruntime::fbs::NodeReleaseList>>> node_release_lists = 0) {
+  ExecutionPlanBuilder builder_(_fbb);
+  builder_.add_node_release_lists(node_release_lists);
+  builder_.add_release_ref_counts(release_ref_counts);
+  builder_.add_release_value_indices(release_value_indices);
+  builder_.add_value_allocation_plans(value_allocation_plans);
+  builder_.add_node_execution_providers(node_execution_providers);
+  builder_.add_node_execution_order(node_execution_order);
+  builder_.add_value_names(value_names);
+  builder_.add_enable_mem_reuse(enable_mem_reuse);
+  builder_.add_execution_order(execution_order);
+  return builder_.Finish();
+}
+
+inline ::flatbuffers::Offset<ExecutionPlan> CreateExecutionPlanDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    int8_t execution_order = 0,
+    bool enable_mem_reuse = false,
+    const std::vector<::flatbuffers::Offset<::flatbuffers::String>> *value_names = nullptr,
+    const std::vector<uint32_t> *node_execution_order = nullptr,
+    const std::vector<::flatbuffers::Offset<::flatbuffers::String>> *node_execution_providers = nullptr,
+    const std::vector<::flatbuffers::Offset<onnxruntime::fbs::ValueAllocationPlan>> *value_allocation_plans = nullptr,
+    const std::vector<uint32_t> *release_value_indices = nullptr,
+    const std::vector<uint32_t> *release_ref_counts = nullptr,
+    const std::vector<::flatbuffers::Offset<onnxruntime::fbs::NodeReleaseList>> *node_release_lists = nullptr) {
+  auto value_names__ = value_names ? _fbb.CreateVector<::flatbuffers::Offset<::flatbuffers::String>>(*value_names) : 0;
+  auto node_execution_order__ = node_execution_order ? _fbb.CreateVector<uint32_t>(*node_execution_order) : 0;
+  auto node_execution_providers__ = node_execution_providers ? _fbb.CreateVector<::flatbuffers::Offset<::flatbuffers::String>>(*node_execution_providers) : 0;
+  auto value_allocation_plans__ = value_allocation_plans ? _fbb.CreateVector<::flatbuffers::Offset<onnxruntime::fbs::ValueAllocationPlan>>(*value_allocation_plans) : 0;
+  auto release_value_indices__ = release_value_indices ? _fbb.CreateVector<uint32_t>(*release_value_indices) : 0;
+  auto release_ref_counts__ = release_ref_counts ? _fbb.CreateVector<uint32_t>(*release_ref_counts) : 0;
+  auto node_release_lists__ = node_release_lists ? _fbb.CreateVector<::flatbuffers::Offset<onnxruntime::fbs::NodeReleaseList>>(*node_release_lists) : 0;
+  return onnxruntime::fbs::CreateExecutionPlan(
+      _fbb,
+      execution_order,
+      enable_mem_reuse,
+      value_names__,
+      node_execution_order__,
+      node_execution_providers__,
+      value_allocation_plans__,
+      release_value_indices__,
+      release_ref_counts__,
+      node_release_lists__);
+}
+
 struct InferenceSession FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef InferenceSessionBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_ORT_VERSION = 4,
     VT_MODEL = 6,
-    VT_KERNEL_TYPE_STR_RESOLVER = 10
+    VT_KERNEL_TYPE_STR_RESOLVER = 10,
+    VT_EXECUTION_PLAN = 12
   };
   const ::flatbuffers::String *ort_version() const {
     return GetPointer<const ::flatbuffers::String *>(VT_ORT_VERSION);
@@ -2987,6 +3380,9 @@ struct InferenceSession FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   const onnxruntime::fbs::KernelTypeStrResolver *kernel_type_str_resolver() const {
     return GetPointer<const onnxruntime::fbs::KernelTypeStrResolver *>(VT_KERNEL_TYPE_STR_RESOLVER);
   }
+  const onnxruntime::fbs::ExecutionPlan *execution_plan() const {
+    return GetPointer<const onnxruntime::fbs::ExecutionPlan *>(VT_EXECUTION_PLAN);
+  }
   bool Verify(::flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_ORT_VERSION) &&
@@ -2995,6 +3391,8 @@ struct InferenceSession FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
            verifier.VerifyTable(model()) &&
            VerifyOffset(verifier, VT_KERNEL_TYPE_STR_RESOLVER) &&
            verifier.VerifyTable(kernel_type_str_resolver()) &&
+           VerifyOffset(verifier, VT_EXECUTION_PLAN) &&
+           verifier.VerifyTable(execution_plan()) &&
            verifier.EndTable();
   }
 };
@@ -3012,6 +3410,9 @@ struct InferenceSessionBuilder {
   void add_kernel_type_str_resolver(::flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver) {
     fbb_.AddOffset(InferenceSession::VT_KERNEL_TYPE_STR_RESOLVER, kernel_type_str_resolver);
   }
+  void add_execution_plan(::flatbuffers::Offset<onnxruntime::fbs::ExecutionPlan> execution_plan) {
+    fbb_.AddOffset(InferenceSession::VT_EXECUTION_PLAN, execution_plan);
+  }
   explicit InferenceSessionBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -3027,8 +3428,10 @@ inline ::flatbuffers::Offset<InferenceSession> CreateInferenceSession(
     ::flatbuffers::FlatBufferBuilder &_fbb,
     ::flatbuffers::Offset<::flatbuffers::String> ort_version = 0,
     ::flatbuffers::Offset<onnxruntime::fbs::Model> model = 0,
-    ::flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0) {
+    ::flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0,
+    ::flatbuffers::Offset<onnxruntime::fbs::ExecutionPlan> execution_plan = 0) {
   InferenceSessionBuilder builder_(_fbb);
+  builder_.add_execution_plan(execution_plan);
   builder_.add_kernel_type_str_resolver(kernel_type_str_resolver);
   builder_.add_model(model);
   builder_.add_ort_version(ort_version);
@@ -3039,13 +3442,15 @@ inline ::flatbuffers::Offset<InferenceSession> CreateInferenceSessionDirect(
     ::flatbuffers::FlatBufferBuilder &_fbb,
     const char *ort_version = nullptr,
     ::flatbuffers::Offset<onnxruntime::fbs::Model> model = 0,
-    ::flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0) {
+    ::flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0,
+    ::flatbuffers::Offset<onnxruntime::fbs::ExecutionPlan> execution_plan = 0) {
   auto ort_version__ = ort_version ? _fbb.CreateString(ort_version) : 0;
   return onnxruntime::fbs::CreateInferenceSession(
       _fbb,
       ort_version__,
       model,
-      kernel_type_str_resolver);
+      kernel_type_str_resolver,
+      execution_plan);
 }
 
 inline bool VerifyTypeInfoValue(::flatbuffers::Verifier &verifier, const void *obj, TypeInfoValue type) {
@@ -0,0 +1,250 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/flatbuffers/tensor_data_compression.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/common/common.h"
+#include "core/flatbuffers/schema/ort.fbs.h"
+
+namespace onnxruntime::fbs::utils {
+
+namespace {
+
+// LZ4 block format constants.
+constexpr size_t kMinMatch = 4;
+// the last 5 bytes of a block are always literals
+constexpr size_t kLastLiterals = 5;
+// the last match must start at least 12 bytes before the end of the block
+constexpr size_t kMatchFindLimit = 12;
+constexpr size_t kMaxOffset = 65535;
+constexpr size_t kRunMask = 15;
+
+void ByteUnshuffle(gsl::span<const uint8_t> src, size_t element_size, gsl::span<uint8_t> dst) {
+  const size_t num_elements = src.size() / element_size;
+  for (size_t i = 0; i < element_size; ++i) {
+    const uint8_t* plane = src.data() + i * num_elements;
+    for (size_t e = 0; e < num_elements; ++e) {
+      dst[e * element_size + i] = plane[e];
+    }
+  }
+
+  const size_t shuffled_bytes = num_elements * element_size;
+  std::copy(src.begin() + shuffled_bytes, src.end(), dst.begin() + shuffled_bytes);
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+// Byte i of element e is moved to plane i. Any trailing bytes that do not form a whole element are copied as-is.
+void ByteShuffle(gsl::span<const uint8_t> src, size_t element_size, gsl::span<uint8_t> dst) {
+  const size_t num_elements = src.size() / element_size;
+  for (size_t e = 0; e < num_elements; ++e) {
+    for (size_t i = 0; i < element_size; ++i) {
+      dst[i * num_elements + e] = src[e * element_size + i];
+    }
+  }
+
+  const size_t shuffled_bytes = num_elements * element_size;
+  std::copy(src.begin() + shuffled_bytes, src.end(), dst.begin() + shuffled_bytes);
+}
+
+inline uint32_t Read32(const uint8_t* p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline size_t Hash(uint32_t sequence) {
+  constexpr int kHashLog = 16;
+  return static_cast<size_t>((sequence * 2654435761U) >> (32 - kHashLog));
+}
+
+void WriteLength(std::vector<uint8_t>& dst, size_t length) {
+  while (length >= 255) {
+    dst.push_back(255);
+    length -= 255;
+  }
+
+  dst.push_back(static_cast<uint8_t>(length));
+}
+
+// Write a sequence of literals followed by a match. match_length of 0 writes the final literals-only sequence.
+void WriteSequence(std::vector<uint8_t>& dst, const uint8_t* literals, size_t literal_length,
+                   size_t offset, size_t match_length) {
+  const size_t match_code = match_length > 0 ? match_length - kMinMatch : 0;
+  const uint8_t token = static_cast<uint8_t>((std::min(literal_length, kRunMask) << 4) |
+                                             std::min(match_code, kRunMask));
+  dst.push_back(token);
+  if (literal_length >= kRunMask) {
+    WriteLength(dst, literal_length - kRunMask);
+  }
+
+  dst.insert(dst.end(), literals, literals + literal_length);
+
+  if (match_length > 0) {
+    dst.push_back(static_cast<uint8_t>(offset & 0xFF));
+    dst.push_back(static_cast<uint8_t>(offset >> 8));
+    if (match_code >= kRunMask) {
+      WriteLength(dst, match_code - kRunMask);
+    }
+  }
+}
+
+// Greedy single-pass LZ4 compressor. Favors simplicity and compression speed over ratio, which is fine for weights
+// where most of the gain comes from the byte shuffle.
+void Lz4Compress(gsl::span<const uint8_t> src, std::vector<uint8_t>& dst) {
+  const uint8_t* const base = src.data();
+  const size_t size = src.size();
+
+  dst.clear();
+  dst.reserve(size + size / 255 + 16);
+
+  size_t anchor = 0;
+  if (size > kMatchFindLimit) {
+    const size_t match_start_limit = size - kMatchFindLimit;
+    const size_t match_end_limit = size - kLastLiterals;
+    std::vector<uint32_t> hash_table(size_t{1} << 16, 0);
+
+    size_t pos = 0;
+    while (pos <= match_start_limit) {
+      const uint32_t sequence = Read32(base + pos);
+      uint32_t& entry = hash_table[Hash(sequence)];
+      const size_t candidate = entry;
+      entry = static_cast<uint32_t>(pos);
+
+      if (candidate >= pos || pos - candidate > kMaxOffset || Read32(base + candidate) != sequence) {
+        ++pos;
+        continue;
+      }
+
+      size_t match_length = kMinMatch;
+      while (pos + match_length < match_end_limit && base[candidate + match_length] == base[pos + match_length]) {
+        ++match_length;
+      }
+
+      WriteSequence(dst, base + anchor, pos - anchor, pos - candidate, match_length);
+      pos += match_length;
+      anchor = pos;
+    }
+  }
+
+  WriteSequence(dst, base + anchor, size - anchor, 0, 0);
+}
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+Status ReadLength(gsl::span<const uint8_t> src, size_t& pos, size_t& length) {
+  uint8_t b;
+  do {
+    ORT_RETURN_IF(pos >= src.size(), "Compressed tensor data is truncated.");
+    b = src[pos++];
+    length += b;
+  } while (b == 255);
+
+  return Status::OK();
+}
+
+Status Lz4Decompress(gsl::span<const uint8_t> src, gsl::span<uint8_t> dst) {
+  size_t in = 0;
+  size_t out = 0;
+
+  while (true) {
+    ORT_RETURN_IF(in >= src.size(), "Compressed tensor data is truncated.");
+    const uint8_t token = src[in++];
+
+    size_t literal_length = token >> 4;
+    if (literal_length == kRunMask) {
+      ORT_RETURN_IF_ERROR(ReadLength(src, in, literal_length));
+    }
+
+    ORT_RETURN_IF(literal_length > src.size() - in || literal_length > dst.size() - out,
+                  "Compressed tensor data is invalid. Literals exceed the buffer size.");
+    memcpy(dst.data() + out, src.data() + in, literal_length);
+    in += literal_length;
+    out += literal_length;
+
+    // the last sequence has no match
+    if (in == src.size()) {
+      break;
+    }
+
+    ORT_RETURN_IF(src.size() - in < 2, "Compressed tensor data is truncated.");
+    const size_t offset = static_cast<size_t>(src[in]) | (static_cast<size_t>(src[in + 1]) << 8);
+    in += 2;
+    ORT_RETURN_IF(offset == 0 || offset > out, "Compressed tensor data is invalid. Match offset is out of range.");
+
+    size_t match_length = token & kRunMask;
+    if (match_length == kRunMask) {
+      ORT_RETURN_IF_ERROR(ReadLength(src, in, match_length));
+    }
+
+    match_length += kMinMatch;
+    ORT_RETURN_IF(match_length > dst.size() - out,
+                  "Compressed tensor data is invalid. Match exceeds the buffer size.");
+
+    uint8_t* match_dst = dst.data() + out;
+    const uint8_t* match_src = match_dst - offset;
+    if (offset >= match_length) {
+      memcpy(match_dst, match_src, match_length);
+    } else {
+      // overlapping copy repeats the last `offset` bytes
+      for (size_t i = 0; i < match_length; ++i) {
+        match_dst[i] = match_src[i];
+      }
+    }
+
+    out += match_length;
+  }
+
+  ORT_RETURN_IF(out != dst.size(), "Compressed tensor data is invalid. Expected ", dst.size(),
+                " bytes after decompression but got ", out);
+
+  return Status::OK();
+}
+
+}  // namespace
+
+#if !defined(ORT_MINIMAL_BUILD)
+Status CompressTensorData(TensorDataCompression compression, size_t element_size,
+                          gsl::span<const uint8_t> data, std::vector<uint8_t>& compressed) {
+  switch (compression) {
+    case TensorDataCompression::LZ4:
+      Lz4Compress(data, compressed);
+      break;
+    case TensorDataCompression::BYTE_SHUFFLE_LZ4: {
+      ORT_RETURN_IF(element_size == 0, "Element size is required for byte shuffling.");
+      std::vector<uint8_t> shuffled(data.size());
+      ByteShuffle(data, element_size, shuffled);
+      Lz4Compress(shuffled, compressed);
+      break;
+    }
+    default:
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported tensor data compression: ",
+                             EnumNameTensorDataCompression(compression));
+  }
+
+  return Status::OK();
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+Status DecompressTensorData(TensorDataCompression compression, size_t element_size,
+                            gsl::span<const uint8_t> compressed, gsl::span<uint8_t> data) {
+  switch (compression) {
+    case TensorDataCompression::LZ4:
+      return Lz4Decompress(compressed, data);
+    case TensorDataCompression::BYTE_SHUFFLE_LZ4: {
+      ORT_RETURN_IF(element_size == 0, "Element size is required for byte unshuffling.");
+      std::vector<uint8_t> shuffled(data.size());
+      ORT_RETURN_IF_ERROR(Lz4Decompress(compressed, shuffled));
+      ByteUnshuffle(shuffled, element_size, data);
+      return Status::OK();
+    }
+    default:
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported tensor data compression: ",
+                             static_cast<int>(compression), ". Invalid ORT format model.");
+  }
+}
+
+}  // namespace onnxruntime::fbs::utils
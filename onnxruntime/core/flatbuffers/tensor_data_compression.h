@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include "core/common/status.h"
+
+namespace onnxruntime {
+namespace fbs {
+enum class TensorDataCompression : int8_t;
+
+namespace utils {
+
+// Compression of ORT format tensor data.
+//
+// The codec is the LZ4 block format (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md), so data written
+// here can also be produced/consumed by the reference lz4 library. BYTE_SHUFFLE_LZ4 first transposes the data so
+// byte i of every element is stored contiguously. The exponent bytes of float/float16 weights vary slowly across a
+// tensor, which LZ4 picks up far better once they are grouped together.
+
+#if !defined(ORT_MINIMAL_BUILD)
+/// <summary>
+/// Compress tensor data.
+/// </summary>
+/// <param name="compression">Compression to apply. Must not be TensorDataCompression::NONE.</param>
+/// <param name="element_size">Size in bytes of a single tensor element. Used to byte shuffle the data.</param>
+/// <param name="data">Uncompressed data.</param>
+/// <param name="compressed">Compressed data. Replaces any existing contents.</param>
+Status CompressTensorData(TensorDataCompression compression, size_t element_size,
+                          gsl::span<const uint8_t> data, std::vector<uint8_t>& compressed);
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+/// <summary>
+/// Decompress tensor data written by CompressTensorData.
+/// The compressed data is untrusted input and is fully bounds checked.
+/// </summary>
+/// <param name="compression">Compression that was applied.</param>
+/// <param name="element_size">Size in bytes of a single tensor element.</param>
+/// <param name="compressed">Compressed data.</param>
+/// <param name="data">Pre-allocated buffer for the uncompressed data. Must be exactly the uncompressed size.</param>
+Status DecompressTensorData(TensorDataCompression compression, size_t element_size,
+                            gsl::span<const uint8_t> compressed, gsl::span<uint8_t> data);
+
+}  // namespace utils
+}  // namespace fbs
+}  // namespace onnxruntime
@@ -98,6 +98,13 @@ class TensorSeq {
     Add(std::move(value));
   }
 
+  // Adds the elements of another sequence without copying their data.
+  // The tensors of a sequence are never written once they are added, so sequences can share them.
+  void AddShared(const TensorSeq& other) {
+    ORT_ENFORCE(IsSameDataType(other), "TensorSeq: sequence to be added has a different data type.");
+    tensors_.insert(tensors_.end(), other.tensors_.cbegin(), other.tensors_.cend());
+  }
+
   static void InitOrtValue(const TensorSeq& source_tensor_seq, std::shared_ptr<IAllocator> allocator, OrtValue& ort_value) {
     auto target_tensor_seq = std::make_unique<TensorSeq>(source_tensor_seq.DataType());
     target_tensor_seq->Reserve(source_tensor_seq.Size());
@@ -8,6 +8,9 @@
 #include <sstream>
 #include <ctime>
 #include <iomanip>
+#include <limits>
+#include <queue>
+#include <string_view>
 #include "core/common/exceptions.h"
 #include "core/common/inlined_containers.h"
 #include "core/common/safeint.h"
@@ -98,6 +101,7 @@ std::ostream& operator<<(std::ostream& out, std::pair<const SequentialExecutionP
       auto& elt_plan = plan.allocation_plan[index];
       out << elt_plan.alloc_kind;
       if (elt_plan.alloc_kind == AllocKind::kReuse) out << " " << elt_plan.reused_buffer;
+      if (elt_plan.is_view) out << " (view)";
       auto& loc = elt_plan.location;
       out << ", " << loc.ToString();
     } else {
@@ -294,13 +298,16 @@ class PlannerImpl {
 #endif
 
   // Find if there exists some input tensor that we can use in-place for output_arg_num-th output in the node.
+  // A view (see KernelDefBuilder::MayOutputView) points into the middle of its input's buffer, so it is never
+  // aliased or updated in place by its consumers, they get a buffer of their own instead.
   bool FindReusableInput(const GraphViewer& graph, const onnxruntime::Node& node, int output_arg_num,
-                         OrtValueIndex* reusable_input, bool* is_strided_tensor) {
+                         OrtValueIndex* reusable_input, bool* is_strided_tensor, bool* is_view) {
 #if defined(ORT_MINIMAL_BUILD) && !defined(ORT_EXTENDED_MINIMAL_BUILD)
     ORT_UNUSED_PARAMETER(graph);
 #endif
 
     *is_strided_tensor = false;
+    *is_view = false;
 #ifdef ENABLE_TRAINING
     // Inputs of Yields are essentially the outputs for FW partial subgraph
     // These tensors will be passed back to pytorch, thus cannot share the buffer with other tensors
@@ -329,7 +336,7 @@ class PlannerImpl {
         // we _must_ reuse this input to satisfy aliasing requirement: (e.g., for reshape)
         if ((0 <= pair.first) && (static_cast<size_t>(pair.first) < input_args.size())) {
           auto p_input_arg = input_args[pair.first];
-          if (p_input_arg->Exists()) {
+          if (p_input_arg->Exists() && !AllocPlan(p_input_arg->Name()).is_view) {
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
             // If the producer node does not have external output, then we can reuse the input buffer; Otherwise,
             // we cannot.
@@ -355,7 +362,7 @@ class PlannerImpl {
       int alias_input_index = output_arg_num - output_offset + input_offset;
       if (alias_input_index >= 0 && static_cast<size_t>(alias_input_index) < input_args.size()) {
         auto p_input_arg = input_args[alias_input_index];
-        if (p_input_arg->Exists()) {
+        if (p_input_arg->Exists() && !AllocPlan(p_input_arg->Name()).is_view) {
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
           // If the producer node does not have external output, then we can reuse the input buffer; Otherwise,
           // we cannot.
@@ -380,7 +387,7 @@ class PlannerImpl {
           if (p_input_arg->Exists()) {
             auto input_arg_index = Index(p_input_arg->Name());
             auto original = Buffer(input_arg_index);
-            if (1 == UseCount(original)) {
+            if (1 == UseCount(original) && !AllocPlan(input_arg_index).is_view) {
               bool need_skip = false;
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
               // If the producer node does not have external output, then we can reuse the input buffer; Otherwise,
@@ -414,7 +421,7 @@ class PlannerImpl {
     const auto& may_strided_outputs_map = ci.kernel_def->MayStridedOutput();
     for (auto& pair : may_strided_outputs_map) {
       if (pair.second == output_arg_num && pair.first >= 0 && static_cast<size_t>(pair.first) < input_args.size() &&
-          input_args[pair.first]->Exists()) {
+          input_args[pair.first]->Exists() && !AllocPlan(input_args[pair.first]->Name()).is_view) {
         bool can_strided = true;
         for (auto it = node.OutputNodesBegin(); it != node.OutputNodesEnd(); ++it) {
           const KernelCreateInfo& output_node_ci = GetKernelCreateInfo(kernel_create_info_map_, it->Index());
@@ -457,6 +464,25 @@ class PlannerImpl {
     }
 #endif
 
+    // The output may be a view of a contiguous range of the input (e.g., for split). Views of views are not
+    // created as the input of the second one may be a buffer of its own that is released before the view.
+    const auto& output_view_input = ci.kernel_def->MayOutputView();
+    if (output_view_input.has_value() && static_cast<size_t>(*output_view_input) < input_args.size()) {
+      auto p_input_arg = input_args[*output_view_input];
+      if (p_input_arg->Exists() && !AllocPlan(p_input_arg->Name()).is_view) {
+        bool need_skip = false;
+#if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+        const Node* producer_node = graph.GetProducerNode(p_input_arg->Name());
+        need_skip = producer_node && HasExternalOutputs(*producer_node);
+#endif
+        if (!need_skip) {
+          *reusable_input = Index(p_input_arg->Name());
+          *is_view = true;
+          return true;
+        }
+      }
+    }
+
     return false;
   }
 
@@ -1498,6 +1524,7 @@ class PlannerImpl {
         // The the OrtValue indexed by current may reuse the memory in the OrtValue indexed by reused.
         OrtValueIndex reused;
         bool is_strided_tensor = false;
+        bool is_view = false;
         if (has_external_outputs) {
           ORT_ENFORCE(!IsNonTensor(*node_output), "Only tensors are supported for external outputs for now.");
           AllocPlan(current).alloc_kind = AllocKind::kAllocatedExternally;
@@ -1539,7 +1566,7 @@ class PlannerImpl {
           }
         } else if (!context_->IsParallelExecutionEnabled() &&
                    FindReusableInput(graph_viewer_, *pnode, static_cast<int>(output_arg_def_index),
-                                     &reused, &is_strided_tensor)) {
+                                     &reused, &is_strided_tensor, &is_view)) {
           // Re-using inputs is applicable for tensors, sequence tensors,
           // and optional types if the kernel has marked certain inputs as
           // possible candidates for re-use
@@ -1548,8 +1575,10 @@ class PlannerImpl {
 #ifdef ENABLE_STRIDED_TENSORS
           if (is_strided_tensor) AllocPlan(current).is_strided_tensor = true;
 #else
-          ORT_ENFORCE(!is_strided_tensor, "Strided tensor is not supported in non-training build for now.");
+          ORT_ENFORCE(!is_strided_tensor, "Strided tensor is not supported in this build. "
+                                          "Build with onnxruntime_ENABLE_STRIDED_TENSORS to enable it.");
 #endif  // ENABLE_STRIDED_TENSORS
+          AllocPlan(current).is_view = is_view;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
           InplaceReuse(reused, current);
 #endif
@@ -1824,6 +1853,10 @@ class PlannerImpl {
               // add current node as consumer for origin buffer
               ortvalue_to_consumers_map[origin].push_back(node_index);
             }
+            if (AllocPlan(value_idx).is_view) {
+              // a view that the kernel could not create holds a buffer of its own
+              ortvalue_to_consumers_map[value_idx].push_back(node_index);
+            }
           }
           return Status::OK();
         };
@@ -1918,7 +1951,10 @@ class PlannerImpl {
   void
   PartitionIntoStreams(const logging::Logger& logger, const ExecutionProviders& execution_providers,
                        const PathString& partition_config_file) {
-    auto partitioner = IGraphPartitioner::CreateGraphPartitioner(logger, partition_config_file);
+    auto partitioner = IGraphPartitioner::CreateGraphPartitioner(logger, partition_config_file,
+                                                                 context_->UseDedicatedCopyStream(),
+                                                                 context_->GetCriticalPathCpuStreams(),
+                                                                 context_->UseDedicatedCollectiveStream());
     auto status = partitioner->PartitionGraph(graph_viewer_, execution_providers, stream_nodes_, context_->GetExecutionOrder());
     ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
     plan_.node_stream_map_.resize(SafeInt<size_t>(graph_viewer_.MaxNodeIndex()) + 1);
@@ -2365,6 +2401,41 @@ Status SequentialPlanner::CreatePlan(
 }
 
 #ifdef ORT_ENABLE_STREAM
+namespace {
+
+// Kinds of the streams a non-CPU device may have, see GetDedicatedStreamKind.
+constexpr int kDefaultStreamKind = 0;
+constexpr int kCopyStreamKind = 1;
+constexpr int kCollectiveStreamKind = 2;
+
+bool IsCollectiveNode(const Node& node) {
+  static const InlinedHashSet<std::string_view> collective_op_types{
+      "NcclAllReduce", "NcclAllGather", "NcclReduceScatter", "AllReduce", "AllGather", "AllToAll"};
+  return node.Domain() == kMSDomain && collective_op_types.count(node.OpType()) > 0;
+}
+
+// Host/device copies and collective communication of a non-CPU device can be put on streams of their own,
+// so that they overlap with the compute nodes of the device rather than being serialized with them.
+int GetDedicatedStreamKind(const Node& node, OrtDevice::DeviceType device_type,
+                           bool use_dedicated_copy_stream, bool use_dedicated_collective_stream) {
+  if (device_type == OrtDevice::CPU) {
+    return kDefaultStreamKind;
+  }
+
+  const auto& op_type = node.OpType();
+  if (use_dedicated_copy_stream && (op_type == "MemcpyFromHost" || op_type == "MemcpyToHost")) {
+    return kCopyStreamKind;
+  }
+
+  if (use_dedicated_collective_stream && IsCollectiveNode(node)) {
+    return kCollectiveStreamKind;
+  }
+
+  return kDefaultStreamKind;
+}
+
+}  // namespace
+
 /*
 DeviceBasedPartitioner stores config in json format:
 ------------------------------------------------------
@@ -2385,7 +2456,12 @@ Pls check definition of OrtDevice for more detail on device type.
 class DeviceBasedPartitioner : public IGraphPartitioner {
  public:
   DeviceBasedPartitioner(const logging::Logger& logger,
-                         const PathString& config_file) : IGraphPartitioner(logger, config_file) {
+                         const PathString& config_file,
+                         bool use_dedicated_copy_stream,
+                         bool use_dedicated_collective_stream)
+      : IGraphPartitioner(logger, config_file),
+        use_dedicated_copy_stream_(use_dedicated_copy_stream),
+        use_dedicated_collective_stream_(use_dedicated_collective_stream) {
     Initialize();
   }
 
@@ -2410,6 +2486,10 @@ class DeviceBasedPartitioner : public IGraphPartitioner {
   std::vector<OrtDevice::DeviceType> device_types_;
   std::vector<InlinedVector<std::string>> node_names_by_stream_;
   bool need_save_ = false;
+  // put the host/device copy nodes of each non-CPU device into a stream of their own
+  bool use_dedicated_copy_stream_ = false;
+  // put the collective communication nodes of each non-CPU device into a stream of their own
+  bool use_dedicated_collective_stream_ = false;
 };
 
 #define EXIT_ON_ERR(warning)         \
@@ -2427,7 +2507,8 @@ Status DeviceBasedPartitioner::PartitionGraph(const onnxruntime::GraphViewer& gr
 
   if (node_names_by_stream_.empty()) {  // input configure empty, do it from scratch
 
-    InlinedHashMap<OrtDevice::DeviceType, int> device_to_stream;
+    // key is the device type and the kind of stream of the device, see GetDedicatedStreamKind
+    InlinedHashMap<std::pair<OrtDevice::DeviceType, int>, int> device_to_stream;
 
     for (auto node_index : p_graph_nodes) {
       // get device info of the node
@@ -2436,14 +2517,17 @@ Status DeviceBasedPartitioner::PartitionGraph(const onnxruntime::GraphViewer& gr
       const auto& node_name = node->Name();
       auto* ep = execution_providers.Get(*node);
       auto device_type = ep->GetOrtDeviceByMemType(OrtMemType::OrtMemTypeDefault).Type();
+      const int stream_kind = GetDedicatedStreamKind(*node, device_type, use_dedicated_copy_stream_,
+                                                     use_dedicated_collective_stream_);
 
       // log the device
-      auto it = device_to_stream.find(device_type);
+      auto it = device_to_stream.find({device_type, stream_kind});
       if (it == device_to_stream.end()) {
-        device_to_stream[device_type] = static_cast<int>(node_names_by_stream_.size());
+        it = device_to_stream.emplace(std::make_pair(device_type, stream_kind),
+                                      static_cast<int>(node_names_by_stream_.size()))
+                 .first;
         node_names_by_stream_.push_back({});
         device_types_.push_back(device_type);
-        it = device_to_stream.find(device_type);
       }
       // put the node into the belonging stream
       if (node_name.empty()) {
@@ -2541,11 +2625,351 @@ void DeviceBasedPartitioner::SaveConfig() const {
   }
 }
 
+/*
+CriticalPathPartitioner stores config in json format:
+------------------------------------------------------
+{
+"type":"CriticalPathPartitioner",
+"cpu_streams":4,
+"profile":"onnxruntime_profile.json",
+"costs":{"node_1":120.5,"node_2":3.0}
+}
+------------------------------------------------------
+"cpu_streams" optionally overrides the number of CPU streams, which is the inter-op parallelism by default;
+"profile" optionally names the output of a profiled session. The kernel times of its nodes, averaged over the runs
+after the first one, are used as node costs;
+"costs" optionally gives node costs directly and takes precedence over the profile.
+Nodes without a cost are estimated from the sizes of their outputs. When the config file cannot be read, it is
+written with the estimated costs and the resulting streams, so the costs can be replaced by measured ones, e.g. by
+adding the profile of warm-up runs, for the next session.
+*/
+class CriticalPathPartitioner : public IGraphPartitioner {
+ public:
+  CriticalPathPartitioner(const logging::Logger& logger,
+                          const PathString& config_file,
+                          bool use_dedicated_copy_stream,
+                          bool use_dedicated_collective_stream,
+                          size_t cpu_streams) : IGraphPartitioner(logger, config_file),
+                                                use_dedicated_copy_stream_(use_dedicated_copy_stream),
+                                                use_dedicated_collective_stream_(use_dedicated_collective_stream),
+                                                cpu_streams_(std::max<size_t>(cpu_streams, 1)) {
+    Initialize();
+  }
+
+  ~CriticalPathPartitioner() {
+    if (need_save_) {
+      SaveConfig();
+    }
+  }
+
+  void SaveConfig() const;
+  Status PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
+                        const ExecutionProviders& execution_providers,
+                        std::vector<InlinedVector<NodeIndex>>& stream_nodes,
+                        ExecutionOrder execution_order) override;
+
+  const char* Type() const override { return "CriticalPathPartitioner"; }
+  size_t Streams() const override { return node_names_by_stream_.size(); }
+
+ private:
+  void Initialize();
+  void LoadProfile(const std::string& profile_file);
+  double GetNodeCost(const Node& node, const std::string& node_name) const;
+
+  // put the host/device copy nodes of each non-CPU device into a stream of their own
+  bool use_dedicated_copy_stream_ = false;
+  // put the collective communication nodes of each non-CPU device into a stream of their own
+  bool use_dedicated_collective_stream_ = false;
+  // maximum number of streams the CPU nodes are spread over
+  size_t cpu_streams_ = 1;
+  // cost of a node by name, in the unit of the profile when one is given
+  InlinedHashMap<std::string, double> node_costs_;
+  std::vector<InlinedVector<std::string>> node_names_by_stream_;
+  bool need_save_ = false;
+};
+
+Status CriticalPathPartitioner::PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
+                                               const ExecutionProviders& execution_providers,
+                                               std::vector<InlinedVector<NodeIndex>>& stream_nodes,
+                                               ExecutionOrder execution_order) {
+  const auto& p_graph_nodes = graph_viewer.GetNodesInTopologicalOrder(execution_order);
+  const size_t max_node_index = graph_viewer.MaxNodeIndex();
+
+  std::vector<std::string> node_names(max_node_index);
+  std::vector<double> costs(max_node_index, 0.0);
+  std::vector<size_t> positions(max_node_index, 0);
+  // key is the device type and the kind of stream of the device, see GetDedicatedStreamKind
+  std::vector<std::pair<OrtDevice::DeviceType, int>> devices(max_node_index);
+
+  InlinedHashMap<std::string, int> op_type_counter;
+  for (size_t i = 0; i < p_graph_nodes.size(); ++i) {
+    const auto node_index = p_graph_nodes[i];
+    const auto* node = graph_viewer.GetNode(node_index);
+    const auto& op_type = node->OpType();
+    auto* ep = execution_providers.Get(*node);
+    auto device_type = ep->GetOrtDeviceByMemType(OrtMemType::OrtMemTypeDefault).Type();
+    const int stream_kind = GetDedicatedStreamKind(*node, device_type, use_dedicated_copy_stream_,
+                                                   use_dedicated_collective_stream_);
+
+    node_names[node_index] = node->Name().empty() ? op_type + std::to_string(op_type_counter[op_type]++)
+                                                  : node->Name();
+    costs[node_index] = GetNodeCost(*node, node_names[node_index]);
+    positions[node_index] = i;
+    devices[node_index] = {device_type, stream_kind};
+  }
+
+  // The rank of a node is the cost of the longest path from the node to the end of the graph,
+  // so the nodes on the critical path have the highest ranks.
+  std::vector<double> ranks(max_node_index, 0.0);
+  std::vector<size_t> pending_inputs(max_node_index, 0);
+  for (auto it = p_graph_nodes.rbegin(); it != p_graph_nodes.rend(); ++it) {
+    const auto* node = graph_viewer.GetNode(*it);
+    double max_output_rank = 0.0;
+    for (auto output_it = node->OutputNodesBegin(); output_it != node->OutputNodesEnd(); ++output_it) {
+      if (graph_viewer.GetNode(output_it->Index()) != nullptr) {
+        max_output_rank = std::max(max_output_rank, ranks[output_it->Index()]);
+        ++pending_inputs[output_it->Index()];
+      }
+    }
+    ranks[*it] = costs[*it] + max_output_rank;
+  }
+
+  // List scheduling: the ready node with the highest rank is placed on the stream of its device where it can start
+  // first. CPU nodes may open a new stream until cpu_streams_ are in use. Ties keep a node on the stream of its
+  // latest input to avoid a synchronization. As nodes are placed in a topological order, each stream is too.
+  auto lower_priority = [&](NodeIndex a, NodeIndex b) {
+    return ranks[a] != ranks[b] ? ranks[a] < ranks[b] : positions[a] > positions[b];
+  };
+  std::priority_queue<NodeIndex, std::vector<NodeIndex>, decltype(lower_priority)> ready_nodes(lower_priority);
+  for (auto node_index : p_graph_nodes) {
+    if (pending_inputs[node_index] == 0) {
+      ready_nodes.push(node_index);
+    }
+  }
+
+  std::vector<double> finish_times(max_node_index, 0.0);
+  std::vector<size_t> node_streams(max_node_index, 0);
+  std::vector<double> stream_free_times;
+  InlinedHashMap<std::pair<OrtDevice::DeviceType, int>, size_t> device_to_stream;
+  InlinedVector<size_t> cpu_stream_ids;
+
+  stream_nodes.clear();
+  node_names_by_stream_.clear();
+  auto add_stream = [&]() {
+    stream_nodes.emplace_back();
+    node_names_by_stream_.emplace_back();
+    stream_free_times.push_back(0.0);
+    return stream_nodes.size() - 1;
+  };
+
+  size_t scheduled_nodes = 0;
+  while (!ready_nodes.empty()) {
+    const auto node_index = ready_nodes.top();
+    ready_nodes.pop();
+    const auto* node = graph_viewer.GetNode(node_index);
+
+    double ready_time = 0.0;
+    size_t input_stream = std::numeric_limits<size_t>::max();
+    for (auto input_it = node->InputNodesBegin(); input_it != node->InputNodesEnd(); ++input_it) {
+      const auto input_index = input_it->Index();
+      if (graph_viewer.GetNode(input_index) != nullptr && finish_times[input_index] >= ready_time) {
+        ready_time = finish_times[input_index];
+        input_stream = node_streams[input_index];
+      }
+    }
+
+    size_t stream = std::numeric_limits<size_t>::max();
+    if (devices[node_index].first != OrtDevice::CPU) {
+      auto it = device_to_stream.find(devices[node_index]);
+      if (it == device_to_stream.end()) {
+        it = device_to_stream.emplace(devices[node_index], add_stream()).first;
+      }
+      stream = it->second;
+    } else {
+      double best_start_time = std::numeric_limits<double>::max();
+      for (auto cpu_stream : cpu_stream_ids) {
+        const double start_time = std::max(stream_free_times[cpu_stream], ready_time);
+        if (start_time < best_start_time || (start_time == best_start_time && cpu_stream == input_stream)) {
+          best_start_time = start_time;
+          stream = cpu_stream;
+        }
+      }
+      if (cpu_stream_ids.size() < cpu_streams_ && best_start_time > ready_time) {
+        stream = add_stream();
+        cpu_stream_ids.push_back(stream);
+      }
+    }
+
+    const double start_time = std::max(stream_free_times[stream], ready_time);
+    finish_times[node_index] = start_time + costs[node_index];
+    stream_free_times[stream] = finish_times[node_index];
+    node_streams[node_index] = stream;
+    stream_nodes[stream].push_back(node_index);
+    node_names_by_stream_[stream].push_back(node_names[node_index]);
+    ++scheduled_nodes;
+
+    for (auto output_it = node->OutputNodesBegin(); output_it != node->OutputNodesEnd(); ++output_it) {
+      const auto output_index = output_it->Index();
+      if (graph_viewer.GetNode(output_index) != nullptr && --pending_inputs[output_index] == 0) {
+        ready_nodes.push(output_index);
+      }
+    }
+  }
+
+  ORT_RETURN_IF_NOT(scheduled_nodes == p_graph_nodes.size(), "CriticalPathPartitioner failed to schedule ",
+                    p_graph_nodes.size() - scheduled_nodes, " nodes");
+
+  if (need_save_) {
+    for (auto node_index : p_graph_nodes) {
+      node_costs_[node_names[node_index]] = costs[node_index];
+    }
+  }
+
+  return Status::OK();
+}
+
+double CriticalPathPartitioner::GetNodeCost(const Node& node, const std::string& node_name) const {
+  auto it = node_costs_.find(node_name);
+  if (it != node_costs_.end()) {
+    return it->second;
+  }
+
+  // Estimate the cost by the number of output elements, times the reduction length of matrix multiplications and
+  // convolutions. Unknown dimensions count as 1.
+  auto element_count = [](const NodeArg* arg, int skip_leading_dims) {
+    double count = 1.0;
+    const auto* shape = arg->Shape();
+    if (shape != nullptr) {
+      for (int i = skip_leading_dims; i < shape->dim_size(); ++i) {
+        if (shape->dim(i).has_dim_value()) {
+          count *= static_cast<double>(shape->dim(i).dim_value());
+        }
+      }
+    }
+    return count;
+  };
+
+  double output_elements = 0.0;
+  for (const auto* output : node.OutputDefs()) {
+    if (output->Exists()) {
+      output_elements += element_count(output, 0);
+    }
+  }
+
+  double reduction_length = 1.0;
+  const auto& op_type = node.OpType();
+  const auto& inputs = node.InputDefs();
+  if (op_type == "MatMul" || op_type == "Gemm" || op_type == "FusedMatMul" || op_type == "MatMulInteger") {
+    const auto* shape = inputs[0]->Shape();
+    if (shape != nullptr && shape->dim_size() > 0 && shape->dim(shape->dim_size() - 1).has_dim_value()) {
+      reduction_length = static_cast<double>(shape->dim(shape->dim_size() - 1).dim_value());
+    }
+  } else if ((op_type == "Conv" || op_type == "FusedConv") && inputs.size() > 1) {
+    reduction_length = element_count(inputs[1], 1);
+  }
+
+  return std::max(output_elements * reduction_length, 1.0);
+}
+
+void CriticalPathPartitioner::LoadProfile(const std::string& profile_file) {
+  std::ifstream if_stream(profile_file);
+  if (!if_stream.is_open()) {
+    LOGS(logger_, WARNING) << "Failed to open profile " << profile_file << " for CriticalPathPartitioner";
+    return;
+  }
+
+  constexpr std::string_view kernel_time_suffix = "_kernel_time";
+  InlinedHashMap<std::string, std::vector<double>> durations;
+  json events = json::parse(if_stream);
+  for (const auto& event : events) {
+    if (!event.is_object() || event.value("cat", "") != "Node") {
+      continue;
+    }
+    const std::string name = event.value("name", "");
+    if (name.size() > kernel_time_suffix.size() &&
+        name.compare(name.size() - kernel_time_suffix.size(), kernel_time_suffix.size(), kernel_time_suffix) == 0) {
+      durations[name.substr(0, name.size() - kernel_time_suffix.size())].push_back(event.value("dur", 0.0));
+    }
+  }
+
+  // the first run includes one-off work such as prepacking, so it is skipped when there are later runs
+  for (const auto& [node_name, node_durations] : durations) {
+    const size_t skip = node_durations.size() > 1 ? 1 : 0;
+    double sum = 0.0;
+    for (size_t i = skip; i < node_durations.size(); ++i) {
+      sum += node_durations[i];
+    }
+    node_costs_[node_name] = sum / static_cast<double>(node_durations.size() - skip);
+  }
+}
+
+void CriticalPathPartitioner::Initialize() {
+  if (config_file_.empty()) {
+    return;
+  }
+  std::ifstream if_stream(config_file_);
+  if (!if_stream.is_open()) {
+    // when config file specified but cannot be read, write it.
+    need_save_ = true;
+    return;
+  }
+  try {
+    json json_config = json::parse(if_stream);
+    if (json_config.contains("cpu_streams")) {
+      cpu_streams_ = std::max<size_t>(json_config["cpu_streams"].get<size_t>(), 1);
+    }
+    if (json_config.contains("profile")) {
+      LoadProfile(json_config["profile"].get<std::string>());
+    }
+    if (json_config.contains("costs")) {
+      for (const auto& [node_name, cost] : json_config["costs"].items()) {
+        node_costs_[node_name] = cost.get<double>();
+      }
+    }
+  } catch (const std::exception& ex) {
+    LOGS(logger_, WARNING) << "Caught exception when reading CriticalPathPartitioner config: " << ex.what();
+    node_costs_.clear();
+  }
+  if_stream.close();
+}
+
+void CriticalPathPartitioner::SaveConfig() const {
+  ORT_TRY {
+    json json_config;
+    json_config["type"] = "CriticalPathPartitioner";
+    json_config["cpu_streams"] = cpu_streams_;
+    json_config["costs"] = json::object();
+    for (const auto& [node_name, cost] : node_costs_) {
+      json_config["costs"][node_name] = cost;
+    }
+    json_config["streams"] = json::array();
+    for (const auto& node_stream : node_names_by_stream_) {
+      auto node_array = json::array();
+      for (const auto& node_name : node_stream) {
+        node_array.insert(node_array.end(), node_name);
+      }
+      json_config["streams"].insert(json_config["streams"].end(), node_array);
+    }
+    std::ofstream of_stream(config_file_);
+    if (of_stream.is_open()) {
+      of_stream << json_config.dump();
+      of_stream.close();
+    }
+  }
+  ORT_CATCH(const std::exception& ex) {
+    LOGS(logger_, WARNING) << "Caught exception during saving CriticalPathPartitioner config: " << ex.what();
+  }
+}
+
 std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(const logging::Logger& logger,
-                                                                             const PathString& config_file) {
+                                                                             const PathString& config_file,
+                                                                             bool use_dedicated_copy_stream,
+                                                                             size_t critical_path_cpu_streams,
+                                                                             bool use_dedicated_collective_stream) {
   // use device based partitioner by default
   IGraphPartitioner::GraphPartitioningStrategy partitioner_type =
-      IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition;
+      critical_path_cpu_streams > 1 ? IGraphPartitioner::GraphPartitioningStrategy::CriticalPathPartition
+                                    : IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition;
   if (!config_file.empty()) {
     std::ifstream f(config_file);
     if (f.is_open()) {
@@ -2555,6 +2979,8 @@ std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(con
           auto type = json_config["type"];
           if (type == "DeviceBasedPartitioner") {
             partitioner_type = IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition;
+          } else if (type == "CriticalPathPartitioner") {
+            partitioner_type = IGraphPartitioner::GraphPartitioningStrategy::CriticalPathPartition;
           }
         }
       } catch (const std::exception& ex) {
@@ -2565,7 +2991,12 @@ std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(con
   }
   if (partitioner_type == IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition) {
     LOGS(logger, INFO) << "Use DeviceBasedPartition as default";
-    return std::make_unique<DeviceBasedPartitioner>(logger, config_file);
+    return std::make_unique<DeviceBasedPartitioner>(logger, config_file, use_dedicated_copy_stream,
+                                                    use_dedicated_collective_stream);
+  } else if (partitioner_type == IGraphPartitioner::GraphPartitioningStrategy::CriticalPathPartition) {
+    LOGS(logger, INFO) << "Use CriticalPathPartition";
+    return std::make_unique<CriticalPathPartitioner>(logger, config_file, use_dedicated_copy_stream,
+                                                     use_dedicated_collective_stream, critical_path_cpu_streams);
   }  // else if other partitioner types ...
   ORT_THROW("Failed to create partitioner");
 }
@@ -46,15 +46,31 @@ class ISequentialPlannerContext {
   virtual ExecutionOrder GetExecutionOrder() const { return ExecutionOrder::DEFAULT; }
 
   virtual bool GetEnableMemoryReuse() const { return true; }
+
+  // If it returns true, copy nodes between host and device are partitioned into a separate stream per device.
+  virtual bool UseDedicatedCopyStream() const { return false; }
+
+  // If it returns true, collective communication nodes of a non-CPU device are partitioned into a separate stream
+  // per device.
+  virtual bool UseDedicatedCollectiveStream() const { return false; }
+
+  // If it returns more than 1, the CPU nodes are spread over up to that many streams by the critical path
+  // partitioner, see CriticalPathPartitioner.
+  virtual size_t GetCriticalPathCpuStreams() const { return 0; }
   virtual ~ISequentialPlannerContext() = default;
 };
 
 class SequentialPlannerContext : public ISequentialPlannerContext {
  public:
-  SequentialPlannerContext(ExecutionMode execution_mode, ExecutionOrder execution_order, bool enable_memory_reuse)
+  SequentialPlannerContext(ExecutionMode execution_mode, ExecutionOrder execution_order, bool enable_memory_reuse,
+                           bool use_dedicated_copy_stream = false, size_t critical_path_cpu_streams = 0,
+                           bool use_dedicated_collective_stream = false)
       : execution_mode_(execution_mode),
         exection_order_(execution_order),
-        enable_memory_reuse_(enable_memory_reuse) {
+        enable_memory_reuse_(enable_memory_reuse),
+        use_dedicated_copy_stream_(use_dedicated_copy_stream),
+        critical_path_cpu_streams_(critical_path_cpu_streams),
+        use_dedicated_collective_stream_(use_dedicated_collective_stream) {
   }
 
   const ONNX_NAMESPACE::TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const override {
@@ -67,10 +83,19 @@ class SequentialPlannerContext : public ISequentialPlannerContext {
 
   bool GetEnableMemoryReuse() const override { return enable_memory_reuse_; }
 
+  bool UseDedicatedCopyStream() const override { return use_dedicated_copy_stream_; }
+
+  bool UseDedicatedCollectiveStream() const override { return use_dedicated_collective_stream_; }
+
+  size_t GetCriticalPathCpuStreams() const override { return critical_path_cpu_streams_; }
+
  private:
   ExecutionMode execution_mode_ = ExecutionMode::ORT_SEQUENTIAL;
   ExecutionOrder exection_order_ = ExecutionOrder::DEFAULT;
   bool enable_memory_reuse_ = true;
+  bool use_dedicated_copy_stream_ = false;
+  size_t critical_path_cpu_streams_ = 0;
+  bool use_dedicated_collective_stream_ = false;
 };
 
 #ifdef ORT_ENABLE_STREAM
@@ -82,16 +107,25 @@ class IGraphPartitioner {
   // DeviceBasedPartitioner is the default, who partitions a graph based off device information.
   // i.e., given a graph which has CPU EP nodes, Cuda EP nodes and TRT EP nodes,
   // it will be partitioned as two sequences, one is for CPU EP nodes, another is for TRT and Cuda nodes.
-  // We will add more optimized partitioner later.
+  // With use_dedicated_copy_stream, the MemcpyFromHost/MemcpyToHost nodes of a non-CPU device get a third
+  // sequence of their own. Likewise use_dedicated_collective_stream gives the collective communication nodes
+  // (e.g. NcclAllReduce) of a non-CPU device a sequence of their own, so they overlap with the compute nodes.
+  // CriticalPathPartitioner spreads the CPU nodes over several streams by list scheduling them on estimated or
+  // profiled node costs, so that the longest chain of dependent nodes is started first.
   enum GraphPartitioningStrategy {
     DeviceBasedPartition = 0,
+    CriticalPathPartition,
     Unknown,
   };
   virtual ~IGraphPartitioner() = default;
   // create the partition based on the partition type.
   // perform partition based on the user input when provided.
+  // critical_path_cpu_streams > 1 selects the critical path partitioner when the config file does not name a type.
   static std::unique_ptr<IGraphPartitioner> CreateGraphPartitioner(const logging::Logger& logger,
-                                                                   const PathString& config_file);
+                                                                   const PathString& config_file,
+                                                                   bool use_dedicated_copy_stream = false,
+                                                                   size_t critical_path_cpu_streams = 0,
+                                                                   bool use_dedicated_collective_stream = false);
   virtual Status PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
                                 const ExecutionProviders& execution_providers,
                                 std::vector<InlinedVector<NodeIndex>>& stream_nodes,
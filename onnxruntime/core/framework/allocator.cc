@@ -124,6 +124,9 @@ void* AllocateBufferWithOptions(IAllocator& alloc, size_t size, bool use_reserve
     ORT_UNUSED_PARAMETER(wait_fn);
 #endif  // ORT_ENABLE_STREAM
   }
+  if (stream && alloc.IsStreamOrdered()) {
+    return alloc.AllocStreamOrdered(size, stream);
+  }
   return alloc.Alloc(size);
 }
 }  // namespace onnxruntime
@@ -22,6 +22,9 @@ struct AllocatorStats {
                                   // is known. Certain allocator may return 0 to indicate the limit is
                                   // unknown.
   int64_t bytes_limit;
+  int64_t num_thread_cache_hits;    // Number of allocations served by the thread caches of an arena without locking.
+  int64_t num_thread_cache_misses;  // Number of allocations small enough for the thread caches that used the bins.
+                                    // Chunks held in the thread caches of an arena count as bytes in use.
 
   AllocatorStats() { Clear(); }
 
@@ -35,6 +38,14 @@ struct AllocatorStats {
     this->max_alloc_size = 0;
     this->bytes_limit = 0;
     this->total_allocated_bytes = 0;
+    this->num_thread_cache_hits = 0;
+    this->num_thread_cache_misses = 0;
+  }
+
+  // Fraction of the allocations eligible for the thread caches that were served by them.
+  double ThreadCacheHitRate() const {
+    const int64_t lookups = this->num_thread_cache_hits + this->num_thread_cache_misses;
+    return lookups == 0 ? 0.0 : static_cast<double>(this->num_thread_cache_hits) / static_cast<double>(lookups);
   }
 
   std::string DebugString() const {
@@ -47,7 +58,9 @@ struct AllocatorStats {
        << "NumReserves:              " << this->num_reserves << "\n"
        << "NumArenaExtensions:       " << this->num_arena_extensions << "\n"
        << "NumArenaShrinkages:       " << this->num_arena_shrinkages << "\n"
-       << "MaxAllocSize:             " << this->max_alloc_size << "\n";
+       << "MaxAllocSize:             " << this->max_alloc_size << "\n"
+       << "NumThreadCacheHits:       " << this->num_thread_cache_hits << "\n"
+       << "NumThreadCacheMisses:     " << this->num_thread_cache_misses << "\n";
     return ss.str();
   }
 };
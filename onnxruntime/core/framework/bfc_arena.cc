@@ -3,16 +3,45 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/bfc_arena.h"
+#include <algorithm>
 #include <type_traits>
 
 namespace onnxruntime {
+
+// The caches of the current thread, one per arena the thread allocated from.
+// They are flushed back to the bins of their arena when the thread exits.
+struct ThreadLocalCaches {
+  struct Entry {
+    uint64_t arena_id;
+    std::weak_ptr<BFCArena::ThreadCacheRegistry> registry;
+    std::shared_ptr<BFCArena::ThreadCache> cache;
+  };
+
+  ~ThreadLocalCaches() {
+    for (auto& entry : entries) {
+      auto registry = entry.registry.lock();
+      if (registry) {
+        std::lock_guard<OrtMutex> lock(registry->mutex);
+        if (registry->arena) {
+          registry->arena->ReleaseThreadCache(entry.cache);
+        }
+      }
+    }
+  }
+
+  std::vector<Entry> entries;
+};
+
+static thread_local ThreadLocalCaches thread_local_caches;
+
 BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                    size_t total_memory,
                    ArenaExtendStrategy arena_extend_strategy,
                    int initial_chunk_size_bytes,
                    int max_dead_bytes_per_chunk,
                    int initial_growth_chunk_size_bytes,
-                   int64_t max_power_of_two_extend_bytes)
+                   int64_t max_power_of_two_extend_bytes,
+                   int thread_cache_max_chunk_bytes)
     : IAllocator(OrtMemoryInfo(resource_allocator->Info().name,
                                OrtAllocatorType::OrtArenaAllocator,
                                resource_allocator->Info().device,
@@ -25,12 +54,20 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       initial_chunk_size_bytes_(initial_chunk_size_bytes),
       max_dead_bytes_per_chunk_(max_dead_bytes_per_chunk),
       initial_growth_chunk_size_bytes_(initial_growth_chunk_size_bytes),
-      max_power_of_two_extend_bytes_(max_power_of_two_extend_bytes) {
+      max_power_of_two_extend_bytes_(max_power_of_two_extend_bytes),
+      thread_cache_max_chunk_bytes_(thread_cache_max_chunk_bytes > 0
+                                        ? RoundedBytes(static_cast<size_t>(thread_cache_max_chunk_bytes))
+                                        : 0),
+      thread_cache_arena_id_([]() {
+        static std::atomic<uint64_t> next_arena_id{0};
+        return next_arena_id++;
+      }()) {
   LOGS_DEFAULT(INFO) << "Creating BFCArena for " << device_allocator_->Info().name
                      << " with following configs: initial_chunk_size_bytes: " << initial_chunk_size_bytes_
                      << " max_dead_bytes_per_chunk: " << max_dead_bytes_per_chunk_
                      << " initial_growth_chunk_size_bytes: " << initial_growth_chunk_size_bytes_
                      << " max_power_of_two_extend_bytes: " << max_power_of_two_extend_bytes_
+                     << " thread_cache_max_chunk_bytes: " << thread_cache_max_chunk_bytes_
                      << " memory limit: " << total_memory
                      << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy);
 
@@ -58,6 +95,12 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
     // Do not consider the first allocation region for shrinkage
     consider_first_allocation_region_for_shrinkage_ = false;
   }
+
+  if (thread_cache_max_chunk_bytes_ > 0) {
+    thread_cache_registry_ = std::make_shared<ThreadCacheRegistry>();
+    thread_cache_registry_->arena = this;
+  }
+
   // Create a bunch of bins of various good sizes.
 
   // We create bins to fit all possible ranges that cover the
@@ -78,6 +121,12 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
 }
 
 BFCArena::~BFCArena() {
+  if (thread_cache_registry_) {
+    // threads exiting from now on leave the arena alone. the chunks of their caches are released with the regions.
+    std::lock_guard<OrtMutex> lock(thread_cache_registry_->mutex);
+    thread_cache_registry_->arena = nullptr;
+  }
+
   for (const auto& region : region_manager_.regions()) {
     device_allocator_->Free(region.ptr());
   }
@@ -322,10 +371,37 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   // so all memory addresses are nicely byte aligned.
   size_t rounded_bytes = RoundedBytes(num_bytes);
 
+  // Small allocations that are not associated with a stream are served from the cache of the thread if possible.
+  ThreadCache* thread_cache = nullptr;
+  size_t thread_cache_class = 0;
+  if (stream == nullptr && rounded_bytes <= thread_cache_max_chunk_bytes_) {
+    thread_cache = GetThreadCache(true);
+    thread_cache_class = rounded_bytes / kMinAllocationSize - 1;
+    std::lock_guard<OrtMutex> cache_lock(thread_cache->mutex);
+    auto& free_chunks = thread_cache->free_chunks[thread_cache_class];
+    if (!free_chunks.empty()) {
+      void* ptr = free_chunks.back();
+      free_chunks.pop_back();
+      ++num_thread_cache_hits_;
+      return ptr;
+    }
+    ++num_thread_cache_misses_;
+  }
+
   // The BFC allocator tries to find the best fit first.
   BinNum bin_num = BinNumForSize(rounded_bytes);
 
   std::lock_guard<OrtMutex> lock(lock_);
+
+  // chunks allocated for a thread cache are returned to it when freed by the same thread.
+  auto attach_to_thread_cache = [&](Chunk* chunk) {
+    if (thread_cache) {
+      chunk->thread_cache = thread_cache;
+      std::lock_guard<OrtMutex> cache_lock(thread_cache->mutex);
+      thread_cache->chunk_classes.insert_or_assign(chunk->ptr, thread_cache_class);
+    }
+  };
+
   // search for a valid chunk
   auto* chunk = FindChunkPtr(bin_num,
                              rounded_bytes,
@@ -341,6 +417,7 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
       if (stream)
         chunk->stream_timestamp = stream->GetCurrentTimestamp();
     }
+    attach_to_thread_cache(chunk);
     return chunk->ptr;
   }
 
@@ -356,6 +433,7 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
       if (chunk->stream == nullptr && stream) {
         chunk->stream = stream;
       }
+      attach_to_thread_cache(chunk);
       return chunk->ptr;
     } else {
       status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
@@ -379,6 +457,67 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<OrtMutex> lock(lock_);
   *stats = stats_;
+  stats->num_thread_cache_hits = num_thread_cache_hits_;
+  stats->num_thread_cache_misses = num_thread_cache_misses_;
+  // allocations served by a thread cache don't go through the bins
+  stats->num_allocs += stats->num_thread_cache_hits;
+}
+
+BFCArena::ThreadCache* BFCArena::GetThreadCache(bool create) {
+  auto& entries = thread_local_caches.entries;
+  for (const auto& entry : entries) {
+    if (entry.arena_id == thread_cache_arena_id_) {
+      return entry.cache.get();
+    }
+  }
+
+  if (!create) {
+    return nullptr;
+  }
+
+  // drop the caches of the arenas that were destroyed
+  entries.erase(std::remove_if(entries.begin(), entries.end(),
+                               [](const ThreadLocalCaches::Entry& entry) { return entry.registry.expired(); }),
+                entries.end());
+
+  auto cache = std::make_shared<ThreadCache>();
+  cache->free_chunks.resize(thread_cache_max_chunk_bytes_ / kMinAllocationSize);
+  {
+    std::lock_guard<OrtMutex> lock(lock_);
+    thread_caches_.push_back(cache);
+  }
+
+  entries.push_back({thread_cache_arena_id_, thread_cache_registry_, cache});
+  return cache.get();
+}
+
+void BFCArena::FlushThreadCache(ThreadCache& cache, bool detach) {
+  std::lock_guard<OrtMutex> cache_lock(cache.mutex);
+  for (auto& free_chunks : cache.free_chunks) {
+    for (void* ptr : free_chunks) {
+      cache.chunk_classes.erase(ptr);
+      BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
+      ORT_ENFORCE(h != kInvalidChunkHandle);
+      ChunkFromHandle(h)->thread_cache = nullptr;
+      FreeAndMaybeCoalesce(h);
+    }
+    free_chunks.clear();
+  }
+
+  if (detach) {
+    for (const auto& chunk_class : cache.chunk_classes) {
+      BFCArena::ChunkHandle h = region_manager_.get_handle(chunk_class.first);
+      ORT_ENFORCE(h != kInvalidChunkHandle);
+      ChunkFromHandle(h)->thread_cache = nullptr;
+    }
+    cache.chunk_classes.clear();
+  }
+}
+
+void BFCArena::ReleaseThreadCache(const std::shared_ptr<ThreadCache>& cache) {
+  std::lock_guard<OrtMutex> lock(lock_);
+  FlushThreadCache(*cache, true);
+  thread_caches_.erase(std::remove(thread_caches_.begin(), thread_caches_.end(), cache), thread_caches_.end());
 }
 
 BFCArena::Chunk* BFCArena::SplitFreeChunkFromBin(BFCArena::Bin::FreeChunkSet* free_chunks,
@@ -496,6 +635,22 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+
+  if (thread_cache_max_chunk_bytes_ > 0) {
+    ThreadCache* thread_cache = GetThreadCache(false);
+    if (thread_cache) {
+      std::lock_guard<OrtMutex> cache_lock(thread_cache->mutex);
+      auto it = thread_cache->chunk_classes.find(p);
+      if (it != thread_cache->chunk_classes.end()) {
+        auto& free_chunks = thread_cache->free_chunks[it->second];
+        if (free_chunks.size() < kMaxChunksPerThreadCacheClass) {
+          free_chunks.push_back(p);
+          return;
+        }
+      }
+    }
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
@@ -510,6 +665,10 @@ void BFCArena::Free(void* p) {
 
 Status BFCArena::Shrink() {
   std::lock_guard<OrtMutex> lock(lock_);
+  for (const auto& thread_cache : thread_caches_) {
+    FlushThreadCache(*thread_cache, false);
+  }
+
   auto num_regions = region_manager_.regions().size();
   std::vector<void*> region_ptrs;
   std::vector<size_t> region_sizes;
@@ -578,6 +737,14 @@ void BFCArena::DeallocateRawInternal(void* ptr) {
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
 
+  // A chunk of a thread cache freed by another thread, or when the free list of its size class is full.
+  Chunk* c = ChunkFromHandle(h);
+  if (c->thread_cache) {
+    std::lock_guard<OrtMutex> cache_lock(c->thread_cache->mutex);
+    c->thread_cache->chunk_classes.erase(ptr);
+    c->thread_cache = nullptr;
+  }
+
   // Consider coalescing it.
   FreeAndMaybeCoalesce(h);
 }
@@ -16,9 +16,12 @@ limitations under the License.
 
 #pragma once
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 
 #include "onnxruntime_config.h"
 
@@ -61,6 +64,10 @@ class BFCArena : public IAllocator {
   static const int DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES = 2 * 1024 * 1024;
   static const int64_t DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES = 1024 * 1024 * 1024;  // 1GB
   static const size_t DEFAULT_MAX_MEM = std::numeric_limits<size_t>::max();
+  // Thread caches are disabled by default.
+  static const int DEFAULT_THREAD_CACHE_MAX_CHUNK_BYTES = 0;
+  // Maximum number of free chunks of a size class kept in a thread cache before they go back to the bins.
+  static const size_t kMaxChunksPerThreadCacheClass = 64;
 
   enum ArenaType {
     BaseArena,
@@ -73,7 +80,8 @@ class BFCArena : public IAllocator {
            int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
            int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
            int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
-           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES);
+           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+           int thread_cache_max_chunk_bytes = DEFAULT_THREAD_CACHE_MAX_CHUNK_BYTES);
 
   ~BFCArena() override;
 
@@ -86,12 +94,13 @@ class BFCArena : public IAllocator {
   void Free(void* p) override;
 
   // Frees all allocation regions in which no chunk is in use.
+  // The free chunks held by the thread caches are returned to the bins first.
   // Does not free any reserved chunks.
   // Resets the size that the arena will grow by in the next allocation to
   // `initial_growth_chunk_size_bytes_` but ultimately all
   // future allocation sizes are determined by the arena growth strategy
   // and the allocation request.
-  Status Shrink();
+  Status Shrink() override;
 
   void* Reserve(size_t size) override;
 
@@ -132,6 +141,8 @@ class BFCArena : public IAllocator {
   static const int kInvalidBinNum = -1;
   static const int kNumBins = 21;
 
+  struct ThreadCache;
+
   // Chunks point to memory.  Their prev/next pointers form a
   // doubly-linked list of addresses sorted by base address that
   // must be contiguous.  Chunks contain information about whether
@@ -170,6 +181,10 @@ class BFCArena : public IAllocator {
 
     uint64_t stream_timestamp = 0;
 
+    // The thread cache the chunk was handed out through, if any.
+    // The chunk stays in use from the point of view of the bins while it is in the free list of the cache.
+    ThreadCache* thread_cache = nullptr;
+
     bool in_use() const { return allocation_id != -1; }
 
     std::string DebugString(BFCArena* a, bool recurse) {
@@ -223,6 +238,39 @@ class BFCArena : public IAllocator {
   static const size_t kMinAllocationBits = 8;
   static const size_t kMinAllocationSize = 1 << kMinAllocationBits;
 
+  // Per thread free lists of small chunks in front of the bins, similar to the thread caches of tcmalloc.
+  // An allocation of at most thread_cache_max_chunk_bytes_ bytes that is not associated with a stream first looks for
+  // a free chunk of its size class (its size rounded up to kMinAllocationSize) in the cache of the calling thread,
+  // and a chunk freed by the thread that allocated it goes back to that cache, without taking lock_ either way.
+  // The mutex of a cache is only contended when another thread frees a chunk of the cache or the caches are flushed.
+  // Lock order is lock_ before ThreadCache::mutex.
+  struct ThreadCache {
+    OrtMutex mutex;
+    // free chunks per size class
+    std::vector<std::vector<void*>> free_chunks;
+    // the chunks handed out through this cache that are in use or in free_chunks, and their size class
+    std::unordered_map<void*, size_t> chunk_classes;
+  };
+
+  // Shared with the thread local caches so that a thread exiting after the arena was destroyed doesn't touch it.
+  struct ThreadCacheRegistry {
+    OrtMutex mutex;
+    BFCArena* arena;
+  };
+
+  friend struct ThreadLocalCaches;
+
+  // Returns the cache of the calling thread, creating it if it doesn't exist yet and `create` is true.
+  ThreadCache* GetThreadCache(bool create);
+
+  // Returns the free chunks of `cache` to the bins. If `detach` is true the chunks of the cache that are in use
+  // are also detached from it so they are freed to the bins, and the cache is unregistered.
+  // Must be called with lock_ held.
+  void FlushThreadCache(ThreadCache& cache, bool detach);
+
+  // Flushes and unregisters the cache of an exiting thread.
+  void ReleaseThreadCache(const std::shared_ptr<ThreadCache>& cache);
+
   // AllocationRegion maps pointers to ChunkHandles for a single
   // contiguous memory region.
   //
@@ -509,6 +557,16 @@ class BFCArena : public IAllocator {
   const int initial_growth_chunk_size_bytes_;
   const int64_t max_power_of_two_extend_bytes_;
 
+  const size_t thread_cache_max_chunk_bytes_;
+  // Unique id of the arena so the thread local caches can't be confused with the ones of a destroyed arena
+  // allocated at the same address.
+  const uint64_t thread_cache_arena_id_;
+  std::shared_ptr<ThreadCacheRegistry> thread_cache_registry_;
+  // All the caches of the threads that allocated from this arena. Guarded by lock_.
+  std::vector<std::shared_ptr<ThreadCache>> thread_caches_;
+  std::atomic<int64_t> num_thread_cache_hits_{0};
+  std::atomic<int64_t> num_thread_cache_misses_{0};
+
   // This flag is only relevant if Shrink() is invoked.
   // This is a boolean flag that controls whether the first allocation region
   // is to be considered for shrinkage or not.
@@ -29,6 +29,14 @@ std::string ConfigOptions::GetConfigOrDefault(const std::string& config_key,
   return GetConfigEntry(config_key).value_or(default_value);
 }
 
+std::string ConfigOptions::GetConfigOrDefault(const char* config_key, const char* default_value) const noexcept {
+  if (configurations.empty()) {
+    return default_value;
+  }
+
+  return GetConfigOrDefault(std::string{config_key}, std::string{default_value});
+}
+
 Status ConfigOptions::AddConfigEntry(const char* config_key, const char* config_value) noexcept {
   std::string key = config_key;
   if (key.empty() || key.length() > 128)
@@ -30,6 +30,9 @@ struct ConfigOptions {
   // If there is no such config, the given default string will be returned
   std::string GetConfigOrDefault(const std::string& config_key, const std::string& default_value) const noexcept;
 
+  // As above, without building the key if there are no configs, e.g. for the run options read by every Run.
+  std::string GetConfigOrDefault(const char* config_key, const char* default_value) const noexcept;
+
   // Add a config pair (config_key, config_value) to this instance of ConfigOptions
   Status AddConfigEntry(const char* config_key, const char* config_value) noexcept;
 
@@ -3,9 +3,21 @@
 // Licensed under the MIT License.
 #include "core/framework/copy.h"
 
+#include <algorithm>
+#include <cstring>
+
+#if (defined(_M_AMD64) || defined(__x86_64__)) && !defined(_M_ARM64EC)
+#include <emmintrin.h>
+#define ORT_HAS_NON_TEMPORAL_COPY
+#endif
+
 namespace onnxruntime {
 
 TensorShapeVector StridesForTensor(const Tensor& tensor) {
+#ifdef ENABLE_STRIDED_TENSORS
+  const auto strides = tensor.Strides();
+  return TensorShapeVector(strides.begin(), strides.end());
+#else
   const auto& shape = tensor.Shape();
   TensorShapeVector strides(shape.NumDimensions());
   int64_t running_size = 1;
@@ -15,6 +27,7 @@ TensorShapeVector StridesForTensor(const Tensor& tensor) {
   }
 
   return strides;
+#endif
 }
 
 namespace {
@@ -94,4 +107,61 @@ void CoalesceDimensions(std::initializer_list<std::reference_wrapper<TensorShape
   }
 }
 
+void MemcpyNonTemporal(void* dst, const void* src, size_t num_bytes) {
+#if defined(ORT_HAS_NON_TEMPORAL_COPY)
+  auto* d = static_cast<uint8_t*>(dst);
+  const auto* s = static_cast<const uint8_t*>(src);
+  if (num_bytes < 256) {
+    memcpy(d, s, num_bytes);
+    return;
+  }
+
+  // copy up to the first 16 byte aligned destination address, then stream whole cache lines
+  const size_t head = (16 - (reinterpret_cast<uintptr_t>(d) & 15)) & 15;
+  memcpy(d, s, head);
+  d += head;
+  s += head;
+  num_bytes -= head;
+
+  for (; num_bytes >= 64; num_bytes -= 64, d += 64, s += 64) {
+    const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+    const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+    const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+    const __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d), v0);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), v1);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), v2);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), v3);
+  }
+  memcpy(d, s, num_bytes);
+
+  // make the streamed stores visible before another thread reads the destination
+  _mm_sfence();
+#else
+  memcpy(dst, src, num_bytes);
+#endif
+}
+
+void ParallelMemcpy(concurrency::ThreadPool* thread_pool, void* dst, const void* src, size_t num_bytes) {
+  // partition on 4 KiB boundaries so that threads do not write to the same cache lines
+  constexpr size_t kBlockBytes = 4096;
+  const bool non_temporal = num_bytes >= kStreamingCopyMinBytes;
+  auto* d = static_cast<uint8_t*>(dst);
+  const auto* s = static_cast<const uint8_t*>(src);
+
+  const size_t num_blocks = (num_bytes + kBlockBytes - 1) / kBlockBytes;
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(num_blocks),
+      {static_cast<double>(kBlockBytes), static_cast<double>(kBlockBytes), 0.0},
+      [d, s, num_bytes, non_temporal](std::ptrdiff_t first, std::ptrdiff_t last) {
+        const size_t begin = static_cast<size_t>(first) * kBlockBytes;
+        const size_t end = std::min(static_cast<size_t>(last) * kBlockBytes, num_bytes);
+        if (non_temporal) {
+          MemcpyNonTemporal(d + begin, s + begin, end - begin);
+        } else {
+          memcpy(d + begin, s + begin, end - begin);
+        }
+      });
+}
+
 }  // namespace onnxruntime
@@ -17,6 +17,22 @@ void CoalesceDimensions(
 
 TensorShapeVector StridesForTensor(const Tensor& tensor);
 
+// Copies of at least this many bytes are not expected to fit in the last level cache and are written with
+// non-temporal stores where the platform supports them, so they do not evict the working set of other kernels.
+constexpr size_t kStreamingCopyMinBytes = size_t{16} * 1024 * 1024;
+
+/*
+    Copy num_bytes from src to dst, which must not overlap. The destination is written with non-temporal stores
+    where the platform supports them and with memcpy otherwise.
+*/
+void MemcpyNonTemporal(void* dst, const void* src, size_t num_bytes);
+
+/*
+    Copy num_bytes from src to dst, which must not overlap. The copy is partitioned by bytes across the thread pool
+    and copies of at least kStreamingCopyMinBytes use non-temporal stores.
+*/
+void ParallelMemcpy(concurrency::ThreadPool* thread_pool, void* dst, const void* src, size_t num_bytes);
+
 namespace strided_copy_detail {
 
 template <typename T>
@@ -29,11 +45,15 @@ void Copy1DNonContiguous(T* dst, int64_t dst_stride, const T* src, int64_t src_s
 }
 
 template <typename T>
-void Copy1DContiguous(T* dst, const T* src, std::ptrdiff_t count) {
+void Copy1DContiguous(T* dst, const T* src, std::ptrdiff_t count, bool non_temporal = false) {
   if constexpr (std::is_same_v<std::string, T>) {
     Copy1DNonContiguous(dst, 1, src, 1, count);
   } else {
-    memcpy(dst, src, count * sizeof(T));
+    if (non_temporal) {
+      MemcpyNonTemporal(dst, src, count * sizeof(T));
+    } else {
+      memcpy(dst, src, count * sizeof(T));
+    }
   }
 }
 
@@ -139,6 +159,13 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
 
   const std::size_t dims = copy_shape.size();
 
+  if constexpr (!std::is_same_v<std::string, T>) {
+    if (dims == 1 && src_strides[0] == 1 && dst_strides[0] == 1) {
+      ParallelMemcpy(thread_pool, dst, src, static_cast<size_t>(total_num_elements_to_copy) * sizeof(T));
+      return;
+    }
+  }
+
   // TODOs for when we have strided tensors:
   // - Reorder dimensions so that we iterate along the smallest strides first
 
@@ -154,10 +181,15 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
     // the size of contiguous spans that we can copy before having to advance the non-contiguous stride
     std::ptrdiff_t contiguous_span_size = static_cast<std::ptrdiff_t>(dims == 2 ? copy_shape[1] : copy_shape[0]);
 
+    // stream the spans to memory only when the spans are long enough to fill whole cache lines
+    const bool non_temporal = static_cast<size_t>(total_num_elements_to_copy) * sizeof(T) >= kStreamingCopyMinBytes &&
+                              static_cast<size_t>(contiguous_span_size) * sizeof(T) >= 4096;
+
     concurrency::ThreadPool::TryParallelFor(
         thread_pool, static_cast<std::ptrdiff_t>(total_num_elements_to_copy),
         {static_cast<float>(sizeof(T)), static_cast<float>(sizeof(T)), 1.0F},
-        [src_stride, dst_stride, dst, src, contiguous_span_size](std::ptrdiff_t first, std::ptrdiff_t last) {
+        [src_stride, dst_stride, dst, src, contiguous_span_size, non_temporal](std::ptrdiff_t first,
+                                                                               std::ptrdiff_t last) {
           // get the current inner and outer index
           std::ptrdiff_t inner = first % contiguous_span_size;
           std::ptrdiff_t outer = first / contiguous_span_size;
@@ -170,7 +202,8 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
             auto elements_to_copy = contiguous_span_size - inner;
             // never copy more than what is in our partition
             elements_to_copy = std::min<std::ptrdiff_t>(elements_to_copy, last - first);
-            strided_copy_detail::Copy1DContiguous<T>(dst + dst_idx, src + src_idx, elements_to_copy);
+            strided_copy_detail::Copy1DContiguous<T>(dst + dst_idx, src + src_idx, elements_to_copy,
+                                                     non_temporal);
             inner = 0;
             outer++;
             first += elements_to_copy;
@@ -182,7 +215,7 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
 
           // Step 2: copy contiguous span by contiguous span until we reach the penultimate span
           while (first < last - contiguous_span_size) {
-            strided_copy_detail::Copy1DContiguous<T>(dst + dst_idx, src + src_idx, contiguous_span_size);
+            strided_copy_detail::Copy1DContiguous<T>(dst + dst_idx, src + src_idx, contiguous_span_size, non_temporal);
             dst_idx += dst_stride;
             src_idx += src_stride;
             first += contiguous_span_size;
@@ -191,7 +224,7 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
           // element in our partition
           ORT_ENFORCE(last >= first);
           auto last_span_size = last - first;
-          strided_copy_detail::Copy1DContiguous<T>(dst + dst_idx, src + src_idx, last_span_size);
+          strided_copy_detail::Copy1DContiguous<T>(dst + dst_idx, src + src_idx, last_span_size, non_temporal);
         });
   } else {
     // enforce that the lambda doesn't change anything
@@ -0,0 +1,198 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/ep_context_cache.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <vector>
+
+#include "core/common/narrow.h"
+#include "core/framework/murmurhash3.h"
+
+namespace onnxruntime {
+
+namespace {
+
+constexpr size_t kDigestLength = 32;
+
+// Keeps entry names usable as file names whatever the EP uses as a model tag.
+std::string MakeEntryPrefix(std::string_view ep_type, std::string_view model_tag) {
+  std::string prefix;
+  prefix.reserve(ep_type.size() + model_tag.size() + 2);
+  for (const std::string_view part : {ep_type, model_tag}) {
+    std::transform(part.begin(), part.end(), std::back_inserter(prefix), [](char c) {
+      return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '.' ? c : '_';
+    });
+    prefix += '_';
+  }
+
+  return prefix;
+}
+
+// Returns true if `suffix` is a key digest optionally followed by an extension.
+bool IsDigestWithExtension(std::string_view suffix) {
+  if (suffix.size() < kDigestLength ||
+      !std::all_of(suffix.begin(), suffix.begin() + kDigestLength,
+                   [](char c) { return std::isxdigit(static_cast<unsigned char>(c)); })) {
+    return false;
+  }
+
+  return suffix.size() == kDigestLength || suffix[kDigestLength] == '.';
+}
+
+}  // namespace
+
+void EpContextCacheKey::Update(const void* data, size_t size) {
+  // MurmurHash3 takes an int length so large components are hashed in chunks which are chained through the hash
+  constexpr size_t kChunkSize = size_t{1} << 20;
+  const auto* bytes = static_cast<const char*>(data);
+  do {
+    const size_t chunk_size = std::min(size, kChunkSize);
+    std::array<uint32_t, 8> combined{};
+    std::copy(hash_.begin(), hash_.end(), combined.begin());
+    MurmurHash3::x86_128(bytes, narrow<int>(chunk_size), 0, combined.data() + 4);
+    MurmurHash3::x86_128(combined.data(), narrow<int>(sizeof(combined)), 0, hash_.data());
+    bytes += chunk_size;
+    size -= chunk_size;
+  } while (size > 0);
+}
+
+EpContextCacheKey& EpContextCacheKey::Add(std::string_view name, std::string_view value) {
+  return AddBytes(name, value.data(), value.size());
+}
+
+EpContextCacheKey& EpContextCacheKey::AddBytes(std::string_view name, const void* data, size_t size) {
+  // the sizes keep ("ab", "c") and ("a", "bc") apart
+  const std::array<uint64_t, 2> sizes{name.size(), size};
+  Update(sizes.data(), sizeof(sizes));
+  Update(name.data(), name.size());
+  Update(data, size);
+  return *this;
+}
+
+Status EpContextCacheKey::AddFile(std::string_view name, const PathString& path) {
+  std::ifstream file(path, std::ifstream::in | std::ifstream::binary);
+  ORT_RETURN_IF_NOT(file.is_open(), "Failed to open ", PathToUTF8String(path), " to compute the EP context cache key.");
+
+  const uint64_t name_size = name.size();
+  Update(&name_size, sizeof(name_size));
+  Update(name.data(), name.size());
+
+  std::vector<char> buffer(size_t{1} << 20);
+  while (file) {
+    file.read(buffer.data(), buffer.size());
+    Update(buffer.data(), narrow<size_t>(file.gcount()));
+  }
+
+  ORT_RETURN_IF_NOT(file.eof(), "Failed to read ", PathToUTF8String(path), " to compute the EP context cache key.");
+  return Status::OK();
+}
+
+std::string EpContextCacheKey::HexDigest() const {
+  std::ostringstream ss;
+  ss << std::hex << std::setfill('0');
+  for (const auto value : hash_) {
+    ss << std::setw(8) << value;
+  }
+
+  return ss.str();
+}
+
+PathString EpContextCacheDirectory::GetEntryPath(std::string_view ep_type, std::string_view model_tag,
+                                                 const EpContextCacheKey& key, std::string_view extension) const {
+  std::string entry_name = MakeEntryPrefix(ep_type, model_tag) + key.HexDigest();
+  entry_name.append(extension);
+  return (std::filesystem::path(directory_) / ToPathString(entry_name)).native();
+}
+
+bool EpContextCacheDirectory::HasEntry(std::string_view ep_type, std::string_view model_tag,
+                                       const EpContextCacheKey& key, std::string_view extension) const {
+  std::error_code ec;
+  return std::filesystem::exists(GetEntryPath(ep_type, model_tag, key, extension), ec);
+}
+
+bool EpContextCacheDirectory::ReadEntry(std::string_view ep_type, std::string_view model_tag,
+                                        const EpContextCacheKey& key, std::string& blob) const {
+  std::ifstream file(GetEntryPath(ep_type, model_tag, key), std::ifstream::in | std::ifstream::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  blob.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  return !file.bad();
+}
+
+Status EpContextCacheDirectory::WriteEntry(std::string_view ep_type, std::string_view model_tag,
+                                           const EpContextCacheKey& key, const void* data, size_t size) const {
+  std::error_code ec;
+  std::filesystem::create_directories(directory_, ec);
+  ORT_RETURN_IF(ec, "Failed to create ", PathToUTF8String(directory_), ": ", ec.message());
+
+  const PathString temp_file_path = GetEntryPath(ep_type, model_tag, key) + ORT_TSTR(".tmp");
+  {
+    std::ofstream out(temp_file_path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    ORT_RETURN_IF_NOT(out.good(), "Failed to open ", PathToUTF8String(temp_file_path), " for writing.");
+    out.write(static_cast<const char*>(data), narrow<std::streamsize>(size));
+    ORT_RETURN_IF_NOT(out.good(), "Failed to write ", PathToUTF8String(temp_file_path), ".");
+  }
+
+  return AddEntry(ep_type, model_tag, key, temp_file_path);
+}
+
+Status EpContextCacheDirectory::AddEntry(std::string_view ep_type, std::string_view model_tag,
+                                         const EpContextCacheKey& key, const PathString& source_path,
+                                         std::string_view extension) const {
+  std::error_code ec;
+  std::filesystem::create_directories(directory_, ec);
+  ORT_RETURN_IF(ec, "Failed to create ", PathToUTF8String(directory_), ": ", ec.message());
+
+  const PathString entry_path = GetEntryPath(ep_type, model_tag, key, extension);
+  std::filesystem::rename(source_path, entry_path, ec);
+  if (ec && std::filesystem::exists(entry_path)) {
+    // another session added the same entry first, which is as good as ours
+    std::filesystem::remove_all(source_path, ec);
+    ec.clear();
+  }
+
+  ORT_RETURN_IF(ec, "Failed to move ", PathToUTF8String(source_path), " to ", PathToUTF8String(entry_path), ": ",
+                ec.message());
+
+  return RemoveOutdatedEntries(ep_type, model_tag, key);
+}
+
+Status EpContextCacheDirectory::RemoveOutdatedEntries(std::string_view ep_type, std::string_view model_tag,
+                                                      const EpContextCacheKey& key) const {
+  const std::string prefix = MakeEntryPrefix(ep_type, model_tag);
+  const std::string digest = key.HexDigest();
+
+  std::error_code ec;
+  std::vector<std::filesystem::path> outdated_entries;
+  for (const auto& entry : std::filesystem::directory_iterator(directory_, ec)) {
+    const std::string entry_name = PathToUTF8String(entry.path().filename().native());
+    if (entry_name.compare(0, prefix.size(), prefix) != 0) {
+      continue;
+    }
+
+    const std::string_view suffix = std::string_view{entry_name}.substr(prefix.size());
+    if (IsDigestWithExtension(suffix) && suffix.substr(0, kDigestLength) != digest) {
+      outdated_entries.push_back(entry.path());
+    }
+  }
+
+  ORT_RETURN_IF(ec, "Failed to list ", PathToUTF8String(directory_), ": ", ec.message());
+
+  for (const auto& path : outdated_entries) {
+    // an entry still in use by another process may fail to be removed, it is retried the next time
+    std::filesystem::remove_all(path, ec);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
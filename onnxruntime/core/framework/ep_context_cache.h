@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <string_view>
+
+#include "core/common/common.h"
+#include "core/common/path_string.h"
+
+namespace onnxruntime {
+
+// Content hash that identifies a blob produced by an EP when it compiles a (sub)graph.
+//
+// An EP adds everything the compiled blob depends on: the serialized (sub)graph and external weights, the EP and
+// compiler versions, the driver version, the target device and the options that affect compilation. A change to any
+// of them produces a different key, so a stale blob is never looked up again instead of having to be detected.
+class EpContextCacheKey {
+ public:
+  // Adds a named component. Components are order sensitive.
+  EpContextCacheKey& Add(std::string_view name, std::string_view value);
+
+  // Adds a named component with binary content, e.g. a serialized model.
+  EpContextCacheKey& AddBytes(std::string_view name, const void* data, size_t size);
+
+  // Adds the content of the file at `path`, e.g. an external weights file.
+  Status AddFile(std::string_view name, const PathString& path);
+
+  // Returns the 128-bit hash of all the components as 32 lower case hex digits.
+  std::string HexDigest() const;
+
+ private:
+  void Update(const void* data, size_t size);
+
+  std::array<uint32_t, 4> hash_{};
+};
+
+// Directory shared by the compiling EPs to keep the blobs they produce across sessions and processes.
+//
+// An entry is a file or a directory named "<ep_type>_<model_tag>_<key digest><extension>". `model_tag` identifies
+// what was compiled independently of its content (e.g. the fused node name), so when an entry is added the entries
+// for the same EP and tag with another key are outdated and get removed. Entries are moved into place with a rename
+// so concurrent readers never see a partial entry.
+class EpContextCacheDirectory final {
+ public:
+  explicit EpContextCacheDirectory(PathString directory) : directory_(std::move(directory)) {}
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(EpContextCacheDirectory);
+
+  // Returns the path of the entry. The entry doesn't need to exist.
+  PathString GetEntryPath(std::string_view ep_type, std::string_view model_tag, const EpContextCacheKey& key,
+                          std::string_view extension = {}) const;
+
+  // Returns true if the entry exists.
+  bool HasEntry(std::string_view ep_type, std::string_view model_tag, const EpContextCacheKey& key,
+                std::string_view extension = {}) const;
+
+  // Reads the blob of a file entry. Returns false if there is no such entry.
+  bool ReadEntry(std::string_view ep_type, std::string_view model_tag, const EpContextCacheKey& key,
+                 std::string& blob) const;
+
+  // Writes a blob as a file entry and removes the outdated entries for the same EP and model tag.
+  Status WriteEntry(std::string_view ep_type, std::string_view model_tag, const EpContextCacheKey& key,
+                    const void* data, size_t size) const;
+
+  // Moves the file or directory at `source_path` (e.g. a compiled model package) into the cache as an entry and
+  // removes the outdated entries for the same EP and model tag. `source_path` should be on the same volume.
+  Status AddEntry(std::string_view ep_type, std::string_view model_tag, const EpContextCacheKey& key,
+                  const PathString& source_path, std::string_view extension = {}) const;
+
+  const PathString& GetDirectory() const { return directory_; }
+
+ private:
+  Status RemoveOutdatedEntries(std::string_view ep_type, std::string_view model_tag,
+                               const EpContextCacheKey& key) const;
+
+  const PathString directory_;
+};
+
+}  // namespace onnxruntime
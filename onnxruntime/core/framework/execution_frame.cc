@@ -5,6 +5,7 @@
 
 #include <sstream>
 
+#include "core/common/safeint.h"
 #include "core/framework/mem_pattern_planner.h"
 #include "core/framework/execution_plan_base.h"
 #include "core/framework/sequential_execution_plan.h"
@@ -48,7 +49,23 @@ IExecutionFrame::IExecutionFrame(const OrtValueNameIdxMap& ort_value_idx_map,
               "node_index_info and ort_value_idx_map are out of sync and cannot be used");
 }
 
-IExecutionFrame::~IExecutionFrame() = default;
+IExecutionFrame::~IExecutionFrame() {
+  if (value_storage_ != nullptr) {
+    // release the values but keep the allocation for the next frame
+    for (auto& value : all_values_) {
+      value = OrtValue();
+    }
+    value_storage_->swap(all_values_);
+  }
+}
+
+void IExecutionFrame::UseValueStorage(InlinedVector<OrtValue>* value_storage) {
+  ORT_ENFORCE(all_values_.empty(), "UseValueStorage must be called before Init");
+  value_storage_ = value_storage;
+  if (value_storage_ != nullptr) {
+    all_values_.swap(*value_storage_);
+  }
+}
 
 #ifdef ENABLE_ATEN
 Status IExecutionFrame::SetOutputMLValue(int index, const OrtValue& ort_value) {
@@ -66,7 +83,6 @@ Status IExecutionFrame::SetOutputMLValue(int index, const OrtValue& ort_value) {
 }
 #endif
 
-#ifdef ENABLE_TRAINING
 void IExecutionFrame::UpdateFeeds(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds) {
   ORT_ENFORCE(feed_mlvalue_idxs.size() == feeds.size());
 
@@ -115,6 +131,12 @@ void IExecutionFrame::UpdateFetches(gsl::span<const int> fetch_mlvalue_idxs,
   }
 }
 
+void IExecutionFrame::ClearValues(gsl::span<const int> ort_value_idxs) {
+  for (int ort_value_idx : ort_value_idxs) {
+    all_values_[ort_value_idx] = OrtValue();
+  }
+}
+
 Status IExecutionFrame::GetOutputs(gsl::span<const int> fetch_mlvalue_idxs, std::vector<OrtValue>& fetches) {
   auto num_fetches = fetch_mlvalue_idxs.size();
 
@@ -136,8 +158,6 @@ Status IExecutionFrame::GetOutputs(gsl::span<const int> fetch_mlvalue_idxs, std:
   return Status::OK();
 }
 
-#endif
-
 // Return nullptr if index map to a value that is an unused optional input/output
 const OrtValue* IExecutionFrame::GetNodeInputOrOutputMLValue(int index) const {
   int ort_value_idx = GetNodeIdxToMLValueIdx(index);
@@ -191,6 +211,31 @@ Status IExecutionFrame::GetOrCreateNodeOutputMLValue(const int output_index, int
   return status;
 }
 
+Status IExecutionFrame::CreateNodeOutputView(int output_arg_index, const TensorShape& shape, const Tensor& input,
+                                             size_t byte_offset, OrtValue*& p_ort_value) {
+  p_ort_value = nullptr;
+  int ort_value_idx = GetNodeIdxToMLValueIdx(output_arg_index);
+  if (ort_value_idx == NodeIndexInfo::kInvalidEntry || !IsPlannedView(ort_value_idx)) {
+    return Status::OK();
+  }
+
+  OrtValue& ort_value = all_values_[ort_value_idx];
+  if (ort_value.IsAllocated()) {
+    return Status::OK();
+  }
+
+  const size_t num_bytes = SafeInt<size_t>(shape.Size()) * input.DataType()->Size();
+  ORT_RETURN_IF_NOT(SafeInt<size_t>(byte_offset) + num_bytes <= input.SizeInBytes(),
+                    "View of ", num_bytes, " bytes at offset ", byte_offset, " exceeds the input of ",
+                    input.SizeInBytes(), " bytes");
+
+  // the view does not own the data, the allocation plan keeps the input alive for as long as the view is used
+  Tensor::InitOrtValue(input.DataType(), shape, const_cast<void*>(input.DataRaw()), input.Location(), ort_value,
+                       static_cast<ptrdiff_t>(byte_offset));
+  p_ort_value = &ort_value;
+  return Status::OK();
+}
+
 bool IExecutionFrame::TryGetInferredShape(int /*index*/, TensorShape& /*shape*/) const {
   // By default, there is no information about inferred shape, so this default
   // implementation always returns false. The derived class of IExecutionFrame
@@ -351,13 +396,15 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
 #ifdef ORT_ENABLE_STREAM
                                const DeviceStreamCollection* device_streams,
 #endif
-                               const SessionState& session_state)
+                               const SessionState& session_state,
+                               InlinedVector<OrtValue>* value_storage)
     : IExecutionFrame(session_state.GetOrtValueNameIdxMap(), session_state.GetNodeIndexInfo(), fetch_mlvalue_idxs),
 #ifdef ORT_ENABLE_STREAM
       device_streams_(device_streams),
 #endif
       session_state_(session_state),
       mem_patterns_(nullptr) {
+  UseValueStorage(value_storage);
   Init(
       feed_mlvalue_idxs, feeds, session_state.GetInitializedTensors(),
 #if !defined(DISABLE_SPARSE_TENSORS)
@@ -406,11 +453,19 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
 
     // if there are some traditional ml value type in inputs disable the memory pattern optimization.
     if (all_tensors) {
-      mem_patterns_ = session_state.GetMemoryPatternGroup(feeds, feed_mlvalue_idxs, inferred_shapes_);
-      // if no existing patterns, generate one in this execution frame
-      if (!mem_patterns_) {
+      if (session_state.IsMemoryPatternShapeBucketingEnabled()) {
+        bucketed_mem_patterns_ = session_state.GetBucketedMemoryPatternGroup(feeds);
+        mem_patterns_ = bucketed_mem_patterns_.get();
         planner_.emplace(*session_state.GetExecutionPlan());
       } else {
+        mem_patterns_ = session_state.GetMemoryPatternGroup(feeds, feed_mlvalue_idxs, inferred_shapes_);
+        // if no existing patterns, generate one in this execution frame
+        if (!mem_patterns_) {
+          planner_.emplace(*session_state.GetExecutionPlan());
+        }
+      }
+
+      if (mem_patterns_) {
         // pre-allocate the big chunk requested in memory pattern.
         // all the internal kernel's input/output tensors will be allocated on these buffer.
         buffers_.reserve(mem_patterns_->locations.size());
@@ -418,7 +473,7 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
           const auto& location = mem_patterns_->locations[i];
           ORT_ENFORCE(buffers_.find(location) == buffers_.end());
           if (mem_patterns_->patterns[i].PeakSize() > 0) {
-            AllocatorPtr alloc = GetAllocator(location);
+            AllocatorPtr alloc = session_state.GetMemoryPatternAllocator(location);
             void* buffer = nullptr;
             // it's possible we can't allocate the large block. if we have memory patterns we know we have successfully
             // executed once before, so if there's an arena involved it probably has smaller blocks available.
@@ -494,6 +549,28 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
 
 ExecutionFrame::~ExecutionFrame() = default;
 
+Status ExecutionFrame::CopyStreamedWeightToDevice(int ort_value_idx, const OrtDevice& device, Stream* stream) {
+  const auto& initializers = session_state_.GetInitializedTensors();
+  auto it = initializers.find(ort_value_idx);
+  ORT_RETURN_IF(it == initializers.end(), "Streamed weight ", ort_value_idx, " is not an initializer");
+  const Tensor& src = it->second.Get<Tensor>();
+
+  AllocatorPtr alloc = GetAllocator(device);
+  ORT_RETURN_IF_NOT(alloc, "Failed to get allocator for ", device.ToString());
+
+  OrtValue& dest = GetMutableMLValue(ort_value_idx);
+  Tensor::InitOrtValue(src.DataType(), src.Shape(), std::move(alloc), dest);
+  Tensor& dst = *dest.GetMutable<Tensor>();
+  if (stream != nullptr) {
+    return session_state_.GetDataTransferMgr().CopyTensorAsync(src, dst, *stream);
+  }
+  return session_state_.GetDataTransferMgr().CopyTensor(src, dst);
+}
+
+void ExecutionFrame::ReleaseStreamedWeight(int ort_value_idx) {
+  GetMutableMLValue(ort_value_idx) = OrtValue();
+}
+
 Status ExecutionFrame::CopyTensor(const Tensor& src, Tensor& dest) const {
   return session_state_.GetDataTransferMgr().CopyTensor(src, dest);
 }
@@ -549,7 +626,8 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
         auto it = buffers_.find(location);
         if (it != buffers_.end()) {
           // if the block is not correct, log message then fall back to default behavior
-          if (block->size_ == size) {
+          // a bucketed pattern was generated for the largest shapes of the bucket so any smaller tensor fits
+          if (block->size_ == size || (bucketed_mem_patterns_ && block->size_ > size)) {
             void* buffer = it->second.get();
             auto status = AllocateTensorWithPreAllocateBufferHelper(
                 ort_value, static_cast<void*>(static_cast<char*>(buffer) + block->offset_), element_type, location,
@@ -564,6 +642,9 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
                                                    << ", block in memory pattern size is: " << block->size_
                                                    << " but the actual size is: " << size
                                                    << ", fall back to default allocation behavior";
+            if (bucketed_mem_patterns_ && block->size_ < size) {
+              bucketed_mem_patterns_overflow_ = true;
+            }
           }
         }
         // else { we couldn't allocate the large block for the buffer so we didn't insert an entry }
@@ -586,6 +667,10 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
           current_stream->GetDevice().Type(), current_stream->GetDevice().Type());
       void* p_data = stream_aware_alloc->AllocOnStream(buffer_size, current_stream, wait_handle);
       Tensor::InitOrtValue(element_type, shape, p_data, std::move(alloc), ort_value);
+    } else if (alloc->IsStreamOrdered()) {
+      size_t buffer_size = Tensor::CalculateTensorStorageSize(element_type, shape);
+      void* p_data = alloc->AllocStreamOrdered(buffer_size, current_stream);
+      Tensor::InitOrtValue(element_type, shape, p_data, std::move(alloc), ort_value);
     } else {
       Tensor::InitOrtValue(element_type, shape, std::move(alloc), ort_value);
     }
@@ -758,6 +843,13 @@ Status ExecutionFrame::AllocateAsPerAllocationPlan(OrtValue& ort_value, int ort_
         break;
       }
       case AllocKind::kReuse: {
+        if (per_alloc_plan.is_view) {
+          // the kernel did not create the output as a view of its input, so it needs a buffer of its own
+          ORT_RETURN_IF_ERROR(AllocateMLValueTensorSelfOwnBuffer(ort_value, ort_value_index, ml_data_type,
+                                                                 alloc_info, *shape));
+          break;
+        }
+
         int reuse_mlvalue_index = per_alloc_plan.reused_buffer;
 
         ORT_RETURN_IF_ERROR(AllocateReusedOrtValueIfNotAllocatedHelper(reuse_mlvalue_index, shape));
@@ -846,6 +938,10 @@ Status ExecutionFrame::CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_
 #endif
 }
 
+bool ExecutionFrame::IsPlannedView(int ort_value_idx) const {
+  return session_state_.GetPerValueAllocPlan()[ort_value_idx].is_view;
+}
+
 void ExecutionFrame::VerifyOutputSizes(int output_index, const Node& node, const TensorShape& output_shape) {
   const NodeArg* output_def = node.OutputDefs()[output_index];
   const auto* expected_shape = output_def->Shape();
@@ -886,10 +982,10 @@ const AllocPlanPerValue& ExecutionFrame::GetAllocationPlan(int ort_value_idx) {
 
 void ExecutionFrame::TraceAllocate(int ort_value_idx, size_t size) {
   if (planner_.has_value()) {
-    // don't trace the output tensors or external outputs.
+    // don't trace the output tensors, external outputs or views that fell back to a buffer of their own.
     auto& allocation_plan = GetAllocationPlan(ort_value_idx);
     if (allocation_plan.alloc_kind == AllocKind::kAllocateOutput ||
-        allocation_plan.alloc_kind == AllocKind::kAllocatedExternally) {
+        allocation_plan.alloc_kind == AllocKind::kAllocatedExternally || allocation_plan.is_view) {
       return;
     }
     auto status = planner_->TraceAllocation(ort_value_idx, size);
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -42,6 +44,10 @@ class IExecutionFrame {
             const std::function<bool(const std::string& name)>& is_initializer_sparse_func,
             gsl::span<const OrtValue> fetches);
 
+  // Use the vector at `value_storage` as the storage of the frame's values, to reuse its allocation. Must be called
+  // before Init. The (cleared) values are handed back to `value_storage` when the frame is destroyed.
+  void UseValueStorage(InlinedVector<OrtValue>* value_storage);
+
  public:
   virtual ~IExecutionFrame();
 
@@ -59,14 +65,19 @@ class IExecutionFrame {
   Status SetOutputMLValue(int index, const OrtValue& ort_value);
 #endif
 
-#ifdef ENABLE_TRAINING
-  // Referenced by PartialGraphExecutionState which is applicable when using ORTModule.
-  // These wont be needed when using ORT Training APIs
+  // Set the feeds and fetches of a frame that is executed more than once. Referenced by PartialGraphExecutionState
+  // which is applicable when using ORTModule, and by CpuGraph. The values must have been released.
   void UpdateFeeds(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds);
   void UpdateFetches(gsl::span<const int> fetch_mlvalue_idxs, gsl::span<const OrtValue> fetches,
-
                      const std::unordered_map<int, OrtValue>& initializers);
+
+  // Release the given values without tracing them for the memory pattern, so that the frame can be executed again.
+  void ClearValues(gsl::span<const int> ort_value_idxs);
+
+  // Write the given values to the 'fetches' vector, e.g. the intermediate values of a partial execution.
   Status GetOutputs(gsl::span<const int> fetch_mlvalue_idxs, std::vector<OrtValue>& fetches);
+
+#ifdef ENABLE_TRAINING
   // if OOM happens, then release all values, so session can run next batch.
   void ReleaseAllMLValues();
 #endif
@@ -78,6 +89,12 @@ class IExecutionFrame {
   Status GetOrCreateNodeOutputMLValue(const int index, int output_arg_index, const TensorShape* shape,
                                       OrtValue*& p_ort_value, const Node& node);
 
+  // Create the output as a view of 'input' starting at byte_offset, if the allocation plan allows it and the
+  // output is not allocated yet. p_ort_value is nullptr otherwise, and the output needs to be created with
+  // GetOrCreateNodeOutputMLValue.
+  Status CreateNodeOutputView(int output_arg_index, const TensorShape& shape, const Tensor& input,
+                              size_t byte_offset, OrtValue*& p_ort_value);
+
   // This function try retrieve the inferred shapes for the given NodeArg index.
   // If the retrieval is successful, this function returns true and false otherwise.
   virtual bool TryGetInferredShape(int index, TensorShape& shape) const;
@@ -119,6 +136,9 @@ class IExecutionFrame {
 
   virtual Status CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_value_idx, const TensorShape* shape) = 0;
 
+  // returns true if the allocation plan made the OrtValue a view of a node input
+  virtual bool IsPlannedView(int /*ort_value_idx*/) const { return false; }
+
   virtual Status CopyTensor(const Tensor& src, Tensor& dest) const = 0;
 
   virtual const DataTransferManager& GetDataTransferManager() const = 0;
@@ -129,6 +149,9 @@ class IExecutionFrame {
   // Input and Output values are passed in by executors
   InlinedVector<OrtValue> all_values_;
 
+  // optional external owner of the all_values_ allocation. see UseValueStorage
+  InlinedVector<OrtValue>* value_storage_{nullptr};
+
   // perf optimization to avoid calling all_values_.size() repeatedly as the size is fixed once constructed
   const size_t all_values_size_;
 
@@ -146,7 +169,9 @@ class ExecutionFrame final : public IExecutionFrame {
 #ifdef ORT_ENABLE_STREAM
                  const DeviceStreamCollection* device_streams,
 #endif
-                 const SessionState& session_state);
+                 const SessionState& session_state,
+                 // optional storage for the values that is reused across frames. see IExecutionFrame::UseValueStorage
+                 InlinedVector<OrtValue>* value_storage = nullptr);
   ~ExecutionFrame() override;
 
   // TODO: These two AllocateMLValue... methods are in the API purely for unit test usage.
@@ -162,10 +187,24 @@ class ExecutionFrame final : public IExecutionFrame {
   // thread-safe
   Status GeneratePatterns(MemoryPatternGroup& out);
 
+  // Weight streaming: allocate the streamed weight at `ort_value_idx` on `device` and copy the host copy of the
+  // weight to it on `stream`, or synchronously if `stream` is nullptr. Consumers on `stream` see the device copy.
+  Status CopyStreamedWeightToDevice(int ort_value_idx, const OrtDevice& device, Stream* stream);
+
+  // Free the device copy of a streamed weight once all its consumers ran.
+  void ReleaseStreamedWeight(int ort_value_idx);
+
   bool HasMemoryPatternPlanner() const {
     return planner_.has_value();
   }
 
+  // Returns true if the memory allocations of this execution were traced and the memory pattern cache
+  // should be updated with the generated patterns, either as there was no pattern for the input shapes or
+  // as some tensors didn't fit in the blocks of the pattern of their shape bucket.
+  bool ShouldUpdateMemoryPatterns() const {
+    return planner_.has_value() && (mem_patterns_ == nullptr || bucketed_mem_patterns_overflow_);
+  }
+
   // This function try retrieve the inferred shapes for the given NodeArg index.
   // If the retrival is sucessful, this function returns true and false otherwise.
   bool TryGetInferredShape(int index, TensorShape& shape) const override;
@@ -198,6 +237,7 @@ class ExecutionFrame final : public IExecutionFrame {
   AllocatorPtr GetAllocatorImpl(const OrtDevice& info) const override;
   Status ReleaseMLValueImpl(int ort_value_idx) override;
   Status CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_value_idx, const TensorShape* shape) override;
+  bool IsPlannedView(int ort_value_idx) const override;
   void VerifyOutputSizes(int output_index, const Node& node, const TensorShape& output_shape) override;
   Status CopyTensor(const Tensor& src, Tensor& dest) const override;
   const DataTransferManager& GetDataTransferManager() const override;
@@ -233,6 +273,12 @@ class ExecutionFrame final : public IExecutionFrame {
   // kernel's input/output tensors.
   const MemoryPatternGroup* mem_patterns_;
 
+  // Keeps the pattern of a shape bucket alive while it is used, as the session state may replace or evict it.
+  // The tensors may be smaller than the blocks of a bucketed pattern and the allocations are always traced so
+  // the pattern can be regenerated if a tensor doesn't fit in its block.
+  std::shared_ptr<const MemoryPatternGroup> bucketed_mem_patterns_;
+  std::atomic<bool> bucketed_mem_patterns_overflow_{false};
+
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
   std::optional<OrtValuePatternPlanner> planner_;
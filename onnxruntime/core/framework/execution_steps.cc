@@ -62,14 +62,16 @@ Status LaunchKernelStep::Execute(StreamExecutionContext& ctx,
                                  SessionScope& session_scope,
                                  const bool& terminate_flag,
                                  bool& continue_flag) {
-#ifdef ENABLE_TRAINING
-  // legacy code required by ORTTrainer. Should be removed when ORTTrainer is removed
+  // Skip the nodes that don't contribute to the requested fetches. The streamed weights scheduled around the node
+  // are still copied and released so that the other nodes find them as planned.
   auto* node_to_execute = ctx.GetNodeToExecute();
   if (node_to_execute && node_to_execute->count(node_index_) == 0) {
+    ORT_RETURN_IF_ERROR(ctx.PrefetchStreamedWeights(node_index_, stream_idx));
+    ctx.ReleaseStreamedWeights(node_index_);
     continue_flag = true;
     return Status::OK();
   }
-#endif
+
   Status status = ExecuteKernel(ctx, node_index_, stream_idx, terminate_flag, session_scope);
   continue_flag = status.IsOK();
   return status;
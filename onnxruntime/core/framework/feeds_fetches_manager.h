@@ -101,10 +101,16 @@ class FeedsFetchesManager {
   const DeviceCopyChecks& GetDeviceCopyChecks() const { return device_copy_checks_; }
   void SetDeviceCopyChecks(DeviceCopyCheck input_copy_needed, DeviceCopyCheck output_copy_needed);
 
+  // Keeps the copy info of a manager reused by runs whose feeds and fetches have the same locations, e.g. the runs
+  // of a frozen IOBinding, so utils::ExecuteGraph doesn't initialize and finalize it again.
+  void FreezeCopyInfo() { copy_info_frozen_ = true; }
+  bool IsCopyInfoFrozen() const { return copy_info_frozen_; }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(FeedsFetchesManager);
 
   DeviceCopyChecks device_copy_checks_ = {};
+  bool copy_info_frozen_ = false;
 
   FeedsFetchesInfo feeds_fetches_info_;
 
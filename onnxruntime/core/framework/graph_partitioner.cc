@@ -16,6 +16,7 @@
 #include "core/graph/function_utils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
+#include "core/platform/threadpool.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 
 // uncomment this line to count non-CUDA ops in ONNX domain
@@ -59,6 +60,7 @@ struct PartitionParams {
   std::reference_wrapper<const layout_transformation::TransformLayoutFunction> transform_layout_function;
   std::reference_wrapper<const layout_transformation::DebugGraphFn> debug_graph_fn;
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+  concurrency::ThreadPool* thread_pool;
 };
 }  // namespace
 
@@ -131,6 +133,60 @@ struct GetCapabilityForEPParams {
   std::reference_wrapper<const layout_transformation::TransformLayoutFunction> transform_layout;
   std::reference_wrapper<const layout_transformation::DebugGraphFn> debug_graph_fn;
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+  concurrency::ThreadPool* thread_pool;
+};
+
+// Kernel lookup that looks up the kernels of all the nodes of a graph in parallel when it's created.
+// The GetCapability of kernel based EPs looks up every node of the graph, which dominates partitioning on large
+// graphs. Nodes that weren't looked up ahead, e.g. ones created by the EP, are looked up on demand.
+class PrefetchedKernelLookup final : public IExecutionProvider::IKernelLookup {
+ public:
+  PrefetchedKernelLookup(const KernelLookup& kernel_lookup, const KernelRegistryManager& kernel_registry_mgr,
+                         const GraphViewer& graph_viewer, concurrency::ThreadPool* thread_pool)
+      : kernel_lookup_{kernel_lookup} {
+    // below this size the lookups are cheaper than dispatching them to the thread pool
+    constexpr int kMinNodesToPrefetch = 256;
+    if (graph_viewer.NumberOfNodes() < kMinNodesToPrefetch ||
+        concurrency::ThreadPool::DegreeOfParallelism(thread_pool) <= 1) {
+      return;
+    }
+
+    InlinedVector<const Node*> graph_nodes;
+    graph_nodes.reserve(graph_viewer.NumberOfNodes());
+    for (const auto& node : graph_viewer.Nodes()) {
+      graph_nodes.push_back(&node);
+    }
+
+    kernel_registry_mgr.PrepareConcurrentKernelLookup(graph_nodes);
+
+    nodes_.resize(graph_viewer.MaxNodeIndex(), nullptr);
+    kernels_.resize(graph_viewer.MaxNodeIndex(), nullptr);
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(graph_nodes.size()),
+        // a lookup hashes the op and matches the type constraints of a few kernel defs
+        TensorOpCost{0.0, 0.0, 1000.0},
+        [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t i = begin; i < end; ++i) {
+            const Node* node = graph_nodes[i];
+            kernels_[node->Index()] = kernel_lookup_.LookUpKernel(*node);
+            nodes_[node->Index()] = node;
+          }
+        });
+  }
+
+  const KernelCreateInfo* LookUpKernel(const Node& node) const override {
+    const auto index = node.Index();
+    if (index < nodes_.size() && nodes_[index] == &node) {
+      return kernels_[index];
+    }
+
+    return kernel_lookup_.LookUpKernel(node);
+  }
+
+ private:
+  const KernelLookup& kernel_lookup_;
+  std::vector<const Node*> nodes_;                // by node index, nullptr if not looked up ahead
+  std::vector<const KernelCreateInfo*> kernels_;  // by node index
 };
 
 auto get_capabilities = [](const IExecutionProvider& ep,
@@ -172,7 +228,10 @@ static Status GetCapabilityForEP(const GetCapabilityForEPParams& params) {
 
   {
     const GraphViewer graph_viewer(graph);
-    capabilities = get_capabilities(current_ep, graph_viewer, kernel_lookup);
+    const PrefetchedKernelLookup prefetched_kernel_lookup{kernel_lookup, kernel_registry_mgr, graph_viewer,
+                                                          kernel_registries_for_ep.empty() ? nullptr
+                                                                                           : params.thread_pool};
+    capabilities = get_capabilities(current_ep, graph_viewer, prefetched_kernel_lookup);
 
     if (capabilities.empty()) {
       return Status::OK();
@@ -359,7 +418,8 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
                                            GraphPartitioner::Mode mode,
                                            int& fused_node_unique_id,
                                            const layout_transformation::TransformLayoutFunction& transform_layout_fn,
-                                           const layout_transformation::DebugGraphFn& debug_graph_fn) {
+                                           const layout_transformation::DebugGraphFn& debug_graph_fn,
+                                           concurrency::ThreadPool* thread_pool) {
   // handle testing edge case where optimizers or constant lifting results in graph with no nodes.
   // doing it here saves all providers checking for this in GetCapability
   if (graph.NumberOfNodes() == 0) {
@@ -373,7 +433,7 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
       // we pass through the FuncManager from the top level graph
       ORT_RETURN_IF_ERROR(PartitionOnnxFormatModelImpl(*subgraph, func_mgr, kernel_registry_mgr,
                                                        fused_kernel_registry, current_ep, mode, fused_node_unique_id,
-                                                       transform_layout_fn, debug_graph_fn));
+                                                       transform_layout_fn, debug_graph_fn, thread_pool));
     }
   }
 
@@ -396,7 +456,8 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
       std::ref(capabilities),
       mode,
       std::cref(transform_layout_fn),
-      std::cref(debug_graph_fn)};
+      std::cref(debug_graph_fn),
+      thread_pool};
 
   ORT_RETURN_IF_ERROR(GetCapabilityForEP(get_capability_params));
   if (capabilities.empty()) {
@@ -742,7 +803,8 @@ static Status PartitionOnnxFormatModel(const PartitionParams& partition_params,
       ORT_RETURN_IF_ERROR(PartitionOnnxFormatModelImpl(graph, func_mgr, kernel_registry_manager,
                                                        fused_kernel_registry, *ep, mode, fused_node_unique_id,
                                                        transform_layout_function,
-                                                       partition_params.debug_graph_fn));
+                                                       partition_params.debug_graph_fn,
+                                                       partition_params.thread_pool));
     }
 
     // expand any nodes that have an ONNX function definition but no matching ORT kernel.
@@ -792,6 +854,7 @@ static Status PartitionOrtFormatModelImpl(const PartitionParams& partition_param
       std::cref(partition_params.transform_layout_function),
       std::cref(partition_params.debug_graph_fn),
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+      partition_params.thread_pool,
   };
   // clang-format on
 
@@ -962,6 +1025,7 @@ Status GraphPartitioner::Partition(Graph& graph, FuncManager& func_mgr,
       std::ref(fused_node_unique_id),
       std::cref(transform_layout_function),
       std::cref(debug_graph_fn),
+      thread_pool_,
   };
 
 #else  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -971,6 +1035,7 @@ Status GraphPartitioner::Partition(Graph& graph, FuncManager& func_mgr,
   ORT_UNUSED_PARAMETER(debug_graph_fn);
   PartitionParams partition_params{
       std::ref(graph),
+      thread_pool_,
   };
 
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
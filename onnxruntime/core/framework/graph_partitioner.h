@@ -14,6 +14,9 @@ class ExecutionProviders;
 class KernelRegistryManager;
 class Model;
 struct ConfigOptions;
+namespace concurrency {
+class ThreadPool;
+}
 
 class GraphPartitioner {
  public:
@@ -24,9 +27,13 @@ class GraphPartitioner {
   };
 
   // The order of providers represents the user preference.
-  GraphPartitioner(KernelRegistryManager& kernel_registry_mgr, const ExecutionProviders& providers)
+  // If `thread_pool` is provided, the kernels of the nodes of large graphs are looked up in parallel before the
+  // capabilities of each kernel based provider are queried.
+  GraphPartitioner(KernelRegistryManager& kernel_registry_mgr, const ExecutionProviders& providers,
+                   concurrency::ThreadPool* thread_pool = nullptr)
       : kernel_registry_mgr_(kernel_registry_mgr),
-        providers_(providers) {
+        providers_(providers),
+        thread_pool_(thread_pool) {
   }
 
   // Run partitioning.
@@ -64,6 +71,7 @@ class GraphPartitioner {
 
   KernelRegistryManager& kernel_registry_mgr_;
   const ExecutionProviders& providers_;
+  concurrency::ThreadPool* thread_pool_;
 };
 
 }  // namespace onnxruntime
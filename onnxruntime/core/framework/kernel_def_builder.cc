@@ -179,6 +179,12 @@ KernelDefBuilder& KernelDefBuilder::VariadicAlias(int input_offset, int output_o
   return *this;
 }
 
+KernelDefBuilder& KernelDefBuilder::MayOutputView(int input_index) {
+  ORT_ENFORCE(input_index >= 0);
+  kernel_def_->output_view_input_ = input_index;
+  return *this;
+}
+
 #ifdef ENABLE_STRIDED_TENSORS
 KernelDefBuilder& KernelDefBuilder::MayStridedInput(int input_index) {
   kernel_def_->may_strided_inputs_.emplace_back(input_index);
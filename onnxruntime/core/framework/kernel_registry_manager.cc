@@ -104,6 +104,17 @@ Status KernelRegistryManager::SearchKernelRegistry(const Node& node,
   return Status(ONNXRUNTIME, NOT_IMPLEMENTED, create_error_message("Failed to find kernel for "));
 }
 
+void KernelRegistryManager::PrepareConcurrentKernelLookup(gsl::span<const Node* const> nodes) const {
+#if !defined(ORT_MINIMAL_BUILD)
+  if (const auto* resolver = std::get_if<OpSchemaKernelTypeStrResolver>(&kernel_type_str_resolver_variant_)) {
+    resolver->RegisterNodeOpSchemas(nodes);
+  }
+#else
+  // KernelTypeStrResolver isn't modified by kernel lookups
+  ORT_UNUSED_PARAMETER(nodes);
+#endif
+}
+
 bool KernelRegistryManager::HasImplementationOf(const KernelRegistryManager& r, const Node& node, const std::string& provider_type) {
   const auto kernel_registries = r.GetKernelRegistriesByProviderType(provider_type);
   return std::any_of(kernel_registries.begin(), kernel_registries.end(), [&](const KernelRegistry* kernel_registry) {
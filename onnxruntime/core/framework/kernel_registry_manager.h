@@ -88,6 +88,10 @@ class KernelRegistryManager {
     kernel_type_str_resolver_variant_ = std::move(kernel_type_str_resolver);
   }
 
+  // Prepares the kernel type string resolver for kernel lookups of `nodes` from multiple threads.
+  // Must be called before the concurrent lookups and not concurrently with any other method.
+  void PrepareConcurrentKernelLookup(gsl::span<const Node* const> nodes) const;
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(KernelRegistryManager);
 
  private:
@@ -295,6 +295,15 @@ Status OpSchemaKernelTypeStrResolver::ResolveKernelTypeStr(
   ORT_RETURN_IF_ERROR(resolver_.ResolveKernelTypeStr(node, kernel_type_str, resolved_args));
   return Status::OK();
 }
+
+void OpSchemaKernelTypeStrResolver::RegisterNodeOpSchemas(gsl::span<const Node* const> nodes) const {
+  std::lock_guard lock{resolver_mutex_};
+  for (const Node* node : nodes) {
+    if (node->Op() != nullptr) {
+      ORT_IGNORE_RETURN_VALUE(resolver_.RegisterNodeOpSchema(*node));
+    }
+  }
+}
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 }  // namespace onnxruntime
@@ -125,6 +125,11 @@ class OpSchemaKernelTypeStrResolver final : public IKernelTypeStrResolver {
   Status ResolveKernelTypeStr(const Node& node, std::string_view kernel_type_str,
                               gsl::span<const ArgTypeAndIndex>& resolved_args) const override;
 
+  // Adds the op schemas of `nodes` to the cache ahead of ResolveKernelTypeStr() calls.
+  // ResolveKernelTypeStr() doesn't modify the cache for the nodes whose op schemas were added, so the args it
+  // returns for them stay valid while other threads resolve the kernel type strings of the same nodes.
+  void RegisterNodeOpSchemas(gsl::span<const Node* const> nodes) const;
+
  private:
   // used as a cache when resolving
   // since the cache may be modified with a const instance, ensure that access to the cache is thread-safe
@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/large_page_allocator.h"
+
+#include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+void* LargePageCPUAllocator::Alloc(size_t size) {
+  const Env& env = Env::Default();
+  const size_t large_page_size = env.GetLargePageSize();
+  if (large_page_size != 0 && size >= large_page_size) {
+    // keep the overrun AllocatorDefaultAlloc allows for MLAS
+    const size_t num_pages = (SafeInt<size_t>(size) + MLAS_SYMM_QGEMM_BUF_OVERRUN + (large_page_size - 1)) /
+                             large_page_size;
+    const size_t rounded_size = SafeInt<size_t>(num_pages) * large_page_size;
+    void* p = env.AllocateLargePages(rounded_size);
+    if (p != nullptr) {
+      std::lock_guard<OrtMutex> lock(mutex_);
+      large_page_buffers_.emplace(p, rounded_size);
+      return p;
+    }
+  }
+
+  return AllocatorDefaultAlloc(size);
+}
+
+void LargePageCPUAllocator::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  size_t large_page_buffer_size = 0;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = large_page_buffers_.find(p);
+    if (it != large_page_buffers_.end()) {
+      large_page_buffer_size = it->second;
+      large_page_buffers_.erase(it);
+    }
+  }
+
+  if (large_page_buffer_size != 0) {
+    Env::Default().FreeLargePages(p, large_page_buffer_size);
+  } else {
+    AllocatorDefaultFree(p);
+  }
+}
+
+}  // namespace onnxruntime
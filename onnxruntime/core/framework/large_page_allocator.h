@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/inlined_containers.h"
+#include "core/framework/allocator.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+// CPU allocator backing the buffers of at least one large page, e.g. the regions of the CPU arena, with the large
+// pages of Env::AllocateLargePages. The smaller buffers, and all of them if the platform has no large pages available,
+// are allocated like CPUAllocator does.
+class LargePageCPUAllocator : public IAllocator {
+ public:
+  LargePageCPUAllocator() : IAllocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator)) {}
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+
+ private:
+  OrtMutex mutex_;
+  // the size of each buffer allocated with large pages
+  InlinedHashMap<void*, size_t> large_page_buffers_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/memory_pattern_slab_pool.h"
+
+#include <algorithm>
+
+namespace onnxruntime {
+
+namespace {
+// The pool is not an arena even if the underlying allocator is, so callers don't treat it as a BFCArena.
+OrtMemoryInfo PoolMemoryInfo(const OrtMemoryInfo& info) {
+  return OrtMemoryInfo(info.name, OrtDeviceAllocator, info.device, info.id, info.mem_type);
+}
+}  // namespace
+
+MemoryPatternSlabPool::MemoryPatternSlabPool(AllocatorPtr allocator, size_t max_idle_slabs)
+    : IAllocator(PoolMemoryInfo(allocator->Info())),
+      allocator_(std::move(allocator)),
+      max_idle_slabs_(max_idle_slabs) {
+}
+
+MemoryPatternSlabPool::~MemoryPatternSlabPool() {
+  // the buffers handed out hold a reference to the pool, so all slabs are idle by now
+  for (auto& slab : idle_slabs_) {
+    allocator_->Free(slab.second);
+  }
+}
+
+void* MemoryPatternSlabPool::Alloc(size_t size) {
+  if (size == 0) {
+    return nullptr;
+  }
+
+  {
+    std::lock_guard<OrtMutex> lock(lock_);
+    // smallest idle slab that is large enough
+    auto it = idle_slabs_.lower_bound(size);
+    if (it != idle_slabs_.end()) {
+      const size_t slab_size = it->first;
+      void* slab = it->second;
+      idle_slabs_.erase(it);
+      used_slabs_.emplace(slab, slab_size);
+      stats_.bytes_in_use += slab_size;
+      stats_.max_bytes_in_use = std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
+      return slab;
+    }
+  }
+
+  // allocate outside of the lock, the underlying allocator has its own synchronization
+  void* slab = allocator_->Alloc(size);
+  if (slab != nullptr) {
+    std::lock_guard<OrtMutex> lock(lock_);
+    used_slabs_.emplace(slab, size);
+    ++stats_.num_allocs;
+    stats_.bytes_in_use += size;
+    stats_.total_allocated_bytes += size;
+    stats_.max_bytes_in_use = std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
+    stats_.max_alloc_size = std::max(stats_.max_alloc_size, static_cast<int64_t>(size));
+  }
+  return slab;
+}
+
+void MemoryPatternSlabPool::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  void* to_free = nullptr;
+  {
+    std::lock_guard<OrtMutex> lock(lock_);
+    auto it = used_slabs_.find(p);
+    ORT_ENFORCE(it != used_slabs_.end(), "Freeing a buffer that was not allocated from the slab pool");
+    const size_t slab_size = it->second;
+    used_slabs_.erase(it);
+    stats_.bytes_in_use -= slab_size;
+
+    idle_slabs_.emplace(slab_size, p);
+    if (idle_slabs_.size() > max_idle_slabs_) {
+      // the smallest slab is the least likely to fit the next request
+      auto smallest = idle_slabs_.begin();
+      to_free = smallest->second;
+      stats_.total_allocated_bytes -= smallest->first;
+      idle_slabs_.erase(smallest);
+    }
+  }
+
+  if (to_free != nullptr) {
+    allocator_->Free(to_free);
+  }
+}
+
+void MemoryPatternSlabPool::GetStats(AllocatorStats* stats) {
+  std::lock_guard<OrtMutex> lock(lock_);
+  *stats = stats_;
+}
+
+size_t MemoryPatternSlabPool::NumIdleSlabs() const {
+  std::lock_guard<OrtMutex> lock(lock_);
+  return idle_slabs_.size();
+}
+
+}  // namespace onnxruntime
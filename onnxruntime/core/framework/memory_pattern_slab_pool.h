@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <map>
+
+#include "core/common/inlined_containers.h"
+#include "core/framework/allocator.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+Keeps the memory pattern buffers (slabs) of finished runs to hand them to the next runs, instead of returning them
+to the underlying allocator. With many concurrent Run calls, each run takes one slab sized to its planned peak and
+the intermediates of all runs no longer interleave in the arena, so the memory use stays close to
+the number of concurrent runs times the planned peak.
+
+A slab is reused for any request it is large enough for. At most max_idle_slabs slabs are kept idle, the smallest
+ones are returned to the underlying allocator first.
+*/
+class MemoryPatternSlabPool final : public IAllocator {
+ public:
+  MemoryPatternSlabPool(AllocatorPtr allocator, size_t max_idle_slabs);
+  ~MemoryPatternSlabPool() override;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MemoryPatternSlabPool);
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+  void GetStats(AllocatorStats* stats) override;
+
+  size_t NumIdleSlabs() const;
+
+ private:
+  const AllocatorPtr allocator_;
+  const size_t max_idle_slabs_;
+
+  mutable OrtMutex lock_;
+  // idle slabs by size
+  std::multimap<size_t, void*> idle_slabs_;
+  // sizes of the slabs handed out
+  InlinedHashMap<void*, size_t> used_slabs_;
+  AllocatorStats stats_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/numa_replicated_buffer.h"
+
+#include <cstring>
+
+#include "core/common/logging/logging.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+NumaReplicatedBuffer::~NumaReplicatedBuffer() {
+  Release();
+}
+
+void NumaReplicatedBuffer::Replicate(const void* data, size_t size, const concurrency::ThreadPool* thread_pool) {
+  Release();
+
+  const std::vector<int> numa_nodes = concurrency::ThreadPool::GetNumaNodes(thread_pool);
+  if (numa_nodes.size() < 2 || data == nullptr || size == 0) {
+    return;
+  }
+
+  const Env& env = Env::Default();
+  size_ = size;
+  replicas_.reserve(numa_nodes.size());
+  for (int numa_node : numa_nodes) {
+    void* replica = env.AllocateOnNumaNode(size, numa_node);
+    if (replica == nullptr) {
+      LOGS_DEFAULT(WARNING) << "Failed to allocate " << size << " bytes on NUMA node " << numa_node
+                            << ". The buffer isn't replicated.";
+      Release();
+      return;
+    }
+    // the pages are placed on the node by the allocation, whichever thread touches them first
+    std::memcpy(replica, data, size);
+    replicas_.push_back(replica);
+  }
+}
+
+void NumaReplicatedBuffer::Release() {
+  const Env& env = Env::Default();
+  for (const void* replica : replicas_) {
+    env.FreeNumaNodeMemory(const_cast<void*>(replica), size_);
+  }
+  replicas_.clear();
+  size_ = 0;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+// Copies of a read-only buffer, e.g. a prepacked weight, one in the memory of each NUMA node the threads of an
+// intra-op thread pool span. The threads streaming the buffer read the copy local to their node instead of pulling
+// it across the interconnect, which matters for memory bandwidth bound GEMMs like the ones of LLM decoding.
+class NumaReplicatedBuffer {
+ public:
+  NumaReplicatedBuffer() = default;
+  ~NumaReplicatedBuffer();
+
+  // Copies `data` to each node of `thread_pool`. Nothing is copied if the pool doesn't span several NUMA nodes
+  // (see ThreadPool::GetNumaNodes) or the memory of a node can't be allocated, and Replicas() stays nullptr.
+  void Replicate(const void* data, size_t size, const concurrency::ThreadPool* thread_pool);
+
+  // Returns the copies indexed like ThreadPool::GetNumaNodes, nullptr if there are none.
+  const void* const* Replicas() const { return replicas_.empty() ? nullptr : replicas_.data(); }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(NumaReplicatedBuffer);
+
+ private:
+  void Release();
+
+  std::vector<const void*> replicas_;
+  size_t size_ = 0;
+};
+
+}  // namespace onnxruntime
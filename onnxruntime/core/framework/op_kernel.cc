@@ -54,6 +54,18 @@ Tensor* OpKernelContext::Output(int index, const std::initializer_list<int64_t>&
   return Output(index, TensorShape(shape));
 }
 
+Tensor* OpKernelContext::OutputView(int index, const TensorShape& shape, const Tensor& input, size_t byte_offset) {
+  // contexts without an execution frame (e.g. for standalone kernels) have no allocation plan
+  if (execution_frame_ == nullptr || index < 0 || index >= OutputCount())
+    return nullptr;
+
+  OrtValue* p_ml_value = nullptr;
+  Status status = execution_frame_->CreateNodeOutputView(GetOutputArgIndex(index), shape, input, byte_offset,
+                                                         p_ml_value);
+  ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
+  return p_ml_value ? p_ml_value->GetMutable<Tensor>() : nullptr;
+}
+
 #if !defined(DISABLE_SPARSE_TENSORS)
 SparseTensor* OpKernelContext::OutputSparse(int index, const TensorShape& shape) {
   auto p_ml_value = OutputMLValue(index, shape);
@@ -5,6 +5,7 @@
 
 #include <functional>
 #include "core/framework/op_kernel.h"
+#include "core/framework/run_options.h"
 #include "core/framework/session_state.h"
 #include "core/session/onnxruntime_c_api.h"
 
@@ -71,9 +72,13 @@ class OpKernelContextInternal : public OpKernelContext {
 
   const bool& GetTerminateFlag() const noexcept { return terminate_flag_; }
 
+  // Options of the Run executing the kernel, nullptr if unknown.
+  const RunOptions* GetRunOptions() const noexcept { return run_options_; }
+
  private:
   const SessionState& session_state_;
   const bool& terminate_flag_;
+  const RunOptions* run_options_{RunOptionsScope::Current()};
   std::vector<const OrtValue*> implicit_input_values_;
 };
 
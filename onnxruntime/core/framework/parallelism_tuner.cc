@@ -0,0 +1,124 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/parallelism_tuner.h"
+
+#include <algorithm>
+
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/graph/constants.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+ParallelismTuner::ParallelismTuner(const GraphViewer& graph_viewer, int max_degree_of_parallelism,
+                                   uint32_t samples_per_candidate)
+    : samples_per_candidate_(samples_per_candidate),
+      nodes_(static_cast<size_t>(graph_viewer.MaxNodeIndex())) {
+  ORT_ENFORCE(max_degree_of_parallelism > 1, "The maximum degree of parallelism must be greater than 1.");
+  ORT_ENFORCE(samples_per_candidate > 0, "The number of samples per candidate must be positive.");
+
+  for (int degree_of_parallelism = 1; degree_of_parallelism < max_degree_of_parallelism; degree_of_parallelism *= 2) {
+    candidates_.push_back(degree_of_parallelism);
+  }
+  candidates_.push_back(max_degree_of_parallelism);
+
+  // only the kernels of the CPU EP run their parallel loops in the intra-op thread pool
+  for (const auto& node : graph_viewer.Nodes()) {
+    nodes_[node.Index()].is_tuned = node.GetExecutionProviderType() == kCpuExecutionProvider;
+  }
+}
+
+ParallelismTuner::Trial ParallelismTuner::Select(NodeIndex node_index, uint64_t shape_hash) {
+  auto& node = nodes_[node_index];
+  std::lock_guard<std::mutex> lock(node.mutex);
+  auto it = node.tunings.find(shape_hash);
+  if (it == node.tunings.end()) {
+    if (node.tunings.size() >= kMaxShapesPerNode) {
+      return Trial{};
+    }
+
+    it = node.tunings.emplace(shape_hash, Tuning{}).first;
+  }
+
+  const auto& tuning = it->second;
+  if (tuning.degree_of_parallelism != 0) {
+    return Trial{tuning.degree_of_parallelism, false};
+  }
+
+  return Trial{candidates_[tuning.candidate], true};
+}
+
+void ParallelismTuner::Record(NodeIndex node_index, uint64_t shape_hash, int degree_of_parallelism,
+                              Duration duration) {
+  auto& node = nodes_[node_index];
+  std::lock_guard<std::mutex> lock(node.mutex);
+  auto it = node.tunings.find(shape_hash);
+  if (it == node.tunings.end()) {
+    return;
+  }
+
+  // concurrent Runs may have moved on to the next candidate
+  auto& tuning = it->second;
+  if (tuning.degree_of_parallelism != 0 || candidates_[tuning.candidate] != degree_of_parallelism) {
+    return;
+  }
+
+  if (tuning.samples == 0) {
+    tuning.fastest.push_back(duration);
+  } else {
+    tuning.fastest.back() = std::min(tuning.fastest.back(), duration);
+  }
+
+  if (++tuning.samples == samples_per_candidate_) {
+    tuning.samples = 0;
+    if (++tuning.candidate == candidates_.size()) {
+      SelectDegreeOfParallelism(tuning);
+    }
+  }
+}
+
+void ParallelismTuner::SelectDegreeOfParallelism(Tuning& tuning) const {
+  const Duration fastest = *std::min_element(tuning.fastest.begin(), tuning.fastest.end());
+  for (size_t i = 0; i < candidates_.size(); ++i) {
+    if (static_cast<double>(tuning.fastest[i].count()) <= static_cast<double>(fastest.count()) * (1.0 + kTolerance)) {
+      tuning.degree_of_parallelism = candidates_[i];
+      break;
+    }
+  }
+
+  tuning.fastest.clear();
+}
+
+int ParallelismTuner::GetDegreeOfParallelism(NodeIndex node_index, uint64_t shape_hash) const {
+  const auto& node = nodes_[node_index];
+  std::lock_guard<std::mutex> lock(node.mutex);
+  const auto it = node.tunings.find(shape_hash);
+  return it != node.tunings.end() ? it->second.degree_of_parallelism : 0;
+}
+
+uint64_t ParallelismTuner::HashInputShapes(const OpKernelContextInternal& kernel_context) {
+  // FNV-1a over the ranks and dimensions of the inputs
+  constexpr uint64_t kPrime = 1099511628211ULL;
+  uint64_t hash = 14695981039346656037ULL;
+  const auto combine = [&hash](uint64_t value) { hash = (hash ^ value) * kPrime; };
+
+  const int input_count = kernel_context.InputCount();
+  for (int i = 0; i < input_count; ++i) {
+    const auto* input = kernel_context.GetInputMLValue(i);
+    if (input == nullptr || !input->IsTensor()) {
+      combine(~0ULL);
+      continue;
+    }
+
+    const auto dims = input->Get<Tensor>().Shape().GetDims();
+    combine(dims.size());
+    for (const auto dim : dims) {
+      combine(static_cast<uint64_t>(dim));
+    }
+  }
+
+  return hash;
+}
+
+}  // namespace onnxruntime
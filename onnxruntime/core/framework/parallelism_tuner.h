@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/graph/basic_types.h"
+
+namespace onnxruntime {
+
+class GraphViewer;
+class OpKernelContextInternal;
+
+/**
+ * Learns the degree of intra-op parallelism of the CPU nodes of the main graph, see
+ * kOrtSessionOptionsConfigIntraOpAdaptiveParallelismSamples.
+ *
+ * The first executions of a node with inputs of a given shape are timed with the parallel loops of the node capped to
+ * 1, 2, 4, ... threads, up to all the threads of the pool, `samples_per_candidate` times each. The node then runs
+ * with the fewest threads whose fastest execution is within kTolerance of the fastest of all, so the loops that scale
+ * poorly leave the other threads of the pool to concurrent Runs.
+ */
+class ParallelismTuner {
+ public:
+  using Duration = std::chrono::nanoseconds;
+
+  // The slowdown accepted to run a node on fewer threads.
+  static constexpr double kTolerance = 0.1;
+
+  // The shapes tuned per node. The executions with inputs of other shapes are not capped.
+  static constexpr size_t kMaxShapesPerNode = 16;
+
+  ParallelismTuner(const GraphViewer& graph_viewer, int max_degree_of_parallelism, uint32_t samples_per_candidate);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ParallelismTuner);
+
+  struct Trial {
+    // the cap of the degree of parallelism of the execution, 0 for none
+    int degree_of_parallelism{0};
+    // whether the execution is timed and passed to Record
+    bool measure{false};
+  };
+
+  // Whether the parallelism of the node is tuned.
+  bool IsTuned(NodeIndex node_index) const noexcept {
+    return node_index < nodes_.size() && nodes_[node_index].is_tuned;
+  }
+
+  // Returns how to execute the node with inputs of the shapes hashed to `shape_hash`.
+  Trial Select(NodeIndex node_index, uint64_t shape_hash);
+
+  // Records the duration of an execution of the node selected with Select.
+  void Record(NodeIndex node_index, uint64_t shape_hash, int degree_of_parallelism, Duration duration);
+
+  // Returns the degree of parallelism learnt for the node and shape, 0 if it is still being tuned.
+  int GetDegreeOfParallelism(NodeIndex node_index, uint64_t shape_hash) const;
+
+  // Hashes the shapes of the inputs of a kernel.
+  static uint64_t HashInputShapes(const OpKernelContextInternal& kernel_context);
+
+ private:
+  struct Tuning {
+    // index in candidates_ of the degree of parallelism being measured
+    size_t candidate{0};
+    uint32_t samples{0};
+    // the fastest execution with each candidate measured
+    InlinedVector<Duration> fastest;
+    // the selected degree of parallelism once tuned, 0 before
+    int degree_of_parallelism{0};
+  };
+
+  struct Node {
+    bool is_tuned{false};
+    mutable std::mutex mutex;
+    InlinedHashMap<uint64_t, Tuning> tunings;
+  };
+
+  void SelectDegreeOfParallelism(Tuning& tuning) const;
+
+  const uint32_t samples_per_candidate_;
+  // 1, 2, 4, ... and the maximum degree of parallelism
+  InlinedVector<int> candidates_;
+  // indexed by NodeIndex
+  std::vector<Node> nodes_;
+};
+
+}  // namespace onnxruntime
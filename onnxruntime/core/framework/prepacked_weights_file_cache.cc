@@ -0,0 +1,299 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights_file_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include "core/common/cpuid_info.h"
+#include "core/common/safeint.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensor.h"
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// File layout (all integers are little endian host order, the fingerprint pins the file to the producing machine):
+//   header  : magic[8] | uint32 version | uint32 num_entries | uint64 cpu_fingerprint
+//   index   : num_entries x { uint32 key_length | key bytes | uint32 num_buffers | num_buffers x { uint64 offset | uint64 size } }
+//   payload : buffers, each starting at a kBufferAlignment aligned offset from the start of the file
+constexpr char kMagic[8] = {'O', 'R', 'T', 'P', 'P', 'W', 'C', '\0'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kBufferAlignment = 64;
+
+constexpr size_t kHeaderSize = sizeof(kMagic) + sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint64_t);
+
+size_t AlignUp(size_t value) {
+  return (value + kBufferAlignment - 1) / kBufferAlignment * kBufferAlignment;
+}
+
+class Reader {
+ public:
+  Reader(const char* data, size_t length) : data_(data), length_(length) {}
+
+  template <typename T>
+  bool Read(T& value) {
+    if (length_ - pos_ < sizeof(T)) return false;
+    std::memcpy(&value, data_ + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return true;
+  }
+
+  bool Read(std::string& value, size_t size) {
+    if (length_ - pos_ < size) return false;
+    value.assign(data_ + pos_, size);
+    pos_ += size;
+    return true;
+  }
+
+ private:
+  const char* data_;
+  size_t length_;
+  size_t pos_ = 0;
+};
+
+template <typename T>
+void Write(std::ostream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void HashBytes(const void* data, size_t length, uint32_t (&hash)[4]) {
+  // MurmurHash3 takes an int length so large initializers are hashed in chunks
+  constexpr size_t kChunkSize = size_t{1} << 30;
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  do {
+    const size_t chunk = std::min(length, kChunkSize);
+    MurmurHash3::x86_128(bytes, static_cast<int>(chunk), hash[0], &hash);
+    bytes += chunk;
+    length -= chunk;
+  } while (length > 0);
+}
+
+void NonOwningDeleter(void*) {}
+
+}  // namespace
+
+uint64_t PrepackedWeightsFileCache::GetCpuFingerprint() {
+  const auto& cpu_info = CPUIDInfo::GetCPUIDInfo();
+  const bool features[] = {
+      cpu_info.HasSSE3(),
+      cpu_info.HasSSE4_1(),
+      cpu_info.HasAVX(),
+      cpu_info.HasAVX2(),
+      cpu_info.HasAVX512f(),
+      cpu_info.HasAVX512Skylake(),
+      cpu_info.HasAVX512_BF16(),
+      cpu_info.HasAMX_BF16(),
+      cpu_info.HasF16C(),
+      cpu_info.HasArmNeonDot(),
+      cpu_info.HasArmNeon_I8MM(),
+      cpu_info.HasArmSVE_I8MM(),
+      cpu_info.HasArmNeon_BF16(),
+  };
+
+  uint64_t fingerprint = 0;
+  for (size_t i = 0; i < std::size(features); ++i) {
+    fingerprint |= static_cast<uint64_t>(features[i]) << i;
+  }
+
+  // keep the pointer width in the fingerprint so 32 and 64 bit builds never share a file
+  fingerprint |= static_cast<uint64_t>(sizeof(void*)) << 56;
+  return fingerprint;
+}
+
+std::string PrepackedWeightsFileCache::GenerateKey(const Node& node, int input_idx, const Tensor& tensor) {
+  uint32_t hash[4] = {0, 0, 0, 0};
+
+  // attributes drive the layout of the pre-packed weights (e.g.) transB for MatMul or accuracy_level for MatMulNBits
+  // so they are part of the key. NodeAttributes is an unordered map, so hash the attributes in name order.
+  const auto& attributes = node.GetAttributes();
+  std::vector<std::string> attribute_names;
+  attribute_names.reserve(attributes.size());
+  for (const auto& attribute : attributes) {
+    attribute_names.push_back(attribute.first);
+  }
+  std::sort(attribute_names.begin(), attribute_names.end());
+  for (const auto& name : attribute_names) {
+    const std::string serialized = attributes.at(name).SerializeAsString();
+    HashBytes(serialized.data(), serialized.size(), hash);
+  }
+
+  const auto dims = tensor.Shape().GetDims();
+  if (!dims.empty()) {
+    HashBytes(dims.data(), dims.size_bytes(), hash);
+  }
+  if (tensor.SizeInBytes() > 0) {
+    HashBytes(tensor.DataRaw(), tensor.SizeInBytes(), hash);
+  }
+
+  std::ostringstream ss;
+  ss << node.Domain() << "+" << node.OpType() << "+" << node.SinceVersion() << "+" << input_idx << "+"
+     << DataTypeImpl::ToString(tensor.DataType()) << "+" << hash[0] << "." << hash[1] << "." << hash[2] << "."
+     << hash[3];
+  return ss.str();
+}
+
+Status PrepackedWeightsFileCache::Load() {
+  weights_.clear();
+  has_added_weights_ = false;
+  mapped_file_ = Env::MappedMemoryPtr{};
+
+  std::error_code ec;
+  if (!std::filesystem::exists(file_path_, ec)) {
+    return Status::OK();
+  }
+
+  const Env& env = Env::Default();
+  size_t file_length = 0;
+  ORT_RETURN_IF_ERROR(env.GetFileLength(file_path_.c_str(), file_length));
+  if (file_length == 0) {
+    return Status::OK();
+  }
+
+  Env::MappedMemoryPtr mapped_file;
+  ORT_RETURN_IF_ERROR(env.MapFileIntoMemory(file_path_.c_str(), 0, file_length, mapped_file));
+
+  Status status = ParseMappedFile(mapped_file.get(), file_length);
+  if (!status.IsOK()) {
+    weights_.clear();
+    return status;
+  }
+
+  mapped_file_ = std::move(mapped_file);
+  return Status::OK();
+}
+
+Status PrepackedWeightsFileCache::ParseMappedFile(const char* data, size_t length) {
+  Reader reader(data, length);
+
+  std::string magic;
+  uint32_t version = 0;
+  uint32_t num_entries = 0;
+  uint64_t fingerprint = 0;
+  ORT_RETURN_IF_NOT(reader.Read(magic, sizeof(kMagic)) && std::memcmp(magic.data(), kMagic, sizeof(kMagic)) == 0,
+                    "Pre-packed weights file ", PathToUTF8String(file_path_), " has an invalid header.");
+  ORT_RETURN_IF_NOT(reader.Read(version) && reader.Read(num_entries) && reader.Read(fingerprint),
+                    "Pre-packed weights file ", PathToUTF8String(file_path_), " is truncated.");
+
+  // Not an error. The file was produced by another version of the format or on a machine with different
+  // CPU features, so the weights are re-packed and the file is rewritten on Save().
+  if (version != kVersion || fingerprint != GetCpuFingerprint()) {
+    return Status::OK();
+  }
+
+  for (uint32_t entry = 0; entry < num_entries; ++entry) {
+    uint32_t key_length = 0;
+    std::string key;
+    uint32_t num_buffers = 0;
+    ORT_RETURN_IF_NOT(reader.Read(key_length) && reader.Read(key, key_length) && reader.Read(num_buffers),
+                      "Pre-packed weights file ", PathToUTF8String(file_path_), " has a truncated index.");
+
+    PrePackedWeights weights;
+    for (uint32_t i = 0; i < num_buffers; ++i) {
+      uint64_t offset = 0;
+      uint64_t size = 0;
+      ORT_RETURN_IF_NOT(reader.Read(offset) && reader.Read(size),
+                        "Pre-packed weights file ", PathToUTF8String(file_path_), " has a truncated index.");
+      ORT_RETURN_IF_NOT(offset <= length && size <= length - offset,
+                        "Pre-packed weights file ", PathToUTF8String(file_path_), " has an out of bounds buffer.");
+
+      void* buffer = size > 0 ? const_cast<char*>(data) + offset : nullptr;
+      weights.buffers_.emplace_back(buffer, NonOwningDeleter);
+      weights.buffer_sizes_.push_back(static_cast<size_t>(size));
+    }
+
+    weights_.emplace(std::move(key), std::move(weights));
+  }
+
+  return Status::OK();
+}
+
+const PrePackedWeights* PrepackedWeightsFileCache::GetWeight(const std::string& key) const {
+  auto iter = weights_.find(key);
+  return iter != weights_.end() ? &iter->second : nullptr;
+}
+
+bool PrepackedWeightsFileCache::AddWeight(const std::string& key, PrePackedWeights&& prepacked_weights) {
+  ORT_ENFORCE(prepacked_weights.buffers_.size() == prepacked_weights.buffer_sizes_.size());
+
+  // some pre-packed buffers may be null if they were just "place-holders" occupying an index
+  // in the "buffers_" vector, so there is nothing to persist for them
+  for (size_t i = 0; i < prepacked_weights.buffers_.size(); ++i) {
+    if (prepacked_weights.buffers_[i] == nullptr) {
+      prepacked_weights.buffer_sizes_[i] = 0;
+    }
+  }
+
+  bool inserted = weights_.emplace(key, std::move(prepacked_weights)).second;
+  has_added_weights_ = has_added_weights_ || inserted;
+  return inserted;
+}
+
+Status PrepackedWeightsFileCache::Save() const {
+  if (!has_added_weights_) {
+    return Status::OK();
+  }
+
+  // lay out the index first so the buffer offsets are known before anything is written
+  SafeInt<size_t> index_end = kHeaderSize;
+  for (const auto& entry : weights_) {
+    index_end += sizeof(uint32_t) + entry.first.size() + sizeof(uint32_t) +
+                 entry.second.buffers_.size() * 2 * sizeof(uint64_t);
+  }
+
+  const PathString temp_file_path = file_path_ + ORT_TSTR(".tmp");
+  {
+    std::ofstream out(temp_file_path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    ORT_RETURN_IF_NOT(out.good(), "Failed to open ", PathToUTF8String(temp_file_path), " for writing.");
+
+    out.write(kMagic, sizeof(kMagic));
+    Write(out, kVersion);
+    Write(out, static_cast<uint32_t>(weights_.size()));
+    Write(out, GetCpuFingerprint());
+
+    size_t offset = AlignUp(index_end);
+    for (const auto& entry : weights_) {
+      Write(out, static_cast<uint32_t>(entry.first.size()));
+      out.write(entry.first.data(), entry.first.size());
+      Write(out, static_cast<uint32_t>(entry.second.buffers_.size()));
+      for (size_t size : entry.second.buffer_sizes_) {
+        Write(out, static_cast<uint64_t>(offset));
+        Write(out, static_cast<uint64_t>(size));
+        offset = AlignUp(offset + size);
+      }
+    }
+
+    // the iteration order of weights_ is stable as it isn't modified in between the two passes
+    const std::vector<char> padding(kBufferAlignment, 0);
+    size_t written = index_end;
+    for (const auto& entry : weights_) {
+      for (size_t i = 0; i < entry.second.buffers_.size(); ++i) {
+        const size_t aligned = AlignUp(written);
+        out.write(padding.data(), aligned - written);
+        const size_t size = entry.second.buffer_sizes_[i];
+        if (size > 0) {
+          out.write(static_cast<const char*>(entry.second.buffers_[i].get()), size);
+        }
+        written = aligned + size;
+      }
+    }
+
+    ORT_RETURN_IF_NOT(out.good(), "Failed to write ", PathToUTF8String(temp_file_path), ".");
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(temp_file_path, file_path_, ec);
+  ORT_RETURN_IF(ec, "Failed to rename ", PathToUTF8String(temp_file_path), " to ", PathToUTF8String(file_path_),
+                ": ", ec.message());
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/common/path_string.h"
+#include "core/framework/prepacked_weights.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+class Node;
+class Tensor;
+
+// A file backed store of pre-packed weights that persists the output of kernels' PrePack() calls
+// across sessions and processes.
+//
+// The file is written once (when a session produced pre-packed weights it didn't find in the file)
+// and memory mapped on subsequent loads, so the pages holding the pre-packed weights are shared
+// between all the processes that load the same file instead of every process packing its own copy.
+//
+// Entries are keyed on the node that consumes the weight (domain, op type, since version and attributes),
+// the input index and a hash of the source initializer. The file records a fingerprint of the CPU features
+// that drive the MLAS dispatch, and a file written on a machine with a different fingerprint is ignored.
+//
+// Only kernels that report CanRestorePrePackedWeightsFromBuffers() for an input are served from the file as
+// the buffers handed to them are read-only views into the mapping and PrePack() is not invoked.
+class PrepackedWeightsFileCache final {
+ public:
+  explicit PrepackedWeightsFileCache(PathString file_path) : file_path_(std::move(file_path)) {}
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrepackedWeightsFileCache);
+
+  // Maps the cache file into memory and indexes its entries.
+  // A missing file or a file written for a different CPU fingerprint leaves the cache empty and returns OK.
+  // A malformed file returns an error status and leaves the cache empty.
+  Status Load();
+
+  // Returns the pre-packed weights pertaining to the provided key or nullptr if the file doesn't have them.
+  // The buffers of the returned instance are owned by the cache and must be treated as read-only.
+  const PrePackedWeights* GetWeight(const std::string& key) const;
+
+  // Takes ownership of a pre-packed weight produced by PrePack() so that it is part of the file on the next Save().
+  // Kernels consume it through GetWeight() just like the entries loaded from the file.
+  // Returns a boolean indicating if the insertion took place.
+  bool AddWeight(const std::string& key, PrePackedWeights&& prepacked_weights);
+
+  // Rewrites the file with all the loaded and newly added entries if any entry was added since Load().
+  // The file is written to a temporary path and renamed so that concurrent readers never see a partial file.
+  Status Save() const;
+
+  // Returns the number of entries available for lookup.
+  size_t GetNumberOfElements() const { return weights_.size(); }
+
+  const PathString& GetFilePath() const { return file_path_; }
+
+  // Generates the lookup key for the pre-packed weights of the source initializer `tensor`
+  // consumed by `node` at input index `input_idx`.
+  static std::string GenerateKey(const Node& node, int input_idx, const Tensor& tensor);
+
+  // Returns a fingerprint of the CPU features relevant to the layout of pre-packed weights.
+  static uint64_t GetCpuFingerprint();
+
+ private:
+  Status ParseMappedFile(const char* data, size_t length);
+
+  const PathString file_path_;
+
+  // Keeps the file mapped (and the pre-packed buffers pointing into it valid) for the lifetime of the cache.
+  Env::MappedMemoryPtr mapped_file_;
+
+  // Entries loaded from the file point into mapped_file_, entries added after Load() own their buffers.
+  std::unordered_map<std::string, PrePackedWeights> weights_;
+
+  // Set if an entry was added since Load() and the file needs to be rewritten.
+  bool has_added_weights_ = false;
+};
+
+}  // namespace onnxruntime
@@ -8,6 +8,25 @@
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(disable : 26409)
 #endif
+
+namespace onnxruntime {
+namespace {
+thread_local const RunOptions* current_run_options = nullptr;
+}  // namespace
+
+RunOptionsScope::RunOptionsScope(const RunOptions* run_options) : previous_run_options_(current_run_options) {
+  current_run_options = run_options;
+}
+
+RunOptionsScope::~RunOptionsScope() {
+  current_run_options = previous_run_options_;
+}
+
+const RunOptions* RunOptionsScope::Current() {
+  return current_run_options;
+}
+}  // namespace onnxruntime
+
 ORT_API_STATUS_IMPL(OrtApis::CreateRunOptions, _Outptr_ OrtRunOptions** out) {
   API_IMPL_BEGIN
   *out = new OrtRunOptions();
@@ -56,6 +75,13 @@ ORT_API_STATUS_IMPL(OrtApis::RunOptionsUnsetTerminate, _Inout_ OrtRunOptions* op
   return nullptr;
 }
 
+ORT_API_STATUS_IMPL(OrtApis::RunOptionsSetGenerationStepCallback, _Inout_ OrtRunOptions* options,
+                    _In_opt_ OrtGenerationStepCallbackFn callback, _In_opt_ void* user_data) {
+  options->generation_step_callback = callback;
+  options->generation_step_callback_user_data = user_data;
+  return nullptr;
+}
+
 ORT_API_STATUS_IMPL(OrtApis::AddRunConfigEntry, _Inout_ OrtRunOptions* options,
                     _In_z_ const char* config_key, _In_z_ const char* config_value) {
   return onnxruntime::ToOrtStatus(options->config_options.AddConfigEntry(config_key, config_value));
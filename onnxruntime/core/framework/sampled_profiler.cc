@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/sampled_profiler.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+namespace profiling {
+
+namespace {
+
+// escapes a Prometheus label value
+std::string EscapeLabelValue(const std::string& value) {
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (const char c : value) {
+    if (c == '\\' || c == '"') {
+      escaped += '\\';
+      escaped += c;
+    } else if (c == '\n') {
+      escaped += "\\n";
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+}  // namespace
+
+SampledProfiler::SampledProfiler(const GraphViewer& graph_viewer, uint32_t sample_rate)
+    : sample_rate_(sample_rate),
+      node_histograms_(static_cast<size_t>(graph_viewer.MaxNodeIndex())),
+      node_labels_(static_cast<size_t>(graph_viewer.MaxNodeIndex())) {
+  ORT_ENFORCE(sample_rate > 0, "The sample rate must be positive.");
+
+  for (const auto& node : graph_viewer.Nodes()) {
+    const auto& name = node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
+    node_labels_[node.Index()] = MakeString("node=\"", EscapeLabelValue(name), "\",op_type=\"",
+                                            EscapeLabelValue(node.OpType()), "\",provider=\"",
+                                            EscapeLabelValue(node.GetExecutionProviderType()), "\"");
+  }
+}
+
+void SampledProfiler::Histogram::Record(Duration latency) noexcept {
+  const auto latency_ns = static_cast<uint64_t>(std::max<Duration::rep>(latency.count(), 0));
+  const auto bucket = std::lower_bound(kBucketBoundsUs.begin(), kBucketBoundsUs.end(), (latency_ns + 999) / 1000) -
+                      kBucketBoundsUs.begin();
+  buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  sum_ns.fetch_add(latency_ns, std::memory_order_relaxed);
+}
+
+void SampledProfiler::AppendHistogram(std::string& text, const std::string& name, const std::string& labels,
+                                      const Histogram& histogram) {
+  const std::string separator = labels.empty() ? "" : ",";
+  std::ostringstream ss;
+  ss.precision(15);
+
+  // the +Inf bucket and the count are the sum of the buckets read, so they are consistent with the buckets
+  // while other Runs record latencies.
+  uint64_t cumulative_count = 0;
+  for (size_t i = 0; i < histogram.buckets.size(); ++i) {
+    cumulative_count += histogram.buckets[i].load(std::memory_order_relaxed);
+    ss << name << "_bucket{" << labels << separator << "le=\"";
+    if (i < kBucketBoundsUs.size()) {
+      ss << static_cast<double>(kBucketBoundsUs[i]) / 1e6;
+    } else {
+      ss << "+Inf";
+    }
+    ss << "\"} " << cumulative_count << "\n";
+  }
+
+  const char* open = labels.empty() ? "" : "{";
+  const char* close = labels.empty() ? "" : "}";
+  ss << name << "_sum" << open << labels << close << " "
+     << static_cast<double>(histogram.sum_ns.load(std::memory_order_relaxed)) / 1e9 << "\n";
+  ss << name << "_count" << open << labels << close << " " << cumulative_count << "\n";
+  text += ss.str();
+}
+
+std::string SampledProfiler::ToPrometheusText() const {
+  std::string text;
+
+  text += "# HELP onnxruntime_run_latency_seconds Latency of the sampled Runs.\n";
+  text += "# TYPE onnxruntime_run_latency_seconds histogram\n";
+  AppendHistogram(text, "onnxruntime_run_latency_seconds", "", run_histogram_);
+
+  text += "# HELP onnxruntime_node_latency_seconds Kernel latency of the nodes in the sampled Runs.\n";
+  text += "# TYPE onnxruntime_node_latency_seconds histogram\n";
+  for (size_t node_index = 0; node_index < node_histograms_.size(); ++node_index) {
+    if (!node_labels_[node_index].empty()) {
+      AppendHistogram(text, "onnxruntime_node_latency_seconds", node_labels_[node_index],
+                      node_histograms_[node_index]);
+    }
+  }
+
+  text += "# HELP onnxruntime_sampled_profiler_runs_total Runs seen by the sampling profiler.\n";
+  text += "# TYPE onnxruntime_sampled_profiler_runs_total counter\n";
+  text += MakeString("onnxruntime_sampled_profiler_runs_total ", run_counter_.load(std::memory_order_relaxed), "\n");
+
+  text += "# HELP onnxruntime_expired_runs_total Runs that failed after their deadline passed.\n";
+  text += "# TYPE onnxruntime_expired_runs_total counter\n";
+  text += MakeString("onnxruntime_expired_runs_total ", expired_runs_.load(std::memory_order_relaxed), "\n");
+
+  return text;
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -0,0 +1,87 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/graph/basic_types.h"
+
+namespace onnxruntime {
+
+class GraphViewer;
+
+namespace profiling {
+
+/**
+ * Always-on sampling profiler, see kOrtSessionOptionsConfigSampledProfilingRate.
+ *
+ * One in `sample_rate` Runs is sampled. The latencies of the nodes and of the sampled Runs are added to fixed bucket
+ * histograms of atomic counters, so concurrent Runs record them without locking. The histograms are never reset and
+ * are exported in the Prometheus text format.
+ */
+class SampledProfiler {
+ public:
+  using Duration = std::chrono::nanoseconds;
+
+  SampledProfiler(const GraphViewer& graph_viewer, uint32_t sample_rate);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SampledProfiler);
+
+  // Returns whether the Run starting now is sampled.
+  bool SampleRun() noexcept {
+    return run_counter_.fetch_add(1, std::memory_order_relaxed) % sample_rate_ == 0;
+  }
+
+  void RecordNode(NodeIndex node_index, Duration latency) noexcept {
+    if (node_index < node_histograms_.size()) {
+      node_histograms_[node_index].Record(latency);
+    }
+  }
+
+  void RecordRun(Duration latency) noexcept { run_histogram_.Record(latency); }
+
+  // Counts a Run that failed after its deadline passed, sampled or not.
+  void RecordExpiredRun() noexcept { expired_runs_.fetch_add(1, std::memory_order_relaxed); }
+
+  uint32_t SampleRate() const noexcept { return sample_rate_; }
+
+  // The histograms of the main graph nodes and of the Runs in the Prometheus text exposition format.
+  std::string ToPrometheusText() const;
+
+ private:
+  // upper bounds of the buckets in microseconds, the last bucket (+Inf) has no bound
+  static constexpr std::array<uint64_t, 20> kBucketBoundsUs{1, 2, 5, 10, 20, 50, 100, 200, 500,
+                                                            1'000, 2'000, 5'000, 10'000, 20'000, 50'000,
+                                                            100'000, 200'000, 500'000, 1'000'000, 5'000'000};
+
+  struct Histogram {
+    void Record(Duration latency) noexcept;
+
+    std::array<std::atomic<uint64_t>, kBucketBoundsUs.size() + 1> buckets{};
+    std::atomic<uint64_t> sum_ns{0};
+  };
+
+  static void AppendHistogram(std::string& text, const std::string& name, const std::string& labels,
+                              const Histogram& histogram);
+
+  const uint32_t sample_rate_;
+  std::atomic<uint64_t> run_counter_{0};
+  std::atomic<uint64_t> expired_runs_{0};
+
+  // indexed by NodeIndex
+  std::vector<Histogram> node_histograms_;
+  // Prometheus labels of the nodes, empty for the indices without a node
+  std::vector<std::string> node_labels_;
+
+  Histogram run_histogram_;
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -46,6 +46,10 @@ struct AllocPlanPerValue {
   // if alloc_kind is kAllocate, it will only allocate required buffer size (like ConstantOfShape).
   bool is_strided_tensor{false};
 #endif
+  // is_view indicates that the kernel may create this OrtValue as a view of a contiguous range of
+  // the reused input (see KernelDefBuilder::MayOutputView). If the kernel does not, it is allocated
+  // on its own and released after its last consumer.
+  bool is_view{false};
 
   class ProgramCounter {
    public:
@@ -165,6 +169,19 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
 
   size_t num_barriers{0};
 
+  // Weight streaming, see kOrtSessionOptionsConfigEnableWeightStreaming.
+  // The location of a streamed weight in allocation_plan is the host memory it is kept in; `device` is where its
+  // consumers run.
+  struct StreamedWeight {
+    OrtValueIndex value_index;
+    OrtDevice device;
+  };
+  std::vector<StreamedWeight> streamed_weights;
+  // for each node, the streamed weights (indices in streamed_weights) to copy to the device before the node runs.
+  InlinedHashMap<NodeIndex, InlinedVector<size_t>> node_weight_prefetch_list;
+  // for each node, the streamed weights to free after the node ran.
+  InlinedHashMap<NodeIndex, InlinedVector<size_t>> node_weight_release_list;
+
 #ifdef ENABLE_TRAINING
   InlinedVector<NodeIndex> node_execution_order_in_training;
   InlinedHashMap<NodeIndex, size_t> node_index_2_toposort_index;
@@ -3,7 +3,9 @@
 
 #include "core/framework/sequential_executor.h"
 
+#include <algorithm>
 #include <chrono>
+#include <optional>
 #include <thread>
 #include <vector>
 #include <sstream>
@@ -14,10 +16,13 @@
 #include "core/framework/stream_execution_context.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/parallelism_tuner.h"
+#include "core/framework/sampled_profiler.h"
 #include "core/framework/utils.h"
 
 #if defined DEBUG_NODE_INPUTS_OUTPUTS
 #include "core/framework/debug_node_inputs_outputs_utils.h"
+#include "core/platform/threadpool.h"
 #endif
 
 #ifdef ENABLE_NVTX_PROFILE
@@ -180,6 +185,13 @@ class SessionScope {
       session_start_ = session_state.Profiler().Start();
     }
 
+    sampled_profiler_ = session_state_.GetSampledProfiler();
+    if (sampled_profiler_ != nullptr && sampled_profiler_->SampleRun()) {
+      sampled_start_ = std::chrono::steady_clock::now();
+    } else {
+      sampled_profiler_ = nullptr;
+    }
+
     auto& logger = session_state_.Logger();
     VLOGS(logger, 0) << "Begin execution";
     const SequentialExecutionPlan& seq_exec_plan = *session_state_.GetExecutionPlan();
@@ -197,6 +209,14 @@ class SessionScope {
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionScope);
 
+  // Whether the deadline of the run has passed, see concurrency::ThreadPool::DeadlineScope.
+  bool IsDeadlineExpired() const {
+    return deadline_ != concurrency::ThreadPool::Deadline::max() && std::chrono::steady_clock::now() >= deadline_;
+  }
+
+  // The options of the run, captured like the deadline.
+  const RunOptions* GetRunOptions() const { return run_options_; }
+
   ~SessionScope() {
 #ifdef ENABLE_NVTX_PROFILE
     // Make sure forward Range object call Begin and End.
@@ -227,6 +247,9 @@ class SessionScope {
     if (session_state_.Profiler().IsEnabled()) {
       session_state_.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", session_start_);
     }
+    if (sampled_profiler_ != nullptr) {
+      sampled_profiler_->RecordRun(std::chrono::steady_clock::now() - sampled_start_);
+    }
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
     auto& logger = session_state_.Logger();
     for (auto i : frame_.GetStaticMemorySizeInfo()) {
@@ -250,6 +273,12 @@ class SessionScope {
  private:
   const SessionState& session_state_;
   TimePoint session_start_;
+  // the sampling profiler if this Run is sampled, otherwise nullptr
+  profiling::SampledProfiler* sampled_profiler_{nullptr};
+  std::chrono::steady_clock::time_point sampled_start_;
+  // captured in the thread that starts the run, the nodes may run in the inter-op thread pool
+  const concurrency::ThreadPool::Deadline deadline_{concurrency::ThreadPool::CurrentDeadline()};
+  const RunOptions* run_options_{RunOptionsScope::Current()};
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   const ExecutionFrame& frame_;
   // Whether memory profiler need create events and flush to file.
@@ -332,6 +361,10 @@ class KernelScope {
     utils::DumpNodeInputs(dump_context_, kernel_context_, kernel_.Node(), session_state_);
 #endif
 
+    if (auto* collector = session_state_.GetTensorStatisticsCollector(); collector != nullptr) {
+      collector->RecordNodeInputs(kernel_.Node(), kernel_context_);
+    }
+
 #ifdef ENABLE_NVTX_PROFILE
     node_compute_range_.Begin();
 #endif
@@ -345,12 +378,18 @@ class KernelScope {
                                      node_name_ + "_fence_before",
                                      sync_time_begin,
                                      {{"op_name", kernel_.KernelDef().OpName()}});
-      concurrency::ThreadPool::StartProfiling(session_state_.GetThreadPool());
+      concurrency::ThreadPool::StartProfiling(session_state_.GetThreadPool(), profiler.GetHardwareCounters());
       VLOGS(session_state_.Logger(), 1) << "Computing kernel: " << node_name_;
       kernel_begin_time_ = session_state_.Profiler().Start();
       CalculateTotalInputSizes(&kernel_context, &kernel_,
                                input_activation_sizes_, input_parameter_sizes_,
                                node_name_, input_type_shape_);
+      hardware_counters_read_ = profiling::ReadHardwareCounters(profiler.GetHardwareCounters(),
+                                                                hardware_counters_begin_);
+    }
+
+    if (session_scope_.sampled_profiler_ != nullptr) {
+      sampled_kernel_start_ = std::chrono::steady_clock::now();
     }
   }
 
@@ -361,8 +400,20 @@ class KernelScope {
     node_compute_range_.End();
 #endif
 
+    if (session_scope_.sampled_profiler_ != nullptr) {
+      session_scope_.sampled_profiler_->RecordNode(kernel_.Node().Index(),
+                                                   std::chrono::steady_clock::now() - sampled_kernel_start_);
+    }
+
     if (session_state_.Profiler().IsEnabled()) {
       auto& profiler = session_state_.Profiler();
+      profiling::HardwareCounterValues hardware_counters_end{};
+      const long long hardware_counters_duration_us = TimeDiffMicroSeconds(kernel_begin_time_);
+      if (hardware_counters_read_ != 0 &&
+          profiling::ReadHardwareCounters(profiler.GetHardwareCounters(), hardware_counters_end) !=
+              hardware_counters_read_) {
+        hardware_counters_read_ = 0;
+      }
       std::string output_type_shape_;
       CalculateTotalOutputSizes(&kernel_context_, total_output_sizes_, node_name_, output_type_shape_);
       profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT,
@@ -381,6 +432,21 @@ class KernelScope {
                                          {"thread_scheduling_stats",
                                           concurrency::ThreadPool::StopProfiling(session_state_.GetThreadPool())},
                                      });
+      if (hardware_counters_read_ != 0) {
+        profiling::HardwareCounterValues counts{};
+        profiling::AccumulateHardwareCounters(hardware_counters_begin_, hardware_counters_end, counts);
+        profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                       node_name_ + "_hardware_counters",
+                                       kernel_begin_time_,
+                                       {
+                                           {"op_name", kernel_.KernelDef().OpName()},
+                                           {"provider", kernel_.KernelDef().Provider()},
+                                           {"node_index", std::to_string(kernel_.Node().Index())},
+                                           {"hardware_counters",
+                                            profiling::HardwareCountersToJson(
+                                                hardware_counters_read_, counts, hardware_counters_duration_us)},
+                                       });
+      }
       auto sync_time_begin = profiler.Start();
       profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT,
                                      node_name_ + "_fence_after",
@@ -405,10 +471,18 @@ class KernelScope {
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
     utils::DumpNodeOutputs(dump_context_, kernel_context_, kernel_.Node(), session_state_);
 #endif
+
+    if (auto* collector = session_state_.GetTensorStatisticsCollector(); collector != nullptr) {
+      collector->RecordNodeOutputs(kernel_.Node(), kernel_context_);
+    }
   }  //~KernelScope
 
  private:
   TimePoint kernel_begin_time_;
+  // hardware counters read when the kernel started, see kOrtSessionOptionsConfigProfilingHardwareCounters
+  profiling::HardwareCounterMask hardware_counters_read_{0};
+  profiling::HardwareCounterValues hardware_counters_begin_{};
+  std::chrono::steady_clock::time_point sampled_kernel_start_;
   SessionScope& session_scope_;
   const SessionState& session_state_;
   std::string node_name_;
@@ -438,6 +512,11 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
                                   size_t stream_idx,
                                   const bool& terminate_flag,
                                   SessionScope& session_scope) {
+  if (session_scope.IsDeadlineExpired()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to the deadline of the run having passed.");
+  }
+  ORT_RETURN_IF_ERROR(ctx.PrefetchStreamedWeights(idx, stream_idx));
+  ORT_RETURN_IF_ERROR(ctx.GetSessionState().EnsureNodePrePacked(idx));
   auto* p_kernel = ctx.GetSessionState().GetKernel(idx);
   if (p_kernel->KernelDef().OpName() == "YieldOp") {
     // Do not execute YieldOp (it is an no-op anyways).
@@ -446,8 +525,11 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
     // as graph outputs are owned by ORT, the risk of caller freeing the tensor or manipulating tensor
     // memory lingers while the tensor is used downstream after the export.
     ctx.RecycleNodeInputs(idx);
+    ctx.ReleaseStreamedWeights(idx);
     return Status::OK();
   }
+  // the kernel reads the options in its context, and the subgraphs it executes in this thread capture them too
+  RunOptionsScope run_options_scope(session_scope.GetRunOptions());
   // TODO: set terminate flag from run_option
   OpKernelContextInternal kernel_ctx(ctx.GetSessionState(),
                                      ctx.GetExecutionFrame(),
@@ -457,6 +539,23 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
                                      ctx.GetDeviceStream(stream_idx));
   onnxruntime::Status status;
   auto& logger = ctx.GetLogger();
+
+  // cap the parallel loops of the node to the degree of parallelism learnt for its input shapes, or to the candidate
+  // being measured, see kOrtSessionOptionsConfigIntraOpAdaptiveParallelismSamples.
+  auto* parallelism_tuner = ctx.GetSessionState().GetParallelismTuner();
+  ParallelismTuner::Trial parallelism_trial;
+  uint64_t shape_hash = 0;
+  if (parallelism_tuner != nullptr && parallelism_tuner->IsTuned(idx)) {
+    shape_hash = ParallelismTuner::HashInputShapes(kernel_ctx);
+    parallelism_trial = parallelism_tuner->Select(idx, shape_hash);
+  }
+  std::optional<concurrency::ThreadPool::MaxDegreeOfParallelismScope> parallelism_scope;
+  if (parallelism_trial.degree_of_parallelism > 0) {
+    parallelism_scope.emplace(parallelism_trial.degree_of_parallelism);
+  }
+  const auto compute_start = parallelism_trial.measure ? std::chrono::steady_clock::now()
+                                                       : std::chrono::steady_clock::time_point{};
+
   if (p_kernel->IsAsync()) {
     ORT_THROW("Async Kernel Support is not implemented yet.");
   } else {
@@ -501,6 +600,11 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
       });
     }
   }
+  if (parallelism_trial.measure && status.IsOK()) {
+    parallelism_tuner->Record(idx, shape_hash, parallelism_trial.degree_of_parallelism,
+                              std::chrono::duration_cast<ParallelismTuner::Duration>(
+                                  std::chrono::steady_clock::now() - compute_start));
+  }
   if (!status.IsOK()) {
     std::ostringstream ss;
     const auto& node = p_kernel->Node();
@@ -517,10 +621,112 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
     return Status(status.Category(), status.Code(), msg_string);
   }
   ctx.RecycleNodeInputs(idx);
+  ctx.ReleaseStreamedWeights(idx);
   VLOGS(logger, 0) << "stream " << stream_idx << " launch kernel with idx " << idx;
   return Status::OK();
 }
 
+// Returns the stream that executes all the nodes if the Run can stop at an early exit point: the plan has a single
+// stream without streamed weights, and the fetches are graph outputs the exit points return values for and are not
+// pre-allocated. Sets fetch_positions to the positions of the fetches in EarlyExits::graph_output_idxs.
+static std::optional<size_t> GetEarlyExitStream(const SessionState::EarlyExits& early_exits,
+                                                const SequentialExecutionPlan& plan,
+                                                gsl::span<const int> fetch_mlvalue_idxs,
+                                                gsl::span<const OrtValue> fetches,
+                                                InlinedVector<size_t>& fetch_positions) {
+  if (!plan.streamed_weights.empty() ||
+      std::any_of(fetches.begin(), fetches.end(), [](const OrtValue& fetch) { return fetch.IsAllocated(); })) {
+    return std::nullopt;
+  }
+
+  std::optional<size_t> stream_idx;
+  for (size_t i = 0; i < plan.execution_plan.size(); ++i) {
+    if (!plan.execution_plan[i]->steps_.empty()) {
+      if (stream_idx.has_value()) {
+        return std::nullopt;
+      }
+      stream_idx = i;
+    }
+  }
+
+  const auto& graph_output_idxs = early_exits.graph_output_idxs;
+  fetch_positions.clear();
+  for (int fetch_idx : fetch_mlvalue_idxs) {
+    const auto it = std::find(graph_output_idxs.begin(), graph_output_idxs.end(), fetch_idx);
+    if (it == graph_output_idxs.end()) {
+      return std::nullopt;
+    }
+    fetch_positions.push_back(static_cast<size_t>(it - graph_output_idxs.begin()));
+  }
+
+  return stream_idx;
+}
+
+static Status IsEarlyExitTaken(StreamExecutionContext& ctx, size_t stream_idx,
+                               const SessionState::EarlyExitPoint& exit_point, bool& taken) {
+  std::vector<OrtValue> values;
+  ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GetOutputs(gsl::make_span(&exit_point.predicate_idx, 1), values));
+  ORT_RETURN_IF_NOT(values[0].IsTensor(), "The early exit predicate must be a tensor.");
+  const Tensor& predicate = values[0].Get<Tensor>();
+  ORT_RETURN_IF_NOT(predicate.IsDataType<bool>() && predicate.Shape().Size() == 1,
+                    "The early exit predicate must be a boolean tensor with one element, got ",
+                    DataTypeImpl::ToString(predicate.DataType()), " ", predicate.Shape());
+
+  if (predicate.Location().device.Type() == OrtDevice::CPU) {
+    taken = *predicate.Data<bool>();
+    return Status::OK();
+  }
+
+  // the predicate is produced on the stream of the Run, wait for it before reading it back
+  if (Stream* stream = ctx.GetDeviceStream(stream_idx); stream != nullptr) {
+    stream->Flush();
+  }
+
+  bool value = false;
+  Tensor cpu_predicate(predicate.DataType(), predicate.Shape(), &value,
+                       OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator));
+  ORT_RETURN_IF_ERROR(ctx.GetSessionState().GetDataTransferMgr().CopyTensor(predicate, cpu_predicate));
+  taken = value;
+  return Status::OK();
+}
+
+// Executes the nodes of the early exit points one after another, in the same frame, until the predicate of one of
+// them is true. Sets the fetches to the outputs of that exit point. Executes the remaining nodes otherwise.
+static Status RunEarlyExitPoints(StreamExecutionContext& ctx, SessionScope& session_scope,
+                                 const SessionState::EarlyExits& early_exits, size_t stream_idx,
+                                 gsl::span<const size_t> fetch_positions, const bool& terminate_flag,
+                                 std::vector<OrtValue>& fetches, bool& exited) {
+  exited = false;
+  bool first_pass = true;
+  auto run_pass = [&](const InlinedHashSet<NodeIndex>& nodes) {
+    // each pass completes the task of the stream
+    if (!first_pass) {
+      ctx.AddTask();
+    }
+    first_pass = false;
+
+    ctx.SetNodeToExecute(&nodes);
+    RunSince(stream_idx, ctx, session_scope, terminate_flag, 0);
+    return ctx.TaskStatus();
+  };
+
+  for (const auto& exit_point : early_exits.exit_points) {
+    ORT_RETURN_IF_ERROR(run_pass(exit_point.nodes));
+    ORT_RETURN_IF_ERROR(IsEarlyExitTaken(ctx, stream_idx, exit_point, exited));
+    if (exited) {
+      InlinedVector<int> output_idxs;
+      output_idxs.reserve(fetch_positions.size());
+      for (size_t position : fetch_positions) {
+        output_idxs.push_back(exit_point.output_idxs[position]);
+      }
+
+      return ctx.GetExecutionFrame().GetOutputs(output_idxs, fetches);
+    }
+  }
+
+  return run_pass(early_exits.remaining_nodes);
+}
+
 onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<const int> feed_mlvalue_idxs,
                                    gsl::span<const OrtValue> feeds, gsl::span<const int> fetch_mlvalue_idxs,
                                    std::vector<OrtValue>& fetches,
@@ -565,36 +771,57 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
                              logger,
                              single_thread_mode);
 #endif
-#ifdef ENABLE_TRAINING
   if (only_execute_path_to_fetches) {
-    auto* node_to_execute = session_state.GetToBeExecutedRange(fetch_mlvalue_idxs);
-    ctx.SetNodeToExecute(node_to_execute);
+    ctx.SetNodeToExecute(session_state.GetToBeExecutedRange(fetch_mlvalue_idxs, feed_mlvalue_idxs));
   }
-#else
-  ORT_UNUSED_PARAMETER(only_execute_path_to_fetches);
-#endif
 
   SessionScope session_scope(session_state, ctx.GetExecutionFrame());
 
   auto* tp = single_thread_mode ? nullptr : session_state.GetInterOpThreadPool();
 
-  for (size_t i = 0; i < execution_plan->execution_plan.size(); ++i) {
-    if (execution_plan->execution_plan[i]->steps_.empty()) {
-      // execution context is initialized with number of valid streams
-      // for invalid stream (0 steps), it doesn't count in number of tasks
-      // so don't need to invoke CompleteTask here
-      // ctx.CompleteTask();
-    } else {
-      concurrency::ThreadPool::Schedule(tp, [i, &ctx, &terminate_flag, &session_scope]() {
-        RunSince(i, ctx, session_scope, terminate_flag, 0);
-      });
+  // Without an inter-op pool the streams run in this thread, which can then lead one parallel section of the
+  // intra-op pool for the whole run. Subgraphs and kernels entering their own sections join this one.
+  std::optional<concurrency::ThreadPool::ParallelSection> run_parallel_section;
+  if (tp == nullptr && session_state.IsIntraOpRunParallelSectionEnabled()) {
+    run_parallel_section.emplace(session_state.GetThreadPool());
+  }
+
+  // a cascade only executes the nodes up to the first early exit point whose predicate is true
+  const auto* early_exits = only_execute_path_to_fetches ? nullptr : session_state.GetEarlyExits();
+  InlinedVector<size_t> early_exit_fetch_positions;
+  const auto early_exit_stream =
+      early_exits != nullptr
+          ? GetEarlyExitStream(*early_exits, *execution_plan, fetch_mlvalue_idxs, fetches, early_exit_fetch_positions)
+          : std::nullopt;
+
+  if (early_exit_stream.has_value()) {
+    bool exited = false;
+    ORT_RETURN_IF_ERROR(RunEarlyExitPoints(ctx, session_scope, *early_exits, *early_exit_stream,
+                                           early_exit_fetch_positions, terminate_flag, fetches, exited));
+    if (exited) {
+      return Status::OK();
+    }
+  } else {
+    for (size_t i = 0; i < execution_plan->execution_plan.size(); ++i) {
+      if (execution_plan->execution_plan[i]->steps_.empty()) {
+        // execution context is initialized with number of valid streams
+        // for invalid stream (0 steps), it doesn't count in number of tasks
+        // so don't need to invoke CompleteTask here
+        // ctx.CompleteTask();
+      } else {
+        concurrency::ThreadPool::Schedule(tp, [i, &ctx, &terminate_flag, &session_scope]() {
+          RunSince(i, ctx, session_scope, terminate_flag, 0);
+        });
+      }
     }
   }
 
   ctx.WaitAll();
+  run_parallel_section.reset();
   ORT_RETURN_IF_ERROR(ctx.TaskStatus());
   ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GetOutputs(fetches));
-  if (ctx.GetExecutionFrame().HasMemoryPatternPlanner()) {
+  // the allocations of a Run that skipped nodes don't make a pattern for the whole graph
+  if (ctx.GetExecutionFrame().ShouldUpdateMemoryPatterns() && ctx.GetNodeToExecute() == nullptr) {
     bool all_tensors = true;
     for (const auto& feed : feeds) {
       if (!(feed.IsTensor())) {
@@ -606,7 +833,11 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
     if (all_tensors) {
       MemoryPatternGroup mem_patterns;
       ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GeneratePatterns(mem_patterns));
-      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(feeds, std::move(mem_patterns)));
+      if (session_state.IsMemoryPatternShapeBucketingEnabled()) {
+        session_state.UpdateBucketedMemoryPatternGroupCache(feeds, std::move(mem_patterns));
+      } else {
+        ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(feeds, std::move(mem_patterns)));
+      }
     }
   }
 
@@ -6,10 +6,16 @@
 #include <sstream>
 
 #include "core/platform/ort_mutex.h"
+#include "core/common/hash_combine.h"
 #include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
 #include "core/common/safeint.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/allocator.h"
+#include "core/framework/bfc_arena.h"
+#include "core/framework/execution_steps.h"
+#include "core/framework/memory_pattern_slab_pool.h"
+#include "core/framework/mldata_type_utils.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_pattern_planner.h"
@@ -21,6 +27,23 @@
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
+namespace {
+thread_local const ThreadPoolBinding* current_thread_pool_binding = nullptr;
+}  // namespace
+
+ThreadPoolBindingScope::ThreadPoolBindingScope(const ThreadPoolBinding* binding)
+    : previous_binding_(current_thread_pool_binding) {
+  current_thread_pool_binding = binding;
+}
+
+ThreadPoolBindingScope::~ThreadPoolBindingScope() {
+  current_thread_pool_binding = previous_binding_;
+}
+
+const ThreadPoolBinding* ThreadPoolBindingScope::Current() {
+  return current_thread_pool_binding;
+}
+
 #ifdef ORT_ENABLE_STREAM
 static inline std::string GetWaitKey(const OrtDevice::DeviceType notificaiton_device_type,
                                      const OrtDevice::DeviceType executor_device_type) {
@@ -87,6 +110,22 @@ SessionState::SessionState(Graph& graph,
 {
   enable_mem_pattern_ = sess_options_.enable_mem_pattern &&
                         sess_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL;
+  if (enable_mem_pattern_) {
+    const std::string bucket_cache_size = sess_options_.config_options.GetConfigOrDefault(
+        kOrtSessionOptionsConfigMemoryPatternBucketCacheSize, "0");
+    ORT_ENFORCE(TryParseStringWithClassicLocale<size_t>(bucket_cache_size, mem_pattern_bucket_cache_size_),
+                "Invalid value for ", kOrtSessionOptionsConfigMemoryPatternBucketCacheSize, ": ", bucket_cache_size);
+
+    const std::string slab_pool_size = sess_options_.config_options.GetConfigOrDefault(
+        kOrtSessionOptionsConfigMemoryPatternSlabPoolSize, "0");
+    ORT_ENFORCE(TryParseStringWithClassicLocale<size_t>(slab_pool_size, mem_pattern_slab_pool_size_),
+                "Invalid value for ", kOrtSessionOptionsConfigMemoryPatternSlabPoolSize, ": ", slab_pool_size);
+  }
+
+  intra_op_run_parallel_section_ =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpRunParallelSection, "0") == "1";
+  stage_feeds_in_pinned_memory_ =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigStageFeedsInPinnedMemory, "0") == "1";
   if (parent_allocators) {
     allocators_ = parent_allocators;
   } else {
@@ -114,6 +153,28 @@ AllocatorPtr SessionState::GetAllocator(const OrtDevice& device) const noexcept
   return nullptr;
 }
 
+AllocatorPtr SessionState::GetMemoryPatternAllocator(const OrtDevice& device) const {
+  AllocatorPtr alloc = GetAllocator(device);
+  if (mem_pattern_slab_pool_size_ == 0 || alloc == nullptr) {
+    return alloc;
+  }
+
+#ifdef ORT_ENABLE_STREAM
+  // a stream aware arena shares the memory pattern buffer between the streams of a run, which needs the arena itself
+  if (alloc->Info().alloc_type == OrtArenaAllocator &&
+      StreamAwareArena::FromBFCArena(*static_cast<BFCArena*>(alloc.get())) != nullptr) {
+    return alloc;
+  }
+#endif
+
+  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
+  auto& pool = mem_pattern_slab_pools_[device];
+  if (pool == nullptr) {
+    pool = std::make_shared<MemoryPatternSlabPool>(std::move(alloc), mem_pattern_slab_pool_size_);
+  }
+  return pool;
+}
+
 void SessionState::UpdateAllocatorsWithEnvAllocators(const std::vector<AllocatorPtr>& env_allocators) {
   for (const auto& env_alloc : env_allocators) {
     (*allocators_)[env_alloc->Info().device] = env_alloc;
@@ -394,119 +455,184 @@ static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
   return ss_1.str();
 }
 
-Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
-                                                       const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
-  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
-                                        bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
-    for (auto& node : GetGraphViewer().Nodes()) {
-      auto kernel = GetMutableKernel(node.Index());
-      int input_idx = 0;
-      for (auto& input_def : node.InputDefs()) {
-        if (input_def->Exists()) {
-          const std::string& input_name = input_def->Name();
-          SessionState* st = this;
-          // subgraph can use the value from outer scope,
-          // so it needs to check if current node uses constant initialized tensor from current and outer graphs
-          do {
-            int ort_value_idx;
-            if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
-              std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
-
-              if (constant_initialized_tensors.count(ort_value_idx)) {
-                bool is_packed = false;
-                const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
-
-                auto iter = initializers_to_share_map.find(input_name);
-                bool is_shared_initializer = (iter != initializers_to_share_map.end());
-
-                // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
-                if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
-                    node.GetExecutionProviderType() == kCpuExecutionProvider) {  // caching of pre-packed weights' turned ON
-
-                  AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
-                  ORT_ENFORCE(allocator_for_caching.get() != nullptr);
-
-                  PrePackedWeights weights_to_be_filled_in;
-                  // The reason we invoke PrePack() before looking into the container for any pre-packed weight
-                  // cached by another instance of the same op_type (for the same constant initializer) is because
-                  // to truly know if we can use a cached pre-packed weight, we would have to compare the cached pre-packed
-                  // weight with the pre-packed weight generated by this instance of the same op_type because other static
-                  // properties of the node like node attributes could play a role in the pre-packed weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
-
-                  if (is_packed) {
-                    // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight to be cached if the weight was pre-packed
-                    ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0, "The kernel corresponding to the node ", node.Name(),
-                                " doesn't have an implementation that can cache computed pre-packed weights");
-
-                    const auto& op_type = node.OpType();
-
-                    // Sanity check
-                    // TODO: Check if some version of the ONNX IR allows op_type to be empty
-                    ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
-
-                    // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
-                    // that we just got by invoking PrePack() on this kernel.
-
-                    const std::string& prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(op_type,
-                                                                                                           weights_to_be_filled_in);
-
-                    bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(prepacked_weights_container_key);
-
-                    if (container_contains_packed_weight) {
-                      LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: " << input_name
-                                          << " used in the node: " << node.Name() << " which is of op type: " << node.OpType();
-
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
-                                                                          node.Name()));
-
-                      ++used_shared_pre_packed_weights_counter_;
-                    } else {  // container doesn't contain the pre-packed weight - so write into it for sharing across kernel instances
-
-                      if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key, std::move(weights_to_be_filled_in))) {
-                        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unable to write the provided PrePackedWeights instance into the container");
-                      }
-
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
-                                                                          node.Name()));
-                    }
-                  }
+Status SessionState::PrepackNodeConstantInitializedTensors(
+    const Node& node, InlinedVector<PrePackedInitializer>* packed_initializers,
+    const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+    bool should_cache_prepacked_weights_for_shared_initializers) {
+  PrepackedWeightsFileCache* prepacked_weights_file_cache = GetPrepackedWeightsFileCache();
+
+  auto kernel = GetMutableKernel(node.Index());
+  int input_idx = 0;
+  for (auto& input_def : node.InputDefs()) {
+    if (input_def->Exists()) {
+      const std::string& input_name = input_def->Name();
+      SessionState* st = this;
+      // subgraph can use the value from outer scope,
+      // so it needs to check if current node uses constant initialized tensor from current and outer graphs
+      do {
+        int ort_value_idx;
+        if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
+          const std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
+
+          auto constant_initialized_tensor_it = constant_initialized_tensors.find(ort_value_idx);
+          if (constant_initialized_tensor_it != constant_initialized_tensors.end()) {
+            bool is_packed = false;
+            const Tensor& const_initialized_tensor = constant_initialized_tensor_it->second.Get<Tensor>();
+
+            auto iter = initializers_to_share_map.find(input_name);
+            bool is_shared_initializer = (iter != initializers_to_share_map.end());
+
+            // The pre-packed weights file cache only serves CPU EP kernels that can be restored from
+            // read-only buffers without invoking PrePack()
+            const bool use_file_cache = prepacked_weights_file_cache != nullptr &&
+                                        node.GetExecutionProviderType() == kCpuExecutionProvider &&
+                                        kernel->CanRestorePrePackedWeightsFromBuffers(input_idx);
+
+            if (use_file_cache) {
+              const std::string file_cache_key = PrepackedWeightsFileCache::GenerateKey(node, input_idx,
+                                                                                         const_initialized_tensor);
+              const PrePackedWeights* cached_weights = prepacked_weights_file_cache->GetWeight(file_cache_key);
+
+              if (cached_weights != nullptr) {
+                LOGS(logger_, INFO) << "Using pre-packed weight from the pre-packed weights file for constant initializer: "
+                                    << input_name << " used in the node: " << node.Name()
+                                    << " which is of op type: " << node.OpType();
+
+                is_packed = true;
+                ++used_file_cached_pre_packed_weights_counter_;
+              } else {
+                AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+                PrePackedWeights weights_to_be_filled_in;
+                ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx,
+                                                    session_cpu_alloc,  // use allocator tied to this session
+                                                    is_packed,
+                                                    &weights_to_be_filled_in));
 
-                } else {  // caching of pre-packed weights' turned OFF
-                  AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx,
-                                                      session_cpu_alloc,  // use allocator tied to this session
-                                                      is_packed,
-                                                      nullptr  // no caching required
-                                                      ));
-                }
                 if (is_packed) {
-                  ++number_of_prepacks_counter_;
+                  ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0, "The kernel corresponding to the node ", node.Name(),
+                              " doesn't have an implementation that can cache computed pre-packed weights");
+
+                  prepacked_weights_file_cache->AddWeight(file_cache_key, std::move(weights_to_be_filled_in));
+                  cached_weights = prepacked_weights_file_cache->GetWeight(file_cache_key);
+                }
+              }
+
+              if (is_packed) {
+                ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx, *cached_weights, node.Name()));
+              }
+
+              // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
+            } else if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
+                       node.GetExecutionProviderType() == kCpuExecutionProvider) {  // caching of pre-packed weights' turned ON
+
+              AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
+              ORT_ENFORCE(allocator_for_caching.get() != nullptr);
+
+              PrePackedWeights weights_to_be_filled_in;
+              // The reason we invoke PrePack() before looking into the container for any pre-packed weight
+              // cached by another instance of the same op_type (for the same constant initializer) is because
+              // to truly know if we can use a cached pre-packed weight, we would have to compare the cached pre-packed
+              // weight with the pre-packed weight generated by this instance of the same op_type because other static
+              // properties of the node like node attributes could play a role in the pre-packed weights' contents.
+              ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
+                                                  is_packed,
+                                                  &weights_to_be_filled_in));
+
+              if (is_packed) {
+                // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight to be cached if the weight was pre-packed
+                ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0, "The kernel corresponding to the node ", node.Name(),
+                            " doesn't have an implementation that can cache computed pre-packed weights");
 
-                  if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
-                    // release the constant initialized tensor
-                    st->initialized_tensors_.erase(ort_value_idx);
-                    constant_initialized_tensors.erase(ort_value_idx);
+                const auto& op_type = node.OpType();
+
+                // Sanity check
+                // TODO: Check if some version of the ONNX IR allows op_type to be empty
+                ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
+
+                // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
+                // that we just got by invoking PrePack() on this kernel.
+
+                const std::string& prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(op_type,
+                                                                                                       weights_to_be_filled_in);
+
+                bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(prepacked_weights_container_key);
+
+                if (container_contains_packed_weight) {
+                  LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: " << input_name
+                                      << " used in the node: " << node.Name() << " which is of op type: " << node.OpType();
+
+                  ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                      prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
+                                                                      node.Name()));
+
+                  ++used_shared_pre_packed_weights_counter_;
+                } else {  // container doesn't contain the pre-packed weight - so write into it for sharing across kernel instances
+
+                  if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key, std::move(weights_to_be_filled_in))) {
+                    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unable to write the provided PrePackedWeights instance into the container");
                   }
+
+                  ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                      prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
+                                                                      node.Name()));
                 }
               }
-              // stop searching in 2 cases:
-              // 1. value is not from OuterScope
-              // 2. value is from OuterScope and the current OuterScope has the value
-              if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
-                break;
+
+            } else {  // caching of pre-packed weights' turned OFF
+              AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+              ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx,
+                                                  session_cpu_alloc,  // use allocator tied to this session
+                                                  is_packed,
+                                                  nullptr  // no caching required
+                                                  ));
+            }
+            if (is_packed) {
+              ++number_of_prepacks_counter_;
+
+              if (packed_initializers != nullptr) {
+                packed_initializers->push_back({st, ort_value_idx, input_name});
               }
             }
-            st = st->Parent();
-          } while (st);
+          }
+          // stop searching in 2 cases:
+          // 1. value is not from OuterScope
+          // 2. value is from OuterScope and the current OuterScope has the value
+          if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
+            break;
+          }
         }
-        input_idx++;
+        st = st->Parent();
+      } while (st);
+    }
+    input_idx++;
+  }
+
+  return Status::OK();
+}
+
+Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
+                                                       const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
+  // release the constant initialized tensors that are not used unpacked anymore
+  auto release_packed_initializers = [&constant_initializers_use_count](
+                                         const InlinedVector<PrePackedInitializer>& packed_initializers) {
+    for (const auto& packed_initializer : packed_initializers) {
+      auto use_count = constant_initializers_use_count.find(packed_initializer.name);
+      if (use_count != constant_initializers_use_count.end() && --use_count->second == 0) {
+        packed_initializer.owner->initialized_tensors_.erase(packed_initializer.ort_value_idx);
+        packed_initializer.owner->constant_initialized_tensors_.erase(packed_initializer.ort_value_idx);
       }
     }
+  };
+
+  auto prepacked_constant_weights = [this, &release_packed_initializers, &initializers_to_share_map](
+                                        bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
+    for (auto& node : GetGraphViewer().Nodes()) {
+      InlinedVector<PrePackedInitializer> packed_initializers;
+      ORT_RETURN_IF_ERROR(PrepackNodeConstantInitializedTensors(
+          node, &packed_initializers, initializers_to_share_map,
+          should_cache_prepacked_weights_for_shared_initializers));
+      release_packed_initializers(packed_initializers);
+    }
 
     return Status::OK();
   };
@@ -518,9 +644,116 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
     // and writes pre-packed weights to the container
     std::lock_guard<onnxruntime::OrtMutex> l(prepacked_weights_container_->mutex_);
     return prepacked_constant_weights(true);
-  } else {
+  }
+
+  // Without shared pre-packed weights, PrePack() of a kernel only touches the kernel itself, so the nodes can be
+  // pre-packed concurrently. The initializers are released once all nodes are done as they may be read meanwhile.
+  int max_concurrency = 1;
+  ORT_RETURN_IF_ERROR(session_state_utils::GetInitializerLoadConcurrency(sess_options_, thread_pool_,
+                                                                         max_concurrency));
+  if (max_concurrency <= 1 || GetPrepackedWeightsFileCache() != nullptr) {
     return prepacked_constant_weights(false);
   }
+
+  InlinedVector<const Node*> nodes;
+  for (const auto& node : GetGraphViewer().Nodes()) {
+    nodes.push_back(&node);
+  }
+
+  std::vector<InlinedVector<PrePackedInitializer>> packed_initializers(nodes.size());
+  ORT_RETURN_IF_ERROR(session_state_utils::RunConcurrently(
+      thread_pool_, max_concurrency, nodes.size(), [&](size_t i) -> Status {
+        return PrepackNodeConstantInitializedTensors(*nodes[i], &packed_initializers[i], initializers_to_share_map,
+                                                     false);
+      }));
+
+  for (const auto& node_packed_initializers : packed_initializers) {
+    release_packed_initializers(node_packed_initializers);
+  }
+
+  return Status::OK();
+}
+
+Status SessionState::EnsureNodePrePacked(NodeIndex node_index) const {
+  if (!lazy_prepacking_ || lazily_prepacked_nodes_[node_index].load(std::memory_order_acquire)) {
+    return Status::OK();
+  }
+
+  // PrePack() mutates the kernel and the counters, and the pre-packed weights file cache is shared by the whole
+  // session, so pre-packing is serialized on the root session state. Runs executing the node concurrently wait here
+  // until its kernel is pre-packed.
+  const SessionState* root = this;
+  while (root->parent_ != nullptr) {
+    root = root->parent_;
+  }
+
+  std::lock_guard<OrtMutex> lock(root->lazy_prepacking_mutex_);
+  if (lazily_prepacked_nodes_[node_index].load(std::memory_order_relaxed)) {
+    return Status::OK();
+  }
+
+  const Node* node = graph_viewer_->GetNode(node_index);
+  ORT_RETURN_IF(node == nullptr, "Node with index ", node_index, " is not in the graph.");
+
+  // the kernels are owned by this session state and only reached through a const reference during execution
+  auto* session_state = const_cast<SessionState*>(this);
+  if (prepacked_weights_container_ != nullptr) {
+    std::lock_guard<OrtMutex> container_lock(prepacked_weights_container_->mutex_);
+    ORT_RETURN_IF_ERROR(session_state->PrepackNodeConstantInitializedTensors(
+        *node, nullptr, sess_options_.initializers_to_share_map, true));
+  } else {
+    ORT_RETURN_IF_ERROR(session_state->PrepackNodeConstantInitializedTensors(
+        *node, nullptr, sess_options_.initializers_to_share_map, false));
+  }
+
+  lazily_prepacked_nodes_[node_index].store(true, std::memory_order_release);
+  return Status::OK();
+}
+
+Status SessionState::PrefaultConstantInitializers(const std::atomic<bool>& stop) const {
+  for (const auto& node : graph_viewer_->Nodes()) {
+    if (stop.load(std::memory_order_relaxed)) {
+      return Status::OK();
+    }
+    ORT_RETURN_IF_ERROR(EnsureNodePrePacked(node.Index()));
+  }
+
+  // read a byte per page of the constant initializers kept in CPU memory, e.g. the ones aliasing the memory mapped
+  // external data file, so that their first use doesn't page fault
+  constexpr size_t kPageSize = 4096;
+  for (const auto& [ort_value_index, ort_value] : constant_initialized_tensors_) {
+    if (stop.load(std::memory_order_relaxed)) {
+      return Status::OK();
+    }
+    if (!ort_value.IsTensor()) {
+      continue;
+    }
+    const Tensor& tensor = ort_value.Get<Tensor>();
+    if (tensor.Location().device.Type() != OrtDevice::CPU || tensor.IsDataTypeString()) {
+      continue;
+    }
+    const volatile char* data = static_cast<const char*>(tensor.DataRaw());
+    for (size_t offset = 0; offset < tensor.SizeInBytes(); offset += kPageSize) {
+      static_cast<void>(data[offset]);
+    }
+  }
+
+  for (const auto& [node_index, subgraph_session_states] : subgraph_session_states_) {
+    for (const auto& [attribute_name, subgraph_session_state] : subgraph_session_states) {
+      ORT_RETURN_IF_ERROR(subgraph_session_state->PrefaultConstantInitializers(stop));
+    }
+  }
+
+  return Status::OK();
+}
+
+PrepackedWeightsFileCache* SessionState::GetPrepackedWeightsFileCache() {
+  SessionState* root = this;
+  while (root->parent_ != nullptr) {
+    root = root->parent_;
+  }
+
+  return root->prepacked_weights_file_cache_.get();
 }
 
 static int64_t CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) {
@@ -531,6 +764,21 @@ static int64_t CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tenso
   return key;
 }
 
+static int64_t CalculateBucketedMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) {
+  size_t key = 0;
+  for (const auto& input : tensor_inputs) {
+    const auto dims = input.Get<Tensor>().Shape().GetDims();
+    // the rank distinguishes inputs whose bucketed dims would otherwise combine to the same sequence
+    HashCombine(dims.size(), key);
+    for (auto dim : dims) {
+      int64_t bucket = 1;
+      while (bucket < dim) bucket <<= 1;
+      HashCombine(dim > 0 ? bucket : dim, key);
+    }
+  }
+  return static_cast<int64_t>(key);
+}
+
 #ifdef ENABLE_TRAINING
 namespace {
 Status ResolveDimParams(const GraphViewer& graph,
@@ -855,6 +1103,41 @@ Status SessionState::UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> ten
   return Status::OK();
 }
 
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetBucketedMemoryPatternGroup(
+    gsl::span<const OrtValue> tensor_inputs) const {
+  int64_t key = CalculateBucketedMemoryPatternsKey(tensor_inputs);
+  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
+  auto it = bucketed_mem_patterns_.find(key);
+  if (it == bucketed_mem_patterns_.end()) {
+    return nullptr;
+  }
+
+  bucketed_mem_patterns_lru_.splice(bucketed_mem_patterns_lru_.begin(), bucketed_mem_patterns_lru_, it->second);
+  return it->second->second;
+}
+
+void SessionState::UpdateBucketedMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
+                                                         MemoryPatternGroup mem_patterns) const {
+  int64_t key = CalculateBucketedMemoryPatternsKey(tensor_inputs);
+  auto patterns = std::make_shared<const MemoryPatternGroup>(std::move(mem_patterns));
+
+  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
+  auto it = bucketed_mem_patterns_.find(key);
+  if (it != bucketed_mem_patterns_.end()) {
+    // the frames still using the previous pattern hold a reference to it
+    it->second->second = std::move(patterns);
+    bucketed_mem_patterns_lru_.splice(bucketed_mem_patterns_lru_.begin(), bucketed_mem_patterns_lru_, it->second);
+    return;
+  }
+
+  bucketed_mem_patterns_lru_.emplace_front(key, std::move(patterns));
+  bucketed_mem_patterns_.insert_or_assign(key, bucketed_mem_patterns_lru_.begin());
+  if (bucketed_mem_patterns_lru_.size() > mem_pattern_bucket_cache_size_) {
+    bucketed_mem_patterns_.erase(bucketed_mem_patterns_lru_.back().first);
+    bucketed_mem_patterns_lru_.pop_back();
+  }
+}
+
 bool SessionState::GetEnableMemoryPattern() const { return enable_mem_pattern_; }
 
 bool SessionState::GetEnableMemoryReuse() const { return sess_options_.enable_mem_reuse; }
@@ -984,47 +1267,147 @@ const NodeIndexInfo& SessionState::GetNodeIndexInfo() const {
   return *node_index_info_;
 }
 
-#ifdef ENABLE_TRAINING
-void SessionState::UpdateToBeExecutedRange(gsl::span<int const> fetch_mlvalue_idxs) {
-  InlinedVector<int> sorted_idxs;
-  sorted_idxs.reserve(fetch_mlvalue_idxs.size());
-  sorted_idxs.assign(fetch_mlvalue_idxs.begin(), fetch_mlvalue_idxs.end());
-  std::sort(sorted_idxs.begin(), sorted_idxs.end());
-  if (to_be_executed_nodes_.find(sorted_idxs) != to_be_executed_nodes_.end())
+namespace {
+// The key of the nodes to execute: the sorted fetches, followed by -1 and the sorted feeds if there are any.
+InlinedVector<int> GetToBeExecutedRangeKey(gsl::span<int const> fetch_mlvalue_idxs,
+                                           gsl::span<int const> feed_mlvalue_idxs) {
+  InlinedVector<int> key;
+  key.reserve(fetch_mlvalue_idxs.size() + feed_mlvalue_idxs.size() + 1);
+  key.assign(fetch_mlvalue_idxs.begin(), fetch_mlvalue_idxs.end());
+  std::sort(key.begin(), key.end());
+  if (!feed_mlvalue_idxs.empty()) {
+    key.push_back(-1);
+    const auto feeds_begin = key.insert(key.end(), feed_mlvalue_idxs.begin(), feed_mlvalue_idxs.end());
+    std::sort(feeds_begin, key.end());
+  }
+  return key;
+}
+}  // namespace
+
+void SessionState::UpdateToBeExecutedRange(gsl::span<int const> fetch_mlvalue_idxs,
+                                           gsl::span<int const> feed_mlvalue_idxs) const {
+  auto key = GetToBeExecutedRangeKey(fetch_mlvalue_idxs, feed_mlvalue_idxs);
+
+  std::lock_guard<OrtMutex> lock(to_be_executed_nodes_mutex_);
+  if (to_be_executed_nodes_.find(key) != to_be_executed_nodes_.end())
     return;
 
-  // Get the nodes generating the fetches.
+  InlinedVector<int> sorted_fetch_idxs(fetch_mlvalue_idxs.begin(), fetch_mlvalue_idxs.end());
+  std::sort(sorted_fetch_idxs.begin(), sorted_fetch_idxs.end());
+  const InlinedHashSet<int> feed_idxs(feed_mlvalue_idxs.begin(), feed_mlvalue_idxs.end());
+
+  // Get the nodes generating the fetches, and the nodes generating feeds which must not be executed.
+  // Fetches of graph inputs and initializers don't need any node.
+  // The producers are looked up from the node outputs as the producer lookup of the graph isn't available in
+  // minimal builds.
   InlinedVector<const Node*> nodes;
   nodes.reserve(fetch_mlvalue_idxs.size());
+  InlinedHashSet<const Node*> fed_nodes;
   InlinedHashSet<NodeIndex> reachable_nodes;
   reachable_nodes.reserve(graph_.NumberOfNodes());
 
-  for (auto idx : fetch_mlvalue_idxs) {
-    std::string node_arg_name;
-    const auto status = this->GetOrtValueNameIdxMap().GetName(idx, node_arg_name);
-    ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
-    auto ending_node = graph_.GetProducerNode(node_arg_name);
-    nodes.push_back(ending_node);
+  const auto& ort_value_name_idx_map = GetOrtValueNameIdxMap();
+  for (const auto& node : graph_.Nodes()) {
+    bool produces_fetch = false;
+    bool produces_feed = false;
+    for (const auto* output_def : node.OutputDefs()) {
+      int idx;
+      if (output_def->Exists() && ort_value_name_idx_map.GetIdx(output_def->Name(), idx).IsOK()) {
+        produces_fetch = produces_fetch ||
+                         std::binary_search(sorted_fetch_idxs.begin(), sorted_fetch_idxs.end(), idx);
+        produces_feed = produces_feed || feed_idxs.count(idx) != 0;
+      }
+    }
+
+    if (produces_feed) {
+      fed_nodes.insert(&node);
+    } else if (produces_fetch) {
+      nodes.push_back(&node);
+    }
   }
 
-  // Reversely traverse to get reachable nodes.
+  // Reversely traverse to get reachable nodes, stopping at the nodes whose outputs were fed.
   graph_.ReverseDFSFrom(
-      nodes, {}, [&reachable_nodes](const Node* n) { reachable_nodes.insert(n->Index()); });
+      nodes, {}, [&reachable_nodes](const Node* n) { reachable_nodes.insert(n->Index()); }, {},
+      [&fed_nodes](const Node*, const Node* input_node) { return fed_nodes.count(input_node) != 0; });
 
   // global start, end doesn't matters
-  to_be_executed_nodes_.emplace(std::move(sorted_idxs), std::move(reachable_nodes));
+  to_be_executed_nodes_.emplace(std::move(key), std::move(reachable_nodes));
 }
 
 const InlinedHashSet<NodeIndex>* SessionState::GetToBeExecutedRange(
-    gsl::span<int const> fetch_mlvalue_idxs) const {
-  InlinedVector<int> sorted_idxs;
-  sorted_idxs.reserve(fetch_mlvalue_idxs.size());
-  sorted_idxs.assign(fetch_mlvalue_idxs.begin(), fetch_mlvalue_idxs.end());
-  std::sort(sorted_idxs.begin(), sorted_idxs.end());
-  auto it = to_be_executed_nodes_.find(sorted_idxs);
+    gsl::span<int const> fetch_mlvalue_idxs, gsl::span<int const> feed_mlvalue_idxs) const {
+  const auto key = GetToBeExecutedRangeKey(fetch_mlvalue_idxs, feed_mlvalue_idxs);
+
+  std::lock_guard<OrtMutex> lock(to_be_executed_nodes_mutex_);
+  auto it = to_be_executed_nodes_.find(key);
   return (it != to_be_executed_nodes_.end()) ? &it->second : nullptr;
 }
-#endif
+
+Status SessionState::SetEarlyExits(
+    gsl::span<const std::pair<std::string, std::vector<std::string>>> exit_points,
+    gsl::span<const std::string> graph_outputs) {
+  auto early_exits = std::make_unique<EarlyExits>();
+  const auto& ort_value_name_idx_map = GetOrtValueNameIdxMap();
+  for (const auto& name : graph_outputs) {
+    int idx;
+    ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(name, idx));
+    early_exits->graph_output_idxs.push_back(idx);
+  }
+
+  // The producers are looked up from the node outputs as the producer lookup of the graph isn't available in
+  // minimal builds.
+  InlinedHashMap<std::string_view, const Node*> producers;
+  for (const auto& node : graph_.Nodes()) {
+    for (const auto* output_def : node.OutputDefs()) {
+      if (output_def->Exists()) {
+        producers.emplace(output_def->Name(), &node);
+      }
+    }
+  }
+
+  // each exit point executes the nodes its values depend on that the previous exit points didn't execute
+  InlinedHashSet<NodeIndex> executed_nodes;
+  for (const auto& [predicate, outputs] : exit_points) {
+    ORT_RETURN_IF_NOT(outputs.size() == graph_outputs.size(), "The early exit point of ", predicate, " has ",
+                      outputs.size(), " outputs, but the graph has ", graph_outputs.size());
+
+    EarlyExitPoint exit_point;
+    InlinedVector<const Node*> nodes;
+    auto add_value = [&](const std::string& name, int& idx) -> Status {
+      ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(name, idx));
+      const auto producer = producers.find(name);
+      ORT_RETURN_IF(producer == producers.end(), "The early exit value ", name, " is not produced by a node.");
+      if (executed_nodes.count(producer->second->Index()) == 0) {
+        nodes.push_back(producer->second);
+      }
+      return Status::OK();
+    };
+
+    ORT_RETURN_IF_ERROR(add_value(predicate, exit_point.predicate_idx));
+    exit_point.output_idxs.resize(outputs.size());
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      ORT_RETURN_IF_ERROR(add_value(outputs[i], exit_point.output_idxs[i]));
+    }
+
+    graph_.ReverseDFSFrom(
+        nodes, {}, [&exit_point](const Node* n) { exit_point.nodes.insert(n->Index()); }, {},
+        [&executed_nodes](const Node*, const Node* input_node) {
+          return executed_nodes.count(input_node->Index()) != 0;
+        });
+    executed_nodes.insert(exit_point.nodes.begin(), exit_point.nodes.end());
+    early_exits->exit_points.push_back(std::move(exit_point));
+  }
+
+  for (const auto& node : graph_.Nodes()) {
+    if (executed_nodes.count(node.Index()) == 0) {
+      early_exits->remaining_nodes.insert(node.Index());
+    }
+  }
+
+  early_exits_ = std::move(early_exits);
+  return Status::OK();
+}
 
 Status SessionState::CreateSubgraphSessionState() {
   for (auto& node : graph_.Nodes()) {
@@ -1184,10 +1567,64 @@ Status SessionState::FinalizeSessionState(const std::basic_string<PATH_CHAR_TYPE
   ORT_RETURN_IF_ERROR(VerifyEachNodeIsAssignedToAnEp(graph_, logger_, execution_providers_));
   ORT_RETURN_IF_ERROR(PopulateKernelCreateInfo(kernel_registry_manager, saving_ort_format));
 
+  const std::string prepacked_weights_file =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigPrepackedWeightsCacheFile, "");
+  if (!prepacked_weights_file.empty() &&
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisablePrepacking, "0") != "1") {
+    prepacked_weights_file_cache_ = std::make_unique<PrepackedWeightsFileCache>(ToPathString(prepacked_weights_file));
+    Status status = prepacked_weights_file_cache_->Load();
+    if (!status.IsOK()) {
+      // a corrupt file only costs us the pre-packing time, it gets rewritten with freshly pre-packed weights
+      LOGS(logger_, WARNING) << "Ignoring the pre-packed weights file: " << status.ErrorMessage();
+    }
+  }
+
   InlinedHashMap<std::string, size_t> constant_initializers_use_count;
   ComputeConstantInitializerUseCount(graph_, constant_initializers_use_count);
-  return FinalizeSessionStateImpl(graph_location, kernel_registry_manager, nullptr, sess_options_,
-                                  remove_initializers, constant_initializers_use_count);
+  ORT_RETURN_IF_ERROR(FinalizeSessionStateImpl(graph_location, kernel_registry_manager, nullptr, sess_options_,
+                                               remove_initializers, constant_initializers_use_count));
+
+  const std::string sampled_profiling_rate_str = sess_options_.config_options.GetConfigOrDefault(
+      kOrtSessionOptionsConfigSampledProfilingRate, "0");
+  uint32_t sampled_profiling_rate = 0;
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale<uint32_t>(sampled_profiling_rate_str, sampled_profiling_rate),
+                    "Invalid value for ", kOrtSessionOptionsConfigSampledProfilingRate, ": ",
+                    sampled_profiling_rate_str);
+  if (sampled_profiling_rate > 0) {
+    sampled_profiler_ = std::make_unique<profiling::SampledProfiler>(*graph_viewer_, sampled_profiling_rate);
+  }
+
+  const std::string parallelism_samples_str = sess_options_.config_options.GetConfigOrDefault(
+      kOrtSessionOptionsConfigIntraOpAdaptiveParallelismSamples, "0");
+  uint32_t parallelism_samples = 0;
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale<uint32_t>(parallelism_samples_str, parallelism_samples),
+                    "Invalid value for ", kOrtSessionOptionsConfigIntraOpAdaptiveParallelismSamples, ": ",
+                    parallelism_samples_str);
+  const int max_degree_of_parallelism = concurrency::ThreadPool::MaxParallelThreads(GetThreadPool());
+  if (parallelism_samples > 0 && max_degree_of_parallelism > 1) {
+    parallelism_tuner_ = std::make_unique<ParallelismTuner>(*graph_viewer_, max_degree_of_parallelism,
+                                                            parallelism_samples);
+  }
+
+  if (sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCollectTensorStatistics, "0") == "1") {
+    const std::string histogram_bins_str = sess_options_.config_options.GetConfigOrDefault(
+        kOrtSessionOptionsConfigTensorStatisticsHistogramBins, "2048");
+    size_t histogram_bins = 0;
+    ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale<size_t>(histogram_bins_str, histogram_bins) &&
+                          histogram_bins > 0 && histogram_bins % 2 == 0,
+                      "Invalid value for ", kOrtSessionOptionsConfigTensorStatisticsHistogramBins, ": ",
+                      histogram_bins_str);
+    tensor_statistics_collector_ = std::make_unique<TensorStatisticsCollector>(*graph_viewer_, histogram_bins);
+  }
+
+  if (prepacked_weights_file_cache_) {
+    Status status = prepacked_weights_file_cache_->Save();
+    if (!status.IsOK()) {
+      LOGS(logger_, WARNING) << "Unable to save the pre-packed weights file: " << status.ErrorMessage();
+    }
+  }
+
+  return Status::OK();
 }
 
 static Status Index(const OrtValueNameIdxMap& ort_value_name_idx_map,
@@ -1315,6 +1752,255 @@ static void AccumulateAllNestedSubgraphsInfo(
   }
 }
 
+#if !defined(ORT_MINIMAL_BUILD)
+Status SessionState::SaveExecutionPlanToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
+                                                  flatbuffers::Offset<fbs::ExecutionPlan>& fbs_execution_plan) const {
+  ORT_RETURN_IF_NOT(p_seq_exec_plan_.has_value(), "The session state has not been finalized.");
+  const auto& plan = *p_seq_exec_plan_;
+
+  // the synchronization steps between streams depend on the stream handles of the EPs, and the streamed weights
+  // on the device memory available when the session is created.
+  if (plan.execution_plan.size() > 1 || !plan.streamed_weights.empty()) {
+    LOGS(logger_, INFO) << "The execution plan is not saved as it has multiple logic streams or streamed weights.";
+    return Status::OK();
+  }
+
+  std::vector<uint32_t> node_execution_order;
+  std::vector<flatbuffers::Offset<flatbuffers::String>> node_execution_providers;
+  if (!plan.execution_plan.empty()) {
+    const auto& steps = plan.execution_plan[0]->steps_;
+    // a single stream may still wait on the stream of an EP
+    if (steps.size() != static_cast<size_t>(graph_viewer_->NumberOfNodes())) {
+      LOGS(logger_, INFO) << "The execution plan is not saved as it has other steps than kernel launches.";
+      return Status::OK();
+    }
+
+    node_execution_order.reserve(steps.size());
+    node_execution_providers.reserve(steps.size());
+    for (const auto& step : steps) {
+      const NodeIndex node_index = step->GetNodeIndex();
+      node_execution_order.push_back(gsl::narrow<uint32_t>(node_index));
+      node_execution_providers.push_back(
+          builder.CreateSharedString(graph_viewer_->GetNode(node_index)->GetExecutionProviderType()));
+    }
+  }
+
+  const size_t num_values = plan.allocation_plan.size();
+  ORT_RETURN_IF_NOT(num_values == static_cast<size_t>(ort_value_name_idx_map_.MaxIdx() + 1),
+                    "The allocation plan doesn't match the OrtValue indices.");
+
+  std::vector<flatbuffers::Offset<flatbuffers::String>> value_names;
+  std::vector<flatbuffers::Offset<fbs::ValueAllocationPlan>> value_allocation_plans;
+  value_names.reserve(num_values);
+  value_allocation_plans.reserve(num_values);
+  for (size_t idx = 0; idx < num_values; ++idx) {
+    std::string name;
+    ORT_RETURN_IF_ERROR(ort_value_name_idx_map_.GetName(static_cast<int>(idx), name));
+    value_names.push_back(builder.CreateString(name));
+
+    const auto& value_plan = plan.allocation_plan[idx];
+    bool is_strided_tensor = false;
+#ifdef ENABLE_STRIDED_TENSORS
+    is_strided_tensor = value_plan.is_strided_tensor;
+#endif
+    value_allocation_plans.push_back(fbs::CreateValueAllocationPlan(
+        builder, static_cast<int8_t>(value_plan.alloc_kind), value_plan.reused_buffer,
+        value_plan.location.Type(), value_plan.location.MemType(), value_plan.location.Id(),
+        is_strided_tensor, value_plan.is_view));
+  }
+
+  std::vector<uint32_t> release_value_indices;
+  std::vector<uint32_t> release_ref_counts;
+  release_value_indices.reserve(plan.release_actions.size());
+  release_ref_counts.reserve(plan.release_actions.size());
+  for (const auto& release_action : plan.release_actions) {
+    release_value_indices.push_back(gsl::narrow<uint32_t>(release_action.value_index));
+    release_ref_counts.push_back(gsl::narrow<uint32_t>(release_action.ref_count));
+  }
+
+  std::vector<flatbuffers::Offset<fbs::NodeReleaseList>> node_release_lists;
+  for (size_t node_index = 0; node_index < plan.node_release_list.size(); ++node_index) {
+    const auto& release_list = plan.node_release_list[node_index];
+    if (release_list.empty()) {
+      continue;
+    }
+
+    std::vector<uint32_t> release_actions;
+    release_actions.reserve(release_list.size());
+    for (const auto release_action_idx : release_list) {
+      release_actions.push_back(gsl::narrow<uint32_t>(release_action_idx));
+    }
+
+    node_release_lists.push_back(
+        fbs::CreateNodeReleaseListDirect(builder, gsl::narrow<uint32_t>(node_index), &release_actions));
+  }
+
+  fbs_execution_plan = fbs::CreateExecutionPlanDirect(builder,
+                                                      static_cast<int8_t>(sess_options_.execution_order),
+                                                      sess_options_.enable_mem_reuse,
+                                                      &value_names,
+                                                      &node_execution_order,
+                                                      &node_execution_providers,
+                                                      &value_allocation_plans,
+                                                      &release_value_indices,
+                                                      &release_ref_counts,
+                                                      &node_release_lists);
+  return Status::OK();
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+Status SessionState::LoadExecutionPlanFromOrtFormat(const fbs::ExecutionPlan& fbs_execution_plan,
+                                                    const SessionOptions& session_options) {
+#if defined(ENABLE_TRAINING_CORE) || (!defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE))
+  // the training and memory profiling data of the plan is not saved
+  ORT_UNUSED_PARAMETER(fbs_execution_plan);
+  ORT_UNUSED_PARAMETER(session_options);
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                         "Saved execution plans are not used in training or memory profiling builds.");
+#else
+  ORT_RETURN_IF(session_options.execution_mode != ExecutionMode::ORT_SEQUENTIAL,
+                "The session uses the parallel execution mode.");
+  ORT_RETURN_IF(!session_options.config_options.GetConfigOrDefault(kNodePartitionConfigFile, "").empty(),
+                "The session has a node partition config file.");
+  ORT_RETURN_IF(fbs_execution_plan.execution_order() != static_cast<int8_t>(session_options.execution_order) ||
+                    fbs_execution_plan.enable_mem_reuse() != session_options.enable_mem_reuse,
+                "The plan was created with other planner options.");
+
+  const auto* fbs_value_names = fbs_execution_plan.value_names();
+  const auto* fbs_value_plans = fbs_execution_plan.value_allocation_plans();
+  const size_t num_values = static_cast<size_t>(ort_value_name_idx_map_.MaxIdx() + 1);
+  ORT_RETURN_IF(fbs_value_names == nullptr || fbs_value_plans == nullptr ||
+                    fbs_value_names->size() != num_values || fbs_value_plans->size() != num_values,
+                "The plan has ", fbs_value_names ? fbs_value_names->size() : 0, " values, the graph has ",
+                num_values, ".");
+
+  const auto* fbs_node_order = fbs_execution_plan.node_execution_order();
+  const auto* fbs_node_eps = fbs_execution_plan.node_execution_providers();
+  const size_t num_nodes = static_cast<size_t>(graph_viewer_->NumberOfNodes());
+  ORT_RETURN_IF(fbs_node_order == nullptr || fbs_node_eps == nullptr ||
+                    fbs_node_order->size() != num_nodes || fbs_node_eps->size() != num_nodes,
+                "The plan has ", fbs_node_order ? fbs_node_order->size() : 0, " nodes, the graph has ",
+                num_nodes, ".");
+
+  auto& plan = p_seq_exec_plan_.emplace();
+
+  plan.allocation_plan.resize(num_values);
+  for (size_t idx = 0; idx < num_values; ++idx) {
+    std::string name;
+    ORT_RETURN_IF_ERROR(ort_value_name_idx_map_.GetName(static_cast<int>(idx), name));
+    ORT_RETURN_IF(fbs_value_names->Get(static_cast<flatbuffers::uoffset_t>(idx))->str() != name,
+                  "The OrtValue index of ", name, " doesn't match.");
+
+    const auto* fbs_value_plan = fbs_value_plans->Get(static_cast<flatbuffers::uoffset_t>(idx));
+    const auto alloc_kind = fbs_value_plan->alloc_kind();
+    ORT_RETURN_IF(alloc_kind < static_cast<int8_t>(AllocKind::kNotSet) ||
+                      alloc_kind > static_cast<int8_t>(AllocKind::kAllocatedExternally),
+                  "Invalid allocation kind ", static_cast<int>(alloc_kind), " for ", name);
+    ORT_RETURN_IF(fbs_value_plan->reused_buffer() < 0 ||
+                      static_cast<size_t>(fbs_value_plan->reused_buffer()) >= num_values,
+                  "Invalid reused buffer for ", name);
+
+    auto& value_plan = plan.allocation_plan[idx];
+    value_plan.alloc_kind = static_cast<AllocKind>(alloc_kind);
+    value_plan.reused_buffer = fbs_value_plan->reused_buffer();
+    value_plan.location = OrtDevice(fbs_value_plan->device_type(), fbs_value_plan->device_mem_type(),
+                                    fbs_value_plan->device_id());
+#ifdef ENABLE_STRIDED_TENSORS
+    value_plan.is_strided_tensor = fbs_value_plan->is_strided_tensor();
+#else
+    ORT_RETURN_IF(fbs_value_plan->is_strided_tensor(), "Strided tensors are not enabled in this build.");
+#endif
+    value_plan.is_view = fbs_value_plan->is_view();
+
+    if (const auto* node_arg = graph_viewer_->GetNodeArg(name); node_arg != nullptr) {
+      value_plan.value_type = utils::GetMLDataType(*node_arg);
+    }
+
+    // the devices of the session may differ from the devices of the session that saved the plan
+    const bool allocates = value_plan.alloc_kind == AllocKind::kAllocate ||
+                           value_plan.alloc_kind == AllocKind::kAllocateStatically ||
+                           value_plan.alloc_kind == AllocKind::kAllocateOutput;
+    ORT_RETURN_IF(allocates && GetAllocator(value_plan.location) == nullptr,
+                  "There is no allocator for the location of ", name, ": ", value_plan.location.ToString());
+  }
+
+  const size_t node_list_size = SafeInt<size_t>(graph_viewer_->MaxNodeIndex()) + 1;
+  plan.node_stream_map_.resize(node_list_size);
+
+  if (num_nodes > 0) {
+    const auto* first_node = graph_viewer_->GetNode(fbs_node_order->Get(0));
+    const auto* first_ep = first_node ? execution_providers_.Get(first_node->GetExecutionProviderType()) : nullptr;
+    ORT_RETURN_IF(first_ep == nullptr, "The first node of the plan is not assigned to an execution provider.");
+    plan.execution_plan.emplace_back(
+        std::make_unique<SequentialExecutionPlan::LogicStream>(first_ep->GetOrtDeviceByMemType(OrtMemTypeDefault)));
+
+    auto& steps = plan.execution_plan[0]->steps_;
+    steps.reserve(num_nodes);
+    InlinedHashSet<NodeIndex> executed_nodes;
+    executed_nodes.reserve(num_nodes);
+    for (flatbuffers::uoffset_t i = 0; i < fbs_node_order->size(); ++i) {
+      const NodeIndex node_index = fbs_node_order->Get(i);
+      const Node* node = node_index < node_list_size ? graph_viewer_->GetNode(node_index) : nullptr;
+      ORT_RETURN_IF(node == nullptr || executed_nodes.count(node_index) > 0, "Invalid node index ", node_index);
+      ORT_RETURN_IF(fbs_node_eps->Get(i)->str() != node->GetExecutionProviderType(), "The node ", node->Name(),
+                    " is assigned to ", node->GetExecutionProviderType(), ".");
+
+      // the saved order must still be a topological order
+      for (auto it = node->InputNodesBegin(), end = node->InputNodesEnd(); it != end; ++it) {
+        ORT_RETURN_IF(executed_nodes.count(it->Index()) == 0, "The node ", node->Name(),
+                      " runs before its input node ", it->Name());
+      }
+
+      executed_nodes.insert(node_index);
+
+#if defined(ORT_MINIMAL_BUILD)
+      steps.emplace_back(std::make_unique<LaunchKernelStep>(node_index));
+#else
+      steps.emplace_back(std::make_unique<LaunchKernelStep>(node_index, node->Name()));
+#endif
+
+      for (const auto* output : node->OutputDefs()) {
+        if (output->Exists()) {
+          int output_idx = -1;
+          ORT_RETURN_IF_ERROR(ort_value_name_idx_map_.GetIdx(output->Name(), output_idx));
+          plan.value_to_stream_map[output_idx] = 0;
+        }
+      }
+    }
+  }
+
+  const auto* fbs_release_value_indices = fbs_execution_plan.release_value_indices();
+  const auto* fbs_release_ref_counts = fbs_execution_plan.release_ref_counts();
+  const size_t num_release_actions = fbs_release_value_indices ? fbs_release_value_indices->size() : 0;
+  ORT_RETURN_IF((fbs_release_ref_counts ? fbs_release_ref_counts->size() : 0) != num_release_actions,
+                "The release actions are incomplete.");
+
+  plan.release_actions.reserve(num_release_actions);
+  for (flatbuffers::uoffset_t i = 0; i < num_release_actions; ++i) {
+    const size_t value_index = fbs_release_value_indices->Get(i);
+    ORT_RETURN_IF(value_index >= num_values, "Invalid value index ", value_index, " in the release actions.");
+    plan.release_actions.push_back(SequentialExecutionPlan::ReleaseAction{value_index, fbs_release_ref_counts->Get(i)});
+  }
+
+  plan.node_release_list.resize(node_list_size);
+  if (const auto* fbs_node_release_lists = fbs_execution_plan.node_release_lists()) {
+    for (const auto* fbs_node_release_list : *fbs_node_release_lists) {
+      const size_t node_index = fbs_node_release_list->node_index();
+      ORT_RETURN_IF(node_index >= node_list_size, "Invalid node index ", node_index, " in the release lists.");
+      if (const auto* fbs_release_actions = fbs_node_release_list->release_actions()) {
+        auto& release_list = plan.node_release_list[node_index];
+        for (const auto release_action_idx : *fbs_release_actions) {
+          ORT_RETURN_IF(release_action_idx >= num_release_actions, "Invalid release action ", release_action_idx);
+          release_list.push_back(release_action_idx);
+        }
+      }
+    }
+  }
+
+  return Status::OK();
+#endif
+}
+
 Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_TYPE>& graph_location,
                                               const KernelRegistryManager& kernel_registry_manager,
                                               _In_opt_ const Node* parent_node,
@@ -1376,9 +2062,22 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   SubgraphsKernelCreateInfoMaps subgraphs_kernel_create_info_maps;
   AccumulateAllNestedSubgraphsInfo(*this, "", 0, subgraphs_kernel_create_info_maps);
 
+  // the critical path partitioner spreads the CPU nodes over as many streams as there are inter-op threads
+  size_t critical_path_cpu_streams = 0;
+  if (session_options.execution_mode == ExecutionMode::ORT_PARALLEL &&
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCriticalPathPartition, "0") == "1") {
+    critical_path_cpu_streams =
+        static_cast<size_t>(concurrency::ThreadPool::DegreeOfParallelism(inter_op_thread_pool_));
+  }
+
   SequentialPlannerContext context(session_options.execution_mode,
                                    session_options.execution_order,
-                                   session_options.enable_mem_reuse);
+                                   session_options.enable_mem_reuse,
+                                   session_options.config_options.GetConfigOrDefault(
+                                       kOrtSessionOptionsConfigUseDedicatedCopyStream, "0") == "1",
+                                   critical_path_cpu_streams,
+                                   session_options.config_options.GetConfigOrDefault(
+                                       kOrtSessionOptionsConfigUseDedicatedCollectiveStream, "0") == "1");
 
 #ifdef _WIN32
 
@@ -1394,24 +2093,43 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
 
 #endif
 
-  auto status = SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
-                                              execution_providers_, kernel_create_info_map_,
-                                              subgraphs_kernel_create_info_maps,
-                                              outer_scope_node_arg_to_location_map,
-                                              ort_value_name_idx_map_, context,
+  // use the plan saved in the ORT format model if it matches the main graph and the session
+  bool loaded_saved_plan = false;
+  if (parent_node == nullptr && saved_execution_plan_ != nullptr) {
+    auto status = LoadExecutionPlanFromOrtFormat(*saved_execution_plan_, session_options);
+    saved_execution_plan_ = nullptr;
+    if (status.IsOK()) {
+      loaded_saved_plan = true;
+    } else {
+      LOGS(logger_, INFO) << "Creating the execution plan as the saved plan can't be used: " << status.ErrorMessage();
+    }
+  }
+
+  if (!loaded_saved_plan) {
+    auto status = SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
+                                                execution_providers_, kernel_create_info_map_,
+                                                subgraphs_kernel_create_info_maps,
+                                                outer_scope_node_arg_to_location_map,
+                                                ort_value_name_idx_map_, context,
 #ifdef ORT_ENABLE_STREAM
-                                              GetStreamHandleRegistryInstance(),
+                                                GetStreamHandleRegistryInstance(),
 #endif
-                                              partition_config_file,
-                                              Logger(),
-                                              p_seq_exec_plan_);
-  ORT_RETURN_IF_ERROR(status);
+                                                partition_config_file,
+                                                Logger(),
+                                                p_seq_exec_plan_);
+    ORT_RETURN_IF_ERROR(status);
+  }
 
   // Record the allocation plan
 
   // Uncomment the below to dump the allocation plan to std::cout
   // std::cout << std::make_pair(&*p_seq_exec_plan_, this);
 
+  if (parent_node == nullptr &&
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigEnableWeightStreaming, "0") == "1") {
+    ORT_RETURN_IF_ERROR(PlanWeightStreaming(session_options));
+  }
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   GetMemoryProfiler()->Init(GetExecutionPlan(), GetOrtValueNameIdxMap());
 #endif
@@ -1473,20 +2191,28 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   }
 #endif
 
+  InlinedHashSet<OrtValueIndex> streamed_weights;
+  for (const auto& streamed_weight : p_seq_exec_plan_->streamed_weights) {
+    streamed_weights.insert(streamed_weight.value_index);
+  }
+
   ORT_RETURN_IF_ERROR(
       session_state_utils::SaveInitializedTensors(
           Env::Default(), graph_location, *graph_viewer_,
           GetAllocator(OrtDevice()),
           ort_value_name_idx_map_, initializer_allocation_order, *tensor_allocator,
-          [this, remove_initializers](const std::string& name, int idx, const OrtValue& value, const OrtCallback& d,
-                                      bool constant, bool sparse) -> Status {
+          [this, remove_initializers, &streamed_weights](const std::string& name, int idx, const OrtValue& value,
+                                                         const OrtCallback& d, bool constant, bool sparse) -> Status {
+            // a streamed weight is only on the device while its consumers run, so kernels must not use it
+            // as a constant input
+            constant = constant && streamed_weights.find(idx) == streamed_weights.end();
             ORT_RETURN_IF_ERROR(AddInitializedTensor(idx, value, &d, constant, sparse));
             if (remove_initializers) {
               graph_.RemoveInitializedTensor(name);
             }
             return Status::OK();
           },
-          logger_, data_transfer_mgr_, *p_seq_exec_plan_, session_options, memory_profile_func));
+          logger_, data_transfer_mgr_, *p_seq_exec_plan_, session_options, memory_profile_func, thread_pool_));
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Record Weight allocation info on device
@@ -1503,8 +2229,15 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
 
   if (!disable_prepacking) {
-    ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
-                                                          session_options.initializers_to_share_map));
+    if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigLazyPrepacking, "0") == "1") {
+      // the constant initializers are pre-packed by EnsureNodePrePacked the first time the kernel of a node runs.
+      // they are kept as other kernels may still need them unpacked.
+      lazy_prepacking_ = true;
+      lazily_prepacked_nodes_ = std::make_unique<std::atomic<bool>[]>(graph_viewer_->MaxNodeIndex());
+    } else {
+      ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
+                                                            session_options.initializers_to_share_map));
+    }
   }
 
   ORT_RETURN_IF_ERROR(
@@ -1563,6 +2296,119 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   return Status::OK();
 }
 
+Status SessionState::PlanWeightStreaming(const SessionOptions& session_options) {
+  const std::string prefetch_distance_str = session_options.config_options.GetConfigOrDefault(
+      kOrtSessionOptionsConfigWeightStreamingPrefetchDistance, "16");
+  size_t prefetch_distance = 0;
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale<size_t>(prefetch_distance_str, prefetch_distance),
+                    "Invalid weight streaming prefetch distance: ", prefetch_distance_str);
+
+  auto& plan = *p_seq_exec_plan_;
+
+  // the nodes of each logic stream in execution order
+  InlinedVector<InlinedVector<NodeIndex>> stream_nodes(plan.execution_plan.size());
+  for (NodeIndex node_index : graph_viewer_->GetNodesInTopologicalOrder(session_options.execution_order)) {
+    stream_nodes[plan.node_stream_map_[node_index]].push_back(node_index);
+  }
+
+  struct Consumers {
+    size_t stream_idx{0};
+    size_t first{std::numeric_limits<size_t>::max()};  // position in stream_nodes[stream_idx]
+    size_t last{0};
+    bool streamable{true};
+  };
+  InlinedHashSet<std::string_view> graph_outputs;
+  for (const NodeArg* output : graph_viewer_->GetOutputs()) {
+    graph_outputs.insert(output->Name());
+  }
+
+  InlinedHashMap<OrtValueIndex, Consumers> candidates;
+  for (const auto& [name, tensor_proto] : graph_viewer_->GetAllInitializedTensors()) {
+    ORT_UNUSED_PARAMETER(tensor_proto);
+    int idx;
+    ORT_RETURN_IF_ERROR(ort_value_name_idx_map_.GetIdx(name, idx));
+    // initializers that can be overridden by a feed or that are graph outputs can't be streamed
+    if (plan.GetLocation(idx).Type() == OrtDevice::CPU || !graph_viewer_->IsConstantInitializer(name, false) ||
+        graph_outputs.find(name) != graph_outputs.end()) {
+      continue;
+    }
+    candidates.emplace(idx, Consumers{});
+  }
+
+  for (size_t stream_idx = 0; stream_idx < stream_nodes.size(); ++stream_idx) {
+    for (size_t pos = 0; pos < stream_nodes[stream_idx].size(); ++pos) {
+      const Node& node = *graph_viewer_->GetNode(stream_nodes[stream_idx][pos]);
+      auto record_consumer = [&](const NodeArg& arg, bool implicit) {
+        int idx;
+        if (!arg.Exists() || !ort_value_name_idx_map_.GetIdx(arg.Name(), idx).IsOK()) {
+          return;
+        }
+        auto it = candidates.find(idx);
+        if (it == candidates.end()) {
+          return;
+        }
+        auto& consumers = it->second;
+        if (consumers.first == std::numeric_limits<size_t>::max()) {
+          consumers.stream_idx = stream_idx;
+          consumers.first = pos;
+        }
+        // a weight used by a subgraph, or by several logic streams, has no single point it can be freed at
+        consumers.streamable = consumers.streamable && !implicit && consumers.stream_idx == stream_idx;
+        consumers.last = pos;
+      };
+      for (const NodeArg* arg : node.InputDefs()) {
+        record_consumer(*arg, false);
+      }
+      for (const NodeArg* arg : node.ImplicitInputDefs()) {
+        record_consumer(*arg, true);
+      }
+    }
+  }
+
+  for (const auto& [idx, consumers] : candidates) {
+    if (!consumers.streamable || consumers.first == std::numeric_limits<size_t>::max()) {
+      continue;
+    }
+
+    const auto& nodes = stream_nodes[consumers.stream_idx];
+    const Node& first_consumer = *graph_viewer_->GetNode(nodes[consumers.first]);
+    const IExecutionProvider* ep = execution_providers_.Get(first_consumer);
+    ORT_RETURN_IF_NOT(ep != nullptr, "No execution provider for node ", first_consumer.Name());
+    OrtDevice host_device = ep->GetOrtDeviceByMemType(OrtMemTypeCPUInput);
+    if (host_device.Type() != OrtDevice::CPU || GetAllocator(host_device) == nullptr) {
+      host_device = OrtDevice();
+    }
+
+    const size_t weight = plan.streamed_weights.size();
+    plan.streamed_weights.push_back({idx, plan.GetLocation(idx)});
+    const size_t prefetch_pos = consumers.first > prefetch_distance ? consumers.first - prefetch_distance : 0;
+    plan.node_weight_prefetch_list[nodes[prefetch_pos]].push_back(weight);
+    plan.node_weight_release_list[nodes[consumers.last]].push_back(weight);
+    plan.SetLocation(idx, host_device);
+  }
+
+  LOGS(logger_, INFO) << "Weight streaming: " << plan.streamed_weights.size() << " of " << candidates.size()
+                      << " device initializers are streamed from host memory.";
+  return Status::OK();
+}
+
+std::unique_ptr<StreamExecutionContext::Buffers> SessionState::AcquireExecutionContextBuffers() const {
+  {
+    std::lock_guard<onnxruntime::OrtMutex> lock(execution_context_buffers_pool_mutex_);
+    if (!execution_context_buffers_pool_.empty()) {
+      auto buffers = std::move(execution_context_buffers_pool_.back());
+      execution_context_buffers_pool_.pop_back();
+      return buffers;
+    }
+  }
+  return std::make_unique<StreamExecutionContext::Buffers>(*this);
+}
+
+void SessionState::RecycleExecutionContextBuffers(std::unique_ptr<StreamExecutionContext::Buffers> buffers) const {
+  std::lock_guard<onnxruntime::OrtMutex> lock(execution_context_buffers_pool_mutex_);
+  execution_context_buffers_pool_.push_back(std::move(buffers));
+}
+
 #ifdef ORT_ENABLE_STREAM
 static void BindToDeviceStream(const SequentialExecutionPlan& execution_plan,
                                DeviceStreamCollection& device_stream_map,
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <list>
 #include <memory>
 #include <map>
 #include <unordered_map>
@@ -24,6 +26,7 @@
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/prepacked_weights_file_cache.h"
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
@@ -31,6 +34,9 @@
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/parallelism_tuner.h"
+#include "core/framework/sampled_profiler.h"
+#include "core/framework/tensor_statistics_collector.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/onnx_protobuf.h"
 #include "core/platform/ort_mutex.h"
@@ -48,6 +54,7 @@
 namespace onnxruntime {
 
 namespace fbs {
+struct ExecutionPlan;
 struct SessionState;
 }  // namespace fbs
 
@@ -62,6 +69,30 @@ class DeviceStreamCollection;
 class MemoryInfo;
 #endif
 
+// Thread pools that replace the ones a SessionState was created with, for the Runs of a session sharing the
+// SessionState of another session. See InferenceSession::Clone.
+struct ThreadPoolBinding {
+  concurrency::ThreadPool* intra_op_thread_pool{};
+  concurrency::ThreadPool* inter_op_thread_pool{};
+};
+
+// Makes `binding` the thread pools of all the session states used in the current thread for the lifetime of the
+// object. nullptr uses the thread pools the session states were created with.
+class ThreadPoolBindingScope {
+ public:
+  explicit ThreadPoolBindingScope(const ThreadPoolBinding* binding);
+  ~ThreadPoolBindingScope();
+
+  ThreadPoolBindingScope(const ThreadPoolBindingScope&) = delete;
+  ThreadPoolBindingScope& operator=(const ThreadPoolBindingScope&) = delete;
+
+  // Returns the thread pools bound in the current thread, nullptr if there are none.
+  static const ThreadPoolBinding* Current();
+
+ private:
+  const ThreadPoolBinding* previous_binding_;
+};
+
 /**
  * SessionState should be modified by the inference session class only.
  * It is supposed to be passed by const-ref only to all the executors.
@@ -203,6 +234,21 @@ class SessionState {
   */
   profiling::Profiler& Profiler() const noexcept { return profiler_; }
 
+  /**
+  Get the sampling profiler of the main graph, see kOrtSessionOptionsConfigSampledProfilingRate.
+  Returns nullptr if sampled profiling is disabled or this is a subgraph session state.
+  */
+  profiling::SampledProfiler* GetSampledProfiler() const noexcept { return sampled_profiler_.get(); }
+
+  // the learner of the intra-op parallelism of the nodes, nullptr unless
+  // kOrtSessionOptionsConfigIntraOpAdaptiveParallelismSamples is set or if this is a subgraph session state
+  ParallelismTuner* GetParallelismTuner() const noexcept { return parallelism_tuner_.get(); }
+
+  // the collector of calibration statistics, nullptr unless kOrtSessionOptionsConfigCollectTensorStatistics is set
+  TensorStatisticsCollector* GetTensorStatisticsCollector() const noexcept {
+    return tensor_statistics_collector_.get();
+  }
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   MemoryProfiler* GetMemoryProfiler() const noexcept { return memory_profiler_; }
 
@@ -233,6 +279,30 @@ class SessionState {
   Status UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
                                        MemoryPatternGroup mem_patterns) const;
 
+  /**
+  Get the memory pattern of the shape bucket of the input shapes, see kOrtSessionOptionsConfigMemoryPatternBucketCacheSize.
+  The pattern may have been generated for larger shapes than the inputs in the same bucket so the blocks of the
+  pattern are upper bounds of the sizes of the tensors. Returns nullptr if the bucket has no pattern yet.
+  Must be called only when all values contain tensors.
+  */
+  std::shared_ptr<const MemoryPatternGroup> GetBucketedMemoryPatternGroup(gsl::span<const OrtValue> tensor_inputs) const;
+
+  /**
+  Set the memory pattern of the shape bucket of the input shapes, replacing the existing one,
+  and evict the least recently used bucket if the cache is full.
+  */
+  void UpdateBucketedMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
+                                             MemoryPatternGroup mem_patterns) const;
+
+  // Returns true if the memory patterns are cached per shape bucket instead of per exact input shapes.
+  bool IsMemoryPatternShapeBucketingEnabled() const { return mem_pattern_bucket_cache_size_ > 0; }
+
+  /**
+  Get the allocator for the memory pattern buffer of a run on the given device. This is the slab pool of the device
+  if kOrtSessionOptionsConfigMemoryPatternSlabPoolSize is set, else the device allocator.
+  */
+  AllocatorPtr GetMemoryPatternAllocator(const OrtDevice& device) const;
+
   bool GetUseDeterministicCompute() const { return sess_options_.use_deterministic_compute; }
 
   /**
@@ -287,8 +357,14 @@ class SessionState {
   /// Return SessionState for the given Node index and attribute name if found.
   const SessionState* GetSubgraphSessionState(NodeIndex index, const std::string& attribute_name) const;
 
-  concurrency::ThreadPool* GetThreadPool() const noexcept { return thread_pool_; }
-  concurrency::ThreadPool* GetInterOpThreadPool() const noexcept { return inter_op_thread_pool_; }
+  concurrency::ThreadPool* GetThreadPool() const noexcept {
+    const ThreadPoolBinding* binding = ThreadPoolBindingScope::Current();
+    return binding != nullptr ? binding->intra_op_thread_pool : thread_pool_;
+  }
+  concurrency::ThreadPool* GetInterOpThreadPool() const noexcept {
+    const ThreadPoolBinding* binding = ThreadPoolBindingScope::Current();
+    return binding != nullptr ? binding->inter_op_thread_pool : inter_op_thread_pool_;
+  }
 
   const FuncManager& GetFuncMgr() const noexcept { return fused_funcs_mgr_; }
   FuncManager& GetMutableFuncMgr() noexcept { return fused_funcs_mgr_; }
@@ -298,16 +374,60 @@ class SessionState {
   InlinedVector<BufferUniquePtr>& GetMutableWeightsBuffers() noexcept { return weights_buffers_; }
 
   const NodeIndexInfo& GetNodeIndexInfo() const;
-#ifdef ENABLE_TRAINING
-  void UpdateToBeExecutedRange(gsl::span<int const> fetch_mlvalue_idxs);
-  const InlinedHashSet<NodeIndex>* GetToBeExecutedRange(gsl::span<int const> fetch_mlvalue_idxs) const;
-#endif
+
+  // Computes and caches the nodes the given fetches depend on, unless they were computed for a previous Run.
+  // Nodes producing a feed, i.e. an intermediate value provided by the caller, and the nodes only they depend on
+  // are excluded. Thread safe.
+  void UpdateToBeExecutedRange(gsl::span<int const> fetch_mlvalue_idxs,
+                               gsl::span<int const> feed_mlvalue_idxs = {}) const;
+  // Returns the nodes the given fetches depend on, or nullptr if UpdateToBeExecutedRange wasn't called for them.
+  // The returned set stays valid for the lifetime of the session state.
+  const InlinedHashSet<NodeIndex>* GetToBeExecutedRange(gsl::span<int const> fetch_mlvalue_idxs,
+                                                        gsl::span<int const> feed_mlvalue_idxs = {}) const;
+
+  // An exit point of a cascade, see kOrtSessionOptionsConfigEarlyExitPoints.
+  struct EarlyExitPoint {
+    // The nodes executed before the predicate is checked, excluding the nodes of the previous exit points.
+    InlinedHashSet<NodeIndex> nodes;
+    // A boolean value with one element. The exit point is taken if it is true.
+    int predicate_idx = -1;
+    // The values returned in place of the graph outputs, in the order of EarlyExits::graph_output_idxs.
+    InlinedVector<int> output_idxs;
+  };
+
+  struct EarlyExits {
+    std::vector<EarlyExitPoint> exit_points;
+    // The nodes executed when no exit point is taken.
+    InlinedHashSet<NodeIndex> remaining_nodes;
+    InlinedVector<int> graph_output_idxs;
+  };
+
+  // Sets the exit points of the cascade, in the order they are checked. Each exit point is a predicate value and the
+  // values it returns in place of graph_outputs.
+  Status SetEarlyExits(gsl::span<const std::pair<std::string, std::vector<std::string>>> exit_points,
+                       gsl::span<const std::string> graph_outputs);
+  // Returns nullptr if no exit points were set.
+  const EarlyExits* GetEarlyExits() const { return early_exits_.get(); }
 
   Status FinalizeSessionState(const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
                               const KernelRegistryManager& kernel_registry_manager,
                               bool remove_initializers = true,
                               bool saving_ort_format = false);
 
+  // Set the execution plan saved in an ORT format model, which is used instead of creating the plan of the main graph
+  // in FinalizeSessionState if it matches the graph, the execution providers and the planner options.
+  // `fbs_execution_plan` must stay valid until FinalizeSessionState returns.
+  void SetSavedExecutionPlan(const fbs::ExecutionPlan* fbs_execution_plan) {
+    saved_execution_plan_ = fbs_execution_plan;
+  }
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // Save the execution plan of the main graph. `fbs_execution_plan` is left unset if the plan can't be reused by
+  // another session, i.e. it has multiple logic streams or streamed weights.
+  Status SaveExecutionPlanToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
+                                      flatbuffers::Offset<fbs::ExecutionPlan>& fbs_execution_plan) const;
+#endif
+
   SessionState* Parent() {
     return parent_;
   }
@@ -316,6 +436,15 @@ class SessionState {
   // The function logs the list of removable attributes for every node.
   void PruneRemovableAttributes();
 
+  // Pre-packs the constant initializers of a node if pre-packing is deferred to the first execution of its kernel,
+  // see kOrtSessionOptionsConfigLazyPrepacking. Safe to call from concurrent Runs.
+  Status EnsureNodePrePacked(NodeIndex node_index) const;
+
+  // Materializes the constant initializers ahead of their first use: completes the deferred pre-packing of all nodes
+  // and touches the pages of the constant initializers in CPU memory, recursing into the subgraphs.
+  // Returns early once `stop` is set.
+  Status PrefaultConstantInitializers(const std::atomic<bool>& stop) const;
+
   size_t GetNumberOfPrepacksCounter() const {
     return number_of_prepacks_counter_;
   }
@@ -324,6 +453,10 @@ class SessionState {
     return used_shared_pre_packed_weights_counter_;
   }
 
+  size_t GetUsedFileCachedPrePackedWeightCounter() const {
+    return used_file_cached_pre_packed_weights_counter_;
+  }
+
   const KernelCreateInfoMap& GetKernelCreateInfoMap() const {
     return kernel_create_info_map_;
   }
@@ -332,6 +465,11 @@ class SessionState {
     return subgraph_session_states_;
   }
 
+  // Get the per-Run buffers of a StreamExecutionContext, reusing the ones of a finished Run when available.
+  std::unique_ptr<StreamExecutionContext::Buffers> AcquireExecutionContextBuffers() const;
+
+  void RecycleExecutionContextBuffers(std::unique_ptr<StreamExecutionContext::Buffers> buffers) const;
+
 #ifdef ORT_ENABLE_STREAM
   std::unique_ptr<DeviceStreamCollection> AcquireDeviceStreamCollection() const;
 
@@ -355,6 +493,11 @@ class SessionState {
 
   const SessionOptions& GetSessionOptions() const { return sess_options_; }
 
+  // The session options read by every Run, parsed once so the Run path doesn't look them up.
+  // See kOrtSessionOptionsConfigIntraOpRunParallelSection and kOrtSessionOptionsConfigStageFeedsInPinnedMemory.
+  bool IsIntraOpRunParallelSectionEnabled() const { return intra_op_run_parallel_section_; }
+  bool ShouldStageFeedsInPinnedMemory() const { return stage_feeds_in_pinned_memory_; }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionState);
 
@@ -375,16 +518,43 @@ class SessionState {
   Status PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
                                            const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map);
 
+  // A constant initialized tensor that was pre-packed for a kernel input, and the session state that owns it.
+  struct PrePackedInitializer {
+    SessionState* owner;
+    int ort_value_idx;
+    std::string name;
+  };
+
+  // Prepack the constant initialized tensors consumed by a node. If packed_initializers is given, the constant
+  // initialized tensors that were pre-packed are appended to it so the caller can release the ones that are not used
+  // unpacked anymore. Doesn't modify the initialized tensors, so nodes can be pre-packed concurrently as long as
+  // no pre-packed weights container or file cache is in use.
+  Status PrepackNodeConstantInitializedTensors(
+      const Node& node, InlinedVector<PrePackedInitializer>* packed_initializers,
+      const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+      bool should_cache_prepacked_weights_for_shared_initializers);
+
+  // Selects the weights to stream from host memory and when to copy and free them, and moves their planned
+  // location to host memory. See kOrtSessionOptionsConfigEnableWeightStreaming.
+  Status PlanWeightStreaming(const SessionOptions& session_options);
+
   SessionState* GetMutableSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name);
 
   Status CreateSubgraphSessionState();
 
+  // Returns the pre-packed weights file cache of the root session state or nullptr if it isn't enabled.
+  PrepackedWeightsFileCache* GetPrepackedWeightsFileCache();
+
   void AddSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name,
                                std::unique_ptr<SessionState> session_state);
 
   Status PopulateKernelCreateInfo(const KernelRegistryManager& kernel_registry_manager,
                                   bool saving_ort_format);
 
+  // Create p_seq_exec_plan_ from saved_execution_plan_. Returns an error if the saved plan doesn't match.
+  Status LoadExecutionPlanFromOrtFormat(const fbs::ExecutionPlan& fbs_execution_plan,
+                                        const SessionOptions& session_options);
+
   Status FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
                                   const KernelRegistryManager& kernel_registry_manager,
                                   _In_opt_ const Node* parent_node,
@@ -408,6 +578,11 @@ class SessionState {
   // fused_funcs_mgr_ must live longer than the session_kernels_, becaues a kernel could be created from this manager
   FuncManager fused_funcs_mgr_;
 
+  // File backed cache of pre-packed weights. Only set in the root session state, and shared with the subgraph session
+  // states. It must live longer than the session_kernels_ (and the subgraph session states) as kernels restored from
+  // the cache point into its file mapping.
+  std::unique_ptr<PrepackedWeightsFileCache> prepacked_weights_file_cache_;
+
   // cache of the constructed kernels to avoid spending construction time per executor
   std::vector<std::unique_ptr<OpKernel>> session_kernels_;
   Graph& graph_;
@@ -473,9 +648,14 @@ class SessionState {
   InlinedHashMap<int, OrtCallback> deleter_for_initialized_tensors_;
   InlinedVector<BufferUniquePtr> weights_buffers_;
   std::optional<SequentialExecutionPlan> p_seq_exec_plan_;
+  // execution plan saved in the ORT format model, only valid during FinalizeSessionState
+  const fbs::ExecutionPlan* saved_execution_plan_{nullptr};
 
   const logging::Logger& logger_;
   profiling::Profiler& profiler_;
+  std::unique_ptr<profiling::SampledProfiler> sampled_profiler_;
+  std::unique_ptr<ParallelismTuner> parallelism_tuner_;
+  std::unique_ptr<TensorStatisticsCollector> tensor_statistics_collector_;
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   MemoryProfiler* memory_profiler_;
@@ -497,6 +677,22 @@ class SessionState {
   NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
 #endif
 
+  bool intra_op_run_parallel_section_ = false;
+  bool stage_feeds_in_pinned_memory_ = false;
+
+  // maximum number of entries of bucketed_mem_patterns_lru_. 0 if the memory patterns are not bucketed.
+  size_t mem_pattern_bucket_cache_size_ = 0;
+  // LRU cache of the memory patterns per shape bucket, most recently used first. Guarded by mem_patterns_lock_.
+  // The patterns are shared with the execution frames using them as an entry can be replaced or evicted during a run.
+  using BucketedMemoryPatternList = std::list<std::pair<int64_t, std::shared_ptr<const MemoryPatternGroup>>>;
+  mutable BucketedMemoryPatternList bucketed_mem_patterns_lru_;
+  mutable InlinedHashMap<int64_t, BucketedMemoryPatternList::iterator> bucketed_mem_patterns_;
+
+  // maximum number of idle buffers in each of mem_pattern_slab_pools_. 0 if the buffers are not pooled.
+  size_t mem_pattern_slab_pool_size_ = 0;
+  // slab pools of the memory pattern buffers per device, created on first use. Guarded by mem_patterns_lock_.
+  mutable InlinedHashMap<OrtDevice, AllocatorPtr> mem_pattern_slab_pools_;
+
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
 
@@ -518,15 +714,17 @@ class SessionState {
   // prepacked_weights_container_ can be nullptr if no caching is required for prepacked weights
   PrepackedWeightsContainer* const prepacked_weights_container_{};
 
-#ifdef ENABLE_TRAINING
-// Needed for ORTTrainer. Should be removed along with ORTTrainer code
+  // The nodes to execute for each set of fetch and feed indices, see UpdateToBeExecutedRange. Entries are never removed, and the sets must not move
+  // as the executor holds pointers to them.
+  mutable OrtMutex to_be_executed_nodes_mutex_;
 #ifndef DISABLE_ABSEIL
-  InlinedHashMap<InlinedVector<int>, InlinedHashSet<NodeIndex>> to_be_executed_nodes_;
+  mutable NodeHashMap<InlinedVector<int>, InlinedHashSet<NodeIndex>> to_be_executed_nodes_;
 #else
-  std::map<InlinedVector<int>, InlinedHashSet<NodeIndex>> to_be_executed_nodes_;
-#endif
+  mutable std::map<InlinedVector<int>, InlinedHashSet<NodeIndex>> to_be_executed_nodes_;
 #endif
 
+  std::unique_ptr<EarlyExits> early_exits_;
+
   SessionState* parent_ = nullptr;
   // Assign each graph in each session an unique id.
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
@@ -540,19 +738,34 @@ class SessionState {
   }
 #endif
 
+  // Whether the constant initializers are pre-packed the first time the kernel of a node runs.
+  bool lazy_prepacking_ = false;
+  // Flag per node index, set once the constant initializers of the node have been pre-packed lazily.
+  std::unique_ptr<std::atomic<bool>[]> lazily_prepacked_nodes_;
+  // Serializes lazy pre-packing, only used on the root session state.
+  mutable OrtMutex lazy_prepacking_mutex_;
+
   // Counter for number of times pre-packing of weights was performed across kernels
-  // part the model
-  size_t number_of_prepacks_counter_ = 0;
+  // part the model. Atomic as nodes may be pre-packed concurrently.
+  std::atomic<size_t> number_of_prepacks_counter_{0};
 
   // Counter for number of times a shared version of the pre-packed weight corresponding to
   // a constant initialized weight was used by the session state
   size_t used_shared_pre_packed_weights_counter_ = 0;
 
+  // Counter for number of times a pre-packed weight was restored from the pre-packed weights file cache
+  // instead of invoking PrePack() on the kernel
+  size_t used_file_cached_pre_packed_weights_counter_ = 0;
+
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
   // Counter for number of times the session graph has been executed
   size_t graph_executions_counter_ = 0;
 #endif
 
+  // lock for the execution context buffers pool
+  mutable OrtMutex execution_context_buffers_pool_mutex_;
+  mutable std::vector<std::unique_ptr<StreamExecutionContext::Buffers>> execution_context_buffers_pool_;
+
 #ifdef ORT_ENABLE_STREAM
   std::unique_ptr<IStreamCommandHandleRegistry> stream_handles_registry_;
 
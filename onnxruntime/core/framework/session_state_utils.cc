@@ -1,9 +1,13 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <atomic>
 #include <functional>
 #include <limits>
+#include <optional>
 #include <utility>
+#include <vector>
 
 #include <core/common/status.h>
 
@@ -12,6 +16,7 @@
 #include "core/framework/session_state_utils.h"
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
 #include "core/graph/graph_viewer.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/graph_partitioner.h"
@@ -26,6 +31,7 @@
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/framework/mem_buffer.h"
 #include "core/framework/tensor_allocator.h"
+#include "core/platform/threadpool.h"
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 #include "core/framework/memory_info.h"
 #endif
@@ -83,6 +89,21 @@ static inline common::Status ExtDataTensorProtoToTensor(const Env& env,
   return common::Status::OK();
 }
 
+// given a tensor proto with external data return an OrtValue whose tensor aliases the mapped external data
+// without allocating a buffer for it
+static common::Status ExtDataTensorProtoToOrtValue(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& proto_path,
+                                                   const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                                   OrtValue& ort_value) {
+  auto p_tensor = std::make_unique<Tensor>();
+  OrtCallback ext_data_deleter;
+  ORT_RETURN_IF_ERROR(ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, *p_tensor, ext_data_deleter));
+
+  ExtDataValueDeleter deleter{ext_data_deleter, p_tensor.get()};
+  MLDataType ml_tensor_type = DataTypeImpl::GetType<Tensor>();
+  ort_value.Init(p_tensor.release(), ml_tensor_type, deleter);
+  return common::Status::OK();
+}
+
 static common::Status DeserializeTensorProto(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& proto_path,
                                              const ONNX_NAMESPACE::TensorProto& tensor_proto, const MemBuffer* m,
                                              const AllocatorPtr& alloc, const AllocatorPtr& default_cpu_alloc,
@@ -122,14 +143,7 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
       // NB: The file containing external data for the tensor is mmap'd. If the tensor will be used on CPU we can
       // utilize the mmap'd buffer directly by calling ExtDataTensorProtoToTensor. If we called
       // TensorProtoToTensor it would copy the data, causing unnecessary overhead
-      OrtCallback ext_data_deleter;
-      ORT_RETURN_IF_ERROR(ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, *p_tensor, ext_data_deleter));
-
-      ExtDataValueDeleter deleter{ext_data_deleter, p_tensor.get()};
-
-      MLDataType ml_tensor_type = DataTypeImpl::GetType<Tensor>();
-      ort_value.Init(p_tensor.release(), ml_tensor_type, deleter);
-      return common::Status::OK();
+      return ExtDataTensorProtoToOrtValue(env, proto_path, tensor_proto, ort_value);
     }
     ORT_RETURN_IF_ERROR(utils::TensorProtoToTensor(env, proto_path.c_str(), tensor_proto, *p_tensor));
   } else {  // non-cpu tensor
@@ -187,7 +201,8 @@ common::Status SaveInitializedTensors(
     const logging::Logger& logger, const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
-    const MemoryProfileFunction& memory_profile_func) {
+    const MemoryProfileFunction& memory_profile_func,
+    concurrency::ThreadPool* thread_pool) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -220,6 +235,13 @@ common::Status SaveInitializedTensors(
     return retval;
   };
 
+  // Initializers with external data that are used on CPU alias the memory mapped external data file, so kernels
+  // read them straight from the mapped pages. They are neither traced by the planner nor allocated.
+  auto use_mapped_external_data =
+      [&exec_plan](int ort_value_index, const ONNX_NAMESPACE::TensorProto& tensor_proto) -> bool {
+    return utils::HasExternalData(tensor_proto) && exec_plan.GetLocation(ort_value_index).Type() == OrtDevice::CPU;
+  };
+
   // 1. first plan the memory
   const InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
   InlinedHashMap<int, const ONNX_NAMESPACE::TensorProto*> id_to_initialized_tensor;
@@ -246,7 +268,7 @@ common::Status SaveInitializedTensors(
     const auto entry = initialized_tensors_to_allocate.find(ort_value_index);
     ORT_ENFORCE(entry != initialized_tensors_to_allocate.end(),
                 "OrtValue index: ", ort_value_index, " from initializer_allocation_order not found among initialized tensors");
-    if (!(utils::HasExternalData(*entry->second) && exec_plan.GetLocation(ort_value_index).Type() == OrtDevice::CPU)) {
+    if (!use_mapped_external_data(ort_value_index, *entry->second)) {
       // can not trace string tensor
       ORT_ENFORCE(entry->second->data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING, "Can not trace string tensor");
       ORT_RETURN_IF_ERROR(planner.Trace(entry->first, entry->second));
@@ -263,6 +285,9 @@ common::Status SaveInitializedTensors(
       // do not trace string tensor
       continue;
     }
+    if (use_mapped_external_data(entry.first, *entry.second)) {
+      continue;
+    }
     ORT_RETURN_IF_ERROR(planner.Trace(entry.first, entry.second));
   }
   // 2. allocate weight buffer on different locations
@@ -283,6 +308,20 @@ common::Status SaveInitializedTensors(
   OrtCallback deleter{nullptr, nullptr};
 
   // 3. create weight tensors based on weights buffer
+  const bool use_device_allocator_for_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+
+  struct InitializerToCreate {
+    int ort_value_index;
+    const ONNX_NAMESPACE::TensorProto* tensor_proto;
+    std::optional<MemBuffer> m;
+    AllocatorPtr alloc;
+    OrtValue ort_value;
+  };
+
+  // the planner is not thread safe, so look up the preallocated buffers before deserializing anything
+  std::vector<InitializerToCreate> initializers_to_create;
+  initializers_to_create.reserve(id_to_initialized_tensor.size());
   for (const auto& entry : id_to_initialized_tensor) {
     int ort_value_index = entry.first;
     const std::string& name = entry.second->name();
@@ -292,31 +331,66 @@ common::Status SaveInitializedTensors(
       continue;
     }
 
-    OrtValue ort_value;
+    InitializerToCreate& initializer = initializers_to_create.emplace_back();
+    initializer.ort_value_index = ort_value_index;
+    initializer.tensor_proto = entry.second;
 
-    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
-      ort_value = *(session_options.initializers_to_share_map.at(name));
+    if (user_supplied_initializer_ids.find(ort_value_index) == user_supplied_initializer_ids.end() &&
+        !use_mapped_external_data(ort_value_index, *entry.second)) {
+      // TODO: if the tensor need be copied, does it have enough room?
+      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, initializer.m, initializer.alloc));
+    }
+  }
+
+  auto create_initializer = [&](InitializerToCreate& initializer) -> Status {
+    const std::string& name = initializer.tensor_proto->name();
+    Status st;
+    if (user_supplied_initializer_ids.find(initializer.ort_value_index) != user_supplied_initializer_ids.end()) {
+      initializer.ort_value = *(session_options.initializers_to_share_map.at(name));
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
+    } else if (use_mapped_external_data(initializer.ort_value_index, *initializer.tensor_proto)) {
+      st = ExtDataTensorProtoToOrtValue(env, graph_loc, *initializer.tensor_proto, initializer.ort_value);
     } else {
-      const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
+      st = DeserializeTensorProto(env, graph_loc, *initializer.tensor_proto,
+                                  initializer.m.has_value() ? &*initializer.m : nullptr, initializer.alloc,
+                                  default_cpu_alloc, initializer.ort_value, data_transfer_mgr,
+                                  use_device_allocator_for_initializers);
+    }
 
-      std::optional<MemBuffer> m;
-      AllocatorPtr alloc;
-      // TODO: if the tensor need be copied, does it have enough room?
-      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, m, alloc));
-      bool use_device_allocator_for_initializers =
-          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
-
-      Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, (m.has_value()) ? &*m : nullptr, alloc,
-                                         default_cpu_alloc, ort_value, data_transfer_mgr,
-                                         use_device_allocator_for_initializers);
-      if (!st.IsOK()) {
-        std::ostringstream oss;
-        oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
-        return Status(st.Category(), st.Code(), oss.str());
-      }
+    if (!st.IsOK()) {
+      std::ostringstream oss;
+      oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
+      return Status(st.Category(), st.Code(), oss.str());
     }
 
+    return Status::OK();
+  };
+
+  // Initializers planned on CPU are independent of each other and can be deserialized concurrently. The ones on
+  // other devices are copied by the data transfer of their execution provider, which may depend on the device
+  // bound to the calling thread, so they are created on this thread.
+  int max_concurrency = 1;
+  ORT_RETURN_IF_ERROR(GetInitializerLoadConcurrency(session_options, thread_pool, max_concurrency));
+
+  InlinedVector<size_t> concurrent_initializers;
+  for (size_t i = 0; i < initializers_to_create.size(); ++i) {
+    if (max_concurrency > 1 &&
+        exec_plan.GetLocation(initializers_to_create[i].ort_value_index).Type() == OrtDevice::CPU) {
+      concurrent_initializers.push_back(i);
+    } else {
+      ORT_RETURN_IF_ERROR(create_initializer(initializers_to_create[i]));
+    }
+  }
+
+  ORT_RETURN_IF_ERROR(RunConcurrently(thread_pool, max_concurrency, concurrent_initializers.size(),
+                                      [&](size_t i) -> Status {
+                                        return create_initializer(initializers_to_create[concurrent_initializers[i]]);
+                                      }));
+
+  for (auto& initializer : initializers_to_create) {
+    int ort_value_index = initializer.ort_value_index;
+    const std::string& name = initializer.tensor_proto->name();
+
     // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
     // so we need to output this message prior to calling save_tensor_func
     VLOGS(logger, 1) << "Adding weight with name : " << name << " with index: " << ort_value_index;
@@ -326,16 +400,67 @@ common::Status SaveInitializedTensors(
     const bool constant = graph.IsConstantInitializer(name, /* check_outer_scope */ false);
 #if !defined(DISABLE_SPARSE_TENSORS)
     const bool sparse = graph.GetGraph().IsSparseInitializer(name);
-    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, ort_value, deleter, constant, sparse));
+    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, initializer.ort_value, deleter, constant, sparse));
 #else
-    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, ort_value, deleter, constant, false));
+    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, initializer.ort_value, deleter, constant, false));
 #endif
+    // the session state holds the value now
+    initializer.ort_value = OrtValue();
   }
 
   LOGS(logger, INFO) << "Done saving initialized tensors";
   return common::Status::OK();
 }
 
+common::Status GetInitializerLoadConcurrency(const SessionOptions& session_options,
+                                             const concurrency::ThreadPool* thread_pool, int& max_concurrency) {
+  const std::string value =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigInitializerLoadConcurrency, "1");
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(value, max_concurrency) && max_concurrency >= 0,
+                    "Invalid value for ", kOrtSessionOptionsConfigInitializerLoadConcurrency, ": ", value);
+
+  const int degree_of_parallelism = concurrency::ThreadPool::DegreeOfParallelism(thread_pool);
+  if (max_concurrency == 0 || max_concurrency > degree_of_parallelism) {
+    max_concurrency = degree_of_parallelism;
+  }
+
+  return Status::OK();
+}
+
+common::Status RunConcurrently(concurrency::ThreadPool* thread_pool, int max_concurrency, size_t count,
+                               const std::function<common::Status(size_t)>& fn) {
+  if (max_concurrency <= 1 || count <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      ORT_RETURN_IF_ERROR(fn(i));
+    }
+    return Status::OK();
+  }
+
+  // each worker claims the next unprocessed index, so at most max_concurrency items are in flight and large items
+  // don't hold back the rest
+  std::vector<Status> statuses(count);
+  std::atomic<size_t> next_index{0};
+  const auto num_workers = static_cast<std::ptrdiff_t>(std::min(static_cast<size_t>(max_concurrency), count));
+  concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, num_workers, [&](std::ptrdiff_t) {
+    for (size_t i = next_index++; i < count; i = next_index++) {
+      ORT_TRY {
+        statuses[i] = fn(i);
+      }
+      ORT_CATCH(const std::exception& ex) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+        });
+      }
+    }
+  });
+
+  for (auto& status : statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  return Status::OK();
+}
+
 template <typename T>  // T is container of const NodeArg* or NodeArg*
 static bool IsArgNameInInputsOutputs(const std::string& name,
                                      const T& graph_args) {
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <functional>
 #include <map>
 
 #include "core/common/const_pointer_container.h"
@@ -21,6 +22,9 @@ class GraphViewer;
 class OrtValueNameIdxMap;
 class DataTransferManager;
 class NodeArg;
+namespace concurrency {
+class ThreadPool;
+}
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 class MemoryInfo;
 #endif
@@ -44,7 +48,24 @@ common::Status SaveInitializedTensors(
     const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
-    const MemoryProfileFunction& memory_profile_func);
+    const MemoryProfileFunction& memory_profile_func,
+    concurrency::ThreadPool* thread_pool = nullptr);
+
+/**
+ * Get the maximum number of initializers that may be deserialized or pre-packed concurrently during session
+ * initialization, from the kOrtSessionOptionsConfigInitializerLoadConcurrency session option.
+ * A value of 1 means initializers are processed one after another.
+ */
+common::Status GetInitializerLoadConcurrency(const SessionOptions& session_options,
+                                             const concurrency::ThreadPool* thread_pool, int& max_concurrency);
+
+/**
+ * Run fn for each index in [0, count) on at most max_concurrency threads of thread_pool.
+ * Exceptions thrown by fn are converted to a failed status. If several indices fail, the status of the lowest
+ * failing index is returned so the result doesn't depend on scheduling.
+ */
+common::Status RunConcurrently(concurrency::ThreadPool* thread_pool, int max_concurrency, size_t count,
+                               const std::function<common::Status(size_t)>& fn);
 
 common::Status SaveInputOutputNamesToNodeMapping(const GraphViewer& graph,
                                                  SessionState& session_state,
@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_initializer_cache.h"
+
+#include <cstring>
+#include <limits>
+
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensorprotoutils.h"
+
+namespace onnxruntime {
+
+SharedInitializerCache::SharedInitializerCache() : allocator_(std::make_shared<CPUAllocator>()) {
+}
+
+Status SharedInitializerCache::GetOrCreate(const Env& env, const std::filesystem::path& model_path,
+                                           const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                           std::shared_ptr<const OrtValue>& value) {
+  auto new_value = std::make_shared<OrtValue>();
+  ORT_RETURN_IF_ERROR(utils::TensorProtoToOrtValue(env, model_path, tensor_proto, allocator_, *new_value));
+
+  const Tensor& tensor = new_value->Get<Tensor>();
+  ORT_RETURN_IF(tensor.IsDataTypeString(), "String initializer ", tensor_proto.name(), " can not be shared.");
+  ORT_RETURN_IF(tensor.SizeInBytes() > static_cast<size_t>(std::numeric_limits<int>::max()),
+                "Initializer ", tensor_proto.name(), " is too large to be shared.");
+
+  uint32_t hash[4] = {0, 0, 0, 0};
+  MurmurHash3::x86_128(tensor.DataRaw(), static_cast<int>(tensor.SizeInBytes()),
+                       static_cast<uint32_t>(tensor_proto.data_type()), hash);
+  const uint64_t key = (static_cast<uint64_t>(hash[0]) << 32) | hash[1];
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+
+  auto range = tensors_.equal_range(key);
+  for (auto it = range.first; it != range.second;) {
+    auto cached_value = it->second.lock();
+    if (cached_value == nullptr) {
+      it = tensors_.erase(it);
+      continue;
+    }
+
+    const Tensor& cached_tensor = cached_value->Get<Tensor>();
+    if (cached_tensor.DataType() == tensor.DataType() && cached_tensor.Shape() == tensor.Shape() &&
+        std::memcmp(cached_tensor.DataRaw(), tensor.DataRaw(), tensor.SizeInBytes()) == 0) {
+      value = std::move(cached_value);
+      return Status::OK();
+    }
+    ++it;
+  }
+
+  tensors_.emplace(key, new_value);
+  value = std::move(new_value);
+  return Status::OK();
+}
+
+size_t SharedInitializerCache::GetNumberOfElements() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+
+  for (auto it = tensors_.begin(); it != tensors_.end();) {
+    if (it->second.expired()) {
+      it = tensors_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  return tensors_.size();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/platform/ort_mutex.h"
+
+namespace ONNX_NAMESPACE {
+class TensorProto;
+}
+
+namespace onnxruntime {
+
+class Env;
+
+// Deduplicates initializers by content across the sessions of an environment.
+// The cache only holds weak references to the tensors it hands out: a tensor stays alive as long as a session
+// holds the returned value, and is released with the last of them.
+class SharedInitializerCache final {
+ public:
+  SharedInitializerCache();
+
+  ~SharedInitializerCache() = default;
+
+  // Deserializes `tensor_proto` into a CPU tensor. If a live tensor with the same data type, shape and data is
+  // already cached, it is returned instead and the new copy is discarded.
+  // String tensors and tensors larger than 2GB are not supported.
+  Status GetOrCreate(const Env& env, const std::filesystem::path& model_path,
+                     const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                     std::shared_ptr<const OrtValue>& value);
+
+  // Returns the number of cached tensors that are still in use.
+  size_t GetNumberOfElements();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SharedInitializerCache);
+
+ private:
+  AllocatorPtr allocator_;
+
+  OrtMutex mutex_;
+
+  // Maps the hash of the tensor data to the tensors with that hash.
+  std::unordered_multimap<uint64_t, std::weak_ptr<const OrtValue>> tensors_;
+};
+
+}  // namespace onnxruntime
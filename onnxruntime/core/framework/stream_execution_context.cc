@@ -8,6 +8,28 @@
 #include "core/common/spin_pause.h"
 
 namespace onnxruntime {
+StreamExecutionContext::Buffers::Buffers(const SessionState& sess_state) {
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning(disable : 26409 26400)
+#endif
+  std::atomic_int* p_release_plan_buffer = new std::atomic_int[sess_state.GetExecutionPlan()->release_actions.size()];
+  release_plan = std::unique_ptr<std::atomic_int[]>(p_release_plan_buffer);
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+#ifdef ORT_ENABLE_STREAM
+  count_down_barriers = std::vector<CountDownBarrier>(sess_state.GetExecutionPlan()->num_barriers);
+#endif
+}
+
+StreamExecutionContext::BuffersHolder::BuffersHolder(const SessionState& sess_state)
+    : session_state_(sess_state), p_(sess_state.AcquireExecutionContextBuffers()) {}
+
+StreamExecutionContext::BuffersHolder::~BuffersHolder() {
+  session_state_.RecycleExecutionContextBuffers(std::move(p_));
+}
+
 #ifdef ORT_ENABLE_STREAM
 StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
                                                int32_t num_streams,
@@ -22,17 +44,19 @@ StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
                                                const logging::Logger& sess_logger,
                                                bool single_thread_mode)
     : session_state_(&sess_state),
+      buffers_(sess_state),
       frame_(feed_mlvalue_idxs,
              feeds,
              fetch_mlvalue_idxs,
              fetches,
              fetch_allocators,
              device_stream_map,
-             sess_state),
+             sess_state,
+             &buffers_.p_->values),
       logger_(&sess_logger),
       single_thread_mode_(single_thread_mode),
-      device_stream_map_(device_stream_map),
-      count_down_barriers_(num_barriers) {
+      thread_pool_binding_(ThreadPoolBindingScope::Current()),
+      device_stream_map_(device_stream_map) {
   notifications_.reserve(notification_owners.size());
   for (size_t i = 0; i < notification_owners.size(); ++i) {
     auto* stream = device_stream_map_ ? device_stream_map_->GetStream(notification_owners[i]) : nullptr;
@@ -41,33 +65,27 @@ StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
     else
       notifications_.push_back(nullptr);
   }
-#ifdef _WIN32
-#pragma warning(push)
-#pragma warning(disable : 26409 26400)
-#endif
-  std::atomic_int* p_release_plan_buffer = new std::atomic_int[sess_state.GetExecutionPlan()->release_actions.size()];
-  release_plan_ = std::unique_ptr<std::atomic_int[]>(p_release_plan_buffer);
-#ifdef _WIN32
-#pragma warning(pop)
-#endif
-
   // init barriers
+  auto& count_down_barriers = buffers_.p_->count_down_barriers;
+  if (count_down_barriers.size() != num_barriers) {
+    count_down_barriers = std::vector<CountDownBarrier>(num_barriers);
+  }
   for (size_t i = 0; i < num_barriers; ++i) {
-    count_down_barriers_[i].Set(2);
+    count_down_barriers[i].Set(2);
   }
   // init remain task to number of streams
   remain_tasks_.Set(num_streams);
   // generate release plan (the ref counts)
   auto& release_actions = sess_state.GetExecutionPlan()->release_actions;
   for (size_t i = 0; i < release_actions.size(); ++i) {
-    release_plan_[i] = static_cast<int>(release_actions[i].ref_count);
+    buffers_.p_->release_plan[i] = static_cast<int>(release_actions[i].ref_count);
   }
 }
 
 synchronize::Notification* StreamExecutionContext ::GetNotification(size_t idx) { return notifications_[idx].get(); }
 
 bool StreamExecutionContext ::DecCountDownBarrier(size_t barrier_id) {
-  return count_down_barriers_[barrier_id].Dec();
+  return buffers_.p_->count_down_barriers[barrier_id].Dec();
 }
 
 Stream* StreamExecutionContext ::GetDeviceStream(size_t idx) {
@@ -90,29 +108,23 @@ StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
                                                const logging::Logger& sess_logger,
                                                bool single_thread_mode)
     : session_state_(&sess_state),
+      buffers_(sess_state),
       frame_(feed_mlvalue_idxs,
              feeds,
              fetch_mlvalue_idxs,
              fetches,
              fetch_allocators,
-             sess_state),
+             sess_state,
+             &buffers_.p_->values),
       logger_(&sess_logger),
-      single_thread_mode_(single_thread_mode) {
-#ifdef _WIN32
-#pragma warning(push)
-#pragma warning(disable : 26409 26400)
-#endif
-  std::atomic_int* p_release_plan_buffer = new std::atomic_int[sess_state.GetExecutionPlan()->release_actions.size()];
-  release_plan_ = std::unique_ptr<std::atomic_int[]>(p_release_plan_buffer);
-#ifdef _WIN32
-#pragma warning(pop)
-#endif
+      single_thread_mode_(single_thread_mode),
+      thread_pool_binding_(ThreadPoolBindingScope::Current()) {
   // init remain task to number of streams
   remain_tasks_.Set(num_streams);
   // generate release plan (the ref counts)
   auto& release_actions = sess_state.GetExecutionPlan()->release_actions;
   for (size_t i = 0; i < release_actions.size(); ++i) {
-    release_plan_[i] = static_cast<int>(release_actions[i].ref_count);
+    buffers_.p_->release_plan[i] = static_cast<int>(release_actions[i].ref_count);
   }
 }
 
@@ -166,13 +178,43 @@ StreamExecutionContext::~StreamExecutionContext() {}
 void StreamExecutionContext::RecycleNodeInputs(onnxruntime::NodeIndex node_index) {
   auto* execution_plan = session_state_->GetExecutionPlan();
   for (auto idx : execution_plan->node_release_list[node_index]) {
-    if (--release_plan_[idx] == 0) {
+    if (--buffers_.p_->release_plan[idx] == 0) {
       ORT_ENFORCE(frame_.ReleaseMLValue(static_cast<int>(execution_plan->release_actions[idx].value_index)).IsOK());
       VLOGS(*logger_, 0) << "ort value " << execution_plan->release_actions[idx].value_index << " released";
     }
   }
 }
 
+Status StreamExecutionContext::PrefetchStreamedWeights(onnxruntime::NodeIndex node_index, size_t stream_idx) {
+  auto* execution_plan = session_state_->GetExecutionPlan();
+  if (execution_plan->streamed_weights.empty()) {
+    return Status::OK();
+  }
+  auto it = execution_plan->node_weight_prefetch_list.find(node_index);
+  if (it != execution_plan->node_weight_prefetch_list.end()) {
+    Stream* stream = GetDeviceStream(stream_idx);
+    for (size_t weight : it->second) {
+      const auto& streamed_weight = execution_plan->streamed_weights[weight];
+      ORT_RETURN_IF_ERROR(frame_.CopyStreamedWeightToDevice(streamed_weight.value_index, streamed_weight.device,
+                                                            stream));
+    }
+  }
+  return Status::OK();
+}
+
+void StreamExecutionContext::ReleaseStreamedWeights(onnxruntime::NodeIndex node_index) {
+  auto* execution_plan = session_state_->GetExecutionPlan();
+  if (execution_plan->streamed_weights.empty()) {
+    return;
+  }
+  auto it = execution_plan->node_weight_release_list.find(node_index);
+  if (it != execution_plan->node_weight_release_list.end()) {
+    for (size_t weight : it->second) {
+      frame_.ReleaseStreamedWeight(execution_plan->streamed_weights[weight].value_index);
+    }
+  }
+}
+
 void RunSince(size_t stream_idx, StreamExecutionContext& ctx, SessionScope& session_scope, const bool& terminate_flag, size_t since) {
   if (!ctx.TaskStatus().IsOK()) {
     // already in bad status, terminate it
@@ -180,6 +222,9 @@ void RunSince(size_t stream_idx, StreamExecutionContext& ctx, SessionScope& sess
     return;
   }
 
+  // the stream may run in the inter-op thread pool, which doesn't have the thread pools of the session bound
+  ThreadPoolBindingScope thread_pool_binding_scope(ctx.GetThreadPoolBinding());
+
 #ifdef USE_CANN
   // Leave it to CANN EP to fill the gap if they want to use run_options
   static onnxruntime::RunOptions run_options;
@@ -16,6 +16,7 @@
 
 namespace onnxruntime {
 class SessionState;
+struct ThreadPoolBinding;
 
 class SessionScope;
 typedef InlinedHashMap<std::string, OrtValue> OrtValueCache;
@@ -58,6 +59,20 @@ class StreamExecutionContext {
     std::atomic_int_fast32_t v_;
   };
 
+  // The per-Run buffers of the context whose sizes only depend on the session.
+  // SessionState pools the buffers of finished Runs so later Runs reset them instead of allocating them again.
+  struct Buffers {
+    explicit Buffers(const SessionState& sess_state);
+
+    // storage of the execution frame's values
+    InlinedVector<OrtValue> values;
+    // ref counts of the release actions in the execution plan
+    std::unique_ptr<std::atomic_int[]> release_plan;
+#ifdef ORT_ENABLE_STREAM
+    std::vector<CountDownBarrier> count_down_barriers;
+#endif
+  };
+
   StreamExecutionContext(const SessionState& sess_state,
                          int32_t num_streams,
 #ifdef ORT_ENABLE_STREAM
@@ -116,6 +131,13 @@ class StreamExecutionContext {
   // Release the OrtValues after a step, based on the execution plan.
   void RecycleNodeInputs(onnxruntime::NodeIndex node_index);
 
+  // Weight streaming: issue the copies of the streamed weights the execution plan prefetches before the node,
+  // on the device stream of the node's logic stream.
+  Status PrefetchStreamedWeights(onnxruntime::NodeIndex node_index, size_t stream_idx);
+
+  // Weight streaming: free the streamed weights whose last consumer is the node.
+  void ReleaseStreamedWeights(onnxruntime::NodeIndex node_index);
+
 #ifdef ENABLE_TRAINING
   void SetOrtValueCache(OrtValueCachePtr cache) {
     cache_ = std::move(cache);
@@ -136,7 +158,9 @@ class StreamExecutionContext {
   void SetCurrentRange(const ProgramRegion* range) {
     program_range_ = range;
   }
+#endif
 
+  // The nodes to execute, or nullptr to execute all of them.
   const InlinedHashSet<NodeIndex>* GetNodeToExecute() {
     return node_to_execute_;
   }
@@ -145,17 +169,32 @@ class StreamExecutionContext {
     node_to_execute_ = node_to_execute;
   }
 
-#endif
+  // The thread pools bound by the session starting the Run, see ThreadPoolBindingScope. The streams scheduled on the
+  // inter-op thread pool bind them again.
+  const ThreadPoolBinding* GetThreadPoolBinding() const {
+    return thread_pool_binding_;
+  }
 
  private:
+  // Acquires the buffers from the session state and recycles them once the context is destroyed.
+  // Declared before frame_ so the frame, which uses the value storage, is destroyed first.
+  struct BuffersHolder {
+    explicit BuffersHolder(const SessionState& sess_state);
+    ~BuffersHolder();
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(BuffersHolder);
+
+    const SessionState& session_state_;
+    std::unique_ptr<Buffers> p_;
+  };
+
   const SessionState* session_state_;
 
+  BuffersHolder buffers_;
+
   ExecutionFrame frame_;
 
   const logging::Logger* logger_;
 
-  std::unique_ptr<std::atomic_int[]> release_plan_;
-
   CountDownBarrier remain_tasks_;
 
   Status task_status_{Status::OK()};
@@ -164,19 +203,18 @@ class StreamExecutionContext {
   const ProgramRegion* program_range_{nullptr};
 
   OrtValueCachePtr cache_{nullptr};
+#endif
 
-  // TODO: this is mainly for ort trainer
-  // Should we deprecate it?
+  // Set when only the nodes producing the fetches are executed, see SessionState::GetToBeExecutedRange.
   const InlinedHashSet<NodeIndex>* node_to_execute_{nullptr};
-#endif
   const bool single_thread_mode_;
+  // captured in the thread that starts the Run
+  const ThreadPoolBinding* const thread_pool_binding_;
 
 #ifdef ORT_ENABLE_STREAM
   InlinedVector<std::unique_ptr<synchronize::Notification>> notifications_;
   // if it is nullptr, means current session doesn't have any EP using stream feature
   const DeviceStreamCollection* device_stream_map_;
-
-  std::vector<CountDownBarrier> count_down_barriers_;
 #endif
 };
 
@@ -0,0 +1,210 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/tensor_statistics_collector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+
+#include "core/framework/op_kernel_context.h"
+#include "core/framework/tensor.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+namespace {
+
+bool IsFloatTensor(const NodeArg& node_arg) {
+  const auto* type = node_arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_FLOAT;
+}
+
+// escapes a JSON string value
+std::string EscapeJsonString(const std::string& value) {
+  std::ostringstream escaped;
+  for (const char c : value) {
+    if (c == '\\' || c == '"') {
+      escaped << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      escaped << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+    } else {
+      escaped << c;
+    }
+  }
+  return escaped.str();
+}
+
+}  // namespace
+
+TensorStatisticsCollector::TensorStatisticsCollector(const GraphViewer& graph_viewer, size_t histogram_bin_count)
+    : histogram_bin_count_(histogram_bin_count) {
+  ORT_ENFORCE(histogram_bin_count > 0 && histogram_bin_count % 2 == 0,
+              "The number of histogram bins must be a positive even number.");
+
+  const auto add_statistics = [this](const NodeArg& node_arg) {
+    if (node_arg.Exists() && IsFloatTensor(node_arg)) {
+      auto statistics = std::make_unique<Statistics>();
+      statistics->histogram.resize(histogram_bin_count_, 0);
+      statistics_.emplace(node_arg.Name(), std::move(statistics));
+    }
+  };
+
+  InlinedHashSet<std::string> graph_inputs_to_record;
+  for (const auto* graph_input : graph_viewer.GetInputs()) {
+    add_statistics(*graph_input);
+    graph_inputs_to_record.insert(graph_input->Name());
+  }
+
+  for (const auto node_index : graph_viewer.GetNodesInTopologicalOrder()) {
+    const auto* node = graph_viewer.GetNode(node_index);
+    if (node == nullptr) {
+      continue;
+    }
+
+    const auto& input_defs = node->InputDefs();
+    for (int i = 0, end = static_cast<int>(input_defs.size()); i < end; ++i) {
+      if (graph_inputs_to_record.erase(input_defs[i]->Name()) > 0) {
+        graph_inputs_by_first_consumer_[node_index].push_back(i);
+      }
+    }
+
+    for (const auto* output_def : node->OutputDefs()) {
+      add_statistics(*output_def);
+    }
+  }
+}
+
+void TensorStatisticsCollector::RecordNodeInputs(const Node& node, const OpKernelContext& context) {
+  const auto it = graph_inputs_by_first_consumer_.find(node.Index());
+  if (it == graph_inputs_by_first_consumer_.end()) {
+    return;
+  }
+
+  for (const int i : it->second) {
+    if (const auto* tensor = context.Input<Tensor>(i); tensor != nullptr) {
+      RecordTensor(node.InputDefs()[i]->Name(), *tensor);
+    }
+  }
+}
+
+void TensorStatisticsCollector::RecordNodeOutputs(const Node& node, OpKernelContext& context) {
+  const auto& output_defs = node.OutputDefs();
+  for (int i = 0, end = context.OutputCount(); i < end; ++i) {
+    if (!output_defs[i]->Exists()) {
+      continue;
+    }
+
+    const auto* type = context.OutputType(i);
+    if (type == nullptr || !type->IsTensorType()) {
+      continue;
+    }
+
+    if (const auto* tensor = context.Output<Tensor>(i); tensor != nullptr) {
+      RecordTensor(output_defs[i]->Name(), *tensor);
+    }
+  }
+}
+
+void TensorStatisticsCollector::RecordTensor(const std::string& name, const Tensor& tensor) {
+  if (!tensor.IsDataType<float>() || tensor.Location().device.Type() != OrtDevice::CPU) {
+    return;
+  }
+
+  Record(name, tensor.DataAsSpan<float>());
+}
+
+void TensorStatisticsCollector::Record(const std::string& name, gsl::span<const float> values) {
+  const auto it = statistics_.find(name);
+  if (it == statistics_.end()) {
+    return;
+  }
+
+  uint64_t count = 0;
+  float min = std::numeric_limits<float>::max();
+  float max = std::numeric_limits<float>::lowest();
+  for (const float value : values) {
+    if (std::isfinite(value)) {
+      min = std::min(min, value);
+      max = std::max(max, value);
+      ++count;
+    }
+  }
+
+  if (count == 0) {
+    return;
+  }
+
+  const float max_abs = std::max(std::abs(min), std::abs(max));
+
+  Statistics& statistics = *it->second;
+  std::lock_guard<std::mutex> lock(statistics.mutex);
+
+  statistics.min = (statistics.count == 0) ? min : std::min(statistics.min, min);
+  statistics.max = (statistics.count == 0) ? max : std::max(statistics.max, max);
+  statistics.count += count;
+
+  // the first non-zero value sets the initial bin width, until then all the values are in bin 0
+  auto& histogram = statistics.histogram;
+  if (statistics.bin_width == 0.0f && max_abs > 0.0f) {
+    statistics.bin_width = max_abs / static_cast<float>(histogram_bin_count_);
+  }
+
+  if (statistics.bin_width == 0.0f) {
+    histogram[0] += count;
+    return;
+  }
+
+  while (max_abs > statistics.bin_width * static_cast<float>(histogram_bin_count_)) {
+    for (size_t bin = 0; bin < histogram_bin_count_ / 2; ++bin) {
+      histogram[bin] = histogram[2 * bin] + histogram[2 * bin + 1];
+    }
+    std::fill(histogram.begin() + histogram_bin_count_ / 2, histogram.end(), uint64_t{0});
+    statistics.bin_width *= 2.0f;
+  }
+
+  const float inverse_bin_width = 1.0f / statistics.bin_width;
+  for (const float value : values) {
+    if (std::isfinite(value)) {
+      // the upper bound of the last bin belongs to it
+      const auto bin = static_cast<size_t>(std::abs(value) * inverse_bin_width);
+      ++histogram[std::min(bin, histogram_bin_count_ - 1)];
+    }
+  }
+}
+
+std::string TensorStatisticsCollector::ToJson() const {
+  // sorted by name so that the output is stable
+  std::map<std::string, const Statistics*> sorted_statistics;
+  for (const auto& [name, statistics] : statistics_) {
+    sorted_statistics.emplace(name, statistics.get());
+  }
+
+  std::ostringstream ss;
+  ss << std::setprecision(std::numeric_limits<float>::max_digits10) << "{";
+  bool first = true;
+  for (const auto& [name, statistics] : sorted_statistics) {
+    std::lock_guard<std::mutex> lock(statistics->mutex);
+    if (statistics->count == 0) {
+      continue;
+    }
+
+    ss << (first ? "" : ",") << "\"" << EscapeJsonString(name) << "\":{"
+       << "\"count\":" << statistics->count << ",\"min\":" << statistics->min << ",\"max\":" << statistics->max
+       << ",\"histogram_bin_width\":" << statistics->bin_width << ",\"histogram\":[";
+    for (size_t bin = 0; bin < statistics->histogram.size(); ++bin) {
+      ss << (bin == 0 ? "" : ",") << statistics->histogram[bin];
+    }
+    ss << "]}";
+    first = false;
+  }
+  ss << "}";
+
+  return ss.str();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gsl/gsl>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/graph/basic_types.h"
+
+namespace onnxruntime {
+
+class GraphViewer;
+class Node;
+class OpKernelContext;
+class Tensor;
+
+/**
+ * Collects calibration statistics of the float tensors of the main graph during ordinary Runs, see
+ * kOrtSessionOptionsConfigCollectTensorStatistics.
+ *
+ * Each tensor gets its min, max and a histogram of its absolute values. The histogram has a fixed number of bins
+ * starting at 0. When a value beyond the last bin is seen the width of the bins is doubled by merging pairs of bins,
+ * so the histogram covers the whole range seen so far without keeping the values. Non-finite values are ignored.
+ *
+ * The node outputs are recorded after the node runs and the graph inputs before their first consumer runs, so no
+ * extra graph outputs are needed. Only tensors in CPU memory are recorded.
+ */
+class TensorStatisticsCollector {
+ public:
+  TensorStatisticsCollector(const GraphViewer& graph_viewer, size_t histogram_bin_count);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(TensorStatisticsCollector);
+
+  // Records the graph inputs that `node` is the first consumer of, before it runs.
+  void RecordNodeInputs(const Node& node, const OpKernelContext& context);
+
+  // Records the outputs of `node`, after it runs.
+  void RecordNodeOutputs(const Node& node, OpKernelContext& context);
+
+  // Adds `values` to the statistics of tensor `name`. Tensors that aren't float tensors of the graph are ignored.
+  void Record(const std::string& name, gsl::span<const float> values);
+
+  size_t HistogramBinCount() const noexcept { return histogram_bin_count_; }
+
+  // The statistics of the recorded tensors as a JSON object keyed by tensor name:
+  //   {"<name>": {"count": <n>, "min": <min>, "max": <max>, "histogram_bin_width": <w>, "histogram": [...]}, ...}
+  // Bin i of "histogram" counts the values whose absolute value is in [i * w, (i + 1) * w), the last bin also counts
+  // the values at its upper bound.
+  std::string ToJson() const;
+
+ private:
+  struct Statistics {
+    mutable std::mutex mutex;
+    uint64_t count{0};
+    float min{0.0f};
+    float max{0.0f};
+    float bin_width{0.0f};
+    std::vector<uint64_t> histogram;
+  };
+
+  void RecordTensor(const std::string& name, const Tensor& tensor);
+
+  const size_t histogram_bin_count_;
+
+  // created up front for all the float tensors so that concurrent Runs only lock the tensors they record
+  std::unordered_map<std::string, std::unique_ptr<Statistics>> statistics_;
+
+  // the graph inputs to record before each node runs
+  InlinedHashMap<NodeIndex, InlinedVector<int>> graph_inputs_by_first_consumer_;
+};
+
+}  // namespace onnxruntime
@@ -4,6 +4,9 @@
 #include "core/framework/utils.h"
 
 #include <iomanip>
+#include <list>
+#include <optional>
+#include <unordered_set>
 
 #include "core/graph/graph_viewer.h"
 #include "core/framework/data_transfer_manager.h"
@@ -258,11 +261,7 @@ static common::Status CalculateStaticCopyInfoForFeed(const SessionState& session
                                                      const std::string& input_name,
                                                      MLValueCopyInfo& copy_info) {
   InlinedVector<SessionState::NodeInfo> node_info_vec;
-#ifdef ENABLE_TRAINING
   if (session_state.GetInputNodeInfo(input_name, node_info_vec) == Status::OK()) {
-#else
-  ORT_RETURN_IF_ERROR(session_state.GetInputNodeInfo(input_name, node_info_vec));
-#endif
     const auto& node_info = node_info_vec.front();  // all consumers of a feed have the same device so first entry is fine
 
     if (node_info.p_node == nullptr) {
@@ -281,9 +280,9 @@ static common::Status CalculateStaticCopyInfoForFeed(const SessionState& session
       }
     }
 
-#ifdef ENABLE_TRAINING
   } else {
-    // This input might be for an intermediate tensor for partial graph execution.
+    // This input is an intermediate value for partial graph execution, or a cut value of a partial inference run
+    // (see kOrtSessionOptionsConfigPartialRunCutValues).
     const auto* exec_plan = session_state.GetExecutionPlan();
     const auto& name_to_id = session_state.GetOrtValueNameIdxMap();
     int index;
@@ -291,7 +290,6 @@ static common::Status CalculateStaticCopyInfoForFeed(const SessionState& session
     const auto& device = exec_plan->GetLocation(index);
     copy_info.target_device = device;
   }
-#endif
 
   return Status::OK();
 }
@@ -448,13 +446,85 @@ static void FinalizeFeedFetchCopyInfo(FeedsFetchesManager& feeds_fetches_manager
   FinalizeFeedFetchCopyInfo(feeds_fetches_manager, feed_locations, fetch_alloc_info);
 }
 
+namespace {
+// Feeds copied from pageable memory to pinned memory before they are copied to the device, so that the device copy is
+// an asynchronous DMA on the stream instead of a copy that blocks the host until it completes.
+// The pinned buffers are released only after the streams that copy from them are flushed.
+class StagedFeeds {
+ public:
+  StagedFeeds() = default;
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(StagedFeeds);
+
+  ~StagedFeeds() {
+    ORT_TRY {
+      for (Stream* stream : streams_) {
+        stream->Flush();
+      }
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        LOGS_DEFAULT(ERROR) << "Failed to flush the stream copying the staged feeds: " << ex.what();
+      });
+    }
+  }
+
+  // Returns the pinned copy of the feed, or nullptr if the feed isn't staged.
+  const OrtValue* Stage(const SessionState& session_state, const MLValueCopyInfo& copy_info,
+                        const OrtValue& feed, Stream* stream) {
+    if (stream == nullptr || !feed.IsTensor() ||
+        copy_info.source_device.Type() != OrtDevice::CPU ||
+        copy_info.source_device.MemType() != OrtDevice::MemType::DEFAULT ||
+        copy_info.target_device.Type() == OrtDevice::CPU) {
+      return nullptr;
+    }
+
+    const Tensor& source = feed.Get<Tensor>();
+    if (source.IsDataTypeString() || source.Location().device != copy_info.source_device) {
+      return nullptr;
+    }
+
+    AllocatorPtr pinned_allocator = FindPinnedAllocator(session_state, copy_info.target_device);
+    if (pinned_allocator == nullptr) {
+      return nullptr;
+    }
+
+    OrtValue& staged = buffers_.emplace_back();
+    Tensor::InitOrtValue(source.DataType(), source.Shape(), std::move(pinned_allocator), staged);
+    memcpy(staged.GetMutable<Tensor>()->MutableDataRaw(), source.DataRaw(), source.SizeInBytes());
+    streams_.insert(stream);
+    return &staged;
+  }
+
+ private:
+  static AllocatorPtr FindPinnedAllocator(const SessionState& session_state, const OrtDevice& device) {
+    // pinned allocators are registered as CPU devices with the memory type of the EP, and often only for device 0
+    for (const OrtDevice::DeviceId device_id : {device.Id(), static_cast<OrtDevice::DeviceId>(0)}) {
+      for (const OrtDevice::MemoryType mem_type : {OrtDevice::MemType::CUDA_PINNED, OrtDevice::MemType::HIP_PINNED,
+                                                   OrtDevice::MemType::CANN_PINNED}) {
+        auto allocator = session_state.GetAllocator(OrtDevice(OrtDevice::CPU, mem_type, device_id));
+        if (allocator != nullptr) {
+          return allocator;
+        }
+      }
+    }
+
+    return nullptr;
+  }
+
+  // std::list as the batched copies refer to the tensors while more feeds are staged
+  std::list<OrtValue> buffers_;
+  std::unordered_set<Stream*> streams_;
+};
+}  // namespace
+
 static common::Status CopyInputsAcrossDevices(const SessionState& session_state,
                                               gsl::span<const OrtValue> orig_feeds,
                                               std::vector<OrtValue>& new_feeds,
 #ifdef ORT_ENABLE_STREAM
                                               DeviceStreamCollection* device_stream_collection,
 #endif
-                                              gsl::span<const MLValueCopyInfo> copy_info) {
+                                              gsl::span<const MLValueCopyInfo> copy_info,
+                                              StagedFeeds* staged_feeds = nullptr) {
   size_t num_feeds = orig_feeds.size();
   ORT_ENFORCE(copy_info.size() == num_feeds);
 
@@ -483,12 +553,19 @@ static common::Status CopyInputsAcrossDevices(const SessionState& session_state,
       }
     }
 #endif
+    const OrtValue* feed = &orig_feeds[idx];
+    if (staged_feeds != nullptr) {
+      if (const OrtValue* staged = staged_feeds->Stage(session_state, copy_info[idx], *feed, copy_this_feed)) {
+        feed = staged;
+      }
+    }
+
 #if !defined(DISABLE_SPARSE_TENSORS)
-    ORT_RETURN_IF_ERROR(BatchOrCopyMLValue(session_state, copy_info[idx], orig_feeds[idx], new_feeds[idx],
+    ORT_RETURN_IF_ERROR(BatchOrCopyMLValue(session_state, copy_info[idx], *feed, new_feeds[idx],
                                            copy_this_feed,
                                            &batched_data_transfers, &batched_sparse_data_transfers));
 #else
-    ORT_RETURN_IF_ERROR(BatchOrCopyMLValue(session_state, copy_info[idx], orig_feeds[idx], new_feeds[idx],
+    ORT_RETURN_IF_ERROR(BatchOrCopyMLValue(session_state, copy_info[idx], *feed, new_feeds[idx],
                                            copy_this_feed,
                                            &batched_data_transfers));
 #endif
@@ -663,14 +740,21 @@ ExecuteGraphImpl(const SessionState& session_state,
     std::vector<OrtValue>* p_fetches = &fetches;
     std::vector<OrtValue> device_feeds;
     std::vector<OrtValue> device_fetches;
+    // declared before the copies so that the pinned buffers outlive them, including on early returns
+    std::optional<StagedFeeds> staged_feeds;
 
     if (device_copy_checks.input_copy_needed == DeviceCopyCheck::Copy) {
       const auto& feed_copy_info = feeds_fetches_manager.GetFeedsDeviceCopyInfo();
+      if (session_state.ShouldStageFeedsInPinnedMemory()) {
+        staged_feeds.emplace();
+      }
+
       auto status = CopyInputsAcrossDevices(session_state, feeds, device_feeds,
 #ifdef ORT_ENABLE_STREAM
                                             device_stream_collection,
 #endif
-                                            feed_copy_info);
+                                            feed_copy_info,
+                                            staged_feeds ? &*staged_feeds : nullptr);
       ORT_RETURN_IF_ERROR(status);
       feeds_to_use = device_feeds;
     }
@@ -743,10 +827,12 @@ common::Status ExecuteGraph(const SessionState& session_state,
 #endif
                             bool only_execute_path_to_fetches,
                             Stream* parent_stream) {
-  ORT_RETURN_IF_ERROR(utils::InitializeFeedFetchCopyInfo(session_state, feeds_fetches_manager));
+  if (!feeds_fetches_manager.IsCopyInfoFrozen()) {
+    ORT_RETURN_IF_ERROR(utils::InitializeFeedFetchCopyInfo(session_state, feeds_fetches_manager));
 
-  // finalize the copy info using the provided feeds and fetches. will update device_copy_checks in the background
-  FinalizeFeedFetchCopyInfo(feeds_fetches_manager, feeds, fetches);
+    // finalize the copy info using the provided feeds and fetches. will update device_copy_checks in the background
+    FinalizeFeedFetchCopyInfo(feeds_fetches_manager, feeds, fetches);
+  }
 #ifdef ORT_ENABLE_STREAM
   DeviceStreamCollection* device_stream_collection = device_stream_collection_holder.p_.get();
   auto retval = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, {},
@@ -906,21 +992,39 @@ common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFet
                                bool sync_subgraph_fetches) {
 #ifdef ORT_ENABLE_STREAM
   DeviceStreamCollectionHolder device_stream_collection_holder(&session_state);
+  return ExecuteSubgraph(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators, execution_mode,
+                         terminate_flag, logger, device_stream_collection_holder, parent_stream,
+                         sync_subgraph_fetches);
+#else
+  auto retval = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
+                                 execution_mode, terminate_flag, logger, false, parent_stream);
+  if (retval.IsOK() && sync_subgraph_fetches && parent_stream) {
+    parent_stream->Flush();
+  }
+  return retval;
+#endif
+}
+
+#ifdef ORT_ENABLE_STREAM
+common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFetchesManager& feeds_fetches_manager,
+                               gsl::span<const OrtValue> feeds, std::vector<OrtValue>& fetches,
+                               const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
+                               ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger,
+                               DeviceStreamCollectionHolder& device_stream_collection_holder,
+                               Stream* parent_stream,
+                               bool sync_subgraph_fetches) {
   DeviceStreamCollection* device_stream_collection = device_stream_collection_holder.p_.get();
 
   auto retval = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
                                  execution_mode, terminate_flag, logger, device_stream_collection, false, parent_stream);
   if (device_stream_collection)
     ORT_CHECK_AND_SET_RETVAL(device_stream_collection->CleanUp(false));
-#else
-  auto retval = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
-                                 execution_mode, terminate_flag, logger, false, parent_stream);
-#endif
   if (retval.IsOK() && sync_subgraph_fetches && parent_stream) {
     parent_stream->Flush();
   }
   return retval;
 }
+#endif
 
 int32_t ONNXTensorElementDataTypeToProtoTensorType(ONNXTensorElementDataType onnx_enum) {
   switch (onnx_enum) {
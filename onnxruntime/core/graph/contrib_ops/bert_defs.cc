@@ -277,11 +277,19 @@ void BaseGroupQueryAttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceConte
   }
 
   if (ctx.getNumOutputs() > 1) {  // has present output
-    // copy the type from query to present key
-    ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 1);
+    if (ctx.getNumOutputs() > 3) {
+      // int8 KV cache with the scales of the tokens of present key and value in outputs 3 and 4
+      updateOutputElemType(ctx, 1, ONNX_NAMESPACE::TensorProto::INT8);
+      updateOutputElemType(ctx, 2, ONNX_NAMESPACE::TensorProto::INT8);
+      updateOutputElemType(ctx, 3, ONNX_NAMESPACE::TensorProto::FLOAT);
+      updateOutputElemType(ctx, 4, ONNX_NAMESPACE::TensorProto::FLOAT);
+    } else {
+      // copy the type from query to present key
+      ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 1);
 
-    // copy the type from query to present value
-    ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 2);
+      // copy the type from query to present value
+      ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 2);
+    }
 
     if (past_key_index >= 0 && hasInputShape(ctx, past_key_index)) {
       auto& past_shape = getInputShape(ctx, past_key_index);
@@ -318,7 +326,11 @@ void BaseGroupQueryAttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceConte
 
 void GroupQueryAttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceContext& ctx, int past_key_index) {
   // TODO(aciddelgado): propagate output shapes depending if kv-share buffer is on or not
-  constexpr int use_max_past_present_buffer = -1;
+  // A paged KV cache (block_table input present) and a ring buffer KV cache are always updated in place so present
+  // has the shape of past.
+  const bool is_paged_kv_cache = ctx.getNumInputs() > 9 && ctx.hasInput(9);
+  const bool is_ring_buffer_kv_cache = getAttribute(ctx, "kv_cache_ring_buffer", 0) == 1;
+  const int use_max_past_present_buffer = is_paged_kv_cache || is_ring_buffer_kv_cache ? 1 : -1;
   BaseGroupQueryAttentionTypeAndShapeInference(ctx, past_key_index, use_max_past_present_buffer);
 }
 
@@ -393,6 +405,27 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
               "Custom scale will be used if specified. Default value is 1/sqrt(head_size)",
               AttributeProto::FLOAT,
               OPTIONAL_VALUE)
+        .Attr("sparse_block_size",
+              "Number of tokens per block of a block sparse attention pattern. Blocks of queries only attend to the "
+              "blocks of keys selected by sparse_local_blocks, sparse_vert_stride and sparse_global_blocks. "
+              "Only supported by the CPU execution provider. Default value is 0 for dense attention.",
+              AttributeProto::INT,
+              OPTIONAL_VALUE)
+        .Attr("sparse_local_blocks",
+              "Number of blocks of a sliding window: block i of queries attends to block j of keys if |i - j| is "
+              "less than it. Default value is 0.",
+              AttributeProto::INT,
+              OPTIONAL_VALUE)
+        .Attr("sparse_vert_stride",
+              "If not 0, block j of keys is attended by all the queries if (j + 1) is a multiple of it. "
+              "Default value is 0.",
+              AttributeProto::INT,
+              OPTIONAL_VALUE)
+        .Attr("sparse_global_blocks",
+              "Number of leading blocks of global tokens that attend to and are attended by all the tokens. "
+              "Default value is 0.",
+              AttributeProto::INT,
+              OPTIONAL_VALUE)
         .Input(0,
                "input",
                "Input tensor with shape (batch_size, sequence_length, input_hidden_size)",
@@ -979,6 +1012,27 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
               "Whether every token can only attend to previous tokens. Default value is 0.",
               AttributeProto::INT,
               static_cast<int64_t>(0))
+        .Attr("sparse_block_size",
+              "Number of tokens per block of a block sparse attention pattern. Blocks of queries only attend to the "
+              "blocks of keys selected by sparse_local_blocks, sparse_vert_stride and sparse_global_blocks. "
+              "Only supported by the CPU execution provider. Default value is 0 for dense attention.",
+              AttributeProto::INT,
+              OPTIONAL_VALUE)
+        .Attr("sparse_local_blocks",
+              "Number of blocks of a sliding window: block i of queries attends to block j of keys if |i - j| is "
+              "less than it. Default value is 0.",
+              AttributeProto::INT,
+              OPTIONAL_VALUE)
+        .Attr("sparse_vert_stride",
+              "If not 0, block j of keys is attended by all the queries if (j + 1) is a multiple of it. "
+              "Default value is 0.",
+              AttributeProto::INT,
+              OPTIONAL_VALUE)
+        .Attr("sparse_global_blocks",
+              "Number of leading blocks of global tokens that attend to and are attended by all the tokens. "
+              "Default value is 0.",
+              AttributeProto::INT,
+              OPTIONAL_VALUE)
         .Input(0,
                "query",
                "Query with shape (batch_size, sequence_length, hidden_size), or packed QKV with shape (batch_size, kv_sequence_length, num_heads, 3, head_size)",
@@ -1051,6 +1105,20 @@ Supports different number of heads for q and kv for CPU and CUDA.
 Only supports causal and local attention.
 Supports rotary position embedding for CPU and CUDA.
 Supports packed input for CPU and CUDA.
+Supports a paged KV cache for CPU and CUDA through the block_table input: past and present key/value are then a pool of
+fixed size blocks shared by all the sequences, and each sequence only holds the blocks listed in its row of the
+block table, so the KV cache grows with the actual number of tokens instead of max_sequence_length per sequence.
+On CUDA the paged KV cache needs flash attention and a kv_block_size that is a multiple of 256.
+Supports an int8 KV cache for CPU when the present_key_scale and present_value_scale outputs are present: each token
+of each head of past/present key and value is quantized symmetrically with its own scale, stored in the matching
+past/present scale tensor, which quarters the KV cache footprint of float models.
+Supports feeding a long prompt in chunks for CPU: a run with more than one new token and a total_sequence_length
+larger than sequence_length appends the tokens to the KV cache, and seqlens_k then counts the past and new tokens
+minus one like in token generation. Each chunk only needs scratch space for its own rows of the attention probs.
+Supports a ring buffer KV cache for local attention for CPU when kv_cache_ring_buffer is 1: past and present key/value
+then hold the last past_sequence_length tokens (local_window_size tokens without past), at least local_window_size,
+and the token at position p of a sequence is stored at index p % past_sequence_length. New tokens overwrite the oldest
+ones, so the KV cache stays the same size however long the sequence gets.
 )DOC";
 
 ONNX_MS_OPERATOR_SET_SCHEMA(
@@ -1067,6 +1135,11 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
               "left_window_size for local attention (like Mistral). Default value is -1 meaning unused.",
               AttributeProto::INT,
               static_cast<int64_t>(-1))
+        .Attr("kv_cache_ring_buffer",
+              "Whether past and present key/value are a ring buffer of the tokens of the local window (CPU only). "
+              "Requires local_window_size. Default value is 0.",
+              AttributeProto::INT,
+              OPTIONAL_VALUE)
         .Attr("do_rotary",
               "Whether to use rotary position embedding. Default value is 0.",
               AttributeProto::INT,
@@ -1094,13 +1167,13 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                "past_key",
                "past state key with support for format BNSH. When past_key uses same tensor as present_key"
                "(k-v cache), it is of length max_sequence_length... otherwise of length past_sequence_length.",
-               "T",
+               "T_CACHE",
                OpSchema::Optional)
         .Input(4,
                "past_value",
                "past state value with support for format BNSH. When past_value uses same tensor as present_value"
                "(k-v cache), it is of length max_sequence_length... otherwise of length past_sequence_length.",
-               "T",
+               "T_CACHE",
                OpSchema::Optional)
         .Input(5,
                "seqlens_k",
@@ -1121,6 +1194,23 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                "2D tensor with shape (max_sequence_length, head_size / 2).",
                "T",
                OpSchema::Optional)
+        .Input(9,
+               "block_table",
+               "2D tensor with shape (batch_size, max_blocks_per_sequence) holding the indices of the KV cache blocks of "
+               "each sequence in order. When present, past_key and past_value are a pool of blocks with shape "
+               "(num_blocks, kv_num_heads, kv_block_size, head_size) that is updated in place.",
+               "M",
+               OpSchema::Optional)
+        .Input(10,
+               "past_key_scale",
+               "Scale of each token of an int8 past_key with shape (batch_size, kv_num_heads, past_sequence_length).",
+               "tensor(float)",
+               OpSchema::Optional)
+        .Input(11,
+               "past_value_scale",
+               "Scale of each token of an int8 past_value with shape (batch_size, kv_num_heads, past_sequence_length).",
+               "tensor(float)",
+               OpSchema::Optional)
         .Output(0,
                 "output",
                 "3D output tensor with shape (batch_size, sequence_length, hidden_size)",
@@ -1130,14 +1220,29 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                 "present state key with support for format BNSH. When past_key uses same tensor as present_key"
                 "(k-v buffer), it is of length max_sequence_length... otherwise of length past_sequence_length +"
                 "kv_sequence_length.",
-                "T")
+                "T_CACHE")
         .Output(2,
                 "present_value",
                 "present state value with support for format BNSH. When past_value uses same tensor as present_value"
                 "(k-v buffer), it is of length max_sequence_length... otherwise of length past_sequence_length +"
                 "kv_sequence_length.",
-                "T")
+                "T_CACHE")
+        .Output(3,
+                "present_key_scale",
+                "Scale of each token of present_key with shape (batch_size, kv_num_heads, present_sequence_length). "
+                "When present, present_key is quantized to int8 (CPU only).",
+                "tensor(float)",
+                OpSchema::Optional)
+        .Output(4,
+                "present_value_scale",
+                "Scale of each token of present_value with shape (batch_size, kv_num_heads, present_sequence_length). "
+                "When present, present_value is quantized to int8 (CPU only).",
+                "tensor(float)",
+                OpSchema::Optional)
         .TypeConstraint("T", {"tensor(float16)", "tensor(bfloat16)", "tensor(float)"}, "Constrain input and output to float tensors.")
+        .TypeConstraint("T_CACHE", {"tensor(float16)", "tensor(bfloat16)", "tensor(float)", "tensor(int8)"},
+                        "Constrain the KV cache to float tensors of the type of the input, or to int8 tensors with "
+                        "the present_key_scale and present_value_scale outputs.")
         .TypeConstraint("M", {"tensor(int32)"}, "Constrain mask to int tensor.")
         .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
           GroupQueryAttentionTypeAndShapeInference(ctx, 3);
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 #include "core/graph/contrib_ops/contrib_defs.h"
 
+#include <algorithm>
 #include <cmath>
 #include "core/graph/onnx_protobuf.h"
 
@@ -542,6 +543,46 @@ void GreedySearchShapeInference(ONNX_NAMESPACE::InferenceContext& ctx) {
   }
 }
 
+void SpeculativeDecodingShapeInference(ONNX_NAMESPACE::InferenceContext& ctx) {
+  // Type inference
+  ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 0);
+  if (ctx.getNumOutputs() > 1) {
+    ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 1);
+    ONNX_NAMESPACE::TensorShapeProto num_accepted_tokens_shape;
+    num_accepted_tokens_shape.add_dim()->set_dim_value(1);
+    updateOutputShape(ctx, 1, num_accepted_tokens_shape);
+  }
+
+  // Shape inference
+  // input 0 (input_ids) shape: (batch_size, sequence_length)
+  // output 0 (sequences) shape: (batch_size, max_length)
+  if (!hasInputShape(ctx, 0)) {
+    return;
+  }
+  auto& input_ids_dims = getInputShape(ctx, 0).dim();
+  if (input_ids_dims.size() != 2) {
+    fail_shape_inference("Inputs 0 shall be 2 dimensions");
+  }
+  if (!input_ids_dims[0].has_dim_value()) {
+    return;
+  }
+
+  const auto max_length = ctx.getInputData(1);
+  if (max_length == nullptr) {  // not initializer
+    return;
+  }
+
+  int max_length_value = 0;
+  if (!ParseScalar(max_length, max_length_value) || max_length_value <= 0) {
+    fail_shape_inference("Failed to parse max_length or it is not positive integer scalar");
+  }
+
+  ONNX_NAMESPACE::TensorShapeProto sequences_shape;
+  sequences_shape.add_dim()->set_dim_value(input_ids_dims[0].dim_value());
+  sequences_shape.add_dim()->set_dim_value(max_length_value);
+  updateOutputShape(ctx, 0, sequences_shape);
+}
+
 constexpr const char* Gelu_ver1_doc =
     R"DOC(Gaussian Error Linear Unit.
 A high-performing neural network activation function.The GELU nonlinearity is
@@ -761,6 +802,55 @@ ONNX_MS_OPERATOR_SET_SCHEMA(TorchEmbedding, 1,
                                   updateOutputShape(ctx, 0, outputs_shape);
                                 }));
 
+ONNX_MS_OPERATOR_SET_SCHEMA(EmbeddingBag, 1,
+                            OpSchema()
+                                .SetDoc(R"DOC(
+Sums or averages bags of rows of an embedding matrix, which is Gather on axis 0 followed by ReduceSum or ReduceMean
+over the last axis of the indices, without materializing the gathered rows. The last axis of `indices` holds the
+indices of the rows in a bag and the other axes enumerate the bags. Negative indices count from the end of
+`weight`, as in Gather.)DOC")
+                                .Attr("mode",
+                                      "How the rows of a bag are combined, 'sum' or 'mean'.",
+                                      AttributeProto::STRING,
+                                      std::string("sum"))
+                                .Attr("keepdims",
+                                      "Keep the reduced axis of the indices as a dimension of size one in the output.",
+                                      AttributeProto::INT,
+                                      static_cast<int64_t>(0))
+                                .Input(0, "weight", "The embedding matrix of shape [N, M].", "T")
+                                .Input(1, "indices", "Indices of rank q >= 1. Each of the bags along the last axis "
+                                                     "is reduced to one row of the output.", "Tind")
+                                .Output(0, "Y", "Output of shape indices.shape[:-1] + [M], or "
+                                                "indices.shape[:-1] + [1, M] when keepdims is 1.", "T")
+                                .TypeConstraint("T", {"tensor(float)", "tensor(float16)"},
+                                                "Constrain input and output types to float tensors.")
+                                .TypeConstraint("Tind", {"tensor(int32)", "tensor(int64)"},
+                                                "Constrain indices to integer types.")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  propagateElemTypeFromInputToOutput(ctx, 0, 0);
+                                  if (!hasNInputShapes(ctx, 2)) {
+                                    return;
+                                  }
+                                  const auto& weight_shape = getInputShape(ctx, 0);
+                                  const auto& indices_shape = getInputShape(ctx, 1);
+                                  if (weight_shape.dim_size() != 2) {
+                                    fail_shape_inference("weight must be a 2D tensor.");
+                                  }
+                                  if (indices_shape.dim_size() < 1) {
+                                    fail_shape_inference("indices must have rank larger than zero.");
+                                  }
+
+                                  ONNX_NAMESPACE::TensorShapeProto output_shape;
+                                  for (int i = 0; i < indices_shape.dim_size() - 1; ++i) {
+                                    *output_shape.add_dim() = indices_shape.dim(i);
+                                  }
+                                  if (getAttribute(ctx, "keepdims", int64_t(0)) != 0) {
+                                    output_shape.add_dim()->set_dim_value(1);
+                                  }
+                                  *output_shape.add_dim() = weight_shape.dim(1);
+                                  updateOutputShape(ctx, 0, output_shape);
+                                }));
+
 constexpr const char* Trilu_ver1_doc = R"DOC(
       Returns the upper or lower triangular part of a 2-D matrix, or batches of 2-D matrices. If the attribute "upper" is set to true,
       the upper triangular matrix is retained. Lower triangular matrix is retained otherwise. Default value for upper is true.
@@ -1332,6 +1422,8 @@ ONNX_MS_OPERATOR_SET_SCHEMA(GreedySearch, 1,
                                 .Input(4, "vocab_mask", "Mask of vocabulary. Words that masked with 0 are not allowed to be generated, and 1 is allowed. Shape is (vocab_size)", "I", OpSchema::Optional)
                                 .Input(5, "prefix_vocab_mask", "Mask of vocabulary for first step. Words that masked with 0 are not allowed to be generated, and 1 is allowed. Shape is (batch_size, vocab_size)", "I", OpSchema::Optional)
                                 .Input(6, "attention_mask", "Custom attention mask. Shape is (batch_size, sequence_length)", "I", OpSchema::Optional)
+                                .Input(7, "vocab", "Byte-level BPE token of each id, like the vocab of BpeDetokenizer. Shape is (vocab_size). Required by stop_strings", "tensor(string)", OpSchema::Optional)
+                                .Input(8, "stop_strings", "Strings that end a sequence once its generated text contains one of them. The token that completes a stop string is kept. Shape is (num_stop_strings)", "tensor(string)", OpSchema::Optional)
                                 .Output(0, "sequences", "Word IDs of generated sequences. Shape is (batch_size, max_sequence_length)", "I")
                                 // TODO(wy): support scores if needed.
                                 .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
@@ -1383,6 +1475,39 @@ ONNX_MS_OPERATOR_SET_SCHEMA(Sampling, 1,
                                   GreedySearchShapeInference(ctx);
                                 }));
 
+constexpr const char* SpeculativeDecoding_ver1_doc = R"DOC(
+Speculative decoding for text generation with GPT-2 like models.
+
+In each iteration, the `draft_decoder` subgraph generates `num_speculative_tokens` tokens greedily and
+the `decoder` subgraph scores all of them in one run. The longest prefix of the draft tokens that matches
+the greedy choice of the decoder is accepted along with the next token chosen by the decoder, and the past
+state of both subgraphs is rolled back to the accepted tokens. The generated sequences are the same as the
+ones of GreedySearch with the `decoder` subgraph, while the decoder runs once for up to
+`num_speculative_tokens` + 1 tokens.
+
+Both subgraphs have the inputs and outputs of the `decoder` subgraph of GreedySearch without past_present_share_buffer,
+and their logits shall be float.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(SpeculativeDecoding, 1,
+                            OpSchema()
+                                .SetDoc(SpeculativeDecoding_ver1_doc)
+                                .Attr("eos_token_id", "The id of the end-of-sequence token", AttributeProto::INT)
+                                .Attr("pad_token_id", "The id of the padding token", AttributeProto::INT)
+                                .Attr("num_speculative_tokens", "Number of tokens generated by the draft decoder in each iteration.",
+                                      AttributeProto::INT, static_cast<int64_t>(4))
+                                .Attr("draft_decoder", "Smaller decoder subgraph that proposes the next tokens.", AttributeProto::GRAPH)
+                                .Attr("decoder", "Decoder subgraph that verifies the proposed tokens.", AttributeProto::GRAPH)
+                                .Input(0, "input_ids", "The sequence used as a prompt for the generation. Shape is (batch_size, sequence_length)", "I")
+                                .Input(1, "max_length", "The maximum length of the sequence to be generated. Shape is (1)", "I")
+                                .Input(2, "attention_mask", "Custom attention mask. Shape is (batch_size, sequence_length)", "I", OpSchema::Optional)
+                                .Output(0, "sequences", "Word IDs of generated sequences. Shape is (batch_size, max_sequence_length)", "I")
+                                .Output(1, "num_accepted_tokens", "Number of draft tokens accepted by the decoder. Shape is (1)", "I", OpSchema::Optional)
+                                .TypeConstraint("I", {"tensor(int32)"}, "Constrain to integer types")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  SpeculativeDecodingShapeInference(ctx);
+                                }));
+
 constexpr const char* MoE_ver1_doc = R"DOC(
       Mixture of experts. Examples: Switch transformer(https://arxiv.org/pdf/2101.03961.pdf) use top 1,
       GLaM(https://arxiv.org/abs/2112.06905) activates top 2 FFN, Vision MOE(https://arxiv.org/pdf/2106.05974.pdf)
@@ -1683,6 +1808,199 @@ activation.)DOC")
                                   ONNX_NAMESPACE::convPoolShapeInference(ctx, true, false, 0, 1);
                                 }));
 
+ONNX_MS_OPERATOR_SET_SCHEMA(FusedDepthwisePointwiseConv, 1,
+                            OpSchema()
+                                .SetDoc(R"DOC(
+A depthwise convolution followed by a pointwise (1x1) convolution, as found in MobileNet style
+inverted residual blocks. The attributes describe the depthwise convolution, whose group must equal
+the number of input channels, and activation is applied to its output. pointwise_activation is
+applied to the output of the pointwise convolution.)DOC")
+                                .Attr(
+                                    "auto_pad",
+                                    "",
+                                    AttributeProto::STRING,
+                                    std::string("NOTSET"))
+                                .Attr(
+                                    "kernel_shape",
+                                    "",
+                                    AttributeProto::INTS,
+                                    OPTIONAL_VALUE)
+                                .Attr(
+                                    "dilations",
+                                    "",
+                                    AttributeProto::INTS,
+                                    OPTIONAL_VALUE)
+                                .Attr(
+                                    "strides",
+                                    "",
+                                    AttributeProto::INTS,
+                                    OPTIONAL_VALUE)
+                                .Attr(
+                                    "pads",
+                                    "",
+                                    AttributeProto::INTS,
+                                    OPTIONAL_VALUE)
+                                .Attr(
+                                    "group",
+                                    "",
+                                    AttributeProto::INT,
+                                    static_cast<int64_t>(1))
+                                .Attr(
+                                    "activation",
+                                    "",
+                                    AttributeProto::STRING,
+                                    OPTIONAL_VALUE)
+                                .Attr(
+                                    "activation_params",
+                                    "",
+                                    AttributeProto::FLOATS,
+                                    OPTIONAL_VALUE)
+                                .Attr(
+                                    "pointwise_activation",
+                                    "",
+                                    AttributeProto::STRING,
+                                    OPTIONAL_VALUE)
+                                .Attr(
+                                    "pointwise_activation_params",
+                                    "",
+                                    AttributeProto::FLOATS,
+                                    OPTIONAL_VALUE)
+                                .Input(
+                                    0,
+                                    "X",
+                                    "",
+                                    "T")
+                                .Input(
+                                    1,
+                                    "W",
+                                    "Depthwise filter with shape (C, 1, kH, kW).",
+                                    "T")
+                                .Input(
+                                    2,
+                                    "B",
+                                    "Depthwise bias with shape (C).",
+                                    "T",
+                                    OpSchema::Optional)
+                                .Input(
+                                    3,
+                                    "PW",
+                                    "Pointwise filter with shape (M, C, 1, 1).",
+                                    "T")
+                                .Input(
+                                    4,
+                                    "PB",
+                                    "Pointwise bias with shape (M).",
+                                    "T",
+                                    OpSchema::Optional)
+                                .Output(
+                                    0,
+                                    "Y",
+                                    "",
+                                    "T")
+                                .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 0);
+                                  ONNX_NAMESPACE::convPoolShapeInference(ctx, true, false, 0, 1);
+                                  if (hasInputShape(ctx, 3) && ctx.getOutputType(0)->tensor_type().has_shape()) {
+                                    auto* output_shape = ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
+                                    if (output_shape->dim_size() > 1 && getInputShape(ctx, 3).dim_size() > 0) {
+                                      *output_shape->mutable_dim(1) = getInputShape(ctx, 3).dim(0);
+                                    }
+                                  }
+                                }));
+
+ONNX_MS_OPERATOR_SET_SCHEMA(FusedElementwise, 1,
+                            OpSchema()
+                                .SetDoc(R"DOC(
+A chain of broadcastable elementwise operators evaluated in a single pass over the output.
+The inputs and the result of each operator are numbered registers: registers 0 to N-1 hold the N inputs and
+operator i writes register N+i. ops lists the operators in evaluation order and operands lists the registers
+each of them reads, in the order of the inputs of the original operator. The last operator produces the output,
+whose shape is the multidirectional broadcast of the shapes of all inputs.
+The supported operators are Abs, Add, Div, Erf, Exp, Mul, Neg, Pow, Relu, Sigmoid, Sqrt, Sub, Tanh and Where.
+Bool inputs may only be used as the condition of Where.
+ReduceMax, ReduceMean and ReduceSum reduce the last axis with keepdims set and Softmax normalizes the last axis.
+With any of them, the chain is evaluated one row of the last axis at a time. Registers whose last dimension is 1
+hold one value per row, and if the output is such a register its last dimension is 1.)DOC")
+                                .Attr(
+                                    "ops",
+                                    "The operator types, in evaluation order.",
+                                    AttributeProto::STRINGS)
+                                .Attr(
+                                    "operands",
+                                    "The registers read by the operators, concatenated in evaluation order.",
+                                    AttributeProto::INTS)
+                                .Input(
+                                    0,
+                                    "inputs",
+                                    "",
+                                    "T1",
+                                    OpSchema::Variadic,
+                                    false)
+                                .Output(
+                                    0,
+                                    "Y",
+                                    "",
+                                    "T")
+                                .TypeConstraint("T", {"tensor(float)"}, "Constrain output type to float tensors")
+                                .TypeConstraint("T1", {"tensor(float)", "tensor(bool)"},
+                                                "Constrain input types to float and bool tensors")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  ctx.getOutputType(0)->mutable_tensor_type()->set_elem_type(
+                                      ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+                                  const auto num_inputs = ctx.getNumInputs();
+                                  if (!hasNInputShapes(ctx, static_cast<int>(num_inputs))) {
+                                    return;
+                                  }
+                                  std::vector<const ONNX_NAMESPACE::TensorShapeProto*> shapes;
+                                  for (size_t i = 0; i < num_inputs; ++i) {
+                                    shapes.push_back(&ctx.getInputType(i)->tensor_type().shape());
+                                  }
+                                  auto* output_shape = ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
+                                  multidirectionalBroadcastShapeInference(shapes, *output_shape);
+
+                                  // With reductions, track which registers hold one value per row of the last axis.
+                                  std::vector<std::string> ops;
+                                  std::vector<int64_t> operands;
+                                  getRepeatedAttribute(ctx, "ops", ops);
+                                  getRepeatedAttribute(ctx, "operands", operands);
+                                  if (std::none_of(ops.begin(), ops.end(), [](const std::string& op) {
+                                        return op == "ReduceMax" || op == "ReduceMean" || op == "ReduceSum";
+                                      })) {
+                                    return;
+                                  }
+
+                                  std::vector<bool> per_row;
+                                  for (const auto* shape : shapes) {
+                                    const int rank = shape->dim_size();
+                                    if (rank > 0 && !shape->dim(rank - 1).has_dim_value()) {
+                                      ctx.getOutputType(0)->mutable_tensor_type()->clear_shape();
+                                      return;
+                                    }
+                                    per_row.push_back(rank == 0 || shape->dim(rank - 1).dim_value() == 1);
+                                  }
+                                  size_t next_operand = 0;
+                                  for (const auto& op : ops) {
+                                    const bool is_reduction = op == "ReduceMax" || op == "ReduceMean" ||
+                                                              op == "ReduceSum";
+                                    const size_t num_operands = op == "Where" ? 3
+                                                                : (op == "Add" || op == "Sub" || op == "Mul" ||
+                                                                   op == "Div" || op == "Pow")
+                                                                    ? 2
+                                                                    : 1;
+                                    bool all_per_row = !is_reduction && op != "Softmax";
+                                    for (size_t j = 0; j < num_operands && next_operand < operands.size(); ++j) {
+                                      const auto reg = static_cast<size_t>(operands[next_operand++]);
+                                      all_per_row = all_per_row && reg < per_row.size() && per_row[reg];
+                                    }
+                                    per_row.push_back(is_reduction || all_per_row);
+                                  }
+
+                                  if (!per_row.empty() && per_row.back() && output_shape->dim_size() > 0) {
+                                    output_shape->mutable_dim(output_shape->dim_size() - 1)->set_dim_value(1);
+                                  }
+                                }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(FusedGemm, 1,
                             OpSchema()
                                 .SetDoc(R"DOC(
@@ -1933,6 +2251,94 @@ ONNX_MS_OPERATOR_SET_SCHEMA(Tokenizer, 1,
                                   updateOutputShape(ctx, 0, output_shape);
                                 }));
 
+constexpr const char* BpeTokenizer_ver1_doc = R"DOC(
+Tokenizes each string of X with a byte-level BPE model like the one of GPT-2.
+Every byte of the text is represented by a printable character, e.g. the space by 'Ġ' (U+0120), and each token of
+'vocab' is the string of the characters of its bytes. The text is split into words like GPT-2 does (contractions, runs
+of letters, digits or other characters with an optional leading space, and runs of spaces), then the characters of
+each word are merged pairwise in the order of 'merges' until no pair can be merged.
+The ids of the tokens of each string are padded with pad_token_id to the largest number of tokens of a string, so if
+the shape of X is [N], the shape of Y is [N, D].
+'vocab' and 'merges' must be initializers, they are loaded once when the session is created.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(BpeTokenizer, 1,
+                            OpSchema()
+                                .SetDoc(BpeTokenizer_ver1_doc)
+                                .Attr("unk_token_id",
+                                      "The id of tokens that are not in the vocabulary. A token outside of the "
+                                      "vocabulary is an error if it is negative. Default value is -1.",
+                                      AttributeProto::INT,
+                                      static_cast<int64_t>(-1))
+                                .Attr("pad_token_id",
+                                      "The id used to pad the tokens of the strings. Default value is 0.",
+                                      AttributeProto::INT,
+                                      static_cast<int64_t>(0))
+                                .Input(0, "X", "Strings to tokenize", "T")
+                                .Input(1, "vocab", "1D tensor with the token of each id.", "T")
+                                .Input(2, "merges",
+                                       "1D tensor with the pairs of tokens to merge as 'left right', in order of "
+                                       "priority.",
+                                       "T")
+                                .Output(0, "Y", "The token ids of each string, with one more dimension than X.",
+                                        "tensor(int64)")
+                                .Output(1, "Y_lengths", "The number of tokens of each string, with the shape of X.",
+                                        "tensor(int64)", OpSchema::Optional)
+                                .TypeConstraint("T", {"tensor(string)"}, "Input is a string tensor")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  updateOutputElemType(ctx, 0, ONNX_NAMESPACE::TensorProto::INT64);
+                                  if (ctx.getNumOutputs() > 1) {
+                                    updateOutputElemType(ctx, 1, ONNX_NAMESPACE::TensorProto::INT64);
+                                  }
+                                  if (!hasInputShape(ctx, 0)) {
+                                    return;
+                                  }
+
+                                  ONNX_NAMESPACE::TensorShapeProto output_shape = getInputShape(ctx, 0);
+                                  if (ctx.getNumOutputs() > 1) {
+                                    updateOutputShape(ctx, 1, output_shape);
+                                  }
+                                  output_shape.add_dim();
+                                  updateOutputShape(ctx, 0, output_shape);
+                                }));
+
+constexpr const char* BpeDetokenizer_ver1_doc = R"DOC(
+Converts the token ids along the last axis of ids back to text with the vocabulary of a byte-level BPE model like the
+one of GPT-2, which is the inverse of BpeTokenizer. The characters of the tokens that represent bytes are converted to
+the bytes, the other characters (e.g. of special tokens) are kept as they are. The tokens of skip_token_ids, such as
+padding or end of sequence, are left out.
+'vocab' must be an initializer, it is loaded once when the session is created.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(BpeDetokenizer, 1,
+                            OpSchema()
+                                .SetDoc(BpeDetokenizer_ver1_doc)
+                                .Attr("skip_token_ids",
+                                      "Ids of the tokens to leave out of the text.",
+                                      AttributeProto::INTS,
+                                      OPTIONAL_VALUE)
+                                .Input(0, "ids", "Token ids with shape [..., sequence_length]", "tensor(int64)")
+                                .Input(1, "vocab", "1D tensor with the token of each id.", "T")
+                                .Output(0, "Y", "The text of each sequence of ids, with one less dimension than ids.",
+                                        "T")
+                                .TypeConstraint("T", {"tensor(string)"}, "Output is a string tensor")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  updateOutputElemType(ctx, 0, ONNX_NAMESPACE::TensorProto::STRING);
+                                  if (!hasInputShape(ctx, 0)) {
+                                    return;
+                                  }
+
+                                  auto& input_shape = getInputShape(ctx, 0);
+                                  if (input_shape.dim_size() < 1) {
+                                    fail_shape_inference("Input ids must have at least one dimension");
+                                  }
+                                  ONNX_NAMESPACE::TensorShapeProto output_shape;
+                                  for (int i = 0; i < input_shape.dim_size() - 1; i++) {
+                                    *output_shape.add_dim() = input_shape.dim(i);
+                                  }
+                                  updateOutputShape(ctx, 0, output_shape);
+                                }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(MatMulInteger16, 1,
                             OpSchema()
                                 .SetDoc(R"DOC(
@@ -3429,6 +3835,12 @@ Input scales is stored in same type as original type of B(float32, float16) with
 Input zero_points is stored as uint8_t or same as type(A). It has the same packing method as input B.
   - [CeilDiv((N * n_blocks_per_col + 1) *bits, 8)]
   If zero_points has same type as A, it's not packed and has the same shape as Scales.
+
+Attribute activation fuses an elementwise epilogue applied after the bias is added:
+  - silu: Y = X * Sigmoid(X)
+  - gelu: Y = 0.5 * X * (1 + Erf(X / sqrt(2)))
+  - swiglu: the first N / 2 output features of B are the gate and the last N / 2 the up projection, and
+    Y = silu(gate) * up. The last dimension of Y is N / 2.
 )DOC";
 
   ONNX_CONTRIB_OPERATOR_SCHEMA(MatMulNBits)
@@ -3446,6 +3858,9 @@ Input zero_points is stored as uint8_t or same as type(A). It has the same packi
             "computation. 4 means input A can be quantized with the same block_size to int8 internally from "
             "type T1.",
             AttributeProto::INT, static_cast<int64_t>(0))
+      .Attr("activation",
+            "Activation applied to the output: silu, gelu or swiglu, see the op doc. (default none)",
+            AttributeProto::STRING, std::string(""))
       .Input(0, "A", "The input tensor, not quantized", "T1")
       .Input(1, "B", "1 or 2 dimensional data blob", "T2")
       .Input(2, "scales", "quantization scale", "T1")
@@ -3463,7 +3878,8 @@ Input zero_points is stored as uint8_t or same as type(A). It has the same packi
         // Shape inference
         int64_t in_features = getAttribute(ctx, "K", -1);
         int64_t out_features = getAttribute(ctx, "N", -1);
-        MatmulWithQuantWeightShapeInference(ctx, in_features, out_features, true);
+        const bool is_swiglu = getAttribute(ctx, "activation", "") == "swiglu";
+        MatmulWithQuantWeightShapeInference(ctx, in_features, is_swiglu ? out_features / 2 : out_features, true);
 
         // validate bias shape
         if (ctx.hasInput(5)) {
@@ -3480,6 +3896,59 @@ Input zero_points is stored as uint8_t or same as type(A). It has the same packi
         }
       });
 
+  static const char* GatherBlockQuantized_ver1_doc = R"DOC(
+GatherBlockQuantized is a Gather on axis 0 of a 2D [N, K] matrix that is quantized blockwise along its rows, in the
+same format as input B of MatMulNBits. Only the gathered rows are dequantized:
+  Y[i, k] = (data[indices[i], k] - zero_point) * scale
+where scale and zero_point are those of the block of `block_size` elements of the row that k belongs to.
+
+  Input data is stored as uint8_t with shape [N][n_blocks_per_row][blob_size], in which:
+  - n_blocks_per_row = (K + block_size - 1) / block_size
+  - blob_size = CeilDiv(block_size * bits, 8)
+  For 4 bits, element 2j of a block is stored in the low 4 bits of byte j and element 2j+1 in the high 4 bits.
+
+Input scales has shape [N * n_blocks_per_row]. Input zero_points is optional and is either stored as uint8_t with
+the same packing as data, i.e. CeilDiv(n_blocks_per_row * bits, 8) bytes per row, or unpacked with the type and
+shape of scales. The zero point defaults to 2^(bits - 1).
+)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(GatherBlockQuantized)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(GatherBlockQuantized_ver1_doc)
+      .Attr("K", "size of each row of the dequantized matrix", AttributeProto::INT)
+      .Attr("bits", "number of bits used for quantization, 4 or 8 (default 4)", AttributeProto::INT,
+            static_cast<int64_t>(4))
+      .Attr("block_size",
+            "number of elements of a row sharing a scale and zero point (default 128). It needs to be a power of 2 "
+            "and not smaller than 16.",
+            AttributeProto::INT, static_cast<int64_t>(128))
+      .Input(0, "data", "The quantized matrix", "T2")
+      .Input(1, "indices", "Indices of the rows to gather. Negative indices count from the end.", "Tind")
+      .Input(2, "scales", "quantization scales", "T1")
+      .Input(3, "zero_points", "quantization zero points", "T3", OpSchema::Optional)
+      .Output(0, "Y", "Dequantized rows with shape indices.shape + [K].", "T1")
+      .TypeConstraint("T1", {"tensor(float)", "tensor(float16)"}, "Constrain output types to float/half_float tensors.")
+      .TypeConstraint("T2", {"tensor(uint8)"}, "Constrain quantized data types to uint8.")
+      .TypeConstraint("T3", {"tensor(uint8)", "tensor(float16)", "tensor(float)"},
+                      "Constrain quantized zero point types to uint8/float16/float.")
+      .TypeConstraint("Tind", {"tensor(int32)", "tensor(int64)"}, "Constrain indices to integer types.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 2, 0);
+        if (!hasInputShape(ctx, 1)) {
+          return;
+        }
+
+        const int64_t row_size = getAttribute(ctx, "K", -1);
+        if (row_size <= 0) {
+          fail_shape_inference("K must be a positive value.");
+        }
+
+        ONNX_NAMESPACE::TensorShapeProto output_shape = getInputShape(ctx, 1);
+        output_shape.add_dim()->set_dim_value(row_size);
+        updateOutputShape(ctx, 0, output_shape);
+      });
+
   static const char* MatMulBnb4_ver1_doc = R"DOC(
 MatMulBnb4 is a MatMul with weight quantized with 4 bits using either FP4 or NF4 data type (https://arxiv.org/pdf/2305.14314.pdf). It does Matrix Multiplication like MatMul (https://github.com/onnx/onnx/blob/main/docs/Operators.md#matmul) with differences:
   1. Input B is a 2D constant Matrix. Its input feature count and output feature count are specified by attribute 'K' and 'N'.
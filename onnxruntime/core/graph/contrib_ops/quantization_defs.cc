@@ -400,6 +400,10 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                "T2", OpSchema::Optional)
         .Input(4, "bias", "1D input tensor, whose dimension is same as B's last dimension", "T1", OpSchema::Optional)
         .Output(0, "Y", "Matrix multiply results from A * B", "T1")
+        .Attr("per_row_a_quantization",
+              "If set to 1, each row of A is quantized symmetrically with its own scale instead of quantizing A "
+              "with one scale. This limits the effect of outliers to the rows that contain them.",
+              AttributeProto::INT, static_cast<int64_t>(0))
         .TypeConstraint("T1", {"tensor(float)"}, "Constrain input A, b_scale and output Y data type as float tensor.")
         .TypeConstraint("T2", {"tensor(int8)", "tensor(uint8)"}, "Constrain input B data type to 8-bit integer tensor.")
         .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
@@ -870,7 +874,8 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
         .Input(0, "A",
                "Input tensor A. "
                "The shape of A should be (M, K) if transA is 0, "
-               "or (K, M) if transA is non-zero.",
+               "or (K, M) if transA is non-zero. "
+               "If transA is 0, A may also have more than 2 dimensions, which are flattened into M as in MatMul.",
                "TA")
         .Input(1, "a_scale",
                "Scale of quantized input 'A'. "
@@ -910,7 +915,10 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                "It is optional. The output is full precision(float32) if it is not provided. "
                "Or the output is quantized.",
                "TYZ", OpSchema::Optional)
-        .Output(0, "Y", "Output tensor of shape (M, N).", "TY")
+        .Output(0, "Y",
+                "Output tensor of shape (M, N). If A has more than 2 dimensions, the shape of Y is the shape of A "
+                "with the last dimension replaced by N.",
+                "TY")
         .Attr("transA", "Whether A should be transposed", AttributeProto::INT, static_cast<int64_t>(0))
         .Attr("transB", "Whether B should be transposed", AttributeProto::INT, static_cast<int64_t>(0))
         .Attr("alpha", "Scalar multiplier for the product of input tensors A * B.", AttributeProto::FLOAT, 1.0f)
@@ -937,13 +945,19 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
             bool transB = transBAttr ? static_cast<int>(transBAttr->i()) != 0 : false;
             auto& first_input_shape = getInputShape(ctx, 0);
             auto& second_input_shape = getInputShape(ctx, 3);
-            if (first_input_shape.dim_size() != 2) {
-              fail_shape_inference("First input does not have rank 2");
+            if (first_input_shape.dim_size() < 2 || (transA && first_input_shape.dim_size() != 2)) {
+              fail_shape_inference("First input does not have rank 2, or rank 2 or more if transA is not set");
             }
             if (second_input_shape.dim_size() != 2) {
               fail_shape_inference("Second input does not have rank 2");
             }
-            updateOutputShape(ctx, 0, {first_input_shape.dim(transA ? 1 : 0), second_input_shape.dim(transB ? 0 : 1)});
+            if (first_input_shape.dim_size() > 2) {
+              ONNX_NAMESPACE::TensorShapeProto output_shape(first_input_shape);
+              *output_shape.mutable_dim(output_shape.dim_size() - 1) = second_input_shape.dim(transB ? 0 : 1);
+              updateOutputShape(ctx, 0, output_shape);
+            } else {
+              updateOutputShape(ctx, 0, {first_input_shape.dim(transA ? 1 : 0), second_input_shape.dim(transB ? 0 : 1)});
+            }
           }
         }));
 ONNX_MS_OPERATOR_SET_SCHEMA(
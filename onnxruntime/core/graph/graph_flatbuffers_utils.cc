@@ -8,6 +8,7 @@
 #include "core/common/narrow.h"
 #include "core/flatbuffers/flatbuffers_utils.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
+#include "core/flatbuffers/tensor_data_compression.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/tensor_external_data_info.h"
 #include "core/graph/graph.h"
@@ -30,7 +31,8 @@ Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
                                 const TensorProto& initializer,
                                 const std::filesystem::path& model_path,
                                 flatbuffers::Offset<fbs::Tensor>& fbs_tensor,
-                                const ExternalDataWriter& external_writer) {
+                                const ExternalDataWriter& external_writer,
+                                fbs::TensorDataCompression compression) {
   auto name = SaveStringToOrtFormat(builder, initializer.has_name(), initializer.name());
   auto doc_string = SaveStringToOrtFormat(builder, initializer.has_doc_string(), initializer.doc_string());
   auto dims = SaveDims(builder, initializer.dims());
@@ -40,6 +42,7 @@ Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
   flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> string_data;
   flatbuffers::Offset<flatbuffers::Vector<uint8_t>> raw_data;
   int64_t external_data_offset = -1;
+  auto applied_compression = fbs::TensorDataCompression::NONE;
 
   auto src_type = initializer.data_type();
   const bool has_string_data = src_type == ONNX_NAMESPACE::TensorProto_DataType_STRING;
@@ -58,7 +61,25 @@ Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
       ORT_RETURN_IF_ERROR(external_writer(src_type, unpacked_tensor, offset));
       external_data_offset = onnxruntime::narrow<int64_t>(offset);  // offset in fb is int64_t so -1 can mark not in use
     } else {
-      raw_data = builder.CreateVector(unpacked_tensor.data(), unpacked_tensor.size());
+      // complex types are excluded as the loader can't infer their size from the data type
+      const bool can_compress = compression != fbs::TensorDataCompression::NONE &&
+                                unpacked_tensor.size() >= kMinimumSizeForCompression &&
+                                src_type != ONNX_NAMESPACE::TensorProto_DataType_COMPLEX64 &&
+                                src_type != ONNX_NAMESPACE::TensorProto_DataType_COMPLEX128;
+      std::vector<uint8_t> compressed_tensor;
+      if (can_compress) {
+        const size_t num_elements = std::accumulate(initializer.dims().cbegin(), initializer.dims().cend(),
+                                                    SafeInt<size_t>(1), std::multiplies<>());
+        const size_t element_size = num_elements > 0 ? unpacked_tensor.size() / num_elements : 1;
+        ORT_RETURN_IF_ERROR(CompressTensorData(compression, element_size, unpacked_tensor, compressed_tensor));
+      }
+
+      if (can_compress && compressed_tensor.size() < unpacked_tensor.size()) {
+        raw_data = builder.CreateVector(compressed_tensor.data(), compressed_tensor.size());
+        applied_compression = compression;
+      } else {
+        raw_data = builder.CreateVector(unpacked_tensor.data(), unpacked_tensor.size());
+      }
     }
   }
 
@@ -75,6 +96,7 @@ Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
       tb.add_external_data_offset(external_data_offset);
     } else {
       tb.add_raw_data(raw_data);
+      tb.add_compression(applied_compression);
     }
   }
   fbs_tensor = tb.Finish();
@@ -298,7 +320,22 @@ Status LoadInitializerOrtFormat(const fbs::Tensor& fbs_tensor, TensorProto& init
     }
   } else {
     const auto* fbs_raw_data = fbs_tensor.raw_data();
-    if (fbs_raw_data) {
+    const auto compression = fbs_tensor.compression();
+    if (fbs_raw_data && compression != fbs::TensorDataCompression::NONE) {
+      // decompress directly into the TensorProto. the uncompressed size is implied by the dims and data type.
+      const size_t num_bytes = GetSizeInBytesFromFbsTensor(fbs_tensor);
+      const size_t num_elements = std::accumulate(fbs_dims->cbegin(), fbs_dims->cend(), SafeInt<size_t>(1),
+                                                  std::multiplies<>());
+      const size_t element_size = num_elements > 0 ? num_bytes / num_elements : 1;
+
+      std::string& raw_data = *initializer.mutable_raw_data();
+      raw_data.resize(num_bytes);
+      auto output_buffer = gsl::make_span<uint8_t>(reinterpret_cast<uint8_t*>(raw_data.data()), num_bytes);
+
+      ORT_RETURN_IF_ERROR(DecompressTensorData(compression, element_size,
+                                               gsl::make_span(fbs_raw_data->Data(), fbs_raw_data->size()),
+                                               output_buffer));
+    } else if (fbs_raw_data) {
       if (load_options.can_use_flatbuffer_for_initializers && fbs_raw_data->size() > 127) {
         initializer.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
 
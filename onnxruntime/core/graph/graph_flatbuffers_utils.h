@@ -34,6 +34,7 @@ class Logger;
 namespace fbs {
 struct Attribute;
 struct Tensor;
+enum class TensorDataCompression : int8_t;
 
 #if !defined(DISABLE_SPARSE_TENSORS)
 struct SparseTensor;
@@ -61,6 +62,13 @@ using ExternalDataReader = std::function<Status(uint64_t offset, gsl::span<uint8
 /// </remarks>
 constexpr uint32_t kMinimumSizeForExternalData = 64;
 
+/// <summary>
+/// Minimum number of bytes for raw data to be compressed when saving with compression.
+/// </summary>
+/// <remarks>matches the size above which the loader would otherwise use the flatbuffer data in place, so small values
+/// keep that ability.</remarks>
+constexpr size_t kMinimumSizeForCompression = 128;
+
 /// <summary>
 /// Save an initializer to an ORT format flatbuffer.
 /// </summary>
@@ -70,10 +78,14 @@ constexpr uint32_t kMinimumSizeForExternalData = 64;
 /// <param name="fbs_tensor">Tensor in flatbuffer.</param>
 /// <param name="external_writer">Optional delegate to write the initializer data to an external file
 /// if the initializer contains kMinimumSizeForExternalData bytes or more, and not string data.</param>
+/// <param name="compression">Compression to apply to raw data of kMinimumSizeForCompression bytes or more that is
+/// not written with external_writer. The data is stored uncompressed if compressing does not make it smaller.
+/// Value-initialized to TensorDataCompression::NONE.</param>
 Status SaveInitializerOrtFormat(
     flatbuffers::FlatBufferBuilder& builder, const ONNX_NAMESPACE::TensorProto& initializer,
     const std::filesystem::path& model_path, flatbuffers::Offset<fbs::Tensor>& fbs_tensor,
-    const ExternalDataWriter& external_writer = nullptr);
+    const ExternalDataWriter& external_writer = nullptr,
+    fbs::TensorDataCompression compression = fbs::TensorDataCompression{});
 
 #if !defined(DISABLE_SPARSE_TENSORS)
 Status SaveSparseInitializerOrtFormat(
@@ -92,6 +104,7 @@ Status SaveAttributeOrtFormat(
 
 /// <summary>
 /// Load an initializer from an ORT format flatbuffer.
+/// Compressed raw data is decompressed into the TensorProto, so it is never used in place.
 /// </summary>
 /// <param name="fbs_tensor">Flatbuffer Tensor</param>
 /// <param name="initializer">TensorProto to load data into</param>
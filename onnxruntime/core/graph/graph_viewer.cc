@@ -53,6 +53,26 @@ GraphViewer::GraphViewer(const Graph& graph, const IndexedSubGraph& filter_info)
     : GraphViewer(graph, &filter_info) {
 }
 
+#ifdef ENABLE_TRAINING
+namespace {
+
+bool IsHostOffloadCopy(const Node& node) {
+  if (node.OpType() != "MemcpyToHost" || node.OutputNodesBegin() == node.OutputNodesEnd()) {
+    return false;
+  }
+
+  for (auto it = node.OutputNodesBegin(), end = node.OutputNodesEnd(); it != end; ++it) {
+    if (it->OpType() != "MemcpyFromHost") {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+#endif
+
 GraphViewer::GraphViewer(const Graph& graph, const IndexedSubGraph* filter_info)
     : graph_{&graph},
       // we can setup the filter here if needed. filtered_node_indices_ will have been populated by the time it's used
@@ -69,6 +89,8 @@ GraphViewer::GraphViewer(const Graph& graph, const IndexedSubGraph* filter_info)
   // right after their parents. This is to make sure the shape and size nodes are executed right after their parents
   // so it's possible the input tensor memory can be released as soon as possible. This is especially important
   // for non-CPU devices or for training case where some gradient graphs use only shape/size of tensors from forward.
+  // A MemcpyToHost only feeding MemcpyFromHost copies is an activation offloaded to host memory, it is handled the
+  // same way so that the device buffer can be released during forward pass.
   InlinedHashSet<NodeIndex> shape_size_nodes;
   InlinedHashMap<NodeIndex, InlinedVector<NodeIndex>> shape_size_parents;
 #endif
@@ -82,7 +104,8 @@ GraphViewer::GraphViewer(const Graph& graph, const IndexedSubGraph* filter_info)
       root_nodes_.push_back(node.Index());
     }
 #ifdef ENABLE_TRAINING
-    if ((node.OpType() == "Shape" || node.OpType() == "Size") && node.InputEdgesBegin() != node.InputEdgesEnd()) {
+    if ((node.OpType() == "Shape" || node.OpType() == "Size" || IsHostOffloadCopy(node)) &&
+        node.InputEdgesBegin() != node.InputEdgesEnd()) {
       shape_size_nodes.insert(node.Index());
       NodeIndex parent = node.InputNodesBegin()->Index();
       if (shape_size_parents.find(parent) == shape_size_parents.end()) {
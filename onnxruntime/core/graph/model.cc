@@ -777,7 +777,8 @@ Status Model::SaveWithExternalInitializers(Model& model,
 }
 
 common::Status Model::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
-                                      flatbuffers::Offset<fbs::Model>& fbs_model) const {
+                                      flatbuffers::Offset<fbs::Model>& fbs_model,
+                                      fbs::TensorDataCompression initializer_compression) const {
   auto producer_name = fbs::utils::SaveStringToOrtFormat(
       builder, model_proto_.has_producer_name(), model_proto_.producer_name());
   auto producer_version = fbs::utils::SaveStringToOrtFormat(
@@ -815,7 +816,7 @@ common::Status Model::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
   }
 
   flatbuffers::Offset<fbs::Graph> fbs_graph;
-  ORT_RETURN_IF_ERROR(graph_->SaveToOrtFormat(builder, fbs_graph));
+  ORT_RETURN_IF_ERROR(graph_->SaveToOrtFormat(builder, fbs_graph, initializer_compression));
 
   fbs::ModelBuilder mb(builder);
   mb.add_ir_version(IrVersion());
@@ -22,6 +22,7 @@ namespace onnxruntime {
 
 namespace fbs {
 struct Model;
+enum class TensorDataCompression : int8_t;
 }  // namespace fbs
 
 typedef std::unordered_map<std::string, std::string> ModelMetaData;
@@ -276,8 +277,11 @@ class Model {
                              const logging::Logger& logger,
                              const ModelOptions& options = {});
 
+  // initializer_compression applies to the initializers of the main graph. Subgraph initializers are not compressed.
   common::Status SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
-                                 flatbuffers::Offset<onnxruntime::fbs::Model>& model) const;
+                                 flatbuffers::Offset<onnxruntime::fbs::Model>& model,
+                                 fbs::TensorDataCompression initializer_compression =
+                                     fbs::TensorDataCompression{}) const;
 
   /// <summary>
   /// Frees local function definitions in the model, excluding those in the `retained` set.
@@ -64,6 +64,9 @@ Abstract:
 #define MLAS_TARGET_WASM
 #if defined(__wasm_simd128__)
 #define MLAS_TARGET_WASM_SIMD
+#if defined(__wasm_relaxed_simd__)
+#define MLAS_TARGET_WASM_RELAXED_SIMD
+#endif
 #else
 #define MLAS_TARGET_WASM_SCALAR
 #endif
@@ -212,6 +215,9 @@ struct MLAS_SGEMM_DATA_PARAMS {
     float alpha = 1.0f;       /**< Supplies the scalar alpha multiplier (see SGEMM definition) */
     float beta = 0.0f;        /**< Supplies the scalar beta multiplier (see SGEMM definition) */
     bool BIsPacked = false;   /**< Whether B is pre-packed */
+    /**< Optional copies of the pre-packed B, one in the memory of each NUMA node the thread pool spans, indexed
+         like onnxruntime::concurrency::ThreadPool::GetNumaNodes. Each thread reads the copy of its node. */
+    const float* const* BNumaReplicas = nullptr;
 };
 
 /**
@@ -241,6 +247,42 @@ MlasGemmBatch(
     MLAS_THREADPOOL* ThreadPool
     );
 
+/**
+ * @brief Supply the shape and the matrices data of one group of a grouped
+ *        single precision gemm operation
+ */
+struct MLAS_SGEMM_GROUP_PARAMS {
+    size_t M = 0;                /**< Supplies the number of rows of matrix A and matrix C. */
+    size_t N = 0;                /**< Supplies the number of columns of matrix B and matrix C. */
+    size_t K = 0;                /**< Supplies the number of columns of matrix A and rows of matrix B. */
+    MLAS_SGEMM_DATA_PARAMS Data; /**< Supplies the matrices data parameters */
+};
+
+/**
+ * @brief  Grouped single precision matrix/matrix multiply operation (SGEMM)
+ *
+ *         Each group is an independent multiplication with its own shape,
+ *         for example the tokens routed to one expert of a mixture of experts
+ *         layer. The tiles of all the groups are scheduled on the thread pool
+ *         together, so that many small groups keep all the threads busy.
+ *
+ * @param TransA      Supplies the transpose operation for matrix A.
+ * @param TransB      Supplies the transpose operation for matrix B.
+ * @param Groups      Supplies an array of group parameters
+ * @param GroupCount  Supplies the number of groups
+ * @param ThreadPool  Supplies the thread pool object to use, else nullptr if the
+                      base library threading support should be used.
+ */
+void
+MLASCALL
+MlasGemmGrouped(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    const MLAS_SGEMM_GROUP_PARAMS* Groups,
+    size_t GroupCount,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 /**
  * @brief  Single precision matrix/matrix multiply operation (SGEMM)
  *
@@ -673,6 +715,77 @@ MlasSymmQgemmBatch(
     MLAS_THREADPOOL* ThreadPool
     );
 
+/**
+ * @brief Returns the size of the buffer needed by MlasSparse24GemmPackB.
+ *
+ * @param N     Supplies the number of columns of matrix B
+ * @param K     Supplies the number of rows of matrix B
+ */
+size_t
+MLASCALL
+MlasSparse24GemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+/**
+ * @brief Packs a matrix B with 2:4 structured sparsity along K, i.e. at most two of
+ *        each group of four consecutive elements of a column are non-zero. Only the
+ *        non-zero elements and their positions in the group are kept.
+ *
+ * @param TransB    Supplies the transpose operation of matrix B
+ * @param N         Supplies the number of columns of matrix B
+ * @param K         Supplies the number of rows of matrix B
+ * @param B         Supplies matrix B
+ * @param ldb       Supplies the first dimension of matrix B
+ * @param PackedB   Supplies the buffer of MlasSparse24GemmPackBSize(N, K) bytes
+ *
+ * @return false if B doesn't have the 2:4 sparsity, the content of PackedB is undefined then.
+ */
+bool
+MLASCALL
+MlasSparse24GemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+/**
+ * @brief Computes C = alpha * op(A) * B for a matrix B packed by MlasSparse24GemmPackB,
+ *        skipping the zero elements of B.
+ *
+ * @param TransA        Supplies the transpose operation of matrix A
+ * @param M             Supplies the number of rows of matrix C
+ * @param N             Supplies the number of columns of matrix C
+ * @param K             Supplies the number of columns of op(A)
+ * @param alpha         Supplies the scalar multiplier
+ * @param A             Supplies matrix A
+ * @param lda           Supplies the first dimension of matrix A
+ * @param PackedB       Supplies the packed matrix B
+ * @param C             Supplies matrix C
+ * @param ldc           Supplies the first dimension of matrix C
+ * @param ThreadPool    Supplies the thread pool object to use, else nullptr if the
+ *                      base library threading support should be used.
+ */
+void
+MLASCALL
+MlasSparse24Gemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 
 //
 // Buffer packing routines.
@@ -757,6 +870,7 @@ enum MLAS_CONV_ALGORITHM {
 #if defined(MLAS_TARGET_WASM_SCALAR)
     MlasConvAlgorithmDepthwise,
 #endif
+    MlasConvAlgorithmWinograd,
 };
 
 struct MLAS_CONV_PARAMETERS {
@@ -786,6 +900,9 @@ struct MLAS_CONV_PARAMETERS {
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            size_t TileBlock;
+        } Winograd;
     } u;
 };
 
@@ -805,7 +922,8 @@ MlasConvPrepare(MLAS_CONV_PARAMETERS* Parameters,
                 const MLAS_ACTIVATION* Activation,
                 size_t* WorkingBufferSize,
                 float Beta,
-                MLAS_THREADPOOL* ThreadPool);
+                MLAS_THREADPOOL* ThreadPool,
+                bool WinogradFilterPacked = false);
 
 void
 MLASCALL
@@ -819,6 +937,60 @@ MlasConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Depthwise convolution fused with the following pointwise convolution. The
+// depthwise output is computed in cache sized tiles that are consumed by the
+// pointwise convolution without being written to memory.
+//
+
+void
+MLASCALL
+MlasConvDepthwisePointwise(
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    const float* Input,
+    const float* DepthwiseFilter,
+    const float* DepthwiseBias,
+    const MLAS_ACTIVATION* DepthwiseActivation,
+    const float* PointwiseFilter,
+    const float* PointwiseBias,
+    const MLAS_ACTIVATION* PointwiseActivation,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Winograd F(4x4, 3x3) convolution routines.
+//
+// A two dimensional 3x3 convolution with unit strides and dilations runs the
+// Winograd algorithm if its filter has been packed with
+// MlasConvWinogradPackFilter and MlasConvPrepare is told so. The packed filter
+// is then passed to MlasConv in place of the filter. The results are not bit
+// exact with the other algorithms.
+//
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels
+    );
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    float* PackedFilter
+    );
+
 void
 MLASCALL
 MlasConvDepthwise(
@@ -1016,6 +1188,139 @@ MlasComputeSoftmax(
     MLAS_THREADPOOL* ThreadPool
     );
 
+/**
+ * @brief Parameters of the fused scaled dot product attention computed by MlasFlashAttention.
+ *
+ * The Q/K/V and mask element of a row are contiguous. Q, K and V of a head are row major
+ * matrices of shape SxH, LxH and LxH_v, where S and L are QSequenceLength and KvSequenceLength.
+ * Head n of Q uses the head n / (NumHeads / KvNumHeads) of K and V.
+ */
+struct MLAS_FLASH_ATTENTION_PARAMS {
+    size_t BatchSize = 0;           ///< B
+    size_t NumHeads = 0;            ///< N, number of heads of Q and of the output
+    size_t KvNumHeads = 0;          ///< number of heads of K and V, NumHeads must be a multiple of it
+    size_t QSequenceLength = 0;     ///< S
+    size_t KvSequenceLength = 0;    ///< L, rows of each head of K and V
+    size_t QkHeadSize = 0;          ///< H
+    size_t VHeadSize = 0;           ///< H_v
+    float Scale = 1.0f;             ///< scale of Q*K'
+
+    const float* Query = nullptr;   ///< head n of batch b at Query + b * QueryBatchStride + n * QueryHeadStride
+    size_t QueryBatchStride = 0;
+    size_t QueryHeadStride = 0;
+    const float* Key = nullptr;     ///< head n of batch b at Key + b * KeyBatchStride + n * KeyHeadStride
+    size_t KeyBatchStride = 0;
+    size_t KeyHeadStride = 0;
+    const float* Value = nullptr;   ///< head n of batch b at Value + b * ValueBatchStride + n * ValueHeadStride
+    size_t ValueBatchStride = 0;
+    size_t ValueHeadStride = 0;
+
+    const float* Mask = nullptr;    ///< optional additive mask of shape SxL per batch, shared by the heads
+    size_t MaskBatchStride = 0;     ///< 0 to use the same mask for all the batches
+
+    const int32_t* KvValidLengths = nullptr;  ///< optional number of valid rows of K and V of each batch
+    bool Causal = false;            ///< if true, query row i only attends to key rows j <= i
+    size_t LocalWindowSize = 0;     ///< if not 0 and Causal, query row i only attends to key rows j >= i - LocalWindowSize
+
+    const uint8_t* BlockLayout = nullptr;  ///< optional ceil(S/SparseBlockSize) x ceil(L/SparseBlockSize) matrix shared
+                                           ///< by the batches and heads, blocks of keys with 0 are skipped
+    size_t SparseBlockSize = 0;     ///< rows of Q and of K/V of a block of BlockLayout, overrides the block sizes below
+
+    float* Output = nullptr;        ///< BxSxNxH_v
+    size_t OutputRowStride = 0;     ///< elements between the rows of Output, 0 for NumHeads * VHeadSize
+
+    size_t QBlockSize = 0;          ///< rows of Q processed together, 0 for the default
+    size_t KvBlockSize = 0;         ///< rows of K and V processed together, 0 for the default
+};
+
+/**
+ * @brief Computes Output = Softmax(Scale * Q * K' + Mask) * V without materializing the matrix of
+ *        attention scores. Q is processed in blocks of rows and K/V in blocks of rows, keeping a
+ *        running maximum and sum of each softmax row (online softmax), so the working set of a
+ *        thread is a block of scores instead of a SxL matrix per head.
+ *
+ * @param Params       Supplies the attention parameters
+ * @param ThreadPool   Supplies the thread pool object to use, else nullptr if the
+ *                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasFlashAttention(
+    const MLAS_FLASH_ATTENTION_PARAMS& Params,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief Parameters of the layer normalization computed by MlasLayerNormalization.
+ *
+ * The tensors are row major with RowSize elements per row. Row r of the input uses row
+ * r % SkipRowCount of Skip, so a skip tensor can be broadcast over the leading dimensions.
+ *
+ * @tparam T   float or MLAS_FP16. Half precision rows are normalized in float.
+ */
+template <typename T>
+struct MLAS_LAYER_NORM_PARAMS {
+    size_t RowCount = 0;
+    size_t RowSize = 0;
+
+    const T* Input = nullptr;       ///< RowCount x RowSize
+    const T* Skip = nullptr;        ///< optional SkipRowCount x RowSize residual added to the input
+    size_t SkipRowCount = 1;
+    const T* Bias = nullptr;        ///< optional RowSize bias added to the input
+    const T* Gamma = nullptr;       ///< RowSize scale
+    const T* Beta = nullptr;        ///< optional RowSize shift, not used if Simplified
+
+    T* Output = nullptr;            ///< RowCount x RowSize
+    T* SkipBiasSum = nullptr;       ///< optional RowCount x RowSize sum of the input, skip and bias
+    float* Mean = nullptr;          ///< optional RowCount means, zero if Simplified
+    float* InvStdDev = nullptr;     ///< optional RowCount reciprocals of the standard deviation
+
+    float Epsilon = 0.0f;
+    bool Simplified = false;        ///< if true, computes RMS normalization (no mean, no Beta)
+};
+
+/**
+ * @brief Computes Output = (X - Mean(X)) / Sqrt(Var(X) + Epsilon) * Gamma + Beta for each row,
+ *        where X = Input + Skip + Bias. The sum and sum of squares of a row are accumulated in
+ *        the same pass that forms X, so each row is read from memory once.
+ *
+ * @param Params       Supplies the normalization parameters
+ * @param ThreadPool   Supplies the thread pool object to use, else nullptr if the
+ *                     base library threading support should be used.
+ */
+template <typename T>
+void
+MLASCALL
+MlasLayerNormalization(
+    const MLAS_LAYER_NORM_PARAMS<T>& Params,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief Applies rotary position embedding to the first RotaryEmbeddingDim elements of a row.
+ *
+ *        In interleaved mode, elements 2i and 2i+1 form pair i. Otherwise element i is paired
+ *        with element i + RotaryEmbeddingDim / 2. Each pair (x, y) becomes
+ *        (x * Cos[i] - y * Sin[i], y * Cos[i] + x * Sin[i]).
+ *
+ * @param Input               Supplies the input row
+ * @param Sin                 Supplies RotaryEmbeddingDim / 2 sine values
+ * @param Cos                 Supplies RotaryEmbeddingDim / 2 cosine values
+ * @param RotaryEmbeddingDim  Supplies the number of rotated elements, a multiple of 2
+ * @param Interleaved         Supplies true if the pairs are adjacent elements
+ * @param Output              Supplies the output row, which may be the input row
+ */
+void
+MLASCALL
+MlasRotaryEmbedOneRow(
+    const float* Input,
+    const float* Sin,
+    const float* Cos,
+    size_t RotaryEmbeddingDim,
+    bool Interleaved,
+    float* Output
+    );
+
 void
 MLASCALL
 MlasComputeTanh(
@@ -1037,6 +1342,14 @@ MlasConvertHalfToFloatBuffer(
     size_t Count
     );
 
+void
+MLASCALL
+MlasConvertFloatToHalfBuffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
 //
 // Transpose routines.
 //
@@ -1432,6 +1745,14 @@ constexpr size_t FP16_SIZE = sizeof(uint16_t);
 bool MLASCALL
 MlasFp16AccelerationSupported();
 
+/**
+ * @brief Whether current CPU has a vectorized MlasHalfGemmBatch kernel.
+ *        This is wider than MlasFp16AccelerationSupported on x64, where
+ *        the half gemm kernels accumulate in fp32 using F16C conversions.
+*/
+bool MLASCALL
+MlasHalfGemmAccelerationSupported();
+
 /**
  * @brief Interface for half gemm post processors.
  *
@@ -1634,7 +1955,11 @@ MlasHalfGemmConvertPackB(
     void* PackedB
     );
 
-#if defined(__aarch64__) && defined(__linux__)
+#if (defined(__aarch64__) && defined(__linux__)) || defined(MLAS_TARGET_AMD64)
+#define MLAS_SBGEMM_SUPPORTED
+#endif
+
+#if defined(MLAS_SBGEMM_SUPPORTED)
 /**
  * @brief Whether current CPU supports Bfloat16(bf16) acceleration.
  */
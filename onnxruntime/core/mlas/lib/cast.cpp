@@ -0,0 +1,153 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cast.cpp
+
+Abstract:
+
+    This module implements the conversion of a buffer of single precision
+    floating point values to half precision.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasCastF32ToF16Kernel(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to convert a buffer of single
+    precision floating point values to half precision, rounding to nearest
+    even.
+
+Arguments:
+
+    Source - Supplies the buffer of single precision values.
+
+    Destination - Supplies the buffer to receive the half precision values.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t i = 0;
+
+#if defined(MLAS_NEON64_INTRINSICS)
+    for (; i + 8 <= Count; i += 8) {
+
+        float16x4_t Low = vcvt_f16_f32(vld1q_f32(Source + i));
+        float16x4_t High = vcvt_f16_f32(vld1q_f32(Source + i + 4));
+
+        vst1q_u16(Destination + i, vreinterpretq_u16_f16(vcombine_f16(Low, High)));
+    }
+#endif
+
+    for (; i < Count; i++) {
+        Destination[i] = MLAS_Float2Half(Source[i]);
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalfBuffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of single precision floating point values
+    to half precision, rounding to nearest even. Values outside of the half
+    precision range become infinity.
+
+Arguments:
+
+    Source - Supplies the buffer of single precision values.
+
+    Destination - Supplies the buffer to receive the half precision values.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().CastF32ToF16Kernel(Source, Destination, Count);
+#else
+    MlasCastF32ToF16Kernel(Source, Destination, Count);
+#endif
+}
+
+#if !defined(MLAS_TARGET_AMD64)
+
+//
+// The AMD64 targets implement this routine in assembly.
+//
+
+void
+MLASCALL
+MlasConvertHalfToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of half precision floating point values to
+    single precision.
+
+Arguments:
+
+    Source - Supplies the buffer of half precision values.
+
+    Destination - Supplies the buffer to receive the single precision values.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t i = 0;
+
+#if defined(MLAS_NEON64_INTRINSICS)
+    for (; i + 8 <= Count; i += 8) {
+
+        float16x8_t Half = vreinterpretq_f16_u16(vld1q_u16(Source + i));
+
+        vst1q_f32(Destination + i, vcvt_f32_f16(vget_low_f16(Half)));
+        vst1q_f32(Destination + i + 4, vcvt_f32_f16(vget_high_f16(Half)));
+    }
+#endif
+
+    for (; i < Count; i++) {
+        Destination[i] = MLAS_Half2Float(Source[i]);
+    }
+}
+
+#endif
@@ -867,13 +867,19 @@ Return Value:
 
     const size_t InputGroupSize = Parameters->InputChannels * Parameters->InputSize;
     const size_t OutputGroupSize = FilterCount * OutputSize;
-    const size_t FilterGroupSize = FilterCount * K;
-
     const size_t BatchCount = Parameters->BatchCount;
     const size_t GroupCount = Parameters->GroupCount;
 
     const MLAS_CONV_ALGORITHM Algorithm = Parameters->Algorithm;
 
+    //
+    // The Winograd algorithm is supplied the packed filter, which holds 36
+    // transformed elements for each filter and input channel.
+    //
+
+    const size_t FilterGroupSize = (Algorithm == MlasConvAlgorithmWinograd) ?
+        36 * FilterCount * Parameters->InputChannels : FilterCount * K;
+
     //
     // Schedule batches of GEMMs across multiple threads.
     //
@@ -987,6 +993,20 @@ Return Value:
 
 #endif
 
+                case MlasConvAlgorithmWinograd:
+                {
+                    MlasConvWinograd(Parameters, Input, filter, WorkingBuffer, Output, ThreadPool);
+
+                    //
+                    // Apply the activation with optional bias.
+                    //
+
+                    MlasActivation(Parameters->Activation, Output, bias, FilterCount,
+                        OutputSize, OutputSize);
+
+                    break;
+                }
+
                 case MlasConvAlgorithmExpandThenGemmSegmented:
                 {
                     //
@@ -1041,7 +1061,8 @@ MlasConvPrepare(
     const MLAS_ACTIVATION* Activation,
     size_t* WorkingBufferSize,
     float Beta,
-    MLAS_THREADPOOL* ThreadPool
+    MLAS_THREADPOOL* ThreadPool,
+    bool WinogradFilterPacked
     )
 /*++
 
@@ -1088,6 +1109,10 @@ Arguments:
     ThreadPool - Supplies the thread pool object to use, else nullptr if the
         base library threading support should be used.
 
+    WinogradFilterPacked - Supplies true if the filter has also been packed
+        by MlasConvWinogradPackFilter. If the Winograd algorithm is selected,
+        the packed filter must be passed to MlasConv instead of the filter.
+
 Return Value:
 
     None.
@@ -1168,6 +1193,21 @@ Return Value:
 
     *WorkingBufferSize = 0;
 
+    //
+    // Use the Winograd algorithm for 3x3 convolutions with unit strides and
+    // dilations if the caller packed the filter and the output is at least
+    // one tile in each dimension.
+    //
+
+    if (WinogradFilterPacked && Dimensions == 2 && AllStridesAreOne && AllDilationsAreOne &&
+        Parameters->KernelShape[0] == 3 && Parameters->KernelShape[1] == 3 &&
+        Parameters->OutputShape[0] >= 4 && Parameters->OutputShape[1] >= 4) {
+
+        MlasConvWinogradPrepare(Parameters, WorkingBufferSize, ThreadPool);
+
+        return;
+    }
+
     if (AllStridesAreOne && AllPaddingIsZero) {
 
         //
@@ -0,0 +1,367 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convolve_dwpw.cpp
+
+Abstract:
+
+    This module implements a depthwise convolution followed by a pointwise
+    convolution, as found in the inverted residual blocks of MobileNet and
+    EfficientNet models.
+
+    The output image is split into tiles of contiguous output positions. For
+    each tile, the depthwise convolution of all channels is computed into a
+    per thread buffer sized to stay in the cache, and the pointwise
+    convolution is then computed from that buffer with a GEMM. This avoids
+    writing the intermediate activation to memory and reading it back.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the target number of elements of the depthwise output of a tile,
+// which is chosen to fit the per core L2 cache along with the pointwise
+// filter, and the bounds for the number of output positions of a tile.
+//
+
+constexpr size_t MLAS_CONV_DWPW_TILE_BUFFER_TARGET = 16384;
+constexpr size_t MLAS_CONV_DWPW_MINIMUM_TILE_SIZE = 16;
+constexpr size_t MLAS_CONV_DWPW_MAXIMUM_TILE_SIZE = 1024;
+
+struct MLAS_CONV_DWPW_WORK_BLOCK {
+    size_t Channels;
+    size_t FilterCount;
+    size_t InputHeight;
+    size_t InputWidth;
+    size_t KernelHeight;
+    size_t KernelWidth;
+    size_t DilationHeight;
+    size_t DilationWidth;
+    size_t PaddingTop;
+    size_t PaddingLeft;
+    size_t StrideHeight;
+    size_t StrideWidth;
+    size_t OutputHeight;
+    size_t OutputWidth;
+    size_t TileSize;
+    size_t TileCount;
+    const float* Input;
+    const float* DepthwiseFilter;
+    const float* DepthwiseBias;
+    const MLAS_ACTIVATION* DepthwiseActivation;
+    const float* PointwiseFilter;
+    const float* PointwiseBias;
+    const MLAS_ACTIVATION* PointwiseActivation;
+    float* Output;
+};
+
+MLAS_FORCEINLINE
+void
+MlasConvDepthwisePointwiseValidRange(
+    size_t KernelOffset,
+    size_t Padding,
+    size_t Stride,
+    size_t InputExtent,
+    size_t OutputStart,
+    size_t OutputEnd,
+    size_t* ValidStart,
+    size_t* ValidEnd
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the range of output positions along a dimension for
+    which the input position (Output * Stride + KernelOffset - Padding) is
+    inside the input image.
+
+--*/
+{
+    size_t Start = 0;
+
+    if (KernelOffset < Padding) {
+        Start = (Padding - KernelOffset + Stride - 1) / Stride;
+    }
+
+    size_t End = 0;
+
+    if (InputExtent + Padding > KernelOffset) {
+        End = (InputExtent + Padding - KernelOffset - 1) / Stride + 1;
+    }
+
+    *ValidStart = std::min(std::max(Start, OutputStart), OutputEnd);
+    *ValidEnd = std::max(std::min(End, OutputEnd), *ValidStart);
+}
+
+void
+MlasConvDepthwisePointwiseComputeDepthwise(
+    const MLAS_CONV_DWPW_WORK_BLOCK* WorkBlock,
+    const float* Input,
+    float* Buffer,
+    size_t TileStart,
+    size_t TileSize
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the depthwise convolution of all channels for a
+    tile of output positions. The output of channel c at position t of the
+    tile is stored at Buffer[c * TileSize + t].
+
+--*/
+{
+    const size_t InputSize = WorkBlock->InputHeight * WorkBlock->InputWidth;
+    const size_t KernelSize = WorkBlock->KernelHeight * WorkBlock->KernelWidth;
+    const size_t OutputWidth = WorkBlock->OutputWidth;
+    const size_t StrideWidth = WorkBlock->StrideWidth;
+
+    std::fill_n(Buffer, WorkBlock->Channels * TileSize, 0.0f);
+
+    for (size_t c = 0; c < WorkBlock->Channels; c++) {
+
+        const float* input = Input + c * InputSize;
+        const float* filter = WorkBlock->DepthwiseFilter + c * KernelSize;
+        float* buffer = Buffer + c * TileSize;
+
+        //
+        // Step through the output rows that intersect the tile.
+        //
+
+        size_t Position = TileStart;
+        const size_t TileEnd = TileStart + TileSize;
+
+        while (Position < TileEnd) {
+
+            const size_t oh = Position / OutputWidth;
+            const size_t RowStart = Position % OutputWidth;
+            const size_t RowEnd = std::min(OutputWidth, RowStart + (TileEnd - Position));
+
+            float* row = buffer + (Position - TileStart);
+
+            for (size_t ky = 0; ky < WorkBlock->KernelHeight; ky++) {
+
+                const size_t ih = oh * WorkBlock->StrideHeight + ky * WorkBlock->DilationHeight -
+                    WorkBlock->PaddingTop;
+
+                if (ih >= WorkBlock->InputHeight) {
+                    continue;
+                }
+
+                const float* input_row = input + ih * WorkBlock->InputWidth;
+
+                for (size_t kx = 0; kx < WorkBlock->KernelWidth; kx++) {
+
+                    const size_t KernelOffset = kx * WorkBlock->DilationWidth;
+                    const float FilterValue = filter[ky * WorkBlock->KernelWidth + kx];
+
+                    size_t ValidStart;
+                    size_t ValidEnd;
+
+                    MlasConvDepthwisePointwiseValidRange(KernelOffset, WorkBlock->PaddingLeft,
+                        StrideWidth, WorkBlock->InputWidth, RowStart, RowEnd, &ValidStart, &ValidEnd);
+
+                    if (ValidStart == ValidEnd) {
+                        continue;
+                    }
+
+                    const float* in = input_row + ValidStart * StrideWidth + KernelOffset -
+                        WorkBlock->PaddingLeft;
+                    float* out = row + (ValidStart - RowStart);
+                    const size_t ValidCount = ValidEnd - ValidStart;
+
+                    if (StrideWidth == 1) {
+                        for (size_t i = 0; i < ValidCount; i++) {
+                            out[i] += in[i] * FilterValue;
+                        }
+                    } else {
+                        for (size_t i = 0; i < ValidCount; i++) {
+                            out[i] += in[i * StrideWidth] * FilterValue;
+                        }
+                    }
+                }
+            }
+
+            Position += RowEnd - RowStart;
+        }
+    }
+}
+
+size_t
+MlasConvDepthwisePointwiseTileSize(
+    size_t Channels,
+    size_t OutputSize,
+    size_t BatchCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of output positions of a tile.
+
+--*/
+{
+    size_t TileSize = MLAS_CONV_DWPW_TILE_BUFFER_TARGET / Channels;
+
+    TileSize = std::max(TileSize, MLAS_CONV_DWPW_MINIMUM_TILE_SIZE);
+    TileSize = std::min(TileSize, MLAS_CONV_DWPW_MAXIMUM_TILE_SIZE);
+
+    //
+    // Reduce the tile size so that every thread receives a tile.
+    //
+
+    const size_t TargetThreadCount = size_t(MlasGetMaximumThreadCount(ThreadPool));
+    const size_t TotalWork = OutputSize * BatchCount;
+
+    if (TargetThreadCount > 1) {
+        TileSize = std::min(TileSize, std::max((TotalWork + TargetThreadCount - 1) / TargetThreadCount,
+            MLAS_CONV_DWPW_MINIMUM_TILE_SIZE));
+    }
+
+    return std::min(TileSize, OutputSize);
+}
+
+void
+MLASCALL
+MlasConvDepthwisePointwise(
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    const float* Input,
+    const float* DepthwiseFilter,
+    const float* DepthwiseBias,
+    const MLAS_ACTIVATION* DepthwiseActivation,
+    const float* PointwiseFilter,
+    const float* PointwiseBias,
+    const MLAS_ACTIVATION* PointwiseActivation,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a two dimensional depthwise convolution with a
+    channel multiplier of one, followed by a pointwise convolution.
+
+Arguments:
+
+    InputShape - Supplies the shape of the input tensor (N, C, H, W).
+
+    KernelShape - Supplies the shape of the depthwise kernel (KH, KW).
+
+    DilationShape - Supplies the dilations of the depthwise convolution.
+
+    Padding - Supplies the padding of the depthwise convolution (top, left,
+        bottom, right).
+
+    StrideShape - Supplies the strides of the depthwise convolution.
+
+    OutputShape - Supplies the shape of the output tensor (N, F, OH, OW).
+
+    Input - Supplies the input tensor.
+
+    DepthwiseFilter - Supplies the depthwise filter tensor (C, 1, KH, KW).
+
+    DepthwiseBias - Optionally supplies the depthwise bias vector.
+
+    DepthwiseActivation - Supplies the activation to apply to the depthwise
+        convolution output.
+
+    PointwiseFilter - Supplies the pointwise filter tensor (F, C, 1, 1).
+
+    PointwiseBias - Optionally supplies the pointwise bias vector.
+
+    PointwiseActivation - Supplies the activation to apply to the output.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_DWPW_WORK_BLOCK WorkBlock;
+
+    const size_t BatchCount = size_t(InputShape[0]);
+
+    WorkBlock.Channels = size_t(InputShape[1]);
+    WorkBlock.InputHeight = size_t(InputShape[2]);
+    WorkBlock.InputWidth = size_t(InputShape[3]);
+    WorkBlock.KernelHeight = size_t(KernelShape[0]);
+    WorkBlock.KernelWidth = size_t(KernelShape[1]);
+    WorkBlock.DilationHeight = size_t(DilationShape[0]);
+    WorkBlock.DilationWidth = size_t(DilationShape[1]);
+    WorkBlock.PaddingTop = size_t(Padding[0]);
+    WorkBlock.PaddingLeft = size_t(Padding[1]);
+    WorkBlock.StrideHeight = size_t(StrideShape[0]);
+    WorkBlock.StrideWidth = size_t(StrideShape[1]);
+    WorkBlock.FilterCount = size_t(OutputShape[1]);
+    WorkBlock.OutputHeight = size_t(OutputShape[2]);
+    WorkBlock.OutputWidth = size_t(OutputShape[3]);
+    WorkBlock.Input = Input;
+    WorkBlock.DepthwiseFilter = DepthwiseFilter;
+    WorkBlock.DepthwiseBias = DepthwiseBias;
+    WorkBlock.DepthwiseActivation = DepthwiseActivation;
+    WorkBlock.PointwiseFilter = PointwiseFilter;
+    WorkBlock.PointwiseBias = PointwiseBias;
+    WorkBlock.PointwiseActivation = PointwiseActivation;
+    WorkBlock.Output = Output;
+
+    const size_t OutputSize = WorkBlock.OutputHeight * WorkBlock.OutputWidth;
+
+    if (BatchCount == 0 || WorkBlock.Channels == 0 || WorkBlock.FilterCount == 0 || OutputSize == 0) {
+        return;
+    }
+
+    WorkBlock.TileSize = MlasConvDepthwisePointwiseTileSize(WorkBlock.Channels, OutputSize,
+        BatchCount, ThreadPool);
+    WorkBlock.TileCount = (OutputSize + WorkBlock.TileSize - 1) / WorkBlock.TileSize;
+
+    //
+    // Process each tile of each batch as a work item. The depthwise output
+    // of a tile lives in a thread local buffer.
+    //
+
+    MlasTrySimpleParallel(ThreadPool, ptrdiff_t(BatchCount * WorkBlock.TileCount), [&](ptrdiff_t tid) {
+
+        const size_t batch = size_t(tid) / WorkBlock.TileCount;
+        const size_t TileStart = (size_t(tid) % WorkBlock.TileCount) * WorkBlock.TileSize;
+        const size_t TileSize = std::min(WorkBlock.TileSize, OutputSize - TileStart);
+
+        const size_t Channels = WorkBlock.Channels;
+        const size_t FilterCount = WorkBlock.FilterCount;
+
+        MlasThreadedBufAlloc(Channels * WorkBlock.TileSize * sizeof(float));
+        float* Buffer = reinterpret_cast<float*>(ThreadedBufHolder.get());
+
+        const float* input = WorkBlock.Input +
+            batch * Channels * WorkBlock.InputHeight * WorkBlock.InputWidth;
+        float* output = WorkBlock.Output + batch * FilterCount * OutputSize + TileStart;
+
+        MlasConvDepthwisePointwiseComputeDepthwise(&WorkBlock, input, Buffer, TileStart, TileSize);
+
+        MlasActivation(WorkBlock.DepthwiseActivation, Buffer, WorkBlock.DepthwiseBias, Channels,
+            TileSize, TileSize);
+
+        MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, TileSize, Channels, 1.0f,
+            WorkBlock.PointwiseFilter, Channels, Buffer, TileSize, 0.0f, output, OutputSize);
+
+        MlasActivation(WorkBlock.PointwiseActivation, output, WorkBlock.PointwiseBias, FilterCount,
+            TileSize, OutputSize);
+    });
+}
@@ -0,0 +1,639 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convolve_winograd.cpp
+
+Abstract:
+
+    This module implements the Winograd F(4x4, 3x3) convolution algorithm for
+    two dimensional 3x3 convolutions with unit strides and dilations.
+
+    The output image is split into tiles of 4x4 elements. Each tile is
+    computed from a 6x6 patch of the input image that is transformed to the
+    Winograd domain, where the convolution becomes an element wise product of
+    the 36 transformed values with the transformed filter. The products are
+    accumulated over the input channels as 36 independent GEMMs, one per
+    element of the transformed tile, which computes 16 outputs with 36
+    multiplies per filter and channel instead of 144 for the direct method.
+
+    The filter transform only depends on the filter, so the transformed
+    filter is packed once by MlasConvWinogradPackFilter.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the minimum number of channels and filters for which the Winograd
+// algorithm is profitable. Below these, the transforms of the input and
+// output tiles dominate the GEMMs.
+//
+
+constexpr size_t MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS = 16;
+
+//
+// Define the number of elements along each dimension of an output tile and
+// of the transformed tile.
+//
+
+constexpr size_t MLAS_CONV_WINOGRAD_OUTPUT_TILE = 4;
+constexpr size_t MLAS_CONV_WINOGRAD_INPUT_TILE = 6;
+constexpr size_t MLAS_CONV_WINOGRAD_TILE_ELEMENTS =
+    MLAS_CONV_WINOGRAD_INPUT_TILE * MLAS_CONV_WINOGRAD_INPUT_TILE;
+
+//
+// Define the target number of elements of the per thread working buffer,
+// which bounds the number of tiles transformed at a time.
+//
+
+constexpr size_t MLAS_CONV_WINOGRAD_WORKING_BUFFER_TARGET = 36 * 16384;
+constexpr size_t MLAS_CONV_WINOGRAD_MINIMUM_TILE_BLOCK = 8;
+constexpr size_t MLAS_CONV_WINOGRAD_MAXIMUM_TILE_BLOCK = 64;
+
+//
+// Define the parameters to execute segments of a Winograd convolution on
+// worker threads.
+//
+
+struct MLAS_CONV_WINOGRAD_WORK_BLOCK {
+    const MLAS_CONV_PARAMETERS* Parameters;
+    const float* Input;
+    const float* PackedFilter;
+    float* WorkingBuffer;
+    float* Output;
+    size_t TileCountW;
+    size_t TileCount;
+};
+
+MLAS_FORCEINLINE
+size_t
+MlasConvWinogradWorkingBufferSizePerThread(
+    size_t InputChannels,
+    size_t FilterCount,
+    size_t TileBlock
+    )
+{
+    //
+    // Each thread transforms a block of tiles of all input channels and
+    // receives the products for all filters.
+    //
+
+    return MLAS_CONV_WINOGRAD_TILE_ELEMENTS * (InputChannels + FilterCount) * TileBlock;
+}
+
+MLAS_FORCEINLINE
+void
+MlasConvWinogradTransformFilter3(
+    const float g[3],
+    float u[6]
+    )
+/*++
+
+Routine Description:
+
+    This routine computes G * g for a column of the filter.
+
+--*/
+{
+    u[0] = g[0] * (1.0f / 4.0f);
+    u[1] = (g[0] + g[1] + g[2]) * (-1.0f / 6.0f);
+    u[2] = (g[0] - g[1] + g[2]) * (-1.0f / 6.0f);
+    u[3] = g[0] * (1.0f / 24.0f) + g[1] * (1.0f / 12.0f) + g[2] * (1.0f / 6.0f);
+    u[4] = g[0] * (1.0f / 24.0f) - g[1] * (1.0f / 12.0f) + g[2] * (1.0f / 6.0f);
+    u[5] = g[2];
+}
+
+MLAS_FORCEINLINE
+void
+MlasConvWinogradTransformInput6(
+    const float d[6],
+    float v[6]
+    )
+/*++
+
+Routine Description:
+
+    This routine computes B^T * d for a column of the input patch.
+
+--*/
+{
+    v[0] = 4.0f * d[0] - 5.0f * d[2] + d[4];
+    v[1] = -4.0f * (d[1] + d[2]) + d[3] + d[4];
+    v[2] = 4.0f * (d[1] - d[2]) - d[3] + d[4];
+    v[3] = 2.0f * (d[3] - d[1]) - d[2] + d[4];
+    v[4] = 2.0f * (d[1] - d[3]) - d[2] + d[4];
+    v[5] = 4.0f * d[1] - 5.0f * d[3] + d[5];
+}
+
+MLAS_FORCEINLINE
+void
+MlasConvWinogradTransformOutput6(
+    const float m[6],
+    float o[4]
+    )
+/*++
+
+Routine Description:
+
+    This routine computes A^T * m for a column of the transformed tile.
+
+--*/
+{
+    const float t12a = m[1] + m[2];
+    const float t12b = m[1] - m[2];
+    const float t34a = m[3] + m[4];
+    const float t34b = m[3] - m[4];
+
+    o[0] = m[0] + t12a + t34a;
+    o[1] = t12b + 2.0f * t34b;
+    o[2] = t12a + 4.0f * t34a;
+    o[3] = t12b + 8.0f * t34b + m[5];
+}
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of elements of the packed Winograd
+    filter for a 3x3 convolution.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    FilterCount - Supplies the number of filters per group.
+
+    InputChannels - Supplies the number of input channels per group.
+
+Return Value:
+
+    Returns the number of elements of the packed filter, or zero if the
+    Winograd algorithm is not profitable for this convolution.
+
+--*/
+{
+    if (FilterCount < MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS ||
+        InputChannels < MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS) {
+        return 0;
+    }
+
+    return GroupCount * MLAS_CONV_WINOGRAD_TILE_ELEMENTS * FilterCount * InputChannels;
+}
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    float* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the filter of a 3x3 convolution to the Winograd
+    domain. For each group, the packed filter holds 36 matrices of FilterCount
+    rows by InputChannels columns, one per element of the transformed tile.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    FilterCount - Supplies the number of filters per group.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    Filter - Supplies the filter tensor in the layout of the Conv operator.
+
+    PackedFilter - Supplies the buffer to receive the packed filter, sized to
+        the number of elements returned by MlasConvWinogradPackFilterSize.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t MatrixSize = FilterCount * InputChannels;
+
+    for (size_t group = 0; group < GroupCount; group++) {
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            for (size_t c = 0; c < InputChannels; c++) {
+
+                //
+                // Compute G * g * G^T, first on the columns and then on the
+                // rows of the intermediate result.
+                //
+
+                const float* g = Filter + (f * InputChannels + c) * 9;
+                float t[3][6];
+
+                for (size_t x = 0; x < 3; x++) {
+                    const float column[3] = {g[x], g[3 + x], g[6 + x]};
+                    MlasConvWinogradTransformFilter3(column, t[x]);
+                }
+
+                for (size_t y = 0; y < 6; y++) {
+                    const float row[3] = {t[0][y], t[1][y], t[2][y]};
+                    float u[6];
+                    MlasConvWinogradTransformFilter3(row, u);
+
+                    for (size_t x = 0; x < 6; x++) {
+                        PackedFilter[(y * 6 + x) * MatrixSize + f * InputChannels + c] = u[x];
+                    }
+                }
+            }
+        }
+
+        Filter += MatrixSize * 9;
+        PackedFilter += MatrixSize * MLAS_CONV_WINOGRAD_TILE_ELEMENTS;
+    }
+}
+
+void
+MlasConvWinogradTransformInputTiles(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    float* TransformedInput,
+    size_t TileCountW,
+    size_t StartTile,
+    size_t CountTiles
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the input patches of a block of tiles to the
+    Winograd domain. The transformed element e of channel c of tile t is
+    stored at TransformedInput[(e * InputChannels + c) * CountTiles + t].
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+
+    const size_t ElementStride = InputChannels * CountTiles;
+
+    for (size_t t = 0; t < CountTiles; t++) {
+
+        const size_t tile = StartTile + t;
+
+        //
+        // Compute the origin of the 6x6 input patch. The coordinates wrap
+        // around for the padding, so the unsigned comparison with the input
+        // dimensions detects both sides.
+        //
+
+        const size_t OriginY = (tile / TileCountW) * MLAS_CONV_WINOGRAD_OUTPUT_TILE - PaddingTop;
+        const size_t OriginX = (tile % TileCountW) * MLAS_CONV_WINOGRAD_OUTPUT_TILE - PaddingLeft;
+
+        const bool PatchInside = OriginY + MLAS_CONV_WINOGRAD_INPUT_TILE <= InputHeight &&
+                                 OriginX + MLAS_CONV_WINOGRAD_INPUT_TILE <= InputWidth &&
+                                 OriginY < InputHeight && OriginX < InputWidth;
+
+        const float* input = Input;
+        float* output = TransformedInput + t;
+
+        for (size_t c = 0; c < InputChannels; c++) {
+
+            float d[6][6];
+
+            if (PatchInside) {
+
+                const float* row = input + OriginY * InputWidth + OriginX;
+
+                for (size_t y = 0; y < 6; y++) {
+                    for (size_t x = 0; x < 6; x++) {
+                        d[y][x] = row[x];
+                    }
+                    row += InputWidth;
+                }
+
+            } else {
+
+                for (size_t y = 0; y < 6; y++) {
+                    const size_t iy = OriginY + y;
+                    for (size_t x = 0; x < 6; x++) {
+                        const size_t ix = OriginX + x;
+                        d[y][x] = (iy < InputHeight && ix < InputWidth) ? input[iy * InputWidth + ix] : 0.0f;
+                    }
+                }
+            }
+
+            //
+            // Compute B^T * d * B, first on the columns and then on the rows
+            // of the intermediate result.
+            //
+
+            float t0[6][6];
+
+            for (size_t x = 0; x < 6; x++) {
+                const float column[6] = {d[0][x], d[1][x], d[2][x], d[3][x], d[4][x], d[5][x]};
+                MlasConvWinogradTransformInput6(column, t0[x]);
+            }
+
+            for (size_t y = 0; y < 6; y++) {
+                const float row[6] = {t0[0][y], t0[1][y], t0[2][y], t0[3][y], t0[4][y], t0[5][y]};
+                float v[6];
+                MlasConvWinogradTransformInput6(row, v);
+
+                for (size_t x = 0; x < 6; x++) {
+                    output[(y * 6 + x) * ElementStride] = v[x];
+                }
+            }
+
+            input += InputSize;
+            output += CountTiles;
+        }
+    }
+}
+
+void
+MlasConvWinogradTransformOutputTiles(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* TransformedOutput,
+    float* Output,
+    size_t TileCountW,
+    size_t StartTile,
+    size_t CountTiles
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms a block of tiles from the Winograd domain to the
+    output image, adding the scaled existing output if Beta is not zero.
+
+--*/
+{
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+    const float Beta = Parameters->Beta;
+
+    const size_t ElementStride = FilterCount * CountTiles;
+
+    for (size_t t = 0; t < CountTiles; t++) {
+
+        const size_t tile = StartTile + t;
+        const size_t OriginY = (tile / TileCountW) * MLAS_CONV_WINOGRAD_OUTPUT_TILE;
+        const size_t OriginX = (tile % TileCountW) * MLAS_CONV_WINOGRAD_OUTPUT_TILE;
+        const size_t CountY = std::min(OutputHeight - OriginY, MLAS_CONV_WINOGRAD_OUTPUT_TILE);
+        const size_t CountX = std::min(OutputWidth - OriginX, MLAS_CONV_WINOGRAD_OUTPUT_TILE);
+
+        const float* input = TransformedOutput + t;
+        float* output = Output + OriginY * OutputWidth + OriginX;
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            //
+            // Compute A^T * m * A, first on the columns and then on the rows
+            // of the intermediate result.
+            //
+
+            float t0[6][4];
+
+            for (size_t x = 0; x < 6; x++) {
+                float column[6];
+                for (size_t y = 0; y < 6; y++) {
+                    column[y] = input[(y * 6 + x) * ElementStride];
+                }
+                MlasConvWinogradTransformOutput6(column, t0[x]);
+            }
+
+            for (size_t y = 0; y < CountY; y++) {
+                const float row[6] = {t0[0][y], t0[1][y], t0[2][y], t0[3][y], t0[4][y], t0[5][y]};
+                float o[4];
+                MlasConvWinogradTransformOutput6(row, o);
+
+                float* out = output + y * OutputWidth;
+
+                if (Beta == 0.0f) {
+                    for (size_t x = 0; x < CountX; x++) {
+                        out[x] = o[x];
+                    }
+                } else {
+                    for (size_t x = 0; x < CountX; x++) {
+                        out[x] = o[x] + Beta * out[x];
+                    }
+                }
+            }
+
+            input += CountTiles;
+            output += OutputSize;
+        }
+    }
+}
+
+void
+MlasConvWinogradThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute the blocks of
+    tiles assigned to the thread.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (const MLAS_CONV_WINOGRAD_WORK_BLOCK*)Context;
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t TileBlock = Parameters->u.Winograd.TileBlock;
+    const size_t TileCount = WorkBlock->TileCount;
+    const size_t ThreadCount = size_t(Parameters->ThreadCount);
+
+    float* TransformedInput = WorkBlock->WorkingBuffer +
+        Index * MlasConvWinogradWorkingBufferSizePerThread(InputChannels, FilterCount, TileBlock);
+    float* TransformedOutput = TransformedInput +
+        MLAS_CONV_WINOGRAD_TILE_ELEMENTS * InputChannels * TileBlock;
+
+    //
+    // Step through the blocks of tiles assigned to this thread.
+    //
+
+    for (size_t StartTile = size_t(Index) * TileBlock; StartTile < TileCount;
+         StartTile += ThreadCount * TileBlock) {
+
+        const size_t CountTiles = std::min(TileCount - StartTile, TileBlock);
+
+        MlasConvWinogradTransformInputTiles(Parameters, WorkBlock->Input, TransformedInput,
+            WorkBlock->TileCountW, StartTile, CountTiles);
+
+        //
+        // Multiply each element of the transformed tiles by the transformed
+        // filter, accumulating over the input channels.
+        //
+
+        for (size_t e = 0; e < MLAS_CONV_WINOGRAD_TILE_ELEMENTS; e++) {
+            MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, CountTiles,
+                InputChannels, 1.0f, WorkBlock->PackedFilter + e * FilterCount * InputChannels,
+                InputChannels, TransformedInput + e * InputChannels * CountTiles, CountTiles,
+                0.0f, TransformedOutput + e * FilterCount * CountTiles, CountTiles);
+        }
+
+        MlasConvWinogradTransformOutputTiles(Parameters, TransformedOutput, WorkBlock->Output,
+            WorkBlock->TileCountW, StartTile, CountTiles);
+    }
+}
+
+void
+MlasConvWinogradPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the tile blocking and the thread count of a
+    Winograd convolution.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+
+    const size_t TileCount =
+        ((Parameters->OutputShape[0] + MLAS_CONV_WINOGRAD_OUTPUT_TILE - 1) / MLAS_CONV_WINOGRAD_OUTPUT_TILE) *
+        ((Parameters->OutputShape[1] + MLAS_CONV_WINOGRAD_OUTPUT_TILE - 1) / MLAS_CONV_WINOGRAD_OUTPUT_TILE);
+
+    //
+    // Size the blocks of tiles so that the transformed tiles of a block fit
+    // the target working buffer size, then split the blocks across threads.
+    //
+
+    size_t TileBlock = MLAS_CONV_WINOGRAD_WORKING_BUFFER_TARGET /
+        (MLAS_CONV_WINOGRAD_TILE_ELEMENTS * (InputChannels + FilterCount));
+
+    TileBlock = std::max(TileBlock, MLAS_CONV_WINOGRAD_MINIMUM_TILE_BLOCK);
+    TileBlock = std::min(TileBlock, MLAS_CONV_WINOGRAD_MAXIMUM_TILE_BLOCK);
+
+    ptrdiff_t TargetThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(TargetThreadCount) > 1) {
+        TileBlock = std::min(TileBlock,
+            std::max((TileCount + TargetThreadCount - 1) / TargetThreadCount, MLAS_CONV_WINOGRAD_MINIMUM_TILE_BLOCK));
+    }
+
+    TileBlock = std::min(TileBlock, TileCount);
+
+    const size_t BlockCount = (TileCount + TileBlock - 1) / TileBlock;
+
+    if (size_t(TargetThreadCount) > BlockCount) {
+        TargetThreadCount = ptrdiff_t(BlockCount);
+    }
+
+    Parameters->Algorithm = MlasConvAlgorithmWinograd;
+    Parameters->ThreadCount = TargetThreadCount;
+    Parameters->u.Winograd.TileBlock = TileBlock;
+
+    *WorkingBufferSize = size_t(TargetThreadCount) *
+        MlasConvWinogradWorkingBufferSizePerThread(InputChannels, FilterCount, TileBlock);
+}
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* PackedFilter,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the Winograd convolution of one batch and group.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input image of the group.
+
+    PackedFilter - Supplies the filter of the group packed by
+        MlasConvWinogradPackFilter.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvPrepare.
+
+    Output - Supplies the output image of the group.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WINOGRAD_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Input = Input;
+    WorkBlock.PackedFilter = PackedFilter;
+    WorkBlock.WorkingBuffer = WorkingBuffer;
+    WorkBlock.Output = Output;
+    WorkBlock.TileCountW =
+        (Parameters->OutputShape[1] + MLAS_CONV_WINOGRAD_OUTPUT_TILE - 1) / MLAS_CONV_WINOGRAD_OUTPUT_TILE;
+    WorkBlock.TileCount = WorkBlock.TileCountW *
+        ((Parameters->OutputShape[0] + MLAS_CONV_WINOGRAD_OUTPUT_TILE - 1) / MLAS_CONV_WINOGRAD_OUTPUT_TILE);
+
+    MlasExecuteThreaded(MlasConvWinogradThreaded, &WorkBlock, Parameters->ThreadCount, ThreadPool);
+}
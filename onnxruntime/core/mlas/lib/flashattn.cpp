@@ -0,0 +1,309 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    flashattn.cpp
+
+Abstract:
+
+    This module implements a fused scaled dot product attention that never
+    materializes the full matrix of attention scores.
+
+    Each work item computes a block of rows of Q of one head. It walks the
+    rows of K and V in blocks and keeps, for every query row, the running
+    maximum and sum of the exponentials of its scores (online softmax). The
+    output accumulated so far is rescaled whenever the maximum of a row grows.
+    The working set of a thread is a block of scores, a block of the output
+    and one block of K and V, which stays cache resident for long sequences.
+
+    With a block sparse layout the blocks of K and V a block of Q doesn't
+    attend to are skipped, so a sliding window costs O(S) instead of O(S^2).
+
+--*/
+
+#include "mlasi.h"
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+
+constexpr size_t DefaultQBlockSize = 64;
+constexpr size_t DefaultKvBlockSize = 256;
+
+MLAS_FORCEINLINE
+float
+ReduceMaximum(
+    const float* Input,
+    size_t N
+    )
+{
+#if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
+    return GetMlasPlatform().ReduceMaximumF32Kernel(Input, N);
+#else
+    return MlasReduceMaximumF32Kernel(Input, N);
+#endif
+}
+
+MLAS_FORCEINLINE
+float
+ComputeSumExp(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float NegativeMaximum
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().ComputeSumExpF32Kernel(Input, Output, N, &NegativeMaximum);
+#else
+    return MlasComputeSumExpF32Kernel(Input, Output, N, &NegativeMaximum);
+#endif
+}
+
+void
+FlashAttentionBlock(
+    const MLAS_FLASH_ATTENTION_PARAMS& Params,
+    size_t QBlockSize,
+    size_t KvBlockSize,
+    size_t WorkIndex,
+    float* Buffer
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the output of one block of query rows of one head.
+
+Arguments:
+
+    Params - Supplies the attention parameters.
+
+    QBlockSize - Supplies the number of query rows of a block.
+
+    KvBlockSize - Supplies the number of key/value rows of a block.
+
+    WorkIndex - Supplies the index of the (batch, head, query block) to compute.
+
+    Buffer - Supplies the thread buffer of QBlockSize * (KvBlockSize + VHeadSize + 2) floats.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t QBlockCount = (Params.QSequenceLength + QBlockSize - 1) / QBlockSize;
+    const size_t QBlock = WorkIndex % QBlockCount;
+    const size_t Head = (WorkIndex / QBlockCount) % Params.NumHeads;
+    const size_t Batch = WorkIndex / QBlockCount / Params.NumHeads;
+    const size_t KvHead = Head / (Params.NumHeads / Params.KvNumHeads);
+
+    const size_t H = Params.QkHeadSize;
+    const size_t Hv = Params.VHeadSize;
+    const size_t RowBegin = QBlock * QBlockSize;
+    const size_t Rows = std::min(QBlockSize, Params.QSequenceLength - RowBegin);
+
+    const float* Q = Params.Query + Batch * Params.QueryBatchStride + Head * Params.QueryHeadStride + RowBegin * H;
+    const float* K = Params.Key + Batch * Params.KeyBatchStride + KvHead * Params.KeyHeadStride;
+    const float* V = Params.Value + Batch * Params.ValueBatchStride + KvHead * Params.ValueHeadStride;
+    const float* Mask = Params.Mask != nullptr
+                            ? Params.Mask + Batch * Params.MaskBatchStride + RowBegin * Params.KvSequenceLength
+                            : nullptr;
+
+    //
+    // Determine the range of key rows any query row of the block attends to.
+    //
+
+    size_t KvEnd = Params.KvSequenceLength;
+    if (Params.KvValidLengths != nullptr) {
+        KvEnd = std::min(KvEnd, size_t(std::max(Params.KvValidLengths[Batch], int32_t(0))));
+    }
+
+    size_t KvBegin = 0;
+    if (Params.Causal) {
+        KvEnd = std::min(KvEnd, RowBegin + Rows);
+        if (Params.LocalWindowSize != 0 && RowBegin > Params.LocalWindowSize) {
+            KvBegin = RowBegin - Params.LocalWindowSize;
+        }
+    }
+
+    //
+    // With a block layout the blocks of keys start at multiples of the sparse
+    // block size, which is also the size of the blocks of queries.
+    //
+
+    const uint8_t* BlockLayoutRow = nullptr;
+    if (Params.BlockLayout != nullptr) {
+        const size_t KvBlockCount = (Params.KvSequenceLength + KvBlockSize - 1) / KvBlockSize;
+        BlockLayoutRow = Params.BlockLayout + QBlock * KvBlockCount;
+        KvBegin = KvBegin / KvBlockSize * KvBlockSize;
+    }
+
+    float* Scores = Buffer;
+    float* Accumulator = Scores + QBlockSize * KvBlockSize;
+    float* RowMaximum = Accumulator + QBlockSize * Hv;
+    float* RowSum = RowMaximum + QBlockSize;
+
+    constexpr float NegativeInfinity = -std::numeric_limits<float>::infinity();
+
+    std::fill_n(Accumulator, Rows * Hv, 0.0f);
+    std::fill_n(RowMaximum, Rows, NegativeInfinity);
+    std::fill_n(RowSum, Rows, 0.0f);
+
+    for (size_t KvBlockBegin = KvBegin; KvBlockBegin < KvEnd; KvBlockBegin += KvBlockSize) {
+        if (BlockLayoutRow != nullptr && BlockLayoutRow[KvBlockBegin / KvBlockSize] == 0) {
+            continue;
+        }
+
+        const size_t Columns = std::min(KvBlockSize, KvEnd - KvBlockBegin);
+
+        //
+        // Scores = Scale * Q * K' of the blocks.
+        //
+
+        MlasGemm(CblasNoTrans, CblasTrans, Rows, Columns, H, Params.Scale, Q, H, K + KvBlockBegin * H, H,
+                 0.0f, Scores, Columns, nullptr);
+
+        for (size_t r = 0; r < Rows; r++) {
+            float* Row = Scores + r * Columns;
+            const size_t QueryRow = RowBegin + r;
+
+            if (Mask != nullptr) {
+                const float* MaskRow = Mask + r * Params.KvSequenceLength + KvBlockBegin;
+                for (size_t c = 0; c < Columns; c++) {
+                    Row[c] += MaskRow[c];
+                }
+            }
+
+            if (Params.Causal) {
+                for (size_t c = 0; c < Columns; c++) {
+                    const size_t KeyRow = KvBlockBegin + c;
+                    if (KeyRow > QueryRow ||
+                        (Params.LocalWindowSize != 0 && KeyRow + Params.LocalWindowSize < QueryRow)) {
+                        Row[c] = NegativeInfinity;
+                    }
+                }
+            }
+
+            const float BlockMaximum = ReduceMaximum(Row, Columns);
+            if (BlockMaximum == NegativeInfinity) {
+                //
+                // None of the keys of the block is attended to by this row.
+                //
+
+                std::fill_n(Row, Columns, 0.0f);
+                continue;
+            }
+
+            const float Maximum = std::max(RowMaximum[r], BlockMaximum);
+            const float BlockSum = ComputeSumExp(Row, Row, Columns, -Maximum);
+
+            //
+            // Rescale the sum and the output accumulated with the previous maximum.
+            //
+
+            if (Maximum != RowMaximum[r]) {
+                const float Correction = std::exp(RowMaximum[r] - Maximum);
+                RowSum[r] *= Correction;
+                float* AccumulatorRow = Accumulator + r * Hv;
+                for (size_t h = 0; h < Hv; h++) {
+                    AccumulatorRow[h] *= Correction;
+                }
+                RowMaximum[r] = Maximum;
+            }
+
+            RowSum[r] += BlockSum;
+        }
+
+        //
+        // Accumulator += Exp(Scores - Maximum) * V of the blocks.
+        //
+
+        MlasGemm(CblasNoTrans, CblasNoTrans, Rows, Hv, Columns, 1.0f, Scores, Columns, V + KvBlockBegin * Hv, Hv,
+                 1.0f, Accumulator, Hv, nullptr);
+    }
+
+    //
+    // Normalize the rows and store them to the BxSxNxH_v output.
+    //
+
+    const size_t OutputRowStride = Params.OutputRowStride != 0 ? Params.OutputRowStride : Params.NumHeads * Hv;
+
+    for (size_t r = 0; r < Rows; r++) {
+        float* Output = Params.Output + (Batch * Params.QSequenceLength + RowBegin + r) * OutputRowStride + Head * Hv;
+        const float* AccumulatorRow = Accumulator + r * Hv;
+        const float Scale = RowSum[r] > 0.0f ? 1.0f / RowSum[r] : 0.0f;
+        for (size_t h = 0; h < Hv; h++) {
+            Output[h] = AccumulatorRow[h] * Scale;
+        }
+    }
+}
+
+}  // namespace
+
+void
+MLASCALL
+MlasFlashAttention(
+    const MLAS_FLASH_ATTENTION_PARAMS& Params,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes Output = Softmax(Scale * Q * K' + Mask) * V, see
+    MLAS_FLASH_ATTENTION_PARAMS for the layout of the tensors.
+
+Arguments:
+
+    Params - Supplies the attention parameters.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Params.BatchSize == 0 || Params.NumHeads == 0 || Params.QSequenceLength == 0) {
+        return;
+    }
+
+    size_t QBlockSize = std::min(Params.QBlockSize != 0 ? Params.QBlockSize : DefaultQBlockSize,
+                                 Params.QSequenceLength);
+    size_t KvBlockSize = std::max(std::min(Params.KvBlockSize != 0 ? Params.KvBlockSize : DefaultKvBlockSize,
+                                           Params.KvSequenceLength),
+                                  size_t(1));
+
+    if (Params.BlockLayout != nullptr) {
+        QBlockSize = Params.SparseBlockSize;
+        KvBlockSize = Params.SparseBlockSize;
+    }
+
+    const size_t QBlockCount = (Params.QSequenceLength + QBlockSize - 1) / QBlockSize;
+    const size_t WorkCount = Params.BatchSize * Params.NumHeads * QBlockCount;
+    const size_t BufferSize = QBlockSize * (KvBlockSize + Params.VHeadSize + 2) * sizeof(float);
+
+    const ptrdiff_t ThreadCount = std::min(MlasGetMaximumThreadCount(ThreadPool), ptrdiff_t(WorkCount));
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+        size_t WorkIndex;
+        size_t WorkRemaining;
+        MlasPartitionWork(tid, ThreadCount, WorkCount, &WorkIndex, &WorkRemaining);
+
+        MlasThreadedBufAlloc(BufferSize);
+        float* Buffer = reinterpret_cast<float*>(ThreadedBufHolder.get());
+
+        for (size_t w = WorkIndex; w < WorkIndex + WorkRemaining; w++) {
+            FlashAttentionBlock(Params, QBlockSize, KvBlockSize, w, Buffer);
+        }
+    });
+}
@@ -0,0 +1,285 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the half precision GEMM kernel for x64 processors
+    with AVX2, FMA3 and F16C support.
+
+    The processor has no fp16 arithmetic, so the kernel converts the fp16
+    inputs to fp32 with F16C, accumulates in fp32 with FMA3 and converts the
+    result back to fp16. Matrix B stays in fp16, so the weight bandwidth is
+    half of the fp32 SGEMM.
+
+--*/
+
+#include <algorithm>
+
+#include "mlasi.h"
+#include "halfgemm.h"
+
+struct MLAS_HALF_GEMM_KERNEL_AVX2 {
+    static constexpr bool PackNeeded = false;
+    static constexpr size_t KernelMaxM = 6;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 1;
+
+    static constexpr MLAS_HALF_GEMM_STRIDES Strides{24, 128, 512};
+};
+
+MLAS_FORCEINLINE
+__m256
+MlasLoadHalf8Avx2(
+    const _mlas_fp16_* Buffer,
+    size_t len
+    )
+{
+    if (len >= 8) {
+        return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Buffer)));
+    }
+
+    _mlas_fp16_ buf[8] = {};
+    std::copy_n(Buffer, len, buf);
+    return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(buf)));
+}
+
+MLAS_FORCEINLINE
+void
+MlasStoreHalf8Avx2(
+    _mlas_fp16_* Buffer,
+    __m256 Vector,
+    size_t len
+    )
+{
+    const __m128i Half = _mm256_cvtps_ph(Vector, _MM_FROUND_TO_NEAREST_INT);
+
+    if (len >= 8) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Buffer), Half);
+        return;
+    }
+
+    _mlas_fp16_ buf[8];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(buf), Half);
+    std::copy_n(buf, len, Buffer);
+}
+
+/**
+ * @brief Compute a block of RowCount rows by up to VectorCount * 8 columns
+ *        of the output. Columns past CountN are neither read nor written.
+ */
+template <size_t RowCount, size_t VectorCount>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmBlockAvx2(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    size_t len[VectorCount];
+    for (size_t v = 0; v < VectorCount; v++) {
+        len[v] = (CountN > v * 8) ? CountN - v * 8 : 0;
+    }
+
+    __m256 Accumulators[RowCount][VectorCount];
+
+    for (size_t v = 0; v < VectorCount; v++) {
+        const __m256 BiasVector = (Bias == nullptr) ? _mm256_setzero_ps() : MlasLoadHalf8Avx2(Bias + v * 8, len[v]);
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r][v] = BiasVector;
+            if (!ZeroMode) {
+                Accumulators[r][v] = _mm256_add_ps(Accumulators[r][v], MlasLoadHalf8Avx2(C + r * ldc + v * 8, len[v]));
+            }
+        }
+    }
+
+    for (size_t k = 0; k < CountK; k++) {
+        __m256 BVector[VectorCount];
+        for (size_t v = 0; v < VectorCount; v++) {
+            BVector[v] = MlasLoadHalf8Avx2(B + v * 8, len[v]);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const __m256 AVector = _mm256_set1_ps(_cvtsh_ss(A[r * lda + k]));
+            for (size_t v = 0; v < VectorCount; v++) {
+                Accumulators[r][v] = _mm256_fmadd_ps(AVector, BVector[v], Accumulators[r][v]);
+            }
+        }
+
+        B += ldb;
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t v = 0; v < VectorCount; v++) {
+            MlasStoreHalf8Avx2(C + r * ldc + v * 8, Accumulators[r][v], len[v]);
+        }
+    }
+}
+
+template <size_t RowCount>
+void
+MlasHalfGemmRowsAvx2(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    while (CountN >= 16) {
+        MlasHalfGemmBlockAvx2<RowCount, 2>(16, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+        C += 16;
+        B += 16;
+        if (Bias != nullptr) {
+            Bias += 16;
+        }
+        CountN -= 16;
+    }
+
+    if (CountN > 8) {
+        MlasHalfGemmBlockAvx2<RowCount, 2>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+    } else if (CountN > 0) {
+        MlasHalfGemmBlockAvx2<RowCount, 1>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+    }
+}
+
+MLAS_FORCEINLINE
+void
+CvtFloat2HalfAvx2(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t len
+)
+{
+    while (len >= 8) {
+        const __m128i Half = _mm256_cvtps_ph(_mm256_loadu_ps(src), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), Half);
+        src += 8;
+        dest += 8;
+        len -= 8;
+    }
+
+    while (len > 0) {
+        *dest++ = _cvtss_sh(*src++, _MM_FROUND_TO_NEAREST_INT);
+        len--;
+    }
+}
+
+/**
+ * @brief Convert a 2D matrix from float to fp16
+*/
+MLAS_FORCEINLINE
+void
+CvtFloat2Half2DAvx2(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t stride,
+    size_t CntRow,
+    size_t CntCol
+    )
+{
+    if (stride == CntCol) {
+        CvtFloat2HalfAvx2(dest, src, CntRow * CntCol);
+        return;
+    }
+    while (CntRow > 0) {
+        CvtFloat2HalfAvx2(dest, src, CntCol);
+        src += stride;
+        dest += CntCol;
+        CntRow--;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackA<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    _mlas_fp16_* D,
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+)
+{
+    CvtFloat2Half2DAvx2(D, A, lda, CountM, CountK);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    _mlas_fp16_* D,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+)
+{
+    CvtFloat2Half2DAvx2(D, B, ldb, CountK, CountN);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernel<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    const bool ZeroMode)
+{
+    switch (std::min(CountM, MLAS_HALF_GEMM_KERNEL_AVX2::KernelMaxM)) {
+        case 1:
+            MlasHalfGemmRowsAvx2<1>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 2:
+            MlasHalfGemmRowsAvx2<2>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 3:
+            MlasHalfGemmRowsAvx2<3>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 4:
+            MlasHalfGemmRowsAvx2<4>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 5:
+            MlasHalfGemmRowsAvx2<5>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        default:
+            MlasHalfGemmRowsAvx2<6>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+    }
+}
+
+
+const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx2 = {
+    MlasHalfGemmOperation<MLAS_HALF_GEMM_KERNEL_AVX2>,
+    nullptr,
+    MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX2>,
+    MLAS_HALF_GEMM_KERNEL_AVX2::PackedK,
+    MLAS_HALF_GEMM_KERNEL_AVX2::KernelMaxM,
+    0
+};
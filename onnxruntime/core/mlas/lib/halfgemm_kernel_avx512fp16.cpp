@@ -0,0 +1,268 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_avx512fp16.cpp
+
+Abstract:
+
+    This module implements the half precision GEMM kernel for x64 processors
+    with AVX512-FP16 support (Sapphire Rapids and later).
+
+    Like the NEON kernel, the products are accumulated in fp16. Each vector
+    holds 32 columns and the column tail is handled with masked loads and
+    stores.
+
+--*/
+
+#include <algorithm>
+
+#include "mlasi.h"
+#include "halfgemm.h"
+
+struct MLAS_HALF_GEMM_KERNEL_AVX512FP16 {
+    static constexpr bool PackNeeded = false;
+    static constexpr size_t KernelMaxM = 6;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 1;
+
+    static constexpr MLAS_HALF_GEMM_STRIDES Strides{24, 128, 512};
+};
+
+MLAS_FORCEINLINE
+__mmask32
+MlasHalfMaskAvx512Fp16(
+    size_t len
+    )
+{
+    return (len >= 32) ? __mmask32(0xFFFFFFFF) : __mmask32((uint32_t(1) << len) - 1);
+}
+
+MLAS_FORCEINLINE
+__m512h
+MlasLoadHalf32Avx512Fp16(
+    const _mlas_fp16_* Buffer,
+    __mmask32 Mask
+    )
+{
+    return _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask, Buffer));
+}
+
+/**
+ * @brief Compute a block of RowCount rows by up to VectorCount * 32 columns
+ *        of the output. Columns past CountN are neither read nor written.
+ */
+template <size_t RowCount, size_t VectorCount>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmBlockAvx512Fp16(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    __mmask32 Mask[VectorCount];
+    for (size_t v = 0; v < VectorCount; v++) {
+        Mask[v] = MlasHalfMaskAvx512Fp16((CountN > v * 32) ? CountN - v * 32 : 0);
+    }
+
+    __m512h Accumulators[RowCount][VectorCount];
+
+    for (size_t v = 0; v < VectorCount; v++) {
+        const __m512h BiasVector = (Bias == nullptr) ? _mm512_setzero_ph() : MlasLoadHalf32Avx512Fp16(Bias + v * 32, Mask[v]);
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r][v] = BiasVector;
+            if (!ZeroMode) {
+                Accumulators[r][v] = _mm512_add_ph(Accumulators[r][v], MlasLoadHalf32Avx512Fp16(C + r * ldc + v * 32, Mask[v]));
+            }
+        }
+    }
+
+    for (size_t k = 0; k < CountK; k++) {
+        __m512h BVector[VectorCount];
+        for (size_t v = 0; v < VectorCount; v++) {
+            BVector[v] = MlasLoadHalf32Avx512Fp16(B + v * 32, Mask[v]);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const __m512h AVector = _mm512_castsi512_ph(_mm512_set1_epi16(short(A[r * lda + k])));
+            for (size_t v = 0; v < VectorCount; v++) {
+                Accumulators[r][v] = _mm512_fmadd_ph(AVector, BVector[v], Accumulators[r][v]);
+            }
+        }
+
+        B += ldb;
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t v = 0; v < VectorCount; v++) {
+            _mm512_mask_storeu_epi16(C + r * ldc + v * 32, Mask[v], _mm512_castph_si512(Accumulators[r][v]));
+        }
+    }
+}
+
+template <size_t RowCount>
+void
+MlasHalfGemmRowsAvx512Fp16(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    while (CountN >= 64) {
+        MlasHalfGemmBlockAvx512Fp16<RowCount, 2>(64, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+        C += 64;
+        B += 64;
+        if (Bias != nullptr) {
+            Bias += 64;
+        }
+        CountN -= 64;
+    }
+
+    if (CountN > 32) {
+        MlasHalfGemmBlockAvx512Fp16<RowCount, 2>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+    } else if (CountN > 0) {
+        MlasHalfGemmBlockAvx512Fp16<RowCount, 1>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+    }
+}
+
+MLAS_FORCEINLINE
+void
+CvtFloat2HalfAvx512Fp16(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t len
+)
+{
+    while (len >= 16) {
+        const __m256i Half = _mm512_cvtps_ph(_mm512_loadu_ps(src), _MM_FROUND_TO_NEAREST_INT);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest), Half);
+        src += 16;
+        dest += 16;
+        len -= 16;
+    }
+
+    if (len > 0) {
+        const __mmask16 Mask = __mmask16((1u << len) - 1);
+        const __m256i Half = _mm512_cvtps_ph(_mm512_maskz_loadu_ps(Mask, src), _MM_FROUND_TO_NEAREST_INT);
+        _mm256_mask_storeu_epi16(dest, Mask, Half);
+    }
+}
+
+/**
+ * @brief Convert a 2D matrix from float to fp16
+*/
+MLAS_FORCEINLINE
+void
+CvtFloat2Half2DAvx512Fp16(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t stride,
+    size_t CntRow,
+    size_t CntCol
+    )
+{
+    if (stride == CntCol) {
+        CvtFloat2HalfAvx512Fp16(dest, src, CntRow * CntCol);
+        return;
+    }
+    while (CntRow > 0) {
+        CvtFloat2HalfAvx512Fp16(dest, src, CntCol);
+        src += stride;
+        dest += CntCol;
+        CntRow--;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackA<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    _mlas_fp16_* D,
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+)
+{
+    CvtFloat2Half2DAvx512Fp16(D, A, lda, CountM, CountK);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    _mlas_fp16_* D,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+)
+{
+    CvtFloat2Half2DAvx512Fp16(D, B, ldb, CountK, CountN);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernel<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    const bool ZeroMode)
+{
+    switch (std::min(CountM, MLAS_HALF_GEMM_KERNEL_AVX512FP16::KernelMaxM)) {
+        case 1:
+            MlasHalfGemmRowsAvx512Fp16<1>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 2:
+            MlasHalfGemmRowsAvx512Fp16<2>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 3:
+            MlasHalfGemmRowsAvx512Fp16<3>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 4:
+            MlasHalfGemmRowsAvx512Fp16<4>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 5:
+            MlasHalfGemmRowsAvx512Fp16<5>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        default:
+            MlasHalfGemmRowsAvx512Fp16<6>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+    }
+}
+
+
+const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx512Fp16 = {
+    MlasHalfGemmOperation<MLAS_HALF_GEMM_KERNEL_AVX512FP16>,
+    nullptr,
+    MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX512FP16>,
+    MLAS_HALF_GEMM_KERNEL_AVX512FP16::PackedK,
+    MLAS_HALF_GEMM_KERNEL_AVX512FP16::KernelMaxM,
+    0
+};
@@ -0,0 +1,82 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cast_avx2.cpp
+
+Abstract:
+
+    This module implements the conversion of a buffer of single precision
+    floating point values to half precision with AVX2 and F16C instructions.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasCastF32ToF16KernelAvx2(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of single precision floating point values
+    to half precision with AVX2 and F16C instructions, rounding to nearest
+    even.
+
+Arguments:
+
+    Source - Supplies the buffer of single precision values.
+
+    Destination - Supplies the buffer to receive the half precision values.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t i = 0;
+
+    for (; i + 16 <= Count; i += 16) {
+
+        __m128i Half0 = _mm256_cvtps_ph(_mm256_loadu_ps(Source + i), _MM_FROUND_TO_NEAREST_INT);
+        __m128i Half1 = _mm256_cvtps_ph(_mm256_loadu_ps(Source + i + 8), _MM_FROUND_TO_NEAREST_INT);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Destination + i), Half0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Destination + i + 8), Half1);
+    }
+
+    for (; i + 8 <= Count; i += 8) {
+
+        __m128i Half = _mm256_cvtps_ph(_mm256_loadu_ps(Source + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Destination + i), Half);
+    }
+
+    if (i < Count) {
+
+        //
+        // Convert the remaining elements through a zero padded vector so that
+        // the tail is rounded the same way as the body.
+        //
+
+        float Buffer[8] = {};
+        unsigned short Result[8];
+        const size_t Remaining = Count - i;
+
+        std::copy_n(Source + i, Remaining, Buffer);
+        __m128i Half = _mm256_cvtps_ph(_mm256_loadu_ps(Buffer), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Result), Half);
+        std::copy_n(Result, Remaining, Destination + i);
+    }
+}
@@ -0,0 +1,129 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    rotary_embedding_avx2.cpp
+
+Abstract:
+
+    This module implements the kernel to apply rotary position embedding to a
+    row with AVX2 and FMA3 instructions.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasRotaryEmbedF32KernelAvx2(
+    const float* Input,
+    const float* Sin,
+    const float* Cos,
+    size_t RotaryEmbeddingDim,
+    bool Interleaved,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine applies rotary position embedding to a row with AVX2 and
+    FMA3 instructions.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Sin - Supplies RotaryEmbeddingDim / 2 sine values.
+
+    Cos - Supplies RotaryEmbeddingDim / 2 cosine values.
+
+    RotaryEmbeddingDim - Supplies the number of rotated elements.
+
+    Interleaved - Supplies true if the rotated pairs are adjacent elements,
+        else element i is paired with element i + RotaryEmbeddingDim / 2.
+
+    Output - Supplies the output row, which may be the input row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t HalfDim = RotaryEmbeddingDim / 2;
+    size_t i = 0;
+
+    if (Interleaved) {
+
+        //
+        // The sine and cosine values are duplicated for the two elements of a
+        // pair. fmaddsub then computes x * c - y * s in the even lanes and
+        // y * c + x * s in the odd lanes from the pair swapped input.
+        //
+
+        const __m256i LowIndices = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+        const __m256i HighIndices = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+
+        for (; i + 8 <= HalfDim; i += 8) {
+
+            __m256 CosVector = _mm256_loadu_ps(Cos + i);
+            __m256 SinVector = _mm256_loadu_ps(Sin + i);
+
+            __m256 Vector0 = _mm256_loadu_ps(Input + i * 2);
+            __m256 Vector1 = _mm256_loadu_ps(Input + i * 2 + 8);
+
+            __m256 Swapped0 = _mm256_permute_ps(Vector0, 0xB1);
+            __m256 Swapped1 = _mm256_permute_ps(Vector1, 0xB1);
+
+            __m256 Output0 = _mm256_fmaddsub_ps(Vector0, _mm256_permutevar8x32_ps(CosVector, LowIndices),
+                _mm256_mul_ps(Swapped0, _mm256_permutevar8x32_ps(SinVector, LowIndices)));
+            __m256 Output1 = _mm256_fmaddsub_ps(Vector1, _mm256_permutevar8x32_ps(CosVector, HighIndices),
+                _mm256_mul_ps(Swapped1, _mm256_permutevar8x32_ps(SinVector, HighIndices)));
+
+            _mm256_storeu_ps(Output + i * 2, Output0);
+            _mm256_storeu_ps(Output + i * 2 + 8, Output1);
+        }
+
+        for (; i < HalfDim; i++) {
+
+            const float x = Input[i * 2];
+            const float y = Input[i * 2 + 1];
+
+            Output[i * 2] = x * Cos[i] - y * Sin[i];
+            Output[i * 2 + 1] = y * Cos[i] + x * Sin[i];
+        }
+
+    } else {
+
+        const float* InputHigh = Input + HalfDim;
+        float* OutputHigh = Output + HalfDim;
+
+        for (; i + 8 <= HalfDim; i += 8) {
+
+            __m256 CosVector = _mm256_loadu_ps(Cos + i);
+            __m256 SinVector = _mm256_loadu_ps(Sin + i);
+            __m256 x = _mm256_loadu_ps(Input + i);
+            __m256 y = _mm256_loadu_ps(InputHigh + i);
+
+            __m256 Output0 = _mm256_fmsub_ps(x, CosVector, _mm256_mul_ps(y, SinVector));
+            __m256 Output1 = _mm256_fmadd_ps(y, CosVector, _mm256_mul_ps(x, SinVector));
+
+            _mm256_storeu_ps(Output + i, Output0);
+            _mm256_storeu_ps(OutputHigh + i, Output1);
+        }
+
+        for (; i < HalfDim; i++) {
+
+            const float x = Input[i];
+            const float y = InputHigh[i];
+
+            Output[i] = x * Cos[i] - y * Sin[i];
+            OutputHigh[i] = y * Cos[i] + x * Sin[i];
+        }
+    }
+}
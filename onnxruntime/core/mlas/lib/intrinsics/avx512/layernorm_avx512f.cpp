@@ -0,0 +1,197 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_avx512f.cpp
+
+Abstract:
+
+    This module implements the kernel to compute layer normalization and RMS
+    normalization of a row with AVX512F instructions.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasLayerNormF32KernelAvx512F(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SkipBiasSum,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes a row with AVX512F instructions. The remaining
+    elements of the row are processed with masked loads and stores.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Skip - Optionally supplies the residual row added to the input.
+
+    Bias - Optionally supplies the bias row added to the input.
+
+    Gamma - Supplies the scale row.
+
+    Beta - Optionally supplies the shift row, ignored if Simplified is set.
+
+    Output - Supplies the output row. The output may alias the input.
+
+    SkipBiasSum - Optionally supplies the row that receives the sum of the
+        input, skip and bias. The row may alias the skip row.
+
+    N - Supplies the number of elements of the row.
+
+    Epsilon - Supplies the value added to the variance.
+
+    Simplified - Supplies true to compute RMS normalization, which neither
+        subtracts the mean nor adds Beta.
+
+    Mean - Receives the mean of the row, zero if Simplified is set.
+
+    InvStdDev - Receives the reciprocal of the standard deviation of the row
+        (of the root mean square if Simplified is set).
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // The sums are accumulated relative to the first element of the row, which
+    // avoids most of the cancellation in E[x^2] - E[x]^2 when the mean is large
+    // relative to the standard deviation.
+    //
+
+    float Shift = 0.0f;
+
+    if (!Simplified) {
+        Shift = Input[0] + ((Skip != nullptr) ? Skip[0] : 0.0f) + ((Bias != nullptr) ? Bias[0] : 0.0f);
+    }
+
+    const __m512 ShiftVector = _mm512_set1_ps(Shift);
+
+    __m512 SumVector0 = _mm512_setzero_ps();
+    __m512 SumVector1 = _mm512_setzero_ps();
+    __m512 SumSquareVector0 = _mm512_setzero_ps();
+    __m512 SumSquareVector1 = _mm512_setzero_ps();
+
+    size_t i = 0;
+
+    for (; i + 32 <= N; i += 32) {
+
+        __m512 Vector0 = _mm512_loadu_ps(Input + i);
+        __m512 Vector1 = _mm512_loadu_ps(Input + i + 16);
+
+        if (Skip != nullptr) {
+            Vector0 = _mm512_add_ps(Vector0, _mm512_loadu_ps(Skip + i));
+            Vector1 = _mm512_add_ps(Vector1, _mm512_loadu_ps(Skip + i + 16));
+        }
+
+        if (Bias != nullptr) {
+            Vector0 = _mm512_add_ps(Vector0, _mm512_loadu_ps(Bias + i));
+            Vector1 = _mm512_add_ps(Vector1, _mm512_loadu_ps(Bias + i + 16));
+        }
+
+        if (SkipBiasSum != nullptr) {
+            _mm512_storeu_ps(SkipBiasSum + i, Vector0);
+            _mm512_storeu_ps(SkipBiasSum + i + 16, Vector1);
+        }
+
+        _mm512_storeu_ps(Output + i, Vector0);
+        _mm512_storeu_ps(Output + i + 16, Vector1);
+
+        Vector0 = _mm512_sub_ps(Vector0, ShiftVector);
+        Vector1 = _mm512_sub_ps(Vector1, ShiftVector);
+
+        SumVector0 = _mm512_add_ps(SumVector0, Vector0);
+        SumVector1 = _mm512_add_ps(SumVector1, Vector1);
+        SumSquareVector0 = _mm512_fmadd_ps(Vector0, Vector0, SumSquareVector0);
+        SumSquareVector1 = _mm512_fmadd_ps(Vector1, Vector1, SumSquareVector1);
+    }
+
+    for (; i < N; i += 16) {
+
+        const __mmask16 Mask = __mmask16((N - i) >= 16 ? 0xFFFF : ((1u << (N - i)) - 1));
+
+        __m512 Vector = _mm512_maskz_loadu_ps(Mask, Input + i);
+
+        if (Skip != nullptr) {
+            Vector = _mm512_add_ps(Vector, _mm512_maskz_loadu_ps(Mask, Skip + i));
+        }
+
+        if (Bias != nullptr) {
+            Vector = _mm512_add_ps(Vector, _mm512_maskz_loadu_ps(Mask, Bias + i));
+        }
+
+        if (SkipBiasSum != nullptr) {
+            _mm512_mask_storeu_ps(SkipBiasSum + i, Mask, Vector);
+        }
+
+        _mm512_mask_storeu_ps(Output + i, Mask, Vector);
+
+        Vector = _mm512_maskz_sub_ps(Mask, Vector, ShiftVector);
+
+        SumVector0 = _mm512_add_ps(SumVector0, Vector);
+        SumSquareVector0 = _mm512_fmadd_ps(Vector, Vector, SumSquareVector0);
+    }
+
+    const float Sum = _mm512_reduce_add_ps(_mm512_add_ps(SumVector0, SumVector1));
+    const float SumSquare = _mm512_reduce_add_ps(_mm512_add_ps(SumSquareVector0, SumSquareVector1));
+
+    //
+    // Compute the statistics of the row. The variance is clamped at zero to
+    // guard against rounding for nearly constant rows.
+    //
+
+    const float ShiftedMean = Simplified ? 0.0f : Sum / float(N);
+    const float MeanValue = Shift + ShiftedMean;
+    const float Variance = std::max(SumSquare / float(N) - ShiftedMean * ShiftedMean, 0.0f);
+    const float InvStdDevValue = 1.0f / std::sqrt(Variance + Epsilon);
+
+    *Mean = MeanValue;
+    *InvStdDev = InvStdDevValue;
+
+    //
+    // Normalize the row.
+    //
+
+    const __m512 MeanVector = _mm512_set1_ps(MeanValue);
+    const __m512 InvStdDevVector = _mm512_set1_ps(InvStdDevValue);
+    const bool AddBeta = !Simplified && Beta != nullptr;
+
+    for (i = 0; i < N; i += 16) {
+
+        const __mmask16 Mask = __mmask16((N - i) >= 16 ? 0xFFFF : ((1u << (N - i)) - 1));
+
+        __m512 Vector = _mm512_sub_ps(_mm512_maskz_loadu_ps(Mask, Output + i), MeanVector);
+        Vector = _mm512_mul_ps(Vector, InvStdDevVector);
+
+        if (AddBeta) {
+            Vector = _mm512_fmadd_ps(Vector, _mm512_maskz_loadu_ps(Mask, Gamma + i),
+                                     _mm512_maskz_loadu_ps(Mask, Beta + i));
+        } else {
+            Vector = _mm512_mul_ps(Vector, _mm512_maskz_loadu_ps(Mask, Gamma + i));
+        }
+
+        _mm512_mask_storeu_ps(Output + i, Mask, Vector);
+    }
+}
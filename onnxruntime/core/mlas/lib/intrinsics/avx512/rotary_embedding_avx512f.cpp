@@ -0,0 +1,129 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    rotary_embedding_avx512f.cpp
+
+Abstract:
+
+    This module implements the kernel to apply rotary position embedding to a
+    row with AVX512F instructions.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasRotaryEmbedF32KernelAvx512F(
+    const float* Input,
+    const float* Sin,
+    const float* Cos,
+    size_t RotaryEmbeddingDim,
+    bool Interleaved,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine applies rotary position embedding to a row with AVX512F
+    instructions.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Sin - Supplies RotaryEmbeddingDim / 2 sine values.
+
+    Cos - Supplies RotaryEmbeddingDim / 2 cosine values.
+
+    RotaryEmbeddingDim - Supplies the number of rotated elements.
+
+    Interleaved - Supplies true if the rotated pairs are adjacent elements,
+        else element i is paired with element i + RotaryEmbeddingDim / 2.
+
+    Output - Supplies the output row, which may be the input row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t HalfDim = RotaryEmbeddingDim / 2;
+    size_t i = 0;
+
+    if (Interleaved) {
+
+        //
+        // The sine and cosine values are duplicated for the two elements of a
+        // pair. fmaddsub then computes x * c - y * s in the even lanes and
+        // y * c + x * s in the odd lanes from the pair swapped input.
+        //
+
+        const __m512i LowIndices = _mm512_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7);
+        const __m512i HighIndices = _mm512_setr_epi32(8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 14, 15, 15);
+
+        for (; i + 16 <= HalfDim; i += 16) {
+
+            __m512 CosVector = _mm512_loadu_ps(Cos + i);
+            __m512 SinVector = _mm512_loadu_ps(Sin + i);
+
+            __m512 Vector0 = _mm512_loadu_ps(Input + i * 2);
+            __m512 Vector1 = _mm512_loadu_ps(Input + i * 2 + 16);
+
+            __m512 Swapped0 = _mm512_permute_ps(Vector0, 0xB1);
+            __m512 Swapped1 = _mm512_permute_ps(Vector1, 0xB1);
+
+            __m512 Output0 = _mm512_fmaddsub_ps(Vector0, _mm512_permutexvar_ps(LowIndices, CosVector),
+                _mm512_mul_ps(Swapped0, _mm512_permutexvar_ps(LowIndices, SinVector)));
+            __m512 Output1 = _mm512_fmaddsub_ps(Vector1, _mm512_permutexvar_ps(HighIndices, CosVector),
+                _mm512_mul_ps(Swapped1, _mm512_permutexvar_ps(HighIndices, SinVector)));
+
+            _mm512_storeu_ps(Output + i * 2, Output0);
+            _mm512_storeu_ps(Output + i * 2 + 16, Output1);
+        }
+
+        for (; i < HalfDim; i++) {
+
+            const float x = Input[i * 2];
+            const float y = Input[i * 2 + 1];
+
+            Output[i * 2] = x * Cos[i] - y * Sin[i];
+            Output[i * 2 + 1] = y * Cos[i] + x * Sin[i];
+        }
+
+    } else {
+
+        const float* InputHigh = Input + HalfDim;
+        float* OutputHigh = Output + HalfDim;
+
+        for (; i + 16 <= HalfDim; i += 16) {
+
+            __m512 CosVector = _mm512_loadu_ps(Cos + i);
+            __m512 SinVector = _mm512_loadu_ps(Sin + i);
+            __m512 x = _mm512_loadu_ps(Input + i);
+            __m512 y = _mm512_loadu_ps(InputHigh + i);
+
+            __m512 Output0 = _mm512_fmsub_ps(x, CosVector, _mm512_mul_ps(y, SinVector));
+            __m512 Output1 = _mm512_fmadd_ps(y, CosVector, _mm512_mul_ps(x, SinVector));
+
+            _mm512_storeu_ps(Output + i, Output0);
+            _mm512_storeu_ps(OutputHigh + i, Output1);
+        }
+
+        for (; i < HalfDim; i++) {
+
+            const float x = Input[i];
+            const float y = InputHigh[i];
+
+            Output[i] = x * Cos[i] - y * Sin[i];
+            OutputHigh[i] = y * Cos[i] + x * Sin[i];
+        }
+    }
+}
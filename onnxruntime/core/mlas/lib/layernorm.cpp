@@ -0,0 +1,479 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements routines to compute layer normalization and RMS
+    normalization, optionally fused with the residual (skip) and bias add
+    that precedes them in transformer models.
+
+    Each row is read once to form the sum of the input, skip and bias while
+    accumulating the sum and the sum of squares, then once more from the
+    output buffer (which is still in cache) to normalize it.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Target number of elements processed by a thread partition.
+//
+
+constexpr size_t MLAS_LAYER_NORM_ELEMENTS_PER_PARTITION = 16384;
+
+void
+MLASCALL
+MlasLayerNormF32Kernel(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SkipBiasSum,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to normalize a row.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Skip - Optionally supplies the residual row added to the input.
+
+    Bias - Optionally supplies the bias row added to the input.
+
+    Gamma - Supplies the scale row.
+
+    Beta - Optionally supplies the shift row, ignored if Simplified is set.
+
+    Output - Supplies the output row. The output may alias the input.
+
+    SkipBiasSum - Optionally supplies the row that receives the sum of the
+        input, skip and bias. The row may alias the skip row.
+
+    N - Supplies the number of elements of the row.
+
+    Epsilon - Supplies the value added to the variance.
+
+    Simplified - Supplies true to compute RMS normalization, which neither
+        subtracts the mean nor adds Beta.
+
+    Mean - Receives the mean of the row, zero if Simplified is set.
+
+    InvStdDev - Receives the reciprocal of the standard deviation of the row
+        (of the root mean square if Simplified is set).
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // The sums are accumulated relative to the first element of the row, which
+    // avoids most of the cancellation in E[x^2] - E[x]^2 when the mean is large
+    // relative to the standard deviation.
+    //
+
+    float Shift = 0.0f;
+
+    if (!Simplified) {
+        Shift = Input[0] + ((Skip != nullptr) ? Skip[0] : 0.0f) + ((Bias != nullptr) ? Bias[0] : 0.0f);
+    }
+
+    const MLAS_FLOAT32X4 ShiftVector = MlasBroadcastFloat32x4(Shift);
+
+    MLAS_FLOAT32X4 SumVector0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumVector1 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumSquareVector0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumSquareVector1 = MlasZeroFloat32x4();
+
+    size_t i = 0;
+
+    for (; i + 8 <= N; i += 8) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasLoadFloat32x4(Input + i);
+        MLAS_FLOAT32X4 Vector1 = MlasLoadFloat32x4(Input + i + 4);
+
+        if (Skip != nullptr) {
+            Vector0 = MlasAddFloat32x4(Vector0, MlasLoadFloat32x4(Skip + i));
+            Vector1 = MlasAddFloat32x4(Vector1, MlasLoadFloat32x4(Skip + i + 4));
+        }
+
+        if (Bias != nullptr) {
+            Vector0 = MlasAddFloat32x4(Vector0, MlasLoadFloat32x4(Bias + i));
+            Vector1 = MlasAddFloat32x4(Vector1, MlasLoadFloat32x4(Bias + i + 4));
+        }
+
+        if (SkipBiasSum != nullptr) {
+            MlasStoreFloat32x4(SkipBiasSum + i, Vector0);
+            MlasStoreFloat32x4(SkipBiasSum + i + 4, Vector1);
+        }
+
+        MlasStoreFloat32x4(Output + i, Vector0);
+        MlasStoreFloat32x4(Output + i + 4, Vector1);
+
+        Vector0 = MlasSubtractFloat32x4(Vector0, ShiftVector);
+        Vector1 = MlasSubtractFloat32x4(Vector1, ShiftVector);
+
+        SumVector0 = MlasAddFloat32x4(SumVector0, Vector0);
+        SumVector1 = MlasAddFloat32x4(SumVector1, Vector1);
+        SumSquareVector0 = MlasMultiplyAddFloat32x4(Vector0, Vector0, SumSquareVector0);
+        SumSquareVector1 = MlasMultiplyAddFloat32x4(Vector1, Vector1, SumSquareVector1);
+    }
+
+    float Sum = MlasReduceAddFloat32x4(MlasAddFloat32x4(SumVector0, SumVector1));
+    float SumSquare = MlasReduceAddFloat32x4(MlasAddFloat32x4(SumSquareVector0, SumSquareVector1));
+
+    for (; i < N; i++) {
+
+        float Value = Input[i];
+
+        if (Skip != nullptr) {
+            Value += Skip[i];
+        }
+
+        if (Bias != nullptr) {
+            Value += Bias[i];
+        }
+
+        if (SkipBiasSum != nullptr) {
+            SkipBiasSum[i] = Value;
+        }
+
+        Output[i] = Value;
+        Value -= Shift;
+        Sum += Value;
+        SumSquare += Value * Value;
+    }
+
+    //
+    // Compute the statistics of the row. The variance is clamped at zero to
+    // guard against rounding for nearly constant rows.
+    //
+
+    const float ShiftedMean = Simplified ? 0.0f : Sum / float(N);
+    const float MeanValue = Shift + ShiftedMean;
+    const float Variance = std::max(SumSquare / float(N) - ShiftedMean * ShiftedMean, 0.0f);
+    const float InvStdDevValue = 1.0f / std::sqrt(Variance + Epsilon);
+
+    *Mean = MeanValue;
+    *InvStdDev = InvStdDevValue;
+
+    //
+    // Normalize the row.
+    //
+
+    const MLAS_FLOAT32X4 MeanVector = MlasBroadcastFloat32x4(MeanValue);
+    const MLAS_FLOAT32X4 InvStdDevVector = MlasBroadcastFloat32x4(InvStdDevValue);
+
+    i = 0;
+
+    for (; i + 4 <= N; i += 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasSubtractFloat32x4(MlasLoadFloat32x4(Output + i), MeanVector);
+        Vector = MlasMultiplyFloat32x4(Vector, InvStdDevVector);
+        Vector = MlasMultiplyFloat32x4(Vector, MlasLoadFloat32x4(Gamma + i));
+
+        if (!Simplified && Beta != nullptr) {
+            Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Beta + i));
+        }
+
+        MlasStoreFloat32x4(Output + i, Vector);
+    }
+
+    for (; i < N; i++) {
+
+        float Value = (Output[i] - MeanValue) * InvStdDevValue * Gamma[i];
+
+        if (!Simplified && Beta != nullptr) {
+            Value += Beta[i];
+        }
+
+        Output[i] = Value;
+    }
+}
+
+MLAS_FORCEINLINE
+MLAS_LAYER_NORM_FLOAT_KERNEL*
+MlasGetLayerNormF32Kernel(
+    void
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().LayerNormF32Kernel;
+#else
+    return MlasLayerNormF32Kernel;
+#endif
+}
+
+void
+MlasLayerNormPartition(
+    const MLAS_LAYER_NORM_PARAMS<float>& Params,
+    size_t RowStart,
+    size_t RowEnd
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes a partition of the rows of a float tensor.
+
+Arguments:
+
+    Params - Supplies the normalization parameters.
+
+    RowStart - Supplies the first row of the partition.
+
+    RowEnd - Supplies the row after the last row of the partition.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_LAYER_NORM_FLOAT_KERNEL* LayerNormF32Kernel = MlasGetLayerNormF32Kernel();
+
+    const size_t RowSize = Params.RowSize;
+    const float* Beta = Params.Simplified ? nullptr : Params.Beta;
+
+    for (size_t Row = RowStart; Row < RowEnd; Row++) {
+
+        const size_t Offset = Row * RowSize;
+
+        const float* Skip = nullptr;
+        if (Params.Skip != nullptr) {
+            Skip = Params.Skip + (Row % Params.SkipRowCount) * RowSize;
+        }
+
+        float* SkipBiasSum = (Params.SkipBiasSum != nullptr) ? Params.SkipBiasSum + Offset : nullptr;
+
+        float Mean;
+        float InvStdDev;
+
+        LayerNormF32Kernel(Params.Input + Offset, Skip, Params.Bias, Params.Gamma, Beta,
+                           Params.Output + Offset, SkipBiasSum, RowSize, Params.Epsilon,
+                           Params.Simplified, &Mean, &InvStdDev);
+
+        if (Params.Mean != nullptr) {
+            Params.Mean[Row] = Mean;
+        }
+
+        if (Params.InvStdDev != nullptr) {
+            Params.InvStdDev[Row] = InvStdDev;
+        }
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasConvertFloatToHalfRow(
+    const float* Source,
+    MLAS_FP16* Destination,
+    size_t Count
+    )
+{
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MLAS_FP16(Source[i]);
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasConvertHalfToFloatRow(
+    const MLAS_FP16* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    MlasConvertHalfToFloatBuffer(reinterpret_cast<const unsigned short*>(Source), Destination, Count);
+}
+
+void
+MlasLayerNormPartition(
+    const MLAS_LAYER_NORM_PARAMS<MLAS_FP16>& Params,
+    size_t RowStart,
+    size_t RowEnd
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes a partition of the rows of a half precision
+    tensor. The rows and the parameters are converted to float in a
+    per-thread buffer and normalized there.
+
+Arguments:
+
+    Params - Supplies the normalization parameters.
+
+    RowStart - Supplies the first row of the partition.
+
+    RowEnd - Supplies the row after the last row of the partition.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t RowSize = Params.RowSize;
+
+    //
+    // Carve the per-thread buffer into the converted parameters, the row and
+    // the skip row.
+    //
+
+    const size_t RowBufferSize = UpAlignSize(RowSize * sizeof(float));
+
+    MlasThreadedBufAlloc(RowBufferSize * 5);
+    uint8_t* Buffer = ThreadedBufHolder.get();
+
+    float* Gamma = reinterpret_cast<float*>(Buffer);
+    float* Beta = reinterpret_cast<float*>(Buffer + RowBufferSize);
+    float* Bias = reinterpret_cast<float*>(Buffer + RowBufferSize * 2);
+    float* RowBuffer = reinterpret_cast<float*>(Buffer + RowBufferSize * 3);
+    float* SkipBuffer = reinterpret_cast<float*>(Buffer + RowBufferSize * 4);
+
+    MlasConvertHalfToFloatRow(Params.Gamma, Gamma, RowSize);
+
+    if (Params.Beta != nullptr && !Params.Simplified) {
+        MlasConvertHalfToFloatRow(Params.Beta, Beta, RowSize);
+    } else {
+        Beta = nullptr;
+    }
+
+    if (Params.Bias != nullptr) {
+        MlasConvertHalfToFloatRow(Params.Bias, Bias, RowSize);
+    } else {
+        Bias = nullptr;
+    }
+
+    MLAS_LAYER_NORM_FLOAT_KERNEL* LayerNormF32Kernel = MlasGetLayerNormF32Kernel();
+
+    for (size_t Row = RowStart; Row < RowEnd; Row++) {
+
+        const size_t Offset = Row * RowSize;
+
+        MlasConvertHalfToFloatRow(Params.Input + Offset, RowBuffer, RowSize);
+
+        float* Skip = nullptr;
+        if (Params.Skip != nullptr) {
+            Skip = SkipBuffer;
+            MlasConvertHalfToFloatRow(Params.Skip + (Row % Params.SkipRowCount) * RowSize, Skip, RowSize);
+        }
+
+        //
+        // The sum of the input, skip and bias overwrites the converted skip
+        // row and the output overwrites the converted input row.
+        //
+
+        float* SkipBiasSum = (Params.SkipBiasSum != nullptr) ? SkipBuffer : nullptr;
+
+        float Mean;
+        float InvStdDev;
+
+        LayerNormF32Kernel(RowBuffer, Skip, Bias, Gamma, Beta, RowBuffer, SkipBiasSum, RowSize,
+                           Params.Epsilon, Params.Simplified, &Mean, &InvStdDev);
+
+        MlasConvertFloatToHalfRow(RowBuffer, Params.Output + Offset, RowSize);
+
+        if (SkipBiasSum != nullptr) {
+            MlasConvertFloatToHalfRow(SkipBiasSum, Params.SkipBiasSum + Offset, RowSize);
+        }
+
+        if (Params.Mean != nullptr) {
+            Params.Mean[Row] = Mean;
+        }
+
+        if (Params.InvStdDev != nullptr) {
+            Params.InvStdDev[Row] = InvStdDev;
+        }
+    }
+}
+
+template<typename T>
+void
+MLASCALL
+MlasLayerNormalization(
+    const MLAS_LAYER_NORM_PARAMS<T>& Params,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes layer normalization or RMS normalization of the
+    rows of a tensor, optionally fused with the residual and bias add.
+
+Arguments:
+
+    Params - Supplies the normalization parameters.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Params.RowCount == 0 || Params.RowSize == 0) {
+        return;
+    }
+
+    //
+    // Partition the rows so that each thread processes a block of roughly
+    // MLAS_LAYER_NORM_ELEMENTS_PER_PARTITION elements, but create at least
+    // one partition per thread when there are enough rows.
+    //
+
+    size_t RowsPerPartition = std::max<size_t>(MLAS_LAYER_NORM_ELEMENTS_PER_PARTITION / Params.RowSize, 1);
+
+    const size_t ThreadCount = size_t(MlasGetMaximumThreadCount(ThreadPool));
+    const size_t RowsPerThread = (Params.RowCount + ThreadCount - 1) / ThreadCount;
+
+    RowsPerPartition = std::min(RowsPerPartition, RowsPerThread);
+
+    const size_t PartitionCount = (Params.RowCount + RowsPerPartition - 1) / RowsPerPartition;
+
+    MlasTrySimpleParallel(ThreadPool, ptrdiff_t(PartitionCount), [&](ptrdiff_t Index) {
+        const size_t RowStart = size_t(Index) * RowsPerPartition;
+        const size_t RowEnd = std::min(RowStart + RowsPerPartition, Params.RowCount);
+        MlasLayerNormPartition(Params, RowStart, RowEnd);
+    });
+}
+
+template
+void
+MLASCALL
+MlasLayerNormalization<float>(
+    const MLAS_LAYER_NORM_PARAMS<float>& Params,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasLayerNormalization<MLAS_FP16>(
+    const MLAS_LAYER_NORM_PARAMS<MLAS_FP16>& Params,
+    MLAS_THREADPOOL* ThreadPool
+    );
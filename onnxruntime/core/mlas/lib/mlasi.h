@@ -191,6 +191,8 @@ class MLASCPUIDInfo
 
     bool HasArmNeon_I8MM() const { return has_arm_neon_i8mm_; }
 
+    bool HasArmSVE() const { return has_arm_sve_; }
+
     bool HasArmSVE_I8MM() const { return has_arm_sve_i8mm_; }
 
     bool HasArmNeon_BF16() const { return has_arm_neon_bf16_; }
@@ -201,6 +203,7 @@ class MLASCPUIDInfo
     bool has_arm_neon_dot_{false};
     bool has_fp16_{false};
     bool has_arm_neon_i8mm_{false};
+    bool has_arm_sve_{false};
     bool has_arm_sve_i8mm_{false};
     bool has_arm_neon_bf16_{false};
 };
@@ -610,6 +613,42 @@ void
     size_t N
     );
 
+typedef
+void
+(MLASCALL MLAS_ROTARY_EMBED_FLOAT_KERNEL)(
+    const float* Input,
+    const float* Sin,
+    const float* Cos,
+    size_t RotaryEmbeddingDim,
+    bool Interleaved,
+    float* Output
+    );
+
+typedef
+void
+(MLASCALL MLAS_CAST_F32_TO_F16_KERNEL)(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
+typedef
+void
+(MLASCALL MLAS_LAYER_NORM_FLOAT_KERNEL)(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SkipBiasSum,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    );
+
 typedef
 void
 (MLASCALL MLAS_QLINEAR_BINARY_OP_S8_KERNEL)(
@@ -861,6 +900,11 @@ extern "C" {
     MLAS_QUANTIZE_LINEAR_S8_KERNEL MlasQuantizeLinearS8KernelAvx512F;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL MlasQuantizeLinearU8KernelAvx512F;
 #endif
+#if defined(MLAS_TARGET_ARM64) && defined(MLAS_USE_SVE)
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasLogisticKernelSve;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL MlasTanhKernelSve;
+    MLAS_COMPUTE_SUMEXP_FLOAT_KERNEL MlasComputeSumExpF32KernelSve;
+#endif
 
     MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL MlasReduceMaximumF32Kernel;
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL MlasReduceMinimumMaximumF32Kernel;
@@ -870,6 +914,19 @@ extern "C" {
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL MlasReduceMinimumMaximumF32KernelAvx;
 #endif
 
+    MLAS_LAYER_NORM_FLOAT_KERNEL MlasLayerNormF32Kernel;
+    MLAS_ROTARY_EMBED_FLOAT_KERNEL MlasRotaryEmbedF32Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_LAYER_NORM_FLOAT_KERNEL MlasLayerNormF32KernelAvx512F;
+    MLAS_ROTARY_EMBED_FLOAT_KERNEL MlasRotaryEmbedF32KernelAvx2;
+    MLAS_ROTARY_EMBED_FLOAT_KERNEL MlasRotaryEmbedF32KernelAvx512F;
+#endif
+
+    MLAS_CAST_F32_TO_F16_KERNEL MlasCastF32ToF16Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_CAST_F32_TO_F16_KERNEL MlasCastF32ToF16KernelAvx2;
+#endif
+
 }
 
 //
@@ -898,7 +955,14 @@ extern "C" {
 #define MLAS_DGEMM_THREAD_COMPLEXITY                (size_t(64) * size_t(1024))
 #define MLAS_QGEMM_THREAD_COMPLEXITY                65536
 
-#if defined(__aarch64__) && defined(__linux__)
+//
+// Define the bytes of quantized B streamed by each thread of a single row
+// n-bit GEMM (GEMV), which is bound by memory bandwidth.
+//
+
+#define MLAS_SQNBIT_GEMV_BYTES_PER_THREAD           (size_t(128) * size_t(1024))
+
+#if defined(MLAS_SBGEMM_SUPPORTED)
 #define MLAS_SBGEMM_THREAD_COMPLEXITY (size_t(64) * size_t(1024))
 #endif
 
@@ -997,6 +1061,28 @@ extern const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvx512;
 
 extern const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAvx512vnni;
 
+extern const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAmx;
+
+//
+// Half precision matrix/matrix multiply dispatch structure.
+//
+
+struct MLAS_HALFGEMM_DISPATCH;
+
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx2;
+
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx512Fp16;
+
+//
+// Bfloat16 precision matrix/matrix multiply dispatch structure.
+//
+
+struct MLAS_SBGEMM_DISPATCH;
+
+extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx512Bf16;
+
+extern const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAmx;
+
 //
 // Quantized depthwise convolution kernels.
 //
@@ -1130,6 +1216,9 @@ struct MLAS_PLATFORM {
     MLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL* ComputeLogSoftmaxOutputF32Kernel;
     MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL* ReduceMaximumF32Kernel;
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL* ReduceMinimumMaximumF32Kernel;
+    MLAS_LAYER_NORM_FLOAT_KERNEL* LayerNormF32Kernel;
+    MLAS_ROTARY_EMBED_FLOAT_KERNEL* RotaryEmbedF32Kernel;
+    MLAS_CAST_F32_TO_F16_KERNEL* CastF32ToF16Kernel;
     MLAS_QUANTIZE_LINEAR_S8_KERNEL* QuantizeLinearS8Kernel;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL* QuantizeLinearU8Kernel;
     MLAS_QUANTIZE_LINEAR_S16_KERNEL* QuantizeLinearS16Kernel;
@@ -1140,6 +1229,9 @@ struct MLAS_PLATFORM {
     uint32_t PreferredBufferAlignment;
     int32_t MaximumThreadCount;
 #elif defined(MLAS_TARGET_ARM64)
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL* LogisticKernelRoutine;
+    MLAS_COMPUTE_UNARY_FLOAT_KERNEL* TanhKernelRoutine;
+    MLAS_COMPUTE_SUMEXP_FLOAT_KERNEL* ComputeSumExpF32Kernel;
     static constexpr int32_t MaximumThreadCount = MLAS_MAXIMUM_THREAD_COUNT * 4;
 #else
     static constexpr int32_t MaximumThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
@@ -1149,6 +1241,10 @@ struct MLAS_PLATFORM {
     const MLAS_Q8Q4GEMM_DISPATCH* Q8Q4GemmDispatch{nullptr};
 
     const MLAS_SQNBIT_GEMM_DISPATCH* SQNBitGemmDispatch{nullptr};
+
+    const MLAS_HALFGEMM_DISPATCH* HalfGemmDispatch{nullptr};
+
+    const MLAS_SBGEMM_DISPATCH* SBGemmDispatch{nullptr};
 };
 
 inline
@@ -1228,6 +1324,25 @@ MlasGetMaximumThreadCount(
 #endif
 }
 
+//
+// Returns the index of the NUMA node of the calling thread among the nodes
+// the thread pool spans, or -1 if it is not known.
+//
+
+inline
+int
+MlasGetCurrentNumaNode(
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+#if defined(BUILD_MLAS_NO_ONNXRUNTIME)
+    MLAS_UNREFERENCED_PARAMETER(ThreadPool);
+    return -1;
+#else
+    return onnxruntime::concurrency::ThreadPool::CurrentThreadNumaNode(ThreadPool);
+#endif
+}
+
 inline
 void
 MlasPartitionWork(
@@ -1299,6 +1414,23 @@ MlasFp32FromBits(
 #pragma warning(pop)
 #endif
 
+void
+MlasConvWinogradPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* PackedFilter,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 #if defined(MLAS_TARGET_WASM_SCALAR)
 
 void
@@ -2026,7 +2158,12 @@ MlasMultiplyAddFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2, MLAS_FL
 #elif defined(MLAS_VSX_INTRINSICS)
     return vec_madd(Vector1, Vector2, Vector3);
 #elif defined(MLAS_WASM_SIMD_INTRINSICS)
+#if defined(MLAS_TARGET_WASM_RELAXED_SIMD)
+    // Lowers to a fused multiply-add where the host supports it, otherwise to multiply and add.
+    return wasm_f32x4_relaxed_madd(Vector1, Vector2, Vector3);
+#else
     return wasm_f32x4_add(wasm_f32x4_mul(Vector1, Vector2), Vector3);
+#endif
 #elif defined(MLAS_LSX_INTRINSICS)
     return __lsx_vfmadd_s(Vector1, Vector2, Vector3);
 #else
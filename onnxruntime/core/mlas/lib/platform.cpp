@@ -56,6 +56,10 @@ MLASCPUIDInfo::MLASCPUIDInfo()
 #define HWCAP2_I8MM (1 << 13)
 #endif
 
+#ifndef HWCAP_SVE
+#define HWCAP_SVE (1 << 22)
+#endif
+
 #ifndef HWCAP2_SVEI8MM
 #define HWCAP2_SVEI8MM (1 << 9)
 #endif
@@ -73,6 +77,7 @@ MLASCPUIDInfo::MLASCPUIDInfo()
     has_fp16_ = has_arm_neon_dot_;
 
     has_arm_neon_i8mm_ = ((getauxval(AT_HWCAP2) & HWCAP2_I8MM) != 0);
+    has_arm_sve_ = ((getauxval(AT_HWCAP) & HWCAP_SVE) != 0);
     has_arm_sve_i8mm_ = ((getauxval(AT_HWCAP2) & HWCAP2_SVEI8MM) != 0);
 
     has_arm_neon_bf16_ = ((getauxval(AT_HWCAP2) & HWCAP2_BF16) != 0);
@@ -268,6 +273,9 @@ Return Value:
     this->ComputeLogSoftmaxOutputF32Kernel = MlasComputeLogSoftmaxOutputF32Kernel;
     this->ReduceMaximumF32Kernel = MlasReduceMaximumF32Kernel;
     this->ReduceMinimumMaximumF32Kernel = MlasReduceMinimumMaximumF32Kernel;
+    this->LayerNormF32Kernel = MlasLayerNormF32Kernel;
+    this->RotaryEmbedF32Kernel = MlasRotaryEmbedF32Kernel;
+    this->CastF32ToF16Kernel = MlasCastF32ToF16Kernel;
     this->QLinearAddS8Kernel = MlasQLinearAddS8Kernel;
     this->QLinearAddU8Kernel = MlasQLinearAddU8Kernel;
     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8Kernel;
@@ -375,8 +383,19 @@ Return Value:
                 this->ConvDepthwiseS8S8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, int8_t>;
                 this->ConvDepthwiseS8U8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, uint8_t>;
                 this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelFma3;
+                this->RotaryEmbedF32Kernel = MlasRotaryEmbedF32KernelAvx2;
                 this->SQNBitGemmDispatch = &MlasSQNBitGemmDispatchAvx2;
 
+                //
+                // Check if the processor supports F16C features for the half
+                // precision GEMM and conversion kernels.
+                //
+
+                if ((Cpuid1[2] & 0x20000000) != 0) {
+                    this->HalfGemmDispatch = &MlasHalfGemmDispatchAvx2;
+                    this->CastF32ToF16Kernel = MlasCastF32ToF16KernelAvx2;
+                }
+
                 //
                 // Check if the processor supports Hybrid core architecture.
                 //
@@ -425,6 +444,8 @@ Return Value:
                     this->ComputeExpF32Kernel = MlasComputeExpF32KernelAvx512F;
                     this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelAvx512F;
                     this->ReduceMaximumF32Kernel = MlasReduceMaximumF32KernelAvx512F;
+                    this->LayerNormF32Kernel = MlasLayerNormF32KernelAvx512F;
+                    this->RotaryEmbedF32Kernel = MlasRotaryEmbedF32KernelAvx512F;
                     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8KernelAvx512F;
                     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8KernelAvx512F;
                     this->NchwcBlockSize = 16;
@@ -457,6 +478,22 @@ Return Value:
                             this->Q8Q4GemmDispatch = &MlasQ8Q4GemmDispatchAvx512vnni;
                             this->SQNBitGemmDispatch = &MlasSQNBitGemmDispatchAvx512vnni;
                         }
+
+                        //
+                        // Check if the processor supports AVX512-FP16.
+                        //
+
+                        if ((Cpuid7[3] & 0x800000) != 0) {
+                            this->HalfGemmDispatch = &MlasHalfGemmDispatchAvx512Fp16;
+                        }
+
+                        //
+                        // Check if the processor supports AVX512_BF16.
+                        //
+
+                        if ((Cpuid7_1[0] & 0x20) != 0) {
+                            this->SBGemmDispatch = &MlasSBGemmDispatchAvx512Bf16;
+                        }
                     }
                 }
 
@@ -471,6 +508,27 @@ Return Value:
                     if (MlasInitAMX()) {
                         this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAmx;
                         this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAmx;
+
+                        //
+                        // Check if the processor also supports AMX-BF16 for the
+                        // SQNBitGemm kernels, which reuse the AVX512VNNI kernels
+                        // for the single row cases.
+                        //
+
+                        if ((Cpuid7[3] & 0b1 << 22) != 0 &&
+                            this->SQNBitGemmDispatch == &MlasSQNBitGemmDispatchAvx512vnni) {
+                            this->SQNBitGemmDispatch = &MlasSQNBitGemmDispatchAmx;
+                        }
+
+                        //
+                        // The AMX-BF16 SBGemm kernel computes the rows that do
+                        // not fill a tile with the AVX512_BF16 kernel.
+                        //
+
+                        if ((Cpuid7[3] & 0b1 << 22) != 0 &&
+                            this->SBGemmDispatch == &MlasSBGemmDispatchAvx512Bf16) {
+                            this->SBGemmDispatch = &MlasSBGemmDispatchAmx;
+                        }
                     }
                 }
 #endif // __APPLE__
@@ -495,6 +553,10 @@ Return Value:
     this->ConvSymU8S8Dispatch = &MlasConvSymU8DispatchNeon;
     this->ConvSymS8S8Dispatch = &MlasConvSymS8DispatchNeon;
 
+    this->LogisticKernelRoutine = MlasLogisticKernel;
+    this->TanhKernelRoutine = MlasTanhKernel;
+    this->ComputeSumExpF32Kernel = MlasComputeSumExpF32Kernel;
+
     //
     // Check if the processor supports ASIMD dot product instructions.
     //
@@ -539,6 +601,18 @@ Return Value:
     }
 #endif
 
+#if defined(MLAS_USE_SVE)
+    //
+    // Check if the processor supports SVE instructions. The kernels are vector
+    // length agnostic, so they use the full width of 256-bit and wider SVE units.
+    //
+    if (MLAS_CPUIDINFO::GetCPUIDInfo().HasArmSVE()) {
+        this->LogisticKernelRoutine = MlasLogisticKernelSve;
+        this->TanhKernelRoutine = MlasTanhKernelSve;
+        this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelSve;
+    }
+#endif
+
 #endif // MLAS_TARGET_ARM64
 #if defined(MLAS_TARGET_POWER)
     this->GemmFloatKernel = MlasSgemmKernel;
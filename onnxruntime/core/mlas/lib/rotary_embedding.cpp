@@ -0,0 +1,188 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    rotary_embedding.cpp
+
+Abstract:
+
+    This module implements rotary position embedding (RoPE) of a row.
+
+--*/
+
+#include "mlasi.h"
+
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasSwapPairsFloat32x4(
+    MLAS_FLOAT32X4 Vector
+    )
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vrev64q_f32(Vector);
+#else
+    return MlasShuffleFloat32x4<1, 0, 3, 2>(Vector);
+#endif
+}
+
+void
+MLASCALL
+MlasRotaryEmbedF32Kernel(
+    const float* Input,
+    const float* Sin,
+    const float* Cos,
+    size_t RotaryEmbeddingDim,
+    bool Interleaved,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to apply rotary position
+    embedding to a row.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Sin - Supplies RotaryEmbeddingDim / 2 sine values.
+
+    Cos - Supplies RotaryEmbeddingDim / 2 cosine values.
+
+    RotaryEmbeddingDim - Supplies the number of rotated elements.
+
+    Interleaved - Supplies true if the rotated pairs are adjacent elements,
+        else element i is paired with element i + RotaryEmbeddingDim / 2.
+
+    Output - Supplies the output row, which may be the input row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t HalfDim = RotaryEmbeddingDim / 2;
+    size_t i = 0;
+
+    if (Interleaved) {
+
+        //
+        // Each vector holds two pairs. The rotation of a pair (x, y) is
+        // (x, y) * (c, c) + (y, x) * (-s, s).
+        //
+
+        const MLAS_FLOAT32X4 SignVector = MlasBroadcastFloat32x4(-0.0f);
+        const MLAS_FLOAT32X4 SignMask = MlasInterleaveLowFloat32x4(SignVector, MlasZeroFloat32x4());
+
+        for (; i + 4 <= HalfDim; i += 4) {
+
+            MLAS_FLOAT32X4 CosVector = MlasLoadFloat32x4(Cos + i);
+            MLAS_FLOAT32X4 SinVector = MlasLoadFloat32x4(Sin + i);
+
+            MLAS_FLOAT32X4 CosLow = MlasInterleaveLowFloat32x4(CosVector, CosVector);
+            MLAS_FLOAT32X4 CosHigh = MlasInterleaveHighFloat32x4(CosVector, CosVector);
+            MLAS_FLOAT32X4 SinLow = MlasXorFloat32x4(MlasInterleaveLowFloat32x4(SinVector, SinVector), SignMask);
+            MLAS_FLOAT32X4 SinHigh = MlasXorFloat32x4(MlasInterleaveHighFloat32x4(SinVector, SinVector), SignMask);
+
+            MLAS_FLOAT32X4 Vector0 = MlasLoadFloat32x4(Input + i * 2);
+            MLAS_FLOAT32X4 Vector1 = MlasLoadFloat32x4(Input + i * 2 + 4);
+
+            MLAS_FLOAT32X4 Output0 = MlasMultiplyAddFloat32x4(MlasSwapPairsFloat32x4(Vector0), SinLow,
+                                                              MlasMultiplyFloat32x4(Vector0, CosLow));
+            MLAS_FLOAT32X4 Output1 = MlasMultiplyAddFloat32x4(MlasSwapPairsFloat32x4(Vector1), SinHigh,
+                                                              MlasMultiplyFloat32x4(Vector1, CosHigh));
+
+            MlasStoreFloat32x4(Output + i * 2, Output0);
+            MlasStoreFloat32x4(Output + i * 2 + 4, Output1);
+        }
+
+        for (; i < HalfDim; i++) {
+
+            const float x = Input[i * 2];
+            const float y = Input[i * 2 + 1];
+
+            Output[i * 2] = x * Cos[i] - y * Sin[i];
+            Output[i * 2 + 1] = y * Cos[i] + x * Sin[i];
+        }
+
+    } else {
+
+        const float* InputHigh = Input + HalfDim;
+        float* OutputHigh = Output + HalfDim;
+
+        for (; i + 4 <= HalfDim; i += 4) {
+
+            MLAS_FLOAT32X4 CosVector = MlasLoadFloat32x4(Cos + i);
+            MLAS_FLOAT32X4 SinVector = MlasLoadFloat32x4(Sin + i);
+            MLAS_FLOAT32X4 x = MlasLoadFloat32x4(Input + i);
+            MLAS_FLOAT32X4 y = MlasLoadFloat32x4(InputHigh + i);
+
+            MLAS_FLOAT32X4 Output0 = MlasSubtractFloat32x4(MlasMultiplyFloat32x4(x, CosVector),
+                                                           MlasMultiplyFloat32x4(y, SinVector));
+            MLAS_FLOAT32X4 Output1 = MlasMultiplyAddFloat32x4(x, SinVector, MlasMultiplyFloat32x4(y, CosVector));
+
+            MlasStoreFloat32x4(Output + i, Output0);
+            MlasStoreFloat32x4(OutputHigh + i, Output1);
+        }
+
+        for (; i < HalfDim; i++) {
+
+            const float x = Input[i];
+            const float y = InputHigh[i];
+
+            Output[i] = x * Cos[i] - y * Sin[i];
+            OutputHigh[i] = y * Cos[i] + x * Sin[i];
+        }
+    }
+}
+
+void
+MLASCALL
+MlasRotaryEmbedOneRow(
+    const float* Input,
+    const float* Sin,
+    const float* Cos,
+    size_t RotaryEmbeddingDim,
+    bool Interleaved,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine applies rotary position embedding to the first
+    RotaryEmbeddingDim elements of a row.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Sin - Supplies RotaryEmbeddingDim / 2 sine values.
+
+    Cos - Supplies RotaryEmbeddingDim / 2 cosine values.
+
+    RotaryEmbeddingDim - Supplies the number of rotated elements.
+
+    Interleaved - Supplies true if the rotated pairs are adjacent elements,
+        else element i is paired with element i + RotaryEmbeddingDim / 2.
+
+    Output - Supplies the output row, which may be the input row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().RotaryEmbedF32Kernel(Input, Sin, Cos, RotaryEmbeddingDim, Interleaved, Output);
+#else
+    MlasRotaryEmbedF32Kernel(Input, Sin, Cos, RotaryEmbeddingDim, Interleaved, Output);
+#endif
+}
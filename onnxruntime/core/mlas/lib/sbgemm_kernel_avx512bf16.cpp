@@ -0,0 +1,476 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sbgemm_kernel_avx512bf16.cpp
+
+Abstract:
+
+    This module implements the bfloat16 precision GEMM kernels for x64
+    processors with AVX512_BF16 and AMX-BF16 support.
+
+    Matrix B is converted to bf16 and packed in panels of 16 columns. Each
+    64 byte row of a panel holds two consecutive values of K for each of the
+    16 columns, which is the operand layout of both VDPBF16PS and the B tile
+    of TDPBF16PS, so the two kernels share the packed format. The rows of a
+    panel are padded to a multiple of 32 values of K, the depth of one tile.
+
+    Matrix A is converted to bf16 a block of rows at a time. The products
+    are accumulated in fp32.
+
+--*/
+
+#include <algorithm>
+#include <cstring>
+
+#include "sbgemm.h"
+#include "amx_common.h"
+
+#define TMM0 0
+#define TMM1 1
+#define TMM2 2
+#define TMM3 3
+#define TMM4 4
+
+struct MLAS_SBGEMM_KERNEL_AVX512BF16 {
+    static constexpr bool PackNeeded = true;
+    static constexpr size_t KernelMaxM = 8;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 32;
+    static constexpr size_t PackedN = 16;
+    static constexpr MLAS_SBGEMM_STRIDES Strides{128, 128, 256};  // M:N:K
+};
+
+struct MLAS_SBGEMM_KERNEL_AMX {
+    static constexpr bool PackNeeded = true;
+    static constexpr size_t KernelMaxM = 16;  // rows of one tile
+    static constexpr size_t PackedK = 32;
+    static constexpr size_t PackedN = 16;
+    static constexpr MLAS_SBGEMM_STRIDES Strides{128, 128, 256};  // M:N:K
+};
+
+namespace
+{
+
+constexpr size_t PANEL_N = 16;
+constexpr size_t TILE_M = 16;
+constexpr size_t TILE_K = 32;
+constexpr size_t TILE_ROW_BYTES = 64;
+
+//
+// Matrix B is packed in blocks of BLOCK_K values of K. Each block holds the
+// panels of all the columns, padded to a multiple of 16, so the kernels
+// process one block of K at a time. This also bounds the size of the stack
+// buffer holding the converted rows of A.
+//
+constexpr size_t BLOCK_K = MLAS_SBGEMM_KERNEL_AVX512BF16::Strides.K;
+
+static_assert(BLOCK_K % TILE_K == 0, "K blocks must hold whole tiles");
+
+MLAS_FORCEINLINE __m512bh
+ReinterpretAsBf16(__m512i Vector)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    return *reinterpret_cast<__m512bh*>(&Vector);
+#else
+    return (__m512bh)Vector;
+#endif
+}
+
+MLAS_FORCEINLINE __m512i
+ReinterpretAsInt(__m512bh Vector)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    return *reinterpret_cast<__m512i*>(&Vector);
+#else
+    return (__m512i)Vector;
+#endif
+}
+
+MLAS_FORCEINLINE __m256i
+ReinterpretAsInt(__m256bh Vector)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    return *reinterpret_cast<__m256i*>(&Vector);
+#else
+    return (__m256i)Vector;
+#endif
+}
+
+MLAS_FORCEINLINE __mmask16
+ColumnMask(size_t CountN)
+{
+    return static_cast<__mmask16>((CountN >= 16) ? 0xFFFF : ((1u << CountN) - 1));
+}
+
+//
+// Converts the fp32 matrix B to bf16 panels of 16 columns. Each row of a
+// panel interleaves the values of K pair (k, k + 1) of the 16 columns.
+//
+void
+ConvertPackB(bfloat16_t* D, const float* B, size_t ldb, size_t CountN, size_t CountK)
+{
+    const size_t AlignedK = (CountK + TILE_K - 1) & ~(TILE_K - 1);
+
+    //
+    // Interleaves the 16 values of row k (low half) with the 16 values of
+    // row k + 1 (high half).
+    //
+    const __m512i Interleave = _mm512_set_epi16(
+        31, 15, 30, 14, 29, 13, 28, 12, 27, 11, 26, 10, 25, 9, 24, 8,
+        23, 7, 22, 6, 21, 5, 20, 4, 19, 3, 18, 2, 17, 1, 16, 0
+    );
+
+    for (size_t n = 0; n < CountN; n += PANEL_N) {
+        const __mmask16 Mask = ColumnMask(CountN - n);
+
+        for (size_t k = 0; k < AlignedK; k += 2) {
+            const __m512 Row0 = (k < CountK) ? _mm512_maskz_loadu_ps(Mask, B + k * ldb + n) : _mm512_setzero_ps();
+            const __m512 Row1 = (k + 1 < CountK) ? _mm512_maskz_loadu_ps(Mask, B + (k + 1) * ldb + n) : _mm512_setzero_ps();
+
+            const __m512i Pairs = _mm512_permutexvar_epi16(Interleave, ReinterpretAsInt(_mm512_cvtne2ps_pbh(Row1, Row0)));
+            _mm512_storeu_si512(D, Pairs);
+            D += 2 * PANEL_N;
+        }
+    }
+}
+
+//
+// Converts CountM rows of fp32 matrix A to bf16 rows of AlignedK values,
+// padded with zeros, and zeros the rows up to PaddedM.
+//
+void
+ConvertA(uint32_t* D, const float* A, size_t lda, size_t CountM, size_t PaddedM, size_t CountK, size_t AlignedK)
+{
+    for (size_t m = 0; m < PaddedM; m++) {
+        uint16_t* d = reinterpret_cast<uint16_t*>(D + m * (AlignedK / 2));
+
+        for (size_t k = 0; k < AlignedK; k += 16) {
+            const size_t klen = (m < CountM && k < CountK) ? std::min(size_t{16}, CountK - k) : 0;
+            const __m512 Values = _mm512_maskz_loadu_ps(ColumnMask(klen), A + m * lda + k);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + k), ReinterpretAsInt(_mm512_cvtneps_pbh(Values)));
+        }
+    }
+}
+
+//
+// Stores a row of up to 16 accumulated values to C, adding the bias on the
+// first K block or the current C values on the next ones.
+//
+MLAS_FORCEINLINE void
+StoreCRow(__m512 Accumulator, float* C, const float* Bias, bool ZeroMode, __mmask16 Mask)
+{
+    if (!ZeroMode) {
+        Accumulator = _mm512_add_ps(Accumulator, _mm512_maskz_loadu_ps(Mask, C));
+    } else if (Bias != nullptr) {
+        Accumulator = _mm512_add_ps(Accumulator, _mm512_maskz_loadu_ps(Mask, Bias));
+    }
+    _mm512_mask_storeu_ps(C, Mask, Accumulator);
+}
+
+template <size_t RowCount, size_t PanelCount>
+MLAS_FORCEINLINE void
+ComputeBlockAvx512Bf16(
+    const uint32_t* APairs,
+    size_t lda_pairs,
+    const bfloat16_t* B,
+    size_t PanelStride,
+    size_t PairCount,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    size_t CountN,
+    bool ZeroMode
+)
+{
+    __m512 Accumulators[RowCount][PanelCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t p = 0; p < PanelCount; p++) {
+            Accumulators[r][p] = _mm512_setzero_ps();
+        }
+    }
+
+    for (size_t kp = 0; kp < PairCount; kp++) {
+        __m512bh BVector[PanelCount];
+        for (size_t p = 0; p < PanelCount; p++) {
+            BVector[p] = ReinterpretAsBf16(_mm512_loadu_si512(B + p * PanelStride + kp * 2 * PANEL_N));
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const __m512bh AVector = ReinterpretAsBf16(_mm512_set1_epi32(int32_t(APairs[r * lda_pairs + kp])));
+            for (size_t p = 0; p < PanelCount; p++) {
+                Accumulators[r][p] = _mm512_dpbf16_ps(Accumulators[r][p], AVector, BVector[p]);
+            }
+        }
+    }
+
+    for (size_t p = 0; p < PanelCount; p++) {
+        const size_t n = p * PANEL_N;
+        const __mmask16 Mask = ColumnMask(CountN - n);
+        for (size_t r = 0; r < RowCount; r++) {
+            StoreCRow(Accumulators[r][p], C + r * ldc + n, (Bias == nullptr) ? nullptr : Bias + n, ZeroMode, Mask);
+        }
+    }
+}
+
+template <size_t RowCount>
+void
+ComputeRowsAvx512Bf16(
+    const uint32_t* APairs,
+    size_t lda_pairs,
+    const bfloat16_t* B,
+    size_t PanelStride,
+    size_t PairCount,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    size_t CountN,
+    bool ZeroMode
+)
+{
+    for (size_t n = 0; n < CountN; n += 2 * PANEL_N) {
+        const size_t nc = std::min(CountN - n, 2 * PANEL_N);
+        const float* bias = (Bias == nullptr) ? nullptr : Bias + n;
+        const bfloat16_t* b = B + (n / PANEL_N) * PanelStride;
+
+        if (nc > PANEL_N) {
+            ComputeBlockAvx512Bf16<RowCount, 2>(APairs, lda_pairs, b, PanelStride, PairCount, C + n, ldc, bias, nc, ZeroMode);
+        } else {
+            ComputeBlockAvx512Bf16<RowCount, 1>(APairs, lda_pairs, b, PanelStride, PairCount, C + n, ldc, bias, nc, ZeroMode);
+        }
+    }
+}
+
+//
+// The tile loads and stores are inline assembly on Linux that the compiler
+// does not know to access memory. Keeps the buffer writes before a tile load
+// and the buffer reads after a tile store.
+//
+MLAS_FORCEINLINE void
+TileMemoryBarrier()
+{
+#ifndef _WIN32
+    __asm__ volatile("" ::: "memory");
+#endif
+}
+
+//
+// Loads a configuration of 16 rows of 64 bytes for all the tiles unless it is
+// already loaded.
+//
+void
+LoadTileConfig()
+{
+    tileconfig_t tc;
+    tc.palette_id = 1;
+    for (int t = 0; t < 8; t++) {
+        tc.rows[t] = TILE_M;
+        tc.colb[t] = TILE_ROW_BYTES;
+    }
+
+    tileconfig_t current_tc;
+    tile_storeconfig(&current_tc);
+    TileMemoryBarrier();
+
+    if (std::memcmp(&current_tc, &tc, sizeof(tileconfig_t)) != 0) {
+        tile_loadconfig(&tc);
+    }
+}
+
+void
+ComputeRowsAmx(
+    const uint32_t* A,
+    size_t AlignedK,
+    const bfloat16_t* B,
+    size_t PanelStride,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    size_t CountM,
+    size_t CountN,
+    bool ZeroMode
+)
+{
+    MLAS_DECLSPEC_ALIGN(float Acc[TILE_M * 2 * PANEL_N], 64);
+
+    const size_t ChunkCount = AlignedK / TILE_K;
+    const size_t lda_bytes = AlignedK * sizeof(bfloat16_t);
+
+    for (size_t n = 0; n < CountN; n += 2 * PANEL_N) {
+        const size_t nc = std::min(CountN - n, 2 * PANEL_N);
+        const bfloat16_t* b0 = B + (n / PANEL_N) * PanelStride;
+        const bfloat16_t* b1 = b0 + PanelStride;
+
+        tile_zero(TMM0);
+
+        if (nc > PANEL_N) {
+            tile_zero(TMM1);
+            for (size_t chunk = 0; chunk < ChunkCount; chunk++) {
+                tile_loadd(TMM2, reinterpret_cast<const uint16_t*>(A) + chunk * TILE_K, lda_bytes);
+                tile_loadd(TMM3, b0 + chunk * TILE_K * PANEL_N, TILE_ROW_BYTES);
+                tile_loadd(TMM4, b1 + chunk * TILE_K * PANEL_N, TILE_ROW_BYTES);
+                tile_dpbf16ps(TMM0, TMM2, TMM3);
+                tile_dpbf16ps(TMM1, TMM2, TMM4);
+            }
+            tile_stored(TMM1, Acc + PANEL_N, 2 * PANEL_N * sizeof(float));
+        } else {
+            for (size_t chunk = 0; chunk < ChunkCount; chunk++) {
+                tile_loadd(TMM2, reinterpret_cast<const uint16_t*>(A) + chunk * TILE_K, lda_bytes);
+                tile_loadd(TMM3, b0 + chunk * TILE_K * PANEL_N, TILE_ROW_BYTES);
+                tile_dpbf16ps(TMM0, TMM2, TMM3);
+            }
+        }
+        tile_stored(TMM0, Acc, 2 * PANEL_N * sizeof(float));
+
+        TileMemoryBarrier();
+
+        for (size_t p = 0; p * PANEL_N < nc; p++) {
+            const size_t pn = n + p * PANEL_N;
+            const __mmask16 Mask = ColumnMask(CountN - pn);
+            for (size_t m = 0; m < CountM; m++) {
+                StoreCRow(
+                    _mm512_load_ps(Acc + m * 2 * PANEL_N + p * PANEL_N), C + m * ldc + pn,
+                    (Bias == nullptr) ? nullptr : Bias + pn, ZeroMode, Mask
+                );
+            }
+        }
+    }
+}
+
+}  // namespace
+
+template <>
+void
+MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AVX512BF16>(
+    bfloat16_t* PackedB, const float* B, size_t ldb, size_t CountN, size_t CountK
+)
+{
+    constexpr size_t PackedN = MLAS_SBGEMM_KERNEL_AVX512BF16::PackedN;
+    const size_t AlignedN = (CountN + PackedN - 1) & ~(PackedN - 1);
+
+    //
+    // Step through each slice of matrix B along the K dimension.
+    //
+    size_t K_block_size;
+    constexpr MLAS_SBGEMM_STRIDES Strides = MLAS_SBGEMM_KERNEL_AVX512BF16::Strides;
+
+    for (size_t k = 0; k < CountK; k += K_block_size) {
+        K_block_size = std::min(CountK - k, Strides.K);
+
+        ConvertPackB(PackedB, B + k * ldb, ldb, CountN, K_block_size);
+        PackedB += AlignedN * K_block_size;
+    }
+}
+
+template <>
+void
+MlasSBGemmKernel<MLAS_SBGEMM_KERNEL_AVX512BF16>(
+    size_t CountM, size_t CountN, size_t CountK, const float* A, size_t lda, const bfloat16_t* B, float* C, size_t ldc, const float* Bias, const bool ZeroMode
+)
+{
+    constexpr size_t RowsMax = MLAS_SBGEMM_KERNEL_AVX512BF16::KernelMaxM;
+    MLAS_DECLSPEC_ALIGN(uint32_t APairs[RowsMax * BLOCK_K / 2], 64);
+
+    const size_t AlignedN = (CountN + PANEL_N - 1) & ~(PANEL_N - 1);
+
+    for (size_t m = 0; m < CountM; m += RowsMax) {
+        const size_t mc = std::min(CountM - m, RowsMax);
+
+        for (size_t k = 0; k < CountK; k += BLOCK_K) {
+            const size_t kc = std::min(CountK - k, BLOCK_K);
+            const size_t AlignedK = (kc + TILE_K - 1) & ~(TILE_K - 1);
+            const size_t lda_pairs = AlignedK / 2;
+            const size_t PanelStride = AlignedK * PANEL_N;
+
+            ConvertA(APairs, A + m * lda + k, lda, mc, mc, kc, AlignedK);
+
+            const bfloat16_t* b = B + AlignedN * k;
+            float* c = C + m * ldc;
+            const bool zero = ZeroMode && (k == 0);
+
+            switch (mc) {
+                case 1: ComputeRowsAvx512Bf16<1>(APairs, lda_pairs, b, PanelStride, lda_pairs, c, ldc, Bias, CountN, zero); break;
+                case 2: ComputeRowsAvx512Bf16<2>(APairs, lda_pairs, b, PanelStride, lda_pairs, c, ldc, Bias, CountN, zero); break;
+                case 3: ComputeRowsAvx512Bf16<3>(APairs, lda_pairs, b, PanelStride, lda_pairs, c, ldc, Bias, CountN, zero); break;
+                case 4: ComputeRowsAvx512Bf16<4>(APairs, lda_pairs, b, PanelStride, lda_pairs, c, ldc, Bias, CountN, zero); break;
+                case 5: ComputeRowsAvx512Bf16<5>(APairs, lda_pairs, b, PanelStride, lda_pairs, c, ldc, Bias, CountN, zero); break;
+                case 6: ComputeRowsAvx512Bf16<6>(APairs, lda_pairs, b, PanelStride, lda_pairs, c, ldc, Bias, CountN, zero); break;
+                case 7: ComputeRowsAvx512Bf16<7>(APairs, lda_pairs, b, PanelStride, lda_pairs, c, ldc, Bias, CountN, zero); break;
+                default: ComputeRowsAvx512Bf16<8>(APairs, lda_pairs, b, PanelStride, lda_pairs, c, ldc, Bias, CountN, zero); break;
+            }
+        }
+    }
+}
+
+template <>
+void
+MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AMX>(
+    bfloat16_t* PackedB, const float* B, size_t ldb, size_t CountN, size_t CountK
+)
+{
+    MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AVX512BF16>(PackedB, B, ldb, CountN, CountK);
+}
+
+template <>
+void
+MlasSBGemmKernel<MLAS_SBGEMM_KERNEL_AMX>(
+    size_t CountM, size_t CountN, size_t CountK, const float* A, size_t lda, const bfloat16_t* B, float* C, size_t ldc, const float* Bias, const bool ZeroMode
+)
+{
+    //
+    // Rows that do not fill a tile are computed with the AVX512_BF16 kernel.
+    //
+    const size_t TileRows = CountM - CountM % TILE_M;
+
+    if (TileRows > 0) {
+        MLAS_DECLSPEC_ALIGN(uint32_t ABf16[TILE_M * BLOCK_K / 2], 64);
+
+        const size_t AlignedN = (CountN + PANEL_N - 1) & ~(PANEL_N - 1);
+
+        LoadTileConfig();
+
+        for (size_t m = 0; m < TileRows; m += TILE_M) {
+            for (size_t k = 0; k < CountK; k += BLOCK_K) {
+                const size_t kc = std::min(CountK - k, BLOCK_K);
+                const size_t AlignedK = (kc + TILE_K - 1) & ~(TILE_K - 1);
+
+                ConvertA(ABf16, A + m * lda + k, lda, TILE_M, TILE_M, kc, AlignedK);
+
+                TileMemoryBarrier();
+
+                ComputeRowsAmx(
+                    ABf16, AlignedK, B + AlignedN * k, AlignedK * PANEL_N, C + m * ldc, ldc, Bias, TILE_M, CountN,
+                    ZeroMode && (k == 0)
+                );
+            }
+        }
+    }
+
+    if (TileRows < CountM) {
+        MlasSBGemmKernel<MLAS_SBGEMM_KERNEL_AVX512BF16>(
+            CountM - TileRows, CountN, CountK, A + TileRows * lda, lda, B, C + TileRows * ldc, ldc, Bias, ZeroMode
+        );
+    }
+}
+
+const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAvx512Bf16 = {
+    MlasSBGemmOperation<MLAS_SBGEMM_KERNEL_AVX512BF16>,
+    MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AVX512BF16>,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::PackedK,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::PackedN,
+    MLAS_SBGEMM_KERNEL_AVX512BF16::KernelMaxM,
+    0
+};
+
+const MLAS_SBGEMM_DISPATCH MlasSBGemmDispatchAmx = {
+    MlasSBGemmOperation<MLAS_SBGEMM_KERNEL_AMX>,
+    MlasSBGemmConvertPackB<MLAS_SBGEMM_KERNEL_AMX>,
+    MLAS_SBGEMM_KERNEL_AMX::PackedK,
+    MLAS_SBGEMM_KERNEL_AMX::PackedN,
+    MLAS_SBGEMM_KERNEL_AMX::KernelMaxM,
+    0
+};
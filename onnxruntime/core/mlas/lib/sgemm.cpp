@@ -17,6 +17,8 @@ Abstract:
 
 #include "mlasi.h"
 
+#include <vector>
+
 //
 // Define the number of rows from matrix A to transpose to a local buffer.
 //
@@ -1631,14 +1633,182 @@ MlasGemmBatch(
     {
         ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
         ptrdiff_t ThreadIdx = tid % ThreadsPerGemm;
+        const MLAS_SGEMM_DATA_PARAMS* GemmData = &(Data[GemmIdx]);
+
+        //
+        // Read the copy of the packed B local to the NUMA node of this thread.
+        //
+
+        MLAS_SGEMM_DATA_PARAMS LocalData;
+        if (GemmData->BIsPacked && GemmData->BNumaReplicas != nullptr) {
+            const int NumaNode = MlasGetCurrentNumaNode(ThreadPool);
+            if (NumaNode >= 0) {
+                LocalData = *GemmData;
+                LocalData.B = GemmData->BNumaReplicas[NumaNode];
+                GemmData = &LocalData;
+            }
+        }
+
         MlasSgemmThreaded(ThreadCountM, ThreadCountN,
-            TransA, TransB, M, N, K, &(Data[GemmIdx]), ThreadIdx);
+            TransA, TransB, M, N, K, GemmData, ThreadIdx);
     });
 }
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(pop)
 #endif
 
+void
+MLASCALL
+MlasGemmGrouped(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    const MLAS_SGEMM_GROUP_PARAMS* Groups,
+    size_t GroupCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a grouped single precision matrix/matrix multiply
+    operation, where each group has its own shape.
+
+    Unlike MlasGemmBatch, which splits the threads evenly across matrices of
+    the same shape, the threads are split across the groups in proportion to
+    the complexity of each group. The tiles of all the groups are then
+    dispatched to the thread pool with a single parallel loop.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    Groups - Supplies the array of group shapes and matrices data parameters.
+
+    GroupCount - Supplies the number of groups.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (GroupCount == 0) {
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the total complexity of the
+    // groups. Small requests should run using the single threaded path.
+    //
+
+    double Complexity = 0.0;
+
+    for (size_t g = 0; g < GroupCount; g++) {
+        Complexity += double(Groups[g].M) * double(Groups[g].N) * double(Groups[g].K);
+    }
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * GetMlasPlatform().MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = GetMlasPlatform().MaximumThreadCount;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Partition each group as a 1D partition like MlasGemmBatch. Every
+    // non-empty group gets at least one tile, so a group never waits for
+    // another one to complete. The tile index of each group is recorded to
+    // map the parallel loop index back to a group.
+    //
+
+    struct MLAS_SGEMM_GROUP_PARTITION {
+        ptrdiff_t TileStart;
+        ptrdiff_t ThreadCountM;
+        ptrdiff_t ThreadCountN;
+    };
+
+    std::vector<MLAS_SGEMM_GROUP_PARTITION> Partitions(GroupCount);
+    ptrdiff_t TileCount = 0;
+
+    for (size_t g = 0; g < GroupCount; g++) {
+
+        const size_t M = Groups[g].M;
+        const size_t N = Groups[g].N;
+        const double GroupComplexity = double(M) * double(N) * double(Groups[g].K);
+
+        Partitions[g].TileStart = TileCount;
+        Partitions[g].ThreadCountM = 0;
+        Partitions[g].ThreadCountN = 0;
+
+        if (M == 0 || N == 0) {
+            continue;
+        }
+
+        ptrdiff_t ThreadsPerGemm = 1;
+
+        if (Complexity > 0.0) {
+            ThreadsPerGemm = std::max(ptrdiff_t(double(TargetThreadCount) * GroupComplexity / Complexity + 0.5), ptrdiff_t(1));
+        }
+
+        if (N > M) {
+
+            const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
+                MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+            if (size_t(ThreadsPerGemm) > BlockedN) {
+                ThreadsPerGemm = ptrdiff_t(BlockedN);
+            }
+
+            Partitions[g].ThreadCountM = 1;
+            Partitions[g].ThreadCountN = ThreadsPerGemm;
+
+        } else {
+
+            if (size_t(ThreadsPerGemm) > M) {
+                ThreadsPerGemm = ptrdiff_t(M);
+            }
+
+            Partitions[g].ThreadCountM = ThreadsPerGemm;
+            Partitions[g].ThreadCountN = 1;
+        }
+
+        TileCount += ThreadsPerGemm;
+    }
+
+    const MLAS_SGEMM_GROUP_PARTITION* PartitionsData = Partitions.data();
+
+    MlasTrySimpleParallel(ThreadPool, TileCount, [=](ptrdiff_t tid)
+    {
+        //
+        // Find the last group that starts at or before this tile. Empty
+        // groups share the start of the next group and are skipped.
+        //
+
+        const MLAS_SGEMM_GROUP_PARTITION* Partition = std::upper_bound(
+            PartitionsData, PartitionsData + GroupCount, tid,
+            [](ptrdiff_t TileIndex, const MLAS_SGEMM_GROUP_PARTITION& p) {
+                return TileIndex < p.TileStart;
+            }) - 1;
+
+        const MLAS_SGEMM_GROUP_PARAMS& Group = Groups[Partition - PartitionsData];
+
+        MlasSgemmThreaded(Partition->ThreadCountM, Partition->ThreadCountN,
+            TransA, TransB, Group.M, Group.N, Group.K, &Group.Data, tid - Partition->TileStart);
+    });
+}
+
 size_t
 MLASCALL
 MlasGemmPackBSize(
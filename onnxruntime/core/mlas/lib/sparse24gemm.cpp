@@ -0,0 +1,286 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparse24gemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation (SGEMM) for a right hand side matrix with 2:4 structured
+    sparsity, i.e. at most two of each group of four consecutive elements of
+    a column along K are non-zero.
+
+    The packed B stores, for every column, the two values of each group and
+    their positions in the group, so it is about 60% of the size of B and
+    half of the multiply/adds are skipped.
+
+    The kernel computes a block of rows of A at a time. The block is
+    transposed into a panel so that every element of B is multiplied with a
+    contiguous vector of rows, which keeps the indexing into the groups out
+    of the vectorized loop.
+
+--*/
+
+#include "mlasi.h"
+
+namespace
+{
+
+constexpr size_t GroupSize = 4;
+constexpr size_t ValuesPerGroup = 2;
+
+// rows of A processed together, two float vectors of the panel
+constexpr size_t RowBlockSize = 8;
+
+// columns of B processed by a work item
+constexpr size_t ColumnBlockSize = 64;
+
+MLAS_FORCEINLINE
+size_t
+GroupCount(
+    size_t K
+    )
+{
+    return (K + GroupSize - 1) / GroupSize;
+}
+
+MLAS_FORCEINLINE
+float
+ElementB(
+    CBLAS_TRANSPOSE TransB,
+    const float* B,
+    size_t ldb,
+    size_t n,
+    size_t k
+    )
+{
+    return (TransB == CblasNoTrans) ? B[k * ldb + n] : B[n * ldb + k];
+}
+
+//
+// Copies the rows [m, m + RowBlockSize) of A into a panel of GroupCount(K) * 4
+// rows of RowBlockSize floats. Rows beyond M and columns beyond K are zero.
+//
+
+void
+PackPanelA(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t K,
+    const float* A,
+    size_t lda,
+    size_t m,
+    float* Panel
+    )
+{
+    const size_t RowCount = std::min(RowBlockSize, M - m);
+    const size_t PaddedK = GroupCount(K) * GroupSize;
+
+    for (size_t k = 0; k < PaddedK; k++) {
+
+        float* p = Panel + k * RowBlockSize;
+
+        for (size_t r = 0; r < RowBlockSize; r++) {
+
+            if (r < RowCount && k < K) {
+                p[r] = (TransA == CblasNoTrans) ? A[(m + r) * lda + k] : A[k * lda + (m + r)];
+            } else {
+                p[r] = 0.0f;
+            }
+        }
+    }
+}
+
+void
+Sparse24GemmBlock(
+    size_t M,
+    size_t K,
+    const float* Panel,
+    const float* PackedValues,
+    const uint8_t* PackedIndices,
+    float* C,
+    size_t ldc,
+    float alpha,
+    size_t m,
+    size_t n,
+    size_t CountN
+    )
+{
+    const size_t Groups = GroupCount(K);
+    const size_t ColumnStride = Groups * ValuesPerGroup;
+    const size_t RowCount = std::min(RowBlockSize, M - m);
+
+    for (size_t j = n; j < n + CountN; j++) {
+
+        const float* Values = PackedValues + j * ColumnStride;
+        const uint8_t* Indices = PackedIndices + j * ColumnStride;
+
+        MLAS_FLOAT32X4 Accumulator0 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator1 = MlasZeroFloat32x4();
+
+        for (size_t g = 0; g < Groups; g++) {
+
+            const float* GroupPanel = Panel + g * GroupSize * RowBlockSize;
+
+            for (size_t v = 0; v < ValuesPerGroup; v++) {
+
+                const float* Row = GroupPanel + Indices[v] * RowBlockSize;
+                MLAS_FLOAT32X4 Value = MlasBroadcastFloat32x4(Values[v]);
+
+                Accumulator0 = MlasMultiplyAddFloat32x4(Value, MlasLoadFloat32x4(Row), Accumulator0);
+                Accumulator1 = MlasMultiplyAddFloat32x4(Value, MlasLoadFloat32x4(Row + 4), Accumulator1);
+            }
+
+            Values += ValuesPerGroup;
+            Indices += ValuesPerGroup;
+        }
+
+        MLAS_FLOAT32X4 Alpha = MlasBroadcastFloat32x4(alpha);
+
+        float Output[RowBlockSize];
+        MlasStoreFloat32x4(Output, MlasMultiplyFloat32x4(Accumulator0, Alpha));
+        MlasStoreFloat32x4(Output + 4, MlasMultiplyFloat32x4(Accumulator1, Alpha));
+
+        for (size_t r = 0; r < RowCount; r++) {
+            C[(m + r) * ldc + j] = Output[r];
+        }
+    }
+}
+
+}  // namespace
+
+size_t
+MLASCALL
+MlasSparse24GemmPackBSize(
+    size_t N,
+    size_t K
+    )
+{
+    const size_t ElementCount = N * GroupCount(K) * ValuesPerGroup;
+
+    return ElementCount * (sizeof(float) + sizeof(uint8_t));
+}
+
+bool
+MLASCALL
+MlasSparse24GemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    )
+{
+    const size_t Groups = GroupCount(K);
+    const size_t ColumnStride = Groups * ValuesPerGroup;
+
+    float* PackedValues = reinterpret_cast<float*>(PackedB);
+    uint8_t* PackedIndices = reinterpret_cast<uint8_t*>(PackedValues + N * ColumnStride);
+
+    for (size_t n = 0; n < N; n++) {
+
+        for (size_t g = 0; g < Groups; g++) {
+
+            float* Values = PackedValues + n * ColumnStride + g * ValuesPerGroup;
+            uint8_t* Indices = PackedIndices + n * ColumnStride + g * ValuesPerGroup;
+
+            //
+            // Groups with fewer than two non-zero elements are filled with zeros
+            // at unused positions, which still index into the panel of A.
+            //
+
+            size_t NonZeroCount = 0;
+            Values[0] = Values[1] = 0.0f;
+            Indices[0] = 0;
+            Indices[1] = 1;
+
+            for (size_t i = 0; i < GroupSize && g * GroupSize + i < K; i++) {
+
+                const float b = ElementB(TransB, B, ldb, n, g * GroupSize + i);
+
+                if (b != 0.0f) {
+
+                    if (NonZeroCount == ValuesPerGroup) {
+                        return false;
+                    }
+
+                    Values[NonZeroCount] = b;
+                    Indices[NonZeroCount] = static_cast<uint8_t>(i);
+                    NonZeroCount++;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+void
+MLASCALL
+MlasSparse24Gemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    if (M == 0 || N == 0) {
+        return;
+    }
+
+    const size_t ColumnStride = GroupCount(K) * ValuesPerGroup;
+    const float* PackedValues = reinterpret_cast<const float*>(PackedB);
+    const uint8_t* PackedIndices = reinterpret_cast<const uint8_t*>(PackedValues + N * ColumnStride);
+
+    const size_t RowBlockCount = (M + RowBlockSize - 1) / RowBlockSize;
+    const size_t ColumnBlockCount = (N + ColumnBlockSize - 1) / ColumnBlockSize;
+    const size_t WorkCount = RowBlockCount * ColumnBlockCount;
+
+    const size_t PanelSize = GroupCount(K) * GroupSize * RowBlockSize * sizeof(float);
+
+    ptrdiff_t ThreadCount = std::min(MlasGetMaximumThreadCount(ThreadPool), static_cast<ptrdiff_t>(WorkCount));
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+        size_t WorkIndex;
+        size_t WorkRemaining;
+        MlasPartitionWork(tid, ThreadCount, WorkCount, &WorkIndex, &WorkRemaining);
+
+        MlasThreadedBufAlloc(PanelSize);
+        float* Panel = reinterpret_cast<float*>(ThreadedBufHolder.get());
+
+        //
+        // The work items of a row block are consecutive, so the panel is only
+        // packed again when a thread moves to the next row block.
+        //
+
+        size_t PackedRowBlock = RowBlockCount;
+
+        for (size_t w = WorkIndex; w < WorkIndex + WorkRemaining; w++) {
+
+            const size_t RowBlock = w / ColumnBlockCount;
+            const size_t n = (w % ColumnBlockCount) * ColumnBlockSize;
+            const size_t m = RowBlock * RowBlockSize;
+
+            if (RowBlock != PackedRowBlock) {
+                PackPanelA(TransA, M, K, A, lda, m, Panel);
+                PackedRowBlock = RowBlock;
+            }
+
+            Sparse24GemmBlock(M, K, Panel, PackedValues, PackedIndices, C, ldc, alpha,
+                              m, n, std::min(ColumnBlockSize, N - n));
+        }
+    });
+}
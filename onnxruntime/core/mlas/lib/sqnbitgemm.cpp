@@ -17,7 +17,9 @@ Abstract:
 
 #include "sqnbitgemm.h"
 
+#include <algorithm>
 #include <cassert>
+#include <vector>
 
 #include "sqnbitgemm_q8_block.h"
 
@@ -31,6 +33,11 @@ enum SQNBitGemmVariant {
 
     SQNBitGemmVariant_BitWidth4_CompFp32 = 0,
     SQNBitGemmVariant_BitWidth4_CompInt8,
+    SQNBitGemmVariant_BitWidth4_CompBf16,
+    SQNBitGemmVariant_BitWidth2_CompFp32,
+    SQNBitGemmVariant_BitWidth3_CompFp32,
+    SQNBitGemmVariant_BitWidth8_CompFp32,
+    SQNBitGemmVariant_BitWidth8_CompInt8,
 
     // End of valid variants
 
@@ -53,6 +60,25 @@ GetSQNBitGemmVariant(
             return SQNBitGemmVariant_BitWidth4_CompFp32;
         } else if (ComputeType == CompInt8) {
             return SQNBitGemmVariant_BitWidth4_CompInt8;
+        } else if (ComputeType == CompBf16) {
+            return SQNBitGemmVariant_BitWidth4_CompBf16;
+        }
+    }
+
+    // 2-bit and 3-bit B only have hardware agnostic CompFp32 kernels
+    if ((BlkBitWidth == 2 || BlkBitWidth == 3) &&
+        (BlkLen == 16 || BlkLen == 32 || BlkLen == 64 || BlkLen == 128 || BlkLen == 256) &&
+        (ComputeType == CompFp32 || ComputeType == CompUndef)) {
+        return (BlkBitWidth == 2) ? SQNBitGemmVariant_BitWidth2_CompFp32 : SQNBitGemmVariant_BitWidth3_CompFp32;
+    }
+
+    // 8-bit B has hardware agnostic CompFp32 and CompInt8 kernels
+    if (BlkBitWidth == 8 &&
+        (BlkLen == 16 || BlkLen == 32 || BlkLen == 64 || BlkLen == 128 || BlkLen == 256)) {
+        if (ComputeType == CompFp32 || ComputeType == CompUndef) {
+            return SQNBitGemmVariant_BitWidth8_CompFp32;
+        } else if (ComputeType == CompInt8) {
+            return SQNBitGemmVariant_BitWidth8_CompInt8;
         }
     }
 
@@ -84,6 +110,19 @@ MlasIsSQNBitGemmAvailable(
             return Dispatch->SQ4BitGemmKernel_CompInt8 != nullptr &&
                    Dispatch->QuantizeARow_CompInt8 != nullptr;
         }
+        case SQNBitGemmVariant_BitWidth4_CompBf16: {
+            return Dispatch->SQ4BitGemmKernel_CompBf16 != nullptr &&
+                   Dispatch->ConvertARow_CompBf16 != nullptr;
+        }
+        case SQNBitGemmVariant_BitWidth2_CompFp32:
+        case SQNBitGemmVariant_BitWidth3_CompFp32:
+        case SQNBitGemmVariant_BitWidth8_CompFp32: {
+            return true;
+        }
+        case SQNBitGemmVariant_BitWidth8_CompInt8: {
+            // A is quantized with the platform kernel
+            return Dispatch->QuantizeARow_CompInt8 != nullptr;
+        }
         default: {
             return false;
         }
@@ -112,6 +151,11 @@ SQNBitGemmPerGemmWorkspaceSize(
         return Dispatch->SQ4BitGemmPerGemmWorkspaceSize(M, N, K, BlkLen, ComputeType);
     }
 
+    if (BlkBitWidth == 8 && ComputeType == CompInt8) {
+        // workspace buffer is used for block quantization of A to int8
+        return M * MlasDivRoundup(K, BlkLen) * Q8BlkSize(BlkLen);
+    }
+
     return 0;
 }
 
@@ -131,6 +175,10 @@ SQNBitGemmPerGemmWorkspaceAlignment(
         return Dispatch->SQ4BitGemmPerGemmWorkspaceAlignment(BlkLen, ComputeType);
     }
 
+    if (BlkBitWidth == 8 && ComputeType == CompInt8) {
+        return Q8BlkAlignment();
+    }
+
     return 1;
 }
 
@@ -194,9 +242,257 @@ MlasSQNBitGemmPackQuantBDataSize(
         );
     }
 
+    if (BlkBitWidth == 2 || BlkBitWidth == 3 || BlkBitWidth == 8) {
+        // the blocks are rearranged in place, see SQNBitGenericGemmPackQuantBData()
+        return N * MlasDivRoundup(K, BlkLen) * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    }
+
     return 0;
 }
 
+namespace
+{
+
+//
+// 2-bit, 3-bit and 8-bit quantized B.
+//
+// B is given as blocks of little endian bit streams, value i of a block taking bits [i * BlkBitWidth, (i + 1) *
+// BlkBitWidth). The packed blocks have the same size but are split in bit planes so that a block is unpacked with
+// shifts and masks of whole bytes, which the compiler vectorizes:
+//  - a 2-bit plane of BlkLen / 4 bytes, where bits [2 * t, 2 * t + 2) of byte j hold the low 2 bits of
+//    value t * BlkLen / 4 + j.
+//  - for 3-bit B, a 1-bit plane of BlkLen / 8 bytes, where bit t of byte j holds bit 2 of value t * BlkLen / 8 + j.
+//
+// 8-bit blocks are one byte per value and are used as is.
+//
+// Zero points are packed like the block data, ceil(BlockCountK * BlkBitWidth / 8) bytes per column.
+//
+
+MLAS_FORCEINLINE uint8_t
+QNBitStreamGetValue(const std::byte* Stream, size_t BitWidth, size_t Index)
+{
+    const size_t BitOffset = Index * BitWidth;
+    const size_t Shift = BitOffset % 8;
+
+    uint32_t Bits = std::to_integer<uint32_t>(Stream[BitOffset / 8]) >> Shift;
+    if (Shift + BitWidth > 8) {
+        Bits |= std::to_integer<uint32_t>(Stream[BitOffset / 8 + 1]) << (8 - Shift);
+    }
+
+    return static_cast<uint8_t>(Bits & ((1u << BitWidth) - 1));
+}
+
+template <size_t BlkBitWidth>
+void
+SQNBitGenericGemmPackQuantBData(
+    size_t N,
+    size_t K,
+    size_t BlkLen,
+    const std::byte* QuantBDataBegin,
+    std::byte* PackedQuantBDataBegin,
+    MLAS_THREADPOOL* ThreadPool
+)
+{
+    const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
+    const size_t BlkDataSize = MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t LowPlaneSize = BlkLen / 4;
+    [[maybe_unused]] const size_t HighPlaneSize = BlkLen / 8;  // only used if BlkBitWidth is 3
+
+    MlasTrySimpleParallel(ThreadPool, N * BlockCountK, [&](ptrdiff_t tid) {
+        const std::byte* QuantBData = QuantBDataBegin + tid * BlkDataSize;
+        std::byte* PackedQuantBData = PackedQuantBDataBegin + tid * BlkDataSize;
+
+        if constexpr (BlkBitWidth == 8) {
+            std::copy_n(QuantBData, BlkDataSize, PackedQuantBData);
+            return;
+        }
+
+        std::fill_n(PackedQuantBData, BlkDataSize, std::byte{0});
+
+        for (size_t i = 0; i < BlkLen; ++i) {
+            const uint8_t Value = QNBitStreamGetValue(QuantBData, BlkBitWidth, i);
+            PackedQuantBData[i % LowPlaneSize] |= static_cast<std::byte>((Value & 0x3) << (2 * (i / LowPlaneSize)));
+            if constexpr (BlkBitWidth == 3) {
+                PackedQuantBData[LowPlaneSize + i % HighPlaneSize] |=
+                    static_cast<std::byte>((Value >> 2) << (i / HighPlaneSize));
+            }
+        }
+    });
+}
+
+/**
+ * @brief Dequantizes a packed 2-bit, 3-bit or 8-bit block of B. All BlkLen values are written, including the padding of the
+ *        last block of a column.
+ */
+template <size_t BlkBitWidth>
+MLAS_FORCEINLINE void
+SQNBitGenericDequantBlk(
+    size_t BlkLen,
+    const std::byte* PackedBlk,
+    float Scale,
+    float ZeroPoint,
+    float* Values
+)
+{
+    if constexpr (BlkBitWidth == 8) {
+        const uint8_t* QuantValues = reinterpret_cast<const uint8_t*>(PackedBlk);
+        for (size_t i = 0; i < BlkLen; ++i) {
+            Values[i] = (static_cast<float>(QuantValues[i]) - ZeroPoint) * Scale;
+        }
+        return;
+    }
+
+    const size_t LowPlaneSize = BlkLen / 4;
+    const uint8_t* LowPlane = reinterpret_cast<const uint8_t*>(PackedBlk);
+
+    uint8_t QuantValues[256];  // the largest BlkLen
+
+    for (size_t t = 0; t < 4; ++t) {
+        for (size_t j = 0; j < LowPlaneSize; ++j) {
+            QuantValues[t * LowPlaneSize + j] = static_cast<uint8_t>((LowPlane[j] >> (2 * t)) & 0x3);
+        }
+    }
+
+    if constexpr (BlkBitWidth == 3) {
+        const size_t HighPlaneSize = BlkLen / 8;
+        const uint8_t* HighPlane = LowPlane + LowPlaneSize;
+        for (size_t t = 0; t < 8; ++t) {
+            for (size_t j = 0; j < HighPlaneSize; ++j) {
+                QuantValues[t * HighPlaneSize + j] |= static_cast<uint8_t>(((HighPlane[j] >> t) & 0x1) << 2);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < BlkLen; ++i) {
+        Values[i] = (static_cast<float>(QuantValues[i]) - ZeroPoint) * Scale;
+    }
+}
+
+template <size_t BlkBitWidth>
+MLAS_FORCEINLINE float
+SQNBitGenericZeroPoint(const std::byte* QuantBZeroPointCol, size_t BlkIdx)
+{
+    if (QuantBZeroPointCol == nullptr) {
+        return static_cast<float>(1 << (BlkBitWidth - 1));
+    }
+
+    return static_cast<float>(QNBitStreamGetValue(QuantBZeroPointCol, BlkBitWidth, BlkIdx));
+}
+
+/**
+ * @brief Multiplies a row of A with 2-bit, 3-bit or 8-bit B. Same parameters as SQ4BitGemmM1Kernel_CompFp32.
+ */
+template <size_t BlkBitWidth>
+void
+SQNBitGenericGemmM1Kernel_CompFp32(
+    size_t BlkLen,
+    const float* A,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockStrideQuantB,
+    const float* Bias
+)
+{
+    const size_t BlkDataSize = MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t StrideQuantBData = BlockStrideQuantB * BlkDataSize;
+    const size_t StrideQuantBZeroPoint = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockStrideQuantB);
+
+    MLAS_DECLSPEC_ALIGN(float Values[256], 16);  // the largest BlkLen
+
+    for (size_t n = 0; n < CountN; ++n) {
+        const std::byte* QuantBDataCol = QuantBData + n * StrideQuantBData;
+        const float* QuantBScaleCol = QuantBScale + n * BlockStrideQuantB;
+        const std::byte* QuantBZeroPointCol =
+            (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + n * StrideQuantBZeroPoint;
+
+        MLAS_FLOAT32X4 AccVector = MlasZeroFloat32x4();
+        float Acc = 0.0f;
+
+        for (size_t k = 0, k_blk_idx = 0; k < CountK; k += BlkLen, ++k_blk_idx) {
+            SQNBitGenericDequantBlk<BlkBitWidth>(
+                BlkLen, QuantBDataCol + k_blk_idx * BlkDataSize, QuantBScaleCol[k_blk_idx],
+                SQNBitGenericZeroPoint<BlkBitWidth>(QuantBZeroPointCol, k_blk_idx), Values
+            );
+
+            const size_t kklen = std::min(CountK - k, BlkLen);
+
+            size_t kk = 0;
+            for (; kk + 4 <= kklen; kk += 4) {
+                AccVector = MlasMultiplyAddFloat32x4(
+                    MlasLoadFloat32x4(A + k + kk), MlasLoadFloat32x4(Values + kk), AccVector
+                );
+            }
+            for (; kk < kklen; ++kk) {
+                Acc += A[k + kk] * Values[kk];
+            }
+        }
+
+        C[n] = Acc + MlasReduceAddFloat32x4(AccVector) + ((Bias == nullptr) ? 0.0f : Bias[n]);
+    }
+}
+
+/**
+ * @brief Dequantizes 2-bit, 3-bit or 8-bit B into the format expected by the Sgemm kernel. Same parameters as
+ *        Q4BitBlkDequantBForSgemm_CompFp32.
+ */
+template <size_t BlkBitWidth>
+void
+SQNBitGenericBlkDequantBForSgemm_CompFp32(
+    size_t BlkLen,
+    float* FpData,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockStrideQuantB
+)
+{
+    const size_t BlkDataSize = MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t StrideQuantBData = BlockStrideQuantB * BlkDataSize;
+    const size_t StrideQuantBZeroPoint = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockStrideQuantB);
+
+    float Values[256];  // the largest BlkLen
+
+    //
+    // Proceed down 16 column-wide regions of B, each stored as CountK rows of 16 values. Columns past CountN in the
+    // last region are zero.
+    //
+    for (size_t n = 0; n < CountN; n += 16) {
+        const size_t NCols = std::min(CountN - n, size_t{16});
+        float* Dst = FpData + n * CountK;
+
+        if (NCols < 16) {
+            std::fill_n(Dst, CountK * 16, 0.0f);
+        }
+
+        for (size_t nn = 0; nn < NCols; ++nn) {
+            const std::byte* QuantBDataCol = QuantBData + (n + nn) * StrideQuantBData;
+            const float* QuantBScaleCol = QuantBScale + (n + nn) * BlockStrideQuantB;
+            const std::byte* QuantBZeroPointCol =
+                (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + (n + nn) * StrideQuantBZeroPoint;
+
+            for (size_t k = 0, k_blk_idx = 0; k < CountK; k += BlkLen, ++k_blk_idx) {
+                SQNBitGenericDequantBlk<BlkBitWidth>(
+                    BlkLen, QuantBDataCol + k_blk_idx * BlkDataSize, QuantBScaleCol[k_blk_idx],
+                    SQNBitGenericZeroPoint<BlkBitWidth>(QuantBZeroPointCol, k_blk_idx), Values
+                );
+
+                const size_t kklen = std::min(CountK - k, BlkLen);
+                for (size_t kk = 0; kk < kklen; ++kk) {
+                    Dst[(k + kk) * 16 + nn] = Values[kk];
+                }
+            }
+        }
+    }
+}
+
+}  // namespace
+
 void MLASCALL
 MlasSQNBitGemmPackQuantBData(
     size_t N,
@@ -226,6 +522,21 @@ MlasSQNBitGemmPackQuantBData(
         );
         return;
     }
+
+    if (BlkBitWidth == 2 || BlkBitWidth == 3 || BlkBitWidth == 8) {
+        const auto PackQuantBData = (BlkBitWidth == 2)   ? SQNBitGenericGemmPackQuantBData<2>
+                                    : (BlkBitWidth == 3) ? SQNBitGenericGemmPackQuantBData<3>
+                                                         : SQNBitGenericGemmPackQuantBData<8>;
+        PackQuantBData(
+            N,
+            K,
+            BlkLen,
+            static_cast<const std::byte*>(QuantBData),
+            static_cast<std::byte*>(PackedQuantBData),
+            ThreadPool
+        );
+        return;
+    }
 }
 
 namespace
@@ -268,8 +579,9 @@ typedef void(SQNBitGemmFn)(
     size_t RangeCountN
 );
 
+template <size_t BlkBitWidth>
 void
-SQ4BitGemm_CompFp32(
+SQNBitGemm_CompFp32(
     const size_t BlkLen,
     const size_t K,
     const MLAS_SQNBIT_GEMM_DATA_PARAMS* const DataParams,
@@ -280,10 +592,20 @@ SQ4BitGemm_CompFp32(
     const size_t RangeCountN
 )
 {
-    constexpr size_t BlkBitWidth = 4;
+    static_assert(BlkBitWidth == 2 || BlkBitWidth == 3 || BlkBitWidth == 4 || BlkBitWidth == 8);
 
     MLAS_UNREFERENCED_PARAMETER(PerGemmWorkspace);
 
+    MLAS_SQNBIT_GEMM_DISPATCH::SQ4BitGemmM1Kernel_CompFp32_Fn* M1Kernel;
+    MLAS_SQNBIT_GEMM_DISPATCH::Q4BitBlkDequantBForSgemm_CompFp32_Fn* DequantBForSgemm;
+    if constexpr (BlkBitWidth == 4) {
+        M1Kernel = GetMlasPlatform().SQNBitGemmDispatch->SQ4BitGemmM1Kernel_CompFp32;
+        DequantBForSgemm = GetMlasPlatform().SQNBitGemmDispatch->Q4BitBlkDequantBForSgemm_CompFp32;
+    } else {
+        M1Kernel = SQNBitGenericGemmM1Kernel_CompFp32<BlkBitWidth>;
+        DequantBForSgemm = SQNBitGenericBlkDequantBForSgemm_CompFp32<BlkBitWidth>;
+    }
+
     const size_t lda = DataParams->lda;
     const size_t ldc = DataParams->ldc;
 
@@ -317,7 +639,7 @@ SQ4BitGemm_CompFp32(
             float* c_blk = C + n;
             const float* bias = (Bias == nullptr) ? nullptr : Bias + n;
 
-            GetMlasPlatform().SQNBitGemmDispatch->SQ4BitGemmM1Kernel_CompFp32(
+            M1Kernel(
                 BlkLen,
                 a_row, b_col, b_col_scale, b_col_zp, c_blk, CountN, K, k_blks, bias
             );
@@ -355,7 +677,7 @@ SQ4BitGemm_CompFp32(
         float* c_blk = C + n;
         const float* bias = (Bias == nullptr) ? nullptr : Bias + n;
 
-        GetMlasPlatform().SQNBitGemmDispatch->Q4BitBlkDequantBForSgemm_CompFp32(
+        DequantBForSgemm(
             BlkLen,
             dequant_b, b_col, b_col_scale, b_col_zp, CountN, K, k_blks
         );
@@ -402,10 +724,10 @@ SQ4BitGemm_CompInt8(
 )
 {
 #ifdef MLAS_TARGET_AMD64_IX86
-    if (RangeCountM != 1) {
+    if (RangeCountM != 1 && !GetMlasPlatform().SQNBitGemmDispatch->SQ4BitGemmKernel_CompInt8_IsMultiRow) {
         // perf experiment shows fp32 is faster than int8 in M > 1 cases.
         // route to fp32 compute before int8 compute is improved.
-        SQ4BitGemm_CompFp32(
+        SQNBitGemm_CompFp32<4>(
             BlkLen,
             K, DataParams, PerGemmWorkspace, RangeStartM, RangeCountM, RangeStartN, RangeCountN
         );
@@ -468,6 +790,161 @@ SQ4BitGemm_CompInt8(
     }
 }
 
+/**
+ * @brief Multiplies int8 block quantized A with 8-bit B. Each block contributes
+ *        ScaleA * ScaleB * (sum(QuantA * QuantB) - ZeroPointB * sum(QuantA)), accumulated in int32.
+ */
+void
+SQ8BitGemm_CompInt8(
+    const size_t BlkLen,
+    const size_t K,
+    const MLAS_SQNBIT_GEMM_DATA_PARAMS* const DataParams,
+    void* const PerGemmWorkspace,
+    const size_t RangeStartM,
+    const size_t RangeCountM,
+    const size_t RangeStartN,
+    const size_t RangeCountN
+)
+{
+    constexpr size_t BlkBitWidth = 8;
+
+    const size_t k_blks = MlasDivRoundup(K, BlkLen);
+
+    const size_t lda = k_blks * Q8BlkSize(BlkLen);
+    const size_t ldc = DataParams->ldc;
+    const size_t ldb = k_blks * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t k_blks_zp_bytes = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(k_blks);
+
+    const std::byte* QuantA = static_cast<const std::byte*>(PerGemmWorkspace) + RangeStartM * lda;
+
+    const std::byte* QuantBData = static_cast<const std::byte*>(DataParams->QuantBData) + RangeStartN * ldb;
+    const float* QuantBScale = DataParams->QuantBScale + RangeStartN * k_blks;
+    const uint8_t* QuantBZeroPoint =
+        (DataParams->QuantBZeroPoint == nullptr)
+            ? nullptr
+            : static_cast<const uint8_t*>(DataParams->QuantBZeroPoint) + RangeStartN * k_blks_zp_bytes;
+
+    float* C = DataParams->C + RangeStartM * ldc + RangeStartN;
+
+    const float* Bias = (DataParams->Bias == nullptr) ? nullptr : DataParams->Bias + RangeStartN;
+
+    //
+    // The sums of the quantized A blocks are shared by all the columns of B.
+    //
+    std::vector<int32_t> QuantASums(k_blks);
+
+    for (size_t m = 0; m < RangeCountM; ++m) {
+        const std::byte* a_row = QuantA + m * lda;
+
+        for (size_t k_blk_idx = 0; k_blk_idx < k_blks; ++k_blk_idx) {
+            const int8_t* a_data = Q8BlkData(a_row + k_blk_idx * Q8BlkSize(BlkLen));
+            int32_t ASum = 0;
+            for (size_t kk = 0; kk < BlkLen; ++kk) {
+                ASum += a_data[kk];
+            }
+            QuantASums[k_blk_idx] = ASum;
+        }
+
+        for (size_t n = 0; n < RangeCountN; ++n) {
+            const uint8_t* b_col = reinterpret_cast<const uint8_t*>(QuantBData + n * ldb);
+            const float* b_col_scale = QuantBScale + n * k_blks;
+            const uint8_t* b_col_zp = (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + n * k_blks_zp_bytes;
+
+            float Acc = 0.0f;
+            for (size_t k_blk_idx = 0; k_blk_idx < k_blks; ++k_blk_idx) {
+                const std::byte* a_blk = a_row + k_blk_idx * Q8BlkSize(BlkLen);
+                const int8_t* a_data = Q8BlkData(a_blk);
+                const uint8_t* b_data = b_col + k_blk_idx * BlkLen;
+
+                // the padding of the last block of A is zero, so the padding of B doesn't contribute
+                int32_t Dot = 0;
+                for (size_t kk = 0; kk < BlkLen; ++kk) {
+                    Dot += int32_t(a_data[kk]) * int32_t(b_data[kk]);
+                }
+
+                const int32_t ZeroPoint = (b_col_zp == nullptr) ? 128 : int32_t(b_col_zp[k_blk_idx]);
+                Acc += Q8BlkScale(a_blk) * b_col_scale[k_blk_idx] * float(Dot - ZeroPoint * QuantASums[k_blk_idx]);
+            }
+
+            C[m * ldc + n] = Acc + ((Bias == nullptr) ? 0.0f : Bias[n]);
+        }
+
+        if (DataParams->PostProcessor != nullptr) {
+            DataParams->PostProcessor->Process(
+                DataParams->C, RangeStartM + m, RangeStartN, 1, RangeCountN, ldc
+            );
+        }
+    }
+}
+
+void
+SQ4BitGemm_CompBf16(
+    const size_t BlkLen,
+    const size_t K,
+    const MLAS_SQNBIT_GEMM_DATA_PARAMS* const DataParams,
+    void* const PerGemmWorkspace,
+    const size_t RangeStartM,
+    const size_t RangeCountM,
+    const size_t RangeStartN,
+    const size_t RangeCountN
+)
+{
+    constexpr size_t BlkBitWidth = 4;
+
+    const size_t k_blks = MlasDivRoundup(K, BlkLen);
+
+    const size_t lda = MlasQNBitBf16ARowLength(K, BlkLen);
+    const size_t ldc = DataParams->ldc;
+    const size_t ldb = k_blks * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t k_blks_zp_bytes = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(k_blks);
+
+    const uint16_t* ABf16 = static_cast<const uint16_t*>(PerGemmWorkspace) + RangeStartM * lda;
+
+    const std::byte* QuantBData = static_cast<const std::byte*>(DataParams->QuantBData) + RangeStartN * ldb;
+    const float* QuantBScale = DataParams->QuantBScale + RangeStartN * k_blks;
+    const std::byte* QuantBZeroPoint =
+        (DataParams->QuantBZeroPoint == nullptr)
+            ? nullptr
+            : static_cast<const std::byte*>(DataParams->QuantBZeroPoint) + RangeStartN * k_blks_zp_bytes;
+
+    float* C = DataParams->C + RangeStartM * ldc + RangeStartN;
+
+    const float* Bias = (DataParams->Bias == nullptr) ? nullptr : DataParams->Bias + RangeStartN;
+
+    size_t CountN;
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
+        CountN = std::min(RangeCountN - n, size_t{128});
+
+        const uint16_t* a_row = ABf16;
+        const std::byte* b_col = QuantBData + n * ldb;
+        const float* b_col_scale = QuantBScale + n * k_blks;
+        const std::byte* b_col_zp =
+            (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + n * k_blks_zp_bytes;
+        float* c_blk = C + n;
+        const float* bias = (Bias == nullptr) ? nullptr : Bias + n;
+
+        size_t RowsRemaining = RangeCountM;
+        while (RowsRemaining > 0) {
+            const auto RowsHandled = GetMlasPlatform().SQNBitGemmDispatch->SQ4BitGemmKernel_CompBf16(
+                BlkLen,
+                a_row, lda, b_col, b_col_scale, b_col_zp, c_blk, RowsRemaining, CountN, K, k_blks, ldc, bias
+            );
+
+            if (DataParams->PostProcessor != nullptr) {
+                DataParams->PostProcessor->Process(
+                    DataParams->C, RangeStartM + RangeCountM - RowsRemaining, RangeStartN + n,
+                    RowsHandled, CountN, ldc
+                );
+            }
+
+            c_blk += RowsHandled * ldc;
+            a_row += RowsHandled * lda;
+
+            RowsRemaining -= RowsHandled;
+        }
+    }
+}
+
 typedef void(InitializeWorkspaceFn)(
     size_t M,
     size_t N,
@@ -515,6 +992,42 @@ InitializeWorkspace_CompInt8(
     });
 }
 
+void
+InitializeWorkspace_CompBf16(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BatchN,
+    size_t BlkLen,
+    const MLAS_SQNBIT_GEMM_DATA_PARAMS* DataParams,
+    void* Workspace,
+    size_t PerGemmWorkspaceStride,
+    MLAS_THREADPOOL* ThreadPool
+)
+{
+    MLAS_UNREFERENCED_PARAMETER(N);
+
+    const auto ConvertARow = GetMlasPlatform().SQNBitGemmDispatch->ConvertARow_CompBf16;
+
+    const size_t ABf16Stride = MlasQNBitBf16ARowLength(K, BlkLen);
+
+    MlasTrySimpleParallel(ThreadPool, BatchN, [&](ptrdiff_t gemm_idx) {
+        const auto& data = DataParams[gemm_idx];
+
+        const float* ARowPtr = data.A;
+        uint16_t* ABf16RowPtr = reinterpret_cast<uint16_t*>(
+            static_cast<std::byte*>(Workspace) + gemm_idx * PerGemmWorkspaceStride
+        );
+
+        for (size_t m = 0; m < M; ++m) {
+            ConvertARow(BlkLen, ARowPtr, K, ABf16RowPtr);
+
+            ARowPtr += data.lda;
+            ABf16RowPtr += ABf16Stride;
+        }
+    });
+}
+
 struct Operations {
     InitializeWorkspaceFn* InitializeWorkspace = nullptr;
     SQNBitGemmFn* SQNBitGemm = nullptr;
@@ -523,11 +1036,23 @@ struct Operations {
 constexpr auto OperationMap = []() {
     std::array<Operations, SQNBitGemmVariantCount> ops;
 
-    ops[SQNBitGemmVariant_BitWidth4_CompFp32].SQNBitGemm = SQ4BitGemm_CompFp32;
+    ops[SQNBitGemmVariant_BitWidth4_CompFp32].SQNBitGemm = SQNBitGemm_CompFp32<4>;
 
     ops[SQNBitGemmVariant_BitWidth4_CompInt8].InitializeWorkspace = InitializeWorkspace_CompInt8;
     ops[SQNBitGemmVariant_BitWidth4_CompInt8].SQNBitGemm = SQ4BitGemm_CompInt8;
 
+    ops[SQNBitGemmVariant_BitWidth4_CompBf16].InitializeWorkspace = InitializeWorkspace_CompBf16;
+    ops[SQNBitGemmVariant_BitWidth4_CompBf16].SQNBitGemm = SQ4BitGemm_CompBf16;
+
+    ops[SQNBitGemmVariant_BitWidth2_CompFp32].SQNBitGemm = SQNBitGemm_CompFp32<2>;
+
+    ops[SQNBitGemmVariant_BitWidth3_CompFp32].SQNBitGemm = SQNBitGemm_CompFp32<3>;
+
+    ops[SQNBitGemmVariant_BitWidth8_CompFp32].SQNBitGemm = SQNBitGemm_CompFp32<8>;
+
+    ops[SQNBitGemmVariant_BitWidth8_CompInt8].InitializeWorkspace = InitializeWorkspace_CompInt8;
+    ops[SQNBitGemmVariant_BitWidth8_CompInt8].SQNBitGemm = SQ8BitGemm_CompInt8;
+
     return ops;
 }();
 
@@ -582,6 +1107,40 @@ MlasSQNBitGemmBatch(
         return;
     }
 
+    if (M == 1) {
+        //
+        // A single row (token decode) is bound by the bandwidth of streaming B.
+        // The row of A is converted once above and shared by all columns, so
+        // give each thread one contiguous range of columns sized by the bytes
+        // of B it reads instead of tiling by compute complexity.
+        //
+
+        const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
+        const size_t ColumnBytes = BlockCountK * (MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen) + sizeof(float));
+
+        ptrdiff_t ThreadsPerGemm =
+            ptrdiff_t((N * ColumnBytes) / MLAS_SQNBIT_GEMV_BYTES_PER_THREAD) + 1;
+        ThreadsPerGemm = std::min(ThreadsPerGemm, MlasGetMaximumThreadCount(ThreadPool));
+
+        const size_t StrideN = MlasDivRoundup(MlasDivRoundup(N, size_t(ThreadsPerGemm)), MLAS_QGEMM_STRIDEN_THREAD_ALIGN) *
+                               MLAS_QGEMM_STRIDEN_THREAD_ALIGN;
+        const ptrdiff_t ThreadCountN = ptrdiff_t(MlasDivRoundup(N, StrideN));
+
+        MlasTrySimpleParallel(ThreadPool, ThreadCountN * BatchN, [&](ptrdiff_t tid) {
+            const auto gemm_i = tid / ThreadCountN;
+            const auto* Data = &DataParams[gemm_i];
+            void* PerGemmWorkspace = reinterpret_cast<void*>(
+                reinterpret_cast<std::byte*>(Workspace) + gemm_i * PerGemmWorkspaceStride
+            );
+
+            const size_t RangeStartN = size_t(tid % ThreadCountN) * StrideN;
+            const size_t RangeCountN = std::min(N - RangeStartN, StrideN);
+
+            ComputeOperation(BlkLen, K, Data, PerGemmWorkspace, 0, 1, RangeStartN, RangeCountN);
+        });
+        return;
+    }
+
     //
     // Compute the number of target threads given the complexity of the SGEMM
     // operation. Small requests should run using the single threaded path.
@@ -35,13 +35,23 @@ template <size_t BlkBitWidth>
 constexpr MLAS_FORCEINLINE size_t
 MlasQNBitZeroPointsForBlksSizeInBytes(size_t BlkCount)
 {
-    if constexpr (BlkBitWidth <= 4) {
-        return MlasDivRoundup(BlkCount, 2);  // 2 blocks per byte
+    if constexpr (BlkBitWidth < 8) {
+        return MlasDivRoundup(BlkCount * BlkBitWidth, 8);  // packed like the block data, e.g., 2 4-bit blocks per byte
     } else {
         return BlkCount;
     }
 }
 
+/**
+ * @brief Gets the number of elements of a row of A converted to bf16 for CompBf16.
+ *        Rows are padded with zeros to whole blocks and to a multiple of 32 elements, the K dimension of a bf16 tile.
+ */
+constexpr MLAS_FORCEINLINE size_t
+MlasQNBitBf16ARowLength(size_t K, size_t BlkLen)
+{
+    return MlasDivRoundup(MlasDivRoundup(K, BlkLen) * BlkLen, 32) * 32;
+}
+
 //
 // Kernel dispatch structure.
 //
@@ -218,6 +228,13 @@ struct MLAS_SQNBIT_GEMM_DISPATCH {
 
     SQ4BitGemmKernel_CompInt8_Fn* SQ4BitGemmKernel_CompInt8 = nullptr;
 
+    /**
+     * Set if SQ4BitGemmKernel_CompInt8 computes several rows of A at a time.
+     * Otherwise, CompInt8 requests with more than one row of A are computed with the CompFp32 kernels on x64
+     * as they are faster.
+     */
+    bool SQ4BitGemmKernel_CompInt8_IsMultiRow = false;
+
     /**
      * @brief Block quantize values from one row of matrix A from floats to quantized 8-bit integers.
      *
@@ -235,4 +252,64 @@ struct MLAS_SQNBIT_GEMM_DISPATCH {
     );
 
     QuantizeARow_CompInt8_Fn* QuantizeARow_CompInt8 = nullptr;
+
+    //
+    // CompBf16 kernel function prototypes.
+    //
+
+    /**
+     * @brief Multiply bf16 matrix A with quantized 4-bit integer matrix B.
+     *        B is block quantized and column major.
+     *
+     * @param       BlkLen              Number of values in a block.
+     * @param       A                   Supplies the A matrix converted to bf16 by ConvertARow_CompBf16.
+     * @param       lda                 Number of elements between adjacent rows of A.
+     * @param       QuantBData          Supplies the quantized B matrix block data.
+     * @param       QuantBScale         Supplies the quantized B matrix block scale values.
+     * @param       QuantBZeroPoint     Supplies the quantized B matrix block zero point values. Optional.
+     * @param[out]  C                   Supplies the output C matrix.
+     * @param       CountM              Number of rows of A and C to process, an upper bound.
+     * @param       CountN              Number of columns of B and C to process.
+     * @param       CountK              Number of columns of A and rows of B.
+     * @param       BlockCountK         Number of blocks in one row of A and one column of B.
+     * @param       ldc                 Number of elements between adjacent rows of C.
+     * @param       Bias                Bias vector of length N.
+     *
+     * @return                          The number of rows of A and C that were processed, at most CountM.
+     */
+    typedef size_t(SQ4BitGemmKernel_CompBf16_Fn)(
+        size_t BlkLen,
+        const uint16_t* A,
+        size_t lda,
+        const std::byte* QuantBData,
+        const float* QuantBScale,
+        const std::byte* QuantBZeroPoint,
+        float* C,
+        size_t CountM,
+        size_t CountN,
+        size_t CountK,
+        size_t BlockCountK,
+        size_t ldc,
+        const float* Bias
+    );
+
+    SQ4BitGemmKernel_CompBf16_Fn* SQ4BitGemmKernel_CompBf16 = nullptr;
+
+    /**
+     * @brief Convert values from one row of matrix A from floats to bf16.
+     *
+     * @param       BlkLen  Number of values in a block.
+     * @param       A       Supplies the A matrix.
+     * @param       CountK  Number of columns of A.
+     * @param[out]  ABf16   Supplies the output row of MlasQNBitBf16ARowLength(CountK, BlkLen) bf16 values.
+     *                      The values past CountK are set to zero.
+     */
+    typedef void(ConvertARow_CompBf16_Fn)(
+        size_t BlkLen,
+        const float* A,
+        size_t CountK,
+        uint16_t* ABf16
+    );
+
+    ConvertARow_CompBf16_Fn* ConvertARow_CompBf16 = nullptr;
 };
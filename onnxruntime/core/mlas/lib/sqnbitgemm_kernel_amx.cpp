@@ -0,0 +1,613 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sqnbitgemm_kernel_amx.cpp
+
+Abstract:
+
+    This module implements the float/quantized n-bit integer matrix
+    multiplication kernels for x64 amx.
+
+    The CompInt8 and CompBf16 kernels compute 16 rows of A at a time with
+    AMX-INT8 and AMX-BF16 tiles. The quantized B matrix is unpacked 32
+    columns at a time to the layout of a tile, four int8 values or two bf16
+    values of one column in each 32-bit element of a tile row. Single row
+    requests are computed with the AVX512VNNI kernels.
+
+--*/
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "sqnbitgemm.h"
+#include "sqnbitgemm_kernel_avx_common.h"
+#include "amx_common.h"
+
+#define TMM0 0
+#define TMM1 1
+#define TMM2 2
+#define TMM3 3
+#define TMM4 4
+
+namespace
+{
+
+constexpr size_t TILE_M = 16;
+constexpr size_t TILE_N = 16;
+constexpr size_t TILE_ROW_BYTES = 64;
+constexpr size_t TILE_BYTES = TILE_M * TILE_ROW_BYTES;
+
+// Number of columns of B computed at a time, one C tile for each 16 columns.
+constexpr size_t AMX_N = 2 * TILE_N;
+
+// Values of K in one row of an int8 tile and of a bf16 tile.
+constexpr size_t TILE_K_INT8 = TILE_ROW_BYTES;
+constexpr size_t TILE_K_BF16 = TILE_ROW_BYTES / sizeof(uint16_t);
+
+//
+// Loads a configuration of 16 rows of 64 bytes for all the tiles unless it is
+// already loaded. This is the same configuration as the QGEMM AMX kernel.
+//
+void
+LoadTileConfig()
+{
+    tileconfig_t tc;
+    tc.palette_id = 1;
+    for (int t = 0; t < 8; t++) {
+        tc.rows[t] = TILE_M;
+        tc.colb[t] = TILE_ROW_BYTES;
+    }
+
+    tileconfig_t current_tc;
+    tile_storeconfig(&current_tc);
+
+    if (std::memcmp(&current_tc, &tc, sizeof(tileconfig_t)) != 0) {
+        tile_loadconfig(&tc);
+    }
+}
+
+//
+// The tile loads and stores are inline assembly on Linux that the compiler
+// does not know to access memory. Keeps the buffer writes before a tile load
+// and the buffer reads after a tile store.
+//
+MLAS_FORCEINLINE void
+TileMemoryBarrier()
+{
+#ifndef _WIN32
+    __asm__ volatile("" ::: "memory");
+#endif
+}
+
+MLAS_FORCEINLINE int8_t
+GetQuantBZeroPoint(const std::byte* QuantBZeroPoint, size_t k_blk)
+{
+    if (QuantBZeroPoint == nullptr) {
+        return 8;
+    }
+
+    const std::byte zp = QuantBZeroPoint[k_blk / 2];
+    return std::to_integer<int8_t>((k_blk & 1) ? (zp >> 4) : (zp & std::byte{0x0F}));
+}
+
+//
+// Unpacks one block of quantized B data packed by SQ4BitGemmPackQuantBData to
+// int8 values in K order with the zero point subtracted.
+//
+MLAS_FORCEINLINE void
+UnpackQuantBBlk(size_t BlkLen, const std::byte* QuantBData, int8_t ZeroPoint, int8_t* Values)
+{
+    const size_t SubBlkLen = (BlkLen == 16) ? 16 : (BlkLen == 32 ? 32 : 64);
+    const size_t SubBlkDataSize = SubBlkLen / 2;
+
+    const __m256i LowMask = _mm256_set1_epi8(0x0F);
+    const __m256i Zp = _mm256_set1_epi8(ZeroPoint);
+
+    for (size_t k = 0; k < BlkLen; k += SubBlkLen) {
+        __m256i bytes;
+        if (SubBlkLen == 64) {
+            bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(QuantBData));
+        } else if (SubBlkLen == 32) {
+            bytes = _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(QuantBData)));
+        } else {
+            bytes = _mm256_castsi128_si256(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(QuantBData)));
+        }
+
+        // byte j of a sub-block holds value j in the low nibble and value j + SubBlkLen / 2 in the high nibble
+        const __m256i lo = _mm256_sub_epi8(_mm256_and_si256(bytes, LowMask), Zp);
+        const __m256i hi = _mm256_sub_epi8(_mm256_and_si256(_mm256_srli_epi16(bytes, 4), LowMask), Zp);
+
+        int8_t* dst = Values + k;
+        if (SubBlkLen == 64) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), lo);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 32), hi);
+        } else if (SubBlkLen == 32) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(lo));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm256_castsi256_si128(hi));
+        } else {
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(lo));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 8), _mm256_castsi256_si128(hi));
+        }
+
+        QuantBData += SubBlkDataSize;
+    }
+}
+
+//
+// Converts floats to bf16 with round to nearest even. The bf16 values are in
+// the low halves of the 32-bit elements.
+//
+MLAS_FORCEINLINE __m512i
+ConvertFloatToBf16(__m512 v)
+{
+    const __m512i bits = _mm512_castps_si512(v);
+    const __m512i lsb = _mm512_and_si512(_mm512_srli_epi32(bits, 16), _mm512_set1_epi32(1));
+    const __m512i rounded = _mm512_add_epi32(bits, _mm512_add_epi32(lsb, _mm512_set1_epi32(0x7FFF)));
+    return _mm512_srli_epi32(rounded, 16);
+}
+
+//
+// Writes 16 32-bit elements of one column of B to the 16 rows of a tile.
+//
+MLAS_FORCEINLINE void
+ScatterTileColumn(std::byte* Tile, size_t Column, __m512i Elements)
+{
+    const __m512i RowOffsets = _mm512_mullo_epi32(
+        _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+        _mm512_set1_epi32(TILE_ROW_BYTES)
+    );
+    _mm512_i32scatter_epi32(Tile + Column * sizeof(int32_t), RowOffsets, Elements, 1);
+}
+
+//
+// Writes the rows of a 16x32 block of results to C.
+//
+MLAS_FORCEINLINE void
+StoreCBlock(const float* Acc, float* C, size_t ldc, size_t CountM, size_t CountN, const float* Bias)
+{
+    const __mmask16 Mask0 = static_cast<__mmask16>((CountN >= TILE_N) ? 0xFFFF : ((1u << CountN) - 1));
+    const __mmask16 Mask1 =
+        static_cast<__mmask16>((CountN >= AMX_N) ? 0xFFFF : (CountN > TILE_N ? ((1u << (CountN - TILE_N)) - 1) : 0));
+
+    const __m512 Bias0 = (Bias == nullptr) ? _mm512_setzero_ps() : _mm512_maskz_loadu_ps(Mask0, Bias);
+    const __m512 Bias1 = (Bias == nullptr) ? _mm512_setzero_ps() : _mm512_maskz_loadu_ps(Mask1, Bias + TILE_N);
+
+    for (size_t m = 0; m < CountM; m++) {
+        _mm512_mask_storeu_ps(C + m * ldc, Mask0, _mm512_add_ps(_mm512_loadu_ps(Acc + m * AMX_N), Bias0));
+        _mm512_mask_storeu_ps(
+            C + m * ldc + TILE_N, Mask1, _mm512_add_ps(_mm512_loadu_ps(Acc + m * AMX_N + TILE_N), Bias1)
+        );
+    }
+}
+
+//
+// CompInt8 kernel implementation.
+//
+
+MLAS_FORCEINLINE size_t
+Int8BlkChunkCount(size_t BlkLen)
+{
+    return std::max(BlkLen / TILE_K_INT8, size_t{1});
+}
+
+//
+// Unpacks AMX_N columns of B to int8 tiles, [block][chunk of 64 K][tile][16 rows][64 bytes], followed by the
+// scales, [block][AMX_N]. The values past the end of a block shorter than 64 and the columns past CountN are zero.
+//
+void
+PackQuantBInt8Tiles(
+    size_t BlkLen,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    size_t CountN,
+    size_t BlockCountK,
+    std::byte* PackedB,
+    float* PackedBScale
+)
+{
+    constexpr size_t BlkBitWidth = 4;
+
+    const size_t BlkDataSize = MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t ZeroPointStride = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockCountK);
+    const size_t ChunkCount = Int8BlkChunkCount(BlkLen);
+    const size_t PackedBlkSize = ChunkCount * 2 * TILE_BYTES;
+
+    MLAS_DECLSPEC_ALIGN(int8_t Values[256], 64);
+
+    for (size_t n = 0; n < AMX_N; n++) {
+        std::byte* Tile = PackedB + (n / TILE_N) * TILE_BYTES;
+        const size_t Column = n % TILE_N;
+
+        if (n >= CountN) {
+            for (size_t k_blk = 0; k_blk < BlockCountK; k_blk++) {
+                for (size_t chunk = 0; chunk < ChunkCount; chunk++) {
+                    ScatterTileColumn(Tile + k_blk * PackedBlkSize + chunk * 2 * TILE_BYTES, Column, _mm512_setzero_si512());
+                }
+                PackedBScale[k_blk * AMX_N + n] = 0.0f;
+            }
+            continue;
+        }
+
+        const std::byte* b_col = QuantBData + n * BlockCountK * BlkDataSize;
+        const std::byte* b_col_zp = (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + n * ZeroPointStride;
+
+        std::memset(Values, 0, sizeof(Values));
+
+        for (size_t k_blk = 0; k_blk < BlockCountK; k_blk++) {
+            UnpackQuantBBlk(BlkLen, b_col + k_blk * BlkDataSize, GetQuantBZeroPoint(b_col_zp, k_blk), Values);
+
+            for (size_t chunk = 0; chunk < ChunkCount; chunk++) {
+                ScatterTileColumn(
+                    Tile + k_blk * PackedBlkSize + chunk * 2 * TILE_BYTES, Column,
+                    _mm512_load_si512(Values + chunk * TILE_K_INT8)
+                );
+            }
+
+            PackedBScale[k_blk * AMX_N + n] = QuantBScale[n * BlockCountK + k_blk];
+        }
+    }
+}
+
+size_t
+SQ4BitGemmKernel_CompInt8_amx(
+    size_t BlkLen,
+    const std::byte* QuantA,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    size_t ldc,
+    const float* Bias
+)
+{
+    if (CountM <= 1) {
+        return SQ4BitGemmKernel_CompInt8_avx512vnni(
+            BlkLen, QuantA, QuantBData, QuantBScale, QuantBZeroPoint, C, CountM, CountN, CountK, BlockCountK, ldc,
+            Bias
+        );
+    }
+
+    constexpr size_t BlkBitWidth = 4;
+
+    const size_t lda = BlockCountK * Q8BlkSize(BlkLen);
+    const size_t ldb = BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t ZeroPointStride = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockCountK);
+
+    const size_t ChunkCount = Int8BlkChunkCount(BlkLen);
+    const size_t PackedBlkSize = ChunkCount * 2 * TILE_BYTES;
+    const size_t PackedBSize = BlockCountK * PackedBlkSize;
+    const size_t PackedBScaleSize = BlockCountK * AMX_N * sizeof(float);
+    const size_t AccSize = TILE_M * AMX_N * sizeof(float);
+
+    MlasThreadedBufAlloc(PackedBSize + PackedBScaleSize + 2 * AccSize);
+    std::byte* PackedB = reinterpret_cast<std::byte*>(ThreadedBufHolder.get());
+    float* PackedBScale = reinterpret_cast<float*>(PackedB + PackedBSize);
+    int32_t* Tiles = reinterpret_cast<int32_t*>(PackedB + PackedBSize + PackedBScaleSize);
+    float* Acc = reinterpret_cast<float*>(PackedB + PackedBSize + PackedBScaleSize + AccSize);
+
+    LoadTileConfig();
+
+    for (size_t n = 0; n < CountN; n += AMX_N) {
+        const size_t nc = std::min(CountN - n, AMX_N);
+
+        PackQuantBInt8Tiles(
+            BlkLen, QuantBData + n * ldb, QuantBScale + n * BlockCountK,
+            (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + n * ZeroPointStride, nc, BlockCountK,
+            PackedB, PackedBScale
+        );
+
+        for (size_t m = 0; m < CountM; m += TILE_M) {
+            const size_t mc = std::min(CountM - m, TILE_M);
+            const std::byte* a_tile = QuantA + m * lda;
+
+            std::fill_n(Acc, TILE_M * AMX_N, 0.0f);
+
+            for (size_t k_blk = 0; k_blk < BlockCountK; k_blk++) {
+                const std::byte* a_blk = a_tile + k_blk * Q8BlkSize(BlkLen);
+                const std::byte* b_blk = PackedB + k_blk * PackedBlkSize;
+
+                TileMemoryBarrier();
+
+                tile_zero(TMM0);
+                tile_zero(TMM1);
+
+                for (size_t chunk = 0; chunk < ChunkCount; chunk++) {
+                    //
+                    // For blocks shorter than 64, the A tile also reads the following blocks, which are
+                    // multiplied by the zero rows of the B tiles. The workspace is padded for the last block.
+                    //
+                    tile_loadd(TMM2, Q8BlkData(a_blk) + chunk * TILE_K_INT8, lda);
+                    tile_loadd(TMM3, b_blk, TILE_ROW_BYTES);
+                    tile_loadd(TMM4, b_blk + TILE_BYTES, TILE_ROW_BYTES);
+                    tile_dpbssd(TMM0, TMM2, TMM3);
+                    tile_dpbssd(TMM1, TMM2, TMM4);
+                    b_blk += 2 * TILE_BYTES;
+                }
+
+                tile_stored(TMM0, Tiles, AMX_N * sizeof(int32_t));
+                tile_stored(TMM1, Tiles + TILE_N, AMX_N * sizeof(int32_t));
+
+                TileMemoryBarrier();
+
+                const __m512 scale_b0 = _mm512_loadu_ps(PackedBScale + k_blk * AMX_N);
+                const __m512 scale_b1 = _mm512_loadu_ps(PackedBScale + k_blk * AMX_N + TILE_N);
+
+                for (size_t mm = 0; mm < mc; mm++) {
+                    const __m512 scale_a = _mm512_set1_ps(Q8BlkScale(a_blk + mm * lda));
+                    float* acc = Acc + mm * AMX_N;
+                    const int32_t* tiles = Tiles + mm * AMX_N;
+
+                    _mm512_storeu_ps(acc, _mm512_fmadd_ps(
+                        _mm512_cvtepi32_ps(_mm512_loadu_si512(tiles)), _mm512_mul_ps(scale_a, scale_b0),
+                        _mm512_loadu_ps(acc)
+                    ));
+                    _mm512_storeu_ps(acc + TILE_N, _mm512_fmadd_ps(
+                        _mm512_cvtepi32_ps(_mm512_loadu_si512(tiles + TILE_N)), _mm512_mul_ps(scale_a, scale_b1),
+                        _mm512_loadu_ps(acc + TILE_N)
+                    ));
+                }
+            }
+
+            StoreCBlock(Acc, C + m * ldc + n, ldc, mc, nc, (Bias == nullptr) ? nullptr : Bias + n);
+        }
+    }
+
+    return CountM;
+}
+
+//
+// CompBf16 kernel implementation.
+//
+
+//
+// Dequantizes AMX_N columns of B to bf16 tiles, [chunk of 32 K][tile][16 rows][64 bytes]. The values past the
+// end of the last block and the columns past CountN are zero.
+//
+void
+PackQuantBBf16Tiles(
+    size_t BlkLen,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    std::byte* PackedB,
+    uint16_t* Column
+)
+{
+    constexpr size_t BlkBitWidth = 4;
+
+    const size_t BlkDataSize = MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t ZeroPointStride = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockCountK);
+    const size_t PaddedK = MlasQNBitBf16ARowLength(CountK, BlkLen);
+
+    MLAS_DECLSPEC_ALIGN(int8_t Values[256], 64);
+
+    for (size_t n = 0; n < AMX_N; n++) {
+        std::byte* Tile = PackedB + (n / TILE_N) * TILE_BYTES;
+
+        std::fill_n(Column, PaddedK, uint16_t{0});
+
+        if (n < CountN) {
+            const std::byte* b_col = QuantBData + n * BlockCountK * BlkDataSize;
+            const float* b_col_scale = QuantBScale + n * BlockCountK;
+            const std::byte* b_col_zp =
+                (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + n * ZeroPointStride;
+
+            for (size_t k_blk = 0; k_blk < BlockCountK; k_blk++) {
+                UnpackQuantBBlk(BlkLen, b_col + k_blk * BlkDataSize, GetQuantBZeroPoint(b_col_zp, k_blk), Values);
+
+                const __m512 scale = _mm512_set1_ps(b_col_scale[k_blk]);
+                for (size_t kk = 0; kk < BlkLen; kk += 16) {
+                    const __m512 v = _mm512_mul_ps(
+                        _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(_mm_load_si128(reinterpret_cast<const __m128i*>(Values + kk)))),
+                        scale
+                    );
+                    _mm256_storeu_si256(
+                        reinterpret_cast<__m256i*>(Column + k_blk * BlkLen + kk),
+                        _mm512_cvtepi32_epi16(ConvertFloatToBf16(v))
+                    );
+                }
+            }
+        }
+
+        for (size_t k = 0; k < PaddedK; k += TILE_K_BF16) {
+            ScatterTileColumn(
+                Tile + (k / TILE_K_BF16) * 2 * TILE_BYTES, n % TILE_N,
+                _mm512_loadu_si512(Column + k)
+            );
+        }
+    }
+}
+
+size_t
+SQ4BitGemmKernel_CompBf16_amx(
+    size_t BlkLen,
+    const uint16_t* A,
+    size_t lda,
+    const std::byte* QuantBData,
+    const float* QuantBScale,
+    const std::byte* QuantBZeroPoint,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    size_t ldc,
+    const float* Bias
+)
+{
+    constexpr size_t BlkBitWidth = 4;
+
+    const size_t ldb = BlockCountK * MlasQNBitBlkDataSizeInBytes(BlkBitWidth, BlkLen);
+    const size_t ZeroPointStride = MlasQNBitZeroPointsForBlksSizeInBytes<BlkBitWidth>(BlockCountK);
+
+    const size_t PaddedK = MlasQNBitBf16ARowLength(CountK, BlkLen);
+    const size_t ChunkCount = PaddedK / TILE_K_BF16;
+    const size_t PackedBSize = ChunkCount * 2 * TILE_BYTES;
+    const size_t ColumnSize = UpAlignSize(PaddedK * sizeof(uint16_t));
+    const size_t AccSize = TILE_M * AMX_N * sizeof(float);
+
+    MlasThreadedBufAlloc(PackedBSize + ColumnSize + AccSize);
+    std::byte* PackedB = reinterpret_cast<std::byte*>(ThreadedBufHolder.get());
+    uint16_t* Column = reinterpret_cast<uint16_t*>(PackedB + PackedBSize);
+    float* Acc = reinterpret_cast<float*>(PackedB + PackedBSize + ColumnSize);
+
+    LoadTileConfig();
+
+    for (size_t n = 0; n < CountN; n += AMX_N) {
+        const size_t nc = std::min(CountN - n, AMX_N);
+
+        PackQuantBBf16Tiles(
+            BlkLen, QuantBData + n * ldb, QuantBScale + n * BlockCountK,
+            (QuantBZeroPoint == nullptr) ? nullptr : QuantBZeroPoint + n * ZeroPointStride, nc, CountK, BlockCountK,
+            PackedB, Column
+        );
+
+        TileMemoryBarrier();
+
+        for (size_t m = 0; m < CountM; m += TILE_M) {
+            const size_t mc = std::min(CountM - m, TILE_M);
+
+            //
+            // The A tile reads 16 rows. The workspace is padded to a multiple of 16 rows.
+            //
+            const uint16_t* a_tile = A + m * lda;
+            const std::byte* b_tile = PackedB;
+
+            tile_zero(TMM0);
+            tile_zero(TMM1);
+
+            for (size_t chunk = 0; chunk < ChunkCount; chunk++) {
+                tile_loadd(TMM2, a_tile + chunk * TILE_K_BF16, lda * sizeof(uint16_t));
+                tile_loadd(TMM3, b_tile, TILE_ROW_BYTES);
+                tile_loadd(TMM4, b_tile + TILE_BYTES, TILE_ROW_BYTES);
+                tile_dpbf16ps(TMM0, TMM2, TMM3);
+                tile_dpbf16ps(TMM1, TMM2, TMM4);
+                b_tile += 2 * TILE_BYTES;
+            }
+
+            tile_stored(TMM0, Acc, AMX_N * sizeof(float));
+            tile_stored(TMM1, Acc + TILE_N, AMX_N * sizeof(float));
+
+            TileMemoryBarrier();
+
+            StoreCBlock(Acc, C + m * ldc + n, ldc, mc, nc, (Bias == nullptr) ? nullptr : Bias + n);
+        }
+    }
+
+    return CountM;
+}
+
+void
+ConvertARow_CompBf16_amx(
+    size_t BlkLen,
+    const float* A,
+    size_t CountK,
+    uint16_t* ABf16
+)
+{
+    const size_t PaddedK = MlasQNBitBf16ARowLength(CountK, BlkLen);
+
+    for (size_t k = 0; k < PaddedK; k += 16) {
+        const size_t klen = (k < CountK) ? std::min(size_t{16}, CountK - k) : 0;
+        const __mmask16 mask = static_cast<__mmask16>((klen == 16) ? 0xFFFF : ((1u << klen) - 1));
+
+        const __m512 v = _mm512_maskz_loadu_ps(mask, A + k);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(ABf16 + k), _mm512_cvtepi32_epi16(ConvertFloatToBf16(v)));
+    }
+}
+
+//
+// Workspace size calculation function implementation.
+//
+
+size_t
+SQ4BitGemmPerGemmWorkspaceSize_amx(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BlkLen,
+    MLAS_SQNBIT_GEMM_COMPUTE_TYPE ComputeType
+)
+{
+    // the kernels read A in tiles of 16 rows, so the rows are padded to a multiple of 16
+    const size_t PaddedM = MlasDivRoundup(M, TILE_M) * TILE_M;
+
+    switch (ComputeType) {
+        case CompInt8: {
+            // the last A tile may also read 64 bytes past the last block
+            const size_t BlockCountK = MlasDivRoundup(K, BlkLen);
+            return PaddedM * BlockCountK * Q8BlkSize(BlkLen) + TILE_K_INT8;
+        }
+        case CompBf16: {
+            return PaddedM * MlasQNBitBf16ARowLength(K, BlkLen) * sizeof(uint16_t);
+        }
+        default: {
+            return SQ4BitGemmPerGemmWorkspaceSize(M, N, K, BlkLen, ComputeType);
+        }
+    }
+}
+
+size_t
+SQ4BitGemmPerGemmWorkspaceAlignment_amx(
+    size_t BlkLen,
+    MLAS_SQNBIT_GEMM_COMPUTE_TYPE ComputeType
+)
+{
+    switch (ComputeType) {
+        case CompBf16: {
+            return TILE_ROW_BYTES;
+        }
+        default: {
+            return SQ4BitGemmPerGemmWorkspaceAlignment(BlkLen, ComputeType);
+        }
+    }
+}
+
+}  // namespace
+
+void MLASCALL
+MlasQ80BlkQuantRow_avx512(
+    size_t BlkLen,
+    const float* A,
+    size_t CountK,
+    std::byte* QuantA
+);
+
+//
+// Kernel dispatch structure definition.
+//
+const MLAS_SQNBIT_GEMM_DISPATCH MlasSQNBitGemmDispatchAmx = []() {
+    MLAS_SQNBIT_GEMM_DISPATCH d;
+
+    d.SQ4BitGemmPackQuantBDataSize = SQ4BitGemmPackQuantBDataSize;
+    d.SQ4BitGemmPackQuantBData = SQ4BitGemmPackQuantBData;
+
+    d.SQ4BitGemmPerGemmWorkspaceSize = SQ4BitGemmPerGemmWorkspaceSize_amx;
+    d.SQ4BitGemmPerGemmWorkspaceAlignment = SQ4BitGemmPerGemmWorkspaceAlignment_amx;
+
+    d.SQ4BitGemmM1Kernel_CompFp32 = SQ4BitGemmM1Kernel_CompFp32_avx512vnni;
+    d.Q4BitBlkDequantBForSgemm_CompFp32 = Q4BitBlkDequantBForSgemm_CompFp32_avx2;
+
+    d.SQ4BitGemmKernel_CompInt8 = SQ4BitGemmKernel_CompInt8_amx;
+    d.SQ4BitGemmKernel_CompInt8_IsMultiRow = true;
+    d.QuantizeARow_CompInt8 = MlasQ80BlkQuantRow_avx512;
+
+    d.SQ4BitGemmKernel_CompBf16 = SQ4BitGemmKernel_CompBf16_amx;
+    d.ConvertARow_CompBf16 = ConvertARow_CompBf16_amx;
+
+    return d;
+}();
@@ -21,6 +21,24 @@ SQ4BitGemmM1Kernel_CompInt8_avx2(
     const float* Bias
 );
 
+//
+// The M=1 kernels stream the packed B columns once. Prefetch each column a fixed distance ahead of the block that
+// is being loaded so the loads of the next blocks are in flight while the current one is computed.
+//
+constexpr size_t SQ4BitGemmM1PrefetchDistance = 512;
+
+template <size_t NCols>
+MLAS_FORCEINLINE void
+PrefetchQuantBColumns(const std::byte* QuantBDataPtr, size_t StrideQuantBData)
+{
+    UnrolledLoop<NCols>([&](size_t i) {
+        _mm_prefetch(
+            reinterpret_cast<const char*>(QuantBDataPtr + StrideQuantBData * i + SQ4BitGemmM1PrefetchDistance),
+            _MM_HINT_T0
+        );
+    });
+}
+
 template <size_t NCols, bool HasZeroPoint>
 MLAS_FORCEINLINE void
 ComputeDotProducts_BlkBitWidth4_CompInt8_SubBlkLen16(
@@ -63,6 +81,8 @@ ComputeDotProducts_BlkBitWidth4_CompInt8_SubBlkLen16(
     // only used if HasZeroPoint == true
 
     for (size_t k = 0; k < CountK; k += BlkLen) {
+        PrefetchQuantBColumns<NCols>(b, StrideQuantBData);
+
         const float a_scale = Q8BlkScale(ablob);
         ablob += sizeof(float);
 
@@ -285,6 +305,8 @@ SQ4BitGemmM1Kernel_BlkLen32_CompInt8_Impl(
 
         size_t k_blks_remaining = BlockCountK;
         for (; k_blks_remaining > 1; k_blks_remaining -= 2) {
+            PrefetchQuantBColumns<NCols>(QuantBDataPtr, StrideQuantBData);
+
             const std::byte* QuantABlk0 = QuantAPtr;
             const std::byte* QuantABlk1 = QuantABlk0 + Q8BlkSize(BlkLen);
 
@@ -478,6 +500,8 @@ ComputeDotProducts_BlkBitWidth4_CompInt8_SubBlkLen64_NCols4(
     for (size_t k = 0; k < CountK; k += BlkLen) {
         size_t ck = std::min(CountK - k, BlkLen);
 
+        PrefetchQuantBColumns<4>(b_blk_data_ptr, StrideQuantBData);
+
         const float a_scale = Q8BlkScale(ablob);
         ablob += sizeof(float);
 
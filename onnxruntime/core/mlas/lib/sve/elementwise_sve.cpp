@@ -0,0 +1,308 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    elementwise_sve.cpp
+
+Abstract:
+
+    This module implements the logistic, hyperbolic tangent and sum of
+    exponential kernels using ARM SVE instructions.
+
+    The kernels use the same polynomial approximations as the generic kernels
+    in logistic.cpp, tanh.cpp and compute.cpp. They are vector length agnostic:
+    each loop iteration processes svcntw() elements and the tail is handled with
+    a predicate, so the kernels use the full width of 256-bit SVE units such as
+    the Neoverse V1 of Graviton3.
+
+    This module must be compiled with SVE enabled (for example
+    -march=armv8.2-a+sve) and MLAS_USE_SVE defined.
+
+--*/
+
+#include "mlasi.h"
+
+#include <arm_sve.h>
+
+//
+// Polynomial coefficients of the logistic function, see logistic.cpp.
+//
+
+struct MLAS_LOGISTIC_CONSTANTS_SVE {
+    static constexpr float LowerRange = -18.0f;
+    static constexpr float UpperRange = 18.0f;
+    static constexpr float alpha_9 = 4.37031012579801e-11f;
+    static constexpr float alpha_7 = 1.15627324459942e-07f;
+    static constexpr float alpha_5 = 6.08574864600143e-05f;
+    static constexpr float alpha_3 = 8.51377133304701e-03f;
+    static constexpr float alpha_1 = 2.48287947061529e-01f;
+    static constexpr float beta_10 = 6.10247389755681e-13f;
+    static constexpr float beta_8 = 5.76102136993427e-09f;
+    static constexpr float beta_6 = 6.29106785017040e-06f;
+    static constexpr float beta_4 = 1.70198817374094e-03f;
+    static constexpr float beta_2 = 1.16817656904453e-01f;
+    static constexpr float beta_0 = 9.93151921023180e-01f;
+    static constexpr float one_half = 0.5f;
+};
+
+//
+// Polynomial coefficients of the hyperbolic tangent function, see tanh.cpp.
+//
+
+struct MLAS_TANH_CONSTANTS_SVE {
+    static constexpr float LowerRange = -9.0f;
+    static constexpr float UpperRange = 9.0f;
+    static constexpr float alpha_13 = -2.76076847742355e-16f;
+    static constexpr float alpha_11 = 2.00018790482477e-13f;
+    static constexpr float alpha_9 = -8.60467152213735e-11f;
+    static constexpr float alpha_7 = 5.12229709037114e-08f;
+    static constexpr float alpha_5 = 1.48572235717979e-05f;
+    static constexpr float alpha_3 = 6.37261928875436e-04f;
+    static constexpr float alpha_1 = 4.89352455891786e-03f;
+    static constexpr float beta_6 = 1.19825839466702e-06f;
+    static constexpr float beta_4 = 1.18534705686654e-04f;
+    static constexpr float beta_2 = 2.26843463243900e-03f;
+    static constexpr float beta_0 = 4.89352518554385e-03f;
+};
+
+//
+// Constants of the exponential function, see compute.cpp.
+//
+
+struct MLAS_EXP_CONSTANTS_SVE {
+    static constexpr float LowerRangeSumExp = -88.3762626647949f;
+    static constexpr float RoundingBias = MLAS_ROUNDING_BIAS_MAGIC;
+    static constexpr float Log2Reciprocal = 1.44269504088896341f;
+    static constexpr float Log2High = -6.93145752e-1f;
+    static constexpr float Log2Low = -1.42860677e-6f;
+    static constexpr float poly_0 = 0x1.694000p-10f;
+    static constexpr float poly_1 = 0x1.125edcp-7f;
+    static constexpr float poly_2 = 0x1.555b5ap-5f;
+    static constexpr float poly_3 = 0x1.555450p-3f;
+    static constexpr float poly_4 = 0x1.fffff6p-2f;
+    static constexpr float poly_56 = 0x1.000000p+0f;
+    static constexpr int32_t MaximumExponent = int32_t(0x3F800000);
+};
+
+void
+MLASCALL
+MlasLogisticKernelSve(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the SVE kernel for the logistic function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    using C = MLAS_LOGISTIC_CONSTANTS_SVE;
+
+    for (size_t i = 0; i < N; i += svcntw()) {
+
+        const svbool_t pg = svwhilelt_b32_u64(i, N);
+
+        //
+        // N.B. FMIN and FMAX return a NaN if either input is a NaN, so a NaN
+        // input carries through to the output like in the generic kernel.
+        //
+
+        svfloat32_t Value = svld1_f32(pg, Input + i);
+        Value = svmax_n_f32_x(pg, Value, C::LowerRange);
+        Value = svmin_n_f32_x(pg, Value, C::UpperRange);
+
+        const svfloat32_t ValueSquared = svmul_f32_x(pg, Value, Value);
+
+        svfloat32_t p;
+        p = svmad_n_f32_x(pg, svdup_n_f32(C::alpha_9), ValueSquared, C::alpha_7);
+        p = svmad_n_f32_x(pg, p, ValueSquared, C::alpha_5);
+        p = svmad_n_f32_x(pg, p, ValueSquared, C::alpha_3);
+        p = svmad_n_f32_x(pg, p, ValueSquared, C::alpha_1);
+        p = svmul_f32_x(pg, p, Value);
+
+        svfloat32_t q;
+        q = svmad_n_f32_x(pg, svdup_n_f32(C::beta_10), ValueSquared, C::beta_8);
+        q = svmad_n_f32_x(pg, q, ValueSquared, C::beta_6);
+        q = svmad_n_f32_x(pg, q, ValueSquared, C::beta_4);
+        q = svmad_n_f32_x(pg, q, ValueSquared, C::beta_2);
+        q = svmad_n_f32_x(pg, q, ValueSquared, C::beta_0);
+
+        svst1_f32(pg, Output + i, svadd_n_f32_x(pg, svdiv_f32_x(pg, p, q), C::one_half));
+    }
+}
+
+void
+MLASCALL
+MlasTanhKernelSve(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the SVE kernel for the hyperbolic tangent function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    using C = MLAS_TANH_CONSTANTS_SVE;
+
+    for (size_t i = 0; i < N; i += svcntw()) {
+
+        const svbool_t pg = svwhilelt_b32_u64(i, N);
+
+        svfloat32_t Value = svld1_f32(pg, Input + i);
+        Value = svmax_n_f32_x(pg, Value, C::LowerRange);
+        Value = svmin_n_f32_x(pg, Value, C::UpperRange);
+
+        const svfloat32_t ValueSquared = svmul_f32_x(pg, Value, Value);
+
+        svfloat32_t p;
+        p = svmad_n_f32_x(pg, svdup_n_f32(C::alpha_13), ValueSquared, C::alpha_11);
+        p = svmad_n_f32_x(pg, p, ValueSquared, C::alpha_9);
+        p = svmad_n_f32_x(pg, p, ValueSquared, C::alpha_7);
+        p = svmad_n_f32_x(pg, p, ValueSquared, C::alpha_5);
+        p = svmad_n_f32_x(pg, p, ValueSquared, C::alpha_3);
+        p = svmad_n_f32_x(pg, p, ValueSquared, C::alpha_1);
+        p = svmul_f32_x(pg, p, Value);
+
+        svfloat32_t q;
+        q = svmad_n_f32_x(pg, svdup_n_f32(C::beta_6), ValueSquared, C::beta_4);
+        q = svmad_n_f32_x(pg, q, ValueSquared, C::beta_2);
+        q = svmad_n_f32_x(pg, q, ValueSquared, C::beta_0);
+
+        svst1_f32(pg, Output + i, svdiv_f32_x(pg, p, q));
+    }
+}
+
+float
+MLASCALL
+MlasComputeSumExpF32KernelSve(
+    const float* Input,
+    float* Output,
+    size_t N,
+    const float* NegativeMaximum
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the SVE kernel for the sum of exponential
+    functions.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Optionally supplies the output buffer. When used for Softmax,
+        the output buffer is used to store the intermediate exp() results. When
+        used for LogSoftmax, the intermediate exp() results are not required.
+
+    N - Supplies the number of elements to process.
+
+    NegativeMaximum - Supplies the address of the negative maximum
+        value that is added to each element before computing the exponential
+        function.
+
+Return Value:
+
+    Returns the sum of the exponential functions.
+
+--*/
+{
+    using C = MLAS_EXP_CONSTANTS_SVE;
+
+    const float NegativeMaximumValue = *NegativeMaximum;
+    svfloat32_t Accumulator = svdup_n_f32(0.0f);
+
+    for (size_t i = 0; i < N; i += svcntw()) {
+
+        const svbool_t pg = svwhilelt_b32_u64(i, N);
+
+        svfloat32_t Vector = svld1_f32(pg, Input + i);
+
+        //
+        // Subtract the maximum value from every element and clamp to the lower
+        // range of this function.
+        //
+
+        Vector = svadd_n_f32_x(pg, Vector, NegativeMaximumValue);
+        Vector = svmax_n_f32_x(pg, Vector, C::LowerRangeSumExp);
+
+        //
+        // Range reduction of the input by computing "(2 ^ m) * exp(reduced)".
+        //
+
+        const svfloat32_t biased = svmad_n_f32_x(pg, Vector, svdup_n_f32(C::Log2Reciprocal), C::RoundingBias);
+        const svfloat32_t m = svsub_n_f32_x(pg, biased, C::RoundingBias);
+
+        Vector = svmla_n_f32_x(pg, Vector, m, C::Log2High);
+        Vector = svmla_n_f32_x(pg, Vector, m, C::Log2Low);
+
+        //
+        // Compute the scaling factor used to reconstruct the "(2 ^ m)" value
+        // from above.
+        //
+
+        svint32_t normal = svlsl_n_s32_x(pg, svreinterpret_s32_f32(biased), 23);
+        normal = svadd_n_s32_x(pg, normal, C::MaximumExponent);
+
+        //
+        // Compute the polynomial approximation of exp(reduced) and reconstruct
+        // the final result using the above scale factor.
+        //
+
+        svfloat32_t p = svdup_n_f32(C::poly_0);
+        p = svmad_n_f32_x(pg, p, Vector, C::poly_1);
+        p = svmad_n_f32_x(pg, p, Vector, C::poly_2);
+        p = svmad_n_f32_x(pg, p, Vector, C::poly_3);
+        p = svmad_n_f32_x(pg, p, Vector, C::poly_4);
+        p = svmad_n_f32_x(pg, p, Vector, C::poly_56);
+        p = svmad_n_f32_x(pg, p, Vector, C::poly_56);
+        p = svmul_f32_x(pg, p, svreinterpret_f32_s32(normal));
+
+        if (Output != nullptr) {
+            svst1_f32(pg, Output + i, p);
+        }
+
+        //
+        // The inactive lanes of the tail keep their partial sums.
+        //
+
+        Accumulator = svadd_f32_m(pg, Accumulator, p);
+    }
+
+    return svaddv_f32(svptrue_b32(), Accumulator);
+}
@@ -0,0 +1,294 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/auto_mixed_precision.h"
+
+#include <algorithm>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+namespace onnxruntime {
+
+namespace {
+
+bool IsFloatTensor(const NodeArg& node_arg) {
+  if (!node_arg.Exists()) {
+    return false;
+  }
+
+  const auto* type = node_arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == TensorProto_DataType_FLOAT;
+}
+
+// Check whether the schema of the node allows `type_str` for all the formal parameters that are float in the node.
+// Parameters with a fixed type, e.g. the float scale of some contrib ops, can't be converted.
+bool SupportsType(const Node& node, const std::string& type_str) {
+  const auto* schema = node.Op();
+  if (schema == nullptr) {
+    return false;
+  }
+
+  const auto& type_constraints = schema->typeConstraintMap();
+  auto allows_type = [&type_constraints, &type_str](const OpSchema::FormalParameter& formal_parameter) {
+    auto it = type_constraints.find(formal_parameter.GetTypeStr());
+    if (it == type_constraints.end()) {
+      return false;
+    }
+
+    const auto& allowed_types = it->second.first;
+    return std::any_of(allowed_types.begin(), allowed_types.end(),
+                       [&type_str](DataType type) { return *type == type_str; });
+  };
+
+  const auto& formal_inputs = schema->inputs();
+  const auto& input_arg_counts = node.InputArgCount();
+  const auto& input_defs = node.InputDefs();
+  size_t input_idx = 0;
+  for (size_t formal_idx = 0; formal_idx < input_arg_counts.size() && formal_idx < formal_inputs.size();
+       ++formal_idx) {
+    for (int i = 0; i < input_arg_counts[formal_idx]; ++i, ++input_idx) {
+      if (IsFloatTensor(*input_defs[input_idx]) && !allows_type(formal_inputs[formal_idx])) {
+        return false;
+      }
+    }
+  }
+
+  // the last formal output may be variadic, e.g. the outputs of Split
+  const auto& formal_outputs = schema->outputs();
+  const auto& output_defs = node.OutputDefs();
+  for (size_t output_idx = 0; output_idx < output_defs.size() && !formal_outputs.empty(); ++output_idx) {
+    const auto& formal_output = formal_outputs[std::min(output_idx, formal_outputs.size() - 1)];
+    if (IsFloatTensor(*output_defs[output_idx]) && !allows_type(formal_output)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Nodes in a QDQ group stay in float, their precision is given by the quantization.
+bool IsInQDQGroup(const Node& node) {
+  for (auto it = node.InputNodesBegin(); it != node.InputNodesEnd(); ++it) {
+    if (it->OpType() == "DequantizeLinear") {
+      return true;
+    }
+  }
+
+  for (auto it = node.OutputNodesBegin(); it != node.OutputNodesEnd(); ++it) {
+    if (it->OpType() == "QuantizeLinear") {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+NodeArg& CreateNodeArgOfType(Graph& graph, const NodeArg& node_arg, TensorProto_DataType elem_type) {
+  TypeProto type = *node_arg.TypeAsProto();
+  type.mutable_tensor_type()->set_elem_type(elem_type);
+  return graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(node_arg.Name() + "_amp"), &type);
+}
+
+Node& AddCastNode(Graph& graph, NodeArg& input, NodeArg& output, TensorProto_DataType to, const Node& node) {
+  Node& cast_node = graph.AddNode(graph.GenerateNodeName("AutoMixedPrecisionCast"), "Cast",
+                                  "Cast inserted by AutoMixedPrecision", {&input}, {&output});
+  cast_node.AddAttribute("to", static_cast<int64_t>(to));
+  cast_node.SetExecutionProviderType(node.GetExecutionProviderType());
+  return cast_node;
+}
+
+}  // namespace
+
+AutoMixedPrecision::AutoMixedPrecision(TensorProto_DataType target_type,
+                                       const InlinedHashSet<std::string>& allow_ops,
+                                       const InlinedHashSet<std::string>& deny_ops,
+                                       const InlinedHashSet<std::string_view>& compatible_execution_providers) noexcept
+    : GraphTransformer("AutoMixedPrecision", compatible_execution_providers),
+      target_type_(target_type),
+      allow_ops_(allow_ops),
+      deny_ops_(deny_ops) {
+}
+
+bool AutoMixedPrecision::IsAllowOp(const Node& node) const {
+  // Ops that do most of the compute of a model. Accumulation happens in float in their kernels.
+  static const InlinedHashSet<std::string_view> default_allow_ops = {"Conv", "ConvTranspose", "Gemm", "MatMul"};
+
+  return allow_ops_.count(node.OpType()) > 0 ||
+         (node.Domain() == kOnnxDomain && default_allow_ops.count(node.OpType()) > 0);
+}
+
+bool AutoMixedPrecision::IsInferOp(const Node& node) const {
+  // Ops that are safe in lower precision, but are only converted next to other converted nodes as converting them
+  // on their own would just add Cast nodes.
+  static const InlinedHashSet<std::string_view> default_infer_ops = {
+      "Add", "Clip", "Concat", "Div", "Expand", "Flatten", "Gather", "Gelu", "Identity", "LeakyRelu", "MaxPool",
+      "Mul", "Pad", "Relu", "Reshape", "Sigmoid", "Slice", "Split", "Squeeze", "Sub", "Tanh", "Transpose",
+      "Unsqueeze", "Where"};
+
+  return node.Domain() == kOnnxDomain && default_infer_ops.count(node.OpType()) > 0;
+}
+
+Status AutoMixedPrecision::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                     const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  const std::string target_type_str = target_type_ == TensorProto_DataType_FLOAT16 ? "tensor(float16)"
+                                                                                   : "tensor(bfloat16)";
+
+  // Select the nodes to convert. Nodes are visited in topological order so the producers of the inputs of a node
+  // have already been selected when the node is visited.
+  InlinedVector<NodeIndex> nodes_to_convert;
+  InlinedHashSet<NodeIndex> nodes_to_convert_set;
+  InlinedHashSet<const NodeArg*> converted_outputs;
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (node_ptr == nullptr) {
+      continue;  // node was removed
+    }
+
+    auto& node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (node.ContainsSubgraph() ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        deny_ops_.count(node.OpType()) > 0) {
+      continue;
+    }
+
+    const auto& input_defs = node.InputDefs();
+    if (std::none_of(input_defs.begin(), input_defs.end(),
+                     [](const NodeArg* input_def) { return IsFloatTensor(*input_def); })) {
+      continue;
+    }
+
+    const bool has_converted_input =
+        std::any_of(input_defs.begin(), input_defs.end(),
+                    [&converted_outputs](const NodeArg* input_def) { return converted_outputs.count(input_def) > 0; });
+    if (!IsAllowOp(node) && !(has_converted_input && IsInferOp(node))) {
+      continue;
+    }
+
+    if (IsInQDQGroup(node) || !SupportsType(node, target_type_str)) {
+      continue;
+    }
+
+    nodes_to_convert.push_back(node_index);
+    nodes_to_convert_set.insert(node_index);
+    for (const auto* output_def : node.OutputDefs()) {
+      if (IsFloatTensor(*output_def)) {
+        converted_outputs.insert(output_def);
+      }
+    }
+  }
+
+  // float graph inputs, initializers and outputs of nodes that stay in float, mapped to their converted value and
+  // the Cast node producing it, if any.
+  InlinedHashMap<std::string, std::pair<NodeArg*, Node*>> converted_inputs;
+
+  for (auto node_index : nodes_to_convert) {
+    Node& node = *graph.GetNode(node_index);
+
+    // Outputs of converted producers were already replaced when the producer was converted, so the float inputs
+    // that are left come from the float parts of the graph.
+    auto& input_defs = node.MutableInputDefs();
+    for (size_t i = 0; i < input_defs.size(); ++i) {
+      NodeArg& input = *input_defs[i];
+      if (!IsFloatTensor(input)) {
+        continue;
+      }
+
+      const int input_idx = static_cast<int>(i);
+      Node* producer = graph.GetMutableProducerNode(input.Name());
+      if (producer != nullptr) {
+        graph.RemoveEdge(producer->Index(), node.Index(), optimizer_utils::IndexOfNodeOutput(*producer, input),
+                         input_idx);
+      }
+
+      auto it = converted_inputs.find(input.Name());
+      if (it == converted_inputs.end()) {
+        NodeArg* converted_input = nullptr;
+        Node* cast_node = nullptr;
+        if (graph_utils::IsConstantInitializer(graph, input.Name(), false)) {
+          Initializer initializer{*graph.GetConstantInitializer(input.Name(), false), graph.ModelPath()};
+          const std::string name = graph.GenerateNodeArgName(input.Name() + "_amp");
+          converted_input = &graph_utils::AddInitializer(
+              graph, target_type_ == TensorProto_DataType_FLOAT16 ? initializer.ToFP16(name)
+                                                                  : initializer.ToBFloat16(name));
+        } else {
+          converted_input = &CreateNodeArgOfType(graph, input, target_type_);
+          cast_node = &AddCastNode(graph, input, *converted_input, target_type_, node);
+          if (producer != nullptr) {
+            graph.AddEdge(producer->Index(), cast_node->Index(),
+                          optimizer_utils::IndexOfNodeOutput(*producer, input), 0);
+          }
+        }
+
+        it = converted_inputs.emplace(input.Name(), std::make_pair(converted_input, cast_node)).first;
+      }
+
+      graph_utils::ReplaceNodeInput(node, input_idx, *it->second.first);
+      if (it->second.second != nullptr) {
+        graph.AddEdge(it->second.second->Index(), node.Index(), 0, input_idx);
+      }
+    }
+
+    // Converted consumers take the converted output directly. The float output is kept for the other consumers
+    // and graph outputs and is produced by a Cast from the converted output.
+    auto& output_defs = node.MutableOutputDefs();
+    for (size_t k = 0; k < output_defs.size(); ++k) {
+      NodeArg& output = *output_defs[k];
+      if (!IsFloatTensor(output)) {
+        continue;
+      }
+
+      const int output_idx = static_cast<int>(k);
+      NodeArg& converted_output = CreateNodeArgOfType(graph, output, target_type_);
+      output_defs[k] = &converted_output;
+      graph.UpdateProducerNode(converted_output.Name(), node.Index());
+
+      InlinedVector<std::pair<NodeIndex, int>> float_consumers;
+      for (auto edge = node.OutputEdgesBegin(); edge != node.OutputEdgesEnd(); ++edge) {
+        if (edge->GetSrcArgIndex() != output_idx) {
+          continue;
+        }
+
+        Node& consumer = *graph.GetNode(edge->GetNode().Index());
+        if (nodes_to_convert_set.count(consumer.Index()) > 0) {
+          graph_utils::ReplaceNodeInput(consumer, edge->GetDstArgIndex(), converted_output);
+        } else {
+          float_consumers.emplace_back(consumer.Index(), edge->GetDstArgIndex());
+        }
+      }
+
+      if (float_consumers.empty() && !graph.IsOutput(&output)) {
+        continue;
+      }
+
+      for (const auto& float_consumer : float_consumers) {
+        graph.RemoveEdge(node.Index(), float_consumer.first, output_idx, float_consumer.second);
+      }
+
+      Node& cast_node = AddCastNode(graph, converted_output, output, TensorProto_DataType_FLOAT, node);
+      graph.UpdateProducerNode(output.Name(), cast_node.Index());
+      graph.AddEdge(node.Index(), cast_node.Index(), output_idx, 0);
+      for (const auto& float_consumer : float_consumers) {
+        graph.AddEdge(cast_node.Index(), float_consumer.first, 0, float_consumer.second);
+      }
+    }
+
+    modified = true;
+  }
+
+  if (!nodes_to_convert.empty()) {
+    LOGS(logger, INFO) << "AutoMixedPrecision converted " << nodes_to_convert.size() << " nodes to "
+                       << target_type_str;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/graph/onnx_protobuf.h"
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class AutoMixedPrecision
+
+Converts the float parts of a graph that benefit from lower precision to float16 or bfloat16.
+
+- Compute bound ops (Conv, ConvTranspose, Gemm, MatMul and any op in `allow_ops`) are always converted.
+- Elementwise and data movement ops (Add, Relu, Transpose, Reshape, ...) follow their inputs: they are converted
+  if at least one of their float inputs is produced by a converted node.
+- All other ops, in particular reductions, normalizations, Softmax and exponentials, and any op in `deny_ops`,
+  stay in float.
+
+A node is only converted if its schema allows the target type for all of its float inputs and outputs.
+Cast nodes are inserted on the boundaries of the converted regions and constant initializers consumed by converted
+nodes are converted in place. Graph inputs and outputs keep their float type.
+*/
+class AutoMixedPrecision : public GraphTransformer {
+ public:
+  AutoMixedPrecision(ONNX_NAMESPACE::TensorProto_DataType target_type,
+                     const InlinedHashSet<std::string>& allow_ops = {},
+                     const InlinedHashSet<std::string>& deny_ops = {},
+                     const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept;
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  bool IsAllowOp(const Node& node) const;
+  bool IsInferOp(const Node& node) const;
+
+  ONNX_NAMESPACE::TensorProto_DataType target_type_;
+  InlinedHashSet<std::string> allow_ops_;
+  InlinedHashSet<std::string> deny_ops_;
+};
+
+}  // namespace onnxruntime
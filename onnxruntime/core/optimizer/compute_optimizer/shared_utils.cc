@@ -1,8 +1,6 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#ifdef ENABLE_TRAINING
-
 #include <onnx/defs/attr_proto_util.h>
 #include "core/framework/random_seed.h"
 #include "core/graph/graph_utils.h"
@@ -255,5 +253,3 @@ NodeArg* InsertNodesForValidIndices(Graph& graph,
 }
 
 }  // namespace onnxruntime::optimizer::compute_optimizer
-
-#endif
@@ -1,9 +1,6 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-// The optimization here ideally is applicable to both training and inferencing,
-// while so far we mainly validate on training during cooking the optimization.
-#ifdef ENABLE_TRAINING
 #pragma once
 
 #include <initializer_list>
@@ -33,6 +30,10 @@ const OPSET_VERSION_LIST opset_13_1{13, 1};
 const OPSET_VERSION_LIST opset_13_9_1{13, 9, 1};
 const OPSET_VERSION_LIST opset_13_11_1{13, 11, 1};
 const OPSET_VERSION_LIST opset_13_9_6_1{13, 9, 6, 1};
+const OPSET_VERSION_LIST opset_13_6_1{13, 6, 1};
+const OPSET_VERSION_LIST opset_13_9{13, 9};
+const OPSET_VERSION_LIST opset_14_13_6_1{14, 13, 6, 1};
+const OPSET_VERSION_LIST opset_17_1{17, 1};
 const OPSET_VERSION_LIST opset_14_13_5_1{14, 13, 5, 1};
 const OPSET_VERSION_LIST opset_14_13_7_6_1{14, 13, 7, 6, 1};
 const OPSET_VERSION_LIST opset_13_12_10_7_6_1{13, 12, 10, 7, 6, 1};
@@ -202,4 +203,3 @@ NodeArg* InsertNodesForValidIndices(Graph& graph,
                                     const std::string& execution_provider_type);
 
 }  // namespace onnxruntime::optimizer::compute_optimizer
-#endif
@@ -1,8 +1,6 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#ifdef ENABLE_TRAINING
-
 #include <onnx/defs/attr_proto_util.h>
 #include "core/common/string_utils.h"
 #include "core/graph/graph_utils.h"
@@ -42,22 +40,53 @@ UpStreamGatherGraphTransformer::UpStreamGatherGraphTransformer(
       {utils::GetFullQualifiedOpName("Dropout", kOnnxDomain),
        OpPassThroughConfig<UpStreamGatherOperatorActorBase>(std::make_shared<SimplePointwiseGatherActor<true>>(),
                                                             opset_13_12_10_7_6_1)},
+      {utils::GetFullQualifiedOpName("Erf", kOnnxDomain),
+       OpPassThroughConfig<UpStreamGatherOperatorActorBase>(std::make_shared<SimplePointwiseGatherActor<true>>(),
+                                                            opset_13_9)},
+      {utils::GetFullQualifiedOpName("FastGelu", kMSDomain),
+       OpPassThroughConfig<UpStreamGatherOperatorActorBase>(std::make_shared<SimplePointwiseGatherActor<true>>(),
+                                                            opset_1)},
       {utils::GetFullQualifiedOpName("Gelu", kMSDomain),
        OpPassThroughConfig<UpStreamGatherOperatorActorBase>(std::make_shared<SimplePointwiseGatherActor<true>>(),
                                                             opset_1)},
-      {// Be noted, this is our own implementation of ONNX domain op.
+      {// Be noted, version 1 is our own implementation of ONNX domain op, version 17 is the standard one.
        utils::GetFullQualifiedOpName("LayerNormalization", kOnnxDomain),
        OpPassThroughConfig<UpStreamGatherOperatorActorBase>(std::make_shared<LayerNormalizationGatherActor>(),
-                                                            opset_1)},
+                                                            opset_17_1)},
       {utils::GetFullQualifiedOpName("MatMul", kOnnxDomain),
        OpPassThroughConfig<UpStreamGatherOperatorActorBase>(std::make_shared<MatMulGatherActor>(),
                                                             opset_13_9_1)},
+      {utils::GetFullQualifiedOpName("Mul", kOnnxDomain),
+       OpPassThroughConfig<UpStreamGatherOperatorActorBase>(std::make_shared<SimplePointwiseGatherActor<true>>(),
+                                                            opset_14_13_7_6_1)},
+      {utils::GetFullQualifiedOpName("QuickGelu", kMSDomain),
+       OpPassThroughConfig<UpStreamGatherOperatorActorBase>(std::make_shared<SimplePointwiseGatherActor<true>>(),
+                                                            opset_1)},
+      {utils::GetFullQualifiedOpName("Relu", kOnnxDomain),
+       OpPassThroughConfig<UpStreamGatherOperatorActorBase>(std::make_shared<SimplePointwiseGatherActor<true>>(),
+                                                            opset_14_13_6_1)},
       {utils::GetFullQualifiedOpName("Reshape", kOnnxDomain),
        OpPassThroughConfig<UpStreamGatherOperatorActorBase>(std::make_shared<ReshapeGatherActor>(),
                                                             opset_19_14_13_5_1)},
+      {utils::GetFullQualifiedOpName("Sigmoid", kOnnxDomain),
+       OpPassThroughConfig<UpStreamGatherOperatorActorBase>(std::make_shared<SimplePointwiseGatherActor<true>>(),
+                                                            opset_13_6_1)},
+      {// Same as LayerNormalization, but without the mean subtraction and the bias (RMSNorm).
+       utils::GetFullQualifiedOpName("SimplifiedLayerNormalization", kOnnxDomain),
+       OpPassThroughConfig<UpStreamGatherOperatorActorBase>(std::make_shared<LayerNormalizationGatherActor>(),
+                                                            opset_1)},
       {utils::GetFullQualifiedOpName("Softmax", kOnnxDomain),
        OpPassThroughConfig<UpStreamGatherOperatorActorBase>(std::make_shared<SoftmaxGatherActor>(),
                                                             opset_13_11_1)},
+      {utils::GetFullQualifiedOpName("Sqrt", kOnnxDomain),
+       OpPassThroughConfig<UpStreamGatherOperatorActorBase>(std::make_shared<SimplePointwiseGatherActor<true>>(),
+                                                            opset_13_6_1)},
+      {utils::GetFullQualifiedOpName("Sub", kOnnxDomain),
+       OpPassThroughConfig<UpStreamGatherOperatorActorBase>(std::make_shared<SimplePointwiseGatherActor<true>>(),
+                                                            opset_14_13_7_6_1)},
+      {utils::GetFullQualifiedOpName("Tanh", kOnnxDomain),
+       OpPassThroughConfig<UpStreamGatherOperatorActorBase>(std::make_shared<SimplePointwiseGatherActor<true>>(),
+                                                            opset_13_6_1)},
       {utils::GetFullQualifiedOpName("Transpose", kOnnxDomain),
        OpPassThroughConfig<UpStreamGatherOperatorActorBase>(std::make_shared<TransposeGatherActor>(),
                                                             opset_13_1)},
@@ -336,7 +365,9 @@ std::optional<SliceInfo> IsSupportedGather(Graph& graph, Node& node,
     return std::nullopt;
   }
 
-  auto axis = static_cast<int>(node.GetAttributes().at("axis").i());
+  // axis is optional and defaults to 0.
+  const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+  int axis = axis_attr != nullptr ? static_cast<int>(axis_attr->i()) : 0;
   axis = axis < 0 ? axis + data_rank : axis;
   size_t dim_size = static_cast<size_t>(indices_shape->dim_size());
   bool is_single_value_1d_tensor = dim_size == 1 && utils::HasDimValue(indices_shape->dim(0)) &&
@@ -476,5 +507,3 @@ std::optional<SliceInfo> UpStreamGatherGraphTransformer::IsSupportedForUpstream(
 }
 
 }  // namespace onnxruntime
-
-#endif
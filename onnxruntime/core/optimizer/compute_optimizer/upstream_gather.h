@@ -1,9 +1,6 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-// The optimization here ideally applies to both training and inferencing,
-// while so far we mainly validate training during cooking the optimization.
-#ifdef ENABLE_TRAINING
 #pragma once
 
 #include "core/optimizer/compute_optimizer/upstream_transformer_base.h"
@@ -125,4 +122,3 @@ class UpStreamGatherGraphTransformer
 };
 
 }  // namespace onnxruntime
-#endif
@@ -1,8 +1,6 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#ifdef ENABLE_TRAINING
-
 #include <onnx/defs/attr_proto_util.h>
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/initializer.h"
@@ -16,6 +14,19 @@ namespace onnxruntime::optimizer::compute_optimizer {
 // Put some utils in anonymous namespace
 namespace {
 
+/**
+ * @brief Get the value of the "axis" attribute of the given node, which is optional in exported inference models.
+ */
+int64_t GetAxisOrDefault(const Node& node, int64_t default_axis) {
+  const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+  return axis_attr != nullptr ? axis_attr->i() : default_axis;
+}
+
+// Softmax normalizes over the last axis by default since opset 13, and over the flattened axes from 1 before.
+int64_t GetSoftmaxAxis(const Node& node) {
+  return GetAxisOrDefault(node, node.SinceVersion() >= 13 ? -1 : 1);
+}
+
 /**
  * @brief From given TensorShape, update specified dimension with given value.
  * If no new_dim is provided, the dimension will be removed.
@@ -425,7 +436,7 @@ bool LayerNormalizationGatherActor::PreCheck(const Graph& /* graph */,
                                              std::unordered_map<int, int>& propagate_input_indices,
                                              std::unordered_map<int, std::vector<DimCompare>>& all_input_cmp_rets,
                                              std::function<void(Node& node)>& shape_update_func) {
-  auto axis = static_cast<int64_t>(current_node.GetAttributes().at("axis").i());
+  auto axis = GetAxisOrDefault(current_node, -1);
   axis = axis < 0 ? axis + current_node.InputDefs()[0]->Shape()->dim_size() : axis;
 
   // Make sure LayerNormalization's reduction happens after the axis we want to slice.
@@ -471,7 +482,7 @@ bool LayerNormalizationGatherActor::PostProcess(Graph& /*graph*/, Node& current_
                                                 const std::unordered_map<int, SliceInfo>& /*new_gather_infos*/) {
   // Update LayerNormalization's axis attribute if it is scalar slice.
   if (info_without_node.is_scalar_slice) {
-    auto axis = static_cast<int64_t>(current_node.GetAttributes().at("axis").i());
+    auto axis = GetAxisOrDefault(current_node, -1);
     auto original_ln_input_rank = info_without_node.input_rank;
     axis = axis < 0 ? axis + original_ln_input_rank : axis;
     auto new_axis = axis - 1;
@@ -488,7 +499,7 @@ bool SoftmaxGatherActor::PreCheck(const Graph& graph, const Node& current_node,
                                   std::unordered_map<int, int>& propagate_input_indices,
                                   std::unordered_map<int, std::vector<DimCompare>>& all_input_cmp_rets,
                                   std::function<void(Node& node)>& shape_update_func) {
-  auto axis = static_cast<int64_t>(current_node.GetAttributes().at("axis").i());
+  auto axis = GetSoftmaxAxis(current_node);
   axis = axis < 0 ? axis + current_node.InputDefs()[0]->Shape()->dim_size() : axis;
 
   // Make sure Softmax's reduction happens after the axis we want to slice.
@@ -510,7 +521,7 @@ bool SoftmaxGatherActor::PostProcess(Graph& graph, Node& current_node, const Sli
 
   // Update Softmax's axis attribute if it is scalar slice.
   if (info_without_node.is_scalar_slice) {
-    auto axis = static_cast<int64_t>(current_node.GetAttributes().at("axis").i());
+    auto axis = GetSoftmaxAxis(current_node);
     auto original_ln_input_rank = info_without_node.input_rank;
     axis = axis < 0 ? axis + original_ln_input_rank : axis;
     auto new_axis = axis - 1;
@@ -772,5 +783,3 @@ template class SimplePointwiseGatherActor<true>;
 template class SimplePointwiseGatherActor<false>;
 
 }  // namespace onnxruntime::optimizer::compute_optimizer
-
-#endif
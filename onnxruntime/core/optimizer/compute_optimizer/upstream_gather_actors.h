@@ -1,9 +1,6 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-// The optimization here ideally applies to both training and inferencing,
-// while so far we mainly validate training during cooking the optimization.
-#ifdef ENABLE_TRAINING
 #pragma once
 
 #include "core/optimizer/compute_optimizer/shared_utils.h"
@@ -302,5 +299,3 @@ void AdaptInputAndOutputForScalarSlice(Graph& graph, Node& current_node, int cur
                                        const logging::Logger& logger);
 
 }  // namespace onnxruntime::optimizer::compute_optimizer
-
-#endif
@@ -1,8 +1,6 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#ifdef ENABLE_TRAINING
-
 #include "core/framework/tensorprotoutils.h"
 #include "core/common/string_utils.h"
 #include "core/graph/graph_utils.h"
@@ -274,5 +272,3 @@ std::optional<ReshapeInfo> UpStreamReshapeGraphTransformer::IsSupportedForUpstre
 }
 
 }  // namespace onnxruntime
-
-#endif
@@ -1,8 +1,6 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#ifdef ENABLE_TRAINING
-
 #include <onnx/defs/attr_proto_util.h>
 #include "core/optimizer/utils.h"
 #include "core/optimizer/compute_optimizer/upstream_reshape_actors.h"
@@ -304,5 +302,3 @@ template class SimplePointwiseReshapeActor<true>;
 template class SimplePointwiseReshapeActor<false>;
 
 }  // namespace onnxruntime::optimizer::compute_optimizer
-
-#endif
@@ -1,9 +1,6 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-// The optimization here ideally applies to both training and inference,
-// while so far we mainly validate training during cooking the optimization.
-#ifdef ENABLE_TRAINING
 #pragma once
 
 #include "core/optimizer/compute_optimizer/shared_utils.h"
@@ -192,5 +189,3 @@ ONNX_NAMESPACE::TensorShapeProto CreateNewShapeWithMergedTwoLeadingDims(
     const ONNX_NAMESPACE::TensorShapeProto_Dimension& new_dim);
 
 }  // namespace onnxruntime::optimizer::compute_optimizer
-
-#endif
@@ -1,8 +1,6 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#ifdef ENABLE_TRAINING
-
 #include <onnx/defs/attr_proto_util.h>
 #include "core/common/safeint.h"
 #include "core/common/string_utils.h"
@@ -103,6 +101,14 @@ Status UpStreamGraphTransformerBase<T1, T2>::ApplyImpl(Graph& graph, bool& modif
         continue;
       }
 
+      // The full output is still needed if it is a graph output, e.g. the hidden states of the last layer
+      // that an inference model returns besides the logits.
+      if (graph.NodeProducesGraphOutput(*input_tensor_producer_node)) {
+        LOG_DEBUG_INFO(logger, log_prefix + " stops at node " + input_tensor_producer_node->Name() +
+                                   " since it produces a graph output");
+        continue;
+      }
+
       auto ret = Upstream(graph, queue, *input_tensor_producer_node, info, logger);
       if (ret) {
         LOG_DEBUG_INFO(logger, log_prefix + " moves up across node " + input_tensor_producer_node->Name());
@@ -160,5 +166,3 @@ template class UpStreamGraphTransformerBase<SliceInfo, UpStreamGatherOperatorAct
 template class UpStreamGraphTransformerBase<ReshapeInfo, UpStreamReshapeOperatorActorBase>;
 
 }  // namespace onnxruntime::optimizer::compute_optimizer
-
-#endif
@@ -1,9 +1,6 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-// The optimization here ideally applies to both training and inferencing,
-// while so far we mainly validate training during cooking the optimization.
-#ifdef ENABLE_TRAINING
 #pragma once
 
 #include "core/optimizer/graph_transformer.h"
@@ -82,4 +79,3 @@ class UpStreamGraphTransformerBase : public GraphTransformer {
 };
 
 }  // namespace onnxruntime::optimizer::compute_optimizer
-#endif
@@ -0,0 +1,142 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/depthwise_pointwise_conv_fusion.h"
+
+#include <algorithm>
+#include <array>
+
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+// FusedConv is accepted to pick up the activations fused by ConvActivationFusion. Its optional Z input is added
+// before the activation, which the fused kernel does not support.
+bool IsConvOrFusedConv(const Node& node) {
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Conv", {1, 11})) {
+    return true;
+  }
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "FusedConv", {1}, kMSDomain)) {
+    const auto& input_defs = node.InputDefs();
+    return input_defs.size() < 4 || !input_defs[3]->Exists();
+  }
+
+  return false;
+}
+
+const TensorProto* GetConstantFilter(const Graph& graph, const Node& node) {
+  const auto& input_defs = node.InputDefs();
+  const auto* filter = graph_utils::GetConstantInitializer(graph, input_defs[1]->Name());
+  if (filter == nullptr || filter->dims_size() != 4 || filter->data_type() != TensorProto_DataType_FLOAT) {
+    return nullptr;
+  }
+  return filter;
+}
+
+// The bias inputs are not connected by edges in the fused graph, so the bias of the pointwise Conv must be an
+// initializer.
+bool HasConstantOrNoBias(const Graph& graph, const Node& node) {
+  const auto& input_defs = node.InputDefs();
+  return input_defs.size() < 3 || !input_defs[2]->Exists() ||
+         graph_utils::IsInitializer(graph, input_defs[2]->Name(), true);
+}
+
+int64_t GetGroup(const Node& node) {
+  const auto* attr = graph_utils::GetNodeAttribute(node, "group");
+  return (attr != nullptr && attr->has_i()) ? attr->i() : 1;
+}
+
+bool AllIntsEqual(const Node& node, const std::string& attr_name, int64_t value) {
+  const auto* attr = graph_utils::GetNodeAttribute(node, attr_name);
+  return attr == nullptr ||
+         std::all_of(attr->ints().begin(), attr->ints().end(), [value](int64_t v) { return v == value; });
+}
+}  // namespace
+
+Status DepthwisePointwiseConvFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                               const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto index : order) {
+    auto* node_ptr = graph.GetNode(index);
+    if (!node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!IsConvOrFusedConv(node) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        node.GetOutputEdgesCount() != 1 || graph.NodeProducesGraphOutput(node)) {
+      continue;
+    }
+
+    // Check for a 2D depthwise convolution with a channel multiplier of one.
+    const auto* dw_filter = GetConstantFilter(graph, node);
+    if (dw_filter == nullptr) {
+      continue;
+    }
+
+    const int64_t channels = dw_filter->dims(0);
+    if (channels <= 1 || dw_filter->dims(1) != 1 || GetGroup(node) != channels) {
+      continue;
+    }
+
+    // Check for a pointwise convolution of the depthwise output.
+    const Node& next_node = *(node.OutputNodesBegin());
+    if (!IsConvOrFusedConv(next_node) || next_node.GetExecutionProviderType() != node.GetExecutionProviderType() ||
+        next_node.InputDefs()[0] != node.OutputDefs()[0]) {
+      continue;
+    }
+
+    const auto* pw_filter = GetConstantFilter(graph, next_node);
+    if (pw_filter == nullptr || pw_filter->dims(1) != channels || pw_filter->dims(2) != 1 ||
+        pw_filter->dims(3) != 1 || GetGroup(next_node) != 1 || !AllIntsEqual(next_node, "strides", 1) ||
+        !AllIntsEqual(next_node, "pads", 0) || !HasConstantOrNoBias(graph, next_node)) {
+      continue;
+    }
+
+    Node& dw_node = node;
+    Node& pw_node = *graph.GetNode(next_node.Index());  // get mutable reference
+
+    NodeArg& empty = graph.GetOrCreateNodeArg("", nullptr);
+    const auto get_bias = [&empty](Node& conv_node) {
+      auto& input_defs = conv_node.MutableInputDefs();
+      return input_defs.size() > 2 ? input_defs[2] : &empty;
+    };
+
+    const std::array<NodeArg*, 5> fused_inputs{dw_node.MutableInputDefs()[0], dw_node.MutableInputDefs()[1],
+                                               get_bias(dw_node), pw_node.MutableInputDefs()[1],
+                                               get_bias(pw_node)};
+
+    // The depthwise convolution attributes, including any fused activation, carry over as is.
+    Node& fused_conv = graph.AddNode(graph.GenerateNodeName("fused " + dw_node.Name()), "FusedDepthwisePointwiseConv",
+                                     "fused depthwise Conv " + dw_node.Name() + " with pointwise Conv " +
+                                         pw_node.Name(),
+                                     fused_inputs, {}, &dw_node.GetAttributes(), kMSDomain);
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    fused_conv.SetExecutionProviderType(dw_node.GetExecutionProviderType());
+
+    for (const auto& attr : pw_node.GetAttributes()) {
+      if (attr.first == "activation" || attr.first == "activation_params") {
+        AttributeProto fused_conv_attr(attr.second);
+        fused_conv_attr.set_name("pointwise_" + attr.first);
+        fused_conv.AddAttributeProto(std::move(fused_conv_attr));
+      }
+    }
+
+    // move output definitions and edges from pw_node to fused_conv. delete dw_node and pw_node.
+    graph_utils::FinalizeNodeFusion(graph, {dw_node, pw_node}, fused_conv);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
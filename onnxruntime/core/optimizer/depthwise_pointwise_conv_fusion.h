@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class DepthwisePointwiseConvFusion
+
+Fuses a 2D depthwise Conv (or FusedConv with an activation) and the pointwise 1x1 Conv that consumes its
+output into a FusedDepthwisePointwiseConv node. The fused kernel computes the depthwise output in cache
+sized tiles, so the intermediate activation is not written to memory.
+*/
+class DepthwisePointwiseConvFusion : public GraphTransformer {
+ public:
+  DepthwisePointwiseConvFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("DepthwisePointwiseConvFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,282 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_fusion.h"
+
+#include <algorithm>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+bool IsReduction(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceSum", {1, 11, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceMean", {1, 11, 13, 18}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceMax", {1, 11, 12, 13, 18});
+}
+
+// Operators that read a whole row of the last axis.
+bool IsRowOp(const Node& node) {
+  return IsReduction(node) || graph_utils::IsSupportedOptypeVersionAndDomain(node, "Softmax", {1, 11, 13});
+}
+
+bool IsSupportedOp(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Pow", {7, 12, 13, 15}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Abs", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Neg", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Exp", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sqrt", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Erf", {9, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Where", {9, 16}) ||
+         IsRowOp(node);
+}
+
+// The inputs the fused kernel reads. The axes input of a reduction is checked by IsLastAxisRowOp instead.
+size_t NumOperands(const Node& node) {
+  return IsReduction(node) ? 1 : node.InputDefs().size();
+}
+
+bool HasElemType(const NodeArg* arg, int32_t elem_type) {
+  const auto* type = arg->TypeAsProto();
+  return arg->Exists() && type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == elem_type;
+}
+
+// The fused kernel computes in float. Where takes a bool condition, which is also the only bool input it accepts.
+bool HasSupportedTypes(const Node& node) {
+  const auto& input_defs = node.InputDefs();
+  for (size_t i = 0; i < NumOperands(node); ++i) {
+    const bool is_condition = i == 0 && node.OpType() == "Where";
+    if (!HasElemType(input_defs[i], is_condition ? TensorProto_DataType_BOOL : TensorProto_DataType_FLOAT)) {
+      return false;
+    }
+  }
+  return node.OutputDefs().size() == 1 && HasElemType(node.OutputDefs()[0], TensorProto_DataType_FLOAT);
+}
+
+// Returns the static size of the last dimension of arg, or -1 if it is unknown. Scalars have a size of 1.
+int64_t GetLastDim(const NodeArg& arg) {
+  const auto* shape = arg.Shape();
+  if (shape == nullptr) {
+    return -1;
+  }
+  if (shape->dim_size() == 0) {
+    return 1;
+  }
+  const auto& dim = shape->dim(shape->dim_size() - 1);
+  return utils::HasDimValue(dim) ? dim.dim_value() : -1;
+}
+
+// The kernel only reduces or normalizes the last axis, keeping the reduced dimension, of an input whose last
+// dimension is known.
+bool IsLastAxisRowOp(const Graph& graph, const Node& node) {
+  const auto* shape = node.InputDefs()[0]->Shape();
+  if (shape == nullptr || shape->dim_size() == 0 || GetLastDim(*node.InputDefs()[0]) < 0) {
+    return false;
+  }
+  const int64_t rank = shape->dim_size();
+  const auto is_last_axis = [rank](int64_t axis) { return axis == -1 || axis == rank - 1; };
+
+  if (!IsReduction(node)) {
+    // Softmax before opset 13 coerces the input to 2D at axis, which is the same for the last axis
+    const auto* axis = graph_utils::GetNodeAttribute(node, "axis");
+    const int64_t default_axis = node.SinceVersion() < 13 ? 1 : -1;
+    return is_last_axis(axis != nullptr && axis->has_i() ? axis->i() : default_axis);
+  }
+
+  const auto* keepdims = graph_utils::GetNodeAttribute(node, "keepdims");
+  if (keepdims != nullptr && keepdims->has_i() && keepdims->i() == 0) {
+    return false;
+  }
+
+  std::vector<int64_t> axes;
+  if (const auto* axes_attr = graph_utils::GetNodeAttribute(node, "axes"); axes_attr != nullptr) {
+    axes.assign(axes_attr->ints().begin(), axes_attr->ints().end());
+  } else if (node.InputDefs().size() > 1 && node.InputDefs()[1]->Exists()) {
+    const auto* axes_const = graph_utils::GetConstantInitializer(graph, node.InputDefs()[1]->Name());
+    if (axes_const == nullptr) {
+      return false;
+    }
+    Initializer initializer{*axes_const, graph.ModelPath()};
+    const auto axes_span = initializer.DataAsSpan<int64_t>();
+    axes.assign(axes_span.begin(), axes_span.end());
+  }
+  return axes.size() == 1 && is_last_axis(axes[0]);
+}
+
+bool IsFusible(const Graph& graph, const Node& node, const InlinedHashSet<std::string_view>& compatible_providers) {
+  return IsSupportedOp(node) && HasSupportedTypes(node) &&
+         graph_utils::IsSupportedProvider(node, compatible_providers) &&
+         (!IsRowOp(node) || IsLastAxisRowOp(graph, node));
+}
+
+// Chains with row operators are evaluated one row at a time, which requires every input to be either a full row
+// or a single value per row.
+bool HasRowCompatibleInputs(gsl::span<Node* const> nodes, gsl::span<NodeArg* const> inputs) {
+  int64_t row_size = -1;
+  for (const Node* node : nodes) {
+    if (IsRowOp(*node)) {
+      const int64_t last_dim = GetLastDim(*node->InputDefs()[0]);
+      if (row_size >= 0 && last_dim != row_size) {
+        return false;
+      }
+      row_size = last_dim;
+    }
+  }
+
+  if (row_size < 0) {
+    return true;
+  }
+
+  return std::all_of(inputs.begin(), inputs.end(), [row_size](const NodeArg* input) {
+    const int64_t last_dim = GetLastDim(*input);
+    return last_dim == 1 || last_dim == row_size;
+  });
+}
+}  // namespace
+
+Status ElementwiseFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                    const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  InlinedHashMap<NodeIndex, size_t> topological_position;
+  for (size_t i = 0; i < order.size(); ++i) {
+    topological_position[order[i]] = i;
+    auto* node = graph.GetNode(order[i]);
+    if (node != nullptr) {
+      ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+    }
+  }
+
+  // Collect the chains from their last node, so each chain is as long as possible. A producer joins a chain if
+  // all of its consumers are in the chain and it does not produce a graph output. The chain then has a single
+  // output and no path leaves it and comes back.
+  InlinedHashSet<NodeIndex> chained;
+  std::vector<InlinedVector<Node*>> chains;
+  for (auto it = order.rbegin(); it != order.rend(); ++it) {
+    auto* node_ptr = graph.GetNode(*it);
+    if (!node_ptr || chained.count(*it) != 0 || !IsFusible(graph, *node_ptr, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    InlinedVector<Node*> nodes{node_ptr};
+    InlinedHashSet<NodeIndex> in_chain{node_ptr->Index()};
+    const auto consumed_in_chain = [&in_chain](const Node& producer) {
+      return std::all_of(producer.OutputNodesBegin(), producer.OutputNodesEnd(),
+                         [&in_chain](const Node& consumer) { return in_chain.count(consumer.Index()) != 0; });
+    };
+
+    // a producer shared by several nodes of the chain can only join once all of them have
+    for (bool grown = true; grown;) {
+      grown = false;
+      for (size_t i = 0; i < nodes.size(); ++i) {
+        for (auto input_it = nodes[i]->InputNodesBegin(); input_it != nodes[i]->InputNodesEnd(); ++input_it) {
+          const Node& producer = *input_it;
+          if (in_chain.count(producer.Index()) == 0 && chained.count(producer.Index()) == 0 &&
+              !graph.NodeProducesGraphOutput(producer) &&
+              producer.GetExecutionProviderType() == node_ptr->GetExecutionProviderType() &&
+              IsFusible(graph, producer, GetCompatibleExecutionProviders()) && consumed_in_chain(producer)) {
+            nodes.push_back(graph.GetNode(producer.Index()));
+            in_chain.insert(producer.Index());
+            grown = true;
+          }
+        }
+      }
+    }
+
+    if (nodes.size() >= 2) {
+      chained.insert(in_chain.begin(), in_chain.end());
+      chains.push_back(std::move(nodes));
+    }
+  }
+
+  for (auto& nodes : chains) {
+    std::sort(nodes.begin(), nodes.end(), [&topological_position](const Node* a, const Node* b) {
+      return topological_position[a->Index()] < topological_position[b->Index()];
+    });
+    Node& last_node = *nodes.back();
+
+    // The inputs of the fused node are the inputs of the chain not produced within it. They are followed by
+    // one register per node, holding its output.
+    InlinedHashMap<const NodeArg*, int64_t> registers;
+    for (const Node* chain_node : nodes) {
+      registers[chain_node->OutputDefs()[0]] = -1;
+    }
+
+    InlinedVector<NodeArg*> fused_inputs;
+    for (Node* chain_node : nodes) {
+      for (size_t i = 0; i < NumOperands(*chain_node); ++i) {
+        NodeArg* input_def = chain_node->MutableInputDefs()[i];
+        if (registers.emplace(input_def, static_cast<int64_t>(fused_inputs.size())).second) {
+          fused_inputs.push_back(input_def);
+        }
+      }
+    }
+
+    if (!HasRowCompatibleInputs(nodes, fused_inputs)) {
+      continue;
+    }
+
+    std::vector<std::string> ops;
+    std::vector<int64_t> operands;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      ops.push_back(nodes[i]->OpType());
+      for (size_t j = 0; j < NumOperands(*nodes[i]); ++j) {
+        operands.push_back(registers[nodes[i]->InputDefs()[j]]);
+      }
+      registers[nodes[i]->OutputDefs()[0]] = static_cast<int64_t>(fused_inputs.size() + i);
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("fused " + last_node.Name()), "FusedElementwise",
+                                     "fused elementwise chain ending in " + last_node.Name(), fused_inputs, {},
+                                     nullptr, kMSDomain);
+    fused_node.AddAttribute("ops", ops);
+    fused_node.AddAttribute("operands", operands);
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    fused_node.SetExecutionProviderType(last_node.GetExecutionProviderType());
+
+    // Connect the inputs produced by other nodes. The input edges of the chain are removed with its nodes,
+    // except those of the first node, which FinalizeNodeFusion would otherwise move with their old indices.
+    for (size_t i = 0; i < fused_inputs.size(); ++i) {
+      const Node* producer = graph.GetProducerNode(fused_inputs[i]->Name());
+      if (producer != nullptr) {
+        graph.AddEdge(producer->Index(), fused_node.Index(),
+                      graph_utils::GetNodeOutputIndexFromOutputName(*producer, fused_inputs[i]->Name()),
+                      static_cast<int>(i));
+      }
+    }
+
+    Node& first_node = *nodes.front();
+    InlinedVector<Node::EdgeEnd> first_node_input_edges(first_node.InputEdgesBegin(), first_node.InputEdgesEnd());
+    for (const auto& edge : first_node_input_edges) {
+      graph.RemoveEdge(edge.GetNode().Index(), first_node.Index(), edge.GetSrcArgIndex(), edge.GetDstArgIndex());
+    }
+
+    InlinedVector<std::reference_wrapper<Node>> fused_nodes;
+    for (Node* chain_node : nodes) {
+      fused_nodes.push_back(*chain_node);
+    }
+
+    // move output definitions and edges from the last node to fused_node. delete all nodes of the chain.
+    graph_utils::FinalizeNodeFusion(graph, fused_nodes, fused_node);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ElementwiseFusion
+
+Fuses chains of float elementwise operators (Add, Sub, Mul, Div, Pow, Sqrt, Erf, Tanh, Where and a few unary
+activations) into a single FusedElementwise node. Every operator of a chain but the last must only be consumed
+within the chain, so its result is never materialized. The fused kernel evaluates the chain over cache sized
+tiles of the output in one pass over memory.
+
+Chains may also contain reductions of the last axis (ReduceSum, ReduceMean, ReduceMax) and Softmax, e.g. the
+variance in a layer normalization variant, a masked Softmax or a sum normalization. The kernel then evaluates
+the chain one row at a time, so each row is read from memory once.
+
+It runs after the pattern fusions, such as BiasGeluFusion and FastGeluFusion, which use specialized kernels.
+*/
+class ElementwiseFusion : public GraphTransformer {
+ public:
+  ElementwiseFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ElementwiseFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/embedding_bag_fusion.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+bool HasElemType(const NodeArg& arg, std::initializer_list<int32_t> elem_types) {
+  const auto* type = arg.TypeAsProto();
+  if (type == nullptr || !type->has_tensor_type()) {
+    return false;
+  }
+  const int32_t elem_type = type->tensor_type().elem_type();
+  return std::find(elem_types.begin(), elem_types.end(), elem_type) != elem_types.end();
+}
+
+int64_t GetIntAttr(const Node& node, const std::string& name, int64_t default_value) {
+  const auto* attr = graph_utils::GetNodeAttribute(node, name);
+  return (attr != nullptr && attr->has_i()) ? attr->i() : default_value;
+}
+
+// The reduction axes come from the attribute before opset 13 (18 for ReduceMean) and from a constant input after.
+bool GetReduceAxes(const Graph& graph, const Node& node, std::vector<int64_t>& axes) {
+  if (const auto* axes_attr = graph_utils::GetNodeAttribute(node, "axes"); axes_attr != nullptr) {
+    axes.assign(axes_attr->ints().begin(), axes_attr->ints().end());
+    return true;
+  }
+
+  if (node.InputDefs().size() > 1 && node.InputDefs()[1]->Exists()) {
+    const auto* axes_const = graph_utils::GetConstantInitializer(graph, node.InputDefs()[1]->Name());
+    if (axes_const == nullptr) {
+      return false;
+    }
+    Initializer initializer{*axes_const, graph.ModelPath()};
+    const auto axes_span = initializer.DataAsSpan<int64_t>();
+    axes.assign(axes_span.begin(), axes_span.end());
+  }
+  return true;
+}
+}  // namespace
+
+Status EmbeddingBagFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                     const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto index : order) {
+    auto* node_ptr = graph.GetNode(index);
+    if (!node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gather", {1, 11, 13}) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        node.GetOutputEdgesCount() != 1 || graph.NodeProducesGraphOutput(node)) {
+      continue;
+    }
+
+    const NodeArg& weight = *node.InputDefs()[0];
+    const NodeArg& indices = *node.InputDefs()[1];
+    const auto* weight_shape = weight.Shape();
+    const auto* indices_shape = indices.Shape();
+    if (GetIntAttr(node, "axis", 0) != 0 || weight_shape == nullptr || weight_shape->dim_size() != 2 ||
+        indices_shape == nullptr || indices_shape->dim_size() < 1 ||
+        !HasElemType(weight, {TensorProto_DataType_FLOAT, TensorProto_DataType_FLOAT16}) ||
+        !HasElemType(indices, {TensorProto_DataType_INT32, TensorProto_DataType_INT64})) {
+      continue;
+    }
+
+    const Node& next_node = *(node.OutputNodesBegin());
+    const bool is_sum = graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "ReduceSum", {1, 11, 13});
+    const bool is_mean = graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "ReduceMean", {1, 11, 13, 18});
+    if ((!is_sum && !is_mean) || next_node.GetExecutionProviderType() != node.GetExecutionProviderType() ||
+        next_node.InputDefs()[0] != node.OutputDefs()[0]) {
+      continue;
+    }
+
+    // The gathered tensor has shape indices.shape + [dim] and the bag axis is the last axis of the indices.
+    const int64_t bag_axis = indices_shape->dim_size() - 1;
+    const int64_t gathered_rank = bag_axis + 2;
+    std::vector<int64_t> axes;
+    if (!GetReduceAxes(graph, next_node, axes) || axes.size() != 1 ||
+        (axes[0] != bag_axis && axes[0] != bag_axis - gathered_rank)) {
+      continue;
+    }
+
+    Node& gather_node = node;
+    Node& reduce_node = *graph.GetNode(next_node.Index());  // get mutable reference
+
+    const std::array<NodeArg*, 2> fused_inputs{gather_node.MutableInputDefs()[0], gather_node.MutableInputDefs()[1]};
+    Node& embedding_bag = graph.AddNode(graph.GenerateNodeName("EmbeddingBag"), "EmbeddingBag",
+                                        "fused Gather " + gather_node.Name() + " with " + reduce_node.OpType() +
+                                            " " + reduce_node.Name(),
+                                        fused_inputs, {}, nullptr, kMSDomain);
+    embedding_bag.AddAttribute("mode", std::string(is_sum ? "sum" : "mean"));
+    embedding_bag.AddAttribute("keepdims", GetIntAttr(reduce_node, "keepdims", 1));
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    embedding_bag.SetExecutionProviderType(gather_node.GetExecutionProviderType());
+
+    // move output definitions and edges from reduce_node to embedding_bag. delete gather_node and reduce_node.
+    graph_utils::FinalizeNodeFusion(graph, {gather_node, reduce_node}, embedding_bag);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class EmbeddingBagFusion
+
+Fuses a Gather on axis 0 of a 2D embedding matrix followed by a ReduceSum or ReduceMean over the last axis of the
+indices into an EmbeddingBag node, which is how PyTorch EmbeddingBag modules with fixed size bags are exported.
+The fused kernel accumulates the rows of each bag into the output instead of materializing the gathered
+[..., bag_size, dim] tensor.
+*/
+class EmbeddingBagFusion : public GraphTransformer {
+ public:
+  EmbeddingBagFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("EmbeddingBagFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/optimizer/graph_transformer_mgr.h"
+
+#include <chrono>
+#include <optional>
+
 #include "core/optimizer/rule_based_graph_transformer.h"
 
 using namespace onnxruntime;
@@ -26,14 +30,42 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
     return Status::OK();
   }
 
+  struct TransformerStats {
+    // number of graph modifications by any transformer when this transformer last ran without modifying the graph
+    std::optional<size_t> unmodified_at;
+    unsigned runs = 0;
+    unsigned modifications = 0;
+    std::chrono::steady_clock::duration duration{};
+  };
+
+  InlinedVector<TransformerStats> stats(transformers->second.size());
+  size_t num_modifications = 0;
+
   for (unsigned step = 0; step < steps_; ++step) {
     bool graph_changed = false;
-    for (const auto& transformer : transformers->second) {
+    for (size_t i = 0; i < transformers->second.size(); ++i) {
+      const auto& transformer = transformers->second[i];
       if (step > 0 && transformer->ShouldOnlyApplyOnce())
         continue;
 
+      // A transformer that found nothing to do has nothing to do until another transformer modifies the graph.
+      auto& transformer_stats = stats[i];
+      if (transformer_stats.unmodified_at == num_modifications)
+        continue;
+
+      const auto start = std::chrono::steady_clock::now();
       bool modified = false;
       ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger));
+      transformer_stats.duration += std::chrono::steady_clock::now() - start;
+      ++transformer_stats.runs;
+
+      if (modified) {
+        ++transformer_stats.modifications;
+        ++num_modifications;
+        transformer_stats.unmodified_at.reset();
+      } else {
+        transformer_stats.unmodified_at = num_modifications;
+      }
       graph_changed = graph_changed || modified;
     }
     if (!graph_changed) {
@@ -41,6 +73,17 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
     }
   }
 
+  for (size_t i = 0; i < transformers->second.size(); ++i) {
+    const auto& transformer_stats = stats[i];
+    if (transformer_stats.runs > 0) {
+      LOGS(logger, VERBOSE) << "GraphTransformer " << transformers->second[i]->Name() << " ran "
+                            << transformer_stats.runs << " time(s) and modified the graph "
+                            << transformer_stats.modifications << " time(s) in "
+                            << std::chrono::duration_cast<std::chrono::microseconds>(transformer_stats.duration).count()
+                            << " us";
+    }
+  }
+
   return Status::OK();
 }
 
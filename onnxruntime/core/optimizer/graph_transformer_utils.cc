@@ -16,24 +16,31 @@
 
 #if !defined(ORT_MINIMAL_BUILD)
 
+#include "core/common/parse_string.h"
+#include "core/common/string_utils.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/optimizer/attention_fusion.h"
+#include "core/optimizer/auto_mixed_precision.h"
 #include "core/optimizer/bias_dropout_fusion.h"
 #include "core/optimizer/bias_gelu_fusion.h"
 #include "core/optimizer/bias_softmax_fusion.h"
 #include "core/optimizer/cast_elimination.h"
 #include "core/optimizer/common_subexpression_elimination.h"
+#include "core/optimizer/compute_optimizer/upstream_gather.h"
 #include "core/optimizer/constant_folding.h"
 #include "core/optimizer/constant_sharing.h"
 #include "core/optimizer/conv_add_act_fusion.h"
 #include "core/optimizer/conv_add_fusion.h"
 #include "core/optimizer/conv_bn_fusion.h"
 #include "core/optimizer/conv_mul_fusion.h"
+#include "core/optimizer/depthwise_pointwise_conv_fusion.h"
 #include "core/optimizer/div_mul_fusion.h"
 #include "core/optimizer/double_qdq_pairs_remover.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_fusion.h"
 #include "core/optimizer/embed_layer_norm_fusion.h"
+#include "core/optimizer/embedding_bag_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
 #include "core/optimizer/free_dim_override_transformer.h"
@@ -47,9 +54,11 @@
 #include "core/optimizer/identity_elimination.h"
 #include "core/optimizer/label_encoder_fusion.h"
 #include "core/optimizer/layer_norm_fusion.h"
+#include "core/optimizer/loop_invariant_code_motion.h"
 #include "core/optimizer/matmul_activation_fusion.h"
 #include "core/optimizer/matmul_add_fusion.h"
 #include "core/optimizer/matmul_bn_fusion.h"
+#include "core/optimizer/matmul_dynamic_quantization.h"
 #include "core/optimizer/matmul_integer_to_float.h"
 #include "core/optimizer/matmul_scale_fusion.h"
 #include "core/optimizer/matmul_transpose_fusion.h"
@@ -58,21 +67,26 @@
 #include "core/optimizer/not_where_fusion.h"
 #include "core/optimizer/pad_fusion.h"
 #include "core/optimizer/pre_shape_node_elimination.h"
+#include "core/optimizer/propagate_cast_ops.h"
 #ifdef MLAS_TARGET_AMD64_IX86
 #include "core/optimizer/qdq_transformer/avx2_weight_s8_to_u8.h"
 #endif
 #include "core/optimizer/qdq_transformer/clip_quantizelinear.h"
 #include "core/optimizer/qdq_transformer/ensure_unique_dq_for_node_unit.h"
+#include "core/optimizer/qdq_transformer/qdq_matmul_bias_fusion.h"
 #include "core/optimizer/qdq_transformer/qdq_propagation.h"
 #include "core/optimizer/qdq_transformer/qdq_s8_to_u8.h"
 #include "core/optimizer/qdq_transformer/relu_quantizelinear.h"
 #include "core/optimizer/quick_gelu_fusion.h"
 #include "core/optimizer/relu_clip_fusion.h"
 #include "core/optimizer/reshape_fusion.h"
+#include "core/optimizer/shape_subgraph_folding.h"
 #include "core/optimizer/rocm_blas_alt_impl.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/optimizer/skip_layer_norm_fusion.h"
+#include "core/optimizer/smooth_quant.h"
 #include "core/optimizer/slice_elimination.h"
+#include "core/optimizer/tensor_parallel_sharding.h"
 #include "core/optimizer/transpose_optimizer.h"
 #include "core/optimizer/unsqueeze_elimination.h"
 #ifdef ENABLE_TRAINING
@@ -187,12 +201,15 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
     TransformerLevel level,
     const SessionOptions& session_options,
     const IExecutionProvider& cpu_execution_provider, /*required by constant folding*/
-    const InlinedHashSet<std::string>& rules_and_transformers_to_disable) {
+    const InlinedHashSet<std::string>& rules_and_transformers_to_disable,
+    const std::unordered_map<std::string, std::string>& model_metadata) {
   InlinedVector<std::unique_ptr<GraphTransformer>> transformers;
   const bool disable_quant_qdq =
       session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsDisableQuantQDQ, "0") == "1";
 #ifndef DISABLE_CONTRIB_OPS
   const InlinedHashSet<std::string_view> cpu_ep = {onnxruntime::kCpuExecutionProvider};
+#else
+  ORT_UNUSED_PARAMETER(model_metadata);
 #endif
   const InlinedHashSet<std::string_view> dml_ep = {onnxruntime::kDmlExecutionProvider};
   AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
@@ -227,11 +244,68 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<CommonSubexpressionElimination>());
       transformers.emplace_back(std::make_unique<ConstantFolding>(cpu_execution_provider, !disable_quant_qdq,
                                                                   session_options.config_options));
+      // Runs after ConstantFolding so that constant computations in Loop bodies are folded rather than moved.
+      transformers.emplace_back(std::make_unique<LoopInvariantCodeMotion>());
       transformers.emplace_back(std::make_unique<MatMulAddFusion>());
       transformers.emplace_back(std::make_unique<ReshapeFusion>());
+      // Folds the shape computations with symbolic dimensions that ConstantFolding and ReshapeFusion leave behind.
+      transformers.emplace_back(std::make_unique<ShapeSubgraphFolding>());
       transformers.emplace_back(std::make_unique<FreeDimensionOverrideTransformer>(
           session_options.free_dimension_overrides));
 
+      // Shards the MLP blocks for in-process tensor parallelism. It runs before the nodes are assigned to execution
+      // providers so that the inserted AllReduce nodes are assigned with the others.
+      int64_t tensor_parallel_world_size = 0;
+      const std::string tensor_parallel_world_size_str =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigTensorParallelWorldSize, "0");
+      ORT_ENFORCE(TryParseStringWithClassicLocale(tensor_parallel_world_size_str, tensor_parallel_world_size) &&
+                      tensor_parallel_world_size >= 0,
+                  "Invalid value for ", kOrtSessionOptionsConfigTensorParallelWorldSize, ": ",
+                  tensor_parallel_world_size_str);
+      if (tensor_parallel_world_size > 1) {
+#if !defined(ORT_USE_NCCL)
+        ORT_THROW(kOrtSessionOptionsConfigTensorParallelWorldSize, " requires a build with NCCL.");
+#endif
+        int64_t tensor_parallel_rank = -1;
+        const std::string tensor_parallel_rank_str =
+            session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigTensorParallelRank, "");
+        ORT_ENFORCE(TryParseStringWithClassicLocale(tensor_parallel_rank_str, tensor_parallel_rank) &&
+                        tensor_parallel_rank >= 0 && tensor_parallel_rank < tensor_parallel_world_size,
+                    "Invalid value for ", kOrtSessionOptionsConfigTensorParallelRank, ": ", tensor_parallel_rank_str);
+        transformers.emplace_back(std::make_unique<TensorParallelSharding>(tensor_parallel_world_size,
+                                                                           tensor_parallel_rank));
+      }
+
+      // Converts the float graph to mixed precision. It runs before the nodes are assigned to execution providers,
+      // so InsertCastTransformer runs the converted nodes without a lower precision kernel in float.
+      const std::string auto_mixed_precision =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsAutoMixedPrecision, "");
+      if (!auto_mixed_precision.empty()) {
+        ORT_ENFORCE(auto_mixed_precision == "fp16" || auto_mixed_precision == "bf16",
+                    "Invalid value for ", kOrtSessionOptionsAutoMixedPrecision, ": ", auto_mixed_precision,
+                    ". Expected \"fp16\" or \"bf16\".");
+        auto to_op_set = [&session_options](const char* config_key) {
+          InlinedHashSet<std::string> op_types;
+          const std::string ops = session_options.config_options.GetConfigOrDefault(config_key, "");
+          for (const auto op_type : utils::SplitString(ops, ",")) {
+            op_types.emplace(op_type);
+          }
+          return op_types;
+        };
+
+        const bool to_fp16 = auto_mixed_precision == "fp16";
+        transformers.emplace_back(std::make_unique<AutoMixedPrecision>(
+            to_fp16 ? ONNX_NAMESPACE::TensorProto_DataType_FLOAT16 : ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16,
+            to_op_set(kOrtSessionOptionsAutoMixedPrecisionAllowOps),
+            to_op_set(kOrtSessionOptionsAutoMixedPrecisionDenyOps)));
+        // Move the casts on the region boundaries across the data movement and activation ops next to them and
+        // remove the redundant ones. It only handles float16.
+        if (to_fp16) {
+          transformers.emplace_back(std::make_unique<PropagateCastOps>(
+              GraphTransformerConfiguration::PropagateCastOpsConfiguration::Strategy::FloodFill, 1));
+        }
+      }
+
       if (!disable_quant_qdq) {
         transformers.emplace_back(std::make_unique<QDQPropagationTransformer>());
 
@@ -269,6 +343,10 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
                                                             QDQIsInt8Allowed() ? "1" : "0") == "1";
       const bool enable_gelu_approximation =
           session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableGeluApproximation, "0") == "1";
+      const bool enable_dynamic_quantize_matmul =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableDynamicQuantizeMatMul, "0") == "1";
+      const bool enable_smooth_quant =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableSmoothQuant, "0") == "1";
 
       const InlinedHashSet<std::string_view> cuda_rocm_eps = {onnxruntime::kCudaExecutionProvider,
                                                               onnxruntime::kRocmExecutionProvider};
@@ -300,7 +378,10 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
         if (!qdq_is_int8_allowed) {
           transformers.emplace_back(std::make_unique<QDQS8ToU8Transformer>(avx2_precision_mode, cpu_ep));
         }
+        // QDQMatMulBiasFusion must run before the QDQSelectorActionTransformer fuses the MatMul and the Add separately.
+        transformers.emplace_back(std::make_unique<QDQMatMulBiasFusion>(cpu_ep));
         transformers.emplace_back(std::make_unique<QDQSelectorActionTransformer>(qdq_is_int8_allowed));
+        transformers.emplace_back(std::make_unique<QDQFloat8SelectorActionTransformer>());
       }
 
       transformers.emplace_back(std::make_unique<GemmActivationFusion>(cpu_ep));
@@ -308,6 +389,10 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<DynamicQuantizeMatMulFusion>(cpu_ep));
 
       transformers.emplace_back(std::make_unique<ConvActivationFusion>(cpu_cuda_rocm_acl_armnn_js_eps));
+      // On platforms with NCHWc support, the NchwcTransformer handles depthwise and pointwise Conv pairs instead.
+      if (MlasNchwcGetBlockSize() <= 1) {
+        transformers.emplace_back(std::make_unique<DepthwisePointwiseConvFusion>(cpu_ep));
+      }
 
       transformers.emplace_back(std::make_unique<GeluFusion>(cpu_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<LayerNormFusion>(cpu_cuda_dml_rocm_eps));
@@ -316,12 +401,34 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<EmbedLayerNormFusion>(cpu_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<GatherSliceToSplitFusion>(cpu_cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<GatherToSliceFusion>(cpu_cuda_rocm_eps));
+      transformers.emplace_back(std::make_unique<EmbeddingBagFusion>(cpu_ep));
+      // Moves Gather/Slice ops that keep a few rows, e.g. the last token's logits, ahead of the LayerNorm, MatMul and
+      // elementwise ops that produce them. It runs after the attention fusions so that it does not split their
+      // patterns, and before the fusions into ops it can't pass through, e.g. FusedMatMul.
+      transformers.emplace_back(std::make_unique<UpStreamGatherGraphTransformer>(cpu_cuda_rocm_eps));
 
       transformers.emplace_back(std::make_unique<MatmulTransposeFusion>(cpu_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<BiasGeluFusion>(cpu_cuda_dml_rocm_eps));
 
       transformers.emplace_back(std::make_unique<SkipLayerNormFusion>(cpu_cuda_dml_rocm_eps));
 
+      // SmoothQuant rescales the normalization outputs, so it runs after the fusions that produce the normalization
+      // nodes and before the MatMul nodes are fused or quantized.
+      if (enable_smooth_quant) {
+        const std::string smooth_quant_alpha_str =
+            session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsSmoothQuantAlpha, "0.5");
+        float smooth_quant_alpha = 0.0f;
+        ORT_ENFORCE(TryParseStringWithClassicLocale(smooth_quant_alpha_str, smooth_quant_alpha) &&
+                        smooth_quant_alpha >= 0.0f && smooth_quant_alpha <= 1.0f,
+                    "Invalid value for ", kOrtSessionOptionsSmoothQuantAlpha, ": ", smooth_quant_alpha_str);
+        std::unordered_map<std::string, std::vector<float>> activation_abs_max;
+        ORT_THROW_IF_ERROR(SmoothQuant::ParseActivationAbsMax(model_metadata, activation_abs_max));
+        if (!activation_abs_max.empty()) {
+          transformers.emplace_back(std::make_unique<SmoothQuant>(std::move(activation_abs_max), smooth_quant_alpha,
+                                                                  cpu_cuda_dml_rocm_eps));
+        }
+      }
+
       transformers.emplace_back(std::make_unique<FastGeluFusion>(cpu_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<QuickGeluFusion>(cpu_cuda_dml_rocm_eps));
 
@@ -351,6 +458,15 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<MatMulScaleFusion>(cpu_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<MatMulActivationFusion>(dml_ep));
 
+      // Fuses the elementwise chains left over by the pattern fusions above, so it must run after them.
+      transformers.emplace_back(std::make_unique<ElementwiseFusion>(cpu_ep));
+
+      // MatMulDynamicQuantization changes results, so it needs to be manually enabled. It runs after the fusions
+      // that match MatMul nodes, and before Avx2WeightS8ToU8Transformer which may need to adjust the int8 weights.
+      if (enable_dynamic_quantize_matmul) {
+        transformers.emplace_back(std::make_unique<MatMulDynamicQuantization>(cpu_ep));
+      }
+
 #ifdef MLAS_TARGET_AMD64_IX86
       if (avx2_precision_mode) {
         transformers.emplace_back(std::make_unique<Avx2WeightS8ToU8Transformer>(cpu_ep));
@@ -358,7 +474,10 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 #endif
 
 #if !defined(ORT_NEURAL_SPEED)
-      transformers.emplace_back(std::make_unique<MatMulNBitsFusion>(cpu_ep));
+      // the activation fusions only apply to nodes assigned to the CUDA EP, which implements the activation attribute
+      const InlinedHashSet<std::string_view> cpu_cuda_eps = {onnxruntime::kCpuExecutionProvider,
+                                                             onnxruntime::kCudaExecutionProvider};
+      transformers.emplace_back(std::make_unique<MatMulNBitsFusion>(cpu_cuda_eps));
 #endif  // !defined(ORT_NEURAL_SPEED)
 
 #endif  // !defined(DISABLE_CONTRIB_OPS)
@@ -372,7 +491,9 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 #ifndef DISABLE_CONTRIB_OPS
       // Register the NCHWc layout transformer if supported by the platform.
       if (MlasNchwcGetBlockSize() > 1) {
-        transformers.emplace_back(std::make_unique<NchwcTransformer>());
+        const bool enable_nchwc_cost_model =
+            session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableNchwcCostModel, "0") == "1";
+        transformers.emplace_back(std::make_unique<NchwcTransformer>(enable_nchwc_cost_model));
       }
 
       auto cpu_registry = cpu_execution_provider.GetKernelRegistry();
@@ -0,0 +1,144 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/loop_invariant_code_motion.h"
+
+#include <algorithm>
+#include <string_view>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+bool IsHoistCandidate(const Node& node, const InlinedHashSet<std::string_view>& body_outputs) {
+  if (node.ContainsSubgraph() || !graph_utils::MatchesOpSetDomain(node, kOnnxDomain) ||
+      !optimizer_utils::IsOperationDeterministic(node.Domain(), node.OpType())) {
+    return false;
+  }
+
+  for (const auto* output_def : node.OutputDefs()) {
+    if (output_def->Exists() && body_outputs.count(output_def->Name()) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Moves the nodes of the body that only consume outer scope values to outer_graph, in topological order so that
+// nodes consuming the outputs of moved nodes can be moved too.
+bool HoistLoopInvariantNodes(Graph& outer_graph, Graph& body, const logging::Logger& logger) {
+  // the values that are defined in the body: its inputs, initializers and the outputs of its nodes.
+  // anything else a node consumes comes from the outer scope.
+  InlinedHashSet<std::string_view> local_values;
+  for (const auto* input : body.GetInputs()) {
+    local_values.insert(input->Name());
+  }
+  for (const auto& [name, tensor_proto] : body.GetAllInitializedTensors()) {
+    ORT_UNUSED_PARAMETER(tensor_proto);
+    local_values.insert(name);
+  }
+  for (const auto& node : body.Nodes()) {
+    for (const auto* output_def : node.OutputDefs()) {
+      if (output_def->Exists()) {
+        local_values.insert(output_def->Name());
+      }
+    }
+  }
+
+  InlinedHashSet<std::string_view> body_outputs;
+  for (const auto* output : body.GetOutputs()) {
+    body_outputs.insert(output->Name());
+  }
+
+  bool modified = false;
+  GraphViewer body_viewer(body);
+  for (auto node_index : body_viewer.GetNodesInTopologicalOrder()) {
+    auto* node_ptr = body.GetNode(node_index);
+    if (node_ptr == nullptr || !IsHoistCandidate(*node_ptr, body_outputs)) {
+      continue;
+    }
+
+    auto& node = *node_ptr;
+    const auto& input_defs = node.InputDefs();
+    const bool is_invariant = std::all_of(input_defs.cbegin(), input_defs.cend(), [&](const NodeArg* input_def) {
+      return !input_def->Exists() || local_values.count(input_def->Name()) == 0;
+    });
+
+    const auto& output_defs = node.OutputDefs();
+    const bool name_conflict = std::any_of(output_defs.cbegin(), output_defs.cend(), [&](const NodeArg* output_def) {
+      return output_def->Exists() && outer_graph.GetNodeArg(output_def->Name()) != nullptr;
+    });
+
+    if (!is_invariant || name_conflict) {
+      continue;
+    }
+
+    InlinedVector<NodeArg*> inputs;
+    inputs.reserve(input_defs.size());
+    for (const auto* input_def : input_defs) {
+      inputs.push_back(&outer_graph.GetOrCreateNodeArg(input_def->Name(), input_def->TypeAsProto()));
+    }
+
+    InlinedVector<NodeArg*> outputs;
+    outputs.reserve(output_defs.size());
+    for (const auto* output_def : output_defs) {
+      outputs.push_back(&outer_graph.GetOrCreateNodeArg(output_def->Name(), output_def->TypeAsProto()));
+    }
+
+    Node& hoisted = outer_graph.AddNode(outer_graph.GenerateNodeName(node.Name()), node.OpType(), node.Description(),
+                                        inputs, outputs, &node.GetAttributes(), node.Domain());
+    hoisted.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    LOGS(logger, VERBOSE) << "Moved loop invariant node " << node.Name() << " (" << node.OpType()
+                          << ") out of the Loop body";
+
+    // the consumers in the body now read the outputs from the outer scope
+    for (const auto* output_def : output_defs) {
+      local_values.erase(output_def->Name());
+    }
+
+    graph_utils::RemoveNodeOutputEdges(body, node);
+    body.RemoveNode(node.Index());
+    modified = true;
+  }
+
+  return modified;
+}
+
+}  // namespace
+
+Status LoopInvariantCodeMotion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                          const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (node_ptr == nullptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+    // nested Loops first, so their invariant nodes are moved to this Loop's body before it is processed
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Loop", {1, 11, 13, 16, 19, 21}) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    Graph* body = node.GetMutableGraphAttribute("body");
+    if (body != nullptr && HoistLoopInvariantNodes(graph, *body, logger)) {
+      modified = true;
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
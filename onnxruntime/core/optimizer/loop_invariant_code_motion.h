@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class LoopInvariantCodeMotion
+
+Moves the nodes of a Loop body that only consume values from the outer scope, i.e. neither the iteration number,
+the condition, the loop carried values nor anything computed from them, to the graph that contains the Loop, so
+they run once instead of once per iteration. Nested Loops are processed first, so invariant nodes can move out of
+several levels of Loops.
+
+Only deterministic ONNX operators without subgraphs are moved, and nodes producing outputs of the body stay in it.
+Moved nodes also run if the Loop has no iteration.
+*/
+class LoopInvariantCodeMotion : public GraphTransformer {
+ public:
+  LoopInvariantCodeMotion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("LoopInvariantCodeMotion", compatible_execution_providers) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
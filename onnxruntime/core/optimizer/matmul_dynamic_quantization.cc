@@ -0,0 +1,125 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/matmul_dynamic_quantization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "core/common/narrow.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Returns the float 2D initializer that is input B of `matmul` if it can be quantized, nullptr otherwise.
+const TensorProto* GetQuantizableWeight(const Graph& graph, const Node& matmul) {
+  const auto& input_defs = matmul.InputDefs();
+  const auto* a_type = input_defs[0]->TypeAsProto();
+  if (a_type == nullptr || a_type->tensor_type().elem_type() != TensorProto_DataType_FLOAT) {
+    return nullptr;
+  }
+
+  const TensorProto* b_tensor_proto = graph_utils::GetConstantInitializer(graph, input_defs[1]->Name());
+  if (b_tensor_proto == nullptr ||
+      b_tensor_proto->data_type() != TensorProto_DataType_FLOAT ||
+      b_tensor_proto->dims_size() != 2) {
+    return nullptr;
+  }
+
+  return b_tensor_proto;
+}
+
+}  // namespace
+
+Status MatMulDynamicQuantization::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                            const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& matmul = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(matmul, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(matmul, "MatMul", {1, 9, 13}) ||
+        !graph_utils::IsSupportedProvider(matmul, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    const TensorProto* b_tensor_proto = GetQuantizableWeight(graph, matmul);
+    if (b_tensor_proto == nullptr) {
+      continue;
+    }
+
+    Initializer b(*b_tensor_proto, graph.ModelPath());
+    const auto k = narrow<size_t>(b_tensor_proto->dims(0));
+    const auto n = narrow<size_t>(b_tensor_proto->dims(1));
+    const float* b_data = b.data<float>();
+
+    // symmetric per column quantization, so B needs no zero point
+    std::vector<float> scales(n, 0.0f);
+    for (size_t row = 0; row < k; row++) {
+      for (size_t col = 0; col < n; col++) {
+        scales[col] = std::max(scales[col], std::abs(b_data[row * n + col]));
+      }
+    }
+    for (auto& scale : scales) {
+      scale = scale > 0.0f ? scale / 127.0f : 1.0f;
+    }
+
+    std::vector<int8_t> b_quant(k * n);
+    for (size_t row = 0; row < k; row++) {
+      for (size_t col = 0; col < n; col++) {
+        const float value = std::nearbyint(b_data[row * n + col] / scales[col]);
+        b_quant[row * n + col] = static_cast<int8_t>(std::clamp(value, -127.0f, 127.0f));
+      }
+    }
+
+    TensorProto b_quant_proto;
+    b_quant_proto.set_name(graph.GenerateNodeArgName(b_tensor_proto->name() + "_quantized"));
+    b_quant_proto.set_data_type(TensorProto_DataType_INT8);
+    b_quant_proto.mutable_dims()->CopyFrom(b_tensor_proto->dims());
+    b_quant_proto.set_raw_data(b_quant.data(), b_quant.size() * sizeof(int8_t));
+
+    TensorProto b_scale_proto;
+    b_scale_proto.set_name(graph.GenerateNodeArgName(b_tensor_proto->name() + "_scale"));
+    b_scale_proto.set_data_type(TensorProto_DataType_FLOAT);
+    b_scale_proto.add_dims(static_cast<int64_t>(n));
+    b_scale_proto.set_raw_data(scales.data(), scales.size() * sizeof(float));
+
+    InlinedVector<NodeArg*> input_defs{
+        matmul.MutableInputDefs()[0],
+        &graph_utils::AddInitializer(graph, b_quant_proto),
+        &graph_utils::AddInitializer(graph, b_scale_proto)};
+
+    Node& dynamic_quantize_matmul = graph.AddNode(graph.GenerateNodeName(matmul.Name() + "_DynamicQuantizeMatMul"),
+                                                  "DynamicQuantizeMatMul",
+                                                  "MatMul with dynamically quantized activations",
+                                                  input_defs,
+                                                  matmul.MutableOutputDefs(),
+                                                  nullptr,
+                                                  kMSDomain);
+    dynamic_quantize_matmul.AddAttribute("per_row_a_quantization", static_cast<int64_t>(1));
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    dynamic_quantize_matmul.SetExecutionProviderType(matmul.GetExecutionProviderType());
+
+    graph_utils::RemoveNodeOutputEdges(graph, matmul);
+    graph.RemoveNode(matmul.Index());
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class MatMulDynamicQuantization
+
+Rewrite float MatMul nodes whose B input is a constant 2D initializer into DynamicQuantizeMatMul. B is quantized to
+int8 with one symmetric scale per column when the graph is optimized, and A is quantized at runtime with one scale per
+row (per_row_a_quantization=1), so the MatMul runs on the int8 GEMM kernels.
+
+This changes the numerical results, so it has to be enabled explicitly.
+*/
+class MatMulDynamicQuantization : public GraphTransformer {
+ public:
+  MatMulDynamicQuantization(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("MatMulDynamicQuantization", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
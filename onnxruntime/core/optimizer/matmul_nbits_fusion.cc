@@ -20,13 +20,32 @@ namespace {
 
 namespace selectors {
 
+bool HasInput(const Node& node, size_t index) {
+  const auto input_defs = node.InputDefs();
+  return input_defs.size() > index && input_defs[index]->Exists();
+}
+
+std::string GetActivation(const Node& node) {
+  const auto* attr = graph_utils::GetNodeAttribute(node, "activation");
+  return attr == nullptr ? std::string{} : attr->s();
+}
+
+int64_t GetIntAttribute(const Node& node, const std::string& name, int64_t default_value) {
+  const auto* attr = graph_utils::GetNodeAttribute(node, name);
+  return attr == nullptr ? default_value : attr->i();
+}
+
 class BiasFusion : public NodeSelector {
  public:
   std::optional<NodesToOptimizeIndices> Select(const GraphViewer& graph_viewer,
                                                const Node& node) const override {
     // check if MatMulNBits node already has a bias input
-    if (const auto input_defs = node.InputDefs();
-        input_defs.size() > 5 && input_defs[5]->Exists()) {
+    if (HasInput(node, 5)) {
+      return std::nullopt;
+    }
+
+    // the bias is added before the activation, so it can't be fused after it
+    if (!GetActivation(node).empty()) {
       return std::nullopt;
     }
 
@@ -71,6 +90,154 @@ class BiasFusion : public NodeSelector {
   }
 };
 
+// Fuses a SiLU or GELU consuming the output of a MatMulNBits node assigned to the CUDA EP, the only one that implements
+// the activation attribute. SiLU is matched as x * Sigmoid(x) or QuickGelu with alpha 1.
+class ActivationFusion : public NodeSelector {
+ public:
+  std::optional<NodesToOptimizeIndices> Select(const GraphViewer& graph_viewer,
+                                               const Node& node) const override {
+    if (node.GetExecutionProviderType() != kCudaExecutionProvider || !GetActivation(node).empty()) {
+      return std::nullopt;
+    }
+
+    const auto& graph = graph_viewer.GetGraph();
+    NodesToOptimizeIndicesBuilder builder{};
+    builder.target_node = node.Index();
+
+    if (optimizer_utils::CheckOutputEdges(graph, node, 2)) {
+      const Node* sigmoid = nullptr;
+      const Node* mul = nullptr;
+      for (auto it = node.OutputNodesBegin(); it != node.OutputNodesEnd(); ++it) {
+        if (graph_utils::IsSupportedOptypeVersionAndDomain(*it, "Sigmoid", {6, 13})) {
+          sigmoid = &*it;
+        } else if (graph_utils::IsSupportedOptypeVersionAndDomain(*it, "Mul", {7, 13, 14})) {
+          mul = &*it;
+        }
+      }
+
+      if (sigmoid == nullptr || mul == nullptr ||
+          !optimizer_utils::CheckOutputEdges(graph, *sigmoid, 1) ||
+          sigmoid->OutputNodesBegin()->Index() != mul->Index() ||
+          sigmoid->GetExecutionProviderType() != node.GetExecutionProviderType() ||
+          mul->GetExecutionProviderType() != node.GetExecutionProviderType()) {
+        return std::nullopt;
+      }
+
+      builder.output_nodes = {sigmoid->Index(), mul->Index()};
+      return builder.Build();
+    }
+
+    if (!optimizer_utils::CheckOutputEdges(graph, node, 1)) {
+      return std::nullopt;
+    }
+
+    const Node& next_node = *node.OutputNodesBegin();
+    if (next_node.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+      return std::nullopt;
+    }
+
+    const bool is_silu = graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "QuickGelu", {1}, kMSDomain) &&
+                         graph_utils::GetNodeAttribute(next_node, "alpha") != nullptr &&
+                         graph_utils::GetNodeAttribute(next_node, "alpha")->f() == 1.0f;
+    const bool is_gelu = graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "Gelu", {1}, kMSDomain) ||
+                         (graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "Gelu", {20}) &&
+                          (graph_utils::GetNodeAttribute(next_node, "approximate") == nullptr ||
+                           graph_utils::GetNodeAttribute(next_node, "approximate")->s() == "none"));
+    if (!is_silu && !is_gelu) {
+      return std::nullopt;
+    }
+
+    builder.output_nodes = {next_node.Index()};
+    return builder.Build();
+  }
+};
+
+// Fuses the gate and up projections of a SwiGLU FFN, silu(MatMulNBits(x, W_gate)) * MatMulNBits(x, W_up), into a
+// single MatMulNBits with the concatenated weights. The silu is expected to have been fused by ActivationFusion.
+class SwiGluFusion : public NodeSelector {
+ public:
+  std::optional<NodesToOptimizeIndices> Select(const GraphViewer& graph_viewer,
+                                               const Node& node) const override {
+    const auto& graph = graph_viewer.GetGraph();
+    if (node.GetExecutionProviderType() != kCudaExecutionProvider || GetActivation(node) != "silu" ||
+        HasInput(node, 4) || HasInput(node, 5) || !HasConcatenableWeights(graph, node) ||
+        !optimizer_utils::CheckOutputEdges(graph, node, 1)) {
+      return std::nullopt;
+    }
+
+    const Node& mul = *node.OutputNodesBegin();
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(mul, "Mul", {7, 13, 14}) ||
+        mul.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+      return std::nullopt;
+    }
+
+    const NodeArg* up_output = mul.InputDefs()[0] == node.OutputDefs()[0] ? mul.InputDefs()[1] : mul.InputDefs()[0];
+    const Node* up = graph.GetProducerNode(up_output->Name());
+    if (up == nullptr || up->OpType() != "MatMulNBits" || up->Domain() != kMSDomain ||
+        up->GetExecutionProviderType() != node.GetExecutionProviderType() || !GetActivation(*up).empty() ||
+        HasInput(*up, 4) || HasInput(*up, 5) || up->InputDefs()[0] != node.InputDefs()[0] ||
+        HasInput(*up, 3) != HasInput(node, 3) || !HasConcatenableWeights(graph, *up) ||
+        !optimizer_utils::CheckOutputEdges(graph, *up, 1)) {
+      return std::nullopt;
+    }
+
+    for (const char* name : {"K", "N", "bits", "block_size", "accuracy_level"}) {
+      if (GetIntAttribute(node, name, 0) != GetIntAttribute(*up, name, 0)) {
+        return std::nullopt;
+      }
+    }
+
+    for (size_t i = 1; i < 4 && HasInput(node, i); ++i) {
+      const auto* gate_tensor = graph_utils::GetConstantInitializer(graph, node.InputDefs()[i]->Name());
+      const auto* up_tensor = graph_utils::GetConstantInitializer(graph, up->InputDefs()[i]->Name());
+      if (gate_tensor->data_type() != up_tensor->data_type()) {
+        return std::nullopt;
+      }
+    }
+
+    NodesToOptimizeIndicesBuilder builder{};
+    builder.input_nodes = {up->Index()};
+    builder.target_node = node.Index();
+    builder.output_nodes = {mul.Index()};
+    return builder.Build();
+  }
+
+ private:
+  // The quantized weight, scales and zero points must be constant and stored per output feature, so that those of the
+  // gate and up projections can be concatenated along their first dimension.
+  static bool HasConcatenableWeights(const Graph& graph, const Node& node) {
+    const int64_t K = GetIntAttribute(node, "K", 0);
+    const int64_t N = GetIntAttribute(node, "N", 0);
+    const int64_t bits = GetIntAttribute(node, "bits", 4);
+    const int64_t block_size = GetIntAttribute(node, "block_size", 0);
+    if (block_size <= 0) {
+      return false;
+    }
+    const int64_t blocks_per_col = (K + block_size - 1) / block_size;
+
+    const auto* b = graph_utils::GetConstantInitializer(graph, node.InputDefs()[1]->Name());
+    const auto* scales = graph_utils::GetConstantInitializer(graph, node.InputDefs()[2]->Name());
+    if (b == nullptr || b->dims_size() == 0 || b->dims(0) != N || scales == nullptr ||
+        utils::GetTensorShapeFromTensorProto(*scales).Size() != N * blocks_per_col) {
+      return false;
+    }
+
+    if (!HasInput(node, 3)) {
+      return true;
+    }
+
+    // uint8 zero points are packed, each output feature needs to start at a byte boundary
+    const auto* zero_points = graph_utils::GetConstantInitializer(graph, node.InputDefs()[3]->Name());
+    if (zero_points == nullptr) {
+      return false;
+    }
+    const int64_t zero_points_per_col = zero_points->data_type() == ONNX_NAMESPACE::TensorProto_DataType_UINT8
+                                            ? (blocks_per_col * bits + 7) / 8
+                                            : blocks_per_col;
+    return utils::GetTensorShapeFromTensorProto(*zero_points).Size() == N * zero_points_per_col;
+  }
+};
+
 }  // namespace selectors
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
@@ -98,6 +265,82 @@ struct BiasFusion : MergeIntoTarget {
   }
 };
 
+struct ActivationFusion : MergeIntoTarget {
+  Status Run(Graph& graph, const NodesToOptimize& selected_nodes) const override {
+    const Node& activation = *selected_nodes.Output(selected_nodes.num_outputs - 1);
+    const bool is_gelu = selected_nodes.num_outputs == 1 && activation.OpType() == "Gelu";
+    selected_nodes.Target().AddAttribute("activation", std::string{is_gelu ? "gelu" : "silu"});
+
+    return MergeIntoTarget::Run(graph, selected_nodes);
+  }
+
+ private:
+  std::vector<NodeAndMoveInfo> ValueMoves(const RuntimeState& runtime_state) const override {
+    // move output from the last node, the activation or the Mul of x * Sigmoid(x)
+    NTO::NodeLocation activation_location{NTO::NodeType::kOutput, runtime_state.selected_nodes.num_outputs - 1};
+
+    return {MoveToSlot(activation_location, ArgType::kOutput, 0, ArgType::kOutput, 0)};
+  }
+};
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+// Concatenates two constant initializers along their first dimension.
+Status ConcatInitializers(Graph& graph, const NodeArg& first, const NodeArg& second, NodeArg*& concat_arg) {
+  const auto* first_tensor = graph_utils::GetConstantInitializer(graph, first.Name());
+  const auto* second_tensor = graph_utils::GetConstantInitializer(graph, second.Name());
+  ORT_RETURN_IF(first_tensor == nullptr || second_tensor == nullptr,
+                "Expected constant initializers: ", first.Name(), ", ", second.Name());
+
+  std::vector<uint8_t> data;
+  std::vector<uint8_t> second_data;
+  ORT_RETURN_IF_ERROR(utils::UnpackInitializerData(*first_tensor, graph.ModelPath(), data));
+  ORT_RETURN_IF_ERROR(utils::UnpackInitializerData(*second_tensor, graph.ModelPath(), second_data));
+  data.insert(data.end(), second_data.begin(), second_data.end());
+
+  ONNX_NAMESPACE::TensorProto concat;
+  concat.set_name(graph.GenerateNodeArgName(first.Name() + "_concat"));
+  concat.set_data_type(first_tensor->data_type());
+  concat.add_dims(first_tensor->dims(0) + second_tensor->dims(0));
+  for (int i = 1; i < first_tensor->dims_size(); ++i) {
+    concat.add_dims(first_tensor->dims(i));
+  }
+  concat.set_raw_data(data.data(), data.size());
+
+  concat_arg = &graph_utils::AddInitializer(graph, concat);
+  return Status::OK();
+}
+
+struct SwiGluFusion : Action {
+  Status Run(Graph& graph, const NodesToOptimize& selected_nodes) const override {
+    Node& up = *selected_nodes.Input(0);
+    Node& gate = selected_nodes.Target();
+    Node& mul = *selected_nodes.Output(0);
+
+    // A, then the gate and up weights, scales and zero points concatenated
+    InlinedVector<NodeArg*> input_defs{gate.MutableInputDefs()[0]};
+    for (size_t i = 1; i < 4 && selectors::HasInput(gate, i); ++i) {
+      NodeArg* concat_arg = nullptr;
+      ORT_RETURN_IF_ERROR(ConcatInitializers(graph, *gate.InputDefs()[i], *up.InputDefs()[i], concat_arg));
+      input_defs.push_back(concat_arg);
+    }
+
+    InlinedVector<NodeArg*> output_defs{mul.MutableOutputDefs()[0]};
+
+    Node& fused = graph.AddNode(graph.GenerateNodeName(gate.Name() + "_SwiGlu"), "MatMulNBits",
+                                "Fused gate and up projections of a SwiGLU FFN", input_defs, output_defs,
+                                &gate.GetAttributes(), kMSDomain);
+    fused.AddAttribute("N", 2 * selectors::GetIntAttribute(gate, "N", 0));
+    fused.AddAttribute("activation", std::string{"swiglu"});
+    fused.SetExecutionProviderType(gate.GetExecutionProviderType());
+
+    graph_utils::FinalizeNodeFusion(graph, {gate, up, mul}, fused);
+    return Status::OK();
+  }
+};
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 }  // namespace actions
 
 void BiasFusionRule(SelectorActionRegistry& registry) {
@@ -121,12 +364,50 @@ void BiasFusionRule(SelectorActionRegistry& registry) {
 #endif
 }
 
+void ActivationFusionRule(SelectorActionRegistry& registry) {
+  constexpr const char* name = "FuseActivation";
+
+  auto action = std::make_unique<actions::ActivationFusion>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+  auto selector = std::make_unique<selectors::ActivationFusion>();
+
+  registry.RegisterSelectorAndAction(name,
+                                     {{SelectorActionRegistry::OpVersionsMapKey("MatMulNBits", kMSDomain), {}}},
+                                     std::move(selector),
+                                     std::move(action));
+
+#else
+
+  registry.RegisterAction(name, std::move(action));
+
+#endif
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+// This fusion adds initializers, so it isn't available as a runtime optimization in minimal builds. It only applies
+// to nodes assigned to the CUDA EP, which runtime optimizations don't target.
+void SwiGluFusionRule(SelectorActionRegistry& registry) {
+  registry.RegisterSelectorAndAction("FuseSwiGlu",
+                                     {{SelectorActionRegistry::OpVersionsMapKey("MatMulNBits", kMSDomain), {}}},
+                                     std::make_unique<selectors::SwiGluFusion>(),
+                                     std::make_unique<actions::SwiGluFusion>());
+}
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 }  // namespace
 
 SelectorActionRegistry MatMulNBitsFusion::CreateSelectorActionRegistry() const {
   SelectorActionRegistry registry{};
 
   BiasFusionRule(registry);
+  ActivationFusionRule(registry);
+#if !defined(ORT_MINIMAL_BUILD)
+  SwiGluFusionRule(registry);
+#endif  // !defined(ORT_MINIMAL_BUILD)
 
   return registry;
 }
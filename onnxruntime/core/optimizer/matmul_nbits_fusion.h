@@ -10,6 +10,9 @@ namespace onnxruntime {
 // Performs node fusions with MatMulNBits.
 // Currently supports these fusions:
 // - MatMulNBits + Add -> MatMulNBits with bias input
+// - MatMulNBits + SiLU/GELU -> MatMulNBits with activation attribute (CUDA EP only)
+// - silu(MatMulNBits(x, W_gate)) * MatMulNBits(x, W_up) -> MatMulNBits with concatenated weights and
+//   activation="swiglu" (CUDA EP only)
 class MatMulNBitsFusion : public SelectorActionTransformer {
  public:
   MatMulNBitsFusion(const InlinedHashSet<std::string_view>& compatible_eps = {},
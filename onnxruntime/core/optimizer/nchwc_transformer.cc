@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include <deque>
+#include <optional>
+#include <vector>
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/nchwc_transformer.h"
@@ -15,6 +17,7 @@ class NchwcTransformerImpl {
  public:
   NchwcTransformerImpl(Graph& graph) noexcept : graph_(graph) {}
 
+  void ExcludeUnprofitableRegions(const GraphViewer& graph_viewer);
   void Transform(Node& node);
   void Finalize(bool& modified);
 
@@ -131,6 +134,9 @@ class NchwcTransformerImpl {
 
   Graph& graph_;
 
+  // Stores the nodes that the cost model decided to leave in NCHW format.
+  InlinedHashSet<NodeIndex> excluded_nodes_;
+
   // Stores a queue of nodes to be removed after walking through the graph.
   std::deque<NodeIndex> removed_nodes_;
 
@@ -1140,7 +1146,177 @@ void NchwcTransformerImpl::TrackTransposeFromNhwc(Node& node) {
   transpose_from_nhwc_output_arg_ = node.MutableOutputDefs()[0];
 }
 
+// Cost model of the NCHWc layout in units of one multiply-add of a NCHW convolution. The NCHWc convolution
+// kernels save a fraction of the time of the NCHW implementation, while each tensor element that crosses a
+// region boundary is reordered by a ReorderInput or ReorderOutput node.
+static constexpr double kNchwcConvSavings = 0.3;
+static constexpr double kNchwcReorderElementCost = 4.0;
+
+static int64_t StaticElementCount(const NodeArg& arg) {
+  const auto* shape = arg.Shape();
+  if (shape == nullptr) {
+    return -1;
+  }
+  int64_t count = 1;
+  for (const auto& dim : shape->dim()) {
+    if (!utils::HasDimValue(dim)) {
+      return -1;
+    }
+    count *= dim.dim_value();
+  }
+  return count;
+}
+
+void NchwcTransformerImpl::ExcludeUnprofitableRegions(const GraphViewer& graph_viewer) {
+  // Group the nodes that would be converted into regions that exchange NCHWc
+  // tensors. Convolutions and pooling start a region or extend the region of
+  // their input. Other supported nodes are only converted if all of their
+  // inputs are already in NCHWc format, so they join (and merge) the regions
+  // of their inputs.
+  InlinedHashMap<NodeIndex, size_t> node_regions;
+  InlinedHashMap<const NodeArg*, size_t> arg_regions;
+  std::vector<size_t> parents;
+
+  auto find_region = [&parents](size_t region) {
+    while (parents[region] != region) {
+      parents[region] = parents[parents[region]];
+      region = parents[region];
+    }
+    return region;
+  };
+
+  for (auto index : graph_viewer.GetNodesInTopologicalOrder()) {
+    const auto& node = *graph_.GetNode(index);
+    if (node.GetExecutionProviderType() != kCpuExecutionProvider || node.OutputDefs().empty()) {
+      continue;
+    }
+
+    std::optional<size_t> region;
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Conv", {1, 11}) ||
+        graph_utils::IsSupportedOptypeVersionAndDomain(node, "FusedConv", {1}, kMSDomain) ||
+        graph_utils::IsSupportedOptypeVersionAndDomain(node, "MaxPool", {1, 8, 10, 11, 12}) ||
+        graph_utils::IsSupportedOptypeVersionAndDomain(node, "AveragePool", {1, 7, 10, 11})) {
+      auto it = arg_regions.find(node.InputDefs()[0]);
+      if (it != arg_regions.end()) {
+        region = find_region(it->second);
+      } else {
+        region = parents.size();
+        parents.push_back(*region);
+      }
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sum", {6, 8, 13}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "Concat", {4, 11, 13}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "BatchNormalization", {7, 9, 14}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "Upsample", {9, 13}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "Resize", {10, 11, 13}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "GlobalMaxPool", {1}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "GlobalAveragePool", {1})) {
+      for (const auto* input_def : node.InputDefs()) {
+        if (!input_def->Exists() || graph_utils::NodeArgIsConstant(graph_, *input_def)) {
+          continue;
+        }
+        auto it = arg_regions.find(input_def);
+        if (it == arg_regions.end()) {
+          region.reset();
+          break;
+        }
+        const size_t input_region = find_region(it->second);
+        if (region.has_value() && *region != input_region) {
+          parents[input_region] = *region;
+        } else {
+          region = input_region;
+        }
+      }
+    }
+
+    if (region.has_value()) {
+      node_regions[index] = *region;
+      arg_regions[node.OutputDefs()[0]] = *region;
+    }
+  }
+
+  struct RegionCost {
+    double savings{0.0};
+    double reorder_cost{0.0};
+    bool has_static_shapes{true};
+    InlinedHashSet<const NodeArg*> reordered_args;
+  };
+  InlinedHashMap<size_t, RegionCost> region_costs;
+
+  auto add_reorder = [](RegionCost& cost, const NodeArg& arg) {
+    if (cost.reordered_args.insert(&arg).second) {
+      const int64_t elements = StaticElementCount(arg);
+      if (elements < 0) {
+        cost.has_static_shapes = false;
+      }
+      cost.reorder_cost += kNchwcReorderElementCost * static_cast<double>(elements);
+    }
+  };
+
+  for (const auto& node_region : node_regions) {
+    const auto& node = *graph_.GetNode(node_region.first);
+    const size_t region = find_region(node_region.second);
+    auto& cost = region_costs[region];
+
+    // The inputs of convolutions and pooling from outside of the region are
+    // reordered, except for convolutions that read the NCHW input directly.
+    const auto* input_def = node.InputDefs()[0];
+    auto it = arg_regions.find(input_def);
+    if (it == arg_regions.end() || find_region(it->second) != region) {
+      const ONNX_NAMESPACE::TensorProto* weights = nullptr;
+      if (node.OpType() == "MaxPool" || node.OpType() == "AveragePool") {
+        add_reorder(cost, *input_def);
+      } else if (node.InputDefs().size() >= 2 &&
+                 graph_.GetInitializedTensor(node.InputDefs()[1]->Name(), weights) && weights->dims_size() == 4) {
+        const auto* group_attr = graph_utils::GetNodeAttribute(node, "group");
+        const bool grouped = group_attr != nullptr && utils::HasInt(*group_attr) && group_attr->i() > 1;
+        if (grouped || static_cast<size_t>(weights->dims(1)) >= MlasNchwcGetBlockSize()) {
+          add_reorder(cost, *input_def);
+        }
+      }
+    }
+
+    // Each convolution saves a fraction of its multiply-adds.
+    const ONNX_NAMESPACE::TensorProto* weights = nullptr;
+    if ((node.OpType() == "Conv" || node.OpType() == "FusedConv") && node.InputDefs().size() >= 2 &&
+        graph_.GetInitializedTensor(node.InputDefs()[1]->Name(), weights) && weights->dims_size() == 4) {
+      const int64_t output_elements = StaticElementCount(*node.OutputDefs()[0]);
+      if (output_elements < 0) {
+        cost.has_static_shapes = false;
+      }
+      cost.savings += kNchwcConvSavings * static_cast<double>(output_elements) *
+                      static_cast<double>(weights->dims(1) * weights->dims(2) * weights->dims(3));
+    }
+
+    // The output is reordered back if it is used outside of the region.
+    bool used_outside = graph_.NodeProducesGraphOutput(node);
+    for (auto consumer = node.OutputNodesBegin(); consumer != node.OutputNodesEnd() && !used_outside; ++consumer) {
+      auto consumer_region = node_regions.find(consumer->Index());
+      used_outside = consumer_region == node_regions.end() || find_region(consumer_region->second) != region;
+    }
+    if (used_outside) {
+      add_reorder(cost, *node.OutputDefs()[0]);
+    }
+  }
+
+  for (const auto& node_region : node_regions) {
+    const auto& cost = region_costs[find_region(node_region.second)];
+    // Regions with dynamic shapes are converted as before.
+    if (cost.has_static_shapes && cost.reorder_cost > cost.savings) {
+      excluded_nodes_.insert(node_region.first);
+    }
+  }
+}
+
 void NchwcTransformerImpl::Transform(Node& node) {
+  if (excluded_nodes_.count(node.Index()) != 0) {
+    return;
+  }
+
   if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Transpose", {1, 13})) {
     TrackTransposeFromNhwc(node);
   }
@@ -1222,6 +1398,10 @@ Status NchwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level
   NchwcTransformerImpl impl(graph);
   GraphViewer graph_viewer(graph);
 
+  if (enable_cost_model_) {
+    impl.ExcludeUnprofitableRegions(graph_viewer);
+  }
+
   for (auto index : graph_viewer.GetNodesInTopologicalOrder()) {
     auto& node = *graph.GetNode(index);
     ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
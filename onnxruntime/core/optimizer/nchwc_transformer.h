@@ -13,13 +13,21 @@ namespace onnxruntime {
 
 Transformer that optimizes the graph by using NCHWc nodes instead of NCHW nodes
 and inserts nodes to reorder tensors as needed.
+
+If enable_cost_model is set, the nodes that would be converted are first grouped
+into connected NCHWc regions. A region is left in NCHW format if the cost of the
+ReorderInput/ReorderOutput nodes at its boundaries is estimated to exceed the
+speedup of its NCHWc convolutions, e.g. for an isolated Conv with few channels.
 */
 class NchwcTransformer : public GraphTransformer {
  public:
-  NchwcTransformer() noexcept : GraphTransformer("NchwcTransformer") {}
+  NchwcTransformer(bool enable_cost_model = false) noexcept
+      : GraphTransformer("NchwcTransformer"), enable_cost_model_(enable_cost_model) {}
 
  private:
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  const bool enable_cost_model_;
 };
 
 }  // namespace onnxruntime
@@ -84,6 +84,15 @@ class OptimizerExecutionFrame final : public IExecutionFrame {
                           const std::vector<int>& fetch_mlvalue_idxs,
                           const std::vector<OrtValue>& fetches = {});
 
+  // Frame with values that are fed instead of being initializers of `info`, so the kernels created from `info` can be
+  // reused with other values. `value_storage` is optional, see IExecutionFrame::UseValueStorage.
+  OptimizerExecutionFrame(const Info& info,
+                          gsl::span<const int> feed_mlvalue_idxs,
+                          gsl::span<const OrtValue> feeds,
+                          const std::vector<int>& fetch_mlvalue_idxs,
+                          const std::vector<OrtValue>& fetches,
+                          InlinedVector<OrtValue>* value_storage = nullptr);
+
   ~OptimizerExecutionFrame() override = default;
 
  private:
@@ -0,0 +1,142 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/pipeline_stage_extraction.h"
+
+#include <algorithm>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+
+namespace {
+
+// Size in bytes of the constant initializers consumed by `node`.
+size_t GetWeightBytes(const Graph& graph, const Node& node) {
+  size_t bytes = 0;
+  for (const auto* input_def : node.InputDefs()) {
+    const TensorProto* initializer = nullptr;
+    if (!input_def->Exists() || !graph.GetInitializedTensor(input_def->Name(), initializer)) {
+      continue;
+    }
+
+    size_t size = 0;
+    if (utils::GetSizeInBytesFromTensorProto<0>(*initializer, &size).IsOK()) {
+      bytes += size;
+    }
+  }
+  return bytes;
+}
+
+}  // namespace
+
+Status PipelineStageExtraction::ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/,
+                                          const logging::Logger& logger) const {
+  if (graph.IsSubgraph() || num_stages_ <= 1) {
+    return Status::OK();
+  }
+
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  // Nodes without weights count as one byte so that graphs without initializers are split by node count.
+  InlinedVector<size_t> costs;
+  costs.reserve(node_topology_list.size());
+  size_t total_cost = 0;
+  for (auto node_index : node_topology_list) {
+    costs.push_back(std::max<size_t>(GetWeightBytes(graph, *graph.GetNode(node_index)), 1));
+    total_cost += costs.back();
+  }
+
+  // A node belongs to the stage its cost is mostly in.
+  InlinedHashMap<NodeIndex, int64_t> node_stages;
+  double cumulative_cost = 0.0;
+  for (size_t i = 0; i < node_topology_list.size(); ++i) {
+    const double middle = cumulative_cost + static_cast<double>(costs[i]) / 2.0;
+    const auto stage =
+        static_cast<int64_t>(middle * static_cast<double>(num_stages_) / static_cast<double>(total_cost));
+    node_stages[node_topology_list[i]] = std::min(stage, num_stages_ - 1);
+    cumulative_cost += static_cast<double>(costs[i]);
+  }
+
+  auto stage_of_producer = [&](const std::string& name) -> int64_t {
+    const Node* producer = graph.GetProducerNode(name);
+    return producer == nullptr ? -1 : node_stages[producer->Index()];
+  };
+
+  InlinedHashSet<std::string> overridable_initializers;
+  for (const auto* input : graph.GetInputsIncludingInitializers()) {
+    overridable_initializers.insert(input->Name());
+  }
+
+  InlinedVector<const NodeArg*> stage_inputs;
+  InlinedVector<const NodeArg*> stage_outputs;
+  InlinedHashSet<const NodeArg*> added;
+  for (auto node_index : node_topology_list) {
+    if (node_stages[node_index] != stage_) {
+      continue;
+    }
+
+    const Node& node = *graph.GetNode(node_index);
+    auto add_input = [&](const NodeArg* input_def) {
+      if (!input_def->Exists() || stage_of_producer(input_def->Name()) == stage_ ||
+          (graph.IsInitializedTensor(input_def->Name()) && overridable_initializers.count(input_def->Name()) == 0)) {
+        return;
+      }
+      if (added.insert(input_def).second) {
+        stage_inputs.push_back(input_def);
+      }
+    };
+    for (const auto* input_def : node.InputDefs()) {
+      add_input(input_def);
+    }
+    for (const auto* input_def : node.ImplicitInputDefs()) {
+      add_input(input_def);
+    }
+
+    for (const auto* output_def : node.OutputDefs()) {
+      if (!output_def->Exists()) {
+        continue;
+      }
+
+      const auto consumers = graph.GetConsumerNodes(output_def->Name());
+      const bool used_later = std::any_of(consumers.begin(), consumers.end(), [&](const Node* consumer) {
+        return node_stages[consumer->Index()] > stage_;
+      });
+      if ((used_later || graph.IsOutput(output_def)) && added.insert(output_def).second) {
+        stage_outputs.push_back(output_def);
+      }
+    }
+  }
+
+  ORT_RETURN_IF(stage_outputs.empty(), "Pipeline stage ", stage_, " of ", num_stages_, " has no nodes. The graph has ",
+                node_topology_list.size(), " nodes.");
+
+  size_t num_removed_nodes = 0;
+  for (auto node_index : node_topology_list) {
+    if (node_stages[node_index] != stage_) {
+      graph_utils::RemoveNodeOutputEdges(graph, *graph.GetNode(node_index));
+    }
+  }
+  for (auto node_index : node_topology_list) {
+    if (node_stages[node_index] != stage_) {
+      graph.RemoveNode(node_index);
+      ++num_removed_nodes;
+    }
+  }
+
+  graph.SetInputs(stage_inputs);
+  graph.SetOutputs(stage_outputs);
+  modified = true;
+
+  LOGS(logger, INFO) << "PipelineStageExtraction kept " << node_topology_list.size() - num_removed_nodes
+                     << " nodes of " << node_topology_list.size() << " for stage " << stage_ << " of " << num_stages_
+                     << ", with " << stage_inputs.size() << " inputs and " << stage_outputs.size() << " outputs.";
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
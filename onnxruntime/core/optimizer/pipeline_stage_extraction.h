@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class PipelineStageExtraction
+
+Reduces the main graph to one stage of a pipeline parallel split, see kOrtSessionOptionsConfigPipelineNumStages.
+
+The nodes are split in topological order into `num_stages` contiguous stages of about the same cost. The cost of a
+node is the size of its constant initializers, which is the memory it needs on the device and, for the MatMul and
+Conv nodes holding most of the weights of large models, proportional to its compute. The graph keeps the nodes of
+`stage`. Its inputs are the graph inputs and the outputs of earlier stages the stage consumes, its outputs are the
+graph outputs and the values consumed by later stages it produces.
+*/
+class PipelineStageExtraction : public GraphTransformer {
+ public:
+  PipelineStageExtraction(int64_t num_stages, int64_t stage) noexcept
+      : GraphTransformer("PipelineStageExtraction"), num_stages_(num_stages), stage_(stage) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  int64_t num_stages_;
+  int64_t stage_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,302 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/qdq_transformer/qdq_matmul_bias_fusion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/qdq_transformer/qdq_util.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Returns the element type of a NodeArg, or UNDEFINED if it is not known.
+int32_t GetElementType(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr ? type->tensor_type().elem_type() : TensorProto_DataType_UNDEFINED;
+}
+
+bool HasSingleConsumer(const Graph& graph, const Node& node) {
+  return optimizer_utils::CheckOutputEdges(graph, node, 1);
+}
+
+// Reads a constant tensor with either 1 or n elements, converting integer values to float.
+bool GetConstantValues(const Graph& graph, const NodeArg& arg, size_t n, std::vector<float>& values) {
+  const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, arg.Name());
+  if (tensor_proto == nullptr) {
+    return false;
+  }
+
+  Initializer initializer(*tensor_proto, graph.ModelPath());
+  if (initializer.size() != 1 && initializer.size() != n) {
+    return false;
+  }
+
+  values.resize(initializer.size());
+  switch (initializer.data_type()) {
+    case TensorProto_DataType_FLOAT:
+      std::copy_n(initializer.data<float>(), values.size(), values.begin());
+      break;
+    case TensorProto_DataType_INT32:
+      std::transform(initializer.data<int32_t>(), initializer.data<int32_t>() + values.size(), values.begin(),
+                     [](int32_t v) { return static_cast<float>(v); });
+      break;
+    default:
+      return false;
+  }
+  return true;
+}
+
+// Reads the float bias of the Add, which is either a constant or a DQ of a constant int32 tensor.
+bool GetBias(const Graph& graph, const NodeArg& bias_arg, size_t n, int a_rank, std::vector<float>& bias) {
+  // the bias must only broadcast along the last axis, i.e. have shape (N) or (1, ..., 1, N)
+  const auto* shape = bias_arg.Shape();
+  if (shape == nullptr || shape->dim_size() < 1 || shape->dim_size() > a_rank ||
+      !utils::HasDimValue(shape->dim(shape->dim_size() - 1)) ||
+      shape->dim(shape->dim_size() - 1).dim_value() != static_cast<int64_t>(n)) {
+    return false;
+  }
+
+  const Node* dq_node = graph.GetProducerNode(bias_arg.Name());
+  if (dq_node == nullptr) {
+    return GetConstantValues(graph, bias_arg, n, bias) && bias.size() == n;
+  }
+
+  const auto& dq_inputs = dq_node->InputDefs();
+  if (!QDQ::MatchDQNode(*dq_node) ||
+      GetElementType(*dq_inputs[QDQ::INPUT_ID]) != TensorProto_DataType_INT32 ||
+      !GetConstantValues(graph, *dq_inputs[QDQ::INPUT_ID], n, bias) || bias.size() != n) {
+    return false;
+  }
+
+  std::vector<float> scale;
+  std::vector<float> zero_point(1, 0.0f);
+  if (!GetConstantValues(graph, *dq_inputs[QDQ::SCALE_ID], n, scale) ||
+      (dq_inputs.size() > QDQ::ZERO_POINT_ID && dq_inputs[QDQ::ZERO_POINT_ID]->Exists() &&
+       !GetConstantValues(graph, *dq_inputs[QDQ::ZERO_POINT_ID], n, zero_point))) {
+    return false;
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    bias[i] = (bias[i] - zero_point[zero_point.size() == 1 ? 0 : i]) * scale[scale.size() == 1 ? 0 : i];
+  }
+  return true;
+}
+
+// Checks that the weight DQ has a constant 2D (K, N) input with a per-tensor or per-column scale and zero point,
+// and returns N and the scales.
+bool GetWeightScales(const Graph& graph, const Node& dq_w, int64_t& n, std::vector<float>& w_scale) {
+  const auto& dq_inputs = dq_w.InputDefs();
+  if (dq_inputs.size() != QDQ::TOTAL_COUNT || !dq_inputs[QDQ::ZERO_POINT_ID]->Exists()) {
+    return false;
+  }
+
+  const auto* weight = graph_utils::GetConstantInitializer(graph, dq_inputs[QDQ::INPUT_ID]->Name());
+  if (weight == nullptr || weight->dims_size() != 2) {
+    return false;
+  }
+  n = weight->dims(1);
+
+  const auto* zero_point = graph_utils::GetConstantInitializer(graph, dq_inputs[QDQ::ZERO_POINT_ID]->Name());
+  if (zero_point == nullptr ||
+      !GetConstantValues(graph, *dq_inputs[QDQ::SCALE_ID], static_cast<size_t>(n), w_scale)) {
+    return false;
+  }
+
+  int64_t zero_point_size = 1;
+  for (auto dim : zero_point->dims()) {
+    zero_point_size *= dim;
+  }
+  if (static_cast<size_t>(zero_point_size) != w_scale.size()) {
+    return false;
+  }
+
+  // per-column quantization of a (K, N) weight is along axis 1
+  if (w_scale.size() != 1) {
+    const auto* axis = graph_utils::GetNodeAttribute(dq_w, "axis");
+    if (axis != nullptr && axis->i() != 1 && axis->i() != -1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+Status QDQMatMulBiasFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                      const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  const auto get_constant_initializer = [&graph](const std::string& initializer_name) {
+    return graph.GetConstantInitializer(initializer_name, true);
+  };
+
+  std::vector<std::reference_wrapper<Node>> nodes_to_remove;
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (node_ptr == nullptr)
+      continue;  // node was removed
+
+    auto& matmul_node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(matmul_node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(matmul_node, "MatMul", {1, 9, 13}) ||
+        !graph_utils::IsSupportedProvider(matmul_node, GetCompatibleExecutionProviders()) ||
+        !HasSingleConsumer(graph, matmul_node)) {
+      continue;
+    }
+
+    const Node* dq_a = graph_utils::GetInputNode(matmul_node, 0);
+    const Node* dq_w = graph_utils::GetInputNode(matmul_node, 1);
+    if (dq_a == nullptr || dq_w == nullptr || !QDQ::MatchDQNode(*dq_a) || !QDQ::MatchDQNode(*dq_w) ||
+        !QDQ::IsDQSupported(*dq_a, get_constant_initializer) ||
+        !HasSingleConsumer(graph, *dq_w)) {
+      continue;
+    }
+
+    // QGemm supports u8 x u8, u8 x s8 and s8 x s8
+    const int32_t a_type = GetElementType(*dq_a->InputDefs()[QDQ::INPUT_ID]);
+    const int32_t w_type = GetElementType(*dq_w->InputDefs()[QDQ::INPUT_ID]);
+    if (!(a_type == TensorProto_DataType_UINT8 &&
+          (w_type == TensorProto_DataType_UINT8 || w_type == TensorProto_DataType_INT8)) &&
+        !(a_type == TensorProto_DataType_INT8 && w_type == TensorProto_DataType_INT8)) {
+      continue;
+    }
+
+    const auto* a_shape = dq_a->InputDefs()[QDQ::INPUT_ID]->Shape();
+    if (a_shape == nullptr || a_shape->dim_size() < 2) {
+      continue;
+    }
+
+    int64_t n = 0;
+    std::vector<float> w_scale;
+    if (!GetWeightScales(graph, *dq_w, n, w_scale)) {
+      continue;
+    }
+
+    // optional requantization of the MatMul output
+    Node* next = graph.GetNode(matmul_node.OutputNodesBegin()->Index());
+    Node* q_mid = nullptr;
+    Node* dq_mid = nullptr;
+    if (QDQ::MatchQNode(*next)) {
+      q_mid = next;
+      if (!HasSingleConsumer(graph, *q_mid)) {
+        continue;
+      }
+      dq_mid = graph.GetNode(q_mid->OutputNodesBegin()->Index());
+      if (!QDQ::IsQDQPairSupported(*q_mid, *dq_mid, get_constant_initializer, graph.ModelPath()) ||
+          !HasSingleConsumer(graph, *dq_mid)) {
+        continue;
+      }
+      next = graph.GetNode(dq_mid->OutputNodesBegin()->Index());
+    }
+
+    Node& add_node = *next;
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(add_node, "Add", {7, 13, 14}) ||
+        add_node.GetExecutionProviderType() != matmul_node.GetExecutionProviderType() ||
+        !HasSingleConsumer(graph, add_node)) {
+      continue;
+    }
+
+    const NodeArg* chain_output = (dq_mid != nullptr ? dq_mid : &matmul_node)->OutputDefs()[0];
+    const int bias_index = add_node.InputDefs()[0] == chain_output ? 1 : 0;
+    std::vector<float> bias;
+    if (!GetBias(graph, *add_node.InputDefs()[bias_index], static_cast<size_t>(n), a_shape->dim_size(), bias)) {
+      continue;
+    }
+
+    Node& q_y = *graph.GetNode(add_node.OutputNodesBegin()->Index());
+    bool y_zero_point_exists = false;
+    if (!QDQ::MatchQNode(q_y) ||
+        !QDQ::QOrDQNodeHasConstantScalarScaleAndZeroPoint(q_y, get_constant_initializer, y_zero_point_exists) ||
+        !y_zero_point_exists ||
+        GetElementType(*q_y.InputDefs()[QDQ::ZERO_POINT_ID]) != a_type) {
+      continue;
+    }
+
+    // quantize the bias with zero point 0 and scale a_scale * w_scale
+    std::vector<float> a_scale;
+    if (!GetConstantValues(graph, *dq_a->InputDefs()[QDQ::SCALE_ID], 1, a_scale)) {
+      continue;
+    }
+
+    std::vector<int32_t> quantized_bias(bias.size());
+    bool bias_in_range = true;
+    for (size_t i = 0; i < bias.size(); ++i) {
+      const float scale = a_scale[0] * w_scale[w_scale.size() == 1 ? 0 : i];
+      const float value = std::nearbyint(bias[i] / scale);
+      if (!(std::abs(value) <= static_cast<float>(std::numeric_limits<int32_t>::max() / 2))) {
+        bias_in_range = false;
+        break;
+      }
+      quantized_bias[i] = static_cast<int32_t>(value);
+    }
+    if (!bias_in_range) {
+      continue;
+    }
+
+    TensorProto bias_initializer;
+    bias_initializer.set_name(graph.GenerateNodeArgName(add_node.Name() + "_bias_quantized"));
+    bias_initializer.set_data_type(TensorProto_DataType_INT32);
+    bias_initializer.add_dims(n);
+    bias_initializer.set_raw_data(quantized_bias.data(), quantized_bias.size() * sizeof(int32_t));
+    NodeArg& bias_arg = graph_utils::AddInitializer(graph, bias_initializer);
+
+    Node& dq_a_node = *graph.GetNode(dq_a->Index());
+    Node& dq_w_node = *graph.GetNode(dq_w->Index());
+    const auto& dq_a_inputs = dq_a_node.MutableInputDefs();
+    const auto& dq_w_inputs = dq_w_node.MutableInputDefs();
+    const auto& q_y_inputs = q_y.MutableInputDefs();
+    std::vector<NodeArg*> input_defs{
+        dq_a_inputs[QDQ::INPUT_ID], dq_a_inputs[QDQ::SCALE_ID], dq_a_inputs[QDQ::ZERO_POINT_ID],
+        dq_w_inputs[QDQ::INPUT_ID], dq_w_inputs[QDQ::SCALE_ID], dq_w_inputs[QDQ::ZERO_POINT_ID],
+        &bias_arg,
+        q_y_inputs[QDQ::SCALE_ID], q_y_inputs[QDQ::ZERO_POINT_ID]};
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName(matmul_node.Name() + "_QGemm"),
+                                     "QGemm",
+                                     "Fused MatMul and Add with QDQ",
+                                     input_defs,
+                                     q_y.MutableOutputDefs(),
+                                     nullptr,
+                                     kMSDomain);
+    fused_node.SetExecutionProviderType(matmul_node.GetExecutionProviderType());
+
+    nodes_to_remove.push_back(matmul_node);
+    if (q_mid != nullptr) {
+      nodes_to_remove.push_back(*q_mid);
+      nodes_to_remove.push_back(*dq_mid);
+    }
+    if (const Node* dq_bias = graph.GetProducerNode(add_node.InputDefs()[bias_index]->Name());
+        dq_bias != nullptr && HasSingleConsumer(graph, *dq_bias)) {
+      nodes_to_remove.push_back(*graph.GetNode(dq_bias->Index()));
+    }
+    nodes_to_remove.push_back(add_node);
+    nodes_to_remove.push_back(q_y);
+    nodes_to_remove.push_back(dq_w_node);
+    if (HasSingleConsumer(graph, dq_a_node)) {
+      nodes_to_remove.push_back(dq_a_node);
+    }
+  }
+
+  modified = modified || !nodes_to_remove.empty();
+
+  for (const auto& node : nodes_to_remove) {
+    graph_utils::RemoveNodeOutputEdges(graph, node);
+    graph.RemoveNode(node.get().Index());
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+    @Class QDQMatMulBiasFusion
+
+    Fuse the QDQ node groups of a projection with bias into a single QGemm with an int32 bias:
+
+      DQ(A), DQ(W) -> MatMul [-> Q -> DQ] -> Add(bias) -> Q
+
+    W must be a constant 2D weight quantized per-tensor or per-column, and the bias a constant float tensor
+    or a DQ of a constant int32 tensor. The bias is requantized to a_scale * w_scale so that the matrix product
+    and the bias are accumulated in int32 and quantized once, which drops the intermediate requantization
+    that the QDQ node unit fusions would leave between a QLinearMatMul and a QLinearAdd.
+
+    A may have any rank of 2 or more, e.g. the (batch, sequence, hidden) activations of a transformer block.
+
+    This must run before the QDQSelectorActionTransformer, which would otherwise fuse the MatMul and the Add
+    separately.
+    */
+class QDQMatMulBiasFusion : public GraphTransformer {
+ public:
+  QDQMatMulBiasFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("QDQMatMulBiasFusion", compatible_execution_providers) {
+  }
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -5,6 +5,12 @@
 
 #include "core/optimizer/qdq_transformer/qdq_util.h"
 #include "core/graph/node_attr_utils.h"
+#if !defined(ORT_MINIMAL_BUILD)
+#include "core/common/narrow.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 namespace onnxruntime {
 namespace QDQ {
 
@@ -335,5 +341,88 @@ Status GemmReplaceWithQuant::RunForSave(Graph& graph,
 }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+#if !defined(ORT_MINIMAL_BUILD)
+Status MatMulReplaceWithGemmFloat8::Run(Graph& graph, const NodesToOptimize& selected_nodes) const {
+  // GemmFloat8 computes A * B' for fp8 inputs, transpose the constant B from [K, N] to [N, K]
+  Node& dq_b = *selected_nodes.Input(1);
+  const auto* b = graph_utils::GetConstantInitializer(graph, dq_b.InputDefs()[0]->Name());
+  ORT_RETURN_IF(b == nullptr || b->dims_size() != 2, "Expected a 2D constant initializer for the B input of MatMul.");
+
+  Initializer b_init{*b, graph.ModelPath()};
+  const auto b_bytes = b_init.DataAsByteSpan();
+  const auto K = narrow<size_t>(b->dims(0));
+  const auto N = narrow<size_t>(b->dims(1));
+  ORT_RETURN_IF(b_bytes.size() != K * N, "Expected 1 byte elements for the B input of MatMul.");
+
+  std::string b_transposed_data(b_bytes.size(), '\0');
+  for (size_t k = 0; k < K; ++k) {
+    for (size_t n = 0; n < N; ++n) {
+      b_transposed_data[n * K + k] = static_cast<char>(b_bytes[k * N + n]);
+    }
+  }
+
+  ONNX_NAMESPACE::TensorProto b_transposed;
+  b_transposed.set_name(graph.GenerateNodeArgName(b->name() + "_transposed"));
+  b_transposed.set_data_type(b->data_type());
+  b_transposed.add_dims(b->dims(1));
+  b_transposed.add_dims(b->dims(0));
+  b_transposed.set_raw_data(std::move(b_transposed_data));
+  graph_utils::ReplaceNodeInput(dq_b, 0, graph_utils::AddInitializer(graph, b_transposed));
+
+  if (selected_nodes.num_outputs > 0) {
+    Node& q = *selected_nodes.Output(0);
+    const auto* y_scale = graph_utils::GetConstantInitializer(graph, q.InputDefs()[1]->Name());
+    ORT_RETURN_IF(y_scale == nullptr, "Expected a constant scale for QuantizeLinear.");
+
+    Initializer y_scale_init{*y_scale, graph.ModelPath()};
+    ONNX_NAMESPACE::TensorProto y_scale_reciprocal;
+    y_scale_reciprocal.set_name(graph.GenerateNodeArgName(y_scale->name() + "_reciprocal"));
+    y_scale_reciprocal.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    y_scale_reciprocal.mutable_dims()->CopyFrom(y_scale->dims());
+    y_scale_reciprocal.add_float_data(1.0f / *y_scale_init.data<float>());
+    graph_utils::ReplaceNodeInput(q, 1, graph_utils::AddInitializer(graph, y_scale_reciprocal));
+  }
+
+  return ReplaceWithNew::Run(graph, selected_nodes);
+}
+
+NodeAttributes MatMulReplaceWithGemmFloat8::ExtraAttributes(const RuntimeState& state) const {
+  int64_t dtype = ONNX_NAMESPACE::TensorProto_DataType_FLOAT;
+  if (state.selected_nodes.num_outputs > 0) {
+    dtype = state.selected_nodes.Output(0)->OutputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  }
+
+  NodeAttributes attr;
+  attr["transA"] = utils::MakeAttribute(std::string("transA"), int64_t{0});
+  attr["transB"] = utils::MakeAttribute(std::string("transB"), int64_t{1});
+  attr["dtype"] = utils::MakeAttribute(std::string("dtype"), dtype);
+  return attr;
+}
+
+std::vector<NodeAndMoveInfo> MatMulReplaceWithGemmFloat8::ValueMoves(const RuntimeState& state) const {
+  NTO::NodeLocation dq_a{NTO::NodeType::kInput, 0};
+  NTO::NodeLocation dq_b{NTO::NodeType::kInput, 1};
+  NTO::NodeLocation dq_c{NTO::NodeType::kInput, 2};
+  NTO::NodeLocation target{NTO::NodeType::kTarget, 0};
+  NTO::NodeLocation q{NTO::NodeType::kOutput, 0};
+
+  std::vector<NodeAndMoveInfo> moves{
+      MoveAndAppend(dq_a, ArgType::kInput, 0, ArgType::kInput),              // A
+      MoveAndAppend(dq_b, ArgType::kInput, 0, ArgType::kInput),              // transposed B
+      MoveAndAppend(dq_c, ArgType::kInput, 0, ArgType::kInput, true, true),  // empty C
+      MoveAndAppend(dq_a, ArgType::kInput, 1, ArgType::kInput),              // scale of A
+      MoveAndAppend(dq_b, ArgType::kInput, 1, ArgType::kInput)};             // scale of B
+
+  if (state.selected_nodes.num_outputs > 0) {
+    moves.push_back(MoveAndAppend(q, ArgType::kInput, 1, ArgType::kInput));  // reciprocal of the scale of Q
+    moves.push_back(MoveAll(q, ArgType::kOutput));
+  } else {
+    moves.push_back(MoveAll(target, ArgType::kOutput));
+  }
+
+  return moves;
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 }  // namespace QDQ
 }  // namespace onnxruntime
@@ -96,5 +96,20 @@ struct GemmReplaceWithQuant : public Action {
   QDQReplaceWithNew qgemm_with_8bits_as_output_replacer_;
 };
 
+#if !defined(ORT_MINIMAL_BUILD)
+// replace DQ(fp8 A) + DQ(fp8 constant B) -> MatMul -> optional Q(fp8) with GemmFloat8.
+// B is transposed to the column major layout cuBLASLt requires for fp8 and the scale of Q is inverted, as the scale of
+// the output of GemmFloat8 multiplies the result.
+struct MatMulReplaceWithGemmFloat8 : public ReplaceWithNew {
+  Status Run(Graph&, const NodesToOptimize& selected_nodes) const override;
+
+ private:
+  std::string OpType(const RuntimeState&) const override { return "GemmFloat8"; }
+  std::string Domain(const RuntimeState&) const override { return kMSDomain; }
+  NodeAttributes ExtraAttributes(const RuntimeState& state) const override;
+  std::vector<NodeAndMoveInfo> ValueMoves(const RuntimeState& state) const override;
+};
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 }  // namespace QDQ
 }  // namespace onnxruntime
@@ -287,6 +287,31 @@ SelectorActionRegistry CreateSelectorActionRegistry(bool is_int8_allowed) {
   return qdq_selector_action_registry;
 }
 
+#if !defined(ORT_MINIMAL_BUILD)
+void MatMulFloat8QDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 4 or 5 nodes. 0=DQ A, 1=DQ B, 2=MatMul, 3=Q Y(optional)
+  // Replace with GemmFloat8
+  // Delete all original nodes.
+  const std::string action_name{"MatMulFloat8"};
+
+  std::unique_ptr<Action> action = std::make_unique<QDQ::MatMulReplaceWithGemmFloat8>();
+
+  std::vector<const char*> providers = {kCudaExecutionProvider};
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::MatMulFloat8Selector>(providers);
+  qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
+                                                         {{"MatMul", {}}},
+                                                         std::move(selector),
+                                                         std::move(action));
+}
+
+SelectorActionRegistry CreateFloat8SelectorActionRegistry() {
+  SelectorActionRegistry qdq_selector_action_registry;
+  MatMulFloat8QDQRules(qdq_selector_action_registry);
+
+  return qdq_selector_action_registry;
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 }  // namespace
 
 QDQSelectorActionTransformer::QDQSelectorActionTransformer(
@@ -299,4 +324,15 @@ QDQSelectorActionTransformer::QDQSelectorActionTransformer(
           {kCpuExecutionProvider, kDmlExecutionProvider}} {
 }
 
+#if !defined(ORT_MINIMAL_BUILD)
+QDQFloat8SelectorActionTransformer::QDQFloat8SelectorActionTransformer()
+    : SelectorActionTransformer{
+          "QDQFloat8SelectorActionTransformer",
+          CreateFloat8SelectorActionRegistry(),
+          SatApplyContextVariant{},
+          // GemmFloat8 is only implemented by the CUDA EP
+          {kCudaExecutionProvider}} {
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 }  // namespace onnxruntime
@@ -24,4 +24,14 @@ class QDQSelectorActionTransformer : public SelectorActionTransformer {
   QDQSelectorActionTransformer(bool is_int8_allowed, const SatApplyContextVariant& apply_context = {});
 };
 
+#if !defined(ORT_MINIMAL_BUILD)
+/**
+Transformer that fuses fp8 QDQ MatMul node groups into GemmFloat8 for the CUDA EP.
+*/
+class QDQFloat8SelectorActionTransformer : public SelectorActionTransformer {
+ public:
+  QDQFloat8SelectorActionTransformer();
+};
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 }  // namespace onnxruntime
@@ -465,6 +465,68 @@ void GemmSelector::UpdateBuilder(NodesToOptimizeIndicesBuilder& builder) const {
   builder.input_nodes.resize(3, NodesToOptimizeIndices::kEmptyNodeIndex);
 }
 
+bool MatMulFloat8NodeGroupSelector::Check(const GraphViewer& graph_viewer,
+                                          const Node& node,
+                                          const std::vector<const Node*>& dq_nodes,
+                                          const std::vector<const Node*>& q_nodes) const {
+#if defined(DISABLE_FLOAT8_TYPES)
+  ORT_UNUSED_PARAMETER(graph_viewer);
+  ORT_UNUSED_PARAMETER(node);
+  ORT_UNUSED_PARAMETER(dq_nodes);
+  ORT_UNUSED_PARAMETER(q_nodes);
+  return false;
+#else
+  if (!CheckQDQNodes(graph_viewer, node, dq_nodes, q_nodes, 2, true /*is_empty_q_nodes_allowed*/)) {
+    return false;
+  }
+
+  auto is_float8 = [](int32_t data_type) {
+    return data_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E4M3FN ||
+           data_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E5M2;
+  };
+  auto get_const_initializer = [&graph_viewer](const std::string& initializer_name) {
+    return graph_viewer.GetConstantInitializer(initializer_name, true);
+  };
+  // the float 8 GEMM takes per tensor float scales, the zero points of float 8 types are always 0
+  auto has_float_scalar_scale = [&](const Node& q_or_dq_node) {
+    bool zero_point_exists = false;
+    return QOrDQNodeHasConstantScalarScaleAndZeroPoint(q_or_dq_node, get_const_initializer, zero_point_exists) &&
+           q_or_dq_node.InputDefs()[1]->TypeAsProto()->tensor_type().elem_type() ==
+               ONNX_NAMESPACE::TensorProto_DataType_FLOAT;
+  };
+
+  const int32_t dt_A = dq_nodes[0]->InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  const int32_t dt_B = dq_nodes[1]->InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  // cuBLASLt has no E5M2 x E5M2 kernels
+  if (!is_float8(dt_A) || !is_float8(dt_B) ||
+      (dt_A == ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E5M2 &&
+       dt_B == ONNX_NAMESPACE::TensorProto_DataType_FLOAT8E5M2) ||
+      !has_float_scalar_scale(*dq_nodes[0]) || !has_float_scalar_scale(*dq_nodes[1])) {
+    return false;
+  }
+
+  // GemmFloat8 is a 2D GEMM, and the constant B is transposed to the [N, K] layout the float 8 kernels require.
+  // These also need K and N to be multiples of 16.
+  const auto* a_shape = dq_nodes[0]->InputDefs()[0]->Shape();
+  const auto* b = get_const_initializer(dq_nodes[1]->InputDefs()[0]->Name());
+  if (a_shape == nullptr || a_shape->dim_size() != 2 || b == nullptr || b->dims_size() != 2 ||
+      b->dims(0) % 16 != 0 || b->dims(1) % 16 != 0) {
+    return false;
+  }
+
+  if (q_nodes.empty()) {
+    return true;
+  }
+
+  return is_float8(q_nodes[0]->OutputDefs()[0]->TypeAsProto()->tensor_type().elem_type()) &&
+         has_float_scalar_scale(*q_nodes[0]);
+#endif  // defined(DISABLE_FLOAT8_TYPES)
+}
+
+void MatMulFloat8Selector::UpdateBuilder(NodesToOptimizeIndicesBuilder& builder) const {
+  builder.input_nodes.resize(3, NodesToOptimizeIndices::kEmptyNodeIndex);
+}
+
 bool WhereNodeGroupSelector::Check(const GraphViewer& graph_viewer, const Node& node,
                                    const std::vector<const Node*>& dq_nodes,
                                    const std::vector<const Node*>& q_nodes) const {
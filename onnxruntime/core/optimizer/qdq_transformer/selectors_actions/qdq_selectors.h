@@ -220,6 +220,15 @@ class GemmNodeGroupSelector : public NodeGroupSelector {
   bool allow_4bit_;
 };
 
+// Input: DQ nodes for A and B with float 8 data and per tensor float scales. B is a 2D constant.
+// Output: optional Q node for Y with float 8 data
+class MatMulFloat8NodeGroupSelector : public NodeGroupSelector {
+ private:
+  bool Check(const GraphViewer& graph_viewer, const Node& node,
+             const std::vector<const Node*>& dq_nodes,
+             const std::vector<const Node*>& q_nodes) const override;
+};
+
 // Input: DQ nodes for input, scale, and B
 // Output: Q node for output
 class InstanceAndLayerNormalizationNodeGroupSelector : public NodeGroupSelector {
@@ -369,6 +378,17 @@ class GemmSelector : public BaseSelector {
   void UpdateBuilder(NodesToOptimizeIndicesBuilder&) const override;
 };
 
+// Input: DQ nodes for A and B with float 8 data
+// Output: optional Q node for Y
+class MatMulFloat8Selector : public BaseSelector {
+ public:
+  explicit MatMulFloat8Selector(gsl::span<const char*> compatible_providers = {})
+      : BaseSelector(std::make_unique<MatMulFloat8NodeGroupSelector>(), compatible_providers) {}
+
+  // adds the missing DQ node for the C input of GemmFloat8
+  void UpdateBuilder(NodesToOptimizeIndicesBuilder&) const override;
+};
+
 }  // namespace QDQ
 }  // namespace onnxruntime
 
@@ -39,49 +39,116 @@ Status RuleBasedGraphTransformer::ApplyRulesOnNode(Graph& graph, Node& node,
   return Status::OK();
 }
 
-Status RuleBasedGraphTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
-  GraphViewer graph_viewer(graph);
-  auto& order = graph_viewer.GetNodesInTopologicalOrder();
-
-  for (NodeIndex i : order) {
-    auto* node = graph.GetNode(i);
-    // A node might not be found as it might have already been deleted from one of the rules.
-    if (!node) {
-      continue;
+Status RuleBasedGraphTransformer::ApplyAllRulesOnNode(Graph& graph, Node& node, RuleEffect& rule_effect,
+                                                      const logging::Logger& logger) const {
+  // First apply rewrite rules that are registered for the op type of the current node; then apply rules that are
+  // registered to be applied regardless of the op type.
+  // Stop further rule application for the current node, if the node gets removed by a rule.
+  const InlinedVector<std::reference_wrapper<const RewriteRule>>* rules = GetRewriteRulesForOpType(node.OpType());
+  if (rules) {
+    ORT_RETURN_IF_ERROR(ApplyRulesOnNode(graph, node, *rules, rule_effect, logger));
+  }
+
+  if (rule_effect != RuleEffect::kRemovedCurrentNode) {
+    rules = GetAnyOpRewriteRules();
+    if (rules) {
+      ORT_RETURN_IF_ERROR(ApplyRulesOnNode(graph, node, *rules, rule_effect, logger));
     }
+  }
 
-    // Initialize the effect of rules on this node to denote that the graph has not yet been modified
-    // by the rule application on the current node.
-    auto rule_effect = RuleEffect::kNone;
+  return Status::OK();
+}
 
-    if (!graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders())) {
-      continue;
+Status RuleBasedGraphTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  // Maximum number of rounds of revisits of the dirty nodes after the traversal of the graph.
+  // Bounds the work if rules keep reporting modifications of the same nodes.
+  constexpr int kMaxRevisitRounds = 10;
+
+  // Nodes next to a rewrite are dirty: rules may now apply to them although they didn't when they were visited.
+  // Dirty nodes are revisited after the top-down traversal until no rule applies, instead of traversing the whole
+  // graph again.
+  InlinedHashSet<NodeIndex> dirty;
+  InlinedVector<NodeIndex> worklist;
+  auto mark_dirty = [&dirty, &worklist](NodeIndex index) {
+    if (dirty.insert(index).second) {
+      worklist.push_back(index);
     }
+  };
 
-    // First apply rewrite rules that are registered for the op type of the current node; then apply rules that are
-    // registered to be applied regardless of the op type; then recursively apply rules to subgraphs (if any).
-    // Stop further rule application for the current node, if the node gets removed by a rule.
-    const InlinedVector<std::reference_wrapper<const RewriteRule>>* rules = nullptr;
+  InlinedVector<NodeIndex> neighbors;
+  auto visit = [&](Node& node, bool recurse) -> Status {
+    dirty.erase(node.Index());
 
-    rules = GetRewriteRulesForOpType(node->OpType());
-    if (rules) {
-      ORT_RETURN_IF_ERROR(ApplyRulesOnNode(graph, *node, *rules, rule_effect, logger));
+    if (!graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      return Status::OK();
     }
 
-    if (rule_effect != RuleEffect::kRemovedCurrentNode) {
-      rules = GetAnyOpRewriteRules();
-      if (rules) {
-        ORT_RETURN_IF_ERROR(ApplyRulesOnNode(graph, *node, *rules, rule_effect, logger));
-      }
+    // Capture the neighbors before applying the rules as the node may get removed.
+    neighbors.clear();
+    for (auto it = node.InputNodesBegin(), end = node.InputNodesEnd(); it != end; ++it) {
+      neighbors.push_back(it->Index());
     }
+    for (auto it = node.OutputNodesBegin(), end = node.OutputNodesEnd(); it != end; ++it) {
+      neighbors.push_back(it->Index());
+    }
+    const NodeIndex first_new_node = static_cast<NodeIndex>(graph.MaxNodeIndex());
+
+    // Initialize the effect of rules on this node to denote that the graph has not yet been modified
+    // by the rule application on the current node.
+    auto rule_effect = RuleEffect::kNone;
+    ORT_RETURN_IF_ERROR(ApplyAllRulesOnNode(graph, node, rule_effect, logger));
 
     // Update the modified field of the rule-based transformer.
     if (rule_effect != RuleEffect::kNone) {
       modified = true;
+
+      for (NodeIndex neighbor : neighbors) {
+        mark_dirty(neighbor);
+      }
+      for (NodeIndex index = first_new_node, end = static_cast<NodeIndex>(graph.MaxNodeIndex()); index < end;
+           ++index) {
+        mark_dirty(index);
+      }
+      if (rule_effect != RuleEffect::kRemovedCurrentNode) {
+        mark_dirty(node.Index());
+      }
     }
 
-    if (rule_effect != RuleEffect::kRemovedCurrentNode) {
-      ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+    if (recurse && rule_effect != RuleEffect::kRemovedCurrentNode) {
+      ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+    }
+
+    return Status::OK();
+  };
+
+  {
+    GraphViewer graph_viewer(graph);
+    auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+    for (NodeIndex i : order) {
+      auto* node = graph.GetNode(i);
+      // A node might not be found as it might have already been deleted from one of the rules.
+      if (!node) {
+        continue;
+      }
+
+      ORT_RETURN_IF_ERROR(visit(*node, /*recurse*/ true));
+    }
+  }
+
+  InlinedVector<NodeIndex> round;
+  for (int round_index = 0; round_index < kMaxRevisitRounds && !worklist.empty(); ++round_index) {
+    round.clear();
+    std::swap(round, worklist);
+
+    for (NodeIndex i : round) {
+      // Skip nodes that were removed, or visited again since they were marked dirty.
+      auto* node = graph.GetNode(i);
+      if (!node || dirty.count(i) == 0) {
+        continue;
+      }
+
+      ORT_RETURN_IF_ERROR(visit(*node, /*recurse*/ false));
     }
   }
 
@@ -0,0 +1,374 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/shape_subgraph_folding.h"
+
+#include <algorithm>
+#include <optional>
+#include <string>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Larger int64 tensors are not shape computations.
+constexpr size_t kMaxShapeValueSize = 64;
+
+// A dimension in a shape computation. It is either a known value or a symbolic dimension, which is identified by
+// its dim_param, or by the tensor and axis it came from if shape inference did not name it.
+struct ShapeDim {
+  int64_t value{0};
+  std::string symbol;
+
+  bool IsKnown() const { return symbol.empty(); }
+};
+
+struct ShapeValue {
+  InlinedVector<ShapeDim> dims;
+  bool is_scalar{false};
+
+  bool IsKnown() const {
+    return std::all_of(dims.begin(), dims.end(), [](const ShapeDim& dim) { return dim.IsKnown(); });
+  }
+};
+
+using ShapeValueMap = InlinedHashMap<const NodeArg*, ShapeValue>;
+
+ShapeDim GetShapeDim(const NodeArg& arg, const TensorShapeProto& shape, int axis) {
+  const auto& dim = shape.dim(axis);
+  if (utils::HasDimValue(dim)) {
+    return {dim.dim_value(), {}};
+  }
+  if (utils::HasDimParam(dim)) {
+    return {0, dim.dim_param()};
+  }
+  return {0, arg.Name() + ":" + std::to_string(axis)};
+}
+
+// Reads a small constant int64 or int32 tensor of rank 0 or 1.
+std::optional<InlinedVector<int64_t>> GetConstantValues(const Graph& graph, const NodeArg* arg) {
+  if (arg == nullptr || !arg->Exists()) {
+    return std::nullopt;
+  }
+  const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, arg->Name());
+  if (tensor_proto == nullptr || tensor_proto->dims_size() > 1 ||
+      (tensor_proto->data_type() != TensorProto_DataType_INT64 &&
+       tensor_proto->data_type() != TensorProto_DataType_INT32)) {
+    return std::nullopt;
+  }
+
+  Initializer initializer(*tensor_proto, graph.ModelPath());
+  if (initializer.size() > kMaxShapeValueSize) {
+    return std::nullopt;
+  }
+  InlinedVector<int64_t> values(initializer.size());
+  if (initializer.data_type() == TensorProto_DataType_INT64) {
+    std::copy_n(initializer.data<int64_t>(), values.size(), values.begin());
+  } else {
+    std::copy_n(initializer.data<int32_t>(), values.size(), values.begin());
+  }
+  return values;
+}
+
+std::optional<ShapeValue> GetShapeValue(const Graph& graph, const ShapeValueMap& values, const NodeArg* arg) {
+  auto it = values.find(arg);
+  if (it != values.end()) {
+    return it->second;
+  }
+
+  const auto* type = arg->TypeAsProto();
+  if (type == nullptr || type->tensor_type().elem_type() != TensorProto_DataType_INT64) {
+    return std::nullopt;
+  }
+  auto constant = GetConstantValues(graph, arg);
+  if (!constant.has_value()) {
+    return std::nullopt;
+  }
+
+  ShapeValue value;
+  value.is_scalar = graph_utils::GetConstantInitializer(graph, arg->Name())->dims_size() == 0;
+  for (int64_t v : *constant) {
+    value.dims.push_back({v, {}});
+  }
+  return value;
+}
+
+// Returns the axes of an Unsqueeze or Squeeze node, from the attribute before opset 13 and the input after.
+std::optional<InlinedVector<int64_t>> GetAxes(const Graph& graph, const Node& node) {
+  if (node.SinceVersion() < 13) {
+    const auto* axes_attr = graph_utils::GetNodeAttribute(node, "axes");
+    if (axes_attr == nullptr) {
+      return InlinedVector<int64_t>{};
+    }
+    return InlinedVector<int64_t>(axes_attr->ints().begin(), axes_attr->ints().end());
+  }
+  if (node.InputDefs().size() < 2 || !node.InputDefs()[1]->Exists()) {
+    return InlinedVector<int64_t>{};
+  }
+  return GetConstantValues(graph, node.InputDefs()[1]);
+}
+
+int64_t GetIntAttribute(const Node& node, const std::string& name, int64_t default_value) {
+  const auto* attr = graph_utils::GetNodeAttribute(node, name);
+  return attr != nullptr && utils::HasInt(*attr) ? attr->i() : default_value;
+}
+
+// Evaluates the output of a shape computation node from the values of its inputs.
+std::optional<ShapeValue> EvaluateNode(const Graph& graph, const ShapeValueMap& values, const Node& node) {
+  const auto& inputs = node.InputDefs();
+  if (inputs.empty() || !inputs[0]->Exists()) {
+    return std::nullopt;
+  }
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Shape", {1, 13, 15, 19, 21})) {
+    const auto* shape = inputs[0]->Shape();
+    if (shape == nullptr) {
+      return std::nullopt;
+    }
+    const int64_t rank = shape->dim_size();
+    int64_t start = GetIntAttribute(node, "start", 0);
+    int64_t end = GetIntAttribute(node, "end", rank);
+    start = std::clamp(start < 0 ? start + rank : start, int64_t{0}, rank);
+    end = std::clamp(end < 0 ? end + rank : end, int64_t{0}, rank);
+
+    ShapeValue value;
+    for (int64_t axis = start; axis < end; ++axis) {
+      value.dims.push_back(GetShapeDim(*inputs[0], *shape, static_cast<int>(axis)));
+    }
+    return value;
+  }
+
+  auto input = GetShapeValue(graph, values, inputs[0]);
+  if (!input.has_value()) {
+    return std::nullopt;
+  }
+  const int64_t size = static_cast<int64_t>(input->dims.size());
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Identity", {1, 13, 14, 16, 19, 21}) ||
+      (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Cast", {6, 9, 13, 19, 21}) &&
+       GetIntAttribute(node, "to", 0) == TensorProto_DataType_INT64)) {
+    return input;
+  }
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gather", {1, 11, 13})) {
+    auto indices = GetConstantValues(graph, inputs[1]);
+    if (input->is_scalar || GetIntAttribute(node, "axis", 0) != 0 || !indices.has_value()) {
+      return std::nullopt;
+    }
+    ShapeValue value;
+    value.is_scalar = graph_utils::GetConstantInitializer(graph, inputs[1]->Name())->dims_size() == 0;
+    for (int64_t index : *indices) {
+      index = index < 0 ? index + size : index;
+      if (index < 0 || index >= size) {
+        return std::nullopt;
+      }
+      value.dims.push_back(input->dims[static_cast<size_t>(index)]);
+    }
+    return value;
+  }
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Unsqueeze", {1, 11, 13, 21})) {
+    auto axes = GetAxes(graph, node);
+    if (!input->is_scalar || !axes.has_value() || axes->size() != 1 || ((*axes)[0] != 0 && (*axes)[0] != -1)) {
+      return std::nullopt;
+    }
+    input->is_scalar = false;
+    return input;
+  }
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Squeeze", {1, 11, 13, 21})) {
+    auto axes = GetAxes(graph, node);
+    if (input->is_scalar || size != 1 || !axes.has_value() ||
+        (!axes->empty() && (axes->size() != 1 || ((*axes)[0] != 0 && (*axes)[0] != -1)))) {
+      return std::nullopt;
+    }
+    input->is_scalar = true;
+    return input;
+  }
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Concat", {4, 11, 13})) {
+    const int64_t axis = GetIntAttribute(node, "axis", 0);
+    if (axis != 0 && axis != -1) {
+      return std::nullopt;
+    }
+    ShapeValue value;
+    for (const auto* concat_input : inputs) {
+      auto concat_value = GetShapeValue(graph, values, concat_input);
+      if (!concat_value.has_value() || concat_value->is_scalar) {
+        return std::nullopt;
+      }
+      value.dims.insert(value.dims.end(), concat_value->dims.begin(), concat_value->dims.end());
+    }
+    return value;
+  }
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Slice", {10, 11, 13})) {
+    auto starts = GetConstantValues(graph, inputs[1]);
+    auto ends = GetConstantValues(graph, inputs.size() > 2 ? inputs[2] : nullptr);
+    if (input->is_scalar || !starts.has_value() || !ends.has_value() || starts->size() != 1 || ends->size() != 1) {
+      return std::nullopt;
+    }
+    if (inputs.size() > 3 && inputs[3]->Exists()) {
+      auto axes = GetConstantValues(graph, inputs[3]);
+      if (!axes.has_value() || axes->size() != 1 || ((*axes)[0] != 0 && (*axes)[0] != -1)) {
+        return std::nullopt;
+      }
+    }
+    if (inputs.size() > 4 && inputs[4]->Exists()) {
+      auto steps = GetConstantValues(graph, inputs[4]);
+      if (!steps.has_value() || steps->size() != 1 || (*steps)[0] != 1) {
+        return std::nullopt;
+      }
+    }
+    int64_t start = (*starts)[0];
+    int64_t end = (*ends)[0];
+    start = std::clamp(start < 0 ? start + size : start, int64_t{0}, size);
+    end = std::clamp(end < 0 ? end + size : end, int64_t{0}, size);
+
+    ShapeValue value;
+    for (int64_t i = start; i < end; ++i) {
+      value.dims.push_back(input->dims[static_cast<size_t>(i)]);
+    }
+    return value;
+  }
+
+  return std::nullopt;
+}
+
+bool IsShapeComputationNode(const Node& node) {
+  static const InlinedHashSet<std::string_view> op_types = {"Shape", "Identity", "Cast", "Gather", "Unsqueeze",
+                                                            "Squeeze", "Concat", "Slice"};
+  return node.Domain() == kOnnxDomain && op_types.count(node.OpType()) != 0;
+}
+
+// Replaces the shape input of a Reshape with a constant, using 0 for the dimensions copied from the Reshape input and
+// -1 for a single other symbolic dimension.
+bool FoldReshapeShape(Graph& graph, Node& reshape, const ShapeValue& shape_value) {
+  if (GetIntAttribute(reshape, "allowzero", 0) != 0 || shape_value.is_scalar) {
+    return false;
+  }
+  const auto* data_shape = reshape.InputDefs()[0]->Shape();
+  if (data_shape == nullptr) {
+    return false;
+  }
+
+  InlinedVector<int64_t> new_shape;
+  bool has_unknown_dim = std::any_of(shape_value.dims.begin(), shape_value.dims.end(),
+                                     [](const ShapeDim& dim) { return dim.IsKnown() && dim.value == -1; });
+  for (size_t i = 0; i < shape_value.dims.size(); ++i) {
+    const auto& dim = shape_value.dims[i];
+    if (dim.IsKnown()) {
+      new_shape.push_back(dim.value);
+    } else if (static_cast<int>(i) < data_shape->dim_size() &&
+               GetShapeDim(*reshape.InputDefs()[0], *data_shape, static_cast<int>(i)).symbol == dim.symbol) {
+      new_shape.push_back(0);
+    } else if (!has_unknown_dim) {
+      new_shape.push_back(-1);
+      has_unknown_dim = true;
+    } else {
+      return false;
+    }
+  }
+
+  TensorProto shape_initializer;
+  shape_initializer.set_name(graph.GenerateNodeArgName(reshape.Name() + "_shape"));
+  shape_initializer.set_data_type(TensorProto_DataType_INT64);
+  shape_initializer.add_dims(static_cast<int64_t>(new_shape.size()));
+  shape_initializer.set_raw_data(new_shape.data(), new_shape.size() * sizeof(int64_t));
+  NodeArg& shape_arg = graph_utils::AddInitializer(graph, shape_initializer);
+
+  if (const auto* input_edge = graph_utils::GetInputEdge(reshape, 1); input_edge != nullptr) {
+    graph.RemoveEdge(input_edge->GetNode().Index(), reshape.Index(), input_edge->GetSrcArgIndex(), 1);
+  }
+  graph_utils::ReplaceNodeInput(reshape, 1, shape_arg);
+  return true;
+}
+
+}  // namespace
+
+Status ShapeSubgraphFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                       const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  ShapeValueMap values;
+  bool removed_uses = false;
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (node_ptr == nullptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Reshape", {5, 13, 14, 19, 21})) {
+      const auto* shape_arg = node.InputDefs()[1];
+      auto it = values.find(shape_arg);
+      if (it != values.end() && !it->second.IsKnown() && FoldReshapeShape(graph, node, it->second)) {
+        modified = true;
+        removed_uses = true;
+      }
+      continue;
+    }
+
+    if (!IsShapeComputationNode(node) || node.OutputDefs().size() != 1) {
+      continue;
+    }
+    auto value = EvaluateNode(graph, values, node);
+    if (!value.has_value() || value->dims.size() > kMaxShapeValueSize) {
+      continue;
+    }
+
+    const auto* output_arg = node.OutputDefs()[0];
+    values[output_arg] = *value;
+
+    if (value->IsKnown() && graph_utils::CanReplaceNodeWithInitializer(graph, node, output_arg->Name(), logger)) {
+      InlinedVector<int64_t> data;
+      for (const auto& dim : value->dims) {
+        data.push_back(dim.value);
+      }
+      TensorProto constant;
+      constant.set_name(graph.GenerateNodeArgName(output_arg->Name()));
+      constant.set_data_type(TensorProto_DataType_INT64);
+      if (!value->is_scalar) {
+        constant.add_dims(static_cast<int64_t>(data.size()));
+      }
+      constant.set_raw_data(data.data(), data.size() * sizeof(int64_t));
+
+      LOGS(logger, VERBOSE) << "Folded symbolic shape computation " << node.OpType() << " node '" << node.Name()
+                            << "'";
+      NodeArg& constant_arg = graph_utils::AddInitializer(graph, constant);
+      values[&constant_arg] = *value;
+      if (graph_utils::ReplaceNodeWithInitializer(graph, node, constant_arg)) {
+        modified = true;
+        removed_uses = true;
+      }
+    }
+  }
+
+  // Remove the shape computations that are no longer used.
+  if (removed_uses) {
+    for (auto it = node_topology_list.rbegin(); it != node_topology_list.rend(); ++it) {
+      auto* node = graph.GetNode(*it);
+      if (node != nullptr && IsShapeComputationNode(*node) && node->GetOutputEdgesCount() == 0 &&
+          !graph.NodeProducesGraphOutput(*node) &&
+          graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders())) {
+        graph.RemoveNode(node->Index());
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
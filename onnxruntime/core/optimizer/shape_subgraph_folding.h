@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ShapeSubgraphFolding
+
+Symbolically evaluates the shape computations of a graph, i.e. the int64 values produced by
+Shape -> Gather/Slice -> Unsqueeze/Squeeze -> Concat chains, using the symbolic dimensions from shape inference.
+
+- Values that turn out to be constant are replaced with initializers, even if the input of the Shape node has
+  symbolic dimensions, e.g. Shape(x)[1:] of a (batch, 12, 64) tensor.
+- The shape input of a Reshape is replaced with a constant if every symbolic dimension in it is either the
+  dimension of the Reshape input at the same position (0) or the only unknown dimension (-1), e.g.
+  Reshape(x, Concat(Shape(x)[0], Shape(x)[1], 12, 64)) becomes Reshape(x, [0, 0, 12, 64]).
+
+Shape computation nodes that are no longer used afterwards are removed.
+*/
+class ShapeSubgraphFolding : public GraphTransformer {
+ public:
+  ShapeSubgraphFolding(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ShapeSubgraphFolding", compatible_execution_providers) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,229 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/smooth_quant.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <optional>
+
+#include "core/common/narrow.h"
+#include "core/common/parse_string.h"
+#include "core/common/string_utils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Input indices of the scale and the shift of a normalization node, -1 if it has no such input.
+struct NormalizationInputs {
+  int gamma_index;
+  int beta_index;
+};
+
+std::optional<NormalizationInputs> GetNormalizationInputs(const Node& node) {
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "LayerNormalization", {1, 17}, kOnnxDomain)) {
+    return NormalizationInputs{1, 2};
+  }
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "SimplifiedLayerNormalization", {1}, kOnnxDomain)) {
+    return NormalizationInputs{1, -1};
+  }
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "SkipLayerNormalization", {1}, kMSDomain)) {
+    return NormalizationInputs{2, 3};
+  }
+  // the optional input 3 of SkipSimplifiedLayerNormalization is added before the normalization
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "SkipSimplifiedLayerNormalization", {1}, kMSDomain)) {
+    return NormalizationInputs{2, -1};
+  }
+  return std::nullopt;
+}
+
+// Returns the constant float initializer that is input `index` of `node` if it has the expected rank, nullptr otherwise.
+const TensorProto* GetFloatConstantInput(const Graph& graph, const Node& node, int index, int rank) {
+  const auto& input_defs = node.InputDefs();
+  if (index < 0 || static_cast<size_t>(index) >= input_defs.size() || !input_defs[index]->Exists()) {
+    return nullptr;
+  }
+
+  const TensorProto* tensor_proto = graph_utils::GetConstantInitializer(graph, input_defs[index]->Name());
+  if (tensor_proto == nullptr ||
+      tensor_proto->data_type() != TensorProto_DataType_FLOAT ||
+      tensor_proto->dims_size() != rank) {
+    return nullptr;
+  }
+
+  return tensor_proto;
+}
+
+// Returns true if `consumer` multiplies `activation`, which has `channels` channels, by constant weights whose rows
+// can be scaled: MatMul(activation, W) or Attention(activation, W, ...).
+bool IsSmoothableConsumer(const Graph& graph, const Node& consumer, const NodeArg& activation, int64_t channels,
+                          const InlinedHashSet<std::string_view>& compatible_providers) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(consumer, "MatMul", {1, 9, 13}) &&
+      !graph_utils::IsSupportedOptypeVersionAndDomain(consumer, "Attention", {1}, kMSDomain)) {
+    return false;
+  }
+
+  if (!graph_utils::IsSupportedProvider(consumer, compatible_providers)) {
+    return false;
+  }
+
+  const auto& input_defs = consumer.InputDefs();
+  if (input_defs[0] != &activation ||
+      std::count(input_defs.begin(), input_defs.end(), &activation) != 1) {
+    return false;
+  }
+
+  const TensorProto* weight = GetFloatConstantInput(graph, consumer, 1, 2);
+  return weight != nullptr && weight->dims(0) == channels;
+}
+
+// Replaces input `index` of `node` with a new initializer holding `initializer`.
+void ReplaceInputWithInitializer(Graph& graph, Node& node, int index, const Initializer& initializer) {
+  TensorProto tensor_proto;
+  initializer.ToProto(tensor_proto);
+  tensor_proto.set_name(graph.GenerateNodeArgName("SmoothQuant_" + node.InputDefs()[index]->Name()));
+  NodeArg& node_arg = graph_utils::AddInitializer(graph, tensor_proto);
+  graph_utils::ReplaceNodeInput(node, index, node_arg);
+}
+
+}  // namespace
+
+Status SmoothQuant::ParseActivationAbsMax(const std::unordered_map<std::string, std::string>& model_metadata,
+                                          std::unordered_map<std::string, std::vector<float>>& activation_abs_max) {
+  const std::string_view prefix = kActivationAbsMaxMetadataPrefix;
+  for (const auto& [key, value] : model_metadata) {
+    if (key.compare(0, prefix.size(), prefix) != 0) {
+      continue;
+    }
+
+    std::vector<float> abs_max;
+    for (const auto& element : utils::SplitString(value, ",")) {
+      float channel_abs_max = 0.0f;
+      ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(utils::TrimString(std::string{element}), channel_abs_max) &&
+                            channel_abs_max >= 0.0f,
+                        "Invalid value in the model metadata ", key, ": ", element);
+      abs_max.push_back(channel_abs_max);
+    }
+
+    activation_abs_max.insert_or_assign(key.substr(prefix.size()), std::move(abs_max));
+  }
+
+  return Status::OK();
+}
+
+Status SmoothQuant::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    const auto normalization_inputs = GetNormalizationInputs(node);
+    if (!normalization_inputs.has_value() ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    const NodeArg& activation = *node.OutputDefs()[0];
+    const auto abs_max_it = activation_abs_max_.find(activation.Name());
+    if (abs_max_it == activation_abs_max_.end() || graph.IsOutput(&activation)) {
+      continue;
+    }
+
+    const std::vector<float>& activation_abs_max = abs_max_it->second;
+    const TensorProto* gamma_proto = GetFloatConstantInput(graph, node, normalization_inputs->gamma_index, 1);
+    if (gamma_proto == nullptr || gamma_proto->dims(0) != static_cast<int64_t>(activation_abs_max.size())) {
+      continue;
+    }
+
+    const TensorProto* beta_proto = nullptr;
+    if (normalization_inputs->beta_index >= 0 &&
+        static_cast<size_t>(normalization_inputs->beta_index) < node.InputDefs().size() &&
+        node.InputDefs()[normalization_inputs->beta_index]->Exists()) {
+      beta_proto = GetFloatConstantInput(graph, node, normalization_inputs->beta_index, 1);
+      if (beta_proto == nullptr || beta_proto->dims(0) != gamma_proto->dims(0)) {
+        continue;
+      }
+    }
+
+    const int64_t channels = gamma_proto->dims(0);
+    std::vector<Node*> consumers = graph.GetMutableConsumerNodes(activation.Name());
+    if (consumers.empty() ||
+        !std::all_of(consumers.begin(), consumers.end(), [&](const Node* consumer) {
+          return IsSmoothableConsumer(graph, *consumer, activation, channels, GetCompatibleExecutionProviders());
+        })) {
+      continue;
+    }
+
+    // the factors are shared by all the consumers, so the weight range of a channel is the max over all of them
+    const auto channel_count = narrow<size_t>(channels);
+    std::vector<float> weight_abs_max(channel_count, 0.0f);
+    InlinedVector<std::unique_ptr<Initializer>> weights;
+    for (const Node* consumer : consumers) {
+      const TensorProto* weight_proto = GetFloatConstantInput(graph, *consumer, 1, 2);
+      const Initializer& weight = *weights.emplace_back(std::make_unique<Initializer>(*weight_proto,
+                                                                                       graph.ModelPath()));
+      const auto columns = narrow<size_t>(weight_proto->dims(1));
+      const float* weight_data = weight.data<float>();
+      for (size_t channel = 0; channel < channel_count; channel++) {
+        for (size_t col = 0; col < columns; col++) {
+          weight_abs_max[channel] = std::max(weight_abs_max[channel], std::abs(weight_data[channel * columns + col]));
+        }
+      }
+    }
+
+    std::vector<float> factors(channel_count, 1.0f);
+    for (size_t channel = 0; channel < channel_count; channel++) {
+      if (activation_abs_max[channel] > 0.0f && weight_abs_max[channel] > 0.0f) {
+        const float factor = std::pow(activation_abs_max[channel], alpha_) /
+                             std::pow(weight_abs_max[channel], 1.0f - alpha_);
+        factors[channel] = std::isfinite(factor) ? std::max(factor, 1e-5f) : 1.0f;
+      }
+    }
+
+    Initializer gamma(*gamma_proto, graph.ModelPath());
+    float* gamma_data = gamma.data<float>();
+    for (size_t channel = 0; channel < channel_count; channel++) {
+      gamma_data[channel] /= factors[channel];
+    }
+    ReplaceInputWithInitializer(graph, node, normalization_inputs->gamma_index, gamma);
+
+    if (beta_proto != nullptr) {
+      Initializer beta(*beta_proto, graph.ModelPath());
+      float* beta_data = beta.data<float>();
+      for (size_t channel = 0; channel < channel_count; channel++) {
+        beta_data[channel] /= factors[channel];
+      }
+      ReplaceInputWithInitializer(graph, node, normalization_inputs->beta_index, beta);
+    }
+
+    for (size_t i = 0; i < consumers.size(); i++) {
+      Initializer& weight = *weights[i];
+      const size_t columns = weight.size() / channel_count;
+      float* weight_data = weight.data<float>();
+      for (size_t channel = 0; channel < channel_count; channel++) {
+        for (size_t col = 0; col < columns; col++) {
+          weight_data[channel * columns + col] *= factors[channel];
+        }
+      }
+      ReplaceInputWithInitializer(graph, *consumers[i], 1, weight);
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class SmoothQuant
+
+Migrate the quantization difficulty of activation outlier channels to the weights, as described in
+"SmoothQuant: Accurate and Efficient Post-Training Quantization for Large Language Models".
+
+For a LayerNormalization, SimplifiedLayerNormalization, SkipLayerNormalization or SkipSimplifiedLayerNormalization node
+whose output only feeds MatMul or Attention nodes with constant weights, each channel j gets a smoothing factor
+  s[j] = max(|X[:, j]|)^alpha / max(|W[j, :]|)^(1 - alpha)
+which divides the normalization gamma (and beta) and multiplies row j of the weights. The results are unchanged, but the
+activations have a smaller range in the outlier channels so they quantize better, e.g. with MatMulDynamicQuantization.
+
+max(|X[:, j]|) is collected offline on calibration data and supplied in the model metadata, with one entry per
+normalization output: the key is kActivationAbsMaxMetadataPrefix followed by the output name, and the value has one
+comma separated float per channel.
+*/
+class SmoothQuant : public GraphTransformer {
+ public:
+  static constexpr const char* kActivationAbsMaxMetadataPrefix = "smooth_quant.activation_abs_max.";
+
+  SmoothQuant(std::unordered_map<std::string, std::vector<float>> activation_abs_max, float alpha,
+              const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("SmoothQuant", compatible_execution_providers),
+        activation_abs_max_(std::move(activation_abs_max)),
+        alpha_(alpha) {}
+
+  // Reads the per channel activation statistics from the model metadata.
+  static Status ParseActivationAbsMax(const std::unordered_map<std::string, std::string>& model_metadata,
+                                      std::unordered_map<std::string, std::vector<float>>& activation_abs_max);
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  std::unordered_map<std::string, std::vector<float>> activation_abs_max_;
+  float alpha_;
+};
+
+}  // namespace onnxruntime
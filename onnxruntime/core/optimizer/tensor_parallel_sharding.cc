@@ -0,0 +1,196 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/tensor_parallel_sharding.h"
+
+#include <cstring>
+
+#include "core/common/narrow.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+// Elementwise ops with a single input that may sit between the two MatMuls of a sharded block.
+bool IsShardableActivation(const Node& node) {
+  static const InlinedHashSet<std::string_view> onnx_ops = {"Relu", "Gelu", "Sigmoid", "Tanh", "Erf"};
+  static const InlinedHashSet<std::string_view> ms_ops = {"Gelu", "FastGelu", "QuickGelu"};
+
+  if (node.InputDefs().size() != 1 || node.OutputDefs().size() != 1) {
+    return false;
+  }
+
+  const auto& domain = node.Domain();
+  if (domain == kOnnxDomain || domain == kOnnxDomainAlias) {
+    return onnx_ops.count(node.OpType()) > 0;
+  }
+  return domain == kMSDomain && ms_ops.count(node.OpType()) > 0;
+}
+
+// Returns the constant initializer feeding `node_arg`, nullptr if it isn't one or doesn't have `rank` dimensions.
+const TensorProto* GetConstantWeight(const Graph& graph, const NodeArg& node_arg, int rank) {
+  const TensorProto* tensor_proto = graph_utils::GetConstantInitializer(graph, node_arg.Name());
+  return tensor_proto != nullptr && tensor_proto->dims_size() == rank ? tensor_proto : nullptr;
+}
+
+// Creates an initializer with the slice `rank` of `world_size` equal slices of `tensor_proto` along `axis`.
+NodeArg& AddSlicedInitializer(Graph& graph, const TensorProto& tensor_proto, int axis, int64_t world_size,
+                              int64_t rank) {
+  Initializer initializer{tensor_proto, graph.ModelPath()};
+  const auto dims = initializer.dims();
+  const auto bytes = initializer.DataAsByteSpan();
+
+  const size_t element_size = initializer.size() == 0 ? 0 : bytes.size() / initializer.size();
+  const size_t slice_dim = narrow<size_t>(dims[axis] / world_size);
+  size_t outer = 1;
+  size_t inner = element_size;
+  for (int i = 0; i < static_cast<int>(dims.size()); ++i) {
+    if (i < axis) {
+      outer *= narrow<size_t>(dims[i]);
+    } else if (i > axis) {
+      inner *= narrow<size_t>(dims[i]);
+    }
+  }
+
+  const size_t src_stride = narrow<size_t>(dims[axis]) * inner;
+  const size_t dst_stride = slice_dim * inner;
+  std::string sliced_data(outer * dst_stride, '\0');
+  for (size_t o = 0; o < outer; ++o) {
+    std::memcpy(sliced_data.data() + o * dst_stride,
+                bytes.data() + o * src_stride + narrow<size_t>(rank) * dst_stride, dst_stride);
+  }
+
+  TensorProto sliced;
+  sliced.set_name(graph.GenerateNodeArgName(tensor_proto.name() + "_rank" + std::to_string(rank)));
+  sliced.set_data_type(tensor_proto.data_type());
+  for (int i = 0; i < static_cast<int>(dims.size()); ++i) {
+    sliced.add_dims(i == axis ? static_cast<int64_t>(slice_dim) : dims[i]);
+  }
+  sliced.set_raw_data(std::move(sliced_data));
+  return graph_utils::AddInitializer(graph, sliced);
+}
+
+// Inserts an AllReduce producing the output of `node` from the partial result computed by `node`.
+void AddAllReduce(Graph& graph, Node& node) {
+  NodeArg& output = *node.MutableOutputDefs()[0];
+  NodeArg& partial_output = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(output.Name() + "_partial"),
+                                                     output.TypeAsProto());
+
+  InlinedVector<std::pair<NodeIndex, int>> consumers;
+  for (auto edge = node.OutputEdgesBegin(); edge != node.OutputEdgesEnd(); ++edge) {
+    consumers.emplace_back(edge->GetNode().Index(), edge->GetDstArgIndex());
+  }
+  for (const auto& consumer : consumers) {
+    graph.RemoveEdge(node.Index(), consumer.first, 0, consumer.second);
+  }
+
+  node.MutableOutputDefs()[0] = &partial_output;
+  graph.UpdateProducerNode(partial_output.Name(), node.Index());
+
+  Node& all_reduce = graph.AddNode(graph.GenerateNodeName(node.Name() + "_AllReduce"), "AllReduce",
+                                   "Sums the partial results of the tensor parallel ranks", {&partial_output},
+                                   {&output}, nullptr, kMSDomain);
+  all_reduce.SetExecutionProviderType(node.GetExecutionProviderType());
+  graph.UpdateProducerNode(output.Name(), all_reduce.Index());
+  graph.AddEdge(node.Index(), all_reduce.Index(), 0, 0);
+  for (const auto& consumer : consumers) {
+    graph.AddEdge(all_reduce.Index(), consumer.first, 0, consumer.second);
+  }
+}
+
+}  // namespace
+
+Status TensorParallelSharding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                         const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  size_t num_sharded_blocks = 0;
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (node_ptr == nullptr) {
+      continue;  // node was removed
+    }
+
+    auto& matmul1 = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(matmul1, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(matmul1, "MatMul", {1, 9, 13}) ||
+        !graph_utils::IsSupportedProvider(matmul1, GetCompatibleExecutionProviders()) ||
+        !optimizer_utils::CheckOutputEdges(graph, matmul1, 1)) {
+      continue;
+    }
+
+    const TensorProto* w1 = GetConstantWeight(graph, *matmul1.InputDefs()[1], 2);
+    if (w1 == nullptr) {
+      continue;
+    }
+    const int64_t inner_dim = w1->dims(1);
+    if (inner_dim <= 0 || inner_dim % world_size_ != 0) {
+      continue;
+    }
+
+    // optional bias
+    Node* next = graph.GetNode(matmul1.OutputNodesBegin()->Index());
+    Node* bias_add = nullptr;
+    int bias_input_idx = -1;
+    const TensorProto* b1 = nullptr;
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(*next, "Add", {7, 13, 14})) {
+      bias_input_idx = next->InputDefs()[0] == matmul1.OutputDefs()[0] ? 1 : 0;
+      b1 = GetConstantWeight(graph, *next->InputDefs()[bias_input_idx], 1);
+      if (b1 == nullptr || b1->dims(0) != inner_dim || !optimizer_utils::CheckOutputEdges(graph, *next, 1)) {
+        continue;
+      }
+      bias_add = next;
+      next = graph.GetNode(bias_add->OutputNodesBegin()->Index());
+    }
+
+    Node& activation = *next;
+    if (!IsShardableActivation(activation) || !optimizer_utils::CheckOutputEdges(graph, activation, 1)) {
+      continue;
+    }
+
+    Node& matmul2 = *graph.GetNode(activation.OutputNodesBegin()->Index());
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(matmul2, "MatMul", {1, 9, 13}) ||
+        matmul2.InputDefs()[0] != activation.OutputDefs()[0]) {
+      continue;
+    }
+    const TensorProto* w2 = GetConstantWeight(graph, *matmul2.InputDefs()[1], 2);
+    if (w2 == nullptr || w2->dims(0) != inner_dim) {
+      continue;
+    }
+
+    graph_utils::ReplaceNodeInput(matmul1, 1, AddSlicedInitializer(graph, *w1, 1, world_size_, rank_));
+    if (bias_add != nullptr) {
+      graph_utils::ReplaceNodeInput(*bias_add, bias_input_idx,
+                                    AddSlicedInitializer(graph, *b1, 0, world_size_, rank_));
+    }
+    graph_utils::ReplaceNodeInput(matmul2, 1, AddSlicedInitializer(graph, *w2, 0, world_size_, rank_));
+    AddAllReduce(graph, matmul2);
+
+    // the inner dimension of the block shrank, the shapes are inferred again when the graph is resolved
+    matmul1.MutableOutputDefs()[0]->ClearShape();
+    if (bias_add != nullptr) {
+      bias_add->MutableOutputDefs()[0]->ClearShape();
+    }
+    activation.MutableOutputDefs()[0]->ClearShape();
+
+    ++num_sharded_blocks;
+    modified = true;
+  }
+
+  if (num_sharded_blocks > 0) {
+    LOGS(logger, INFO) << "TensorParallelSharding sharded " << num_sharded_blocks << " MLP blocks for rank "
+                       << rank_ << " of " << world_size_;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,36 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class TensorParallelSharding
+
+Shards the MLP blocks of a model for the rank of a tensor parallel group, see
+kOrtSessionOptionsConfigTensorParallelWorldSize.
+
+A block is MatMul(X, W1) -> [Add(B1)] -> activation -> MatMul(W2) where W1, B1 and W2 are constant initializers and
+the inner dimension of the block is divisible by the world size. The rank keeps its slice of the columns of W1 and
+B1 and the matching slice of the rows of W2, and the partial results of the second MatMul are summed over the ranks
+by an AllReduce.
+*/
+class TensorParallelSharding : public GraphTransformer {
+ public:
+  TensorParallelSharding(int64_t world_size, int64_t rank,
+                         const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("TensorParallelSharding", compatible_execution_providers),
+        world_size_(world_size),
+        rank_(rank) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  int64_t world_size_;
+  int64_t rank_;
+};
+
+}  // namespace onnxruntime
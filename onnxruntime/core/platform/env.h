@@ -91,6 +91,15 @@ struct ThreadOptions {
   void* custom_thread_creation_options = nullptr;
   OrtCustomJoinThreadFn custom_join_thread_fn = nullptr;
   int dynamic_block_base_ = 0;
+
+  // If non-negative, the threads spin waiting for work for this many microseconds before blocking,
+  // instead of a fixed number of iterations. Only applies when spinning is allowed.
+  int spin_duration_us = -1;
+
+  // If true, the thread pool groups its workers by the NUMA node of their affinities and prefers to keep
+  // scheduling and work stealing within a node. Only takes effect when affinities are set and the workers
+  // span more than one node.
+  bool numa_aware_scheduling = false;
 };
 
 std::ostream& operator<<(std::ostream& os, const LogicalProcessors&);
@@ -147,6 +156,15 @@ class Env {
 
   virtual std::vector<LogicalProcessors> GetDefaultThreadAffinities() const = 0;
 
+  /// <summary>
+  /// Returns the NUMA node that a logical processor belongs to.
+  /// </summary>
+  /// <param name="logical_processor_id">0-based logical processor id, as used in LogicalProcessors</param>
+  /// <returns>0-based NUMA node id, or -1 if it cannot be determined</returns>
+  virtual int GetNumaNodeOfLogicalProcessor(int /*logical_processor_id*/) const {
+    return -1;
+  }
+
   /// \brief Returns the number of micro-seconds since the Unix epoch.
   virtual uint64_t NowMicros() const {
     return env_time_->NowMicros();
@@ -192,6 +210,45 @@ class Env {
   virtual common::Status MapFileIntoMemory(_In_z_ const ORTCHAR_T* file_path, FileOffsetType offset, size_t length,
                                            MappedMemoryPtr& mapped_memory) const = 0;
 
+  /**
+   * Returns the size of the large pages, e.g. 2 MB on x64 Linux, or 0 if the platform doesn't provide them.
+   */
+  virtual size_t GetLargePageSize() const { return 0; }
+
+  /**
+   * Allocates read/write memory backed by large pages, which reduces the TLB misses of accesses spread over big
+   * buffers like the weights of GEMMs.
+   * @param size The size in bytes, a multiple of GetLargePageSize().
+   * @return The memory, or nullptr if large pages are unavailable, in which case the caller falls back to a regular
+   *         allocation. It's freed with FreeLargePages().
+   */
+  virtual void* AllocateLargePages(size_t size) const {
+    ORT_UNUSED_PARAMETER(size);
+    return nullptr;
+  }
+
+  virtual void FreeLargePages(void* p, size_t size) const {
+    ORT_UNUSED_PARAMETER(p);
+    ORT_UNUSED_PARAMETER(size);
+  }
+
+  /**
+   * Allocates read/write memory whose pages are placed on a NUMA node.
+   * @param size The size in bytes.
+   * @param numa_node The OS id of the node, e.g. from GetNumaNodeOfLogicalProcessor().
+   * @return The memory, or nullptr if it can't be placed on the node. It's freed with FreeNumaNodeMemory().
+   */
+  virtual void* AllocateOnNumaNode(size_t size, int numa_node) const {
+    ORT_UNUSED_PARAMETER(size);
+    ORT_UNUSED_PARAMETER(numa_node);
+    return nullptr;
+  }
+
+  virtual void FreeNumaNodeMemory(void* p, size_t size) const {
+    ORT_UNUSED_PARAMETER(p);
+    ORT_UNUSED_PARAMETER(size);
+  }
+
 #ifdef _WIN32
   /// \brief Returns true if the directory exists.
   virtual bool FolderExists(const std::wstring& path) const = 0;
@@ -17,6 +17,7 @@ limitations under the License.
 #include "core/platform/env.h"
 
 #include <assert.h>
+#include <dirent.h>
 #include <dlfcn.h>
 #include <fcntl.h>
 #include <ftw.h>
@@ -29,6 +30,7 @@ limitations under the License.
 #include <sys/syscall.h>
 #include <unistd.h>
 
+#include <fstream>
 #include <iostream>
 #include <optional>
 #include <thread>
@@ -118,6 +120,10 @@ struct Freer {
 
 using MallocdStringPtr = std::unique_ptr<char, Freer<char> >;
 
+struct DirCloser {
+  void operator()(DIR* dir) const { closedir(dir); }
+};
+
 class PosixThread : public EnvThread {
  private:
   struct Param {
@@ -302,6 +308,30 @@ class PosixEnv : public Env {
     return ret;
   }
 
+  int GetNumaNodeOfLogicalProcessor(int logical_processor_id) const override {
+#if defined(__linux__) && !defined(__ANDROID__)
+    // The sysfs directory of each cpu contains a "node<N>" link to the NUMA node it belongs to.
+    if (logical_processor_id < 0) {
+      return -1;
+    }
+    const std::string cpu_dir = "/sys/devices/system/cpu/cpu" + std::to_string(logical_processor_id);
+    std::unique_ptr<DIR, DirCloser> dir(opendir(cpu_dir.c_str()));
+    if (!dir) {
+      return -1;
+    }
+    while (const dirent* entry = readdir(dir.get())) {
+      const char* name = entry->d_name;
+      if (strncmp(name, "node", 4) == 0 && name[4] >= '0' && name[4] <= '9') {
+        return atoi(name + 4);
+      }
+    }
+    return -1;
+#else
+    ORT_UNUSED_PARAMETER(logical_processor_id);
+    return -1;
+#endif
+  }
+
   void SleepForMicroseconds(int64_t micros) const override {
     while (micros > 0) {
       timespec sleep_time;
@@ -434,6 +464,108 @@ class PosixEnv : public Env {
     return Status::OK();
   }
 
+  size_t GetLargePageSize() const override {
+#if defined(__linux__)
+    // the size of the transparent huge pages, which is also the default size of the hugetlbfs pages on x64 and arm64
+    static const size_t large_page_size = []() -> size_t {
+      size_t size = 0;
+      std::ifstream file("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size");
+      if (file >> size && size != 0 && (size & (size - 1)) == 0) {
+        return size;
+      }
+      return 0;
+    }();
+    return large_page_size;
+#else
+    return 0;
+#endif
+  }
+
+  void* AllocateLargePages(size_t size) const override {
+#if defined(__linux__)
+    const size_t large_page_size = GetLargePageSize();
+    if (large_page_size == 0 || size == 0 || size % large_page_size != 0) {
+      return nullptr;
+    }
+
+    // pages reserved in hugetlbfs first
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (p != MAP_FAILED) {
+      return p;
+    }
+
+    // then transparent huge pages, which need a mapping aligned to the large page size
+    const size_t mapped_length = size + large_page_size;
+    void* const mapped_base = mmap(nullptr, mapped_length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapped_base == MAP_FAILED) {
+      return nullptr;
+    }
+
+    const uintptr_t base = reinterpret_cast<uintptr_t>(mapped_base);
+    const uintptr_t aligned = (base + large_page_size - 1) & ~static_cast<uintptr_t>(large_page_size - 1);
+    const size_t head = aligned - base;
+    const size_t tail = mapped_length - head - size;
+    if (head != 0) {
+      munmap(mapped_base, head);
+    }
+    if (tail != 0) {
+      munmap(reinterpret_cast<char*>(aligned) + size, tail);
+    }
+
+    p = reinterpret_cast<void*>(aligned);
+    if (madvise(p, size, MADV_HUGEPAGE) != 0) {
+      munmap(p, size);
+      return nullptr;
+    }
+    return p;
+#else
+    ORT_UNUSED_PARAMETER(size);
+    return nullptr;
+#endif
+  }
+
+  void FreeLargePages(void* p, size_t size) const override {
+    if (p != nullptr) {
+      munmap(p, size);
+    }
+  }
+
+  void* AllocateOnNumaNode(size_t size, int numa_node) const override {
+#if defined(__linux__) && defined(SYS_mbind)
+    if (size == 0 || numa_node < 0) {
+      return nullptr;
+    }
+
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+      return nullptr;
+    }
+
+    // bind the pages to the node before they are touched, MPOL_BIND is 2 in <numaif.h>
+    constexpr int kMpolBind = 2;
+    constexpr size_t kBitsPerWord = sizeof(unsigned long) * 8;
+    std::vector<unsigned long> node_mask(static_cast<size_t>(numa_node) / kBitsPerWord + 1, 0);
+    node_mask[static_cast<size_t>(numa_node) / kBitsPerWord] = 1UL << (static_cast<size_t>(numa_node) % kBitsPerWord);
+    // the kernel reads maxnode - 1 bits of the mask
+    const unsigned long max_node = static_cast<unsigned long>(node_mask.size() * kBitsPerWord + 1);
+    if (syscall(SYS_mbind, p, size, kMpolBind, node_mask.data(), max_node, 0) != 0) {
+      munmap(p, size);
+      return nullptr;
+    }
+    return p;
+#else
+    ORT_UNUSED_PARAMETER(size);
+    ORT_UNUSED_PARAMETER(numa_node);
+    return nullptr;
+#endif
+  }
+
+  void FreeNumaNodeMemory(void* p, size_t size) const override {
+    if (p != nullptr) {
+      munmap(p, size);
+    }
+  }
+
   static common::Status ReportSystemError(const char* operation_name, const std::string& path) {
     auto [err_no, err_msg] = GetErrnoInfo();
     std::ostringstream oss;
@@ -303,6 +303,21 @@ std::vector<LogicalProcessors> WindowsEnv::GetDefaultThreadAffinities() const {
   return cores_.empty() ? std::vector<LogicalProcessors>(DefaultNumCores(), LogicalProcessors{}) : cores_;
 }
 
+int WindowsEnv::GetNumaNodeOfLogicalProcessor(int logical_processor_id) const {
+  auto processor_info = GetProcessorAffinityMask(logical_processor_id);
+  if (processor_info.group_id < 0 || processor_info.local_processor_id < 0) {
+    return -1;
+  }
+  PROCESSOR_NUMBER processor_number = {};
+  processor_number.Group = static_cast<WORD>(processor_info.group_id);
+  processor_number.Number = static_cast<BYTE>(processor_info.local_processor_id);
+  USHORT node_number = 0;
+  if (!GetNumaProcessorNodeEx(&processor_number, &node_number) || node_number == 0xffff) {
+    return -1;
+  }
+  return static_cast<int>(node_number);
+}
+
 WindowsEnv& WindowsEnv::Instance() {
   static WindowsEnv default_env;
   return default_env;
@@ -469,6 +484,40 @@ Status WindowsEnv::MapFileIntoMemory(_In_z_ const ORTCHAR_T* file_path,
   return Status::OK();
 }
 
+size_t WindowsEnv::GetLargePageSize() const {
+  return GetLargePageMinimum();
+}
+
+void* WindowsEnv::AllocateLargePages(size_t size) const {
+  const size_t large_page_size = GetLargePageSize();
+  if (large_page_size == 0 || size == 0 || size % large_page_size != 0) {
+    return nullptr;
+  }
+
+  // fails unless the user has the SeLockMemoryPrivilege ("Lock pages in memory") privilege
+  return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+}
+
+void WindowsEnv::FreeLargePages(void* p, size_t /*size*/) const {
+  if (p != nullptr) {
+    VirtualFree(p, 0, MEM_RELEASE);
+  }
+}
+
+void* WindowsEnv::AllocateOnNumaNode(size_t size, int numa_node) const {
+  if (size == 0 || numa_node < 0) {
+    return nullptr;
+  }
+  return VirtualAllocExNuma(GetCurrentProcess(), nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE,
+                            static_cast<DWORD>(numa_node));
+}
+
+void WindowsEnv::FreeNumaNodeMemory(void* p, size_t /*size*/) const {
+  if (p != nullptr) {
+    VirtualFree(p, 0, MEM_RELEASE);
+  }
+}
+
 bool WindowsEnv::FolderExists(const std::wstring& path) const {
   DWORD attributes = GetFileAttributesW(path.c_str());
   return (attributes != INVALID_FILE_ATTRIBUTES) && (attributes & FILE_ATTRIBUTE_DIRECTORY);
@@ -55,6 +55,7 @@ class WindowsEnv : public Env {
   static int DefaultNumCores();
   int GetNumPhysicalCpuCores() const override;
   std::vector<LogicalProcessors> GetDefaultThreadAffinities() const override;
+  int GetNumaNodeOfLogicalProcessor(int logical_processor_id) const override;
   static WindowsEnv& Instance();
   PIDType GetSelfPid() const override;
   Status GetFileLength(_In_z_ const ORTCHAR_T* file_path, size_t& length) const override;
@@ -65,6 +66,11 @@ class WindowsEnv : public Env {
                            FileOffsetType offset,
                            size_t length,
                            MappedMemoryPtr& mapped_memory) const override;
+  size_t GetLargePageSize() const override;
+  void* AllocateLargePages(size_t size) const override;
+  void FreeLargePages(void* p, size_t size) const override;
+  void* AllocateOnNumaNode(size_t size, int numa_node) const override;
+  void FreeNumaNodeMemory(void* p, size_t size) const override;
   bool FolderExists(const std::wstring& path) const override;
   bool FolderExists(const std::string& path) const override;
   common::Status CreateFolder(const std::wstring& path) const override;
@@ -1,9 +1,11 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <fstream>
 
 #include "core/common/safeint.h"
+#include "core/framework/ep_context_cache.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/platform/env.h"
 #include "core/providers/common.h"
@@ -436,7 +438,8 @@ ModelBuilder::ModelBuilder(const GraphViewer& graph_viewer, const logging::Logge
     std::string weights_id = mlpackage_->addItem(tmp_dir, "weights", "com.microsoft.OnnxRuntime",
                                                  "CoreML Model Weights");
     auto weights_info = mlpackage_->findItem(weights_id);
-    weights_file_writer_ = std::make_unique<StorageWriter>(weights_info->path() + "/weight.bin");
+    weights_file_path_ = weights_info->path() + "/weight.bin";
+    weights_file_writer_ = std::make_unique<StorageWriter>(weights_file_path_);
 #else
     // should never happen due to handling in coreml_execution_provider.cc
     // throw here so all other code in this class can assume create_ml_program_ is only ever true in a build
@@ -903,6 +906,8 @@ Status ModelBuilder::CreateModel() {
 
 Status ModelBuilder::SaveModel() {
   std::string output_path = model_output_path_;
+  std::string serialized_model;
+  ORT_RETURN_IF_NOT(coreml_model_->SerializeToString(&serialized_model), "Serializing the CoreML model failed.");
 
 #if defined(COREML_ENABLE_MLPROGRAM)
   if (create_ml_program_) {
@@ -921,7 +926,8 @@ Status ModelBuilder::SaveModel() {
   {
     LOGS(logger_, INFO) << "Writing CoreML Model to " << output_path;
     std::ofstream stream(output_path, std::ofstream::out | std::ofstream::binary);
-    ORT_RETURN_IF_NOT(coreml_model_->SerializeToOstream(&stream), "Saving the CoreML model failed. Path=", output_path);
+    stream.write(serialized_model.data(), serialized_model.size());
+    ORT_RETURN_IF_NOT(stream.good(), "Saving the CoreML model failed. Path=", output_path);
   }
 
 #if defined(COREML_ENABLE_MLPROGRAM)
@@ -932,6 +938,24 @@ Status ModelBuilder::SaveModel() {
   weights_file_writer_.reset();
 #endif
 
+  if (coreml_flags_ & COREML_FLAG_ENABLE_COMPILED_MODEL_CACHE) {
+    // the key covers everything the compiled model depends on. any change to the ONNX subgraph or to how we convert
+    // it changes the generated model and results in a new entry.
+    EpContextCacheKey key;
+    key.AddBytes("model", serialized_model.data(), serialized_model.size());
+#if defined(COREML_ENABLE_MLPROGRAM)
+    if (create_ml_program_) {
+      ORT_RETURN_IF_ERROR(key.AddFile("weights", ToPathString(weights_file_path_)));
+    }
+#endif
+    key.Add("coreml_version", std::to_string(coreml_version_));
+    key.Add("coreml_flags", std::to_string(coreml_flags_));
+
+    const EpContextCacheDirectory cache_directory(ToPathString(util::GetCompiledModelCacheDirectory()));
+    compiled_model_cache_path_ = PathToUTF8String(
+        cache_directory.GetEntryPath(kCoreMLExecutionProvider, graph_viewer_.Name(), key, ".mlmodelc"));
+  }
+
   return Status::OK();
 }
 
@@ -969,6 +993,7 @@ Status ModelBuilder::LoadModel(std::unique_ptr<Model>& model) {
                                     get_sanitized_io_info(std::move(input_output_info_)),
                                     std::move(scalar_outputs_),
                                     std::move(int64_outputs_),
+                                    compiled_model_cache_path_,
                                     logger_, coreml_flags_);
   } else
 #endif
@@ -979,6 +1004,7 @@ Status ModelBuilder::LoadModel(std::unique_ptr<Model>& model) {
                                     std::move(input_output_info_),
                                     std::move(scalar_outputs_),
                                     std::move(int64_outputs_),
+                                    compiled_model_cache_path_,
                                     logger_, coreml_flags_);
   }
 
@@ -196,6 +196,8 @@ class ModelBuilder {
   const uint32_t coreml_flags_;
   const bool create_ml_program_;         // ML Program (CoreML5, iOS 15+, macOS 12+) or NeuralNetwork (old)
   const std::string model_output_path_;  // create_ml_program_ ? dir for mlpackage : filename for mlmodel
+  // path of the compiled model in the cache if COREML_FLAG_ENABLE_COMPILED_MODEL_CACHE is set. set by SaveModel.
+  std::string compiled_model_cache_path_;
 
   std::vector<std::string> onnx_input_names_;
   std::vector<std::string> onnx_output_names_;
@@ -219,6 +221,7 @@ class ModelBuilder {
   COREML_SPEC::MILSpec::Block* mlprogram_main_block_{nullptr};  // Block that all the operations are added to
   std::unique_ptr<MPL::ModelPackage> mlpackage_;
   std::unique_ptr<MILBlob::Blob::StorageWriter> weights_file_writer_;
+  std::string weights_file_path_;
 
   // Values must start with [a-zA-A_]
   // Additionally they can't be in a list of reserved words.
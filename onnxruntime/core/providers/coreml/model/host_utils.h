@@ -67,6 +67,10 @@ int CoreMLVersion();
 // Get a temporary macOS/iOS temp file path
 std::string GetTemporaryFilePath();
 
+// Get the directory compiled models are cached in when COREML_FLAG_ENABLE_COMPILED_MODEL_CACHE is set.
+// The directory is created if it does not exist.
+std::string GetCompiledModelCacheDirectory();
+
 #if !defined(NDEBUG) && defined(__APPLE__)
 // Override location the model is written to so that a) it's easily found and b) it is not automatically deleted
 // when the EP exits. Use to debug the model that is generated.
@@ -54,6 +54,25 @@ std::string GetTemporaryFilePath() {
   return std::string([[temporary_file_url path] UTF8String]);
 }
 
+std::string GetCompiledModelCacheDirectory() {
+  // Library/Caches persists across app launches but the OS may purge it when space is low, which is what we want for
+  // something that can be regenerated.
+  NSURL* caches_directory_url = [[[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory
+                                                                       inDomains:NSUserDomainMask] firstObject];
+  if (caches_directory_url == nil) {
+    caches_directory_url = [NSURL fileURLWithPath:NSTemporaryDirectory() isDirectory:YES];
+  }
+
+  NSURL* cache_directory_url = [caches_directory_url URLByAppendingPathComponent:@"onnxruntime-coreml"
+                                                                     isDirectory:YES];
+  [[NSFileManager defaultManager] createDirectoryAtURL:cache_directory_url
+                           withIntermediateDirectories:YES
+                                            attributes:nil
+                                                 error:nil];
+
+  return std::string([[cache_directory_url path] UTF8String]);
+}
+
 }  // namespace util
 }  // namespace coreml
 }  // namespace onnxruntime
@@ -35,6 +35,16 @@ std::string GetTemporaryFilePath() {
   return dir_name;
 }
 
+std::string GetCompiledModelCacheDirectory() {
+  const std::string dir_name = "coreml_ep_compiled_model_cache";
+  auto& env = Env::Default();
+  if (!env.FolderExists(dir_name)) {
+    ORT_THROW_IF_ERROR(env.CreateFolder(ToPathString(dir_name)));
+  }
+
+  return dir_name;
+}
+
 }  // namespace util
 }  // namespace coreml
 }  // namespace onnxruntime
@@ -34,12 +34,15 @@ using GetOutputTensorMutableRawDataFn = std::function<void*(const std::string& n
 
 class Model {
  public:
+  // `compiled_model_cache_path` is where the compiled model is kept for reuse by other sessions.
+  // If empty, the model is compiled to a temporary location that is removed with the Model.
   Model(const std::string& path,
         std::vector<std::string>&& model_input_names,
         std::vector<std::string>&& model_output_names,
         std::unordered_map<std::string, OnnxTensorInfo>&& input_output_info,
         std::unordered_set<std::string>&& scalar_outputs,
         std::unordered_set<std::string>&& int64_outputs,
+        const std::string& compiled_model_cache_path,
         const logging::Logger& logger, uint32_t coreml_flags);
 
   ~Model();
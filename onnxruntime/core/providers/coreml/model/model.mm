@@ -234,18 +234,22 @@ NS_ASSUME_NONNULL_BEGIN
 // Execution for a CoreML model, it performs
 // 1. Compile the model by given path for execution
 // 2. Predict using given OnnxTensorFeatureProvider input and copy the output data back ORT
-// 3. The compiled model will be removed in dealloc or removed using cleanup function
+// 3. The compiled model will be removed in dealloc or removed using cleanup function, unless it is kept in the
+//    compiled model cache
 @interface CoreMLExecution : NSObject {
   NSString* coreml_model_path_;
   NSString* compiled_model_path_;
+  NSString* _Nullable compiled_model_cache_path_;
   const logging::Logger* logger_;
   uint32_t coreml_flags_;
 }
 
 - (instancetype)initWithPath:(const std::string&)path
+   compiled_model_cache_path:(const std::string&)compiled_model_cache_path
                       logger:(const logging::Logger&)logger
                 coreml_flags:(uint32_t)coreml_flags;
 - (void)cleanup;
+- (void)removeModel;
 - (void)dealloc;
 - (Status)loadModel API_AVAILABLE_COREML3;
 - (Status)predict:(const std::unordered_map<std::string, OnnxTensorData>&)inputs
@@ -261,10 +265,14 @@ NS_ASSUME_NONNULL_BEGIN
 @implementation CoreMLExecution
 
 - (instancetype)initWithPath:(const std::string&)path
+   compiled_model_cache_path:(const std::string&)compiled_model_cache_path
                       logger:(const logging::Logger&)logger
                 coreml_flags:(uint32_t)coreml_flags {
   if (self = [super init]) {
     coreml_model_path_ = util::Utf8StringToNSString(path.c_str());
+    compiled_model_cache_path_ = compiled_model_cache_path.empty()
+                                     ? nil
+                                     : util::Utf8StringToNSString(compiled_model_cache_path.c_str());
     logger_ = &logger;
     coreml_flags_ = coreml_flags;
   }
@@ -282,6 +290,11 @@ NS_ASSUME_NONNULL_BEGIN
     compiled_model_path_ = nil;
   }
 
+  [self removeModel];
+}
+
+// remove the uncompiled model. it is not needed once the compiled model is loaded.
+- (void)removeModel {
 #if !defined(NDEBUG)
   std::string path_override = Env::Default().GetEnvironmentVar(util::kOverrideModelOutputDirectoryEnvVar);
   if (!path_override.empty()) {
@@ -291,7 +304,7 @@ NS_ASSUME_NONNULL_BEGIN
 #endif
 
   if (coreml_model_path_ != nil) {
-    error = nil;
+    NSError* error = nil;
     [[NSFileManager defaultManager] removeItemAtPath:coreml_model_path_ error:&error];
     if (error != nil) {
       LOGS(*logger_, ERROR) << "Failed cleaning up the coreml model: " << [coreml_model_path_ UTF8String]
@@ -316,14 +329,36 @@ NS_ASSUME_NONNULL_BEGIN
   // As we call loadModel during EP Compile there shouldn't be an issue letting the actual compile run in the
   // background. We will have to check for completion in `predict` and block until it is done.
   NSError* error = nil;
-  NSURL* compileUrl = [MLModel compileModelAtURL:modelUrl error:&error];
+  NSFileManager* file_manager = [NSFileManager defaultManager];
+  NSURL* compileUrl = nil;
 
-  if (error != nil) {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Error compiling model: ",
-                           [[error localizedDescription] UTF8String]);
-  }
+  if (compiled_model_cache_path_ != nil && [file_manager fileExistsAtPath:compiled_model_cache_path_]) {
+    LOGS(*logger_, INFO) << "Using cached compiled CoreML model: " << [compiled_model_cache_path_ UTF8String];
+    compileUrl = [NSURL fileURLWithPath:compiled_model_cache_path_ isDirectory:YES];
+  } else {
+    compileUrl = [MLModel compileModelAtURL:modelUrl error:&error];
 
-  compiled_model_path_ = [compileUrl path];
+    if (error != nil) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Error compiling model: ",
+                             [[error localizedDescription] UTF8String]);
+    }
+
+    compiled_model_path_ = [compileUrl path];
+
+    if (compiled_model_cache_path_ != nil) {
+      // if another session added the same model first the move fails and we use our temporary copy
+      NSURL* cacheUrl = [NSURL fileURLWithPath:compiled_model_cache_path_ isDirectory:YES];
+      NSError* move_error = nil;
+      if ([file_manager moveItemAtURL:compileUrl toURL:cacheUrl error:&move_error]) {
+        compileUrl = cacheUrl;
+        compiled_model_path_ = nil;
+      } else {
+        LOGS(*logger_, WARNING) << "Failed to add the compiled model to the cache: "
+                                << [compiled_model_cache_path_ UTF8String] << ", error message: "
+                                << [[move_error localizedDescription] UTF8String];
+      }
+    }
+  }
 
   MLModelConfiguration* config = [MLModelConfiguration alloc];
   config.computeUnits = (coreml_flags_ & COREML_FLAG_USE_CPU_ONLY)
@@ -336,6 +371,11 @@ NS_ASSUME_NONNULL_BEGIN
                            (error != nil) ? MakeString(", error: ", [[error localizedDescription] UTF8String]) : "");
   }
 
+  if (compiled_model_cache_path_ != nil) {
+    // don't keep a second copy of the weights on disk for the lifetime of the session
+    [self removeModel];
+  }
+
   return Status::OK();
 }
 
@@ -435,7 +475,8 @@ namespace coreml {
 // This class will bridge Model (c++) with CoreMLExecution (objective c++)
 class Execution {
  public:
-  Execution(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags);
+  Execution(const std::string& path, const std::string& compiled_model_cache_path,
+            const logging::Logger& logger, uint32_t coreml_flags);
   ~Execution(){};
 
   Status LoadModel();
@@ -448,9 +489,11 @@ class Execution {
   CoreMLExecution* execution_;
 };
 
-Execution::Execution(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags) {
+Execution::Execution(const std::string& path, const std::string& compiled_model_cache_path,
+                     const logging::Logger& logger, uint32_t coreml_flags) {
   @autoreleasepool {
     execution_ = [[CoreMLExecution alloc] initWithPath:path
+                             compiled_model_cache_path:compiled_model_cache_path
                                                 logger:logger
                                           coreml_flags:coreml_flags];
   }
@@ -495,9 +538,10 @@ Model::Model(const std::string& path,
              std::unordered_map<std::string, OnnxTensorInfo>&& input_output_info,
              std::unordered_set<std::string>&& scalar_outputs,
              std::unordered_set<std::string>&& int64_outputs,
+             const std::string& compiled_model_cache_path,
              const logging::Logger& logger,
              uint32_t coreml_flags)
-    : execution_(std::make_unique<Execution>(path, logger, coreml_flags)),
+    : execution_(std::make_unique<Execution>(path, compiled_model_cache_path, logger, coreml_flags)),
       model_input_names_(std::move(model_input_names)),
       model_output_names_(std::move(model_output_names)),
       input_output_info_(std::move(input_output_info)),
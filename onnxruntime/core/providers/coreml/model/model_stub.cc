@@ -14,6 +14,7 @@ Model::Model(const std::string& /*path*/,
              std::unordered_map<std::string, OnnxTensorInfo>&& input_output_info,
              std::unordered_set<std::string>&& scalar_outputs,
              std::unordered_set<std::string>&& int64_outputs,
+             const std::string& /*compiled_model_cache_path*/,
              const logging::Logger& /*logger*/,
              uint32_t /*coreml_flags*/)
     : execution_(std::make_unique<Execution>()),
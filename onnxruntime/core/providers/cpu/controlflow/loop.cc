@@ -13,6 +13,7 @@
 #include "core/providers/cpu/controlflow/utils.h"
 
 #include "core/framework/allocator.h"
+#include "core/framework/device_stream_collection.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/session_state.h"
@@ -502,6 +503,11 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
 
   auto& iter_num_value = *iter_num_mlvalue_.GetMutable<Tensor>()->MutableData<int64_t>();
 
+#ifdef ORT_ENABLE_STREAM
+  // every iteration executes the subgraph on the same streams
+  DeviceStreamCollectionHolder device_stream_collection_holder(&session_state_);
+#endif
+
   while (iter_num_value < max_trip_count_ && *condition_mlvalue_.GetMutable<Tensor>()->MutableData<bool>()) {
     if (iter_num_value != 0) {
       SaveOutputsAndUpdateFeeds(fetches, feeds);
@@ -510,6 +516,9 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
 
     status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, {},
                                     ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger(),
+#ifdef ORT_ENABLE_STREAM
+                                    device_stream_collection_holder,
+#endif
                                     context_.GetComputeStream(),
                                     // because the fetch[0] is the loop condition which we need to access on CPU,
                                     // have to perofrm a stream sync to make sure the data arrived.
@@ -559,7 +568,8 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
         *output = std::move(*input.GetMutable<TensorSeq>());
       } else {
         // We can't move the Loop's inputs directly into the Loop's outputs
-        // as operator inputs are read-only. Hence, we need to make a copy.
+        // as operator inputs are read-only. The tensors of a sequence are read-only too, so they are shared
+        // unless they need to be copied to the device of the Loop's outputs.
         auto& data = input.Get<TensorSeq>();
         output->SetType(data.DataType());
         output->Reserve(data.Size());
@@ -567,6 +577,11 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
         AllocatorPtr alloc;
         ORT_RETURN_IF_ERROR(context_.GetTempSpaceAllocator(&alloc));
         for (auto it = data.begin(), end = data.end(); it != end; ++it) {
+          if (it->Get<Tensor>().Location().device == alloc->Info().device) {
+            output->Add(*it);
+            continue;
+          }
+
           Tensor tmp(it->Get<Tensor>().DataType(), it->Get<Tensor>().Shape(), alloc);
           // Safely use the IDataTransfer abstraction as we only allow using
           // Loop on CUDA if the copy stream is the same as the compute stream.
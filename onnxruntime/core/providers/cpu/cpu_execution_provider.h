@@ -5,12 +5,20 @@
 
 #include "core/framework/execution_provider.h"
 #include "core/graph/constants.h"
+#if !defined(ORT_MINIMAL_BUILD)
+#include "core/providers/cpu/tunable/cpu_tuning_context.h"
+#endif
 
 namespace onnxruntime {
 
 // Information needed to construct CPU execution providers.
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
+  // back the large buffers, e.g. the arena regions, with large pages. see LargePageCPUAllocator
+  bool use_large_pages{false};
+#if !defined(ORT_MINIMAL_BUILD)
+  cpu::tunable::CpuTunableOpInfo tunable_op{};
+#endif
 
   explicit CPUExecutionProviderInfo(bool use_arena)
       : create_arena(use_arena) {}
@@ -32,9 +40,16 @@ class CPUExecutionProvider : public IExecutionProvider {
   std::unique_ptr<IDataTransfer> GetDataTransfer() const override;
   std::vector<AllocatorPtr> CreatePreferredAllocators() override;
 
+#if !defined(ORT_MINIMAL_BUILD)
+  ITuningContext* GetTuningContext() const override;
+#endif
+
  private:
   CPUExecutionProviderInfo info_;
   std::vector<FuseRuleFn> fuse_rules_;
+#if !defined(ORT_MINIMAL_BUILD)
+  mutable cpu::tunable::CpuTuningContext tuning_context_;
+#endif
 };
 
 // Registers all available CPU kernels
@@ -2,6 +2,11 @@
 // Licensed under the MIT License.
 
 #include "einsum_typed_compute_processor.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "core/common/inlined_containers.h"
 #include "core/common/narrow.h"
 #include "core/common/span_utils.h"
 
@@ -332,6 +337,95 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   return output;
 }
 
+// The inputs are contracted one at a time into a running result. Every order gives the same result, but the cost of
+// each step is the product of the dims of the labels of the running result and of the input, so the order matters
+// for three or more inputs. Every order is costed for up to kMaxInputsForContractionOrderSearch inputs.
+static constexpr size_t kMaxInputsForContractionOrderSearch = 5;
+
+// Whether the subscript label needs to be kept until the input is contracted. The labels an input doesn't have are
+// homogenized to a dim of 1, as are broadcasted dims, and summing a label out before an input in which it's 1 is
+// exact. The last input a label appears in always keeps it, which reproduces the order of the equation.
+static bool InputHasLabel(const std::vector<TensorShape>& homogenized_input_dims,
+                          const std::vector<int64_t>& mapped_indices_to_last_input_index,
+                          size_t input, size_t label) {
+  return homogenized_input_dims[input][label] != 1 ||
+         mapped_indices_to_last_input_index[label] == static_cast<int64_t>(input);
+}
+
+// For each subscript label, the step of `order` after which it's summed out, or -1 if it appears in the output.
+static InlinedVector<int64_t> GetLabelToLastStep(const std::vector<TensorShape>& homogenized_input_dims,
+                                                 const std::vector<int64_t>& mapped_indices_to_last_input_index,
+                                                 gsl::span<const size_t> order) {
+  InlinedVector<int64_t> label_to_last_step(mapped_indices_to_last_input_index.size(), -1);
+  for (size_t label = 0; label < label_to_last_step.size(); ++label) {
+    if (mapped_indices_to_last_input_index[label] == -1) {
+      continue;
+    }
+    for (size_t step = 0; step < order.size(); ++step) {
+      if (InputHasLabel(homogenized_input_dims, mapped_indices_to_last_input_index, order[step], label)) {
+        label_to_last_step[label] = static_cast<int64_t>(step);
+      }
+    }
+  }
+  return label_to_last_step;
+}
+
+static InlinedVector<size_t> GetContractionOrder(const std::vector<TensorShape>& homogenized_input_dims,
+                                                 const std::vector<int64_t>& mapped_indices_to_last_input_index) {
+  const size_t num_inputs = homogenized_input_dims.size();
+  const size_t num_labels = mapped_indices_to_last_input_index.size();
+  InlinedVector<size_t> order(num_inputs);
+  std::iota(order.begin(), order.end(), size_t{0});
+  if (num_inputs < 3 || num_inputs > kMaxInputsForContractionOrderSearch) {
+    return order;
+  }
+
+  InlinedVector<double> label_dims(num_labels, 1.0);
+  for (const auto& dims : homogenized_input_dims) {
+    for (size_t label = 0; label < num_labels; ++label) {
+      label_dims[label] = std::max(label_dims[label], static_cast<double>(dims[label]));
+    }
+  }
+
+  auto cost_of = [&](gsl::span<const size_t> candidate) {
+    const auto label_to_last_step = GetLabelToLastStep(homogenized_input_dims, mapped_indices_to_last_input_index,
+                                                       candidate);
+    InlinedVector<bool> in_result(num_labels, false);
+    double cost = 0.0;
+    for (size_t step = 0; step < num_inputs; ++step) {
+      double step_cost = 1.0;
+      for (size_t label = 0; label < num_labels; ++label) {
+        in_result[label] = in_result[label] ||
+                           InputHasLabel(homogenized_input_dims, mapped_indices_to_last_input_index,
+                                         candidate[step], label);
+        if (in_result[label]) {
+          step_cost *= label_dims[label];
+        }
+        if (label_to_last_step[label] == static_cast<int64_t>(step)) {
+          in_result[label] = false;
+        }
+      }
+      if (step > 0) {
+        cost += step_cost;
+      }
+    }
+    return cost;
+  };
+
+  // the order of the equation wins ties
+  InlinedVector<size_t> candidate = order;
+  double best_cost = cost_of(order);
+  while (std::next_permutation(candidate.begin(), candidate.end())) {
+    const double cost = cost_of(candidate);
+    if (cost < best_cost) {
+      best_cost = cost;
+      order = candidate;
+    }
+  }
+
+  return order;
+}
+
 template <typename T>
 void EinsumTypedComputeProcessor<T>::SetDeviceHelpers(const EinsumOp::DeviceHelpers::Transpose& device_transpose_func,
                                                       const EinsumOp::DeviceHelpers::MatMul<T>& device_matmul_func,
@@ -357,6 +451,11 @@ Status EinsumTypedComputeProcessor<T>::Run() {
 
   auto num_inputs = context_->InputCount();
 
+  const auto order = GetContractionOrder(homogenized_input_dims, mapped_indices_to_last_input_index);
+  const auto label_to_last_step = GetLabelToLastStep(homogenized_input_dims, mapped_indices_to_last_input_index,
+                                                     order);
+  const size_t first = order[0];
+
   // Pre-process the first input so as to reduce any dims that only it has
   std::unique_ptr<const Tensor> result;
 
@@ -368,7 +467,7 @@ Status EinsumTypedComputeProcessor<T>::Run() {
     preserved_dims.reserve(onnxruntime::narrow<size_t>(num_subscript_labels));  // num_subscript_labels is the upper bound. No harm in over-reserving.
 
     for (size_t i = 0; i < onnxruntime::narrow<size_t>(num_subscript_labels); ++i) {
-      if (mapped_indices_to_last_input_index[i] == 0) {
+      if (label_to_last_step[i] == 0) {
         reduced_dims.push_back(i);
       } else {
         preserved_dims.push_back(i);
@@ -377,14 +476,14 @@ Status EinsumTypedComputeProcessor<T>::Run() {
 
     // Reduce the dims that are last seen in the first input alone
     if (reduced_dims.size() != 0) {
-      result = EinsumOp::ReduceSum<T>(preprocessed_inputs[0] ? *preprocessed_inputs[0] : *raw_inputs[0],
-                                      homogenized_input_dims[0].GetDims(), reduced_dims, allocator_, tp_,
+      result = EinsumOp::ReduceSum<T>(preprocessed_inputs[first] ? *preprocessed_inputs[first] : *raw_inputs[first],
+                                      homogenized_input_dims[first].GetDims(), reduced_dims, allocator_, tp_,
                                       einsum_ep_assets_, device_reduce_sum_func_);
     } else {
       // Check if there is a pre-processed version of this input
       // If so assign it to result
-      if (preprocessed_inputs[0]) {
-        result = std::move(preprocessed_inputs[0]);
+      if (preprocessed_inputs[first]) {
+        result = std::move(preprocessed_inputs[first]);
       }
     }
 
@@ -392,7 +491,7 @@ Status EinsumTypedComputeProcessor<T>::Run() {
     if (num_inputs == 1) {
       // Finalize the output by applying any transpose required to get
       // it to the required output ordering and move it to the op's output
-      FinalizeOutput(result ? *result : *raw_inputs[0], preserved_dims);
+      FinalizeOutput(result ? *result : *raw_inputs[first], preserved_dims);
 
       return Status::OK();
     }
@@ -402,21 +501,22 @@ Status EinsumTypedComputeProcessor<T>::Run() {
   {
     bool is_final_pair = false;
     // Keep processing each input pair-wise
-    for (int input = 1; input < num_inputs; ++input) {
+    for (int step = 1; step < num_inputs; ++step) {
+      const size_t input = order[step];
       TensorShapeVector reduced_dims;
       reduced_dims.reserve(onnxruntime::narrow<size_t>(num_subscript_labels));  // num_subscript_labels is the upper bound. No harm in over-reserving by a small margin.
       for (int64_t dim = 0; dim < num_subscript_labels; ++dim) {
-        if (mapped_indices_to_last_input_index[onnxruntime::narrow<size_t>(dim)] == input) {
+        if (label_to_last_step[onnxruntime::narrow<size_t>(dim)] == step) {
           // This is the last input we are seeing this dimension (and it doesn't occur in the output), so reduce along the dimension
           reduced_dims.push_back(dim);
         }
       }
-      if (input == num_inputs - 1) {
+      if (step == num_inputs - 1) {
         is_final_pair = true;
       }
       // Use either the preprocessed inputs (if it is available) or the corresponding raw inputs
-      result = PairwiseOperandProcess(result ? *result : *raw_inputs[0],
-                                      result ? result->Shape() : homogenized_input_dims[0],
+      result = PairwiseOperandProcess(result ? *result : *raw_inputs[first],
+                                      result ? result->Shape() : homogenized_input_dims[first],
                                       preprocessed_inputs[input] ? *preprocessed_inputs[input] : *raw_inputs[input],
                                       homogenized_input_dims[input],
                                       reduced_dims, is_final_pair);
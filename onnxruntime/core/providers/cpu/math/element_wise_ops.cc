@@ -13,6 +13,7 @@
 #include "core/mlas/inc/mlas.h"
 
 #include <cmath>
+#include <functional>
 
 namespace onnxruntime {
 // Supported types for operators that have type reduction enabled
@@ -2038,4 +2039,83 @@ static void UntypedBroadcastVariadic(int input_count, OpKernelContext& context,
   }
 }
 
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+namespace {
+
+// Half precision arithmetic for Add, Sub, Mul and Div. Eigen::half uses the fp16 vector instructions of the targets
+// that define MLAS_F16VEC_INTRINSICS_SUPPORTED, so the values are not widened to float.
+template <typename Op>
+void BroadcastMLFloat16Arithmetic(OpKernelContext& context) {
+  ProcessBroadcastSpanFuncs funcs{
+      [](BroadcastHelper& per_iter_bh) {
+        const auto num_elements = per_iter_bh.NumOutputElements();
+        ConstEigenVectorArrayMap<Eigen::half> input_1(
+            reinterpret_cast<const Eigen::half*>(per_iter_bh.EigenInput1<MLFloat16>().data()), num_elements);
+        EigenVectorArrayMap<Eigen::half> output(
+            reinterpret_cast<Eigen::half*>(per_iter_bh.OutputEigen<MLFloat16>().data()), num_elements);
+        output = Op{}(static_cast<Eigen::half>(per_iter_bh.ScalarInput0<MLFloat16>()), input_1);
+      },
+      [](BroadcastHelper& per_iter_bh) {
+        const auto num_elements = per_iter_bh.NumOutputElements();
+        ConstEigenVectorArrayMap<Eigen::half> input_0(
+            reinterpret_cast<const Eigen::half*>(per_iter_bh.EigenInput0<MLFloat16>().data()), num_elements);
+        EigenVectorArrayMap<Eigen::half> output(
+            reinterpret_cast<Eigen::half*>(per_iter_bh.OutputEigen<MLFloat16>().data()), num_elements);
+        output = Op{}(input_0, static_cast<Eigen::half>(per_iter_bh.ScalarInput1<MLFloat16>()));
+      },
+      [](BroadcastHelper& per_iter_bh) {
+        const auto num_elements = per_iter_bh.NumOutputElements();
+        ConstEigenVectorArrayMap<Eigen::half> input_0(
+            reinterpret_cast<const Eigen::half*>(per_iter_bh.EigenInput0<MLFloat16>().data()), num_elements);
+        ConstEigenVectorArrayMap<Eigen::half> input_1(
+            reinterpret_cast<const Eigen::half*>(per_iter_bh.EigenInput1<MLFloat16>().data()), num_elements);
+        EigenVectorArrayMap<Eigen::half> output(
+            reinterpret_cast<Eigen::half*>(per_iter_bh.OutputEigen<MLFloat16>().data()), num_elements);
+        output = Op{}(input_0, input_1);
+      }};
+
+  UntypedBroadcastTwo(context, funcs, 1.0);
+}
+
+}  // namespace
+
+template <>
+Status Add<MLFloat16>::Compute(OpKernelContext* context) const {
+  BroadcastMLFloat16Arithmetic<std::plus<>>(*context);
+  return Status::OK();
+}
+
+template <>
+Status Sub<MLFloat16>::Compute(OpKernelContext* context) const {
+  BroadcastMLFloat16Arithmetic<std::minus<>>(*context);
+  return Status::OK();
+}
+
+template <>
+Status Mul<MLFloat16>::Compute(OpKernelContext* context) const {
+  BroadcastMLFloat16Arithmetic<std::multiplies<>>(*context);
+  return Status::OK();
+}
+
+template <>
+Status Div<MLFloat16>::Compute(OpKernelContext* context) const {
+  BroadcastMLFloat16Arithmetic<std::divides<>>(*context);
+  return Status::OK();
+}
+
+// These are added to the kernel registry by RegisterFp16Kernels, only if MlasFp16AccelerationSupported().
+REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, MLFloat16, Add);
+REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, MLFloat16, Add);
+REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, MLFloat16, Add);
+REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, MLFloat16, Sub);
+REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, MLFloat16, Sub);
+REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, MLFloat16, Sub);
+REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, MLFloat16, Mul);
+REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, MLFloat16, Mul);
+REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, MLFloat16, Mul);
+REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, MLFloat16, Div);
+REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, MLFloat16, Div);
+REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, MLFloat16, Div);
+#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
+
 }  // namespace onnxruntime
@@ -4,6 +4,9 @@
 #include "core/providers/cpu/math/matmul.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/providers/cpu/math/matmul_helper.h"
+#if !defined(ORT_MINIMAL_BUILD)
+#include "core/providers/cpu/tunable/cpu_tunable.h"
+#endif
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
@@ -124,7 +127,76 @@ Status MatMul<T>::Compute(OpKernelContext* ctx) const {
 
   return Status::OK();
 }
-#if defined(__aarch64__) && defined(__linux__)
+
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+template <>
+Status MatMul<MLFloat16>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const auto* a = ctx->Input<Tensor>(0);
+  const auto* b = ctx->Input<Tensor>(1);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  auto* y_data = y->MutableData<MLFloat16>();
+  if (helper.K() == 0) {
+    std::fill_n(y_data, y->Shape().Size(), MLFloat16::Zero);
+    return Status::OK();
+  }
+
+  const auto* a_data = a->Data<MLFloat16>();
+  const auto* b_data = b->Data<MLFloat16>();
+
+  const size_t max_len = helper.OutputOffsets().size();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  std::vector<MLAS_HALF_GEMM_DATA_PARAMS> data(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    data[i].A = a_data + helper.LeftOffsets()[i];
+    data[i].lda = K;
+    data[i].B = b_data + helper.RightOffsets()[i];
+    data[i].ldb = N;
+    data[i].C = y_data + helper.OutputOffsets()[i];
+    data[i].ldc = N;
+  }
+  MlasHalfGemmBatch(M, N, K, max_len, data.data(), thread_pool);
+
+  return Status::OK();
+}
+
+// These are added to the kernel registry by RegisterFp16Kernels, only if MlasFp16AccelerationSupported().
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    1, 8,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    9,
+    12,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
+
+#if defined(MLAS_SBGEMM_SUPPORTED)
 bool GemmPackBBfloat16(AllocatorPtr& alloc,
                        const Tensor& tensor_b,
                        bool trans_b,
@@ -163,6 +235,104 @@ bool GemmPackBBfloat16(AllocatorPtr& alloc,
 }
 #endif
 
+bool GemmPackBSparse24(AllocatorPtr& alloc,
+                       const Tensor& tensor_b,
+                       bool trans_b,
+                       IAllocatorUniquePtr<void>& packed_b,
+                       size_t& packed_b_size,
+                       TensorShape& b_shape) {
+  if (tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+
+  const TensorShape& shape = tensor_b.Shape();
+  const size_t K = trans_b ? static_cast<size_t>(shape[1]) : static_cast<size_t>(shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(shape[0]) : static_cast<size_t>(shape[1]);
+
+  size_t size = MlasSparse24GemmPackBSize(N, K);
+  if (size == 0) {
+    return false;
+  }
+
+  // every byte of the buffer is written, so its hash used for sharing it between sessions is stable
+  auto buffer = IAllocator::MakeUniquePtr<void>(alloc, size, true);
+  if (!MlasSparse24GemmPackB(trans_b ? CblasTrans : CblasNoTrans,
+                             N,
+                             K,
+                             tensor_b.Data<float>(),
+                             trans_b ? K : N,
+                             buffer.get())) {
+    return false;
+  }
+
+  b_shape = shape;
+  packed_b = std::move(buffer);
+  packed_b_size = size;
+  return true;
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+namespace {
+
+struct SgemmBatchParams : cpu::tunable::OpParams {
+  SgemmBatchParams(cpu::tunable::CpuTuningContext* tuning_ctx, concurrency::ThreadPool* tp)
+      : OpParams(tuning_ctx, nullptr), thread_pool(tp) {}
+
+  std::string Signature() const override {
+    // The winner depends on the number of threads as much as on the shape.
+    return MakeString(trans_a == CblasTrans ? "T" : "N", trans_b == CblasTrans ? "T" : "N", "_", M, "_", N, "_", K,
+                      "_", batch_size, b_is_packed ? "_packed" : "", "_dop",
+                      concurrency::ThreadPool::DegreeOfParallelism(thread_pool));
+  }
+
+  CBLAS_TRANSPOSE trans_a;
+  CBLAS_TRANSPOSE trans_b;
+  size_t M;
+  size_t N;
+  size_t K;
+  const MLAS_SGEMM_DATA_PARAMS* data;
+  size_t batch_size;
+  bool b_is_packed;
+  concurrency::ThreadPool* thread_pool;
+};
+
+// Chooses how a batch of SGEMMs is spread over the intra-op thread pool.
+class SgemmBatchTunableOp : public cpu::tunable::TunableOp<SgemmBatchParams> {
+ public:
+  SgemmBatchTunableOp() {
+    // MLAS partitions every GEMM of the batch over the thread pool. This is the default.
+    RegisterOp([](const SgemmBatchParams* params) {
+      MlasGemmBatch(params->trans_a, params->trans_b, params->M, params->N, params->K,
+                    params->data, params->batch_size, params->thread_pool);
+      return Status::OK();
+    });
+
+    // A single thread, for shapes too small to amortize waking up the thread pool.
+    RegisterOp([](const SgemmBatchParams* params) {
+      TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(
+          concurrency::ThreadPool::DegreeOfParallelism(params->thread_pool) <= 1, "single threaded already");
+      MlasGemmBatch(params->trans_a, params->trans_b, params->M, params->N, params->K,
+                    params->data, params->batch_size, nullptr);
+      return Status::OK();
+    });
+
+    // One thread per GEMM of the batch, which avoids splitting small GEMMs into even smaller tiles.
+    RegisterOp([](const SgemmBatchParams* params) {
+      TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(
+          concurrency::ThreadPool::DegreeOfParallelism(params->thread_pool) <= 1 || params->batch_size <= 1,
+          "a batch spread over multiple threads is needed");
+      concurrency::ThreadPool::TrySimpleParallelFor(
+          params->thread_pool, static_cast<std::ptrdiff_t>(params->batch_size), [params](std::ptrdiff_t i) {
+            MlasGemm(params->trans_a, params->trans_b, params->M, params->N, params->K, params->data[i], nullptr);
+          });
+      return Status::OK();
+    });
+  }
+};
+
+}  // namespace
+#endif
+
 Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ AllocatorPtr alloc,
                               /*out*/ bool& is_packed,
                               /*out*/ PrePackedWeights* prepacked_weights) {
@@ -171,7 +341,7 @@ Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ Alloc
   // only pack Matrix B
   if (input_idx == 1) {
     size_t packed_b_size;
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
     size_t dim1 = 0;
     size_t dim2 = 0;
     TensorShape b_shape = tensor.Shape();
@@ -180,7 +350,14 @@ Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ Alloc
       dim1 = static_cast<size_t>(b_shape[0]);
       dim2 = static_cast<size_t>(b_shape[1]);
     }
+#endif
 
+    if (use_sparse24_gemm_ &&
+        GemmPackBSparse24(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_)) {
+      is_packed = true;
+      b_is_sparse24_packed_ = true;
+    } else
+#if defined(MLAS_SBGEMM_SUPPORTED)
     if (use_fastmath_mode_ && (trans_b_attr_ == 0) && ((dim1 * dim2) >= kFastMathModeKernelsizeThreshold)) {
       is_packed = GemmPackBBfloat16(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
     } else
@@ -240,7 +417,17 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const size_t K = static_cast<size_t>(helper.K());
   const size_t lda = helper.Lda(trans_a);
   const size_t ldb = helper.Ldb(trans_b);
-#if defined(__aarch64__) && defined(__linux__)
+
+  if (b_is_sparse24_packed_) {
+    for (size_t i = 0; i < max_len; i++) {
+      MlasSparse24Gemm(trans_a ? CblasTrans : CblasNoTrans, M, N, K, alpha_attr_,
+                       a_data + helper.LeftOffsets()[i], lda, packed_b_.get(),
+                       y_data + helper.OutputOffsets()[i], N, thread_pool);
+    }
+    return Status::OK();
+  }
+
+#if defined(MLAS_SBGEMM_SUPPORTED)
   if (use_fastmath_mode_ && !trans_b && ((N * K) >= kFastMathModeKernelsizeThreshold)) {
     std::vector<MLAS_SBGEMM_DATA_PARAMS> data(max_len);
     for (size_t i = 0; i < max_len; i++) {
@@ -259,9 +446,18 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   } else
 #endif
   {
+    const float* const* b_numa_replicas = nullptr;
+    if (numa_replicate_packed_b_ && packed_b_) {
+      std::call_once(packed_b_replicas_once_, [&]() {
+        packed_b_replicas_.Replicate(packed_b_.get(), MlasGemmPackBSize(N, K), thread_pool);
+      });
+      b_numa_replicas = reinterpret_cast<const float* const*>(packed_b_replicas_.Replicas());
+    }
+
     std::vector<MLAS_SGEMM_DATA_PARAMS> data(max_len);
     for (size_t i = 0; i < max_len; i++) {
       data[i].BIsPacked = bool(packed_b_);
+      data[i].BNumaReplicas = b_numa_replicas;
       data[i].A = a_data + helper.LeftOffsets()[i];
       data[i].lda = lda;
       data[i].B = data[i].BIsPacked ? (float*)packed_b_.get() : b_data + helper.RightOffsets()[i];
@@ -271,6 +467,23 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
       data[i].alpha = alpha_attr_;
       data[i].beta = 0.0f;
     }
+#if !defined(ORT_MINIMAL_BUILD)
+    auto* tuning_ctx = cpu::tunable::GetTuningContext(Info());
+    if (tuning_ctx != nullptr && tuning_ctx->IsTunableOpEnabled()) {
+      static SgemmBatchTunableOp sgemm_batch_op;
+
+      SgemmBatchParams params(tuning_ctx, thread_pool);
+      params.trans_a = trans_a ? CblasTrans : CblasNoTrans;
+      params.trans_b = trans_b ? CblasTrans : CblasNoTrans;
+      params.M = M;
+      params.N = N;
+      params.K = K;
+      params.data = data.data();
+      params.batch_size = max_len;
+      params.b_is_packed = bool(packed_b_);
+      return sgemm_batch_op(&params);
+    }
+#endif
     MlasGemmBatch(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
                   M, N, K, data.data(), max_len, thread_pool);
   }
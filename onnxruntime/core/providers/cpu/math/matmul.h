@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <mutex>
+
+#include "core/framework/numa_replicated_buffer.h"
 #include "core/framework/op_kernel.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
@@ -30,10 +33,17 @@ class MatMul<float> final : public OpKernel {
     trans_batch_a_ = trans_batch_a_attr != 0;
     trans_batch_b_ = trans_batch_b_attr != 0;
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
+#if defined(__aarch64__)
     auto config_ops = info.GetConfigOptions().GetConfigEntry(kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16);
+#else
+    auto config_ops = info.GetConfigOptions().GetConfigEntry(kOrtSessionOptionsMlasGemmFastMathX64Bfloat16);
+#endif
     use_fastmath_mode_ = (config_ops == "1") && MlasBf16AccelerationSupported();
 #endif
+    use_sparse24_gemm_ = info.GetConfigOptions().GetConfigEntry(kOrtSessionOptionsMlasSparse24Gemm) == "1";
+    numa_replicate_packed_b_ =
+        info.GetConfigOptions().GetConfigEntry(kOrtSessionOptionsConfigNumaReplicatePrepackedWeights) == "1";
   }
 
   Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
@@ -49,6 +59,15 @@ class MatMul<float> final : public OpKernel {
   TensorShape b_shape_;
   IAllocatorUniquePtr<void> packed_b_;
 
+  // sparse weight GEMM state, packed_b_ holds the non-zero elements of B if B has 2:4 sparsity
+  bool use_sparse24_gemm_;
+  bool b_is_sparse24_packed_{false};
+
+  // copies of packed_b_ for the NUMA nodes of the intra op thread pool, made by the first Compute
+  bool numa_replicate_packed_b_;
+  mutable std::once_flag packed_b_replicas_once_;
+  mutable NumaReplicatedBuffer packed_b_replicas_;
+
   // For FusedMatMul contrib ops
   float alpha_attr_;
   int64_t trans_a_attr_;
@@ -56,11 +75,11 @@ class MatMul<float> final : public OpKernel {
   bool trans_batch_a_;
   bool trans_batch_b_;
 
-#if defined(__aarch64__) && defined(__linux__)
+#if defined(MLAS_SBGEMM_SUPPORTED)
   // fastmath mode state
   bool use_fastmath_mode_;
-  // sbgemm kernel is implemented as 8x8 blocks with weights pre-packed to 4 blocks of 4x2
-  // so a minimum of 32 elements is defined to outweigh the additional prepacking overhead
+  // sbgemm kernels work on blocks of pre-packed weights (4 blocks of 4x2 on arm64, 16 column
+  // panels on x64), so a minimum of 32 elements is defined to outweigh the additional prepacking overhead
   const size_t kFastMathModeKernelsizeThreshold = 32;
 #endif
 };
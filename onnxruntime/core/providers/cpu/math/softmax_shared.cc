@@ -23,10 +23,12 @@
 #include <algorithm>
 #include <cmath>
 #include <gsl/gsl>
+#include <vector>
 
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 template <typename T>
@@ -103,4 +105,29 @@ common::Status SoftmaxCPU<float>(size_t N,
   return Status::OK();
 }
 
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+template <>
+common::Status SoftmaxCPU<MLFloat16>(size_t N,
+                                     size_t D,
+                                     const MLFloat16* Xdata,
+                                     MLFloat16* Ydata,
+                                     bool logarithmic,
+                                     onnxruntime::concurrency::ThreadPool* thread_pool) {
+  // The exponentials and the row sums are computed in float, a block of rows at a time.
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(N),
+      TensorOpCost{static_cast<double>(D * sizeof(MLFloat16)), static_cast<double>(D * sizeof(MLFloat16)),
+                   static_cast<double>(D * 10)},
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        std::vector<float> buffer(static_cast<size_t>(end - begin) * D);
+        const size_t count = buffer.size();
+        MlasConvertHalfToFloatBuffer(&Xdata[begin * D].val, buffer.data(), count);
+        MlasComputeSoftmax(buffer.data(), buffer.data(), static_cast<size_t>(end - begin), D, logarithmic, nullptr);
+        MlasConvertFloatToHalfBuffer(buffer.data(), &Ydata[begin * D].val, count);
+      });
+
+  return Status::OK();
+}
+#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
+
 }  // namespace onnxruntime
@@ -140,6 +140,58 @@ static void SelectTopK(const Comparator& comparer,
   // the data_holder now contains the indices of the top k elements in the first k elements
 }
 
+// Rows of contiguous elements at least this long are filtered before selecting the top k from them.
+// See SelectTopKFromCandidates.
+constexpr int64_t kMinBlocksForCandidateFilter = 4096;
+constexpr size_t kCandidateFilterSampleSize = 1024;
+
+// Selects the top k elements of a contiguous row like SelectTopK, but only from the candidates that can be in the
+// top k. The threshold is a value estimated from an evenly spaced sample of the row to be beaten by more than k
+// elements, and the elements the threshold beats are dropped in a single branchless pass. Returns false if fewer than
+// k elements are left, in which case SelectTopK needs to be used.
+template <class Comparator>
+static bool SelectTopKFromCandidates(const Comparator& comparer, const typename Comparator::DataType* input_data,
+                                     int64_t row_offset, int64_t num_blocks, const unsigned k, bool sort_top_k,
+                                     std::vector<typename Comparator::DataType>& sample,
+                                     std::vector<int64_t>& data_holder) {
+  using T = typename Comparator::DataType;
+  const T* row = input_data + row_offset;
+  const auto n = onnxruntime::narrow<size_t>(num_blocks);
+
+  // the rank in the sample of the expected k-th value, plus 4 standard deviations
+  const double expected_rank = static_cast<double>(k) * kCandidateFilterSampleSize / static_cast<double>(n);
+  const auto rank = static_cast<size_t>(expected_rank + 4 * std::sqrt(expected_rank)) + 1;
+  if (rank >= kCandidateFilterSampleSize) {
+    return false;
+  }
+
+  const size_t stride = n / kCandidateFilterSampleSize;
+  sample.resize(kCandidateFilterSampleSize);
+  for (size_t l = 0; l < kCandidateFilterSampleSize; ++l) {
+    sample[l] = row[l * stride];
+  }
+  std::nth_element(sample.begin(), sample.begin() + rank, sample.end(),
+                   [&comparer](const T& lhs, const T& rhs) { return comparer.CompareValueOnly(lhs, rhs); });
+  const T threshold = sample[rank];
+
+  size_t num_candidates = 0;
+  for (size_t l = 0; l < n; ++l) {
+    data_holder[num_candidates] = row_offset + static_cast<int64_t>(l);
+    num_candidates += comparer.CompareValueOnly(threshold, row[l]) ? 0 : 1;
+  }
+  if (num_candidates < k) {
+    return false;
+  }
+
+  std::nth_element(data_holder.begin(), data_holder.begin() + (k - 1), data_holder.begin() + num_candidates,
+                   comparer);
+  if (sort_top_k) {
+    std::sort(data_holder.begin(), data_holder.begin() + k, comparer);
+  }
+
+  return true;
+}
+
 // Given an input tensor 'input' and metadata values - 'k' and 'axis_parsed',
 // this method will extract the sorted top k largest/smallest elements and place them in the output tensor 'values'
 // along with the metadata output 'indices'
@@ -295,11 +347,17 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
           // we re-use a single data_holder for performance. avoids allocating memory on each iteration.
           // the call to SelectTopK overwrites any existing data so we don't need to clear on each iteration.
           std::vector<int64_t> data_holder(onnxruntime::narrow<size_t>(num_blocks));
+          std::vector<typename Comparator::DataType> sample;
+          const bool filter_candidates = block_slice == 1 && num_blocks >= kMinBlocksForCandidateFilter;
 
           for (auto i = work.start; i < work.end; ++i) {
             auto row_offset = i * cols;
             for (int64_t j = 0; j < block_slice; ++j) {
-              SelectTopK<Comparator>(comparer, row_offset, num_blocks, block_slice, j, k, sorted, data_holder);
+              if (!filter_candidates ||
+                  !SelectTopKFromCandidates<Comparator>(comparer, input_data, row_offset, num_blocks, k, sorted,
+                                                        sample, data_holder)) {
+                SelectTopK<Comparator>(comparer, row_offset, num_blocks, block_slice, j, k, sorted, data_holder);
+              }
 
               // Insert the top 'k' (largest or smallest) elements into the final output buffers
               for (int64_t l = 0; l < k; ++l) {
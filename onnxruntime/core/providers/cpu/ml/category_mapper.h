@@ -26,11 +26,12 @@ class CategoryMapper final : public OpKernel {
 
     ORT_ENFORCE(num_entries == int_categories.size());
 
+    packed_strings_.Assign(string_categories);
     string_to_int_map_.reserve(num_entries);
     int_to_string_map_.reserve(num_entries);
 
     for (size_t i = 0; i < num_entries; ++i) {
-      const std::string& str = string_categories[i];
+      const std::string_view str = packed_strings_[i];
       int64_t index = int_categories[i];
 
       string_to_int_map_[str] = index;
@@ -41,8 +42,10 @@ class CategoryMapper final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  std::unordered_map<std::string, int64_t> string_to_int_map_;
-  std::unordered_map<int64_t, std::string> int_to_string_map_;
+  // Both maps refer to the strings in packed_strings_
+  PackedStrings packed_strings_;
+  InlinedHashMap<std::string_view, int64_t> string_to_int_map_;
+  InlinedHashMap<int64_t, std::string_view> int_to_string_map_;
 
   std::string default_string_;
   int64_t default_int_;
@@ -24,11 +24,12 @@ class LabelEncoder final : public OpKernel {
 
     auto num_entries = string_classes.size();
 
+    packed_strings_.Assign(string_classes);
     string_to_int_map_.reserve(num_entries);
     int_to_string_map_.reserve(num_entries);
 
     for (size_t i = 0; i < num_entries; ++i) {
-      const std::string& str = string_classes[i];
+      const std::string_view str = packed_strings_[i];
 
       string_to_int_map_[str] = i;
       int_to_string_map_[i] = str;
@@ -38,8 +39,10 @@ class LabelEncoder final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  std::unordered_map<std::string, int64_t> string_to_int_map_;
-  std::unordered_map<int64_t, std::string> int_to_string_map_;
+  // Both maps refer to the strings in packed_strings_
+  PackedStrings packed_strings_;
+  InlinedHashMap<std::string_view, int64_t> string_to_int_map_;
+  InlinedHashMap<int64_t, std::string_view> int_to_string_map_;
 
   std::string default_string_;
   int64_t default_int_;
@@ -72,16 +75,11 @@ class LabelEncoder_2 final : public OpKernel {
     const TensorShape& shape = X->Shape();
     auto* Y = context->Output(0, shape);
 
-    auto input = X->template DataAsSpan<TKey>();
-    auto output = Y->template MutableDataAsSpan<TValue>();
-    auto input_iter = input.begin();
-    auto output_iter = output.begin();
-    while (input_iter != input.end()) {
-      const auto found = map_.find(*input_iter);
-      *output_iter = found == map_.end() ? default_value_ : found->second;
-      ++output_iter;
-      ++input_iter;
-    }
+    ParallelLookup(context->GetOperatorThreadPool(), X->template DataAsSpan<TKey>(),
+                   Y->template MutableDataAsSpan<TValue>(), [this](const TKey& key, TValue& value) {
+                     const auto found = map_.find(key);
+                     value = found == map_.end() ? default_value_ : found->second;
+                   });
     return Status::OK();
   }
 
@@ -202,6 +200,7 @@ class LabelEncoder_4 final : public OpKernel {
     auto keys = GetAttribute<TKey>(kernel_info, key_field_name_, "keys_tensor");
     auto values = GetAttribute<TValue>(kernel_info, value_field_name_, "values_tensor");
     ORT_ENFORCE(keys.size() == values.size(), "Keys and values must have the same length.");
+    map_.reserve(keys.size());
     for (size_t i = 0; i < keys.size(); ++i) {
       map_.emplace(keys[i], values[i]);
     }
@@ -211,16 +210,11 @@ class LabelEncoder_4 final : public OpKernel {
     const TensorShape& shape = X->Shape();
     auto* Y = context->Output(0, shape);
 
-    auto input = X->template DataAsSpan<TKey>();
-    auto output = Y->template MutableDataAsSpan<TValue>();
-    auto input_iter = input.begin();
-    auto output_iter = output.begin();
-    while (input_iter != input.end()) {
-      const auto found = map_.find(*input_iter);
-      *output_iter = found == map_.end() ? default_value_ : found->second;
-      ++output_iter;
-      ++input_iter;
-    }
+    ParallelLookup(context->GetOperatorThreadPool(), X->template DataAsSpan<TKey>(),
+                   Y->template MutableDataAsSpan<TValue>(), [this](const TKey& key, TValue& value) {
+                     const auto found = map_.find(key);
+                     value = found == map_.end() ? default_value_ : found->second;
+                   });
     return Status::OK();
   }
 
@@ -60,13 +60,17 @@ void LinearClassifier::ComputeImpl(const gsl::span<const float> input,
               "Scores output is incorrect size. Expected:", scores_output_size,
               " Found:", scores_output_data.size());
 
-  TensorShape intercepts_shape({num_targets});
-  onnxruntime::Gemm<float>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
-                                        num_batches, num_targets, num_features,
-                                        1.f, input_data, coefficients.data(), 1.f,
-                                        intercepts.data(), &intercepts_shape,
-                                        scores_output_data.data(),
-                                        threadpool);
+  // high dimensional inputs such as one-hot encoded or hashed features are mostly zeros
+  if (!TryComputeGemmWithSparseA(input_data, coefficients.data(), num_batches, num_targets, num_features, 1.f,
+                                 intercepts.data(), intercepts.size(), scores_output_data.data(), threadpool)) {
+    TensorShape intercepts_shape({num_targets});
+    onnxruntime::Gemm<float>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                                          num_batches, num_targets, num_features,
+                                          1.f, input_data, coefficients.data(), 1.f,
+                                          intercepts.data(), &intercepts_shape,
+                                          scores_output_data.data(),
+                                          threadpool);
+  }
 
   float* score = scores_output_data.data();
   float* end_scores = score + (num_batches * num_targets);  // we haven't added extra targets yet so iterate the original scores
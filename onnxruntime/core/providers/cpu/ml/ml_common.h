@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include "core/common/common.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
@@ -524,5 +527,105 @@ void batched_update_scores_inplace(gsl::span<T> scores, int64_t num_batches_in,
     }
   }
 }
+// Computes out = alpha * a * b^T + c, like Gemm<T>::ComputeGemm with CblasNoTrans and CblasTrans, when most of the
+// elements of `a` are zeros. Only the columns of `b` matching the non zero elements of `a` are read, so the cost is
+// O(nnz * n) instead of O(m * n * k).
+// a: [m, k], b: [n, k], out: [m, n], c is nullptr, a scalar or one value per column of `out` (c_size 0, 1 or n).
+// Returns false without writing to `out` if `a` is too dense for this to be faster than the dense GEMM.
+template <typename T>
+bool TryComputeGemmWithSparseA(const T* a, const T* b, ptrdiff_t m, ptrdiff_t n, ptrdiff_t k, T alpha,
+                               const T* c, size_t c_size, T* out, concurrency::ThreadPool* threadpool) {
+  // Every non zero element reads n elements of b which are k apart, while the dense GEMM streams b.
+  // 1 non zero element out of 16 is roughly where both cost the same.
+  constexpr size_t kMinZerosPerNonZero = 16;
+  const size_t size = SafeInt<size_t>(m) * k;
+  const size_t max_non_zeros = size / kMinZerosPerNonZero;
+  size_t non_zeros = 0;
+  for (size_t i = 0; i < size; ++i) {
+    if (a[i] != T{0} && ++non_zeros > max_non_zeros) {
+      return false;
+    }
+  }
+
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, m,
+      TensorOpCost{static_cast<double>(k * sizeof(T)), static_cast<double>(n * sizeof(T)), static_cast<double>(k)},
+      [a, b, n, k, alpha, c, c_size, out](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const T* a_row = a + row * k;
+          T* out_row = out + row * n;
+          for (ptrdiff_t j = 0; j < n; ++j) {
+            out_row[j] = c_size == 0 ? T{0} : c[c_size == 1 ? 0 : j];
+          }
+
+          for (ptrdiff_t feature = 0; feature < k; ++feature) {
+            if (a_row[feature] != T{0}) {
+              const T value = alpha * a_row[feature];
+              const T* b_column = b + feature;
+              for (ptrdiff_t j = 0; j < n; ++j) {
+                out_row[j] += value * b_column[j * k];
+              }
+            }
+          }
+        }
+      });
+
+  return true;
+}
+
+// Writes lookup(input[i], output[i]) for every element. Lookups into a kernel's tables are read only and
+// independent, so large inputs are split across the thread pool.
+template <typename TIn, typename TOut, typename Lookup>
+void ParallelLookup(concurrency::ThreadPool* threadpool, gsl::span<const TIn> input, gsl::span<TOut> output,
+                    Lookup&& lookup) {
+  constexpr bool has_strings = std::is_same_v<TIn, std::string> || std::is_same_v<TOut, std::string>;
+  const TensorOpCost cost{static_cast<double>(sizeof(TIn)), static_cast<double>(sizeof(TOut)),
+                          has_strings ? 64.0 : 16.0};
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, static_cast<std::ptrdiff_t>(input.size()), cost,
+      [&input, &output, &lookup](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (auto i = static_cast<size_t>(first), end = static_cast<size_t>(last); i < end; ++i) {
+          lookup(input[i], output[i]);
+        }
+      });
+}
+
+// Stores strings back to back in one byte buffer with their start offsets. Lookup tables keyed by the strings
+// hold std::string_view keys into the buffer instead of one heap allocated std::string per entry, which keeps
+// them compact and avoids chasing a pointer per key.
+class PackedStrings {
+ public:
+  PackedStrings() = default;
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PackedStrings);
+
+  // Replaces the contents. Views returned before are invalidated.
+  void Assign(gsl::span<const std::string> strings) {
+    size_t total_bytes = 0;
+    for (const auto& s : strings) {
+      total_bytes += s.size();
+    }
+
+    bytes_.clear();
+    bytes_.reserve(total_bytes);
+    offsets_.clear();
+    offsets_.reserve(strings.size() + 1);
+    offsets_.push_back(0);
+    for (const auto& s : strings) {
+      bytes_.append(s);
+      offsets_.push_back(bytes_.size());
+    }
+  }
+
+  size_t size() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+
+  std::string_view operator[](size_t i) const {
+    return std::string_view(bytes_.data() + offsets_[i], offsets_[i + 1] - offsets_[i]);
+  }
+
+ private:
+  std::string bytes_;
+  InlinedVector<size_t> offsets_;
+};
+
 }  // namespace ml
 }  // namespace onnxruntime
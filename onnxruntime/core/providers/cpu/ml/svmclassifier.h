@@ -73,12 +73,15 @@ class SVMCommon {
         c = coef0_;
       }
 
-      onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
-                                        m, n, k,
-                                        alpha, a.data(), b.data(), beta,
-                                        c != 0.f ? &c : nullptr, &shape_C,
-                                        out.data(),
-                                        threadpool);
+      if (!TryComputeGemmWithSparseA(a.data(), b.data(), m, n, k, static_cast<T>(alpha),
+                                     c != 0.f ? &c : nullptr, c != 0.f ? 1 : 0, out.data(), threadpool)) {
+        onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                                          m, n, k,
+                                          alpha, a.data(), b.data(), beta,
+                                          c != 0.f ? &c : nullptr, &shape_C,
+                                          out.data(),
+                                          threadpool);
+      }
 
       if (kernel_type_ == KERNEL::POLY) {
         auto map_out = EigenVectorArrayMap<T>(out.data(), out.size());
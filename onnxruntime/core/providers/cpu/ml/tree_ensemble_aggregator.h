@@ -103,6 +103,14 @@ struct TreeNodeElement {
   inline bool is_missing_track_true() const { return flags & MissingTrack::kTrue; }
 };
 
+// Node of a complete binary tree stored in breadth first order: the children of the node at index i are at
+// 2 * i + 1 when the condition is true and 2 * i + 2 otherwise. See TreeEnsembleCommon::compact_nodes_.
+template <typename T>
+struct CompactTreeNode {
+  T threshold;
+  int32_t feature_id;
+};
+
 template <typename InputType, typename ThresholdType, typename OutputType>
 class TreeAggregator {
  protected:
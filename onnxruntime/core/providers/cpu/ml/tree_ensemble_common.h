@@ -48,6 +48,16 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   std::vector<SparseValue<ThresholdType>> weights_;
   std::vector<TreeNodeElement<ThresholdType>*> roots_;
 
+  // If all the trees are at most kMaxCompactTreeDepth deep, use the same comparison and don't track missing
+  // values, every tree is also stored as a complete binary tree of depth compact_tree_depth_: shallower leaves are
+  // repeated down to the last level. Evaluating one is compact_tree_depth_ branch-free steps
+  // node = 2 * node + 1 + !condition, the reached index selects the leaf of nodes_ in compact_leaves_.
+  static constexpr int kMaxCompactTreeDepth = 8;
+  int compact_tree_depth_ = 0;  // 0 if the compact layout is not used
+  NODE_MODE compact_mode_ = NODE_MODE::LEAF;
+  std::vector<CompactTreeNode<ThresholdType>> compact_nodes_;     // 2^depth - 1 nodes per tree
+  std::vector<TreeNodeElement<ThresholdType>*> compact_leaves_;  // 2^depth leaves per tree
+
  public:
   TreeEnsembleCommon() {}
 
@@ -83,6 +93,15 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   TreeNodeElement<ThresholdType>* ProcessTreeNodeLeave(TreeNodeElement<ThresholdType>* root,
                                                        const InputType* x_data) const;
 
+  // Returns the leaf of tree `tree` reached by the row `x_data`.
+  TreeNodeElement<ThresholdType>* ProcessTreeLeave(size_t tree, const InputType* x_data) const;
+
+  // Stores in `leaves` the leaves of tree `tree` reached by the `n_rows` rows starting at `x_data`, `stride` apart.
+  // Uses the compact trees if there are, otherwise if all nodes share the same mode, blocks of rows walk the tree
+  // in lockstep.
+  void ProcessTreeNodeLeaves(size_t tree, const InputType* x_data, int64_t stride,
+                             size_t n_rows, TreeNodeElement<ThresholdType>** leaves) const;
+
   template <typename AGG>
   void ComputeAgg(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Y, Tensor* label, const AGG& agg) const;
 
@@ -92,8 +111,66 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
                   const std::vector<ThresholdType>& nodes_values_as_tensor, const std::vector<float>& node_values,
                   const std::vector<int64_t>& nodes_missing_value_tracks_true, std::vector<size_t>& updated_mapping,
                   int64_t tree_id, const InlinedVector<TreeNodeElementId>& node_tree_ids);
+
+  void InitCompactTrees();
+
+  template <typename Compare>
+  void ProcessCompactTreeLeaves(size_t tree, const InputType* x_data, int64_t stride, size_t n_rows,
+                                TreeNodeElement<ThresholdType>** leaves, Compare cmp) const;
 };
 
+namespace compact_tree {
+
+// Returns the depth of the tree under `node`, or any value above max_depth if it is deeper.
+template <typename T>
+int GetDepth(const TreeNodeElement<T>* node, int max_depth) {
+  if (!node->is_not_leaf()) {
+    return 0;
+  }
+  if (max_depth == 0) {
+    return 1;
+  }
+  return 1 + std::max(GetDepth(node + 1, max_depth - 1), GetDepth(node->truenode_or_weight.ptr, max_depth - 1));
+}
+
+// Stores the tree under `node` at `index` of `nodes`, `depth` is the number of levels left above the leaves.
+// The leaves of the last level are stored in `leaves` from index `first_leaf_index`.
+template <typename T>
+void Fill(TreeNodeElement<T>* node, size_t index, int depth, size_t first_leaf_index, CompactTreeNode<T>* nodes,
+          TreeNodeElement<T>** leaves) {
+  if (depth == 0) {
+    leaves[index - first_leaf_index] = node;
+  } else if (!node->is_not_leaf()) {
+    // both branches lead to the same leaf, the comparison does not matter
+    nodes[index] = {T{0}, 0};
+    Fill(node, 2 * index + 1, depth - 1, first_leaf_index, nodes, leaves);
+    Fill(node, 2 * index + 2, depth - 1, first_leaf_index, nodes, leaves);
+  } else {
+    nodes[index] = {node->value_or_unique_weight, static_cast<int32_t>(node->feature_id)};
+    Fill(node->truenode_or_weight.ptr, 2 * index + 1, depth - 1, first_leaf_index, nodes, leaves);
+    Fill(node + 1, 2 * index + 2, depth - 1, first_leaf_index, nodes, leaves);
+  }
+}
+
+template <int Depth, typename InputType, typename ThresholdType, typename Compare>
+void ProcessLeaves(const CompactTreeNode<ThresholdType>* nodes, TreeNodeElement<ThresholdType>* const* tree_leaves,
+                   const InputType* x_data, int64_t stride, size_t n_rows, TreeNodeElement<ThresholdType>** leaves,
+                   Compare cmp) {
+  constexpr size_t kFirstLeafIndex = (size_t{1} << Depth) - 1;
+  for (size_t i = 0; i < n_rows; ++i) {
+    const InputType* x = x_data + static_cast<int64_t>(i) * stride;
+    size_t index = 0;
+    // Depth is known at compile time, the loop is unrolled
+    for (int level = 0; level < Depth; ++level) {
+      const CompactTreeNode<ThresholdType>& node = nodes[index];
+      index = 2 * index + 1 + static_cast<size_t>(!cmp(x[node.feature_id], node.threshold));
+    }
+    leaves[i] = tree_leaves[index - kFirstLeafIndex];
+  }
+}
+
+}  // namespace compact_tree
+
 template <typename InputType, typename ThresholdType, typename OutputType>
 Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::Init(const OpKernelInfo& info) {
   std::vector<ThresholdType> base_values_as_tensor, nodes_hitrates_as_tensor,
@@ -338,9 +415,45 @@ Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::Init(
     }
   }
 
+  InitCompactTrees();
+
   return Status::OK();
 }
 
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::InitCompactTrees() {
+  compact_tree_depth_ = 0;
+  compact_nodes_.clear();
+  compact_leaves_.clear();
+  if (!same_mode_ || has_missing_tracks_ || roots_.empty()) {
+    return;
+  }
+
+  int depth = 0;
+  for (const auto* root : roots_) {
+    depth = std::max(depth, compact_tree::GetDepth(root, kMaxCompactTreeDepth));
+    if (depth > kMaxCompactTreeDepth) {
+      return;
+    }
+    if (root->is_not_leaf()) {
+      compact_mode_ = root->mode();
+    }
+  }
+  if (depth == 0) {
+    return;
+  }
+
+  const size_t n_nodes = (size_t{1} << depth) - 1;
+  const size_t n_leaves = size_t{1} << depth;
+  compact_nodes_.resize(roots_.size() * n_nodes);
+  compact_leaves_.resize(roots_.size() * n_leaves);
+  for (size_t j = 0; j < roots_.size(); ++j) {
+    compact_tree::Fill(roots_[j], 0, depth, n_nodes, compact_nodes_.data() + j * n_nodes,
+                       compact_leaves_.data() + j * n_leaves);
+  }
+  compact_tree_depth_ = depth;
+}
+
 template <typename InputType, typename ThresholdType, typename OutputType>
 size_t TreeEnsembleCommon<InputType, ThresholdType, OutputType>::AddNodes(
     const size_t i, const InlinedVector<NODE_MODE>& cmodes, const InlinedVector<size_t>& truenode_ids,
@@ -460,7 +573,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       ScoreValue<ThresholdType> score = {0, 0};
       if (n_trees_ <= parallel_tree_ || max_num_threads == 1) { /* section A: 1 output, 1 row and not enough trees to parallelize */
         for (int64_t j = 0; j < n_trees_; ++j) {
-          agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[onnxruntime::narrow<size_t>(j)], x_data));
+          agg.ProcessTreeNodePrediction1(score, *ProcessTreeLeave(onnxruntime::narrow<size_t>(j), x_data));
         }
       } else { /* section B: 1 output, 1 row and enough trees to parallelize */
         std::vector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_trees_), {0, 0});
@@ -468,7 +581,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             ttp,
             SafeInt<int32_t>(n_trees_),
             [this, &scores, &agg, x_data](ptrdiff_t j) {
-              agg.ProcessTreeNodePrediction1(scores[j], *ProcessTreeNodeLeave(roots_[j], x_data));
+              agg.ProcessTreeNodePrediction1(scores[j], *ProcessTreeLeave(j, x_data));
             },
             max_num_threads);
 
@@ -489,6 +602,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       // split into batch so that every batch holds on caches, then loop on trees and finally loop
       // on the batch rows.
       std::vector<ScoreValue<ThresholdType>> scores(parallel_tree_N_);
+      std::vector<TreeNodeElement<ThresholdType>*> leaves(parallel_tree_N_);
       size_t j;
       int64_t i, batch, batch_end;
 
@@ -498,8 +612,10 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           scores[SafeInt<ptrdiff_t>(i - batch)] = {0, 0};
         }
         for (j = 0; j < static_cast<size_t>(n_trees_); ++j) {
+          ProcessTreeNodeLeaves(j, x_data + batch * stride, stride, SafeInt<size_t>(batch_end - batch),
+                                leaves.data());
           for (i = batch; i < batch_end; ++i) {
-            agg.ProcessTreeNodePrediction1(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+            agg.ProcessTreeNodePrediction1(scores[SafeInt<ptrdiff_t>(i - batch)], *leaves[SafeInt<ptrdiff_t>(i - batch)]);
           }
         }
         for (i = batch; i < batch_end; ++i) {
@@ -518,13 +634,15 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             num_threads,
             [this, &agg, &scores, num_threads, x_data, N, begin_n, end_n, stride](ptrdiff_t batch_num) {
               auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, onnxruntime::narrow<size_t>(this->n_trees_));
+              std::vector<TreeNodeElement<ThresholdType>*> leaves(SafeInt<size_t>(end_n - begin_n));
               for (int64_t i = begin_n; i < end_n; ++i) {
                 scores[batch_num * SafeInt<ptrdiff_t>(N) + i] = {0, 0};
               }
               for (auto j = work.start; j < work.end; ++j) {
+                ProcessTreeNodeLeaves(j, x_data + begin_n * stride, stride, leaves.size(), leaves.data());
                 for (int64_t i = begin_n; i < end_n; ++i) {
                   agg.ProcessTreeNodePrediction1(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
-                                                 *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+                                                 *leaves[SafeInt<ptrdiff_t>(i - begin_n)]);
                 }
               }
             });
@@ -550,7 +668,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           [this, &agg, x_data, z_data, stride, label_data](ptrdiff_t i) {
             ScoreValue<ThresholdType> score = {0, 0};
             for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-              agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+              agg.ProcessTreeNodePrediction1(score, *ProcessTreeLeave(j, x_data + i * stride));
             }
 
             agg.FinalizeScores1(z_data + i, score,
@@ -563,7 +681,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       if (n_trees_ <= parallel_tree_ || max_num_threads == 1) { /* section A2 */
         InlinedVector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
         for (int64_t j = 0; j < n_trees_; ++j) {
-          agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[onnxruntime::narrow<size_t>(j)], x_data), weights_);
+          agg.ProcessTreeNodePrediction(scores, *ProcessTreeLeave(onnxruntime::narrow<size_t>(j), x_data), weights_);
         }
         agg.FinalizeScores(scores, z_data, -1, label_data);
       } else { /* section B2: 2+ outputs, 1 row, enough trees to parallelize */
@@ -576,7 +694,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
               scores[batch_num].resize(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
               auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, onnxruntime::narrow<size_t>(n_trees_));
               for (auto j = work.start; j < work.end; ++j) {
-                agg.ProcessTreeNodePrediction(scores[batch_num], *ProcessTreeNodeLeave(roots_[j], x_data), weights_);
+                agg.ProcessTreeNodePrediction(scores[batch_num], *ProcessTreeLeave(j, x_data), weights_);
               }
             });
         for (size_t i = 1, limit = scores.size(); i < limit; ++i) {
@@ -586,6 +704,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       }
     } else if (N <= parallel_N_ || max_num_threads == 1) { /* section C2: 2+ outputs, 2+ rows, not enough rows to parallelize */
       std::vector<InlinedVector<ScoreValue<ThresholdType>>> scores(parallel_tree_N_);
+      std::vector<TreeNodeElement<ThresholdType>*> leaves(parallel_tree_N_);
       size_t j, limit;
       int64_t i, batch, batch_end;
       batch_end = std::min(N, static_cast<int64_t>(parallel_tree_N_));
@@ -598,8 +717,10 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           std::fill(scores[SafeInt<ptrdiff_t>(i - batch)].begin(), scores[SafeInt<ptrdiff_t>(i - batch)].end(), ScoreValue<ThresholdType>({0, 0}));
         }
         for (j = 0, limit = roots_.size(); j < limit; ++j) {
+          ProcessTreeNodeLeaves(j, x_data + batch * stride, stride, SafeInt<size_t>(batch_end - batch),
+                                leaves.data());
           for (i = batch; i < batch_end; ++i) {
-            agg.ProcessTreeNodePrediction(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
+            agg.ProcessTreeNodePrediction(scores[SafeInt<ptrdiff_t>(i - batch)], *leaves[SafeInt<ptrdiff_t>(i - batch)], weights_);
           }
         }
         for (i = batch; i < batch_end; ++i) {
@@ -619,13 +740,15 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             num_threads,
             [this, &agg, &scores, num_threads, x_data, N, stride, begin_n, end_n](ptrdiff_t batch_num) {
               auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, onnxruntime::narrow<size_t>(this->n_trees_));
+              std::vector<TreeNodeElement<ThresholdType>*> leaves(SafeInt<size_t>(end_n - begin_n));
               for (int64_t i = begin_n; i < end_n; ++i) {
                 scores[batch_num * SafeInt<ptrdiff_t>(N) + i].resize(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
               }
               for (auto j = work.start; j < work.end; ++j) {
+                ProcessTreeNodeLeaves(j, x_data + begin_n * stride, stride, leaves.size(), leaves.data());
                 for (int64_t i = begin_n; i < end_n; ++i) {
                   agg.ProcessTreeNodePrediction(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
-                                                *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
+                                                *leaves[SafeInt<ptrdiff_t>(i - begin_n)], weights_);
                 }
               }
             });
@@ -657,7 +780,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             for (auto i = work.start; i < work.end; ++i) {
               std::fill(scores.begin(), scores.end(), ScoreValue<ThresholdType>({0, 0}));
               for (j = 0, limit = roots_.size(); j < limit; ++j) {
-                agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
+                agg.ProcessTreeNodePrediction(scores, *ProcessTreeLeave(j, x_data + i * stride), weights_);
               }
 
               agg.FinalizeScores(scores,
@@ -767,6 +890,164 @@ TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeave(
   return root;
 }
 
+// Number of rows ProcessTreeNodeLeaves walks down a tree together. Every row is a chain of dependent loads,
+// interleaving several rows lets the processor overlap the loads of one row with the comparisons of the others.
+constexpr size_t kTreeRowBlockSize = 8;
+
+template <bool HasMissingTracks, typename InputType, typename ThresholdType, typename Compare>
+inline void ProcessTreeNodeLeavesBlock(TreeNodeElement<ThresholdType>** nodes, const InputType* x_data,
+                                       int64_t stride, Compare cmp) {
+  // all the rows start from the same root
+  bool not_done = nodes[0]->is_not_leaf();
+  while (not_done) {
+    not_done = false;
+    for (size_t k = 0; k < kTreeRowBlockSize; ++k) {
+      TreeNodeElement<ThresholdType>* node = nodes[k];
+      if (node->is_not_leaf()) {
+        InputType val = x_data[static_cast<int64_t>(k) * stride + node->feature_id];
+        bool is_true = cmp(val, node->value_or_unique_weight);
+        if constexpr (HasMissingTracks) {
+          is_true = is_true || (node->is_missing_track_true() && _isnan_(val));
+        }
+        node = is_true ? node->truenode_or_weight.ptr : node + 1;
+        nodes[k] = node;
+        not_done = not_done || node->is_not_leaf();
+      }
+    }
+  }
+}
+
+#define TREE_FIND_LEAVES(CMP)                                                                    \
+  if (has_missing_tracks_) {                                                                     \
+    ProcessTreeNodeLeavesBlock<true>(nodes, block_data, stride,                                  \
+                                     [](InputType v, ThresholdType t) { return v CMP t; });      \
+  } else {                                                                                       \
+    ProcessTreeNodeLeavesBlock<false>(nodes, block_data, stride,                                 \
+                                      [](InputType v, ThresholdType t) { return v CMP t; });     \
+  }
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename Compare>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessCompactTreeLeaves(
+    size_t tree, const InputType* x_data, int64_t stride, size_t n_rows, TreeNodeElement<ThresholdType>** leaves,
+    Compare cmp) const {
+  const CompactTreeNode<ThresholdType>* nodes = compact_nodes_.data() + tree * ((size_t{1} << compact_tree_depth_) - 1);
+  TreeNodeElement<ThresholdType>* const* tree_leaves = compact_leaves_.data() + (tree << compact_tree_depth_);
+  switch (compact_tree_depth_) {
+    case 1:
+      compact_tree::ProcessLeaves<1>(nodes, tree_leaves, x_data, stride, n_rows, leaves, cmp);
+      break;
+    case 2:
+      compact_tree::ProcessLeaves<2>(nodes, tree_leaves, x_data, stride, n_rows, leaves, cmp);
+      break;
+    case 3:
+      compact_tree::ProcessLeaves<3>(nodes, tree_leaves, x_data, stride, n_rows, leaves, cmp);
+      break;
+    case 4:
+      compact_tree::ProcessLeaves<4>(nodes, tree_leaves, x_data, stride, n_rows, leaves, cmp);
+      break;
+    case 5:
+      compact_tree::ProcessLeaves<5>(nodes, tree_leaves, x_data, stride, n_rows, leaves, cmp);
+      break;
+    case 6:
+      compact_tree::ProcessLeaves<6>(nodes, tree_leaves, x_data, stride, n_rows, leaves, cmp);
+      break;
+    case 7:
+      compact_tree::ProcessLeaves<7>(nodes, tree_leaves, x_data, stride, n_rows, leaves, cmp);
+      break;
+    case 8:
+      compact_tree::ProcessLeaves<8>(nodes, tree_leaves, x_data, stride, n_rows, leaves, cmp);
+      break;
+    default:
+      ORT_THROW("Unexpected depth ", compact_tree_depth_, " of the compact trees.");
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+TreeNodeElement<ThresholdType>* TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeLeave(
+    size_t tree, const InputType* x_data) const {
+  if (compact_tree_depth_ == 0) {
+    return ProcessTreeNodeLeave(roots_[tree], x_data);
+  }
+  TreeNodeElement<ThresholdType>* leaf;
+  ProcessTreeNodeLeaves(tree, x_data, 0, 1, &leaf);
+  return leaf;
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeaves(
+    size_t tree, const InputType* x_data, int64_t stride, size_t n_rows,
+    TreeNodeElement<ThresholdType>** leaves) const {
+  if (compact_tree_depth_ > 0) {
+    switch (compact_mode_) {
+      case NODE_MODE::BRANCH_LEQ:
+        ProcessCompactTreeLeaves(tree, x_data, stride, n_rows, leaves,
+                                 [](InputType v, ThresholdType t) { return v <= t; });
+        break;
+      case NODE_MODE::BRANCH_LT:
+        ProcessCompactTreeLeaves(tree, x_data, stride, n_rows, leaves,
+                                 [](InputType v, ThresholdType t) { return v < t; });
+        break;
+      case NODE_MODE::BRANCH_GTE:
+        ProcessCompactTreeLeaves(tree, x_data, stride, n_rows, leaves,
+                                 [](InputType v, ThresholdType t) { return v >= t; });
+        break;
+      case NODE_MODE::BRANCH_GT:
+        ProcessCompactTreeLeaves(tree, x_data, stride, n_rows, leaves,
+                                 [](InputType v, ThresholdType t) { return v > t; });
+        break;
+      case NODE_MODE::BRANCH_EQ:
+        ProcessCompactTreeLeaves(tree, x_data, stride, n_rows, leaves,
+                                 [](InputType v, ThresholdType t) { return v == t; });
+        break;
+      case NODE_MODE::BRANCH_NEQ:
+        ProcessCompactTreeLeaves(tree, x_data, stride, n_rows, leaves,
+                                 [](InputType v, ThresholdType t) { return v != t; });
+        break;
+      case NODE_MODE::LEAF:
+        ORT_THROW("The compact trees have no comparison mode.");
+    }
+    return;
+  }
+
+  TreeNodeElement<ThresholdType>* root = roots_[tree];
+  size_t i = 0;
+  if (same_mode_ && root->is_not_leaf()) {
+    for (; i + kTreeRowBlockSize <= n_rows; i += kTreeRowBlockSize) {
+      TreeNodeElement<ThresholdType>** nodes = leaves + i;
+      const InputType* block_data = x_data + static_cast<int64_t>(i) * stride;
+      std::fill(nodes, nodes + kTreeRowBlockSize, root);
+      switch (root->mode()) {
+        case NODE_MODE::BRANCH_LEQ:
+          TREE_FIND_LEAVES(<=)
+          break;
+        case NODE_MODE::BRANCH_LT:
+          TREE_FIND_LEAVES(<)
+          break;
+        case NODE_MODE::BRANCH_GTE:
+          TREE_FIND_LEAVES(>=)
+          break;
+        case NODE_MODE::BRANCH_GT:
+          TREE_FIND_LEAVES(>)
+          break;
+        case NODE_MODE::BRANCH_EQ:
+          TREE_FIND_LEAVES(==)
+          break;
+        case NODE_MODE::BRANCH_NEQ:
+          TREE_FIND_LEAVES(!=)
+          break;
+        case NODE_MODE::LEAF:
+          break;
+      }
+    }
+  }
+
+  // remaining rows, or nodes with different modes
+  for (; i < n_rows; ++i) {
+    leaves[i] = ProcessTreeNodeLeave(root, x_data + static_cast<int64_t>(i) * stride);
+  }
+}
+
 // TI: input type
 // TH: threshold type, double if T==double, float otherwise
 // TO: output type
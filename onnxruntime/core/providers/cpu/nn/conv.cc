@@ -17,6 +17,8 @@
 
 #include "core/providers/cpu/nn/conv.h"
 
+#include <algorithm>
+
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
 #include "core/util/math_cpuonly.h"
@@ -153,20 +155,88 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+Status Conv<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack the filter of 2D 3x3 convolutions that may run the Winograd algorithm
+  if (!use_winograd_ || input_idx != 1) {
+    return Status::OK();
+  }
+
+  const auto& shape = tensor.Shape();
+  if (shape.NumDimensions() != 4 || shape[2] != 3 || shape[3] != 3 || conv_attrs_.group <= 0) {
+    return Status::OK();
+  }
+
+  const auto all_ones = [](const TensorShapeVector& values) {
+    return std::all_of(values.begin(), values.end(), [](int64_t v) { return v == 1; });
+  };
+  if (!all_ones(conv_attrs_.strides) || !all_ones(conv_attrs_.dilations)) {
+    return Status::OK();
+  }
+
+  const size_t group_count = narrow<size_t>(conv_attrs_.group);
+  const size_t filter_count = narrow<size_t>(shape[0]) / group_count;
+  const size_t input_channels = narrow<size_t>(shape[1]);
+  const size_t winograd_filter_size = MlasConvWinogradPackFilterSize(group_count, filter_count, input_channels);
+  if (winograd_filter_size == 0) {
+    return Status::OK();
+  }
+
+  // Keep a copy of the filter for the input shapes that do not run the Winograd algorithm.
+  const size_t filter_size = narrow<size_t>(shape.Size());
+  const size_t packed_filter_data_size = SafeInt<size_t>(filter_size + winograd_filter_size) * sizeof(float);
+  auto* packed_filter_data = static_cast<float*>(alloc->Alloc(packed_filter_data_size));
+
+  std::copy_n(tensor.Data<float>(), filter_size, packed_filter_data);
+  MlasConvWinogradPackFilter(group_count, filter_count, input_channels, tensor.Data<float>(),
+                             packed_filter_data + filter_size);
+
+  filter_shape_ = shape;
+  winograd_filter_offset_ = filter_size;
+  packed_filter_ = BufferUniquePtr(packed_filter_data, BufferDeleter(std::move(alloc)));
+
+  bool share_prepacked_weights = (prepacked_weights != nullptr);
+  if (share_prepacked_weights) {
+    prepacked_weights->buffers_.push_back(std::move(packed_filter_));
+    prepacked_weights->buffer_sizes_.push_back(packed_filter_data_size);
+  }
+
+  is_packed = true;
+  return Status::OK();
+}
+
+Status Conv<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              int input_idx,
+                                              /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_filter_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
 Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* X = context->Input<Tensor>(0);
-  const Tensor* W = context->Input<Tensor>(1);
+  const Tensor* W = packed_filter_ ? nullptr : context->Input<Tensor>(1);
+  const TensorShape& W_shape = W ? W->Shape() : filter_shape_;
+  const float* W_data = W ? W->Data<float>() : static_cast<const float*>(packed_filter_.get());
   const Tensor* B = num_inputs >= 3 ? context->Input<Tensor>(2) : nullptr;
   const Tensor* Sum = num_inputs >= 4 ? context->Input<Tensor>(3) : nullptr;
   const int64_t N = X->Shape()[0];
   const int64_t C = X->Shape()[1];
-  const int64_t M = W->Shape()[0];
-  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
+  const int64_t M = W_shape[0];
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W_shape));
 
   // kernel_shape is an optional attribute and has to be inferred from W if not provided
   TensorShapeVector kernel_shape;
-  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W->Shape(), kernel_shape));
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
 
   ConvPadVector pads(conv_attrs_.pads);
   if (pads.empty()) {
@@ -231,15 +301,21 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
                     &activation_,
                     &WorkingBufferSize,
                     Beta,
-                    thread_pool);
+                    thread_pool,
+                    packed_filter_ != nullptr);
 
     auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * SafeInt<size_t>(WorkingBufferSize))
                                                : nullptr;
     BufferUniquePtr working_buffer(working_data, BufferDeleter(std::move(alloc)));
 
+    const float* filter_data = W_data;
+    if (Parameters.Algorithm == MlasConvAlgorithmWinograd) {
+      filter_data += winograd_filter_offset_;
+    }
+
     MlasConv(&Parameters,
              Xdata.data(),
-             W->Data<float>(),
+             filter_data,
              Bdata,
              static_cast<float*>(working_buffer.get()),
              Ydata.data(),
@@ -250,12 +326,12 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
     const int64_t kernel_size = TensorShape(kernel_shape).Size();
     const SafeInt<int64_t> X_offset = SafeInt<int64_t>(C) / conv_attrs_.group * input_image_size;
     const SafeInt<int64_t> Y_offset = SafeInt<int64_t>(Y->Shape().Size()) / Y->Shape()[0] / conv_attrs_.group;
-    const SafeInt<int64_t> W_offset = SafeInt<int64_t>(W->Shape().Size()) / conv_attrs_.group;
+    const SafeInt<int64_t> W_offset = SafeInt<int64_t>(W_shape.Size()) / conv_attrs_.group;
     const SafeInt<int64_t> kernel_dim = SafeInt<int64_t>(C) / conv_attrs_.group * kernel_size;
     const int64_t col_buffer_size = kernel_dim * output_image_size;
 
     auto col_data = IAllocator::MakeUniquePtr<float>(alloc, narrow<size_t>(col_buffer_size));
-    auto w_data = W->DataAsSpan<float>();
+    auto w_data = gsl::make_span(W_data, narrow<size_t>(W_shape.Size()));
     for (int image_id = 0; image_id < N; ++image_id) {
       for (int group_id = 0; group_id < conv_attrs_.group; ++group_id) {
         math::Im2col<float, StorageOrder::NCHW>()(
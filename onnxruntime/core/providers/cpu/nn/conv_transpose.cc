@@ -17,6 +17,8 @@
 
 #include "core/providers/cpu/nn/conv_transpose.h"
 
+#include <algorithm>
+
 #include "core/mlas/inc/mlas.h"
 #include "core/common/safeint.h"
 #include "core/util/math.h"
@@ -24,6 +26,73 @@
 
 namespace onnxruntime {
 
+namespace {
+
+// Integer division rounding towards negative infinity.
+inline int64_t FloorDiv(int64_t a, int64_t b) {
+  return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+// Number of kernel taps that contribute to the outputs of `phase` in one dimension.
+inline int64_t SubpixelTaps(int64_t phase, int64_t stride, int64_t kernel) {
+  return phase < kernel ? (kernel - phase + stride - 1) / stride : 0;
+}
+
+// One dimension of an output phase. With dilation 1, output o = stride * q + phase - pad receives the kernel taps
+// phase + stride * t from input q - t, for t in [0, taps).
+struct SubpixelPhase {
+  int64_t taps;
+  int64_t first_q;
+  int64_t num_outputs;
+};
+
+SubpixelPhase ComputeSubpixelPhase(int64_t phase, int64_t stride, int64_t kernel, int64_t pad, int64_t output_size) {
+  SubpixelPhase result;
+  result.taps = SubpixelTaps(phase, stride, kernel);
+  result.first_q = -FloorDiv(phase - pad, stride);
+  const int64_t last_q = FloorDiv(output_size - 1 + pad - phase, stride);
+  result.num_outputs = std::max<int64_t>(last_q - result.first_q + 1, 0);
+  return result;
+}
+
+// The sub-pixel decomposition handles 2D without dilation. It is used when its per phase column buffer is no larger
+// than the one of GEMM + Col2im, which holds for the usual upsampling configurations (stride 2, kernel 2 to 4).
+bool CanUseSubpixel(const ConvTransposeAttributes& attrs, const TensorShape& filter_shape) {
+  if (filter_shape.NumDimensions() != 4) {
+    return false;
+  }
+
+  for (int64_t dilation : attrs.dilations) {
+    if (dilation != 1) {
+      return false;
+    }
+  }
+
+  const int64_t kernel_h = filter_shape[2];
+  const int64_t kernel_w = filter_shape[3];
+  if (!attrs.kernel_shape_.empty() &&
+      (attrs.kernel_shape_.size() != 2 || attrs.kernel_shape_[0] != kernel_h || attrs.kernel_shape_[1] != kernel_w)) {
+    return false;
+  }
+
+  if (!attrs.strides.empty() && attrs.strides.size() != 2) {
+    return false;
+  }
+
+  const int64_t stride_h = attrs.strides.empty() ? 1 : attrs.strides[0];
+  const int64_t stride_w = attrs.strides.empty() ? 1 : attrs.strides[1];
+  if (stride_h <= 0 || stride_w <= 0 || attrs.group <= 0) {
+    return false;
+  }
+
+  const int64_t input_channels_per_group = filter_shape[0] / attrs.group;
+  const int64_t output_channels_per_group = filter_shape[1];
+  return input_channels_per_group * SubpixelTaps(0, stride_h, kernel_h) * SubpixelTaps(0, stride_w, kernel_w) <=
+         output_channels_per_group * kernel_h * kernel_w;
+}
+
+}  // namespace
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     ConvTranspose,
     1, 10,
@@ -58,6 +127,54 @@ Status ConvTranspose<float>::PrePack(const Tensor& tensor, int input_idx, Alloca
     }
     filter_shape_ = tensor.Shape();
 
+    if (CanUseSubpixel(conv_transpose_attrs_, filter_shape_)) {
+      const int64_t group = conv_transpose_attrs_.group;
+      const int64_t input_channels_per_group = filter_shape_[0] / group;
+      const int64_t output_channels_per_group = filter_shape_[1];
+      const int64_t kernel_h = filter_shape_[2];
+      const int64_t kernel_w = filter_shape_[3];
+      const int64_t stride_h = conv_transpose_attrs_.strides.empty() ? 1 : conv_transpose_attrs_.strides[0];
+      const int64_t stride_w = conv_transpose_attrs_.strides.empty() ? 1 : conv_transpose_attrs_.strides[1];
+
+      const size_t packed_filter_data_size = SafeInt<size_t>(tensor.Shape().Size()) * sizeof(float);
+      auto* packed_filter_data = static_cast<float*>(alloc->Alloc(packed_filter_data_size));
+      packed_filter_ = BufferUniquePtr(packed_filter_data, BufferDeleter(std::move(alloc)));
+
+      // For each group and phase, a [M/group, C/group * taps_h * taps_w] matrix. The phases partition the kernel
+      // taps, so the packed filter has the size of the original one.
+      const float* filter_data = tensor.Data<float>();
+      float* dst = packed_filter_data;
+      for (int64_t group_id = 0; group_id < group; ++group_id) {
+        for (int64_t phase_h = 0; phase_h < stride_h; ++phase_h) {
+          for (int64_t phase_w = 0; phase_w < stride_w; ++phase_w) {
+            const int64_t taps_h = SubpixelTaps(phase_h, stride_h, kernel_h);
+            const int64_t taps_w = SubpixelTaps(phase_w, stride_w, kernel_w);
+            for (int64_t m = 0; m < output_channels_per_group; ++m) {
+              for (int64_t c = 0; c < input_channels_per_group; ++c) {
+                const float* filter_mc = filter_data +
+                                         ((group_id * input_channels_per_group + c) * output_channels_per_group + m) *
+                                             kernel_h * kernel_w;
+                for (int64_t t_h = 0; t_h < taps_h; ++t_h) {
+                  for (int64_t t_w = 0; t_w < taps_w; ++t_w) {
+                    *dst++ = filter_mc[(phase_h + stride_h * t_h) * kernel_w + phase_w + stride_w * t_w];
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+
+      if (prepacked_weights != nullptr) {
+        prepacked_weights->buffers_.push_back(std::move(packed_filter_));
+        prepacked_weights->buffer_sizes_.push_back(packed_filter_data_size);
+      }
+
+      subpixel_filter_ = true;
+      is_packed = true;
+      return Status::OK();
+    }
+
     const size_t K = static_cast<size_t>(filter_shape_[0]) / onnxruntime::narrow<size_t>(conv_transpose_attrs_.group);
     const size_t N = onnxruntime::narrow<size_t>(filter_shape_.SizeFromDimension(1));
     auto packed_elements_per_group = N * K;
@@ -73,7 +190,7 @@ Status ConvTranspose<float>::PrePack(const Tensor& tensor, int input_idx, Alloca
     // if and when we try to cache this pre-packed buffer for sharing between sessions.
     memset(packed_filter_data, 0, packed_filter_data_size);
 
-    transposed_filter_ = BufferUniquePtr(packed_filter_data, BufferDeleter(std::move(alloc)));
+    packed_filter_ = BufferUniquePtr(packed_filter_data, BufferDeleter(std::move(alloc)));
 
     for (int64_t group_id = 0; group_id < conv_transpose_attrs_.group; ++group_id) {
       MlasTranspose(tensor.Data<float>() + (group_id * N * K),
@@ -83,7 +200,7 @@ Status ConvTranspose<float>::PrePack(const Tensor& tensor, int input_idx, Alloca
 
     bool share_prepacked_weights = (prepacked_weights != nullptr);
     if (share_prepacked_weights) {
-      prepacked_weights->buffers_.push_back(std::move(transposed_filter_));
+      prepacked_weights->buffers_.push_back(std::move(packed_filter_));
       prepacked_weights->buffer_sizes_.push_back(packed_filter_data_size);
     }
 
@@ -108,7 +225,7 @@ Status ConvTranspose<float>::UseSharedPrePackedBuffers(std::vector<BufferUniqueP
 
   if (input_idx == 1) {
     used_shared_buffers = true;
-    transposed_filter_ = std::move(prepacked_buffers[0]);
+    packed_filter_ = std::move(prepacked_buffers[0]);
   }
 
   return Status::OK();
@@ -226,13 +343,17 @@ Status ConvTranspose<float>::DoConvTranspose(OpKernelContext* context, bool dyna
   ConvTransposeAttributes::Prepare p;
   bool has_bias = dynamic_padding ? num_inputs == 4 : num_inputs == 3;
   ORT_RETURN_IF_ERROR(conv_transpose_attrs_.PrepareForCompute(
-      context, has_bias, p, dynamic_padding, transposed_filter_ ? &filter_shape_ : nullptr));
+      context, has_bias, p, dynamic_padding, packed_filter_ ? &filter_shape_ : nullptr));
 
   // Bail out early if one of the dimensions is zero.
   if (p.Y->Shape().Size() == 0) {
     return Status::OK();
   }
 
+  if (subpixel_filter_ && p.F == nullptr) {
+    return DoSubpixelConvTranspose(context, p);
+  }
+
   const int64_t input_image_size = p.input_shape.Size();
   const int64_t X_offset = p.num_input_channels / conv_transpose_attrs_.group * input_image_size;
   const int64_t Y_offset = p.Y->Shape().Size() / p.Y->Shape()[0] / conv_transpose_attrs_.group;
@@ -250,7 +371,7 @@ Status ConvTranspose<float>::DoConvTranspose(OpKernelContext* context, bool dyna
   float* col_buffer_data = static_cast<float*>(col_buffer.get());
 
   const float* Xdata = p.X->Data<float>();
-  const float* filter_data = p.F ? p.F->Data<float>() : static_cast<float*>(transposed_filter_.get());
+  const float* filter_data = p.F ? p.F->Data<float>() : static_cast<float*>(packed_filter_.get());
   float* Ydata = p.Y->MutableData<float>();
   TensorShape output_shape = p.Y->Shape().Slice(2);
 
@@ -317,4 +438,150 @@ Status ConvTranspose<float>::DoConvTranspose(OpKernelContext* context, bool dyna
 
   return Status::OK();
 }
+template <>
+Status ConvTranspose<float>::DoSubpixelConvTranspose(OpKernelContext* context,
+                                                     const ConvTransposeAttributes::Prepare& p) const {
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  const int64_t group = conv_transpose_attrs_.group;
+  const int64_t input_channels_per_group = p.num_input_channels / group;
+  const int64_t output_channels_per_group = p.num_output_channels / group;
+  const int64_t input_h = p.input_shape[0];
+  const int64_t input_w = p.input_shape[1];
+  const int64_t output_h = p.Y->Shape()[2];
+  const int64_t output_w = p.Y->Shape()[3];
+  const int64_t stride_h = p.strides[0];
+  const int64_t stride_w = p.strides[1];
+
+  std::vector<SubpixelPhase> phases_h;
+  std::vector<SubpixelPhase> phases_w;
+  for (int64_t phase = 0; phase < stride_h; ++phase) {
+    phases_h.push_back(ComputeSubpixelPhase(phase, stride_h, p.kernel_shape[0], p.pads[0], output_h));
+  }
+  for (int64_t phase = 0; phase < stride_w; ++phase) {
+    phases_w.push_back(ComputeSubpixelPhase(phase, stride_w, p.kernel_shape[1], p.pads[1], output_w));
+  }
+
+  int64_t col_buffer_size = 0;
+  int64_t phase_output_buffer_size = 0;
+  for (const auto& phase_h : phases_h) {
+    for (const auto& phase_w : phases_w) {
+      const int64_t num_outputs = phase_h.num_outputs * phase_w.num_outputs;
+      col_buffer_size = std::max(col_buffer_size,
+                                 input_channels_per_group * phase_h.taps * phase_w.taps * num_outputs);
+      phase_output_buffer_size = std::max(phase_output_buffer_size, output_channels_per_group * num_outputs);
+    }
+  }
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+  auto col_buffer = IAllocator::MakeUniquePtr<float>(alloc, SafeInt<size_t>(col_buffer_size));
+  auto phase_output_buffer = IAllocator::MakeUniquePtr<float>(alloc, SafeInt<size_t>(phase_output_buffer_size));
+  float* col_data = col_buffer.get();
+  float* phase_output = phase_output_buffer.get();
+
+  const int64_t input_image_size = input_h * input_w;
+  const int64_t output_image_size = output_h * output_w;
+  const int64_t filter_group_size = filter_shape_.Size() / group;
+  const float* Xdata = p.X->Data<float>();
+  const float* Bdata = p.B != nullptr ? p.B->Data<float>() : nullptr;
+  float* Ydata = p.Y->MutableData<float>();
+
+  for (int64_t image_id = 0; image_id < p.N; ++image_id) {
+    for (int64_t group_id = 0; group_id < group; ++group_id) {
+      const float* X_group = Xdata + (image_id * p.num_input_channels + group_id * input_channels_per_group) *
+                                         input_image_size;
+      float* Y_group = Ydata + (image_id * p.num_output_channels + group_id * output_channels_per_group) *
+                                   output_image_size;
+      const float* filter_data = static_cast<const float*>(packed_filter_.get()) + group_id * filter_group_size;
+
+      for (int64_t phase_h = 0; phase_h < stride_h; ++phase_h) {
+        for (int64_t phase_w = 0; phase_w < stride_w; ++phase_w) {
+          const SubpixelPhase& ph = phases_h[phase_h];
+          const SubpixelPhase& pw = phases_w[phase_w];
+          const int64_t taps = ph.taps * pw.taps;
+          const int64_t kernel_dim = input_channels_per_group * taps;
+          const float* phase_filter = filter_data;
+          filter_data += output_channels_per_group * kernel_dim;
+
+          const int64_t num_outputs = ph.num_outputs * pw.num_outputs;
+          if (num_outputs == 0) {
+            continue;
+          }
+
+          if (taps == 0) {
+            // the kernel is smaller than the stride, these outputs only receive the bias.
+            std::fill_n(phase_output, output_channels_per_group * num_outputs, 0.0f);
+          } else {
+            // Gather the input patches of the phase. Row (c, t_h, t_w) holds input (q_h - t_h, q_w - t_w) of
+            // channel c for every output of the phase.
+            concurrency::ThreadPool::TryParallelFor(
+                thread_pool, static_cast<std::ptrdiff_t>(kernel_dim),
+                TensorOpCost{static_cast<double>(num_outputs * sizeof(float)),
+                             static_cast<double>(num_outputs * sizeof(float)),
+                             static_cast<double>(num_outputs)},
+                [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                  for (std::ptrdiff_t row = begin; row < end; ++row) {
+                    const int64_t c = row / taps;
+                    const int64_t t_h = (row % taps) / pw.taps;
+                    const int64_t t_w = row % pw.taps;
+                    const float* X_channel = X_group + c * input_image_size;
+                    float* dst = col_data + row * num_outputs;
+                    for (int64_t i = 0; i < ph.num_outputs; ++i, dst += pw.num_outputs) {
+                      const int64_t ih = ph.first_q + i - t_h;
+                      if (ih < 0 || ih >= input_h) {
+                        std::fill_n(dst, pw.num_outputs, 0.0f);
+                        continue;
+                      }
+
+                      const float* X_row = X_channel + ih * input_w;
+                      for (int64_t j = 0; j < pw.num_outputs; ++j) {
+                        const int64_t iw = pw.first_q + j - t_w;
+                        dst[j] = (iw >= 0 && iw < input_w) ? X_row[iw] : 0.0f;
+                      }
+                    }
+                  }
+                });
+
+            math::Gemm<float>(
+                CblasNoTrans,
+                CblasNoTrans,
+                onnxruntime::narrow<ptrdiff_t>(output_channels_per_group),
+                onnxruntime::narrow<ptrdiff_t>(num_outputs),
+                onnxruntime::narrow<ptrdiff_t>(kernel_dim),
+                1,
+                phase_filter,
+                col_data,
+                0,
+                phase_output,
+                thread_pool);
+          }
+
+          // Interleave the phase into the output, adding the bias. Every output belongs to exactly one phase.
+          concurrency::ThreadPool::TryParallelFor(
+              thread_pool, static_cast<std::ptrdiff_t>(output_channels_per_group),
+              TensorOpCost{static_cast<double>(num_outputs * sizeof(float)),
+                           static_cast<double>(num_outputs * sizeof(float)),
+                           static_cast<double>(num_outputs)},
+              [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                for (std::ptrdiff_t m = begin; m < end; ++m) {
+                  const float bias = Bdata != nullptr ? Bdata[group_id * output_channels_per_group + m] : 0.0f;
+                  const float* src = phase_output + m * num_outputs;
+                  for (int64_t i = 0; i < ph.num_outputs; ++i, src += pw.num_outputs) {
+                    const int64_t oh = stride_h * (ph.first_q + i) + phase_h - p.pads[0];
+                    float* Y_row = Y_group + m * output_image_size + oh * output_w +
+                                   stride_w * pw.first_q + phase_w - p.pads[1];
+                    for (int64_t j = 0; j < pw.num_outputs; ++j) {
+                      Y_row[j * stride_w] = src[j] + bias;
+                    }
+                  }
+                }
+              });
+        }
+      }
+    }
+  }
+
+  return Status::OK();
+}
 }  // namespace onnxruntime
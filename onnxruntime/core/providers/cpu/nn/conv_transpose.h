@@ -41,11 +41,17 @@ class ConvTranspose : public OpKernel {
   Status DoConvTranspose(OpKernelContext* context, bool dynamic_padding) const;
 
  private:
+  // 2D transposed convolution decomposed into stride_h * stride_w regular convolutions, one per output phase,
+  // using the filter packed per phase by PrePack. Avoids the column buffer of the output size and the Col2im pass.
+  Status DoSubpixelConvTranspose(OpKernelContext* context, const ConvTransposeAttributes::Prepare& p) const;
+
   ConvTransposeAttributes conv_transpose_attrs_;
 
   // for pre-packing usage
   TensorShape filter_shape_;
-  BufferUniquePtr transposed_filter_;
+  // the transposed filter, or the filter packed per output phase if subpixel_filter_ is true.
+  BufferUniquePtr packed_filter_;
+  bool subpixel_filter_{false};
 };
 
 }  // namespace onnxruntime
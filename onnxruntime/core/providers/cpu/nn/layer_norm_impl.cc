@@ -3,8 +3,11 @@
 
 #include "layer_norm_impl.h"
 
+#include <type_traits>
+
 #include "core/common/safeint.h"
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/util/math_cpuonly.h"
@@ -74,47 +77,103 @@ Status ComputeImpl(OpKernelContext* p_ctx, int64_t orig_axis, float epsilon, boo
     inv_std_dev_data = inv_std_dev->MutableData<U>();
   }
 
-  concurrency::ThreadPool::TryBatchParallelFor(
-      p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(norm_count),
-      [&](ptrdiff_t task_idx) {
-        const T* p_input = X_data + task_idx * norm_size;
-        T* p_output = Y_data + task_idx * norm_size;
-
-        T mean = 0;
-        T mean_square = 0;
+  if constexpr (std::is_same_v<T, float> && std::is_same_v<U, float>) {
+    MLAS_LAYER_NORM_PARAMS<float> params;
+    params.RowCount = static_cast<size_t>(norm_count);
+    params.RowSize = static_cast<size_t>(norm_size);
+    params.Input = X_data;
+    params.Gamma = scale_data;
+    params.Beta = bias_data;
+    params.Output = Y_data;
+    params.Mean = mean_data;
+    params.InvStdDev = inv_std_dev_data;
+    params.Epsilon = epsilon;
+    params.Simplified = simplified;
+
+    MlasLayerNormalization(params, p_ctx->GetOperatorThreadPool());
+  } else if constexpr (std::is_same_v<T, MLFloat16>) {
+    // MLAS normalizes half precision rows in float. The statistics are float, so they are converted if the
+    // contrib op declared them as MLFloat16.
+    const size_t row_count = static_cast<size_t>(norm_count);
+    IAllocatorUniquePtr<float> mean_buffer;
+    IAllocatorUniquePtr<float> inv_std_dev_buffer;
+
+    MLAS_LAYER_NORM_PARAMS<MLAS_FP16> params;
+    params.RowCount = row_count;
+    params.RowSize = static_cast<size_t>(norm_size);
+    params.Input = X_data;
+    params.Gamma = scale_data;
+    params.Beta = bias_data;
+    params.Output = Y_data;
+    params.Epsilon = epsilon;
+    params.Simplified = simplified;
+    if constexpr (std::is_same_v<U, float>) {
+      params.Mean = mean_data;
+      params.InvStdDev = inv_std_dev_data;
+    } else {
+      if (mean_data != nullptr) {
+        mean_buffer = IAllocator::MakeUniquePtr<float>(alloc, row_count);
+        params.Mean = mean_buffer.get();
+      }
+      if (inv_std_dev_data != nullptr) {
+        inv_std_dev_buffer = IAllocator::MakeUniquePtr<float>(alloc, row_count);
+        params.InvStdDev = inv_std_dev_buffer.get();
+      }
+    }
 
-        for (int64_t h = 0; h < norm_size; h++) {
-          mean += p_input[h];
-          mean_square += p_input[h] * p_input[h];
-        }
+    MlasLayerNormalization(params, p_ctx->GetOperatorThreadPool());
 
-        mean = mean / norm_size;
-        if (simplified) {
-          mean_square = sqrt(mean_square / norm_size + epsilon);
-        } else {
-          mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon);
-        }
+    if constexpr (!std::is_same_v<U, float>) {
+      if (mean_data != nullptr) {
+        MlasConvertFloatToHalfBuffer(mean_buffer.get(), &mean_data->val, row_count);
+      }
+      if (inv_std_dev_data != nullptr) {
+        MlasConvertFloatToHalfBuffer(inv_std_dev_buffer.get(), &inv_std_dev_data->val, row_count);
+      }
+    }
+  } else {
+    concurrency::ThreadPool::TryBatchParallelFor(
+        p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(norm_count),
+        [&](ptrdiff_t task_idx) {
+          const T* p_input = X_data + task_idx * norm_size;
+          T* p_output = Y_data + task_idx * norm_size;
+
+          T mean = 0;
+          T mean_square = 0;
+
+          for (int64_t h = 0; h < norm_size; h++) {
+            mean += p_input[h];
+            mean_square += p_input[h] * p_input[h];
+          }
 
-        for (int64_t h = 0; h < norm_size; h++) {
+          mean = mean / norm_size;
           if (simplified) {
-            p_output[h] = p_input[h] / mean_square * scale_data[h];
-          } else if (nullptr == bias) {
-            p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h];
+            mean_square = sqrt(mean_square / norm_size + epsilon);
           } else {
-            p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
+            mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon);
           }
-        }
 
-        if (mean_data != nullptr) {
-          // ONNX spec doesn't support 'double' for 'U' so when 'T' == double, 'U' == float and we need to narrow
-          mean_data[task_idx] = gsl::narrow_cast<U>(mean);
-        }
+          for (int64_t h = 0; h < norm_size; h++) {
+            if (simplified) {
+              p_output[h] = p_input[h] / mean_square * scale_data[h];
+            } else if (nullptr == bias) {
+              p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h];
+            } else {
+              p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
+            }
+          }
 
-        if (inv_std_dev_data != nullptr) {
-          inv_std_dev_data[task_idx] = gsl::narrow_cast<U>(1 / mean_square);
-        }
-      },
-      0);
+          if (mean_data != nullptr) {
+            // ONNX spec doesn't support 'double' for 'U' so when 'T' == double, 'U' == float and we need to narrow
+            mean_data[task_idx] = gsl::narrow_cast<U>(mean);
+          }
+
+          if (inv_std_dev_data != nullptr) {
+            inv_std_dev_data[task_idx] = gsl::narrow_cast<U>(1 / mean_square);
+          }
+        },
+        0);
+  }
 
   return Status::OK();
 }
@@ -141,7 +200,11 @@ struct SrcDispatcher {
 Status LayerNormImpl::Compute(OpKernelContext* p_ctx) const {
   const auto elem_type = p_ctx->Input<Tensor>(0)->GetElementType();
 
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+  using SupportedTypeList = boost::mp11::mp_list<float, double, MLFloat16>;
+#else
   using SupportedTypeList = boost::mp11::mp_list<float, double>;
+#endif
 
   utils::MLTypeCallDispatcherFromTypeList<SupportedTypeList> t_disp(elem_type);
   return t_disp.InvokeRet<Status, SrcDispatcher>(p_ctx, axis_, epsilon_, simplified_, contrib_op_);
@@ -9,7 +9,10 @@
 #include "core/platform/threadpool.h"
 
 #include <functional>
+#include <limits>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 namespace onnxruntime {
 
@@ -25,69 +28,71 @@ ONNX_CPU_OPERATOR_KERNEL(
 
 namespace ngram_details {
 
-// NgrampPart implements a Trie like structure
-// for a unigram (1) it would insert into a root map with a valid id.
-// for (1,2,3) node 2 would be a child of 1 but have id == 0
-// because (1,2) does not exists. Node 3 would have a valid id.
-template <class T>
-struct NgramPart;
-
-template <>
-struct NgramPart<int64_t>;
-
-template <>
-struct NgramPart<std::string>;
+inline int64_t ToKey(int64_t item) { return item; }
+inline std::string_view ToKey(const std::string& item) { return item; }
+
+// NgramTrie is the n-gram pool compiled into a flat trie.
+// Node 0 is the root and every other node is an n-gram prefix; for (1,2,3)
+// node (1,2) exists but has id == 0 because (1,2) is not in the pool,
+// while (1,2,3) has a valid id.
+// All edges live in one hash table keyed by (parent node, item), so walking
+// down the trie is one probe into one table per item instead of a chain of
+// per-node tables. String items are views of the pool_strings attribute.
+template <class K>
+class NgramTrie {
+ public:
+  using Edge = std::pair<uint32_t, K>;
+
+  bool empty() const { return edges_.empty(); }
+
+  // Returns the child of node for item, 0 if there is none
+  uint32_t Find(uint32_t node, K item) const {
+    auto hit = edges_.find(Edge{node, item});
+    return hit == edges_.end() ? 0 : hit->second;
+  }
 
-using NgramPartInt = NgramPart<int64_t>;
-using NgramPartString = NgramPart<std::string>;
+  // Returns the n-gram id of node, 0 if no n-gram ends there
+  size_t NgramId(uint32_t node) const { return ngram_ids_[node]; }
 
-// Avoid recursive class definitions using unique_ptr + forward declaration
-using IntMap = InlinedHashMap<int64_t, std::unique_ptr<NgramPartInt>>;
+  // Returns next ngram_id
+  template <class ForwardIter>
+  size_t Populate(ForwardIter first, size_t ngrams, size_t ngram_size, size_t ngram_id) {
+    if (ngram_ids_.empty()) {
+      ngram_ids_.push_back(0);  // root
+    }
+    for (; ngrams > 0; --ngrams) {
+      uint32_t node = 0;
+      for (size_t n = 0; n < ngram_size; ++n, ++first) {
+        ORT_ENFORCE(ngram_ids_.size() < std::numeric_limits<uint32_t>::max(), "Too many n-gram items in the pool");
+        auto p = edges_.emplace(Edge{node, ToKey(*first)}, static_cast<uint32_t>(ngram_ids_.size()));
+        if (p.second) {
+          ngram_ids_.push_back(0);
+        }
+        node = p.first->second;
+      }
+      ORT_ENFORCE(ngram_ids_[node] == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
+      ngram_ids_[node] = ngram_id;
+      ++ngram_id;
+    }
+    return ngram_id;
+  }
 
+ private:
 #ifndef DISABLE_ABSEIL
-using StrMap = absl::flat_hash_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                   std::hash<std::string>, std::equal_to<std::string>>;
+  absl::flat_hash_map<Edge, uint32_t> edges_;
 #else
-using StrMap = std::unordered_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                  std::hash<std::string>, std::equal_to<std::string>>;
+  struct EdgeHash {
+    size_t operator()(const Edge& edge) const {
+      return std::hash<K>{}(edge.second) ^ (std::hash<uint32_t>{}(edge.first) * 0x9E3779B97F4A7C15ULL);
+    }
+  };
+  std::unordered_map<Edge, uint32_t, EdgeHash> edges_;
 #endif
-
-template <>
-struct NgramPart<int64_t> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  IntMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
+  std::vector<size_t> ngram_ids_;
 };
 
-template <>
-struct NgramPart<std::string> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  StrMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
-};
-
-// Returns next ngram_id
-template <class K, class ForwardIter, class Map>
-inline size_t PopulateGrams(ForwardIter first, size_t ngrams, size_t ngram_size, size_t ngram_id,
-                            Map& c) {
-  for (; ngrams > 0; --ngrams) {
-    size_t n = 1;
-    Map* m = &c;
-    while (true) {
-      auto p = m->emplace(*first, std::make_unique<NgramPart<K>>(0));
-      ++first;
-      if (n == ngram_size) {
-        ORT_ENFORCE(p.first->second->id_ == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
-        p.first->second->id_ = ngram_id;
-        ++ngram_id;
-        break;
-      }
-      ++n;
-      m = &p.first->second->leafs_;
-    }
-  }
-  return ngram_id;
-}
+using NgramTrieInt = NgramTrie<int64_t>;
+using NgramTrieString = NgramTrie<std::string_view>;
 
 }  // namespace ngram_details
 }  // namespace onnxruntime
@@ -134,11 +139,11 @@ struct TfIdfVectorizer::Impl {
   gsl::span<const int64_t> ngram_indexes_;
   gsl::span<const float> weights_;
 
-  // This map contains references to pool_string_ entries
+  // This trie contains references to pool_string_ entries
   // of pool_strings attribute
-  StrMap str_map_;
-  // This map contains pool_int64s entries
-  IntMap int64_map_;
+  NgramTrieString str_trie_;
+  // This trie contains pool_int64s entries
+  NgramTrieInt int64_trie_;
 
   size_t output_size_ = 0;
 
@@ -241,9 +246,9 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
       // Skip loading into hash_set ngrams that are not in the range of [min_gram_length-max_gram_length]
       if (ngram_size >= min_gram_length && ngram_size <= max_gram_length) {
         if (pool_strings.empty()) {
-          ngram_id = PopulateGrams<int64_t>(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_map_);
+          ngram_id = impl_->int64_trie_.Populate(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id);
         } else {
-          ngram_id = PopulateGrams<std::string>(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_map_);
+          ngram_id = impl_->str_trie_.Populate(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id);
         }
       } else {
         ngram_id += ngrams;
@@ -281,39 +286,39 @@ void TfIdfVectorizer::ComputeImpl(const void* x_data_raw, size_t elem_size, ptrd
       auto ngram_item = ngram_start;
       if (is_input_string) {
         const std::string* str_item = reinterpret_cast<const std::string*>(ngram_item);
-        const StrMap* str_map = &impl.str_map_;
+        const NgramTrieString& str_trie = impl.str_trie_;
+        uint32_t node = 0;
         for (auto ngram_size = 1;
-             !str_map->empty() &&
              ngram_size <= max_gram_length &&
              str_item < ngram_row_end;
              ++ngram_size, str_item += skip_distance) {
-          auto hit = str_map->find(*str_item);
-          if (hit == str_map->end()) {
+          node = str_trie.Find(node, *str_item);
+          if (node == 0) {
             break;
           }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            output_idx = impl.OutputIdToIncrement(hit->second->id_);
+          const size_t id = str_trie.NgramId(node);
+          if (ngram_size >= start_ngram_size && id != 0) {
+            output_idx = impl.OutputIdToIncrement(id);
             fn_weight(output_idx, output_data);
           }
-          str_map = &hit->second->leafs_;
         }
       } else {
-        const IntMap* int_map = &impl.int64_map_;
+        const NgramTrieInt& int_trie = impl.int64_trie_;
+        uint32_t node = 0;
         for (auto ngram_size = 1;
-             !int_map->empty() &&
              ngram_size <= max_gram_length &&
              ngram_item < ngram_row_end;
              ++ngram_size, ngram_item = AdvanceElementPtr(ngram_item, skip_distance, elem_size)) {
           int64_t val = (elem_size == 4) ? int64_t{*reinterpret_cast<const int32_t*>(ngram_item)} : *reinterpret_cast<const int64_t*>(ngram_item);
-          auto hit = int_map->find(val);
-          if (hit == int_map->end()) {
+          node = int_trie.Find(node, val);
+          if (node == 0) {
             break;
           }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            output_idx = impl.OutputIdToIncrement(hit->second->id_);
+          const size_t id = int_trie.NgramId(node);
+          if (ngram_size >= start_ngram_size && id != 0) {
+            output_idx = impl.OutputIdToIncrement(id);
             fn_weight(output_idx, output_data);
           }
-          int_map = &hit->second->leafs_;
         }
       }
       // Sliding window shift
@@ -373,8 +378,8 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
   const bool is_input_string = X->IsDataTypeString();
 
   if (total_items == 0 ||
-      (is_input_string && impl_->str_map_.empty()) ||
-      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_map_.empty())) {
+      (is_input_string && impl_->str_trie_.empty()) ||
+      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_trie_.empty())) {
     // TfidfVectorizer may receive an empty input when it follows a Tokenizer
     // (for example for a string containing only stopwords).
     // TfidfVectorizer returns a zero tensor of shape
@@ -13,10 +13,12 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 
-#include <queue>
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
 #include "non_max_suppression_helper.h"
 
 // TODO:fix the warnings
@@ -43,6 +45,78 @@ ONNX_OPERATOR_KERNEL_EX(
 
 using namespace nms_helpers;
 
+namespace {
+
+// The corners and the area of a box, computed once per batch rather than for every pair of boxes compared.
+struct BoxCorners {
+  float x_min;
+  float y_min;
+  float x_max;
+  float y_max;
+  float area;
+};
+
+BoxCorners GetBoxCorners(const float* box, int64_t center_point_box) {
+  BoxCorners corners{};
+  // center_point_box_ only support 0 or 1
+  if (0 == center_point_box) {
+    // boxes data format [y1, x1, y2, x2],
+    MaxMin(box[1], box[3], corners.x_min, corners.x_max);
+    MaxMin(box[0], box[2], corners.y_min, corners.y_max);
+  } else {
+    // 1 == center_point_box_ => boxes data format [x_center, y_center, width, height]
+    const float width_half = box[2] / 2;
+    const float height_half = box[3] / 2;
+    corners.x_min = box[0] - width_half;
+    corners.x_max = box[0] + width_half;
+    corners.y_min = box[1] - height_half;
+    corners.y_max = box[1] + height_half;
+  }
+  corners.area = (corners.x_max - corners.x_min) * (corners.y_max - corners.y_min);
+  return corners;
+}
+
+// Same result as nms_helpers::SuppressByIOU, but without branches so that it can be evaluated for several selected
+// boxes at once.
+inline bool SuppressByIOU(const BoxCorners& box1, const BoxCorners& box2, float iou_threshold) {
+  const float intersection_x_min = std::max(box1.x_min, box2.x_min);
+  const float intersection_x_max = std::min(box1.x_max, box2.x_max);
+  const float intersection_y_min = std::max(box1.y_min, box2.y_min);
+  const float intersection_y_max = std::min(box1.y_max, box2.y_max);
+  const float intersection_area = (intersection_x_max - intersection_x_min) *
+                                  (intersection_y_max - intersection_y_min);
+  const float union_area = box1.area + box2.area - intersection_area;
+
+  return !(intersection_x_max <= intersection_x_min) & !(intersection_y_max <= intersection_y_min) &
+         !(intersection_area <= .0f) & !(box1.area <= .0f) & !(box2.area <= .0f) & !(union_area <= .0f) &
+         (intersection_area / union_area > iou_threshold);
+}
+
+// Whether `box` is suppressed by any of the boxes selected so far. The selected boxes are checked in blocks without
+// branches, stopping after the first block with a suppressing box.
+bool IsSuppressed(const BoxCorners& box, const std::vector<BoxCorners>& selected, float iou_threshold) {
+  constexpr size_t kBlockSize = 8;
+  const size_t num_selected = selected.size();
+  size_t i = 0;
+  for (; i + kBlockSize <= num_selected; i += kBlockSize) {
+    bool suppressed = false;
+    for (size_t j = i; j < i + kBlockSize; ++j) {
+      suppressed |= SuppressByIOU(box, selected[j], iou_threshold);
+    }
+    if (suppressed) {
+      return true;
+    }
+  }
+  for (; i < num_selected; ++i) {
+    if (SuppressByIOU(box, selected[i], iou_threshold)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
 // This works for both CPU and GPU.
 // CUDA kernel declare OrtMemTypeCPUInput for max_output_boxes_per_class(2), iou_threshold(3) and score_threshold(4)
 Status NonMaxSuppressionBase::PrepareCompute(OpKernelContext* ctx, PrepareContext& pc) {
@@ -148,55 +222,73 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   };
 
   const auto center_point_box = GetCenterPointBox();
+  const int64_t num_boxes = pc.num_boxes_;
 
-  std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfoPtr> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_));
-
-  for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfoPtr> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            candidate_boxes.emplace_back(*class_scores, box_index);
+  // the corners of the boxes are shared by all the classes of a batch
+  std::vector<BoxCorners> box_corners(narrow<size_t>(pc.num_batches_ * num_boxes));
+  for (size_t i = 0; i < box_corners.size(); ++i) {
+    box_corners[i] = GetBoxCorners(boxes_data + 4 * i, center_point_box);
+  }
+
+  // the boxes selected for each batch and class, which are processed concurrently
+  const auto num_batch_classes = narrow<std::ptrdiff_t>(pc.num_batches_ * pc.num_classes_);
+  std::vector<std::vector<int64_t>> selected_boxes(num_batch_classes);
+  const size_t max_selected = std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_);
+
+  const double cost_per_class = static_cast<double>(num_boxes) * 64.0;
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), num_batch_classes, cost_per_class,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<BoxInfoPtr> candidate_boxes;
+        candidate_boxes.reserve(pc.num_boxes_);
+        std::vector<BoxCorners> selected_corners;
+        selected_corners.reserve(max_selected);
+
+        for (std::ptrdiff_t batch_class = first; batch_class < last; ++batch_class) {
+          const int64_t batch_index = batch_class / pc.num_classes_;
+          const BoxCorners* batch_corners = box_corners.data() + batch_index * num_boxes;
+
+          // Filter by score_threshold_
+          candidate_boxes.clear();
+          const auto* class_scores = scores_data + batch_class * num_boxes;
+          if (pc.score_threshold_ != nullptr) {
+            for (int64_t box_index = 0; box_index < num_boxes; ++box_index, ++class_scores) {
+              if (*class_scores > score_threshold) {
+                candidate_boxes.emplace_back(*class_scores, box_index);
+              }
+            }
+          } else {
+            for (int64_t box_index = 0; box_index < num_boxes; ++box_index, ++class_scores) {
+              candidate_boxes.emplace_back(*class_scores, box_index);
+            }
           }
-        }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          candidate_boxes.emplace_back(*class_scores, box_index);
-        }
-      }
-      std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfoPtr& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (SuppressByIOU(batch_boxes, next_top_score.index_, selected_index.index_, center_point_box, iou_threshold)) {
-            selected = false;
-            break;
+          // a heap only orders as many candidates as are popped until max_output_boxes_per_class are selected
+          std::make_heap(candidate_boxes.begin(), candidate_boxes.end());
+          auto heap_end = candidate_boxes.end();
+
+          auto& selected_inside_class = selected_boxes[batch_class];
+          selected_corners.clear();
+          // Get the next box with top score, filter by iou_threshold
+          while (heap_end != candidate_boxes.begin() && selected_corners.size() < max_selected) {
+            const int64_t next_index = candidate_boxes.front().index_;
+            std::pop_heap(candidate_boxes.begin(), heap_end--);
+
+            // Check with existing selected boxes for this class, suppress if exceed the IOU threshold
+            const BoxCorners& next_corners = batch_corners[next_index];
+            if (!IsSuppressed(next_corners, selected_corners, iou_threshold)) {
+              selected_corners.push_back(next_corners);
+              selected_inside_class.push_back(next_index);
+            }
           }
         }
+      });
 
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
-        }
-        sorted_boxes.pop();
-      }  // while
-    }    // for class_index
-  }      // for batch_index
+  std::vector<SelectedIndex> selected_indices;
+  for (std::ptrdiff_t batch_class = 0; batch_class < num_batch_classes; ++batch_class) {
+    for (int64_t box_index : selected_boxes[batch_class]) {
+      selected_indices.emplace_back(batch_class / pc.num_classes_, batch_class % pc.num_classes_, box_index);
+    }
+  }
 
   constexpr auto last_dim = 3;
   const auto num_selected = selected_indices.size();
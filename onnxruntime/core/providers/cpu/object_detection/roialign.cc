@@ -17,7 +17,9 @@
 
 #include "roialign.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 #include <core/common/safeint.h>
 #include "core/util/math_cpuonly.h"
 #include "core/common/common.h"
@@ -154,6 +156,42 @@ static void PreCalcForBilinearInterpolate(const int64_t height, const int64_t wi
   }
 }
 
+// Computes the sampling grid of the ROI `roi` and fills `pre_calc` with the bilinear interpolation positions and
+// weights of its samples, which are shared by all channels.
+template <typename T>
+void PreCalcForRoi(const T* roi, float spatial_scale, bool half_pixel, int64_t height, int64_t width,
+                   int64_t pooled_height, int64_t pooled_width, int64_t sampling_ratio,
+                   int64_t& roi_bin_grid_h, int64_t& roi_bin_grid_w, std::vector<PreCalc<T>>& pre_calc) {
+  // Do not using rounding; this implementation detail is critical
+  T offset = half_pixel ? (T)0.5 : (T)0.0;
+  T roi_start_w = roi[0] * spatial_scale - offset;
+  T roi_start_h = roi[1] * spatial_scale - offset;
+  T roi_end_w = roi[2] * spatial_scale - offset;
+  T roi_end_h = roi[3] * spatial_scale - offset;
+
+  T roi_width = roi_end_w - roi_start_w;
+  T roi_height = roi_end_h - roi_start_h;
+  if (!half_pixel) {
+    // Force malformed ROIs to be 1x1
+    roi_width = std::max(roi_width, (T)1.);
+    roi_height = std::max(roi_height, (T)1.);
+  }
+
+  T bin_size_h = static_cast<T>(roi_height) / static_cast<T>(pooled_height);
+  T bin_size_w = static_cast<T>(roi_width) / static_cast<T>(pooled_width);
+
+  // We use roi_bin_grid to sample the grid and mimic integral
+  roi_bin_grid_h = (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_height / pooled_height));  // e.g., = 2
+  roi_bin_grid_w = (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_width / pooled_width));
+
+  // we want to precalculate indices and weights shared by all channels,
+  // this is the key point of optimization
+  pre_calc.resize(roi_bin_grid_h * roi_bin_grid_w * pooled_width * SafeInt<size_t>(pooled_height));
+  PreCalcForBilinearInterpolate(height, width, pooled_height, pooled_width, roi_bin_grid_h, roi_bin_grid_w,
+                                roi_start_h, roi_start_w, bin_size_h, bin_size_w, roi_bin_grid_h,
+                                roi_bin_grid_w, pre_calc);
+}
+
 template <typename T>
 void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, float spatial_scale, int64_t height,
                      int64_t width, int64_t sampling_ratio, const T* bottom_rois, int64_t num_roi_cols, T* top_data,
@@ -167,45 +205,19 @@ void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, floa
   double cost = static_cast<double>(channels * pooled_width * pooled_height * 100);
 
   ThreadPool::TryParallelFor(ttp, static_cast<ptrdiff_t>(n_rois), cost, [&](ptrdiff_t n, ptrdiff_t end) {
+    std::vector<PreCalc<T>> pre_calc;
     for (; n != end; ++n) {
       int64_t index_n = n * channels * pooled_width * pooled_height;
-
-      const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
       const auto roi_batch_ind = batch_indices_ptr[n];
 
-      // Do not using rounding; this implementation detail is critical
-      T offset = half_pixel ? (T)0.5 : (T)0.0;
-      T roi_start_w = offset_bottom_rois[0] * spatial_scale - offset;
-      T roi_start_h = offset_bottom_rois[1] * spatial_scale - offset;
-      T roi_end_w = offset_bottom_rois[2] * spatial_scale - offset;
-      T roi_end_h = offset_bottom_rois[3] * spatial_scale - offset;
-
-      T roi_width = roi_end_w - roi_start_w;
-      T roi_height = roi_end_h - roi_start_h;
-      if (!half_pixel) {
-        // Force malformed ROIs to be 1x1
-        roi_width = std::max(roi_width, (T)1.);
-        roi_height = std::max(roi_height, (T)1.);
-      }
-
-      T bin_size_h = static_cast<T>(roi_height) / static_cast<T>(pooled_height);
-      T bin_size_w = static_cast<T>(roi_width) / static_cast<T>(pooled_width);
-
-      // We use roi_bin_grid to sample the grid and mimic integral
-      int64_t roi_bin_grid_h = (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_height / pooled_height));  // e.g., = 2
-      int64_t roi_bin_grid_w =
-          (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_width / pooled_width));
+      int64_t roi_bin_grid_h = 0;
+      int64_t roi_bin_grid_w = 0;
+      PreCalcForRoi(bottom_rois + n * num_roi_cols, spatial_scale, half_pixel, height, width, pooled_height,
+                    pooled_width, sampling_ratio, roi_bin_grid_h, roi_bin_grid_w, pre_calc);
 
       // We do average (integral) pooling inside a bin
       const int64_t count = std::max(roi_bin_grid_h * roi_bin_grid_w, static_cast<int64_t>(1));  // e.g. = 4
 
-      // we want to precalculate indices and weights shared by all channels,
-      // this is the key point of optimization
-      std::vector<PreCalc<T>> pre_calc(roi_bin_grid_h * roi_bin_grid_w * pooled_width * SafeInt<size_t>(pooled_height));
-      PreCalcForBilinearInterpolate(height, width, pooled_height, pooled_width, roi_bin_grid_h, roi_bin_grid_w,
-                                    roi_start_h, roi_start_w, bin_size_h, bin_size_w, roi_bin_grid_h,
-                                    roi_bin_grid_w, pre_calc);
-
       for (int64_t c = 0; c < channels; c++) {
         int64_t index_n_c = index_n + c * pooled_width * pooled_height;
         const T* offset_bottom_data =
@@ -256,6 +268,101 @@ void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, floa
     }        // for n
   });
 }
+
+// Channels below which the channels last path doesn't have enough values per sample to vectorize.
+constexpr int64_t kMinChannelsForChannelsLast = 16;
+
+// Whether the ROIs sample enough of the input to pay for transposing it to channels last. Every output bin reads the
+// four corners of at least one sample per channel.
+bool UseChannelsLast(int64_t batch_size, int64_t channels, int64_t height, int64_t width, int64_t n_rois,
+                     int64_t pooled_height, int64_t pooled_width) {
+  return channels >= kMinChannelsForChannelsLast &&
+         n_rois * pooled_height * pooled_width * 4 >= batch_size * height * width;
+}
+
+// Same result as RoiAlignForward, from the input transposed to NHWC. The four corners of a sample are then
+// contiguous vectors of channels, so a sample updates all the channels of an output bin in one loop over contiguous
+// memory instead of gathering four values from a different plane for every channel.
+template <typename T>
+void RoiAlignForwardChannelsLast(const TensorShape& output_shape, const T* bottom_data_nhwc, float spatial_scale,
+                                 int64_t height, int64_t width, int64_t sampling_ratio, const T* bottom_rois,
+                                 int64_t num_roi_cols, T* top_data, RoiAlignMode mode, bool half_pixel,
+                                 const int64_t* batch_indices_ptr, ThreadPool* ttp) {
+  int64_t n_rois = output_shape[0];
+  int64_t channels = output_shape[1];
+  int64_t pooled_height = output_shape[2];
+  int64_t pooled_width = output_shape[3];
+  const int64_t pooled_size = pooled_height * pooled_width;
+
+  double cost = static_cast<double>(channels * pooled_width * pooled_height * 100);
+
+  ThreadPool::TryParallelFor(ttp, static_cast<ptrdiff_t>(n_rois), cost, [&](ptrdiff_t n, ptrdiff_t end) {
+    std::vector<PreCalc<T>> pre_calc;
+    std::vector<T> bin_values(onnxruntime::narrow<size_t>(channels));
+    for (; n != end; ++n) {
+      const T* batch_data = bottom_data_nhwc + batch_indices_ptr[n] * height * width * channels;
+
+      int64_t roi_bin_grid_h = 0;
+      int64_t roi_bin_grid_w = 0;
+      PreCalcForRoi(bottom_rois + n * num_roi_cols, spatial_scale, half_pixel, height, width, pooled_height,
+                    pooled_width, sampling_ratio, roi_bin_grid_h, roi_bin_grid_w, pre_calc);
+
+      // We do average (integral) pooling inside a bin
+      const int64_t count = std::max(roi_bin_grid_h * roi_bin_grid_w, static_cast<int64_t>(1));  // e.g. = 4
+      const int64_t samples_per_bin = roi_bin_grid_h * roi_bin_grid_w;
+
+      for (int64_t bin = 0; bin < pooled_size; ++bin) {
+        T* values = bin_values.data();
+        std::fill_n(values, channels, T{0});
+
+        for (int64_t sample = 0; sample < samples_per_bin; ++sample) {
+          const auto& pc = pre_calc[onnxruntime::narrow<size_t>(bin * samples_per_bin + sample)];
+          const T* data1 = batch_data + pc.pos1 * channels;
+          const T* data2 = batch_data + pc.pos2 * channels;
+          const T* data3 = batch_data + pc.pos3 * channels;
+          const T* data4 = batch_data + pc.pos4 * channels;
+          if (mode == RoiAlignMode::avg) {  // avg pooling
+            for (int64_t c = 0; c < channels; ++c) {
+              values[c] += pc.w1 * data1[c] + pc.w2 * data2[c] + pc.w3 * data3[c] + pc.w4 * data4[c];
+            }
+          } else {  // max pooling
+            for (int64_t c = 0; c < channels; ++c) {
+              T val = std::max(std::max(std::max(pc.w1 * data1[c], pc.w2 * data2[c]), pc.w3 * data3[c]),
+                               pc.w4 * data4[c]);
+              values[c] = sample == 0 ? val : std::max(values[c], val);
+            }
+          }
+        }
+
+        T* output = top_data + n * channels * pooled_size + bin;
+        for (int64_t c = 0; c < channels; ++c) {
+          output[c * pooled_size] = mode == RoiAlignMode::avg ? values[c] / count : values[c];
+        }
+      }  // for bin
+    }    // for n
+  });
+}
+
+// Transposes `input` from NCHW to NHWC, one row of the image at a time.
+template <typename T>
+void TransposeToChannelsLast(const T* input, int64_t batch_size, int64_t channels, int64_t height, int64_t width,
+                             T* output, ThreadPool* ttp) {
+  ThreadPool::TryParallelFor(
+      ttp, static_cast<ptrdiff_t>(batch_size * height), static_cast<double>(channels * width),
+      [&](ptrdiff_t first, ptrdiff_t last) {
+        for (ptrdiff_t row = first; row < last; ++row) {
+          const int64_t b = row / height;
+          const int64_t h = row % height;
+          T* output_row = output + row * width * channels;
+          for (int64_t c = 0; c < channels; ++c) {
+            const T* input_row = input + ((b * channels + c) * height + h) * width;
+            for (int64_t w = 0; w < width; ++w) {
+              output_row[w * channels + c] = input_row[w];
+            }
+          }
+        }
+      });
+}
 }  // namespace
 
 Status CheckROIAlignValidInput(const Tensor* X_ptr, const Tensor* rois_ptr, const Tensor* batch_indices_ptr) {
@@ -318,6 +425,23 @@ Status RoiAlign<T>::Compute(OpKernelContext* context) const {
 
   auto& Y = *context->Output(0, {num_rois, num_channels, this->output_height_, this->output_width_});
 
+  if (UseChannelsLast(x_dims[0], num_channels, x_dims[2], x_dims[3], num_rois, this->output_height_,
+                      this->output_width_)) {
+    AllocatorPtr alloc;
+    ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+    auto x_nhwc = IAllocator::MakeUniquePtr<T>(alloc, SafeInt<size_t>(x_dims.Size()));
+    TransposeToChannelsLast(X_ptr->Data<T>(), x_dims[0], num_channels, x_dims[2], x_dims[3], x_nhwc.get(),
+                            context->GetOperatorThreadPool());
+
+    RoiAlignForwardChannelsLast<T>(Y.Shape(), x_nhwc.get(), this->spatial_scale_,
+                                   x_dims[2],  // height
+                                   x_dims[3],  // width
+                                   this->sampling_ratio_, rois_ptr->Data<T>(), num_roi_cols,
+                                   Y.template MutableData<T>(), this->mode_, this->half_pixel_,
+                                   batch_indices_ptr->Data<int64_t>(), context->GetOperatorThreadPool());
+    return Status::OK();
+  }
+
   RoiAlignForward<T>(Y.Shape(), X_ptr->Data<T>(), this->spatial_scale_,
                      x_dims[2],  // height
                      x_dims[3],  // width
@@ -620,7 +620,9 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
   // requantizing to the output type.
   //
   // This buffer is not needed for the symmetric convolution path as requantization
-  // is fused with the GEMM compuation.
+  // is fused with the GEMM compuation. The non-depthwise QGEMM path also fuses the
+  // requantization through an output processor, so there the buffer only receives
+  // the int32_t accumulators of the block being requantized.
   BufferUniquePtr gemm_output_buffer;
   if (!is_symmetric_conv_) {
     auto* gemm_output_data = alloc->Alloc(SafeInt<size_t>(sizeof(int32_t)) * Y_offset);
@@ -969,9 +971,26 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
             gemm_params.C = worker_gemm_output + group_id * group_output_channels;
             gemm_params.ldc = static_cast<size_t>(M);
 
+            // Requantize each block of the GEMM output as soon as it is computed, while
+            // it is still in the cache, instead of in a separate pass over the output.
+            const bool per_channel_scale = output_scales.size() > 1;
+            MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR requant_proc(
+                worker_output + group_id * group_output_channels,
+                static_cast<size_t>(M),
+                Bdata != nullptr ? Bdata + group_id * group_output_channels : nullptr,
+                output_scales.data() + (per_channel_scale ? group_id * group_output_channels : 0),
+                per_channel_scale,
+                Y_zero_point_value,
+                std::is_signed<ActType>::value);
+            gemm_params.OutputProcessor = &requant_proc;
+
             MlasGemm(gemm_shape, gemm_params, nullptr);
           }
         }
+
+        if (!is_symmetric_gemm_) {
+          return;
+        }
       }
 
       MlasRequantizeOutput(
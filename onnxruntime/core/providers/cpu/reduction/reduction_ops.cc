@@ -336,6 +336,12 @@ static void ValidateFastReduceRKR(const gsl::span<const int64_t>& fast_shape, co
   ORT_ENFORCE(fast_shape[1] == output.Shape().Size(), "Output size mismatch.");
 }
 
+// Reductions of all elements smaller than two blocks of kFastReduceRMinBlockSize stay on the calling thread.
+static bool IsParallelFastReduceR(const gsl::span<const int64_t>& fast_shape, concurrency::ThreadPool* tp) {
+  return fast_shape.size() == 1 && concurrency::ThreadPool::DegreeOfParallelism(tp) > 1 &&
+         fast_shape[0] >= 2 * kFastReduceRMinBlockSize;
+}
+
 void ReduceAggregatorBase::FastReduceKR(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*) {
   ValidateMustBeOverloaded();
 }
@@ -348,6 +354,9 @@ void ReduceAggregatorBase::FastReduceKRK(const Tensor&, const gsl::span<const in
 void ReduceAggregatorBase::FastReduceRKR(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*) {
   ValidateMustBeOverloaded();
 }
+void ReduceAggregatorBase::FastReduceR(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*) {
+  ValidateMustBeOverloaded();
+}
 
 void NoTransposePrepareForReduce(const TensorShape& new_input_shape,
                                  gsl::span<const int64_t> reduced_axes,
@@ -754,7 +763,8 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
                             fast_reduce_fct* case_kr,
                             fast_reduce_fct* case_rk,
                             fast_reduce_fct* case_krk,
-                            fast_reduce_fct* case_rkr) {
+                            fast_reduce_fct* case_rkr,
+                            fast_reduce_fct* case_r) {
   TensorShapeVector axes;
   const Tensor* input = ctx->Input<Tensor>(0);
   auto reduced_dims = input->Shape().GetDims();
@@ -807,6 +817,12 @@ bool CommonFastReduceSwitch(OpKernelContext* ctx,
             break;
           }
         case FastReduceKind::kR:
+          if (IsParallelFastReduceR(fast_shape, ctx->GetOperatorThreadPool())) {
+            case_r(*input, fast_shape, *output, ctx->GetOperatorThreadPool());
+            return true;
+          } else {
+            break;
+          }
         case FastReduceKind::kK:
         case FastReduceKind::kNone:
         default:
@@ -830,7 +846,7 @@ bool CommonFastReduce(OpKernelContext* ctx,
   return CommonFastReduceSwitch(ctx, axes_, keepdims_, noop_with_empty_axes,
                                 fast_kind, fast_shape, output_shape, fast_axes,
                                 AGG::WhichFastReduce(), &AGG::FastReduceKR, &AGG::FastReduceRK,
-                                &AGG::FastReduceKRK, &AGG::FastReduceRKR);
+                                &AGG::FastReduceKRK, &AGG::FastReduceRKR, &AGG::FastReduceR);
 }
 
 static void ValidateKeepDims(const TensorShape& shape, int64_t keepdims) {
@@ -1077,6 +1093,12 @@ std::unique_ptr<Tensor> ReduceSum<T>::Impl(const Tensor& input, gsl::span<const
           break;
         }
       case FastReduceKind::kR:
+        if (IsParallelFastReduceR(fast_shape, tp)) {
+          ReduceAggregatorSum<T>::FastReduceR(input, fast_shape, *output, tp);
+          return output;
+        } else {
+          break;
+        }
       case FastReduceKind::kK:
       case FastReduceKind::kNone:
       default:
@@ -47,6 +47,9 @@ constexpr TensorOpCost ParallelReduceFastCost(int64_t n_row, int64_t n_col, int6
                       static_cast<double>(n_row * n_col * element_size * n_ops)};
 }
 
+/* Minimum number of elements reduced by each thread when all elements are reduced (FastReduceKind::kR). */
+constexpr int64_t kFastReduceRMinBlockSize = 16384;
+
 /**
   This only improves reduce function when reduced axes are contiguous:
   if len(shape) == 4, any single axis is ok, axes=(0, 1) or (1, 2) or (2, 3) is ok,
@@ -58,6 +61,7 @@ constexpr TensorOpCost ParallelReduceFastCost(int64_t n_row, int64_t n_col, int6
   *  RK - reduction on the first dimensions
   *  KRK - reduction on the middle dimensions.
   *  RKR - reduction on all dimensions but the middle ones
+  *  R - reduction on all dimensions
 
   For these three configuration, the reduction may be optimized
   with vectors operations. Method WhichFastReduce() returns which case
@@ -159,6 +163,7 @@ class ReduceAggregatorBase {
   static void FastReduceRK(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*);
   static void FastReduceKRK(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*);
   static void FastReduceRKR(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*);
+  static void FastReduceR(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*);
 };
 
 template <typename T, typename TVAL = T>
@@ -206,6 +211,35 @@ class ReduceAggregator : public ReduceAggregatorBase {
           }
         });
   }
+
+  // Reduces all elements in two passes: contiguous blocks are reduced in parallel, then the partial results
+  // are combined pairwise. The rounding error of a sum grows with the number of blocks instead of elements.
+  static void CommonFastReduceR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                Tensor& output, concurrency::ThreadPool* tp,
+                                std::function<TVAL(const T*, int64_t)> f_block,
+                                std::function<TVAL(const TVAL&, const TVAL&)> f_merge) {
+    const T* data = input.Data<T>();
+    const int64_t N = fast_shape[0];
+    const int64_t n_tasks = std::min(std::max<int64_t>(1, N / kFastReduceRMinBlockSize),
+                                     static_cast<int64_t>(concurrency::ThreadPool::DegreeOfParallelism(tp)) * 4);
+    const int64_t block_size = (N + n_tasks - 1) / n_tasks;
+    const int64_t n_blocks = (N + block_size - 1) / block_size;
+
+    auto partials = std::make_unique<TVAL[]>(onnxruntime::narrow<size_t>(n_blocks));
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(n_blocks),
+        [data, N, block_size, &partials, &f_block](std::ptrdiff_t b) {
+          const int64_t begin = b * block_size;
+          partials[b] = f_block(data + begin, std::min(block_size, N - begin));
+        });
+
+    for (int64_t stride = 1; stride < n_blocks; stride *= 2) {
+      for (int64_t b = 0; b + stride < n_blocks; b += 2 * stride) {
+        partials[b] = f_merge(partials[b], partials[b + stride]);
+      }
+    }
+    *output.MutableData<TVAL>() = partials[0];
+  }
 };
 
 template <typename T>
@@ -226,7 +260,8 @@ class ReduceAggregatorSum : public ReduceAggregator<T, T> {
 
   // Fast reduction
   static inline FastReduceKind WhichFastReduce() {
-    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR;
+    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR |
+           FastReduceKind::kR;
   }
 
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -287,6 +322,14 @@ class ReduceAggregatorSum : public ReduceAggregator<T, T> {
           value += aggall(p, size);
         });
   }
+
+  static void FastReduceR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                          Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregator<T, T>::CommonFastReduceR(
+        input, fast_shape, output, tp,
+        [](const T* p, int64_t size) -> T { return aggall(p, size); },
+        [](const T& a, const T& b) -> T { return a + b; });
+  }
 };
 
 template <typename T, typename TVAL = T>
@@ -366,6 +409,12 @@ class ReduceAggregatorMean : public ReduceAggregatorSum<T> {
       *out /= div;
     }
   }
+
+  static void FastReduceR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                          Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregatorSum<T>::FastReduceR(input, fast_shape, output, tp);
+    *output.MutableData<T>() /= static_cast<T>(fast_shape[0]);
+  }
 };
 
 template <typename T>
@@ -386,7 +435,8 @@ class ReduceAggregatorMax : public ReduceAggregator<T> {
 
   // Fast reduction
   static inline FastReduceKind WhichFastReduce() {
-    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR;
+    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR |
+           FastReduceKind::kR;
   }
 
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -483,6 +533,20 @@ class ReduceAggregatorMax : public ReduceAggregator<T> {
           }
         });
   }
+
+  static void FastReduceR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                          Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregator<T, T>::CommonFastReduceR(
+        input, fast_shape, output, tp,
+        [](const T* p, int64_t size) -> T { return aggall(p, size); },
+        [](const T& a, const T& b) -> T {
+          if constexpr (std::is_same_v<bool, T>) { /* bool specific impl */
+            return a || b;
+          } else {
+            return b > a ? b : a;
+          }
+        });
+  }
 };
 
 template <typename T, typename TVAL = int64_t>
@@ -596,7 +660,8 @@ class ReduceAggregatorMin : public ReduceAggregator<T, T> {
 
   // Fast reduction
   static inline FastReduceKind WhichFastReduce() {
-    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR;
+    return FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK | FastReduceKind::kRKR |
+           FastReduceKind::kR;
   }
 
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
@@ -693,6 +758,20 @@ class ReduceAggregatorMin : public ReduceAggregator<T, T> {
           }
         });
   }
+
+  static void FastReduceR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                          Tensor& output, concurrency::ThreadPool* tp) {
+    ReduceAggregator<T, T>::CommonFastReduceR(
+        input, fast_shape, output, tp,
+        [](const T* p, int64_t size) -> T { return aggall(p, size); },
+        [](const T& a, const T& b) -> T {
+          if constexpr (std::is_same_v<bool, T>) { /* bool specific impl */
+            return a && b;
+          } else {
+            return b < a ? b : a;
+          }
+        });
+  }
 };
 
 template <typename T>
@@ -198,7 +198,9 @@ ONNX_CPU_OPERATOR_KERNEL(
                                  DataTypeImpl::GetTensorType<int64_t>()}),
     SequenceInsert);
 
-// Using DataTransferManager here allows other non-CPU EPs to use this implementation of the sequence ops
+// Using DataTransferManager here allows other non-CPU EPs to use this implementation of the sequence ops.
+// Input tensors are copied, not shared, as the allocation planner may reuse their buffers once the kernel ran.
+// Tensors that are already in a sequence are shared instead, see TensorSeq::AddShared.
 static Tensor CloneTensor(const Tensor& in_tensor, OpKernelContext* context, const DataTransferManager& dtm) {
   AllocatorPtr alloc;
   ORT_THROW_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
@@ -7,6 +7,8 @@
 #include <complex>
 #include <functional>
 #include <limits>
+#include <mutex>
+#include <type_traits>
 #include <vector>
 #include <core/common/safeint.h>
 
@@ -313,11 +315,192 @@ static Status dft_bluestein_z_chirp(
   return Status::OK();
 }
 
+// A mixed radix FFT plan for a length whose only prime factors are 2, 3 and 5. A DFT of a real signal of even length
+// is computed with a complex FFT of half the length.
+template <typename T>
+struct MixedRadixPlan {
+  size_t dft_length = 0;
+  bool inverse = false;
+  bool real_input = false;
+
+  // The radices of the complex FFT, radix 4 first. The length of the complex FFT is their product.
+  InlinedVector<size_t> radices;
+  // exp(+-2*pi*i*j/fft_length) for j in [0, fft_length)
+  InlinedVector<std::complex<T>> twiddles;
+  // exp(+-2*pi*i*k/dft_length) for k in [0, dft_length/2], if the complex FFT is half the length of a real DFT
+  InlinedVector<std::complex<T>> real_twiddles;
+
+  // scratch buffers
+  InlinedVector<std::complex<T>> input;
+  InlinedVector<std::complex<T>> output;
+};
+
+static bool get_mixed_radices(size_t length, InlinedVector<size_t>& radices) {
+  radices.clear();
+  for (size_t radix : {4, 2, 3, 5}) {
+    while (length % radix == 0) {
+      radices.push_back(radix);
+      length /= radix;
+    }
+  }
+  return length == 1;
+}
+
+// Prepares `plan` for a DFT of `dft_length` and returns whether the length can be computed with a mixed radix FFT.
+template <typename T>
+static bool prepare_mixed_radix_plan(MixedRadixPlan<T>& plan, size_t dft_length, bool real_input, bool inverse) {
+  const bool half_length = real_input && dft_length % 2 == 0;
+  if (plan.dft_length == dft_length && plan.inverse == inverse && plan.real_input == half_length) {
+    return !plan.radices.empty();
+  }
+
+  plan.dft_length = dft_length;
+  plan.inverse = inverse;
+  plan.real_input = half_length;
+  plan.twiddles.clear();
+  plan.real_twiddles.clear();
+
+  const size_t fft_length = half_length ? dft_length / 2 : dft_length;
+  if (!get_mixed_radices(fft_length, plan.radices)) {
+    plan.radices.clear();
+    return false;
+  }
+
+  const auto angular_velocity = compute_angular_velocity<T>(fft_length, inverse);
+  plan.twiddles.resize(fft_length);
+  for (size_t j = 0; j < fft_length; j++) {
+    plan.twiddles[j] = compute_exponential(j, angular_velocity);
+  }
+
+  if (half_length) {
+    const auto real_angular_velocity = compute_angular_velocity<T>(dft_length, inverse);
+    plan.real_twiddles.resize(fft_length + 1);
+    for (size_t k = 0; k <= fft_length; k++) {
+      plan.real_twiddles[k] = compute_exponential(k, real_angular_velocity);
+    }
+  }
+
+  return true;
+}
+
+// Decimation in time FFT of the `length` values of `input` at `input_stride` into the contiguous `output`.
+// The FFT of a length is split into `radix` FFTs of the values at every radix-th position, which are then combined
+// with butterflies of that radix.
+template <typename T>
+static void mixed_radix_fft(const MixedRadixPlan<T>& plan, const std::complex<T>* input, size_t input_stride,
+                            std::complex<T>* output, size_t length, size_t radix_index) {
+  if (length == 1) {
+    *output = *input;
+    return;
+  }
+
+  const size_t radix = plan.radices[radix_index];
+  const size_t sub_length = length / radix;
+  for (size_t q = 0; q < radix; q++) {
+    mixed_radix_fft(plan, input + q * input_stride, input_stride * radix, output + q * sub_length, sub_length,
+                    radix_index + 1);
+  }
+
+  const size_t fft_length = plan.twiddles.size();
+  const size_t twiddle_stride = fft_length / length;
+  const size_t radix_twiddle_stride = fft_length / radix;
+  std::complex<T> t[5];
+  for (size_t k = 0; k < sub_length; k++) {
+    for (size_t q = 0; q < radix; q++) {
+      t[q] = output[q * sub_length + k] * plan.twiddles[q * k * twiddle_stride];
+    }
+
+    if (radix == 2) {
+      output[k] = t[0] + t[1];
+      output[sub_length + k] = t[0] - t[1];
+    } else if (radix == 4) {
+      // the powers of exp(+-2*pi*i/4) are 1, +-i, -1 and -+i
+      const std::complex<T> even_sum = t[0] + t[2];
+      const std::complex<T> even_difference = t[0] - t[2];
+      const std::complex<T> odd_sum = t[1] + t[3];
+      const std::complex<T> odd_difference = t[1] - t[3];
+      const std::complex<T> rotated = plan.inverse ? std::complex<T>(-odd_difference.imag(), odd_difference.real())
+                                                   : std::complex<T>(odd_difference.imag(), -odd_difference.real());
+      output[k] = even_sum + odd_sum;
+      output[sub_length + k] = even_difference + rotated;
+      output[2 * sub_length + k] = even_sum - odd_sum;
+      output[3 * sub_length + k] = even_difference - rotated;
+    } else {
+      for (size_t r = 0; r < radix; r++) {
+        std::complex<T> sum = t[0];
+        for (size_t q = 1; q < radix; q++) {
+          sum += t[q] * plan.twiddles[((q * r) % radix) * radix_twiddle_stride];
+        }
+        output[r * sub_length + k] = sum;
+      }
+    }
+  }
+}
+
+template <typename T, typename U>
+static Status fft_mixed_radix(const Tensor* X, Tensor* Y, size_t X_offset, size_t X_stride, size_t Y_offset,
+                              size_t Y_stride, int64_t axis, size_t dft_length, const Tensor* window,
+                              bool is_onesided, bool inverse, MixedRadixPlan<T>& plan) {
+  const auto& X_shape = X->Shape();
+  size_t number_of_samples = static_cast<size_t>(X_shape[onnxruntime::narrow<size_t>(axis)]);
+
+  const auto* X_data = reinterpret_cast<const U*>(X->DataRaw()) + X_offset;
+  const T* window_data = window ? reinterpret_cast<const T*>(window->DataRaw()) : nullptr;
+  auto* Y_data = reinterpret_cast<std::complex<T>*>(Y->MutableDataRaw()) + Y_offset;
+
+  auto get_sample = [&](size_t n) -> std::complex<T> {
+    if (n >= number_of_samples) {
+      return std::complex<T>(0, 0);
+    }
+    std::complex<T> sample = *(X_data + n * X_stride);
+    return window_data ? sample * *(window_data + n) : sample;
+  };
+
+  const size_t output_size = is_onesided ? (dft_length >> 1) + 1 : dft_length;
+  const T scale = inverse ? static_cast<T>(1) / static_cast<T>(dft_length) : static_cast<T>(1);
+
+  if (plan.real_input) {
+    // Pack the even and odd samples into the real and imaginary parts of a signal of half the length. The DFTs of
+    // the even and odd samples are conjugate symmetric, so they can be separated from the FFT of the packed signal.
+    const size_t half_length = dft_length / 2;
+    plan.input.resize(half_length);
+    plan.output.resize(half_length);
+    for (size_t n = 0; n < half_length; n++) {
+      plan.input[n] = std::complex<T>(get_sample(2 * n).real(), get_sample(2 * n + 1).real());
+    }
+    mixed_radix_fft(plan, plan.input.data(), 1, plan.output.data(), half_length, 0);
+
+    for (size_t k = 0; k <= half_length; k++) {
+      const std::complex<T> z = plan.output[k % half_length];
+      const std::complex<T> z_mirror = std::conj(plan.output[(half_length - k) % half_length]);
+      const std::complex<T> even = (z + z_mirror) * static_cast<T>(0.5);
+      const std::complex<T> odd = (z - z_mirror) * std::complex<T>(0, static_cast<T>(-0.5));
+      *(Y_data + k * Y_stride) = (even + plan.real_twiddles[k] * odd) * scale;
+    }
+    for (size_t k = half_length + 1; k < output_size; k++) {
+      *(Y_data + k * Y_stride) = std::conj(*(Y_data + (dft_length - k) * Y_stride));
+    }
+    return Status::OK();
+  }
+
+  plan.input.resize(dft_length);
+  plan.output.resize(dft_length);
+  for (size_t n = 0; n < dft_length; n++) {
+    plan.input[n] = get_sample(n);
+  }
+  mixed_radix_fft(plan, plan.input.data(), 1, plan.output.data(), dft_length, 0);
+
+  for (size_t k = 0; k < output_size; k++) {
+    *(Y_data + k * Y_stride) = plan.output[k] * scale;
+  }
+  return Status::OK();
+}
+
 template <typename T, typename U>
 static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X, Tensor* Y, Tensor& b_fft, Tensor& chirp,
                                          int64_t axis, int64_t dft_length, const Tensor* window, bool is_onesided, bool inverse,
                                          InlinedVector<std::complex<T>>& V,
-                                         InlinedVector<std::complex<T>>& temp_output) {
+                                         InlinedVector<std::complex<T>>& temp_output, MixedRadixPlan<T>& plan) {
   // Get shape
   const auto& X_shape = X->Shape();
   const auto& Y_shape = Y->Shape();
@@ -332,6 +515,10 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X,
     batch_and_signal_rank -= 1;
   }
 
+  const bool use_mixed_radix = !is_power_of_2(onnxruntime::narrow<size_t>(dft_length)) &&
+                               prepare_mixed_radix_plan(plan, onnxruntime::narrow<size_t>(dft_length),
+                                                        std::is_same<T, U>::value, inverse);
+
   // Calculate x/y offsets/strides
   for (size_t i = 0; i < total_dfts; i++) {
     size_t X_offset = 0;
@@ -365,6 +552,10 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, const Tensor* X,
     if (is_power_of_2(onnxruntime::narrow<size_t>(dft_length))) {
       ORT_RETURN_IF_ERROR((fft_radix2<T, U>(ctx, X, Y, X_offset, X_stride, Y_offset, Y_stride, axis, onnxruntime::narrow<size_t>(dft_length), window,
                                             is_onesided, inverse, V, temp_output)));
+    } else if (use_mixed_radix) {
+      ORT_RETURN_IF_ERROR((fft_mixed_radix<T, U>(X, Y, X_offset, X_stride, Y_offset, Y_stride, axis,
+                                                 onnxruntime::narrow<size_t>(dft_length), window, is_onesided,
+                                                 inverse, plan)));
     } else {
       ORT_RETURN_IF_ERROR(
           (dft_bluestein_z_chirp<T, U>(ctx, X, Y, b_fft, chirp, X_offset, X_stride, Y_offset, Y_stride, axis, onnxruntime::narrow<size_t>(dft_length), window, inverse, V, temp_output)));
@@ -413,12 +604,14 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, int64_t axis, boo
   if (element_size == sizeof(float)) {
     InlinedVector<std::complex<float>> V;
     InlinedVector<std::complex<float>> temp_output;
+    MixedRadixPlan<float> plan;
     if (is_real_valued) {
       ORT_RETURN_IF_ERROR((discrete_fourier_transform<float, float>(ctx, X, Y, b_fft, chirp, axis, number_of_samples, nullptr,
-                                                                    is_onesided, inverse, V, temp_output)));
+                                                                    is_onesided, inverse, V, temp_output, plan)));
     } else if (is_complex_valued) {
       ORT_RETURN_IF_ERROR((discrete_fourier_transform<float, std::complex<float>>(
-          ctx, X, Y, b_fft, chirp, axis, number_of_samples, nullptr, is_onesided, inverse, V, temp_output)));
+          ctx, X, Y, b_fft, chirp, axis, number_of_samples, nullptr, is_onesided, inverse, V, temp_output,
+          plan)));
     } else {
       ORT_THROW(
           "Unsupported input signal shape. The signal's first dimension must be the batch dimension and its second "
@@ -429,12 +622,14 @@ static Status discrete_fourier_transform(OpKernelContext* ctx, int64_t axis, boo
   } else if (element_size == sizeof(double)) {
     InlinedVector<std::complex<double>> V;
     InlinedVector<std::complex<double>> temp_output;
+    MixedRadixPlan<double> plan;
     if (is_real_valued) {
       ORT_RETURN_IF_ERROR((discrete_fourier_transform<double, double>(ctx, X, Y, b_fft, chirp, axis, number_of_samples, nullptr,
-                                                                      is_onesided, inverse, V, temp_output)));
+                                                                      is_onesided, inverse, V, temp_output, plan)));
     } else if (is_complex_valued) {
       ORT_RETURN_IF_ERROR((discrete_fourier_transform<double, std::complex<double>>(
-          ctx, X, Y, b_fft, chirp, axis, number_of_samples, nullptr, is_onesided, inverse, V, temp_output)));
+          ctx, X, Y, b_fft, chirp, axis, number_of_samples, nullptr, is_onesided, inverse, V, temp_output,
+          plan)));
     } else {
       ORT_THROW(
           "Unsupported input signal shape. The signal's first dimension must be the batch dimension and its second "
@@ -529,31 +724,49 @@ static Status short_time_fourier_transform(OpKernelContext* ctx, bool is_oneside
   auto dft_input_shape = onnxruntime::TensorShape({1, window_size, signal_components});
   auto dft_output_shape = onnxruntime::TensorShape({1, dft_output_size, output_components});
 
-  Tensor b_fft, chirp;
-  InlinedVector<std::complex<T>> V;
-  InlinedVector<std::complex<T>> temp_output;
-
-  // Run each dft of each batch as if it was a real-valued batch size 1 dft operation
-  for (int64_t batch_idx = 0; batch_idx < batch_size; batch_idx++) {
-    for (int64_t i = 0; i < n_dfts; i++) {
-      auto input_frame_begin =
-          signal_data + (batch_idx * signal_size * signal_components) + (i * frame_step * signal_components);
-
-      auto output_frame_begin = Y_data + (batch_idx * n_dfts * dft_output_size * output_components) +
-                                (i * dft_output_size * output_components);
-
-      // Tensors do not own the backing memory, so no worries on destruction
-      auto input = onnxruntime::Tensor(signal->DataType(), dft_input_shape, input_frame_begin, signal->Location(), 0);
-
-      auto output = onnxruntime::Tensor(Y->DataType(), dft_output_shape, output_frame_begin, Y->Location(), 0);
-
-      // Run individual dft
-      ORT_RETURN_IF_ERROR((discrete_fourier_transform<T, U>(ctx, &input, &output, b_fft, chirp, 1, window_size, window, is_onesided,
-                                                            false, V, temp_output)));
-    }
-  }
-
-  return Status::OK();
+  // The frames are independent. Each thread keeps its own FFT plans, which are created for its first frame and
+  // reused for the others.
+  const auto total_dfts = batch_size * n_dfts;
+  const double cost_per_dft = 5.0 * static_cast<double>(window_size) * std::log2(static_cast<double>(window_size) + 1);
+  std::mutex status_mutex;
+  Status status;
+
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), onnxruntime::narrow<std::ptrdiff_t>(total_dfts), cost_per_dft,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        Tensor b_fft, chirp;
+        InlinedVector<std::complex<T>> V;
+        InlinedVector<std::complex<T>> temp_output;
+        MixedRadixPlan<T> plan;
+
+        // Run each dft of each batch as if it was a real-valued batch size 1 dft operation
+        for (std::ptrdiff_t dft_index = first; dft_index < last; dft_index++) {
+          const int64_t batch_idx = dft_index / n_dfts;
+          const int64_t i = dft_index % n_dfts;
+          auto input_frame_begin =
+              signal_data + (batch_idx * signal_size * signal_components) + (i * frame_step * signal_components);
+
+          auto output_frame_begin = Y_data + (batch_idx * n_dfts * dft_output_size * output_components) +
+                                    (i * dft_output_size * output_components);
+
+          // Tensors do not own the backing memory, so no worries on destruction
+          auto input = onnxruntime::Tensor(signal->DataType(), dft_input_shape, input_frame_begin,
+                                           signal->Location(), 0);
+
+          auto output = onnxruntime::Tensor(Y->DataType(), dft_output_shape, output_frame_begin, Y->Location(), 0);
+
+          // Run individual dft
+          auto dft_status = discrete_fourier_transform<T, U>(ctx, &input, &output, b_fft, chirp, 1, window_size,
+                                                             window, is_onesided, false, V, temp_output, plan);
+          if (!dft_status.IsOK()) {
+            std::lock_guard<std::mutex> lock(status_mutex);
+            status = std::move(dft_status);
+            return;
+          }
+        }
+      });
+
+  return status;
 }
 
 Status STFT::Compute(OpKernelContext* ctx) const {
@@ -2,7 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/compress.h"
+#include <algorithm>
+#include <numeric>
 #include "core/providers/common.h"
+#include "core/platform/threadpool.h"
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
@@ -25,6 +28,9 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<bool>()),
     Compress);
 
+// Conditions shorter than this are scanned by a single block
+constexpr int64_t kCompressMinBlockSize = 16384;
+
 Status Compress::Compute(OpKernelContext* ctx) const {
   const auto* input_tensor = ctx->Input<Tensor>(0);
   size_t rank = input_tensor->Shape().NumDimensions();
@@ -38,17 +44,28 @@ Status Compress::Compute(OpKernelContext* ctx) const {
   auto condition_length = condition->Shape().Size();
   auto condition_data = condition->Data<bool>();
 
-  int64_t positive_condition_count = 0;
   // if has axis, we need to compress on dimension[axis], otherwise compress on the flattened input data
   int64_t compress_input_length = has_axis_ ? input_dimensions[onnxruntime::narrow<size_t>(axis)] : input_tensor->Shape().Size();
   int64_t valid_condition_length = compress_input_length < condition_length ? compress_input_length : condition_length;
 
-  // Figure out output shape
-  for (int i = 0; i < valid_condition_length; ++i) {
-    if (condition_data[i]) {
-      ++positive_condition_count;
+  // The output size depends on the condition, so it is compacted in two phases: every block of the condition
+  // counts its true values in parallel, a prefix sum gives the output position each block starts at, and then
+  // the selected entries are copied in parallel.
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const std::ptrdiff_t num_blocks = std::max<std::ptrdiff_t>(
+      1, std::min<std::ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(tp),
+                                  static_cast<std::ptrdiff_t>(valid_condition_length / kCompressMinBlockSize)));
+  std::vector<int64_t> block_offsets(static_cast<size_t>(num_blocks) + 1, 0);
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t block) {
+    const auto work = concurrency::ThreadPool::PartitionWork(block, num_blocks, valid_condition_length);
+    int64_t count = 0;
+    for (std::ptrdiff_t i = work.start; i < work.end; ++i) {
+      count += condition_data[i] ? 1 : 0;
     }
-  }
+    block_offsets[static_cast<size_t>(block) + 1] = count;
+  });
+  std::partial_sum(block_offsets.begin(), block_offsets.end(), block_offsets.begin());
+  const int64_t positive_condition_count = block_offsets.back();
 
   std::vector<int64_t> output_dims(input_dimensions.begin(), input_dimensions.end());
   if (has_axis_) {
@@ -68,7 +85,6 @@ Status Compress::Compute(OpKernelContext* ctx) const {
   auto* output_data = static_cast<uint8_t*>(output_tensor->MutableDataRaw());
   auto element_bytes = input_tensor->DataType()->Size();
   bool is_string_type = input_tensor->IsDataTypeString();
-  int64_t output_index = 0;
 
   if (has_axis_) {
     int64_t axes_left_stride = 1;
@@ -81,42 +97,58 @@ Status Compress::Compute(OpKernelContext* ctx) const {
       axes_right_stride *= input_dimensions[i];
     }
     int64_t axes_included_right_stride = axes_right_stride * input_dimensions[onnxruntime::narrow<size_t>(axis)];
-    int64_t axes_included_right_stride_bytes = axes_included_right_stride * element_bytes;
     ORT_ENFORCE(axes_right_stride >= 0 &&
                 static_cast<uint64_t>(axes_right_stride) < std::numeric_limits<size_t>::max());
     size_t axes_right_stride_bytes = 0;
     if (!IAllocator::CalcMemSizeForArray(static_cast<size_t>(axes_right_stride), element_bytes,
                                          &axes_right_stride_bytes))
       return Status(ONNXRUNTIME, FAIL, "size overflow");
-    for (int i = 0; i < axes_left_stride; ++i) {
-      for (int j = 0; j < valid_condition_length; ++j) {
-        if (!condition_data[j]) {
+
+    // The condition is along a single axis so the selected entries are listed once.
+    std::vector<int64_t> selected;
+    selected.reserve(onnxruntime::narrow<size_t>(positive_condition_count));
+    for (int64_t j = 0; j < valid_condition_length; ++j) {
+      if (condition_data[j]) {
+        selected.push_back(j);
+      }
+    }
+
+    // Every (outer index, selected entry) pair copies one contiguous slice of axes_right_stride elements.
+    const auto num_slices = static_cast<std::ptrdiff_t>(axes_left_stride * positive_condition_count);
+    const TensorOpCost cost{static_cast<double>(axes_right_stride_bytes), static_cast<double>(axes_right_stride_bytes),
+                            static_cast<double>(is_string_type ? axes_right_stride * 16 : axes_right_stride)};
+    concurrency::ThreadPool::TryParallelFor(
+        tp, num_slices, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t slice = first; slice < last; ++slice) {
+            const int64_t i = slice / positive_condition_count;
+            const int64_t j = selected[static_cast<size_t>(slice % positive_condition_count)];
+            const int64_t input_offset = i * axes_included_right_stride + j * axes_right_stride;
+            const int64_t output_offset = slice * axes_right_stride;
+            if (is_string_type) {
+              const auto* src = reinterpret_cast<const std::string*>(input_data) + input_offset;
+              std::copy(src, src + axes_right_stride, reinterpret_cast<std::string*>(output_data) + output_offset);
+            } else {
+              memcpy(output_data + output_offset * element_bytes, input_data + input_offset * element_bytes,
+                     axes_right_stride_bytes);
+            }
+          }
+        });
+  } else {
+    concurrency::ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t block) {
+      const auto work = concurrency::ThreadPool::PartitionWork(block, num_blocks, valid_condition_length);
+      int64_t output_index = block_offsets[static_cast<size_t>(block)];
+      for (std::ptrdiff_t i = work.start; i < work.end; ++i) {
+        if (!condition_data[i]) {
           continue;
         }
         if (is_string_type) {
-          for (int idxItem = 0; idxItem < axes_right_stride; ++idxItem) {
-            reinterpret_cast<std::string*>(output_data)[output_index + idxItem] =
-                reinterpret_cast<const std::string*>(input_data)[i * axes_included_right_stride + j * axes_right_stride + idxItem];
-          }
-          output_index += axes_right_stride;
+          reinterpret_cast<std::string*>(output_data)[output_index] = reinterpret_cast<const std::string*>(input_data)[i];
         } else {
-          memcpy(output_data + output_index, input_data + i * axes_included_right_stride_bytes + j * axes_right_stride_bytes, axes_right_stride_bytes);
-          output_index += axes_right_stride_bytes;
+          memcpy(output_data + output_index * element_bytes, input_data + i * element_bytes, element_bytes);
         }
+        ++output_index;
       }
-    }
-  } else {
-    for (int i = 0; i < valid_condition_length; ++i) {
-      if (!condition_data[i]) {
-        continue;
-      }
-      if (is_string_type) {
-        reinterpret_cast<std::string*>(output_data)[output_index] = reinterpret_cast<const std::string*>(input_data)[i];
-      } else {
-        memcpy(output_data + output_index * element_bytes, input_data + i * element_bytes, element_bytes);
-      }
-      ++output_index;
-    }
+    });
   }
 
   return Status::OK();
@@ -3,6 +3,9 @@
 
 #include "core/providers/cpu/tensor/concat.h"
 
+#include <cstring>
+
+#include "core/common/safeint.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/TensorSeq.h"
 #include "core/framework/copy.h"
@@ -245,10 +248,77 @@ TensorShapeVector StridesForStack(const TensorShapeVector& full_strides, uint64_
   }
   return strides;
 }
+
+bool IsContiguousConcat(const Prepare& p) {
+  if (p.is_string_type) {
+    return false;
+  }
+#ifdef ENABLE_STRIDED_TENSORS
+  if (!p.output_tensor->IsContiguous()) {
+    return false;
+  }
+  for (const auto& input : p.inputs) {
+    if (!input.tensor->IsContiguous()) {
+      return false;
+    }
+  }
+#endif
+  return true;
+}
+
+// The output is a [outer, output_axis_pitch] matrix whose rows are the concatenation of one row of every
+// [outer, input_axis_pitch] input, so all inputs are copied in one loop over the output rows partitioned by bytes.
+// With a single row every input is one contiguous block that is copied by ParallelMemcpy.
+void ConcatContiguous(const Prepare& p, concurrency::ThreadPool* tp) {
+  const size_t element_size = p.output_tensor->DataType()->Size();
+  auto* output = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
+  const int64_t outer = p.output_num_elements / p.output_axis_pitch;
+
+  if (outer == 1) {
+    for (const auto& input : p.inputs) {
+      const size_t input_bytes = SafeInt<size_t>(input.num_elements) * element_size;
+      if (input_bytes == 0) {
+        continue;
+      }
+      ParallelMemcpy(tp, output, input.tensor->DataRaw(), input_bytes);
+      output += input_bytes;
+    }
+    return;
+  }
+
+  const double row_bytes = static_cast<double>(p.output_axis_pitch) * element_size;
+  const bool non_temporal = SafeInt<size_t>(p.output_num_elements) * element_size >= kStreamingCopyMinBytes;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, onnxruntime::narrow<std::ptrdiff_t>(outer), TensorOpCost{row_bytes, row_bytes, 0.0},
+      [&p, output, element_size, non_temporal](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          uint8_t* output_row = output + row * p.output_axis_pitch * element_size;
+          for (const auto& input : p.inputs) {
+            const size_t input_row_bytes = static_cast<size_t>(input.axis_pitch) * element_size;
+            if (input_row_bytes == 0) {
+              continue;
+            }
+            const auto* input_row = static_cast<const uint8_t*>(input.tensor->DataRaw()) + row * input_row_bytes;
+            // stream to memory only rows long enough to fill whole cache lines
+            if (non_temporal && input_row_bytes >= 4096) {
+              MemcpyNonTemporal(output_row, input_row, input_row_bytes);
+            } else {
+              memcpy(output_row, input_row, input_row_bytes);
+            }
+            output_row += input_row_bytes;
+          }
+        }
+      });
+}
 }  // namespace
 
 // This method computes the output tensor for Concat/ConcatFromSequence ops
 Status ConcatBase::ComputeImpl(Prepare& p, OpKernelContext* ctx) const {
+  if (IsContiguousConcat(p)) {
+    ConcatContiguous(p, ctx->GetOperatorThreadPool());
+    return Status::OK();
+  }
+
   int input_count = static_cast<int>(p.inputs.size());
   int64_t initial_output_offset = 0;  // initial offset for each input
 
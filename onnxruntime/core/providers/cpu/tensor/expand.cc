@@ -4,22 +4,29 @@
 #include "expand.h"
 #include <cmath>
 #include <core/common/safeint.h>
+#include "core/framework/copy.h"
 
 namespace onnxruntime {
 
-#define REG_EXPAND_KERNEL(TYPE)                                                    \
-  ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                        \
-      Expand,                                                                      \
-      8,                                                                           \
-      12,                                                                          \
-      TYPE,                                                                        \
-      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
-      Expand<TYPE>);                                                               \
-  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                  \
-      Expand,                                                                      \
-      13,                                                                          \
-      TYPE,                                                                        \
-      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
+#ifdef ENABLE_STRIDED_TENSORS
+#define CREATE_EXPAND_KERNEL_DEF KernelDefBuilder().MayStridedOutput(0, 0)
+#else
+#define CREATE_EXPAND_KERNEL_DEF KernelDefBuilder()
+#endif
+
+#define REG_EXPAND_KERNEL(TYPE)                                                          \
+  ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                              \
+      Expand,                                                                            \
+      8,                                                                                 \
+      12,                                                                                \
+      TYPE,                                                                              \
+      CREATE_EXPAND_KERNEL_DEF.TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
+      Expand<TYPE>);                                                                     \
+  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                        \
+      Expand,                                                                            \
+      13,                                                                                \
+      TYPE,                                                                              \
+      CREATE_EXPAND_KERNEL_DEF.TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
       Expand<TYPE>);
 
 REG_EXPAND_KERNEL(float)
@@ -35,6 +42,27 @@ REG_EXPAND_KERNEL(uint64_t)
 REG_EXPAND_KERNEL(bool)
 REG_EXPAND_KERNEL(MLFloat16)
 
+#undef CREATE_EXPAND_KERNEL_DEF
+
+#ifdef ENABLE_STRIDED_TENSORS
+// Strides of the output viewing the input buffer. Broadcast dimensions get a stride of 0.
+static TensorShapeVector ComputeOutputStrides(const TensorShape& input_shape, gsl::span<const int64_t> input_strides,
+                                              const TensorShape& output_shape) {
+  const size_t rank = output_shape.NumDimensions();
+  const size_t input_rank = input_shape.NumDimensions();
+  const size_t offset = rank - input_rank;
+
+  TensorShapeVector output_strides(rank, 0);
+  for (size_t dim = offset; dim < rank; ++dim) {
+    if (input_shape[dim - offset] == output_shape[dim]) {
+      output_strides[dim] = input_strides[dim - offset];
+    }
+  }
+
+  return output_strides;
+}
+#endif
+
 template <typename T>
 Status Expand<T>::Compute(OpKernelContext* context) const {
   const auto* input_tensor = context->Input<Tensor>(0);
@@ -69,6 +97,16 @@ Status Expand<T>::Compute(OpKernelContext* context) const {
 
   TensorShape output_tensor_shape(output_shape);
   auto* output_tensor = context->Output(0, output_tensor_shape);
+
+#ifdef ENABLE_STRIDED_TENSORS
+  // Strided output sharing the input buffer.
+  if (output_tensor->DataRaw() == input_tensor->DataRaw()) {
+    output_tensor->SetShapeAndStrides(output_tensor_shape,
+                                      ComputeOutputStrides(input_tensor->Shape(), input_tensor->Strides(),
+                                                           output_tensor_shape));
+    return Status::OK();
+  }
+#endif
   auto* output_data = output_tensor->MutableData<T>();
   auto* output_dims = output_shape.data();
   auto output_dims_size = static_cast<int64_t>(output_shape.size());
@@ -79,6 +117,13 @@ Status Expand<T>::Compute(OpKernelContext* context) const {
     return Status::OK();
   }
 
+  // nothing is broadcast, so the output is a copy of the input
+  if (output_tensor_shape == input_tensor->Shape()) {
+    ParallelMemcpy(context->GetOperatorThreadPool(), output_data, input_data,
+                   SafeInt<size_t>(output_tensor_shape.Size()) * sizeof(T));
+    return Status::OK();
+  }
+
   std::unique_ptr<int64_t[]> input_dim_group = std::make_unique<int64_t[]>(onnxruntime::narrow<size_t>(max_dims_size));
   std::unique_ptr<int64_t[]> output_dim_group = std::make_unique<int64_t[]>(onnxruntime::narrow<size_t>(max_dims_size));
   std::unique_ptr<int64_t[]> expand_dim_size = std::make_unique<int64_t[]>(onnxruntime::narrow<size_t>(max_dims_size));
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include <string>
+#include <type_traits>
 #include "gather_elements.h"
 #include "onnxruntime_config.h"
 
@@ -132,7 +133,18 @@ static void core_impl(const Tensor* input_tensor, const Tensor* indices_tensor,
       }
     };
 
-    concurrency::ThreadPool::TryBatchParallelFor(ttp, num_inner_dim, BatchWork, 0);
+    // Rows of the innermost dimension are the unit of work. A cost per row keeps small tensors on one thread and
+    // splits many short rows into blocks instead of one task per row.
+    using TElement = std::remove_pointer_t<decltype(output_data)>;
+    const TensorOpCost cost{static_cast<double>(inner_dim_size * (sizeof(TElement) + sizeof(Tin))),
+                            static_cast<double>(inner_dim_size * sizeof(TElement)),
+                            static_cast<double>(inner_dim_size)};
+    concurrency::ThreadPool::TryParallelFor(ttp, static_cast<std::ptrdiff_t>(num_inner_dim), cost,
+                                            [&BatchWork](std::ptrdiff_t first, std::ptrdiff_t last) {
+                                              for (std::ptrdiff_t i = first; i < last; ++i) {
+                                                BatchWork(static_cast<size_t>(i));
+                                              }
+                                            });
   };
 
   // Iterate over the elements based on the element size (or if it's a string). For everything but strings
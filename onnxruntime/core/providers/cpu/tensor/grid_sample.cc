@@ -142,6 +142,107 @@ T GridSample<T>::PixelAtGrid3D(const T* image, int64_t d, int64_t h, int64_t w,
   return pixel;
 }
 
+template <typename T>
+template <typename GridSample<T>::GridSampleInterpolationMode mode,
+          typename GridSample<T>::GridSamplePaddingMode padding_mode>
+void GridSample<T>::Sample2DRows(const T* X_data, const T* grid_data, T* Y_data, int64_t C, int64_t H_in,
+                                 int64_t W_in, int64_t H_out, int64_t W_out, const T border[/* 4 */],
+                                 std::ptrdiff_t first, std::ptrdiff_t last) const {
+  constexpr int64_t num_taps = mode == Linear ? 4 : 1;
+
+  // Resolves the source pixel (r, c) to its offset in a channel, as PixelAtGrid. With zeros padding, the pixels
+  // outside the input read offset 0 and are masked out.
+  auto resolve = [&](int64_t r, int64_t c, std::ptrdiff_t& offset, uint8_t& valid) {
+    if constexpr (padding_mode == Zeros) {
+      valid = c >= 0 && c < W_in && r >= 0 && r < H_in;
+      offset = valid ? r * W_in + c : 0;
+    } else if constexpr (padding_mode == Border) {
+      offset = std::clamp<int64_t>(r, 0, H_in - 1) * W_in + std::clamp<int64_t>(c, 0, W_in - 1);
+    } else {
+      c = static_cast<int64_t>(GsReflect(static_cast<T>(c), border[0], border[2]));
+      r = static_cast<int64_t>(GsReflect(static_cast<T>(r), border[1], border[3]));
+      offset = r * W_in + c;
+    }
+  };
+
+  auto tap = [](const T* X_channel, std::ptrdiff_t offset, uint8_t valid) -> T {
+    if constexpr (padding_mode == Zeros) {
+      return valid ? X_channel[offset] : T{};
+    } else {
+      ORT_UNUSED_PARAMETER(valid);
+      return X_channel[offset];
+    }
+  };
+
+  // per tap, the source offsets and masks of the pixels of the row, and in linear mode the planes dx1, dx2, dy1, dy2
+  std::vector<std::ptrdiff_t> offsets(narrow<size_t>(num_taps * W_out));
+  std::vector<uint8_t> valid(narrow<size_t>(num_taps * W_out), 1);
+  std::vector<T> weights(mode == Linear ? narrow<size_t>(4 * W_out) : 0);
+
+  for (std::ptrdiff_t row = first; row < last; ++row) {
+    const int64_t n = row / H_out;
+    const int64_t oy = row % H_out;
+    const T* gridpoint = grid_data + (n * H_out + oy) * W_out * 2;
+
+    for (int64_t ox = 0; ox < W_out; ++ox) {
+      auto x = GsDenormalize<T>(gridpoint[ox * 2], W_in, align_corners_);  // actual location
+      auto y = GsDenormalize<T>(gridpoint[ox * 2 + 1], H_in, align_corners_);
+
+      if constexpr (mode == Nearest) {
+        x = static_cast<T>(std::nearbyint(static_cast<T>(x)));
+        y = static_cast<T>(std::nearbyint(static_cast<T>(y)));
+        resolve(static_cast<int64_t>(y), static_cast<int64_t>(x), offsets[ox], valid[ox]);
+      } else {
+        int64_t x1 = static_cast<int64_t>(std::floor(x));
+        int64_t y1 = static_cast<int64_t>(std::floor(y));
+        int64_t x2 = x1 + 1;
+        int64_t y2 = y1 + 1;
+
+        resolve(y1, x1, offsets[ox], valid[ox]);
+        resolve(y1, x2, offsets[W_out + ox], valid[W_out + ox]);
+        resolve(y2, x1, offsets[2 * W_out + ox], valid[2 * W_out + ox]);
+        resolve(y2, x2, offsets[3 * W_out + ox], valid[3 * W_out + ox]);
+
+        weights[ox] = x - static_cast<T>(x1);
+        weights[W_out + ox] = static_cast<T>(x2) - x;
+        weights[2 * W_out + ox] = y - static_cast<T>(y1);
+        weights[3 * W_out + ox] = static_cast<T>(y2) - y;
+      }
+    }
+
+    for (int64_t c = 0; c < C; ++c) {
+      const T* X_channel = X_data + (n * C + c) * (H_in * W_in);
+      T* Y_row = Y_data + (n * C + c) * (H_out * W_out) + oy * W_out;
+
+      if constexpr (mode == Nearest) {
+        for (int64_t ox = 0; ox < W_out; ++ox) {
+          Y_row[ox] = tap(X_channel, offsets[ox], valid[ox]);
+        }
+      } else {
+        const std::ptrdiff_t* o11 = offsets.data();
+        const std::ptrdiff_t* o12 = o11 + W_out;
+        const std::ptrdiff_t* o21 = o12 + W_out;
+        const std::ptrdiff_t* o22 = o21 + W_out;
+        const uint8_t* v11 = valid.data();
+        const uint8_t* v12 = v11 + W_out;
+        const uint8_t* v21 = v12 + W_out;
+        const uint8_t* v22 = v21 + W_out;
+        const T* dx1 = weights.data();
+        const T* dx2 = dx1 + W_out;
+        const T* dy1 = dx2 + W_out;
+        const T* dy2 = dy1 + W_out;
+        for (int64_t ox = 0; ox < W_out; ++ox) {
+          T p11 = tap(X_channel, o11[ox], v11[ox]);
+          T p12 = tap(X_channel, o12[ox], v12[ox]);
+          T p21 = tap(X_channel, o21[ox], v21[ox]);
+          T p22 = tap(X_channel, o22[ox], v22[ox]);
+          Y_row[ox] = dy2[ox] * (dx2[ox] * p11 + dx1[ox] * p12) + dy1[ox] * (dx2[ox] * p21 + dx1[ox] * p22);
+        }
+      }
+    }
+  }
+}
+
 // When grid sampling, padding is applied before interpolation.
 // For instance, in bilinear mode and zeros padding-mode, pixel p at actual
 // image location (-0.5, -0.5)
@@ -203,6 +304,54 @@ Status GridSample<T>::Compute(OpKernelContext* context) const {
     }
     T border[] = {x_min, y_min, x_max, y_max};  // l-t-r-b
 
+    // linear and nearest modes compute the source pixels of an output pixel once for all the channels, and run in
+    // parallel over the N x H_out output rows
+    if (mode_ != Cubic) {
+      const T* X_data = input->Data<T>();
+      const T* grid_data = grid->Data<T>();
+      T* Y_data = Y.MutableData<T>();
+      const double num_taps = mode_ == Linear ? 4.0 : 1.0;
+      const double row_size = static_cast<double>(C * W_out);
+      const TensorOpCost cost{row_size * num_taps * sizeof(T), row_size * sizeof(T), row_size * num_taps * 3.0};
+      concurrency::ThreadPool::TryParallelFor(
+          context->GetOperatorThreadPool(), onnxruntime::narrow<std::ptrdiff_t>(N * H_out), cost,
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            if (mode_ == Linear) {
+              switch (padding_mode_) {
+                case Zeros:
+                  Sample2DRows<Linear, Zeros>(X_data, grid_data, Y_data, C, H_in, W_in, H_out, W_out, border,
+                                              first, last);
+                  break;
+                case Border:
+                  Sample2DRows<Linear, Border>(X_data, grid_data, Y_data, C, H_in, W_in, H_out, W_out, border,
+                                               first, last);
+                  break;
+                case Reflection:
+                  Sample2DRows<Linear, Reflection>(X_data, grid_data, Y_data, C, H_in, W_in, H_out, W_out, border,
+                                                   first, last);
+                  break;
+              }
+            } else {
+              switch (padding_mode_) {
+                case Zeros:
+                  Sample2DRows<Nearest, Zeros>(X_data, grid_data, Y_data, C, H_in, W_in, H_out, W_out, border,
+                                               first, last);
+                  break;
+                case Border:
+                  Sample2DRows<Nearest, Border>(X_data, grid_data, Y_data, C, H_in, W_in, H_out, W_out, border,
+                                                first, last);
+                  break;
+                case Reflection:
+                  Sample2DRows<Nearest, Reflection>(X_data, grid_data, Y_data, C, H_in, W_in, H_out, W_out, border,
+                                                    first, last);
+                  break;
+              }
+            }
+          });
+      return Status::OK();
+    }
+
+    // cubic mode
     concurrency::ThreadPool* tp = H_out * W_out > 64 ? context->GetOperatorThreadPool() : nullptr;
     for (int64_t n = 0; n < N; n++) {
       const T* grid_data = grid->Data<T>() + n * (H_out * W_out) * 2;
@@ -221,41 +370,18 @@ Status GridSample<T>::Compute(OpKernelContext* context) const {
                 auto x = GsDenormalize<T>(nx, W_in, align_corners_);  // actual location
                 auto y = GsDenormalize<T>(ny, H_in, align_corners_);
 
-                if (mode_ == Nearest) {
-                  x = static_cast<T>(std::nearbyint(static_cast<T>(x)));
-                  y = static_cast<T>(std::nearbyint(static_cast<T>(y)));
-                  // x, y are integers in all padding modes
-                  *Y_gridpoint = PixelAtGrid(X_data, static_cast<int64_t>(y), static_cast<int64_t>(x), H_in, W_in, border);
-                } else if (mode_ == Linear) {
-                  int64_t x1 = static_cast<int64_t>(std::floor(x));
-                  int64_t y1 = static_cast<int64_t>(std::floor(y));
-                  int64_t x2 = x1 + 1;
-                  int64_t y2 = y1 + 1;
-
-                  T p11 = PixelAtGrid(X_data, y1, x1, H_in, W_in, border);
-                  T p12 = PixelAtGrid(X_data, y1, x2, H_in, W_in, border);
-                  T p21 = PixelAtGrid(X_data, y2, x1, H_in, W_in, border);
-                  T p22 = PixelAtGrid(X_data, y2, x2, H_in, W_in, border);
-
-                  T dx2 = static_cast<T>(x2) - x;
-                  T dx1 = x - static_cast<T>(x1);
-                  T dy2 = static_cast<T>(y2) - y;
-                  T dy1 = y - static_cast<T>(y1);
-                  *Y_gridpoint = dy2 * (dx2 * p11 + dx1 * p12) + dy1 * (dx2 * p21 + dx1 * p22);
-                } else if (mode_ == Cubic) {
-                  int64_t x0 = static_cast<int64_t>(std::floor(x)) - 1;  // top-left corner of the bbox
-                  int64_t y0 = static_cast<int64_t>(std::floor(y)) - 1;
-
-                  T p[4][4] = {};  // [H][W]
-                  for (int64_t h = 0; h < 4; h++) {
-                    for (int64_t w = 0; w < 4; w++) {
-                      p[h][w] = PixelAtGrid(X_data, h + y0, w + x0, H_in, W_in, border);
-                    }
+                int64_t x0 = static_cast<int64_t>(std::floor(x)) - 1;  // top-left corner of the bbox
+                int64_t y0 = static_cast<int64_t>(std::floor(y)) - 1;
+
+                T p[4][4] = {};  // [H][W]
+                for (int64_t h = 0; h < 4; h++) {
+                  for (int64_t w = 0; w < 4; w++) {
+                    p[h][w] = PixelAtGrid(X_data, h + y0, w + x0, H_in, W_in, border);
                   }
-                  T dx = static_cast<T>(x - x0 - 1);
-                  T dy = static_cast<T>(y - y0 - 1);
-                  *Y_gridpoint = GsBicubicInterpolate(p, dx, dy);
                 }
+                T dx = static_cast<T>(x - x0 - 1);
+                T dy = static_cast<T>(y - y0 - 1);
+                *Y_gridpoint = GsBicubicInterpolate(p, dx, dy);
               }
             }
           });
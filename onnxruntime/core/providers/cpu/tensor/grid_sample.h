@@ -68,6 +68,14 @@ class GridSample final : public OpKernel {
     Reflection
   };
 
+  // Samples the rows [first, last) of the N x H_out output rows of a 4-D input in linear or nearest mode. The source
+  // pixels and weights of the output pixels of a row are computed once and reused for all the channels, so the loop
+  // over the pixels of a channel has no branches and can be vectorized.
+  template <GridSampleInterpolationMode mode, GridSamplePaddingMode padding_mode>
+  void Sample2DRows(const T* X_data, const T* grid_data, T* Y_data, int64_t C, int64_t H_in, int64_t W_in,
+                    int64_t H_out, int64_t W_out, const T border[/* 4 */], std::ptrdiff_t first,
+                    std::ptrdiff_t last) const;
+
   T PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, T border[/* 4 */]) const;
   T PixelAtGrid3D(const T* image, int64_t d, int64_t h, int64_t w, int64_t D, int64_t H, int64_t W, T border[/* 6 */]) const;
 
@@ -88,22 +88,13 @@ class IdentityOp final : public OpKernel {
       // Equivalent of checking if two buffer pointers are
       // different before copying over the contents while
       // processing Tensors.
+      //
+      // Otherwise share the tensors, which are read-only once in a sequence. Copying them would make a Loop that
+      // passes a growing sequence through an Identity quadratic in the size of the sequence.
       if (X != output) {
         output->SetType(X->DataType());
         output->Reserve(X->Size());
-
-        AllocatorPtr alloc;
-        auto status = context->GetTempSpaceAllocator(&alloc);
-        if (!status.IsOK()) {
-          ORT_THROW("Unable to get an allocator");
-        }
-
-        for (auto it = X->begin(), end = X->end(); it != end; ++it) {
-          auto& it_tensor = it->Get<Tensor>();
-          Tensor tmp(it_tensor.DataType(), it_tensor.Shape(), alloc);
-          CopyCpuTensor(&it_tensor, &tmp);
-          output->Add(std::move(tmp));
-        }
+        output->AddShared(*X);
       }
     }
 
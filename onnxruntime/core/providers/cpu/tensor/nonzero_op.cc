@@ -3,10 +3,13 @@
 
 #include "core/providers/cpu/tensor/nonzero_op.h"
 
+#include <algorithm>
 #include <cassert>
+#include <numeric>
 #include <vector>
 #include <core/common/safeint.h>
-#include "core/util/math_cpuonly.h"
+#include "core/common/inlined_containers.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 // kernel builder functions
@@ -51,6 +54,9 @@ NONZERO_TYPED_KERNEL(float)
 #undef NONZERO_9_TYPED_KERNEL
 #undef NONZERO_TYPED_KERNEL
 
+// Inputs smaller than this are scanned by a single block
+constexpr std::ptrdiff_t kNonZeroMinBlockSize = 16384;
+
 template <typename T>
 Status NonZero<T>::Compute(OpKernelContext* context) const {
   const auto X = context->Input<Tensor>(0);
@@ -59,59 +65,79 @@ Status NonZero<T>::Compute(OpKernelContext* context) const {
   const auto& X_shape = X->Shape();
   assert(X_shape.Size() >= 0);
 
-  const Eigen::Index coordinate_size = X_shape.IsScalar() ? 1 : onnxruntime::narrow<Eigen::Index>(X_shape.NumDimensions());
-  std::vector<int64_t> non_zero_indices_buffer{};
-  // reserve enough space for indices for every element of X
-  non_zero_indices_buffer.reserve(SafeInt<size_t>(X_shape.Size()) * coordinate_size);
-
+  const size_t coordinate_size = X_shape.IsScalar() ? 1 : X_shape.NumDimensions();
   const T* data = X->Data<T>();
+  const auto num_elements = onnxruntime::narrow<std::ptrdiff_t>(X_shape.Size());
+
+  // The output size depends on the data, so the input is compacted in two phases:
+  // every block counts its non-zero values in parallel, a prefix sum gives the output column each block
+  // starts at, and then every block writes the coordinates of its non-zero values in parallel.
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  const std::ptrdiff_t num_blocks = std::max<std::ptrdiff_t>(
+      1, std::min<std::ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(tp),
+                                  num_elements / kNonZeroMinBlockSize));
+
+  std::vector<int64_t> block_offsets(static_cast<size_t>(num_blocks) + 1, 0);
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t block) {
+    const auto work = concurrency::ThreadPool::PartitionWork(block, num_blocks, num_elements);
+    int64_t count = 0;
+    for (std::ptrdiff_t i = work.start; i < work.end; ++i) {
+      count += data[i] != T{} ? 1 : 0;
+    }
+    block_offsets[static_cast<size_t>(block) + 1] = count;
+  });
+  std::partial_sum(block_offsets.begin(), block_offsets.end(), block_offsets.begin());
+
+  const int64_t num_non_zero_values = block_offsets.back();
+  Tensor* const Y = context->Output(0, {static_cast<int64_t>(coordinate_size), num_non_zero_values});
+  ORT_ENFORCE(Y, "failed to get first output!");
+  if (num_non_zero_values == 0) {
+    return Status::OK();
+  }
 
+  // Output is [coordinate_size, num_non_zero_values]: dimension d of the k-th non-zero value is at
+  // y_data[d * num_non_zero_values + k].
+  int64_t* const y_data = Y->MutableData<int64_t>();
   if (X_shape.IsScalar()) {
-    const T& value = *data;
-    if (value != T{}) {
-      non_zero_indices_buffer.push_back(0);
+    y_data[0] = 0;
+    return Status::OK();
+  }
+
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t block) {
+    const auto work = concurrency::ThreadPool::PartitionWork(block, num_blocks, num_elements);
+    if (block_offsets[static_cast<size_t>(block)] == block_offsets[static_cast<size_t>(block) + 1]) {
+      return;
+    }
+
+    // coordinate of the first entry of the block
+    InlinedVector<int64_t> coordinate(coordinate_size, 0);
+    for (std::ptrdiff_t idx = static_cast<std::ptrdiff_t>(coordinate_size) - 1, remaining = work.start;
+         idx >= 0 && remaining > 0; --idx) {
+      coordinate[static_cast<size_t>(idx)] = remaining % X_shape[static_cast<size_t>(idx)];
+      remaining /= X_shape[static_cast<size_t>(idx)];
     }
-  } else {
-    std::vector<int64_t> coordinate(coordinate_size, 0);
-
-    // as we iterate the entries, increment the coordinate for the current entry
-    // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
-    auto increment_coordinate = [&coordinate, &coordinate_size, &X_shape]() {
-      for (Eigen::Index idx = coordinate_size - 1; idx >= 0; --idx) {
-        int64_t& cur_coord = coordinate[idx];
-        if (cur_coord != X_shape[idx] - 1) {
+
+    int64_t k = block_offsets[static_cast<size_t>(block)];
+    for (std::ptrdiff_t i = work.start; i < work.end; ++i) {
+      if (data[i] != T{}) {
+        for (size_t d = 0; d < coordinate_size; ++d) {
+          y_data[d * num_non_zero_values + k] = coordinate[d];
+        }
+        ++k;
+      }
+
+      // as we iterate the entries, increment the coordinate for the current entry
+      // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
+      for (std::ptrdiff_t idx = static_cast<std::ptrdiff_t>(coordinate_size) - 1; idx >= 0; --idx) {
+        int64_t& cur_coord = coordinate[static_cast<size_t>(idx)];
+        if (cur_coord != X_shape[static_cast<size_t>(idx)] - 1) {
           ++cur_coord;
           break;
         }
         cur_coord = 0;
       }
-    };
-
-    for (size_t i = 0, end = onnxruntime::narrow<size_t>(X_shape.Size()); i < end; ++i) {
-      const T& value = *data++;
-      if (value != T{}) {
-        non_zero_indices_buffer.insert(non_zero_indices_buffer.end(),
-                                       coordinate.begin(), coordinate.end());
-      }
-
-      increment_coordinate();
     }
-  }
-
-  const Eigen::Index num_non_zero_values = onnxruntime::narrow<Eigen::Index>(non_zero_indices_buffer.size()) / coordinate_size;
-
-  // transpose result for output
-  ConstEigenMatrixMapRowMajor<int64_t> non_zero_indices_matrix{
-      non_zero_indices_buffer.data(),
-      num_non_zero_values, coordinate_size};
-
-  Tensor* const Y = context->Output(0, {coordinate_size, num_non_zero_values});
-  ORT_ENFORCE(Y, "failed to get first output!");
-
-  EigenMatrixMapRowMajor<int64_t> y_matrix{
-      Y->MutableData<int64_t>(),
-      coordinate_size, num_non_zero_values};
-  y_matrix = non_zero_indices_matrix.transpose();
+  });
 
   return Status::OK();
 }
@@ -3,6 +3,10 @@
 
 #include "core/providers/cpu/tensor/scatter_nd.h"
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/platform/threadpool.h"
@@ -350,59 +354,83 @@ struct Func_Max_ND<BFloat16> {
   }
 };
 
+// Applies the updates to the output slices. Without a reduction, duplicate indices are undefined behavior per the
+// spec and the updates are written in parallel. With a reduction, updates to the same output slice must not run
+// concurrently, so the updates are grouped by the slice they target and the groups are distributed across the
+// threads instead. Each group applies its updates in index order, which keeps the result deterministic.
+template <typename TData, typename TFunc>
+void ApplyScatterND(const Prepare<TData>& prepare, bool is_reduction, concurrency::ThreadPool* tp) {
+  const TFunc func{};
+  const auto num_updates = static_cast<std::ptrdiff_t>(prepare.element_offsets.size());
+  auto apply = [&](size_t i) {
+    func(prepare.output_base + prepare.element_offsets[i],
+         prepare.input_base + i * prepare.element_to_copy,
+         prepare.element_to_copy);
+  };
+
+  if (!is_reduction || num_updates <= 1 || concurrency::ThreadPool::DegreeOfParallelism(tp) == 1) {
+    concurrency::ThreadPool::TryParallelFor(
+        tp, num_updates, static_cast<double>(prepare.element_to_copy),
+        [&apply](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            apply(static_cast<size_t>(i));
+          }
+        });
+    return;
+  }
+
+  std::vector<size_t> order(static_cast<size_t>(num_updates));
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::stable_sort(order.begin(), order.end(), [&prepare](size_t lhs, size_t rhs) {
+    return prepare.element_offsets[lhs] < prepare.element_offsets[rhs];
+  });
+
+  // group_starts[g] is the position in `order` of the first update of group g.
+  std::vector<size_t> group_starts;
+  for (size_t i = 0; i < order.size(); ++i) {
+    if (i == 0 || prepare.element_offsets[order[i]] != prepare.element_offsets[order[i - 1]]) {
+      group_starts.push_back(i);
+    }
+  }
+  const auto num_groups = static_cast<std::ptrdiff_t>(group_starts.size());
+  group_starts.push_back(order.size());
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_groups,
+      static_cast<double>(prepare.element_to_copy) * static_cast<double>(num_updates) / static_cast<double>(num_groups),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t g = first; g < last; ++g) {
+          for (size_t i = group_starts[static_cast<size_t>(g)]; i < group_starts[static_cast<size_t>(g) + 1]; ++i) {
+            apply(order[i]);
+          }
+        }
+      });
+}
+
 template <typename TData>
 struct ScatterNDDispatchTarget {
   Status operator()(OpKernelContext* context, concurrency::ThreadPool* tp, ScatterND::Reduction reduction) const {
     Prepare<TData> prepare;
     ORT_RETURN_IF_ERROR(PrepareForCompute(context, prepare));
 
-    auto lambda = [&](int64_t i) {
-      switch (reduction) {
-        case ScatterND::Reduction::Add: {
-          auto func = Func_Add_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
-        } break;
-        case ScatterND::Reduction::Mul: {
-          auto func = Func_Mul_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
-        } break;
-        case ScatterND::Reduction::Min: {
-          auto func = Func_Min_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
-        } break;
-        case ScatterND::Reduction::Max: {
-          auto func = Func_Max_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
-        } break;
-        default:
-        case ScatterND::Reduction::None: {
-          auto func = Func_Copy_ND<TData>();
-          func(
-              prepare.output_base + prepare.element_offsets[onnxruntime::narrow<size_t>(i)],
-              prepare.input_base + i * prepare.element_to_copy,
-              prepare.element_to_copy);
-        } break;
-      }
-    };
-    concurrency::ThreadPool::TryParallelFor(
-        tp, prepare.element_offsets.size(), static_cast<double>(prepare.element_to_copy),
-        [&lambda](ptrdiff_t first, ptrdiff_t last) {
-          for (int i = static_cast<int>(first), end = static_cast<int>(last); i < end; ++i) {
-            lambda(i);
-          }
-        });
+    switch (reduction) {
+      case ScatterND::Reduction::Add:
+        ApplyScatterND<TData, Func_Add_ND<TData>>(prepare, true, tp);
+        break;
+      case ScatterND::Reduction::Mul:
+        ApplyScatterND<TData, Func_Mul_ND<TData>>(prepare, true, tp);
+        break;
+      case ScatterND::Reduction::Min:
+        ApplyScatterND<TData, Func_Min_ND<TData>>(prepare, true, tp);
+        break;
+      case ScatterND::Reduction::Max:
+        ApplyScatterND<TData, Func_Max_ND<TData>>(prepare, true, tp);
+        break;
+      default:
+      case ScatterND::Reduction::None:
+        ApplyScatterND<TData, Func_Copy_ND<TData>>(prepare, false, tp);
+        break;
+    }
     return Status::OK();
   }
 };
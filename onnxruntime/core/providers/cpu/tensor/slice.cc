@@ -7,6 +7,7 @@
 #include <unordered_map>
 
 #include "core/common/narrow.h"
+#include "core/common/safeint.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/providers/common.h"
@@ -42,7 +43,9 @@ using EnabledIndicesTypes = ORT_OP_KERNEL_ARG_ENABLED_TYPE_LIST_ALL_OPSETS(kCpuE
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     1, 9,
-    KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
+    KernelDefBuilder()
+        .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
+        .MayOutputView(0),
     Slice1);
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
@@ -50,7 +53,8 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     10, 10,
     KernelDefBuilder()
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
-        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
+        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>())
+        .MayOutputView(0),
     Slice10);
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
@@ -59,7 +63,8 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     12,
     KernelDefBuilder()
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
-        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
+        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>())
+        .MayOutputView(0),
     Slice10);
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -67,7 +72,8 @@ ONNX_CPU_OPERATOR_KERNEL(
     13,
     KernelDefBuilder()
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
-        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
+        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>())
+        .MayOutputView(0),
     Slice10);
 
 // Coalesce contiguous non-slice dimensions into a single dimension.
@@ -226,11 +232,50 @@ Status SliceBase::FillVectorsFromInput(const Tensor& start_tensor,
   return Status::OK();
 }
 
+// Returns true if the slice is a single contiguous range of the input, and sets 'offset' to the index of its first
+// element. That is the case if all the output dimensions before the first partially sliced one are 1,
+// and all the ones after it are complete.
+static bool IsContiguousSlice(const Tensor& input_tensor, const SliceOp::PrepareForComputeMetadata& compute_metadata,
+                              int64_t& offset) {
+  // starts and steps match the coalesced dimensions if there are any
+  const bool flattened = compute_metadata.p_flattened_input_dims_ != nullptr;
+  const gsl::span<const int64_t> input_dims = flattened ? gsl::make_span(compute_metadata.flattened_input_dims_)
+                                                        : input_tensor.Shape().GetDims();
+  const gsl::span<const int64_t> output_dims = flattened ? gsl::make_span(compute_metadata.flattened_output_dims_)
+                                                         : gsl::make_span(compute_metadata.output_dims_);
+
+  offset = 0;
+  int64_t pitch = 1;
+  bool inner_dims_complete = true;
+  for (size_t i = input_dims.size(); i-- > 0;) {
+    if (output_dims[i] != 1 && (!inner_dims_complete || compute_metadata.steps_[i] != 1)) {
+      return false;
+    }
+
+    offset += compute_metadata.starts_[i] * pitch;
+    pitch *= input_dims[i];
+    inner_dims_complete = inner_dims_complete && output_dims[i] == input_dims[i];
+  }
+
+  return true;
+}
+
 template <typename T>
 static Status SliceImpl(OpKernelContext* ctx,
                         const Tensor& input_tensor,
                         SliceOp::PrepareForComputeMetadata& compute_metadata) {
   TensorShape output_shape(compute_metadata.output_dims_);
+
+  // output the slice as a view of the input if it's a contiguous range and the allocation plan allows it
+  int64_t offset = 0;
+  if (!input_tensor.IsDataTypeString() && output_shape.Size() != 0 &&
+      IsContiguousSlice(input_tensor, compute_metadata, offset)) {
+    const size_t byte_offset = SafeInt<size_t>(offset) * input_tensor.DataType()->Size();
+    if (ctx->OutputView(0, output_shape, input_tensor, byte_offset) != nullptr) {
+      return Status::OK();
+    }
+  }
+
   auto& output_tensor = *ctx->Output(0, output_shape);
 
   // output tensor's size is 0, nothing to fill - return
@@ -28,12 +28,20 @@ ORT_SPECIFY_OP_KERNEL_ARG_REQUIRED_TYPES_ALL_OPSETS(
 using EnabledSplitDataTypes = ORT_OP_KERNEL_ARG_ENABLED_TYPE_LIST_ALL_OPSETS(
     kCpuExecutionProvider, kOnnxDomain, Split, Input, 0);
 
+// the input is read with a strided copy, so it may be a strided tensor
+#ifdef ENABLE_STRIDED_TENSORS
+#define CREATE_SPLIT_KERNEL_DEF KernelDefBuilder().MayStridedInput(0)
+#else
+#define CREATE_SPLIT_KERNEL_DEF KernelDefBuilder()
+#endif
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Split,
     2,
     10,
-    KernelDefBuilder().TypeConstraint("T",
-                                      BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
+    CREATE_SPLIT_KERNEL_DEF
+        .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>())
+        .MayOutputView(0),
     Split_1_13);
 
 // Opset 11 starts to support Neg Axis.
@@ -41,8 +49,9 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Split,
     11,
     12,
-    KernelDefBuilder().TypeConstraint("T",
-                                      BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
+    CREATE_SPLIT_KERNEL_DEF
+        .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>())
+        .MayOutputView(0),
     Split_1_13);
 
 // Opset 13 starts to supports 'split' as optional input.
@@ -50,18 +59,22 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Split,
     13,
     17,
-    KernelDefBuilder().TypeConstraint("T",
-                                      BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
+    CREATE_SPLIT_KERNEL_DEF
+        .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>())
+        .MayOutputView(0),
     Split_1_13);
 
 // TODO: support unequal split and num_outputs
 ONNX_CPU_OPERATOR_KERNEL(
     Split,
     18,
-    KernelDefBuilder().TypeConstraint("T",
-                                      BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
+    CREATE_SPLIT_KERNEL_DEF
+        .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>())
+        .MayOutputView(0),
     Split_18);
 
+#undef CREATE_SPLIT_KERNEL_DEF
+
 Status SplitBase::PrepareForCompute(const TensorShape& input_shape, int num_outputs, int64_t& axis, int& before_dims,
                                     int& after_dims_including_split_axis, int& after_dims_excluding_split,
                                     std::vector<int64_t>& split_sizes) const {
@@ -153,18 +166,34 @@ Status SplitImpl::Compute(OpKernelContext* context) const {
 
   SafeInt<ptrdiff_t> input_offset = 0;
 
+  // with nothing before the split axis each output is a contiguous range of the input
+  bool outputs_are_contiguous = before_dims == 1 && !input.IsDataTypeString();
+#ifdef ENABLE_STRIDED_TENSORS
+  outputs_are_contiguous = outputs_are_contiguous && input.IsContiguous();
+#endif
+  const size_t element_size = input.DataType()->Size();
+
   for (int i = 0; i < num_outputs; ++i) {
     // update size of dimension for axis we're splitting on
     auto split_size = narrow<int>(split_sizes[i]);
     output_dimensions[narrow<size_t>(axis)] = split_size;
 
-    Tensor* output = context->Output(i, TensorShape{output_dimensions});
-    const auto output_strides = StridesForTensor(*output);
+    const TensorShape output_shape{output_dimensions};
+    Tensor* output = nullptr;
+    if (outputs_are_contiguous) {
+      output = context->OutputView(i, output_shape, input,
+                                   SafeInt<size_t>(static_cast<ptrdiff_t>(input_offset)) * element_size);
+    }
+
+    if (output == nullptr) {
+      output = context->Output(i, output_shape);
+      const auto output_strides = StridesForTensor(*output);
 
-    ORT_RETURN_IF_ERROR(DispatchStridedCopy<EnabledSplitDataTypes>(context->GetOperatorThreadPool(),
-                                                                   *output, /* dst_offset */ 0, output_strides,
-                                                                   output->Shape(),
-                                                                   input, input_offset, input_strides));
+      ORT_RETURN_IF_ERROR(DispatchStridedCopy<EnabledSplitDataTypes>(context->GetOperatorThreadPool(),
+                                                                     *output, /* dst_offset */ 0, output_strides,
+                                                                     output->Shape(),
+                                                                     input, input_offset, input_strides));
+    }
 
     input_offset += SafeInt<ptrdiff_t>(split_size) * after_dims_excluding_split;  // offset by the data we used in this iteration
   }
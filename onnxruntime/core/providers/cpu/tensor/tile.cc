@@ -11,6 +11,7 @@
 
 #include "core/providers/cpu/tensor/tile.h"
 #include "core/providers/cpu/tensor/utils.h"
+#include "core/framework/copy.h"
 
 #ifdef _MSC_VER
 #pragma warning(pop)
@@ -214,7 +215,8 @@ Status Tile::Compute(OpKernelContext* ctx) const {
     if (input_tensor.IsDataType<std::string>())
       std::copy(input_tensor.Data<std::string>(), input_tensor.Data<std::string>() + input_shape.Size(), output_tensor.MutableData<std::string>());
     else
-      memcpy(output_tensor.MutableDataRaw(), input_tensor.DataRaw(), input_tensor.SizeInBytes());
+      ParallelMemcpy(ctx->GetOperatorThreadPool(), output_tensor.MutableDataRaw(), input_tensor.DataRaw(),
+                     input_tensor.SizeInBytes());
     return Status::OK();
   }
 
@@ -232,39 +234,54 @@ Status Tile::Compute(OpKernelContext* ctx) const {
       !input_tensor.IsDataType<std::string>()) {
     int8_t* output_data_casted = reinterpret_cast<int8_t*>(output_tensor.MutableDataRaw());
     const int8_t* input_data_casted = reinterpret_cast<const int8_t*>(input_tensor.DataRaw());
-    const void* input_data_raw = input_tensor.DataRaw();
+    concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+    const bool non_temporal = output_tensor.SizeInBytes() >= kStreamingCopyMinBytes;
+    const auto copy = [non_temporal](void* dst, const void* src, size_t num_bytes) {
+      if (non_temporal) {
+        MemcpyNonTemporal(dst, src, num_bytes);
+      } else {
+        memcpy(dst, src, num_bytes);
+      }
+    };
 
     if (!is_batched_memcpy) {
       size_t copy_bytes = input_tensor.SizeInBytes();
-      // TODO: Add multi-threading logic if num_of_copies_per_batch is large enough
-      for (size_t i = 0; i < num_of_copies_per_batch; ++i) {
-        memcpy(static_cast<void*>(output_data_casted), input_data_raw, copy_bytes);
-        output_data_casted += copy_bytes;
-      }
+      concurrency::ThreadPool::TryParallelFor(
+          tp, static_cast<std::ptrdiff_t>(num_of_copies_per_batch),
+          TensorOpCost{static_cast<double>(copy_bytes), static_cast<double>(copy_bytes), 0.0},
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t i = first; i < last; ++i) {
+              copy(output_data_casted + i * copy_bytes, input_data_casted, copy_bytes);
+            }
+          });
     } else {
       size_t copy_bytes = num_of_elements_per_batch * input_tensor.DataType()->Size();
       size_t batch_count = static_cast<size_t>(input_tensor.Shape()[0]);  // The tensor is atleast 1-D- this is safe
-
-      // TODO: Multi-thread if needed
-      for (size_t batch = 0; batch < batch_count; ++batch) {
-        for (size_t i = 0; i < num_of_copies_per_batch; ++i) {
-          memcpy(static_cast<void*>(output_data_casted), static_cast<const void*>(input_data_casted), copy_bytes);
-          output_data_casted += copy_bytes;
-        }
-        input_data_casted += copy_bytes;
-      }
+      const size_t batch_output_bytes = copy_bytes * num_of_copies_per_batch;
+
+      concurrency::ThreadPool::TryParallelFor(
+          tp, static_cast<std::ptrdiff_t>(batch_count),
+          TensorOpCost{static_cast<double>(copy_bytes), static_cast<double>(batch_output_bytes), 0.0},
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t batch = first; batch < last; ++batch) {
+              int8_t* batch_output = output_data_casted + batch * batch_output_bytes;
+              for (size_t i = 0; i < num_of_copies_per_batch; ++i) {
+                copy(batch_output + i * copy_bytes, input_data_casted + batch * copy_bytes, copy_bytes);
+              }
+            }
+          });
 
       // Now account for batch dim repeat
       if (num_of_batch_copies > 1) {
-        // reset some values
-        output_data_casted = reinterpret_cast<int8_t*>(output_tensor.MutableDataRaw());
-        copy_bytes *= num_of_copies_per_batch * batch_count;
-        int8_t* copy_ptr = output_data_casted + copy_bytes;
-
-        for (size_t i = 1; i < num_of_batch_copies; ++i) {
-          memcpy(static_cast<void*>(copy_ptr), static_cast<const void*>(output_data_casted), copy_bytes);
-          copy_ptr += copy_bytes;
-        }
+        copy_bytes = batch_output_bytes * batch_count;
+        concurrency::ThreadPool::TryParallelFor(
+            tp, static_cast<std::ptrdiff_t>(num_of_batch_copies - 1),
+            TensorOpCost{static_cast<double>(copy_bytes), static_cast<double>(copy_bytes), 0.0},
+            [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+              for (std::ptrdiff_t i = first; i < last; ++i) {
+                copy(output_data_casted + (i + 1) * copy_bytes, output_data_casted, copy_bytes);
+              }
+            });
       }
     }
 
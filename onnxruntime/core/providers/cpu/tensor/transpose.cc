@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/tensor/transpose.h"
 
+#include <algorithm>
 #include <memory>
 #include "core/framework/element_type_lists.h"
 #include "core/framework/utils.h"
@@ -259,9 +260,219 @@ static void DoTransposeEltWise(int64_t num_axes, gsl::span<const int64_t> target
   }
 }
 
+// The permutation of a transpose with the size 1 axes dropped and the input axes that stay next to each other in the
+// output merged into one, which leaves the fewest axes to iterate over.
+struct CoalescedTranspose {
+  InlinedVector<size_t> input_dims;
+  // output axis k is input axis perm[k]
+  InlinedVector<size_t> perm;
+};
+
+static CoalescedTranspose CoalesceTranspose(const gsl::span<const size_t>& permutations,
+                                            gsl::span<const int64_t> input_dims) {
+  const size_t rank = input_dims.size();
+
+  // drop the size 1 axes
+  InlinedVector<size_t> dims;
+  InlinedVector<size_t> kept_axis(rank, 0);
+  for (size_t i = 0; i < rank; ++i) {
+    if (input_dims[i] != 1) {
+      kept_axis[i] = dims.size();
+      dims.push_back(onnxruntime::narrow<size_t>(input_dims[i]));
+    }
+  }
+  InlinedVector<size_t> output_position(dims.size());
+  size_t num_output_axes = 0;
+  for (size_t k = 0; k < rank; ++k) {
+    if (input_dims[permutations[k]] != 1) {
+      output_position[kept_axis[permutations[k]]] = num_output_axes++;
+    }
+  }
+
+  // an input axis is merged into the previous one if it directly follows it in the output
+  CoalescedTranspose coalesced;
+  InlinedVector<size_t> merged_axis(dims.size());
+  InlinedVector<bool> starts_axis(dims.size());
+  for (size_t i = 0; i < dims.size(); ++i) {
+    starts_axis[i] = i == 0 || output_position[i] != output_position[i - 1] + 1;
+    if (starts_axis[i]) {
+      coalesced.input_dims.push_back(dims[i]);
+    } else {
+      coalesced.input_dims.back() *= dims[i];
+    }
+    merged_axis[i] = coalesced.input_dims.size() - 1;
+  }
+
+  InlinedVector<size_t> output_order(dims.size());
+  for (size_t i = 0; i < dims.size(); ++i) {
+    output_order[output_position[i]] = i;
+  }
+  for (size_t i : output_order) {
+    if (starts_axis[i]) {
+      coalesced.perm.push_back(merged_axis[i]);
+    }
+  }
+
+  return coalesced;
+}
+
+// Transposes `source` into `target` after coalescing the axes. If the innermost input axis stays innermost, the
+// contiguous blocks of it are copied. Otherwise the innermost input axis and the input axis that becomes innermost in
+// the output form a 2D transpose for every index of the other axes, which is copied in tiles that fit in the L1
+// cache so that both the reads and the writes use every cache line they touch. The blocks or rows of tiles are
+// spread over the thread pool.
+template <typename T>
+static void BlockedTranspose(const CoalescedTranspose& transpose, const T* source, T* target,
+                             concurrency::ThreadPool* tp) {
+  const auto& dims = transpose.input_dims;
+  const auto& perm = transpose.perm;
+  const size_t rank = dims.size();
+  if (rank == 0) {
+    *target = *source;
+    return;
+  }
+
+  InlinedVector<size_t> input_strides(rank);
+  InlinedVector<size_t> output_strides(rank);  // the output stride of each input axis
+  size_t input_stride = 1;
+  size_t output_stride = 1;
+  for (size_t i = rank; i-- > 0;) {
+    input_strides[i] = input_stride;
+    input_stride *= dims[i];
+    output_strides[perm[i]] = output_stride;
+    output_stride *= dims[perm[i]];
+  }
+
+  const size_t inner_axis = rank - 1;      // contiguous in the input
+  const size_t moved_axis = perm[rank - 1];  // contiguous in the output
+  InlinedVector<size_t> outer_axes;
+  size_t outer_size = 1;
+  for (size_t k = 0; k < rank; ++k) {
+    if (perm[k] != inner_axis && perm[k] != moved_axis) {
+      outer_axes.push_back(perm[k]);
+      outer_size *= dims[perm[k]];
+    }
+  }
+
+  // Walks the outer axes in output order, keeping the offsets of the current index in the source and target.
+  struct OuterIterator {
+    InlinedVector<size_t> index;
+    size_t source_offset = 0;
+    size_t target_offset = 0;
+  };
+  auto seek = [&](OuterIterator& it, size_t outer_index) {
+    it.index.resize(outer_axes.size());
+    it.source_offset = 0;
+    it.target_offset = 0;
+    for (size_t j = outer_axes.size(); j-- > 0;) {
+      const size_t axis = outer_axes[j];
+      it.index[j] = outer_index % dims[axis];
+      outer_index /= dims[axis];
+      it.source_offset += it.index[j] * input_strides[axis];
+      it.target_offset += it.index[j] * output_strides[axis];
+    }
+  };
+  auto increment = [&](OuterIterator& it) {
+    for (size_t j = outer_axes.size(); j-- > 0;) {
+      const size_t axis = outer_axes[j];
+      it.source_offset += input_strides[axis];
+      it.target_offset += output_strides[axis];
+      if (++it.index[j] < dims[axis]) {
+        return;
+      }
+      it.source_offset -= it.index[j] * input_strides[axis];
+      it.target_offset -= it.index[j] * output_strides[axis];
+      it.index[j] = 0;
+    }
+  };
+
+  if (moved_axis == inner_axis) {
+    const size_t block_size = dims[inner_axis];
+    const double block_bytes = static_cast<double>(block_size * sizeof(T));
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(outer_size), TensorOpCost{block_bytes, block_bytes, 0},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          OuterIterator it;
+          seek(it, static_cast<size_t>(first));
+          for (std::ptrdiff_t outer_index = first; outer_index < last; ++outer_index, increment(it)) {
+            memcpy(target + it.target_offset, source + it.source_offset, block_size * sizeof(T));
+          }
+        });
+    return;
+  }
+
+  constexpr size_t kTileSize = std::max<size_t>(8, 64 / sizeof(T));
+  const size_t num_rows = dims[moved_axis];
+  const size_t num_cols = dims[inner_axis];
+  const size_t source_row_stride = input_strides[moved_axis];
+  const size_t target_col_stride = output_strides[inner_axis];
+  const size_t num_row_tiles = (num_rows + kTileSize - 1) / kTileSize;
+  const double tile_row_bytes = static_cast<double>(kTileSize * num_cols * sizeof(T));
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(outer_size * num_row_tiles),
+      TensorOpCost{tile_row_bytes, tile_row_bytes, static_cast<double>(kTileSize * num_cols)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        OuterIterator it;
+        seek(it, static_cast<size_t>(first) / num_row_tiles);
+        size_t row_tile = static_cast<size_t>(first) % num_row_tiles;
+        for (std::ptrdiff_t unit = first; unit < last; ++unit) {
+          const size_t row_begin = row_tile * kTileSize;
+          const size_t tile_rows = std::min(kTileSize, num_rows - row_begin);
+          const T* source_tile = source + it.source_offset + row_begin * source_row_stride;
+          T* target_tile = target + it.target_offset + row_begin;
+
+          for (size_t col_begin = 0; col_begin < num_cols; col_begin += kTileSize) {
+            const size_t col_end = std::min(col_begin + kTileSize, num_cols);
+            for (size_t col = col_begin; col < col_end; ++col) {
+              const T* source_col = source_tile + col;
+              T* target_row = target_tile + col * target_col_stride;
+              for (size_t row = 0; row < tile_rows; ++row) {
+                target_row[row] = source_col[row * source_row_stride];
+              }
+            }
+          }
+
+          if (++row_tile == num_row_tiles) {
+            row_tile = 0;
+            increment(it);
+          }
+        }
+      });
+}
+
+// Runs BlockedTranspose for the element type of `element_size`. Returns false if the size isn't enabled in this build.
+static bool DoBlockedTranspose(const gsl::span<const size_t>& permutations, gsl::span<const int64_t> input_dims,
+                               const uint8_t* source, uint8_t* target, size_t element_size,
+                               concurrency::ThreadPool* tp) {
+  auto run = [&](auto type_tag) {
+    using T = decltype(type_tag);
+    constexpr bool enabled = utils::HasTypeWithSameSize<EnabledDataTypesAllOpsets, T>();
+    if (enabled) {
+      BlockedTranspose(CoalesceTranspose(permutations, input_dims), reinterpret_cast<const T*>(source),
+                       reinterpret_cast<T*>(target), tp);
+    }
+    return enabled;
+  };
+
+  switch (element_size) {
+    case sizeof(uint64_t):
+      return run(uint64_t{});
+    case sizeof(uint32_t):
+      return run(uint32_t{});
+    case sizeof(uint16_t):
+      return run(uint16_t{});
+    case sizeof(uint8_t):
+      return run(uint8_t{});
+    default:
+      return false;
+  }
+}
+
 //  `input_shape_override` overrides the shape of `input` for compute purposes.
 static Status DoUntypedTranspose(const gsl::span<const size_t>& permutations, const Tensor& input, Tensor& output,
-                                 const TensorShape* input_shape_override = nullptr) {
+                                 const TensorShape* input_shape_override = nullptr,
+                                 concurrency::ThreadPool* tp = nullptr) {
   const auto& input_shape = input_shape_override ? *input_shape_override : input.Shape();
   const auto& input_dims = input_shape.GetDims();
   auto rank = input_shape.NumDimensions();
@@ -321,6 +532,8 @@ static Status DoUntypedTranspose(const gsl::span<const size_t>& permutations, co
     auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
     if (1 == prefix_blocksize) {
       DoTransposeSingleBlock(suffix_blocksize, input_data, output_data, element_size);
+    } else if (DoBlockedTranspose(permutations, input_dims, input_data, output_data, element_size, tp)) {
+      // done
     } else if (1 == suffix_blocksize) {
       // this may return a failed status if the data size is not supported in this build
       status = DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
@@ -368,7 +581,7 @@ static Status TransposeImpl(const gsl::span<const size_t>& permutations, const T
   }
 
   // fall back to default implementation
-  return DoUntypedTranspose(permutations, input, output, input_shape_override);
+  return DoUntypedTranspose(permutations, input, output, input_shape_override, tp);
 }
 
 template <typename Int4Type>
@@ -450,24 +663,46 @@ Status Transpose::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
+#ifdef ENABLE_STRIDED_TENSORS
+  // Strided output sharing the input buffer, its strides are the permuted input strides.
+  if (X.DataRaw() == Y.DataRaw()) {
+    const auto input_strides = X.Strides();
+    TensorShapeVector output_strides(rank);
+    for (size_t i = 0; i < rank; ++i) {
+      output_strides[i] = input_strides[(*p_perm)[i]];
+    }
+    Y.SetShapeAndStrides(output_shape, output_strides);
+    return Status::OK();
+  }
+#endif
+
   return DoTranspose(*p_perm, X, Y, nullptr, ctx->GetOperatorThreadPool());
 }
 
+#ifdef ENABLE_STRIDED_TENSORS
+#define CREATE_TRANSPOSE_KERNEL_DEF KernelDefBuilder().MayStridedOutput(0, 0)
+#else
+#define CREATE_TRANSPOSE_KERNEL_DEF KernelDefBuilder()
+#endif
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Transpose,
     1,
     12,
-    KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypesAllOpsets>()),
+    CREATE_TRANSPOSE_KERNEL_DEF.TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypesAllOpsets>()),
     Transpose);
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Transpose,
     13,
     20,
-    KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypesAllOpsets>()),
+    CREATE_TRANSPOSE_KERNEL_DEF.TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypesAllOpsets>()),
     Transpose);
 
+#undef CREATE_TRANSPOSE_KERNEL_DEF
+
 // Opset 21 added support for float8e4m3fnuz, float8e5m2, float8e5m2fnuz, int4 and uint4.
+// It doesn't produce strided outputs as element strides can't address the packed 4-bit types.
 // TODO(adrianlizarraga): Implement support for float8e4m3fnuz, float8e5m2, and float8e5m2fnuz.
 ONNX_CPU_OPERATOR_KERNEL(
     Transpose,
@@ -2,12 +2,21 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/unique.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <map>
+#include <numeric>
+#include <string_view>
+#include <type_traits>
 #include <core/common/safeint.h>
 #include <gsl/gsl>
+#include "core/common/inlined_containers.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/providers/common.h"
 #include "core/providers/op_kernel_type_control.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 
@@ -144,61 +153,143 @@ class Subtensor {
   std::vector<T> items_;
 };
 
-template <typename T>
-static void CreateFlattenedOutput(OpKernelContext& context,
-                                  const std::map<const T, int64_t>& offsets,         // map sorted key to unsorted idx
-                                  const std::vector<std::vector<int64_t>>& indices,  // unsorted
-                                  const std::vector<int64_t>& inverse_index,         // unsorted
-                                  bool sorted) {
-  int64_t num_unique = static_cast<int64_t>(indices.size());
-  Tensor& Y = *context.Output(0, {num_unique});
-  Tensor* indices_out = context.Output(1, {num_unique});
-  Tensor* inverse_indices = context.Output(2, {static_cast<int64_t>(inverse_index.size())});
-  Tensor* counts = context.Output(3, {num_unique});
-
-  auto Y_data = Y.MutableDataAsSpan<T>();
-  gsl::span<int64_t> indices_data = indices_out != nullptr ? indices_out->MutableDataAsSpan<int64_t>()
-                                                           : gsl::span<int64_t>();
-  gsl::span<int64_t> inverse_indices_data = inverse_indices != nullptr ? inverse_indices->MutableDataAsSpan<int64_t>()
-                                                                       : gsl::span<int64_t>();
-  gsl::span<int64_t> counts_data = counts != nullptr ? counts->MutableDataAsSpan<int64_t>()
-                                                     : gsl::span<int64_t>();
+// Inputs smaller than this are handled by a single block
+constexpr size_t kUniqueMinBlockSize = 16384;
 
-  // iterate using 'offsets' which is sorted, but contains the offset of the unsorted entry
-  auto offsets_iter = offsets.begin();
-  for (int64_t i = 0, end = num_unique; i < end; ++i, ++offsets_iter) {
-    // write sequentially if we want sorted output, use the unsorted_idx if not
-    auto unsorted_idx = offsets_iter->second;
-    auto output_idx = sorted ? i : unsorted_idx;
+// Flattened Unique is hash based. Every value maps to a key that compares equal exactly when the values do
+// for the purposes of Unique: floats compare by their bits with -0 folded into 0 and all NaNs folded into one,
+// strings by a view of the input string.
+template <typename T>
+static auto UniqueKey(const T& value) {
+  if constexpr (std::is_floating_point_v<T>) {
+    using Bits = std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+    const T canonical = value == T{0} ? T{0} : (std::isnan(value) ? std::numeric_limits<T>::quiet_NaN() : value);
+    Bits bits;
+    memcpy(&bits, &canonical, sizeof(bits));
+    return bits;
+  } else if constexpr (std::is_same_v<T, std::string>) {
+    return std::string_view(value);
+  } else {
+    return value;
+  }
+}
 
-    Y_data[onnxruntime::narrow<size_t>(output_idx)] = offsets_iter->first;
+// Orders values for sorted output. NaN, which has no order, goes last.
+template <typename T>
+static bool UniqueLess(const T& lhs, const T& rhs) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return std::isnan(rhs) ? !std::isnan(lhs) : lhs < rhs;
+  } else {
+    return lhs < rhs;
+  }
+}
 
-    if (indices_out) {
-      indices_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].front();
+// Computes Unique of the flattened input in three phases:
+//  1. the input is split in blocks and every block finds its unique values in parallel, writing block local
+//     ids to the inverse index.
+//  2. the block results are merged in block order, which keeps the first occurrence order of the whole input.
+//  3. the inverse index is remapped to output positions in parallel.
+// Sorting is only done when requested and only sorts the unique values.
+template <typename T>
+static void ComputeFlattenedUnique(OpKernelContext& context, gsl::span<const T> data, bool sorted) {
+  using Key = decltype(UniqueKey(std::declval<const T&>()));
+  concurrency::ThreadPool* tp = context.GetOperatorThreadPool();
+  const size_t n = data.size();
+  const std::ptrdiff_t num_blocks = std::max<std::ptrdiff_t>(
+      1, std::min<std::ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(tp),
+                                  static_cast<std::ptrdiff_t>(n / kUniqueMinBlockSize)));
+
+  Tensor* inverse_indices = context.Output(2, {static_cast<int64_t>(n)});
+  gsl::span<int64_t> inverse = inverse_indices != nullptr ? inverse_indices->MutableDataAsSpan<int64_t>()
+                                                          : gsl::span<int64_t>();
+
+  struct BlockUniques {
+    std::vector<int64_t> first_index;  // input index of the first occurrence, in first occurrence order
+    std::vector<int64_t> counts;
+  };
+  std::vector<BlockUniques> blocks(narrow<size_t>(num_blocks));
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t b) {
+    const auto work = concurrency::ThreadPool::PartitionWork(b, num_blocks, static_cast<std::ptrdiff_t>(n));
+    BlockUniques& block = blocks[narrow<size_t>(b)];
+    InlinedHashMap<Key, int64_t> ids;
+    for (std::ptrdiff_t i = work.start; i < work.end; ++i) {
+      const auto p = ids.emplace(UniqueKey(data[narrow<size_t>(i)]), static_cast<int64_t>(block.first_index.size()));
+      if (p.second) {
+        block.first_index.push_back(i);
+        block.counts.push_back(0);
+      }
+      ++block.counts[narrow<size_t>(p.first->second)];
+      if (!inverse.empty()) {
+        inverse[narrow<size_t>(i)] = p.first->second;
+      }
     }
-
-    if (counts) {
-      counts_data[onnxruntime::narrow<size_t>(output_idx)] = indices[onnxruntime::narrow<size_t>(unsorted_idx)].size();
+  });
+
+  std::vector<int64_t> first_index;
+  std::vector<int64_t> counts;
+  // block local id to unsorted id, only needed with more than one block
+  std::vector<std::vector<int64_t>> block_to_unsorted(narrow<size_t>(num_blocks));
+  if (num_blocks == 1) {
+    first_index = std::move(blocks[0].first_index);
+    counts = std::move(blocks[0].counts);
+  } else {
+    InlinedHashMap<Key, int64_t> ids;
+    for (size_t b = 0; b < blocks.size(); ++b) {
+      const BlockUniques& block = blocks[b];
+      block_to_unsorted[b].resize(block.first_index.size());
+      for (size_t local_id = 0; local_id < block.first_index.size(); ++local_id) {
+        const int64_t index = block.first_index[local_id];
+        const auto p = ids.emplace(UniqueKey(data[narrow<size_t>(index)]), static_cast<int64_t>(first_index.size()));
+        if (p.second) {
+          first_index.push_back(index);
+          counts.push_back(0);
+        }
+        counts[narrow<size_t>(p.first->second)] += block.counts[local_id];
+        block_to_unsorted[b][local_id] = p.first->second;
+      }
     }
   }
 
-  if (inverse_indices) {
-    if (sorted) {
-      // need to convert unsorted entries in the inverse index to their sorted values
-      std::vector<int64_t> unsorted_to_sorted;
-      unsorted_to_sorted.resize(onnxruntime::narrow<size_t>(num_unique));
-      int64_t sorted_idx = 0;
-      for (const auto& offset : offsets) {
-        unsorted_to_sorted[onnxruntime::narrow<size_t>(offset.second)] = sorted_idx++;
-      }
+  const size_t num_unique = first_index.size();
+  // order[output position] = unsorted id
+  std::vector<int64_t> order(num_unique);
+  std::iota(order.begin(), order.end(), int64_t{0});
+  if (sorted) {
+    std::sort(order.begin(), order.end(), [&](int64_t lhs, int64_t rhs) {
+      return UniqueLess(data[narrow<size_t>(first_index[narrow<size_t>(lhs)])],
+                        data[narrow<size_t>(first_index[narrow<size_t>(rhs)])]);
+    });
+  }
 
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[onnxruntime::narrow<size_t>(i)] = unsorted_to_sorted[onnxruntime::narrow<size_t>(inverse_index[i])];
-      }
-    } else {
-      for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
-        inverse_indices_data[i] = inverse_index[i];
+  if (!inverse.empty() && (sorted || num_blocks > 1)) {
+    std::vector<int64_t> unsorted_to_output(num_unique);
+    for (size_t i = 0; i < num_unique; ++i) {
+      unsorted_to_output[narrow<size_t>(order[i])] = static_cast<int64_t>(i);
+    }
+    concurrency::ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t b) {
+      const auto work = concurrency::ThreadPool::PartitionWork(b, num_blocks, static_cast<std::ptrdiff_t>(n));
+      const auto& to_unsorted = block_to_unsorted[narrow<size_t>(b)];
+      for (std::ptrdiff_t i = work.start; i < work.end; ++i) {
+        int64_t& id = inverse[narrow<size_t>(i)];
+        const int64_t unsorted_id = num_blocks > 1 ? to_unsorted[narrow<size_t>(id)] : id;
+        id = unsorted_to_output[narrow<size_t>(unsorted_id)];
       }
+    });
+  }
+
+  Tensor& Y = *context.Output(0, {static_cast<int64_t>(num_unique)});
+  Tensor* indices_out = context.Output(1, {static_cast<int64_t>(num_unique)});
+  Tensor* counts_out = context.Output(3, {static_cast<int64_t>(num_unique)});
+
+  auto Y_data = Y.MutableDataAsSpan<T>();
+  for (size_t i = 0; i < num_unique; ++i) {
+    const auto unsorted_id = narrow<size_t>(order[i]);
+    Y_data[i] = data[narrow<size_t>(first_index[unsorted_id])];
+    if (indices_out) {
+      indices_out->MutableData<int64_t>()[i] = first_index[unsorted_id];
+    }
+    if (counts_out) {
+      counts_out->MutableData<int64_t>()[i] = counts[unsorted_id];
     }
   }
 }
@@ -308,30 +399,7 @@ Status Unique::ComputeImpl(OpKernelContext& context) const {
   auto data = input.DataAsSpan<T>();
 
   if (flatten_) {
-    std::map<const T, int64_t> offsets;  // offset of entry in indices. provides map between sorted and unsorted values
-    std::vector<std::vector<int64_t>> indices;
-    std::vector<int64_t> inverse_index;
-
-    indices.reserve(data.size() / 2);  // arbitrary value. at worst 1 realloc but could be too large
-    inverse_index.reserve(data.size());
-
-    int64_t num_unique = 0;
-
-    for (int64_t i = 0, end = input.Shape().Size(); i < end; ++i) {
-      auto entry = offsets.find(data[onnxruntime::narrow<size_t>(i)]);
-      if (entry == offsets.end()) {
-        offsets[data[onnxruntime::narrow<size_t>(i)]] = num_unique;
-        inverse_index.push_back({num_unique});
-        indices.push_back({i});
-        ++num_unique;
-      } else {
-        size_t indices_idx = onnxruntime::narrow<size_t>(entry->second);
-        indices[indices_idx].push_back(i);
-        inverse_index.push_back(onnxruntime::narrow<int64_t>(indices_idx));
-      }
-    }
-
-    CreateFlattenedOutput(context, offsets, indices, inverse_index, sort_);
+    ComputeFlattenedUnique<T>(context, data, sort_);
   } else {
     const auto& input_shape = input.Shape();
     const int64_t input_dims = static_cast<int64_t>(input_shape.NumDimensions());
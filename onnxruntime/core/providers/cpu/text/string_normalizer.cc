@@ -4,6 +4,7 @@
 #include "string_normalizer.h"
 #include "core/common/common.h"
 #include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
 // Used below HAS_DEPRECATED_DECLARATIONS
 #include "onnxruntime_config.h"
 
@@ -435,6 +436,72 @@ const std::string default_locale("en_US.UTF-8");  // All non-MS and not Apple
 #endif
 
 #endif  // _MSC_VER
+
+// Turkic locales map I and i to dotless and dotted variants, so plain ASCII case mapping does not apply to them.
+bool HasAsciiCaseMapping(const std::string& locale_name) {
+  auto starts_with = [&locale_name](const char* prefix) {
+    return locale_name.compare(0, std::char_traits<char>::length(prefix), prefix) == 0;
+  };
+  return !(starts_with("tr") || starts_with("az") || starts_with("Turkish") || starts_with("Azer"));
+}
+
+// Branch-free so that the compiler vectorizes both loops
+bool IsAscii(const std::string& s) {
+  unsigned char bits = 0;
+  for (const char c : s) {
+    bits |= static_cast<unsigned char>(c);
+  }
+  return (bits & 0x80) == 0;
+}
+
+// Changes the case of the ASCII string src into dest, which has room for src.size() characters.
+// Works for both char and wchar_t destinations.
+template <typename CharT>
+void AsciiChangeCase(StringNormalizer::CaseAction caseaction, const std::string& src, CharT* dest) {
+  assert(caseaction != StringNormalizer::NONE);
+  const unsigned char first = caseaction == StringNormalizer::LOWER ? 'A' : 'a';
+  const unsigned char flip = 'a' - 'A';
+  const unsigned char* s = reinterpret_cast<const unsigned char*>(src.data());
+  for (size_t i = 0, lim = src.size(); i < lim; ++i) {
+    const unsigned char c = s[i];
+    const unsigned char in_range = static_cast<unsigned char>(c - first) < 26 ? flip : 0;
+    dest[i] = static_cast<CharT>(caseaction == StringNormalizer::LOWER ? c + in_range : c - in_range);
+  }
+}
+
+constexpr size_t kMinStringsPerBatch = 64;
+
+// Runs fn(i, converter, wchar_buffer) for i in [0, total) in contiguous batches, at most one per thread.
+// Every batch has its own converter and conversion buffer. The first error of every batch is returned.
+template <typename Fn>
+Status ParallelForStrings(concurrency::ThreadPool* tp, size_t total, Fn&& fn) {
+  const std::ptrdiff_t num_batches = std::max<std::ptrdiff_t>(
+      1, std::min<std::ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(tp),
+                                  static_cast<std::ptrdiff_t>(total / kMinStringsPerBatch)));
+  InlinedVector<Status> statuses(narrow<size_t>(num_batches));
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_batches, [&](std::ptrdiff_t batch) {
+    const auto work = concurrency::ThreadPool::PartitionWork(batch, num_batches, static_cast<std::ptrdiff_t>(total));
+    Status& status = statuses[narrow<size_t>(batch)];
+    ORT_TRY {
+      Utf8Converter converter;
+      std::wstring wchar_buffer;
+      for (std::ptrdiff_t i = work.start; i < work.end && status.IsOK(); ++i) {
+        status = fn(static_cast<size_t>(i), converter, wchar_buffer);
+      }
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+      });
+    }
+  });
+
+  for (const auto& status : statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+  return Status::OK();
+}
+
 }  // namespace string_normalizer
 
 using namespace string_normalizer;
@@ -459,6 +526,7 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info) {
   }
 
   locale_name_ = info.GetAttrOrDefault("locale", default_locale);
+  ascii_case_mapping_ = HasAsciiCaseMapping(locale_name_);
 
   std::vector<std::string> stop_words = info.GetAttrsOrDefault<std::string>("stopwords");
   if (is_case_sensitive_) {
@@ -521,57 +589,70 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
   // and compare with the original strings. Otherwise, we need to convert the string
   // to widechar, lowercase it and then compare. Case-insensitive comparison is complicated
   // for UTF-8 and requires additional dependency.
+  // Strings are independent of each other, so every step runs over the strings in parallel batches.
 
   Locale locale(locale_name_);
-  Utf8Converter converter;
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+
+  // Writes s with its case changed to dest
+  auto change_case = [&](const std::string& s, std::string& dest, Utf8Converter& converter,
+                         std::wstring& wchar_buffer) {
+    if (ascii_case_mapping_ && IsAscii(s)) {
+      dest.resize(s.size());
+      AsciiChangeCase(case_change_action_, s, dest.data());
+      return Status::OK();
+    }
 
-  // Compute the largest widestring buffer needed.
-  size_t max_wide_buffer_len = 0;
-  for (const auto& s : input_span) {
-    size_t wchars = 0;
-    // Checks for invalid UTF-8 characters on Windows
-    ORT_RETURN_IF_ERROR(converter.ComputeRequiredSizeToWideChar(s, wchars));
-    max_wide_buffer_len = std::max(max_wide_buffer_len, wchars);
-  }
+    // A UTF-8 string never has more wide characters than bytes
+    wchar_buffer.resize(s.size());
+    ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
+    locale.ChangeCase(case_change_action_, wchar_buffer);
 
-  // Reuse reserved space
-  std::wstring wchar_buffer;
-  wchar_buffer.reserve(max_wide_buffer_len);
+    size_t utf8_buffer_len = converter.ComputeRequiredSizeToUtf8(wchar_buffer);
+    dest.resize(utf8_buffer_len);
+    return converter.ConvertToUtf8(wchar_buffer, dest);
+  };
 
   // Output everything and change case as required
   auto output_no_filtering = [&](const TensorShape& output_shape) {
     auto output_tensor = ctx->Output(0, output_shape);
     auto const output_data = output_tensor->MutableData<std::string>();
-    for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
-      const std::string& s = input_span[i];
-      wchar_buffer.resize(max_wide_buffer_len);
-      ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-      locale.ChangeCase(case_change_action_, wchar_buffer);
-
-      auto& dest = output_data[i];
-      size_t utf8_buffer_len = converter.ComputeRequiredSizeToUtf8(wchar_buffer);
-      dest.resize(utf8_buffer_len);
-      ORT_RETURN_IF_ERROR(converter.ConvertToUtf8(wchar_buffer, dest));
-    }
-    return Status::OK();
+    return ParallelForStrings(tp, input_span.size(),
+                              [&](size_t i, Utf8Converter& converter, std::wstring& wchar_buffer) {
+                                return change_case(input_span[i], output_data[i], converter, wchar_buffer);
+                              });
   };
 
   auto output_filtered = [&](const TensorShape& output_shape, gsl::span<const size_t> filtered_indices) {
     auto output_tensor = ctx->Output(0, output_shape);
     auto output_data = output_tensor->MutableData<std::string>();
-    for (size_t i : filtered_indices) {
-      const std::string& s = input_span[i];
-      if (case_change_action_ != NONE) {
-        wchar_buffer.resize(max_wide_buffer_len);
-        ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-        locale.ChangeCase(case_change_action_, wchar_buffer);
-
-        auto& dest = *output_data++;
-        size_t utf8_buffer_len = converter.ComputeRequiredSizeToUtf8(wchar_buffer);
-        dest.resize(utf8_buffer_len);
-        ORT_RETURN_IF_ERROR(converter.ConvertToUtf8(wchar_buffer, dest));
-      } else {
-        *output_data++ = s;
+    return ParallelForStrings(tp, filtered_indices.size(),
+                              [&](size_t i, Utf8Converter& converter, std::wstring& wchar_buffer) {
+                                const std::string& s = input_span[filtered_indices[i]];
+                                if (case_change_action_ != NONE) {
+                                  return change_case(s, output_data[i], converter, wchar_buffer);
+                                }
+                                output_data[i] = s;
+                                return Status::OK();
+                              });
+  };
+
+  // Marks the strings to keep in parallel and collects their indices in order
+  auto filter = [&](InlinedVector<size_t>& filtered_strings_indices, auto&& is_stopword) {
+    std::vector<uint8_t> keep(input_span.size());
+    ORT_RETURN_IF_ERROR(ParallelForStrings(tp, input_span.size(),
+                                           [&](size_t i, Utf8Converter& converter, std::wstring& wchar_buffer) {
+                                             bool stopword = false;
+                                             ORT_RETURN_IF_ERROR(is_stopword(input_span[i], converter,
+                                                                             wchar_buffer, stopword));
+                                             keep[i] = stopword ? 0 : 1;
+                                             return Status::OK();
+                                           }));
+
+    filtered_strings_indices.reserve(input_span.size());
+    for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
+      if (keep[i] != 0) {
+        filtered_strings_indices.push_back(i);
       }
     }
     return Status::OK();
@@ -587,14 +668,11 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
     } else {
       // we need to filter
       InlinedVector<size_t> filtered_strings_indices;
-      filtered_strings_indices.reserve(input_span.size());
-
-      for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
-        const std::string& s = input_span[i];
-        if (stopwords_.count(s) == 0) {
-          filtered_strings_indices.push_back(i);
-        }
-      }
+      ORT_RETURN_IF_ERROR(filter(filtered_strings_indices,
+                                 [this](const std::string& s, Utf8Converter&, std::wstring&, bool& stopword) {
+                                   stopword = stopwords_.count(s) != 0;
+                                   return Status::OK();
+                                 }));
 
       // According to the spec, if all strings are filtered out
       // the output must have a shape of {1} with a single empty string.
@@ -611,17 +689,21 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
       // Case insensitive filtering is performed by converting the input strings
       // to compare_caseaction_. For that we convert to wchar_t UNICODE.
       // Otherwise, we need to pull ICU library on all platforms.
+      // ASCII strings are widened and case changed directly without going through the converter.
       InlinedVector<size_t> filtered_strings_indices;
-      filtered_strings_indices.reserve(input_span.size());
-      for (size_t i = 0, lim = input_span.size(); i < lim; ++i) {
-        const std::string& s = input_span[i];
-        wchar_buffer.resize(max_wide_buffer_len);
-        ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
-        locale.ChangeCase(compare_caseaction_, wchar_buffer);
-        if (wstopwords_.count(wchar_buffer) == 0) {
-          filtered_strings_indices.push_back(i);
-        }
-      }
+      ORT_RETURN_IF_ERROR(filter(filtered_strings_indices,
+                                 [&](const std::string& s, Utf8Converter& converter, std::wstring& wchar_buffer,
+                                     bool& stopword) {
+                                   wchar_buffer.resize(s.size());
+                                   if (ascii_case_mapping_ && IsAscii(s)) {
+                                     AsciiChangeCase(compare_caseaction_, s, wchar_buffer.data());
+                                   } else {
+                                     ORT_RETURN_IF_ERROR(converter.ConvertToWideChar(s, wchar_buffer));
+                                     locale.ChangeCase(compare_caseaction_, wchar_buffer);
+                                   }
+                                   stopword = wstopwords_.count(wchar_buffer) != 0;
+                                   return Status::OK();
+                                 }));
 
       // According to the spec, if all strings are filtered out
       // the output must have a shape of {1} with a single empty string.
@@ -31,6 +31,8 @@ class StringNormalizer : public OpKernel {
   // used for case-insensitive compare
   CaseAction compare_caseaction_{LOWER};
   std::string locale_name_;
+  // ASCII strings skip the wide char conversion when the locale maps ASCII case like the C locale
+  bool ascii_case_mapping_{true};
   // Either if these are populated but not both
   InlinedHashSet<std::string> stopwords_;
   InlinedHashSet<std::wstring> wstopwords_;
@@ -4,6 +4,7 @@
 #include "cuda_allocator.h"
 #include "cuda_common.h"
 #include "gpu_data_transfer.h"
+#include "core/framework/stream_handles.h"
 
 namespace onnxruntime {
 
@@ -86,6 +87,99 @@ void* CUDAExternalAllocator::Reserve(size_t size) {
   return p;
 }
 
+CUDAMempoolAllocator::CUDAMempoolAllocator(OrtDevice::DeviceId device_id, const char* name, uint64_t release_threshold)
+    : CUDAAllocator(device_id, name) {
+  cudaMemPoolProps props = {};
+  props.allocType = cudaMemAllocationTypePinned;
+  props.handleTypes = cudaMemHandleTypeNone;
+  props.location.type = cudaMemLocationTypeDevice;
+  props.location.id = device_id;
+  CUDA_CALL_THROW(cudaMemPoolCreate(&pool_, &props));
+  CUDA_CALL_THROW(cudaMemPoolSetAttribute(pool_, cudaMemPoolAttrReleaseThreshold, &release_threshold));
+}
+
+CUDAMempoolAllocator::~CUDAMempoolAllocator() {
+  cudaMemPoolDestroy(pool_);  // do not throw error since it's OK for it to fail during shutdown
+}
+
+void* CUDAMempoolAllocator::Alloc(size_t size) {
+  SetDevice(true);
+  CheckDevice(true);
+  void* p = nullptr;
+  if (size > 0) {
+    // without a stream the memory must be usable by any stream once this returns
+    CUDA_CALL_THROW(cudaMallocFromPoolAsync(&p, size, pool_, nullptr));
+    CUDA_CALL_THROW(cudaStreamSynchronize(nullptr));
+    std::lock_guard<OrtMutex> lock(lock_);
+    alloc_streams_[p] = nullptr;
+    ++num_allocs_;
+  }
+  return p;
+}
+
+void* CUDAMempoolAllocator::AllocStreamOrdered(size_t size, Stream* stream) {
+  SetDevice(true);
+  CheckDevice(true);
+  void* p = nullptr;
+  if (size > 0) {
+    cudaStream_t cuda_stream = static_cast<cudaStream_t>(stream->GetHandle());
+    CUDA_CALL_THROW(cudaMallocFromPoolAsync(&p, size, pool_, cuda_stream));
+    std::lock_guard<OrtMutex> lock(lock_);
+    alloc_streams_[p] = cuda_stream;
+    ++num_allocs_;
+  }
+  return p;
+}
+
+void CUDAMempoolAllocator::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  cudaStream_t cuda_stream = nullptr;
+  {
+    std::lock_guard<OrtMutex> lock(lock_);
+    auto it = alloc_streams_.find(p);
+    if (it != alloc_streams_.end()) {
+      cuda_stream = it->second;
+      alloc_streams_.erase(it);
+    }
+  }
+
+  SetDevice(false);
+  CheckDevice(false);  // ignore CUDA failure when free
+  if (cuda_stream == nullptr) {
+    // like cudaFree, wait for the work that may still use the memory
+    cudaDeviceSynchronize();
+  }
+  cudaFreeAsync(p, cuda_stream);  // do not throw error since it's OK for it to fail during shutdown
+}
+
+void CUDAMempoolAllocator::GetStats(AllocatorStats* stats) {
+  uint64_t used = 0;
+  uint64_t reserved = 0;
+  uint64_t used_high = 0;
+  cudaMemPoolGetAttribute(pool_, cudaMemPoolAttrUsedMemCurrent, &used);
+  cudaMemPoolGetAttribute(pool_, cudaMemPoolAttrReservedMemCurrent, &reserved);
+  cudaMemPoolGetAttribute(pool_, cudaMemPoolAttrUsedMemHigh, &used_high);
+
+  std::lock_guard<OrtMutex> lock(lock_);
+  stats->Clear();
+  stats->num_allocs = num_allocs_;
+  stats->num_arena_shrinkages = num_shrinks_;
+  stats->bytes_in_use = static_cast<int64_t>(used);
+  stats->total_allocated_bytes = static_cast<int64_t>(reserved);
+  stats->max_bytes_in_use = static_cast<int64_t>(used_high);
+}
+
+Status CUDAMempoolAllocator::Shrink() {
+  SetDevice(true);
+  CUDA_RETURN_IF_ERROR(cudaMemPoolTrimTo(pool_, 0));
+  std::lock_guard<OrtMutex> lock(lock_);
+  ++num_shrinks_;
+  return Status::OK();
+}
+
 void* CUDAPinnedAllocator::Alloc(size_t size) {
   void* p = nullptr;
   if (size > 0) {
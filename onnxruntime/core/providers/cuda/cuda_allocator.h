@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <cuda_runtime_api.h>
+
 #include "core/common/inlined_containers.h"
 #include "core/framework/allocator.h"
 #include "core/platform/ort_mutex.h"
@@ -49,6 +51,34 @@ class CUDAExternalAllocator : public CUDAAllocator {
   InlinedHashSet<void*> reserved_;
 };
 
+// Allocates device memory from a CUDA stream ordered memory pool (cudaMallocAsync) instead of an arena.
+// Memory allocated on a stream is freed on that stream, so the pool reuses it for later allocations of the stream
+// without synchronizing with other streams. Memory allocated without a stream is freed like cudaFree.
+class CUDAMempoolAllocator : public CUDAAllocator {
+ public:
+  // `release_threshold` is the number of bytes of unused memory the pool keeps when a stream is synchronized.
+  CUDAMempoolAllocator(OrtDevice::DeviceId device_id, const char* name, uint64_t release_threshold);
+  ~CUDAMempoolAllocator() override;
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+  void GetStats(AllocatorStats* stats) override;
+
+  bool IsStreamOrdered() const override { return true; }
+  void* AllocStreamOrdered(size_t size, Stream* stream) override;
+
+  // Returns all the unused memory of the pool to the system.
+  Status Shrink() override;
+
+ private:
+  cudaMemPool_t pool_ = nullptr;
+  OrtMutex lock_;
+  // the stream each allocation was made on, nullptr if it was made without a stream
+  InlinedHashMap<void*, cudaStream_t> alloc_streams_;
+  int64_t num_allocs_ = 0;
+  int64_t num_shrinks_ = 0;
+};
+
 // TODO: add a default constructor
 class CUDAPinnedAllocator : public IAllocator {
  public:
@@ -2,6 +2,8 @@
 // Copyright (c) 2023 NVIDIA Corporation.
 // Licensed under the MIT License.
 
+#include <limits>
+
 #include "core/common/inlined_containers.h"
 #include "core/common/parse_string.h"
 #include "core/providers/shared_library/provider_api.h"
@@ -149,6 +151,19 @@ AllocatorPtr CUDAExecutionProvider::CreateCudaAllocator(OrtDevice::DeviceId devi
         device_id,
         false);
 
+    return CreateAllocator(default_memory_info);
+  } else if (default_memory_arena_cfg && default_memory_arena_cfg->use_cuda_mempool == 1) {
+    // the CUDA memory pool reuses the memory freed on a stream itself, so it replaces the arena
+    const uint64_t release_threshold = default_memory_arena_cfg->cuda_mempool_release_threshold < 0
+                                           ? std::numeric_limits<uint64_t>::max()
+                                           : static_cast<uint64_t>(default_memory_arena_cfg->cuda_mempool_release_threshold);
+    AllocatorCreationInfo default_memory_info(
+        [release_threshold](OrtDevice::DeviceId id) {
+          return std::make_unique<CUDAMempoolAllocator>(id, CUDA, release_threshold);
+        },
+        device_id,
+        false);
+
     return CreateAllocator(default_memory_info);
   } else {
     AllocatorCreationInfo default_memory_info(
@@ -239,6 +254,12 @@ Status CUDAExecutionProvider::PerThreadContext::ReplayGraph(CudaGraphAnnotation_
   return cuda_graph_.Replay(graph_annotation_id);
 }
 
+void CUDAExecutionProvider::PerThreadContext::ReleaseGraph(CudaGraphAnnotation_t cuda_graph_annotation_id) {
+  cuda_graph_.Release(cuda_graph_annotation_id);
+  // the regular runs before the next capture allocate the memory again
+  graph_id_to_run_count_.erase(cuda_graph_annotation_id);
+}
+
 void CUDAExecutionProvider::PerThreadContext::IncrementRegularRunCountBeforeGraphCapture(
     CudaGraphAnnotation_t cuda_graph_annotation_id) {
   if (graph_id_to_run_count_.find(cuda_graph_annotation_id) == graph_id_to_run_count_.end()) {
@@ -297,7 +318,7 @@ CUDAExecutionProvider::CUDAExecutionProvider(const CUDAExecutionProviderInfo& in
     } else if (info.enable_cuda_graph || info.use_ep_level_unified_stream) {
       // current cuda graph implementation only works with single stream
       // use EP level unified stream for all the reqeust
-      CUDA_CALL_THROW(cudaStreamCreateWithFlags(&stream_, cudaStreamNonBlocking));
+      stream_ = CreateCudaStream(info.stream_priority);
       use_ep_level_unified_stream_ = true;
     } else {
       stream_ = nullptr;
@@ -475,6 +496,11 @@ Status CUDAExecutionProvider::ReplayGraph(int graph_annotation_id) {
   return GetPerThreadContext().ReplayGraph(graph_annotation_id);
 }
 
+Status CUDAExecutionProvider::ReleaseGraph(int graph_annotation_id) {
+  GetPerThreadContext().ReleaseGraph(graph_annotation_id);
+  return Status::OK();
+}
+
 namespace cuda {
 // opset 1 to 9
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, MemcpyFromHost);
@@ -29,6 +29,14 @@ void CudaGraphSet::Put(CudaGraphAnnotation_t cuda_graph_annotation_id, cudaGraph
   cuda_graphs_.emplace(cuda_graph_annotation_id, graph_exec);
 }
 
+void CudaGraphSet::Erase(CudaGraphAnnotation_t cuda_graph_annotation_id) {
+  auto it = cuda_graphs_.find(cuda_graph_annotation_id);
+  if (it != cuda_graphs_.end()) {
+    CUDA_CALL_THROW(cudaGraphExecDestroy(it->second));
+    cuda_graphs_.erase(it);
+  }
+}
+
 cudaGraphExec_t CudaGraphSet::Get(CudaGraphAnnotation_t cuda_graph_annotation_id) const {
   ORT_ENFORCE(Contains(cuda_graph_annotation_id));
   return cuda_graphs_.at(cuda_graph_annotation_id);
@@ -67,8 +75,7 @@ void CUDAGraphManager::CaptureEnd(CudaGraphAnnotation_t cuda_graph_annotation_id
   CUDA_CALL_THROW(cudaGraphInstantiate(&graph_exec, graph, NULL, NULL, 0));
   CUDA_CALL_THROW(cudaGraphDestroy(graph));
 
-  // Currently all the captured graphs will be tied to the session's lifecycle
-  // TODO(wy): Addd an interface to free captured graphs
+  // The captured graphs are tied to the session's lifecycle unless they are released with Release()
   cuda_graph_set_.Put(cuda_graph_annotation_id, graph_exec);
 }
 
@@ -85,6 +92,12 @@ Status CUDAGraphManager::Replay(CudaGraphAnnotation_t cuda_graph_annotation_id)
   return Status::OK();
 }
 
+void CUDAGraphManager::Release(CudaGraphAnnotation_t cuda_graph_annotation_id) {
+  // make sure a replay of the graph is not in flight
+  CUDA_CALL_THROW(cudaStreamSynchronize(stream_));
+  cuda_graph_set_.Erase(cuda_graph_annotation_id);
+}
+
 bool CUDAGraphManager::IsGraphCaptureAllowedOnRun(CudaGraphAnnotation_t cuda_graph_annotation_id) const {
   return cuda_graph_annotation_id != kCudaGraphAnnotationSkip;
 }
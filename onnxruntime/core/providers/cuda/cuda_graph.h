@@ -24,6 +24,7 @@ struct CudaGraphSet {
   void Clear();
   bool Contains(CudaGraphAnnotation_t cuda_graph_annotation_id) const;
   void Put(CudaGraphAnnotation_t cuda_graph_annotation_id, cudaGraphExec_t graph_exec);
+  void Erase(CudaGraphAnnotation_t cuda_graph_annotation_id);
   cudaGraphExec_t Get(CudaGraphAnnotation_t cuda_graph_annotation_id) const;
 
  private:
@@ -39,6 +40,7 @@ struct CUDAGraphManager {
   void CaptureBegin(CudaGraphAnnotation_t cuda_graph_annotation_id);
   void CaptureEnd(CudaGraphAnnotation_t cuda_graph_annotation_id);
   Status Replay(CudaGraphAnnotation_t cuda_graph_annotation_id);
+  void Release(CudaGraphAnnotation_t cuda_graph_annotation_id);
 
   void Reset();
 
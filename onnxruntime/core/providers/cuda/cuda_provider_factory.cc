@@ -226,6 +226,7 @@ struct CUDA_Provider : Provider {
     info.enable_skip_layer_norm_strict_mode = params->enable_skip_layer_norm_strict_mode != 0;
     info.use_ep_level_unified_stream = params->use_ep_level_unified_stream != 0;
     info.use_tf32 = params->use_tf32 != 0;
+    info.stream_priority = params->stream_priority;
 
     return std::make_shared<CUDAProviderFactory>(info);
   }
@@ -260,6 +261,7 @@ struct CUDA_Provider : Provider {
     cuda_options.prefer_nhwc = internal_options.prefer_nhwc;
     cuda_options.use_ep_level_unified_stream = internal_options.use_ep_level_unified_stream;
     cuda_options.use_tf32 = internal_options.use_tf32;
+    cuda_options.stream_priority = internal_options.stream_priority;
   }
 
   ProviderOptions GetProviderOptions(const void* provider_options) override {
@@ -1,5 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
+#include <algorithm>
+
 #include "core/providers/cuda/cuda_resource.h"
 #include "core/providers/cuda/cuda_stream_handle.h"
 #include "core/providers/cuda/cuda_common.h"
@@ -233,6 +235,18 @@ void WaitCudaNotificationOnHost(Stream& /*stream*/, synchronize::Notification& n
   static_cast<CudaNotification*>(&notification)->wait_on_host();
 }
 
+cudaStream_t CreateCudaStream(int priority) {
+  int least_priority = 0;
+  int greatest_priority = 0;
+  CUDA_CALL_THROW(cudaDeviceGetStreamPriorityRange(&least_priority, &greatest_priority));
+  // greater priorities have lower numbers
+  priority = std::clamp(priority, greatest_priority, least_priority);
+
+  cudaStream_t stream = nullptr;
+  CUDA_CALL_THROW(cudaStreamCreateWithPriority(&stream, cudaStreamNonBlocking, priority));
+  return stream;
+}
+
 void RegisterCudaStreamHandles(IStreamCommandHandleRegistry& stream_handle_registry,
                                const OrtDevice::DeviceType device_type,
                                AllocatorPtr cpu_allocator,
@@ -249,9 +263,7 @@ void RegisterCudaStreamHandles(IStreamCommandHandleRegistry& stream_handle_regis
   if (!use_existing_stream)
     stream_handle_registry.RegisterCreateStreamFn(device_type, [cpu_allocator, release_cpu_buffer_on_cuda_stream, ep_info](const OrtDevice& device) {
       CUDA_CALL_THROW(cudaSetDevice(device.Id()));
-      cudaStream_t stream = nullptr;
-      CUDA_CALL_THROW(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
-      // CUDA_CALL_THROW(cudaStreamCreate(&stream));
+      cudaStream_t stream = CreateCudaStream(ep_info.stream_priority);
       return std::make_unique<CudaStream>(stream, device, cpu_allocator, release_cpu_buffer_on_cuda_stream, true, nullptr, nullptr, ep_info);
     });
   else
@@ -58,6 +58,9 @@ struct CudaStream : Stream {
   const CUDAExecutionProviderInfo ep_info_;
 };
 
+// Creates a non-blocking stream on the current device with `priority` clamped to the range the device supports.
+cudaStream_t CreateCudaStream(int priority);
+
 void RegisterCudaStreamHandles(IStreamCommandHandleRegistry& stream_handle_registry,
                                const OrtDevice::DeviceType device_type,
                                AllocatorPtr cpu_allocator,
@@ -39,7 +39,8 @@ namespace Dml
             bool enableMetacommands,
             bool enableGraphCapture,
             bool enableCpuSyncSpinning,
-            bool disableMemoryArena);
+            bool disableMemoryArena,
+            uint32_t minNodeCountToReuseCommandList);
 
         void ReleaseCompletedReferences();
 
@@ -164,6 +165,7 @@ namespace Dml
         int GetCurrentGraphAnnotationId() const { return m_currentGraphAnnotationId; }
         void AppendCapturedGraph(int annotationId, std::unique_ptr<DmlReusedCommandListState> capturedGraph);
         bool CpuSyncSpinningEnabled() const noexcept;
+        uint32_t GetMinNodeCountToReuseCommandList() const noexcept { return m_minNodeCountToReuseCommandList; }
         std::shared_ptr<onnxruntime::IAllocator> GetGpuAllocator();
         std::shared_ptr<onnxruntime::IAllocator> GetCpuInputAllocator();
 
@@ -209,6 +211,7 @@ namespace Dml
         bool m_sessionInitialized = false;
         bool m_cpuSyncSpinningEnabled = false;
         bool m_memoryArenaDisabled = false;
+        uint32_t m_minNodeCountToReuseCommandList = 0;
         ComPtr<ExecutionContext> m_context;
         std::unique_ptr<PooledUploadHeap> m_uploadHeap;
         std::unique_ptr<ReadbackHeap> m_readbackHeap;
@@ -263,7 +266,8 @@ namespace Dml
             bool enableMetacommands,
             bool enableGraphCapture,
             bool enableSyncSpinning,
-            bool disableMemoryArena
+            bool disableMemoryArena,
+            uint32_t minNodeCountToReuseCommandList
         );
 
         std::unique_ptr<onnxruntime::IDataTransfer> GetDataTransfer() const final override
@@ -588,7 +588,7 @@ namespace Dml::GraphDescBuilder
         graphDesc.InputEdges = std::move(dmlGraphInputEdges);
         graphDesc.OutputEdges = std::move(dmlGraphOutputEdges);
         graphDesc.IntermediateEdges = std::move(dmlGraphIntermediateEdges);
-        graphDesc.reuseCommandList = (subgraphNodes.size() >= minNodeCountToReuseCommandList || executionHandle->IsMcdmDevice());
+        graphDesc.reuseCommandList = (subgraphNodes.size() >= executionHandle->GetMinNodeCountToReuseCommandList() || executionHandle->IsMcdmDevice());
         graphDesc.outputShapes = std::move(graphOutputShapes);
         return graphDesc;
     }
@@ -23,7 +23,6 @@ namespace Dml
 
     namespace GraphDescBuilder
     {
-        constexpr uint32_t minNodeCountToReuseCommandList = 5;
         constexpr uint32_t c_maxConstNodeDataSize = 8;
 
         // Gets a unique name for the node which survives recreation and graph manipulations between the point
@@ -30,6 +30,7 @@ using Microsoft::WRL::ComPtr;
 #include "DmlExecutionProvider/src/ErrorHandling.h"
 #include "DmlExecutionProvider/src/GraphicsUnknownHelper.h"
 #include "DmlExecutionProvider/inc/DmlExecutionProvider.h"
+#include "core/common/parse_string.h"
 #include "core/platform/env.h"
 #include "core/providers/dml/dml_session_options_config_keys.h"
 #include "core/providers/dml/DmlExecutionProvider/src/ExecutionContext.h"
@@ -57,6 +58,10 @@ struct DMLProviderFactory : IExecutionProviderFactory {
     graph_capture_enabled_ = ConfigValueIsTrue(config_options.GetConfigOrDefault(kOrtSessionOptionsConfigEnableGraphCapture, "0"));
     cpu_sync_spinning_enabled_ = ConfigValueIsTrue(config_options.GetConfigOrDefault(kOrtSessionOptionsConfigEnableCpuSyncSpinning, "0"));
     disable_memory_arena_ = ConfigValueIsTrue(config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisableMemoryArena, "0"));
+
+    const std::string min_node_count_str = config_options.GetConfigOrDefault(kOrtSessionOptionsConfigReuseCommandListMinNodeCount, "5");
+    ORT_ENFORCE(TryParseStringWithClassicLocale(min_node_count_str, min_node_count_to_reuse_command_list_),
+                "Invalid value for ", kOrtSessionOptionsConfigReuseCommandListMinNodeCount, ": ", min_node_count_str);
   }
 
   ~DMLProviderFactory() override {}
@@ -72,6 +77,7 @@ struct DMLProviderFactory : IExecutionProviderFactory {
   bool graph_capture_enabled_ = false;
   bool cpu_sync_spinning_enabled_ = false;
   bool disable_memory_arena_ = false;
+  uint32_t min_node_count_to_reuse_command_list_ = 5;
   bool python_api_ = false;
 };
 
@@ -93,7 +99,7 @@ std::unique_ptr<IExecutionProvider> DMLProviderFactory::CreateProvider() {
     execution_context = wil::MakeOrThrow<Dml::ExecutionContext>(d3d12_device.Get(), dml_device_.Get(), cmd_queue_.Get(), cpu_sync_spinning_enabled_, false);
   }
 
-  auto provider = Dml::CreateExecutionProvider(dml_device_.Get(), execution_context.Get(), metacommands_enabled_, graph_capture_enabled_, cpu_sync_spinning_enabled_, disable_memory_arena_);
+  auto provider = Dml::CreateExecutionProvider(dml_device_.Get(), execution_context.Get(), metacommands_enabled_, graph_capture_enabled_, cpu_sync_spinning_enabled_, disable_memory_arena_, min_node_count_to_reuse_command_list_);
   return provider;
 }
 
@@ -25,3 +25,11 @@ static const char* const kOrtSessionOptionsConfigEnableGraphSerialization = "ep.
 static const char* const kOrtSessionOptionsConfigEnableGraphCapture = "ep.dml.enable_graph_capture";
 static const char* const kOrtSessionOptionsConfigEnableCpuSyncSpinning = "ep.dml.enable_cpu_sync_spinning";
 static const char* const kOrtSessionOptionsConfigDisableMemoryArena = "ep.dml.disable_memory_arena";
+
+// Minimum number of nodes a fused DirectML partition needs for its command list to be recorded once and re-executed
+// by later Runs, instead of being recorded on every execution. Re-executing a command list only rebinds the inputs and
+// outputs, which removes most of the CPU cost of small partitions at high execution rates, at the cost of a descriptor
+// heap per recorded command list. Command lists are always reused on MCDM devices.
+// "0" or "1": all partitions reuse their command list.
+// The default value is "5"
+static const char* const kOrtSessionOptionsConfigReuseCommandListMinNodeCount = "ep.dml.reuse_command_list_min_node_count";
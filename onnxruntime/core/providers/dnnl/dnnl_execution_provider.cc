@@ -5,6 +5,7 @@
 #pragma warning(disable : 4996)
 #endif
 
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <unordered_set>
@@ -49,6 +50,19 @@ DnnlExecutionProvider::DnnlExecutionProvider(const DnnlExecutionProviderInfo& in
     enable_fusion_ = (std::stoi(fusion_env) == 0 ? false : true);
   }
 
+  // number of input shapes each dynamic subgraph keeps compiled primitives for
+  const std::string shape_cache_env = onnxruntime::GetEnvironmentVar("ORT_DNNL_SHAPE_CACHE_CAPACITY");
+  if (!shape_cache_env.empty()) {
+    shape_cache_capacity_ = static_cast<size_t>(std::max(std::stoi(shape_cache_env), 1));
+  }
+
+  // oneDNN caches the JIT compiled primitives process wide, so sessions creating primitives with the same
+  // descriptors reuse the kernels. Allow raising the capacity (1024 by default) for models with many shapes.
+  const std::string primitive_cache_env = onnxruntime::GetEnvironmentVar("ORT_DNNL_PRIMITIVE_CACHE_CAPACITY");
+  if (!primitive_cache_env.empty()) {
+    dnnl::set_primitive_cache_capacity(std::stoi(primitive_cache_env));
+  }
+
   // Set the number of threads specified by the user
   // If provided arguments set them as the number of threads, else call
   // calc which usually = numcores
@@ -296,7 +310,8 @@ Status DnnlExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fuse
     }
 
     // subgraph primitive
-    auto dnnl_subgraph_primitive = std::make_unique<ort_dnnl::DnnlSubgraphPrimitive>(*subgraphs_[fused_node.Name()].get());
+    auto dnnl_subgraph_primitive = std::make_unique<ort_dnnl::DnnlSubgraphPrimitive>(*subgraphs_[fused_node.Name()].get(),
+                                                                                  shape_cache_capacity_);
     {
       const auto& input_defs = fused_node.InputDefs();
       std::vector<std::string> onnx_input_names(input_defs.size());
@@ -41,6 +41,8 @@ class DnnlExecutionProvider : public IExecutionProvider {
   bool debug_log_ = false;
   // enable fusion by default
   bool enable_fusion_ = true;
+  // keep the primitives of the 4 most recently used input shapes of each subgraph by default
+  size_t shape_cache_capacity_ = 4;
   std::unique_ptr<ModelMetadefIdGenerator> metadef_id_generator_;
 };
 
@@ -37,6 +37,7 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 
@@ -240,7 +241,8 @@ void DnnlSubgraphPrimitive::AddKernels() {
   }
 }
 
-DnnlSubgraphPrimitive::DnnlSubgraphPrimitive(ort_dnnl::DnnlSubgraph& dnnl_subgraph) {
+DnnlSubgraphPrimitive::DnnlSubgraphPrimitive(ort_dnnl::DnnlSubgraph& dnnl_subgraph, size_t shape_cache_capacity)
+    : shape_cache_capacity_(std::max<size_t>(shape_cache_capacity, 1)) {
   subgraph_ = &dnnl_subgraph;
   if (dnnl_engine_get_count(dnnl_engine_kind_t::dnnl_cpu)) {
     cpu_engine_ = dnnl::engine(dnnl::engine::kind::cpu, 0);
@@ -276,11 +278,30 @@ void DnnlSubgraphPrimitive::Compile(const std::unordered_map<std::string, OnnxTe
     key += "|";
   }
   // if key different from shape key, update and recompile
-  if (key != shape_key_) {
-    shape_key_ = key;
-  } else {
+  if (key == shape_key_) {
     return;
   }
+
+  // keep the current primitives around in case the shapes switch back
+  if (!shape_key_.empty() && shape_cache_capacity_ > 1) {
+    shape_cache_.emplace_front(shape_key_, CompiledState{});
+    SaveCompiledState(shape_cache_.front().second);
+    if (shape_cache_.size() >= shape_cache_capacity_) {
+      shape_cache_.pop_back();
+    }
+  }
+
+  shape_key_ = key;
+
+  auto cached = std::find_if(shape_cache_.begin(), shape_cache_.end(),
+                             [&key](const auto& entry) { return entry.first == key; });
+  if (cached != shape_cache_.end()) {
+    LOGS_DEFAULT(INFO) << "Reuse compiled primitives for input shapes";
+    RestoreCompiledState(cached->second);
+    shape_cache_.erase(cached);
+    return;
+  }
+
   if (IsDynamic()) {
     LOGS_DEFAULT(INFO) << "Dynamic Compile";
   } else {
@@ -292,11 +313,13 @@ void DnnlSubgraphPrimitive::Compile(const std::unordered_map<std::string, OnnxTe
   outputs_.clear();
   outputs_are_always_copied_.clear();
   inputs_md_.clear();
+  input_is_scalar_.clear();
   outputs_md_.clear();
   net_.clear();
   net_args_.clear();
   reshapes_.clear();
   scalar_outputs_.clear();
+  items_to_print_.clear();
   // initializer should not be cleared upon recompile
   // initializers_.clear();
 
@@ -321,6 +344,36 @@ void DnnlSubgraphPrimitive::Compile(const std::unordered_map<std::string, OnnxTe
   AddOutputs();
 }
 
+void DnnlSubgraphPrimitive::SaveCompiledState(CompiledState& state) {
+  state.intermediates = std::move(intermediates_);
+  state.inputs = std::move(inputs_);
+  state.inputs_md = std::move(inputs_md_);
+  state.input_is_scalar = std::move(input_is_scalar_);
+  state.outputs = std::move(outputs_);
+  state.outputs_md = std::move(outputs_md_);
+  state.outputs_are_always_copied = std::move(outputs_are_always_copied_);
+  state.net = std::move(net_);
+  state.net_args = std::move(net_args_);
+  state.reshapes = std::move(reshapes_);
+  state.scalar_outputs = std::move(scalar_outputs_);
+  state.items_to_print = std::move(items_to_print_);
+}
+
+void DnnlSubgraphPrimitive::RestoreCompiledState(CompiledState& state) {
+  intermediates_ = std::move(state.intermediates);
+  inputs_ = std::move(state.inputs);
+  inputs_md_ = std::move(state.inputs_md);
+  input_is_scalar_ = std::move(state.input_is_scalar);
+  outputs_ = std::move(state.outputs);
+  outputs_md_ = std::move(state.outputs_md);
+  outputs_are_always_copied_ = std::move(state.outputs_are_always_copied);
+  net_ = std::move(state.net);
+  net_args_ = std::move(state.net_args);
+  reshapes_ = std::move(state.reshapes);
+  scalar_outputs_ = std::move(state.scalar_outputs);
+  items_to_print_ = std::move(state.items_to_print);
+}
+
 dnnl::memory::format_tag DnnlSubgraphPrimitive::GetDnnlFormat(size_t dim_size) {
   dnnl::memory::format_tag source_format = dnnl::memory::format_tag::any;
   switch (dim_size) {
@@ -2,6 +2,7 @@
 // Licensed under the MIT License
 
 #pragma once
+#include <list>
 #include "dnnl_subgraph.h"
 #include "dnnl.hpp"
 #include "core/platform/ort_mutex.h"
@@ -22,10 +23,13 @@ struct OnnxTensorData {
 
 class DnnlSubgraphPrimitive {
  public:
-  DnnlSubgraphPrimitive(ort_dnnl::DnnlSubgraph& dnnl_subgraph);
+  // shape_cache_capacity is the number of input shapes a dynamic subgraph keeps compiled primitives for
+  DnnlSubgraphPrimitive(ort_dnnl::DnnlSubgraph& dnnl_subgraph, size_t shape_cache_capacity = 1);
   ~DnnlSubgraphPrimitive() = default;
 
   // compile subgraph primitive with runtime input information
+  // the primitives of the least recently used input shapes are kept so alternating shapes (e.g. variable batch size)
+  // don't rebuild and JIT the primitives on every change
   void Compile(const std::unordered_map<std::string, OnnxTensorData>& inputs);
   void AddInitializers();
   void AddOutputs();
@@ -96,8 +100,31 @@ class DnnlSubgraphPrimitive {
   }
 
  private:
+  // everything Compile builds for one set of input shapes
+  struct CompiledState {
+    std::unordered_map<std::string, std::vector<dnnl::memory>> intermediates;
+    std::unordered_map<std::string, dnnl::memory> inputs;
+    std::unordered_map<std::string, dnnl::memory::desc> inputs_md;
+    std::unordered_set<std::string> input_is_scalar;
+    std::unordered_map<std::string, dnnl::memory> outputs;
+    std::unordered_map<std::string, dnnl::memory::desc> outputs_md;
+    std::unordered_set<std::string> outputs_are_always_copied;
+    std::vector<dnnl::primitive> net;
+    std::vector<std::unordered_map<int, dnnl::memory>> net_args;
+    std::vector<std::pair<dnnl::memory, dnnl::memory>> reshapes;
+    std::unordered_set<std::string> scalar_outputs;
+    std::vector<std::pair<int, int>> items_to_print;
+  };
+
+  void SaveCompiledState(CompiledState& state);
+  void RestoreCompiledState(CompiledState& state);
+
   std::string shape_key_;
 
+  // compiled states of previously seen input shapes, most recently used first. the current state is not in the list.
+  std::list<std::pair<std::string, CompiledState>> shape_cache_;
+  size_t shape_cache_capacity_;
+
   std::unordered_map<std::string, std::vector<dnnl::memory>> intermediates_;
 
   std::unordered_map<std::string, dnnl::memory> inputs_;
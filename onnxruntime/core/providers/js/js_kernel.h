@@ -9,6 +9,8 @@
 #include <sstream>
 #endif
 
+#include <vector>
+
 #include "core/framework/op_kernel.h"
 #include "core/providers/js/js_execution_provider.h"
 #include "core/providers/js/js_data_types.h"
@@ -83,7 +85,7 @@ class JsKernel : public OpKernel {
     EM_ASM({ Module.jsepReleaseKernel($0); }, this);
   }
 
-  Status SerializeKernelContext(OpKernelContext* context, AllocatorPtr alloc, void* custom_data_ptr, size_t custom_data_size, void** ptr) const {
+  Status SerializeKernelContext(OpKernelContext* context, void* custom_data_ptr, size_t custom_data_size, void** ptr) const {
     //
     // An optional input may be a placeholder, which is nullptr. In this case, we still need to
     // add the placeholder to the serialized data, with type, data_ptr and dim_size all zeros,
@@ -110,10 +112,10 @@ class JsKernel : public OpKernel {
         temp_data_size += sizeof(size_t) * 3;
       }
     }
-    uint32_t* p_serialized_kernel_context = reinterpret_cast<uint32_t*>(alloc->Alloc(temp_data_size));
-    if (p_serialized_kernel_context == nullptr) {
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to allocate memory for serialized kernel context.");
-    }
+    // The buffer is kept by the kernel and reused by every call, so a dispatch does not need to allocate from the
+    // WASM heap. This is safe because JSEP does not support concurrent runs.
+    serialized_kernel_context_.resize(temp_data_size / sizeof(uint32_t));
+    uint32_t* p_serialized_kernel_context = serialized_kernel_context_.data();
 
     p_serialized_kernel_context[0] = reinterpret_cast<uint32_t>(context);
     p_serialized_kernel_context[1] = static_cast<uint32_t>(context->InputCount());
@@ -191,7 +193,7 @@ class JsKernel : public OpKernel {
     ORT_RETURN_IF_ERROR(SerializeCustomData(context, alloc, &p_custom_data, &custom_data_size));
 
     void* p_serialized_kernel_context = nullptr;
-    auto status = SerializeKernelContext(context, alloc, p_custom_data, custom_data_size, &p_serialized_kernel_context);
+    auto status = SerializeKernelContext(context, p_custom_data, custom_data_size, &p_serialized_kernel_context);
     if (!status.IsOK()) {
       if (p_custom_data != nullptr) {
         alloc->Free(p_custom_data);
@@ -206,7 +208,6 @@ class JsKernel : public OpKernel {
     LOGS_DEFAULT(VERBOSE) << "outputs = " << context->OutputCount() << ". Y.data="
                           << (size_t)(context->Output<Tensor>(0)->DataRaw()) << ".";
 
-    alloc->Free(p_serialized_kernel_context);
     if (p_custom_data != nullptr) {
       alloc->Free(p_custom_data);
     }
@@ -221,6 +222,9 @@ class JsKernel : public OpKernel {
   Status Compute(OpKernelContext* context) const override {
     return ComputeInternal(context);
   }
+
+ private:
+  mutable std::vector<uint32_t> serialized_kernel_context_;
 };
 }  // namespace js
 }  // namespace onnxruntime
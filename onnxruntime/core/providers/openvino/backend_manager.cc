@@ -411,48 +411,52 @@ void BackendManager::Compute(OrtKernelContext* context) {
     std::vector<std::vector<int64_t>> tensor_shapes = GetInputTensorShapes(ctx);
     auto key = MakeMapKeyString(tensor_shapes, GetGlobalContext().device_type);
     std::shared_ptr<IBackend> dynamic_backend;
-    auto search = backend_map_.find(key);
-    if (search == backend_map_.end()) {
-      LOGS_DEFAULT(INFO) << "[OpenVINO-EP] "
-                         << "Creating dynamic backend for key: " << key;
-      LOGS_DEFAULT(INFO) << "[OpenVINO-EP] "
-                         << "Backend created for graph " << subgraph_context_.subgraph_name;
-      auto modelproto_with_concrete_shapes = ReWriteInputShapeInfo(*model_proto_, tensor_shapes);
-      try {
-        dynamic_backend = BackendFactory::MakeBackend(*modelproto_with_concrete_shapes,
-                                                      GetGlobalContext(),
-                                                      subgraph_context_,
-                                                      ep_ctx_handle_);
-      } catch (const OnnxRuntimeException& ex) {
-        // Build option disables fallback to CPU on compilation failures with NPU.
+    {
+      // Concurrent Run calls may need a backend for the same shape at the same time
+      std::lock_guard<std::mutex> lock(backend_map_mutex_);
+      auto search = backend_map_.find(key);
+      if (search == backend_map_.end()) {
+        LOGS_DEFAULT(INFO) << "[OpenVINO-EP] "
+                           << "Creating dynamic backend for key: " << key;
+        LOGS_DEFAULT(INFO) << "[OpenVINO-EP] "
+                           << "Backend created for graph " << subgraph_context_.subgraph_name;
+        auto modelproto_with_concrete_shapes = ReWriteInputShapeInfo(*model_proto_, tensor_shapes);
+        try {
+          dynamic_backend = BackendFactory::MakeBackend(*modelproto_with_concrete_shapes,
+                                                        GetGlobalContext(),
+                                                        subgraph_context_,
+                                                        ep_ctx_handle_);
+        } catch (const OnnxRuntimeException& ex) {
+          // Build option disables fallback to CPU on compilation failures with NPU.
 #if defined(OPENVINO_DISABLE_NPU_FALLBACK)
-        LOGS_DEFAULT(WARNING) << "Model compilation failed at OV NPU.";
-        ORT_THROW(ex.what());
+          LOGS_DEFAULT(WARNING) << "Model compilation failed at OV NPU.";
+          ORT_THROW(ex.what());
 #else
-        if (GetGlobalContext().device_type.find("NPU") != std::string::npos &&
-            !GetGlobalContext().disable_cpu_fallback) {
-          LOGS_DEFAULT(WARNING) << ex.what();
-          LOGS_DEFAULT(WARNING) << "Model compilation failed at OV NPU."
-                                << "Falling back to OV CPU for execution";
-          GetGlobalContext().device_type = "CPU";
-          GetGlobalContext().precision_str = "FP32";
-          key = MakeMapKeyString(tensor_shapes, GetGlobalContext().device_type);
-          try {
-            dynamic_backend = BackendFactory::MakeBackend(*modelproto_with_concrete_shapes,
-                                                          GetGlobalContext(),
-                                                          subgraph_context_,
-                                                          ep_ctx_handle_);
-          } catch (std::string const& msg) {
-            ORT_THROW(msg);
+          if (GetGlobalContext().device_type.find("NPU") != std::string::npos &&
+              !GetGlobalContext().disable_cpu_fallback) {
+            LOGS_DEFAULT(WARNING) << ex.what();
+            LOGS_DEFAULT(WARNING) << "Model compilation failed at OV NPU."
+                                  << "Falling back to OV CPU for execution";
+            GetGlobalContext().device_type = "CPU";
+            GetGlobalContext().precision_str = "FP32";
+            key = MakeMapKeyString(tensor_shapes, GetGlobalContext().device_type);
+            try {
+              dynamic_backend = BackendFactory::MakeBackend(*modelproto_with_concrete_shapes,
+                                                            GetGlobalContext(),
+                                                            subgraph_context_,
+                                                            ep_ctx_handle_);
+            } catch (std::string const& msg) {
+              ORT_THROW(msg);
+            }
+          } else {
+            ORT_THROW(ex.what());
           }
-        } else {
-          ORT_THROW(ex.what());
-        }
 #endif
+        }
+        backend_map_.insert({key, dynamic_backend});
+      } else {
+        dynamic_backend = search->second;
       }
-      backend_map_.insert({key, dynamic_backend});
-    } else {
-      dynamic_backend = search->second;
     }
 
     dynamic_backend->Infer(context);
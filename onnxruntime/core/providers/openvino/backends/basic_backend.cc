@@ -1,6 +1,7 @@
 // Copyright (C) Intel Corporation
 // Licensed under the MIT License
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <memory>
@@ -117,7 +118,23 @@ BasicBackend::BasicBackend(const ONNX_NAMESPACE::ModelProto& model_proto,
     ORT_THROW(msg);
   }
 
-  inferRequestsQueue_ = std::unique_ptr<InferRequestsQueue>(new InferRequestsQueue(exe_network_, 1));
+  inferRequestsQueue_ = std::unique_ptr<InferRequestsQueue>(new InferRequestsQueue(exe_network_, GetNumInferRequests()));
+}
+
+// A Run waits for an idle infer request, so the size of the pool bounds how many Run calls on the session can
+// execute on the device at the same time. Create one request per stream, or as many as the plugin reports to be
+// optimal for the compiled model if that is more.
+size_t BasicBackend::GetNumInferRequests() {
+  size_t num_infer_requests = static_cast<size_t>(std::max(global_context_.num_streams, 1));
+  try {
+    uint32_t optimal_num_infer_requests = exe_network_.Get().get_property(ov::optimal_number_of_infer_requests);
+    num_infer_requests = std::max(num_infer_requests, static_cast<size_t>(optimal_num_infer_requests));
+  } catch (const std::exception& e) {
+    LOGS_DEFAULT(INFO) << log_tag << "Optimal number of infer requests is not available: " << e.what();
+  }
+
+  LOGS_DEFAULT(INFO) << log_tag << "Number of infer requests: " << num_infer_requests;
+  return num_infer_requests;
 }
 
 bool BasicBackend::ValidateSubgraph(std::map<std::string, std::shared_ptr<ov::Node>>& const_outputs_map) {
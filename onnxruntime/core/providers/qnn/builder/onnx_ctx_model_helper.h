@@ -48,16 +48,20 @@ bool ValidateContextCacheFilePath(bool is_qnn_ctx_model,
                                   const onnxruntime::PathString& model_pathstring,
                                   onnxruntime::PathString& context_cache_path);
 
+// If share_ep_contexts is true, graphs in the context binary without a matching EPContext node are added to
+// qnn_models instead of failing so they can be handed to other sessions.
 Status GetEpContextFromMainNode(const onnxruntime::Node& main_context_node,
                                 const onnxruntime::PathString& ctx_onnx_model_path,
                                 QnnBackendManager* qnn_backend_manager,
-                                std::unordered_map<std::string, std::unique_ptr<qnn::QnnModel>>& qnn_models);
+                                std::unordered_map<std::string, std::unique_ptr<qnn::QnnModel>>& qnn_models,
+                                bool share_ep_contexts = false);
 
 Status LoadQnnCtxFromOnnxGraph(const onnxruntime::GraphViewer& graph_viewer,
                                const onnxruntime::PathString& ctx_onnx_model_path,
                                QnnBackendManager* qnn_backend_manager,
                                std::unordered_map<std::string, std::unique_ptr<qnn::QnnModel>>& qnn_models,
-                               const logging::Logger& logger);
+                               const logging::Logger& logger,
+                               bool share_ep_contexts = false);
 
 Status CreateEPContextNodes(Model* model,
                             unsigned char* buffer,
@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "core/platform/ort_mutex.h"
+#include "core/providers/qnn/builder/qnn_backend_manager.h"
+#include "core/providers/qnn/builder/qnn_model.h"
+
+namespace onnxruntime {
+namespace qnn {
+
+// Process wide state shared by the QNN EP instances of sessions that enable ep.share_ep_contexts.
+// The sessions use one QnnBackendManager so a context loaded by one of them can run graphs for another. Graphs of a
+// loaded context binary that no session has claimed yet are kept here until a session with a matching EPContext
+// node takes them.
+class SharedContext {
+ public:
+  static SharedContext& GetInstance() {
+    static SharedContext instance;
+    return instance;
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SharedContext);
+
+  // Register a QNN EP instance that shares contexts and return the shared backend manager.
+  // `create_backend_manager` is only called for the first instance.
+  std::shared_ptr<QnnBackendManager> AddUser(
+      const std::function<std::unique_ptr<QnnBackendManager>()>& create_backend_manager) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    if (num_users_++ == 0) {
+      backend_manager_ = create_backend_manager();
+    }
+
+    return backend_manager_;
+  }
+
+  // Unregister a QNN EP instance. The graphs nobody claimed and the backend manager are released with the last one.
+  void RemoveUser() {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    if (--num_users_ == 0) {
+      qnn_models_.clear();
+      backend_manager_.reset();
+    }
+  }
+
+  // Take the graph for the EPContext node `name` if another session loaded it. Returns nullptr otherwise.
+  std::unique_ptr<QnnModel> TakeQnnModel(const std::string& name) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = qnn_models_.find(name);
+    if (it == qnn_models_.end()) {
+      return nullptr;
+    }
+
+    auto qnn_model = std::move(it->second);
+    qnn_models_.erase(it);
+    return qnn_model;
+  }
+
+  // Keep graphs the current session loaded but does not use.
+  void AddQnnModels(std::unordered_map<std::string, std::unique_ptr<QnnModel>>&& qnn_models) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    for (auto& [name, qnn_model] : qnn_models) {
+      if (qnn_model) {
+        qnn_models_.emplace(name, std::move(qnn_model));
+      }
+    }
+  }
+
+ private:
+  SharedContext() = default;
+
+  OrtMutex mutex_;
+  size_t num_users_ = 0;
+  std::shared_ptr<QnnBackendManager> backend_manager_;
+  std::unordered_map<std::string, std::unique_ptr<QnnModel>> qnn_models_;
+};
+
+}  // namespace qnn
+}  // namespace onnxruntime
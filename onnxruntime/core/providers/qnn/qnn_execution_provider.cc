@@ -198,6 +198,10 @@ QNNExecutionProvider::QNNExecutionProvider(const ProviderOptions& provider_optio
     LOGS_DEFAULT(VERBOSE) << "User specified context cache embed mode: " << qnn_context_embed_mode_;
 
     context_cache_path_cfg_ = session_options->config_options.GetConfigOrDefault(kOrtSessionOptionEpContextFilePath, "");
+
+    share_ep_contexts_ = session_options->config_options.GetConfigOrDefault(
+                             kOrtSessionOptionShareEpContexts, "0") == "1";
+    LOGS_DEFAULT(VERBOSE) << "User specified option - share EP contexts across sessions: " << share_ep_contexts_;
     LOGS_DEFAULT(VERBOSE) << "User specified context cache path: " << context_cache_path_cfg_;
   }
 
@@ -378,16 +382,25 @@ QNNExecutionProvider::QNNExecutionProvider(const ProviderOptions& provider_optio
     LOGS_DEFAULT(VERBOSE) << "User specified enable_htp_fp16_precision: " << enable_HTP_FP16_precision_;
   }
 
-  qnn_backend_manager_ = std::make_unique<qnn::QnnBackendManager>(
-      std::move(backend_path),
-      profiling_level_etw,
-      profiling_level,
-      std::move(profiling_file_path),
-      context_priority,
-      std::move(qnn_saver_path),
-      device_id_,
-      htp_arch,
-      soc_model);
+  auto create_backend_manager = [&]() {
+    return std::make_unique<qnn::QnnBackendManager>(
+        std::move(backend_path),
+        profiling_level_etw,
+        profiling_level,
+        std::move(profiling_file_path),
+        context_priority,
+        std::move(qnn_saver_path),
+        device_id_,
+        htp_arch,
+        soc_model);
+  };
+
+  if (share_ep_contexts_) {
+    // the first session sharing EP contexts decides the backend options for all of them
+    qnn_backend_manager_ = qnn::SharedContext::GetInstance().AddUser(create_backend_manager);
+  } else {
+    qnn_backend_manager_ = create_backend_manager();
+  }
 }
 
 QNNExecutionProvider::~QNNExecutionProvider() {
@@ -399,6 +412,11 @@ QNNExecutionProvider::~QNNExecutionProvider() {
     ORT_IGNORE_RETURN_VALUE(cache->erase(this));
   }
 
+  if (share_ep_contexts_) {
+    qnn_backend_manager_.reset();
+    qnn::SharedContext::GetInstance().RemoveUser();
+  }
+
   // Unregister the ETW callback
 #ifdef _WIN32
   logging::EtwRegistrationManager::Instance().UnregisterInternalCallback(callback_ETWSink_provider_);
@@ -828,14 +846,31 @@ Status QNNExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fused
     ORT_RETURN_IF_ERROR(qnn::GetMainContextNode(fused_nodes_and_graphs, qnn_backend_manager_.get(),
                                                 logger, main_context_pos_list, qnn_models));
 
+    // Graphs already deserialized by another session sharing EP contexts are reused as is
+    std::unordered_set<std::string> shared_model_names;
+    if (share_ep_contexts_) {
+      for (auto& [name, qnn_model] : qnn_models) {
+        auto shared_qnn_model = qnn::SharedContext::GetInstance().TakeQnnModel(name);
+        if (shared_qnn_model) {
+          qnn_model = std::move(shared_qnn_model);
+          shared_model_names.insert(name);
+        }
+      }
+    }
+
     for (auto main_context_pos : main_context_pos_list) {
       const onnxruntime::GraphViewer& main_ctx_graph_viewer(fused_nodes_and_graphs[main_context_pos].filtered_graph);
+      if (shared_model_names.count(main_ctx_graph_viewer.Nodes().begin()->Name()) > 0) {
+        continue;
+      }
+
       // Create QNN context from the cached binary, deserialize the QNN graph from the binary
       ORT_RETURN_IF_ERROR(qnn::LoadQnnCtxFromOnnxGraph(main_ctx_graph_viewer,
                                                        context_cache_path,
                                                        qnn_backend_manager_.get(),
                                                        qnn_models,
-                                                       logger));
+                                                       logger,
+                                                       share_ep_contexts_));
     }
 
     for (auto fused_node_and_graph : fused_nodes_and_graphs) {
@@ -856,6 +891,11 @@ Status QNNExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fused
       ORT_RETURN_IF_ERROR(CreateComputeFunc(node_compute_funcs, logger));
     }
 
+    if (share_ep_contexts_) {
+      // keep the graphs from the context binaries that this session does not use for the other sessions
+      qnn::SharedContext::GetInstance().AddQnnModels(std::move(qnn_models));
+    }
+
     return Status::OK();
   }
 
@@ -227,6 +227,39 @@ inline void saveTimingCacheFile(const std::string outFileName, const nvinfer1::I
   oFile.write((char*)blob->data(), blob->size());
   oFile.close();
 }
+
+// Writes an engine built by the compute function and the profile it's built with to the engine cache.
+onnxruntime::Status WriteEngineCache(const onnxruntime::TensorrtFuncState& trt_state,
+                                     onnxruntime::ShapeRangesMap& shape_ranges,
+                                     const nvinfer1::IHostMemory& serialized_engine,
+                                     const std::string& profile_cache_path, const std::string& engine_cache_path,
+                                     const std::string& encrypted_engine_cache_path) {
+  // Serialize engine profile
+  SerializeProfileV2(profile_cache_path, shape_ranges);
+  LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + profile_cache_path;
+
+  // Serialize engine
+  if (trt_state.engine_decryption_enable) {
+    // Encrypt engine. The library is not always deployed with the encrypt function, so check if it is available first.
+    if (trt_state.engine_encryption != nullptr) {
+      if (!trt_state.engine_encryption(encrypted_engine_cache_path.c_str(),
+                                       reinterpret_cast<char*>(const_cast<void*>(serialized_engine.data())),
+                                       serialized_engine.size())) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
+                               "TensorRT EP could not call engine encryption function encrypt");
+      }
+      LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized and encrypted engine " + encrypted_engine_cache_path;
+    } else {
+      LOGS_DEFAULT(WARNING) << "[TensorRT EP] Engine cache encryption function is not found. No cache is written to disk";
+    }
+  } else {
+    std::ofstream file(engine_cache_path, std::ios::binary | std::ios::out);
+    file.write(reinterpret_cast<const char*>(serialized_engine.data()), serialized_engine.size());
+    LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + engine_cache_path;
+  }
+
+  return onnxruntime::Status::OK();
+}
 }  // namespace
 
 namespace google {
@@ -1350,6 +1383,7 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     profile_opt_shapes = info.profile_opt_shapes;
     cuda_graph_enable_ = info.cuda_graph_enable;
     engine_hw_compatible_ = info.engine_hw_compatible;
+    async_engine_build_ = info.async_engine_build;
   } else {
     try {
       const std::string max_partition_iterations_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kMaxPartitionIterations);
@@ -1608,6 +1642,24 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
 #endif
   }
 
+  // Asynchronous engine build: the engine built meanwhile uses builder optimization level 0. The weight-stripped engine
+  // refit and the EP context model dump write the engine to disk, they would write the quickly built engine.
+  if (async_engine_build_) {
+#if NV_TENSORRT_MAJOR == 8 && NV_TENSORRT_MINOR > 5 || NV_TENSORRT_MAJOR > 8
+    if (builder_optimization_level_ == 0) {
+      async_engine_build_ = false;
+    } else if (weight_stripped_engine_enable_ || dump_ep_context_model_) {
+      LOGS_DEFAULT(WARNING) << "[TensorRT EP] trt_async_engine_build can't be used with weight-stripped engines or "
+                               "EP context model dumps and is disabled.";
+      async_engine_build_ = false;
+    }
+#else
+    LOGS_DEFAULT(WARNING) << "[TensorRT EP] trt_async_engine_build requires the builder optimization level of TRT 8.6 "
+                             "onwards and is disabled.";
+    async_engine_build_ = false;
+#endif
+  }
+
   if (engine_cache_enable_ || int8_enable_ || timing_cache_enable_) {
     if (!cache_path_.empty() && !fs::is_directory(cache_path_)) {
       if (!fs::create_directory(cache_path_)) {
@@ -1736,7 +1788,8 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
                         << ", trt_ep_context_file_path: " << ep_context_file_path_
                         << ", trt_ep_context_embed_mode: " << ep_context_embed_mode_
                         << ", trt_cache_prefix: " << cache_prefix_
-                        << ", trt_engine_hw_compatible: " << engine_hw_compatible_;
+                        << ", trt_engine_hw_compatible: " << engine_hw_compatible_
+                        << ", trt_async_engine_build: " << async_engine_build_;
 }
 
 TensorrtExecutionProvider::~TensorrtExecutionProvider() {
@@ -3289,7 +3342,8 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
           context_memory_sharing_enable_, &max_ctx_mem_size_, dynamic_range_map, engine_decryption_enable_,
           engine_decryption_, engine_encryption_, timing_cache_enable_, global_cache_path_, force_timing_cache_match_,
           detailed_build_log_, build_heuristics_enable_, sparsity_enable_, builder_optimization_level_,
-          auxiliary_streams_, !tactic_sources_.empty(), tactics, cuda_graph_enable_, cache_prefix_, cache_suffix, engine_hw_compatible_};
+          auxiliary_streams_, !tactic_sources_.empty(), tactics, cuda_graph_enable_, cache_prefix_, cache_suffix, engine_hw_compatible_,
+          async_engine_build_};
     *state = p.release();
     return 0;
   };
@@ -3437,6 +3491,38 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
       }
     }
 
+    // Swap in the engine built in the background once it's ready, see trt_async_engine_build.
+    if (trt_state->pending_engine_build.valid() &&
+        trt_state->pending_engine_build.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+      TensorrtAsyncEngineBuild engine_build = trt_state->pending_engine_build.get();
+      std::unique_ptr<nvinfer1::ICudaEngine> built_engine;
+      if (engine_build.serialized_engine != nullptr) {
+        built_engine.reset(trt_state->runtime->deserializeCudaEngine(engine_build.serialized_engine->data(),
+                                                                     engine_build.serialized_engine->size()));
+      }
+
+      if (built_engine == nullptr) {
+        LOGS_DEFAULT(WARNING) << "[TensorRT EP] The background engine build for " << trt_state->trt_node_name_with_precision
+                              << " failed, the engine built with optimization level 0 is kept.";
+      } else {
+        // Destroy the IExecutionContext objects before destroying an engine object, otherwise it will lead to undefined behavior.
+        trt_state->context->reset();
+        *(trt_state->engine) = std::move(built_engine);
+        trt_engine = trt_state->engine->get();
+        context_update = true;
+        LOGS_DEFAULT(INFO) << "[TensorRT EP] Swapped in the engine built in the background for "
+                           << trt_state->trt_node_name_with_precision;
+
+        if (trt_state->engine_cache_enable) {
+          ORT_RETURN_IF_ERROR(WriteEngineCache(*trt_state, engine_build.shape_ranges, *engine_build.serialized_engine,
+                                               profile_cache_path, engine_cache_path, encrypted_engine_cache_path));
+        }
+        if (trt_state->timing_cache_enable && engine_build.serialized_timing_cache != nullptr) {
+          saveTimingCacheFile(timing_cache_path, engine_build.serialized_timing_cache.get());
+        }
+      }
+    }
+
     // Check and update shape ranges for dynamic shape inputs.
     for (int i = 0, end = num_inputs; i < end; ++i) {
       auto input = trt_state->network->get()->getInput(i);
@@ -3455,6 +3541,13 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
 
     // Regenerate engine
     if (engine_update) {
+      // A build in the background for earlier profiles uses the builder and the network. Its engine is superseded by the
+      // engine for the new profiles.
+      if (trt_state->pending_engine_build.valid()) {
+        trt_state->pending_engine_build.wait();
+        trt_state->pending_engine_build = {};
+      }
+
       // Destroy the IExecutionContext objects before destroying an engine object, otherwise it will lead to undefined behavior.
       trt_state->context->reset();
       trt_state->engine->reset();
@@ -3559,6 +3652,15 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
         LOGS_DEFAULT(INFO) << "[TensorRT EP] Re-generate engine with hardware compatibility enabled.";
       }
 
+      // With trt_async_engine_build, an engine built with optimization level 0 runs until the engine built with the
+      // configured level in the background is ready.
+      const bool build_async = trt_state->async_engine_build;
+#if NV_TENSORRT_MAJOR == 8 && NV_TENSORRT_MINOR > 5 || NV_TENSORRT_MAJOR > 8
+      if (build_async) {
+        trt_config->setBuilderOptimizationLevel(0);
+      }
+#endif
+
       // Build engine
       std::unique_ptr<nvinfer1::IHostMemory> serialized_engine;
       {
@@ -3586,32 +3688,14 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
         return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP Failed to Build Engine.");
       }
       trt_engine = trt_state->engine->get();
-      if (trt_state->engine_cache_enable) {
-        // Serialize engine profile
-        SerializeProfileV2(profile_cache_path, shape_ranges);
-        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + profile_cache_path;
-
-        // Serialize engine
-        if (trt_state->engine_decryption_enable) {
-          // Encrypt engine. The library is not always deployed with the encrypt function, so check if it is available first.
-          if (trt_state->engine_encryption != nullptr) {
-            if (!trt_state->engine_encryption(encrypted_engine_cache_path.c_str(), reinterpret_cast<char*>(serialized_engine->data()), serialized_engine->size())) {
-              return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
-                                     "TensorRT EP could not call engine encryption function encrypt");
-            }
-            LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized and encrypted engine " + encrypted_engine_cache_path;
-          } else {
-            LOGS_DEFAULT(WARNING) << "[TensorRT EP] Engine cache encryption function is not found. No cache is written to disk";
-          }
-        } else {
-          std::ofstream file(engine_cache_path, std::ios::binary | std::ios::out);
-          file.write(reinterpret_cast<char*>(serialized_engine->data()), serialized_engine->size());
-          LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + engine_cache_path;
-        }
+      // the quickly built engine isn't cached, the engine built in the background is
+      if (trt_state->engine_cache_enable && !build_async) {
+        ORT_RETURN_IF_ERROR(WriteEngineCache(*trt_state, shape_ranges, *serialized_engine, profile_cache_path,
+                                             engine_cache_path, encrypted_engine_cache_path));
       }
 
       // serialize and save timing cache
-      if (trt_state->timing_cache_enable) {
+      if (trt_state->timing_cache_enable && !build_async) {
         auto timing_cache = trt_config->getTimingCache();
         std::unique_ptr<nvinfer1::IHostMemory> timingCacheHostData{timing_cache->serialize()};
         if (timingCacheHostData == nullptr) {
@@ -3643,6 +3727,29 @@ Status TensorrtExecutionProvider::CreateNodeComputeInfoFromGraph(const GraphView
           return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, status.ErrorMessage());
         }
       }
+
+#if NV_TENSORRT_MAJOR == 8 && NV_TENSORRT_MINOR > 5 || NV_TENSORRT_MAJOR > 8
+      if (build_async) {
+        trt_config->setBuilderOptimizationLevel(trt_state->builder_optimization_level);
+        std::shared_ptr<nvinfer1::IBuilderConfig> config{std::move(trt_config)};
+        std::shared_ptr<nvinfer1::ITimingCache> config_timing_cache{std::move(timing_cache)};
+        nvinfer1::INetworkDefinition* network = trt_state->network->get();
+        trt_state->pending_engine_build = std::async(
+            std::launch::async,
+            [this, trt_builder, network, config, config_timing_cache, shape_ranges = ShapeRangesMap(shape_ranges)]() mutable {
+              TensorrtAsyncEngineBuild engine_build;
+              engine_build.shape_ranges = std::move(shape_ranges);
+              auto lock = GetApiLock();
+              engine_build.serialized_engine.reset(trt_builder->buildSerializedNetwork(*network, *config));
+              if (config_timing_cache != nullptr) {
+                engine_build.serialized_timing_cache.reset(config_timing_cache->serialize());
+              }
+              return engine_build;
+            });
+        LOGS_DEFAULT(INFO) << "[TensorRT EP] Building the engine for " << trt_state->trt_node_name_with_precision
+                           << " in the background, the engine built with optimization level 0 runs meanwhile.";
+      }
+#endif
     }
 
     if (context_update) {
@@ -3,6 +3,7 @@
 
 #pragma once
 #include <ctime>
+#include <future>
 #ifndef USE_CUDA_MINIMAL
 #include <cudnn.h>
 #else
@@ -155,6 +156,13 @@ class OutputAllocator : public nvinfer1::IOutputAllocator {
  */
 using ShapeRangesMap = std::unordered_map<std::string, std::unordered_map<size_t, std::vector<std::vector<int64_t>>>>;
 
+// Result of an engine build on a background thread, see trt_async_engine_build.
+struct TensorrtAsyncEngineBuild {
+  std::unique_ptr<nvinfer1::IHostMemory> serialized_engine;  // nullptr if the build failed
+  std::unique_ptr<nvinfer1::IHostMemory> serialized_timing_cache;
+  ShapeRangesMap shape_ranges;  // the profile shape ranges that the engine is built with
+};
+
 // Information to construct kernel function state.
 struct TensorrtFuncState {
   AllocateFunc test_allocate_func = nullptr;
@@ -201,6 +209,10 @@ struct TensorrtFuncState {
   std::string cache_prefix;
   std::string cache_suffix;
   bool engine_hw_compatible = false;
+  bool async_engine_build = false;
+  // Engine being built in the background with the configured builder optimization level, while the engine built
+  // with optimization level 0 runs.
+  std::future<TensorrtAsyncEngineBuild> pending_engine_build;
 };
 
 // Minimum information to construct kernel function state for direct engine load code path
@@ -329,6 +341,7 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   bool cuda_graph_enable_ = false;
   std::string cache_prefix_;
   bool engine_hw_compatible_ = false;
+  bool async_engine_build_ = false;
 
   // The OrtAllocator object will be get during ep compute time
   // and should be kept for the lifetime of TRT EP object.
@@ -116,6 +116,7 @@ struct Tensorrt_Provider : Provider {
     info.ep_context_embed_mode = options.trt_ep_context_embed_mode;
     info.engine_cache_prefix = options.trt_engine_cache_prefix == nullptr ? "" : options.trt_engine_cache_prefix;
     info.engine_hw_compatible = options.trt_engine_hw_compatible != 0;
+    info.async_engine_build = options.trt_async_engine_build != 0;
 
     return std::make_shared<TensorrtProviderFactory>(info);
   }
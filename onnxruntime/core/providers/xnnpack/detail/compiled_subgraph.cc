@@ -0,0 +1,503 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/xnnpack/detail/compiled_subgraph.h"
+
+#include <cstring>
+#include <limits>
+#include <string>
+#include <unordered_map>
+
+#include "core/common/narrow.h"
+#include "core/framework/op_kernel.h"
+#include "core/framework/op_node_proto_helper.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/constants.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/providers/common.h"
+#include "core/providers/cpu/nn/pool_attributes.h"
+#include "core/providers/xnnpack/detail/utils.h"
+#include "core/session/onnxruntime_cxx_api.h"
+
+namespace onnxruntime {
+namespace xnnpack {
+
+namespace {
+
+struct SubgraphDeleter {
+  void operator()(xnn_subgraph_t p) const {
+    if (p != nullptr) {
+      xnn_delete_subgraph(p);
+    }
+  }
+};
+
+// float tensor with all dims known. zero sized dims are not supported.
+bool IsStaticFloatTensor(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  if (type == nullptr || !type->has_tensor_type() ||
+      type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+    return false;
+  }
+
+  const auto* shape = arg.Shape();
+  if (shape == nullptr || shape->dim_size() == 0) {
+    return false;
+  }
+
+  for (const auto& dim : shape->dim()) {
+    if (!dim.has_dim_value() || dim.dim_value() <= 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::vector<int64_t> GetStaticShape(const NodeArg& arg) {
+  std::vector<int64_t> dims;
+  for (const auto& dim : arg.Shape()->dim()) {
+    dims.push_back(dim.dim_value());
+  }
+
+  return dims;
+}
+
+Status ReadConstantFloats(const GraphViewer& graph, const std::string& name, std::vector<float>& values,
+                          std::vector<int64_t>* dims = nullptr) {
+  const auto* tensor = graph.GetConstantInitializer(name, true);
+  ORT_RETURN_IF(tensor == nullptr, "'", name, "' is not a constant initializer.");
+  ORT_RETURN_IF_NOT(tensor->data_type() == ONNX_NAMESPACE::TensorProto_DataType_FLOAT,
+                    "'", name, "' is not a float initializer.");
+
+  std::vector<uint8_t> unpacked;
+  ORT_RETURN_IF_ERROR(utils::UnpackInitializerData(*tensor, graph.ModelPath(), unpacked));
+  values.resize(unpacked.size() / sizeof(float));
+  std::memcpy(values.data(), unpacked.data(), values.size() * sizeof(float));
+
+  if (dims != nullptr) {
+    dims->assign(tensor->dims().begin(), tensor->dims().end());
+  }
+
+  return Status::OK();
+}
+
+// Clip has min/max as attributes prior to opset 11, and as optional constant inputs from opset 11 on.
+Status GetClipRange(const Node& node, const GraphViewer& graph, float& min, float& max) {
+  min = std::numeric_limits<float>::lowest();
+  max = std::numeric_limits<float>::max();
+
+  if (node.OpType() == "Relu") {
+    min = 0.f;
+    return Status::OK();
+  }
+
+  if (node.SinceVersion() < 11) {
+    ProtoHelperNodeContext nc(node);
+    OpNodeProtoHelper info(&nc);
+    min = info.GetAttrOrDefault<float>("min", min);
+    max = info.GetAttrOrDefault<float>("max", max);
+    return Status::OK();
+  }
+
+  const auto& input_defs = node.InputDefs();
+  for (size_t i = 1; i < input_defs.size() && i < 3; ++i) {
+    if (!input_defs[i]->Exists()) {
+      continue;
+    }
+
+    std::vector<float> value;
+    ORT_RETURN_IF_ERROR(ReadConstantFloats(graph, input_defs[i]->Name(), value));
+    ORT_RETURN_IF_NOT(value.size() == 1, "Clip ", i == 1 ? "min" : "max", " must be a scalar.");
+    (i == 1 ? min : max) = value[0];
+  }
+
+  return Status::OK();
+}
+
+struct Window2DAttributes {
+  uint32_t pad_top{0};
+  uint32_t pad_right{0};
+  uint32_t pad_bottom{0};
+  uint32_t pad_left{0};
+  uint32_t kernel_height{0};
+  uint32_t kernel_width{0};
+  uint32_t stride_height{1};
+  uint32_t stride_width{1};
+  uint32_t dilation_height{1};
+  uint32_t dilation_width{1};
+  uint32_t groups{1};
+  uint32_t flags{0};
+};
+
+// `pads` is in the ONNX order of {top, left, bottom, right}.
+bool SetPadsAndFlags(AutoPadType auto_pad, gsl::span<const int64_t> pads, Window2DAttributes& attrs) {
+  if (!IsPaddingTypeSupported(auto_pad)) {
+    return false;
+  }
+
+  if (auto_pad == AutoPadType::SAME_UPPER) {
+    // SAME_UPPER matches TensorFlow SAME padding. XNNPACK requires the explicit padding to be zero in this case.
+    attrs.flags |= XNN_FLAG_TENSORFLOW_SAME_PADDING;
+  } else if (auto_pad == AutoPadType::NOTSET) {
+    if (pads.size() != 4) {
+      return false;
+    }
+
+    attrs.pad_top = narrow<uint32_t>(pads[0]);
+    attrs.pad_left = narrow<uint32_t>(pads[1]);
+    attrs.pad_bottom = narrow<uint32_t>(pads[2]);
+    attrs.pad_right = narrow<uint32_t>(pads[3]);
+  }
+
+  return true;
+}
+
+// the weight of the NHWC Conv is still in the ONNX layout of {M, C/group, kH, kW}
+bool GetConv2DAttributes(const Node& node, gsl::span<const int64_t> weight_dims, Window2DAttributes& attrs) {
+  if (weight_dims.size() != 4) {
+    return false;
+  }
+
+  ProtoHelperNodeContext nc(node);
+  OpNodeProtoHelper info(&nc);
+
+  const auto kernel_shape = info.GetAttrsOrDefault<int64_t>("kernel_shape", {weight_dims[2], weight_dims[3]});
+  const auto pads = info.GetAttrsOrDefault<int64_t>("pads", std::vector<int64_t>(4, 0));
+  const auto strides = info.GetAttrsOrDefault<int64_t>("strides", {1, 1});
+  const auto dilations = info.GetAttrsOrDefault<int64_t>("dilations", {1, 1});
+  const auto group = info.GetAttrOrDefault<int64_t>("group", 1);
+  const auto auto_pad = StringToAutoPadType(info.GetAttrOrDefault<std::string>("auto_pad", "NOTSET"));
+
+  if (kernel_shape.size() != 2 || kernel_shape[0] != weight_dims[2] || kernel_shape[1] != weight_dims[3] ||
+      strides.size() != 2 || dilations.size() != 2 || group < 1 || weight_dims[0] % group != 0) {
+    return false;
+  }
+
+  if (!SetPadsAndFlags(auto_pad, pads, attrs)) {
+    return false;
+  }
+
+  attrs.kernel_height = narrow<uint32_t>(kernel_shape[0]);
+  attrs.kernel_width = narrow<uint32_t>(kernel_shape[1]);
+  attrs.stride_height = narrow<uint32_t>(strides[0]);
+  attrs.stride_width = narrow<uint32_t>(strides[1]);
+  attrs.dilation_height = narrow<uint32_t>(dilations[0]);
+  attrs.dilation_width = narrow<uint32_t>(dilations[1]);
+  attrs.groups = narrow<uint32_t>(group);
+  return true;
+}
+
+bool GetPool2DAttributes(const Node& node, Window2DAttributes& attrs) {
+  ProtoHelperNodeContext nc(node);
+  OpNodeProtoHelper info(&nc);
+  PoolAttributes pool_attrs(info, node.OpType(), node.SinceVersion());
+
+  if (pool_attrs.kernel_shape.size() != 2 || pool_attrs.ceil_mode != 0 || pool_attrs.storage_order != 0) {
+    return false;
+  }
+
+  if (node.OpType() == "MaxPool") {
+    // XNNPACK doesn't support 1x1 max pooling
+    if (pool_attrs.kernel_shape[0] == 1 && pool_attrs.kernel_shape[1] == 1) {
+      return false;
+    }
+  } else if (pool_attrs.count_include_pad || !pool_attrs.default_dilations) {
+    // XNNPACK average pooling excludes the padding from the count and doesn't support dilations
+    return false;
+  }
+
+  if (!SetPadsAndFlags(pool_attrs.auto_pad, pool_attrs.pads, attrs)) {
+    return false;
+  }
+
+  attrs.kernel_height = narrow<uint32_t>(pool_attrs.kernel_shape[0]);
+  attrs.kernel_width = narrow<uint32_t>(pool_attrs.kernel_shape[1]);
+  attrs.stride_height = narrow<uint32_t>(pool_attrs.strides[0]);
+  attrs.stride_width = narrow<uint32_t>(pool_attrs.strides[1]);
+  attrs.dilation_height = narrow<uint32_t>(pool_attrs.dilations[0]);
+  attrs.dilation_width = narrow<uint32_t>(pool_attrs.dilations[1]);
+  return true;
+}
+
+bool IsSoftmaxOnLastAxis(const Node& node, size_t rank) {
+  ProtoHelperNodeContext nc(node);
+  OpNodeProtoHelper info(&nc);
+  // opset 13 changed the default axis from 1 to -1
+  const int64_t axis = info.GetAttrOrDefault<int64_t>("axis", node.SinceVersion() < 13 ? 1 : -1);
+  return HandleNegativeAxis(axis, static_cast<int64_t>(rank)) == static_cast<int64_t>(rank) - 1;
+}
+
+Status DefineTensor(xnn_subgraph_t subgraph, gsl::span<const int64_t> dims, const void* data,
+                    uint32_t external_id, uint32_t flags, uint32_t& id) {
+  std::vector<size_t> xnn_dims(dims.begin(), dims.end());
+  const xnn_status status = xnn_define_tensor_value(subgraph, xnn_datatype_fp32, xnn_dims.size(), xnn_dims.data(),
+                                                    data, external_id, flags, &id);
+  ORT_RETURN_IF_NOT(status == xnn_status_success, "xnn_define_tensor_value failed. Status:", status);
+  return Status::OK();
+}
+
+}  // namespace
+
+bool IsNodeSupportedInSubgraph(const Node& node, const GraphViewer& graph, const std::string& ep_type) {
+  const auto& input_defs = node.InputDefs();
+  const auto& output_defs = node.OutputDefs();
+  if (input_defs.empty() || output_defs.empty() ||
+      graph.IsConstantInitializer(input_defs[0]->Name(), true) ||
+      !IsStaticFloatTensor(*input_defs[0]) || !IsStaticFloatTensor(*output_defs[0])) {
+    return false;
+  }
+
+  // no optional outputs, e.g. the indices of MaxPool
+  for (size_t i = 1; i < output_defs.size(); ++i) {
+    if (output_defs[i]->Exists()) {
+      return false;
+    }
+  }
+
+  const auto& op_type = node.OpType();
+  const size_t rank = narrow<size_t>(input_defs[0]->Shape()->dim_size());
+
+  if (node.GetExecutionProviderType().empty()) {
+    // activations aren't claimed in the first call to GetCapability. take them if they consume the output of a node
+    // assigned to this EP so they can be fused with it by XNNPACK.
+    if (node.Domain() != kOnnxDomain || (op_type != "Relu" && op_type != "Clip")) {
+      return false;
+    }
+
+    const Node::EdgeEnd* input0_edge = graph_utils::GetInputEdge(node, 0);
+    if (input0_edge == nullptr || input0_edge->GetNode().GetExecutionProviderType() != ep_type) {
+      return false;
+    }
+
+    float min = 0.f;
+    float max = 0.f;
+    return GetClipRange(node, graph, min, max).IsOK() && min <= max;
+  }
+
+  if (node.GetExecutionProviderType() != ep_type) {
+    return false;
+  }
+
+  if (node.Domain() == kOnnxDomain && op_type == "Softmax") {
+    return IsSoftmaxOnLastAxis(node, rank);
+  }
+
+  if (node.Domain() != kMSInternalNHWCDomain || rank != 4) {
+    return false;
+  }
+
+  Window2DAttributes attrs;
+  if (op_type == "Conv") {
+    const auto* weight = input_defs.size() > 1 ? graph.GetConstantInitializer(input_defs[1]->Name(), true) : nullptr;
+    if (weight == nullptr || weight->data_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+      return false;
+    }
+
+    const std::vector<int64_t> weight_dims(weight->dims().begin(), weight->dims().end());
+    if (!GetConv2DAttributes(node, weight_dims, attrs) ||
+        input_defs[0]->Shape()->dim(3).dim_value() != weight_dims[1] * attrs.groups) {
+      return false;
+    }
+
+    return input_defs.size() < 3 || !input_defs[2]->Exists() ||
+           graph.GetConstantInitializer(input_defs[2]->Name(), true) != nullptr;
+  }
+
+  if (op_type == "MaxPool" || op_type == "AveragePool") {
+    return GetPool2DAttributes(node, attrs);
+  }
+
+  return false;
+}
+
+Status CompiledSubgraph::Create(const GraphViewer& graph, const Node& fused_node, pthreadpool* threadpool,
+                                std::unique_ptr<CompiledSubgraph>& compiled_subgraph) {
+  std::unique_ptr<CompiledSubgraph> compiled{new CompiledSubgraph()};
+
+  // constant initializers are copied in to the subgraph, all other inputs and outputs are external values
+  const auto& fused_inputs = fused_node.InputDefs();
+  const auto& fused_outputs = fused_node.OutputDefs();
+  for (size_t i = 0; i < fused_inputs.size(); ++i) {
+    if (!graph.IsConstantInitializer(fused_inputs[i]->Name(), true)) {
+      compiled->inputs_.push_back({i, GetStaticShape(*fused_inputs[i])});
+    }
+  }
+
+  for (size_t i = 0; i < fused_outputs.size(); ++i) {
+    compiled->outputs_.push_back({i, GetStaticShape(*fused_outputs[i])});
+  }
+
+  const auto num_external_values = narrow<uint32_t>(compiled->inputs_.size() + compiled->outputs_.size());
+  xnn_subgraph_t subgraph_ptr = nullptr;
+  xnn_status status = xnn_create_subgraph(num_external_values, 0, &subgraph_ptr);
+  ORT_RETURN_IF_NOT(status == xnn_status_success, "xnn_create_subgraph failed. Status:", status);
+  std::unique_ptr<xnn_subgraph, SubgraphDeleter> subgraph{subgraph_ptr};
+
+  std::unordered_map<std::string, uint32_t> value_ids;
+  uint32_t external_id = 0;
+  for (const auto& input : compiled->inputs_) {
+    uint32_t id = XNN_INVALID_VALUE_ID;
+    ORT_RETURN_IF_ERROR(DefineTensor(subgraph.get(), input.shape, nullptr, external_id++,
+                                     XNN_VALUE_FLAG_EXTERNAL_INPUT, id));
+    value_ids[fused_inputs[input.index]->Name()] = id;
+  }
+
+  for (const auto& output : compiled->outputs_) {
+    uint32_t id = XNN_INVALID_VALUE_ID;
+    ORT_RETURN_IF_ERROR(DefineTensor(subgraph.get(), output.shape, nullptr, external_id++,
+                                     XNN_VALUE_FLAG_EXTERNAL_OUTPUT, id));
+    value_ids[fused_outputs[output.index]->Name()] = id;
+  }
+
+  auto input_id = [&value_ids](const NodeArg& arg, uint32_t& id) -> Status {
+    const auto it = value_ids.find(arg.Name());
+    ORT_RETURN_IF(it == value_ids.end(), "'", arg.Name(), "' was not defined in the XNNPACK subgraph.");
+    id = it->second;
+    return Status::OK();
+  };
+
+  // outputs that are consumed within the group only are internal values that XNNPACK plans the memory for
+  auto output_id = [&value_ids, &subgraph](const NodeArg& arg, uint32_t& id) -> Status {
+    if (const auto it = value_ids.find(arg.Name()); it != value_ids.end()) {
+      id = it->second;
+      return Status::OK();
+    }
+
+    ORT_RETURN_IF_ERROR(DefineTensor(subgraph.get(), GetStaticShape(arg), nullptr, XNN_INVALID_VALUE_ID, 0, id));
+    value_ids[arg.Name()] = id;
+    return Status::OK();
+  };
+
+  constexpr float kNoMin = -std::numeric_limits<float>::infinity();
+  constexpr float kNoMax = std::numeric_limits<float>::infinity();
+
+  for (NodeIndex node_index : graph.GetNodesInTopologicalOrder()) {
+    const Node& node = *graph.GetNode(node_index);
+    const auto& input_defs = node.InputDefs();
+    const auto& op_type = node.OpType();
+
+    uint32_t x_id = XNN_INVALID_VALUE_ID;
+    uint32_t y_id = XNN_INVALID_VALUE_ID;
+    ORT_RETURN_IF_ERROR(input_id(*input_defs[0], x_id));
+    ORT_RETURN_IF_ERROR(output_id(*node.OutputDefs()[0], y_id));
+
+    Window2DAttributes attrs;
+    if (op_type == "Conv") {
+      std::vector<float> weight;
+      std::vector<int64_t> weight_dims;
+      ORT_RETURN_IF_ERROR(ReadConstantFloats(graph, input_defs[1]->Name(), weight, &weight_dims));
+      ORT_RETURN_IF_NOT(GetConv2DAttributes(node, weight_dims, attrs), "Unsupported Conv node ", node.Name());
+
+      // transpose the weight from {M, C/group, kH, kW} to {M, kH, kW, C/group}
+      const size_t M = narrow<size_t>(weight_dims[0]);
+      const size_t C = narrow<size_t>(weight_dims[1]);
+      const size_t kernel_size = size_t{attrs.kernel_height} * attrs.kernel_width;
+      std::vector<float>& ohwi = compiled->static_data_.emplace_back(weight.size());
+      for (size_t m = 0; m < M; ++m) {
+        for (size_t c = 0; c < C; ++c) {
+          for (size_t k = 0; k < kernel_size; ++k) {
+            ohwi[(m * kernel_size + k) * C + c] = weight[(m * C + c) * kernel_size + k];
+          }
+        }
+      }
+
+      const int64_t filter_dims[] = {weight_dims[0], weight_dims[2], weight_dims[3], weight_dims[1]};
+      uint32_t filter_id = XNN_INVALID_VALUE_ID;
+      ORT_RETURN_IF_ERROR(DefineTensor(subgraph.get(), filter_dims, ohwi.data(), XNN_INVALID_VALUE_ID, 0, filter_id));
+
+      uint32_t bias_id = XNN_INVALID_VALUE_ID;
+      if (input_defs.size() > 2 && input_defs[2]->Exists()) {
+        std::vector<float>& bias = compiled->static_data_.emplace_back();
+        ORT_RETURN_IF_ERROR(ReadConstantFloats(graph, input_defs[2]->Name(), bias));
+        const int64_t bias_dims[] = {static_cast<int64_t>(bias.size())};
+        ORT_RETURN_IF_ERROR(DefineTensor(subgraph.get(), bias_dims, bias.data(), XNN_INVALID_VALUE_ID, 0, bias_id));
+      }
+
+      status = xnn_define_convolution_2d(subgraph.get(), attrs.pad_top, attrs.pad_right, attrs.pad_bottom,
+                                         attrs.pad_left, attrs.kernel_height, attrs.kernel_width,
+                                         attrs.stride_height, attrs.stride_width,
+                                         attrs.dilation_height, attrs.dilation_width, attrs.groups,
+                                         C, M / attrs.groups, kNoMin, kNoMax,
+                                         x_id, filter_id, bias_id, y_id, attrs.flags);
+    } else if (op_type == "MaxPool") {
+      ORT_RETURN_IF_NOT(GetPool2DAttributes(node, attrs), "Unsupported MaxPool node ", node.Name());
+      status = xnn_define_max_pooling_2d(subgraph.get(), attrs.pad_top, attrs.pad_right, attrs.pad_bottom,
+                                         attrs.pad_left, attrs.kernel_height, attrs.kernel_width,
+                                         attrs.stride_height, attrs.stride_width,
+                                         attrs.dilation_height, attrs.dilation_width, kNoMin, kNoMax,
+                                         x_id, y_id, attrs.flags);
+    } else if (op_type == "AveragePool") {
+      ORT_RETURN_IF_NOT(GetPool2DAttributes(node, attrs), "Unsupported AveragePool node ", node.Name());
+      status = xnn_define_average_pooling_2d(subgraph.get(), attrs.pad_top, attrs.pad_right, attrs.pad_bottom,
+                                             attrs.pad_left, attrs.kernel_height, attrs.kernel_width,
+                                             attrs.stride_height, attrs.stride_width, kNoMin, kNoMax,
+                                             x_id, y_id, attrs.flags);
+    } else if (op_type == "Softmax") {
+      status = xnn_define_softmax(subgraph.get(), x_id, y_id, 0);
+    } else if (op_type == "Relu" || op_type == "Clip") {
+      float min = 0.f;
+      float max = 0.f;
+      ORT_RETURN_IF_ERROR(GetClipRange(node, graph, min, max));
+      status = xnn_define_clamp(subgraph.get(), min, max, x_id, y_id, 0);
+    } else {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unexpected ", op_type, " node in XNNPACK subgraph.");
+    }
+
+    ORT_RETURN_IF_NOT(status == xnn_status_success, "Failed to define ", op_type, " node ", node.Name(),
+                      " in XNNPACK subgraph. Status:", status);
+  }
+
+  // XNNPACK fuses the operators where possible and plans the memory of the internal values here
+  xnn_runtime_t runtime = nullptr;
+#ifdef XNNPACK_USE_ORT_THREADPOOL
+  compiled->ort_threadpool_ = std::make_unique<pthreadpool>(nullptr);
+  threadpool = compiled->ort_threadpool_.get();
+#endif
+  status = xnn_create_runtime_v2(subgraph.get(), threadpool, 0, &runtime);
+  ORT_RETURN_IF_NOT(status == xnn_status_success, "xnn_create_runtime_v2 failed. Status:", status);
+  compiled->runtime_.reset(runtime);
+
+  compiled->external_values_.resize(num_external_values);
+  for (uint32_t i = 0; i < num_external_values; ++i) {
+    compiled->external_values_[i].id = i;
+  }
+
+  compiled_subgraph = std::move(compiled);
+  return Status::OK();
+}
+
+Status CompiledSubgraph::Compute(OrtKernelContext* context) {
+  Ort::KernelContext ctx(context);
+  std::lock_guard<OrtMutex> lock(mutex_);
+
+#ifdef XNNPACK_USE_ORT_THREADPOOL
+  // the compute function is called with the OpKernelContext of the FunctionKernel
+  ort_threadpool_->thread_pool = reinterpret_cast<OpKernelContext*>(context)->GetOperatorThreadPool();
+#endif
+
+  for (size_t i = 0; i < inputs_.size(); ++i) {
+    const auto input = ctx.GetInput(inputs_[i].index);
+    ORT_RETURN_IF_NOT(input.GetTensorTypeAndShapeInfo().GetShape() == inputs_[i].shape,
+                      "Input ", inputs_[i].index, " does not have the shape the XNNPACK subgraph was compiled for.");
+    external_values_[i].data = const_cast<void*>(input.GetTensorRawData());
+  }
+
+  for (size_t i = 0; i < outputs_.size(); ++i) {
+    const auto& shape = outputs_[i].shape;
+    auto output = ctx.GetOutput(outputs_[i].index, shape.data(), shape.size());
+    external_values_[inputs_.size() + i].data = output.GetTensorMutableRawData();
+  }
+
+  xnn_status status = xnn_setup_runtime(runtime_.get(), external_values_.size(), external_values_.data());
+  ORT_RETURN_IF_NOT(status == xnn_status_success, "xnn_setup_runtime failed. Status:", status);
+
+  status = xnn_invoke_runtime(runtime_.get());
+  ORT_RETURN_IF_NOT(status == xnn_status_success, "xnn_invoke_runtime failed. Status:", status);
+
+  return Status::OK();
+}
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
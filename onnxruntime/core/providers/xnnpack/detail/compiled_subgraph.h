@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/ort_mutex.h"
+#include "core/providers/xnnpack/detail/ort_pthreadpool.h"
+#include "core/session/onnxruntime_c_api.h"
+
+#include "xnnpack.h"
+
+struct pthreadpool;
+
+namespace onnxruntime {
+class GraphViewer;
+class Node;
+
+namespace xnnpack {
+
+// Check if `node` can be defined in an xnn_subgraph by CompiledSubgraph.
+// This is only used in the second call to GetCapability, after the layout transformation, and is limited to float
+// operators with static shapes:
+//   - NHWC Conv, MaxPool and AveragePool that the first call already assigned to the XNNPACK EP
+//   - Softmax on the last axis that the first call already assigned to the XNNPACK EP
+//   - unassigned Relu and Clip (with constant min/max) that consume the output of a node assigned to the XNNPACK EP
+bool IsNodeSupportedInSubgraph(const Node& node, const GraphViewer& graph, const std::string& ep_type);
+
+// A group of nodes compiled into a single xnn_runtime.
+// XNNPACK does the memory planning of the intermediate values and fuses operators (e.g. Conv + Clip) itself,
+// so the nodes in the group don't round-trip through the ORT kernel dispatch and allocation planner.
+class CompiledSubgraph {
+ public:
+  // Define the nodes of `graph` in an xnn_subgraph and create the runtime for it.
+  // The inputs and outputs of `fused_node` are the external values of the runtime.
+  // `threadpool` is ignored with XNNPACK_USE_ORT_THREADPOOL. The runtime uses the intra-op thread pool of each Compute
+  // call instead.
+  static Status Create(const GraphViewer& graph, const Node& fused_node, pthreadpool* threadpool,
+                       std::unique_ptr<CompiledSubgraph>& compiled_subgraph);
+
+  Status Compute(OrtKernelContext* context);
+
+ private:
+  struct RuntimeDeleter {
+    void operator()(xnn_runtime_t p) const {
+      if (p != nullptr) {
+        xnn_delete_runtime(p);
+      }
+    }
+  };
+
+  // a runtime input or output and the index of the matching fused node input or output
+  struct ExternalValue {
+    size_t index;
+    std::vector<int64_t> shape;
+  };
+
+  CompiledSubgraph() = default;
+
+  // copies of the constant initializers in the layout XNNPACK expects. must outlive the runtime.
+  std::vector<std::vector<float>> static_data_;
+#ifdef XNNPACK_USE_ORT_THREADPOOL
+  // the runtime keeps a pointer to this, so it's created before and destroyed after runtime_
+  std::unique_ptr<pthreadpool> ort_threadpool_;
+#endif
+  std::unique_ptr<xnn_runtime, RuntimeDeleter> runtime_;
+  std::vector<ExternalValue> inputs_;
+  std::vector<ExternalValue> outputs_;
+  // external ids are assigned to inputs_ followed by outputs_
+  std::vector<xnn_external_value> external_values_;
+  OrtMutex mutex_;
+};
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
@@ -15,6 +15,7 @@
 #include "core/providers/xnnpack/detail/utils.h"
 
 // each operator provides a helper to check if supported
+#include "core/providers/xnnpack/math/binary_elementwise.h"
 #include "core/providers/xnnpack/math/gemm.h"
 #include "core/providers/xnnpack/math/matmul.h"
 #include "core/providers/xnnpack/math/softmax.h"
@@ -23,6 +24,7 @@
 #include "core/providers/xnnpack/nn/conv_transpose.h"
 #include "core/providers/xnnpack/nn/max_pool.h"
 #include "core/providers/xnnpack/tensor/resize.h"
+#include "core/providers/xnnpack/tensor/transpose.h"
 
 namespace onnxruntime {
 namespace xnnpack {
@@ -100,6 +102,11 @@ bool NodeSupportChecker::IsNodeSupported(const NodeUnit& nodeunit) {
       {"Resize", Resize::IsOnnxNodeSupported},
       {"Gemm", Gemm::IsOnnxNodeSupported},
       {"MatMul", MatMul::IsOnnxNodeSupported},
+      {"Add", BinaryElementwise::IsOnnxNodeSupported},
+      {"Sub", BinaryElementwise::IsOnnxNodeSupported},
+      {"Mul", BinaryElementwise::IsOnnxNodeSupported},
+      {"Div", BinaryElementwise::IsOnnxNodeSupported},
+      {"Transpose", Transpose::IsOnnxNodeSupported},
   };
 
   bool supported = false;
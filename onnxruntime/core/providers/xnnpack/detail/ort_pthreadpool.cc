@@ -0,0 +1,424 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#ifdef XNNPACK_USE_ORT_THREADPOOL
+
+#include "core/providers/xnnpack/detail/ort_pthreadpool.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "core/platform/threadpool.h"
+
+#include "pthreadpool.h"
+
+namespace onnxruntime {
+namespace xnnpack {
+namespace {
+
+using concurrency::ThreadPool;
+
+ThreadPool* GetOrtThreadPool(pthreadpool_t pool) {
+  return pool != nullptr ? pool->thread_pool : nullptr;
+}
+
+// Split [0, range) into at most DegreeOfParallelism(tp) contiguous blocks and call fn(thread_index, begin, end) for
+// each of them. The block index is used as the thread index, so it is always less than pthreadpool_get_threads_count.
+// Static partitioning matches what pthreadpool does before work stealing and keeps the per-call overhead at a single
+// ThreadPool dispatch.
+template <typename Fn>
+void ParallelizeRange(pthreadpool_t pool, size_t range, Fn&& fn) {
+  ThreadPool* tp = GetOrtThreadPool(pool);
+  const auto num_blocks = std::min<std::ptrdiff_t>(ThreadPool::DegreeOfParallelism(tp),
+                                                   static_cast<std::ptrdiff_t>(range));
+  if (num_blocks <= 1) {
+    fn(size_t{0}, size_t{0}, range);
+    return;
+  }
+
+  ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t block) {
+    const auto work = ThreadPool::PartitionWork(block, num_blocks, static_cast<std::ptrdiff_t>(range));
+    fn(static_cast<size_t>(block), static_cast<size_t>(work.start), static_cast<size_t>(work.end));
+  });
+}
+
+template <size_t N>
+using Index = std::array<size_t, N>;
+
+// Iterate over the tiles of an N-dimensional range in row-major order and call
+// fn(thread_index, start_of_tile, size_of_tile). Dimensions that the pthreadpool function does not tile have a tile
+// size of 1, so every pthreadpool_parallelize_* variant maps onto this.
+template <size_t N, typename Fn>
+void ParallelizeTiled(pthreadpool_t pool, const Index<N>& range, const Index<N>& tile, Fn&& fn) {
+  Index<N> tile_count;
+  size_t total = 1;
+  for (size_t d = 0; d < N; ++d) {
+    if (range[d] == 0) {
+      return;
+    }
+
+    tile_count[d] = (range[d] + tile[d] - 1) / tile[d];
+    total *= tile_count[d];
+  }
+
+  ParallelizeRange(pool, total, [&](size_t thread, size_t begin, size_t end) {
+    if (begin == end) {
+      return;
+    }
+
+    // decode the first tile and then increment the coordinates to avoid a division per tile
+    Index<N> coord;
+    size_t remainder = begin;
+    for (size_t d = N; d-- > 0;) {
+      coord[d] = remainder % tile_count[d];
+      remainder /= tile_count[d];
+    }
+
+    for (size_t linear = begin; linear < end; ++linear) {
+      Index<N> start;
+      Index<N> size;
+      for (size_t d = 0; d < N; ++d) {
+        start[d] = coord[d] * tile[d];
+        size[d] = std::min(tile[d], range[d] - start[d]);
+      }
+
+      fn(thread, start, size);
+
+      for (size_t d = N; d-- > 0;) {
+        if (++coord[d] < tile_count[d]) {
+          break;
+        }
+
+        coord[d] = 0;
+      }
+    }
+  });
+}
+
+// XNNPACK kernels only differ per microarchitecture on heterogeneous ARM cores where pthreadpool is built with
+// cpuinfo support. The ORT thread pool doesn't track which core a worker runs on, so the default is always used.
+uint32_t UarchIndex(uint32_t default_uarch_index) {
+  return default_uarch_index;
+}
+
+}  // namespace
+}  // namespace xnnpack
+}  // namespace onnxruntime
+
+using onnxruntime::concurrency::ThreadPool;
+using onnxruntime::xnnpack::Index;
+using onnxruntime::xnnpack::ParallelizeRange;
+using onnxruntime::xnnpack::ParallelizeTiled;
+using onnxruntime::xnnpack::UarchIndex;
+
+// The pthreadpool flags (PTHREADPOOL_FLAG_DISABLE_DENORMALS, PTHREADPOOL_FLAG_YIELD_WORKERS) are ignored.
+// Denormal handling and spinning of the ORT thread pool are controlled by the session options.
+
+pthreadpool_t pthreadpool_create(size_t /*threads_count*/) {
+  // the ORT thread pool is bound per kernel invocation by the XNNPACK EP
+  return new pthreadpool(nullptr);
+}
+
+size_t pthreadpool_get_threads_count(pthreadpool_t pool) {
+  return static_cast<size_t>(ThreadPool::DegreeOfParallelism(onnxruntime::xnnpack::GetOrtThreadPool(pool)));
+}
+
+void pthreadpool_destroy(pthreadpool_t pool) {
+  delete pool;
+}
+
+//
+// 1D
+//
+
+void pthreadpool_parallelize_1d(pthreadpool_t pool, pthreadpool_task_1d_t function, void* context,
+                                size_t range, uint32_t /*flags*/) {
+  ParallelizeRange(pool, range, [&](size_t /*thread*/, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      function(context, i);
+    }
+  });
+}
+
+void pthreadpool_parallelize_1d_with_thread(pthreadpool_t pool, pthreadpool_task_1d_with_thread_t function,
+                                            void* context, size_t range, uint32_t /*flags*/) {
+  ParallelizeRange(pool, range, [&](size_t thread, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      function(context, thread, i);
+    }
+  });
+}
+
+void pthreadpool_parallelize_1d_with_uarch(pthreadpool_t pool, pthreadpool_task_1d_with_id_t function,
+                                           void* context, uint32_t default_uarch_index,
+                                           uint32_t /*max_uarch_index*/, size_t range, uint32_t /*flags*/) {
+  const uint32_t uarch_index = UarchIndex(default_uarch_index);
+  ParallelizeRange(pool, range, [&](size_t /*thread*/, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      function(context, uarch_index, i);
+    }
+  });
+}
+
+void pthreadpool_parallelize_1d_tile_1d(pthreadpool_t pool, pthreadpool_task_1d_tile_1d_t function, void* context,
+                                        size_t range, size_t tile, uint32_t /*flags*/) {
+  ParallelizeTiled<1>(pool, {range}, {tile}, [&](size_t, const Index<1>& start, const Index<1>& size) {
+    function(context, start[0], size[0]);
+  });
+}
+
+//
+// 2D
+//
+
+void pthreadpool_parallelize_2d(pthreadpool_t pool, pthreadpool_task_2d_t function, void* context,
+                                size_t range_i, size_t range_j, uint32_t /*flags*/) {
+  ParallelizeTiled<2>(pool, {range_i, range_j}, {1, 1}, [&](size_t, const Index<2>& start, const Index<2>&) {
+    function(context, start[0], start[1]);
+  });
+}
+
+void pthreadpool_parallelize_2d_with_thread(pthreadpool_t pool, pthreadpool_task_2d_with_thread_t function,
+                                            void* context, size_t range_i, size_t range_j, uint32_t /*flags*/) {
+  ParallelizeTiled<2>(pool, {range_i, range_j}, {1, 1},
+                      [&](size_t thread, const Index<2>& start, const Index<2>&) {
+                        function(context, thread, start[0], start[1]);
+                      });
+}
+
+void pthreadpool_parallelize_2d_tile_1d(pthreadpool_t pool, pthreadpool_task_2d_tile_1d_t function, void* context,
+                                        size_t range_i, size_t range_j, size_t tile_j, uint32_t /*flags*/) {
+  ParallelizeTiled<2>(pool, {range_i, range_j}, {1, tile_j},
+                      [&](size_t, const Index<2>& start, const Index<2>& size) {
+                        function(context, start[0], start[1], size[1]);
+                      });
+}
+
+void pthreadpool_parallelize_2d_tile_1d_with_uarch(pthreadpool_t pool,
+                                                   pthreadpool_task_2d_tile_1d_with_id_t function, void* context,
+                                                   uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                                   size_t range_i, size_t range_j, size_t tile_j,
+                                                   uint32_t /*flags*/) {
+  const uint32_t uarch_index = UarchIndex(default_uarch_index);
+  ParallelizeTiled<2>(pool, {range_i, range_j}, {1, tile_j},
+                      [&](size_t, const Index<2>& start, const Index<2>& size) {
+                        function(context, uarch_index, start[0], start[1], size[1]);
+                      });
+}
+
+void pthreadpool_parallelize_2d_tile_1d_with_uarch_with_thread(
+    pthreadpool_t pool, pthreadpool_task_2d_tile_1d_with_id_with_thread_t function, void* context,
+    uint32_t default_uarch_index, uint32_t /*max_uarch_index*/, size_t range_i, size_t range_j, size_t tile_j,
+    uint32_t /*flags*/) {
+  const uint32_t uarch_index = UarchIndex(default_uarch_index);
+  ParallelizeTiled<2>(pool, {range_i, range_j}, {1, tile_j},
+                      [&](size_t thread, const Index<2>& start, const Index<2>& size) {
+                        function(context, uarch_index, thread, start[0], start[1], size[1]);
+                      });
+}
+
+void pthreadpool_parallelize_2d_tile_2d(pthreadpool_t pool, pthreadpool_task_2d_tile_2d_t function, void* context,
+                                        size_t range_i, size_t range_j, size_t tile_i, size_t tile_j,
+                                        uint32_t /*flags*/) {
+  ParallelizeTiled<2>(pool, {range_i, range_j}, {tile_i, tile_j},
+                      [&](size_t, const Index<2>& start, const Index<2>& size) {
+                        function(context, start[0], start[1], size[0], size[1]);
+                      });
+}
+
+void pthreadpool_parallelize_2d_tile_2d_with_uarch(pthreadpool_t pool,
+                                                   pthreadpool_task_2d_tile_2d_with_id_t function, void* context,
+                                                   uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                                   size_t range_i, size_t range_j, size_t tile_i, size_t tile_j,
+                                                   uint32_t /*flags*/) {
+  const uint32_t uarch_index = UarchIndex(default_uarch_index);
+  ParallelizeTiled<2>(pool, {range_i, range_j}, {tile_i, tile_j},
+                      [&](size_t, const Index<2>& start, const Index<2>& size) {
+                        function(context, uarch_index, start[0], start[1], size[0], size[1]);
+                      });
+}
+
+//
+// 3D
+//
+
+void pthreadpool_parallelize_3d(pthreadpool_t pool, pthreadpool_task_3d_t function, void* context,
+                                size_t range_i, size_t range_j, size_t range_k, uint32_t /*flags*/) {
+  ParallelizeTiled<3>(pool, {range_i, range_j, range_k}, {1, 1, 1},
+                      [&](size_t, const Index<3>& start, const Index<3>&) {
+                        function(context, start[0], start[1], start[2]);
+                      });
+}
+
+void pthreadpool_parallelize_3d_tile_1d(pthreadpool_t pool, pthreadpool_task_3d_tile_1d_t function, void* context,
+                                        size_t range_i, size_t range_j, size_t range_k, size_t tile_k,
+                                        uint32_t /*flags*/) {
+  ParallelizeTiled<3>(pool, {range_i, range_j, range_k}, {1, 1, tile_k},
+                      [&](size_t, const Index<3>& start, const Index<3>& size) {
+                        function(context, start[0], start[1], start[2], size[2]);
+                      });
+}
+
+void pthreadpool_parallelize_3d_tile_1d_with_thread(pthreadpool_t pool,
+                                                    pthreadpool_task_3d_tile_1d_with_thread_t function,
+                                                    void* context, size_t range_i, size_t range_j, size_t range_k,
+                                                    size_t tile_k, uint32_t /*flags*/) {
+  ParallelizeTiled<3>(pool, {range_i, range_j, range_k}, {1, 1, tile_k},
+                      [&](size_t thread, const Index<3>& start, const Index<3>& size) {
+                        function(context, thread, start[0], start[1], start[2], size[2]);
+                      });
+}
+
+void pthreadpool_parallelize_3d_tile_1d_with_uarch(pthreadpool_t pool,
+                                                   pthreadpool_task_3d_tile_1d_with_id_t function, void* context,
+                                                   uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                                   size_t range_i, size_t range_j, size_t range_k, size_t tile_k,
+                                                   uint32_t /*flags*/) {
+  const uint32_t uarch_index = UarchIndex(default_uarch_index);
+  ParallelizeTiled<3>(pool, {range_i, range_j, range_k}, {1, 1, tile_k},
+                      [&](size_t, const Index<3>& start, const Index<3>& size) {
+                        function(context, uarch_index, start[0], start[1], start[2], size[2]);
+                      });
+}
+
+void pthreadpool_parallelize_3d_tile_1d_with_uarch_with_thread(
+    pthreadpool_t pool, pthreadpool_task_3d_tile_1d_with_id_with_thread_t function, void* context,
+    uint32_t default_uarch_index, uint32_t /*max_uarch_index*/, size_t range_i, size_t range_j, size_t range_k,
+    size_t tile_k, uint32_t /*flags*/) {
+  const uint32_t uarch_index = UarchIndex(default_uarch_index);
+  ParallelizeTiled<3>(pool, {range_i, range_j, range_k}, {1, 1, tile_k},
+                      [&](size_t thread, const Index<3>& start, const Index<3>& size) {
+                        function(context, uarch_index, thread, start[0], start[1], start[2], size[2]);
+                      });
+}
+
+void pthreadpool_parallelize_3d_tile_2d(pthreadpool_t pool, pthreadpool_task_3d_tile_2d_t function, void* context,
+                                        size_t range_i, size_t range_j, size_t range_k, size_t tile_j,
+                                        size_t tile_k, uint32_t /*flags*/) {
+  ParallelizeTiled<3>(pool, {range_i, range_j, range_k}, {1, tile_j, tile_k},
+                      [&](size_t, const Index<3>& start, const Index<3>& size) {
+                        function(context, start[0], start[1], start[2], size[1], size[2]);
+                      });
+}
+
+void pthreadpool_parallelize_3d_tile_2d_with_uarch(pthreadpool_t pool,
+                                                   pthreadpool_task_3d_tile_2d_with_id_t function, void* context,
+                                                   uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                                   size_t range_i, size_t range_j, size_t range_k, size_t tile_j,
+                                                   size_t tile_k, uint32_t /*flags*/) {
+  const uint32_t uarch_index = UarchIndex(default_uarch_index);
+  ParallelizeTiled<3>(pool, {range_i, range_j, range_k}, {1, tile_j, tile_k},
+                      [&](size_t, const Index<3>& start, const Index<3>& size) {
+                        function(context, uarch_index, start[0], start[1], start[2], size[1], size[2]);
+                      });
+}
+
+//
+// 4D
+//
+
+void pthreadpool_parallelize_4d(pthreadpool_t pool, pthreadpool_task_4d_t function, void* context,
+                                size_t range_i, size_t range_j, size_t range_k, size_t range_l, uint32_t /*flags*/) {
+  ParallelizeTiled<4>(pool, {range_i, range_j, range_k, range_l}, {1, 1, 1, 1},
+                      [&](size_t, const Index<4>& start, const Index<4>&) {
+                        function(context, start[0], start[1], start[2], start[3]);
+                      });
+}
+
+void pthreadpool_parallelize_4d_tile_1d(pthreadpool_t pool, pthreadpool_task_4d_tile_1d_t function, void* context,
+                                        size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t tile_l, uint32_t /*flags*/) {
+  ParallelizeTiled<4>(pool, {range_i, range_j, range_k, range_l}, {1, 1, 1, tile_l},
+                      [&](size_t, const Index<4>& start, const Index<4>& size) {
+                        function(context, start[0], start[1], start[2], start[3], size[3]);
+                      });
+}
+
+void pthreadpool_parallelize_4d_tile_2d(pthreadpool_t pool, pthreadpool_task_4d_tile_2d_t function, void* context,
+                                        size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t tile_k, size_t tile_l, uint32_t /*flags*/) {
+  ParallelizeTiled<4>(pool, {range_i, range_j, range_k, range_l}, {1, 1, tile_k, tile_l},
+                      [&](size_t, const Index<4>& start, const Index<4>& size) {
+                        function(context, start[0], start[1], start[2], start[3], size[2], size[3]);
+                      });
+}
+
+void pthreadpool_parallelize_4d_tile_2d_with_uarch(pthreadpool_t pool,
+                                                   pthreadpool_task_4d_tile_2d_with_id_t function, void* context,
+                                                   uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                                   size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                                   size_t tile_k, size_t tile_l, uint32_t /*flags*/) {
+  const uint32_t uarch_index = UarchIndex(default_uarch_index);
+  ParallelizeTiled<4>(pool, {range_i, range_j, range_k, range_l}, {1, 1, tile_k, tile_l},
+                      [&](size_t, const Index<4>& start, const Index<4>& size) {
+                        function(context, uarch_index, start[0], start[1], start[2], start[3], size[2], size[3]);
+                      });
+}
+
+//
+// 5D
+//
+
+void pthreadpool_parallelize_5d(pthreadpool_t pool, pthreadpool_task_5d_t function, void* context,
+                                size_t range_i, size_t range_j, size_t range_k, size_t range_l, size_t range_m,
+                                uint32_t /*flags*/) {
+  ParallelizeTiled<5>(pool, {range_i, range_j, range_k, range_l, range_m}, {1, 1, 1, 1, 1},
+                      [&](size_t, const Index<5>& start, const Index<5>&) {
+                        function(context, start[0], start[1], start[2], start[3], start[4]);
+                      });
+}
+
+void pthreadpool_parallelize_5d_tile_1d(pthreadpool_t pool, pthreadpool_task_5d_tile_1d_t function, void* context,
+                                        size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t range_m, size_t tile_m, uint32_t /*flags*/) {
+  ParallelizeTiled<5>(pool, {range_i, range_j, range_k, range_l, range_m}, {1, 1, 1, 1, tile_m},
+                      [&](size_t, const Index<5>& start, const Index<5>& size) {
+                        function(context, start[0], start[1], start[2], start[3], start[4], size[4]);
+                      });
+}
+
+void pthreadpool_parallelize_5d_tile_2d(pthreadpool_t pool, pthreadpool_task_5d_tile_2d_t function, void* context,
+                                        size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t range_m, size_t tile_l, size_t tile_m, uint32_t /*flags*/) {
+  ParallelizeTiled<5>(pool, {range_i, range_j, range_k, range_l, range_m}, {1, 1, 1, tile_l, tile_m},
+                      [&](size_t, const Index<5>& start, const Index<5>& size) {
+                        function(context, start[0], start[1], start[2], start[3], start[4], size[3], size[4]);
+                      });
+}
+
+//
+// 6D
+//
+
+void pthreadpool_parallelize_6d(pthreadpool_t pool, pthreadpool_task_6d_t function, void* context,
+                                size_t range_i, size_t range_j, size_t range_k, size_t range_l, size_t range_m,
+                                size_t range_n, uint32_t /*flags*/) {
+  ParallelizeTiled<6>(pool, {range_i, range_j, range_k, range_l, range_m, range_n}, {1, 1, 1, 1, 1, 1},
+                      [&](size_t, const Index<6>& start, const Index<6>&) {
+                        function(context, start[0], start[1], start[2], start[3], start[4], start[5]);
+                      });
+}
+
+void pthreadpool_parallelize_6d_tile_1d(pthreadpool_t pool, pthreadpool_task_6d_tile_1d_t function, void* context,
+                                        size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t range_m, size_t range_n, size_t tile_n, uint32_t /*flags*/) {
+  ParallelizeTiled<6>(pool, {range_i, range_j, range_k, range_l, range_m, range_n}, {1, 1, 1, 1, 1, tile_n},
+                      [&](size_t, const Index<6>& start, const Index<6>& size) {
+                        function(context, start[0], start[1], start[2], start[3], start[4], start[5], size[5]);
+                      });
+}
+
+void pthreadpool_parallelize_6d_tile_2d(pthreadpool_t pool, pthreadpool_task_6d_tile_2d_t function, void* context,
+                                        size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t range_m, size_t range_n, size_t tile_m, size_t tile_n,
+                                        uint32_t /*flags*/) {
+  ParallelizeTiled<6>(pool, {range_i, range_j, range_k, range_l, range_m, range_n}, {1, 1, 1, 1, tile_m, tile_n},
+                      [&](size_t, const Index<6>& start, const Index<6>& size) {
+                        function(context, start[0], start[1], start[2], start[3], start[4], start[5],
+                                 size[4], size[5]);
+                      });
+}
+
+#endif  // XNNPACK_USE_ORT_THREADPOOL
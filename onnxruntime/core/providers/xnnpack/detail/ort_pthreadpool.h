@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+// When XNNPACK_USE_ORT_THREADPOOL is defined the build links ort_pthreadpool.cc instead of the upstream pthreadpool
+// library. The pthreadpool API that XNNPACK calls is then implemented on top of the ORT intra-op thread pool, so
+// XNNPACK and MLAS kernels share one set of worker threads and one spinning policy instead of oversubscribing the
+// cores with two pools.
+#ifdef XNNPACK_USE_ORT_THREADPOOL
+
+namespace onnxruntime {
+namespace concurrency {
+class ThreadPool;
+}  // namespace concurrency
+}  // namespace onnxruntime
+
+// Definition of the type that is opaque in pthreadpool.h.
+// `thread_pool` is not owned and is expected to be set to the thread pool of the current kernel invocation
+// (OpKernelContext::GetOperatorThreadPool()) before XNNPACK is called. nullptr runs everything on the calling thread.
+struct pthreadpool {
+  explicit pthreadpool(onnxruntime::concurrency::ThreadPool* tp) : thread_pool{tp} {}
+
+  onnxruntime::concurrency::ThreadPool* thread_pool;
+};
+
+#endif  // XNNPACK_USE_ORT_THREADPOOL
@@ -0,0 +1,156 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/xnnpack/math/binary_elementwise.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/framework/op_kernel.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+namespace xnnpack {
+
+namespace {
+// numpy-style broadcasting of the two input shapes
+Status ComputeBroadcastShape(const TensorShape& a_shape, const TensorShape& b_shape, TensorShapeVector& output_dims) {
+  const size_t a_rank = a_shape.NumDimensions();
+  const size_t b_rank = b_shape.NumDimensions();
+  const size_t rank = std::max(a_rank, b_rank);
+  output_dims.assign(rank, 1);
+  for (size_t i = 0; i < rank; ++i) {
+    const int64_t a_dim = i < rank - a_rank ? 1 : a_shape[i - (rank - a_rank)];
+    const int64_t b_dim = i < rank - b_rank ? 1 : b_shape[i - (rank - b_rank)];
+    ORT_RETURN_IF_NOT(a_dim == b_dim || a_dim == 1 || b_dim == 1,
+                      "Shapes ", a_shape, " and ", b_shape, " can't be broadcast.");
+    output_dims[i] = a_dim == 1 ? b_dim : a_dim;
+  }
+
+  return Status::OK();
+}
+}  // namespace
+
+bool BinaryElementwise::IsOnnxNodeSupported(const NodeUnit& node_unit, const GraphViewer& /*graph*/) {
+  bool supported = false;
+
+  // use do {} while(false) so it's easier to set a breakpoint on the return
+  do {
+    // QDQ node units would need to be fused to a quantized operator
+    if (node_unit.UnitType() != NodeUnit::Type::SingleNode) {
+      break;
+    }
+
+    const auto& inputs = node_unit.Inputs();
+    if (inputs.size() != 2) {
+      break;
+    }
+
+    // we only support float currently. xnnpack supports up to XNN_MAX_TENSOR_DIMS dims.
+    bool inputs_supported = true;
+    for (const auto& input : inputs) {
+      const auto* type = input.node_arg.TypeAsProto();
+      const auto* shape = input.node_arg.Shape();
+      if (type == nullptr || type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT ||
+          shape == nullptr || shape->dim_size() > XNN_MAX_TENSOR_DIMS) {
+        inputs_supported = false;
+      }
+    }
+
+    if (!inputs_supported) {
+      break;
+    }
+
+    supported = true;
+  } while (false);
+
+  return supported;
+}
+
+BinaryElementwise::BinaryElementwise(const OpKernelInfo& info) : XnnpackKernel{info} {
+  using CreateFn = xnn_status (*)(float, float, uint32_t, xnn_operator_t*);
+  CreateFn create_fn = nullptr;
+
+  const auto& op_type = info.node().OpType();
+  if (op_type == "Add") {
+    create_fn = xnn_create_add_nd_f32;
+    reshape_fn_ = xnn_reshape_add_nd_f32;
+    setup_fn_ = xnn_setup_add_nd_f32;
+  } else if (op_type == "Sub") {
+    create_fn = xnn_create_subtract_nd_f32;
+    reshape_fn_ = xnn_reshape_subtract_nd_f32;
+    setup_fn_ = xnn_setup_subtract_nd_f32;
+  } else if (op_type == "Mul") {
+    create_fn = xnn_create_multiply_nd_f32;
+    reshape_fn_ = xnn_reshape_multiply_nd_f32;
+    setup_fn_ = xnn_setup_multiply_nd_f32;
+  } else if (op_type == "Div") {
+    create_fn = xnn_create_divide_nd_f32;
+    reshape_fn_ = xnn_reshape_divide_nd_f32;
+    setup_fn_ = xnn_setup_divide_nd_f32;
+  } else {
+    ORT_THROW("Unsupported binary elementwise operator ", op_type);
+  }
+
+  struct xnn_operator* p = nullptr;
+  const xnn_status status = create_fn(-INFINITY, INFINITY, 0, &p);
+  ORT_ENFORCE(status == xnn_status_success, "xnn_create_", op_type, "_nd_f32 failed. Status:", status);
+  op0_.reset(p);
+}
+
+Status BinaryElementwise::Compute(OpKernelContext* ctx) const {
+  const Tensor& A = *ctx->Input<Tensor>(0);
+  const Tensor& B = *ctx->Input<Tensor>(1);
+
+  TensorShapeVector output_dims;
+  ORT_RETURN_IF_ERROR(ComputeBroadcastShape(A.Shape(), B.Shape(), output_dims));
+  Tensor* Y = ctx->Output(0, TensorShape(output_dims));
+
+  // edge case. one or more dims with value of 0. nothing to do
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  const auto a_dims = A.Shape().GetDims();
+  const auto b_dims = B.Shape().GetDims();
+  const InlinedVector<size_t, XNN_MAX_TENSOR_DIMS> a_shape(a_dims.begin(), a_dims.end());
+  const InlinedVector<size_t, XNN_MAX_TENSOR_DIMS> b_shape(b_dims.begin(), b_dims.end());
+
+  pthreadpool_t threadpool = GetThreadPool(ctx);
+  xnn_status status = reshape_fn_(op0_.get(), a_shape.size(), a_shape.data(), b_shape.size(), b_shape.data(),
+                                  threadpool);
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_reshape for ", Node().OpType(), " returned ", status);
+  }
+
+  status = setup_fn_(op0_.get(), A.Data<float>(), B.Data<float>(), Y->MutableData<float>());
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_setup for ", Node().OpType(), " returned ", status);
+  }
+
+  status = xnn_run_operator(op0_.get(), threadpool);
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_run_operator returned ", status);
+  }
+
+  return Status::OK();
+}
+
+#define REGISTER_BINARY_ELEMENTWISE_KERNELS(Op)                                                                   \
+  ONNX_OPERATOR_VERSIONED_KERNEL_EX(Op, kOnnxDomain, 7, 12, kXnnpackExecutionProvider,                         \
+                                    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()), \
+                                    BinaryElementwise);                                                           \
+  ONNX_OPERATOR_VERSIONED_KERNEL_EX(Op, kOnnxDomain, 13, 13, kXnnpackExecutionProvider,                        \
+                                    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()), \
+                                    BinaryElementwise);                                                           \
+  ONNX_OPERATOR_KERNEL_EX(Op, kOnnxDomain, 14, kXnnpackExecutionProvider,                                         \
+                          KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),           \
+                          BinaryElementwise);
+
+REGISTER_BINARY_ELEMENTWISE_KERNELS(Add)
+REGISTER_BINARY_ELEMENTWISE_KERNELS(Sub)
+REGISTER_BINARY_ELEMENTWISE_KERNELS(Mul)
+REGISTER_BINARY_ELEMENTWISE_KERNELS(Div)
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/xnnpack/xnnpack_kernel.h"
+#include "core/providers/xnnpack/detail/utils.h"
+
+namespace onnxruntime {
+class GraphViewer;
+namespace xnnpack {
+
+// Add, Sub, Mul and Div with multidirectional (numpy-style) broadcasting.
+class BinaryElementwise final : public XnnpackKernel {
+ public:
+  BinaryElementwise(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* ctx) const override;
+  static bool IsOnnxNodeSupported(const NodeUnit& node_unit, const GraphViewer& graph);
+
+ private:
+  using ReshapeFn = xnn_status (*)(xnn_operator_t, size_t, const size_t*, size_t, const size_t*, pthreadpool_t);
+  using SetupFn = xnn_status (*)(xnn_operator_t, const float*, const float*, float*);
+
+  ReshapeFn reshape_fn_{nullptr};
+  SetupFn setup_fn_{nullptr};
+  XnnpackOperator op0_;
+};
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
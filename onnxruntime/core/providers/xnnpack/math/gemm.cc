@@ -160,7 +160,7 @@ Status Gemm::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr,
 }
 
 Status Gemm::Compute(OpKernelContext* context) const {
-  pthreadpool_t threadpool = GetThreadPool();
+  pthreadpool_t threadpool = GetThreadPool(context);
   const auto* A = context->Input<Tensor>(0);
   auto Y = context->Output(0, {M_, N_});
 
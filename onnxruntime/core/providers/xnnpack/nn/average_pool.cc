@@ -233,7 +233,7 @@ Status AveragePool::Compute(OpKernelContext* context) const {
     return Status::OK();
   }
 
-  pthreadpool_t threadpool = GetThreadPool();
+  pthreadpool_t threadpool = GetThreadPool(context);
 
   // setup allocator/automated dellocate for workspace
   size_t workspace_size = 0;
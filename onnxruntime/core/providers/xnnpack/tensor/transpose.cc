@@ -0,0 +1,110 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/xnnpack/tensor/transpose.h"
+
+#include "core/framework/op_kernel.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+namespace xnnpack {
+
+bool Transpose::IsOnnxNodeSupported(const NodeUnit& node_unit, const GraphViewer& /*graph*/) {
+  bool supported = false;
+
+  // use do {} while(false) so it's easier to set a breakpoint on the return
+  do {
+    // a QDQ Transpose has its DQ/Q dropped by the QDQ optimizers, so only handle the plain node
+    if (node_unit.UnitType() != NodeUnit::Type::SingleNode) {
+      break;
+    }
+
+    const auto& x_arg = node_unit.Inputs()[0].node_arg;
+    const auto* x_type = x_arg.TypeAsProto();
+    if (x_type == nullptr ||
+        (x_type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT &&
+         x_type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_UINT8 &&
+         x_type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_INT8)) {
+      break;
+    }
+
+    // the rank must be known as xnnpack supports up to XNN_MAX_TENSOR_DIMS dims
+    const auto* x_shape = x_arg.Shape();
+    if (!x_shape || x_shape->dim_size() == 0 || x_shape->dim_size() > XNN_MAX_TENSOR_DIMS) {
+      break;
+    }
+
+    supported = true;
+  } while (false);
+
+  return supported;
+}
+
+Transpose::Transpose(const OpKernelInfo& info) : TransposeBase{info}, XnnpackKernel{info} {
+  int32_t x_dtype = 0;
+  ORT_ENFORCE(GetType(*info.node().InputDefs()[0], x_dtype));
+  element_size_ = x_dtype == ONNX_NAMESPACE::TensorProto_DataType_FLOAT ? 4 : 1;
+
+  struct xnn_operator* p = nullptr;
+  const xnn_status status = element_size_ == 4 ? xnn_create_transpose_nd_x32(0, &p)
+                                               : xnn_create_transpose_nd_x8(0, &p);
+  ORT_ENFORCE(status == xnn_status_success, "xnn_create_transpose_nd_x", element_size_ * 8,
+              " failed. Status:", status);
+  op0_.reset(p);
+}
+
+Status Transpose::Compute(OpKernelContext* ctx) const {
+  const Tensor& X = *ctx->Input<Tensor>(0);
+
+  TensorShapeVector output_dims;
+  InlinedVector<size_t> default_perm;
+  const InlinedVector<size_t>* p_perm = nullptr;
+  ORT_RETURN_IF_ERROR(ComputeOutputShape(X, output_dims, default_perm, p_perm));
+  Tensor& Y = *ctx->Output(0, TensorShape(output_dims));
+
+  // edge case. one or more dims with value of 0. nothing to do
+  if (X.Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  const auto x_dims = X.Shape().GetDims();
+  const InlinedVector<size_t, XNN_MAX_TENSOR_DIMS> x_shape(x_dims.begin(), x_dims.end());
+  ORT_RETURN_IF(x_shape.size() > XNN_MAX_TENSOR_DIMS, "Transpose of rank ", x_shape.size(), " is not supported.");
+
+  pthreadpool_t threadpool = GetThreadPool(ctx);
+  auto reshape_fn = element_size_ == 4 ? xnn_reshape_transpose_nd_x32 : xnn_reshape_transpose_nd_x8;
+  xnn_status status = reshape_fn(op0_.get(), x_shape.size(), x_shape.data(), p_perm->data(), threadpool);
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_reshape_transpose_nd_x", element_size_ * 8, " returned ", status);
+  }
+
+  auto setup_fn = element_size_ == 4 ? xnn_setup_transpose_nd_x32 : xnn_setup_transpose_nd_x8;
+  status = setup_fn(op0_.get(), X.DataRaw(), Y.MutableDataRaw());
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_setup_transpose_nd_x", element_size_ * 8, " returned ", status);
+  }
+
+  status = xnn_run_operator(op0_.get(), threadpool);
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_run_operator returned ", status);
+  }
+
+  return Status::OK();
+}
+
+#define TRANSPOSE_TYPE_CONSTRAINTS                                                                   \
+  KernelDefBuilder().TypeConstraint("T", std::vector<MLDataType>{DataTypeImpl::GetTensorType<float>(),   \
+                                                                 DataTypeImpl::GetTensorType<uint8_t>(), \
+                                                                 DataTypeImpl::GetTensorType<int8_t>()})
+
+ONNX_OPERATOR_VERSIONED_KERNEL_EX(Transpose, kOnnxDomain, 1, 12, kXnnpackExecutionProvider,
+                                  TRANSPOSE_TYPE_CONSTRAINTS, Transpose);
+
+ONNX_OPERATOR_VERSIONED_KERNEL_EX(Transpose, kOnnxDomain, 13, 20, kXnnpackExecutionProvider,
+                                  TRANSPOSE_TYPE_CONSTRAINTS, Transpose);
+
+ONNX_OPERATOR_KERNEL_EX(Transpose, kOnnxDomain, 21, kXnnpackExecutionProvider,
+                        TRANSPOSE_TYPE_CONSTRAINTS, Transpose);
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
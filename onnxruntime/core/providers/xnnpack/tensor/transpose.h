@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/xnnpack/xnnpack_kernel.h"
+#include "core/providers/cpu/tensor/transpose.h"
+#include "core/providers/xnnpack/detail/utils.h"
+
+namespace onnxruntime {
+class GraphViewer;
+class NodeUnit;
+namespace xnnpack {
+
+class Transpose final : public TransposeBase, public XnnpackKernel {
+ public:
+  explicit Transpose(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* ctx) const override;
+
+  static bool IsOnnxNodeSupported(const NodeUnit& node_unit, const GraphViewer& graph);
+
+ private:
+  // xnnpack transposes are by element size. 1 for int8/uint8, 4 for float.
+  size_t element_size_;
+  XnnpackOperator op0_;
+};
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
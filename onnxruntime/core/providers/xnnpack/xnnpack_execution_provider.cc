@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <string>
 #include <string_view>
 #include <unordered_map>
 #include <unordered_set>
@@ -13,7 +14,9 @@
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/optimizer/qdq_transformer/selectors_actions/qdq_selectors.h"
 #include "core/optimizer/qdq_transformer/selectors_actions/shared/utils.h"
+#include "core/providers/partitioning_utils.h"
 #include "core/providers/xnnpack/xnnpack_execution_provider.h"
+#include "core/providers/xnnpack/detail/compiled_subgraph.h"
 #include "core/providers/xnnpack/detail/utils.h"
 #include "core/providers/xnnpack/detail/node_support_checker.h"
 #include "core/providers/xnnpack/xnnpack_init.h"
@@ -70,6 +73,19 @@ class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kMSIn
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kMSInternalNHWCDomain, 12, MaxPool);
 
 // ONNX operators
+class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 7, 12, Add);
+class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 13, 13, Add);
+class ONNX_OPERATOR_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 14, Add);
+class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 7, 12, Sub);
+class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 13, 13, Sub);
+class ONNX_OPERATOR_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 14, Sub);
+class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 7, 12, Mul);
+class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 13, 13, Mul);
+class ONNX_OPERATOR_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 14, Mul);
+class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 7, 12, Div);
+class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 13, 13, Div);
+class ONNX_OPERATOR_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 14, Div);
+
 class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 7, 8, Gemm);
 class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 9, 10, Gemm);
 class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 11, 12, Gemm);
@@ -83,6 +99,10 @@ class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnx
 class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 11, 12, Softmax);
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 13, Softmax);
 
+class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 1, 12, Transpose);
+class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 13, 20, Transpose);
+class ONNX_OPERATOR_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 21, Transpose);
+
 // Internal domain
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kDynamicDomainByCreate, 1, QLinearSoftmax);
 
@@ -131,6 +151,23 @@ std::unique_ptr<KernelRegistry> RegisterKernels() {
       KERNEL_CREATE_INFO_VERSIONED(9, 12, MatMul, kOnnxDomain),
       KERNEL_CREATE_INFO(13, MatMul, kOnnxDomain),
 
+      KERNEL_CREATE_INFO_VERSIONED(7, 12, Add, kOnnxDomain),
+      KERNEL_CREATE_INFO_VERSIONED(13, 13, Add, kOnnxDomain),
+      KERNEL_CREATE_INFO(14, Add, kOnnxDomain),
+      KERNEL_CREATE_INFO_VERSIONED(7, 12, Sub, kOnnxDomain),
+      KERNEL_CREATE_INFO_VERSIONED(13, 13, Sub, kOnnxDomain),
+      KERNEL_CREATE_INFO(14, Sub, kOnnxDomain),
+      KERNEL_CREATE_INFO_VERSIONED(7, 12, Mul, kOnnxDomain),
+      KERNEL_CREATE_INFO_VERSIONED(13, 13, Mul, kOnnxDomain),
+      KERNEL_CREATE_INFO(14, Mul, kOnnxDomain),
+      KERNEL_CREATE_INFO_VERSIONED(7, 12, Div, kOnnxDomain),
+      KERNEL_CREATE_INFO_VERSIONED(13, 13, Div, kOnnxDomain),
+      KERNEL_CREATE_INFO(14, Div, kOnnxDomain),
+
+      KERNEL_CREATE_INFO_VERSIONED(1, 12, Transpose, kOnnxDomain),
+      KERNEL_CREATE_INFO_VERSIONED(13, 20, Transpose, kOnnxDomain),
+      KERNEL_CREATE_INFO(21, Transpose, kOnnxDomain),
+
       //  quantization op
       KERNEL_CREATE_INFO(1, QLinearAveragePool, kMSInternalNHWCDomain),
 
@@ -155,7 +192,12 @@ std::unique_ptr<KernelRegistry> RegisterKernels() {
 using namespace xnnpack;
 
 XnnpackExecutionProvider::XnnpackExecutionProvider(const XnnpackExecutionProviderInfo& info)
-    : IExecutionProvider{kXnnpackExecutionProvider} {
+    : IExecutionProvider{kXnnpackExecutionProvider},
+      enable_subgraph_compile_{info.enable_subgraph_compile} {
+#ifdef XNNPACK_USE_ORT_THREADPOOL
+  // XNNPACK runs on the ORT intra-op thread pool via the pthreadpool adapter, so there's no private pool to create
+  // and no contention between two pools.
+#else
   int xnn_thread_pool_size = info.xnn_thread_pool_size;
   int ort_thread_pool_size = info.session_options ? info.session_options->intra_op_param.thread_pool_size : 1;
   bool allow_intra_op_spinning = (info.session_options == nullptr) ||
@@ -179,6 +221,7 @@ XnnpackExecutionProvider::XnnpackExecutionProvider(const XnnpackExecutionProvide
     // pthreadpool is independent of ort-threadpoool, so we had better disable cpu spinning for ort-threadpool.
     xnnpack_thread_pool_ = pthreadpool_create(static_cast<size_t>(xnn_thread_pool_size));
   }
+#endif
 }
 
 std::vector<AllocatorPtr> XnnpackExecutionProvider::CreatePreferredAllocators() {
@@ -270,13 +313,26 @@ std::vector<std::unique_ptr<ComputeCapability>> XnnpackExecutionProvider::GetCap
   std::unordered_map<const Node*, const NodeUnit*> node_unit_map;
   std::tie(node_unit_holder, node_unit_map) = QDQ::GetAllNodeUnits(graph);
 
+  // nodes in a compiled subgraph are not handled individually below
+  std::unordered_set<const Node*> compiled_nodes;
+  if (enable_subgraph_compile_) {
+#if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+    capabilities = GetCompiledSubgraphCapabilities(graph, node_unit_map);
+    for (const auto& capability : capabilities) {
+      for (NodeIndex node_index : capability->sub_graph->nodes) {
+        compiled_nodes.insert(graph.GetNode(node_index));
+      }
+    }
+#endif
+  }
+
   // This holds the result of whether a NodeUnit is supported or not,
   // to prevent nodes in a NodeUnit being checked for multiple times
   std::unordered_map<const NodeUnit*, bool> node_unit_supported_result;
   node_unit_supported_result.reserve(node_unit_holder.size());
   for (NodeIndex idx : graph.GetNodesInTopologicalOrder()) {
     const Node* n = graph.GetNode(idx);
-    if (n == nullptr) {
+    if (n == nullptr || compiled_nodes.count(n) > 0) {
       continue;
     }
     // if node is part of a QDQ group,
@@ -342,12 +398,68 @@ std::vector<std::unique_ptr<ComputeCapability>> XnnpackExecutionProvider::GetCap
     }
   }
 
-  // FUTURE: finding nodes to compile can be inserted here and added to the ComputeCapability instances returned.
-  // GraphPartitioner can handle a mix of static and compiled kernels.
-
   return capabilities;
 }
 
+#if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+std::vector<std::unique_ptr<ComputeCapability>> XnnpackExecutionProvider::GetCompiledSubgraphCapabilities(
+    const GraphViewer& graph,
+    const std::unordered_map<const Node*, const NodeUnit*>& node_unit_map) const {
+  // the nodes claimed in the first call have been converted to NHWC by now, so the shapes and layouts in the graph
+  // are the ones the xnn_subgraph is defined with. QDQ node groups are left to the statically registered kernels.
+  const auto is_node_supported = [&](const Node& node) {
+    const auto it = node_unit_map.find(&node);
+    return it != node_unit_map.end() && it->second->UnitType() == NodeUnit::Type::SingleNode &&
+           IsNodeSupportedInSubgraph(node, graph, Type());
+  };
+
+  // a single node gains nothing over the statically registered kernel
+  const auto on_group_closed = [](const std::vector<const Node*>& group) {
+    return group.size() > 1;
+  };
+
+  const auto gen_metadef_name = [&]() {
+    HashValue model_hash;
+    int metadef_id = metadef_id_generator_.GenerateId(graph, model_hash);
+    return MakeString("XNNPACK_", model_hash, "_", metadef_id);
+  };
+
+  return utils::CreateSupportedPartitions(graph, is_node_supported, on_group_closed, gen_metadef_name,
+                                          "XNNPACK", Type(), &node_unit_map);
+}
+
+common::Status XnnpackExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fused_nodes_and_graphs,
+                                                 std::vector<NodeComputeInfo>& node_compute_funcs) {
+  for (const auto& fused_node_and_graph : fused_nodes_and_graphs) {
+    const Node& fused_node = fused_node_and_graph.fused_node;
+
+    std::unique_ptr<CompiledSubgraph> compiled_subgraph;
+    ORT_RETURN_IF_ERROR(CompiledSubgraph::Create(fused_node_and_graph.filtered_graph, fused_node,
+                                                 xnnpack_thread_pool_, compiled_subgraph));
+    compiled_subgraphs_[fused_node.Name()] = std::move(compiled_subgraph);
+
+    NodeComputeInfo compute_info;
+    compute_info.create_state_func = [this](ComputeContext* context, FunctionState* state) {
+      *state = compiled_subgraphs_.at(context->node_name).get();
+      return 0;
+    };
+
+    compute_info.release_state_func = [](FunctionState state) {
+      // the CompiledSubgraph is owned by compiled_subgraphs_
+      ORT_UNUSED_PARAMETER(state);
+    };
+
+    compute_info.compute_func = [](FunctionState state, const OrtApi* /*api*/, OrtKernelContext* context) {
+      return static_cast<CompiledSubgraph*>(state)->Compute(context);
+    };
+
+    node_compute_funcs.push_back(std::move(compute_info));
+  }
+
+  return Status::OK();
+}
+#endif
+
 std::shared_ptr<KernelRegistry> XnnpackExecutionProvider::GetKernelRegistry() const {
   static std::shared_ptr<KernelRegistry> registry = xnnpack::RegisterKernels();
   return registry;
@@ -4,16 +4,28 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+#include <unordered_map>
+
 #include "core/framework/execution_provider.h"
+#include "core/framework/model_metadef_id_generator.h"
 #include "core/graph/constants.h"
 #include "core/providers/providers.h"
 #include "core/framework/session_options.h"
 
 struct pthreadpool;
 namespace onnxruntime {
-// placeholder for future use. no options currently
+class NodeUnit;
+
+namespace xnnpack {
+class CompiledSubgraph;
+}
+
 struct XnnpackExecutionProviderInfo {
   int xnn_thread_pool_size{0};
+  // compile connected groups of float nodes with static shapes into a single xnn_runtime
+  bool enable_subgraph_compile{false};
   const SessionOptions* session_options{nullptr};
   XnnpackExecutionProviderInfo() = default;
 
@@ -22,6 +34,10 @@ struct XnnpackExecutionProviderInfo {
     if (auto it = po.find("intra_op_num_threads"); it != po.end()) {
       xnn_thread_pool_size = std::stoi(it->second);
     }
+
+    if (auto it = po.find("enable_subgraph_compile"); it != po.end()) {
+      enable_subgraph_compile = it->second == "1";
+    }
   }
 };
 
@@ -36,6 +52,11 @@ class XnnpackExecutionProvider : public IExecutionProvider {
 
   std::shared_ptr<KernelRegistry> GetKernelRegistry() const override;
 
+#if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+  common::Status Compile(const std::vector<FusedNodeAndGraph>& fused_nodes_and_graphs,
+                         std::vector<NodeComputeInfo>& node_compute_funcs) override;
+#endif
+
   DataLayout GetPreferredLayout() const override { return DataLayout::NHWC; }
 
   FusionStyle GetFusionStyle() const override { return FusionStyle::FilteredGraphViewer; }
@@ -50,7 +71,18 @@ class XnnpackExecutionProvider : public IExecutionProvider {
   std::vector<AllocatorPtr> CreatePreferredAllocators() override;
 
  private:
+#if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+  // find groups of nodes to compile into a single xnn_runtime in the second call to GetCapability
+  std::vector<std::unique_ptr<ComputeCapability>> GetCompiledSubgraphCapabilities(
+      const GraphViewer& graph,
+      const std::unordered_map<const Node*, const NodeUnit*>& node_unit_map) const;
+#endif
+
   pthreadpool* xnnpack_thread_pool_{nullptr};
+  const bool enable_subgraph_compile_;
+  ModelMetadefIdGenerator metadef_id_generator_;
+  // compiled subgraphs by fused node name
+  std::unordered_map<std::string, std::unique_ptr<xnnpack::CompiledSubgraph>> compiled_subgraphs_;
 };
 
 }  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #pragma once
 #include "core/framework/op_kernel.h"
 #include "core/providers/xnnpack/xnnpack_execution_provider.h"
+#include "core/providers/xnnpack/detail/ort_pthreadpool.h"
 #include "xnnpack.h"
 
 struct pthreadpool;
@@ -19,8 +20,16 @@ class XnnpackKernel : public OpKernel {
             static_cast<const XnnpackExecutionProvider*>(info.GetExecutionProvider())->GetPrivateThreadPool()},
         caches_{enable_caches} {
   }
-  [[nodiscard]] pthreadpool* GetThreadPool() const {
+  // Returns the thread pool to pass to xnn_reshape_* for this invocation.
+  // With XNNPACK_USE_ORT_THREADPOOL that is an adapter over the ORT intra-op thread pool of `context`. The adapter is
+  // a member, which is fine as the XNNPACK EP does not support concurrent runs.
+  [[nodiscard]] pthreadpool* GetThreadPool([[maybe_unused]] OpKernelContext* context) const {
+#ifdef XNNPACK_USE_ORT_THREADPOOL
+    ort_threadpool_.thread_pool = context->GetOperatorThreadPool();
+    return &ort_threadpool_;
+#else
     return xnnpack_threadpool_;
+#endif
   }
 
   // see comment below about enabling code cache
@@ -30,6 +39,9 @@ class XnnpackKernel : public OpKernel {
 
  private:
   pthreadpool* xnnpack_threadpool_;
+#ifdef XNNPACK_USE_ORT_THREADPOOL
+  mutable pthreadpool ort_threadpool_{nullptr};
+#endif
 
   // Helper class to wrap usage of the XNNPACK weights and code caches.
   // NOTE: Currently creating/freeing the code cache is not exposed via the public xnnpack.h header so usage is
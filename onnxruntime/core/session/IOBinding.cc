@@ -12,14 +12,22 @@ IOBinding::IOBinding(const SessionState& session_state) : session_state_(session
 }
 
 common::Status IOBinding::BindInput(const std::string& name, const OrtValue& ml_value) {
+  if (frozen_) {
+    return RebindFrozenInput(name, ml_value);
+  }
+
   auto it = mapped_feed_names_.emplace(name, feed_names_.size());
 
   auto add_or_replace = [&](const OrtValue& value) {
+    const bool copied = value.IsTensor() && ml_value.IsTensor() &&
+                        value.Get<Tensor>().DataRaw() != ml_value.Get<Tensor>().DataRaw();
     if (it.second) {
       feed_names_.push_back(name);
       feeds_.push_back(value);
+      feeds_copied_.push_back(copied);
     } else {
       feeds_[it.first->second] = value;
+      feeds_copied_[it.first->second] = copied;
     }
   };
 
@@ -42,9 +50,102 @@ common::Status IOBinding::BindInput(const std::string& name, const OrtValue& ml_
 }
 
 void IOBinding::ClearInputs() {
+  Unfreeze();
   mapped_feed_names_.clear();
   feed_names_.clear();
   feeds_.clear();
+  feeds_copied_.clear();
+}
+
+common::Status IOBinding::Freeze() {
+  if (output_names_.empty()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "At least one output should be bound to freeze the binding.");
+  }
+
+  for (size_t i = 0, end = feeds_.size(); i < end; ++i) {
+    if (!feeds_[i].IsTensor()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input '", feed_names_[i],
+                             "' isn't a tensor. Only bindings of tensors can be frozen.");
+    }
+  }
+
+  frozen_ = true;
+  return Status::OK();
+}
+
+void IOBinding::Unfreeze() {
+  frozen_ = false;
+  frozen_feeds_fetches_manager_.reset();
+}
+
+// Checks that `new_value` can replace the frozen value `bound_value`.
+static common::Status CheckSameTensorMetadata(const char* moniker, const std::string& name,
+                                              const OrtValue& bound_value, const OrtValue& new_value,
+                                              bool check_location) {
+  if (!new_value.IsTensor()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The ", moniker, " '", name,
+                           "' of a frozen binding can only be rebound to a tensor.");
+  }
+
+  const auto& bound = bound_value.Get<Tensor>();
+  const auto& tensor = new_value.Get<Tensor>();
+  if (bound.DataType() != tensor.DataType() || bound.Shape() != tensor.Shape()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The ", moniker, " '", name,
+                           "' of a frozen binding has the shape ", bound.Shape(), " but was rebound to a tensor of ",
+                           "another type or of the shape ", tensor.Shape(), ". Call Unfreeze() first.");
+  }
+
+  if (check_location && bound.Location().device != tensor.Location().device) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The ", moniker, " '", name,
+                           "' of a frozen binding was rebound to a tensor on another device. Call Unfreeze() first.");
+  }
+
+  return Status::OK();
+}
+
+common::Status IOBinding::RebindFrozenInput(const std::string& name, const OrtValue& ml_value) {
+  auto it = mapped_feed_names_.find(name);
+  if (it == mapped_feed_names_.end()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input '", name,
+                           "' isn't bound. A frozen binding can't bind new names, call Unfreeze() first.");
+  }
+
+  const size_t index = it->second;
+  OrtValue& bound_value = feeds_[index];
+  if (!feeds_copied_[index]) {
+    ORT_RETURN_IF_ERROR(CheckSameTensorMetadata("input", name, bound_value, ml_value, /*check_location*/ true));
+    bound_value = ml_value;
+    return Status::OK();
+  }
+
+  // Copy the new contents into the device buffer the runs already use.
+  ORT_RETURN_IF_ERROR(CheckSameTensorMetadata("input", name, bound_value, ml_value, /*check_location*/ false));
+  return session_state_.GetDataTransferMgr().CopyTensor(ml_value.Get<Tensor>(), *bound_value.GetMutable<Tensor>());
+}
+
+common::Status IOBinding::RebindFrozenOutput(const std::string& name, const OrtValue& ml_value) {
+  auto it = mapped_output_names_.find(name);
+  if (it == mapped_output_names_.end()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Output '", name,
+                           "' isn't bound. A frozen binding can't bind new names, call Unfreeze() first.");
+  }
+
+  OrtValue& bound_value = outputs_[it->second];
+  if (!ml_value.IsAllocated()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Output '", name,
+                           "' of a frozen binding can only be rebound to a pre-allocated tensor.");
+  }
+
+  // an output that wasn't pre-allocated is allocated by the first run
+  if (bound_value.IsAllocated()) {
+    ORT_RETURN_IF_ERROR(CheckSameTensorMetadata("output", name, bound_value, ml_value, /*check_location*/ true));
+  } else if (frozen_feeds_fetches_manager_ != nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Output '", name,
+                           "' of a frozen binding has no value to be replaced. Call Unfreeze() first.");
+  }
+
+  bound_value = ml_value;
+  return Status::OK();
 }
 
 static common::Status SyncProviders(const SessionState::NameNodeInfoMapType& node_info_map,
@@ -88,6 +189,10 @@ common::Status IOBinding::BindOutput(const std::string& name, OrtDevice device)
 }
 
 common::Status IOBinding::BindOutputImpl(const std::string& name, const OrtValue& ml_value, OrtDevice device) {
+  if (frozen_) {
+    return RebindFrozenOutput(name, ml_value);
+  }
+
   auto it = mapped_output_names_.emplace(name, output_names_.size());
   size_t index = it.first->second;
   if (it.second) {
@@ -104,6 +209,7 @@ common::Status IOBinding::BindOutputImpl(const std::string& name, const OrtValue
 }
 
 void IOBinding::ClearOutputs() {
+  Unfreeze();
   mapped_output_names_.clear();
   output_names_.clear();
   outputs_.clear();
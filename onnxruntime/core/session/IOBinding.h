@@ -9,6 +9,7 @@
 #include "core/framework/execution_provider.h"
 #include "core/common/status.h"
 #include "core/graph/basic_types.h"
+#include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/ort_value.h"
 #include "core/session/inference_session.h"
 #include "core/common/logging/logging.h"
@@ -90,9 +91,24 @@ class IOBinding {
 
   /**
    * clear inputs or outputs. IOBinding is stateful. There are cases we need to reset its state.
+   * Clearing a frozen binding unfreezes it.
    */
   void ClearOutputs();
   void ClearInputs();
+
+  /**
+   * Freeze the bound names, and the types, shapes and locations of the bound values, for repeated runs that only
+   * change the contents of the values, e.g. a decode loop.
+   * The first InferenceSession::Run() after Freeze() validates the binding and resolves the feed/fetch indices and
+   * the device copies once, the later runs reuse them. The outputs allocated by the first run are kept and written
+   * in place by the later runs.
+   * While frozen, BindInput() and BindOutput() only accept names that are already bound and values of the same type,
+   * shape and location. A rebound input whose bound value was copied to the device of its consumer has the new
+   * contents copied into the existing device buffer, so the addresses used by the runs don't change.
+   */
+  common::Status Freeze();
+  void Unfreeze();
+  bool IsFrozen() const { return frozen_; }
   IOBinding(const SessionState& session_state);
 
  private:
@@ -102,11 +118,17 @@ class IOBinding {
   std::vector<std::string> feed_names_;
   std::unordered_map<std::string, size_t> mapped_feed_names_;
   std::vector<OrtValue> feeds_;
+  // whether the bound value of each input is a copy of the value given to BindInput on another device
+  std::vector<bool> feeds_copied_;
   std::vector<std::string> output_names_;
   std::unordered_map<std::string, size_t> mapped_output_names_;
   std::vector<OrtValue> outputs_;
   std::vector<OrtDevice> outputs_device_info_;
 
+  bool frozen_ = false;
+  // created by the first InferenceSession::Run() after Freeze()
+  std::unique_ptr<FeedsFetchesManager> frozen_feeds_fetches_manager_;
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IOBinding);
 
   // device info for all outputs. only used by InferenceSession if the output is not pre-allocated.
@@ -114,5 +136,9 @@ class IOBinding {
 
   // The implementation for the BindOutput() overloads
   common::Status BindOutputImpl(const std::string& name, const OrtValue& ml_value, OrtDevice device);
+
+  // The implementation of BindInput() and BindOutput() for a frozen binding
+  common::Status RebindFrozenInput(const std::string& name, const OrtValue& ml_value);
+  common::Status RebindFrozenOutput(const std::string& name, const OrtValue& ml_value);
 };
 }  // namespace onnxruntime
@@ -0,0 +1,328 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/continuous_batching.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "core/framework/tensor.h"
+#include "core/graph/onnx_protobuf.h"
+
+namespace onnxruntime {
+
+namespace {
+
+std::string LayerName(const std::string& name_format, int layer) {
+  std::string name = name_format;
+  const auto pos = name.find("%d");
+  if (pos != std::string::npos) {
+    name.replace(pos, 2, std::to_string(layer));
+  }
+  return name;
+}
+
+template <typename T>
+OrtValue CreateTensorValue(const AllocatorPtr& allocator, const TensorShape& shape, gsl::span<const T> data) {
+  OrtValue value;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<T>(), shape, allocator, value);
+  std::copy(data.begin(), data.end(), value.GetMutable<Tensor>()->MutableData<T>());
+  return value;
+}
+
+}  // namespace
+
+KVCacheBlockAllocator::KVCacheBlockAllocator(int num_blocks) : free_blocks_(num_blocks > 0 ? num_blocks : 0) {
+  // hand out the lowest block indices first
+  std::iota(free_blocks_.rbegin(), free_blocks_.rend(), 0);
+}
+
+bool KVCacheBlockAllocator::Allocate(size_t count, std::vector<int32_t>& blocks) {
+  if (count > free_blocks_.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    blocks.push_back(free_blocks_.back());
+    free_blocks_.pop_back();
+  }
+
+  return true;
+}
+
+void KVCacheBlockAllocator::Free(std::vector<int32_t>& blocks) {
+  free_blocks_.insert(free_blocks_.end(), blocks.rbegin(), blocks.rend());
+  blocks.clear();
+}
+
+ContinuousBatchingSession::ContinuousBatchingSession(InferenceSession& session,
+                                                     const ContinuousBatchingOptions& options)
+    : session_(session),
+      options_(options),
+      allocator_(std::make_shared<CPUAllocator>()),
+      block_allocator_(options.num_kv_blocks) {
+}
+
+Status ContinuousBatchingSession::Initialize() {
+  ORT_RETURN_IF_NOT(options_.max_batch_size > 0, "max_batch_size must be positive.");
+  ORT_RETURN_IF_NOT(options_.num_layers > 0 && options_.kv_num_heads > 0 && options_.head_size > 0,
+                    "num_layers, kv_num_heads and head_size must be positive.");
+  ORT_RETURN_IF_NOT(options_.kv_block_size > 0 && options_.max_blocks_per_sequence > 0,
+                    "kv_block_size and max_blocks_per_sequence must be positive.");
+  // a single sequence of maximum length must always fit so preemption can make progress
+  ORT_RETURN_IF_NOT(options_.num_kv_blocks >= options_.max_blocks_per_sequence,
+                    "num_kv_blocks must be at least max_blocks_per_sequence.");
+
+  auto [status, inputs] = session_.GetModelInputs();
+  ORT_RETURN_IF_ERROR(status);
+
+  auto find_input = [inputs = inputs](const std::string& name) -> const NodeArg* {
+    auto it = std::find_if(inputs->begin(), inputs->end(), [&name](const NodeArg* arg) { return arg->Name() == name; });
+    return it != inputs->end() ? *it : nullptr;
+  };
+
+  const NodeArg* input_ids = find_input(options_.input_ids_name);
+  ORT_RETURN_IF_NOT(input_ids != nullptr, "The model has no input named ", options_.input_ids_name);
+  const auto* input_ids_type = input_ids->TypeAsProto();
+  ORT_RETURN_IF_NOT(input_ids_type != nullptr && input_ids_type->has_tensor_type(),
+                    options_.input_ids_name, " must be a tensor.");
+  const auto input_ids_elem_type = input_ids_type->tensor_type().elem_type();
+  ORT_RETURN_IF_NOT(input_ids_elem_type == ONNX_NAMESPACE::TensorProto_DataType_INT64 ||
+                        input_ids_elem_type == ONNX_NAMESPACE::TensorProto_DataType_INT32,
+                    options_.input_ids_name, " must be a tensor of int32 or int64.");
+  is_input_ids_int64_ = input_ids_elem_type == ONNX_NAMESPACE::TensorProto_DataType_INT64;
+  has_position_ids_ = find_input(options_.position_ids_name) != nullptr;
+
+  for (const auto* name : {&options_.seqlens_k_name, &options_.total_sequence_length_name,
+                           &options_.block_table_name}) {
+    ORT_RETURN_IF_NOT(find_input(*name) != nullptr, "The model has no input named ", *name);
+  }
+
+  const TensorShape kv_cache_shape({options_.num_kv_blocks, options_.kv_num_heads, options_.kv_block_size,
+                                    options_.head_size});
+  key_cache_.clear();
+  value_cache_.clear();
+  kv_cache_input_names_.clear();
+  kv_cache_output_names_.clear();
+  for (int layer = 0; layer < options_.num_layers; ++layer) {
+    for (const auto* name : {&options_.past_key_name, &options_.past_value_name}) {
+      kv_cache_input_names_.push_back(LayerName(*name, layer));
+      ORT_RETURN_IF_NOT(find_input(kv_cache_input_names_.back()) != nullptr,
+                        "The model has no input named ", kv_cache_input_names_.back());
+    }
+    kv_cache_output_names_.push_back(LayerName(options_.present_key_name, layer));
+    kv_cache_output_names_.push_back(LayerName(options_.present_value_name, layer));
+
+    OrtValue key_cache;
+    Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), kv_cache_shape, allocator_, key_cache);
+    key_cache_.push_back(std::move(key_cache));
+
+    OrtValue value_cache;
+    Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), kv_cache_shape, allocator_, value_cache);
+    value_cache_.push_back(std::move(value_cache));
+  }
+
+  return Status::OK();
+}
+
+size_t ContinuousBatchingSession::BlocksForTokens(size_t num_tokens) const {
+  const size_t block_size = static_cast<size_t>(options_.kv_block_size);
+  return (num_tokens + block_size - 1) / block_size;
+}
+
+Status ContinuousBatchingSession::AddSequence(int64_t id, gsl::span<const int32_t> prompt_tokens, int max_new_tokens) {
+  ORT_RETURN_IF_NOT(!key_cache_.empty(), "Initialize() must be called before adding sequences.");
+  ORT_RETURN_IF_NOT(!prompt_tokens.empty(), "The prompt of sequence ", id, " is empty.");
+  ORT_RETURN_IF_NOT(max_new_tokens > 0, "max_new_tokens of sequence ", id, " must be positive.");
+
+  // the KV of the last generated token is never cached
+  const size_t max_cached_tokens = prompt_tokens.size() + static_cast<size_t>(max_new_tokens) - 1;
+  ORT_RETURN_IF_NOT(BlocksForTokens(max_cached_tokens) <= static_cast<size_t>(options_.max_blocks_per_sequence),
+                    "Sequence ", id, " needs more than max_blocks_per_sequence KV cache blocks.");
+
+  Sequence sequence;
+  sequence.id = id;
+  sequence.tokens.assign(prompt_tokens.begin(), prompt_tokens.end());
+  sequence.prompt_length = prompt_tokens.size();
+  sequence.max_new_tokens = max_new_tokens;
+  pending_.push_back(std::move(sequence));
+
+  return Status::OK();
+}
+
+void ContinuousBatchingSession::AdmitPendingSequences() {
+  // blocks the running sequences need for the tokens of this step are not available to new sequences
+  size_t reserved_blocks = 0;
+  for (const auto& sequence : running_) {
+    reserved_blocks += BlocksForTokens(sequence.tokens.size()) - sequence.blocks.size();
+  }
+
+  while (!pending_.empty() && running_.size() < static_cast<size_t>(options_.max_batch_size)) {
+    const size_t needed_blocks = BlocksForTokens(pending_.front().tokens.size());
+    if (reserved_blocks + needed_blocks > block_allocator_.NumFreeBlocks()) {
+      break;
+    }
+
+    reserved_blocks += needed_blocks;
+    running_.push_back(std::move(pending_.front()));
+    pending_.pop_front();
+  }
+}
+
+void ContinuousBatchingSession::ReserveBlocks(std::vector<Sequence*>& batch) {
+  batch.clear();
+
+  // all the tokens of a running sequence have their KV cached by the end of this step
+  for (size_t i = 0; i < running_.size(); ++i) {
+    Sequence& sequence = running_[i];
+    const size_t needed_blocks = BlocksForTokens(sequence.tokens.size()) - sequence.blocks.size();
+
+    // preempt the most recently admitted sequences, they are re-prefilled from their tokens once readmitted
+    while (!block_allocator_.Allocate(needed_blocks, sequence.blocks)) {
+      ORT_ENFORCE(running_.size() - 1 > i, "The KV cache pool can't hold a single sequence.");
+      Sequence& preempted = running_.back();
+      block_allocator_.Free(preempted.blocks);
+      preempted.num_cached_tokens = 0;
+      pending_.push_front(std::move(preempted));
+      running_.pop_back();
+    }
+  }
+
+  for (auto& sequence : running_) {
+    batch.push_back(&sequence);
+  }
+}
+
+Status ContinuousBatchingSession::RunDecoder(const std::vector<Sequence*>& batch, bool is_prompt) {
+  const int64_t batch_size = static_cast<int64_t>(batch.size());
+  // all the sequences of a prompt run have the same length, see Step()
+  const int64_t sequence_length = is_prompt ? static_cast<int64_t>(batch[0]->tokens.size()) : 1;
+  const int64_t max_blocks = options_.max_blocks_per_sequence;
+
+  std::vector<int64_t> input_ids;
+  std::vector<int64_t> position_ids;
+  std::vector<int32_t> seqlens_k;
+  std::vector<int32_t> block_table(SafeInt<size_t>(batch_size) * max_blocks, 0);
+  int32_t total_sequence_length = 0;
+
+  input_ids.reserve(SafeInt<size_t>(batch_size) * sequence_length);
+  position_ids.reserve(SafeInt<size_t>(batch_size) * sequence_length);
+  for (int64_t b = 0; b < batch_size; ++b) {
+    const Sequence& sequence = *batch[b];
+    const int64_t start_position = is_prompt ? 0 : static_cast<int64_t>(sequence.tokens.size()) - 1;
+    for (int64_t s = 0; s < sequence_length; ++s) {
+      input_ids.push_back(sequence.tokens[start_position + s]);
+      position_ids.push_back(start_position + s);
+    }
+
+    // for the prompt seqlens_k is the number of tokens - 1, for token generation the number of tokens in the cache
+    seqlens_k.push_back(static_cast<int32_t>(is_prompt ? sequence_length - 1 : start_position));
+    total_sequence_length = std::max(total_sequence_length, static_cast<int32_t>(sequence.tokens.size()));
+    std::copy(sequence.blocks.begin(), sequence.blocks.end(), block_table.begin() + b * max_blocks);
+  }
+
+  const TensorShape ids_shape({batch_size, sequence_length});
+
+  std::vector<std::string> feed_names;
+  std::vector<OrtValue> feeds;
+  feed_names.push_back(options_.input_ids_name);
+  if (is_input_ids_int64_) {
+    feeds.push_back(CreateTensorValue<int64_t>(allocator_, ids_shape, input_ids));
+  } else {
+    std::vector<int32_t> input_ids_int32(input_ids.begin(), input_ids.end());
+    feeds.push_back(CreateTensorValue<int32_t>(allocator_, ids_shape, input_ids_int32));
+  }
+  if (has_position_ids_) {
+    feed_names.push_back(options_.position_ids_name);
+    feeds.push_back(CreateTensorValue<int64_t>(allocator_, ids_shape, position_ids));
+  }
+  feed_names.push_back(options_.seqlens_k_name);
+  feeds.push_back(CreateTensorValue<int32_t>(allocator_, TensorShape({batch_size}), seqlens_k));
+  feed_names.push_back(options_.total_sequence_length_name);
+  feeds.push_back(CreateTensorValue<int32_t>(allocator_, TensorShape({1}),
+                                             gsl::span<const int32_t>(&total_sequence_length, 1)));
+  feed_names.push_back(options_.block_table_name);
+  feeds.push_back(CreateTensorValue<int32_t>(allocator_, TensorShape({batch_size, max_blocks}), block_table));
+
+  // the KV cache pools are both fed as past and pre-allocated as present so the decoder updates them in place
+  std::vector<std::string> output_names{options_.logits_name};
+  std::vector<OrtValue> fetches(1);
+  for (int layer = 0; layer < options_.num_layers; ++layer) {
+    feed_names.push_back(kv_cache_input_names_[2 * layer]);
+    feeds.push_back(key_cache_[layer]);
+    feed_names.push_back(kv_cache_input_names_[2 * layer + 1]);
+    feeds.push_back(value_cache_[layer]);
+
+    output_names.push_back(kv_cache_output_names_[2 * layer]);
+    fetches.push_back(key_cache_[layer]);
+    output_names.push_back(kv_cache_output_names_[2 * layer + 1]);
+    fetches.push_back(value_cache_[layer]);
+  }
+
+  ORT_RETURN_IF_ERROR(session_.Run(RunOptions(), feed_names, feeds, output_names, &fetches));
+
+  const Tensor& logits = fetches[0].Get<Tensor>();
+  ORT_RETURN_IF_NOT(logits.IsDataType<float>(), options_.logits_name, " must be a tensor of float.");
+  const auto& logits_dims = logits.Shape().GetDims();
+  ORT_RETURN_IF_NOT(logits_dims.size() == 3 && logits_dims[0] == batch_size,
+                    options_.logits_name, " must have shape (batch_size, sequence_length, vocab_size).");
+
+  // some decoders only produce the logits of the last position
+  const int64_t logits_length = logits_dims[1];
+  const int64_t vocab_size = logits_dims[2];
+  const float* logits_data = logits.Data<float>();
+  for (int64_t b = 0; b < batch_size; ++b) {
+    const float* last_logits = logits_data + (b * logits_length + logits_length - 1) * vocab_size;
+    const auto next_token = std::max_element(last_logits, last_logits + vocab_size) - last_logits;
+
+    Sequence& sequence = *batch[b];
+    sequence.num_cached_tokens = sequence.tokens.size();
+    sequence.tokens.push_back(static_cast<int32_t>(next_token));
+  }
+
+  return Status::OK();
+}
+
+Status ContinuousBatchingSession::Step(std::vector<FinishedSequence>& finished_sequences) {
+  finished_sequences.clear();
+
+  AdmitPendingSequences();
+
+  std::vector<Sequence*> batch;
+  ReserveBlocks(batch);
+
+  std::vector<Sequence*> decode_batch;
+  for (Sequence* sequence : batch) {
+    if (sequence->num_cached_tokens == 0) {
+      // prompts have different lengths, and GroupQueryAttention treats the whole batch as either prompt or
+      // token generation, so the sequences that joined are prefilled one at a time
+      ORT_RETURN_IF_ERROR(RunDecoder({sequence}, true));
+    } else {
+      decode_batch.push_back(sequence);
+    }
+  }
+
+  if (!decode_batch.empty()) {
+    ORT_RETURN_IF_ERROR(RunDecoder(decode_batch, false));
+  }
+
+  // finished sequences leave the batch and release their blocks right away
+  auto is_finished = [this](const Sequence& sequence) {
+    const size_t num_generated = sequence.tokens.size() - sequence.prompt_length;
+    return num_generated >= static_cast<size_t>(sequence.max_new_tokens) ||
+           (options_.eos_token_id >= 0 && sequence.tokens.back() == options_.eos_token_id);
+  };
+
+  for (auto& sequence : running_) {
+    if (is_finished(sequence)) {
+      block_allocator_.Free(sequence.blocks);
+      finished_sequences.push_back(
+          {sequence.id, std::vector<int32_t>(sequence.tokens.begin() + sequence.prompt_length, sequence.tokens.end())});
+    }
+  }
+  running_.erase(std::remove_if(running_.begin(), running_.end(), is_finished), running_.end());
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
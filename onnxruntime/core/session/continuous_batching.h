@@ -0,0 +1,147 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+/**
+ * Free list of the blocks of a paged KV cache.
+ * Blocks are handed out one at a time as sequences grow and returned when a sequence leaves the batch.
+ */
+class KVCacheBlockAllocator {
+ public:
+  explicit KVCacheBlockAllocator(int num_blocks);
+
+  // Appends `count` free blocks to `blocks`. Returns false and leaves `blocks` untouched if there are not enough.
+  bool Allocate(size_t count, std::vector<int32_t>& blocks);
+
+  // Returns the blocks to the free list and clears `blocks`.
+  void Free(std::vector<int32_t>& blocks);
+
+  size_t NumFreeBlocks() const { return free_blocks_.size(); }
+
+ private:
+  std::vector<int32_t> free_blocks_;
+};
+
+struct ContinuousBatchingOptions {
+  // Maximum number of sequences decoded together in a step.
+  int max_batch_size = 16;
+
+  // Shape of the KV cache of the decoder.
+  int num_layers = 0;
+  int kv_num_heads = 0;
+  int head_size = 0;
+
+  // Layout of the paged KV cache shared by all the sequences, see the block_table input of GroupQueryAttention.
+  int num_kv_blocks = 0;
+  int kv_block_size = 16;
+  int max_blocks_per_sequence = 0;
+
+  // A sequence finishes when this token is generated. -1 to only stop on max_new_tokens.
+  int32_t eos_token_id = -1;
+
+  // Names of the inputs and outputs of the decoder. "%d" in the past/present names is replaced by the layer index.
+  // position_ids is only fed if it is an input of the model.
+  std::string input_ids_name = "input_ids";
+  std::string position_ids_name = "position_ids";
+  std::string seqlens_k_name = "seqlens_k";
+  std::string total_sequence_length_name = "total_sequence_length";
+  std::string block_table_name = "block_table";
+  std::string past_key_name = "past_key_values.%d.key";
+  std::string past_value_name = "past_key_values.%d.value";
+  std::string present_key_name = "present.%d.key";
+  std::string present_value_name = "present.%d.value";
+  std::string logits_name = "logits";
+};
+
+/**
+ * Continuous (in-flight) batching of greedy decoding on top of InferenceSession::Run.
+ *
+ * The session runs one step of a decoder whose GroupQueryAttention nodes use a paged KV cache. All the
+ * sequences share one pool of KV blocks per layer that is fed as past and bound as present, so it is
+ * updated in place. Every sequence owns a slot with its tokens and the list of its blocks, which grows
+ * with the number of tokens.
+ *
+ * Sequences join and leave the batch between steps: each Step() prefills the sequences that joined since
+ * the previous step and decodes one token for the sequences already running. A sequence that finishes
+ * releases its blocks immediately, so short requests don't wait for long ones. If the pool runs out of
+ * blocks, the most recently admitted sequences are preempted back to the queue and prefilled again later.
+ *
+ * This class is not thread safe.
+ */
+class ContinuousBatchingSession {
+ public:
+  struct FinishedSequence {
+    int64_t id;
+    std::vector<int32_t> generated_tokens;
+  };
+
+  // `session` must be initialized and outlive this instance.
+  ContinuousBatchingSession(InferenceSession& session, const ContinuousBatchingOptions& options);
+
+  // Validates the options against the model and allocates the KV cache pool.
+  Status Initialize();
+
+  // Queues a sequence. It joins the batch in a following Step() once there is a free slot and enough blocks.
+  Status AddSequence(int64_t id, gsl::span<const int32_t> prompt_tokens, int max_new_tokens);
+
+  // Runs one step and reports the sequences that finished during it.
+  Status Step(std::vector<FinishedSequence>& finished_sequences);
+
+  size_t NumRunningSequences() const { return running_.size(); }
+  size_t NumPendingSequences() const { return pending_.size(); }
+  bool HasWork() const { return !running_.empty() || !pending_.empty(); }
+
+ private:
+  struct Sequence {
+    int64_t id;
+    std::vector<int32_t> tokens;  // prompt followed by the generated tokens
+    size_t prompt_length;
+    int max_new_tokens;
+    std::vector<int32_t> blocks;  // KV cache blocks backing the positions of the sequence in order
+    size_t num_cached_tokens = 0;  // number of tokens whose KV is in the cache
+  };
+
+  size_t BlocksForTokens(size_t num_tokens) const;
+
+  // Moves pending sequences to the running set while there is room in the batch and in the KV cache pool.
+  void AdmitPendingSequences();
+
+  // Makes sure every running sequence has blocks for the tokens it caches in this step, preempting
+  // the most recently admitted sequences if the pool is exhausted, and returns the running sequences in `batch`.
+  void ReserveBlocks(std::vector<Sequence*>& batch);
+
+  // Runs the decoder for `batch`, over all the tokens of the sequences for a prompt or the last token otherwise,
+  // and appends the next token chosen greedily to every sequence.
+  Status RunDecoder(const std::vector<Sequence*>& batch, bool is_prompt);
+
+  InferenceSession& session_;
+  const ContinuousBatchingOptions options_;
+  AllocatorPtr allocator_;
+
+  bool is_input_ids_int64_ = false;
+  bool has_position_ids_ = false;
+
+  KVCacheBlockAllocator block_allocator_;
+  std::vector<OrtValue> key_cache_;    // one pool of key blocks per layer
+  std::vector<OrtValue> value_cache_;  // one pool of value blocks per layer
+  InlinedVector<std::string> kv_cache_input_names_;
+  InlinedVector<std::string> kv_cache_output_names_;
+
+  std::deque<Sequence> pending_;
+  std::vector<Sequence> running_;  // in admission order
+};
+
+}  // namespace onnxruntime
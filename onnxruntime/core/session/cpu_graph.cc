@@ -0,0 +1,228 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/cpu_graph.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "core/framework/execution_frame.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/sequential_execution_plan.h"
+#include "core/framework/session_state.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/framework/run_options.h"
+#include "core/graph/constants.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+namespace {
+
+bool HasStaticTensorShape(const NodeArg& node_arg) {
+  const auto* type = node_arg.TypeAsProto();
+  if (type == nullptr || !utils::HasTensorType(*type)) {
+    return false;
+  }
+
+  const auto* shape = node_arg.Shape();
+  if (shape == nullptr) {
+    return false;
+  }
+
+  return std::all_of(shape->dim().begin(), shape->dim().end(),
+                     [](const ONNX_NAMESPACE::TensorShapeProto_Dimension& dim) { return utils::HasDimValue(dim); });
+}
+
+}  // namespace
+
+CpuGraph::CpuGraph(const SessionState& session_state) : session_state_(session_state) {
+}
+
+CpuGraph::~CpuGraph() {
+  // the kernel contexts reference the frame
+  Reset();
+}
+
+Status CpuGraph::CheckCapturable(const SessionState& session_state) {
+  const auto* plan = session_state.GetExecutionPlan();
+  ORT_RETURN_IF(plan == nullptr, "The session has no execution plan.");
+  ORT_RETURN_IF(plan->execution_plan.size() > 1, "The execution plan has multiple logic streams.");
+  ORT_RETURN_IF(!plan->streamed_weights.empty(), "The session streams weights to a device.");
+
+  const auto& graph_viewer = session_state.GetGraphViewer();
+  for (const auto* input : graph_viewer.GetInputs()) {
+    ORT_RETURN_IF(!HasStaticTensorShape(*input), "The graph input ", input->Name(),
+                  " is not a tensor with a static shape.");
+  }
+
+  for (const auto& node : graph_viewer.Nodes()) {
+    ORT_RETURN_IF(node.GetExecutionProviderType() != kCpuExecutionProvider, "The node ", node.Name(),
+                  " is assigned to ", node.GetExecutionProviderType(), ".");
+    ORT_RETURN_IF(node.ContainsSubgraph(), "The node ", node.Name(), " has subgraphs.");
+    for (const auto* output : node.OutputDefs()) {
+      ORT_RETURN_IF(output->Exists() && !HasStaticTensorShape(*output), "The output ", output->Name(), " of node ",
+                    node.Name(), " is not a tensor with a static shape.");
+    }
+  }
+
+  for (const auto* output : graph_viewer.GetOutputs()) {
+    ORT_RETURN_IF(graph_viewer.GetProducerNode(output->Name()) == nullptr, "The graph output ", output->Name(),
+                  " is not produced by a node.");
+  }
+
+  return Status::OK();
+}
+
+bool CpuGraph::Matches(gsl::span<const std::string> feed_names, gsl::span<const std::string> output_names) const {
+  if (!IsCaptured()) {
+    return true;
+  }
+
+  return std::equal(feed_names.begin(), feed_names.end(), feed_names_.begin(), feed_names_.end()) &&
+         std::equal(output_names.begin(), output_names.end(), output_names_.begin(), output_names_.end());
+}
+
+Status CpuGraph::Run(const RunOptions& run_options,
+                     gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                     gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches) {
+  if (!IsCaptured()) {
+    return Capture(run_options, feed_names, feeds, output_names, fetches);
+  }
+
+  return Replay(run_options, feeds, fetches);
+}
+
+Status CpuGraph::Capture(const RunOptions& run_options,
+                         gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                         gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches) {
+  const auto& name_idx_map = session_state_.GetOrtValueNameIdxMap();
+  InlinedVector<int> feed_idxs;
+  feed_idxs.reserve(feed_names.size());
+  for (const auto& name : feed_names) {
+    int idx = -1;
+    ORT_RETURN_IF_ERROR(name_idx_map.GetIdx(name, idx));
+    feed_idxs.push_back(idx);
+  }
+
+  InlinedVector<int> fetch_idxs;
+  fetch_idxs.reserve(output_names.size());
+  for (const auto& name : output_names) {
+    int idx = -1;
+    ORT_RETURN_IF_ERROR(name_idx_map.GetIdx(name, idx));
+    fetch_idxs.push_back(idx);
+  }
+
+  // the CPU EP has no streams
+  frame_ = std::make_unique<ExecutionFrame>(feed_idxs, feeds, fetch_idxs, fetches,
+                                            std::unordered_map<size_t, IExecutor::CustomAllocator>{},
+#ifdef ORT_ENABLE_STREAM
+                                            nullptr,
+#endif
+                                            session_state_);
+
+  // with a single logic stream all the steps are kernel launches
+  const auto& plan = *session_state_.GetExecutionPlan();
+  if (!plan.execution_plan.empty()) {
+    const auto& steps = plan.execution_plan[0]->steps_;
+    kernel_calls_.reserve(steps.size());
+    for (const auto& step : steps) {
+      const OpKernel* kernel = session_state_.GetKernel(step->GetNodeIndex());
+      kernel_calls_.push_back({kernel, std::make_unique<OpKernelContextInternal>(session_state_, *frame_, *kernel,
+                                                                                 session_state_.Logger(),
+                                                                                 terminate_flag_, nullptr)});
+    }
+  }
+
+  Status status = Execute(run_options);
+  if (status.IsOK()) {
+    status = frame_->GetOutputs(fetches);
+  }
+
+  if (!status.IsOK()) {
+    Reset();
+    return status;
+  }
+
+  // keep the values owning a buffer of their own and the initializers, the kernels write to the same buffers
+  // in every replay.
+  const auto& allocation_plan = plan.allocation_plan;
+  for (size_t idx = 0; idx < allocation_plan.size(); ++idx) {
+    const auto& value_plan = allocation_plan[idx];
+    const bool keep = (value_plan.alloc_kind == AllocKind::kAllocate && !value_plan.is_view) ||
+                      value_plan.alloc_kind == AllocKind::kAllocateStatically;
+    if (!keep) {
+      values_to_release_.push_back(static_cast<int>(idx));
+    }
+  }
+
+  frame_->ClearValues(values_to_release_);
+
+  feed_names_.assign(feed_names.begin(), feed_names.end());
+  output_names_.assign(output_names.begin(), output_names.end());
+  feed_idxs_ = std::move(feed_idxs);
+  fetch_idxs_ = std::move(fetch_idxs);
+
+  LOGS(session_state_.Logger(), INFO) << "Captured the CPU graph with " << kernel_calls_.size() << " kernel calls.";
+  return Status::OK();
+}
+
+Status CpuGraph::Replay(const RunOptions& run_options, gsl::span<const OrtValue> feeds,
+                        std::vector<OrtValue>& fetches) {
+  frame_->UpdateFeeds(feed_idxs_, feeds);
+  if (!fetches.empty()) {
+    frame_->UpdateFetches(fetch_idxs_, fetches, session_state_.GetInitializedTensors());
+  }
+
+  Status status = Execute(run_options);
+  if (status.IsOK()) {
+    status = frame_->GetOutputs(fetches);
+  }
+
+  frame_->ClearValues(values_to_release_);
+  return status;
+}
+
+Status CpuGraph::Execute(const RunOptions& run_options) {
+  terminate_flag_ = run_options.terminate;
+
+  for (auto& call : kernel_calls_) {
+    if (run_options.terminate) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+    }
+
+    Status status;
+    ORT_TRY {
+      status = call.kernel->Compute(call.context.get());
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+
+    if (!status.IsOK()) {
+      std::ostringstream ss;
+      const auto& node = call.kernel->Node();
+      ss << "Non-zero status code returned while running " << node.OpType() << " node. Name:'" << node.Name()
+         << "' Status Message: " << status.ErrorMessage();
+      const auto msg_string = ss.str();
+      LOGS(session_state_.Logger(), ERROR) << msg_string;
+      return Status(status.Category(), status.Code(), msg_string);
+    }
+  }
+
+  return Status::OK();
+}
+
+void CpuGraph::Reset() {
+  kernel_calls_.clear();
+  frame_.reset();
+  values_to_release_.clear();
+  feed_names_.clear();
+  output_names_.clear();
+  feed_idxs_.clear();
+  fetch_idxs_.clear();
+}
+
+}  // namespace onnxruntime
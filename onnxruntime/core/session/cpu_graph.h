@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/ort_value.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class ExecutionFrame;
+class OpKernel;
+class OpKernelContextInternal;
+class SessionState;
+struct RunOptions;
+
+/**
+ * Capture and replay of the kernel calls of a CPU graph, see kOrtSessionOptionsConfigEnableCpuGraphCapture.
+ *
+ * The first Run executes the nodes with an execution frame and kernel contexts owned by the CpuGraph, which are kept
+ * after the Run. Later Runs with the same feed and output names replace the feeds and fetches of the frame and call
+ * the kernels of the recorded list directly, without the executor, the execution frame setup and the per node
+ * OpKernelContext construction. The intermediate values that own their buffer stay allocated between the Runs, so
+ * the kernels write to the same buffers every time. The values that are placed in another value's buffer, the feeds
+ * and the fetches are released after each Run: the outputs of a replay are newly allocated unless pre-allocated
+ * fetches are passed, and the CpuGraph doesn't keep the feeds alive.
+ *
+ * Only graphs whose inputs and node outputs all have static shapes can be captured, so all the Runs use the
+ * same shapes. See CheckCapturable for the other requirements.
+ */
+class CpuGraph {
+ public:
+  explicit CpuGraph(const SessionState& session_state);
+  ~CpuGraph();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CpuGraph);
+
+  // Returns an error with the reason if the main graph of `session_state` can't be captured: a node is assigned to
+  // another EP than the CPU EP or has subgraphs, an input or node output has a dynamic shape or isn't a tensor,
+  // a graph output isn't produced by a node, the plan has multiple logic streams or streamed weights.
+  static Status CheckCapturable(const SessionState& session_state);
+
+  // Locks the graph for a Run. Returns an unlocked lock if another Run is using the graph, so that the caller can
+  // execute the graph as usual instead of waiting.
+  std::unique_lock<OrtMutex> TryLock() { return std::unique_lock<OrtMutex>(mutex_, std::try_to_lock); }
+
+  // Returns whether a Run with the given feed and output names can use the graph, i.e. the graph wasn't captured yet
+  // or was captured with the same names. The graph must be locked.
+  bool Matches(gsl::span<const std::string> feed_names, gsl::span<const std::string> output_names) const;
+
+  // Captures the graph with the feeds and fetches of the first Run, replays it afterwards. The feeds and fetches
+  // must have been validated. The graph must be locked.
+  Status Run(const RunOptions& run_options,
+             gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+             gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches);
+
+  bool IsCaptured() const { return frame_ != nullptr; }
+
+ private:
+  struct KernelCall {
+    const OpKernel* kernel;
+    std::unique_ptr<OpKernelContextInternal> context;
+  };
+
+  Status Capture(const RunOptions& run_options,
+                 gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                 gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches);
+
+  Status Replay(const RunOptions& run_options, gsl::span<const OrtValue> feeds, std::vector<OrtValue>& fetches);
+
+  // Calls the kernels in execution order.
+  Status Execute(const RunOptions& run_options);
+
+  void Reset();
+
+  const SessionState& session_state_;
+
+  OrtMutex mutex_;
+
+  std::vector<std::string> feed_names_;
+  std::vector<std::string> output_names_;
+  InlinedVector<int> feed_idxs_;
+  InlinedVector<int> fetch_idxs_;
+
+  std::unique_ptr<ExecutionFrame> frame_;
+  std::vector<KernelCall> kernel_calls_;
+
+  // the values released after each Run
+  InlinedVector<int> values_to_release_;
+
+  // referenced by the kernel contexts, set from RunOptions::terminate for each Run
+  bool terminate_flag_{false};
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,311 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/dynamic_batcher.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+#include "core/framework/tensor.h"
+#include "core/graph/onnx_protobuf.h"
+
+namespace onnxruntime {
+
+namespace dynamic_batching {
+
+Status ConcatenateBatch(gsl::span<const OrtValue* const> values, const AllocatorPtr& allocator, OrtValue& result) {
+  ORT_RETURN_IF(values.empty(), "No values to concatenate.");
+
+  const Tensor& first = values[0]->Get<Tensor>();
+  ORT_RETURN_IF(first.IsDataTypeString(), "String tensors can't be batched.");
+  ORT_RETURN_IF_NOT(first.Location().device.Type() == OrtDevice::CPU, "Only CPU tensors can be batched.");
+  ORT_RETURN_IF_NOT(first.Shape().NumDimensions() > 0, "Scalars have no batch dimension.");
+
+  int64_t total_batch_size = 0;
+  for (const auto* value : values) {
+    const Tensor& tensor = value->Get<Tensor>();
+    ORT_RETURN_IF_NOT(tensor.DataType() == first.DataType() &&
+                          tensor.Location().device.Type() == OrtDevice::CPU &&
+                          tensor.Shape().NumDimensions() == first.Shape().NumDimensions() &&
+                          tensor.Shape().Slice(1) == first.Shape().Slice(1),
+                      "Tensors with shapes ", first.Shape(), " and ", tensor.Shape(), " can't be batched.");
+    total_batch_size += tensor.Shape()[0];
+  }
+
+  TensorShape shape = first.Shape();
+  shape[0] = total_batch_size;
+  Tensor::InitOrtValue(first.DataType(), shape, allocator, result);
+
+  auto* dst = static_cast<uint8_t*>(result.GetMutable<Tensor>()->MutableDataRaw());
+  for (const auto* value : values) {
+    const Tensor& tensor = value->Get<Tensor>();
+    std::memcpy(dst, tensor.DataRaw(), tensor.SizeInBytes());
+    dst += tensor.SizeInBytes();
+  }
+
+  return Status::OK();
+}
+
+Status SliceBatch(const OrtValue& value, int64_t offset, int64_t count, const AllocatorPtr& allocator,
+                  OrtValue& result) {
+  const Tensor& tensor = value.Get<Tensor>();
+  ORT_RETURN_IF(tensor.IsDataTypeString(), "String tensors can't be batched.");
+  ORT_RETURN_IF_NOT(tensor.Location().device.Type() == OrtDevice::CPU, "Only CPU tensors can be batched.");
+  ORT_RETURN_IF_NOT(tensor.Shape().NumDimensions() > 0, "Scalars have no batch dimension.");
+  ORT_RETURN_IF_NOT(offset >= 0 && count >= 0 && offset + count <= tensor.Shape()[0],
+                    "Rows ", offset, " to ", offset + count, " are out of the batch dimension of ", tensor.Shape());
+
+  TensorShape shape = tensor.Shape();
+  shape[0] = count;
+  Tensor::InitOrtValue(tensor.DataType(), shape, allocator, result);
+
+  const size_t row_size = static_cast<size_t>(tensor.Shape().SizeFromDimension(1)) * tensor.DataType()->Size();
+  std::memcpy(result.GetMutable<Tensor>()->MutableDataRaw(),
+              static_cast<const uint8_t*>(tensor.DataRaw()) + static_cast<size_t>(offset) * row_size,
+              static_cast<size_t>(count) * row_size);
+
+  return Status::OK();
+}
+
+}  // namespace dynamic_batching
+
+namespace {
+
+// Returns the symbolic batch dimension of a graph input or output, or an empty string if it has none.
+std::string BatchDimParam(const NodeArg& arg) {
+  const auto* shape = arg.Shape();
+  if (shape == nullptr || shape->dim_size() == 0 || !shape->dim(0).has_dim_param()) {
+    return {};
+  }
+  return shape->dim(0).dim_param();
+}
+
+}  // namespace
+
+DynamicBatcher::DynamicBatcher(InferenceSession& session, const DynamicBatcherOptions& options)
+    : session_(session),
+      options_(options),
+      allocator_(std::make_shared<CPUAllocator>()) {
+}
+
+DynamicBatcher::~DynamicBatcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+
+  for (auto& request : queue_) {
+    request->done.set_value(ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The dynamic batcher was destroyed."));
+  }
+}
+
+Status DynamicBatcher::Initialize() {
+  ORT_RETURN_IF_NOT(options_.max_batch_size > 0, "max_batch_size must be positive.");
+  ORT_RETURN_IF(worker_.joinable(), "The dynamic batcher is already initialized.");
+
+  auto [status, inputs] = session_.GetModelInputs();
+  ORT_RETURN_IF_ERROR(status);
+  ORT_RETURN_IF(inputs->empty(), "The model has no inputs to batch.");
+
+  const std::string batch_dim = BatchDimParam(*inputs->front());
+  for (const auto* input : *inputs) {
+    ORT_RETURN_IF_NOT(!batch_dim.empty() && BatchDimParam(*input) == batch_dim,
+                      "The first dimension of every input must be the same symbolic batch dimension. Input ",
+                      input->Name(), " has no dimension '", batch_dim, "'.");
+  }
+
+  auto [output_status, outputs] = session_.GetModelOutputs();
+  ORT_RETURN_IF_ERROR(output_status);
+  batched_outputs_.clear();
+  for (const auto* output : *outputs) {
+    if (BatchDimParam(*output) == batch_dim) {
+      batched_outputs_.insert(output->Name());
+    }
+  }
+
+  worker_ = std::thread(&DynamicBatcher::WorkerLoop, this);
+
+  return Status::OK();
+}
+
+Status DynamicBatcher::Run(const NameMLValMap& feeds, gsl::span<const std::string> output_names,
+                           std::vector<OrtValue>& fetches) {
+  ORT_RETURN_IF_NOT(worker_.joinable(), "Initialize() must be called before Run().");
+  ORT_RETURN_IF(feeds.empty(), "A request must have feeds.");
+
+  auto request = std::make_unique<Request>();
+  for (const auto& feed : feeds) {
+    request->feed_names.push_back(feed.first);
+  }
+  std::sort(request->feed_names.begin(), request->feed_names.end());
+
+  for (const auto& name : request->feed_names) {
+    const OrtValue& feed = feeds.at(name);
+    ORT_RETURN_IF_NOT(feed.IsTensor(), "Feed ", name, " is not a tensor.");
+    const Tensor& tensor = feed.Get<Tensor>();
+    ORT_RETURN_IF(tensor.IsDataTypeString() || tensor.Location().device.Type() != OrtDevice::CPU ||
+                      tensor.Shape().NumDimensions() == 0,
+                  "Feed ", name, " must be a CPU tensor of a non-string type with a batch dimension.");
+
+    const int64_t batch_size = tensor.Shape()[0];
+    ORT_RETURN_IF(request->feeds.size() > 0 && batch_size != request->batch_size,
+                  "Feed ", name, " has batch size ", batch_size, " instead of ", request->batch_size);
+    request->batch_size = batch_size;
+    request->feeds.push_back(feed);
+  }
+  ORT_RETURN_IF_NOT(request->batch_size > 0, "A request must have a positive batch size.");
+
+  for (const auto& name : output_names) {
+    ORT_RETURN_IF_NOT(batched_outputs_.count(name) > 0,
+                      "Output ", name, " doesn't have the batch dimension of the inputs and can't be batched.");
+  }
+  request->output_names.assign(output_names.begin(), output_names.end());
+  request->fetches = &fetches;
+
+  auto done = request->done.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ORT_RETURN_IF(stop_, "The dynamic batcher is stopping.");
+    queue_.push_back(std::move(request));
+  }
+  cv_.notify_all();
+
+  return done.get();
+}
+
+bool DynamicBatcher::IsCompatible(const Request& a, const Request& b) {
+  if (a.feed_names != b.feed_names || a.output_names != b.output_names) {
+    return false;
+  }
+
+  for (size_t i = 0; i < a.feeds.size(); ++i) {
+    const Tensor& x = a.feeds[i].Get<Tensor>();
+    const Tensor& y = b.feeds[i].Get<Tensor>();
+    if (x.DataType() != y.DataType() || x.Shape().NumDimensions() != y.Shape().NumDimensions() ||
+        x.Shape().Slice(1) != y.Shape().Slice(1)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::vector<std::unique_ptr<DynamicBatcher::Request>> DynamicBatcher::NextBatch() {
+  std::vector<std::unique_ptr<Request>> batch;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+  if (stop_) {
+    return batch;
+  }
+
+  batch.push_back(std::move(queue_.front()));
+  queue_.pop_front();
+  int64_t batch_size = batch.front()->batch_size;
+
+  // take the compatible requests that fit, the others stay queued in order for a following batch
+  auto take_compatible = [&]() {
+    for (auto it = queue_.begin(); it != queue_.end() && batch_size < options_.max_batch_size;) {
+      if (IsCompatible(*batch.front(), **it) && batch_size + (*it)->batch_size <= options_.max_batch_size) {
+        batch_size += (*it)->batch_size;
+        batch.push_back(std::move(*it));
+        it = queue_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  };
+
+  const auto deadline = std::chrono::steady_clock::now() + options_.max_queue_delay;
+  take_compatible();
+  while (batch_size < options_.max_batch_size && !stop_) {
+    if (cv_.wait_until(lock, deadline) == std::cv_status::timeout) {
+      take_compatible();
+      break;
+    }
+    take_compatible();
+  }
+
+  return batch;
+}
+
+void DynamicBatcher::WorkerLoop() {
+  for (;;) {
+    auto batch = NextBatch();
+    if (batch.empty()) {
+      return;
+    }
+
+    Status status;
+    ORT_TRY {
+      status = RunBatch(batch);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+      });
+    }
+
+    for (auto& request : batch) {
+      request->done.set_value(status);
+    }
+  }
+}
+
+Status DynamicBatcher::RunBatch(std::vector<std::unique_ptr<Request>>& batch) {
+  const Request& first = *batch.front();
+
+  // a single request runs with its own feeds and fetches
+  if (batch.size() == 1) {
+    NameMLValMap feeds;
+    for (size_t i = 0; i < first.feeds.size(); ++i) {
+      feeds.emplace(first.feed_names[i], first.feeds[i]);
+    }
+    return session_.Run(options_.run_options, feeds, first.output_names, first.fetches);
+  }
+
+  NameMLValMap feeds;
+  std::vector<const OrtValue*> values(batch.size());
+  for (size_t i = 0; i < first.feeds.size(); ++i) {
+    std::transform(batch.begin(), batch.end(), values.begin(),
+                   [i](const std::unique_ptr<Request>& request) { return &request->feeds[i]; });
+    OrtValue feed;
+    ORT_RETURN_IF_ERROR(dynamic_batching::ConcatenateBatch(values, allocator_, feed));
+    feeds.emplace(first.feed_names[i], std::move(feed));
+  }
+
+  std::vector<OrtValue> fetches;
+  ORT_RETURN_IF_ERROR(session_.Run(options_.run_options, feeds, first.output_names, &fetches));
+
+  const int64_t total_batch_size = std::accumulate(
+      batch.begin(), batch.end(), int64_t{0},
+      [](int64_t sum, const std::unique_ptr<Request>& request) { return sum + request->batch_size; });
+
+  for (size_t i = 0; i < fetches.size(); ++i) {
+    ORT_RETURN_IF_NOT(fetches[i].IsTensor(), "Output ", first.output_names[i], " is not a tensor.");
+    const auto& shape = fetches[i].Get<Tensor>().Shape();
+    ORT_RETURN_IF_NOT(shape.NumDimensions() > 0 && shape[0] == total_batch_size,
+                      "Output ", first.output_names[i], " has shape ", shape, " without the batch size ",
+                      total_batch_size, " of the inputs.");
+  }
+
+  int64_t offset = 0;
+  for (auto& request : batch) {
+    request->fetches->resize(fetches.size());
+    for (size_t i = 0; i < fetches.size(); ++i) {
+      ORT_RETURN_IF_ERROR(dynamic_batching::SliceBatch(fetches[i], offset, request->batch_size, allocator_,
+                                                       (*request->fetches)[i]));
+    }
+    offset += request->batch_size;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+struct DynamicBatcherOptions {
+  // Maximum sum of the batch sizes of the requests coalesced into one Run.
+  int64_t max_batch_size = 8;
+
+  // How long the first request of a batch waits for compatible requests to join it.
+  std::chrono::microseconds max_queue_delay{500};
+
+  // Options of the coalesced Run calls.
+  RunOptions run_options;
+};
+
+namespace dynamic_batching {
+
+// Concatenates CPU tensors that only differ in their first dimension along that dimension.
+Status ConcatenateBatch(gsl::span<const OrtValue* const> values, const AllocatorPtr& allocator, OrtValue& result);
+
+// Copies rows [offset, offset + count) of the first dimension of a CPU tensor to a new tensor.
+Status SliceBatch(const OrtValue& value, int64_t offset, int64_t count, const AllocatorPtr& allocator,
+                  OrtValue& result);
+
+}  // namespace dynamic_batching
+
+/**
+ * Dynamic batching of concurrent Run requests on top of InferenceSession::Run.
+ *
+ * Callers on any thread submit requests with Run(), which blocks until the outputs of the request are available.
+ * A worker thread takes the oldest queued request and waits up to max_queue_delay for compatible requests,
+ * ones with the same feed names, output names, element types and non-batch dimensions. The feeds of the batch
+ * are concatenated along the batch dimension, the session is run once and the outputs are split back to the
+ * callers, so the per Run overhead is paid once per batch instead of once per request.
+ *
+ * The batch dimension is the first dimension of every input. Initialize() checks that it is symbolic and the
+ * same for all the inputs. Only the outputs whose first dimension is that same symbolic dimension can be fetched.
+ * Feeds must be CPU tensors of non-string types.
+ */
+class DynamicBatcher {
+ public:
+  // `session` must be initialized and outlive this instance.
+  DynamicBatcher(InferenceSession& session, const DynamicBatcherOptions& options);
+
+  // Fails the requests that are still queued and stops the worker thread.
+  ~DynamicBatcher();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(DynamicBatcher);
+
+  // Validates the batch dimension of the model inputs and outputs and starts the worker thread.
+  Status Initialize();
+
+  // Queues a request and waits for its outputs. Thread safe.
+  Status Run(const NameMLValMap& feeds, gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches);
+
+ private:
+  struct Request {
+    InlinedVector<std::string> feed_names;  // sorted
+    InlinedVector<OrtValue> feeds;          // in the order of feed_names
+    std::vector<std::string> output_names;
+    int64_t batch_size = 0;
+    std::vector<OrtValue>* fetches = nullptr;
+    std::promise<Status> done;
+  };
+
+  static bool IsCompatible(const Request& a, const Request& b);
+
+  void WorkerLoop();
+
+  // Takes the oldest request and the compatible ones that arrive within max_queue_delay out of the queue.
+  // Returns an empty batch when stopping.
+  std::vector<std::unique_ptr<Request>> NextBatch();
+
+  Status RunBatch(std::vector<std::unique_ptr<Request>>& batch);
+
+  InferenceSession& session_;
+  const DynamicBatcherOptions options_;
+  AllocatorPtr allocator_;
+
+  InlinedHashSet<std::string> batched_outputs_;  // outputs whose first dimension is the batch dimension
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::unique_ptr<Request>> queue_;
+  bool stop_ = false;
+  std::thread worker_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,221 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/graph_capture_buckets.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/common/parse_string.h"
+#include "core/common/string_utils.h"
+#include "core/framework/run_options.h"
+#include "core/framework/session_state.h"
+#include "core/framework/tensor.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/session/onnxruntime_run_options_config_keys.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Runs without graph capture use this annotation id, see kOrtRunOptionsConfigCudaGraphAnnotation.
+constexpr const char* kGraphAnnotationSkip = "-1";
+
+RunOptions WithGraphAnnotation(const RunOptions& run_options, const std::string& graph_annotation_id) {
+  RunOptions result = run_options;
+  ORT_THROW_IF_ERROR(result.config_options.AddConfigEntry(kOrtRunOptionsConfigCudaGraphAnnotation,
+                                                          graph_annotation_id.c_str()));
+  return result;
+}
+
+}  // namespace
+
+GraphCaptureBuckets::GraphCaptureBuckets(const SessionState& session_state, const OrtDevice& device,
+                                         std::vector<int64_t> buckets, size_t max_graphs)
+    : session_state_(session_state),
+      device_(device),
+      buckets_(std::move(buckets)),
+      max_graphs_(max_graphs),
+      device_allocator_(session_state.GetAllocator(device)),
+      cpu_allocator_(session_state.GetAllocator(OrtDevice())) {
+  ORT_ENFORCE(!buckets_.empty() && std::is_sorted(buckets_.begin(), buckets_.end()),
+              "The graph capture buckets must be ascending.");
+  ORT_ENFORCE(device_allocator_ != nullptr && cpu_allocator_ != nullptr,
+              "The graph capture buckets require allocators for ", device_.ToString(), " and the CPU.");
+
+  for (const auto* input : session_state.GetGraphViewer().GetInputs()) {
+    const auto* shape = input->Shape();
+    if (shape != nullptr && shape->dim_size() > 0 && !utils::HasDimValue(shape->dim(0))) {
+      batch_input_names_.insert(input->Name());
+    }
+  }
+}
+
+Status GraphCaptureBuckets::ParseBuckets(const std::string& buckets_str, std::vector<int64_t>& buckets) {
+  buckets.clear();
+  for (const auto bucket_str : utils::SplitString(buckets_str, ",")) {
+    int64_t bucket = 0;
+    ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(bucket_str, bucket) && bucket > 0 &&
+                          (buckets.empty() || bucket > buckets.back()),
+                      "The graph capture buckets must be ascending positive integers: ", buckets_str);
+    buckets.push_back(bucket);
+  }
+
+  ORT_RETURN_IF(buckets.empty(), "No graph capture bucket in: ", buckets_str);
+  return Status::OK();
+}
+
+size_t GraphCaptureBuckets::NumGraphs() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return buckets_in_use_.size();
+}
+
+int64_t GraphCaptureBuckets::GetBucketBatchSize(gsl::span<const std::string> feed_names,
+                                                gsl::span<const OrtValue> feeds) const {
+  int64_t batch_size = -1;
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    if (!feeds[i].IsTensor() || feeds[i].Get<Tensor>().IsDataTypeString()) {
+      return 0;
+    }
+
+    if (batch_input_names_.count(feed_names[i]) == 0) {
+      continue;
+    }
+
+    const auto& shape = feeds[i].Get<Tensor>().Shape();
+    if (shape.NumDimensions() == 0 || shape[0] <= 0 || (batch_size != -1 && shape[0] != batch_size)) {
+      return 0;
+    }
+    batch_size = shape[0];
+  }
+
+  if (batch_size == -1) {
+    return -1;
+  }
+
+  const auto bucket = std::lower_bound(buckets_.begin(), buckets_.end(), batch_size);
+  return bucket == buckets_.end() ? 0 : *bucket;
+}
+
+Status GraphCaptureBuckets::CreateBucket(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                         int64_t batch_size, Bucket& bucket) {
+  bucket.graph_annotation_id = next_graph_annotation_id_++;
+  bucket.batch_size = batch_size;
+  bucket.feeds.resize(feeds.size());
+
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    const Tensor& feed = feeds[i].Get<Tensor>();
+    TensorShape shape = feed.Shape();
+    if (batch_size != -1 && batch_input_names_.count(feed_names[i]) > 0) {
+      shape[0] = batch_size;
+    }
+
+    // zero the buffer once so that the padded rows hold valid numbers
+    Tensor zeros(feed.DataType(), shape, cpu_allocator_);
+    std::memset(zeros.MutableDataRaw(), 0, zeros.SizeInBytes());
+    Tensor::InitOrtValue(feed.DataType(), shape, device_allocator_, bucket.feeds[i]);
+    ORT_RETURN_IF_ERROR(session_state_.GetDataTransferMgr().CopyTensor(zeros,
+                                                                       *bucket.feeds[i].GetMutable<Tensor>()));
+  }
+
+  return Status::OK();
+}
+
+Status GraphCaptureBuckets::CopyToBuffer(const Tensor& src, Tensor& dst) const {
+  Tensor dst_rows(src.DataType(), src.Shape(), dst.MutableDataRaw(), dst.Location());
+  return session_state_.GetDataTransferMgr().CopyTensor(src, dst_rows);
+}
+
+Status GraphCaptureBuckets::CopyFromBuffer(const Tensor& src, int64_t batch_size, int64_t padded_batch_size,
+                                           OrtValue& dst) const {
+  TensorShape shape = src.Shape();
+  if (padded_batch_size != -1 && shape.NumDimensions() > 0 && shape[0] == padded_batch_size) {
+    shape[0] = batch_size;
+  }
+
+  const Tensor src_rows(src.DataType(), shape, const_cast<void*>(src.DataRaw()), src.Location());
+  Tensor::InitOrtValue(src.DataType(), shape, cpu_allocator_, dst);
+  return session_state_.GetDataTransferMgr().CopyTensor(src_rows, *dst.GetMutable<Tensor>());
+}
+
+Status GraphCaptureBuckets::Run(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                                gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                                std::vector<OrtValue>& fetches, const RunFn& run,
+                                const ReleaseGraphFn& release_graph) {
+  const int64_t padded_batch_size = GetBucketBatchSize(feed_names, feeds);
+  if (padded_batch_size == 0) {
+    std::vector<OrtDevice> cpu_devices(output_names.size(), OrtDevice());
+    return run(WithGraphAnnotation(run_options, kGraphAnnotationSkip), feeds, fetches, cpu_devices);
+  }
+
+  std::string key;
+  int64_t batch_size = -1;
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    const Tensor& feed = feeds[i].Get<Tensor>();
+    key.append(feed_names[i]).append(":").append(std::to_string(feed.GetElementType()));
+    const bool is_batch_input = padded_batch_size != -1 && batch_input_names_.count(feed_names[i]) > 0;
+    const auto dims = feed.Shape().GetDims();
+    for (size_t dim = 0; dim < dims.size(); ++dim) {
+      const int64_t dim_value = dim == 0 && is_batch_input ? padded_batch_size : dims[dim];
+      key.append(dim == 0 ? "[" : ",").append(std::to_string(dim_value));
+    }
+    key.append("];");
+    if (is_batch_input) {
+      batch_size = dims[0];
+    }
+  }
+  for (const auto& name : output_names) {
+    key.append(name).append(";");
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+
+  auto entry = index_.find(key);
+  if (entry != index_.end()) {
+    buckets_in_use_.splice(buckets_in_use_.begin(), buckets_in_use_, entry->second);
+  } else {
+    if (max_graphs_ > 0 && buckets_in_use_.size() >= max_graphs_) {
+      const Bucket& lru = buckets_in_use_.back();
+      ORT_RETURN_IF_ERROR(release_graph(lru.graph_annotation_id));
+      index_.erase(lru.key);
+      buckets_in_use_.pop_back();
+    }
+
+    Bucket bucket;
+    bucket.key = key;
+    ORT_RETURN_IF_ERROR(CreateBucket(feed_names, feeds, padded_batch_size, bucket));
+    buckets_in_use_.push_front(std::move(bucket));
+    index_.emplace(std::move(key), buckets_in_use_.begin());
+  }
+
+  Bucket& bucket = buckets_in_use_.front();
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    ORT_RETURN_IF_ERROR(CopyToBuffer(feeds[i].Get<Tensor>(), *bucket.feeds[i].GetMutable<Tensor>()));
+  }
+
+  const std::vector<OrtDevice> fetches_device(output_names.size(), device_);
+  if (bucket.fetches.empty()) {
+    // The shapes of the outputs are only known after a Run, so a first Run without graph capture allocates the
+    // fetch buffers the captured graph writes to.
+    Status status = run(WithGraphAnnotation(run_options, kGraphAnnotationSkip), bucket.feeds, bucket.fetches,
+                        fetches_device);
+    if (!status.IsOK()) {
+      index_.erase(bucket.key);
+      buckets_in_use_.pop_front();
+      return status;
+    }
+  }
+
+  ORT_RETURN_IF_ERROR(run(WithGraphAnnotation(run_options, std::to_string(bucket.graph_annotation_id)),
+                          bucket.feeds, bucket.fetches, fetches_device));
+
+  fetches.resize(output_names.size());
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    ORT_RETURN_IF_ERROR(CopyFromBuffer(bucket.fetches[i].Get<Tensor>(), batch_size, padded_batch_size, fetches[i]));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class SessionState;
+struct RunOptions;
+
+/**
+ * Graph capture for inputs of a variable batch size, see kOrtSessionOptionsConfigGraphCaptureBatchBuckets.
+ *
+ * Graph capture requires the feeds and fetches of the captured Runs to stay at the same device addresses. For each
+ * shape bucket, i.e. the feed shapes with the batch dimension padded to a bucket size and the output names, the
+ * session owns device buffers for the feeds and fetches. A Run copies its feeds into the first rows of the feed
+ * buffers, runs the graph of the bucket with them, which captures it the first time and replays it afterwards, and
+ * copies the first rows of the fetch buffers to CPU outputs.
+ *
+ * The number of captured graphs can be bounded, the least recently used bucket is then released.
+ */
+class GraphCaptureBuckets {
+ public:
+  // Runs the graph with the given run options, feeds and fetches, placing the outputs on the given devices.
+  using RunFn = std::function<Status(const RunOptions& run_options, gsl::span<const OrtValue> feeds,
+                                     std::vector<OrtValue>& fetches, const std::vector<OrtDevice>& fetches_device)>;
+  // Releases the captured graph of an annotation id.
+  using ReleaseGraphFn = std::function<Status(int graph_annotation_id)>;
+
+  // `buckets` are the ascending batch sizes, `device` is the device of the EP whose graphs are captured.
+  // `max_graphs` bounds the number of captured graphs, 0 means no bound.
+  GraphCaptureBuckets(const SessionState& session_state, const OrtDevice& device, std::vector<int64_t> buckets,
+                      size_t max_graphs);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GraphCaptureBuckets);
+
+  // Parses the comma separated bucket sizes of kOrtSessionOptionsConfigGraphCaptureBatchBuckets.
+  static Status ParseBuckets(const std::string& buckets_str, std::vector<int64_t>& buckets);
+
+  // Runs the feeds with the graph of their bucket. `fetches` must be empty or only contain unallocated values.
+  // Runs whose feeds don't fit in a bucket are run without graph capture.
+  Status Run(const RunOptions& run_options, gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+             gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches,
+             const RunFn& run, const ReleaseGraphFn& release_graph);
+
+  size_t NumGraphs() const;
+
+  // The first graph annotation id used by the buckets.
+  static constexpr int kFirstGraphAnnotationId = 65536;
+
+ private:
+  struct Bucket {
+    std::string key;
+    int graph_annotation_id;
+    int64_t batch_size;  // padded batch size, -1 if the feeds have no batch dimension
+    std::vector<OrtValue> feeds;
+    std::vector<OrtValue> fetches;
+  };
+
+  // Returns the padded batch size for the feeds, -1 if they have no batch dimension, or 0 if they don't fit in a
+  // bucket.
+  int64_t GetBucketBatchSize(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds) const;
+
+  Status CreateBucket(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds, int64_t batch_size,
+                      Bucket& bucket);
+
+  // Copies `src` to the first rows of `dst`.
+  Status CopyToBuffer(const Tensor& src, Tensor& dst) const;
+
+  // Copies the first `batch_size` rows of `src` to a new CPU tensor if the first dimension of `src` is
+  // `padded_batch_size`, or all of `src` otherwise.
+  Status CopyFromBuffer(const Tensor& src, int64_t batch_size, int64_t padded_batch_size, OrtValue& dst) const;
+
+  const SessionState& session_state_;
+  const OrtDevice device_;
+  const std::vector<int64_t> buckets_;
+  const size_t max_graphs_;
+  const AllocatorPtr device_allocator_;
+  const AllocatorPtr cpu_allocator_;
+
+  // names of the graph inputs whose first dimension is symbolic
+  InlinedHashSet<std::string> batch_input_names_;
+
+  // held during the bucketed Runs, the buffers of a bucket can only be used by one Run at a time
+  mutable OrtMutex mutex_;
+  std::list<Bucket> buckets_in_use_;  // most recently used first
+  InlinedHashMap<std::string, std::list<Bucket>::iterator> index_;
+  int next_graph_annotation_id_ = kFirstGraphAnnotationId;
+};
+
+}  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <list>
@@ -42,6 +43,7 @@
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/layout_transformation/layout_transformation.h"
 #include "core/optimizer/insert_cast_transformer.h"
+#include "core/optimizer/pipeline_stage_extraction.h"
 #include "core/optimizer/qdq_transformer/ensure_unique_dq_for_node_unit.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/optimizer/selectors_actions/selector_action_transformer_apply_contexts.h"
@@ -69,8 +71,10 @@
 #include "core/session/user_logging_sink.h"
 #include "core/session/IOBinding.h"
 #include "core/session/inference_session_utils.h"
+#include "core/session/model_composition.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
+#include "core/session/optimized_model_cache.h"
 #include "core/util/protobuf_parsing_utils.h"
 #include "core/util/thread_utils.h"
 
@@ -486,6 +490,11 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
 
   use_per_session_threads_ = session_options.use_per_session_threads;
   force_spinning_stop_between_runs_ = session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigForceSpinningStop, "0") == "1";
+  const std::string intra_op_thread_pool_priority = session_options_.config_options.GetConfigOrDefault(
+      kOrtSessionOptionsConfigIntraOpThreadPoolPriority, "normal");
+  ORT_ENFORCE(concurrency::ThreadPool::TryParsePriority(intra_op_thread_pool_priority, intra_op_thread_pool_priority_),
+              "Invalid value for ", kOrtSessionOptionsConfigIntraOpThreadPoolPriority, ": ",
+              intra_op_thread_pool_priority);
 
   if (use_per_session_threads_) {
     LOGS(*session_logger_, INFO) << "Creating and using per session threadpools since use_per_session_threads_ is true";
@@ -505,6 +514,8 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         // If the thread pool can use all the processors, then
         // we set affinity of each thread to each processor.
         to.allow_spinning = allow_intra_op_spinning;
+        to.spin_duration_us =
+            std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpSpinDurationUs, "-1"));
         to.dynamic_block_base_ = std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBlockBase, "0"));
         LOGS(*session_logger_, INFO) << "Dynamic block base set to " << to.dynamic_block_base_;
 
@@ -518,6 +529,8 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         to.auto_set_affinity = to.thread_pool_size == 0 &&
                                session_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL &&
                                to.affinity_str.empty();
+        to.numa_aware_scheduling =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpNumaAwareScheduling, "0") == "1";
 
         if (to.custom_create_thread_fn) {
           ORT_ENFORCE(to.custom_join_thread_fn, "custom join thread function not set for intra op thread pool");
@@ -570,6 +583,11 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
   }
 
   session_profiler_.Initialize(session_logger_);
+  profiling::HardwareCounterMask hardware_counters = 0;
+  ORT_THROW_IF_ERROR(profiling::ParseHardwareCounters(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfilingHardwareCounters, ""),
+      hardware_counters));
+  session_profiler_.SetHardwareCounters(hardware_counters);
   if (session_options_.enable_profiling) {
     StartProfiling(session_options_.profile_file_prefix);
   }
@@ -704,6 +722,11 @@ InferenceSession::InferenceSession(const SessionOptions& session_options, const
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 InferenceSession::~InferenceSession() {
+  if (initializer_prefault_thread_.joinable()) {
+    stop_initializer_prefault_ = true;
+    initializer_prefault_thread_.join();
+  }
+
   if (session_options_.enable_profiling) {
     ORT_TRY {
       EndProfiling();
@@ -723,6 +746,39 @@ InferenceSession::~InferenceSession() {
     }
   }
 
+#if !defined(ORT_MINIMAL_BUILD)
+  const std::string tuning_results_cache_dir =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigTuningResultsCacheDir, "");
+  if (is_inited_ && !tuning_results_cache_dir.empty()) {
+    ORT_TRY {
+      for (const auto& provider : execution_providers_) {
+        const auto* tuning_ctx = provider->GetTuningContext();
+        if (tuning_ctx == nullptr) {
+          continue;
+        }
+
+        auto results = tuning_ctx->GetTuningResults();
+        if (results.results.empty()) {
+          continue;
+        }
+
+        const auto cache_file = inference_session_utils::GetTuningResultsCacheFile(
+            tuning_results_cache_dir, provider->Type(), results.validators);
+        auto status = inference_session_utils::SaveTuningResultsToFile(cache_file, results);
+        if (!status.IsOK()) {
+          LOGS(*session_logger_, WARNING) << "Failed to cache the TuningResults of " << provider->Type() << ": "
+                                          << status.ErrorMessage();
+        }
+      }
+    }
+    ORT_CATCH(const std::exception& e) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        LOGS(*session_logger_, WARNING) << "Failed to cache the TuningResults: " << e.what();
+      });
+    }
+  }
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
   // Unregister the session and ETW callbacks
 #ifdef _WIN32
   std::lock_guard<OrtMutex> lock(active_sessions_mutex_);
@@ -891,10 +947,25 @@ common::Status InferenceSession::SaveToOrtFormat(const std::filesystem::path& fi
   fbs_buffer_size = ((fbs_buffer_size + m_bytes - 1) / m_bytes) * m_bytes;
   flatbuffers::FlatBufferBuilder builder(fbs_buffer_size);
 
+  const std::string initializer_compression_str = session_options_.config_options.GetConfigOrDefault(
+      kOrtSessionOptionsConfigSaveOrtFormatInitializerCompression, "none");
+  fbs::TensorDataCompression initializer_compression;
+  if (initializer_compression_str == "none") {
+    initializer_compression = fbs::TensorDataCompression::NONE;
+  } else if (initializer_compression_str == "lz4") {
+    initializer_compression = fbs::TensorDataCompression::LZ4;
+  } else if (initializer_compression_str == "byte_shuffle_lz4") {
+    initializer_compression = fbs::TensorDataCompression::BYTE_SHUFFLE_LZ4;
+  } else {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                           kOrtSessionOptionsConfigSaveOrtFormatInitializerCompression, ": ",
+                           initializer_compression_str);
+  }
+
   auto ort_model_version = builder.CreateString(std::to_string(kOrtModelVersion));
   flatbuffers::Offset<fbs::Model> fbs_model;
   ORT_RETURN_IF_ERROR(
-      model_->SaveToOrtFormat(builder, fbs_model));
+      model_->SaveToOrtFormat(builder, fbs_model, initializer_compression));
 
   flatbuffers::Offset<fbs::KernelTypeStrResolver> fbs_kernel_type_str_resolver;
   KernelTypeStrResolver kernel_type_str_resolver{};
@@ -908,10 +979,14 @@ common::Status InferenceSession::SaveToOrtFormat(const std::filesystem::path& fi
   ORT_RETURN_IF_ERROR(
       kernel_type_str_resolver.SaveToOrtFormat(builder, fbs_kernel_type_str_resolver));
 
+  flatbuffers::Offset<fbs::ExecutionPlan> fbs_execution_plan;
+  ORT_RETURN_IF_ERROR(session_state_->SaveExecutionPlanToOrtFormat(builder, fbs_execution_plan));
+
   fbs::InferenceSessionBuilder sb(builder);
   sb.add_ort_version(ort_model_version);
   sb.add_model(fbs_model);
   sb.add_kernel_type_str_resolver(fbs_kernel_type_str_resolver);
+  sb.add_execution_plan(fbs_execution_plan);
   auto session = sb.Finish();
   builder.Finish(session, fbs::InferenceSessionIdentifier());
 
@@ -926,6 +1001,229 @@ common::Status InferenceSession::SaveToOrtFormat(const std::filesystem::path& fi
   return Status::OK();
 }
 
+common::Status InferenceSession::UseOptimizedModelCache() {
+  const std::string cache_dir =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigOptimizedModelCacheDir, "");
+  if (cache_dir.empty() || !ort_format_model_bytes_.empty()) {
+    return Status::OK();
+  }
+
+  if (!session_options_.optimized_model_filepath.empty()) {
+    LOGS(*session_logger_, WARNING) << "The optimized model cache is not used as optimized_model_filepath is set.";
+    return Status::OK();
+  }
+
+  for (const auto& ep : execution_providers_) {
+    if (!optimized_model_cache::IsSupportedExecutionProvider(ep->Type())) {
+      LOGS(*session_logger_, INFO) << "The optimized model cache is not used with the " << ep->Type() << ".";
+      return Status::OK();
+    }
+  }
+
+  std::string key;
+  if (const auto status = optimized_model_cache::ComputeKey(*model_, session_options_, execution_providers_,
+                                                            optimizers_to_disable_, key);
+      !status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "The optimized model cache is not used: " << status.ErrorMessage();
+    return Status::OK();
+  }
+
+  const std::filesystem::path cache_path = std::filesystem::path(ToPathString(cache_dir)) / ToPathString(key + ".ort");
+  std::error_code error_code;
+  if (!std::filesystem::exists(cache_path, error_code)) {
+    LOGS(*session_logger_, INFO) << "The optimized model will be saved to the cache as "
+                                 << ORT_TSTR_CONVERT_TO_PRINTABLE_STRING(cache_path.native());
+    optimized_model_cache_path_ = cache_path;
+    return Status::OK();
+  }
+
+  // Replace the ONNX model with the cached one, or keep it if the cached model can't be loaded.
+  std::shared_ptr<Model> onnx_model;
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    onnx_model = std::move(model_);
+    is_model_loaded_ = false;
+  }
+  const PathString onnx_model_location = model_location_;
+
+  if (const auto status = LoadOrtModel(cache_path.native()); !status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "Failed to load the optimized model "
+                                    << ORT_TSTR_CONVERT_TO_PRINTABLE_STRING(cache_path.native())
+                                    << " from the cache: " << status.ErrorMessage();
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    model_ = std::move(onnx_model);
+    model_location_ = onnx_model_location;
+    ort_format_model_bytes_ = gsl::span<const uint8_t>();
+    std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+    ORT_RETURN_IF_ERROR(SaveModelMetadata(*model_));
+    is_model_loaded_ = true;
+    return Status::OK();
+  }
+
+  LOGS(*session_logger_, INFO) << "Loaded the optimized model from the cache: "
+                               << ORT_TSTR_CONVERT_TO_PRINTABLE_STRING(cache_path.native());
+  return Status::OK();
+}
+
+void InferenceSession::SaveToOptimizedModelCache() const {
+  if (session_state_->GetFuncMgr().NumFuncs() > 0) {
+    LOGS(*session_logger_, WARNING) << "The optimized model is not saved to the cache as it contains compiled nodes.";
+    return;
+  }
+
+  // Save to a file unique to this session, then rename it, so other sessions never load a partially written model.
+  static std::atomic<uint32_t> save_count{0};
+  std::filesystem::path temp_path = optimized_model_cache_path_;
+  temp_path += ToPathString("." + std::to_string(Env::Default().GetSelfPid()) + "." +
+                            std::to_string(save_count++) + ".tmp");
+
+  std::error_code error_code;
+  std::filesystem::create_directories(optimized_model_cache_path_.parent_path(), error_code);
+
+  Status status = SaveToOrtFormat(temp_path);
+  if (status.IsOK()) {
+    std::filesystem::rename(temp_path, optimized_model_cache_path_, error_code);
+    if (error_code) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, error_code.message());
+    }
+  }
+
+  if (!status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "Failed to save the optimized model to the cache: " << status.ErrorMessage();
+    std::filesystem::remove(temp_path, error_code);
+  }
+}
+
+common::Status InferenceSession::AddPartialRunCutValues(Graph& graph) {
+  const std::string cut_values =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigPartialRunCutValues, "");
+  if (cut_values.empty()) {
+    return Status::OK();
+  }
+
+  std::vector<const NodeArg*> outputs = graph.GetOutputs();
+  for (const auto cut_value : utils::SplitString(cut_values, ",")) {
+    std::string name{cut_value};
+    ORT_RETURN_IF(graph.GetProducerNode(name) == nullptr, "The partial run cut value '", name,
+                  "' is not produced by a node of the main graph.");
+
+    const NodeArg* node_arg = graph.GetNodeArg(name);
+    if (std::find(outputs.cbegin(), outputs.cend(), node_arg) == outputs.cend()) {
+      outputs.push_back(node_arg);
+    }
+
+    partial_run_cut_values_.insert(std::move(name));
+  }
+
+  graph.SetOutputs(outputs);
+  return Status::OK();
+}
+
+common::Status InferenceSession::FinalizePartialRunCutValues(const Graph& graph) {
+  for (const auto& name : partial_run_cut_values_) {
+    // a Run feeding the cut value skips its producer, so the producer must not have other outputs that are needed
+    const Node* producer = graph.GetProducerNode(name);
+    ORT_RETURN_IF(producer == nullptr, "The partial run cut value '", name,
+                  "' is not produced by a node of the optimized graph.");
+    for (const auto* output_def : producer->OutputDefs()) {
+      if (!output_def->Exists() || partial_run_cut_values_.count(output_def->Name()) != 0) {
+        continue;
+      }
+
+      ORT_RETURN_IF(graph.IsOutput(output_def) || !graph.GetConsumerNodes(output_def->Name()).empty(),
+                    "The partial run cut value '", name, "' can't be fed as the node producing it, ",
+                    producer->Name(), ", also produces '", output_def->Name(), "', which isn't a cut value.");
+    }
+
+    const auto output = output_def_map_.find(name);
+    ORT_RETURN_IF(output == output_def_map_.end(), "The partial run cut value '", name, "' is not a graph output.");
+    input_def_map_.insert_or_assign(output->first, output->second);
+  }
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::AddEarlyExitPoints(Graph& graph) {
+  const std::string exit_points =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigEarlyExitPoints, "");
+  if (exit_points.empty()) {
+    return Status::OK();
+  }
+
+  std::vector<const NodeArg*> outputs = graph.GetOutputs();
+  for (const auto* output : outputs) {
+    early_exit_graph_outputs_.push_back(output->Name());
+  }
+
+  const auto add_output = [&graph, &outputs](std::string_view name) -> const NodeArg* {
+    const NodeArg* node_arg = graph.GetNodeArg(std::string{name});
+    if (node_arg == nullptr || graph.GetProducerNode(node_arg->Name()) == nullptr) {
+      return nullptr;
+    }
+
+    if (std::find(outputs.cbegin(), outputs.cend(), node_arg) == outputs.cend()) {
+      outputs.push_back(node_arg);
+    }
+
+    return node_arg;
+  };
+
+  const size_t num_graph_outputs = early_exit_graph_outputs_.size();
+  for (const auto exit_point : utils::SplitString(exit_points, ";")) {
+    const auto separator = exit_point.find(':');
+    ORT_RETURN_IF(separator == std::string_view::npos, "The early exit point '", exit_point,
+                  "' must have the format 'predicate:output1,output2'.");
+
+    const auto predicate = exit_point.substr(0, separator);
+    const NodeArg* predicate_arg = add_output(predicate);
+    ORT_RETURN_IF(predicate_arg == nullptr, "The early exit predicate '", predicate,
+                  "' is not produced by a node of the main graph.");
+    ORT_RETURN_IF(predicate_arg->TypeAsProto() != nullptr &&
+                      predicate_arg->TypeAsProto()->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_BOOL,
+                  "The early exit predicate '", predicate, "' must be a boolean tensor.");
+
+    std::vector<std::string> exit_outputs;
+    for (const auto output : utils::SplitString(exit_point.substr(separator + 1), ",")) {
+      const NodeArg* output_arg = add_output(output);
+      ORT_RETURN_IF(output_arg == nullptr, "The early exit output '", output,
+                    "' is not produced by a node of the main graph.");
+      exit_outputs.emplace_back(output_arg->Name());
+    }
+
+    ORT_RETURN_IF(exit_outputs.size() != num_graph_outputs, "The early exit point of '", predicate, "' has ",
+                  exit_outputs.size(), " outputs, but the model has ", num_graph_outputs);
+    for (size_t i = 0; i < num_graph_outputs; ++i) {
+      ORT_RETURN_IF(graph.GetNodeArg(exit_outputs[i])->Type() != outputs[i]->Type(), "The early exit output '",
+                    exit_outputs[i], "' doesn't have the type of the model output '", early_exit_graph_outputs_[i],
+                    "'.");
+    }
+
+    early_exit_points_.emplace_back(std::string{predicate}, std::move(exit_outputs));
+  }
+
+  graph.SetOutputs(outputs);
+  return Status::OK();
+}
+
+common::Status InferenceSession::ComposeModels(std::shared_ptr<Model>& model) {
+  const std::string stages =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigComposeModels, "");
+  if (stages.empty()) {
+    return Status::OK();
+  }
+
+  ONNX_NAMESPACE::ModelProto model_proto = model->ToProto();
+  ORT_RETURN_IF_ERROR(model_composition::Compose(stages, model_proto));
+
+  const bool strict_shape_type_inference = session_options_.config_options.GetConfigOrDefault(
+                                               kOrtSessionOptionsConfigStrictShapeTypeInference, "0") == "1";
+  ORT_RETURN_IF_ERROR(Model::Load(std::move(model_proto), model_location_, model,
+                                  HasLocalSchema() ? &custom_schema_registries_ : nullptr, *session_logger_,
+                                  ModelOptions(true, strict_shape_type_inference)));
+  models_composed_ = true;
+  return Status::OK();
+}
+
 common::Status InferenceSession::LoadWithLoader(std::function<common::Status(std::shared_ptr<Model>&)> loader,
                                                 const std::string& event_name) {
   Status status = Status::OK();
@@ -943,6 +1241,7 @@ common::Status InferenceSession::LoadWithLoader(std::function<common::Status(std
     std::shared_ptr<onnxruntime::Model> p_tmp_model;
     status = loader(p_tmp_model);
     ORT_RETURN_IF_ERROR_SESSIONID_(status);
+    ORT_RETURN_IF_ERROR_SESSIONID_(ComposeModels(p_tmp_model));
 
     model_ = p_tmp_model;
 
@@ -1177,17 +1476,18 @@ common::Status InferenceSession::Load() {
 common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool saving_model_in_ort_format) {
   // The transformer order:
   // 1. Ensure we inline as many functions as possible. We refer to it as Ahead Of Time (AOT) function inlining.
-  // 2. ensure potential QDQ node units have unique DQ nodes (required transformer).
+  // 2. keep the nodes of the pipeline stage of the session, if the model is split into pipeline stages.
+  // 3. ensure potential QDQ node units have unique DQ nodes (required transformer).
   //    - This is a required transformer as the ORT code has a hard requirement there are no overlapping QDQ node units.
   //    - We run it here in case optimizers are disabled.
-  // 3. run level 1 optimizations. these only use ONNX operators.
-  // 4. partition nodes based on EP capabilities. EPs may fuse nodes during this process.
-  // 5. run level 2+ optimizations. level 2 and 3 optimizations use contrib ops.
-  // 6. insert cast nodes (required transformer).
-  // 7. insert copy nodes (required transformer).
+  // 4. run level 1 optimizations. these only use ONNX operators.
+  // 5. partition nodes based on EP capabilities. EPs may fuse nodes during this process.
+  // 6. run level 2+ optimizations. level 2 and 3 optimizations use contrib ops.
+  // 7. insert cast nodes (required transformer).
+  // 8. insert copy nodes (required transformer).
 
   // Run Ahead Of time function inlining
-  GraphPartitioner partitioner(kernel_registry_manager_, execution_providers_);
+  GraphPartitioner partitioner(kernel_registry_manager_, execution_providers_, GetIntraOpThreadPoolToUse());
   if (const bool disable_aot_function_inlining =
           session_options_.config_options.GetConfigOrDefault(
               kOrtSessionOptionsDisableAheadOfTimeFunctionInlining, "0") == "1";
@@ -1204,6 +1504,25 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool
     return transformer.Apply(graph, modified, logger);
   };
 
+  // keep the nodes of the pipeline stage. it runs here as the stage must be extracted in case optimizers are disabled.
+  {
+    int64_t pipeline_num_stages = 1;
+    int64_t pipeline_stage = 0;
+    const std::string num_stages_str =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigPipelineNumStages, "1");
+    const std::string stage_str =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigPipelineStage, "0");
+    ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(num_stages_str, pipeline_num_stages) && pipeline_num_stages > 0,
+                      "Invalid value for ", kOrtSessionOptionsConfigPipelineNumStages, ": ", num_stages_str);
+    ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(stage_str, pipeline_stage) && pipeline_stage >= 0 &&
+                          pipeline_stage < pipeline_num_stages,
+                      "Invalid value for ", kOrtSessionOptionsConfigPipelineStage, ": ", stage_str);
+    if (pipeline_num_stages > 1) {
+      PipelineStageExtraction pipeline_stage_extraction{pipeline_num_stages, pipeline_stage};
+      ORT_RETURN_IF_ERROR_SESSIONID_(apply_transformer_once(pipeline_stage_extraction, *session_logger_, graph));
+    }
+  }
+
   // ensure potential QDQ node units have unique DQ nodes
   if (const bool disable_quant_qdq =
           session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsDisableQuantQDQ, "0") == "1";
@@ -1560,6 +1879,55 @@ static bool ModelHasFP16Inputs(const Graph& graph) {
   return false;
 }
 
+common::Status InferenceSession::ShareInitializersAcrossSessions(const onnxruntime::Graph& graph) {
+  // the shared copies live in CPU memory, so they can only be used as is if every consumer runs on CPU
+  InlinedHashMap<std::string_view, bool> used_on_cpu_only;
+  for (const auto& node : graph.Nodes()) {
+    const bool on_cpu = node.GetExecutionProviderType() == onnxruntime::kCpuExecutionProvider;
+    auto update = [&used_on_cpu_only, on_cpu](const NodeArg& input_def, size_t) {
+      auto [it, inserted] = used_on_cpu_only.try_emplace(input_def.Name(), on_cpu);
+      it->second = it->second && on_cpu;
+      return Status::OK();
+    };
+    ORT_RETURN_IF_ERROR(node.ForEachWithIndex(node.InputDefs(), update));
+    ORT_RETURN_IF_ERROR(node.ForEachWithIndex(node.ImplicitInputDefs(), update));
+  }
+
+  auto& shared_initializer_cache = environment_.GetSharedInitializerCache();
+  size_t num_shared_bytes = 0;
+
+  for (const auto& [name, tensor_proto] : graph.GetAllInitializedTensors()) {
+    // initializers supplied by the user are shared already, and external data is memory mapped
+    if (session_options_.initializers_to_share_map.count(name) > 0 || utils::HasExternalData(*tensor_proto) ||
+        tensor_proto->data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING ||
+        graph.IsOutput(graph.GetNodeArg(name))) {
+      continue;
+    }
+
+    auto it = used_on_cpu_only.find(name);
+    if (it == used_on_cpu_only.end() || !it->second) {
+      continue;
+    }
+
+    size_t size_in_bytes = 0;
+    ORT_RETURN_IF_ERROR(utils::GetSizeInBytesFromTensorProto<0>(*tensor_proto, &size_in_bytes));
+    if (size_in_bytes > static_cast<size_t>(std::numeric_limits<int>::max())) {
+      continue;
+    }
+
+    std::shared_ptr<const OrtValue> shared_value;
+    ORT_RETURN_IF_ERROR(shared_initializer_cache.GetOrCreate(Env::Default(), model_location_, *tensor_proto,
+                                                             shared_value));
+    session_options_.initializers_to_share_map[name] = shared_value.get();
+    initializers_shared_across_sessions_.push_back(std::move(shared_value));
+    num_shared_bytes += size_in_bytes;
+  }
+
+  LOGS(*session_logger_, INFO) << "Shared " << initializers_shared_across_sessions_.size() << " initializers ("
+                               << num_shared_bytes << " bytes) with the other sessions in the environment.";
+  return Status::OK();
+}
+
 common::Status InferenceSession::AddPrePackedWeightsContainer(PrepackedWeightsContainer* prepacked_weights_container) {
   if (prepacked_weights_container == nullptr) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
@@ -1576,6 +1944,82 @@ common::Status InferenceSession::AddPrePackedWeightsContainer(PrepackedWeightsCo
   return Status::OK();
 }
 
+common::Status InferenceSession::AddLoraAdapter(const std::string& adapter_name, NameMLValMap parameters) {
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    if (!is_inited_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Session must be initialized before adding a LoRA adapter.");
+    }
+  }
+
+  if (adapter_name.empty() || adapter_name.find(',') != std::string::npos) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid LoRA adapter name: '", adapter_name, "'");
+  }
+
+  InlinedVector<std::string> parameter_names;
+  InlinedVector<OrtValue> parameter_values;
+  parameter_names.reserve(parameters.size());
+  parameter_values.reserve(parameters.size());
+  for (const auto& [name, value] : parameters) {
+    parameter_names.push_back(name);
+    parameter_values.push_back(value);
+  }
+  ORT_RETURN_IF_ERROR(ValidateInputs(parameter_names, parameter_values));
+
+  std::lock_guard<onnxruntime::OrtMutex> l(lora_adapters_mutex_);
+  if (!lora_adapters_.try_emplace(adapter_name, std::make_shared<const NameMLValMap>(std::move(parameters))).second) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "A LoRA adapter named ", adapter_name,
+                           " was already added.");
+  }
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::RemoveLoraAdapter(const std::string& adapter_name) {
+  std::lock_guard<onnxruntime::OrtMutex> l(lora_adapters_mutex_);
+  if (lora_adapters_.erase(adapter_name) == 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "No LoRA adapter named ", adapter_name, " was added.");
+  }
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::AddLoraAdapterFeeds(const std::string& active_lora_adapters,
+                                                     gsl::span<const std::string> feed_names,
+                                                     gsl::span<const OrtValue> feeds,
+                                                     InlinedVector<std::string>& feed_names_with_adapters,
+                                                     InlinedVector<OrtValue>& feeds_with_adapters) const {
+  InlinedVector<std::shared_ptr<const NameMLValMap>> adapters;
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(lora_adapters_mutex_);
+    for (const auto adapter_name : utils::SplitString(active_lora_adapters, ",")) {
+      auto it = lora_adapters_.find(std::string(adapter_name));
+      if (it == lora_adapters_.end()) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "No LoRA adapter named ", adapter_name,
+                               " was added to the session.");
+      }
+      adapters.push_back(it->second);
+    }
+  }
+
+  feed_names_with_adapters.assign(feed_names.begin(), feed_names.end());
+  feeds_with_adapters.assign(feeds.begin(), feeds.end());
+
+  InlinedHashSet<std::string_view> fed_names(feed_names.begin(), feed_names.end());
+  for (const auto& adapter : adapters) {
+    for (const auto& [name, value] : *adapter) {
+      if (!fed_names.insert(name).second) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The LoRA adapter parameter ", name,
+                               " is fed more than once.");
+      }
+      feed_names_with_adapters.push_back(name);
+      feeds_with_adapters.push_back(value);
+    }
+  }
+
+  return Status::OK();
+}
+
 namespace {
 Status PartitionOrtFormatModel(onnxruntime::Graph& graph,
                                const ExecutionProviders& providers,
@@ -1599,7 +2043,7 @@ Status PartitionOrtFormatModel(onnxruntime::Graph& graph,
   }
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
-  GraphPartitioner partitioner(kernel_registry_manager, providers);
+  GraphPartitioner partitioner(kernel_registry_manager, providers, session_state.GetThreadPool());
   ORT_RETURN_IF_ERROR(partitioner.Partition(graph,
                                             session_state.GetMutableFuncMgr(),
                                             transform_layout_fn,
@@ -1677,6 +2121,11 @@ common::Status InferenceSession::Initialize() {
       have_cpu_ep = execution_providers_.Get(onnxruntime::kCpuExecutionProvider) != nullptr;
     }
 
+#if !defined(ORT_MINIMAL_BUILD)
+    // may replace model_, so it must happen before any reference to its graph is taken
+    ORT_RETURN_IF_ERROR_SESSIONID_(UseOptimizedModelCache());
+#endif
+
     // Verify that there are no external initializers in the graph if external data is disabled.
     onnxruntime::Graph& graph = model_->MainGraph();
 #ifdef DISABLE_EXTERNAL_INITIALIZERS
@@ -1694,6 +2143,8 @@ common::Status InferenceSession::Initialize() {
     if (!have_cpu_ep) {
       LOGS(*session_logger_, INFO) << "Adding default CPU execution provider.";
       CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena};
+      epi.use_large_pages =
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseLargePages, "0") == "1";
       auto p_cpu_exec_provider = std::make_unique<CPUExecutionProvider>(epi);
       ORT_RETURN_IF_ERROR_SESSIONID_(RegisterExecutionProvider(std::move(p_cpu_exec_provider)));
       execution_providers_.SetCpuProviderWasImplicitlyAdded(true);
@@ -1721,6 +2172,13 @@ common::Status InferenceSession::Initialize() {
     session_activity_started_ = true;
 #endif
 
+    const bool share_initializers_across_sessions =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigShareInitializersAcrossSessions,
+                                                           "0") == "1";
+    if (share_initializers_across_sessions && prepacked_weights_container_ == nullptr) {
+      prepacked_weights_container_ = &environment_.GetSharedPrepackedWeightsContainer();
+    }
+
     // now that we have all the execution providers, create the session state
     session_state_ = std::make_unique<SessionState>(
         model_->MainGraph(),
@@ -1747,6 +2205,31 @@ common::Status InferenceSession::Initialize() {
       }
     }
 
+#if !defined(ORT_MINIMAL_BUILD)
+    // The CPU EP has no provider options, so its TunableOp settings come from the session options.
+    if (auto* cpu_ep = execution_providers_.Get(onnxruntime::kCpuExecutionProvider); cpu_ep != nullptr) {
+      auto* tuning_ctx = cpu_ep->GetTuningContext();
+      const auto& config_options = session_options_.config_options;
+      if (tuning_ctx != nullptr &&
+          config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCpuTunableOpEnable, "0") == "1") {
+        tuning_ctx->EnableTunableOp();
+        if (config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCpuTunableOpTuningEnable, "0") == "1") {
+          tuning_ctx->EnableTuning();
+        }
+
+        const std::string max_tuning_duration_str =
+            config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCpuTunableOpMaxTuningDurationMs, "0");
+        int max_tuning_duration_ms = 0;
+        if (!TryParseStringWithClassicLocale<int>(max_tuning_duration_str, max_tuning_duration_ms)) {
+          ORT_RETURN_IF_ERROR_SESSIONID_(ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                                                         kOrtSessionOptionsConfigCpuTunableOpMaxTuningDurationMs, ": ",
+                                                         max_tuning_duration_str));
+        }
+        tuning_ctx->SetMaxTuningDurationMs(max_tuning_duration_ms);
+      }
+    }
+#endif
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
     // Don't want to pollute SessionState constructor since memory profile is enabled optionally.
     session_state_->SetMemoryProfiler(&memory_profiler_);
@@ -1763,8 +2246,16 @@ common::Status InferenceSession::Initialize() {
     ORT_RETURN_IF_ERROR_SESSIONID_(kernel_registry_manager_.RegisterKernels(execution_providers_));
 
     const bool loading_ort_format = !ort_format_model_bytes_.empty();
-    const bool saving_model = !session_options_.optimized_model_filepath.empty();
+#if !defined(ORT_MINIMAL_BUILD)
+    const bool saving_to_model_cache = !optimized_model_cache_path_.empty();
+#else
+    const bool saving_to_model_cache = false;
+#endif
+    const bool saving_model = !session_options_.optimized_model_filepath.empty() || saving_to_model_cache;
     const bool saving_ort_format = [&]() {
+      if (saving_to_model_cache) {
+        return true;
+      }
       if (saving_model) {
         const std::string model_type = session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSaveModelFormat, "");
         const bool has_explicit_type = !model_type.empty();
@@ -1775,6 +2266,22 @@ common::Status InferenceSession::Initialize() {
       return false;
     }();
 
+    // Check whether Run results can be cached before the graph is partitioned,
+    // as the nodes of compiled subgraphs can't be inspected afterwards.
+    size_t run_result_cache_size = 0;
+    const std::string run_result_cache_size_str =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigRunResultCacheSize, "0");
+    if (!TryParseStringWithClassicLocale<size_t>(run_result_cache_size_str, run_result_cache_size)) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                                                     kOrtSessionOptionsConfigRunResultCacheSize, ": ",
+                                                     run_result_cache_size_str));
+    }
+    if (run_result_cache_size > 0 && !RunResultCache::IsDeterministic(graph)) {
+      LOGS(*session_logger_, WARNING) << "The run result cache is disabled as the outputs of the model don't only "
+                                         "depend on its inputs.";
+      run_result_cache_size = 0;
+    }
+
     if (!loading_ort_format) {
 #if !defined(ORT_MINIMAL_BUILD)
       const auto minimal_build_opt_config_value = session_options_.config_options.GetConfigOrDefault(
@@ -1850,6 +2357,9 @@ common::Status InferenceSession::Initialize() {
       }
 #endif
 
+      ORT_RETURN_IF_ERROR_SESSIONID_(AddPartialRunCutValues(graph));
+      ORT_RETURN_IF_ERROR_SESSIONID_(AddEarlyExitPoints(graph));
+
       // apply any transformations to the main graph and any subgraphs
       ORT_RETURN_IF_ERROR_SESSIONID_(TransformGraph(graph, saving_ort_format));
 
@@ -1997,12 +2507,30 @@ common::Status InferenceSession::Initialize() {
 
       // Update temporary copies of metadata, input- and output definitions to the same state as the resolved graph
       ORT_RETURN_IF_ERROR_SESSIONID_(SaveModelMetadata(*model_));
+      ORT_RETURN_IF_ERROR_SESSIONID_(FinalizePartialRunCutValues(graph));
 #else   // !defined(ORT_MINIMAL_BUILD)
       ORT_RETURN_IF_ERROR_SESSIONID_(
           ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
                           "Loading anything other than ORT format models is not enabled in this build."));
 #endif  // !defined(ORT_MINIMAL_BUILD)
     } else {
+      if (!session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigPartialRunCutValues, "").empty()) {
+        ORT_RETURN_IF_ERROR_SESSIONID_(ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                                       "Partial run cut values are not supported for ORT format models."));
+      }
+
+      if (!session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigEarlyExitPoints, "").empty()) {
+        ORT_RETURN_IF_ERROR_SESSIONID_(ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                                       "Early exit points are not supported for ORT format models."));
+      }
+
+      // an optimized model loaded from the cache already contains the composed models
+      if (!models_composed_ &&
+          !session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigComposeModels, "").empty()) {
+        ORT_RETURN_IF_ERROR_SESSIONID_(ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                                                       "Composing models is not supported for ORT format models."));
+      }
+
       ORT_RETURN_IF_ERROR_SESSIONID_(PartitionOrtFormatModel(graph, execution_providers_, kernel_registry_manager_,
                                                              *session_state_, session_options_.config_options, *session_logger_));
 
@@ -2011,6 +2539,13 @@ common::Status InferenceSession::Initialize() {
       ORT_RETURN_IF_ERROR_SESSIONID_(
           ApplyOrtFormatModelRuntimeOptimizations(graph, *session_logger_, session_options_, optimizers_to_disable_, cpu_ep));
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
+
+      // ort_format_model_bytes_ was verified when loading the model and stays valid until the end of Initialize
+      session_state_->SetSavedExecutionPlan(fbs::GetInferenceSession(ort_format_model_bytes_.data())->execution_plan());
+    }
+
+    if (share_initializers_across_sessions) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(ShareInitializersAcrossSessions(graph));
     }
 
     ORT_RETURN_IF_ERROR_SESSIONID_(
@@ -2020,7 +2555,13 @@ common::Status InferenceSession::Initialize() {
                                              saving_ort_format));
 
 #if !defined(ORT_MINIMAL_BUILD)
-    if (saving_model) {
+    if (!early_exit_points_.empty()) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(session_state_->SetEarlyExits(early_exit_points_, early_exit_graph_outputs_));
+    }
+
+    if (saving_to_model_cache) {
+      SaveToOptimizedModelCache();
+    } else if (saving_model) {
       if (session_state_->GetFuncMgr().NumFuncs() > 0) {
         ORT_RETURN_IF_ERROR_SESSIONID_(
             ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
@@ -2064,11 +2605,94 @@ common::Status InferenceSession::Initialize() {
     if (found_tuning_results) {
       ORT_RETURN_IF_ERROR_SESSIONID_(SetTuningResults(tuning_results, /*error_on_invalid*/ false, /*auto_enable*/ true));
     }
+
+    const std::string tuning_results_cache_dir =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigTuningResultsCacheDir, "");
+    if (!tuning_results_cache_dir.empty()) {
+      for (const auto& provider : execution_providers_) {
+        auto* tuning_ctx = provider->GetTuningContext();
+        if (tuning_ctx == nullptr) {
+          continue;
+        }
+
+        const auto cache_file = inference_session_utils::GetTuningResultsCacheFile(
+            tuning_results_cache_dir, provider->Type(), tuning_ctx->GetTuningResultsValidator().GetAllValidators());
+        if (!std::filesystem::exists(cache_file)) {
+          continue;
+        }
+
+        // a stale or corrupted cache only costs tuning time, so it must not fail the session
+        TuningResults cached_results;
+        auto status = inference_session_utils::LoadTuningResultsFromFile(cache_file, cached_results);
+        if (status.IsOK()) {
+          status = tuning_ctx->LoadTuningResults(cached_results);
+        }
+        if (status.IsOK()) {
+          LOGS(*session_logger_, INFO) << "Loaded the TuningResults of " << provider->Type() << " from "
+                                       << cache_file.string();
+        } else {
+          LOGS(*session_logger_, WARNING) << "Ignoring the cached TuningResults of " << provider->Type() << ": "
+                                          << status.ErrorMessage();
+        }
+      }
+    }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
     // Resolve memory pattern flags of the main graph and subgraph session states
     ResolveMemoryPatternFlags(*session_state_);
 
+    if (run_result_cache_size > 0) {
+      if (cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled()) {
+        LOGS(*session_logger_, WARNING) << "The run result cache is disabled as graph capture is enabled.";
+      } else {
+        run_result_cache_ = std::make_unique<RunResultCache>(run_result_cache_size,
+                                                             session_state_->GetAllocator(OrtDevice()));
+      }
+    }
+
+    prune_execution_to_fetches_ =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigPruneExecutionToFetches, "0") == "1";
+
+    if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigEnableCpuGraphCapture, "0") == "1") {
+      Status capturable = CpuGraph::CheckCapturable(*session_state_);
+      if (cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled()) {
+        LOGS(*session_logger_, WARNING) << "CPU graph capture is disabled as the graph capture of "
+                                        << cached_execution_provider_for_graph_replay_.Type() << " is enabled.";
+      } else if (session_profiler_.IsEnabled() || session_options_.execution_mode != ExecutionMode::ORT_SEQUENTIAL) {
+        LOGS(*session_logger_, WARNING) << "CPU graph capture is disabled as it requires the sequential execution "
+                                           "mode without profiling.";
+      } else if (!capturable.IsOK()) {
+        LOGS(*session_logger_, WARNING) << "CPU graph capture is disabled: " << capturable.ErrorMessage();
+      } else {
+        cpu_graph_ = std::make_unique<CpuGraph>(*session_state_);
+      }
+    }
+
+    const std::string graph_capture_batch_buckets =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigGraphCaptureBatchBuckets, "");
+    if (!graph_capture_batch_buckets.empty()) {
+      if (!cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled()) {
+        LOGS(*session_logger_, WARNING) << "The graph capture buckets are ignored as no execution provider has graph "
+                                           "capture enabled.";
+      } else {
+        std::vector<int64_t> buckets;
+        ORT_RETURN_IF_ERROR_SESSIONID_(GraphCaptureBuckets::ParseBuckets(graph_capture_batch_buckets, buckets));
+
+        size_t max_graphs = 0;
+        const std::string max_graphs_str =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigGraphCaptureMaxGraphs, "0");
+        if (!TryParseStringWithClassicLocale<size_t>(max_graphs_str, max_graphs)) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                                 kOrtSessionOptionsConfigGraphCaptureMaxGraphs, ": ", max_graphs_str);
+        }
+
+        const OrtDevice device = cached_execution_provider_for_graph_replay_.cached_execution_provider_for_graph_replay_
+                                     ->GetOrtDeviceByMemType(OrtMemTypeDefault);
+        graph_capture_buckets_ = std::make_unique<GraphCaptureBuckets>(*session_state_, device, std::move(buckets),
+                                                                       max_graphs);
+      }
+    }
+
     is_inited_ = true;
 
     if (!using_ort_model_bytes_for_initializers_) {
@@ -2086,6 +2710,16 @@ common::Status InferenceSession::Initialize() {
         graph.DomainToVersionMap(), graph.Name(), model_->MetaData(),
         telemetry_.event_name_, execution_providers_.GetIds(), model_has_fp16_inputs, false);
 
+    if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigPrefaultInitializers, "0") == "1") {
+      // the session is usable right away, Runs that need a kernel before it is pre-packed here pre-pack it themselves
+      initializer_prefault_thread_ = std::thread([this]() {
+        Status prefault_status = session_state_->PrefaultConstantInitializers(stop_initializer_prefault_);
+        if (!prefault_status.IsOK()) {
+          LOGS(*session_logger_, WARNING) << "Failed to prefault the initializers: " << prefault_status.ErrorMessage();
+        }
+      });
+    }
+
     LOGS(*session_logger_, INFO) << "Session successfully initialized.";
   }
   ORT_CATCH(const NotImplementedException& ex) {
@@ -2124,6 +2758,40 @@ common::Status InferenceSession::Initialize() {
 #pragma warning(pop)
 #endif
 
+common::Status InferenceSession::Clone(const SessionOptions& clone_session_options,
+                                       std::unique_ptr<InferenceSession>& clone) const {
+  std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+  if (!is_inited_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The session must be initialized before it can be cloned.");
+  }
+
+  // the constructor creates the thread pools of the clone from its options
+  auto new_session = std::make_unique<InferenceSession>(clone_session_options, environment_);
+
+  // the kernels of the shared session state belong to these providers. the clone calls OnRunStart and OnRunEnd on them.
+  for (const auto& provider : execution_providers_) {
+    ORT_RETURN_IF_ERROR(new_session->execution_providers_.Add(provider->Type(), provider));
+  }
+
+  new_session->model_ = model_;
+  new_session->model_location_ = model_location_;
+  new_session->model_metadata_ = model_metadata_;
+  new_session->input_def_map_ = input_def_map_;
+  new_session->output_def_map_ = output_def_map_;
+  new_session->session_state_ = session_state_;
+  new_session->is_concurrent_run_supported_ = is_concurrent_run_supported_;
+  new_session->prune_execution_to_fetches_ = prune_execution_to_fetches_;
+  new_session->partial_run_cut_values_ = partial_run_cut_values_;
+  new_session->thread_pool_binding_ = ThreadPoolBinding{new_session->GetIntraOpThreadPoolToUse(),
+                                                        new_session->GetInterOpThreadPoolToUse()};
+  new_session->is_model_loaded_ = true;
+  new_session->is_inited_ = true;
+
+  LOGS(*session_logger_, INFO) << "Cloned the initialized session.";
+  clone = std::move(new_session);
+  return Status::OK();
+}
+
 int InferenceSession::GetCurrentNumRuns() const {
   return current_num_runs_.load();
 }
@@ -2458,6 +3126,14 @@ Status InferenceSession::Run(const RunOptions& run_options,
                              gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
                              gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
                              const std::vector<OrtDevice>* p_fetches_device_info) {
+  return RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info, nullptr);
+}
+
+Status InferenceSession::RunImpl(const RunOptions& run_options,
+                                 gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                 gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
+                                 const std::vector<OrtDevice>* p_fetches_device_info,
+                                 FeedsFetchesManager* frozen_feeds_fetches_manager) {
   TimePoint tp;
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
@@ -2490,8 +3166,81 @@ Status InferenceSession::Run(const RunOptions& run_options,
   auto* inter_tp = (control_spinning) ? inter_op_thread_pool_.get() : nullptr;
   ThreadPoolSpinningSwitch runs_refcounter_and_tp_spin_control(intra_tp, inter_tp, current_num_runs_);
 
-  // Check if this Run() is simply going to be a CUDA Graph replay.
-  if (cached_execution_provider_for_graph_replay_.IsGraphCaptured(graph_annotation_id)) {
+  auto intra_op_thread_pool_priority = intra_op_thread_pool_priority_;
+  const std::string run_intra_op_thread_pool_priority =
+      run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigIntraOpThreadPoolPriority, "");
+  if (!run_intra_op_thread_pool_priority.empty() &&
+      !concurrency::ThreadPool::TryParsePriority(run_intra_op_thread_pool_priority, intra_op_thread_pool_priority)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                           kOrtRunOptionsConfigIntraOpThreadPoolPriority, ": ", run_intra_op_thread_pool_priority);
+  }
+  concurrency::ThreadPool::PriorityScope intra_op_priority_scope(intra_op_thread_pool_priority);
+
+  auto deadline = concurrency::ThreadPool::Deadline::max();
+  const std::string latency_budget_str =
+      run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigLatencyBudgetUs, "");
+  if (!latency_budget_str.empty()) {
+    int64_t latency_budget_us = 0;
+    if (!TryParseStringWithClassicLocale<int64_t>(latency_budget_str, latency_budget_us) || latency_budget_us <= 0) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                             kOrtRunOptionsConfigLatencyBudgetUs, ": ", latency_budget_str);
+    }
+    deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(latency_budget_us);
+  }
+  concurrency::ThreadPool::DeadlineScope deadline_scope(deadline);
+  RunOptionsScope run_options_scope(&run_options);
+  // a cloned session runs the kernels of the shared session state on its own thread pools
+  ThreadPoolBindingScope thread_pool_binding_scope(thread_pool_binding_ ? &*thread_pool_binding_ : nullptr);
+
+  bool ran_graph_capture_buckets = false;
+
+  InlinedVector<std::string> feed_names_with_adapters;
+  InlinedVector<OrtValue> feeds_with_adapters;
+  const std::string active_lora_adapters =
+      run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigActiveLoraAdapters, "");
+  if (!active_lora_adapters.empty()) {
+    if (frozen_feeds_fetches_manager != nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Active LoRA adapters can't be used with a frozen IOBinding.");
+    }
+    ORT_RETURN_IF_ERROR_SESSIONID_(AddLoraAdapterFeeds(active_lora_adapters, feed_names, feeds,
+                                                       feed_names_with_adapters, feeds_with_adapters));
+    feed_names = feed_names_with_adapters;
+    feeds = feeds_with_adapters;
+  }
+
+  // A hit in the result cache requires feeds and output names identical to the ones of a previous successful Run,
+  // which were validated then.
+  if (is_inited_ && run_result_cache_ != nullptr && p_fetches != nullptr &&
+      run_result_cache_->Find(feed_names, feeds, output_names, *p_fetches)) {
+    LOGS(*session_logger_, VERBOSE) << "Returning the cached outputs of a previous Run with the same feeds.";
+  } else if (is_inited_ && cpu_graph_ != nullptr && p_fetches != nullptr &&
+             TryRunCpuGraph(run_options, feed_names, feeds, output_names, *p_fetches, p_fetches_device_info, retval)) {
+    // the feeds were run through the captured kernel calls of the CPU graph
+    if (retval.IsOK() && run_result_cache_ != nullptr) {
+      run_result_cache_->Insert(feed_names, feeds, output_names, *p_fetches);
+    }
+  } else if (is_inited_ && graph_capture_buckets_ != nullptr && graph_annotation_str.empty() &&
+             p_fetches != nullptr && p_fetches_device_info == nullptr &&
+             std::none_of(p_fetches->begin(), p_fetches->end(), [](const OrtValue& v) { return v.IsAllocated(); })) {
+    // The feeds are copied to the buffers of their batch size bucket, whose graph is captured or replayed by the
+    // nested Runs.
+    ran_graph_capture_buckets = true;
+    ORT_TRY {
+      retval = graph_capture_buckets_->Run(
+          run_options, feed_names, feeds, output_names, *p_fetches,
+          [&](const RunOptions& bucket_run_options, gsl::span<const OrtValue> bucket_feeds,
+              std::vector<OrtValue>& bucket_fetches, const std::vector<OrtDevice>& fetches_device) {
+            return Run(bucket_run_options, feed_names, bucket_feeds, output_names, &bucket_fetches, &fetches_device);
+          },
+          [this](int id) { return cached_execution_provider_for_graph_replay_.ReleaseGraph(id); });
+    }
+    ORT_CATCH(const std::exception& e) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        retval = Status(common::ONNXRUNTIME, common::FAIL, e.what());
+      });
+    }
+  } else if (cached_execution_provider_for_graph_replay_.IsGraphCaptured(graph_annotation_id)) {
+    // This Run() is simply going to be a CUDA Graph replay.
     LOGS(*session_logger_, INFO) << "Replaying the captured "
                                  << cached_execution_provider_for_graph_replay_.Type()
                                  << " CUDA Graph for this model with tag: " << run_options.run_tag
@@ -2512,8 +3261,10 @@ Status InferenceSession::Run(const RunOptions& run_options,
       // log evaluation start to trace logging provider
       env.GetTelemetryProvider().LogEvaluationStart();
 
-      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
-      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+      if (frozen_feeds_fetches_manager == nullptr) {
+        ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
+        ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+      }
 
       // shrink certain default memory arenas if the user has requested for it
       const std::string& shrink_memory_arenas =
@@ -2523,19 +3274,26 @@ Status InferenceSession::Run(const RunOptions& run_options,
         ORT_RETURN_IF_ERROR_SESSIONID_(ValidateAndParseShrinkArenaString(shrink_memory_arenas, arenas_to_shrink));
       }
 
-      FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
-      FeedsFetchesManager feeds_fetches_manager{std::move(info)};
+      std::optional<FeedsFetchesManager> run_feeds_fetches_manager;
+      if (frozen_feeds_fetches_manager == nullptr) {
+        FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
+        run_feeds_fetches_manager.emplace(std::move(info));
 
-      if (p_fetches_device_info) {
-        // populate the target device info. ignored if pre-allocated fetches are provided
-        const auto& fetch_device_info = *p_fetches_device_info;
-        auto& fetch_info = feeds_fetches_manager.GetMutableFetchesDeviceCopyInfo();
+        if (p_fetches_device_info) {
+          // populate the target device info. ignored if pre-allocated fetches are provided
+          const auto& fetch_device_info = *p_fetches_device_info;
+          auto& fetch_info = run_feeds_fetches_manager->GetMutableFetchesDeviceCopyInfo();
 
-        for (size_t i = 0, end = output_names.size(); i < end; ++i) {
-          fetch_info[i].target_device = fetch_device_info[i];
+          for (size_t i = 0, end = output_names.size(); i < end; ++i) {
+            fetch_info[i].target_device = fetch_device_info[i];
+          }
         }
       }
 
+      FeedsFetchesManager& feeds_fetches_manager = frozen_feeds_fetches_manager != nullptr
+                                                       ? *frozen_feeds_fetches_manager
+                                                       : *run_feeds_fetches_manager;
+
       if (!run_options.run_tag.empty()) {
         LOGS(*session_logger_, INFO) << "Running with tag: " << run_options.run_tag;
       }
@@ -2565,14 +3323,20 @@ Status InferenceSession::Run(const RunOptions& run_options,
         ORT_CHECK_AND_SET_RETVAL(start_func());
       }
 
-#ifdef ENABLE_TRAINING
-      if (run_options.only_execute_path_to_fetches) {
-        // TODO: this method is not thread safe, if multiple Run happened in parallel we might hit race condition issue.
-        // currently it only used in training, there is no parallel run execution in training so it is ok.
-        // but it is better we can fix it with a better solution.
-        session_state_->UpdateToBeExecutedRange(feeds_fetches_manager.GetFeedsFetchesInfo().fetches_mlvalue_idxs);
+      // Runs fetching or feeding cut values only execute the nodes between the cuts
+      const auto is_cut_value = [this](const std::string& name) { return partial_run_cut_values_.count(name) != 0; };
+      const bool is_partial_run = !partial_run_cut_values_.empty() &&
+                                  (std::any_of(feed_names.begin(), feed_names.end(), is_cut_value) ||
+                                   std::any_of(output_names.begin(), output_names.end(), is_cut_value));
+
+      const bool only_execute_path_to_fetches =
+          run_options.only_execute_path_to_fetches || is_partial_run ||
+          (prune_execution_to_fetches_ && output_names.size() < output_def_map_.size());
+      if (only_execute_path_to_fetches) {
+        const auto& feeds_fetches_info = feeds_fetches_manager.GetFeedsFetchesInfo();
+        session_state_->UpdateToBeExecutedRange(feeds_fetches_info.fetches_mlvalue_idxs,
+                                                feeds_fetches_info.feeds_mlvalue_idxs);
       }
-#endif
 
       // execute the graph
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
@@ -2586,11 +3350,16 @@ Status InferenceSession::Run(const RunOptions& run_options,
       if (retval.IsOK()) {
         retval = utils::ExecuteGraph(*session_state_, feeds_fetches_manager, feeds, *p_fetches,
                                      session_options_.execution_mode,
-                                     run_options,
+                                     run_options.terminate,
+                                     run_logger,
 #ifdef ORT_ENABLE_STREAM
                                      device_stream_collection_holder,
 #endif
-                                     run_logger);
+                                     only_execute_path_to_fetches);
+        if (retval.IsOK() && frozen_feeds_fetches_manager != nullptr) {
+          // the feeds and fetches of the later runs have the same locations
+          frozen_feeds_fetches_manager->FreezeCopyInfo();
+        }
       }
 
       // info all execution providers InferenceSession:Run ended
@@ -2610,6 +3379,10 @@ Status InferenceSession::Run(const RunOptions& run_options,
         ORT_CHECK_AND_SET_RETVAL(device_stream_collection->CleanUp(sync_execution_provider));
       }
 #endif
+
+      if (retval.IsOK() && run_result_cache_ != nullptr) {
+        run_result_cache_->Insert(feed_names, feeds, output_names, *p_fetches);
+      }
     }
     ORT_CATCH(const std::exception& e) {
       ORT_HANDLE_EXCEPTION([&]() {
@@ -2647,6 +3420,19 @@ Status InferenceSession::Run(const RunOptions& run_options,
   if (session_profiler_.IsEnabled()) {
     session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "model_run", tp);
   }
+
+  if (!retval.IsOK() && deadline != concurrency::ThreadPool::Deadline::max() &&
+      std::chrono::steady_clock::now() >= deadline) {
+    const uint64_t num_expired_runs = num_expired_runs_.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (session_state_ != nullptr && session_state_->GetSampledProfiler() != nullptr) {
+      session_state_->GetSampledProfiler()->RecordExpiredRun();
+    }
+    if (session_profiler_.IsEnabled()) {
+      session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "model_run_deadline_exceeded", tp,
+                                              {{"latency_budget_us", latency_budget_str},
+                                               {"expired_runs", std::to_string(num_expired_runs)}});
+    }
+  }
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
   TraceLoggingWriteStop(ortrun_activity, "OrtRun");
 #endif
@@ -2657,7 +3443,8 @@ Status InferenceSession::Run(const RunOptions& run_options,
   // N is defined in min_num_runs_before_cuda_graph_capture_ for CUDA EP,
   // N is defined in min_num_runs_before_hip_graph_capture_ for ROCM EP,
   // and the value could be different for other EP.
-  if (retval.IsOK() && cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled() &&
+  if (retval.IsOK() && !ran_graph_capture_buckets &&
+      cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled() &&
       cached_execution_provider_for_graph_replay_.AllowGraphCaptureOnRun(graph_annotation_id) &&
       !cached_execution_provider_for_graph_replay_.IsGraphCaptured(graph_annotation_id)) {
     LOGS(*session_logger_, INFO) << "Start another run for necessary memory allocation or graph capture.";
@@ -2666,6 +3453,61 @@ Status InferenceSession::Run(const RunOptions& run_options,
   return retval;
 }
 
+bool InferenceSession::TryRunCpuGraph(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                                      gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                                      std::vector<OrtValue>& fetches,
+                                      const std::vector<OrtDevice>* p_fetches_device_info, Status& status) {
+  // the outputs of the CPU graph are in CPU memory
+  if (p_fetches_device_info != nullptr &&
+      std::any_of(p_fetches_device_info->begin(), p_fetches_device_info->end(),
+                  [](const OrtDevice& device) { return device.Type() != OrtDevice::CPU; })) {
+    return false;
+  }
+
+  auto lock = cpu_graph_->TryLock();
+  if (!lock.owns_lock() || !cpu_graph_->Matches(feed_names, output_names)) {
+    return false;
+  }
+
+  status = ValidateInputs(feed_names, feeds);
+  if (status.IsOK()) {
+    status = ValidateOutputs(output_names, &fetches);
+  }
+
+  if (status.IsOK()) {
+    ORT_TRY {
+      status = cpu_graph_->Run(run_options, feed_names, feeds, output_names, fetches);
+    }
+    ORT_CATCH(const std::exception& e) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = Status(common::ONNXRUNTIME, common::FAIL, e.what());
+      });
+    }
+  }
+
+  return true;
+}
+
+namespace {
+// The names and values a Run with C string names passes on, kept per thread so a thread running the same model
+// repeatedly reuses their allocations instead of allocating the names on every Run.
+struct RunArgBuffers {
+  InlinedVector<std::string> feed_names;
+  InlinedVector<OrtValue> feeds;
+  InlinedVector<std::string> fetch_names;
+  std::vector<OrtValue> fetches;
+  // set while a Run uses the buffers. a Run nested in a kernel of another Run on the thread uses its own.
+  bool in_use = false;
+};
+
+void AssignNames(gsl::span<const char* const> names, InlinedVector<std::string>& name_vec) {
+  name_vec.resize(names.size());
+  for (size_t i = 0; i != names.size(); ++i) {
+    name_vec[i].assign(names[i]);
+  }
+}
+}  // namespace
+
 Status InferenceSession::Run(const RunOptions& run_options,
                              gsl::span<const char* const> feed_names,
                              gsl::span<const OrtValue* const> feeds,
@@ -2673,10 +3515,6 @@ Status InferenceSession::Run(const RunOptions& run_options,
                              gsl::span<OrtValue*> fetches) {
   size_t num_feeds = feed_names.size();
   size_t num_fetches = fetch_names.size();
-  InlinedVector<std::string> feed_name_vec;
-  feed_name_vec.reserve(num_feeds);
-  InlinedVector<OrtValue> feed_vec;
-  feed_vec.reserve(num_feeds);
 
   for (size_t i = 0; i != num_feeds; ++i) {
     if (feed_names[i] == nullptr || feed_names[i][0] == '\0') {
@@ -2686,22 +3524,33 @@ Status InferenceSession::Run(const RunOptions& run_options,
     if (!feeds[i]) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, MakeString("NULL input supplied for input ", feed_names[i]).c_str());
     }
-
-    feed_name_vec.emplace_back(feed_names[i]);
-    feed_vec.emplace_back(*feeds[i]);
   }
 
-  // Create output feed
-  InlinedVector<std::string> fetch_name_vec;
-  fetch_name_vec.reserve(num_fetches);
   for (size_t i = 0; i != num_fetches; ++i) {
     if (fetch_names[i] == nullptr || fetch_names[i][0] == '\0') {
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "output name cannot be empty");
     }
-    fetch_name_vec.emplace_back(fetch_names[i]);
   }
 
-  std::vector<OrtValue> fetch_vec;
+  thread_local RunArgBuffers thread_buffers;
+  std::optional<RunArgBuffers> nested_buffers;
+  RunArgBuffers& buffers = thread_buffers.in_use ? nested_buffers.emplace() : thread_buffers;
+  buffers.in_use = true;
+  // release the feeds and fetches, which are owned by the caller, when the Run completes
+  auto release_buffers = gsl::finally([&buffers]() {
+    buffers.feeds.clear();
+    buffers.fetches.clear();
+    buffers.in_use = false;
+  });
+
+  AssignNames(feed_names, buffers.feed_names);
+  for (size_t i = 0; i != num_feeds; ++i) {
+    buffers.feeds.emplace_back(*feeds[i]);
+  }
+
+  // Create output feed
+  AssignNames(fetch_names, buffers.fetch_names);
+  auto& fetch_vec = buffers.fetches;
   fetch_vec.reserve(num_fetches);
   for (size_t i = 0; i != num_fetches; ++i) {
     if (fetches[i] != nullptr) {
@@ -2712,7 +3561,7 @@ Status InferenceSession::Run(const RunOptions& run_options,
   }
 
   Status status;
-  status = Run(run_options, feed_name_vec, feed_vec, fetch_name_vec, &fetch_vec, nullptr);
+  status = Run(run_options, buffers.feed_names, buffers.feeds, buffers.fetch_names, &fetch_vec, nullptr);
 
   if (!status.IsOK())
     return status;
@@ -2861,6 +3710,28 @@ common::Status InferenceSession::NewIOBinding(std::unique_ptr<IOBinding>* io_bin
 common::Status InferenceSession::Run(const RunOptions& run_options, IOBinding& io_binding) {
   // TODO should Run() call io_binding.SynchronizeInputs() or should it let the callers do it?
   // io_binding.SynchronizeInputs();
+  if (io_binding.IsFrozen()) {
+    auto& frozen_feeds_fetches_manager = io_binding.frozen_feeds_fetches_manager_;
+    if (frozen_feeds_fetches_manager == nullptr) {
+      // validate the binding and resolve the feeds and fetches once for all the runs until it's unfrozen
+      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(io_binding.GetInputNames(), io_binding.GetInputs()));
+      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(io_binding.GetOutputNames(), &io_binding.GetOutputs()));
+      ORT_RETURN_IF_ERROR_SESSIONID_(FeedsFetchesManager::Create(io_binding.GetInputNames(),
+                                                                 io_binding.GetOutputNames(),
+                                                                 session_state_->GetOrtValueNameIdxMap(),
+                                                                 frozen_feeds_fetches_manager));
+
+      const auto& fetch_device_info = io_binding.GetOutputsDeviceInfo();
+      auto& fetch_info = frozen_feeds_fetches_manager->GetMutableFetchesDeviceCopyInfo();
+      for (size_t i = 0, end = fetch_info.size(); i < end; ++i) {
+        fetch_info[i].target_device = fetch_device_info[i];
+      }
+    }
+
+    return RunImpl(run_options, io_binding.GetInputNames(), io_binding.GetInputs(), io_binding.GetOutputNames(),
+                   &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo(), frozen_feeds_fetches_manager.get());
+  }
+
   return Run(run_options, io_binding.GetInputNames(), io_binding.GetInputs(), io_binding.GetOutputNames(),
              &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo());
 }
@@ -3012,7 +3883,8 @@ common::Status InferenceSession::ValidateAndParseShrinkArenaString(const std::st
                              " combination in the memory arena shrink list: ", device_id_pair);
     }
 
-    if (alloc->Info().alloc_type != OrtAllocatorType::OrtArenaAllocator) {
+    // stream ordered allocators cache the memory they free like arenas
+    if (alloc->Info().alloc_type != OrtAllocatorType::OrtArenaAllocator && !alloc->IsStreamOrdered()) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The registered allocator for device-id ",
                              " combination is not an arena based allocator: ", device_id_pair);
     }
@@ -3025,7 +3897,7 @@ common::Status InferenceSession::ValidateAndParseShrinkArenaString(const std::st
 
 void InferenceSession::ShrinkMemoryArenas(gsl::span<const AllocatorPtr> arenas_to_shrink) {
   for (auto& alloc : arenas_to_shrink) {
-    auto status = static_cast<BFCArena*>(alloc.get())->Shrink();
+    auto status = alloc->Shrink();
 
     if (!status.IsOK()) {
       LOGS(*session_logger_, WARNING) << "Unable to shrink arena: " << alloc->Info().ToString()
@@ -3105,8 +3977,15 @@ const logging::Logger& InferenceSession::CreateLoggerForRun(const RunOptions& ru
                                                             std::unique_ptr<logging::Logger>& new_run_logger) {
   const logging::Logger* run_logger;
 
+  // a Run without a tag or log levels of its own uses the session logger, so creating the logger doesn't allocate
+  const bool use_session_logger =
+      run_options.run_tag.empty() &&
+      (run_options.run_log_severity_level == -1 ||
+       run_options.run_log_severity_level == static_cast<int>(session_logger_->GetSeverity())) &&
+      run_options.run_log_verbosity_level == session_options_.session_log_verbosity_level;
+
   // create a per-run logger if we can
-  if (logging_manager_ != nullptr) {
+  if (logging_manager_ != nullptr && !use_session_logger) {
     std::string run_log_id{session_options_.session_logid};
 
     if (!session_options_.session_logid.empty() && !run_options.run_tag.empty()) {
@@ -3131,7 +4010,7 @@ const logging::Logger& InferenceSession::CreateLoggerForRun(const RunOptions& ru
     run_logger = new_run_logger.get();
     VLOGS(*run_logger, 1) << "Created logger for run with id of " << run_log_id;
   } else {
-    // fallback to using default logger. this does NOT have any session or run specific id/tag in it
+    // use the session logger. this does NOT have any run specific tag in it
     run_logger = session_logger_;
     VLOGS(*run_logger, 1) << "Using default logger for run " << run_options.run_tag;
   }
@@ -3171,7 +4050,7 @@ common::Status InferenceSession::AddPredefinedTransformers(
 
         if (use_full_build_optimizations) {
           return optimizer_utils::GenerateTransformers(level, session_options_, cpu_ep,
-                                                       optimizers_to_disable_);
+                                                       optimizers_to_disable_, model_->MetaData());
         } else {
           const auto sat_context =
               minimal_build_optimization_handling ==
@@ -6,6 +6,7 @@
 #include <map>
 #include <optional>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <filesystem>
 
@@ -29,6 +30,9 @@
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/insert_cast_transformer.h"
 #include "core/platform/ort_mutex.h"
+#include "core/session/cpu_graph.h"
+#include "core/session/graph_capture_buckets.h"
+#include "core/session/run_result_cache.h"
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
 #include "core/language_interop_ops/language_interop_ops.h"
 #endif
@@ -329,6 +333,20 @@ class InferenceSession {
    */
   [[nodiscard]] common::Status Initialize();
 
+  /**
+   * Creates an initialized session that shares the state of this initialized session: the model, the kernels with
+   * their pre-packed weights, the initializers and the execution plan. Loading, optimizing, partitioning and
+   * pre-packing the model are skipped, so creating a clone is cheap.
+   * The clone runs the kernels on its own thread pools, created from clone_session_options, and has its own per-Run
+   * state. The execution providers and their allocators are shared with this session, which must outlive the clone.
+   * @param clone_session_options Options of the clone. Only the options applying to the thread pools and to Run, e.g.
+   *        the execution mode, are used. The options used by Initialize are the ones of this session.
+   * @param clone The created session.
+   * @return OK if success.
+   */
+  [[nodiscard]] common::Status Clone(const SessionOptions& clone_session_options,
+                                     std::unique_ptr<InferenceSession>& clone) const;
+
   [[nodiscard]] common::Status Run(const RunOptions& run_options, gsl::span<const std::string> feed_names,
                                    gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
                                    std::vector<OrtValue>* p_fetches,
@@ -536,6 +554,24 @@ class InferenceSession {
    */
   Status AddPrePackedWeightsContainer(PrepackedWeightsContainer* prepacked_weights_container);
 
+  /**
+   * Register a LoRA adapter with an initialized session. The adapter maps overridable initializers (or inputs) of the
+   * model, typically the low-rank A and B matrices of its LoRA branches, to the values to feed for them in the runs
+   * that activate the adapter with the run config entry "run.active_lora_adapters".
+   * Switching adapters only changes the feeds of a run, so it requires neither a new session nor merging the
+   * adapter into the base weights.
+   * This API is thread-safe.
+   * @param adapter_name unique name of the adapter
+   * @param parameters values of the adapter. They are validated against the model inputs.
+   */
+  [[nodiscard]] common::Status AddLoraAdapter(const std::string& adapter_name, NameMLValMap parameters);
+
+  /**
+   * Remove a LoRA adapter added with AddLoraAdapter. Runs using it that are in progress are not affected.
+   * This API is thread-safe.
+   */
+  [[nodiscard]] common::Status RemoveLoraAdapter(const std::string& adapter_name);
+
  protected:
 #if !defined(ORT_MINIMAL_BUILD)
 
@@ -602,6 +638,11 @@ class InferenceSession {
   // The file path of where the model was loaded. e.g. /tmp/test_squeezenet/model.onnx
   PathString model_location_;
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // Path of the optimized model cache entry Initialize saves the optimized model to. Empty if none.
+  std::filesystem::path optimized_model_cache_path_;
+#endif
+
   // The list of execution providers.
   ExecutionProviders execution_providers_;
 
@@ -614,6 +655,17 @@ class InferenceSession {
 
   [[nodiscard]] common::Status SaveModelMetadata(const onnxruntime::Model& model);
 
+  // Replaces the initializers of the main graph that are only used on CPU with the deduplicated copies from the
+  // environment's SharedInitializerCache, by adding them to the initializers to share.
+  [[nodiscard]] common::Status ShareInitializersAcrossSessions(const onnxruntime::Graph& graph);
+
+  // Appends the parameters of the LoRA adapters named in `active_lora_adapters`, a comma separated list, to the feeds.
+  [[nodiscard]] common::Status AddLoraAdapterFeeds(const std::string& active_lora_adapters,
+                                                   gsl::span<const std::string> feed_names,
+                                                   gsl::span<const OrtValue> feeds,
+                                                   InlinedVector<std::string>& feed_names_with_adapters,
+                                                   InlinedVector<OrtValue>& feeds_with_adapters) const;
+
 #if !defined(ORT_MINIMAL_BUILD)
 
   [[nodiscard]] common::Status LoadOnnxModel(const PathString& model_uri);
@@ -623,6 +675,30 @@ class InferenceSession {
   }
 
   common::Status SaveToOrtFormat(const std::filesystem::path& filepath) const;
+
+  // Replaces the loaded ONNX model with its optimized version from the cache directory of
+  // kOrtSessionOptionsConfigOptimizedModelCacheDir if there is one. Otherwise sets optimized_model_cache_path_,
+  // so Initialize saves the optimized model to the cache.
+  common::Status UseOptimizedModelCache();
+
+  // Saves the optimized model to optimized_model_cache_path_. The cache is best effort, failures are only logged.
+  void SaveToOptimizedModelCache() const;
+
+  // Makes the values of kOrtSessionOptionsConfigPartialRunCutValues outputs of the graph, so they survive the graph
+  // optimizations and can be fetched. Sets partial_run_cut_values_.
+  common::Status AddPartialRunCutValues(Graph& graph);
+
+  // Checks that the nodes producing the cut values can be skipped in the optimized graph, and makes the cut values
+  // valid feeds. Must be called after the model metadata was saved.
+  common::Status FinalizePartialRunCutValues(const Graph& graph);
+
+  // Makes the predicates and outputs of kOrtSessionOptionsConfigEarlyExitPoints outputs of the graph, so they survive
+  // the graph optimizations. Sets early_exit_points_ and early_exit_graph_outputs_.
+  common::Status AddEarlyExitPoints(Graph& graph);
+
+  // Appends the models of kOrtSessionOptionsConfigComposeModels to the loaded model, replacing it with the composed
+  // model.
+  common::Status ComposeModels(std::shared_ptr<Model>& model);
 #endif
 
   /**
@@ -659,6 +735,14 @@ class InferenceSession {
   [[nodiscard]] common::Status CheckShapes(const std::string& input_name, const TensorShape& input_shape,
                                            const TensorShape& expected_shape, const char* input_output_moniker) const;
 
+  // Run() with the feeds/fetches manager of a frozen IOBinding, which skips the validation of the feeds and fetches
+  // and the creation of the manager. nullptr validates them and creates a manager for this run.
+  [[nodiscard]] common::Status RunImpl(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                                       gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                                       std::vector<OrtValue>* p_fetches,
+                                       const std::vector<OrtDevice>* p_fetches_device_info,
+                                       FeedsFetchesManager* frozen_feeds_fetches_manager);
+
   [[nodiscard]] common::Status ValidateInputs(gsl::span<const std::string> feed_names,
                                               gsl::span<const OrtValue> feeds) const;
 
@@ -670,6 +754,13 @@ class InferenceSession {
                                                      const InputOutputDefMetaMap& input_output_meta_map,
                                                      ArgType arg_type) const;
 
+  // Runs the feeds through cpu_graph_, validating them first. Returns false if the Run can't use cpu_graph_ and
+  // needs to execute the graph as usual.
+  bool TryRunCpuGraph(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                      gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                      std::vector<OrtValue>& fetches, const std::vector<OrtDevice>* p_fetches_device_info,
+                      Status& status);
+
   [[nodiscard]] common::Status WaitForNotification(Notification* p_executor_done, int64_t timeout_in_ms);
 
   template <typename T>
@@ -731,9 +822,13 @@ class InferenceSession {
   MemoryProfiler memory_profiler_;
 #endif
 
-  // Immutable state for each op in the model. Shared by all executors.
+  // Immutable state for each op in the model. Shared by all executors, and by the sessions cloned from this one.
   // It has a dependency on execution_providers_.
-  std::unique_ptr<SessionState> session_state_;
+  std::shared_ptr<SessionState> session_state_;
+
+  // Thread pools of a session cloned from another one, bound in its Runs in place of the thread pools of the shared
+  // session_state_. Not set if the session was initialized itself.
+  std::optional<ThreadPoolBinding> thread_pool_binding_;
 
   // Threadpools per session. These are initialized and used for the entire duration of the session
   // when use_per_session_threads is true.
@@ -746,6 +841,9 @@ class InferenceSession {
   // Spinning is restarted on the next Run()
   bool force_spinning_stop_between_runs_ = false;
 
+  // Priority class of the parallel loops of the runs in the intra-op thread pool.
+  concurrency::ThreadPool::Priority intra_op_thread_pool_priority_ = concurrency::ThreadPool::Priority::kNormal;
+
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> thread_pool_;
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
 
@@ -787,11 +885,43 @@ class InferenceSession {
   // Number of concurrently running executors
   std::atomic<int> current_num_runs_ = 0;
 
+  // Number of Runs that failed after their deadline passed, see kOrtRunOptionsConfigLatencyBudgetUs.
+  std::atomic<uint64_t> num_expired_runs_ = 0;
+
   mutable onnxruntime::OrtMutex session_mutex_;  // to ensure only one thread can invoke Load/Initialize
   bool is_model_loaded_ = false;                 // GUARDED_BY(session_mutex_)
   bool is_inited_ = false;                       // GUARDED_BY(session_mutex_)
   bool is_concurrent_run_supported_ = true;      // Graph execution in Run is GUARDED_BY(session_mutex_) if false
 
+  // Cache of the outputs of previous Runs, see kOrtSessionOptionsConfigRunResultCacheSize. nullptr if disabled.
+  std::unique_ptr<RunResultCache> run_result_cache_;
+
+  // Captured kernel calls of the CPU graph, see kOrtSessionOptionsConfigEnableCpuGraphCapture. nullptr if disabled.
+  std::unique_ptr<CpuGraph> cpu_graph_;
+
+  // Graphs captured per batch size bucket, see kOrtSessionOptionsConfigGraphCaptureBatchBuckets. nullptr if disabled.
+  std::unique_ptr<GraphCaptureBuckets> graph_capture_buckets_;
+
+  // Whether Runs fetching a subset of the outputs only execute the nodes they depend on,
+  // see kOrtSessionOptionsConfigPruneExecutionToFetches.
+  bool prune_execution_to_fetches_ = false;
+
+  // Intermediate values Runs can be cut at, see kOrtSessionOptionsConfigPartialRunCutValues.
+  InlinedHashSet<std::string> partial_run_cut_values_;
+
+  // The predicate and outputs of each early exit point, and the outputs of the model they replace,
+  // see kOrtSessionOptionsConfigEarlyExitPoints.
+  std::vector<std::pair<std::string, std::vector<std::string>>> early_exit_points_;
+  std::vector<std::string> early_exit_graph_outputs_;
+
+  // Whether the models of kOrtSessionOptionsConfigComposeModels were appended to the loaded model.
+  bool models_composed_ = false;
+
+  // Materializes the constant initializers in the background once the session is initialized,
+  // see kOrtSessionOptionsConfigPrefaultInitializers. Stopped and joined when the session is released.
+  std::thread initializer_prefault_thread_;
+  std::atomic<bool> stop_initializer_prefault_{false};
+
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
   InterOpDomains interop_domains_;
 #endif
@@ -855,6 +985,15 @@ class InferenceSession {
   // the cache is valid until any session reliant on it is still in scope.
   PrepackedWeightsContainer* prepacked_weights_container_ = nullptr;
 
+  // LoRA adapters added with AddLoraAdapter, by name.
+  // The parameters are immutable once added, so a run can use them after releasing the mutex.
+  mutable OrtMutex lora_adapters_mutex_;
+  InlinedHashMap<std::string, std::shared_ptr<const NameMLValMap>> lora_adapters_;
+
+  // Initializers shared with other sessions through the environment's SharedInitializerCache.
+  // Holding them keeps the shared copies alive for the lifetime of this session.
+  std::vector<std::shared_ptr<const OrtValue>> initializers_shared_across_sessions_;
+
   // Cache the EP instance if the user has configured the EP to capture a graph
   // for the model and all the necessary criteria for graph capture has been met.
   // At Run() time, if this member is not nullptr and the captured graph is ready
@@ -887,6 +1026,13 @@ class InferenceSession {
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Cached EP instance for graph replay is not set yet before calling ReplayGraph()");
     }
 
+    Status ReleaseGraph(int graph_annotation_id) {
+      if (cached_execution_provider_for_graph_replay_) {
+        return cached_execution_provider_for_graph_replay_->ReleaseGraph(graph_annotation_id);
+      }
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Cached EP instance for graph replay is not set yet before calling ReleaseGraph()");
+    }
+
     const std::string& Type() const {
       return cached_execution_provider_for_graph_replay_->Type();
     }
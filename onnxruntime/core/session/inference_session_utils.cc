@@ -5,6 +5,12 @@
 
 #include "core/session/inference_session_utils.h"
 
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <thread>
+
 namespace onnxruntime {
 
 //---------------------
@@ -110,6 +116,10 @@ void from_json(const json& j, TuningResults& trs) {
   j.at("validators").get_to(trs.validators);
 }
 
+void to_json(json& j, const TuningResults& trs) {
+  j = json{{"ep", trs.ep}, {"results", trs.results}, {"validators", trs.validators}};
+}
+
 //---------------------------------------------------
 //--- end of session options related helpers ---
 //---------------------------------------------------
@@ -264,6 +274,69 @@ Status ParseTuningResultsFromModelMetadata(const onnxruntime::ModelMetadata& met
   return Status::OK();
 }
 
+std::filesystem::path GetTuningResultsCacheFile(const std::filesystem::path& cache_dir, const std::string& ep,
+                                                const std::unordered_map<std::string, std::string>& validators) {
+  // FNV-1a of the sorted validators, which is stable across processes and platforms unlike std::hash
+  std::map<std::string, std::string> sorted_validators(validators.cbegin(), validators.cend());
+  uint64_t hash = 14695981039346656037ULL;
+  auto hash_string = [&hash](const std::string& str) {
+    for (const char c : str) {
+      hash ^= static_cast<uint8_t>(c);
+      hash *= 1099511628211ULL;
+    }
+    hash ^= 0xff;  // separator, so that "ab" + "c" and "a" + "bc" differ
+    hash *= 1099511628211ULL;
+  };
+  for (const auto& [key, value] : sorted_validators) {
+    hash_string(key);
+    hash_string(value);
+  }
+
+  std::ostringstream file_name;
+  file_name << ep << "_" << std::hex << std::setw(16) << std::setfill('0') << hash << ".json";
+  return cache_dir / file_name.str();
+}
+
+Status LoadTuningResultsFromFile(const std::filesystem::path& file, TuningResults& results) {
+  std::ifstream stream(file);
+  ORT_RETURN_IF_NOT(stream.good(), "Failed to open the tuning results file ", file.string());
+
+  Status status;
+  ORT_TRY {
+    results = json::parse(stream).get<TuningResults>();
+  }
+  ORT_CATCH(const std::exception& e) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to parse the tuning results file ", file.string(), ": ",
+                               e.what());
+    });
+  }
+  return status;
+}
+
+Status SaveTuningResultsToFile(const std::filesystem::path& file, const TuningResults& results) {
+  std::error_code error;
+  std::filesystem::create_directories(file.parent_path(), error);
+  ORT_RETURN_IF(error, "Failed to create the tuning results cache directory ", file.parent_path().string(), ": ",
+                error.message());
+
+  std::filesystem::path temp_file = file;
+  temp_file += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+  {
+    std::ofstream stream(temp_file, std::ios::trunc);
+    ORT_RETURN_IF_NOT(stream.good(), "Failed to open the tuning results file ", temp_file.string());
+    stream << json(results).dump();
+    ORT_RETURN_IF_NOT(stream.good(), "Failed to write the tuning results file ", temp_file.string());
+  }
+
+  std::filesystem::rename(temp_file, file, error);
+  if (error) {
+    std::filesystem::remove(temp_file, error);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write the tuning results file ", file.string());
+  }
+  return Status::OK();
+}
+
 }  // namespace inference_session_utils
 }  // namespace onnxruntime
 
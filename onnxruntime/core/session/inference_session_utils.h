@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <filesystem>
+
 #include "core/flatbuffers/schema/ort.fbs.h"
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -62,6 +64,17 @@ Status ParseTuningResultsFromModelMetadata(const onnxruntime::ModelMetadata& met
                                            /*out*/ std::vector<TuningResults>& results,
                                            /*out*/ bool& key_found);
 
+// Returns the file in cache_dir that caches the tuning results of the execution provider ep. The file name is derived
+// from the validators of the results, i.e. the versions of ORT and of the libraries used by the EP and the device
+// model, so results are only reused in an environment they are valid for.
+std::filesystem::path GetTuningResultsCacheFile(const std::filesystem::path& cache_dir, const std::string& ep,
+                                                const std::unordered_map<std::string, std::string>& validators);
+
+Status LoadTuningResultsFromFile(const std::filesystem::path& file, /*out*/ TuningResults& results);
+
+// Writes to a temporary file that is then renamed, so concurrent processes never read a partially written file.
+Status SaveTuningResultsToFile(const std::filesystem::path& file, const TuningResults& results);
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 }  // namespace inference_session_utils
@@ -0,0 +1,288 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/model_composition.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "core/common/path_string.h"
+#include "core/common/string_utils.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/constants.h"
+#include "core/graph/model.h"
+#include "core/graph/onnx_protobuf.h"
+
+namespace onnxruntime {
+namespace model_composition {
+
+namespace {
+
+// Renames the values and nodes of a stage, leaving the names of `renames` to the value they map to.
+class StageRenamer {
+ public:
+  StageRenamer(std::string prefix, std::unordered_map<std::string, std::string> renames,
+               std::filesystem::path model_dir)
+      : prefix_(std::move(prefix)), renames_(std::move(renames)), model_dir_(std::move(model_dir)) {}
+
+  void RenameGraph(ONNX_NAMESPACE::GraphProto& graph) const {
+    for (auto& input : *graph.mutable_input()) {
+      Rename(*input.mutable_name());
+    }
+    for (auto& output : *graph.mutable_output()) {
+      Rename(*output.mutable_name());
+    }
+    for (auto& value_info : *graph.mutable_value_info()) {
+      Rename(*value_info.mutable_name());
+    }
+    for (auto& initializer : *graph.mutable_initializer()) {
+      RenameInitializer(initializer);
+    }
+    for (auto& sparse_initializer : *graph.mutable_sparse_initializer()) {
+      RenameInitializer(*sparse_initializer.mutable_values());
+      Rename(*sparse_initializer.mutable_indices()->mutable_name());
+    }
+    for (auto& annotation : *graph.mutable_quantization_annotation()) {
+      Rename(*annotation.mutable_tensor_name());
+    }
+
+    for (auto& node : *graph.mutable_node()) {
+      if (!node.name().empty()) {
+        node.set_name(prefix_ + node.name());
+      }
+      for (auto& input : *node.mutable_input()) {
+        Rename(input);
+      }
+      for (auto& output : *node.mutable_output()) {
+        Rename(output);
+      }
+      // the values of subgraphs are renamed too, as they must not shadow the values of the composed model
+      for (auto& attribute : *node.mutable_attribute()) {
+        if (attribute.has_g()) {
+          RenameGraph(*attribute.mutable_g());
+        }
+        for (auto& subgraph : *attribute.mutable_graphs()) {
+          RenameGraph(subgraph);
+        }
+      }
+    }
+  }
+
+ private:
+  void Rename(std::string& name) const {
+    if (name.empty()) {  // missing optional value
+      return;
+    }
+
+    const auto it = renames_.find(name);
+    name = it != renames_.end() ? it->second : prefix_ + name;
+  }
+
+  // Also makes the location of external data absolute, as it is relative to the directory of the stage model.
+  void RenameInitializer(ONNX_NAMESPACE::TensorProto& initializer) const {
+    Rename(*initializer.mutable_name());
+    if (!utils::HasExternalData(initializer)) {
+      return;
+    }
+
+    for (auto& entry : *initializer.mutable_external_data()) {
+      if (entry.key() == "location" && entry.value() != ToUTF8String(utils::kTensorProtoMemoryAddressTag)) {
+        entry.set_value(ToUTF8String((model_dir_ / ToPathString(entry.value())).native()));
+      }
+    }
+  }
+
+  const std::string prefix_;
+  const std::unordered_map<std::string, std::string> renames_;
+  const std::filesystem::path model_dir_;
+};
+
+template <typename T>
+const T* FindByName(const google::protobuf::RepeatedPtrField<T>& values, const std::string& name) {
+  const auto it = std::find_if(values.begin(), values.end(), [&name](const T& value) { return value.name() == name; });
+  return it != values.end() ? &*it : nullptr;
+}
+
+std::string_view NormalizeDomain(const std::string& domain) {
+  return domain == kOnnxDomainAlias ? std::string_view{kOnnxDomain} : std::string_view{domain};
+}
+
+Status MergeOpsetImports(ONNX_NAMESPACE::ModelProto& model_proto, const ONNX_NAMESPACE::ModelProto& stage_proto,
+                         const std::string& stage_name) {
+  for (const auto& stage_opset : stage_proto.opset_import()) {
+    const auto& opsets = model_proto.opset_import();
+    const auto it = std::find_if(opsets.begin(), opsets.end(), [&stage_opset](const auto& opset) {
+      return NormalizeDomain(opset.domain()) == NormalizeDomain(stage_opset.domain());
+    });
+
+    if (it == opsets.end()) {
+      *model_proto.add_opset_import() = stage_opset;
+      continue;
+    }
+
+    ORT_RETURN_IF(it->version() != stage_opset.version(), "The model of ", stage_name, " imports version ",
+                  stage_opset.version(), " of the opset of domain '", stage_opset.domain(),
+                  "', but the composed model imports version ", it->version(), ".");
+  }
+
+  return Status::OK();
+}
+
+Status MergeFunctions(ONNX_NAMESPACE::ModelProto& model_proto, const ONNX_NAMESPACE::ModelProto& stage_proto,
+                      const std::string& stage_name) {
+  for (const auto& stage_function : stage_proto.functions()) {
+    const auto& functions = model_proto.functions();
+    const auto it = std::find_if(functions.begin(), functions.end(), [&stage_function](const auto& function) {
+      return function.domain() == stage_function.domain() && function.name() == stage_function.name();
+    });
+
+    if (it == functions.end()) {
+      *model_proto.add_functions() = stage_function;
+      continue;
+    }
+
+    ORT_RETURN_IF(it->SerializeAsString() != stage_function.SerializeAsString(), "The model of ", stage_name,
+                  " defines the function ", stage_function.domain(), ":", stage_function.name(),
+                  " differently from the composed model.");
+  }
+
+  return Status::OK();
+}
+
+Status AppendStage(ONNX_NAMESPACE::ModelProto& model_proto, ONNX_NAMESPACE::ModelProto&& stage_proto,
+                   std::string_view connections, size_t stage_index, const std::filesystem::path& model_dir) {
+  const std::string stage_name = "stage " + std::to_string(stage_index);
+  ONNX_NAMESPACE::GraphProto& graph = *model_proto.mutable_graph();
+  ONNX_NAMESPACE::GraphProto& stage = *stage_proto.mutable_graph();
+
+  // stage input -> output of the composed model it reads
+  std::unordered_map<std::string, std::string> renames;
+  std::unordered_set<std::string> connected_outputs;
+  for (const auto connection : utils::SplitString(connections, ",")) {
+    const auto separator = connection.find('=');
+    ORT_RETURN_IF(separator == std::string_view::npos, "The connection '", connection, "' of ", stage_name,
+                  " must have the format 'output=input'.");
+
+    const std::string output_name{connection.substr(0, separator)};
+    const std::string input_name{connection.substr(separator + 1)};
+    const auto* output = FindByName(graph.output(), output_name);
+    ORT_RETURN_IF(output == nullptr, "'", output_name, "' connected to ", stage_name,
+                  " is not an output of the composed model.");
+    const auto* input = FindByName(stage.input(), input_name);
+    ORT_RETURN_IF(input == nullptr, "'", input_name, "' is not an input of the model of ", stage_name, ".");
+    ORT_RETURN_IF(output->type().tensor_type().elem_type() != input->type().tensor_type().elem_type(),
+                  "The output '", output_name, "' and the input '", input_name, "' of ", stage_name,
+                  " have different element types.");
+    ORT_RETURN_IF(!renames.emplace(input_name, output_name).second, "The input '", input_name, "' of ", stage_name,
+                  " is connected more than once.");
+    connected_outputs.insert(output_name);
+  }
+
+  // the values of the composed model, which the inputs and outputs of the stage keeping their names can't redefine
+  std::unordered_set<std::string> values;
+  for (const auto& input : graph.input()) {
+    values.insert(input.name());
+  }
+  for (const auto& initializer : graph.initializer()) {
+    values.insert(initializer.name());
+  }
+  for (const auto& node : graph.node()) {
+    values.insert(node.output().begin(), node.output().end());
+  }
+
+  std::vector<ONNX_NAMESPACE::ValueInfoProto> new_inputs;
+  for (const auto& input : stage.input()) {
+    if (renames.count(input.name()) != 0) {
+      continue;
+    }
+
+    renames.emplace(input.name(), input.name());
+    if (const auto* shared_input = FindByName(graph.input(), input.name()); shared_input != nullptr) {
+      ORT_RETURN_IF(shared_input->type().SerializeAsString() != input.type().SerializeAsString(), "The input '",
+                    input.name(), "' of ", stage_name, " has a different type than the input of the composed model.");
+      continue;
+    }
+
+    ORT_RETURN_IF(values.count(input.name()) != 0, "The input '", input.name(), "' of ", stage_name,
+                  " conflicts with a value of the composed model.");
+    new_inputs.push_back(input);
+  }
+
+  for (const auto& output : stage.output()) {
+    ORT_RETURN_IF(values.count(output.name()) != 0 || FindByName(graph.output(), output.name()) != nullptr,
+                  "The output '", output.name(), "' of ", stage_name, " conflicts with a value of the composed model.");
+    renames.emplace(output.name(), output.name());
+  }
+
+  // the defaults of connected inputs are never used
+  auto& stage_initializers = *stage.mutable_initializer();
+  stage_initializers.erase(std::remove_if(stage_initializers.begin(), stage_initializers.end(),
+                                          [&renames](const auto& initializer) {
+                                            const auto it = renames.find(initializer.name());
+                                            return it != renames.end() && it->second != initializer.name();
+                                          }),
+                           stage_initializers.end());
+
+  const StageRenamer renamer("stage" + std::to_string(stage_index) + "/", std::move(renames), model_dir);
+  renamer.RenameGraph(stage);
+  for (auto& input : new_inputs) {
+    *graph.add_input() = std::move(input);
+  }
+
+  auto& outputs = *graph.mutable_output();
+  outputs.erase(std::remove_if(outputs.begin(), outputs.end(),
+                               [&connected_outputs](const auto& output) {
+                                 return connected_outputs.count(output.name()) != 0;
+                               }),
+                outputs.end());
+  for (auto& output : *stage.mutable_output()) {
+    *graph.add_output() = std::move(output);
+  }
+
+  for (auto& node : *stage.mutable_node()) {
+    *graph.add_node() = std::move(node);
+  }
+  for (auto& initializer : *stage.mutable_initializer()) {
+    *graph.add_initializer() = std::move(initializer);
+  }
+  for (auto& sparse_initializer : *stage.mutable_sparse_initializer()) {
+    *graph.add_sparse_initializer() = std::move(sparse_initializer);
+  }
+  for (auto& value_info : *stage.mutable_value_info()) {
+    *graph.add_value_info() = std::move(value_info);
+  }
+  for (auto& annotation : *stage.mutable_quantization_annotation()) {
+    *graph.add_quantization_annotation() = std::move(annotation);
+  }
+
+  ORT_RETURN_IF_ERROR(MergeOpsetImports(model_proto, stage_proto, stage_name));
+  ORT_RETURN_IF_ERROR(MergeFunctions(model_proto, stage_proto, stage_name));
+  model_proto.set_ir_version(std::max(model_proto.ir_version(), stage_proto.ir_version()));
+  return Status::OK();
+}
+
+}  // namespace
+
+Status Compose(const std::string& stages, ONNX_NAMESPACE::ModelProto& model_proto) {
+  size_t stage_index = 0;
+  for (const auto stage : utils::SplitString(stages, ";")) {
+    ++stage_index;
+    const auto separator = stage.find('|');
+    const std::filesystem::path stage_path = ToPathString(std::string{stage.substr(0, separator)});
+    const std::string_view connections =
+        separator == std::string_view::npos ? std::string_view{} : stage.substr(separator + 1);
+
+    ONNX_NAMESPACE::ModelProto stage_proto;
+    ORT_RETURN_IF_ERROR(Model::Load(stage_path.native(), stage_proto));
+    ORT_RETURN_IF_ERROR(AppendStage(model_proto, std::move(stage_proto), connections, stage_index,
+                                    std::filesystem::absolute(stage_path).parent_path()));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace model_composition
+}  // namespace onnxruntime
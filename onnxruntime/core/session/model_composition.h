@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/common/common.h"
+
+namespace ONNX_NAMESPACE {
+class ModelProto;
+}  // namespace ONNX_NAMESPACE
+
+namespace onnxruntime {
+namespace model_composition {
+
+// Appends the models of `stages`, in the format of kOrtSessionOptionsConfigComposeModels, to `model_proto`, so the
+// pipeline of models runs as one graph.
+// The nodes, initializers and intermediate values of the model of stage N are prefixed with "stage<N>/". The inputs
+// of a stage that are connected to outputs of the previous stages read these values, its other inputs become inputs
+// of the composed model, or are shared with an existing input of the same name. The connected outputs stop being
+// outputs of the composed model and the outputs of the stage are added.
+Status Compose(const std::string& stages, ONNX_NAMESPACE::ModelProto& model_proto);
+
+}  // namespace model_composition
+}  // namespace onnxruntime
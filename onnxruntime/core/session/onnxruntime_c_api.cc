@@ -1052,6 +1052,16 @@ ORT_API_STATUS_IMPL(OrtApis::SynchronizeBoundOutputs, _Inout_ OrtIoBinding* bind
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::FreezeIoBinding, _Inout_ OrtIoBinding* binding_ptr) {
+  API_IMPL_BEGIN
+  return ToOrtStatus(binding_ptr->binding_->Freeze());
+  API_IMPL_END
+}
+
+ORT_API(void, OrtApis::UnfreezeIoBinding, _Inout_ OrtIoBinding* binding_ptr) {
+  binding_ptr->binding_->Unfreeze();
+}
+
 ORT_API_STATUS_IMPL(OrtApis::IsTensor, _In_ const OrtValue* value, _Out_ int* out) {
   auto v = reinterpret_cast<const ::OrtValue*>(value);
   *out = v->IsTensor() ? 1 : 0;
@@ -1242,6 +1252,26 @@ ORT_API_STATUS_IMPL(OrtApis::GetStringTensorContent, _In_ const OrtValue* value,
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::GetStringTensorElementViews, _In_ const OrtValue* value,
+                    _Out_writes_all_(count) const char** data, _Out_writes_all_(count) size_t* lengths, size_t count) {
+  API_IMPL_BEGIN
+  gsl::span<const std::string> str_span;
+  if (auto* status = GetTensorStringSpan(*value, str_span)) {
+    return status;
+  }
+
+  if (count != str_span.size()) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "count is not equal to the number of string elements");
+  }
+
+  for (const auto& str : str_span) {
+    *data++ = str.data();
+    *lengths++ = str.size();
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::GetStringTensorElement, _In_ const OrtValue* value,
                     size_t s_len, size_t index, _Out_writes_bytes_all_(s_len) void* s) {
   API_IMPL_BEGIN
@@ -2195,6 +2225,36 @@ ORT_API_STATUS_IMPL(OrtApis::SessionGetProfilingStartTimeNs, _In_ const OrtSessi
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionGetSampledProfile, _In_ const OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  const auto* session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  const auto* sampled_profiler = session->GetSessionState().GetSampledProfiler();
+  if (sampled_profiler == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT,
+                                 "Sampled profiling is not enabled. Set the session.sampled_profiling_rate "
+                                 "session config entry to enable it.");
+  }
+  *out = StrDup(sampled_profiler->ToPrometheusText(), allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetTensorStatistics, _In_ const OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  const auto* session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  const auto* collector = session->GetSessionState().GetTensorStatisticsCollector();
+  if (collector == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT,
+                                 "Tensor statistics are not collected. Set the session.collect_tensor_statistics "
+                                 "session config entry to 1 to collect them.");
+  }
+  *out = StrDup(collector->ToJson(), allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
 // End support for non-tensor types
 
 ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfg, _In_ size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes,
@@ -2229,6 +2289,12 @@ ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfgV2, _In_reads_(num_keys) const char*
       cfg->initial_growth_chunk_size_bytes = static_cast<int>(arena_config_values[i]);
     } else if (strcmp(arena_config_keys[i], "max_power_of_two_extend_bytes") == 0) {
       cfg->max_power_of_two_extend_bytes = static_cast<int64_t>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "thread_cache_max_chunk_bytes") == 0) {
+      cfg->thread_cache_max_chunk_bytes = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "use_cuda_mempool") == 0) {
+      cfg->use_cuda_mempool = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "cuda_mempool_release_threshold") == 0) {
+      cfg->cuda_mempool_release_threshold = static_cast<int64_t>(arena_config_values[i]);
     } else {
       std::ostringstream oss;
       oss << "Invalid key found: " << arena_config_keys[i];
@@ -2730,6 +2796,13 @@ static constexpr OrtApi ort_api_1_to_19 = {
     &OrtApis::KernelInfoGetAllocator,
     &OrtApis::AddExternalInitializersFromFilesInMemory,
     // End of Version 18 - DO NOT MODIFY ABOVE (see above text for more information)
+
+    &OrtApis::SessionGetSampledProfile,
+    &OrtApis::GetStringTensorElementViews,
+    &OrtApis::SessionGetTensorStatistics,
+    &OrtApis::RunOptionsSetGenerationStepCallback,
+    &OrtApis::FreezeIoBinding,
+    &OrtApis::UnfreezeIoBinding,
 };
 
 // OrtApiBase can never change as there is no way to know what version of OrtApiBase is returned by OrtGetApiBase.
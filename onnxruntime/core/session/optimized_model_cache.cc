@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/optimized_model_cache.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#include "core/common/cpuid_info.h"
+#include "core/framework/execution_providers.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/session_options.h"
+#include "core/graph/constants.h"
+#include "core/graph/model.h"
+#include "core/graph/onnx_protobuf.h"
+#include "onnxruntime_config.h"
+
+namespace onnxruntime {
+namespace optimized_model_cache {
+
+namespace {
+
+std::string HashToHex(const void* data, size_t size) {
+  uint32_t hash[4];
+  MurmurHash3::x86_128(data, static_cast<int>(size), 0, hash);
+
+  std::ostringstream hex;
+  hex << std::hex << std::setfill('0');
+  for (uint32_t word : hash) {
+    hex << std::setw(8) << word;
+  }
+  return hex.str();
+}
+
+void DescribeCpu(std::ostream& out) {
+  const auto& cpuid_info = CPUIDInfo::GetCPUIDInfo();
+  out << "cpu:" << cpuid_info.HasSSE3() << cpuid_info.HasSSE4_1() << cpuid_info.HasAVX() << cpuid_info.HasAVX2()
+      << cpuid_info.HasF16C() << cpuid_info.HasAVX512f() << cpuid_info.HasAVX512Skylake()
+      << cpuid_info.HasAVX512_BF16() << cpuid_info.HasAMX_BF16() << cpuid_info.HasArmNeonDot()
+      << cpuid_info.HasArmNeon_I8MM() << cpuid_info.HasArmSVE_I8MM() << cpuid_info.HasArmNeon_BF16()
+      << cpuid_info.HasFp16VectorAcceleration() << '\n';
+}
+
+}  // namespace
+
+bool IsSupportedExecutionProvider(const std::string& provider_type) {
+  return provider_type == kCpuExecutionProvider ||
+         provider_type == kCudaExecutionProvider ||
+         provider_type == kRocmExecutionProvider;
+}
+
+Status ComputeKey(const Model& model, const SessionOptions& session_options,
+                  const ExecutionProviders& execution_providers,
+                  const InlinedHashSet<std::string>& optimizers_to_disable, std::string& key) {
+  std::ostringstream description;
+  description << "ort:" << ORT_VERSION << '\n';
+
+  {
+    // initializers with external data are referenced by location, so the serialized model stays small
+    const auto model_proto = model.ToProto();
+    ORT_RETURN_IF(model_proto.ByteSizeLong() > static_cast<size_t>(std::numeric_limits<int>::max()),
+                  "The model is too large to be hashed.");
+    std::string model_bytes;
+    ORT_RETURN_IF_NOT(model_proto.SerializeToString(&model_bytes), "Failed to serialize the model.");
+    description << "model:" << HashToHex(model_bytes.data(), model_bytes.size()) << '\n';
+  }
+
+  description << "level:" << static_cast<int>(session_options.graph_optimization_level) << '\n';
+
+  std::vector<std::string> disabled(optimizers_to_disable.begin(), optimizers_to_disable.end());
+  std::sort(disabled.begin(), disabled.end());
+  for (const auto& name : disabled) {
+    description << "disabled:" << name << '\n';
+  }
+
+  for (const auto& dim_override : session_options.free_dimension_overrides) {
+    description << "dim:" << dim_override.dim_identifier << ':'
+                << static_cast<int>(dim_override.dim_identifer_type) << ':' << dim_override.dim_value << '\n';
+  }
+
+  const std::map<std::string, std::string> config_entries(session_options.config_options.configurations.begin(),
+                                                          session_options.config_options.configurations.end());
+  for (const auto& [name, value] : config_entries) {
+    description << "config:" << name << '=' << value << '\n';
+  }
+
+  for (const auto& ep : execution_providers) {
+    description << "ep:" << ep->Type() << '\n';
+    const auto provider_options = ep->GetProviderOptions();
+    const std::map<std::string, std::string> sorted_options(provider_options.begin(), provider_options.end());
+    for (const auto& [name, value] : sorted_options) {
+      description << "ep_option:" << name << '=' << value << '\n';
+    }
+  }
+
+  // the session adds a default CPU EP if none was registered
+  if (execution_providers.Get(kCpuExecutionProvider) == nullptr) {
+    description << "ep:" << kCpuExecutionProvider << '\n';
+  }
+
+  DescribeCpu(description);
+
+  const std::string description_str = description.str();
+  key = HashToHex(description_str.data(), description_str.size());
+  return Status::OK();
+}
+
+}  // namespace optimized_model_cache
+}  // namespace onnxruntime
@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+
+namespace onnxruntime {
+
+class ExecutionProviders;
+class Model;
+struct SessionOptions;
+
+namespace optimized_model_cache {
+
+// Returns whether the nodes assigned to an execution provider of this type run with kernels, so the ORT format
+// model saved by a session using it can be reloaded without changing how the nodes run.
+bool IsSupportedExecutionProvider(const std::string& provider_type);
+
+// Computes the name of the entry of the optimized model cache for `model`, see
+// kOrtSessionOptionsConfigOptimizedModelCacheDir.
+// It's a hash of the serialized model, the ORT version, the session options and optimizers that affect the
+// optimized graph, the execution providers and their options, and the instruction set extensions of the CPU.
+Status ComputeKey(const Model& model, const SessionOptions& session_options,
+                  const ExecutionProviders& execution_providers,
+                  const InlinedHashSet<std::string>& optimizers_to_disable, std::string& key);
+
+}  // namespace optimized_model_cache
+}  // namespace onnxruntime
@@ -351,6 +351,21 @@ ORT_API_STATUS_IMPL(AddExternalInitializersFromFilesInMemory, _In_ OrtSessionOpt
                     _In_reads_(num_external_initializer_files) const size_t* file_lengths,
                     size_t num_external_initializer_files);
 
+ORT_API_STATUS_IMPL(SessionGetSampledProfile, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
+
+ORT_API_STATUS_IMPL(GetStringTensorElementViews, _In_ const OrtValue* value, _Out_writes_all_(count) const char** data,
+                    _Out_writes_all_(count) size_t* lengths, size_t count);
+
+ORT_API_STATUS_IMPL(SessionGetTensorStatistics, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
+
+ORT_API_STATUS_IMPL(RunOptionsSetGenerationStepCallback, _Inout_ OrtRunOptions* options,
+                    _In_opt_ OrtGenerationStepCallbackFn callback, _In_opt_ void* user_data);
+
+ORT_API_STATUS_IMPL(FreezeIoBinding, _Inout_ OrtIoBinding* binding_ptr);
+ORT_API(void, UnfreezeIoBinding, _Inout_ OrtIoBinding* binding_ptr);
+
 ORT_API_STATUS_IMPL(CreateOpAttr,
                     _In_ const char* name,
                     _In_ const void* data,
@@ -0,0 +1,248 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/run_result_cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensor.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/constants.h"
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Ops whose outputs are not a function of their inputs.
+const InlinedHashSet<std::string_view> kNondeterministicOps{
+    "Bernoulli", "Multinomial", "RandomNormal", "RandomNormalLike", "RandomUniform", "RandomUniformLike"};
+
+// Dropout ops of the com.microsoft domain. They are treated as nondeterministic whatever their training mode is.
+const InlinedHashSet<std::string_view> kContribDropoutOps{"BiasDropout", "BitmaskBiasDropout", "BitmaskDropout"};
+
+// The training_mode input of Dropout since opset 12 makes it random unless it's a constant false initializer.
+bool IsDropoutInTrainingMode(const Graph& graph, const Node& node) {
+  const auto& inputs = node.InputDefs();
+  if (inputs.size() < 3 || !inputs[2]->Exists()) {
+    return false;
+  }
+
+  const ONNX_NAMESPACE::TensorProto* training_mode = graph.GetConstantInitializer(inputs[2]->Name(), true);
+  if (training_mode == nullptr) {
+    return true;
+  }
+
+  bool value = true;
+  return !utils::UnpackTensor(*training_mode, graph.ModelPath(), &value, 1).IsOK() || value;
+}
+
+bool IsCacheable(const OrtValue& value) {
+  if (!value.IsAllocated() || !value.IsTensor()) {
+    return false;
+  }
+
+  const Tensor& tensor = value.Get<Tensor>();
+  return tensor.Location().device.Type() == OrtDevice::CPU;
+}
+
+bool TensorsEqual(const Tensor& a, const Tensor& b) {
+  if (a.DataType() != b.DataType() || a.Shape() != b.Shape()) {
+    return false;
+  }
+
+  if (a.IsDataTypeString()) {
+    auto a_strings = a.DataAsSpan<std::string>();
+    auto b_strings = b.DataAsSpan<std::string>();
+    return std::equal(a_strings.begin(), a_strings.end(), b_strings.begin());
+  }
+
+  return std::memcmp(a.DataRaw(), b.DataRaw(), a.SizeInBytes()) == 0;
+}
+
+uint32_t HashBytes(const void* data, size_t size, uint32_t seed) {
+  // MurmurHash3 takes an int length, hash larger buffers in chunks.
+  constexpr size_t kChunkSize = size_t{1} << 30;
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  do {
+    const size_t chunk = std::min(size, kChunkSize);
+    MurmurHash3::x86_32(bytes, static_cast<int>(chunk), seed, &seed);
+    bytes += chunk;
+    size -= chunk;
+  } while (size > 0);
+  return seed;
+}
+
+}  // namespace
+
+RunResultCache::RunResultCache(size_t capacity, AllocatorPtr allocator)
+    : capacity_(capacity), allocator_(std::move(allocator)) {
+  ORT_ENFORCE(capacity_ > 0, "The capacity of the run result cache must be positive.");
+  ORT_ENFORCE(allocator_ != nullptr && allocator_->Info().device.Type() == OrtDevice::CPU,
+              "The run result cache requires a CPU allocator.");
+}
+
+bool RunResultCache::IsDeterministic(const Graph& graph) {
+  for (const auto& node : graph.Nodes()) {
+    const auto& domain = node.Domain();
+    if (domain == kOnnxDomain) {
+      if (kNondeterministicOps.count(node.OpType()) > 0 ||
+          (node.OpType() == "Dropout" && IsDropoutInTrainingMode(graph, node))) {
+        return false;
+      }
+    } else if (domain == kMSDomain) {
+      if (kContribDropoutOps.count(node.OpType()) > 0) {
+        return false;
+      }
+    } else if (domain != kMLDomain) {
+      // custom ops may have state or side effects
+      return false;
+    }
+
+    for (const auto* subgraph : node.GetSubgraphs()) {
+      if (!IsDeterministic(*subgraph)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+uint32_t RunResultCache::Hash(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                              gsl::span<const std::string> output_names) {
+  uint32_t hash = 0;
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    hash = HashBytes(feed_names[i].data(), feed_names[i].size(), hash);
+
+    const Tensor& tensor = feeds[i].Get<Tensor>();
+    const int32_t element_type = tensor.GetElementType();
+    hash = HashBytes(&element_type, sizeof(element_type), hash);
+    const auto dims = tensor.Shape().GetDims();
+    hash = HashBytes(dims.data(), dims.size_bytes(), hash);
+
+    if (tensor.IsDataTypeString()) {
+      for (const auto& str : tensor.DataAsSpan<std::string>()) {
+        hash = HashBytes(str.data(), str.size(), hash);
+      }
+    } else {
+      hash = HashBytes(tensor.DataRaw(), tensor.SizeInBytes(), hash);
+    }
+  }
+
+  for (const auto& name : output_names) {
+    hash = HashBytes(name.data(), name.size(), hash);
+  }
+
+  return hash;
+}
+
+bool RunResultCache::Matches(const Entry& entry, gsl::span<const std::string> feed_names,
+                             gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names) {
+  if (!std::equal(entry.feed_names.begin(), entry.feed_names.end(), feed_names.begin(), feed_names.end()) ||
+      !std::equal(entry.output_names.begin(), entry.output_names.end(), output_names.begin(), output_names.end())) {
+    return false;
+  }
+
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    if (!TensorsEqual(entry.feeds[i].Get<Tensor>(), feeds[i].Get<Tensor>())) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+OrtValue RunResultCache::Copy(const OrtValue& value) const {
+  const Tensor& tensor = value.Get<Tensor>();
+  OrtValue copy;
+  Tensor::InitOrtValue(tensor.DataType(), tensor.Shape(), allocator_, copy);
+  Tensor& copy_tensor = *copy.GetMutable<Tensor>();
+
+  if (tensor.IsDataTypeString()) {
+    auto src = tensor.DataAsSpan<std::string>();
+    std::copy(src.begin(), src.end(), copy_tensor.MutableData<std::string>());
+  } else {
+    std::memcpy(copy_tensor.MutableDataRaw(), tensor.DataRaw(), tensor.SizeInBytes());
+  }
+
+  return copy;
+}
+
+bool RunResultCache::Find(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                          gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches) {
+  if (feed_names.size() != feeds.size() ||
+      std::any_of(fetches.begin(), fetches.end(), [](const OrtValue& value) { return value.IsAllocated(); }) ||
+      !std::all_of(feeds.begin(), feeds.end(), [](const OrtValue& value) { return IsCacheable(value); })) {
+    return false;
+  }
+
+  const uint32_t hash = Hash(feed_names, feeds, output_names);
+
+  // Share the cached values under the lock, copy them outside of it.
+  std::vector<OrtValue> cached_fetches;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(hash);
+    if (it == index_.end() || !Matches(*it->second, feed_names, feeds, output_names)) {
+      return false;
+    }
+
+    entries_.splice(entries_.begin(), entries_, it->second);
+    cached_fetches = it->second->fetches;
+  }
+
+  fetches.clear();
+  fetches.reserve(cached_fetches.size());
+  for (const auto& value : cached_fetches) {
+    fetches.push_back(Copy(value));
+  }
+
+  return true;
+}
+
+void RunResultCache::Insert(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                            gsl::span<const std::string> output_names, gsl::span<const OrtValue> fetches) {
+  if (feed_names.size() != feeds.size() || output_names.size() != fetches.size() ||
+      !std::all_of(feeds.begin(), feeds.end(), [](const OrtValue& value) { return IsCacheable(value); }) ||
+      !std::all_of(fetches.begin(), fetches.end(), [](const OrtValue& value) { return IsCacheable(value); })) {
+    return;
+  }
+
+  Entry entry;
+  entry.hash = Hash(feed_names, feeds, output_names);
+  entry.feed_names.assign(feed_names.begin(), feed_names.end());
+  entry.output_names.assign(output_names.begin(), output_names.end());
+  entry.feeds.reserve(feeds.size());
+  for (const auto& value : feeds) {
+    entry.feeds.push_back(Copy(value));
+  }
+  entry.fetches.reserve(fetches.size());
+  for (const auto& value : fetches) {
+    entry.fetches.push_back(Copy(value));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // A concurrent Run with the same feeds or a hash collision, the newer entry replaces the existing one.
+  auto it = index_.find(entry.hash);
+  if (it != index_.end()) {
+    entries_.erase(it->second);
+    index_.erase(it);
+  } else if (entries_.size() == capacity_) {
+    index_.erase(entries_.back().hash);
+    entries_.pop_back();
+  }
+
+  entries_.push_front(std::move(entry));
+  index_.emplace(entries_.front().hash, entries_.begin());
+}
+
+size_t RunResultCache::Size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+
+namespace onnxruntime {
+
+class Graph;
+
+/**
+ * Bounded LRU cache of the outputs of InferenceSession::Run, see kOrtSessionOptionsConfigRunResultCacheSize.
+ *
+ * Entries are keyed on a MurmurHash3 of the feed names, output names, element types, shapes and data of the feeds.
+ * A hash match is confirmed by comparing the feeds with the ones stored in the entry, so collisions never return
+ * the outputs of different inputs. The feeds and outputs are copied in and out of the cache, so callers are free
+ * to modify the values they passed to or received from Run.
+ *
+ * Only dense CPU tensors are cached. Runs with pre-allocated fetches are neither looked up nor inserted.
+ */
+class RunResultCache {
+ public:
+  // `capacity` is the maximum number of entries, it must be positive.
+  // Cached values are allocated with `allocator`, which must allocate CPU memory.
+  RunResultCache(size_t capacity, AllocatorPtr allocator);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunResultCache);
+
+  // Returns whether the outputs of `graph` and all its subgraphs only depend on the inputs, i.e. it has no random
+  // number generators, no Dropout in training mode and no nodes of custom op domains whose behavior is unknown.
+  static bool IsDeterministic(const Graph& graph);
+
+  // If a previous Run with the same feeds and output names was cached, copies its outputs to `fetches` and
+  // returns true. `fetches` must be empty or only contain unallocated values. Thread safe.
+  bool Find(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+            gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches);
+
+  // Caches the outputs of a successful Run, evicting the least recently used entry if the cache is full.
+  // Does nothing if any of the feeds or fetches is not a dense CPU tensor. Thread safe.
+  void Insert(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+              gsl::span<const std::string> output_names, gsl::span<const OrtValue> fetches);
+
+  size_t Size() const;
+
+ private:
+  struct Entry {
+    uint32_t hash;
+    std::vector<std::string> feed_names;
+    std::vector<OrtValue> feeds;
+    std::vector<std::string> output_names;
+    std::vector<OrtValue> fetches;
+  };
+
+  static uint32_t Hash(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                       gsl::span<const std::string> output_names);
+
+  static bool Matches(const Entry& entry, gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                      gsl::span<const std::string> output_names);
+
+  OrtValue Copy(const OrtValue& value) const;
+
+  const size_t capacity_;
+  const AllocatorPtr allocator_;
+
+  mutable std::mutex mutex_;
+  std::list<Entry> entries_;  // most recently used first
+  InlinedHashMap<uint32_t, std::list<Entry>::iterator> index_;
+};
+
+}  // namespace onnxruntime
@@ -21,8 +21,12 @@ struct OrtThreadPoolParams {
   // If it is true, the thread pool will spin a while after the queue became empty.
   bool allow_spinning = true;
 
+  // If it is non-negative, the threads spin for this many microseconds instead of a fixed number of iterations.
+  int spin_duration_us = -1;
+
   // It it is non-negative, thread pool will split a task by a decreasing block size
-  // of remaining_of_total_iterations / (num_of_threads * dynamic_block_base_)
+  // of remaining_of_total_iterations / (num_of_threads * dynamic_block_base_).
+  // On hybrid cpus the block size of threads on efficient cores is further scaled by their relative throughput.
   int dynamic_block_base_ = 0;
 
   unsigned int stack_size = 0;
@@ -42,6 +46,10 @@ struct OrtThreadPoolParams {
   // Set or unset denormal as zero
   bool set_denormal_as_zero = false;
 
+  // If it is true, workers are grouped by the NUMA node of their affinity and
+  // the thread pool keeps scheduling and work stealing local to a node where possible.
+  bool numa_aware_scheduling = false;
+
   // members to manage custom threads
   OrtCustomCreateThreadFn custom_create_thread_fn = nullptr;
   void* custom_thread_creation_options = nullptr;
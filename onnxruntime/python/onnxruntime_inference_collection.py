@@ -317,10 +317,48 @@ class Session:
         """
         return self._sess.get_profiling_start_time_ns
 
+    def get_tensor_statistics(self):
+        """
+        Return the calibration statistics collected during the runs of the session as a JSON string.
+
+        The statistics are collected when the session config entry ``session.collect_tensor_statistics`` is ``1``.
+        Each float tensor of the graph has its ``count``, ``min``, ``max`` and a ``histogram`` of its absolute
+        values whose bins are ``histogram_bin_width`` wide.
+        """
+        return self._sess.get_tensor_statistics()
+
     def io_binding(self):
         "Return an onnxruntime.IOBinding object`."
         return IOBinding(self)
 
+    def run_with_buffers(self, output_names, input_feed, output_buffers=None, run_options=None, return_dlpack=False):
+        """
+        Compute the predictions without copying the inputs or the outputs.
+
+        :param output_names: name of the outputs
+        :param input_feed: dictionary ``{ input_name: input_value }`` where every value is
+            an :class:`onnxruntime.OrtValue`, a C-contiguous numpy array, an object exposing
+            ``__array_interface__`` or, in training builds, an object implementing ``__dlpack__``
+        :param output_buffers: optional dictionary ``{ output_name: buffer }`` of preallocated outputs
+            of the same kinds as the inputs. The outputs are written to these buffers, which are returned.
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+        :param return_dlpack: return the outputs without a buffer as DLPack capsules instead of numpy arrays,
+            only in training builds
+        :return: list of results, every result is either a given buffer, a numpy array over the memory
+            of the output, a DLPack capsule, a sparse tensor, a list or a dictionary.
+
+        The GIL is released during the whole execution of the model.
+
+        ::
+
+            y = np.empty((3, 2), dtype=np.float32)
+            sess.run_with_buffers([output_name], {input_name: x}, {output_name: y})
+        """
+        self._validate_input(list(input_feed.keys()))
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+        return self._sess.run_with_buffers(output_names, input_feed, output_buffers or {}, run_options, return_dlpack)
+
     def run_with_iobinding(self, iobinding, run_options=None):
         """
         Compute the predictions.
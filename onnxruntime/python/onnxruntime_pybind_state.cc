@@ -378,6 +378,68 @@ py::object AddTensorAsPyObj(const OrtValue& val, const DataTransferManager* data
   return GetPyObjFromTensor(val, data_transfer_manager, mem_cpy_to_host_functions);
 }
 
+// Returns whether the input or output `name` of `defs` is a bool tensor, DLPack doesn't tell bool from uint8.
+static bool IsBoolTensorArg(const std::vector<const NodeArg*>* defs, const std::string& name) {
+  if (defs == nullptr) {
+    return false;
+  }
+  for (const auto* def : *defs) {
+    if (def->Name() == name) {
+      const auto* type_proto = def->TypeAsProto();
+      return type_proto != nullptr && type_proto->has_tensor_type() &&
+             type_proto->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_BOOL;
+    }
+  }
+  return false;
+}
+
+// Wraps a tensor given to run_with_buffers in an OrtValue without copying its data. The tensor is an OrtValue, an
+// object implementing __dlpack__ (training builds only), or a C-contiguous numpy array or object exposing
+// __array_interface__. The objects that own the memory the OrtValue points to are appended to `owners`, which must
+// be kept alive until the Run has finished.
+static OrtValue OrtValueFromBufferObject(const std::string& name, const py::object& obj, bool is_bool_tensor,
+                                         bool is_output, std::vector<py::object>& owners) {
+  if (py::isinstance<OrtValue>(obj)) {
+    return *obj.cast<OrtValue*>();
+  }
+  if (strcmp(Py_TYPE(obj.ptr())->tp_name, PYTHON_ORTVALUE_OBJECT_NAME) == 0) {
+    return *obj.attr(PYTHON_ORTVALUE_NATIVE_OBJECT_ATTR).cast<OrtValue*>();
+  }
+#ifdef ENABLE_TRAINING
+  if (py::hasattr(obj, "__dlpack__")) {
+    // the OrtValue takes the ownership of the DLPack tensor, which keeps the memory alive
+    py::object capsule = obj.attr("__dlpack__")();
+    return FromDlpack(capsule.ptr(), is_bool_tensor);
+  }
+#else
+  ORT_UNUSED_PARAMETER(is_bool_tensor);
+#endif
+
+  // a view for numpy arrays and objects exposing __array_interface__, never a copy
+  auto array = py::array::ensure(obj);
+  if (!array) {
+    PyErr_Clear();
+    throw std::runtime_error("The value of '" + name +
+                             "' must be an OrtValue, a numpy array or an object exposing __array_interface__.");
+  }
+  if ((array.flags() & py::array::c_style) == 0) {
+    throw std::runtime_error("The value of '" + name + "' must be a C-contiguous array.");
+  }
+  const int npy_type = array.dtype().num();
+  if (!IsNumericNumpyType(npy_type)) {
+    throw std::runtime_error("The value of '" + name + "' must be a numeric array.");
+  }
+  if (is_output && !array.writeable()) {
+    throw std::runtime_error("The buffer of output '" + name + "' must be writeable.");
+  }
+
+  OrtValue value;
+  Tensor::InitOrtValue(NumpyTypeToOnnxRuntimeTensorType(npy_type), GetShape(array),
+                       const_cast<void*>(array.data()), GetAllocator()->Info(), value);
+  owners.push_back(std::move(array));
+  return value;
+}
+
 static std::unique_ptr<onnxruntime::IExecutionProvider> LoadExecutionProvider(
     const std::string& ep_shared_lib_path,
     const ProviderOptions& provider_options = {},
@@ -800,6 +862,14 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
             } else {
               ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_engine_hw_compatible' should be 'True' or 'False'. Default value is 'False'.\n");
             }
+          } else if (option.first == "trt_async_engine_build") {
+            if (option.second == "True" || option.second == "true") {
+              params.trt_async_engine_build = true;
+            } else if (option.second == "False" || option.second == "false") {
+              params.trt_async_engine_build = false;
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_async_engine_build' should be 'True' or 'False'. Default value is 'False'.\n");
+            }
           } else {
             ORT_THROW("Invalid TensorRT EP option: ", option.first);
           }
@@ -1533,6 +1603,12 @@ void addObjectMethods(py::module& m, ExecutionProviderRegistrationFn ep_registra
             ort_arena_cfg->initial_growth_chunk_size_bytes = kvp.second.cast<int>();
           } else if (key == "max_power_of_two_extend_bytes") {
             ort_arena_cfg->max_power_of_two_extend_bytes = kvp.second.cast<int>();
+          } else if (key == "thread_cache_max_chunk_bytes") {
+            ort_arena_cfg->thread_cache_max_chunk_bytes = kvp.second.cast<int>();
+          } else if (key == "use_cuda_mempool") {
+            ort_arena_cfg->use_cuda_mempool = kvp.second.cast<int>();
+          } else if (key == "cuda_mempool_release_threshold") {
+            ort_arena_cfg->cuda_mempool_release_threshold = kvp.second.cast<int64_t>();
           } else {
             ORT_THROW("Invalid OrtArenaCfg option: ", key);
           }
@@ -1544,7 +1620,10 @@ void addObjectMethods(py::module& m, ExecutionProviderRegistrationFn ep_registra
       .def_readwrite("initial_chunk_size_bytes", &OrtArenaCfg::initial_chunk_size_bytes)
       .def_readwrite("max_dead_bytes_per_chunk", &OrtArenaCfg::max_dead_bytes_per_chunk)
       .def_readwrite("initial_growth_chunk_size_bytes", &OrtArenaCfg::initial_growth_chunk_size_bytes)
-      .def_readwrite("max_power_of_two_extend_bytes", &OrtArenaCfg::max_power_of_two_extend_bytes);
+      .def_readwrite("max_power_of_two_extend_bytes", &OrtArenaCfg::max_power_of_two_extend_bytes)
+      .def_readwrite("thread_cache_max_chunk_bytes", &OrtArenaCfg::thread_cache_max_chunk_bytes)
+      .def_readwrite("use_cuda_mempool", &OrtArenaCfg::use_cuda_mempool)
+      .def_readwrite("cuda_mempool_release_threshold", &OrtArenaCfg::cuda_mempool_release_threshold);
 
   py::class_<OrtMemoryInfo> ort_memory_info_binding(m, "OrtMemoryInfo");
   ort_memory_info_binding.def(py::init([](const char* name, OrtAllocatorType type, int id, OrtMemType mem_type) {
@@ -2092,12 +2171,101 @@ including arg name, arg type (contains both type and shape).)pbdoc")
         py::gil_scoped_release release;
         OrtPybindThrowIfError(sess->GetSessionHandle()->Run(run_options, feed_names, feeds, fetch_names, &fetches, &fetch_devices));
       })
+      /// Runs without copying the feeds or the outputs. Each feed is an OrtValue, a numpy array, an object exposing
+      /// __array_interface__ or, in training builds, an object implementing __dlpack__. The outputs found in
+      /// `output_buffers` are written to the given buffers, which are returned as they are. The other outputs are
+      /// returned as numpy arrays over the memory of the outputs, or as DLPack capsules if `return_dlpack` is true.
+      .def(
+          "run_with_buffers",
+          [](PyInferenceSession* sess, const std::vector<std::string>& output_names, const py::dict& feeds,
+             const py::dict& output_buffers, RunOptions* run_options, bool return_dlpack) -> py::list {
+#ifndef ENABLE_TRAINING
+            if (return_dlpack) {
+              throw std::runtime_error("DLPack outputs are not supported in this build.");
+            }
+#endif
+            const auto model_inputs = sess->GetSessionHandle()->GetModelInputs();
+            OrtPybindThrowIfError(model_inputs.first);
+            const auto model_outputs = sess->GetSessionHandle()->GetModelOutputs();
+            OrtPybindThrowIfError(model_outputs.first);
+
+            std::vector<py::object> owners;
+            std::vector<std::string> feed_names;
+            std::vector<OrtValue> ort_feeds;
+            feed_names.reserve(feeds.size());
+            ort_feeds.reserve(feeds.size());
+            for (const auto& item : feeds) {
+              if (item.second.is_none()) {
+                continue;
+              }
+              feed_names.push_back(item.first.cast<std::string>());
+              const std::string& name = feed_names.back();
+              ort_feeds.push_back(OrtValueFromBufferObject(name, py::reinterpret_borrow<py::object>(item.second),
+                                                           IsBoolTensorArg(model_inputs.second, name), false,
+                                                           owners));
+            }
+
+            std::vector<py::object> buffers(output_names.size());
+            std::vector<OrtValue> fetches(output_names.size());
+            for (size_t i = 0; i < output_names.size(); ++i) {
+              const py::str name(output_names[i]);
+              if (output_buffers.contains(name)) {
+                buffers[i] = output_buffers[name];
+                fetches[i] = OrtValueFromBufferObject(output_names[i], buffers[i],
+                                                      IsBoolTensorArg(model_outputs.second, output_names[i]), true,
+                                                      owners);
+              }
+            }
+
+            {
+              // release GIL to allow multiple python threads to invoke Run() in parallel.
+              py::gil_scoped_release release;
+              const RunOptions default_run_options;
+              OrtPybindThrowIfError(sess->GetSessionHandle()->Run(run_options != nullptr ? *run_options
+                                                                                          : default_run_options,
+                                                                  feed_names, ort_feeds, output_names, &fetches));
+            }
+
+            py::list result;
+            for (size_t i = 0; i < fetches.size(); ++i) {
+              const OrtValue& fetch = fetches[i];
+              if (buffers[i]) {
+                result.append(buffers[i]);
+              } else if (!fetch.IsAllocated()) {
+                result.append(py::none());
+              } else if (fetch.IsTensor()) {
+#ifdef ENABLE_TRAINING
+                if (return_dlpack) {
+                  result.append(py::reinterpret_steal<py::object>(ToDlpack(fetch)));
+                  continue;
+                }
+#endif
+                result.append(AddTensorAsPyObj(fetch, &sess->GetSessionHandle()->GetDataTransferManager(), nullptr));
+              } else if (fetch.IsSparseTensor()) {
+                result.append(GetPyObjectFromSparseTensor(i, fetch, nullptr));
+              } else {
+                result.append(AddNonTensorAsPyObj(fetch, nullptr, nullptr));
+              }
+            }
+            return result;
+          },
+          py::arg("output_names"), py::arg("feeds"), py::arg("output_buffers") = py::dict(),
+          py::arg("run_options") = nullptr, py::arg("return_dlpack") = false)
       .def("end_profiling", [](const PyInferenceSession* sess) -> std::string {
         return sess->GetSessionHandle()->EndProfiling();
       })
       .def_property_readonly("get_profiling_start_time_ns", [](const PyInferenceSession* sess) -> uint64_t {
         return sess->GetSessionHandle()->GetProfiling().GetStartTimeNs();
       })
+      .def("get_tensor_statistics", [](const PyInferenceSession* sess) -> std::string {
+        const auto* collector = sess->GetSessionHandle()->GetSessionState().GetTensorStatisticsCollector();
+        if (collector == nullptr) {
+          throw std::runtime_error(
+              "Tensor statistics are not collected. Set the session.collect_tensor_statistics session config entry "
+              "to 1 to collect them.");
+        }
+        return collector->ToJson();
+      })
       .def(
           "get_providers", [](const PyInferenceSession* sess) -> const std::vector<std::string>& {
             return sess->GetSessionHandle()->GetRegisteredProviderTypes();
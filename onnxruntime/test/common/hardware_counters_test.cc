@@ -0,0 +1,65 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/hardware_counters.h"
+
+#include "gtest/gtest.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime::test {
+
+using namespace profiling;
+
+TEST(HardwareCountersTest, Parse) {
+  HardwareCounterMask mask = 0;
+  ASSERT_STATUS_OK(ParseHardwareCounters("", mask));
+  EXPECT_EQ(mask, 0u);
+
+  ASSERT_STATUS_OK(ParseHardwareCounters("cycles,instructions,cache_misses", mask));
+  EXPECT_EQ(mask, (1u << HW_CPU_CYCLES) | (1u << HW_INSTRUCTIONS) | (1u << HW_CACHE_MISSES));
+
+  ASSERT_STATUS_NOT_OK(ParseHardwareCounters("cycles,stalls", mask));
+}
+
+TEST(HardwareCountersTest, ToJson) {
+  HardwareCounterValues counts{};
+  counts[HW_CPU_CYCLES] = 1000;
+  counts[HW_INSTRUCTIONS] = 2000;
+  counts[HW_CACHE_REFERENCES] = 100;
+  counts[HW_CACHE_MISSES] = 25;
+
+  const HardwareCounterMask mask = (1u << HW_CPU_CYCLES) | (1u << HW_INSTRUCTIONS) |
+                                   (1u << HW_CACHE_REFERENCES) | (1u << HW_CACHE_MISSES);
+  // 25 misses of 64 bytes in 1us
+  EXPECT_EQ(HardwareCountersToJson(mask, counts, 1),
+            "{\"cycles\": 1000, \"instructions\": 2000, \"cache_references\": 100, \"cache_misses\": 25, "
+            "\"ipc\": 2, \"cache_miss_rate\": 0.25, \"memory_bandwidth_gbps\": 1.6}");
+
+  EXPECT_EQ(HardwareCountersToJson(1u << HW_CPU_CYCLES, counts), "{\"cycles\": 1000}");
+}
+
+TEST(HardwareCountersTest, ReadOnlyReturnsRequestedCounters) {
+  HardwareCounterValues begin{};
+  EXPECT_EQ(ReadHardwareCounters(0, begin), 0u);
+
+  // the counters may not be available, e.g. in containers, but never ones that were not asked for
+  const HardwareCounterMask mask = (1u << HW_CPU_CYCLES) | (1u << HW_INSTRUCTIONS);
+  const HardwareCounterMask read = ReadHardwareCounters(mask, begin);
+  EXPECT_EQ(read & ~mask, 0u);
+
+  volatile uint64_t sum = 0;
+  for (uint64_t i = 0; i < 100000; ++i) {
+    sum = sum + i;
+  }
+
+  HardwareCounterValues end{};
+  if (read != 0 && ReadHardwareCounters(mask, end) == read) {
+    HardwareCounterValues counts{};
+    AccumulateHardwareCounters(begin, end, counts);
+    if ((read & (1u << HW_INSTRUCTIONS)) != 0) {
+      EXPECT_GT(counts[HW_INSTRUCTIONS], 0u);
+    }
+  }
+}
+
+}  // namespace onnxruntime::test
@@ -658,6 +658,95 @@ TEST(AttentionTest, AttentionNoMaskIndex) {
                    batch_size, sequence_length, hidden_size, number_of_heads);
 }
 
+// Computes the output of Attention with a 1D key sequence length mask, in double.
+static std::vector<float> ReferenceAttention(const std::vector<float>& input_data, const std::vector<float>& weight_data,
+                                             const std::vector<float>& bias_data,
+                                             const std::vector<int32_t>& mask_index_data, int batch_size,
+                                             int sequence_length, int hidden_size, int number_of_heads) {
+  const int head_size = hidden_size / number_of_heads;
+  const int qkv_size = 3 * hidden_size;
+
+  // qkv(B, S, 3 x D) = input(B, S, D) x weights(D, 3 x D) + bias(3 x D)
+  std::vector<double> qkv(static_cast<size_t>(batch_size) * sequence_length * qkv_size);
+  for (int r = 0; r < batch_size * sequence_length; r++) {
+    for (int c = 0; c < qkv_size; c++) {
+      double sum = bias_data[c];
+      for (int k = 0; k < hidden_size; k++) {
+        sum += static_cast<double>(input_data[r * hidden_size + k]) * weight_data[k * qkv_size + c];
+      }
+      qkv[static_cast<size_t>(r) * qkv_size + c] = sum;
+    }
+  }
+
+  std::vector<float> output(static_cast<size_t>(batch_size) * sequence_length * hidden_size);
+  std::vector<double> scores(sequence_length);
+  for (int b = 0; b < batch_size; b++) {
+    for (int n = 0; n < number_of_heads; n++) {
+      for (int i = 0; i < sequence_length; i++) {
+        const double* q = &qkv[(static_cast<size_t>(b) * sequence_length + i) * qkv_size + n * head_size];
+        double max_score = std::numeric_limits<double>::lowest();
+        for (int j = 0; j < sequence_length; j++) {
+          const double* k = &qkv[(static_cast<size_t>(b) * sequence_length + j) * qkv_size + hidden_size +
+                                 n * head_size];
+          double sum = 0.0;
+          for (int h = 0; h < head_size; h++) {
+            sum += q[h] * k[h];
+          }
+          scores[j] = sum / std::sqrt(static_cast<double>(head_size)) + (j < mask_index_data[b] ? 0.0 : -10000.0);
+          max_score = std::max(max_score, scores[j]);
+        }
+
+        double sum_exp = 0.0;
+        for (int j = 0; j < sequence_length; j++) {
+          scores[j] = std::exp(scores[j] - max_score);
+          sum_exp += scores[j];
+        }
+
+        for (int h = 0; h < head_size; h++) {
+          double value = 0.0;
+          for (int j = 0; j < sequence_length; j++) {
+            value += scores[j] * qkv[(static_cast<size_t>(b) * sequence_length + j) * qkv_size + 2 * hidden_size +
+                                     n * head_size + h];
+          }
+          output[(static_cast<size_t>(b) * sequence_length + i) * hidden_size + n * head_size + h] =
+              static_cast<float>(value / sum_exp);
+        }
+      }
+    }
+  }
+
+  return output;
+}
+
+// With enough heads for all the threads, the CPU kernel attends to each head as soon as it is projected.
+TEST(AttentionTest, AttentionManyHeads) {
+  int batch_size = 3;
+  int sequence_length = 7;
+  int hidden_size = 64;
+  int number_of_heads = 16;
+
+  std::vector<float> input_data(static_cast<size_t>(batch_size) * sequence_length * hidden_size);
+  for (size_t i = 0; i < input_data.size(); i++) {
+    input_data[i] = static_cast<float>(static_cast<int>(i * 7 % 19) - 9) * 0.1f;
+  }
+  std::vector<float> weight_data(static_cast<size_t>(hidden_size) * 3 * hidden_size);
+  for (size_t i = 0; i < weight_data.size(); i++) {
+    weight_data[i] = static_cast<float>(static_cast<int>(i * 5 % 23) - 11) * 0.02f;
+  }
+  std::vector<float> bias_data(3 * static_cast<size_t>(hidden_size));
+  for (size_t i = 0; i < bias_data.size(); i++) {
+    bias_data[i] = static_cast<float>(static_cast<int>(i % 7) - 3) * 0.05f;
+  }
+
+  std::vector<int32_t> mask_index_data = {7, 4, 1};
+
+  std::vector<float> output_data = ReferenceAttention(input_data, weight_data, bias_data, mask_index_data,
+                                                      batch_size, sequence_length, hidden_size, number_of_heads);
+
+  RunAttentionTest(input_data, weight_data, bias_data, mask_index_data, output_data,
+                   batch_size, sequence_length, hidden_size, number_of_heads);
+}
+
 TEST(AttentionTest, AttentionUnidirectional) {
   int batch_size = 1;
   int sequence_length = 2;
@@ -6,6 +6,7 @@
 #include "gtest/gtest.h"
 #include <gsl/gsl>
 #include "core/session/onnxruntime_cxx_api.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/common/cuda_op_test_utils.h"
 
 #ifdef USE_CUDA
@@ -388,5 +389,65 @@ TEST(BeamSearchTest, GptBeamSearchFp16_VocabPadded) {
   }
 }
 
+TEST(BeamSearchTest, GptBeamSearchWithPrefixCache) {
+  // The first prompt is cached, the second one shares its first 20 tokens and the third one is the first again.
+  const std::vector<int32_t> prompt{52, 195, 731, 321, 301, 734, 620, 41, 554, 74, 622, 206,
+                                    222, 75, 223, 221, 198, 224, 572, 328, 219, 328, 206, 288};
+  std::vector<int32_t> other_prompt(prompt.begin(), prompt.begin() + 20);
+  other_prompt.insert(other_prompt.end(), {896, 328, 669, 131});
+  const std::vector<std::vector<int32_t>> prompts{prompt, other_prompt, prompt};
+
+  auto run = [](Ort::Session& session, std::vector<int32_t> input_ids) {
+    std::vector<int64_t> input_ids_shape{1, static_cast<int64_t>(input_ids.size())};
+    std::vector<int64_t> parameter_shape{1};
+    std::vector<int32_t> max_length{32};
+    std::vector<int32_t> min_length{1};
+    std::vector<int32_t> num_beams{4};
+    std::vector<int32_t> num_return_sequences{1};
+    std::vector<float> length_penalty{1.0f};
+    std::vector<float> repetition_penalty{1.0f};
+
+    Ort::MemoryInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
+    std::vector<Ort::Value> ort_inputs;
+    ort_inputs.push_back(Ort::Value::CreateTensor(info, input_ids.data(), input_ids.size(),
+                                                  input_ids_shape.data(), input_ids_shape.size()));
+    ort_inputs.push_back(Ort::Value::CreateTensor(info, max_length.data(), max_length.size(),
+                                                  parameter_shape.data(), parameter_shape.size()));
+    ort_inputs.push_back(Ort::Value::CreateTensor(info, min_length.data(), min_length.size(),
+                                                  parameter_shape.data(), parameter_shape.size()));
+    ort_inputs.push_back(Ort::Value::CreateTensor(info, num_beams.data(), num_beams.size(),
+                                                  parameter_shape.data(), parameter_shape.size()));
+    ort_inputs.push_back(Ort::Value::CreateTensor(info, num_return_sequences.data(), num_return_sequences.size(),
+                                                  parameter_shape.data(), parameter_shape.size()));
+    ort_inputs.push_back(Ort::Value::CreateTensor(info, length_penalty.data(), length_penalty.size(),
+                                                  parameter_shape.data(), parameter_shape.size()));
+    ort_inputs.push_back(Ort::Value::CreateTensor(info, repetition_penalty.data(), repetition_penalty.size(),
+                                                  parameter_shape.data(), parameter_shape.size()));
+    const char* input_names[] = {"input_ids", "max_length", "min_length", "num_beams", "num_return_sequences",
+                                 "length_penalty", "repetition_penalty"};
+    const char* const output_names[] = {"sequences"};
+
+    auto ort_outputs = session.Run(Ort::RunOptions{}, input_names, ort_inputs.data(), ort_inputs.size(),
+                                   output_names, 1);
+    const auto& sequences = ort_outputs[0];
+    const auto* result_vals = sequences.GetTensorData<int32_t>();
+    return std::vector<int32_t>(result_vals, result_vals + sequences.GetTensorTypeAndShapeInfo().GetElementCount());
+  };
+
+  Ort::SessionOptions session_options;
+  Ort::Session session(*ort_env, ORT_TSTR("testdata/transformers/tiny_gpt2_beamsearch.onnx"), session_options);
+
+  Ort::SessionOptions cached_session_options;
+  cached_session_options.AddConfigEntry(kOrtSessionOptionsConfigGptPrefixCacheSize, "2");
+  Ort::Session cached_session(*ort_env, ORT_TSTR("testdata/transformers/tiny_gpt2_beamsearch.onnx"),
+                              cached_session_options);
+
+  for (const auto& input_ids : prompts) {
+    const auto expected_output = run(session, input_ids);
+    ASSERT_EQ(expected_output.size(), 32u);
+    EXPECT_EQ(run(cached_session, input_ids), expected_output);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace bpe_tokenizer_test {
+
+constexpr const char* domain = onnxruntime::kMSDomain;
+constexpr int opset_ver = 1;
+
+// "Ġ" is the character of the byte ' ', and "Ã©" the characters of the two bytes of "é".
+const std::vector<std::string> vocab{"h", "e", "l", "o", "Ġ", "w", "r", "d", "he", "ll", "hell", "hello", "Ġw",
+                                     "Ġwor", "Ġworld", "or", "ld", "<|endoftext|>", "Ã", "©", "Ã©"};
+const std::vector<std::string> merges{"h e", "l l", "he ll", "hell o", "Ġ w", "o r", "Ġw or", "l d", "Ġwor ld",
+                                      "Ã ©"};
+
+void AddTokenizerInputs(OpTester& test, const std::vector<int64_t>& dims, const std::vector<std::string>& input) {
+  test.AddInput<std::string>("X", dims, input);
+  test.AddInput<std::string>("vocab", {static_cast<int64_t>(vocab.size())}, vocab, true);
+  test.AddInput<std::string>("merges", {static_cast<int64_t>(merges.size())}, merges, true);
+}
+
+}  // namespace bpe_tokenizer_test
+
+using namespace bpe_tokenizer_test;
+
+TEST(ContribOpTest, BpeTokenizer_Merges) {
+  OpTester test("BpeTokenizer", opset_ver, domain);
+  test.AddAttribute<int64_t>("pad_token_id", 17);
+  AddTokenizerInputs(test, {3}, {"hello world", "hold", "\xC3\xA9"});
+
+  test.AddOutput<int64_t>("Y", {3, 3}, {11, 14, 17,
+                                         0, 3, 16,
+                                         20, 17, 17});
+  test.AddOutput<int64_t>("Y_lengths", {3}, {2, 3, 1});
+  test.Run();
+}
+
+TEST(ContribOpTest, BpeTokenizer_UnknownToken) {
+  OpTester test("BpeTokenizer", opset_ver, domain);
+  test.AddAttribute<int64_t>("unk_token_id", 17);
+  AddTokenizerInputs(test, {1, 1}, {"hex"});
+
+  test.AddOutput<int64_t>("Y", {1, 1, 2}, {8, 17});
+  test.Run();
+}
+
+TEST(ContribOpTest, BpeTokenizer_UnknownTokenWithoutUnkTokenId) {
+  OpTester test("BpeTokenizer", opset_ver, domain);
+  AddTokenizerInputs(test, {1}, {"hex"});
+
+  test.AddOutput<int64_t>("Y", {1, 2}, {8, 0});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "is not in the vocabulary");
+}
+
+TEST(ContribOpTest, BpeDetokenizer_SkipTokenIds) {
+  OpTester test("BpeDetokenizer", opset_ver, domain);
+  test.AddAttribute<std::vector<int64_t>>("skip_token_ids", {17});
+  test.AddInput<int64_t>("ids", {3, 3}, {11, 14, 17,
+                                         0, 3, 16,
+                                         20, 17, 17});
+  test.AddInput<std::string>("vocab", {static_cast<int64_t>(vocab.size())}, vocab, true);
+
+  test.AddOutput<std::string>("Y", {3}, {"hello world", "hold", "\xC3\xA9"});
+  test.Run();
+}
+
+TEST(ContribOpTest, BpeDetokenizer_IdOutOfVocabulary) {
+  OpTester test("BpeDetokenizer", opset_ver, domain);
+  test.AddInput<int64_t>("ids", {1, 2}, {11, 21});
+  test.AddInput<std::string>("vocab", {static_cast<int64_t>(vocab.size())}, vocab, true);
+
+  test.AddOutput<std::string>("Y", {1}, {""});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "is out of the vocabulary");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -280,5 +280,49 @@ TEST(DynamicQuantizeMatMul, B_PerColumn_ND) {
   test_case({15, 14, 13}, {15, 13, 27}, {15, 1, 27});
 }
 
+// Every row of A is a multiple of its own scale, so per row quantization is exact even though the rows differ in
+// magnitude by almost 100x and quantizing A with a single scale would lose most of the second row.
+TEST(DynamicQuantizeMatMul, PerRowAQuantization) {
+  constexpr int64_t M = 2;
+  constexpr int64_t K = 4;
+  constexpr int64_t N = 3;
+  const std::vector<float> A_data{63.5f, -12.0f, 0.5f, 3.0f,
+                                  1.27f, -0.5f, 0.25f, 0.01f};
+  const std::vector<int8_t> B_data{1, -2, 3,
+                                   4, 5, -6,
+                                   -7, 8, 9,
+                                   10, -11, 12};
+  const std::vector<float> B_scale{0.5f, 0.25f, 1.0f};
+  const std::vector<float> Bias{1.0f, 2.0f, 3.0f};
+
+  std::vector<float> Y_data(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = Bias[n];
+      for (int64_t k = 0; k < K; k++) {
+        sum += A_data[m * K + k] * B_data[k * N + n] * B_scale[n];
+      }
+      Y_data[m * N + n] = sum;
+    }
+  }
+
+  for (bool is_matrix_b_constant : {false, true}) {
+    OpTester test("DynamicQuantizeMatMul", 1, onnxruntime::kMSDomain);
+    test.AddAttribute<int64_t>("per_row_a_quantization", 1);
+    test.AddInput<float>("A", {M, K}, A_data);
+    test.AddInput<int8_t>("B", {K, N}, B_data, is_matrix_b_constant);
+    test.AddInput<float>("b_scale", {N}, B_scale);
+    test.AddOptionalInputEdge<int8_t>();
+    test.AddInput<float>("bias", {N}, Bias);
+    test.AddOutput<float>("Y", {M, N}, Y_data);
+    test.SetOutputRelErr("Y", 0.0001f);
+
+    // only the CPU kernel implements per_row_a_quantization
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+const std::vector<float> kWeight = {0.0f, 1.0f, 2.0f,
+                                    3.0f, 4.0f, 5.0f,
+                                    6.0f, 7.0f, 8.0f,
+                                    9.0f, 10.0f, 11.0f};
+}  // namespace
+
+TEST(EmbeddingBagOpTest, Sum) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("weight", {4, 3}, kWeight);
+  test.AddInput<int64_t>("indices", {2, 3}, {0, 1, 3, 2, 2, -1});
+  test.AddOutput<float>("Y", {2, 3}, {12.0f, 15.0f, 18.0f, 21.0f, 24.0f, 27.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, MeanKeepDims) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  test.AddAttribute<int64_t>("keepdims", 1);
+  test.AddInput<float>("weight", {4, 3}, kWeight);
+  test.AddInput<int32_t>("indices", {2, 2}, {0, 2, 1, 3});
+  test.AddOutput<float>("Y", {2, 1, 3}, {3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, Float16) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  test.AddInput<MLFloat16>("weight", {4, 3}, FloatsToMLFloat16s(kWeight));
+  test.AddInput<int64_t>("indices", {3, 2}, {1, 3, 0, 0, 2, 1});
+  test.AddOutput<MLFloat16>("Y", {3, 3}, FloatsToMLFloat16s({6.0f, 7.0f, 8.0f, 0.0f, 1.0f, 2.0f, 4.5f, 5.5f, 6.5f}));
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, IndexOutOfRange) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("weight", {4, 3}, kWeight);
+  test.AddInput<int64_t>("indices", {1, 2}, {0, 4});
+  test.AddOutput<float>("Y", {1, 3}, {0.0f, 0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices element out of data bounds");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
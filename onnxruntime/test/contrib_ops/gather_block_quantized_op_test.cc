@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+// Quantizes a [num_rows, K] matrix of known quantized values in the MatMulNBits block format and runs
+// GatherBlockQuantized on `indices`, with the expected output dequantized element by element.
+void RunGatherBlockQuantized(int64_t num_rows, int64_t K, int64_t bits, int64_t block_size, bool has_zero_points,
+                             const std::vector<int64_t>& indices_shape, const std::vector<int64_t>& indices) {
+  const int64_t blocks_per_row = (K + block_size - 1) / block_size;
+  const int64_t blob_size = block_size * bits / 8;
+  const int64_t zp_row_bytes = (blocks_per_row * bits + 7) / 8;
+  const int64_t max_q = (int64_t{1} << bits) - 1;
+
+  std::vector<uint8_t> data(num_rows * blocks_per_row * blob_size, 0);
+  std::vector<float> scales(num_rows * blocks_per_row);
+  std::vector<uint8_t> zero_points(num_rows * zp_row_bytes, 0);
+  std::vector<float> dequantized(num_rows * K);
+  for (int64_t n = 0; n < num_rows; ++n) {
+    for (int64_t b = 0; b < blocks_per_row; ++b) {
+      scales[n * blocks_per_row + b] = 0.25f * static_cast<float>(n + 1) + 0.125f * static_cast<float>(b);
+      const int64_t zp = has_zero_points ? (n * 5 + b * 3) % (max_q + 1) : (int64_t{1} << (bits - 1));
+      if (bits == 4) {
+        zero_points[n * zp_row_bytes + b / 2] |= static_cast<uint8_t>(zp << ((b & 1) * 4));
+      } else {
+        zero_points[n * zp_row_bytes + b] = static_cast<uint8_t>(zp);
+      }
+
+      for (int64_t k = b * block_size; k < std::min(K, (b + 1) * block_size); ++k) {
+        const int64_t q = (n * 7 + k * 3) % (max_q + 1);
+        const int64_t in_block = k - b * block_size;
+        uint8_t& byte = data[(n * blocks_per_row + b) * blob_size + (bits == 4 ? in_block / 2 : in_block)];
+        byte |= static_cast<uint8_t>(bits == 4 ? q << ((in_block & 1) * 4) : q);
+        dequantized[n * K + k] = static_cast<float>(q - zp) * scales[n * blocks_per_row + b];
+      }
+    }
+  }
+
+  std::vector<float> expected;
+  for (int64_t index : indices) {
+    const int64_t row = index < 0 ? index + num_rows : index;
+    expected.insert(expected.end(), dequantized.begin() + row * K, dequantized.begin() + (row + 1) * K);
+  }
+  std::vector<int64_t> output_shape = indices_shape;
+  output_shape.push_back(K);
+
+  OpTester test("GatherBlockQuantized", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("K", K);
+  test.AddAttribute<int64_t>("bits", bits);
+  test.AddAttribute<int64_t>("block_size", block_size);
+  test.AddInput<uint8_t>("data", {num_rows, blocks_per_row, blob_size}, data, true);
+  test.AddInput<int64_t>("indices", indices_shape, indices);
+  test.AddInput<float>("scales", {num_rows * blocks_per_row}, scales, true);
+  if (has_zero_points) {
+    test.AddInput<uint8_t>("zero_points", {num_rows * zp_row_bytes}, zero_points, true);
+  }
+  test.AddOutput<float>("Y", output_shape, expected);
+  test.Run();
+}
+}  // namespace
+
+TEST(GatherBlockQuantizedOpTest, Int4WithZeroPoints) {
+  RunGatherBlockQuantized(5, 40, 4, 16, true, {2, 3}, {4, 0, -1, 2, 2, 1});
+}
+
+TEST(GatherBlockQuantizedOpTest, Int4DefaultZeroPoints) {
+  RunGatherBlockQuantized(3, 32, 4, 32, false, {4}, {1, 2, 0, -3});
+}
+
+TEST(GatherBlockQuantizedOpTest, Int8) {
+  RunGatherBlockQuantized(4, 20, 8, 16, true, {3}, {3, 1, -4});
+  RunGatherBlockQuantized(4, 20, 8, 16, false, {3}, {0, 2, 2});
+}
+
+TEST(GatherBlockQuantizedOpTest, IndexOutOfRange) {
+  OpTester test("GatherBlockQuantized", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("K", int64_t{16});
+  test.AddAttribute<int64_t>("block_size", int64_t{16});
+  test.AddInput<uint8_t>("data", {2, 1, 8}, std::vector<uint8_t>(16, 0x88));
+  test.AddInput<int64_t>("indices", {1}, {2});
+  test.AddInput<float>("scales", {2}, {1.0f, 1.0f});
+  test.AddOutput<float>("Y", {1, 16}, std::vector<float>(16, 0.0f));
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices element out of data bounds");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include "gtest/gtest.h"
@@ -183,5 +184,59 @@ TEST(GreedySearchTest, GptGreedySearchFp32) {
   }
 }
 
+TEST(GreedySearchTest, GptGreedySearchFp32_GenerationStepCallback) {
+  std::vector<int64_t> input_ids_shape{2, 4};
+  std::vector<int32_t> input_ids{
+      0, 0, 0, 52, 0, 0, 195, 731};
+
+  std::vector<int64_t> parameter_shape{1};
+  std::vector<int32_t> max_length{10};
+  std::vector<int32_t> min_length{1};
+  std::vector<float> repetition_penalty{1.0f};
+
+  Ort::MemoryInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
+  std::vector<Ort::Value> ort_inputs;
+  ort_inputs.push_back(Ort::Value::CreateTensor(
+      info, input_ids.data(), input_ids.size(), input_ids_shape.data(), input_ids_shape.size()));
+  ort_inputs.push_back(Ort::Value::CreateTensor(
+      info, max_length.data(), max_length.size(), parameter_shape.data(), parameter_shape.size()));
+  ort_inputs.push_back(Ort::Value::CreateTensor(
+      info, min_length.data(), min_length.size(), parameter_shape.data(), parameter_shape.size()));
+  ort_inputs.push_back(Ort::Value::CreateTensor(
+      info, repetition_penalty.data(), repetition_penalty.size(), parameter_shape.data(), parameter_shape.size()));
+  const char* input_names[] = {"input_ids", "max_length", "min_length", "repetition_penalty"};
+  const char* const output_names[] = {"sequences"};
+
+  // Collects the tokens of each step, and ends the generation after the second one.
+  struct StreamedTokens {
+    std::vector<std::vector<int32_t>> steps;
+  } streamed;
+  auto callback = [](void* user_data, const int32_t* next_tokens, const bool* /*finished*/, size_t batch_size,
+                     size_t step) -> int {
+    auto* streamed_tokens = static_cast<StreamedTokens*>(user_data);
+    EXPECT_EQ(step, streamed_tokens->steps.size());
+    streamed_tokens->steps.emplace_back(next_tokens, next_tokens + batch_size);
+    return streamed_tokens->steps.size() == 2 ? 1 : 0;
+  };
+
+  Ort::RunOptions run_options;
+  run_options.SetGenerationStepCallback(callback, &streamed);
+
+  Ort::SessionOptions session_options;
+  Ort::Session session(*ort_env, ORT_TSTR("testdata/transformers/tiny_gpt2_greedysearch_with_init_decoder.onnx"),
+                       session_options);
+  auto ort_outputs = session.Run(run_options, input_names, ort_inputs.data(), ort_inputs.size(), output_names, 1);
+
+  const std::vector<std::vector<int32_t>> expected_steps{{204, 731}, {204, 114}};
+  ASSERT_EQ(streamed.steps, expected_steps);
+
+  ASSERT_EQ(ort_outputs.size(), 1U);
+  const auto result_shape = ort_outputs[0].GetTensorTypeAndShapeInfo().GetShape();
+  ASSERT_EQ(result_shape, (std::vector<int64_t>{input_ids_shape[0], max_length[0]}));
+  const auto* result_vals = ort_outputs[0].GetTensorData<int32_t>();
+  const std::vector<int32_t> expected_prefix{0, 0, 0, 52, 204, 204};
+  ASSERT_TRUE(std::equal(expected_prefix.cbegin(), expected_prefix.cend(), result_vals));
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -727,7 +727,6 @@ TEST(GroupNormTest, GroupNorm_128) {
       0.504504f, 0.382702f, 0.525628f, 0.443822f, -0.084682f, 1.613891f, -0.204372f, 2.062000f, 1.060236f,
       0.578661f, -0.086430f, 0.421238f, 0.818468f, 0.938992f, 0.802915f, 0.683523f};
 
-  // Test float16, without activation
   int min_cuda_architecture = 530;
   bool enable_cuda = HasCudaEnvironment(min_cuda_architecture);
   bool enable_rocm = (nullptr != DefaultRocmExecutionProvider().get());
@@ -736,8 +735,10 @@ TEST(GroupNormTest, GroupNorm_128) {
   std::array<int, 3> channels_last_values = {-1, 0, 1};
 
   for (const int channels_last : channels_last_values) {
-    if (enable_cuda || enable_rocm || enable_dml) {
+    // Test float16, without activation
+    {
       std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+      execution_providers.push_back(DefaultCpuExecutionProvider());
       if (enable_cuda && channels_last != 0) {
         execution_providers.push_back(DefaultCudaExecutionProvider());
       }
@@ -748,11 +749,6 @@ TEST(GroupNormTest, GroupNorm_128) {
         execution_providers.push_back(DefaultDmlExecutionProvider());
       }
 
-      // Don't run the test if no providers are supported
-      if (execution_providers.empty()) {
-        continue;
-      }
-
       OpTester test("GroupNorm", 1, onnxruntime::kMSDomain);
       test.AddAttribute<float>("epsilon", 1e-05f);
       test.AddAttribute<int64_t>("groups", 32);
@@ -784,8 +780,9 @@ TEST(GroupNormTest, GroupNorm_128) {
 
     // Test float32, with activation
     enable_cuda = HasCudaEnvironment(0);
-    if (enable_cuda || enable_rocm || enable_dml) {
+    {
       std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+      execution_providers.push_back(DefaultCpuExecutionProvider());
       if (enable_cuda && channels_last != 0) {
         execution_providers.push_back(DefaultCudaExecutionProvider());
       }
@@ -796,11 +793,6 @@ TEST(GroupNormTest, GroupNorm_128) {
         execution_providers.push_back(DefaultDmlExecutionProvider());
       }
 
-      // Don't run the test if no providers are supported
-      if (execution_providers.empty()) {
-        continue;
-      }
-
       OpTester test("GroupNorm", 1, onnxruntime::kMSDomain);
       test.AddAttribute<float>("epsilon", 1e-05f);
       test.AddAttribute<int64_t>("groups", 32);
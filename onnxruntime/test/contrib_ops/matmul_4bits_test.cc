@@ -3,7 +3,10 @@
 
 #ifndef ORT_MINIMAL_BUILD
 
+#include <algorithm>
+#include <cmath>
 #include <optional>
+#include <string>
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -80,6 +83,7 @@ struct TestOptions {
   bool zp_is_4bit{true};
   bool has_g_idx{false};
   bool has_bias{false};
+  std::string activation{};
 
   std::optional<float> output_abs_error{};
 };
@@ -91,7 +95,8 @@ std::ostream& operator<<(std::ostream& os, const TestOptions& opts) {
             << ", has_zero_point:" << opts.has_zero_point
             << ", zp_is_4bit:" << opts.zp_is_4bit
             << ", has_g_idx:" << opts.has_g_idx
-            << ", has_bias:" << opts.has_bias;
+            << ", has_bias:" << opts.has_bias
+            << ", activation:" << opts.activation;
 }
 
 template <typename T1>
@@ -170,12 +175,33 @@ void RunTest(const TestOptions& opts,
     }
   }
 
+  auto silu = [](float x) { return x / (1.0f + std::exp(-x)); };
+  int64_t output_N = N;
+  if (opts.activation == "silu") {
+    std::transform(expected_vals.begin(), expected_vals.end(), expected_vals.begin(), silu);
+  } else if (opts.activation == "gelu") {
+    std::transform(expected_vals.begin(), expected_vals.end(), expected_vals.begin(),
+                   [](float x) { return 0.5f * x * (1.0f + std::erf(x * 0.70710678f)); });
+  } else if (opts.activation == "swiglu") {
+    output_N = N / 2;
+    std::vector<float> swiglu_vals(M * output_N);
+    for (int64_t m = 0; m < M; m++) {
+      for (int64_t n = 0; n < output_N; n++) {
+        swiglu_vals[m * output_N + n] = silu(expected_vals[m * N + n]) * expected_vals[m * N + output_N + n];
+      }
+    }
+    expected_vals = std::move(swiglu_vals);
+  }
+
   OpTester test("MatMulNBits", 1, kMSDomain);
   test.AddAttribute<int64_t>("K", K);
   test.AddAttribute<int64_t>("N", N);
   test.AddAttribute<int64_t>("block_size", opts.block_size);
   test.AddAttribute<int64_t>("bits", QBits);
   test.AddAttribute<int64_t>("accuracy_level", opts.accuracy_level);
+  if (!opts.activation.empty()) {
+    test.AddAttribute<std::string>("activation", opts.activation);
+  }
 
   if constexpr (use_float16) {
     test.AddInput<T1>("A", {M, K}, ToFloat16(input0_vals), false);
@@ -244,9 +270,9 @@ void RunTest(const TestOptions& opts,
   }
 
   if constexpr (use_float16) {
-    test.AddOutput<T1>("Y", {M, N}, ToFloat16(expected_vals));
+    test.AddOutput<T1>("Y", {M, output_N}, ToFloat16(expected_vals));
   } else {
-    test.AddOutput<T1>("Y", {M, N}, expected_vals);
+    test.AddOutput<T1>("Y", {M, output_N}, expected_vals);
   }
 
   if (opts.output_abs_error.has_value()) {
@@ -319,6 +345,120 @@ TEST(MatMulNBits, Float32) {
   }
 }
 
+namespace {
+
+// Packs `values` of `bits` bits each as a little endian bit stream of `size_in_bytes` bytes.
+std::vector<uint8_t> PackBits(gsl::span<const int32_t> values, int64_t bits, size_t size_in_bytes) {
+  std::vector<uint8_t> packed(size_in_bytes, 0);
+  for (size_t i = 0; i < values.size(); i++) {
+    for (int64_t b = 0; b < bits; b++) {
+      if ((values[i] >> b) & 1) {
+        const size_t bit = i * narrow<size_t>(bits) + narrow<size_t>(b);
+        packed[bit / 8] |= static_cast<uint8_t>(1 << (bit % 8));
+      }
+    }
+  }
+  return packed;
+}
+
+void RunLowBitTest(int64_t bits, int64_t M, int64_t N, int64_t K, int64_t block_size, bool has_zero_point,
+                   bool is_b_constant, int64_t accuracy_level = 0, float abs_error = 1e-3f) {
+  SCOPED_TRACE(MakeString("bits:", bits, ", M:", M, ", N:", N, ", K:", K, ", block_size:", block_size,
+                          ", has_zero_point:", has_zero_point, ", is_b_constant:", is_b_constant,
+                          ", accuracy_level:", accuracy_level));
+
+  const int64_t blocks_per_col = (K + block_size - 1) / block_size;
+  const int64_t blob_size = block_size * bits / 8;
+
+  RandomValueGenerator random{1234};
+  const std::vector<float> a(random.Gaussian<float>(AsSpan({M, K}), 0.0f, 0.25f));
+  // keep the dequantized values in the same range for all bit widths
+  const float scale_max = 0.1f / static_cast<float>(int64_t{1} << (bits - 2));
+  const std::vector<float> scales(
+      random.Uniform<float>(AsSpan({N * blocks_per_col}), scale_max / 10.0f, scale_max));
+  const int32_t value_end = 1 << bits;
+  const std::vector<int32_t> quant_values(
+      random.Uniform<int32_t>(AsSpan({N * blocks_per_col * block_size}), 0, value_end));
+  // without zero points the kernel uses the middle of the range
+  const std::vector<int32_t> zero_points(
+      has_zero_point ? random.Uniform<int32_t>(AsSpan({N * blocks_per_col}), 0, value_end)
+                     : std::vector<int32_t>(narrow<size_t>(N * blocks_per_col), value_end / 2));
+
+  // each block and the zero points of each column are packed separately
+  std::vector<uint8_t> b;
+  for (int64_t blk = 0; blk < N * blocks_per_col; blk++) {
+    const auto blob = PackBits(gsl::make_span(quant_values).subspan(narrow<size_t>(blk * block_size),
+                                                                    narrow<size_t>(block_size)),
+                               bits, narrow<size_t>(blob_size));
+    b.insert(b.end(), blob.begin(), blob.end());
+  }
+  const int64_t zero_point_col_size = (blocks_per_col * bits + 7) / 8;
+  std::vector<uint8_t> packed_zero_points;
+  for (int64_t n = 0; n < N; n++) {
+    const auto col = PackBits(gsl::make_span(zero_points).subspan(narrow<size_t>(n * blocks_per_col),
+                                                                  narrow<size_t>(blocks_per_col)),
+                              bits, narrow<size_t>(zero_point_col_size));
+    packed_zero_points.insert(packed_zero_points.end(), col.begin(), col.end());
+  }
+
+  std::vector<float> expected(narrow<size_t>(M * N));
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        const int64_t blk = n * blocks_per_col + k / block_size;
+        const float b_value = (static_cast<float>(quant_values[blk * block_size + k % block_size]) -
+                               static_cast<float>(zero_points[blk])) *
+                              scales[blk];
+        sum += a[m * K + k] * b_value;
+      }
+      expected[m * N + n] = sum;
+    }
+  }
+
+  OpTester test("MatMulNBits", 1, kMSDomain);
+  test.AddAttribute<int64_t>("K", K);
+  test.AddAttribute<int64_t>("N", N);
+  test.AddAttribute<int64_t>("block_size", block_size);
+  test.AddAttribute<int64_t>("bits", bits);
+  test.AddAttribute<int64_t>("accuracy_level", accuracy_level);
+
+  test.AddInput<float>("A", {M, K}, a, false);
+  test.AddInput<uint8_t>("B", {N, blocks_per_col, blob_size}, b, is_b_constant);
+  test.AddInput<float>("scales", {N * blocks_per_col}, scales, true);
+  if (has_zero_point) {
+    test.AddInput<uint8_t>("zero_points", {static_cast<int64_t>(packed_zero_points.size())}, packed_zero_points,
+                           true);
+  }
+
+  test.AddOutput<float>("Y", {M, N}, expected);
+  test.SetOutputAbsErr("Y", abs_error);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> explicit_eps;
+  explicit_eps.emplace_back(DefaultCpuExecutionProvider());
+  test.ConfigEps(std::move(explicit_eps));
+  test.RunWithConfig();
+}
+
+}  // namespace
+
+TEST(MatMulNBits, Float32LowBits) {
+  for (auto bits : {2, 3, 8}) {
+    for (auto M : {1, 5}) {
+      for (auto K : {64, 93, 256}) {
+        for (auto block_size : {16, 32, 128}) {
+          for (bool has_zero_point : {false, true}) {
+            // B is prepacked for MLAS when it is constant, otherwise it is dequantized
+            for (bool is_b_constant : {true, false}) {
+              RunLowBitTest(bits, M, 40, K, block_size, has_zero_point, is_b_constant);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM) || defined(USE_DML)
 
 namespace {
@@ -411,6 +551,31 @@ TEST(MatMulNBits, Float16Large) {
   }
 }
 
+#if defined(USE_CUDA)
+// The fused bias and activation epilogues, on both the GEMV (M == 1) and the dequantize + GEMM paths.
+TEST(MatMulNBits, Float16ActivationCuda) {
+  for (const char* activation : {"silu", "gelu", "swiglu"}) {
+    for (auto M : {1, 33}) {
+      for (auto has_bias : {false, true}) {
+        TestOptions opts{};
+        opts.M = M;
+        opts.N = 64;
+        opts.K = 256;
+        opts.block_size = 32;
+        opts.has_zero_point = true;
+        opts.has_bias = has_bias;
+        opts.activation = activation;
+        opts.output_abs_error = 0.05f;
+
+        std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+        execution_providers.push_back(DefaultCudaExecutionProvider());
+        RunTest<MLFloat16>(opts, std::move(execution_providers));
+      }
+    }
+  }
+}
+#endif  // defined(USE_CUDA)
+
 #endif  // defined(USE_CUDA) || defined(USE_ROCM) || defined(USE_DML)
 
 #if defined(ORT_NEURAL_SPEED)
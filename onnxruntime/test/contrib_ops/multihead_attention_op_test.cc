@@ -588,6 +588,51 @@ TEST(MultiHeadAttentionTest, SelfAttention_WithPastAndPresent_NoMask_NoRelPosBia
   RunMultiHeadAttentionTests(data, /*disable_cpu=*/false, /*disable_cuda=*/true);
 }
 
+// With a zero query the probs are uniform over the attended keys, so each output row is the mean of their values.
+static void RunBlockSparseMultiHeadAttentionTest(int64_t sparse_block_size, int64_t sparse_local_blocks,
+                                                 int64_t sparse_global_blocks, const std::vector<float>& output_data,
+                                                 bool output_present) {
+  constexpr int64_t batch_size = 1, sequence_length = 4, hidden_size = 2;
+  const std::vector<float> key_data = {0.5f, -1.0f, 2.0f, 1.5f, -0.5f, 0.25f, 1.0f, -2.0f};
+  const std::vector<float> value_data = {1.0f, 0.0f, 3.0f, 0.0f, 0.0f, 2.0f, 0.0f, 6.0f};
+
+  OpTester tester("MultiHeadAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", 1);
+  tester.AddAttribute<int64_t>("sparse_block_size", sparse_block_size);
+  tester.AddAttribute<int64_t>("sparse_local_blocks", sparse_local_blocks);
+  tester.AddAttribute<int64_t>("sparse_global_blocks", sparse_global_blocks);
+
+  tester.AddInput<float>("query", {batch_size, sequence_length, hidden_size},
+                         std::vector<float>(sequence_length * hidden_size, 0.0f));
+  tester.AddInput<float>("key", {batch_size, sequence_length, hidden_size}, key_data);
+  tester.AddInput<float>("value", {batch_size, sequence_length, hidden_size}, value_data);
+  tester.AddOutput<float>("output", {batch_size, sequence_length, hidden_size}, output_data, false, 0, 1e-4f);
+
+  // the present key and value are only produced by the kernel that materializes the probs and masks the blocks
+  if (output_present) {
+    tester.AddOutput<float>("present_key", {batch_size, 1, sequence_length, hidden_size}, key_data);
+    tester.AddOutput<float>("present_value", {batch_size, 1, sequence_length, hidden_size}, value_data);
+  }
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(MultiHeadAttentionTest, BlockSparse_LocalBlocks) {
+  // blocks of two tokens only attend to themselves
+  const std::vector<float> output_data = {2.0f, 0.0f, 2.0f, 0.0f, 0.0f, 4.0f, 0.0f, 4.0f};
+  RunBlockSparseMultiHeadAttentionTest(2, 1, 0, output_data, false);
+  RunBlockSparseMultiHeadAttentionTest(2, 1, 0, output_data, true);
+}
+
+TEST(MultiHeadAttentionTest, BlockSparse_GlobalBlocks) {
+  // the first token attends to all the tokens, the others only to the first one
+  const std::vector<float> output_data = {1.0f, 2.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f};
+  RunBlockSparseMultiHeadAttentionTest(1, 0, 1, output_data, false);
+  RunBlockSparseMultiHeadAttentionTest(1, 0, 1, output_data, true);
+}
+
 // This test is disabled since it is not used in Whisper anymore, and it fails in ROCm.
 TEST(MultiHeadAttentionTest, DISABLED_CrossAttention_WithPastPassedInDirectly_NoMask) {
   // Whisper decoder cross attention with past_kv in place of current KV and no present_kv
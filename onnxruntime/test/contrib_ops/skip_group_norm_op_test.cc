@@ -119,44 +119,38 @@ TEST(SkipGroupNormTest, SkipGroupNorm_with_bias) {
   std::array<int, 2> channels_last_values = {-1, 1};
 
   for (const int channels_last : channels_last_values) {
-    if (enable_cuda || enable_rocm) {
-      std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
-      if (enable_cuda && channels_last != 0) {
-        execution_providers.push_back(DefaultCudaExecutionProvider());
-      }
-
-      if (enable_rocm && channels_last != 0) {
-        execution_providers.push_back(DefaultRocmExecutionProvider());
-      }
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    if (enable_cuda && channels_last != 0) {
+      execution_providers.push_back(DefaultCudaExecutionProvider());
+    }
 
-      // Don't run the test if no providers are supported
-      if (execution_providers.empty()) {
-        continue;
-      }
+    if (enable_rocm && channels_last != 0) {
+      execution_providers.push_back(DefaultRocmExecutionProvider());
+    }
 
-      OpTester test("SkipGroupNorm", 1, onnxruntime::kMSDomain);
-      test.AddAttribute<float>("epsilon", 1e-05f);
-      test.AddAttribute<int64_t>("groups", 4);
-      test.AddAttribute<int64_t>("activation", 0);
+    OpTester test("SkipGroupNorm", 1, onnxruntime::kMSDomain);
+    test.AddAttribute<float>("epsilon", 1e-05f);
+    test.AddAttribute<int64_t>("groups", 4);
+    test.AddAttribute<int64_t>("activation", 0);
 
-      // We interpret channels_last==-1 as the attribute not being provided
-      if (channels_last != -1) {
-        test.AddAttribute<int64_t>("channels_last", channels_last);
-      }
+    // We interpret channels_last==-1 as the attribute not being provided
+    if (channels_last != -1) {
+      test.AddAttribute<int64_t>("channels_last", channels_last);
+    }
 
-      test.AddInput<MLFloat16>("X", dims_nhwc, ToFloat16(input_data_nhwc));
-      test.AddInput<float>("gamma", {C}, gamma_data);
-      test.AddInput<float>("beta", {C}, beta_data);
-      test.AddInput<MLFloat16>("skip", dims_nhwc, ToFloat16(skip_data_nhwc));
-      test.AddInput<MLFloat16>("bias", {C}, ToFloat16(bias_data));
+    test.AddInput<MLFloat16>("X", dims_nhwc, ToFloat16(input_data_nhwc));
+    test.AddInput<float>("gamma", {C}, gamma_data);
+    test.AddInput<float>("beta", {C}, beta_data);
+    test.AddInput<MLFloat16>("skip", dims_nhwc, ToFloat16(skip_data_nhwc));
+    test.AddInput<MLFloat16>("bias", {C}, ToFloat16(bias_data));
 
-      constexpr float rel_error = 0.0f;
-      constexpr float abs_error = 0.02f;
-      test.AddOutput<MLFloat16>("Y", dims_nhwc, ToFloat16(norm_data_nhwc), false, rel_error, abs_error);
-      test.AddOutput<MLFloat16>("S", dims_nhwc, ToFloat16(add_out_data_nhwc), false, rel_error, abs_error);
+    constexpr float rel_error = 0.0f;
+    constexpr float abs_error = 0.02f;
+    test.AddOutput<MLFloat16>("Y", dims_nhwc, ToFloat16(norm_data_nhwc), false, rel_error, abs_error);
+    test.AddOutput<MLFloat16>("S", dims_nhwc, ToFloat16(add_out_data_nhwc), false, rel_error, abs_error);
 
-      test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
-    }
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
   }
 }
 
@@ -243,51 +237,45 @@ TEST(SkipGroupNormTest, SkipGroupNorm_no_bias_broadcast_skip) {
   constexpr int channels_last = 1;
   for (const int skip_dim : skip_dims) {
     for (const bool has_add_out : has_add_out_values) {
-      if (enable_cuda || enable_rocm) {
-        std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
-        if (enable_cuda && channels_last != 0) {
-          execution_providers.push_back(DefaultCudaExecutionProvider());
-        }
-
-        if (enable_rocm && channels_last != 0) {
-          execution_providers.push_back(DefaultRocmExecutionProvider());
-        }
-
-        // Don't run the test if no providers are supported
-        if (execution_providers.empty()) {
-          continue;
-        }
-
-        OpTester test("SkipGroupNorm", 1, onnxruntime::kMSDomain);
-        test.AddAttribute<float>("epsilon", 1e-05f);
-        test.AddAttribute<int64_t>("groups", 8);
-        test.AddAttribute<int64_t>("activation", 0);
-
-        // We interpret channels_last==-1 as the attribute not being provided
-        if (channels_last != -1) {
-          test.AddAttribute<int64_t>("channels_last", channels_last);
-        }
-
-        test.AddInput<MLFloat16>("X", dims_nhwc, ToFloat16(input_data_nhwc));
-        test.AddInput<float>("gamma", {C}, gamma_data);
-        test.AddInput<float>("beta", {C}, beta_data);
-        if (skip_dim == 2) {
-          test.AddInput<MLFloat16>("skip", {B, C}, ToFloat16(skip_data));
-        } else {
-          test.AddInput<MLFloat16>("skip", {B, 1, 1, C}, ToFloat16(skip_data));
-        }
-        // no bias
-
-        constexpr float rel_error = 0.0f;
-        constexpr float abs_error = 0.02f;
-        test.AddOutput<MLFloat16>("Y", dims_nhwc, ToFloat16(norm_data_nhwc), false, rel_error, abs_error);
-
-        if (has_add_out) {
-          test.AddOutput<MLFloat16>("S", dims_nhwc, ToFloat16(add_out_data_nhwc), false, rel_error, abs_error);
-        }
-
-        test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+      std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+      execution_providers.push_back(DefaultCpuExecutionProvider());
+      if (enable_cuda && channels_last != 0) {
+        execution_providers.push_back(DefaultCudaExecutionProvider());
+      }
+
+      if (enable_rocm && channels_last != 0) {
+        execution_providers.push_back(DefaultRocmExecutionProvider());
+      }
+
+      OpTester test("SkipGroupNorm", 1, onnxruntime::kMSDomain);
+      test.AddAttribute<float>("epsilon", 1e-05f);
+      test.AddAttribute<int64_t>("groups", 8);
+      test.AddAttribute<int64_t>("activation", 0);
+
+      // We interpret channels_last==-1 as the attribute not being provided
+      if (channels_last != -1) {
+        test.AddAttribute<int64_t>("channels_last", channels_last);
+      }
+
+      test.AddInput<MLFloat16>("X", dims_nhwc, ToFloat16(input_data_nhwc));
+      test.AddInput<float>("gamma", {C}, gamma_data);
+      test.AddInput<float>("beta", {C}, beta_data);
+      if (skip_dim == 2) {
+        test.AddInput<MLFloat16>("skip", {B, C}, ToFloat16(skip_data));
+      } else {
+        test.AddInput<MLFloat16>("skip", {B, 1, 1, C}, ToFloat16(skip_data));
+      }
+      // no bias
+
+      constexpr float rel_error = 0.0f;
+      constexpr float abs_error = 0.02f;
+      test.AddOutput<MLFloat16>("Y", dims_nhwc, ToFloat16(norm_data_nhwc), false, rel_error, abs_error);
+
+      if (has_add_out) {
+        test.AddOutput<MLFloat16>("S", dims_nhwc, ToFloat16(add_out_data_nhwc), false, rel_error, abs_error);
       }
+
+      test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
     }
   }
 }
@@ -296,6 +296,85 @@ TEST(FlatbufferUtilsTest, ExternalWriteReadWithLoadInitializers) {
   }
 }
 
+TEST(FlatbufferUtilsTest, CompressedWriteRead) {
+  auto initializers = CreateInitializers();
+
+  for (const auto compression : {fbs::TensorDataCompression::LZ4, fbs::TensorDataCompression::BYTE_SHUFFLE_LZ4}) {
+    flatbuffers::FlatBufferBuilder builder(1024);
+
+    std::vector<flatbuffers::Offset<fbs::Tensor>> fbs_tensors;
+    for (const auto& initializer : initializers) {
+      flatbuffers::Offset<fbs::Tensor> fbs_tensor;
+      ASSERT_STATUS_OK(SaveInitializerOrtFormat(builder, initializer, std::filesystem::path(), fbs_tensor,
+                                                nullptr, compression));
+      fbs_tensors.push_back(fbs_tensor);
+    }
+
+    auto fbs_tensors_offset = builder.CreateVector(fbs_tensors);
+    fbs::test::TestDataBuilder tdb(builder);
+    tdb.add_initializers(fbs_tensors_offset);
+    builder.Finish(tdb.Finish());
+    auto fb_data = builder.GetBufferSpan();
+
+    const auto* fbs_tensors2 = fbs::test::GetTestData(fb_data.data())->initializers();
+    ASSERT_EQ(initializers.size(), fbs_tensors2->size());
+
+    OrtFormatLoadOptions options;
+    for (int i = 0; i < narrow<int>(initializers.size()); i++) {
+      const auto& expected_initializer = initializers[i];
+      const auto& fbs_tensor = *fbs_tensors2->Get(i);
+      const auto& name = expected_initializer.name();
+
+      // the 64-bit data has 7 zero bytes per element so always compresses. data below the threshold never does.
+      if (name == "tensor_64") {
+        ASSERT_EQ(fbs_tensor.compression(), compression);
+        ASSERT_LT(fbs_tensor.raw_data()->size(), size_t{36 * sizeof(int64_t)});
+      } else if (name == "tensor_string" || name == "tensor_32_small") {
+        ASSERT_EQ(fbs_tensor.compression(), fbs::TensorDataCompression::NONE);
+      }
+
+      ONNX_NAMESPACE::TensorProto loaded_initializer;
+      ASSERT_STATUS_OK(LoadInitializerOrtFormat(fbs_tensor, loaded_initializer, options));
+      ASSERT_EQ(name, loaded_initializer.name());
+      ASSERT_EQ(expected_initializer.data_type(), loaded_initializer.data_type());
+      ASSERT_EQ_TENSORPROTO_VECTORFIELD(expected_initializer, loaded_initializer, dims());
+
+      if (loaded_initializer.data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+        // compressed data is decompressed into the TensorProto instead of being used in place
+        if (fbs_tensor.compression() != fbs::TensorDataCompression::NONE) {
+          ASSERT_FALSE(onnxruntime::utils::HasExternalData(loaded_initializer)) << name;
+        }
+
+        std::vector<uint8_t> expected_data, loaded_data;
+        ASSERT_STATUS_OK(onnxruntime::utils::UnpackInitializerData(expected_initializer, expected_data));
+        ASSERT_STATUS_OK(onnxruntime::utils::UnpackInitializerData(loaded_initializer, loaded_data));
+        ASSERT_EQ(expected_data, loaded_data) << name;
+      } else {
+        ASSERT_EQ_TENSORPROTO_VECTORFIELD(expected_initializer, loaded_initializer, string_data());
+      }
+    }
+  }
+}
+
+TEST(FlatbufferUtilsTest, InvalidCompressedDataIsRejected) {
+  flatbuffers::FlatBufferBuilder builder(1024);
+
+  // a literal run longer than the remaining input
+  const std::vector<int64_t> dims{64};
+  const std::vector<uint8_t> raw_data{0xF0, 0xFF, 0x01, 0x02};
+  auto fbs_tensor = fbs::CreateTensorDirect(builder, "tensor", nullptr, &dims, fbs::TensorDataType::FLOAT,
+                                            &raw_data, nullptr, -1, fbs::TensorDataCompression::LZ4);
+
+  fbs::test::TestDataBuilder tdb(builder);
+  tdb.add_initializers(builder.CreateVector(std::vector<flatbuffers::Offset<fbs::Tensor>>{fbs_tensor}));
+  builder.Finish(tdb.Finish());
+  auto fb_data = builder.GetBufferSpan();
+
+  const auto* fbs_tensors = fbs::test::GetTestData(fb_data.data())->initializers();
+  ONNX_NAMESPACE::TensorProto initializer;
+  ASSERT_FALSE(LoadInitializerOrtFormat(*fbs_tensors->Get(0), initializer, OrtFormatLoadOptions{}).IsOK());
+}
+
 #ifdef ENABLE_TRAINING_APIS
 // tests method that loads to OrtTensor (used when loading a checkpoint into a checkpoint state)
 TEST(FlatbufferUtilsTest, ExternalWriteReadWithLoadOrtTensor) {
@@ -148,6 +148,7 @@ class PlannerTest : public ::testing::Test {
   std::unique_ptr<::onnxruntime::KernelDef> std_kernel_;               // a unary kernel with no-aliasing and no-in-place
   std::unique_ptr<::onnxruntime::KernelDef> in_place_kernel_;          // a unary kernel with in-place
   std::unique_ptr<::onnxruntime::KernelDef> external_outputs_kernel_;  // an unary kernel with external outputs
+  std::unique_ptr<::onnxruntime::KernelDef> output_view_kernel_;       // an unary kernel with a view output
 #ifdef ENABLE_STRIDED_TENSORS
   std::unique_ptr<::onnxruntime::KernelDef> may_strided_input_kernel_;   // an uinary kernel with may_strided_input
   std::unique_ptr<::onnxruntime::KernelDef> may_strided_output_kernel_;  // an unary kernel with may_strided_output
@@ -177,6 +178,8 @@ class PlannerTest : public ::testing::Test {
         KernelDefBuilder().SetName("Relu").Provider(kCpuExecutionProvider).SinceVersion(1, 10).MayInplace(0, 0).Build();
     external_outputs_kernel_ =
         KernelDefBuilder().SetName("Tanh").Provider(kCpuExecutionProvider).SinceVersion(1, 10).ExternalOutputs().Build();
+    output_view_kernel_ =
+        KernelDefBuilder().SetName("Neg").Provider(kCpuExecutionProvider).SinceVersion(1, 10).MayOutputView(0).Build();
 #ifdef ENABLE_STRIDED_TENSORS
     may_strided_input_kernel_ = KernelDefBuilder()
                                     .SetName("Abs")
@@ -238,6 +241,10 @@ class PlannerTest : public ::testing::Test {
     return AddNode(*external_outputs_kernel_, input, output);
   }
 
+  onnxruntime::Node* AddOutputViewNode(std::string& input, std::string& output) {
+    return AddNode(*output_view_kernel_, input, output);
+  }
+
 #ifdef ENABLE_STRIDED_TENSORS
   onnxruntime::Node* AddMayStridedInputNode(std::string& input, std::string& output) {
     return AddNode(*may_strided_input_kernel_, input, output);
@@ -356,6 +363,12 @@ class PlannerTest : public ::testing::Test {
     EXPECT_EQ(plan_->allocation_plan[id].alloc_kind, kind) << "Error in allocation kind for " << name;
   }
 
+  void CheckIsView(const std::string& name, bool is_view) {
+    int id;
+    index(name, id);
+    EXPECT_EQ(plan_->allocation_plan[id].is_view, is_view) << "Error in view flag for " << name;
+  }
+
   void CheckFreed(int step_number, std::initializer_list<std::string> freed_items) {
     // TODO: add the checker for new implementation of release plan
     //// create set and check equality
@@ -575,6 +588,40 @@ TEST_F(PlannerTest, ExternalOutputsNoReuseTest) {
   CheckFreed(3, {X4});
 }
 
+TEST_F(PlannerTest, OutputViewTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+
+  // graph structure:
+  AddNormalNode(X1, X2);      // normal operator; X2: temporary
+  AddOutputViewNode(X2, X3);  // X3 is a view of X2
+  AddInplaceNode(X3, X4);     // may-in-place operator, but X3 is a view so X4 gets its own buffer
+  AddNormalNode(X4, X5);      // normal operator; X5: output
+
+  // simulate shape-inference results:
+  Shape shape1{"M", "N"};
+  auto shape = &shape1.value;
+  SetShape({{X1, shape}, {X2, shape}, {X3, shape}, {X4, shape}, {X5, shape}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X1, AllocKind::kPreExisting);
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kReuse);
+  CheckAllocKind(X4, AllocKind::kAllocate);
+  CheckAllocKind(X5, AllocKind::kAllocateOutput);
+  CheckIsView(X3, true);
+  CheckIsView(X4, false);
+
+  // check each ml-value is freed at appropriate step
+  // X2 is kept alive for as long as its view X3 is used, X3 is released in case it holds a buffer of its own.
+  CheckFreed(0, {});
+  CheckFreed(1, {});
+  CheckFreed(2, {X2, X3});
+  CheckFreed(3, {X4});
+}
+
 #ifdef ENABLE_STRIDED_TENSORS
 TEST_F(PlannerTest, MayStridedTest1) {
   // tensor variables:
@@ -1367,6 +1414,32 @@ TEST_F(PlannerTest, MultiStreamCudaEPNodeCPUOutput) {
   EXPECT_NE(strstr(typeid(*GetState().GetExecutionPlan()->execution_plan[1]->steps_[2]).name(), "LaunchKernelStep"), nullptr) << "2nd step: LaunchKernelStep for node 2";
 }
 
+// Test execution plan for the same graph as MultiStreamCudaEPNodeCPUOutput with a dedicated copy stream:
+// node1 (MemcpyToHost, CUDA EP) is in the copy stream of CUDA,
+// node2 (CPU EP) and node3 (Transpose, CUDA EP) are in the CPU and the CUDA compute streams.
+TEST_F(PlannerTest, MultiStreamDedicatedCopyStream) {
+  ORT_THROW_IF_ERROR(sess_options_->config_options.AddConfigEntry(kOrtSessionOptionsConfigUseDedicatedCopyStream, "1"));
+  MemcpyToHostInCuda_TransposeInCudaAndCpu();
+  const auto* plan = GetState().GetExecutionPlan();
+  EXPECT_EQ(plan->execution_plan.size(), 3) << "3 logic streams";
+
+  InlinedHashMap<std::string, size_t> stream_of_node;
+  for (const auto& node : GetGraph().Nodes()) {
+    stream_of_node[node.Name()] = plan->node_stream_map_[node.Index()];
+  }
+  EXPECT_NE(stream_of_node["node1"], stream_of_node["node2"]);
+  EXPECT_NE(stream_of_node["node1"], stream_of_node["node3"]);
+  EXPECT_NE(stream_of_node["node2"], stream_of_node["node3"]);
+  EXPECT_EQ(plan->execution_plan[stream_of_node["node1"]]->device_.Type(),
+            plan->execution_plan[stream_of_node["node3"]]->device_.Type())
+      << "copy stream and compute stream are on the same device";
+
+  const auto& copy_steps = plan->execution_plan[stream_of_node["node1"]]->steps_;
+  ASSERT_GE(copy_steps.size(), 2u);
+  EXPECT_NE(strstr(typeid(*copy_steps[0]).name(), "LaunchKernelStep"), nullptr) << "0th step: LaunchKernelStep for node 1";
+  EXPECT_NE(strstr(typeid(*copy_steps[1]).name(), "ActivateNotificationStep"), nullptr) << "1st step: ActivateNofiticationStep by node 1";
+}
+
 // Test execution plan for the graph:
 // node1 has 2 outputs which are both consumed by node2, node1 and node2 are in different streams
 // Only 1 WaitOnEPStep is expected before launching node2
@@ -1908,6 +1981,152 @@ TEST_F(PlannerTest, TestMultiStreamConfig) {
               graph_partitioner_cpu_gpu->Streams() == 2);
 }
 
+// Two branches of different length join at the end. The critical path partitioner keeps the long branch on one
+// CPU stream and moves the short branch to a second one.
+TEST_F(PlannerTest, TestCriticalPathPartition) {
+  onnxruntime::Model model("critical_path", false, ModelMetaData(), PathString(),
+                           IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 17}}, {},
+                           DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(8);
+
+  auto& x = graph.GetOrCreateNodeArg("x", &tensor_type);
+  auto& relu_0_out = graph.GetOrCreateNodeArg("relu_0_out", &tensor_type);
+  auto& relu_1_out = graph.GetOrCreateNodeArg("relu_1_out", &tensor_type);
+  auto& relu_2_out = graph.GetOrCreateNodeArg("relu_2_out", &tensor_type);
+  auto& sigmoid_out = graph.GetOrCreateNodeArg("sigmoid_out", &tensor_type);
+  auto& y = graph.GetOrCreateNodeArg("y", &tensor_type);
+
+  graph.AddNode("relu_0", "Relu", "", {&x}, {&relu_0_out});
+  graph.AddNode("relu_1", "Relu", "", {&relu_0_out}, {&relu_1_out});
+  graph.AddNode("relu_2", "Relu", "", {&relu_1_out}, {&relu_2_out});
+  graph.AddNode("sigmoid", "Sigmoid", "", {&x}, {&sigmoid_out});
+  graph.AddNode("add", "Add", "", {&relu_2_out, &sigmoid_out}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  SessionOptions so;
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.inter_op_param.thread_pool_size = 2;
+  so.graph_optimization_level = TransformerLevel::Default;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigCriticalPathPartition, "1"));
+  InferenceSession sess{so, GetEnvironment()};
+  ASSERT_STATUS_OK(sess.RegisterExecutionProvider(DefaultCpuExecutionProvider()));
+
+  std::string model_data;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+  std::stringstream model_stream(model_data);
+  ASSERT_STATUS_OK(sess.Load(model_stream));
+  ASSERT_STATUS_OK(sess.Initialize());
+
+  const auto& session_state = sess.GetSessionState();
+  const auto* plan = const_cast<SessionState&>(session_state).GetExecutionPlan();
+  ASSERT_EQ(plan->execution_plan.size(), 2u);
+
+  InlinedHashMap<std::string, size_t> node_streams;
+  for (const auto& node : session_state.GetGraphViewer().Nodes()) {
+    node_streams[node.Name()] = plan->node_stream_map_[node.Index()];
+  }
+  EXPECT_EQ(node_streams["relu_0"], node_streams["relu_1"]);
+  EXPECT_EQ(node_streams["relu_1"], node_streams["relu_2"]);
+  EXPECT_EQ(node_streams["relu_2"], node_streams["add"]);
+  EXPECT_NE(node_streams["relu_0"], node_streams["sigmoid"]);
+
+  // the partitioned graph computes relu(x) + sigmoid(x)
+  std::vector<float> x_data(16);
+  for (size_t i = 0; i < x_data.size(); ++i) {
+    x_data[i] = static_cast<float>(i) - 8.0f;
+  }
+  OrtValue x_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {2, 8}, x_data, &x_value);
+  NameMLValMap feeds{{"x", x_value}};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(sess.Run(feeds, {"y"}, &fetches));
+
+  const auto y_data = fetches[0].Get<Tensor>().DataAsSpan<float>();
+  for (size_t i = 0; i < x_data.size(); ++i) {
+    const float expected = std::max(x_data[i], 0.0f) + 1.0f / (1.0f + std::exp(-x_data[i]));
+    EXPECT_NEAR(y_data[i], expected, 1e-5f);
+  }
+}
+
+TEST_F(PlannerTest, TestSplitOutputView) {
+  onnxruntime::Model model("split_view", false, ModelMetaData(), PathString(),
+                           IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 17}}, {},
+                           DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  auto make_type = [](int64_t dim0) {
+    TypeProto tensor_type;
+    tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim0);
+    tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(8);
+    return tensor_type;
+  };
+  TypeProto full_type = make_type(4);
+  TypeProto half_type = make_type(2);
+
+  auto& x = graph.GetOrCreateNodeArg("x", &full_type);
+  auto& relu_out = graph.GetOrCreateNodeArg("relu_out", &full_type);
+  auto& split_0 = graph.GetOrCreateNodeArg("split_0", &half_type);
+  auto& split_1 = graph.GetOrCreateNodeArg("split_1", &half_type);
+  auto& y = graph.GetOrCreateNodeArg("y", &half_type);
+
+  graph.AddNode("relu", "Relu", "", {&x}, {&relu_out});
+  graph.AddNode("split", "Split", "", {&relu_out}, {&split_0, &split_1});
+  graph.AddNode("add", "Add", "", {&split_0, &split_1}, {&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  SessionOptions so;
+  so.graph_optimization_level = TransformerLevel::Default;
+  InferenceSession sess{so, GetEnvironment()};
+  ASSERT_STATUS_OK(sess.RegisterExecutionProvider(DefaultCpuExecutionProvider()));
+
+  std::string model_data;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+  std::stringstream model_stream(model_data);
+  ASSERT_STATUS_OK(sess.Load(model_stream));
+  ASSERT_STATUS_OK(sess.Initialize());
+
+  // both halves of a split along the outermost axis are views of the Relu output
+  const auto& session_state = sess.GetSessionState();
+  const auto* plan = const_cast<SessionState&>(session_state).GetExecutionPlan();
+  const auto& name_idx_map = session_state.GetOrtValueNameIdxMap();
+  int relu_out_idx, split_0_idx, split_1_idx;
+  ASSERT_STATUS_OK(name_idx_map.GetIdx("relu_out", relu_out_idx));
+  ASSERT_STATUS_OK(name_idx_map.GetIdx("split_0", split_0_idx));
+  ASSERT_STATUS_OK(name_idx_map.GetIdx("split_1", split_1_idx));
+  for (int idx : {split_0_idx, split_1_idx}) {
+    EXPECT_EQ(plan->allocation_plan[idx].alloc_kind, AllocKind::kReuse);
+    EXPECT_EQ(plan->allocation_plan[idx].reused_buffer, relu_out_idx);
+    EXPECT_TRUE(plan->allocation_plan[idx].is_view);
+  }
+
+  std::vector<float> x_data(32);
+  for (size_t i = 0; i < x_data.size(); ++i) {
+    x_data[i] = static_cast<float>(i) - 16.0f;
+  }
+  OrtValue x_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {4, 8}, x_data, &x_value);
+  NameMLValMap feeds{{"x", x_value}};
+
+  // the second run uses the memory pattern generated by the first one
+  for (int run = 0; run < 2; ++run) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(sess.Run(feeds, {"y"}, &fetches));
+
+    const auto y_data = fetches[0].Get<Tensor>().DataAsSpan<float>();
+    ASSERT_EQ(y_data.size(), 16u);
+    for (size_t i = 0; i < y_data.size(); ++i) {
+      const float expected = std::max(x_data[i], 0.0f) + std::max(x_data[i + 16], 0.0f);
+      EXPECT_EQ(y_data[i], expected);
+    }
+  }
+}
+
 // Save partition config to a file and check its completeness
 TEST_F(PlannerTest, TestMultiStreamSaveConfig) {
   const char* config_file_path = "./testdata/multi_stream_models/conv_add_relu_single_stream.json";
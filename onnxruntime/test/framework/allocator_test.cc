@@ -3,6 +3,9 @@
 #include <absl/base/config.h>
 
 #include "core/framework/allocator.h"
+#include "core/framework/large_page_allocator.h"
+#include "core/framework/memory_pattern_slab_pool.h"
+#include "core/platform/env.h"
 
 #include "test_utils.h"
 #include "gtest/gtest.h"
@@ -32,6 +35,24 @@ TEST(AllocatorTest, CPUAllocatorTest) {
   cpu_arena->Free(bytes);
   // todo: test the used / max api.
 }
+// Large pages are used when the platform provides them, and the allocations fall back to regular pages otherwise.
+TEST(AllocatorTest, LargePageCPUAllocatorTest) {
+  LargePageCPUAllocator allocator;
+  const size_t large_page_size = Env::Default().GetLargePageSize();
+
+  for (size_t size : {size_t{1024}, large_page_size * 2 + 1, size_t{4} << 20}) {
+    if (size == 1) {
+      continue;  // no large pages
+    }
+    auto* bytes = static_cast<uint8_t*>(allocator.Alloc(size));
+    ASSERT_NE(bytes, nullptr);
+    memset(bytes, 0x5a, size);
+    EXPECT_EQ(bytes[0], 0x5a);
+    EXPECT_EQ(bytes[size - 1], 0x5a);
+    allocator.Free(bytes);
+  }
+}
+
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(disable : 26400)
 #endif
@@ -110,5 +131,43 @@ TEST(AllocatorTest, TestOverflowChecks) {
   EXPECT_TRUE(IAllocator::CalcMemSizeForArrayWithAlignment<kAllocAlignment>(num_elements, element_size - (kAllocAlignment / num_elements), &size));
   EXPECT_FALSE(IAllocator::CalcMemSizeForArrayWithAlignment<kAllocAlignment>(num_elements, element_size, &size));
 }
+
+TEST(AllocatorTest, MemoryPatternSlabPoolTest) {
+  auto pool = std::make_shared<MemoryPatternSlabPool>(std::make_shared<CPUAllocator>(), /*max_idle_slabs*/ 1);
+  EXPECT_EQ(pool->Info().alloc_type, OrtDeviceAllocator);
+
+  // a returned slab is reused for any request it is large enough for
+  void* slab_1k = pool->Alloc(1024);
+  ASSERT_NE(slab_1k, nullptr);
+  pool->Free(slab_1k);
+  EXPECT_EQ(pool->NumIdleSlabs(), 1u);
+  EXPECT_EQ(pool->Alloc(800), slab_1k);
+  EXPECT_EQ(pool->NumIdleSlabs(), 0u);
+
+  // a larger request while the slab is in use gets a new one
+  void* slab_2k = pool->Alloc(2048);
+  ASSERT_NE(slab_2k, nullptr);
+  EXPECT_NE(slab_2k, slab_1k);
+
+  // only the largest slab is kept idle
+  pool->Free(slab_1k);
+  pool->Free(slab_2k);
+  EXPECT_EQ(pool->NumIdleSlabs(), 1u);
+  EXPECT_EQ(pool->Alloc(1500), slab_2k);
+
+  AllocatorStats stats;
+  pool->GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 2);
+  EXPECT_EQ(stats.bytes_in_use, 2048);
+  EXPECT_EQ(stats.total_allocated_bytes, 2048);
+  EXPECT_EQ(stats.max_bytes_in_use, 1024 + 2048);
+
+  // releasing the buffer returns the slab to the pool and keeps the pool alive until then
+  auto buffer = BufferUniquePtr(pool->Alloc(100), BufferDeleter(pool));
+  EXPECT_NE(buffer.get(), nullptr);
+  pool->Free(slab_2k);
+  buffer.reset();
+  EXPECT_EQ(pool->NumIdleSlabs(), 1u);
+}
 }  // namespace test
 }  // namespace onnxruntime
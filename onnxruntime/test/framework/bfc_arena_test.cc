@@ -7,6 +7,7 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include <cstdlib>
+#include <thread>
 #include "core/framework/stream_handles.h"
 
 namespace onnxruntime {
@@ -307,6 +308,68 @@ TEST(BFCArenaTest, TestShrink) {
   EXPECT_EQ(stats.total_allocated_bytes, 10 * 1024 * 1024) << "Expect 10M bytes but actually " << stats.total_allocated_bytes << " bytes";
 }
 
+TEST(BFCArenaTest, TestThreadCache) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES, 4096);
+  AllocatorStats stats;
+
+  // a freed small chunk is handed out again from the thread cache
+  void* p1 = a.Alloc(1000);
+  a.Free(p1);
+  void* p2 = a.Alloc(1000);
+  EXPECT_EQ(p1, p2);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_hits, 1);
+  EXPECT_EQ(stats.num_thread_cache_misses, 1);
+  EXPECT_EQ(stats.num_allocs, 2);
+  EXPECT_DOUBLE_EQ(stats.ThreadCacheHitRate(), 0.5);
+
+  // allocations larger than the limit go to the bins
+  void* large = a.Alloc(8192);
+  a.Free(large);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_hits + stats.num_thread_cache_misses, 2);
+
+  // a chunk freed by another thread goes back to the bins
+  std::thread([&]() { a.Free(p2); }).join();
+  void* p3 = a.Alloc(1000);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_hits, 1);
+  a.Free(p3);
+
+  // chunks held by the thread caches are returned to the bins on Shrink
+  a.GetStats(&stats);
+  EXPECT_GT(stats.bytes_in_use, 0);
+  EXPECT_EQ(a.Shrink(), Status::OK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+}
+
+TEST(BFCArenaTest, TestThreadCacheFlushedOnThreadExit) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES, 4096);
+  void* in_use = nullptr;
+  std::thread([&]() {
+    for (int i = 0; i < 10; ++i) {
+      a.Free(a.Alloc(512));
+    }
+    in_use = a.Alloc(512);
+  }).join();
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_hits, 10);
+  // only the chunk still in use is left once the cache of the thread was flushed
+  EXPECT_EQ(stats.bytes_in_use, 512);
+
+  a.Free(in_use);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
 class BadAllocator : public IAllocator {
  public:
   BadAllocator() : IAllocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator)) {}
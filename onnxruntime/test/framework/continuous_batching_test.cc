@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/continuous_batching.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(KVCacheBlockAllocatorTest, AllocateAndFree) {
+  KVCacheBlockAllocator allocator(4);
+  ASSERT_EQ(allocator.NumFreeBlocks(), 4u);
+
+  std::vector<int32_t> first;
+  ASSERT_TRUE(allocator.Allocate(3, first));
+  EXPECT_EQ(first, (std::vector<int32_t>{0, 1, 2}));
+  EXPECT_EQ(allocator.NumFreeBlocks(), 1u);
+
+  // not enough blocks leaves the sequence untouched
+  std::vector<int32_t> second{3};
+  ASSERT_FALSE(allocator.Allocate(2, second));
+  EXPECT_EQ(second, (std::vector<int32_t>{3}));
+  EXPECT_EQ(allocator.NumFreeBlocks(), 1u);
+
+  allocator.Free(first);
+  EXPECT_TRUE(first.empty());
+  EXPECT_EQ(allocator.NumFreeBlocks(), 4u);
+
+  // freed blocks are handed out again in the order the sequence held them
+  std::vector<int32_t> third;
+  ASSERT_TRUE(allocator.Allocate(4, third));
+  EXPECT_EQ(third, (std::vector<int32_t>{0, 1, 2, 3}));
+  EXPECT_EQ(allocator.NumFreeBlocks(), 0u);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,156 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/cpu_graph.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "core/framework/run_options.h"
+#include "core/framework/tensor.h"
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "gtest/gtest.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Y = Add(Neg(Relu(X)), X), i.e. min(X, 0)
+std::string CreateModel(bool static_shape) {
+  Model model("cpu_graph", false, ModelMetaData(), ORT_TSTR(""), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 13}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto* shape = type.mutable_tensor_type()->mutable_shape();
+  if (static_shape) {
+    shape->add_dim()->set_dim_value(2);
+  } else {
+    shape->add_dim()->set_dim_param("batch");
+  }
+  shape->add_dim()->set_dim_value(3);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &type);
+  auto& relu_out = graph.GetOrCreateNodeArg("relu_out", &type);
+  auto& neg_out = graph.GetOrCreateNodeArg("neg_out", &type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &type);
+  graph.AddNode("relu", "Relu", "", {&x}, {&relu_out});
+  graph.AddNode("neg", "Neg", "", {&relu_out}, {&neg_out});
+  graph.AddNode("add", "Add", "", {&neg_out, &x}, {&y});
+  ORT_THROW_IF_ERROR(graph.Resolve());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+  return model_data;
+}
+
+void InitializeSession(InferenceSession& session, const std::string& model_data) {
+  std::stringstream stream(model_data);
+  ASSERT_STATUS_OK(session.Load(stream));
+  ASSERT_STATUS_OK(session.Initialize());
+}
+
+OrtValue CreateFloatTensor(const std::vector<float>& data) {
+  OrtValue value;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), TensorShape({2, 3}), std::make_shared<CPUAllocator>(), value);
+  std::copy(data.begin(), data.end(), value.GetMutable<Tensor>()->MutableData<float>());
+  return value;
+}
+
+std::vector<float> TensorData(const OrtValue& value) {
+  auto span = value.Get<Tensor>().DataAsSpan<float>();
+  return std::vector<float>(span.begin(), span.end());
+}
+
+}  // namespace
+
+TEST(CpuGraphTest, SessionReplaysWithNewFeeds) {
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigEnableCpuGraphCapture, "1"));
+  InferenceSession session{so, GetEnvironment()};
+  InitializeSession(session, CreateModel(true));
+
+  std::vector<OrtValue> first_fetches;
+  for (int run = 0; run < 3; ++run) {
+    const float sign = run % 2 == 0 ? 1.f : -1.f;
+    const std::vector<float> x{sign * 1.f, -2.f, 3.f, sign * -4.f, 5.f, static_cast<float>(run)};
+    std::vector<float> expected(x.size());
+    std::transform(x.begin(), x.end(), expected.begin(), [](float v) { return std::min(v, 0.f); });
+
+    NameMLValMap feeds{{"X", CreateFloatTensor(x)}};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session.Run(feeds, {"Y"}, &fetches));
+    ASSERT_EQ(TensorData(fetches[0]), expected);
+
+    if (run == 0) {
+      first_fetches = fetches;
+    }
+  }
+
+  // the outputs of a replay are not written to the outputs of a previous Run
+  ASSERT_EQ(TensorData(first_fetches[0]), (std::vector<float>{0.f, -2.f, 0.f, -4.f, 0.f, 0.f}));
+}
+
+TEST(CpuGraphTest, CaptureAndReplay) {
+  InferenceSession session{SessionOptions{}, GetEnvironment()};
+  InitializeSession(session, CreateModel(true));
+  ASSERT_STATUS_OK(CpuGraph::CheckCapturable(session.GetSessionState()));
+
+  CpuGraph graph(session.GetSessionState());
+  const std::vector<std::string> feed_names{"X"};
+  const std::vector<std::string> output_names{"Y"};
+  const std::vector<std::string> other_output_names{"neg_out"};
+  RunOptions run_options;
+
+  {
+    auto lock = graph.TryLock();
+    ASSERT_TRUE(lock.owns_lock());
+    ASSERT_TRUE(graph.Matches(feed_names, other_output_names));
+
+    std::vector<OrtValue> feeds{CreateFloatTensor({-1.f, 2.f, -3.f, 4.f, -5.f, 6.f})};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(graph.Run(run_options, feed_names, feeds, output_names, fetches));
+    ASSERT_TRUE(graph.IsCaptured());
+    ASSERT_EQ(TensorData(fetches[0]), (std::vector<float>{-1.f, 0.f, -3.f, 0.f, -5.f, 0.f}));
+  }
+
+  ASSERT_TRUE(graph.Matches(feed_names, output_names));
+  ASSERT_FALSE(graph.Matches(feed_names, other_output_names));
+
+  // replay into a pre-allocated output
+  auto lock = graph.TryLock();
+  ASSERT_TRUE(lock.owns_lock());
+  std::vector<OrtValue> feeds{CreateFloatTensor({1.f, -2.f, 3.f, -4.f, 5.f, -6.f})};
+  std::vector<OrtValue> fetches{CreateFloatTensor(std::vector<float>(6, 42.f))};
+  const void* output_buffer = fetches[0].Get<Tensor>().DataRaw();
+  ASSERT_STATUS_OK(graph.Run(run_options, feed_names, feeds, output_names, fetches));
+  ASSERT_EQ(fetches[0].Get<Tensor>().DataRaw(), output_buffer);
+  ASSERT_EQ(TensorData(fetches[0]), (std::vector<float>{0.f, -2.f, 0.f, -4.f, 0.f, -6.f}));
+}
+
+TEST(CpuGraphTest, RejectsDynamicShapes) {
+  InferenceSession session{SessionOptions{}, GetEnvironment()};
+  InitializeSession(session, CreateModel(false));
+  ASSERT_FALSE(CpuGraph::CheckCapturable(session.GetSessionState()).IsOK());
+
+  // the session option falls back to the usual execution
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigEnableCpuGraphCapture, "1"));
+  InferenceSession capture_session{so, GetEnvironment()};
+  InitializeSession(capture_session, CreateModel(false));
+  NameMLValMap feeds{{"X", CreateFloatTensor({1.f, -2.f, 3.f, -4.f, 5.f, -6.f})}};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(capture_session.Run(feeds, {"Y"}, &fetches));
+  ASSERT_EQ(TensorData(fetches[0]), (std::vector<float>{0.f, -2.f, 0.f, -4.f, 0.f, -6.f}));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/dynamic_batcher.h"
+
+#include "core/framework/tensor.h"
+#include "gtest/gtest.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+OrtValue CreateFloatTensor(const AllocatorPtr& allocator, const TensorShape& shape, const std::vector<float>& data) {
+  OrtValue value;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), shape, allocator, value);
+  std::copy(data.begin(), data.end(), value.GetMutable<Tensor>()->MutableData<float>());
+  return value;
+}
+
+std::vector<float> TensorData(const OrtValue& value) {
+  auto span = value.Get<Tensor>().DataAsSpan<float>();
+  return std::vector<float>(span.begin(), span.end());
+}
+
+}  // namespace
+
+TEST(DynamicBatcherTest, ConcatenateAndSliceBatch) {
+  auto allocator = std::make_shared<CPUAllocator>();
+  OrtValue a = CreateFloatTensor(allocator, {1, 2}, {1.f, 2.f});
+  OrtValue b = CreateFloatTensor(allocator, {2, 2}, {3.f, 4.f, 5.f, 6.f});
+
+  std::vector<const OrtValue*> values{&a, &b};
+  OrtValue batch;
+  ASSERT_STATUS_OK(dynamic_batching::ConcatenateBatch(values, allocator, batch));
+  EXPECT_EQ(batch.Get<Tensor>().Shape(), TensorShape({3, 2}));
+  EXPECT_EQ(TensorData(batch), (std::vector<float>{1.f, 2.f, 3.f, 4.f, 5.f, 6.f}));
+
+  OrtValue slice;
+  ASSERT_STATUS_OK(dynamic_batching::SliceBatch(batch, 1, 2, allocator, slice));
+  EXPECT_EQ(slice.Get<Tensor>().Shape(), TensorShape({2, 2}));
+  EXPECT_EQ(TensorData(slice), (std::vector<float>{3.f, 4.f, 5.f, 6.f}));
+
+  EXPECT_FALSE(dynamic_batching::SliceBatch(batch, 2, 2, allocator, slice).IsOK());
+}
+
+TEST(DynamicBatcherTest, ConcatenateBatchRejectsMismatchedShapes) {
+  auto allocator = std::make_shared<CPUAllocator>();
+  OrtValue a = CreateFloatTensor(allocator, {1, 2}, {1.f, 2.f});
+  OrtValue b = CreateFloatTensor(allocator, {1, 3}, {3.f, 4.f, 5.f});
+
+  std::vector<const OrtValue*> values{&a, &b};
+  OrtValue batch;
+  EXPECT_FALSE(dynamic_batching::ConcatenateBatch(values, allocator, batch).IsOK());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,87 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "core/framework/ep_context_cache.h"
+#include "test/util/include/asserts.h"
+#include "test/util/include/temp_dir.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(EpContextCacheTest, KeyDependsOnAllComponents) {
+  const auto make_key = [](std::string_view model, std::string_view driver_version) {
+    EpContextCacheKey key;
+    key.AddBytes("model", model.data(), model.size());
+    key.Add("driver_version", driver_version);
+    return key.HexDigest();
+  };
+
+  const std::string digest = make_key("model", "1.0");
+  EXPECT_EQ(digest.size(), 32u);
+  EXPECT_EQ(digest, make_key("model", "1.0"));
+  EXPECT_NE(digest, make_key("model2", "1.0"));
+  EXPECT_NE(digest, make_key("model", "1.1"));
+
+  // component boundaries are part of the key
+  EXPECT_NE(make_key("ab", "c"), make_key("a", "bc"));
+}
+
+TEST(EpContextCacheTest, WriteAndReadEntry) {
+  TemporaryDirectory tmp_dir{ORT_TSTR("ep_context_cache_test_tmp_dir")};
+  const EpContextCacheDirectory cache(tmp_dir.Path() + ORT_TSTR("/cache"));
+
+  EpContextCacheKey key;
+  key.Add("model", "m").Add("device", "gpu0");
+
+  std::string blob;
+  EXPECT_FALSE(cache.HasEntry("TestEP", "graph/0", key));
+  EXPECT_FALSE(cache.ReadEntry("TestEP", "graph/0", key, blob));
+
+  const std::string compiled = "compiled blob";
+  ASSERT_STATUS_OK(cache.WriteEntry("TestEP", "graph/0", key, compiled.data(), compiled.size()));
+  EXPECT_TRUE(cache.HasEntry("TestEP", "graph/0", key));
+  ASSERT_TRUE(cache.ReadEntry("TestEP", "graph/0", key, blob));
+  EXPECT_EQ(blob, compiled);
+
+  // the model tag is sanitized so the entry is directly in the cache directory
+  EXPECT_EQ(std::filesystem::path(cache.GetEntryPath("TestEP", "graph/0", key)).parent_path(),
+            std::filesystem::path(cache.GetDirectory()));
+}
+
+TEST(EpContextCacheTest, AddingEntryRemovesOutdatedEntries) {
+  TemporaryDirectory tmp_dir{ORT_TSTR("ep_context_cache_test_tmp_dir")};
+  const EpContextCacheDirectory cache(tmp_dir.Path());
+
+  EpContextCacheKey old_key;
+  old_key.Add("driver_version", "1");
+  EpContextCacheKey new_key;
+  new_key.Add("driver_version", "2");
+
+  const std::string blob = "blob";
+  ASSERT_STATUS_OK(cache.WriteEntry("TestEP", "graph", old_key, blob.data(), blob.size()));
+  ASSERT_STATUS_OK(cache.WriteEntry("TestEP", "other_graph", old_key, blob.data(), blob.size()));
+  ASSERT_STATUS_OK(cache.WriteEntry("OtherEP", "graph", old_key, blob.data(), blob.size()));
+
+  // a directory entry, like a compiled model package
+  const PathString package_path = tmp_dir.Path() + ORT_TSTR("/package");
+  std::filesystem::create_directory(package_path);
+  std::ofstream(std::filesystem::path(package_path) / "model.bin") << blob;
+  ASSERT_STATUS_OK(cache.AddEntry("TestEP", "graph", new_key, package_path, ".pkg"));
+
+  EXPECT_FALSE(std::filesystem::exists(package_path));
+  EXPECT_TRUE(cache.HasEntry("TestEP", "graph", new_key, ".pkg"));
+  EXPECT_FALSE(cache.HasEntry("TestEP", "graph", old_key));
+
+  // entries of other graphs and other EPs are kept
+  EXPECT_TRUE(cache.HasEntry("TestEP", "other_graph", old_key));
+  EXPECT_TRUE(cache.HasEntry("OtherEP", "graph", old_key));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
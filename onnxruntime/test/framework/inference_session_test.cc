@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <filesystem>
 #include <functional>
 #include <iterator>
 #include <thread>
@@ -33,6 +34,7 @@
 #include "core/providers/cpu/math/element_wise_ops.h"
 #ifdef USE_CUDA
 #include "core/providers/cuda/cuda_provider_factory.h"
+#include "core/providers/cuda/cuda_provider_options.h"
 #include "core/providers/cuda/gpu_data_transfer.h"
 #endif
 #ifdef USE_TENSORRT
@@ -434,6 +436,56 @@ TEST(InferenceSessionTests, DisableCPUArena) {
   RunModel(session_object, run_options);
 }
 
+TEST(InferenceSessionTests, RunParallelSection) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.RunParallelSection";
+  so.intra_op_param.thread_pool_size = 4;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigIntraOpRunParallelSection, "1"));
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  for (int i = 0; i < 3; i++) {
+    RunModel(session_object, run_options);
+  }
+}
+
+TEST(InferenceSessionTests, Clone) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.Clone";
+
+  InferenceSession session_object{so, GetEnvironment()};
+  std::unique_ptr<InferenceSession> clone;
+  ASSERT_FALSE(session_object.Clone(so, clone).IsOK());
+
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  SessionOptions clone_so;
+  clone_so.session_logid = "InferenceSessionTests.Clone.Clone";
+  clone_so.intra_op_param.thread_pool_size = 2;
+  ASSERT_STATUS_OK(session_object.Clone(clone_so, clone));
+
+  // the clone shares the initialized session state
+  ASSERT_EQ(&clone->GetSessionState(), &session_object.GetSessionState());
+
+  RunOptions run_options;
+  RunModel(*clone, run_options);
+  RunModel(session_object, run_options);
+
+  // the thread pools bound in the current thread, as in the Runs of the clone, replace the ones of the session state
+  const auto* intra_op_thread_pool = session_object.GetSessionState().GetThreadPool();
+  {
+    const ThreadPoolBinding binding{nullptr, nullptr};
+    ThreadPoolBindingScope scope(&binding);
+    ASSERT_EQ(session_object.GetSessionState().GetThreadPool(), nullptr);
+  }
+  ASSERT_EQ(session_object.GetSessionState().GetThreadPool(), intra_op_thread_pool);
+}
+
 TEST(InferenceSessionTests, TestModelSerialization) {
   // Load model with level 0 transform level
   // and assert that the model has Identity nodes.
@@ -496,6 +548,48 @@ TEST(InferenceSessionTests, TestModelSerialization) {
   ASSERT_TRUE(session_object_emptyValidation.Initialize().IsOK());
 }
 
+TEST(InferenceSessionTests, OptimizedModelCache) {
+  const std::filesystem::path cache_dir = "OptimizedModelCache_dir";
+  std::filesystem::remove_all(cache_dir);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.OptimizedModelCache";
+  so.graph_optimization_level = TransformerLevel::Level1;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigOptimizedModelCacheDir,
+                                                    cache_dir.string().c_str()));
+
+  const auto count_cache_entries = [&cache_dir]() {
+    if (!std::filesystem::exists(cache_dir)) {
+      return 0;
+    }
+    return static_cast<int>(std::distance(std::filesystem::directory_iterator(cache_dir),
+                                          std::filesystem::directory_iterator()));
+  };
+
+  // The first session optimizes the model and saves it to the cache.
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load("testdata/transform/abs-id-max.onnx"));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  ASSERT_EQ(count_cache_entries(), 1);
+  ASSERT_EQ(CountOpsInGraph(session_object.GetGraph())["Identity"], 0);
+
+  // The second session loads the cache entry instead of writing a new one.
+  InferenceSessionWrapper cached_session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(cached_session_object.Load("testdata/transform/abs-id-max.onnx"));
+  ASSERT_STATUS_OK(cached_session_object.Initialize());
+  ASSERT_EQ(count_cache_entries(), 1);
+  ASSERT_EQ(CountOpsInGraph(cached_session_object.GetGraph())["Identity"], 0);
+
+  // Different optimization levels are different entries.
+  so.graph_optimization_level = TransformerLevel::Default;
+  InferenceSessionWrapper unoptimized_session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(unoptimized_session_object.Load("testdata/transform/abs-id-max.onnx"));
+  ASSERT_STATUS_OK(unoptimized_session_object.Initialize());
+  ASSERT_EQ(count_cache_entries(), 2);
+
+  std::filesystem::remove_all(cache_dir);
+}
+
 #ifdef ORT_RUN_EXTERNAL_ONNX_TESTS
 static bool Compare(const InputDefList& f_arg, const InputDefList& s_arg) {
   if (f_arg.size() != s_arg.size()) {
@@ -1073,6 +1167,190 @@ TEST(InferenceSessionTests, TestIOBindingReuse) {
   }
 }
 
+// A frozen binding validates and resolves its feeds and fetches once, and the later runs only update the contents.
+TEST(InferenceSessionTests, TestFrozenIOBinding) {
+  SessionOptions so;
+  InferenceSession session_object(so, GetEnvironment());
+  std::unique_ptr<Model> p_model;
+  CreateMatMulModel(p_model, kCpuExecutionProvider);
+
+  std::string s1;
+  p_model->ToProto().SerializeToString(&s1);
+  std::stringstream sstr(s1);
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  unique_ptr<IOBinding> io_binding;
+  ASSERT_STATUS_OK(session_object.NewIOBinding(&io_binding));
+
+  auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  OrtValue a, b;
+  CreateMLValue<float>(allocator, {2, 2}, {1.f, 2.f, 3.f, 4.f}, &a);
+  CreateMLValue<float>(allocator, {2, 2}, {1.f, 0.f, 0.f, 1.f}, &b);
+  ASSERT_STATUS_OK(io_binding->BindInput("A", a));
+  ASSERT_STATUS_OK(io_binding->BindInput("B", b));
+  ASSERT_STATUS_OK(io_binding->BindOutput("Y"));
+  ASSERT_STATUS_OK(io_binding->Freeze());
+
+  ASSERT_STATUS_OK(session_object.Run(*io_binding));
+  VerifyOutputs(io_binding->GetOutputs(), {2, 2}, {1.f, 2.f, 3.f, 4.f});
+  const void* output_data = io_binding->GetOutputs()[0].Get<Tensor>().DataRaw();
+
+  // the output allocated by the first run is written in place
+  OrtValue b2;
+  CreateMLValue<float>(allocator, {2, 2}, {2.f, 0.f, 0.f, 2.f}, &b2);
+  ASSERT_STATUS_OK(io_binding->BindInput("B", b2));
+  ASSERT_STATUS_OK(session_object.Run(*io_binding));
+  VerifyOutputs(io_binding->GetOutputs(), {2, 2}, {2.f, 4.f, 6.f, 8.f});
+  ASSERT_EQ(io_binding->GetOutputs()[0].Get<Tensor>().DataRaw(), output_data);
+
+  // new names and other shapes need the binding to be unfrozen
+  OrtValue b3;
+  CreateMLValue<float>(allocator, {2, 1}, {1.f, 1.f}, &b3);
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(io_binding->BindInput("B", b3), "Call Unfreeze() first");
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(io_binding->BindInput("C", b2), "can't bind new names");
+
+  io_binding->Unfreeze();
+  ASSERT_STATUS_OK(io_binding->BindInput("B", b3));
+  ASSERT_STATUS_OK(io_binding->BindOutput("Y"));
+  ASSERT_STATUS_OK(session_object.Run(*io_binding));
+  VerifyOutputs(io_binding->GetOutputs(), {2, 1}, {3.f, 7.f});
+}
+
+#if !defined(ORT_MINIMAL_BUILD) && !defined(ORT_NO_RTTI)
+// Tunes the CPU MatMul in one session and reuses the results in another session without tuning.
+TEST(InferenceSessionTests, CpuTunableOpResultsRoundTrip) {
+  std::unique_ptr<Model> p_model;
+  CreateMatMulModel(p_model, kCpuExecutionProvider);
+  std::string model_data;
+  ASSERT_TRUE(p_model->ToProto().SerializeToString(&model_data));
+
+  std::vector<float> a_data(4 * 8);
+  std::vector<float> b_data(8 * 16);
+  for (size_t i = 0; i < a_data.size(); ++i) a_data[i] = static_cast<float>(i % 5) - 2.0f;
+  for (size_t i = 0; i < b_data.size(); ++i) b_data[i] = static_cast<float>(i % 7) - 3.0f;
+  std::vector<float> expected(4 * 16, 0.0f);
+  for (size_t m = 0; m < 4; ++m) {
+    for (size_t n = 0; n < 16; ++n) {
+      for (size_t k = 0; k < 8; ++k) {
+        expected[m * 16 + n] += a_data[m * 8 + k] * b_data[k * 16 + n];
+      }
+    }
+  }
+
+  auto run = [&](InferenceSession& session) {
+    OrtValue a_value;
+    OrtValue b_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {4, 8}, a_data, &a_value);
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {8, 16}, b_data, &b_value);
+    NameMLValMap feeds{{"A", a_value}, {"B", b_value}};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session.Run(feeds, {"Y"}, &fetches));
+    VerifyOutputs(fetches, {4, 16}, expected);
+  };
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 2;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigCpuTunableOpEnable, "1"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigCpuTunableOpTuningEnable, "1"));
+  InferenceSession tuning_session{so, GetEnvironment()};
+  std::stringstream tuning_stream(model_data);
+  ASSERT_STATUS_OK(tuning_session.Load(tuning_stream));
+  ASSERT_STATUS_OK(tuning_session.Initialize());
+  run(tuning_session);
+
+  std::vector<TuningResults> tuning_results = tuning_session.GetTuningResults();
+  ASSERT_EQ(tuning_results.size(), 1u);
+  ASSERT_EQ(tuning_results[0].ep, kCpuExecutionProvider);
+  ASSERT_EQ(tuning_results[0].validators.count("CPU_ISA"), 1u);
+  ASSERT_EQ(tuning_results[0].results.size(), 1u);
+  ASSERT_EQ(tuning_results[0].results.begin()->second.size(), 1u);
+
+  SessionOptions so_no_tuning;
+  so_no_tuning.intra_op_param.thread_pool_size = 2;
+  InferenceSession session{so_no_tuning, GetEnvironment()};
+  std::stringstream stream(model_data);
+  ASSERT_STATUS_OK(session.Load(stream));
+  ASSERT_STATUS_OK(session.Initialize());
+  ASSERT_STATUS_OK(session.SetTuningResults(tuning_results, /*error_on_invalid*/ true, /*auto_enable*/ true));
+  run(session);
+
+  // the loaded result was used as is, nothing was tuned again
+  const auto reloaded_results = session.GetTuningResults();
+  ASSERT_EQ(reloaded_results.size(), 1u);
+  ASSERT_EQ(reloaded_results[0].results, tuning_results[0].results);
+
+  // results from a host with a different ISA are rejected
+  tuning_results[0].validators["CPU_ISA"] = "not this host";
+  ASSERT_FALSE(session.SetTuningResults(tuning_results, /*error_on_invalid*/ true, /*auto_enable*/ true).IsOK());
+}
+
+// The results tuned by one session are written to the cache directory when it is destroyed and picked up by the
+// next session.
+TEST(InferenceSessionTests, CpuTunableOpResultsCacheDir) {
+  std::unique_ptr<Model> p_model;
+  CreateMatMulModel(p_model, kCpuExecutionProvider);
+  std::string model_data;
+  ASSERT_TRUE(p_model->ToProto().SerializeToString(&model_data));
+
+  const std::filesystem::path cache_dir = "TuningResultsCache_dir";
+  std::filesystem::remove_all(cache_dir);
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 2;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigCpuTunableOpEnable, "1"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigTuningResultsCacheDir,
+                                                    cache_dir.string().c_str()));
+
+  std::vector<TuningResults> tuning_results;
+  {
+    SessionOptions tuning_so = so;
+    ASSERT_STATUS_OK(tuning_so.config_options.AddConfigEntry(kOrtSessionOptionsConfigCpuTunableOpTuningEnable, "1"));
+    InferenceSession tuning_session{tuning_so, GetEnvironment()};
+    std::stringstream tuning_stream(model_data);
+    ASSERT_STATUS_OK(tuning_session.Load(tuning_stream));
+    ASSERT_STATUS_OK(tuning_session.Initialize());
+
+    OrtValue a_value;
+    OrtValue b_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {4, 8},
+                         std::vector<float>(4 * 8, 1.0f), &a_value);
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {8, 16},
+                         std::vector<float>(8 * 16, 1.0f), &b_value);
+    NameMLValMap feeds{{"A", a_value}, {"B", b_value}};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(tuning_session.Run(feeds, {"Y"}, &fetches));
+    VerifyOutputs(fetches, {4, 16}, std::vector<float>(4 * 16, 8.0f));
+
+    tuning_results = tuning_session.GetTuningResults();
+    ASSERT_EQ(tuning_results.size(), 1u);
+    ASSERT_FALSE(tuning_results[0].results.empty());
+  }
+
+  const auto cache_file = inference_session_utils::GetTuningResultsCacheFile(cache_dir, kCpuExecutionProvider,
+                                                                             tuning_results[0].validators);
+  ASSERT_TRUE(std::filesystem::exists(cache_file));
+
+  // results tuned in another environment go to another file
+  auto other_validators = tuning_results[0].validators;
+  other_validators["CPU_ISA"] = "not this host";
+  ASSERT_NE(inference_session_utils::GetTuningResultsCacheFile(cache_dir, kCpuExecutionProvider, other_validators),
+            cache_file);
+
+  {
+    InferenceSession session{so, GetEnvironment()};
+    std::stringstream stream(model_data);
+    ASSERT_STATUS_OK(session.Load(stream));
+    ASSERT_STATUS_OK(session.Initialize());
+
+    const auto cached_results = session.GetTuningResults();
+    ASSERT_EQ(cached_results.size(), 1u);
+    ASSERT_EQ(cached_results[0].results, tuning_results[0].results);
+  }
+
+  std::filesystem::remove_all(cache_dir);
+}
+#endif
+
 TEST(InferenceSessionTests, InvalidInputTypeOfTensorElement) {
   SessionOptions so;
 
@@ -2120,6 +2398,22 @@ TEST(InferenceSessionTests, DISABLED_TestParallelExecutionWithCudaProvider) {
   ASSERT_TRUE(so_queried.execution_mode == ExecutionMode::ORT_SEQUENTIAL);
 }
 
+TEST(InferenceSessionTests, StageFeedsInPinnedMemoryWithCudaProvider) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.StageFeedsInPinnedMemoryWithCudaProvider";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigStageFeedsInPinnedMemory, "1"));
+  InferenceSession session_object{so, GetEnvironment()};
+
+  ASSERT_STATUS_OK(session_object.RegisterExecutionProvider(DefaultCudaExecutionProvider()));
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // the second run reuses the pinned buffers released by the first one
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+  RunModel(session_object, run_options);
+}
+
 TEST(InferenceSessionTests, TestArenaShrinkageAfterRun) {
   OrtArenaCfg arena_cfg;
   arena_cfg.arena_extend_strategy = 1;  // kSameAsRequested
@@ -2836,6 +3130,526 @@ TEST(InferenceSessionTests, InitializerSharing_EnsureSessionsUseUserAddedInitial
   }
 }
 
+TEST(InferenceSessionTests, InitializerSharing_AcrossSessionsInEnv) {
+  if constexpr (!SessionOptions::DEFAULT_USE_PER_SESSION_THREADS) {
+    GTEST_SKIP() << "Skipping the test";
+  }
+  auto logging_manager = std::make_unique<logging::LoggingManager>(
+      std::unique_ptr<ISink>(new CLogSink()), logging::Severity::kVERBOSE, false,
+      LoggingManager::InstanceType::Temporal);
+
+  std::unique_ptr<Environment> env;
+  ASSERT_STATUS_OK(Environment::Create(std::move(logging_manager), env));
+
+  const char* init_name = "W";
+  auto get_init_buffer = [init_name](InferenceSessionWrapper& sess) {
+    int idx;
+    ORT_THROW_IF_ERROR(sess.GetSessionState().GetOrtValueNameIdxMap().GetIdx(init_name, idx));
+    return sess.GetSessionState().GetInitializedTensors().at(idx).Get<Tensor>().Data<float>();
+  };
+
+  SessionOptions so;
+  so.graph_optimization_level = TransformerLevel::Default;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigShareInitializersAcrossSessions, "1"));
+
+  auto sess1 = std::make_unique<InferenceSessionTestSharingInitializer>(so, *env);
+  ASSERT_STATUS_OK(sess1->Load(MODEL_URI));
+  ASSERT_STATUS_OK(sess1->Initialize());
+
+  auto sess2 = std::make_unique<InferenceSessionTestSharingInitializer>(so, *env);
+  ASSERT_STATUS_OK(sess2->Load(MODEL_URI));
+  ASSERT_STATUS_OK(sess2->Initialize());
+
+  SessionOptions so_not_shared;
+  so_not_shared.graph_optimization_level = TransformerLevel::Default;
+  InferenceSessionTestSharingInitializer sess3(so_not_shared, *env);
+  ASSERT_STATUS_OK(sess3.Load(MODEL_URI));
+  ASSERT_STATUS_OK(sess3.Initialize());
+
+  // the sessions that enable sharing use one copy of the identical initializer, the other session has its own
+  ASSERT_EQ(get_init_buffer(*sess1), get_init_buffer(*sess2));
+  ASSERT_NE(get_init_buffer(*sess1), get_init_buffer(sess3));
+  ASSERT_EQ(env->GetSharedInitializerCache().GetNumberOfElements(), size_t{1});
+
+  // the shared copy is released with the last session using it
+  sess1.reset();
+  ASSERT_EQ(env->GetSharedInitializerCache().GetNumberOfElements(), size_t{1});
+  sess2.reset();
+  ASSERT_EQ(env->GetSharedInitializerCache().GetNumberOfElements(), size_t{0});
+}
+
+// Y = X * W + (X * A) * B, where the LoRA matrices A and B are overridable initializers that default to zeros.
+static void CreateLoraModel(std::string& model_data) {
+  onnxruntime::Model model("lora", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 13}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  auto make_float_tensor = [](std::initializer_list<int64_t> dims) {
+    TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    for (auto dim : dims) {
+      type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+    }
+    return type;
+  };
+  auto add_initializer = [&graph](const std::string& name, std::initializer_list<int64_t> dims,
+                                  std::initializer_list<float> values) {
+    TensorProto tensor;
+    tensor.set_name(name);
+    tensor.set_data_type(TensorProto_DataType_FLOAT);
+    for (auto dim : dims) {
+      tensor.add_dims(dim);
+    }
+    for (auto value : values) {
+      tensor.add_float_data(value);
+    }
+    graph.AddInitializedTensor(tensor);
+  };
+
+  auto type_x = make_float_tensor({1, 2});
+  auto type_a = make_float_tensor({2, 1});
+  auto type_b = make_float_tensor({1, 2});
+  auto type_xa = make_float_tensor({1, 1});
+  auto& x = graph.GetOrCreateNodeArg("X", &type_x);
+  auto& w = graph.GetOrCreateNodeArg("W", nullptr);
+  auto& a = graph.GetOrCreateNodeArg("A", &type_a);
+  auto& b = graph.GetOrCreateNodeArg("B", &type_b);
+  auto& xw = graph.GetOrCreateNodeArg("XW", &type_x);
+  auto& xa = graph.GetOrCreateNodeArg("XA", &type_xa);
+  auto& delta = graph.GetOrCreateNodeArg("delta", &type_x);
+  auto& y = graph.GetOrCreateNodeArg("Y", &type_x);
+  graph.AddNode("base", "MatMul", "", {&x, &w}, {&xw});
+  graph.AddNode("lora_a", "MatMul", "", {&x, &a}, {&xa});
+  graph.AddNode("lora_b", "MatMul", "", {&xa, &b}, {&delta});
+  graph.AddNode("add", "Add", "", {&xw, &delta}, {&y});
+
+  add_initializer("W", {2, 2}, {1.f, 0.f, 0.f, 1.f});
+  add_initializer("A", {2, 1}, {0.f, 0.f});
+  add_initializer("B", {1, 2}, {0.f, 0.f});
+  graph.SetInputs({&x, &a, &b});
+  graph.SetOutputs({&y});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+}
+
+TEST(InferenceSessionTests, LoraAdapterPerRun) {
+  std::string model_data;
+  CreateLoraModel(model_data);
+
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  std::stringstream stream(model_data);
+  ASSERT_STATUS_OK(session.Load(stream));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  auto make_value = [&allocator](const std::vector<int64_t>& dims, const std::vector<float>& values) {
+    OrtValue value;
+    CreateMLValue<float>(allocator, dims, values, &value);
+    return value;
+  };
+
+  // delta = (X * A) * B
+  ASSERT_STATUS_OK(session.AddLoraAdapter("sum_to_first",
+                                          {{"A", make_value({2, 1}, {1.f, 1.f})}, {"B", make_value({1, 2}, {1.f, 0.f})}}));
+  ASSERT_STATUS_OK(session.AddLoraAdapter("double_first_to_second",
+                                          {{"A", make_value({2, 1}, {1.f, 0.f})}, {"B", make_value({1, 2}, {0.f, 2.f})}}));
+  ASSERT_STATUS_OK(session.AddLoraAdapter("scale_b", {{"B", make_value({1, 2}, {1.f, 1.f})}}));
+
+  // the parameters are validated against the model inputs
+  ASSERT_FALSE(session.AddLoraAdapter("sum_to_first", {{"A", make_value({2, 1}, {1.f, 1.f})}}).IsOK());
+  ASSERT_FALSE(session.AddLoraAdapter("bad_shape", {{"A", make_value({1, 2}, {1.f, 1.f})}}).IsOK());
+  ASSERT_FALSE(session.AddLoraAdapter("bad_name", {{"C", make_value({2, 1}, {1.f, 1.f})}}).IsOK());
+
+  NameMLValMap feeds{{"X", make_value({1, 2}, {1.f, 2.f})}};
+  auto run = [&](const std::string& active_lora_adapters, const std::vector<float>& expected_y) {
+    RunOptions run_options;
+    ASSERT_STATUS_OK(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigActiveLoraAdapters,
+                                                               active_lora_adapters.c_str()));
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session.Run(run_options, feeds, {"Y"}, &fetches));
+    VerifyOutputs(fetches, {1, 2}, expected_y);
+  };
+
+  run("", {1.f, 2.f});
+  run("sum_to_first", {4.f, 2.f});
+  run("double_first_to_second", {1.f, 4.f});
+  run("sum_to_first", {4.f, 2.f});
+
+  RunOptions run_options;
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigActiveLoraAdapters,
+                                                             "sum_to_first,scale_b"));
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(session.Run(run_options, feeds, {"Y"}, &fetches), "fed more than once");
+
+  ASSERT_STATUS_OK(session.RemoveLoraAdapter("sum_to_first"));
+  RunOptions removed_run_options;
+  ASSERT_STATUS_OK(removed_run_options.config_options.AddConfigEntry(kOrtRunOptionsConfigActiveLoraAdapters,
+                                                                     "sum_to_first"));
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(session.Run(removed_run_options, feeds, {"Y"}, &fetches),
+                                      "No LoRA adapter named sum_to_first");
+}
+
+// Two heads: YA = Relu(X) and YB = Reshape(X, S). Feeding an invalid shape S makes the Reshape fail if it's executed.
+static void CreateTwoHeadModel(std::string& model_data) {
+  onnxruntime::Model model("two_heads", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 13}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto type_x;
+  type_x.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type_x.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  type_x.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  TypeProto type_s;
+  type_s.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  type_s.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &type_x);
+  auto& s = graph.GetOrCreateNodeArg("S", &type_s);
+  auto& ya = graph.GetOrCreateNodeArg("YA", &type_x);
+  auto& yb = graph.GetOrCreateNodeArg("YB", nullptr);
+  graph.AddNode("head_a", "Relu", "", {&x}, {&ya});
+  graph.AddNode("head_b", "Reshape", "", {&x, &s}, {&yb});
+  graph.SetInputs({&x, &s});
+  graph.SetOutputs({&ya, &yb});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+}
+
+TEST(InferenceSessionTests, PruneExecutionToFetches) {
+  std::string model_data;
+  CreateTwoHeadModel(model_data);
+
+  auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  OrtValue x;
+  CreateMLValue<float>(allocator, {1, 2}, {-1.f, 2.f}, &x);
+  OrtValue s;
+  CreateMLValue<int64_t>(allocator, {2}, {3, 3}, &s);
+  NameMLValMap feeds{{"X", x}, {"S", s}};
+
+  auto create_session = [&model_data](const char* prune_execution_to_fetches) {
+    SessionOptions so;
+    EXPECT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigPruneExecutionToFetches,
+                                                      prune_execution_to_fetches));
+    auto session = std::make_unique<InferenceSession>(so, GetEnvironment());
+    std::stringstream stream(model_data);
+    EXPECT_STATUS_OK(session->Load(stream));
+    EXPECT_STATUS_OK(session->Initialize());
+    return session;
+  };
+
+  RunOptions run_options;
+  std::vector<OrtValue> fetches;
+
+  // all the nodes are executed by default
+  auto session = create_session("0");
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(session->Run(run_options, feeds, {"YA"}, &fetches), "head_b");
+
+  // unless the Run asks for it
+  RunOptions prune_run_options;
+  prune_run_options.only_execute_path_to_fetches = true;
+  ASSERT_STATUS_OK(session->Run(prune_run_options, feeds, {"YA"}, &fetches));
+  VerifyOutputs(fetches, {1, 2}, {0.f, 2.f});
+
+  // or the session prunes the Runs that fetch a subset of the outputs
+  auto pruning_session = create_session("1");
+  for (int i = 0; i < 2; ++i) {
+    fetches.clear();
+    ASSERT_STATUS_OK(pruning_session->Run(run_options, feeds, {"YA"}, &fetches));
+    VerifyOutputs(fetches, {1, 2}, {0.f, 2.f});
+  }
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(pruning_session->Run(run_options, feeds, {"YB"}, &fetches), "head_b");
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(pruning_session->Run(run_options, feeds, {"YA", "YB"}, &fetches), "head_b");
+}
+
+// Y = Relu(X) + B, cut at H = Relu(X).
+static void CreateTwoStageModel(std::string& model_data) {
+  onnxruntime::Model model("two_stage", false, ModelMetaData(), PathString(),
+                           IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {},
+                           DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto type_x;
+  type_x.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type_x.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  type_x.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &type_x);
+  auto& b = graph.GetOrCreateNodeArg("B", &type_x);
+  auto& h = graph.GetOrCreateNodeArg("H", &type_x);
+  auto& y = graph.GetOrCreateNodeArg("Y", &type_x);
+  graph.AddNode("encoder", "Relu", "", {&x}, {&h});
+  graph.AddNode("decoder", "Add", "", {&h, &b}, {&y});
+  graph.SetInputs({&x, &b});
+  graph.SetOutputs({&y});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+}
+
+TEST(InferenceSessionTests, PartialRunCutValues) {
+  std::string model_data;
+  CreateTwoStageModel(model_data);
+
+  auto create_session = [&model_data](const char* cut_values, std::unique_ptr<InferenceSession>& session) {
+    SessionOptions so;
+    EXPECT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigPartialRunCutValues, cut_values));
+    session = std::make_unique<InferenceSession>(so, GetEnvironment());
+    std::stringstream stream(model_data);
+    EXPECT_STATUS_OK(session->Load(stream));
+    return session->Initialize();
+  };
+
+  std::unique_ptr<InferenceSession> session;
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(create_session("X", session), "is not produced by a node");
+  ASSERT_STATUS_OK(create_session("H", session));
+
+  auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  OrtValue x;
+  CreateMLValue<float>(allocator, {1, 2}, {-1.f, 2.f}, &x);
+  OrtValue b;
+  CreateMLValue<float>(allocator, {1, 2}, {10.f, 20.f}, &b);
+  RunOptions run_options;
+
+  // the first stage only needs X
+  std::vector<OrtValue> cut;
+  ASSERT_STATUS_OK(session->Run(run_options, NameMLValMap{{"X", x}}, {"H"}, &cut));
+  VerifyOutputs(cut, {1, 2}, {0.f, 2.f});
+
+  // the second stage resumes from the cut, without X, and can be repeated
+  for (float offset : {0.f, 1.f}) {
+    OrtValue b2;
+    CreateMLValue<float>(allocator, {1, 2}, {10.f + offset, 20.f + offset}, &b2);
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session->Run(run_options, NameMLValMap{{"H", cut[0]}, {"B", b2}}, {"Y"}, &fetches));
+    VerifyOutputs(fetches, {1, 2}, {10.f + offset, 22.f + offset});
+  }
+
+  // the whole model still runs in one go
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session->Run(run_options, NameMLValMap{{"X", x}, {"B", b}}, {"Y"}, &fetches));
+  VerifyOutputs(fetches, {1, 2}, {10.f, 22.f});
+}
+
+// Y = Reshape(X, S), with an early exit returning E = Neg(X) if P = ReduceMax(X) > T.
+static void CreateEarlyExitModel(std::string& model_data) {
+  onnxruntime::Model model("early_exit", false, ModelMetaData(), PathString(),
+                           IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {},
+                           DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto type_x;
+  type_x.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type_x.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  type_x.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  TypeProto type_float;
+  type_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  TypeProto type_bool;
+  type_bool.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+  TypeProto type_shape;
+  type_shape.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  type_shape.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &type_x);
+  auto& t = graph.GetOrCreateNodeArg("T", &type_float);
+  auto& s = graph.GetOrCreateNodeArg("S", &type_shape);
+  auto& m = graph.GetOrCreateNodeArg("M", &type_float);
+  auto& p = graph.GetOrCreateNodeArg("P", &type_bool);
+  auto& e = graph.GetOrCreateNodeArg("E", &type_float);
+  auto& y = graph.GetOrCreateNodeArg("Y", &type_float);
+  graph.AddNode("confidence", "ReduceMax", "", {&x}, {&m});
+  graph.AddNode("predicate", "Greater", "", {&m, &t}, {&p});
+  graph.AddNode("exit", "Neg", "", {&x}, {&e});
+  graph.AddNode("trunk", "Reshape", "", {&x, &s}, {&y});
+  graph.SetInputs({&x, &t, &s});
+  graph.SetOutputs({&y});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+}
+
+TEST(InferenceSessionTests, EarlyExitPoints) {
+  std::string model_data;
+  CreateEarlyExitModel(model_data);
+
+  auto create_session = [&model_data](const char* exit_points, std::unique_ptr<InferenceSession>& session) {
+    SessionOptions so;
+    EXPECT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigEarlyExitPoints, exit_points));
+    session = std::make_unique<InferenceSession>(so, GetEnvironment());
+    std::stringstream stream(model_data);
+    EXPECT_STATUS_OK(session->Load(stream));
+    return session->Initialize();
+  };
+
+  std::unique_ptr<InferenceSession> session;
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(create_session("M:E", session), "must be a boolean tensor");
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(create_session("P:E,M", session), "outputs, but the model has 1");
+  ASSERT_STATUS_OK(create_session("P:E", session));
+
+  auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  OrtValue x;
+  CreateMLValue<float>(allocator, {1, 2}, {1.f, 2.f}, &x);
+  auto run = [&](float threshold, std::vector<int64_t> shape, std::vector<OrtValue>& fetches) {
+    OrtValue t;
+    CreateMLValue<float>(allocator, {1}, {threshold}, &t);
+    OrtValue s;
+    CreateMLValue<int64_t>(allocator, {2}, shape, &s);
+    fetches.clear();
+    return session->Run(RunOptions{}, NameMLValMap{{"X", x}, {"T", t}, {"S", s}}, {"Y"}, &fetches);
+  };
+
+  // the exit is taken, the invalid shape of the trunk doesn't matter as it isn't executed
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(run(0.f, {3, 3}, fetches));
+  VerifyOutputs(fetches, {1, 2}, {-1.f, -2.f});
+
+  // the exit isn't taken, the trunk is executed
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(run(5.f, {3, 3}, fetches), "trunk");
+  ASSERT_STATUS_OK(run(5.f, {1, 2}, fetches));
+  VerifyOutputs(fetches, {1, 2}, {1.f, 2.f});
+}
+
+// Z = Neg(H), with H = Abs(In): the intermediate value has the name of a value of the two stage model.
+static void SavePostprocessingModel(const std::filesystem::path& model_path) {
+  onnxruntime::Model model("postprocessing", false, ModelMetaData(), PathString(),
+                           IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {},
+                           DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto type_in;
+  type_in.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type_in.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  type_in.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& in = graph.GetOrCreateNodeArg("In", &type_in);
+  auto& h = graph.GetOrCreateNodeArg("H", &type_in);
+  auto& z = graph.GetOrCreateNodeArg("Z", &type_in);
+  graph.AddNode("encoder", "Abs", "", {&in}, {&h});
+  graph.AddNode("decoder", "Neg", "", {&h}, {&z});
+  graph.SetInputs({&in});
+  graph.SetOutputs({&z});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  std::ofstream stream(model_path, std::ios::binary);
+  ASSERT_TRUE(model.ToProto().SerializeToOstream(&stream));
+}
+
+TEST(InferenceSessionTests, ComposeModels) {
+  std::string model_data;
+  CreateTwoStageModel(model_data);
+  const std::filesystem::path stage_path = "ComposeModels_postprocessing.onnx";
+  SavePostprocessingModel(stage_path);
+
+  auto create_session = [&](const std::string& stages, std::unique_ptr<InferenceSessionWrapper>& session) {
+    SessionOptions so;
+    EXPECT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigComposeModels, stages.c_str()));
+    session = std::make_unique<InferenceSessionWrapper>(so, GetEnvironment());
+    std::stringstream stream(model_data);
+    ORT_RETURN_IF_ERROR(session->Load(stream));
+    return session->Initialize();
+  };
+
+  std::unique_ptr<InferenceSessionWrapper> session;
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(create_session(stage_path.string() + "|H=In", session),
+                                      "is not an output of the composed model");
+  ASSERT_STATUS_NOT_OK_AND_HAS_SUBSTR(create_session(stage_path.string() + "|Y=X", session),
+                                      "is not an input of the model of stage 1");
+  ASSERT_STATUS_OK(create_session(stage_path.string() + "|Y=In", session));
+
+  // the connected output is replaced by the output of the stage
+  const auto& outputs = session->GetGraph().GetOutputs();
+  ASSERT_EQ(outputs.size(), 1u);
+  EXPECT_EQ(outputs[0]->Name(), "Z");
+  EXPECT_NE(session->GetGraph().GetNodeArg("stage1/H"), nullptr);
+
+  auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  OrtValue x;
+  CreateMLValue<float>(allocator, {1, 2}, {-1.f, 2.f}, &x);
+  OrtValue b;
+  CreateMLValue<float>(allocator, {1, 2}, {-10.f, 20.f}, &b);
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session->Run(RunOptions{}, NameMLValMap{{"X", x}, {"B", b}}, {"Z"}, &fetches));
+  VerifyOutputs(fetches, {1, 2}, {-10.f, -22.f});
+
+  std::filesystem::remove(stage_path);
+}
+
+#ifdef USE_CUDA
+// Relu of an input with a symbolic batch dimension.
+static void CreateDynamicBatchReluModel(std::string& model_data) {
+  onnxruntime::Model model("dynamic_batch_relu", false, ModelMetaData(), PathString(),
+                           IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {},
+                           DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto type_x;
+  type_x.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type_x.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  type_x.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &type_x);
+  auto& y = graph.GetOrCreateNodeArg("Y", &type_x);
+  graph.AddNode("relu", "Relu", "", {&x}, {&y});
+  graph.SetInputs({&x});
+  graph.SetOutputs({&y});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+}
+
+TEST(InferenceSessionTests, GraphCaptureBatchBuckets) {
+  std::string model_data;
+  CreateDynamicBatchReluModel(model_data);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigGraphCaptureBatchBuckets, "2,4"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigGraphCaptureMaxGraphs, "1"));
+  InferenceSession session_object{so, GetEnvironment()};
+
+  OrtCUDAProviderOptionsV2 provider_options{};
+  provider_options.enable_cuda_graph = 1;
+  auto factory = CudaProviderFactoryCreator::Create(&provider_options);
+  ASSERT_STATUS_OK(session_object.RegisterExecutionProvider(factory->CreateProvider()));
+  std::stringstream stream(model_data);
+  ASSERT_STATUS_OK(session_object.Load(stream));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  RunOptions run_options;
+  auto run_and_verify = [&](const std::vector<float>& x_values) {
+    const int64_t batch_size = static_cast<int64_t>(x_values.size() / 2);
+    OrtValue x;
+    CreateMLValue<float>(allocator, {batch_size, 2}, x_values, &x);
+    NameMLValMap feeds{{"X", x}};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(run_options, feeds, {"Y"}, &fetches));
+
+    std::vector<float> expected_values(x_values.size());
+    std::transform(x_values.begin(), x_values.end(), expected_values.begin(),
+                   [](float value) { return std::max(value, 0.f); });
+    VerifyOutputs(fetches, {batch_size, 2}, expected_values);
+  };
+
+  // batch sizes 1 and 2 share the graph of bucket 2, the second Run replays it
+  run_and_verify({-1.f, 2.f});
+  run_and_verify({3.f, -4.f, -5.f, 6.f});
+  run_and_verify({7.f, -8.f});
+
+  // batch size 3 is padded to bucket 4, whose graph replaces the one of bucket 2
+  run_and_verify({1.f, -2.f, 3.f, -4.f, 5.f, -6.f});
+  run_and_verify({-1.f, 2.f, -3.f, 4.f, -5.f, 6.f, -7.f, 8.f});
+
+  // batch size 5 is above the largest bucket and runs without graph capture
+  run_and_verify({-1.f, 1.f, -2.f, 2.f, -3.f, 3.f, -4.f, 4.f, -5.f, 5.f});
+
+  // bucket 2 is captured again
+  run_and_verify({-9.f, 10.f, 11.f, -12.f});
+}
+#endif  // USE_CUDA
+
 void RunModelWithDenormalAsZero(InferenceSession& session_object,
                                 const RunOptions& run_options,
                                 bool set_denormal_as_zero) {
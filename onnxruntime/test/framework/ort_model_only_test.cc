@@ -3,6 +3,7 @@
 
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/data_types.h"
+#include "core/framework/sequential_execution_plan.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/TensorSeq.h"
 #include "core/graph/model.h"
@@ -322,6 +323,66 @@ TEST(OrtModelOnlyTests, SerializeToOrtFormat) {
   RunOrtModel(test_info);
 }
 
+TEST(OrtModelOnlyTests, SaveAndLoadExecutionPlan) {
+  const auto ort_file = ORT_TSTR("testdata/mnist.onnx.execution_plan.test_output.ort");
+  SaveAndCompareModels(ORT_TSTR("testdata/mnist.onnx"), ort_file);
+
+  size_t num_bytes = 0;
+  ASSERT_STATUS_OK(Env::Default().GetFileLength(ort_file, num_bytes));
+  std::vector<char> model_data(num_bytes);
+  std::ifstream bytes_stream(ort_file, std::ifstream::in | std::ifstream::binary);
+  bytes_stream.read(model_data.data(), num_bytes);
+  bytes_stream.close();
+
+  // the CPU only plan has a single logic stream, so it is saved
+  const auto* fbs_session = fbs::GetInferenceSession(model_data.data());
+  ASSERT_NE(fbs_session->execution_plan(), nullptr);
+
+  SessionOptions so;
+  so.session_logid = "SaveAndLoadExecutionPlan";
+  InferenceSessionWrapper planned_session{so, GetEnvironment()};
+  ASSERT_STATUS_OK(planned_session.Load(ORT_TSTR("testdata/mnist.onnx")));
+  ASSERT_STATUS_OK(planned_session.Initialize());
+
+  InferenceSessionWrapper loaded_session{so, GetEnvironment()};
+  ASSERT_STATUS_OK(loaded_session.Load(model_data.data(), static_cast<int>(num_bytes)));
+  ASSERT_STATUS_OK(loaded_session.Initialize());
+
+  // the loaded plan matches the plan created by the allocation planner
+  const auto& planned = *planned_session.GetSessionState().GetExecutionPlan();
+  const auto& loaded = *loaded_session.GetSessionState().GetExecutionPlan();
+  ASSERT_EQ(loaded.execution_plan.size(), 1u);
+  ASSERT_EQ(loaded.execution_plan[0]->steps_.size(), planned.execution_plan[0]->steps_.size());
+  for (size_t i = 0; i < loaded.execution_plan[0]->steps_.size(); ++i) {
+    EXPECT_EQ(loaded.execution_plan[0]->steps_[i]->GetNodeIndex(), planned.execution_plan[0]->steps_[i]->GetNodeIndex());
+  }
+
+  ASSERT_EQ(loaded.allocation_plan.size(), planned.allocation_plan.size());
+  for (size_t i = 0; i < loaded.allocation_plan.size(); ++i) {
+    EXPECT_EQ(loaded.allocation_plan[i].alloc_kind, planned.allocation_plan[i].alloc_kind);
+    EXPECT_EQ(loaded.allocation_plan[i].reused_buffer, planned.allocation_plan[i].reused_buffer);
+    EXPECT_EQ(loaded.allocation_plan[i].location, planned.allocation_plan[i].location);
+    EXPECT_EQ(loaded.allocation_plan[i].value_type, planned.allocation_plan[i].value_type);
+  }
+
+  ASSERT_EQ(loaded.release_actions.size(), planned.release_actions.size());
+  for (size_t i = 0; i < loaded.release_actions.size(); ++i) {
+    EXPECT_EQ(loaded.release_actions[i].value_index, planned.release_actions[i].value_index);
+    EXPECT_EQ(loaded.release_actions[i].ref_count, planned.release_actions[i].ref_count);
+  }
+  EXPECT_EQ(loaded.node_release_list, planned.node_release_list);
+
+  std::vector<float> data(28 * 28, 1.f);
+  OrtValue input;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {1, 1, 28, 28}, data, &input);
+  NameMLValMap feeds{{"Input3", input}};
+  std::vector<OrtValue> planned_fetches;
+  std::vector<OrtValue> loaded_fetches;
+  ASSERT_STATUS_OK(planned_session.Run(feeds, {"Plus214_Output_0"}, &planned_fetches));
+  ASSERT_STATUS_OK(loaded_session.Run(feeds, {"Plus214_Output_0"}, &loaded_fetches));
+  CheckOrtValuesAreEqual("Plus214_Output_0", planned_fetches[0], loaded_fetches[0]);
+}
+
 TEST(OrtModelOnlyTests, SparseInitializerHandling) {
   const auto ort_file = ORT_TSTR("testdata/ort_minimal_test_models/sparse_initializer_handling.onnx.test_output.ort");
   SaveAndCompareModels(ORT_TSTR("testdata/ort_minimal_test_models/sparse_initializer_handling.onnx"), ort_file);
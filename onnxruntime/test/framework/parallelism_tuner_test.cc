@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/parallelism_tuner.h"
+
+#include <sstream>
+
+#include "core/framework/session_state.h"
+#include "core/framework/tensor.h"
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "gtest/gtest.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace std::chrono_literals;
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Y = Relu(X)
+std::string CreateModel() {
+  Model model("parallelism_tuner", false, ModelMetaData(), ORT_TSTR(""), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 13}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("N");
+
+  auto& x = graph.GetOrCreateNodeArg("X", &type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &type);
+  graph.AddNode("relu", "Relu", "", {&x}, {&y});
+  ORT_THROW_IF_ERROR(graph.Resolve());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+  return model_data;
+}
+
+void InitializeSession(InferenceSession& session) {
+  std::stringstream stream(CreateModel());
+  ASSERT_STATUS_OK(session.Load(stream));
+  ASSERT_STATUS_OK(session.Initialize());
+}
+
+SessionOptions CreateSessionOptions(const char* samples) {
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 4;
+  EXPECT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigIntraOpAdaptiveParallelismSamples,
+                                                     samples));
+  return so;
+}
+
+}  // namespace
+
+TEST(ParallelismTunerTest, DisabledByDefault) {
+  InferenceSession session{CreateSessionOptions("0"), GetEnvironment()};
+  InitializeSession(session);
+
+  ASSERT_EQ(session.GetSessionState().GetParallelismTuner(), nullptr);
+}
+
+TEST(ParallelismTunerTest, RunsWhileTuning) {
+  InferenceSession session{CreateSessionOptions("1"), GetEnvironment()};
+  InitializeSession(session);
+  ASSERT_NE(session.GetSessionState().GetParallelismTuner(), nullptr);
+
+  // the runs measuring the candidates and the ones after produce the same results
+  for (int run = 0; run < 5; ++run) {
+    OrtValue x;
+    Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), TensorShape({1024}), std::make_shared<CPUAllocator>(), x);
+    auto* x_data = x.GetMutable<Tensor>()->MutableData<float>();
+    for (int i = 0; i < 1024; ++i) {
+      x_data[i] = static_cast<float>(i % 2 == 0 ? i : -i);
+    }
+
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session.Run(NameMLValMap{{"X", x}}, {"Y"}, &fetches));
+    const auto* y_data = fetches[0].Get<Tensor>().Data<float>();
+    for (int i = 0; i < 1024; ++i) {
+      ASSERT_EQ(y_data[i], i % 2 == 0 ? static_cast<float>(i) : 0.f);
+    }
+  }
+}
+
+TEST(ParallelismTunerTest, SelectsFewestThreadsWithinTolerance) {
+  InferenceSession session{CreateSessionOptions("0"), GetEnvironment()};
+  InitializeSession(session);
+  const auto& graph_viewer = session.GetSessionState().GetGraphViewer();
+  const NodeIndex node_index = graph_viewer.Nodes().begin()->Index();
+
+  ParallelismTuner tuner(graph_viewer, 4, 2);
+  ASSERT_TRUE(tuner.IsTuned(node_index));
+
+  // the candidates 1, 2 and 4 are measured twice each, keeping the fastest sample
+  const std::vector<std::pair<int, ParallelismTuner::Duration>> samples{
+      {1, 100us}, {1, 90us}, {2, 60us}, {2, 54us}, {4, 52us}, {4, 50us}};
+  for (const auto& [degree_of_parallelism, duration] : samples) {
+    const auto trial = tuner.Select(node_index, 1);
+    ASSERT_TRUE(trial.measure);
+    ASSERT_EQ(trial.degree_of_parallelism, degree_of_parallelism);
+    tuner.Record(node_index, 1, trial.degree_of_parallelism, duration);
+  }
+
+  // 2 threads are within 10% of 4
+  EXPECT_EQ(tuner.GetDegreeOfParallelism(node_index, 1), 2);
+  const auto trial = tuner.Select(node_index, 1);
+  EXPECT_FALSE(trial.measure);
+  EXPECT_EQ(trial.degree_of_parallelism, 2);
+
+  // other shapes are tuned separately, and samples of a candidate no longer measured are ignored
+  EXPECT_EQ(tuner.GetDegreeOfParallelism(node_index, 2), 0);
+  EXPECT_EQ(tuner.Select(node_index, 2).degree_of_parallelism, 1);
+  tuner.Record(node_index, 2, 4, 1us);
+  EXPECT_EQ(tuner.Select(node_index, 2).degree_of_parallelism, 1);
+}
+
+TEST(ParallelismTunerTest, InvalidSamples) {
+  InferenceSession session{CreateSessionOptions("some"), GetEnvironment()};
+  std::stringstream stream(CreateModel());
+  ASSERT_STATUS_OK(session.Load(stream));
+  ASSERT_STATUS_NOT_OK(session.Initialize());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+#include "core/framework/allocator.h"
+#include "core/framework/prepacked_weights_file_cache.h"
+#include "test/util/include/asserts.h"
+#include "test/util/include/temp_dir.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+PrePackedWeights MakePrePackedWeights(const AllocatorPtr& alloc, size_t size, uint8_t first_value) {
+  PrePackedWeights weights;
+  auto buffer = IAllocator::MakeUniquePtr<void>(alloc, size, true);
+  std::iota(static_cast<uint8_t*>(buffer.get()), static_cast<uint8_t*>(buffer.get()) + size, first_value);
+  weights.buffers_.push_back(std::move(buffer));
+  weights.buffer_sizes_.push_back(size);
+  return weights;
+}
+
+}  // namespace
+
+TEST(PrepackedWeightsFileCacheTest, SaveAndLoad) {
+  TemporaryDirectory tmp_dir{ORT_TSTR("prepacked_weights_file_cache_test_tmp_dir")};
+  const PathString file_path = tmp_dir.Path() + ORT_TSTR("/weights.bin");
+  auto alloc = std::make_shared<CPUAllocator>();
+
+  {
+    PrepackedWeightsFileCache cache(file_path);
+    ASSERT_STATUS_OK(cache.Load());
+    ASSERT_EQ(cache.GetNumberOfElements(), 0u);
+
+    ASSERT_TRUE(cache.AddWeight("a", MakePrePackedWeights(alloc, 100, 1)));
+    ASSERT_TRUE(cache.AddWeight("b", MakePrePackedWeights(alloc, 7, 200)));
+    ASSERT_FALSE(cache.AddWeight("a", MakePrePackedWeights(alloc, 3, 0)));
+    ASSERT_STATUS_OK(cache.Save());
+  }
+
+  PrepackedWeightsFileCache cache(file_path);
+  ASSERT_STATUS_OK(cache.Load());
+  ASSERT_EQ(cache.GetNumberOfElements(), 2u);
+  ASSERT_EQ(cache.GetWeight("c"), nullptr);
+
+  const PrePackedWeights* a = cache.GetWeight("a");
+  ASSERT_NE(a, nullptr);
+  ASSERT_EQ(a->buffer_sizes_.size(), 1u);
+  ASSERT_EQ(a->buffer_sizes_[0], 100u);
+  auto expected_a = MakePrePackedWeights(alloc, 100, 1);
+  EXPECT_EQ(std::memcmp(a->buffers_[0].get(), expected_a.buffers_[0].get(), 100), 0);
+
+  const PrePackedWeights* b = cache.GetWeight("b");
+  ASSERT_NE(b, nullptr);
+  ASSERT_EQ(b->buffer_sizes_[0], 7u);
+  auto expected_b = MakePrePackedWeights(alloc, 7, 200);
+  EXPECT_EQ(std::memcmp(b->buffers_[0].get(), expected_b.buffers_[0].get(), 7), 0);
+
+  // buffers in the file are aligned so the kernels can use them directly
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(a->buffers_[0].get()) % 64, 0u);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(b->buffers_[0].get()) % 64, 0u);
+}
+
+TEST(PrepackedWeightsFileCacheTest, LoadInvalidFile) {
+  TemporaryDirectory tmp_dir{ORT_TSTR("prepacked_weights_file_cache_test_tmp_dir")};
+  const PathString file_path = tmp_dir.Path() + ORT_TSTR("/weights.bin");
+
+  {
+    std::ofstream out(file_path, std::ofstream::out | std::ofstream::binary);
+    out << "not a pre-packed weights file";
+  }
+
+  PrepackedWeightsFileCache cache(file_path);
+  ASSERT_FALSE(cache.Load().IsOK());
+  ASSERT_EQ(cache.GetNumberOfElements(), 0u);
+
+  // the file gets replaced with a valid one on the next save
+  auto alloc = std::make_shared<CPUAllocator>();
+  ASSERT_TRUE(cache.AddWeight("a", MakePrePackedWeights(alloc, 16, 0)));
+  ASSERT_STATUS_OK(cache.Save());
+
+  PrepackedWeightsFileCache reloaded_cache(file_path);
+  ASSERT_STATUS_OK(reloaded_cache.Load());
+  ASSERT_EQ(reloaded_cache.GetNumberOfElements(), 1u);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
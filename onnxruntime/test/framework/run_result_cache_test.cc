@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/run_result_cache.h"
+
+#include "core/framework/tensor.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+OrtValue CreateFloatTensor(const AllocatorPtr& allocator, const TensorShape& shape, const std::vector<float>& data) {
+  OrtValue value;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), shape, allocator, value);
+  std::copy(data.begin(), data.end(), value.GetMutable<Tensor>()->MutableData<float>());
+  return value;
+}
+
+std::vector<float> TensorData(const OrtValue& value) {
+  auto span = value.Get<Tensor>().DataAsSpan<float>();
+  return std::vector<float>(span.begin(), span.end());
+}
+
+}  // namespace
+
+TEST(RunResultCacheTest, FindReturnsCopiesOfCachedOutputs) {
+  auto allocator = std::make_shared<CPUAllocator>();
+  RunResultCache cache(2, allocator);
+
+  const std::vector<std::string> feed_names{"X"};
+  const std::vector<std::string> output_names{"Y"};
+  std::vector<OrtValue> feeds{CreateFloatTensor(allocator, {2}, {1.f, 2.f})};
+  std::vector<OrtValue> fetches{CreateFloatTensor(allocator, {2}, {3.f, 4.f})};
+
+  std::vector<OrtValue> result;
+  EXPECT_FALSE(cache.Find(feed_names, feeds, output_names, result));
+
+  cache.Insert(feed_names, feeds, output_names, fetches);
+  EXPECT_EQ(cache.Size(), 1u);
+
+  // the cache must not alias the values of the caller
+  feeds[0].GetMutable<Tensor>()->MutableData<float>()[0] = 5.f;
+  fetches[0].GetMutable<Tensor>()->MutableData<float>()[0] = 6.f;
+  EXPECT_FALSE(cache.Find(feed_names, feeds, output_names, result));
+
+  feeds[0].GetMutable<Tensor>()->MutableData<float>()[0] = 1.f;
+  ASSERT_TRUE(cache.Find(feed_names, feeds, output_names, result));
+  ASSERT_EQ(result.size(), 1u);
+  EXPECT_EQ(TensorData(result[0]), (std::vector<float>{3.f, 4.f}));
+
+  result[0].GetMutable<Tensor>()->MutableData<float>()[0] = 7.f;
+  std::vector<OrtValue> second_result;
+  ASSERT_TRUE(cache.Find(feed_names, feeds, output_names, second_result));
+  EXPECT_EQ(TensorData(second_result[0]), (std::vector<float>{3.f, 4.f}));
+
+  // different output names or shapes are different entries
+  const std::vector<std::string> other_output_names{"Z"};
+  std::vector<OrtValue> other_result;
+  EXPECT_FALSE(cache.Find(feed_names, feeds, other_output_names, other_result));
+  std::vector<OrtValue> reshaped_feeds{CreateFloatTensor(allocator, {1, 2}, {1.f, 2.f})};
+  EXPECT_FALSE(cache.Find(feed_names, reshaped_feeds, output_names, other_result));
+}
+
+TEST(RunResultCacheTest, EvictsLeastRecentlyUsedEntry) {
+  auto allocator = std::make_shared<CPUAllocator>();
+  RunResultCache cache(2, allocator);
+
+  const std::vector<std::string> feed_names{"X"};
+  const std::vector<std::string> output_names{"Y"};
+  std::vector<OrtValue> feeds_a{CreateFloatTensor(allocator, {1}, {1.f})};
+  std::vector<OrtValue> feeds_b{CreateFloatTensor(allocator, {1}, {2.f})};
+  std::vector<OrtValue> feeds_c{CreateFloatTensor(allocator, {1}, {3.f})};
+  std::vector<OrtValue> fetches{CreateFloatTensor(allocator, {1}, {0.f})};
+
+  cache.Insert(feed_names, feeds_a, output_names, fetches);
+  cache.Insert(feed_names, feeds_b, output_names, fetches);
+
+  // touch a so b is the least recently used entry
+  std::vector<OrtValue> result;
+  ASSERT_TRUE(cache.Find(feed_names, feeds_a, output_names, result));
+
+  cache.Insert(feed_names, feeds_c, output_names, fetches);
+  EXPECT_EQ(cache.Size(), 2u);
+
+  result.clear();
+  EXPECT_TRUE(cache.Find(feed_names, feeds_a, output_names, result));
+  result.clear();
+  EXPECT_FALSE(cache.Find(feed_names, feeds_b, output_names, result));
+  result.clear();
+  EXPECT_TRUE(cache.Find(feed_names, feeds_c, output_names, result));
+}
+
+TEST(RunResultCacheTest, SkipsPreallocatedFetches) {
+  auto allocator = std::make_shared<CPUAllocator>();
+  RunResultCache cache(1, allocator);
+
+  const std::vector<std::string> feed_names{"X"};
+  const std::vector<std::string> output_names{"Y"};
+  std::vector<OrtValue> feeds{CreateFloatTensor(allocator, {1}, {1.f})};
+  std::vector<OrtValue> fetches{CreateFloatTensor(allocator, {1}, {2.f})};
+  cache.Insert(feed_names, feeds, output_names, fetches);
+
+  std::vector<OrtValue> preallocated{CreateFloatTensor(allocator, {1}, {0.f})};
+  EXPECT_FALSE(cache.Find(feed_names, feeds, output_names, preallocated));
+  EXPECT_EQ(TensorData(preallocated[0]), (std::vector<float>{0.f}));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,124 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/sampled_profiler.h"
+
+#include <sstream>
+
+#include "core/framework/session_state.h"
+#include "core/framework/tensor.h"
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "gtest/gtest.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Y = Neg(Relu(X))
+std::string CreateModel() {
+  Model model("sampled_profiler", false, ModelMetaData(), ORT_TSTR(""), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 13}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &type);
+  auto& relu_out = graph.GetOrCreateNodeArg("relu_out", &type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &type);
+  graph.AddNode("relu", "Relu", "", {&x}, {&relu_out});
+  graph.AddNode("neg", "Neg", "", {&relu_out}, {&y});
+  ORT_THROW_IF_ERROR(graph.Resolve());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+  return model_data;
+}
+
+void InitializeSession(InferenceSession& session) {
+  std::stringstream stream(CreateModel());
+  ASSERT_STATUS_OK(session.Load(stream));
+  ASSERT_STATUS_OK(session.Initialize());
+}
+
+}  // namespace
+
+TEST(SampledProfilerTest, DisabledByDefault) {
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  InitializeSession(session);
+
+  ASSERT_EQ(session.GetSessionState().GetSampledProfiler(), nullptr);
+}
+
+TEST(SampledProfilerTest, SamplesOneInNRuns) {
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSampledProfilingRate, "2"));
+  InferenceSession session{so, GetEnvironment()};
+  InitializeSession(session);
+
+  const auto* profiler = session.GetSessionState().GetSampledProfiler();
+  ASSERT_NE(profiler, nullptr);
+  ASSERT_EQ(profiler->SampleRate(), 2u);
+
+  for (int run = 0; run < 4; ++run) {
+    OrtValue x;
+    Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), TensorShape({3}), std::make_shared<CPUAllocator>(), x);
+    NameMLValMap feeds{{"X", x}};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session.Run(feeds, {"Y"}, &fetches));
+  }
+
+  const std::string text = profiler->ToPrometheusText();
+  EXPECT_NE(text.find("# TYPE onnxruntime_run_latency_seconds histogram\n"), std::string::npos);
+  EXPECT_NE(text.find("onnxruntime_run_latency_seconds_count 2\n"), std::string::npos);
+  EXPECT_NE(text.find("onnxruntime_run_latency_seconds_bucket{le=\"+Inf\"} 2\n"), std::string::npos);
+  EXPECT_NE(text.find("onnxruntime_node_latency_seconds_count{node=\"relu\",op_type=\"Relu\","
+                      "provider=\"CPUExecutionProvider\"} 2\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("onnxruntime_node_latency_seconds_count{node=\"neg\",op_type=\"Neg\","
+                      "provider=\"CPUExecutionProvider\"} 2\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("onnxruntime_sampled_profiler_runs_total 4\n"), std::string::npos);
+}
+
+TEST(SampledProfilerTest, InvalidRate) {
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSampledProfilingRate, "often"));
+  InferenceSession session{so, GetEnvironment()};
+  std::stringstream stream(CreateModel());
+  ASSERT_STATUS_OK(session.Load(stream));
+  ASSERT_STATUS_NOT_OK(session.Initialize());
+}
+
+TEST(SampledProfilerTest, BucketBounds) {
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  InitializeSession(session);
+
+  profiling::SampledProfiler profiler(session.GetSessionState().GetGraphViewer(), 1);
+  // 1us is in the le="1e-06" bucket, 1.5us and 2us are in the le="2e-06" bucket
+  profiler.RecordRun(std::chrono::nanoseconds(1000));
+  profiler.RecordRun(std::chrono::nanoseconds(1500));
+  profiler.RecordRun(std::chrono::nanoseconds(2000));
+  // beyond the last bound
+  profiler.RecordRun(std::chrono::seconds(10));
+
+  const std::string text = profiler.ToPrometheusText();
+  EXPECT_NE(text.find("onnxruntime_run_latency_seconds_bucket{le=\"1e-06\"} 1\n"), std::string::npos);
+  EXPECT_NE(text.find("onnxruntime_run_latency_seconds_bucket{le=\"2e-06\"} 3\n"), std::string::npos);
+  EXPECT_NE(text.find("onnxruntime_run_latency_seconds_bucket{le=\"5\"} 3\n"), std::string::npos);
+  EXPECT_NE(text.find("onnxruntime_run_latency_seconds_bucket{le=\"+Inf\"} 4\n"), std::string::npos);
+  EXPECT_NE(text.find("onnxruntime_run_latency_seconds_count 4\n"), std::string::npos);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
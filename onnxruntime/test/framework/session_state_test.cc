@@ -702,6 +702,89 @@ TEST_F(SessionStateTestSharedInitalizersWithPrePacking, test1) {
   ASSERT_EQ(kernel->store_pre_packed_weight_calls_count, 0);
 }
 
+// Lazy pre-packing = no pre-packing during session state finalization, exactly one pre-pack on first use
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, LazyPrePacking) {
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  sess_options.enable_mem_reuse = true;
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigLazyPrepacking] = "1";
+
+  Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+              DefaultLoggingManager().DefaultLogger());
+
+  CreateSimpleGraph(model.MainGraph());
+  PlaceAllNodesToCPUEP(model.MainGraph());
+  SessionState session_state(model.MainGraph(),
+                             execution_providers,
+                             tp.get(),
+                             nullptr, /*inter_op_thread_pool*/
+                             dtm,
+                             DefaultLoggingManager().DefaultLogger(),
+                             profiler,
+                             sess_options);
+
+  ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                      kernel_registry_manager));
+
+  const auto* kernel = reinterpret_cast<const PrePackingTestOpKernel*>(session_state.GetKernel(0));
+
+  // Nothing is pre-packed up front and the constant initializer is kept
+  ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(0));
+  ASSERT_EQ(kernel->prepack_calls_count, 0);
+  ASSERT_EQ(session_state.GetConstantInitializedTensors().size(), static_cast<size_t>(1));
+
+  // The first use pre-packs, later uses are no-ops
+  ASSERT_STATUS_OK(session_state.EnsureNodePrePacked(0));
+  ASSERT_STATUS_OK(session_state.EnsureNodePrePacked(0));
+  ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(1));
+  ASSERT_EQ(kernel->prepack_calls_count, 1);
+
+  // Prefaulting skips nodes that are already pre-packed
+  std::atomic<bool> stop{false};
+  ASSERT_STATUS_OK(session_state.PrefaultConstantInitializers(stop));
+  ASSERT_EQ(kernel->prepack_calls_count, 1);
+}
+
+// Concurrent initializer loading = same pre-packing result as loading the initializers one after another
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, ConcurrentInitializerLoading) {
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  sess_options.enable_mem_reuse = true;
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigInitializerLoadConcurrency] = "0";
+
+  Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+              DefaultLoggingManager().DefaultLogger());
+
+  CreateSimpleGraph(model.MainGraph());
+  PlaceAllNodesToCPUEP(model.MainGraph());
+  SessionState session_state(model.MainGraph(),
+                             execution_providers,
+                             tp.get(),
+                             nullptr, /*inter_op_thread_pool*/
+                             dtm,
+                             DefaultLoggingManager().DefaultLogger(),
+                             profiler,
+                             sess_options);
+
+  ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                      kernel_registry_manager));
+
+  const auto* kernel = reinterpret_cast<const PrePackingTestOpKernel*>(session_state.GetKernel(0));
+
+  ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(1));
+  ASSERT_EQ(kernel->prepack_calls_count, 1);
+  // the pre-packed initializer is released once all nodes are pre-packed
+  ASSERT_EQ(session_state.GetConstantInitializedTensors().size(), static_cast<size_t>(0));
+}
+
 // Pre-packing enabled + shared initializers + no pre-packed weights container = no pre-packed weights caching
 TEST_F(SessionStateTestSharedInitalizersWithPrePacking, test2) {
   SessionOptions sess_options;
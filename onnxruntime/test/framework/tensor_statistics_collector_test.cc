@@ -0,0 +1,124 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/tensor_statistics_collector.h"
+
+#include <limits>
+#include <sstream>
+
+#include "core/framework/session_state.h"
+#include "core/framework/tensor.h"
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "gtest/gtest.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Y = Neg(Relu(X))
+std::string CreateModel() {
+  Model model("tensor_statistics", false, ModelMetaData(), ORT_TSTR(""), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 13}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &type);
+  auto& relu_out = graph.GetOrCreateNodeArg("relu_out", &type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &type);
+  graph.AddNode("relu", "Relu", "", {&x}, {&relu_out});
+  graph.AddNode("neg", "Neg", "", {&relu_out}, {&y});
+  ORT_THROW_IF_ERROR(graph.Resolve());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+  return model_data;
+}
+
+void InitializeSession(InferenceSession& session) {
+  std::stringstream stream(CreateModel());
+  ASSERT_STATUS_OK(session.Load(stream));
+  ASSERT_STATUS_OK(session.Initialize());
+}
+
+}  // namespace
+
+TEST(TensorStatisticsCollectorTest, DisabledByDefault) {
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  InitializeSession(session);
+
+  ASSERT_EQ(session.GetSessionState().GetTensorStatisticsCollector(), nullptr);
+}
+
+TEST(TensorStatisticsCollectorTest, CollectsDuringRuns) {
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigCollectTensorStatistics, "1"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigTensorStatisticsHistogramBins, "4"));
+  InferenceSession session{so, GetEnvironment()};
+  InitializeSession(session);
+
+  const auto* collector = session.GetSessionState().GetTensorStatisticsCollector();
+  ASSERT_NE(collector, nullptr);
+  ASSERT_EQ(collector->HistogramBinCount(), 4u);
+
+  const std::vector<std::vector<float>> inputs{{-1.0f, 0.5f, 1.5f, 2.0f}, {-3.0f, 0.0f, 1.0f, 3.5f}};
+  for (const auto& input : inputs) {
+    OrtValue x;
+    Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), TensorShape({4}), std::make_shared<CPUAllocator>(), x);
+    std::copy(input.begin(), input.end(), x.GetMutable<Tensor>()->MutableData<float>());
+    NameMLValMap feeds{{"X", x}};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session.Run(feeds, {"Y"}, &fetches));
+  }
+
+  // the first Run sets bins of width 0.5, the second Run doubles them to cover 3.5
+  const std::string json = collector->ToJson();
+  EXPECT_NE(json.find("\"X\":{\"count\":8,\"min\":-3,\"max\":3.5,\"histogram_bin_width\":1,"
+                      "\"histogram\":[2,4,0,2]}"),
+            std::string::npos)
+      << json;
+  EXPECT_NE(json.find("\"relu_out\":{\"count\":8,\"min\":0,\"max\":3.5,\"histogram_bin_width\":1,"
+                      "\"histogram\":[4,3,0,1]}"),
+            std::string::npos)
+      << json;
+  EXPECT_NE(json.find("\"Y\":{\"count\":8,\"min\":-3.5,"), std::string::npos) << json;
+}
+
+TEST(TensorStatisticsCollectorTest, IgnoresNonFiniteValues) {
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  InitializeSession(session);
+
+  TensorStatisticsCollector collector(session.GetSessionState().GetGraphViewer(), 2);
+  const std::vector<float> values{std::numeric_limits<float>::quiet_NaN(), -std::numeric_limits<float>::infinity(),
+                                  0.0f, 0.0f};
+  collector.Record("X", values);
+  collector.Record("not_a_tensor", values);
+
+  // only zeros so far, so the bin width isn't set yet
+  EXPECT_EQ(collector.ToJson(),
+            "{\"X\":{\"count\":2,\"min\":0,\"max\":0,\"histogram_bin_width\":0,\"histogram\":[2,0]}}");
+}
+
+TEST(TensorStatisticsCollectorTest, InvalidHistogramBins) {
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigCollectTensorStatistics, "1"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigTensorStatisticsHistogramBins, "3"));
+  InferenceSession session{so, GetEnvironment()};
+  std::stringstream stream(CreateModel());
+  ASSERT_STATUS_OK(session.Load(stream));
+  ASSERT_STATUS_NOT_OK(session.Initialize());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
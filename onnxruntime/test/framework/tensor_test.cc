@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/tensor.h"
+#include "core/framework/TensorSeq.h"
 #include "test_utils.h"
 
 #include "gmock/gmock.h"
@@ -261,5 +262,23 @@ TEST(TensorTest, Strided) {
 }
 #endif
 
+TEST(TensorTest, TensorSeqAddSharedDoesNotCopy) {
+  auto alloc = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  TensorSeq source(DataTypeImpl::GetType<float>());
+  source.Add(Tensor(DataTypeImpl::GetType<float>(), TensorShape({2, 3}), alloc));
+  source.Add(Tensor(DataTypeImpl::GetType<float>(), TensorShape({4}), alloc));
+
+  TensorSeq target(DataTypeImpl::GetType<float>());
+  target.AddShared(source);
+  ASSERT_EQ(target.Size(), source.Size());
+  for (size_t i = 0; i < source.Size(); ++i) {
+    EXPECT_EQ(target.Get(i).DataRaw(), source.Get(i).DataRaw());
+    EXPECT_EQ(target.Get(i).Shape(), source.Get(i).Shape());
+  }
+
+  TensorSeq other_type(DataTypeImpl::GetType<int64_t>());
+  EXPECT_THROW(other_type.AddShared(source), OnnxRuntimeException);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -7,9 +7,12 @@
 
 #include "core/common/common.h"
 #include "core/framework/tunable.h"
+// The CPU EP provides the TuningContext implementation except in minimal builds.
+#if defined(ORT_MINIMAL_BUILD)
 #define TUNING_CONTEXT_IMPL
 #include "core/framework/tuning_context_impl.h"
 #undef TUNING_CONTEXT_IMPL
+#endif
 
 using namespace std::chrono_literals;
 
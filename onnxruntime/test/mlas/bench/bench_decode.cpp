@@ -0,0 +1,358 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Benchmarks of the kernels of a transformer decode step. Each benchmark reports the achieved memory bandwidth
+// (GB/s) and arithmetic throughput (GFLOP/s). When ORT_MLAS_BENCH_PEAK_GBPS and ORT_MLAS_BENCH_PEAK_GFLOPS are set
+// to the peak of the machine, the fraction of the peak that is reached is reported as well.
+
+#include "mlas.h"
+#include "mlas_q4.h"
+#include "mlas_qnbit.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "bench_util.h"
+#include "core/common/narrow.h"
+#include "core/mlas/lib/mlasi.h"
+#include "core/platform/env_var_utils.h"
+#include "core/util/thread_utils.h"
+
+using onnxruntime::narrow;
+
+namespace {
+
+std::unique_ptr<onnxruntime::concurrency::ThreadPool> CreateBenchThreadPool(size_t Threads) {
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = static_cast<int>(Threads);
+  tpo.auto_set_affinity = true;
+
+  return std::unique_ptr<onnxruntime::concurrency::ThreadPool>(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                                 tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+}
+
+// Reports the bytes moved and the floating point operations done by one iteration as rates.
+void SetRooflineCounters(benchmark::State& state, double Bytes, double Flops) {
+  using onnxruntime::ParseEnvironmentVariableWithDefault;
+
+  static const double PeakGBps = ParseEnvironmentVariableWithDefault<double>("ORT_MLAS_BENCH_PEAK_GBPS", 0.0);
+  static const double PeakGFlops = ParseEnvironmentVariableWithDefault<double>("ORT_MLAS_BENCH_PEAK_GFLOPS", 0.0);
+
+  state.counters["GB/s"] = benchmark::Counter(Bytes * 1e-9, benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["GFLOP/s"] = benchmark::Counter(Flops * 1e-9, benchmark::Counter::kIsIterationInvariantRate);
+
+  if (PeakGBps > 0.0) {
+    state.counters["%PeakBW"] =
+        benchmark::Counter(Bytes * 1e-7 / PeakGBps, benchmark::Counter::kIsIterationInvariantRate);
+  }
+  if (PeakGFlops > 0.0) {
+    state.counters["%PeakFLOP"] =
+        benchmark::Counter(Flops * 1e-7 / PeakGFlops, benchmark::Counter::kIsIterationInvariantRate);
+  }
+}
+
+}  // namespace
+
+//
+// MatMulNBits: 4-bit blockwise quantized B with M = 1..16 rows of A.
+//
+
+void DECODE_SQNBITGEMM(benchmark::State& state) {
+  constexpr size_t BlkBitWidth = 4;
+
+  const auto BlkLen = narrow<size_t>(state.range(0));
+  const auto M = narrow<size_t>(state.range(1));
+  const auto N = narrow<size_t>(state.range(2));
+  const auto K = narrow<size_t>(state.range(3));
+  const auto Threads = narrow<size_t>(state.range(4));
+  const auto ComputeType = static_cast<MLAS_SQNBIT_GEMM_COMPUTE_TYPE>(state.range(5));
+
+  if (!MlasIsSQNBitGemmAvailable(BlkBitWidth, BlkLen, ComputeType)) {
+    state.SkipWithMessage("SQNBitGemm is not available with the given configuration on the current machine.");
+    return;
+  }
+
+  size_t QuantBDataSizeInBytes, QuantBScaleSize, QuantBZeroPointSizeInBytes;
+  MlasBlockwiseQuantizedBufferSizes(
+      BlkBitWidth, static_cast<int>(BlkLen), /* columnwise */ true,
+      static_cast<int>(K), static_cast<int>(N),
+      QuantBDataSizeInBytes, QuantBScaleSize, &QuantBZeroPointSizeInBytes);
+
+  auto tp = CreateBenchThreadPool(Threads);
+
+  const auto A = RandomVectorUniform(M * K, -1.0f, 1.0f);
+  const auto B = RandomVectorUniform(K * N, -1.0f, 1.0f);
+  std::vector<float> C(M * N);
+
+  std::vector<uint8_t> QuantBData(QuantBDataSizeInBytes);
+  std::vector<float> QuantBScale(QuantBScaleSize);
+
+  MlasQuantizeBlockwise<float, BlkBitWidth>(QuantBData.data(), QuantBScale.data(), nullptr,
+                                            B.data(), static_cast<int>(BlkLen), /* columnwise */ true,
+                                            static_cast<int>(K), static_cast<int>(N), static_cast<int>(N),
+                                            tp.get());
+
+  std::unique_ptr<std::byte[]> Workspace;
+  if (const auto WorkspaceSize = MlasSQNBitGemmBatchWorkspaceSize(M, N, K, 1, BlkBitWidth, BlkLen, ComputeType);
+      WorkspaceSize > 0) {
+    Workspace = std::make_unique<std::byte[]>(WorkspaceSize);
+  }
+
+  std::unique_ptr<std::byte[]> PackedQuantBData;
+  if (const auto PackedQuantBDataSize = MlasSQNBitGemmPackQuantBDataSize(N, K, BlkBitWidth, BlkLen, ComputeType);
+      PackedQuantBDataSize > 0) {
+    PackedQuantBData = std::make_unique<std::byte[]>(PackedQuantBDataSize);
+    MlasSQNBitGemmPackQuantBData(N, K, BlkBitWidth, BlkLen, ComputeType, QuantBData.data(), PackedQuantBData.get(),
+                                 tp.get());
+  }
+
+  MLAS_SQNBIT_GEMM_DATA_PARAMS params{};
+  params.A = A.data();
+  params.lda = K;
+  params.QuantBData = PackedQuantBData != nullptr
+                          ? static_cast<const void*>(PackedQuantBData.get())
+                          : static_cast<const void*>(QuantBData.data());
+  params.QuantBScale = QuantBScale.data();
+  params.C = C.data();
+  params.ldc = N;
+
+  // warm up run
+  MlasSQNBitGemmBatch(M, N, K, 1, BlkBitWidth, BlkLen, ComputeType, &params, Workspace.get(), tp.get());
+
+  for (auto _ : state) {
+    MlasSQNBitGemmBatch(M, N, K, 1, BlkBitWidth, BlkLen, ComputeType, &params, Workspace.get(), tp.get());
+  }
+
+  const double Bytes = double(QuantBDataSizeInBytes) + double(QuantBScaleSize) * sizeof(float) +
+                       double(M) * double(K + N) * sizeof(float);
+  SetRooflineCounters(state, Bytes, 2.0 * double(M) * double(N) * double(K));
+}
+
+static void DecodeSQNBitGemmArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"BlkLen", "M", "N", "K", "Threads", "ComputeType"});
+
+  // (N, K) of the attention and MLP projections of common 3B to 8B models.
+  const std::vector<std::pair<int64_t, int64_t>> shapes = {
+      {3072, 3072}, {8192, 3072}, {3072, 8192},
+      {4096, 4096}, {11008, 4096}, {4096, 11008},
+      {6144, 4096}, {14336, 4096}, {4096, 14336},
+  };
+
+  for (int64_t BlkLen : {32, 64, 128}) {
+    for (int64_t M : {1, 2, 4, 8, 16}) {
+      for (const auto& [N, K] : shapes) {
+        for (int64_t Threads : {1, 8}) {
+          for (int64_t ComputeType : {int64_t{CompFp32}, int64_t{CompInt8}}) {
+            b->Args({BlkLen, M, N, K, Threads, ComputeType});
+          }
+        }
+      }
+    }
+  }
+}
+
+BENCHMARK(DECODE_SQNBITGEMM)->Apply(DecodeSQNBitGemmArgs)->UseRealTime();
+
+//
+// Grouped query attention of one new token over a KV cache: per query head, the scores against the keys of its
+// KV head, the softmax of the scores and their product with the values, as in GQAAttentionBase.
+//
+
+void DECODE_GQA(benchmark::State& state) {
+  const auto NumHeads = narrow<size_t>(state.range(0));
+  const auto KvNumHeads = narrow<size_t>(state.range(1));
+  const auto HeadSize = narrow<size_t>(state.range(2));
+  const auto KvLength = narrow<size_t>(state.range(3));
+  const auto Threads = narrow<size_t>(state.range(4));
+
+  if (NumHeads == 0 || KvNumHeads == 0 || NumHeads % KvNumHeads != 0) {
+    throw std::invalid_argument("NumHeads must be a multiple of KvNumHeads!");
+  }
+
+  auto tp = CreateBenchThreadPool(Threads);
+
+  const auto Q = RandomVectorUniform(NumHeads * HeadSize, -1.0f, 1.0f);
+  const auto KCache = RandomVectorUniform(KvNumHeads * KvLength * HeadSize, -1.0f, 1.0f);
+  const auto VCache = RandomVectorUniform(KvNumHeads * KvLength * HeadSize, -1.0f, 1.0f);
+  std::vector<float> Scores(NumHeads * KvLength);
+  std::vector<float> Output(NumHeads * HeadSize);
+
+  const size_t HeadsPerKvHead = NumHeads / KvNumHeads;
+  const float Scale = 1.0f / std::sqrt(float(HeadSize));
+
+  auto RunAttention = [&]() {
+    MlasTrySimpleParallel(tp.get(), static_cast<ptrdiff_t>(NumHeads), [&](ptrdiff_t h) {
+      const size_t KvHead = size_t(h) / HeadsPerKvHead;
+      const float* K = KCache.data() + KvHead * KvLength * HeadSize;
+      const float* V = VCache.data() + KvHead * KvLength * HeadSize;
+      float* S = Scores.data() + size_t(h) * KvLength;
+
+      MlasGemm(CblasNoTrans, CblasTrans, 1, KvLength, HeadSize, Scale, Q.data() + size_t(h) * HeadSize, HeadSize,
+               K, HeadSize, 0.0f, S, KvLength, nullptr);
+      MlasComputeSoftmax(S, S, 1, KvLength, false, nullptr);
+      MlasGemm(CblasNoTrans, CblasNoTrans, 1, HeadSize, KvLength, 1.0f, S, KvLength,
+               V, HeadSize, 0.0f, Output.data() + size_t(h) * HeadSize, HeadSize, nullptr);
+    });
+  };
+
+  // warm up run
+  RunAttention();
+
+  for (auto _ : state) {
+    RunAttention();
+  }
+
+  const double Bytes = 2.0 * double(KvNumHeads) * double(KvLength) * double(HeadSize) * sizeof(float);
+  SetRooflineCounters(state, Bytes, 4.0 * double(NumHeads) * double(KvLength) * double(HeadSize));
+}
+
+BENCHMARK(DECODE_GQA)
+    ->ArgNames({"NumHeads", "KvNumHeads", "HeadSize", "KvLength", "Threads"})
+    ->ArgsProduct({
+        {32},                           // NumHeads
+        {8, 32},                        // KvNumHeads
+        {128},                          // HeadSize
+        {128, 512, 2048, 8192, 32768},  // KvLength
+        {1, 8},                         // Threads
+    })
+    ->UseRealTime();
+
+//
+// Rotary position embedding of the query or key heads of one token.
+//
+
+void DECODE_ROPE(benchmark::State& state) {
+  const auto NumHeads = narrow<size_t>(state.range(0));
+  const auto HeadSize = narrow<size_t>(state.range(1));
+  const bool Interleaved = narrow<bool>(state.range(2));
+
+  auto Data = RandomVectorUniform(NumHeads * HeadSize, -1.0f, 1.0f);
+  const auto Sin = RandomVectorUniform(HeadSize / 2, -1.0f, 1.0f);
+  const auto Cos = RandomVectorUniform(HeadSize / 2, -1.0f, 1.0f);
+
+  auto RunRotaryEmbedding = [&]() {
+    for (size_t n = 0; n < NumHeads; n++) {
+      float* Row = Data.data() + n * HeadSize;
+      MlasRotaryEmbedOneRow(Row, Sin.data(), Cos.data(), HeadSize, Interleaved, Row);
+    }
+  };
+
+  // warm up run
+  RunRotaryEmbedding();
+
+  for (auto _ : state) {
+    RunRotaryEmbedding();
+  }
+
+  const double Bytes = double(NumHeads) * double(HeadSize) * 2 * sizeof(float) + double(HeadSize) * sizeof(float);
+  SetRooflineCounters(state, Bytes, 3.0 * double(NumHeads) * double(HeadSize));
+}
+
+BENCHMARK(DECODE_ROPE)
+    ->ArgNames({"NumHeads", "HeadSize", "Interleaved"})
+    ->ArgsProduct({
+        {8, 32, 40},                      // NumHeads
+        {64, 80, 128},                    // HeadSize
+        {int64_t{false}, int64_t{true}},  // Interleaved
+    })
+    ->UseRealTime();
+
+//
+// RMS normalization of the hidden state of M tokens.
+//
+
+void DECODE_RMSNORM(benchmark::State& state) {
+  const auto M = narrow<size_t>(state.range(0));
+  const auto HiddenSize = narrow<size_t>(state.range(1));
+  const auto Threads = narrow<size_t>(state.range(2));
+
+  auto tp = CreateBenchThreadPool(Threads);
+
+  const auto Input = RandomVectorUniform(M * HiddenSize, -1.0f, 1.0f);
+  const auto Gamma = RandomVectorUniform(HiddenSize, -1.0f, 1.0f);
+  std::vector<float> Output(M * HiddenSize);
+  std::vector<float> Mean(M);
+  std::vector<float> InvStdDev(M);
+
+  MLAS_LAYER_NORM_PARAMS<float> Params;
+  Params.RowCount = M;
+  Params.RowSize = HiddenSize;
+  Params.Input = Input.data();
+  Params.Gamma = Gamma.data();
+  Params.Output = Output.data();
+  Params.Mean = Mean.data();
+  Params.InvStdDev = InvStdDev.data();
+  Params.Epsilon = 1e-6f;
+  Params.Simplified = true;
+
+  // warm up run
+  MlasLayerNormalization(Params, tp.get());
+
+  for (auto _ : state) {
+    MlasLayerNormalization(Params, tp.get());
+  }
+
+  const double Bytes = (2.0 * double(M) + 1.0) * double(HiddenSize) * sizeof(float);
+  SetRooflineCounters(state, Bytes, 4.0 * double(M) * double(HiddenSize));
+}
+
+BENCHMARK(DECODE_RMSNORM)
+    ->ArgNames({"M", "HiddenSize", "Threads"})
+    ->ArgsProduct({
+        {1, 4, 16},          // M
+        {2048, 4096, 8192},  // HiddenSize
+        {1, 8},              // Threads
+    })
+    ->UseRealTime();
+
+//
+// Sampling of the next token: the softmax of the logits over the vocabulary followed by a top-k selection.
+//
+
+void DECODE_SAMPLING(benchmark::State& state) {
+  const auto VocabSize = narrow<size_t>(state.range(0));
+  const auto TopK = narrow<size_t>(state.range(1));
+
+  if (TopK == 0 || TopK > VocabSize) {
+    throw std::invalid_argument("TopK must be in [1, VocabSize]!");
+  }
+
+  const auto Logits = RandomVectorUniform(VocabSize, -10.0f, 10.0f);
+  std::vector<float> Probabilities(VocabSize);
+  std::vector<uint32_t> Indices(VocabSize);
+
+  auto RunSampling = [&]() {
+    MlasComputeSoftmax(Logits.data(), Probabilities.data(), 1, VocabSize, false, nullptr);
+    for (size_t i = 0; i < VocabSize; i++) {
+      Indices[i] = static_cast<uint32_t>(i);
+    }
+    std::nth_element(Indices.begin(), Indices.begin() + (TopK - 1), Indices.end(),
+                     [&](uint32_t a, uint32_t b) { return Probabilities[a] > Probabilities[b]; });
+    benchmark::DoNotOptimize(Indices.data());
+  };
+
+  // warm up run
+  RunSampling();
+
+  for (auto _ : state) {
+    RunSampling();
+  }
+
+  const double Bytes = 2.0 * double(VocabSize) * sizeof(float);
+  SetRooflineCounters(state, Bytes, 4.0 * double(VocabSize));
+}
+
+BENCHMARK(DECODE_SAMPLING)
+    ->ArgNames({"VocabSize", "TopK"})
+    ->ArgsProduct({
+        {32000, 128256, 151936},  // VocabSize
+        {1, 50},                  // TopK
+    })
+    ->UseRealTime();
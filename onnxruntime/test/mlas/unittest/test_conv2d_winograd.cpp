@@ -0,0 +1,171 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <cmath>
+#include <vector>
+
+//
+// Compares the Winograd convolution with a direct convolution. The Winograd
+// algorithm rounds differently, so the results are compared with a tolerance
+// relative to the magnitude of the products.
+//
+template <bool Threaded>
+class MlasConv2DWinogradTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferFilter;
+  MatrixGuardBuffer<float> BufferPackedFilter;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferWorking;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t BatchCount,
+            size_t GroupCount,
+            size_t InputChannels,
+            size_t InputHeight,
+            size_t InputWidth,
+            size_t FilterCount,
+            size_t PaddingTop,
+            size_t PaddingLeft,
+            size_t PaddingBottom,
+            size_t PaddingRight,
+            float Beta) {
+    const size_t OutputHeight = InputHeight + PaddingTop + PaddingBottom - 2;
+    const size_t OutputWidth = InputWidth + PaddingLeft + PaddingRight - 2;
+    const size_t InputSize = InputHeight * InputWidth;
+    const size_t OutputSize = OutputHeight * OutputWidth;
+
+    const size_t InputElements = BatchCount * GroupCount * InputChannels * InputSize;
+    const size_t FilterElements = GroupCount * FilterCount * InputChannels * 9;
+    const size_t OutputElements = BatchCount * GroupCount * FilterCount * OutputSize;
+
+    const float* Input = BufferInput.GetBuffer(InputElements);
+    const float* Filter = BufferFilter.GetBuffer(FilterElements);
+    const float* Bias = BufferBias.GetBuffer(GroupCount * FilterCount);
+    float* Output = BufferOutput.GetBuffer(OutputElements);
+
+    const size_t PackedFilterSize = MlasConvWinogradPackFilterSize(GroupCount, FilterCount, InputChannels);
+    ASSERT_GT(PackedFilterSize, size_t(0));
+
+    float* PackedFilter = BufferPackedFilter.GetBuffer(PackedFilterSize);
+    MlasConvWinogradPackFilter(GroupCount, FilterCount, InputChannels, Filter, PackedFilter);
+
+    std::vector<float> OutputReference(OutputElements);
+    for (size_t i = 0; i < OutputElements; i++) {
+      Output[i] = float(i % 7) - 3.0f;
+    }
+
+    //
+    // Compute the reference output with the existing output scaled by Beta,
+    // the bias and the tolerance from the sum of the absolute products.
+    //
+
+    std::vector<float> Tolerance(OutputElements);
+
+    for (size_t b = 0; b < BatchCount; b++) {
+      for (size_t g = 0; g < GroupCount; g++) {
+        for (size_t f = 0; f < FilterCount; f++) {
+          const float* filter = Filter + (g * FilterCount + f) * InputChannels * 9;
+          const size_t output_offset = ((b * GroupCount + g) * FilterCount + f) * OutputSize;
+
+          for (size_t oh = 0; oh < OutputHeight; oh++) {
+            for (size_t ow = 0; ow < OutputWidth; ow++) {
+              double sum = 0.0;
+              double magnitude = 0.0;
+
+              for (size_t c = 0; c < InputChannels; c++) {
+                const float* input = Input + ((b * GroupCount + g) * InputChannels + c) * InputSize;
+
+                for (size_t ky = 0; ky < 3; ky++) {
+                  const size_t ih = oh + ky - PaddingTop;
+                  for (size_t kx = 0; kx < 3; kx++) {
+                    const size_t iw = ow + kx - PaddingLeft;
+                    if (ih < InputHeight && iw < InputWidth) {
+                      const double product = double(input[ih * InputWidth + iw]) * filter[(c * 3 + ky) * 3 + kx];
+                      sum += product;
+                      magnitude += std::fabs(product);
+                    }
+                  }
+                }
+              }
+
+              const size_t o = output_offset + oh * OutputWidth + ow;
+              OutputReference[o] = float(sum + Beta * Output[o] + Bias[g * FilterCount + f]);
+              Tolerance[o] = float(1e-4 * (magnitude + 1.0));
+            }
+          }
+        }
+      }
+    }
+
+    int64_t InputShape[] = {int64_t(InputHeight), int64_t(InputWidth)};
+    int64_t KernelShape[] = {3, 3};
+    int64_t DilationShape[] = {1, 1};
+    int64_t Padding[] = {int64_t(PaddingTop), int64_t(PaddingLeft), int64_t(PaddingBottom), int64_t(PaddingRight)};
+    int64_t StrideShape[] = {1, 1};
+    int64_t OutputShape[] = {int64_t(OutputHeight), int64_t(OutputWidth)};
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = MlasIdentityActivation;
+
+    MLAS_CONV_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+
+    MlasConvPrepare(&Parameters, 2, BatchCount, GroupCount, InputChannels, InputShape, KernelShape,
+                    DilationShape, Padding, StrideShape, OutputShape, FilterCount, &Activation,
+                    &WorkingBufferSize, Beta, threadpool_, true);
+
+    ASSERT_EQ(Parameters.Algorithm, MlasConvAlgorithmWinograd);
+
+    MlasConv(&Parameters, Input, PackedFilter, Bias, BufferWorking.GetBuffer(WorkingBufferSize),
+             Output, threadpool_);
+
+    for (size_t i = 0; i < OutputElements; i++) {
+      ASSERT_NEAR(Output[i], OutputReference[i], Tolerance[i])
+          << " @" << i << ", B" << BatchCount << "/G" << GroupCount << "/Cpg" << InputChannels
+          << "/Fpg" << FilterCount << "/H" << InputHeight << "/W" << InputWidth
+          << "/Pad" << PaddingTop << "," << PaddingLeft << "," << PaddingBottom << "," << PaddingRight
+          << "/Beta" << Beta;
+    }
+  }
+
+ public:
+  MlasConv2DWinogradTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "Conv2dWinograd_Threaded" : "Conv2dWinograd_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    // Output is a single tile.
+    Test(1, 1, 16, 6, 6, 16, 0, 0, 0, 0, 0.0f);
+
+    // Same padding with partial tiles at the right and bottom edges.
+    Test(1, 1, 16, 8, 8, 16, 1, 1, 1, 1, 0.0f);
+    Test(2, 1, 32, 13, 17, 48, 1, 1, 1, 1, 0.0f);
+    Test(1, 1, 64, 28, 28, 64, 1, 1, 1, 1, 0.0f);
+
+    // Asymmetric padding and groups.
+    Test(1, 1, 20, 7, 9, 17, 2, 0, 1, 3, 0.0f);
+    Test(3, 3, 16, 30, 5, 16, 1, 2, 0, 1, 0.0f);
+
+    // Accumulate into the existing output.
+    Test(1, 2, 16, 11, 6, 24, 0, 0, 0, 0, 0.5f);
+    Test(1, 1, 24, 9, 12, 32, 1, 1, 1, 1, 1.0f);
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasConv2DWinogradTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasConv2DWinogradTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,224 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasFlashAttentionTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferQuery;
+  MatrixGuardBuffer<float> BufferKey;
+  MatrixGuardBuffer<float> BufferValue;
+  MatrixGuardBuffer<float> BufferMask;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t BatchSize, size_t NumHeads, size_t KvNumHeads, size_t S, size_t L, size_t H, size_t Hv,
+            bool UseMask, bool Causal, size_t LocalWindowSize, bool UseValidLengths,
+            size_t QBlockSize, size_t KvBlockSize, size_t SparseBlockSize = 0, size_t OutputPadding = 0) {
+    // the rows of the output are OutputPadding elements apart, as when writing the heads into a wider tensor
+    const size_t OutputRowStride = NumHeads * Hv + OutputPadding;
+    float* Query = BufferQuery.GetBuffer(BatchSize * NumHeads * S * H);
+    float* Key = BufferKey.GetBuffer(BatchSize * KvNumHeads * L * H);
+    float* Value = BufferValue.GetBuffer(BatchSize * KvNumHeads * L * Hv);
+    float* Mask = BufferMask.GetBuffer(BatchSize * S * L);
+    float* Output = BufferOutput.GetBuffer(BatchSize * S * OutputRowStride);
+    float* OutputReference = BufferOutputReference.GetBuffer(BatchSize * S * OutputRowStride);
+
+    std::default_random_engine generator(static_cast<unsigned>(BatchSize * S * L + H));
+    std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+
+    for (size_t i = 0; i < BatchSize * NumHeads * S * H; i++) {
+      Query[i] = distribution(generator);
+    }
+    for (size_t i = 0; i < BatchSize * KvNumHeads * L * H; i++) {
+      Key[i] = distribution(generator);
+    }
+    for (size_t i = 0; i < BatchSize * KvNumHeads * L * Hv; i++) {
+      Value[i] = distribution(generator);
+    }
+    for (size_t i = 0; i < BatchSize * S * L; i++) {
+      Mask[i] = (generator() % 4 == 0) ? -100.0f : 0.0f;
+    }
+
+    std::vector<int32_t> ValidLengths(BatchSize);
+    for (size_t b = 0; b < BatchSize; b++) {
+      ValidLengths[b] = static_cast<int32_t>(1 + generator() % L);
+    }
+
+    // the diagonal and the first block of keys, plus some random blocks
+    std::vector<uint8_t> BlockLayout;
+    if (SparseBlockSize != 0) {
+      const size_t QBlockCount = (S + SparseBlockSize - 1) / SparseBlockSize;
+      const size_t KvBlockCount = (L + SparseBlockSize - 1) / SparseBlockSize;
+      BlockLayout.resize(QBlockCount * KvBlockCount);
+      for (size_t i = 0; i < QBlockCount; i++) {
+        for (size_t j = 0; j < KvBlockCount; j++) {
+          BlockLayout[i * KvBlockCount + j] = (i == j || j == 0 || generator() % 3 == 0) ? 1 : 0;
+        }
+      }
+    }
+
+    MLAS_FLASH_ATTENTION_PARAMS Params;
+    Params.BatchSize = BatchSize;
+    Params.NumHeads = NumHeads;
+    Params.KvNumHeads = KvNumHeads;
+    Params.QSequenceLength = S;
+    Params.KvSequenceLength = L;
+    Params.QkHeadSize = H;
+    Params.VHeadSize = Hv;
+    Params.Scale = 1.0f / std::sqrt(static_cast<float>(H));
+    Params.Query = Query;
+    Params.QueryBatchStride = NumHeads * S * H;
+    Params.QueryHeadStride = S * H;
+    Params.Key = Key;
+    Params.KeyBatchStride = KvNumHeads * L * H;
+    Params.KeyHeadStride = L * H;
+    Params.Value = Value;
+    Params.ValueBatchStride = KvNumHeads * L * Hv;
+    Params.ValueHeadStride = L * Hv;
+    Params.Mask = UseMask ? Mask : nullptr;
+    Params.MaskBatchStride = S * L;
+    Params.KvValidLengths = UseValidLengths ? ValidLengths.data() : nullptr;
+    Params.Causal = Causal;
+    Params.LocalWindowSize = LocalWindowSize;
+    Params.BlockLayout = SparseBlockSize != 0 ? BlockLayout.data() : nullptr;
+    Params.SparseBlockSize = SparseBlockSize;
+    Params.Output = Output;
+    Params.OutputRowStride = OutputPadding != 0 ? OutputRowStride : 0;
+    Params.QBlockSize = QBlockSize;
+    Params.KvBlockSize = KvBlockSize;
+
+    MlasFlashAttention(Params, threadpool_);
+    ReferenceAttention(Params, OutputReference);
+
+    constexpr float AbsoluteTolerance = 1e-5f;
+    constexpr float RelativeTolerance = 1e-4f;
+
+    for (size_t i = 0; i < BatchSize * S * OutputRowStride; i++) {
+      if (i % OutputRowStride >= NumHeads * Hv) {
+        continue;
+      }
+      float diff = std::fabs(Output[i] - OutputReference[i]);
+      ASSERT_TRUE(diff <= AbsoluteTolerance || diff <= std::fabs(OutputReference[i]) * RelativeTolerance)
+          << "B/N/Nkv/S/L/H/Hv " << BatchSize << "/" << NumHeads << "/" << KvNumHeads << "/" << S << "/" << L
+          << "/" << H << "/" << Hv << " mask:" << UseMask << " causal:" << Causal << " window:" << LocalWindowSize
+          << " valid_lengths:" << UseValidLengths << " blocks:" << QBlockSize << "/" << KvBlockSize
+          << " sparse block:" << SparseBlockSize << " output padding:" << OutputPadding
+          << ", got: " << Output[i] << ", expecting: " << OutputReference[i];
+    }
+  }
+
+  void ReferenceAttention(const MLAS_FLASH_ATTENTION_PARAMS& Params, float* Output) {
+    const size_t S = Params.QSequenceLength;
+    const size_t L = Params.KvSequenceLength;
+    const size_t H = Params.QkHeadSize;
+    const size_t Hv = Params.VHeadSize;
+    const size_t OutputRowStride = Params.OutputRowStride != 0 ? Params.OutputRowStride : Params.NumHeads * Hv;
+    std::vector<double> Scores(L);
+
+    for (size_t b = 0; b < Params.BatchSize; b++) {
+      for (size_t n = 0; n < Params.NumHeads; n++) {
+        const size_t kvn = n / (Params.NumHeads / Params.KvNumHeads);
+        const float* Q = Params.Query + b * Params.QueryBatchStride + n * Params.QueryHeadStride;
+        const float* K = Params.Key + b * Params.KeyBatchStride + kvn * Params.KeyHeadStride;
+        const float* V = Params.Value + b * Params.ValueBatchStride + kvn * Params.ValueHeadStride;
+        const size_t ValidLength = Params.KvValidLengths != nullptr ? size_t(Params.KvValidLengths[b]) : L;
+
+        for (size_t i = 0; i < S; i++) {
+          double MaximumValue = std::numeric_limits<double>::lowest();
+          bool Attended = false;
+
+          for (size_t j = 0; j < L; j++) {
+            bool Valid = j < ValidLength;
+            if (Params.Causal) {
+              Valid = Valid && j <= i && (Params.LocalWindowSize == 0 || j + Params.LocalWindowSize >= i);
+            }
+            if (Params.BlockLayout != nullptr) {
+              const size_t KvBlockCount = (L + Params.SparseBlockSize - 1) / Params.SparseBlockSize;
+              Valid = Valid && Params.BlockLayout[(i / Params.SparseBlockSize) * KvBlockCount +
+                                                  j / Params.SparseBlockSize] != 0;
+            }
+            if (!Valid) {
+              Scores[j] = std::numeric_limits<double>::quiet_NaN();
+              continue;
+            }
+
+            double Sum = 0.0;
+            for (size_t h = 0; h < H; h++) {
+              Sum += double(Q[i * H + h]) * double(K[j * H + h]);
+            }
+            Scores[j] = Sum * Params.Scale;
+            if (Params.Mask != nullptr) {
+              Scores[j] += Params.Mask[b * Params.MaskBatchStride + i * L + j];
+            }
+            MaximumValue = (std::max)(MaximumValue, Scores[j]);
+            Attended = true;
+          }
+
+          double Sum = 0.0;
+          for (size_t j = 0; j < L; j++) {
+            Scores[j] = std::isnan(Scores[j]) ? 0.0 : std::exp(Scores[j] - MaximumValue);
+            Sum += Scores[j];
+          }
+
+          float* OutputRow = Output + (b * S + i) * OutputRowStride + n * Hv;
+          for (size_t h = 0; h < Hv; h++) {
+            double Value = 0.0;
+            for (size_t j = 0; j < L; j++) {
+              Value += Scores[j] * V[j * Hv + h];
+            }
+            OutputRow[h] = Attended ? float(Value / Sum) : 0.0f;
+          }
+        }
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "FlashAttention_Threaded" : "FlashAttention_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasFlashAttentionTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    for (size_t S : {1, 5, 33}) {
+      for (size_t L : {1, 7, 64, 100}) {
+        for (size_t blocks : {0, 1}) {
+          const size_t QBlockSize = blocks ? 4 : 0;
+          const size_t KvBlockSize = blocks ? 16 : 0;
+          Test(2, 4, 4, S, L, 16, 16, false, false, 0, false, QBlockSize, KvBlockSize);
+          Test(2, 4, 2, S, L, 8, 6, true, false, 0, true, QBlockSize, KvBlockSize);
+          if (S <= L) {
+            Test(2, 4, 2, S, L, 8, 8, false, true, 0, false, QBlockSize, KvBlockSize);
+            Test(2, 4, 1, S, L, 8, 8, true, true, 3, true, QBlockSize, KvBlockSize);
+          }
+        }
+      }
+    }
+
+    for (size_t SparseBlockSize : {1, 8, 16}) {
+      Test(2, 4, 2, 33, 100, 8, 8, false, false, 0, false, 0, 0, SparseBlockSize);
+      Test(2, 4, 2, 64, 64, 8, 8, true, true, 0, true, 0, 0, SparseBlockSize);
+      Test(1, 2, 2, 50, 50, 16, 16, false, true, 20, false, 0, 0, SparseBlockSize);
+    }
+
+    Test(1, 8, 8, 128, 512, 64, 64, false, true, 0, false, 0, 0);
+    Test(3, 2, 2, 77, 300, 32, 48, true, false, 0, false, 0, 0);
+    Test(2, 1, 1, 33, 33, 16, 16, true, false, 0, false, 0, 0, 0, 48);
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasFlashAttentionTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasFlashAttentionTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
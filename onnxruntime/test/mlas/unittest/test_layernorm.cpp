@@ -0,0 +1,123 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <cmath>
+#include <vector>
+
+//
+// Compares MlasLayerNormalization with a double precision reference.
+//
+template <bool Threaded>
+class MlasLayerNormTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferSkip;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferGamma;
+  MatrixGuardBuffer<float> BufferBeta;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferSkipBiasSum;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t RowCount, size_t RowSize, size_t SkipRowCount, bool UseBias, bool UseBeta, bool Simplified) {
+    const float* Input = BufferInput.GetBuffer(RowCount * RowSize);
+    const float* Skip = SkipRowCount != 0 ? BufferSkip.GetBuffer(SkipRowCount * RowSize) : nullptr;
+    const float* Bias = UseBias ? BufferBias.GetBuffer(RowSize) : nullptr;
+    const float* Gamma = BufferGamma.GetBuffer(RowSize);
+    const float* Beta = UseBeta ? BufferBeta.GetBuffer(RowSize) : nullptr;
+    float* Output = BufferOutput.GetBuffer(RowCount * RowSize);
+    float* SkipBiasSum = BufferSkipBiasSum.GetBuffer(RowCount * RowSize);
+
+    std::vector<float> Mean(RowCount);
+    std::vector<float> InvStdDev(RowCount);
+
+    MLAS_LAYER_NORM_PARAMS<float> Params;
+    Params.RowCount = RowCount;
+    Params.RowSize = RowSize;
+    Params.Input = Input;
+    Params.Skip = Skip;
+    Params.SkipRowCount = SkipRowCount != 0 ? SkipRowCount : 1;
+    Params.Bias = Bias;
+    Params.Gamma = Gamma;
+    Params.Beta = Beta;
+    Params.Output = Output;
+    Params.SkipBiasSum = SkipBiasSum;
+    Params.Mean = Mean.data();
+    Params.InvStdDev = InvStdDev.data();
+    Params.Epsilon = 1e-5f;
+    Params.Simplified = Simplified;
+
+    MlasLayerNormalization(Params, threadpool_);
+
+    std::vector<double> Sum(RowSize);
+
+    for (size_t r = 0; r < RowCount; r++) {
+      double RowSum = 0.0;
+      for (size_t h = 0; h < RowSize; h++) {
+        double Value = Input[r * RowSize + h];
+        if (Skip != nullptr) {
+          Value += Skip[(r % SkipRowCount) * RowSize + h];
+        }
+        if (Bias != nullptr) {
+          Value += Bias[h];
+        }
+        Sum[h] = Value;
+        RowSum += Value;
+      }
+
+      const double RowMean = Simplified ? 0.0 : RowSum / RowSize;
+      double RowVariance = 0.0;
+      for (size_t h = 0; h < RowSize; h++) {
+        RowVariance += (Sum[h] - RowMean) * (Sum[h] - RowMean);
+      }
+      const double RowInvStdDev = 1.0 / std::sqrt(RowVariance / RowSize + 1e-5);
+
+      ASSERT_NEAR(Mean[r], RowMean, 1e-4 * (1.0 + std::fabs(RowMean))) << " row " << r << ", N" << RowSize;
+      ASSERT_NEAR(InvStdDev[r], RowInvStdDev, 1e-4 * RowInvStdDev) << " row " << r << ", N" << RowSize;
+
+      for (size_t h = 0; h < RowSize; h++) {
+        double Expected = (Sum[h] - RowMean) * RowInvStdDev * Gamma[h];
+        if (Beta != nullptr && !Simplified) {
+          Expected += Beta[h];
+        }
+
+        ASSERT_NEAR(SkipBiasSum[r * RowSize + h], Sum[h], 1e-5 * (1.0 + std::fabs(Sum[h])))
+            << " @" << r << "," << h << ", N" << RowSize;
+        ASSERT_NEAR(Output[r * RowSize + h], Expected, 1e-4 * (1.0 + std::fabs(Expected)))
+            << " @" << r << "," << h << ", N" << RowSize << ", Simplified " << Simplified;
+      }
+    }
+  }
+
+ public:
+  MlasLayerNormTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "LayerNorm_Threaded" : "LayerNorm_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t RowSize : {1, 7, 16, 33, 100, 768, 1027}) {
+      for (bool Simplified : {false, true}) {
+        Test(3, RowSize, 0, false, false, Simplified);
+        Test(5, RowSize, 5, true, true, Simplified);
+        Test(40, RowSize, 8, false, true, Simplified);
+        Test(17, RowSize, 1, true, false, Simplified);
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasLayerNormTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
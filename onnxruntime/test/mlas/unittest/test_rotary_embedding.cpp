@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <cmath>
+#include <vector>
+
+//
+// Compares MlasRotaryEmbedOneRow with a scalar reference.
+//
+class MlasRotaryEmbeddingTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferSin;
+  MatrixGuardBuffer<float> BufferCos;
+  MatrixGuardBuffer<float> BufferOutput;
+
+  void Test(size_t RotaryEmbeddingDim, bool Interleaved, bool InPlace) {
+    const size_t HalfDim = RotaryEmbeddingDim / 2;
+    float* Input = BufferInput.GetBuffer(RotaryEmbeddingDim);
+    float* Sin = BufferSin.GetBuffer(HalfDim);
+    float* Cos = BufferCos.GetBuffer(HalfDim);
+    float* Output = InPlace ? Input : BufferOutput.GetBuffer(RotaryEmbeddingDim);
+
+    for (size_t i = 0; i < HalfDim; i++) {
+      const float Angle = 0.37f * float(i + 1);
+      Sin[i] = std::sin(Angle);
+      Cos[i] = std::cos(Angle);
+    }
+
+    std::vector<float> Expected(RotaryEmbeddingDim);
+    for (size_t i = 0; i < HalfDim; i++) {
+      const size_t i0 = Interleaved ? i * 2 : i;
+      const size_t i1 = Interleaved ? i * 2 + 1 : i + HalfDim;
+      Expected[i0] = Input[i0] * Cos[i] - Input[i1] * Sin[i];
+      Expected[i1] = Input[i1] * Cos[i] + Input[i0] * Sin[i];
+    }
+
+    MlasRotaryEmbedOneRow(Input, Sin, Cos, RotaryEmbeddingDim, Interleaved, Output);
+
+    for (size_t i = 0; i < RotaryEmbeddingDim; i++) {
+      ASSERT_NEAR(Output[i], Expected[i], 1e-5f * (1.0f + std::fabs(Expected[i])))
+          << " @" << i << ", Dim " << RotaryEmbeddingDim << ", Interleaved " << Interleaved;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("RotaryEmbedding");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t RotaryEmbeddingDim : {2, 6, 8, 16, 30, 32, 34, 64, 66, 96, 128, 130}) {
+      for (bool Interleaved : {false, true}) {
+        Test(RotaryEmbeddingDim, Interleaved, false);
+        Test(RotaryEmbeddingDim, Interleaved, true);
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasRotaryEmbeddingTest>::RegisterShortExecute();
+  }
+  return count;
+});
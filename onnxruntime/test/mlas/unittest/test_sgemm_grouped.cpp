@@ -0,0 +1,127 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <array>
+#include <vector>
+
+//
+// Compares the grouped SGEMM with a single threaded SGEMM of each group. Each
+// element of the output does not depend on the partition of the operation,
+// so the results must match exactly.
+//
+template <bool Threaded>
+class MlasSgemmGroupedTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(CBLAS_TRANSPOSE TransA, CBLAS_TRANSPOSE TransB, const std::vector<std::array<size_t, 3>>& Shapes, float alpha, float beta) {
+    size_t SizeA = 0;
+    size_t SizeB = 0;
+    size_t SizeC = 0;
+
+    for (const auto& shape : Shapes) {
+      SizeA += shape[0] * shape[2];
+      SizeB += shape[2] * shape[1];
+      SizeC += shape[0] * shape[1];
+    }
+
+    const float* A = BufferA.GetBuffer(SizeA);
+    const float* B = BufferB.GetBuffer(SizeB);
+    float* C = BufferC.GetBuffer(SizeC);
+    float* CReference = BufferCReference.GetBuffer(SizeC);
+
+    std::fill_n(C, SizeC, -0.5f);
+    std::fill_n(CReference, SizeC, -0.5f);
+
+    std::vector<MLAS_SGEMM_GROUP_PARAMS> Groups(Shapes.size());
+
+    for (size_t g = 0, OffsetA = 0, OffsetB = 0, OffsetC = 0; g < Shapes.size(); g++) {
+      const size_t M = Shapes[g][0];
+      const size_t N = Shapes[g][1];
+      const size_t K = Shapes[g][2];
+
+      auto& group = Groups[g];
+      group.M = M;
+      group.N = N;
+      group.K = K;
+      group.Data.A = A + OffsetA;
+      group.Data.lda = (TransA == CblasNoTrans) ? K : M;
+      group.Data.B = B + OffsetB;
+      group.Data.ldb = (TransB == CblasNoTrans) ? N : K;
+      group.Data.C = C + OffsetC;
+      group.Data.ldc = N;
+      group.Data.alpha = alpha;
+      group.Data.beta = beta;
+
+      MLAS_SGEMM_DATA_PARAMS ReferenceData = group.Data;
+      ReferenceData.C = CReference + OffsetC;
+      MlasGemm(TransA, TransB, M, N, K, ReferenceData, nullptr);
+
+      OffsetA += M * K;
+      OffsetB += K * N;
+      OffsetC += M * N;
+    }
+
+    MlasGemmGrouped(TransA, TransB, Groups.data(), Groups.size(), threadpool_);
+
+    for (size_t f = 0; f < SizeC; f++) {
+      ASSERT_EQ(C[f], CReference[f]) << " Diff @" << f << ", " << Shapes.size() << " groups, "
+                                     << (TransA == CblasTrans ? "TransA" : "A") << "/"
+                                     << (TransB == CblasTrans ? "TransB" : "B") << "/"
+                                     << "Alpha" << alpha << "/"
+                                     << "Beta" << beta;
+    }
+  }
+
+ public:
+  MlasSgemmGroupedTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("SgemmGrouped") + (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    // Groups of the same shape, like the experts of a balanced layer.
+    Test(CblasNoTrans, CblasNoTrans, {{16, 64, 32}, {16, 64, 32}, {16, 64, 32}, {16, 64, 32}}, 1.0f, 0.0f);
+
+    // Skewed token counts, including experts with no routed tokens.
+    Test(CblasNoTrans, CblasNoTrans, {{1, 96, 64}, {0, 96, 64}, {37, 96, 64}, {200, 96, 64}, {3, 96, 64}, {0, 96, 64}}, 1.0f, 0.0f);
+    Test(CblasNoTrans, CblasTrans, {{0, 48, 40}, {5, 48, 40}, {130, 48, 40}, {0, 48, 40}}, 1.0f, 0.0f);
+
+    // Groups of different shapes, wide and tall.
+    Test(CblasNoTrans, CblasNoTrans, {{7, 300, 17}, {260, 3, 33}, {64, 64, 1}, {1, 1, 1}}, 0.5f, 0.0f);
+    Test(CblasTrans, CblasNoTrans, {{9, 160, 24}, {100, 20, 48}}, 1.0f, -1.0f);
+    Test(CblasTrans, CblasTrans, {{33, 33, 33}, {2, 129, 65}, {129, 2, 65}}, -0.25f, 0.5f);
+
+    // A group with no inner dimension only scales C.
+    Test(CblasNoTrans, CblasNoTrans, {{12, 20, 0}, {12, 20, 8}}, 1.0f, 0.5f);
+
+    // Many small groups.
+    std::vector<std::array<size_t, 3>> shapes;
+    for (size_t g = 0; g < 64; g++) {
+      shapes.push_back({(g * 7) % 23, 32, 48});
+    }
+    Test(CblasNoTrans, CblasNoTrans, shapes, 1.0f, 0.0f);
+
+    // No groups at all.
+    MlasGemmGrouped(CblasNoTrans, CblasNoTrans, nullptr, 0, threadpool_);
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSgemmGroupedTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSgemmGroupedTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <cmath>
+#include <vector>
+
+//
+// Compares MlasSparse24Gemm with a double precision reference for a B with 2:4 sparsity.
+//
+template <bool Threaded>
+class MlasSparse24GemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t M, size_t N, size_t K, bool TransA, bool TransB, float alpha) {
+    const float* A = BufferA.GetBuffer(M * K);
+    float* B = BufferB.GetBuffer(N * K);
+    float* C = BufferC.GetBuffer(M * N);
+    uint8_t* PackedB = BufferPackedB.GetBuffer(MlasSparse24GemmPackBSize(N, K));
+
+    const size_t lda = TransA ? M : K;
+    const size_t ldb = TransB ? K : N;
+
+    // keep two of each group of four elements, at positions that differ between the columns
+    for (size_t n = 0; n < N; n++) {
+      for (size_t k = 0; k < K; k++) {
+        float& b = TransB ? B[n * ldb + k] : B[k * ldb + n];
+        if ((k % 4) != (n % 4) && (k % 4) != ((n + 1 + n / 4) % 4)) {
+          b = 0.0f;
+        }
+      }
+    }
+
+    ASSERT_TRUE(MlasSparse24GemmPackB(TransB ? CblasTrans : CblasNoTrans, N, K, B, ldb, PackedB))
+        << " M" << M << " N" << N << " K" << K;
+
+    MlasSparse24Gemm(TransA ? CblasTrans : CblasNoTrans, M, N, K, alpha, A, lda, PackedB, C, N, threadpool_);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double Expected = 0.0;
+        for (size_t k = 0; k < K; k++) {
+          const double a = TransA ? A[k * lda + m] : A[m * lda + k];
+          const double b = TransB ? B[n * ldb + k] : B[k * ldb + n];
+          Expected += a * b;
+        }
+        Expected *= alpha;
+
+        ASSERT_NEAR(C[m * N + n], Expected, 1e-4 * (1.0 + std::fabs(Expected)))
+            << " @" << m << "," << n << ", M" << M << " N" << N << " K" << K
+            << " TransA " << TransA << " TransB " << TransB;
+      }
+    }
+  }
+
+  void TestDenseRejected(size_t N, size_t K) {
+    float* B = BufferB.GetBuffer(N * K);
+    uint8_t* PackedB = BufferPackedB.GetBuffer(MlasSparse24GemmPackBSize(N, K));
+
+    for (size_t i = 0; i < N * K; i++) {
+      B[i] = 1.0f;
+    }
+
+    ASSERT_FALSE(MlasSparse24GemmPackB(CblasNoTrans, N, K, B, N, PackedB)) << " N" << N << " K" << K;
+  }
+
+ public:
+  MlasSparse24GemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "Sparse24Gemm_Threaded" : "Sparse24Gemm_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t M : {1, 3, 8, 19}) {
+      for (size_t N : {1, 7, 64, 130}) {
+        for (size_t K : {1, 3, 4, 17, 64}) {
+          for (bool TransA : {false, true}) {
+            for (bool TransB : {false, true}) {
+              Test(M, N, K, TransA, TransB, 1.0f);
+            }
+          }
+        }
+      }
+    }
+
+    Test(33, 96, 256, false, false, 0.5f);
+    Test(4, 1024, 768, false, true, 1.0f);
+
+    TestDenseRejected(8, 4);
+    TestDenseRejected(3, 7);
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSparse24GemmTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSparse24GemmTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
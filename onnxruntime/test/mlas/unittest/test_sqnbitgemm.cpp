@@ -14,6 +14,8 @@ Abstract:
 
 --*/
 
+#include <cstring>
+
 #include "test_util.h"
 #include "mlas_q4.h"
 #include "mlas_qnbit.h"
@@ -24,6 +26,8 @@ static constexpr const char* ComputeTypeName(MLAS_SQNBIT_GEMM_COMPUTE_TYPE Compu
       return "Fp32";
     case CompInt8:
       return "Int8";
+    case CompBf16:
+      return "Bf16";
     default:
       return "unknown";
   }
@@ -194,6 +198,47 @@ class MlasSQNBitGemmTest : public MlasTestBase {
     }
   }
 
+  static float RoundToBf16(float f) {
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    bits += 0x7FFF + ((bits >> 16) & 1);  // round to nearest even
+    bits &= 0xFFFF0000;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+  }
+
+  void CallReferenceGemm_CompBf16(size_t M,
+                                  size_t N,
+                                  size_t K,
+                                  const float* A,
+                                  const uint8_t* QuantBData,
+                                  const float* QuantBScale,
+                                  const uint8_t* QuantBZeroPoint,
+                                  const float* Bias,
+                                  float* C) {
+    float* DequantizedBData = BufferDequantizedB.GetBuffer(K * N);
+    MlasDequantizeBlockwise<float, BlkBitWidth>(
+        DequantizedBData, QuantBData, QuantBScale, QuantBZeroPoint, BlkLen, /* columnwise */ true,
+        static_cast<int>(K), static_cast<int>(N), GetMlasThreadPool());
+    // Note: DequantizedBData is in column major layout.
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        const float* a = A + m * K;
+        const float* b = DequantizedBData + n * K;
+        float* c = C + (m * N) + n;
+
+        float sum = Bias == nullptr ? 0.0f : Bias[n];
+        for (size_t k = 0; k < K; k++) {
+          sum += RoundToBf16(*a) * RoundToBf16(*b);
+          b += 1;
+          a += 1;
+        }
+        *c = sum;
+      }
+    }
+  }
+
  public:
   void Test(size_t M, size_t N, size_t K,
             MLAS_SQNBIT_GEMM_COMPUTE_TYPE ComputeType,
@@ -270,6 +315,8 @@ class MlasSQNBitGemmTest : public MlasTestBase {
       CallReferenceGemm_CompFp32(M, N, K, A, QuantBData, QuantBScale, QuantBZeroPoint, Bias, CReference);
     } else if (ComputeType == CompInt8) {
       CallReferenceGemm_CompInt8(M, N, K, A, QuantBData, QuantBScale, QuantBZeroPoint, Bias, CReference);
+    } else if (ComputeType == CompBf16) {
+      CallReferenceGemm_CompBf16(M, N, K, A, QuantBData, QuantBScale, QuantBZeroPoint, Bias, CReference);
     } else {
       FAIL() << "Test is not implemented for compute type "
              << ComputeType << " (" << ComputeTypeName(ComputeType) << ")";
@@ -362,7 +409,7 @@ class SQNBitGemmShortExecuteTest : public MlasTestFixture<MlasSQNBitGemmTest<Blk
   static size_t RegisterShortExecuteTests() {
     size_t tests_registered = 0;
 
-    for (MLAS_SQNBIT_GEMM_COMPUTE_TYPE ComputeType : {CompFp32, CompInt8}) {
+    for (MLAS_SQNBIT_GEMM_COMPUTE_TYPE ComputeType : {CompFp32, CompInt8, CompBf16}) {
       for (bool WithThreadpool : {false, true}) {
         for (bool Symmetric : {false, true}) {
           for (size_t b = 1; b < 16; b++) {
@@ -21,6 +21,8 @@
 #include <iostream>
 #include <unordered_map>
 
+#include "op_configs.h"
+
 const OrtApi* g_ort = OrtGetApiBase()->GetApi(ORT_API_VERSION);
 OrtEnv* env = nullptr;
 
@@ -79,7 +81,8 @@ int main(int argc, char** argv) {
   if (::benchmark::ReportUnrecognizedArguments(argc, argv))
     return -1;
   ORT_ABORT_ON_ERROR(g_ort->CreateEnv(ORT_LOGGING_LEVEL_ERROR, "test", &env));
-  ::benchmark::RunSpecifiedBenchmarks();
+  RegisterOpConfigBenchmarks();
+  int result = RunBenchmarksWithBaseline();
   g_ort->ReleaseEnv(env);
-  return 0;
+  return result;
 }
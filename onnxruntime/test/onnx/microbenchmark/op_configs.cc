@@ -0,0 +1,491 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "op_configs.h"
+
+#include <benchmark/benchmark.h>
+#include <core/framework/tensor_shape.h>
+#include <core/framework/tensorprotoutils.h>
+#include <core/graph/model.h>
+#include <core/platform/env.h>
+#include <core/session/onnxruntime_cxx_api.h>
+#include <core/session/ort_env.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+using namespace onnxruntime;
+
+namespace {
+
+// Value used for symbolic dimensions such as the batch size. Using the same value for all of them keeps dimensions
+// that must match (e.g. the sequence length of two inputs) consistent.
+constexpr int64_t kSymbolicDimValue = 1;
+
+// Initializers of these types carry values that drive the op (shapes, axes, indices...) rather than weights, so their
+// content is part of the node configuration.
+bool IsValueInitializer(int32_t data_type) {
+  return data_type != ONNX_NAMESPACE::TensorProto_DataType_FLOAT &&
+         data_type != ONNX_NAMESPACE::TensorProto_DataType_FLOAT16 &&
+         data_type != ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16 &&
+         data_type != ONNX_NAMESPACE::TensorProto_DataType_DOUBLE;
+}
+
+size_t ElementSize(int32_t data_type) {
+  switch (data_type) {
+    case ONNX_NAMESPACE::TensorProto_DataType_BOOL:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT8:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT8:
+      return 1;
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT16:
+      return 2;
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT32:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT32:
+      return 4;
+    case ONNX_NAMESPACE::TensorProto_DataType_DOUBLE:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT64:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT64:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+// Fills `data` with values in [-1, 1) for floating point types, and zeros otherwise so that integer inputs are valid
+// indices.
+void FillRandom(int32_t data_type, size_t num_elements, std::mt19937& rng, std::vector<uint8_t>& data) {
+  data.assign(num_elements * ElementSize(data_type), 0);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  switch (data_type) {
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT: {
+      auto* p = reinterpret_cast<float*>(data.data());
+      for (size_t i = 0; i < num_elements; ++i) p[i] = dist(rng);
+      break;
+    }
+    case ONNX_NAMESPACE::TensorProto_DataType_DOUBLE: {
+      auto* p = reinterpret_cast<double*>(data.data());
+      for (size_t i = 0; i < num_elements; ++i) p[i] = dist(rng);
+      break;
+    }
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT16: {
+      auto* p = reinterpret_cast<Ort::Float16_t*>(data.data());
+      for (size_t i = 0; i < num_elements; ++i) p[i] = Ort::Float16_t(dist(rng));
+      break;
+    }
+    case ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16: {
+      auto* p = reinterpret_cast<Ort::BFloat16_t*>(data.data());
+      for (size_t i = 0; i < num_elements; ++i) p[i] = Ort::BFloat16_t(dist(rng));
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+uint64_t Fnv1a(const std::string& str) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : str) {
+    hash = (hash ^ c) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+struct InputSpec {
+  std::string name;
+  int32_t data_type;
+  std::vector<int64_t> shape;
+};
+
+// A single node model and the inputs to feed it.
+struct OpConfig {
+  std::string model;
+  std::vector<InputSpec> inputs;
+  std::vector<std::string> outputs;
+};
+
+std::string ShapeToString(int32_t data_type, const std::vector<int64_t>& shape) {
+  std::ostringstream ss;
+  ss << ONNX_NAMESPACE::TensorProto_DataType_Name(data_type) << "[";
+  for (size_t i = 0; i < shape.size(); ++i) {
+    ss << (i > 0 ? "x" : "") << shape[i];
+  }
+  ss << "]";
+  return ss.str();
+}
+
+// Reads the static shape of a graph value, substituting symbolic dimensions. Returns false if the rank or any
+// dimension is unknown.
+bool GetStaticShape(const NodeArg& arg, std::vector<int64_t>& shape) {
+  const auto* shape_proto = arg.Shape();
+  if (shape_proto == nullptr) {
+    return false;
+  }
+
+  shape.clear();
+  for (const auto& dim : shape_proto->dim()) {
+    if (utils::HasDimValue(dim)) {
+      shape.push_back(dim.dim_value());
+    } else if (utils::HasDimParam(dim)) {
+      shape.push_back(kSymbolicDimValue);
+    } else {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Builds a single node model from `node`. Constant initializers stay initializers, so kernels that pre-pack their
+// weights run the same code path as in the source model; the other inputs become graph inputs.
+// Returns false if the node cannot run in isolation. `key` identifies the configuration and `label` describes it.
+bool CreateOpConfig(const Graph& graph, const Node& node, OpConfig& config, std::string& key, std::string& label) {
+  if (node.ContainsSubgraph()) {
+    return false;
+  }
+
+  ONNX_NAMESPACE::ModelProto model;
+  model.set_ir_version(ONNX_NAMESPACE::IR_VERSION);
+  for (const auto& [domain, version] : graph.DomainToVersionMap()) {
+    auto* opset = model.add_opset_import();
+    opset->set_domain(domain);
+    opset->set_version(version);
+  }
+
+  auto& graph_proto = *model.mutable_graph();
+  graph_proto.set_name("op_config");
+  auto& node_proto = *graph_proto.add_node();
+  node.ToProto(node_proto);
+  node_proto.clear_name();
+  node_proto.clear_input();
+  node_proto.clear_output();
+  node_proto.clear_doc_string();
+
+  std::ostringstream key_stream;
+  std::ostringstream label_stream;
+  std::mt19937 rng(0);
+  bool has_graph_input = false;
+
+  const auto input_defs = node.InputDefs();
+  for (size_t i = 0; i < input_defs.size(); ++i) {
+    const NodeArg& arg = *input_defs[i];
+    if (!arg.Exists()) {
+      node_proto.add_input("");
+      key_stream << "|";
+      continue;
+    }
+
+    const std::string name = "input_" + std::to_string(i);
+    node_proto.add_input(name);
+
+    const auto* initializer = graph.GetConstantInitializer(arg.Name(), false);
+    if (initializer != nullptr) {
+      auto& tensor = *graph_proto.add_initializer();
+      tensor = *initializer;
+      tensor.set_name(name);
+      tensor.clear_doc_string();
+
+      if (utils::HasExternalData(tensor)) {
+        // the external file is not available to the single node model. weights can be replaced with random values.
+        const size_t element_size = ElementSize(tensor.data_type());
+        if (IsValueInitializer(tensor.data_type()) || element_size == 0) {
+          return false;
+        }
+
+        const std::vector<int64_t> dims(tensor.dims().begin(), tensor.dims().end());
+        tensor.clear_external_data();
+        tensor.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_DEFAULT);
+        std::vector<uint8_t> data;
+        FillRandom(tensor.data_type(), static_cast<size_t>(TensorShape(dims).Size()), rng, data);
+        tensor.set_raw_data(data.data(), data.size());
+      }
+
+      const std::vector<int64_t> dims(tensor.dims().begin(), tensor.dims().end());
+      key_stream << "|c" << ShapeToString(tensor.data_type(), dims);
+      if (IsValueInitializer(tensor.data_type())) {
+        std::string content;
+        tensor.SerializeToString(&content);
+        key_stream << ":" << Fnv1a(content);
+      }
+
+      label_stream << (i > 0 ? "," : "") << "c" << ShapeToString(tensor.data_type(), dims);
+      continue;
+    }
+
+    const auto* type = arg.TypeAsProto();
+    std::vector<int64_t> shape;
+    if (type == nullptr || !type->has_tensor_type() || ElementSize(type->tensor_type().elem_type()) == 0 ||
+        !GetStaticShape(arg, shape)) {
+      return false;
+    }
+
+    const int32_t data_type = type->tensor_type().elem_type();
+    auto& value_info = *graph_proto.add_input();
+    value_info.set_name(name);
+    auto& tensor_type = *value_info.mutable_type()->mutable_tensor_type();
+    tensor_type.set_elem_type(data_type);
+    for (int64_t dim : shape) {
+      tensor_type.mutable_shape()->add_dim()->set_dim_value(dim);
+    }
+
+    config.inputs.push_back({name, data_type, shape});
+    has_graph_input = true;
+    key_stream << "|" << ShapeToString(data_type, shape);
+    label_stream << (i > 0 ? "," : "") << ShapeToString(data_type, shape);
+  }
+
+  // a node with only constant inputs would be constant folded.
+  if (!has_graph_input) {
+    return false;
+  }
+
+  const auto output_defs = node.OutputDefs();
+  for (size_t i = 0; i < output_defs.size(); ++i) {
+    const NodeArg& arg = *output_defs[i];
+    if (!arg.Exists()) {
+      node_proto.add_output("");
+      continue;
+    }
+
+    const auto* type = arg.TypeAsProto();
+    if (type == nullptr || !type->has_tensor_type()) {
+      return false;
+    }
+
+    const std::string name = "output_" + std::to_string(i);
+    node_proto.add_output(name);
+    auto& value_info = *graph_proto.add_output();
+    value_info.set_name(name);
+    value_info.mutable_type()->mutable_tensor_type()->set_elem_type(type->tensor_type().elem_type());
+    config.outputs.push_back(name);
+  }
+
+  // the node proto without names identifies the op, domain and attributes.
+  std::string node_content;
+  node_proto.SerializeToString(&node_content);
+  key = node.Domain() + ":" + std::to_string(graph.DomainToVersionMap().at(node.Domain())) + ":" + node_content +
+        key_stream.str();
+  label = label_stream.str();
+
+  model.SerializeToString(&config.model);
+  return true;
+}
+
+void RunOpConfig(benchmark::State& state, const OpConfig& config) {
+  Ort::SessionOptions session_options;
+  // a single thread keeps the results comparable between machines with different core counts.
+  session_options.SetIntraOpNumThreads(1);
+
+  OrtSession* session = nullptr;
+  OrtStatus* status = g_ort->CreateSessionFromArray(env, config.model.data(), config.model.size(), session_options,
+                                                    &session);
+  if (status != nullptr) {
+    state.SkipWithError(g_ort->GetErrorMessage(status));
+    g_ort->ReleaseStatus(status);
+    return;
+  }
+
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  std::mt19937 rng(0);
+  std::vector<std::vector<uint8_t>> buffers(config.inputs.size());
+  std::vector<Ort::Value> input_values;
+  std::vector<const char*> input_names;
+  for (size_t i = 0; i < config.inputs.size(); ++i) {
+    const auto& input = config.inputs[i];
+    const size_t num_elements = static_cast<size_t>(TensorShape(input.shape).Size());
+    FillRandom(input.data_type, num_elements, rng, buffers[i]);
+    input_values.push_back(Ort::Value::CreateTensor(memory_info, buffers[i].data(), buffers[i].size(),
+                                                    input.shape.data(), input.shape.size(),
+                                                    static_cast<ONNXTensorElementDataType>(input.data_type)));
+    input_names.push_back(input.name.c_str());
+  }
+
+  std::vector<const char*> output_names;
+  for (const auto& output : config.outputs) {
+    output_names.push_back(output.c_str());
+  }
+
+  static_assert(sizeof(Ort::Value) == sizeof(OrtValue*), "Ort::Value must be usable as an OrtValue* array");
+  std::vector<OrtValue*> outputs(output_names.size(), nullptr);
+  for (auto _ : state) {
+    status = g_ort->Run(session, nullptr, input_names.data(),
+                        reinterpret_cast<const OrtValue* const*>(input_values.data()), input_values.size(),
+                        output_names.data(), output_names.size(), outputs.data());
+    if (status != nullptr) {
+      state.SkipWithError(g_ort->GetErrorMessage(status));
+      g_ort->ReleaseStatus(status);
+      break;
+    }
+
+    for (auto*& output : outputs) {
+      g_ort->ReleaseValue(output);
+      output = nullptr;
+    }
+  }
+
+  g_ort->ReleaseSession(session);
+}
+
+// Records the time per iteration of each benchmark while reporting to the console as usual.
+class BaselineReporter : public benchmark::ConsoleReporter {
+ public:
+  void ReportRuns(const std::vector<Run>& reports) override {
+    for (const auto& run : reports) {
+      if (run.run_type == Run::RT_Iteration && run.iterations > 0) {
+        times_ns_[run.benchmark_name()] = run.real_accumulated_time * 1e9 / static_cast<double>(run.iterations);
+      }
+    }
+
+    ConsoleReporter::ReportRuns(reports);
+  }
+
+  const std::map<std::string, double>& TimesNs() const { return times_ns_; }
+
+ private:
+  std::map<std::string, double> times_ns_;
+};
+
+// Baseline files have one "<benchmark name>\t<ns per iteration>" line per benchmark.
+bool ReadBaseline(const std::string& path, std::map<std::string, double>& times_ns) {
+  std::ifstream in(path);
+  if (!in) {
+    return false;
+  }
+
+  std::string line;
+  while (std::getline(in, line)) {
+    const auto separator = line.rfind('\t');
+    if (separator == std::string::npos) {
+      continue;
+    }
+
+    times_ns[line.substr(0, separator)] = std::stod(line.substr(separator + 1));
+  }
+
+  return true;
+}
+
+bool WriteBaseline(const std::string& path, const std::map<std::string, double>& times_ns) {
+  std::ofstream out(path);
+  for (const auto& [name, time_ns] : times_ns) {
+    out << name << "\t" << std::setprecision(8) << time_ns << "\n";
+  }
+
+  return static_cast<bool>(out);
+}
+
+}  // namespace
+
+void RegisterOpConfigBenchmarks() {
+  const std::string model_dir = Env::Default().GetEnvironmentVar("ORT_OPBENCH_MODEL_DIR");
+  if (model_dir.empty()) {
+    return;
+  }
+
+  auto logger = env->GetLoggingManager()->CreateLogger("op_configs");
+  std::unordered_set<std::string> seen;
+
+  std::error_code ec;
+  for (const auto& entry : std::filesystem::recursive_directory_iterator(model_dir, ec)) {
+    if (!entry.is_regular_file() || entry.path().extension() != ".onnx") {
+      continue;
+    }
+
+    std::shared_ptr<Model> model;
+    auto status = Model::Load(entry.path().native(), model, nullptr, *logger);
+    if (!status.IsOK()) {
+      std::cerr << "Skipping " << entry.path().string() << ": " << status.ErrorMessage() << std::endl;
+      continue;
+    }
+
+    const Graph& graph = model->MainGraph();
+    for (const auto& node : graph.Nodes()) {
+      auto config = std::make_shared<OpConfig>();
+      std::string key;
+      std::string label;
+      if (!CreateOpConfig(graph, node, *config, key, label) || !seen.insert(key).second) {
+        continue;
+      }
+
+      std::ostringstream name;
+      name << "BM_OpConfig/" << (node.Domain().empty() ? "" : node.Domain() + ".") << node.OpType() << "/" << label
+           << "/" << std::hex << std::setw(8) << std::setfill('0') << (Fnv1a(key) & 0xFFFFFFFF);
+      benchmark::RegisterBenchmark(name.str().c_str(), [config](benchmark::State& state) {
+        RunOpConfig(state, *config);
+      });
+    }
+  }
+
+  if (ec) {
+    std::cerr << "Failed to read " << model_dir << ": " << ec.message() << std::endl;
+  }
+}
+
+int RunBenchmarksWithBaseline() {
+  const std::string baseline_path = Env::Default().GetEnvironmentVar("ORT_OPBENCH_BASELINE");
+  const std::string save_path = Env::Default().GetEnvironmentVar("ORT_OPBENCH_SAVE_BASELINE");
+  if (baseline_path.empty() && save_path.empty()) {
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+  }
+
+  BaselineReporter reporter;
+  benchmark::RunSpecifiedBenchmarks(&reporter);
+
+  int result = 0;
+  if (!save_path.empty() && !WriteBaseline(save_path, reporter.TimesNs())) {
+    std::cerr << "Failed to write baseline " << save_path << std::endl;
+    result = 1;
+  }
+
+  if (!baseline_path.empty()) {
+    std::map<std::string, double> baseline;
+    if (!ReadBaseline(baseline_path, baseline)) {
+      std::cerr << "Failed to read baseline " << baseline_path << std::endl;
+      return 1;
+    }
+
+    const std::string threshold_str = Env::Default().GetEnvironmentVar("ORT_OPBENCH_REGRESSION_THRESHOLD");
+    const double threshold = threshold_str.empty() ? 0.1 : std::stod(threshold_str);
+
+    size_t num_compared = 0;
+    size_t num_regressions = 0;
+    for (const auto& [name, time_ns] : reporter.TimesNs()) {
+      auto it = baseline.find(name);
+      if (it == baseline.end() || it->second <= 0) {
+        continue;
+      }
+
+      ++num_compared;
+      const double change = time_ns / it->second - 1;
+      if (change > threshold) {
+        ++num_regressions;
+        std::cerr << "REGRESSION " << name << ": " << it->second << " ns -> " << time_ns << " ns (+"
+                  << std::setprecision(3) << change * 100 << "%)" << std::endl;
+      }
+    }
+
+    std::cout << num_compared << " benchmarks compared against " << baseline_path << ", " << num_regressions
+              << " regressed by more than " << threshold * 100 << "%" << std::endl;
+    if (num_regressions > 0) {
+      result = 1;
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,17 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+// Registers one benchmark per distinct node configuration (op, attributes, input types and shapes) found in the
+// models under the directory given by the ORT_OPBENCH_MODEL_DIR environment variable. Each configuration runs as a
+// single node model. Does nothing if the variable is not set.
+// Must be called after the global OrtEnv is created.
+void RegisterOpConfigBenchmarks();
+
+// Runs the benchmarks selected on the command line.
+// If ORT_OPBENCH_SAVE_BASELINE is set, the time per iteration of every benchmark is written to that file.
+// If ORT_OPBENCH_BASELINE is set, the times are compared against the ones in that file, and any benchmark slower than
+// its baseline by more than ORT_OPBENCH_REGRESSION_THRESHOLD (a fraction, 0.1 by default) is reported as a regression.
+// Returns the process exit code: non-zero if there was a regression or a baseline file could not be read or written.
+int RunBenchmarksWithBaseline();
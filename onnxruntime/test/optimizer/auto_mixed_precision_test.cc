@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/optimizer/auto_mixed_precision.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+// MatMul -> Add -> Softmax -> output
+void BuildMatMulAddSoftmax(ModelTestBuilder& builder) {
+  auto* input_arg = builder.MakeInput<float>({2, 8, 16}, -1.0f, 1.0f);
+  auto* weight_arg = builder.MakeInitializer<float>({16, 32}, -1.0f, 1.0f);
+  auto* bias_arg = builder.MakeInitializer<float>({32}, -1.0f, 1.0f);
+  auto* matmul_out = builder.MakeIntermediate();
+  auto* add_out = builder.MakeIntermediate();
+  auto* output_arg = builder.MakeOutput();
+
+  builder.AddNode("MatMul", {input_arg, weight_arg}, {matmul_out});
+  builder.AddNode("Add", {matmul_out, bias_arg}, {add_out});
+  builder.AddNode("Softmax", {add_out}, {output_arg});
+}
+
+int32_t ElemType(const NodeArg* node_arg) {
+  return node_arg->TypeAsProto()->tensor_type().elem_type();
+}
+}  // namespace
+
+// MatMul and the Add following it run in float16, Softmax stays in float.
+TEST(AutoMixedPrecisionTests, ConvertMatMulRegion) {
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_count_map = CountOpsInGraph(graph);
+    // one Cast on the graph input and one in front of Softmax. The initializers are converted in place.
+    TEST_RETURN_IF_NOT(op_count_map["Cast"] == 2);
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "MatMul" || node.OpType() == "Add") {
+        for (const auto* input_def : node.InputDefs()) {
+          TEST_RETURN_IF_NOT(ElemType(input_def) == ONNX_NAMESPACE::TensorProto_DataType_FLOAT16);
+        }
+        TEST_RETURN_IF_NOT(ElemType(node.OutputDefs()[0]) == ONNX_NAMESPACE::TensorProto_DataType_FLOAT16);
+      } else if (node.OpType() == "Softmax") {
+        TEST_RETURN_IF_NOT(ElemType(node.InputDefs()[0]) == ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+      }
+    }
+    TEST_RETURN_IF_NOT(ElemType(graph.GetOutputs()[0]) == ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    return Status::OK();
+  };
+
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  ASSERT_STATUS_OK(TestGraphTransformer(
+      BuildMatMulAddSoftmax, 13, logger,
+      std::make_unique<AutoMixedPrecision>(ONNX_NAMESPACE::TensorProto_DataType_FLOAT16),
+      TransformerLevel::Level1, 1, nullptr, post_graph_checker));
+}
+
+// Add is denied, so only MatMul is converted and its output is cast back to float.
+TEST(AutoMixedPrecisionTests, DenyOps) {
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_count_map = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_count_map["Cast"] == 2);
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "MatMul") {
+        TEST_RETURN_IF_NOT(ElemType(node.OutputDefs()[0]) == ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16);
+      } else if (node.OpType() == "Add") {
+        TEST_RETURN_IF_NOT(ElemType(node.InputDefs()[0]) == ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+        TEST_RETURN_IF_NOT(ElemType(node.InputDefs()[1]) == ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+      }
+    }
+    return Status::OK();
+  };
+
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  ASSERT_STATUS_OK(TestGraphTransformer(
+      BuildMatMulAddSoftmax, 13, logger,
+      std::make_unique<AutoMixedPrecision>(ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16,
+                                           InlinedHashSet<std::string>{}, InlinedHashSet<std::string>{"Add"}),
+      TransformerLevel::Level1, 1, nullptr, post_graph_checker));
+}
+
+// Without a compute heavy op in the graph nothing is converted.
+TEST(AutoMixedPrecisionTests, NoAllowOp) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 8}, -1.0f, 1.0f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    builder.AddNode("Add", {input_arg, builder.MakeInitializer<float>({8}, -1.0f, 1.0f)}, {add_out});
+    builder.AddNode("Relu", {add_out}, {output_arg});
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_count_map = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_count_map["Cast"] == 0);
+    return Status::OK();
+  };
+
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  ASSERT_STATUS_OK(TestGraphTransformer(
+      build_test_case, 13, logger,
+      std::make_unique<AutoMixedPrecision>(ONNX_NAMESPACE::TensorProto_DataType_FLOAT16),
+      TransformerLevel::Level1, 1, nullptr, post_graph_checker));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
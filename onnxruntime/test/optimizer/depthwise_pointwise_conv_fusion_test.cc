@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/optimizer/depthwise_pointwise_conv_fusion.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+// Builds a depthwise Conv followed by a pointwise Conv. When activation is not empty, both convolutions are
+// FusedConv nodes with that activation.
+void TestDepthwisePointwiseConv(const std::vector<int64_t>& input_shape, const std::vector<int64_t>& kernel_shape,
+                                const std::vector<int64_t>& strides, const std::vector<int64_t>& pads,
+                                int64_t output_channels, const std::string& activation) {
+  const int64_t channels = input_shape[1];
+
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>(input_shape, -3.f, 3.f);
+    auto* dw_weight_arg = builder.MakeInitializer<float>({channels, 1, kernel_shape[0], kernel_shape[1]}, -1.f, 1.f);
+    auto* dw_bias_arg = builder.MakeInitializer<float>({channels}, -1.f, 1.f);
+    auto* pw_weight_arg = builder.MakeInitializer<float>({output_channels, channels, 1, 1}, -1.f, 1.f);
+    auto* pw_bias_arg = builder.MakeInitializer<float>({output_channels}, -1.f, 1.f);
+    auto* dw_out_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    const std::string op_type = activation.empty() ? "Conv" : "FusedConv";
+    const std::string domain = activation.empty() ? "" : kMSDomain;
+
+    auto& dw_node = builder.AddNode(op_type, {input_arg, dw_weight_arg, dw_bias_arg}, {dw_out_arg}, domain);
+    dw_node.AddAttribute("group", channels);
+    dw_node.AddAttribute("kernel_shape", kernel_shape);
+    dw_node.AddAttribute("strides", strides);
+    dw_node.AddAttribute("pads", pads);
+
+    auto& pw_node = builder.AddNode(op_type, {dw_out_arg, pw_weight_arg, pw_bias_arg}, {output_arg}, domain);
+    pw_node.AddAttribute("kernel_shape", std::vector<int64_t>{1, 1});
+
+    if (!activation.empty()) {
+      dw_node.AddAttribute("activation", activation);
+      pw_node.AddAttribute("activation", activation);
+      if (activation == "Clip") {
+        dw_node.AddAttribute("activation_params", std::vector<float>{0.f, 6.f});
+        pw_node.AddAttribute("activation_params", std::vector<float>{-1.f, 1.f});
+      }
+    }
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedDepthwisePointwiseConv"], 1);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level1, 13, 0.0001, 0.0001,
+                    std::make_unique<DepthwisePointwiseConvFusion>());
+}
+
+TEST(DepthwisePointwiseConvFusionTests, Conv) {
+  TestDepthwisePointwiseConv({1, 16, 9, 9}, {3, 3}, {1, 1}, {1, 1, 1, 1}, 24, "");
+  TestDepthwisePointwiseConv({2, 32, 14, 14}, {3, 3}, {1, 1}, {1, 1, 1, 1}, 64, "");
+}
+
+TEST(DepthwisePointwiseConvFusionTests, ConvStrided) {
+  TestDepthwisePointwiseConv({1, 16, 15, 13}, {3, 3}, {2, 2}, {1, 1, 1, 1}, 32, "");
+  TestDepthwisePointwiseConv({1, 24, 17, 17}, {5, 5}, {2, 2}, {2, 2, 1, 1}, 8, "");
+}
+
+TEST(DepthwisePointwiseConvFusionTests, FusedConvActivation) {
+  TestDepthwisePointwiseConv({1, 16, 9, 9}, {3, 3}, {1, 1}, {1, 1, 1, 1}, 24, "Relu");
+  TestDepthwisePointwiseConv({1, 32, 12, 10}, {3, 3}, {2, 2}, {0, 0, 1, 1}, 16, "Clip");
+}
+
+TEST(DepthwisePointwiseConvFusionTests, PointwiseStridedNotFused) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 8, 8, 8}, -3.f, 3.f);
+    auto* dw_weight_arg = builder.MakeInitializer<float>({8, 1, 3, 3}, -1.f, 1.f);
+    auto* pw_weight_arg = builder.MakeInitializer<float>({16, 8, 1, 1}, -1.f, 1.f);
+    auto* dw_out_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Conv", {input_arg, dw_weight_arg}, {dw_out_arg}).AddAttribute("group", int64_t(8));
+    builder.AddNode("Conv", {dw_out_arg, pw_weight_arg}, {output_arg})
+        .AddAttribute("strides", std::vector<int64_t>{2, 2});
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedDepthwisePointwiseConv"], 0);
+    EXPECT_EQ(op_to_count["Conv"], 2);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level1, 13, 0.0001, 0.0001,
+                    std::make_unique<DepthwisePointwiseConvFusion>());
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -26,6 +26,27 @@ class DummyGraphTransformer : public GraphTransformer {
   }
 };
 
+// Dummy graph transformer that counts its invocations and reports a modification of the graph
+// for the first `num_modifications` of them
+class CountingGraphTransformer : public GraphTransformer {
+ public:
+  CountingGraphTransformer(const std::string& name, int num_modifications) noexcept
+      : GraphTransformer(name), num_modifications_(num_modifications) {}
+
+  int InvocationCount() const {
+    return invocation_count_;
+  }
+
+ private:
+  const int num_modifications_;
+  mutable int invocation_count_ = 0;
+
+  Status ApplyImpl(Graph& /*graph*/, bool& modified, int /*graph_level*/, const logging::Logger&) const override {
+    modified = invocation_count_++ < num_modifications_;
+    return Status::OK();
+  }
+};
+
 // Dummy graph transformer that does nothing, but just sets the modified value
 // This is currently used to test custom transformer selection feature
 class DummyRewriteRule : public RewriteRule {
@@ -0,0 +1,259 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/optimizer/elementwise_fusion.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+namespace {
+void TestElementwiseFusion(const std::function<void(ModelTestBuilder& builder)>& build_test_case,
+                           const std::function<void(std::map<std::string, int>& op_to_count)>& check_counts) {
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    check_counts(op_to_count);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level1, 13, 0.0001, 0.0001,
+                    std::make_unique<ElementwiseFusion>());
+}
+}  // namespace
+
+// Y = (Erf((X + B) * 0.7) + 1) * X, with a per channel bias.
+TEST(ElementwiseFusionTests, Chain) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 3, 8, 16}, -3.f, 3.f);
+    auto* bias_arg = builder.MakeInitializer<float>({16}, -1.f, 1.f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* erf_out = builder.MakeIntermediate();
+    auto* add1_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {input_arg, bias_arg}, {add_out});
+    builder.AddNode("Mul", {add_out, builder.MakeScalarInitializer<float>(0.7f)}, {mul_out});
+    builder.AddNode("Erf", {mul_out}, {erf_out});
+    builder.AddNode("Add", {erf_out, builder.MakeScalarInitializer<float>(1.f)}, {add1_out});
+    builder.AddNode("Mul", {add1_out, input_arg}, {output_arg});
+  };
+
+  TestElementwiseFusion(build_test_case, [](std::map<std::string, int>& op_to_count) {
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Erf"], 0);
+  });
+}
+
+// Where(C, Sqrt(Abs(X)), Tanh(Y) / 2) with inputs broadcast along different dimensions.
+TEST(ElementwiseFusionTests, WhereBroadcast) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* cond_arg = builder.MakeInputBool({3, 1});
+    auto* x_arg = builder.MakeInput<float>({2, 3, 5}, -3.f, 3.f);
+    auto* y_arg = builder.MakeInput<float>({2, 1, 1}, -3.f, 3.f);
+    auto* abs_out = builder.MakeIntermediate();
+    auto* sqrt_out = builder.MakeIntermediate();
+    auto* tanh_out = builder.MakeIntermediate();
+    auto* div_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Abs", {x_arg}, {abs_out});
+    builder.AddNode("Sqrt", {abs_out}, {sqrt_out});
+    builder.AddNode("Tanh", {y_arg}, {tanh_out});
+    builder.AddNode("Div", {tanh_out, builder.MakeScalarInitializer<float>(2.f)}, {div_out});
+    builder.AddNode("Where", {cond_arg, sqrt_out, div_out}, {output_arg});
+  };
+
+  TestElementwiseFusion(build_test_case, [](std::map<std::string, int>& op_to_count) {
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Where"], 0);
+  });
+}
+
+// The output of Add is read by both branches, which are fused with it, and by a Transpose outside of the chain.
+TEST(ElementwiseFusionTests, SharedIntermediate) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x_arg = builder.MakeInput<float>({4, 32}, -3.f, 3.f);
+    auto* y_arg = builder.MakeInput<float>({4, 32}, -3.f, 3.f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* tanh_out = builder.MakeIntermediate();
+    auto* sigmoid_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    auto* transpose_out = builder.MakeOutput();
+
+    builder.AddNode("Add", {x_arg, y_arg}, {add_out});
+    builder.AddNode("Tanh", {add_out}, {tanh_out});
+    builder.AddNode("Sigmoid", {add_out}, {sigmoid_out});
+    builder.AddNode("Mul", {tanh_out, sigmoid_out}, {mul_out});
+    builder.AddNode("Sqrt", {mul_out}, {output_arg});
+    builder.AddNode("Transpose", {add_out}, {transpose_out});
+  };
+
+  TestElementwiseFusion(build_test_case, [](std::map<std::string, int>& op_to_count) {
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 1);
+    EXPECT_EQ(op_to_count["Tanh"], 0);
+    EXPECT_EQ(op_to_count["Sigmoid"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+  });
+
+  // without the Transpose, Add is only read within the chain and is fused too
+  auto build_diamond = [](ModelTestBuilder& builder) {
+    auto* x_arg = builder.MakeInput<float>({4, 32}, -3.f, 3.f);
+    auto* y_arg = builder.MakeInput<float>({4, 32}, -3.f, 3.f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* tanh_out = builder.MakeIntermediate();
+    auto* sigmoid_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {x_arg, y_arg}, {add_out});
+    builder.AddNode("Tanh", {add_out}, {tanh_out});
+    builder.AddNode("Sigmoid", {add_out}, {sigmoid_out});
+    builder.AddNode("Mul", {tanh_out, sigmoid_out}, {output_arg});
+  };
+
+  TestElementwiseFusion(build_diamond, [](std::map<std::string, int>& op_to_count) {
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 0);
+  });
+}
+
+// (X - mean) / Sqrt(Mean((X - mean)^2) + eps) * scale, a layer normalization LayerNormFusion does not match.
+TEST(ElementwiseFusionTests, VarianceNormalization) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x_arg = builder.MakeInput<float>({2, 6, 48}, -3.f, 3.f);
+    auto* scale_arg = builder.MakeInitializer<float>({48}, -1.f, 1.f);
+    auto* mean_out = builder.MakeIntermediate();
+    auto* sub_out = builder.MakeIntermediate();
+    auto* pow_out = builder.MakeIntermediate();
+    auto* var_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* sqrt_out = builder.MakeIntermediate();
+    auto* div_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("ReduceMean", {x_arg}, {mean_out}).AddAttribute("axes", std::vector<int64_t>{-1});
+    builder.AddNode("Sub", {x_arg, mean_out}, {sub_out});
+    builder.AddNode("Pow", {sub_out, builder.MakeScalarInitializer<float>(2.f)}, {pow_out});
+    builder.AddNode("ReduceMean", {pow_out}, {var_out}).AddAttribute("axes", std::vector<int64_t>{2});
+    builder.AddNode("Add", {var_out, builder.MakeScalarInitializer<float>(1e-5f)}, {add_out});
+    builder.AddNode("Sqrt", {add_out}, {sqrt_out});
+    builder.AddNode("Div", {sub_out, sqrt_out}, {div_out});
+    builder.AddNode("Mul", {div_out, scale_arg}, {output_arg});
+  };
+
+  TestElementwiseFusion(build_test_case, [](std::map<std::string, int>& op_to_count) {
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["ReduceMean"], 0);
+    EXPECT_EQ(op_to_count["Sub"], 0);
+  });
+}
+
+// Softmax(Where(mask, X * scale, -10000)) with a mask broadcast over the rows.
+TEST(ElementwiseFusionTests, MaskedSoftmax) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x_arg = builder.MakeInput<float>({2, 4, 8, 32}, -3.f, 3.f);
+    auto* mask_arg = builder.MakeInputBool({2, 1, 1, 32});
+    auto* mul_out = builder.MakeIntermediate();
+    auto* where_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Mul", {x_arg, builder.MakeScalarInitializer<float>(0.125f)}, {mul_out});
+    builder.AddNode("Where", {mask_arg, mul_out, builder.MakeScalarInitializer<float>(-10000.f)}, {where_out});
+    builder.AddNode("Softmax", {where_out}, {output_arg});
+  };
+
+  TestElementwiseFusion(build_test_case, [](std::map<std::string, int>& op_to_count) {
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Softmax"], 0);
+  });
+}
+
+// X / ReduceSum(X), and Sqrt(ReduceSum(X * X)) whose output has a last dimension of 1.
+TEST(ElementwiseFusionTests, SumNormalization) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x_arg = builder.MakeInput<float>({3, 5, 16}, 0.5f, 3.f);
+    auto* axes_arg = builder.MakeInitializer<int64_t>({1}, {-1});
+    auto* abs_out = builder.MakeIntermediate();
+    auto* sum_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Abs", {x_arg}, {abs_out});
+    builder.AddNode("ReduceSum", {abs_out, axes_arg}, {sum_out});
+    builder.AddNode("Div", {x_arg, sum_out}, {output_arg});
+  };
+
+  TestElementwiseFusion(build_test_case, [](std::map<std::string, int>& op_to_count) {
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["ReduceSum"], 0);
+  });
+
+  auto build_norm = [](ModelTestBuilder& builder) {
+    auto* x_arg = builder.MakeInput<float>({3, 5, 16}, -3.f, 3.f);
+    auto* axes_arg = builder.MakeInitializer<int64_t>({1}, {2});
+    auto* mul_out = builder.MakeIntermediate();
+    auto* sum_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Mul", {x_arg, x_arg}, {mul_out});
+    builder.AddNode("ReduceSum", {mul_out, axes_arg}, {sum_out});
+    builder.AddNode("Sqrt", {sum_out}, {output_arg});
+  };
+
+  TestElementwiseFusion(build_norm, [](std::map<std::string, int>& op_to_count) {
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+  });
+}
+
+// Reductions of other axes are left alone.
+TEST(ElementwiseFusionTests, ReductionOfOtherAxisNotFused) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x_arg = builder.MakeInput<float>({3, 5, 16}, -3.f, 3.f);
+    auto* mean_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("ReduceMean", {x_arg}, {mean_out}).AddAttribute("axes", std::vector<int64_t>{1});
+    builder.AddNode("Sub", {x_arg, mean_out}, {output_arg});
+  };
+
+  TestElementwiseFusion(build_test_case, [](std::map<std::string, int>& op_to_count) {
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 0);
+    EXPECT_EQ(op_to_count["ReduceMean"], 1);
+  });
+}
+
+// An intermediate that is also a graph output must be kept.
+TEST(ElementwiseFusionTests, GraphOutputNotFused) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x_arg = builder.MakeInput<float>({4, 32}, -3.f, 3.f);
+    auto* relu_out = builder.MakeOutput();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Relu", {x_arg}, {relu_out});
+    builder.AddNode("Neg", {relu_out}, {output_arg});
+  };
+
+  TestElementwiseFusion(build_test_case, [](std::map<std::string, int>& op_to_count) {
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 0);
+    EXPECT_EQ(op_to_count["Relu"], 1);
+    EXPECT_EQ(op_to_count["Neg"], 1);
+  });
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
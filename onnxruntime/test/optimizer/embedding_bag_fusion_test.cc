@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/optimizer/embedding_bag_fusion.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+namespace {
+// Gather of bags of 5 rows from a [50, 16] embedding matrix, with 2 x 3 bags.
+NodeArg* MakeGather(ModelTestBuilder& builder) {
+  std::vector<int64_t> indices(2 * 3 * 5);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    indices[i] = static_cast<int64_t>((i * 17) % 50) - (i % 3 == 0 ? 50 : 0);
+  }
+  auto* indices_arg = builder.MakeInput<int64_t>({2, 3, 5}, indices);
+  auto* weight_arg = builder.MakeInitializer<float>({50, 16}, -1.f, 1.f);
+  auto* gather_out = builder.MakeIntermediate();
+  builder.AddNode("Gather", {weight_arg, indices_arg}, {gather_out});
+  return gather_out;
+}
+
+void CheckFused(InferenceSessionWrapper& session) {
+  auto op_to_count = CountOpsInGraph(session.GetGraph());
+  EXPECT_EQ(op_to_count["com.microsoft.EmbeddingBag"], 1);
+  EXPECT_EQ(op_to_count["Gather"], 0);
+}
+}  // namespace
+
+TEST(EmbeddingBagFusionTests, GatherReduceSum) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* gather_out = MakeGather(builder);
+    auto* axes_arg = builder.MakeInitializer<int64_t>({1}, {-2});
+    auto* output_arg = builder.MakeOutput();
+    builder.AddNode("ReduceSum", {gather_out, axes_arg}, {output_arg}).AddAttribute("keepdims", int64_t(0));
+  };
+
+  TransformerTester(build_test_case, CheckFused, TransformerLevel::Level1, TransformerLevel::Level1, 13, 1e-5, 1e-5,
+                    std::make_unique<EmbeddingBagFusion>());
+}
+
+TEST(EmbeddingBagFusionTests, GatherReduceMeanKeepDims) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* gather_out = MakeGather(builder);
+    auto* output_arg = builder.MakeOutput();
+    builder.AddNode("ReduceMean", {gather_out}, {output_arg}).AddAttribute("axes", std::vector<int64_t>{2});
+  };
+
+  TransformerTester(build_test_case, CheckFused, TransformerLevel::Level1, TransformerLevel::Level1, 13, 1e-5, 1e-5,
+                    std::make_unique<EmbeddingBagFusion>());
+}
+
+// Reducing the embedding dimension instead of the bag is not an embedding bag.
+TEST(EmbeddingBagFusionTests, ReduceOtherAxisNotFused) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* gather_out = MakeGather(builder);
+    auto* axes_arg = builder.MakeInitializer<int64_t>({1}, {-1});
+    auto* output_arg = builder.MakeOutput();
+    builder.AddNode("ReduceSum", {gather_out, axes_arg}, {output_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.EmbeddingBag"], 0);
+    EXPECT_EQ(op_to_count["Gather"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level1, 13, 1e-5, 1e-5,
+                    std::make_unique<EmbeddingBagFusion>());
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
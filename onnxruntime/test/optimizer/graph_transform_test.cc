@@ -7783,6 +7783,124 @@ TEST_F(GraphTransformationTests, MatMulNBitsBiasFusion) {
   }
 }
 
+namespace {
+// Adds a MatMulNBits node assigned to the CUDA EP, multiplying `input` by random 4 bits [K, N] weights.
+Node& AddMatMulNBits(ModelTestBuilder& builder, NodeArg* input, NodeArg* output, int64_t K, int64_t N) {
+  constexpr size_t qbits = 4;
+  constexpr size_t block_size = 32;
+
+  int q_rows, q_cols;
+  MlasBlockwiseQuantizedShape<float, qbits>(block_size, /* columnwise */ true,
+                                            static_cast<int>(K), static_cast<int>(N),
+                                            q_rows, q_cols);
+
+  size_t q_data_size_in_bytes, q_scale_size, q_zp_size_in_bytes;
+  MlasBlockwiseQuantizedBufferSizes(qbits, block_size, /* columnwise */ true,
+                                    static_cast<int>(K), static_cast<int>(N),
+                                    q_data_size_in_bytes, q_scale_size, &q_zp_size_in_bytes);
+
+  auto* B_data = builder.MakeInitializer<uint8_t>({int64_t{q_cols}, int64_t{q_rows}}, uint8_t{0}, uint8_t{255});
+  auto* B_scales = builder.MakeInitializer<float>({static_cast<int64_t>(q_scale_size)}, 1.0f, 2.0f);
+  auto* B_zero_points = builder.MakeInitializer<uint8_t>({static_cast<int64_t>(q_zp_size_in_bytes)},
+                                                         uint8_t{0}, uint8_t{255});
+
+  auto& matmul = builder.AddNode("MatMulNBits", {input, B_data, B_scales, B_zero_points}, {output}, kMSDomain);
+  matmul.AddAttribute("N", N);
+  matmul.AddAttribute("K", K);
+  matmul.AddAttribute("block_size", static_cast<int64_t>(block_size));
+  matmul.AddAttribute("bits", static_cast<int64_t>(qbits));
+  matmul.SetExecutionProviderType(kCudaExecutionProvider);
+  return matmul;
+}
+
+const ONNX_NAMESPACE::AttributeProto* GetMatMulNBitsAttribute(Graph& graph, const std::string& name) {
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "MatMulNBits") {
+      return graph_utils::GetNodeAttribute(node, name);
+    }
+  }
+  return nullptr;
+}
+}  // namespace
+
+// x * Sigmoid(x) after a MatMulNBits assigned to the CUDA EP becomes its silu activation.
+TEST_F(GraphTransformationTests, MatMulNBitsActivationFusion) {
+  for (bool assign_to_cuda : {true, false}) {
+    SCOPED_TRACE(MakeString("assign_to_cuda:", assign_to_cuda));
+
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* A = builder.MakeInput<float>(std::vector<int64_t>{2, 32}, "A");
+      auto* matmul_output = builder.MakeIntermediate();
+      auto* sigmoid_output = builder.MakeIntermediate();
+      auto* graph_output = builder.MakeOutput();
+
+      auto& matmul = AddMatMulNBits(builder, A, matmul_output, 32, 16);
+      auto& sigmoid = builder.AddNode("Sigmoid", {matmul_output}, {sigmoid_output});
+      auto& mul = builder.AddNode("Mul", {matmul_output, sigmoid_output}, {graph_output});
+
+      const std::string ep = assign_to_cuda ? kCudaExecutionProvider : kCpuExecutionProvider;
+      for (Node* node : {&matmul, &sigmoid, &mul}) {
+        node->SetExecutionProviderType(ep);
+      }
+    };
+
+    auto post_graph_checker = [&](Graph& graph) {
+      auto op_count = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_count["Sigmoid"] == (assign_to_cuda ? 0 : 1));
+      TEST_RETURN_IF_NOT(op_count["Mul"] == (assign_to_cuda ? 0 : 1));
+      if (assign_to_cuda) {
+        const auto* activation = GetMatMulNBitsAttribute(graph, "activation");
+        TEST_RETURN_IF_NOT(activation != nullptr && activation->s() == "silu");
+      }
+      return Status::OK();
+    };
+
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 21, *logger_, std::make_unique<MatMulNBitsFusion>(),
+                                          TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+  }
+}
+
+// The gate and up projections of a SwiGLU FFN become a single MatMulNBits.
+TEST_F(GraphTransformationTests, MatMulNBitsSwiGluFusion) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* A = builder.MakeInput<float>(std::vector<int64_t>{2, 32}, "A");
+    auto* gate_output = builder.MakeIntermediate();
+    auto* up_output = builder.MakeIntermediate();
+    auto* sigmoid_output = builder.MakeIntermediate();
+    auto* silu_output = builder.MakeIntermediate();
+    auto* swiglu_output = builder.MakeIntermediate();
+    auto* graph_output = builder.MakeOutput();
+
+    AddMatMulNBits(builder, A, gate_output, 32, 16);
+    AddMatMulNBits(builder, A, up_output, 32, 16);
+    builder.AddNode("Sigmoid", {gate_output}, {sigmoid_output}).SetExecutionProviderType(kCudaExecutionProvider);
+    builder.AddNode("Mul", {gate_output, sigmoid_output}, {silu_output})
+        .SetExecutionProviderType(kCudaExecutionProvider);
+    builder.AddNode("Mul", {silu_output, up_output}, {swiglu_output}).SetExecutionProviderType(kCudaExecutionProvider);
+    AddMatMulNBits(builder, swiglu_output, graph_output, 16, 32);
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_count["com.microsoft.MatMulNBits"] == 2);
+    TEST_RETURN_IF_NOT(op_count["Sigmoid"] == 0);
+    TEST_RETURN_IF_NOT(op_count["Mul"] == 0);
+
+    for (const auto& node : graph.Nodes()) {
+      if (node.InputDefs()[0] == graph.GetInputs()[0]) {
+        TEST_RETURN_IF_NOT(graph_utils::GetNodeAttribute(node, "activation")->s() == "swiglu");
+        TEST_RETURN_IF_NOT(graph_utils::GetNodeAttribute(node, "N")->i() == 32);
+        const ONNX_NAMESPACE::TensorProto* b = nullptr;
+        TEST_RETURN_IF_NOT(graph.GetInitializedTensor(node.InputDefs()[1]->Name(), b) && b->dims(0) == 32);
+      }
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 21, *logger_, std::make_unique<MatMulNBitsFusion>(),
+                                        TransformerLevel::Level2, 2, nullptr, post_graph_checker));
+}
+
 #endif  // !defined(DISABLE_CONTRIB_OPS)
 
 }  // namespace test
@@ -0,0 +1,132 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "core/graph/model.h"
+#include "core/optimizer/graph_transformer_mgr.h"
+#include "core/optimizer/loop_invariant_code_motion.h"
+#include "test/framework/test_utils.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+TypeProto MakeTensorType(TensorProto_DataType elem_type, std::initializer_list<int64_t> dims) {
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(elem_type);
+  auto* shape = type.mutable_tensor_type()->mutable_shape();
+  for (int64_t dim : dims) {
+    shape->add_dim()->set_dim_value(dim);
+  }
+  return type;
+}
+
+/*  Loop body with the outer scope values x and w.
+      x   w
+       \ /
+       Mul      <- invariant
+        |
+       Relu     <- invariant, consumes the output of an invariant node
+        |
+  state_in  |
+        \   |
+         Add    <- consumes a loop carried value
+          |
+      state_out
+*/
+GraphProto CreateLoopBody(const logging::Logger& logger) {
+  Model model("loop_body", true, logger);
+  auto& graph = model.MainGraph();
+
+  const TypeProto float_tensor = MakeTensorType(TensorProto_DataType_FLOAT, {2});
+  const TypeProto int64_scalar = MakeTensorType(TensorProto_DataType_INT64, {});
+  const TypeProto bool_scalar = MakeTensorType(TensorProto_DataType_BOOL, {});
+
+  auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
+  auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
+  auto& state_in = graph.GetOrCreateNodeArg("state_in", &float_tensor);
+  auto& cond_out = graph.GetOrCreateNodeArg("cond_out", &bool_scalar);
+  auto& state_out = graph.GetOrCreateNodeArg("state_out", &float_tensor);
+
+  auto& x = graph.GetOrCreateNodeArg("x", &float_tensor);
+  auto& w = graph.GetOrCreateNodeArg("w", &float_tensor);
+  graph.AddOuterScopeNodeArg("x");
+  graph.AddOuterScopeNodeArg("w");
+
+  auto& scaled = graph.GetOrCreateNodeArg("scaled", &float_tensor);
+  auto& scaled_relu = graph.GetOrCreateNodeArg("scaled_relu", &float_tensor);
+  graph.AddNode("mul", "Mul", "invariant", {&x, &w}, {&scaled});
+  graph.AddNode("relu", "Relu", "invariant", {&scaled}, {&scaled_relu});
+  graph.AddNode("add", "Add", "loop carried", {&state_in, &scaled_relu}, {&state_out});
+  graph.AddNode("cond", "Identity", "loop carried", {&cond_in}, {&cond_out});
+
+  graph.SetInputs({&iter_num_in, &cond_in, &state_in});
+  graph.SetOutputs({&cond_out, &state_out});
+  EXPECT_STATUS_OK(graph.Resolve());
+
+  return graph.ToGraphProto();
+}
+}  // namespace
+
+TEST(LoopInvariantCodeMotionTests, HoistsNodesConsumingOnlyOuterScopeValues) {
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  Model model("main_graph", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 16}}, {}, logger);
+  auto& graph = model.MainGraph();
+
+  const TypeProto float_tensor = MakeTensorType(TensorProto_DataType_FLOAT, {2});
+  const TypeProto int64_scalar = MakeTensorType(TensorProto_DataType_INT64, {});
+  const TypeProto bool_scalar = MakeTensorType(TensorProto_DataType_BOOL, {});
+
+  auto& x = graph.GetOrCreateNodeArg("x", &float_tensor);
+  auto& w = graph.GetOrCreateNodeArg("w", &float_tensor);
+  auto& max_trip_count = graph.GetOrCreateNodeArg("max_trip_count", &int64_scalar);
+  auto& cond = graph.GetOrCreateNodeArg("cond", &bool_scalar);
+  auto& state = graph.GetOrCreateNodeArg("state", &float_tensor);
+  auto& final_state = graph.GetOrCreateNodeArg("final_state", &float_tensor);
+
+  auto& loop_node = graph.AddNode("loop", "Loop", "Loop node", {&max_trip_count, &cond, &state}, {&final_state});
+  loop_node.AddAttribute("body", CreateLoopBody(logger));
+
+  graph.SetInputs({&x, &w, &max_trip_count, &cond, &state});
+  graph.SetOutputs({&final_state});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<LoopInvariantCodeMotion>(),
+                                                     TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, logger));
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  auto main_op_count = CountOpsInGraph(graph, false);
+  EXPECT_EQ(main_op_count["Mul"], 1);
+  EXPECT_EQ(main_op_count["Relu"], 1);
+  EXPECT_EQ(main_op_count["Loop"], 1);
+
+  const Node* loop = graph.GetProducerNode("final_state");
+  ASSERT_NE(loop, nullptr);
+  const Graph* body = loop->GetGraphAttribute("body");
+  ASSERT_NE(body, nullptr);
+
+  auto body_op_count = CountOpsInGraph(*body, false);
+  EXPECT_EQ(body_op_count["Mul"], 0);
+  EXPECT_EQ(body_op_count["Relu"], 0);
+  EXPECT_EQ(body_op_count["Add"], 1);
+  EXPECT_EQ(body_op_count["Identity"], 1);
+
+  // the Loop now consumes the output of the hoisted Relu from the outer scope
+  const auto& implicit_inputs = loop->ImplicitInputDefs();
+  EXPECT_TRUE(std::any_of(implicit_inputs.cbegin(), implicit_inputs.cend(),
+                          [](const NodeArg* arg) { return arg->Name() == "scaled_relu"; }));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/optimizer/pipeline_stage_extraction.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+// input -> MatMul -> Relu -> MatMul -> Relu -> MatMul -> Relu -> MatMul -> output, all weights of the same size
+void BuildMatMulChain(ModelTestBuilder& builder) {
+  NodeArg* value = builder.MakeInput<float>({2, 16}, -1.0f, 1.0f);
+  for (int i = 0; i < 4; ++i) {
+    auto* weight_arg = builder.MakeInitializer<float>({16, 16}, -1.0f, 1.0f);
+    auto* matmul_out = i == 3 ? builder.MakeOutput() : builder.MakeIntermediate();
+    builder.AddNode("MatMul", {value, weight_arg}, {matmul_out});
+    value = matmul_out;
+    if (i < 3) {
+      auto* relu_out = builder.MakeIntermediate();
+      builder.AddNode("Relu", {value}, {relu_out});
+      value = relu_out;
+    }
+  }
+}
+}  // namespace
+
+// The first stage keeps the first two MatMuls and outputs the value the second stage starts from.
+TEST(PipelineStageExtractionTests, FirstStage) {
+  std::string graph_output_name;
+  auto pre_graph_checker = [&graph_output_name](Graph& graph) {
+    graph_output_name = graph.GetOutputs()[0]->Name();
+    return Status::OK();
+  };
+  auto post_graph_checker = [&graph_output_name](Graph& graph) {
+    auto op_count_map = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_count_map["MatMul"] == 2);
+    TEST_RETURN_IF_NOT(graph.GetInputs().size() == 1);
+    TEST_RETURN_IF_NOT(graph.GetOutputs().size() == 1);
+    TEST_RETURN_IF_NOT(graph.GetOutputs()[0]->Name() != graph_output_name);
+    TEST_RETURN_IF_NOT(graph.GetProducerNode(graph.GetOutputs()[0]->Name())->OpType() == "Relu");
+    return Status::OK();
+  };
+
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  ASSERT_STATUS_OK(TestGraphTransformer(BuildMatMulChain, 13, logger,
+                                        std::make_unique<PipelineStageExtraction>(2, 0),
+                                        TransformerLevel::Level1, 1, pre_graph_checker, post_graph_checker));
+}
+
+// The second stage takes the output of the first stage and produces the graph output.
+TEST(PipelineStageExtractionTests, LastStage) {
+  std::string graph_input_name;
+  std::string graph_output_name;
+  auto pre_graph_checker = [&](Graph& graph) {
+    graph_input_name = graph.GetInputs()[0]->Name();
+    graph_output_name = graph.GetOutputs()[0]->Name();
+    return Status::OK();
+  };
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_count_map = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_count_map["MatMul"] == 2);
+    TEST_RETURN_IF_NOT(graph.GetInputs().size() == 1);
+    TEST_RETURN_IF_NOT(graph.GetInputs()[0]->Name() != graph_input_name);
+    TEST_RETURN_IF_NOT(graph.GetOutputs().size() == 1);
+    TEST_RETURN_IF_NOT(graph.GetOutputs()[0]->Name() == graph_output_name);
+    return Status::OK();
+  };
+
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  ASSERT_STATUS_OK(TestGraphTransformer(BuildMatMulChain, 13, logger,
+                                        std::make_unique<PipelineStageExtraction>(2, 1),
+                                        TransformerLevel::Level1, 1, pre_graph_checker, post_graph_checker));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
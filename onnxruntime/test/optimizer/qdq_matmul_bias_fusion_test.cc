@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/optimizer/qdq_transformer/qdq_matmul_bias_fusion.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+namespace {
+template <typename TA, typename TW>
+void TestQDQMatMulBiasFusion(bool per_column, bool requantize_matmul, bool quantized_bias, int expected_qgemm_count) {
+  constexpr int64_t K = 16;
+  constexpr int64_t N = 8;
+  const TA a_zero_point = std::is_same_v<TA, uint8_t> ? 128 : 0;
+  const TW w_zero_point = std::is_same_v<TW, uint8_t> ? 128 : 0;
+
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    // (batch, sequence, hidden) activations
+    auto* input_arg = builder.MakeInput<float>({2, 3, K}, -1.f, 1.f);
+    auto* q_a_out = builder.MakeIntermediate();
+    auto* dq_a_out = builder.MakeIntermediate();
+    builder.AddQuantizeLinearNode<TA>(input_arg, .01f, a_zero_point, q_a_out);
+    builder.AddDequantizeLinearNode<TA>(q_a_out, .01f, a_zero_point, dq_a_out);
+
+    auto* weight_arg = builder.MakeInitializer<TW>({K, N}, std::numeric_limits<TW>::min(),
+                                                   std::numeric_limits<TW>::max());
+    auto* dq_w_out = builder.MakeIntermediate();
+    if (per_column) {
+      std::vector<float> scales(N);
+      for (int64_t i = 0; i < N; ++i) {
+        scales[i] = .002f * static_cast<float>(i + 1);
+      }
+      builder.AddDequantizeLinearNode<TW>(weight_arg, scales, std::vector<TW>(N, w_zero_point), dq_w_out);
+    } else {
+      builder.AddDequantizeLinearNode<TW>(weight_arg, .005f, w_zero_point, dq_w_out);
+    }
+
+    auto* matmul_out = builder.MakeIntermediate();
+    builder.AddNode("MatMul", {dq_a_out, dq_w_out}, {matmul_out});
+
+    NodeArg* add_input = matmul_out;
+    if (requantize_matmul) {
+      auto* q_mid_out = builder.MakeIntermediate();
+      add_input = builder.MakeIntermediate();
+      builder.AddQuantizeLinearNode<TA>(matmul_out, .02f, a_zero_point, q_mid_out);
+      builder.AddDequantizeLinearNode<TA>(q_mid_out, .02f, a_zero_point, add_input);
+    }
+
+    NodeArg* bias_arg = nullptr;
+    if (quantized_bias) {
+      auto* bias_quantized = builder.MakeInitializer<int32_t>({N}, -1000, 1000);
+      bias_arg = builder.MakeIntermediate();
+      builder.AddDequantizeLinearNode<int32_t>(bias_quantized, .0005f, 0, bias_arg);
+    } else {
+      bias_arg = builder.MakeInitializer<float>({N}, -.5f, .5f);
+    }
+
+    auto* add_out = builder.MakeIntermediate();
+    auto* q_y_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    builder.AddNode("Add", {add_input, bias_arg}, {add_out});
+    builder.AddQuantizeLinearNode<TA>(add_out, .02f, a_zero_point, q_y_out);
+    builder.AddDequantizeLinearNode<TA>(q_y_out, .02f, a_zero_point, output_arg);
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.QGemm"], expected_qgemm_count);
+    EXPECT_EQ(op_to_count["MatMul"], 1 - expected_qgemm_count);
+    EXPECT_EQ(op_to_count["Add"], 1 - expected_qgemm_count);
+    if (expected_qgemm_count == 1) {
+      // only the Q of the input and the DQ of the output are left
+      EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], 1);
+    }
+  };
+
+  // skipping the requantization of the MatMul output may change the result by one quantization step
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level1, 13, .05, .05,
+                    std::make_unique<QDQMatMulBiasFusion>());
+}
+}  // namespace
+
+TEST(QDQMatMulBiasFusionTests, U8U8) {
+  TestQDQMatMulBiasFusion<uint8_t, uint8_t>(false, false, false, 1);
+}
+
+TEST(QDQMatMulBiasFusionTests, U8S8PerColumn) {
+  TestQDQMatMulBiasFusion<uint8_t, int8_t>(true, false, false, 1);
+}
+
+TEST(QDQMatMulBiasFusionTests, S8S8RequantizedMatMul) {
+  TestQDQMatMulBiasFusion<int8_t, int8_t>(false, true, false, 1);
+}
+
+TEST(QDQMatMulBiasFusionTests, QuantizedBias) {
+  TestQDQMatMulBiasFusion<uint8_t, int8_t>(true, true, true, 1);
+}
+
+// QGemm has no kernel for int8 activations with uint8 weights.
+TEST(QDQMatMulBiasFusionTests, S8U8NotFused) {
+  TestQDQMatMulBiasFusion<int8_t, uint8_t>(false, false, false, 0);
+}
+
+#endif  // !DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -7,10 +7,12 @@
 #include "core/framework/compute_capability.h"
 #include "core/framework/node_unit.h"
 #include "core/framework/int4.h"
+#include "core/graph/graph_utils.h"
 #include "core/graph/model.h"
 #include "core/graph/onnx_protobuf.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/optimizer/double_qdq_pairs_remover.h"
+#include "core/optimizer/initializer.h"
 #include "core/optimizer/qdq_transformer/qdq_final_cleanup.h"
 #include "core/optimizer/qdq_transformer/selectors_actions/qdq_selectors.h"
 #include "core/optimizer/qdq_transformer/selectors_actions/qdq_selector_action_transformer.h"
@@ -2951,6 +2953,72 @@ TEST(QDQTransformerTests, Softmax_U8U8) {
   QDQTransformerSoftmaxTests<uint8_t, uint8_t>();
 }
 
+#if !defined(DISABLE_FLOAT8_TYPES)
+// DQ(fp8 A) + DQ(fp8 constant B) -> MatMul -> optional Q(fp8) on the CUDA EP is replaced with GemmFloat8 taking the
+// transposed B.
+TEST(QDQTransformerTests, MatMul_Float8_GemmFloat8) {
+  auto test_case = [](bool has_output_q) {
+    auto build_test_case = [has_output_q](ModelTestBuilder& builder) {
+      auto* input_a = builder.MakeInput<Float8E4M3FN>({16, 32}, std::vector<Float8E4M3FN>(16 * 32, Float8E4M3FN(0.5f)));
+      auto* input_b = builder.MakeInitializer<Float8E4M3FN>({32, 48},
+                                                            std::vector<Float8E4M3FN>(32 * 48, Float8E4M3FN(0.25f)));
+      auto* dq_a_output = builder.MakeIntermediate();
+      auto* dq_b_output = builder.MakeIntermediate();
+      builder.AddNode("DequantizeLinear", {input_a, builder.MakeScalarInitializer<float>(0.5f)}, {dq_a_output});
+      builder.AddNode("DequantizeLinear", {input_b, builder.MakeScalarInitializer<float>(0.25f)}, {dq_b_output});
+
+      if (has_output_q) {
+        auto* matmul_output = builder.MakeIntermediate();
+        builder.AddNode("MatMul", {dq_a_output, dq_b_output}, {matmul_output});
+        builder.AddNode("QuantizeLinear",
+                        {matmul_output, builder.MakeScalarInitializer<float>(4.0f),
+                         builder.MakeScalarInitializer<Float8E4M3FN>(Float8E4M3FN(0.0f))},
+                        {builder.MakeOutput()});
+      } else {
+        builder.AddNode("MatMul", {dq_a_output, dq_b_output}, {builder.MakeOutput()});
+      }
+    };
+
+    auto pre_graph_checker = [](Graph& graph) {
+      for (auto& node : graph.Nodes()) {
+        node.SetExecutionProviderType(kCudaExecutionProvider);
+      }
+      return Status::OK();
+    };
+
+    auto post_graph_checker = [has_output_q](Graph& graph) {
+      auto op_to_count = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_to_count["com.microsoft.GemmFloat8"] == 1);
+      TEST_RETURN_IF_NOT(op_to_count["MatMul"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["DequantizeLinear"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["QuantizeLinear"] == 0);
+
+      for (const auto& node : graph.Nodes()) {
+        const auto& input_defs = node.InputDefs();
+        const auto* b = graph_utils::GetConstantInitializer(graph, input_defs[1]->Name());
+        TEST_RETURN_IF_NOT(b != nullptr && b->dims(0) == 48 && b->dims(1) == 32);
+        TEST_RETURN_IF_NOT(!input_defs[2]->Exists());
+        TEST_RETURN_IF_NOT(input_defs.size() == (has_output_q ? 6u : 5u));
+        if (has_output_q) {
+          const auto* scale_y = graph_utils::GetConstantInitializer(graph, input_defs[5]->Name());
+          TEST_RETURN_IF_NOT(scale_y != nullptr);
+          TEST_RETURN_IF_NOT(Initializer(*scale_y, graph.ModelPath()).data<float>()[0] == 0.25f);
+        }
+      }
+      return Status::OK();
+    };
+
+    const auto& logger = DefaultLoggingManager().DefaultLogger();
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 19, logger,
+                                          std::make_unique<QDQFloat8SelectorActionTransformer>(),
+                                          TransformerLevel::Level2, 1, pre_graph_checker, post_graph_checker));
+  };
+
+  test_case(false);
+  test_case(true);
+}
+#endif  // !defined(DISABLE_FLOAT8_TYPES)
+
 #endif  // !defined(DISABLE_CONTRIB_OPS)
 
 TEST(QDQTransformerTests, QDQPropagation_QBackward) {
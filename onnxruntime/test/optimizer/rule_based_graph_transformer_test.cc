@@ -71,5 +71,31 @@ TEST(RuleBasedGraphTransformerTest, TestSettingStepsInGraphTransformerManager) {
   ASSERT_STATUS_OK(graph_transformation_mgr.GetSteps(steps_queried));
   ASSERT_EQ(steps_queried, static_cast<unsigned>(10));
 }
+
+TEST(RuleBasedGraphTransformerTest, TestGraphTransformerManagerSkipsTransformersWithoutChanges) {
+  auto model_uri = ORT_TSTR("testdata/transform/fusion/fuse-conv-bn-mul-add-unsqueeze.onnx");
+
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(model_uri, model, nullptr, DefaultLoggingManager().DefaultLogger()));
+  Graph& graph = model->MainGraph();
+
+  // `modifying` changes the graph in its first two runs, `idle` never does
+  auto modifying = std::make_unique<CountingGraphTransformer>("ModifyingTransformer", 2);
+  auto idle = std::make_unique<CountingGraphTransformer>("IdleTransformer", 0);
+  const auto* modifying_ptr = modifying.get();
+  const auto* idle_ptr = idle.get();
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(modifying), TransformerLevel::Level2));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(idle), TransformerLevel::Level2));
+
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2,
+                                                              DefaultLoggingManager().DefaultLogger()));
+
+  // step 0 and 1: modifying changes the graph, then idle runs on the changed graph.
+  // step 2: modifying finds nothing to do. idle is skipped as the graph didn't change since its last run.
+  EXPECT_EQ(modifying_ptr->InvocationCount(), 3);
+  EXPECT_EQ(idle_ptr->InvocationCount(), 2);
+}
 }  // namespace test
 }  // namespace onnxruntime
\ No newline at end of file
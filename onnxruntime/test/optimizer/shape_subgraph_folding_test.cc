@@ -0,0 +1,139 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <limits>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/shape_subgraph_folding.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+// Adds Unsqueeze(Gather(shape, index)) with opset 13 inputs.
+NodeArg* AddShapeElement(ModelTestBuilder& builder, NodeArg* shape_arg, int64_t index) {
+  auto* gather_out = builder.MakeIntermediate();
+  auto* unsqueeze_out = builder.MakeIntermediate();
+  builder.AddNode("Gather", {shape_arg, builder.MakeScalarInitializer<int64_t>(index)}, {gather_out});
+  builder.AddNode("Unsqueeze", {gather_out, builder.Make1DInitializer<int64_t>({0})}, {unsqueeze_out});
+  return unsqueeze_out;
+}
+
+Status CheckReshapeShape(Graph& graph, const std::vector<int64_t>& expected_shape) {
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == "Reshape") {
+      const auto* shape_proto = graph.GetConstantInitializer(node.InputDefs()[1]->Name(), true);
+      TEST_RETURN_IF_NOT(shape_proto != nullptr);
+      Initializer shape{*shape_proto, graph.ModelPath()};
+      auto shape_values = shape.DataAsSpan<int64_t>();
+      TEST_RETURN_IF_NOT(std::vector<int64_t>(shape_values.begin(), shape_values.end()) == expected_shape);
+    }
+  }
+  return Status::OK();
+}
+}  // namespace
+
+// Reshape(x, Concat(Shape(x)[0], Shape(x)[1], 12, 64)) of a (batch, seq, 768) tensor becomes Reshape(x, [0, 0, 12, 64]).
+TEST(ShapeSubgraphFoldingTests, ReshapeWithSymbolicDims) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeSymbolicInput<float>({std::string("batch"), std::string("seq"), int64_t{768}});
+    auto* shape_out = builder.MakeIntermediate();
+    auto* concat_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    builder.AddNode("Shape", {input_arg}, {shape_out});
+    auto* batch_arg = AddShapeElement(builder, shape_out, 0);
+    auto* seq_arg = AddShapeElement(builder, shape_out, 1);
+    builder.AddNode("Concat",
+                    {batch_arg, seq_arg, builder.Make1DInitializer<int64_t>({12}),
+                     builder.Make1DInitializer<int64_t>({64})},
+                    {concat_out})
+        .AddAttribute("axis", static_cast<int64_t>(0));
+    builder.AddNode("Reshape", {input_arg, concat_out}, {output_arg});
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_count_map = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_count_map["Shape"] == 0);
+    TEST_RETURN_IF_NOT(op_count_map["Gather"] == 0);
+    TEST_RETURN_IF_NOT(op_count_map["Unsqueeze"] == 0);
+    TEST_RETURN_IF_NOT(op_count_map["Concat"] == 0);
+    TEST_RETURN_IF_NOT(op_count_map["Reshape"] == 1);
+    return CheckReshapeShape(graph, {0, 0, 12, 64});
+  };
+
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, logger, std::make_unique<ShapeSubgraphFolding>(),
+                                        TransformerLevel::Level1, 1, nullptr, post_graph_checker));
+}
+
+// Shape(x)[1:] of a (batch, 12, 64) tensor is constant, so Concat(-1, Shape(x)[1:]) is folded.
+TEST(ShapeSubgraphFoldingTests, PartiallyKnownShape) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeSymbolicInput<float>({std::string("batch"), int64_t{12}, int64_t{64}});
+    auto* shape_out = builder.MakeIntermediate();
+    auto* slice_out = builder.MakeIntermediate();
+    auto* concat_out = builder.MakeIntermediate();
+    auto* reshape_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    builder.AddNode("Shape", {input_arg}, {shape_out});
+    builder.AddNode("Slice",
+                    {shape_out, builder.Make1DInitializer<int64_t>({1}),
+                     builder.Make1DInitializer<int64_t>({std::numeric_limits<int64_t>::max()})},
+                    {slice_out});
+    builder.AddNode("Concat", {builder.Make1DInitializer<int64_t>({-1}), slice_out}, {concat_out})
+        .AddAttribute("axis", static_cast<int64_t>(0));
+    builder.AddNode("Reshape", {input_arg, concat_out}, {reshape_out});
+    builder.AddNode("Identity", {reshape_out}, {output_arg});
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_count_map = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_count_map["Shape"] == 0);
+    TEST_RETURN_IF_NOT(op_count_map["Slice"] == 0);
+    TEST_RETURN_IF_NOT(op_count_map["Concat"] == 0);
+    return CheckReshapeShape(graph, {-1, 12, 64});
+  };
+
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, logger, std::make_unique<ShapeSubgraphFolding>(),
+                                        TransformerLevel::Level1, 1, nullptr, post_graph_checker));
+}
+
+// Swapping two symbolic dimensions needs them both at runtime, so the shape computation is kept.
+TEST(ShapeSubgraphFoldingTests, SwappedSymbolicDimsNotFolded) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeSymbolicInput<float>({std::string("a"), std::string("b"), int64_t{4}});
+    auto* shape_out = builder.MakeIntermediate();
+    auto* concat_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    builder.AddNode("Shape", {input_arg}, {shape_out});
+    auto* b_arg = AddShapeElement(builder, shape_out, 1);
+    auto* a_arg = AddShapeElement(builder, shape_out, 0);
+    builder.AddNode("Concat", {b_arg, a_arg, builder.Make1DInitializer<int64_t>({4})}, {concat_out})
+        .AddAttribute("axis", static_cast<int64_t>(0));
+    builder.AddNode("Reshape", {input_arg, concat_out}, {output_arg});
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_count_map = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_count_map["Shape"] == 1);
+    TEST_RETURN_IF_NOT(op_count_map["Concat"] == 1);
+    return Status::OK();
+  };
+
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, logger, std::make_unique<ShapeSubgraphFolding>(),
+                                        TransformerLevel::Level1, 1, nullptr, post_graph_checker));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
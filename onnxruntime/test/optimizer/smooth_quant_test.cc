@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/optimizer/smooth_quant.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+namespace {
+
+constexpr const char* kNormalizedName = "normalized";
+
+// Activation statistics with an outlier channel.
+std::unordered_map<std::string, std::vector<float>> MakeActivationAbsMax(size_t channels) {
+  std::vector<float> abs_max(channels, 2.0f);
+  abs_max[channels / 2] = 60.0f;
+  return {{kNormalizedName, abs_max}};
+}
+
+size_t CountSmoothedInitializers(const Graph& graph) {
+  size_t count = 0;
+  for (const auto& [name, tensor_proto] : graph.GetAllInitializedTensors()) {
+    if (name.rfind("SmoothQuant_", 0) == 0) {
+      count++;
+    }
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST(SmoothQuantTests, LayerNormalizationToMatMuls) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 4, 16}, -1.f, 1.f);
+    auto* gamma_arg = builder.MakeInitializer<float>({16}, 0.5f, 1.5f);
+    auto* beta_arg = builder.MakeInitializer<float>({16}, -0.5f, 0.5f);
+    auto* normalized_arg = &builder.graph_.GetOrCreateNodeArg(kNormalizedName, nullptr);
+    auto* weight1_arg = builder.MakeInitializer<float>({16, 8}, -1.f, 1.f);
+    auto* weight2_arg = builder.MakeInitializer<float>({16, 32}, -1.f, 1.f);
+    auto* output1_arg = builder.MakeOutput();
+    auto* output2_arg = builder.MakeOutput();
+
+    builder.AddNode("LayerNormalization", {input_arg, gamma_arg, beta_arg}, {normalized_arg});
+    builder.AddNode("MatMul", {normalized_arg, weight1_arg}, {output1_arg});
+    builder.AddNode("MatMul", {normalized_arg, weight2_arg}, {output2_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    const Graph& graph = session.GetGraph();
+    auto op_to_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_to_count["LayerNormalization"], 1);
+    EXPECT_EQ(op_to_count["MatMul"], 2);
+    // gamma, beta and the two weights
+    EXPECT_EQ(CountSmoothedInitializers(graph), 4u);
+  };
+
+  // the smoothing doesn't change the results
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level1, 17, 1e-4, 1e-4,
+                    std::make_unique<SmoothQuant>(MakeActivationAbsMax(16), 0.5f));
+}
+
+TEST(SmoothQuantTests, OtherConsumerIsNotSmoothed) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 4, 16}, -1.f, 1.f);
+    auto* gamma_arg = builder.MakeInitializer<float>({16}, 0.5f, 1.5f);
+    auto* beta_arg = builder.MakeInitializer<float>({16}, -0.5f, 0.5f);
+    auto* normalized_arg = &builder.graph_.GetOrCreateNodeArg(kNormalizedName, nullptr);
+    auto* weight_arg = builder.MakeInitializer<float>({16, 8}, -1.f, 1.f);
+    auto* output1_arg = builder.MakeOutput();
+    auto* output2_arg = builder.MakeOutput();
+
+    builder.AddNode("LayerNormalization", {input_arg, gamma_arg, beta_arg}, {normalized_arg});
+    builder.AddNode("MatMul", {normalized_arg, weight_arg}, {output1_arg});
+    builder.AddNode("Add", {normalized_arg, input_arg}, {output2_arg});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    EXPECT_EQ(CountSmoothedInitializers(session.GetGraph()), 0u);
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level1, 17, 0.0, 0.0,
+                    std::make_unique<SmoothQuant>(MakeActivationAbsMax(16), 0.5f));
+}
+
+TEST(SmoothQuantTests, ParseActivationAbsMax) {
+  const std::string prefix = SmoothQuant::kActivationAbsMaxMetadataPrefix;
+  const std::unordered_map<std::string, std::string> metadata{{prefix + "ln_out", "1.5, 2,0.25"},
+                                                              {"producer", "test"}};
+  std::unordered_map<std::string, std::vector<float>> activation_abs_max;
+  ASSERT_STATUS_OK(SmoothQuant::ParseActivationAbsMax(metadata, activation_abs_max));
+  ASSERT_EQ(activation_abs_max.size(), 1u);
+  EXPECT_EQ(activation_abs_max["ln_out"], (std::vector<float>{1.5f, 2.0f, 0.25f}));
+
+  const std::unordered_map<std::string, std::string> invalid_metadata{{prefix + "ln_out", "1.5,abc"}};
+  ASSERT_STATUS_NOT_OK(SmoothQuant::ParseActivationAbsMax(invalid_metadata, activation_abs_max));
+  const std::unordered_map<std::string, std::string> negative_metadata{{prefix + "ln_out", "-1"}};
+  ASSERT_STATUS_NOT_OK(SmoothQuant::ParseActivationAbsMax(negative_metadata, activation_abs_max));
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
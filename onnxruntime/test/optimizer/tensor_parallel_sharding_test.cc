@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/optimizer/tensor_parallel_sharding.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+
+// The AllReduce schema is only registered in builds with NCCL.
+#if defined(ORT_USE_NCCL)
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+// MatMul -> Add -> Relu -> MatMul -> output
+std::function<void(ModelTestBuilder&)> BuildMlp(int64_t inner_dim) {
+  return [inner_dim](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 8, 16}, -1.0f, 1.0f);
+    auto* weight1_arg = builder.MakeInitializer<float>({16, inner_dim}, -1.0f, 1.0f);
+    auto* bias_arg = builder.MakeInitializer<float>({inner_dim}, -1.0f, 1.0f);
+    auto* weight2_arg = builder.MakeInitializer<float>({inner_dim, 16}, -1.0f, 1.0f);
+    auto* matmul1_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* relu_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("MatMul", {input_arg, weight1_arg}, {matmul1_out});
+    builder.AddNode("Add", {matmul1_out, bias_arg}, {add_out});
+    builder.AddNode("Relu", {add_out}, {relu_out});
+    builder.AddNode("MatMul", {relu_out, weight2_arg}, {output_arg});
+  };
+}
+
+std::vector<int64_t> InitializerDims(const Graph& graph, const NodeArg* node_arg) {
+  const ONNX_NAMESPACE::TensorProto* tensor_proto = nullptr;
+  if (!graph.GetInitializedTensor(node_arg->Name(), tensor_proto)) {
+    return {};
+  }
+  return {tensor_proto->dims().begin(), tensor_proto->dims().end()};
+}
+}  // namespace
+
+// The weights of the rank are a quarter of the inner dimension and the second MatMul is followed by an AllReduce.
+TEST(TensorParallelShardingTests, ShardMlp) {
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_count_map = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_count_map["com.microsoft.AllReduce"] == 1);
+    TEST_RETURN_IF_NOT(op_count_map["MatMul"] == 2);
+
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "MatMul" && node.InputDefs()[0]->Name() == graph.GetInputs()[0]->Name()) {
+        TEST_RETURN_IF_NOT(InitializerDims(graph, node.InputDefs()[1]) == std::vector<int64_t>({16, 8}));
+      } else if (node.OpType() == "MatMul") {
+        TEST_RETURN_IF_NOT(InitializerDims(graph, node.InputDefs()[1]) == std::vector<int64_t>({8, 16}));
+        TEST_RETURN_IF_NOT(node.OutputNodesBegin()->OpType() == "AllReduce");
+      } else if (node.OpType() == "Add") {
+        TEST_RETURN_IF_NOT(InitializerDims(graph, node.InputDefs()[1]) == std::vector<int64_t>({8}));
+      } else if (node.OpType() == "AllReduce") {
+        TEST_RETURN_IF_NOT(node.OutputDefs()[0] == graph.GetOutputs()[0]);
+      }
+    }
+    return Status::OK();
+  };
+
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  ASSERT_STATUS_OK(TestGraphTransformer(BuildMlp(32), 13, logger,
+                                        std::make_unique<TensorParallelSharding>(4, 1),
+                                        TransformerLevel::Level1, 1, nullptr, post_graph_checker));
+}
+
+// An inner dimension that isn't divisible by the world size isn't sharded.
+TEST(TensorParallelShardingTests, IndivisibleInnerDim) {
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_count_map = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_count_map["com.microsoft.AllReduce"] == 0);
+    return Status::OK();
+  };
+
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  ASSERT_STATUS_OK(TestGraphTransformer(BuildMlp(30), 13, logger,
+                                        std::make_unique<TensorParallelSharding>(4, 0),
+                                        TransformerLevel::Level1, 1, nullptr, post_graph_checker));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
+
+#endif  // defined(ORT_USE_NCCL)
@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/optimizer/compute_optimizer/upstream_gather.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+// Builds LayerNormalization -> MatMul -> Gather(index -1, axis 1) -> Identity, which is how a decoder picks the
+// hidden states of the last token before the LM head.
+void BuildLastTokenGraph(ModelTestBuilder& builder, bool layer_norm_output_is_graph_output) {
+  auto* input_arg = builder.MakeInput<float>({2, 8, 16}, -1.0f, 1.0f);
+  auto* scale_arg = builder.MakeInitializer<float>({16}, -1.0f, 1.0f);
+  auto* bias_arg = builder.MakeInitializer<float>({16}, -1.0f, 1.0f);
+  auto* weight_arg = builder.MakeInitializer<float>({16, 32}, -1.0f, 1.0f);
+  auto* ln_out = layer_norm_output_is_graph_output ? builder.MakeOutput() : builder.MakeIntermediate();
+  auto* matmul_out = builder.MakeIntermediate();
+  auto* gather_out = builder.MakeIntermediate();
+  auto* output_arg = builder.MakeOutput();
+
+  builder.AddNode("LayerNormalization", {input_arg, scale_arg, bias_arg}, {ln_out});
+  builder.AddNode("MatMul", {ln_out, weight_arg}, {matmul_out});
+  builder.AddNode("Gather", {matmul_out, builder.MakeScalarInitializer<int64_t>(-1)}, {gather_out})
+      .AddAttribute("axis", static_cast<int64_t>(1));
+  builder.AddNode("Identity", {gather_out}, {output_arg});
+}
+
+const Node* GetProducer(const Graph& graph, const NodeArg* arg) {
+  return graph.GetProducerNode(arg->Name());
+}
+}  // namespace
+
+// The Gather is moved to the graph input, so LayerNormalization and MatMul only run on the last token.
+TEST(UpStreamGatherTests, LastTokenInference) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    BuildLastTokenGraph(builder, false);
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_count_map = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_count_map["Gather"] == 1);
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "Gather") {
+        TEST_RETURN_IF_NOT(graph.IsInputsIncludingInitializers(node.InputDefs()[0]));
+      } else if (node.OpType() == "LayerNormalization") {
+        const Node* producer = GetProducer(graph, node.InputDefs()[0]);
+        TEST_RETURN_IF_NOT(producer != nullptr && producer->OpType() == "Gather");
+      }
+    }
+    return Status::OK();
+  };
+
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 17, logger,
+                                        std::make_unique<UpStreamGatherGraphTransformer>(),
+                                        TransformerLevel::Level1, 1, nullptr, post_graph_checker));
+}
+
+// The full LayerNormalization output is a graph output, so the Gather can not move above MatMul.
+TEST(UpStreamGatherTests, StopAtGraphOutput) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    BuildLastTokenGraph(builder, true);
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_count_map = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_count_map["Gather"] == 1);
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == "Gather") {
+        const Node* producer = GetProducer(graph, node.InputDefs()[0]);
+        TEST_RETURN_IF_NOT(producer != nullptr && producer->OpType() == "LayerNormalization");
+      } else if (node.OpType() == "MatMul") {
+        const Node* producer = GetProducer(graph, node.InputDefs()[0]);
+        TEST_RETURN_IF_NOT(producer != nullptr && producer->OpType() == "Gather");
+      }
+    }
+    return Status::OK();
+  };
+
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 17, logger,
+                                        std::make_unique<UpStreamGatherGraphTransformer>(),
+                                        TransformerLevel::Level1, 1, nullptr, post_graph_checker));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,159 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "allocation_audit.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#if !defined(_WIN32) && defined(__has_include)
+#if __has_include(<execinfo.h>)
+#include <execinfo.h>
+#define ORT_PERF_TEST_ALLOCATION_AUDIT
+#endif
+#endif
+
+namespace onnxruntime {
+namespace perftest {
+namespace allocation_audit {
+
+#if defined(ORT_PERF_TEST_ALLOCATION_AUDIT)
+
+namespace {
+
+constexpr size_t kMaxStacks = 64;
+constexpr int kMaxFrames = 32;
+
+struct Stack {
+  void* frames[kMaxFrames];
+  int num_frames;
+  size_t size;
+};
+
+std::atomic<bool> active{false};
+std::atomic<size_t> allocations{0};
+std::atomic<size_t> bytes{0};
+std::atomic<size_t> next_stack{0};
+size_t max_stacks = 0;
+Stack stacks[kMaxStacks];
+
+// set while an allocation of the thread is recorded, so allocations made by backtrace are not recorded
+thread_local bool recording = false;
+
+}  // namespace
+
+// Called by operator new. Must not allocate.
+void RecordAllocation(size_t size) {
+  if (!active.load(std::memory_order_relaxed) || recording) {
+    return;
+  }
+
+  recording = true;
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  bytes.fetch_add(size, std::memory_order_relaxed);
+  const size_t slot = next_stack.fetch_add(1, std::memory_order_relaxed);
+  if (slot < max_stacks) {
+    stacks[slot].size = size;
+    stacks[slot].num_frames = backtrace(stacks[slot].frames, kMaxFrames);
+  }
+  recording = false;
+}
+
+bool IsSupported() { return true; }
+
+void Start(size_t num_stacks) {
+  // the first backtrace loads the unwinder, which allocates
+  void* frames[1];
+  backtrace(frames, 1);
+
+  max_stacks = std::min(num_stacks, kMaxStacks);
+  allocations = 0;
+  bytes = 0;
+  next_stack = 0;
+  active = true;
+}
+
+Result Stop() {
+  active = false;
+  return Result{allocations.load(), bytes.load()};
+}
+
+void WriteStacks(std::ostream& os) {
+  const size_t num_stacks = std::min(next_stack.load(), max_stacks);
+  for (size_t i = 0; i < num_stacks; ++i) {
+    const auto& stack = stacks[i];
+    os << "Allocation " << i << ": " << stack.size << " bytes\n";
+    char** symbols = backtrace_symbols(stack.frames, stack.num_frames);
+    // skip the frames of operator new
+    for (int frame = 2; frame < stack.num_frames; ++frame) {
+      os << "  " << (symbols != nullptr ? symbols[frame] : "?") << "\n";
+    }
+    std::free(symbols);
+  }
+
+  os << std::flush;
+}
+
+#else
+
+bool IsSupported() { return false; }
+
+void Start(size_t) {}
+
+Result Stop() { return Result{}; }
+
+void WriteStacks(std::ostream&) {}
+
+#endif
+
+}  // namespace allocation_audit
+}  // namespace perftest
+}  // namespace onnxruntime
+
+#if defined(ORT_PERF_TEST_ALLOCATION_AUDIT)
+
+// Replacements of the global allocation functions, counting the allocations while an audit is active. The other
+// forms of operator new and delete default to these.
+
+static void* AuditedAlloc(std::size_t size, std::size_t alignment) {
+  onnxruntime::perftest::allocation_audit::RecordAllocation(size);
+  if (size == 0) {
+    size = 1;
+  }
+
+  void* p = nullptr;
+  if (alignment <= alignof(std::max_align_t)) {
+    p = std::malloc(size);
+  } else if (posix_memalign(&p, alignment, size) != 0) {
+    p = nullptr;
+  }
+
+  if (p == nullptr) {
+#ifdef ORT_NO_EXCEPTIONS
+    std::abort();
+#else
+    throw std::bad_alloc();
+#endif
+  }
+
+  return p;
+}
+
+void* operator new(std::size_t size) {
+  return AuditedAlloc(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return AuditedAlloc(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+#endif
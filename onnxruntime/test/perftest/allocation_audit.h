@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+
+namespace onnxruntime {
+namespace perftest {
+
+// Counts the heap allocations made with operator new by any thread of the process while an audit is active, e.g.
+// while a warm Run executes. This replaces the global operator new of the executable, so allocations of the
+// onnxruntime library are seen where the platform resolves them to the executable's operator new (ELF platforms).
+// Allocations made with malloc directly, or by the device allocators, are not counted.
+namespace allocation_audit {
+
+// Whether allocations can be counted in this build.
+bool IsSupported();
+
+// Starts counting allocations, recording the call stacks of the first `max_stacks` of them.
+void Start(size_t max_stacks);
+
+struct Result {
+  size_t allocations{0};
+  size_t bytes{0};
+};
+
+// Stops counting and returns the allocations made since Start.
+Result Stop();
+
+// Writes the recorded call stacks of the last audit.
+void WriteStacks(std::ostream& os);
+
+}  // namespace allocation_audit
+}  // namespace perftest
+}  // namespace onnxruntime
@@ -113,6 +113,7 @@ namespace perftest {
       "\t    [TensorRT only] [trt_engine_cache_path]: Specify engine cache path.\n"
       "\t    [TensorRT only] [trt_engine_cache_prefix]: Customize engine cache prefix when trt_engine_cache_enable is true.\n"
       "\t    [TensorRT only] [trt_engine_hw_compatible]: Enable hardware compatibility. Engines ending with '_sm80+' can be re-used across all Ampere+ GPU (a hardware-compatible engine may have lower throughput and/or higher latency than its non-hardware-compatible counterpart).\n"
+      "\t    [TensorRT only] [trt_async_engine_build]: Build the engines of new shape profiles in the background and run quickly built engines meanwhile.\n"
       "\t    [TensorRT only] [trt_weight_stripped_engine_enable]: Enable weight-stripped engine build.\n"
       "\t    [TensorRT only] [trt_onnx_model_folder_path]: Folder path for the ONNX model with weights.\n"
       "\t    [TensorRT only] [trt_force_sequential_engine_build]: Force TensorRT engines to be built sequentially.\n"
@@ -127,6 +128,7 @@ namespace perftest {
       "\t    [Example] [For NNAPI EP] -e nnapi -i \"NNAPI_FLAG_USE_FP16 NNAPI_FLAG_USE_NCHW NNAPI_FLAG_CPU_DISABLED\"\n"
       "\n"
       "\t    [CoreML only] [COREML_FLAG_CREATE_MLPROGRAM]: Create an ML Program model instead of Neural Network.\n"
+      "\t    [CoreML only] [COREML_FLAG_ENABLE_COMPILED_MODEL_CACHE]: Reuse compiled CoreML models across sessions.\n"
       "\t    [Example] [For CoreML EP] -e coreml -i \"COREML_FLAG_CREATE_MLPROGRAM\"\n"
       "\n"
       "\t    [SNPE only] [runtime]: SNPE runtime, options: 'CPU', 'GPU', 'GPU_FLOAT16', 'DSP', 'AIP_FIXED_TF'. \n"
@@ -143,6 +145,16 @@ namespace perftest {
       "\t-D [Disable thread spinning]: disable spinning entirely for thread owned by onnxruntime intra-op thread pool.\n"
       "\t-Z [Force thread to stop spinning between runs]: disallow thread from spinning during runs to reduce cpu usage.\n"
       "\t-n [Exit after session creation]: allow user to measure session creation time to measure impact of enabling any initialization optimizations.\n"
+      "\t-R [auto|<GFLOP/s>:<GB/s>]: Print a roofline report of the achieved GFLOP/s and GB/s of each node, computed from the profile. "
+      "'auto' measures the peak compute and memory bandwidth of the CPU, otherwise the given peaks are used, e.g. for GPUs. "
+      "Enables profiling if -p is not given.\n"
+      "\t-Q [qps1,qps2,...]: Run an open-loop load test instead: requests arrive as a Poisson process at each target QPS in turn, "
+      "and are served by up to -c concurrent runs. Reports the achieved QPS and latency percentiles measured from the arrival time, "
+      "for 'duration' seconds or 'times' requests per QPS.\n"
+      "\t-W [warmup_seconds]: Load test warm-up at each target QPS, excluded from the results. Default:0.\n"
+      "\t-L [num_stacks]: Count the heap allocations of a warm Run before the test, and print the call stacks of the first "
+      "num_stacks of them (at most 64). Requires a platform where the allocations of onnxruntime go through the "
+      "operator new of the executable, e.g. Linux.\n"
       "\t-h: help\n");
 }
 #ifdef _WIN32
@@ -205,7 +217,7 @@ static bool ParseSessionConfigs(const std::string& configs_string,
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:C:AMPIDZvhsqzn"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:C:R:Q:W:L:AMPIDZvhsqzn"))) != -1) {
     switch (ch) {
       case 'f': {
         std::basic_string<ORTCHAR_T> dim_name;
@@ -390,6 +402,52 @@ static bool ParseSessionConfigs(const std::string& configs_string,
       case 'n':
         test_config.run_config.exit_after_session_creation = true;
         break;
+      case 'Q': {
+        std::istringstream ss(ToUTF8String(optarg));
+        std::string token;
+        while (std::getline(ss, token, ',')) {
+          double qps = 0;
+          ORT_TRY {
+            qps = std::stod(token);
+          }
+          ORT_CATCH(...) {
+            return false;
+          }
+          if (qps <= 0) {
+            return false;
+          }
+          test_config.run_config.load_qps.push_back(qps);
+        }
+        if (test_config.run_config.load_qps.empty()) {
+          return false;
+        }
+        break;
+      }
+      case 'W': {
+        long warmup_seconds = OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr);
+        if (warmup_seconds < 0) {
+          return false;
+        }
+        test_config.run_config.load_warmup_seconds = static_cast<size_t>(warmup_seconds);
+        break;
+      }
+      case 'L': {
+        long num_stacks = OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr);
+        if (num_stacks < 0) {
+          return false;
+        }
+        test_config.run_config.allocation_audit = true;
+        test_config.run_config.allocation_audit_stacks = static_cast<size_t>(num_stacks);
+        break;
+      }
+      case 'R': {
+        test_config.run_config.roofline_report = true;
+        const std::string peak_str = ToUTF8String(optarg);
+        if (peak_str != "auto" && !ParseHardwarePeak(peak_str, test_config.run_config.roofline_peak)) {
+          return false;
+        }
+        break;
+      }
       case '?':
       case 'h':
       default:
@@ -414,6 +472,10 @@ static bool ParseSessionConfigs(const std::string& configs_string,
 
   test_config.model_info.model_file_path = argv[0];
 
+  if (test_config.run_config.roofline_report && test_config.run_config.profile_file.empty()) {
+    test_config.run_config.profile_file = ORT_TSTR("onnxruntime_perf_test_roofline");
+  }
+
   return true;
 }
 
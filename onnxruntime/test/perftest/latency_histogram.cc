@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace onnxruntime {
+namespace perftest {
+
+// Bucket layout: values below kSubBuckets map to themselves. Above that, the range [2^e, 2^(e+1)) for
+// e >= kSubBucketBits is covered by kSubBuckets / 2 buckets, as the leading bit is implied.
+LatencyHistogram::LatencyHistogram()
+    : buckets_(kSubBuckets + (kMaxExponent - kSubBucketBits) * (kSubBuckets / 2), 0) {}
+
+size_t LatencyHistogram::BucketIndex(uint64_t value) {
+  if (value < kSubBuckets) {
+    return static_cast<size_t>(value);
+  }
+
+  int exponent = 0;
+  for (uint64_t v = value; v > 1; v >>= 1) {
+    ++exponent;
+  }
+
+  if (exponent >= kMaxExponent) {
+    return kSubBuckets + (kMaxExponent - kSubBucketBits) * (kSubBuckets / 2) - 1;
+  }
+
+  // keep the kSubBucketBits most significant bits, drop the implied leading one.
+  const int shift = exponent - (kSubBucketBits - 1);
+  const uint64_t sub_bucket = (value >> shift) - kSubBuckets / 2;
+  return static_cast<size_t>(kSubBuckets + (exponent - kSubBucketBits) * (kSubBuckets / 2) + sub_bucket);
+}
+
+double LatencyHistogram::BucketUpperBound(size_t index) {
+  if (index < kSubBuckets) {
+    return static_cast<double>(index);
+  }
+
+  const size_t offset = index - kSubBuckets;
+  const int exponent = static_cast<int>(offset / (kSubBuckets / 2)) + kSubBucketBits;
+  const uint64_t sub_bucket = offset % (kSubBuckets / 2) + kSubBuckets / 2;
+  const int shift = exponent - (kSubBucketBits - 1);
+  return std::ldexp(static_cast<double>(sub_bucket + 1), shift) - 1;
+}
+
+void LatencyHistogram::Record(double latency_us) {
+  latency_us = std::max(latency_us, 0.0);
+  ++buckets_[BucketIndex(static_cast<uint64_t>(latency_us))];
+
+  min_us_ = count_ == 0 ? latency_us : std::min(min_us_, latency_us);
+  max_us_ = std::max(max_us_, latency_us);
+  sum_us_ += latency_us;
+  ++count_;
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+  if (other.count_ == 0) {
+    return;
+  }
+
+  for (size_t i = 0; i < buckets_.size(); ++i) {
+    buckets_[i] += other.buckets_[i];
+  }
+
+  min_us_ = count_ == 0 ? other.min_us_ : std::min(min_us_, other.min_us_);
+  max_us_ = std::max(max_us_, other.max_us_);
+  sum_us_ += other.sum_us_;
+  count_ += other.count_;
+}
+
+double LatencyHistogram::Percentile(double percentile) const {
+  if (count_ == 0) {
+    return 0;
+  }
+
+  const auto rank = static_cast<uint64_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 *
+                                                    static_cast<double>(count_)));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets_.size(); ++i) {
+    seen += buckets_[i];
+    if (seen >= std::max<uint64_t>(rank, 1)) {
+      // the bucket bound can exceed the largest value recorded
+      return std::min(BucketUpperBound(i), max_us_);
+    }
+  }
+
+  return max_us_;
+}
+
+}  // namespace perftest
+}  // namespace onnxruntime
@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace onnxruntime {
+namespace perftest {
+
+// Latency histogram with log-linear buckets in the style of HdrHistogram: every power of two range of microseconds
+// is split into kSubBuckets / 2 linear buckets, so any recorded value is reported within 2/kSubBuckets of its actual
+// value regardless of magnitude, using a fixed amount of memory.
+// Not thread safe. Record into one histogram per thread and Merge them.
+class LatencyHistogram {
+ public:
+  LatencyHistogram();
+
+  void Record(double latency_us);
+
+  void Merge(const LatencyHistogram& other);
+
+  // Latency at `percentile` (0 - 100), as the upper bound of the bucket containing it.
+  double Percentile(double percentile) const;
+
+  uint64_t Count() const { return count_; }
+  double Min() const { return count_ > 0 ? min_us_ : 0; }
+  double Max() const { return max_us_; }
+  double Mean() const { return count_ > 0 ? sum_us_ / static_cast<double>(count_) : 0; }
+
+ private:
+  static constexpr int kSubBucketBits = 7;
+  static constexpr uint64_t kSubBuckets = uint64_t{1} << kSubBucketBits;
+  // values up to 2^40 us (~12 days) are tracked exactly, larger ones are clamped.
+  static constexpr int kMaxExponent = 40;
+
+  static size_t BucketIndex(uint64_t value);
+  static double BucketUpperBound(size_t index);
+
+  std::vector<uint64_t> buckets_;
+  uint64_t count_{0};
+  double sum_us_{0};
+  double min_us_{0};
+  double max_us_{0};
+};
+
+}  // namespace perftest
+}  // namespace onnxruntime
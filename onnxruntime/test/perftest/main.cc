@@ -56,7 +56,10 @@ int real_main(int argc, char* argv[]) {
     return -1;
   }
 
-  perf_runner.SerializeResult();
+  // the load test writes its own results
+  if (test_config.run_config.load_qps.empty()) {
+    perf_runner.SerializeResult();
+  }
 
   return 0;
 }
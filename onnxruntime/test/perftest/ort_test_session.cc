@@ -13,6 +13,7 @@
 #include "core/providers/tensorrt/tensorrt_provider_options.h"
 #include "core/providers/dnnl/dnnl_provider_options.h"
 #include <assert.h>
+#include "core/common/path_string.h"
 #include "providers.h"
 #include "TestCase.h"
 
@@ -42,6 +43,12 @@ std::chrono::duration<double> OnnxRuntimeTestSession::Run() {
   return duration_seconds;
 }
 
+std::basic_string<ORTCHAR_T> OnnxRuntimeTestSession::EndProfiling() {
+  Ort::AllocatorWithDefaultOptions allocator;
+  auto profile_file = session_.EndProfilingAllocated(allocator);
+  return ToPathString(std::string(profile_file.get()));
+}
+
 OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device& rd,
                                                const PerformanceTestConfig& performance_test_config,
                                                const TestModelInfo& m)
@@ -416,11 +423,15 @@ select from 'TF8', 'TF16', 'UINT8', 'FLOAT', 'ITENSOR'. \n)");
       if (key == "COREML_FLAG_CREATE_MLPROGRAM") {
         coreml_flags |= COREML_FLAG_CREATE_MLPROGRAM;
         std::cout << "Enabling ML Program.\n";
+      } else if (key == "COREML_FLAG_ENABLE_COMPILED_MODEL_CACHE") {
+        coreml_flags |= COREML_FLAG_ENABLE_COMPILED_MODEL_CACHE;
+        std::cout << "Enabling the compiled model cache.\n";
       } else if (key.empty()) {
       } else {
         ORT_THROW(
             "[ERROR] [CoreML] wrong key type entered. Choose from the following runtime key options "
-            "that are available for CoreML. ['COREML_FLAG_CREATE_MLPROGRAM'] \n");
+            "that are available for CoreML. ['COREML_FLAG_CREATE_MLPROGRAM', "
+            "'COREML_FLAG_ENABLE_COMPILED_MODEL_CACHE'] \n");
       }
     }
     // COREML_FLAG_CREATE_MLPROGRAM
@@ -31,6 +31,9 @@ class OnnxRuntimeTestSession : public TestSession {
 
   std::chrono::duration<double> Run() override;
 
+  // Stops profiling and returns the file the profile was written to.
+  std::basic_string<ORTCHAR_T> EndProfiling();
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(OnnxRuntimeTestSession);
 
  private:
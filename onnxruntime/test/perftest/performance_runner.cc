@@ -7,9 +7,13 @@
 #endif
 
 #include "performance_runner.h"
+#include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <thread>
 
 #include "TestCase.h"
+#include "allocation_audit.h"
 #include "utils.h"
 #include "ort_test_session.h"
 using onnxruntime::Status;
@@ -126,6 +130,14 @@ Status PerformanceRunner::Run() {
   ORT_RETURN_IF_ERROR(RunOneIteration<true>());
   initial_inference_result_.end = std::chrono::high_resolution_clock::now();
 
+  if (performance_test_config_.run_config.allocation_audit) {
+    ORT_RETURN_IF_ERROR(AuditAllocations());
+  }
+
+  if (!performance_test_config_.run_config.load_qps.empty()) {
+    return LoadTest();
+  }
+
   // TODO: start profiling
   // if (!performance_test_config_.run_config.profile_file.empty())
   performance_result_.start = std::chrono::high_resolution_clock::now();
@@ -165,6 +177,35 @@ Status PerformanceRunner::Run() {
             << "Peak working set size: " << performance_result_.peak_workingset_size << " bytes"
             << std::endl;
 
+  const auto& run_config = performance_test_config_.run_config;
+  if (run_config.roofline_report) {
+    auto profile_file = static_cast<OnnxRuntimeTestSession*>(session_.get())->EndProfiling();
+    HardwarePeak peak = run_config.roofline_peak;
+    if (peak.gflops_per_second <= 0) {
+      peak = MeasureCpuPeak(run_config.intra_op_num_threads);
+    }
+    ORT_RETURN_IF_ERROR(WriteRooflineReport(profile_file, peak, std::cout));
+  }
+
+  return Status::OK();
+}
+
+Status PerformanceRunner::AuditAllocations() {
+  if (!allocation_audit::IsSupported()) {
+    std::cout << "Heap allocation audit is not supported on this platform." << std::endl;
+    return Status::OK();
+  }
+
+  // the first Runs may still allocate caches, e.g. the memory patterns
+  ORT_RETURN_IF_ERROR(RunOneIteration<true>());
+
+  allocation_audit::Start(performance_test_config_.run_config.allocation_audit_stacks);
+  auto status = RunOneIteration<true>();
+  const auto result = allocation_audit::Stop();
+  ORT_RETURN_IF_ERROR(status);
+
+  std::cout << "Heap allocations in a warm Run: " << result.allocations << " (" << result.bytes << " bytes)\n";
+  allocation_audit::WriteStacks(std::cout);
   return Status::OK();
 }
 
@@ -255,6 +296,139 @@ Status PerformanceRunner::ForkJoinRepeat() {
   return Status::OK();
 }
 
+Status PerformanceRunner::LoadTest() {
+  const auto& run_config = performance_test_config_.run_config;
+  const auto& result_file_path = performance_test_config_.model_info.result_file_path;
+  std::ofstream result_file;
+  if (!result_file_path.empty()) {
+    result_file.open(result_file_path, std::ofstream::out | std::ofstream::app);
+  }
+
+  std::cout << "\nOpen-loop load test with " << std::max<size_t>(run_config.concurrent_session_runs, 1)
+            << " concurrent runs. Latencies in ms, measured from the request arrival.\n"
+            << std::left << std::setw(14) << "Target QPS" << std::right << std::setw(14) << "Achieved QPS"
+            << std::setw(10) << "Requests" << std::setw(10) << "Mean" << std::setw(10) << "P50"
+            << std::setw(10) << "P95" << std::setw(10) << "P99" << std::setw(10) << "P999"
+            << std::setw(10) << "Max" << std::endl;
+
+  for (const double qps : run_config.load_qps) {
+    if (run_config.load_warmup_seconds > 0) {
+      LatencyHistogram warmup_histogram;
+      double warmup_seconds = 0;
+      const auto warmup_requests = static_cast<size_t>(std::ceil(qps * run_config.load_warmup_seconds));
+      ORT_RETURN_IF_ERROR(RunOpenLoop(qps, warmup_requests, warmup_histogram, warmup_seconds));
+    }
+
+    const size_t num_requests = run_config.test_mode == TestMode::KFixRepeatedTimesMode
+                                    ? run_config.repeated_times
+                                    : static_cast<size_t>(std::ceil(qps * run_config.duration_in_seconds));
+    LatencyHistogram histogram;
+    double elapsed_seconds = 0;
+    ORT_RETURN_IF_ERROR(RunOpenLoop(qps, num_requests, histogram, elapsed_seconds));
+
+    const double achieved_qps = elapsed_seconds > 0 ? static_cast<double>(histogram.Count()) / elapsed_seconds : 0;
+    const double p50 = histogram.Percentile(50) / 1000;
+    const double p95 = histogram.Percentile(95) / 1000;
+    const double p99 = histogram.Percentile(99) / 1000;
+    const double p999 = histogram.Percentile(99.9) / 1000;
+
+    std::cout << std::fixed << std::setprecision(2) << std::left << std::setw(14) << qps << std::right
+              << std::setw(14) << achieved_qps << std::setw(10) << histogram.Count()
+              << std::setw(10) << histogram.Mean() / 1000 << std::setw(10) << p50 << std::setw(10) << p95
+              << std::setw(10) << p99 << std::setw(10) << p999 << std::setw(10) << histogram.Max() / 1000
+              << (achieved_qps < 0.95 * qps ? "  (saturated)" : "") << std::defaultfloat << std::endl;
+
+    if (result_file.is_open()) {
+      result_file << performance_result_.model_name << "," << qps << "," << achieved_qps << ","
+                  << histogram.Count() << "," << histogram.Mean() / 1000 << "," << p50 << "," << p95 << ","
+                  << p99 << "," << p999 << "," << histogram.Max() / 1000 << std::endl;
+    }
+  }
+
+  return Status::OK();
+}
+
+Status PerformanceRunner::RunOpenLoop(double qps, size_t num_requests, LatencyHistogram& histogram,
+                                      double& elapsed_seconds) {
+  using Clock = std::chrono::steady_clock;
+
+  // offsets of the request arrivals from the start of the test
+  std::vector<Clock::duration> arrivals(num_requests);
+  std::exponential_distribution<double> interarrival_seconds(qps);
+  double arrival_seconds = 0;
+  for (auto& arrival : arrivals) {
+    arrival_seconds += interarrival_seconds(load_rng_);
+    arrival = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(arrival_seconds));
+  }
+
+  const size_t num_workers = std::max<size_t>(performance_test_config_.run_config.concurrent_session_runs, 1);
+  auto tpool = std::make_unique<DefaultThreadPoolType>(static_cast<int>(num_workers));
+  std::vector<LatencyHistogram> worker_histograms(num_workers);
+  std::atomic<size_t> next_request{0};
+  std::atomic<int> counter{0};
+  Status status;
+  OrtMutex m;
+  OrtCondVar cv;
+
+  const auto start = Clock::now();
+  auto end = start;
+
+  // Fork. Each worker serves the earliest request that has not been taken yet, waiting for it to arrive if needed.
+  for (size_t w = 0; w != num_workers; ++w) {
+    counter++;
+    tpool->Schedule([this, w, start, num_requests, &arrivals, &worker_histograms, &next_request, &counter, &status,
+                     &end, &m, &cv]() {
+      size_t request;
+      while ((request = next_request++) < num_requests) {
+        const auto arrival = start + arrivals[request];
+        std::this_thread::sleep_until(arrival);
+
+        auto run_status = Status::OK();
+        ORT_TRY {
+          session_->Run();
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            run_status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "PerformanceRunner::RunOpenLoop caught exception: ",
+                                         ex.what());
+          });
+        }
+
+        const auto completion = Clock::now();
+        if (!run_status.IsOK()) {
+          std::lock_guard<OrtMutex> lg(m);
+          status = run_status;
+          next_request = num_requests;
+          break;
+        }
+
+        worker_histograms[w].Record(std::chrono::duration<double, std::micro>(completion - arrival).count());
+        std::lock_guard<OrtMutex> lg(m);
+        end = std::max(end, completion);
+      }
+
+      // Simplified version of Eigen::Barrier
+      std::lock_guard<OrtMutex> lg(m);
+      counter--;
+      cv.notify_all();
+    });
+  }
+
+  // Join
+  {
+    std::unique_lock<OrtMutex> lock(m);
+    cv.wait(lock, [&counter]() { return counter == 0; });
+  }
+  ORT_RETURN_IF_ERROR(status);
+
+  for (const auto& worker_histogram : worker_histograms) {
+    histogram.Merge(worker_histogram);
+  }
+  elapsed_seconds = std::chrono::duration<double>(end - start).count();
+
+  return Status::OK();
+}
+
 static std::unique_ptr<TestModelInfo> CreateModelInfo(const PerformanceTestConfig& performance_test_config_) {
   const auto& file_path = performance_test_config_.model_info.model_file_path;
 #if !defined(ORT_MINIMAL_BUILD)
@@ -272,7 +446,10 @@ static std::unique_ptr<TestModelInfo> CreateModelInfo(const PerformanceTestConfi
 
 PerformanceRunner::PerformanceRunner(Ort::Env& env, const PerformanceTestConfig& test_config, std::random_device& rd)
     : performance_test_config_(test_config),
-      test_model_info_(CreateModelInfo(test_config)) {
+      test_model_info_(CreateModelInfo(test_config)),
+      load_rng_(test_config.run_config.random_seed_for_input_data >= 0
+                    ? static_cast<std::mt19937::result_type>(test_config.run_config.random_seed_for_input_data)
+                    : rd()) {
   session_create_start_ = std::chrono::high_resolution_clock::now();
   session_ = std::make_unique<OnnxRuntimeTestSession>(env, rd, performance_test_config_, *test_model_info_);
   session_create_end_ = std::chrono::high_resolution_clock::now();
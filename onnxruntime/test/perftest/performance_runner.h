@@ -18,6 +18,7 @@
 #include <core/session/onnxruntime_cxx_api.h>
 #include "test_configuration.h"
 #include "heap_buffer.h"
+#include "latency_histogram.h"
 #include "test_session.h"
 #include "OrtValueList.h"
 
@@ -86,11 +87,20 @@ class PerformanceRunner {
     return Status::OK();
   }
 
+  // Counts the heap allocations of a warm Run, see RunConfig::allocation_audit.
+  Status AuditAllocations();
+
   Status FixDurationTest();
   Status RepeatedTimesTest();
   Status ForkJoinRepeat();
   Status RunParallelDuration();
 
+  // Open-loop load test at each of the RunConfig::load_qps rates.
+  Status LoadTest();
+  // Issues num_requests requests with Poisson arrivals at `qps`, and records the latency of each from its arrival
+  // time, so time spent waiting for a free worker is included.
+  Status RunOpenLoop(double qps, size_t num_requests, LatencyHistogram& histogram, double& elapsed_seconds);
+
   inline Status RunFixDuration() {
     while (performance_result_.total_time_cost < performance_test_config_.run_config.duration_in_seconds) {
       ORT_RETURN_IF_ERROR(RunOneIteration<false>());
@@ -115,6 +125,8 @@ class PerformanceRunner {
   std::unique_ptr<TestSession> session_;
   onnxruntime::test::HeapBuffer b_;
   std::unique_ptr<ITestCase> test_case_;
+  // seeds the arrival times of the load test
+  std::mt19937 load_rng_;
 
   OrtMutex results_mutex_;
 };
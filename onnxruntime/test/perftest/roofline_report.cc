@@ -0,0 +1,401 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "roofline_report.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+#include "nlohmann/json.hpp"
+
+#include <core/common/common.h>
+#include <core/platform/path_lib.h>
+
+namespace onnxruntime {
+namespace perftest {
+
+namespace {
+
+using Shapes = std::vector<std::vector<int64_t>>;
+using CostModel = std::function<bool(const Shapes& inputs, const Shapes& outputs, double& flops)>;
+
+double NumElements(const std::vector<int64_t>& shape) {
+  return std::accumulate(shape.begin(), shape.end(), 1.0,
+                         [](double total, int64_t dim) { return total * static_cast<double>(dim); });
+}
+
+// Cost model for ops doing `flops_per_element` operations per output element.
+CostModel PerOutputElement(double flops_per_element) {
+  return [flops_per_element](const Shapes& /*inputs*/, const Shapes& outputs, double& flops) {
+    if (outputs.empty()) {
+      return false;
+    }
+    flops = flops_per_element * NumElements(outputs[0]);
+    return true;
+  };
+}
+
+// Cost model for ops doing `flops_per_element` operations per element of their first input.
+CostModel PerInputElement(double flops_per_element) {
+  return [flops_per_element](const Shapes& inputs, const Shapes& /*outputs*/, double& flops) {
+    if (inputs.empty()) {
+      return false;
+    }
+    flops = flops_per_element * NumElements(inputs[0]);
+    return true;
+  };
+}
+
+// A multiply-add per output element for each element of the reduced dimension, which is the last dimension of A.
+// Also used for MatMulNBits and the quantized variants, whose B input is packed.
+bool MatMulCost(const Shapes& inputs, const Shapes& outputs, double& flops) {
+  if (inputs.empty() || outputs.empty() || inputs[0].empty()) {
+    return false;
+  }
+  flops = 2.0 * NumElements(outputs[0]) * static_cast<double>(inputs[0].back());
+  return true;
+}
+
+// A is [M, K] or [K, M] depending on transA. Either way K is the number of elements of A over the M rows of Y.
+bool GemmCost(const Shapes& inputs, const Shapes& outputs, double& flops) {
+  if (inputs.empty() || outputs.empty() || outputs[0].size() != 2 || outputs[0][0] == 0) {
+    return false;
+  }
+  const double k = NumElements(inputs[0]) / static_cast<double>(outputs[0][0]);
+  flops = 2.0 * NumElements(outputs[0]) * k;
+  return true;
+}
+
+// W is [M, C / group, k1, k2, ...], so each output element takes numel(W) / M multiply-adds.
+bool ConvCost(const Shapes& inputs, const Shapes& outputs, double& flops) {
+  if (inputs.size() < 2 || outputs.empty() || inputs[1].empty() || inputs[1][0] == 0) {
+    return false;
+  }
+  const double macs_per_output = NumElements(inputs[1]) / static_cast<double>(inputs[1][0]);
+  flops = 2.0 * NumElements(outputs[0]) * macs_per_output;
+  return true;
+}
+
+// W is [C, M / group, k1, k2, ...], so each input element is scattered with numel(W) / C multiply-adds.
+bool ConvTransposeCost(const Shapes& inputs, const Shapes& /*outputs*/, double& flops) {
+  if (inputs.size() < 2 || inputs[1].empty() || inputs[1][0] == 0) {
+    return false;
+  }
+  const double macs_per_input = NumElements(inputs[1]) / static_cast<double>(inputs[1][0]);
+  flops = 2.0 * NumElements(inputs[0]) * macs_per_input;
+  return true;
+}
+
+// The per element costs of the non-linear ops are rough averages, as the actual cost depends on the approximation
+// used by the kernel.
+const std::unordered_map<std::string, CostModel>& CostModels() {
+  static const std::unordered_map<std::string, CostModel> cost_models = [] {
+    std::unordered_map<std::string, CostModel> models;
+
+    for (const char* op : {"MatMul", "FusedMatMul", "MatMulInteger", "QLinearMatMul", "MatMulIntegerToFloat",
+                           "DynamicQuantizeMatMul", "MatMulNBits", "MatMulBnb4", "TransposeMatMul"}) {
+      models.emplace(op, MatMulCost);
+    }
+
+    models.emplace("Gemm", GemmCost);
+
+    for (const char* op : {"Conv", "FusedConv", "NhwcFusedConv", "QLinearConv", "ConvInteger", "NhwcConv"}) {
+      models.emplace(op, ConvCost);
+    }
+
+    models.emplace("ConvTranspose", ConvTransposeCost);
+
+    for (const char* op : {"Add", "Sub", "Mul", "Div", "Max", "Min", "Mean", "Sum", "Abs", "Neg", "Relu", "Sign",
+                           "Floor", "Ceil", "Round", "Clip", "Where", "Equal", "Less", "LessOrEqual", "Greater",
+                           "GreaterOrEqual", "And", "Or", "Xor", "Not", "LeakyRelu", "PRelu", "Reciprocal",
+                           "BiasAdd", "QuickGelu"}) {
+      models.emplace(op, PerOutputElement(1.0));
+    }
+
+    for (const char* op : {"Sqrt", "Exp", "Log", "Pow", "Sigmoid", "Tanh", "Erf", "HardSigmoid", "Softplus",
+                           "Elu", "Selu", "Celu", "Mish", "HardSwish"}) {
+      models.emplace(op, PerOutputElement(4.0));
+    }
+
+    for (const char* op : {"Gelu", "FastGelu", "BiasGelu"}) {
+      models.emplace(op, PerOutputElement(8.0));
+    }
+
+    for (const char* op : {"Softmax", "LogSoftmax"}) {
+      models.emplace(op, PerOutputElement(5.0));
+    }
+
+    for (const char* op : {"LayerNormalization", "SimplifiedLayerNormalization", "SkipLayerNormalization",
+                           "SkipSimplifiedLayerNormalization", "GroupNorm", "InstanceNormalization"}) {
+      models.emplace(op, PerOutputElement(8.0));
+    }
+
+    models.emplace("BatchNormalization", PerOutputElement(2.0));
+
+    for (const char* op : {"ReduceSum", "ReduceMean", "ReduceMax", "ReduceMin", "ReduceProd", "ReduceL1",
+                           "ReduceL2", "ReduceSumSquare", "GlobalAveragePool", "GlobalMaxPool", "AveragePool",
+                           "MaxPool"}) {
+      models.emplace(op, PerInputElement(1.0));
+    }
+
+    // data movement only
+    for (const char* op : {"Reshape", "Transpose", "Concat", "Split", "Slice", "Gather", "GatherElements",
+                           "GatherND", "Squeeze", "Unsqueeze", "Flatten", "Expand", "Tile", "Pad", "Identity",
+                           "Cast", "Shape", "MemcpyFromHost", "MemcpyToHost"}) {
+      models.emplace(op, PerOutputElement(0.0));
+    }
+
+    return models;
+  }();
+
+  return cost_models;
+}
+
+// Shapes from the "input_type_shape"/"output_type_shape" args, e.g. [{"float":[1,3,224,224]},{"int64":[2]}].
+Shapes ParseTypeShapes(const nlohmann::json& type_shapes) {
+  Shapes shapes;
+  if (!type_shapes.is_array()) {
+    return shapes;
+  }
+
+  for (const auto& type_shape : type_shapes) {
+    for (const auto& item : type_shape.items()) {
+      shapes.push_back(item.value().get<std::vector<int64_t>>());
+    }
+  }
+
+  return shapes;
+}
+
+double ArgAsDouble(const nlohmann::json& args, const char* name) {
+  auto it = args.find(name);
+  if (it == args.end()) {
+    return 0;
+  }
+  return it->is_string() ? std::stod(it->get<std::string>()) : it->get<double>();
+}
+
+struct NodeStats {
+  std::string op_type;
+  std::string provider;
+  size_t calls{0};
+  double total_us{0};
+  double total_flops{0};
+  double total_bytes{0};
+  bool has_cost_model{true};
+};
+
+}  // namespace
+
+bool ParseHardwarePeak(const std::string& str, HardwarePeak& peak) {
+  const auto pos = str.find(':');
+  if (pos == std::string::npos) {
+    return false;
+  }
+
+  ORT_TRY {
+    peak.gflops_per_second = std::stod(str.substr(0, pos));
+    peak.gbytes_per_second = std::stod(str.substr(pos + 1));
+  }
+  ORT_CATCH(...) {
+    return false;
+  }
+
+  return peak.gflops_per_second > 0 && peak.gbytes_per_second > 0;
+}
+
+HardwarePeak MeasureCpuPeak(int num_threads) {
+  if (num_threads <= 0) {
+    num_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  }
+
+  // Runs fn on num_threads threads and returns the elapsed seconds.
+  auto run_threads = [num_threads](const std::function<void(int)>& fn) {
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back(fn, t);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+    return duration.count();
+  };
+
+  HardwarePeak peak;
+  std::atomic<double> sink{0};
+
+  // Independent multiply-add chains, enough of them to hide the FMA latency once vectorized.
+  constexpr int kLanes = 128;
+  constexpr int kFmaIterations = 1 << 18;
+  const double fma_seconds = run_threads([&sink](int) {
+    float acc[kLanes];
+    for (int i = 0; i < kLanes; ++i) {
+      acc[i] = static_cast<float>(i);
+    }
+    const float a = 0.999999f;
+    const float b = 1e-7f;
+    for (int iter = 0; iter < kFmaIterations; ++iter) {
+      for (int i = 0; i < kLanes; ++i) {
+        acc[i] = acc[i] * a + b;
+      }
+    }
+    sink = sink + std::accumulate(acc, acc + kLanes, 0.0);
+  });
+  peak.gflops_per_second = 2.0 * kLanes * kFmaIterations * num_threads / fma_seconds / 1e9;
+
+  // Read bandwidth over a buffer much larger than the last level cache. Best of a few passes.
+  constexpr size_t kBytesPerThread = size_t{64} * 1024 * 1024;
+  std::vector<std::vector<float>> buffers(num_threads, std::vector<float>(kBytesPerThread / sizeof(float), 1.0f));
+  double best_seconds = std::numeric_limits<double>::max();
+  for (int pass = 0; pass < 3; ++pass) {
+    best_seconds = std::min(best_seconds, run_threads([&buffers, &sink](int t) {
+      const auto& buffer = buffers[t];
+      float sum[16] = {};
+      for (size_t i = 0; i + 16 <= buffer.size(); i += 16) {
+        for (int j = 0; j < 16; ++j) {
+          sum[j] += buffer[i + j];
+        }
+      }
+      sink = sink + std::accumulate(sum, sum + 16, 0.0);
+    }));
+  }
+  peak.gbytes_per_second = static_cast<double>(kBytesPerThread) * num_threads / best_seconds / 1e9;
+
+  return peak;
+}
+
+bool EstimateNodeFlops(const std::string& op_type, const Shapes& input_shapes, const Shapes& output_shapes,
+                       double& flops) {
+  const auto& cost_models = CostModels();
+  auto it = cost_models.find(op_type);
+  if (it == cost_models.end()) {
+    return false;
+  }
+  return it->second(input_shapes, output_shapes, flops);
+}
+
+Status WriteRooflineReport(const std::basic_string<ORTCHAR_T>& profile_file, const HardwarePeak& peak,
+                           std::ostream& os) {
+  std::ifstream ifs(profile_file.c_str());
+  ORT_RETURN_IF_NOT(ifs.good(), "Failed to open profile file ", ToUTF8String(profile_file));
+
+  nlohmann::json events = nlohmann::json::parse(ifs, nullptr, /*allow_exceptions*/ false);
+  ORT_RETURN_IF(events.is_discarded() || !events.is_array(), "Failed to parse profile file ",
+                ToUTF8String(profile_file));
+
+  // node name -> stats, in order of first execution
+  std::vector<std::string> node_names;
+  std::unordered_map<std::string, NodeStats> node_stats;
+  constexpr std::string_view kKernelTimeSuffix = "_kernel_time";
+
+  for (const auto& event : events) {
+    if (event.value("cat", "") != "Node" || !event.contains("args")) {
+      continue;
+    }
+
+    const std::string name = event.value("name", "");
+    if (name.size() <= kKernelTimeSuffix.size() ||
+        name.compare(name.size() - kKernelTimeSuffix.size(), kKernelTimeSuffix.size(), kKernelTimeSuffix) != 0) {
+      continue;
+    }
+
+    const auto& args = event["args"];
+    const std::string node_name = name.substr(0, name.size() - kKernelTimeSuffix.size());
+    auto [it, inserted] = node_stats.try_emplace(node_name);
+    auto& stats = it->second;
+    if (inserted) {
+      node_names.push_back(node_name);
+      stats.op_type = args.value("op_name", "");
+      stats.provider = args.value("provider", "");
+      // the first execution is the warm-up run, which includes one-off costs
+      continue;
+    }
+
+    double flops = 0;
+    if (stats.has_cost_model &&
+        EstimateNodeFlops(stats.op_type, ParseTypeShapes(args.value("input_type_shape", nlohmann::json())),
+                          ParseTypeShapes(args.value("output_type_shape", nlohmann::json())), flops)) {
+      stats.total_flops += flops;
+    } else {
+      stats.has_cost_model = false;
+    }
+
+    stats.total_bytes += ArgAsDouble(args, "activation_size") + ArgAsDouble(args, "parameter_size") +
+                         ArgAsDouble(args, "output_size");
+    stats.total_us += event.value("dur", 0.0);
+    ++stats.calls;
+  }
+
+  // slowest nodes first
+  node_names.erase(std::remove_if(node_names.begin(), node_names.end(),
+                                  [&node_stats](const std::string& n) { return node_stats[n].calls == 0; }),
+                   node_names.end());
+  std::stable_sort(node_names.begin(), node_names.end(), [&node_stats](const std::string& a, const std::string& b) {
+    return node_stats[a].total_us > node_stats[b].total_us;
+  });
+
+  const double ridge_point = peak.gflops_per_second / peak.gbytes_per_second;
+  os << "\nRoofline report (" << node_names.size() << " nodes, first run excluded)\n"
+     << "Peak compute: " << std::fixed << std::setprecision(1) << peak.gflops_per_second << " GFLOP/s, "
+     << "peak bandwidth: " << peak.gbytes_per_second << " GB/s, "
+     << "ridge point: " << std::setprecision(2) << ridge_point << " FLOP/byte\n"
+     << "%Roof is the achieved throughput relative to the attainable one at the node's arithmetic intensity.\n"
+     << "Nodes without a cost model only report bandwidth and %Roof against the peak bandwidth.\n\n";
+
+  os << std::left << std::setw(40) << "Node" << std::setw(24) << "Op" << std::right
+     << std::setw(8) << "Calls" << std::setw(12) << "Avg(us)" << std::setw(8) << "%Time"
+     << std::setw(12) << "GFLOP/s" << std::setw(10) << "GB/s" << std::setw(10) << "FLOP/B"
+     << std::setw(8) << "%Roof" << "  Bound\n";
+
+  double total_us = 0;
+  for (const auto& n : node_names) {
+    total_us += node_stats[n].total_us;
+  }
+
+  for (const auto& n : node_names) {
+    const auto& stats = node_stats[n];
+    const double seconds = stats.total_us / 1e6;
+    const double gbytes_per_second = seconds > 0 ? stats.total_bytes / seconds / 1e9 : 0;
+
+    std::string display_name = n.size() > 38 ? n.substr(0, 35) + "..." : n;
+    os << std::left << std::setw(40) << display_name << std::setw(24) << stats.op_type << std::right
+       << std::setw(8) << stats.calls
+       << std::setw(12) << std::setprecision(1) << stats.total_us / static_cast<double>(stats.calls)
+       << std::setw(8) << (total_us > 0 ? 100.0 * stats.total_us / total_us : 0.0);
+
+    if (stats.has_cost_model) {
+      const double gflops_per_second = seconds > 0 ? stats.total_flops / seconds / 1e9 : 0;
+      const double intensity = stats.total_bytes > 0 ? stats.total_flops / stats.total_bytes : 0;
+      const bool memory_bound = intensity < ridge_point;
+      const double attainable = memory_bound ? intensity * peak.gbytes_per_second : peak.gflops_per_second;
+      const double roof = attainable > 0 ? 100.0 * gflops_per_second / attainable
+                                         : 100.0 * gbytes_per_second / peak.gbytes_per_second;
+      os << std::setw(12) << gflops_per_second << std::setw(10) << gbytes_per_second
+         << std::setw(10) << std::setprecision(2) << intensity
+         << std::setw(8) << std::setprecision(1) << roof
+         << "  " << (memory_bound ? "memory" : "compute") << "\n";
+    } else {
+      os << std::setw(12) << "-" << std::setw(10) << gbytes_per_second << std::setw(10) << "-"
+         << std::setw(8) << 100.0 * gbytes_per_second / peak.gbytes_per_second << "  -\n";
+    }
+  }
+
+  os << std::defaultfloat << std::flush;
+  return Status::OK();
+}
+
+}  // namespace perftest
+}  // namespace onnxruntime
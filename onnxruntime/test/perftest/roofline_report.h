@@ -0,0 +1,44 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <core/common/status.h>
+#include <core/session/onnxruntime_c_api.h>
+
+namespace onnxruntime {
+namespace perftest {
+
+// Peak throughput of the hardware the kernels run on.
+struct HardwarePeak {
+  double gflops_per_second{0};
+  double gbytes_per_second{0};
+};
+
+// Parses "<GFLOP/s>:<GB/s>". Returns false if the string is malformed or either value is not positive.
+bool ParseHardwarePeak(const std::string& str, HardwarePeak& peak);
+
+// Measures the peak floating point throughput and memory read bandwidth of the CPU with `num_threads` threads,
+// using short synthetic loops. 0 uses all hardware threads.
+HardwarePeak MeasureCpuPeak(int num_threads);
+
+// Floating point operations of a single node execution, estimated from its input and output shapes.
+// Returns false if there is no cost model for `op_type`.
+bool EstimateNodeFlops(const std::string& op_type,
+                       const std::vector<std::vector<int64_t>>& input_shapes,
+                       const std::vector<std::vector<int64_t>>& output_shapes,
+                       double& flops);
+
+// Reads the node events of a profile written with profiling enabled, and prints the achieved GFLOP/s and GB/s of
+// each node against the roofline defined by `peak`. Bytes moved are the sizes of the node inputs and outputs, so
+// they are a lower bound of the memory traffic.
+Status WriteRooflineReport(const std::basic_string<ORTCHAR_T>& profile_file, const HardwarePeak& peak,
+                           std::ostream& os);
+
+}  // namespace perftest
+}  // namespace onnxruntime
@@ -7,9 +7,11 @@
 #include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "core/graph/constants.h"
 #include "core/framework/session_options.h"
+#include "roofline_report.h"
 
 namespace onnxruntime {
 namespace perftest {
@@ -64,6 +66,16 @@ struct RunConfig {
   bool disable_spinning = false;
   bool disable_spinning_between_run = false;
   bool exit_after_session_creation = false;
+  bool roofline_report = false;
+  // measured with MeasureCpuPeak when not set
+  HardwarePeak roofline_peak;
+  // Open-loop load generation. Requests arrive as a Poisson process at each of these rates in turn and are served by
+  // concurrent_session_runs workers. Empty runs the closed-loop test modes instead.
+  std::vector<double> load_qps;
+  size_t load_warmup_seconds{0};
+  // Counts the heap allocations of a warm Run before the test, printing the call stacks of the first ones.
+  bool allocation_audit{false};
+  size_t allocation_audit_stacks{0};
 };
 
 struct PerformanceTestConfig {
@@ -14,6 +14,9 @@
 #include <algorithm>
 #include <memory>
 #include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -392,6 +395,10 @@ TEST(ThreadPoolTest, TestConcurrentParallelFor_4Thread_4Conc_1MTasks) {
   TestConcurrentParallelFor("TestConcurrentParallelFor_4Thread_4Conc_1MTasks", 4, 4, 1000000);
 }
 
+TEST(ThreadPoolTest, TestConcurrentParallelFor_4Thread_4Conc_1MTasks_hybrid) {
+  TestConcurrentParallelFor("TestConcurrentParallelFor_4Thread_4Conc_1MTasks_hybrid", 4, 4, 1000000, 0, true);
+}
+
 TEST(ThreadPoolTest, TestConcurrentParallelFor_4Thread_4Conc_1MTasks_dynamic_block_base_1) {
   TestConcurrentParallelFor("TestConcurrentParallelFor_4Thread_4Conc_1MTasks_dynamic_block_base_1", 4, 4, 1000000, 1);
 }
@@ -434,6 +441,177 @@ TEST(ThreadPoolTest, TestBurstScheduling_65536Task) {
   TestBurstScheduling("TestBurstScheduling_65536Tasks", 65536);
 }
 
+TEST(ThreadPoolTest, TestNumaAwareScheduling) {
+  // Pin every worker to the first logical processor so that the NUMA topology
+  // can be queried on any machine.  On a single-node host the pool falls back
+  // to regular scheduling, which must be equally correct.
+  constexpr int num_threads = 4;
+  onnxruntime::ThreadOptions thread_options;
+  thread_options.numa_aware_scheduling = true;
+  thread_options.affinities.resize(num_threads, onnxruntime::LogicalProcessors{0});
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), thread_options, nullptr, num_threads, true);
+
+  for (int rep = 0; rep < 5; rep++) {
+    auto test_data = CreateTestData(1000);
+    ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+    ValidateTestData(*test_data);
+  }
+
+  // Shutting down the pool waits for all scheduled work to complete
+  std::atomic<int> ctr{0};
+  for (int i = 0; i < 16; i++) {
+    ThreadPool::Schedule(tp.get(), [&]() { ctr++; });
+  }
+  tp.reset();
+  ASSERT_EQ(ctr, 16);
+}
+
+TEST(ThreadPoolTest, TestNestedParallelSections) {
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions{}, nullptr, 4, true);
+  auto other_tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions{}, nullptr, 2, true);
+  auto test_data = CreateTestData(1000);
+  {
+    // The inner sections join the outer one, and the loops of another pool run on their own.
+    ThreadPool::ParallelSection outer(tp.get());
+    ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+    {
+      ThreadPool::ParallelSection inner(tp.get());
+      ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+    }
+    {
+      ThreadPool::ParallelSection inner(other_tp.get());
+      ThreadPool::TrySimpleParallelFor(other_tp.get(), 1000, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+    }
+    ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+  }
+  ValidateTestData(*test_data, 4);
+}
+
+TEST(ThreadPoolTest, TestSpinDuration) {
+  // Workers that block right away and workers that spin for a bounded time must both pick up
+  // the loops of consecutive parallel sections, whatever duration the sections request.
+  for (int pool_spin_duration_us : {0, 50}) {
+    onnxruntime::ThreadOptions thread_options;
+    thread_options.spin_duration_us = pool_spin_duration_us;
+    auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), thread_options, nullptr, 4, true);
+
+    for (int section_spin_duration_us : {-1, 0, 1000}) {
+      constexpr int num_loops = 10;
+      auto test_data = CreateTestData(1000);
+      {
+        ThreadPool::ParallelSection ps(tp.get(), section_spin_duration_us);
+        for (int l = 0; l < num_loops; l++) {
+          ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+        }
+      }
+      ValidateTestData(*test_data, num_loops);
+    }
+  }
+}
+
+TEST(ThreadPoolTest, TestPriorityClasses) {
+  ThreadPool::Priority priority;
+  ASSERT_TRUE(ThreadPool::TryParsePriority("high", priority));
+  ASSERT_EQ(priority, ThreadPool::Priority::kHigh);
+  ASSERT_FALSE(ThreadPool::TryParsePriority("urgent", priority));
+
+  ASSERT_EQ(ThreadPool::CurrentPriority(), ThreadPool::Priority::kNormal);
+  {
+    ThreadPool::PriorityScope scope(ThreadPool::Priority::kHigh);
+    ASSERT_EQ(ThreadPool::CurrentPriority(), ThreadPool::Priority::kHigh);
+  }
+  ASSERT_EQ(ThreadPool::CurrentPriority(), ThreadPool::Priority::kNormal);
+
+  // While a high priority loop runs, the workers don't help with a low priority loop,
+  // which is completed by the thread that started it.
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions{}, nullptr, 4, true);
+  ThreadPool::PriorityScope scope(ThreadPool::Priority::kHigh);
+  ThreadPool::TrySimpleParallelFor(tp.get(), 2, [&](std::ptrdiff_t i) {
+    if (i != 0) {
+      return;
+    }
+
+    std::thread low_priority_thread([&]() {
+      ThreadPool::PriorityScope low_scope(ThreadPool::Priority::kLow);
+      auto test_data = CreateTestData(1000);
+      std::vector<std::thread::id> thread_ids(1000);
+      ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t j) {
+        IncrementElement(*test_data, j);
+        thread_ids[j] = std::this_thread::get_id();
+      });
+      ValidateTestData(*test_data);
+      for (const auto& id : thread_ids) {
+        ASSERT_EQ(id, std::this_thread::get_id());
+      }
+    });
+    low_priority_thread.join();
+  });
+}
+
+TEST(ThreadPoolTest, TestDeadline) {
+  ASSERT_EQ(ThreadPool::CurrentDeadline(), ThreadPool::Deadline::max());
+  const auto deadline = std::chrono::steady_clock::now() - std::chrono::seconds(1);
+  {
+    ThreadPool::DeadlineScope scope(deadline);
+    ASSERT_EQ(ThreadPool::CurrentDeadline(), deadline);
+  }
+  ASSERT_EQ(ThreadPool::CurrentDeadline(), ThreadPool::Deadline::max());
+
+  // The loops of a run that missed its deadline are run by the thread that started them.
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions{}, nullptr, 4, true);
+  ThreadPool::DeadlineScope scope(deadline);
+  auto test_data = CreateTestData(1000);
+  std::vector<std::thread::id> thread_ids(1000);
+  ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t i) {
+    IncrementElement(*test_data, i);
+    thread_ids[i] = std::this_thread::get_id();
+  });
+  ValidateTestData(*test_data);
+  for (const auto& id : thread_ids) {
+    ASSERT_EQ(id, std::this_thread::get_id());
+  }
+}
+
+TEST(ThreadPoolTest, TestMaxDegreeOfParallelism) {
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions{}, nullptr, 4, true);
+  ASSERT_EQ(ThreadPool::CurrentMaxDegreeOfParallelism(), 0);
+  ASSERT_EQ(ThreadPool::MaxParallelThreads(tp.get()), 4);
+  const int degree_of_parallelism = ThreadPool::DegreeOfParallelism(tp.get());
+  {
+    ThreadPool::MaxDegreeOfParallelismScope scope(2);
+    ASSERT_EQ(ThreadPool::CurrentMaxDegreeOfParallelism(), 2);
+    ASSERT_EQ(ThreadPool::MaxParallelThreads(tp.get()), 2);
+    ASSERT_EQ(ThreadPool::DegreeOfParallelism(tp.get()), degree_of_parallelism / 2);
+
+    // the loop runs on at most 2 threads
+    auto test_data = CreateTestData(1000);
+    std::mutex mutex;
+    std::set<std::thread::id> thread_ids;
+    ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t i) {
+      IncrementElement(*test_data, i);
+      std::lock_guard<std::mutex> lock(mutex);
+      thread_ids.insert(std::this_thread::get_id());
+    });
+    ValidateTestData(*test_data);
+    ASSERT_LE(thread_ids.size(), 2u);
+  }
+  ASSERT_EQ(ThreadPool::CurrentMaxDegreeOfParallelism(), 0);
+
+  // a cap of 1 runs the loops in the calling thread
+  ThreadPool::MaxDegreeOfParallelismScope scope(1);
+  ASSERT_FALSE(ThreadPool::ShouldParallelize(tp.get()));
+  auto test_data = CreateTestData(1000);
+  std::vector<std::thread::id> thread_ids(1000);
+  ThreadPool::TrySimpleParallelFor(tp.get(), 1000, [&](std::ptrdiff_t i) {
+    IncrementElement(*test_data, i);
+    thread_ids[i] = std::this_thread::get_id();
+  });
+  ValidateTestData(*test_data);
+  for (const auto& id : thread_ids) {
+    ASSERT_EQ(id, std::this_thread::get_id());
+  }
+}
+
 TEST(ThreadPoolTest, TestPoolCreation_1Iter) {
   TestPoolCreation("TestPoolCreation_1Iter", 1);
 }
@@ -736,13 +736,23 @@ void BaseTester::RunWithConfig(size_t* number_of_pre_packed_weights_counter,
         if (ctx_.run_options != nullptr &&
             ctx_.run_options->config_options.GetConfigEntry(kOpTesterRunOptionsConfigTestTunableOp) == "true") {
           std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+          SessionOptions tunable_op_session_options = ctx_.session_options;
           if (provider_type == onnxruntime::kRocmExecutionProvider) {
             execution_providers.emplace_back(DefaultRocmExecutionProvider(/*test_tunable_op=*/true));
           }
+#if !defined(ORT_MINIMAL_BUILD)
+          if (provider_type == onnxruntime::kCpuExecutionProvider) {
+            execution_providers.emplace_back(DefaultCpuExecutionProvider());
+            ASSERT_STATUS_OK(tunable_op_session_options.config_options.AddConfigEntry(
+                kOrtSessionOptionsConfigCpuTunableOpEnable, "1"));
+            ASSERT_STATUS_OK(tunable_op_session_options.config_options.AddConfigEntry(
+                kOrtSessionOptionsConfigCpuTunableOpTuningEnable, "1"));
+          }
+#endif
 
           if (!execution_providers.empty()) {
             ExecuteModelForEps(
-                std::move(execution_providers), model, ctx_.session_options,
+                std::move(execution_providers), model, tunable_op_session_options,
                 ctx_.expect_result, ctx_.expected_failure_string,
                 ctx_.run_options, feeds, output_names,
                 &custom_session_registries_,
@@ -126,6 +126,31 @@ TEST(CoreMLExecutionProviderTest, ArgMaxCastTest) {
 #endif
 }
 
+// The second session should load the compiled model the first one added to the cache.
+TEST(CoreMLExecutionProviderTest, CompiledModelCacheTest) {
+  const ORTCHAR_T* model_file_name = ORT_TSTR("testdata/coreml_argmax_cast_test.onnx");
+  const uint32_t flags = s_coreml_flags | COREML_FLAG_ENABLE_COMPILED_MODEL_CACHE;
+
+#if defined(__APPLE__)
+  std::vector<int64_t> dims_mul_x = {3, 2, 2};
+  std::vector<float> values_mul_x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 12.0f};
+  OrtValue ml_value_x;
+  AllocatorPtr allocator = std::make_shared<CPUAllocator>();
+  CreateMLValue<float>(allocator, dims_mul_x, values_mul_x, &ml_value_x);
+
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("X", ml_value_x));
+
+  for (int i = 0; i < 2; ++i) {
+    RunAndVerifyOutputsWithEP(model_file_name, CurrentTestName(), MakeCoreMLExecutionProvider(flags), feeds);
+  }
+#else
+  for (int i = 0; i < 2; ++i) {
+    TestModelLoad(model_file_name, MakeCoreMLExecutionProvider(flags), ExpectedEPNodeAssignment::Some);
+  }
+#endif
+}
+
 TEST(CoreMLExecutionProviderTest, GatherWithScalarIndices) {
   // For scalar inputs, the input shape is modified from [] -> [1] before passing the input to CoreML.
   // This won't work for Gather because the output shape depends on the `indices` input shape which could be a scalar.
@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/mlas/inc/mlas.h"
+
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+#include "default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+std::vector<MLFloat16> ToFloat16(const std::vector<float>& values) {
+  std::vector<MLFloat16> result;
+  result.reserve(values.size());
+  for (float value : values) {
+    result.push_back(MLFloat16(value));
+  }
+  return result;
+}
+
+void RunOnCpu(OpTester& test) {
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+void RunBinaryOp(const char* op_type,
+                 const std::vector<int64_t>& a_dims, const std::vector<float>& a,
+                 const std::vector<int64_t>& b_dims, const std::vector<float>& b,
+                 const std::vector<int64_t>& c_dims, const std::vector<float>& c) {
+  OpTester test(op_type, 14);
+  test.AddInput<MLFloat16>("A", a_dims, ToFloat16(a));
+  test.AddInput<MLFloat16>("B", b_dims, ToFloat16(b));
+  test.AddOutput<MLFloat16>("C", c_dims, ToFloat16(c));
+  RunOnCpu(test);
+}
+
+}  // namespace
+
+TEST(Fp16MathTest, Add_Broadcast) {
+  RunBinaryOp("Add", {2, 3}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f},
+              {3}, {0.5f, -1.0f, 2.0f},
+              {2, 3}, {1.5f, 1.0f, 5.0f, 4.5f, 4.0f, 8.0f});
+}
+
+TEST(Fp16MathTest, Sub_ScalarInput1) {
+  RunBinaryOp("Sub", {2, 3}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f},
+              {1}, {2.0f},
+              {2, 3}, {-1.0f, 0.0f, 1.0f, 2.0f, 3.0f, 4.0f});
+}
+
+TEST(Fp16MathTest, Mul) {
+  RunBinaryOp("Mul", {2, 3}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f},
+              {2, 3}, {0.5f, -1.0f, 2.0f, 0.25f, 2.0f, -0.5f},
+              {2, 3}, {0.5f, -2.0f, 6.0f, 1.0f, 10.0f, -3.0f});
+}
+
+TEST(Fp16MathTest, Div_ScalarInput0) {
+  RunBinaryOp("Div", {}, {6.0f},
+              {2, 3}, {1.0f, 2.0f, 3.0f, 4.0f, -6.0f, 0.5f},
+              {2, 3}, {6.0f, 3.0f, 2.0f, 1.5f, -1.0f, 12.0f});
+}
+
+TEST(Fp16MathTest, MatMul_BroadcastB) {
+  OpTester test("MatMul", 13);
+  test.AddInput<MLFloat16>("A", {2, 2, 3}, ToFloat16({1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f,
+                                                      -1.0f, 0.0f, 1.0f, 2.0f, -2.0f, 0.5f}));
+  test.AddInput<MLFloat16>("B", {3, 2}, ToFloat16({1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f}));
+  test.AddOutput<MLFloat16>("Y", {2, 2, 2}, ToFloat16({4.0f, 5.0f, 10.0f, 11.0f, 0.0f, 1.0f, 2.5f, -1.5f}));
+  RunOnCpu(test);
+}
+
+TEST(Fp16MathTest, Gemm_Bias) {
+  OpTester test("Gemm", 13);
+  test.AddInput<MLFloat16>("A", {2, 3}, ToFloat16({1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}));
+  test.AddInput<MLFloat16>("B", {3, 2}, ToFloat16({1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f}));
+  test.AddInput<MLFloat16>("C", {2}, ToFloat16({0.5f, -1.0f}));
+  test.AddOutput<MLFloat16>("Y", {2, 2}, ToFloat16({4.5f, 4.0f, 10.5f, 10.0f}));
+  RunOnCpu(test);
+}
+
+TEST(Fp16MathTest, Softmax_Axis0) {
+  OpTester test("Softmax", 13);
+  test.AddAttribute<int64_t>("axis", 0);
+  test.AddInput<MLFloat16>("X", {2, 3}, ToFloat16({1.0f, 2.0f, 3.0f, 0.5f, -1.0f, 2.0f}));
+  test.AddOutput<MLFloat16>("Y", {2, 3}, ToFloat16({0.62245933f, 0.95257413f, 0.73105858f,
+                                                     0.37754067f, 0.04742587f, 0.26894142f}));
+  RunOnCpu(test);
+}
+
+TEST(Fp16MathTest, LayerNormalization) {
+  OpTester test("LayerNormalization", 17);
+  test.AddAttribute<int64_t>("axis", -1);
+  test.AddAttribute<float>("epsilon", 1e-5f);
+  test.AddInput<MLFloat16>("X", {2, 4}, ToFloat16({1.0f, 2.0f, 3.0f, 4.0f, -1.0f, 0.0f, 2.0f, -3.0f}));
+  test.AddInput<MLFloat16>("Scale", {4}, ToFloat16({1.0f, 0.5f, 2.0f, 1.0f}));
+  test.AddInput<MLFloat16>("B", {4}, ToFloat16({0.0f, 1.0f, -1.0f, 0.5f}));
+  test.AddOutput<MLFloat16>("Y", {2, 4}, ToFloat16({-1.34163542f, 0.77639410f, -0.10557639f, 1.84163542f,
+                                                     -0.27734967f, 1.13867484f, 1.77349671f, -0.88674836f}));
+  RunOnCpu(test);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
+
+#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/providers/run_options_config_keys.h"
@@ -293,6 +294,73 @@ TEST(MathOpTest, MatMul_bfloat16) {
 
 #ifndef ENABLE_TRAINING
 // Prepacking is disabled in full training build so no need to test the feature in a training build.
+TEST(MathOpTest, MatMulSparse24Weights) {
+  constexpr int64_t M = 3, K = 10, N = 5;
+
+  std::vector<float> a_values(M * K);
+  for (size_t i = 0; i < a_values.size(); i++) {
+    a_values[i] = static_cast<float>(static_cast<int>(i % 7) - 3);
+  }
+
+  // at most two non-zero elements in each group of four rows of a column, the last group is partial
+  std::vector<float> sparse_b_values(K * N, 0.0f);
+  for (int64_t k = 0; k < K; k++) {
+    for (int64_t n = 0; n < N; n++) {
+      if (k % 4 == n % 4 || k % 4 == (n + 2) % 4) {
+        sparse_b_values[k * N + n] = static_cast<float>(k - n) * 0.5f;
+      }
+    }
+  }
+
+  std::vector<float> dense_b_values(K * N, 1.0f);
+
+  for (const auto* b_values : {&sparse_b_values, &dense_b_values}) {
+    std::vector<float> y_values(M * N, 0.0f);
+    for (int64_t m = 0; m < M; m++) {
+      for (int64_t n = 0; n < N; n++) {
+        for (int64_t k = 0; k < K; k++) {
+          y_values[m * N + n] += a_values[m * K + k] * (*b_values)[k * N + n];
+        }
+      }
+    }
+
+    OpTester test("MatMul");
+    test.AddInput<float>("A", {M, K}, a_values);
+    // B is to be an initializer for triggering pre-packing
+    test.AddInput<float>("B", {K, N}, *b_values, true);
+    test.AddOutput<float>("Y", {M, N}, y_values);
+
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsMlasSparse24Gemm, "1"));
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Config(so)
+        .ConfigEps(std::move(execution_providers))
+        .RunWithConfig();
+  }
+}
+
+TEST(MathOpTest, MatMulNumaReplicatedPrepackedWeights) {
+  OpTester test("MatMul");
+  test.AddInput<float>("A", {2, 4}, {1.0f, 2.0f, 3.0f, 4.0f, -1.0f, -2.0f, -3.0f, -4.0f});
+  // B is to be an initializer for triggering pre-packing
+  test.AddInput<float>("B", {4, 3}, std::vector<float>(12, 1.0f), true);
+  test.AddOutput<float>("Y", {2, 3}, {10.0f, 10.0f, 10.0f, -10.0f, -10.0f, -10.0f});
+
+  // the weights are only replicated when the intra op workers span several NUMA nodes, otherwise the kernel must
+  // keep using the single packed buffer
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigIntraOpNumaAwareScheduling, "1"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigNumaReplicatePrepackedWeights, "1"));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Config(so)
+      .ConfigEps(std::move(execution_providers))
+      .RunWithConfig();
+}
+
 TEST(MathOpTest, MatMulSharedPrepackedWeights) {
   OpTester test("MatMul");
 
@@ -814,6 +814,39 @@ TEST(TopKOperator, Top3AllSame) {
   top_3_explicit_axis<double>(11, 0);
 }
 
+// rows of at least 4096 elements select from the candidates beating a threshold estimated from a sample of the row.
+// use values with many duplicates in an order the sample doesn't follow so ties at the threshold are kept.
+template <typename T>
+static void TestCandidateFilter(int64_t largest) {
+  constexpr int64_t n = 8192;
+  constexpr int64_t k = 1000;
+  std::vector<T> input_vals(n);
+  for (int64_t i = 0; i < n; ++i) {
+    input_vals[i] = static_cast<T>((i * 7919) % 997);
+  }
+
+  std::vector<int64_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&input_vals, largest](int64_t lhs, int64_t rhs) {
+    return largest ? input_vals[lhs] > input_vals[rhs] : input_vals[lhs] < input_vals[rhs];
+  });
+
+  std::vector<T> expected_vals(k);
+  std::vector<int64_t> expected_indices(order.begin(), order.begin() + k);
+  for (int64_t i = 0; i < k; ++i) {
+    expected_vals[i] = input_vals[expected_indices[i]];
+  }
+
+  RunTest(11, k, input_vals, {n}, expected_vals, expected_indices, {k}, false, -1, largest);
+}
+
+TEST(TopKOperator, NthElementCandidateFilter) {
+  TestCandidateFilter<float>(1);
+  TestCandidateFilter<float>(0);  // smallest
+  TestCandidateFilter<double>(1);
+  TestCandidateFilter<double>(0);  // smallest
+}
+
 template <typename T>
 static void TestThreaded(int64_t k, int64_t n, int64_t batch_size) {
   std::vector<T> input_vals(n * batch_size, 0.0f);
@@ -43,5 +43,24 @@ TEST(CategoryMapper, IntToString) {
 
   RunTest(dims, input, output);
 }
+
+TEST(CategoryMapper, ManyElements) {
+  const std::vector<std::string> words{"One", "Two", "Three", "Four"};
+  const std::vector<int64_t> indexes{1, 2, 3, 99};
+  std::vector<std::string> strings;
+  std::vector<int64_t> ints;
+  for (size_t i = 0; i < 10000; ++i) {
+    strings.push_back(words[i % words.size()]);
+    ints.push_back(indexes[i % indexes.size()]);
+  }
+  std::vector<std::string> int_outputs(strings);
+  for (size_t i = 3; i < int_outputs.size(); i += 4) {
+    int_outputs[i] = "default";
+  }
+
+  std::vector<int64_t> dims{100, 100};
+  RunTest(dims, strings, ints);
+  RunTest(dims, ints, int_outputs);
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -88,6 +88,47 @@ TEST(MLOpTest, LinearClassifierMulticlassProbSigmoid) {
   test.Run();
 }
 
+TEST(MLOpTest, LinearClassifierMulticlassSparseInput) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  // one non zero feature per row exercises the path skipping the zeros of the input
+  constexpr int64_t num_rows = 4, num_features = 64, num_classes = 3;
+  std::vector<float> coefficients(num_classes * num_features);
+  for (int64_t c = 0; c < num_classes; ++c) {
+    for (int64_t f = 0; f < num_features; ++f) {
+      coefficients[c * num_features + f] = static_cast<float>((f % 7) - 3) * static_cast<float>(c + 1) * 0.25f;
+    }
+  }
+  std::vector<float> intercepts = {0.5f, -0.25f, 0.125f};
+  std::vector<int64_t> classes = {1, 2, 3};
+
+  std::vector<float> X(num_rows * num_features, 0.f);
+  std::vector<float> predictions(num_rows * num_classes);
+  std::vector<int64_t> predicted_class(num_rows);
+  for (int64_t r = 0; r < num_rows; ++r) {
+    const int64_t feature = r * 16 + 3 * r + 1;
+    X[r * num_features + feature] = static_cast<float>(r + 1);
+
+    int64_t best = 0;
+    for (int64_t c = 0; c < num_classes; ++c) {
+      predictions[r * num_classes + c] = intercepts[c] + (r + 1) * coefficients[c * num_features + feature];
+      if (predictions[r * num_classes + c] > predictions[r * num_classes + best]) {
+        best = c;
+      }
+    }
+    predicted_class[r] = classes[best];
+  }
+
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", classes);
+
+  test.AddInput<float>("X", {num_rows, num_features}, X);
+  test.AddOutput<int64_t>("Y", {num_rows}, predicted_class);
+  test.AddOutput<float>("Z", {num_rows, num_classes}, predictions);
+  test.Run();
+}
+
 TEST(MLOpTest, LinearClassifierBinary) {
   OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
 
@@ -275,6 +275,7 @@ TEST(MLOpTest, TreeRegressorMultiTargetBatchTreeC2) {
   GenTreeAndRunTest(1, X, base_values, results, "AVERAGE", false, 200, 130);  // section C2
   GenTreeAndRunTest(3, X, base_values, results, "AVERAGE", false, 200, 130);  // section C2
   GenTreeAndRunTest(3, X, base_values, results, "AVERAGE", false, 400, 130);  // section C2
+  GenTreeAndRunTest(3, X, base_values, results, "AVERAGE", false, 48, 1);    // section C2, blocks of rows
 }
 
 TEST(MLOpTest, TreeRegressorMultiTargetBatchTreeD2) {
@@ -582,6 +583,7 @@ TEST(MLOpTest, TreeRegressorSingleTargetBatchTreeB) {
 TEST(MLOpTest, TreeRegressorSingleTargetBatchTreeC) {
   GenTreeAndRunTest1(1, "AVERAGE", false, 3, 1);  // section C
   GenTreeAndRunTest1(3, "AVERAGE", false, 3, 1);  // section C
+  GenTreeAndRunTest1(3, "AVERAGE", false, 45, 1);  // section C, blocks of rows and remaining rows
 }
 
 TEST(MLOpTest, TreeRegressorSingleTargetBatchTreeD) {
@@ -679,6 +681,70 @@ TEST(MLOpTest, TreeRegressorSingleTargetSum_as_tensor_precision) {
   GenTreeAndRunTest1_as_tensor_precision(3);
 }
 
+// A chain of `depth` nodes of mode `mode`, the k-th true branch is a leaf of weight k and the last false branch a leaf
+// of weight `depth`.
+void GenChainTreeAndRunTest(int64_t depth, const std::string& mode) {
+  OpTester test("TreeEnsembleRegressor", 3, onnxruntime::kMLDomain);
+
+  std::vector<int64_t> nodes_featureids, nodes_nodeids, nodes_treeids, nodes_truenodeids, nodes_falsenodeids;
+  std::vector<int64_t> target_ids, target_nodeids, target_treeids;
+  std::vector<std::string> nodes_modes;
+  std::vector<float> nodes_values, target_weights;
+  for (int64_t k = 0; k <= depth; ++k) {
+    const bool is_last = k == depth;
+    nodes_nodeids.push_back(2 * k);
+    nodes_modes.push_back(is_last ? "LEAF" : mode);
+    nodes_values.push_back(static_cast<float>(k));
+    nodes_truenodeids.push_back(is_last ? 0 : 2 * k + 1);
+    nodes_falsenodeids.push_back(is_last ? 0 : 2 * k + 2);
+    if (!is_last) {
+      nodes_nodeids.push_back(2 * k + 1);
+      nodes_modes.push_back("LEAF");
+      nodes_values.push_back(0.f);
+      nodes_truenodeids.push_back(0);
+      nodes_falsenodeids.push_back(0);
+    }
+    target_nodeids.push_back(is_last ? 2 * k : 2 * k + 1);
+    target_weights.push_back(static_cast<float>(k));
+  }
+  nodes_featureids.resize(nodes_nodeids.size(), 0);
+  nodes_treeids.resize(nodes_nodeids.size(), 0);
+  target_ids.resize(target_nodeids.size(), 0);
+  target_treeids.resize(target_nodeids.size(), 0);
+
+  test.AddAttribute("nodes_truenodeids", nodes_truenodeids);
+  test.AddAttribute("nodes_falsenodeids", nodes_falsenodeids);
+  test.AddAttribute("nodes_treeids", nodes_treeids);
+  test.AddAttribute("nodes_nodeids", nodes_nodeids);
+  test.AddAttribute("nodes_featureids", nodes_featureids);
+  test.AddAttribute("nodes_values", nodes_values);
+  test.AddAttribute("nodes_modes", nodes_modes);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", target_ids);
+  test.AddAttribute("target_weights", target_weights);
+  test.AddAttribute("n_targets", static_cast<int64_t>(1));
+
+  // row r is greater than the first r thresholds
+  std::vector<float> X, Y;
+  for (int64_t r = 0; r <= depth; ++r) {
+    X.push_back(static_cast<float>(r) - 0.5f);
+    Y.push_back(static_cast<float>(mode == "BRANCH_LEQ" ? r : (r == 0 ? depth : 0)));
+  }
+  test.AddInput<float>("X", {depth + 1, 1}, X);
+  test.AddOutput<float>("Y", {depth + 1, 1}, Y);
+  test.Run();
+}
+
+TEST(MLOpTest, TreeRegressorChainTrees) {
+  // trees up to 8 levels deep use the compact layout, deeper ones the nodes
+  GenChainTreeAndRunTest(3, "BRANCH_LEQ");
+  GenChainTreeAndRunTest(8, "BRANCH_LEQ");
+  GenChainTreeAndRunTest(12, "BRANCH_LEQ");
+  GenChainTreeAndRunTest(3, "BRANCH_GT");
+  GenChainTreeAndRunTest(12, "BRANCH_GT");
+}
+
 TEST(MLOpTest, TreeRegressorTrueNodeBeforeNode) {
   OpTester test("TreeEnsembleRegressor", 3, onnxruntime::kMLDomain);
 
@@ -1147,6 +1147,39 @@ TEST(ConvTransposeTest, ConvTranspose_AutoPad_with_non_default_strides) {
                        kDmlExecutionProvider});     // TODO: Unskip when fixed #41968513
 }
 
+// Stride 2 with kernel 3 gives output phases with 2x2, 2x1, 1x2 and 1x1 kernel taps. Covers the per phase
+// decomposition used when the filter is prepacked.
+TEST(ConvTransposeTest, ConvTranspose_2D_Strides2_Group2_Bias) {
+  ConvTransposeOpAttributes attrs = {
+      vector<int64_t>{3, 3},        // kernel_shape
+      vector<int64_t>{1, 1},        // output_padding
+      {},                           // output_shape
+      vector<int64_t>{1, 1, 1, 1},  // pads
+      vector<int64_t>{2, 2},        // strides
+      vector<int64_t>{1, 1},        // dilations
+      2,                            // group
+      "NOTSET"                      // auto_pad
+  };
+  vector<float> X = {1.0f, -2.0f, 3.0f, 4.0f,
+                     0.5f, -1.0f, 2.0f, -3.0f};
+  vector<int64_t> X_shape = {1, 2, 2, 2};
+  vector<float> W = {1.0f, 2.0f, -1.0f, 0.0f, 3.0f, 1.0f, -2.0f, 1.0f, 2.0f,
+                     2.0f, -1.0f, 1.0f, 0.5f, 1.0f, -3.0f, 1.0f, 0.0f, 2.0f};
+  vector<int64_t> W_shape = {2, 1, 3, 3};
+  vector<float> B = {0.5f, -1.0f};
+  vector<int64_t> B_shape = {2};
+  vector<int64_t> Y_shape = {1, 2, 4, 4};
+  auto expected_vals = {3.5f, 1.5f, -5.5f, -1.5f,
+                        7.5f, 7.5f, 6.5f, -7.5f,
+                        9.5f, 3.5f, 12.5f, 4.5f,
+                        3.5f, -1.5f, 4.5f, 8.5f,
+                        -0.5f, -3.0f, -2.0f, 2.0f,
+                        -3.0f, -5.0f, 2.0f, -6.0f,
+                        1.0f, -8.5f, -4.0f, 8.0f,
+                        -1.0f, 0.0f, -1.0f, -7.0f};
+  TestConvTransposeOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
+}
+
 #ifndef ENABLE_TRAINING
 // Prepacking is disabled in full training build so no need to test the feature in a training build.
 TEST(ConvTransposeTest, SharedPrepackedWeights) {
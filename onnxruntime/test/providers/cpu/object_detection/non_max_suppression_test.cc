@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -383,5 +385,40 @@ TEST(NonMaxSuppressionOpTest, WithIOUThresholdOpset11) {
   test.Run();
 }
 
+// more than 8 selected boxes per class. in the first class the last box is suppressed by a box past the first block
+// of selected boxes it is checked against.
+TEST(NonMaxSuppressionOpTest, ManySelectedBoxesTwoClasses) {
+  constexpr int64_t num_boxes = 21;
+  std::vector<float> boxes;
+  std::vector<float> scores(2 * num_boxes);
+  for (int64_t i = 0; i < num_boxes - 1; ++i) {
+    const auto x = static_cast<float>(2 * i);
+    boxes.insert(boxes.end(), {0.0f, x, 1.0f, x + 1.0f});
+    scores[i] = 0.9f - 0.01f * i;
+    scores[num_boxes + i] = 0.1f + 0.01f * i;
+  }
+  // the last box is the same as box 12 with a lower score in both classes
+  boxes.insert(boxes.end(), {0.0f, 24.0f, 1.0f, 25.0f});
+  scores[num_boxes - 1] = 0.05f;
+  scores[2 * num_boxes - 1] = 0.05f;
+
+  std::vector<int64_t> selected_indices;
+  for (int64_t i = 0; i < num_boxes - 1; ++i) {
+    selected_indices.insert(selected_indices.end(), {0L, 0L, i});
+  }
+  for (int64_t i = num_boxes - 2; i >= 0; --i) {
+    selected_indices.insert(selected_indices.end(), {0L, 1L, i});
+  }
+
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {1, num_boxes, 4}, boxes);
+  test.AddInput<float>("scores", {1, 2, num_boxes}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {30L});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {0.0f});
+  test.AddOutput<int64_t>("selected_indices", {2 * (num_boxes - 1), 3}, selected_indices);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -5637,6 +5637,28 @@ TEST(ReductionOpTest, ReduceSum_RKR_parallel_bigger) {
   test.Run();
 }
 
+// Large enough for the reduction of all elements to be split into blocks reduced by several threads.
+TEST(ReductionOpTest, ReduceAll_R_parallel) {
+  std::vector<float> in_data(7 * 30011);
+  for (size_t i = 0; i < in_data.size(); ++i)
+    in_data[i] = static_cast<float>(static_cast<int>(i % 7) - 3);
+  in_data[123457] = 100.0f;
+  in_data[98765] = -50.0f;
+  const float sum = 100.0f - 2.0f - 50.0f + 1.0f;  // replaces 2 and -1, every period of 7 sums to zero
+
+  const std::vector<std::pair<std::string, float>> cases = {
+      {"ReduceSum", sum}, {"ReduceMean", sum / static_cast<float>(in_data.size())},
+      {"ReduceMax", 100.0f}, {"ReduceMin", -50.0f}};
+  for (const auto& [op, expected] : cases) {
+    SCOPED_TRACE(op);
+    OpTester test(op.c_str());
+    test.AddAttribute("keepdims", (int64_t)0);
+    test.AddInput<float>("data", {7, 30011}, in_data);
+    test.AddOutput<float>("reduced", {}, {expected});
+    test.Run();
+  }
+}
+
 TEST(ReductionOpTest, ReduceSum_RKR_keepdims) {
   OpTester test("ReduceSum");
   test.AddAttribute("axes", std::vector<int64_t>{0, 2});
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
 #include <functional>
 #include <vector>
 
@@ -116,6 +117,51 @@ TEST(SignalOpsTest, DFT20_Float_inverse) {
   TestInverseFloat(kOpsetVersion20);
 }
 
+// Compares the DFT of lengths whose prime factors are 2, 3 and 5, but which aren't a power of 2, with a naive DFT.
+static void TestMixedRadixDFTFloat(int64_t length, bool complex, bool onesided) {
+  OpTester test("DFT", kMinOpsetVersion);
+
+  const int64_t components = complex ? 2 : 1;
+  vector<int64_t> shape = {2, length, components};
+  vector<int64_t> output_shape = {2, onesided ? (1 + (length >> 1)) : length, 2};
+
+  RandomValueGenerator random(GetTestRandomSeed());
+  vector<float> input = random.Uniform<float>(shape, -1.f, 1.f);
+
+  constexpr double pi = 3.14159265358979323846;
+  vector<float> expected_output;
+  for (int64_t batch = 0; batch < shape[0]; batch++) {
+    const float* signal = input.data() + batch * length * components;
+    for (int64_t k = 0; k < output_shape[1]; k++) {
+      double real = 0;
+      double imag = 0;
+      for (int64_t n = 0; n < length; n++) {
+        const double angle = -2.0 * pi * static_cast<double>(k * n % length) / static_cast<double>(length);
+        const double x_real = signal[n * components];
+        const double x_imag = complex ? signal[n * components + 1] : 0.0;
+        real += x_real * std::cos(angle) - x_imag * std::sin(angle);
+        imag += x_real * std::sin(angle) + x_imag * std::cos(angle);
+      }
+      expected_output.push_back(static_cast<float>(real));
+      expected_output.push_back(static_cast<float>(imag));
+    }
+  }
+
+  test.AddInput<float>("input", shape, input);
+  test.AddAttribute<int64_t>("onesided", static_cast<int64_t>(onesided));
+  test.AddOutput<float>("output", output_shape, expected_output);
+  test.SetOutputAbsErr("output", 0.001f);
+  test.Run();
+}
+
+TEST(SignalOpsTest, DFT17_Float_mixed_radix) {
+  for (int64_t length : {6, 12, 15, 400}) {
+    TestMixedRadixDFTFloat(length, false, false);
+    TestMixedRadixDFTFloat(length, false, true);
+    TestMixedRadixDFTFloat(length, true, false);
+  }
+}
+
 // Tests that FFT(FFT(x), inverse=true) == x
 static void TestDFTInvertible(bool complex, int since_version) {
   // TODO: test dft_length
@@ -158,6 +158,23 @@ TEST(CastOpTest, NonStringTypes) {
       CastNonStringTester{});
 }
 
+// Large enough to be split across threads, with a length that leaves a tail for the vectorized conversions.
+TEST(CastOpTest, FloatAndFloat16LargeTensor) {
+  const std::vector<int64_t> shape{3, 1031};
+  std::vector<float> float_data(3 * 1031);
+  for (size_t i = 0; i < float_data.size(); ++i) {
+    float_data[i] = (static_cast<float>(i % 509) - 254.0f) * 0.37f;
+  }
+  float_data[7] = 70000.0f;  // rounds to infinity in float16
+  float_data[11] = 1e-6f;    // float16 subnormal
+
+  const std::vector<MLFloat16> float16_data = CastedValues<float, MLFloat16>(gsl::make_span(float_data));
+  TestCastOp(gsl::make_span(float_data), gsl::make_span(float16_data), shape);
+
+  const std::vector<float> float_output = CastedValues<MLFloat16, float>(gsl::make_span(float16_data));
+  TestCastOp(gsl::make_span(float16_data), gsl::make_span(float_output), shape);
+}
+
 TEST(CastOpTest, FromString) {
   const std::vector<int64_t> shape{2, 2, 2};
   const std::vector<std::string> string_data = {"-inf", "+INF", "0.9767611", "0.28280696",
@@ -426,5 +426,30 @@ TEST(ConcatOpTest, Concat4D_2) {
   test.Run();
 }
 
+// Enough rows of inputs with different widths, including an empty one, for the copy to run on several threads.
+TEST(ConcatOpTest, Concat2D_many_rows) {
+  OpTester test("Concat");
+  test.AddAttribute("axis", int64_t{1});
+
+  constexpr int64_t rows = 4096;
+  const std::vector<int64_t> widths{3, 0, 17, 1};
+  std::vector<std::vector<int32_t>> inputs(widths.size());
+  std::vector<int32_t> output;
+  for (int64_t row = 0; row < rows; ++row) {
+    for (size_t i = 0; i < widths.size(); ++i) {
+      for (int64_t col = 0; col < widths[i]; ++col) {
+        const auto value = static_cast<int32_t>(row * 1000 + static_cast<int64_t>(i) * 100 + col);
+        inputs[i].push_back(value);
+        output.push_back(value);
+      }
+    }
+  }
+  for (size_t i = 0; i < widths.size(); ++i) {
+    test.AddInput<int32_t>(("input" + std::to_string(i + 1)).c_str(), {rows, widths[i]}, inputs[i]);
+  }
+  test.AddOutput<int32_t>("concat_result", {rows, 21}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
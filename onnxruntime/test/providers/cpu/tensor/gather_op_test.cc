@@ -369,6 +369,36 @@ TEST(GatherOpTest, Gather_perf) {
   test.Run();
 }
 
+// Rows of 64 bytes use the fixed size row copy, with indices far enough apart to prefetch the next rows.
+TEST(GatherOpTest, Gather_axis0_embedding_rows) {
+  constexpr int64_t num_rows = 97;
+  constexpr int64_t row_size = 16;
+  constexpr int64_t num_indices = 300;
+
+  std::vector<float> input(num_rows * row_size);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i);
+  }
+  std::vector<int64_t> indices(num_indices);
+  std::vector<float> output;
+  output.reserve(num_indices * row_size);
+  for (int64_t i = 0; i < num_indices; ++i) {
+    indices[i] = (i * 31) % num_rows;
+    if (i % 4 == 0) {
+      indices[i] -= num_rows;
+    }
+    const int64_t row = indices[i] < 0 ? indices[i] + num_rows : indices[i];
+    output.insert(output.end(), input.begin() + row * row_size, input.begin() + (row + 1) * row_size);
+  }
+
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 0LL);
+  test.AddInput<float>("data", {num_rows, row_size}, input);
+  test.AddInput<int64_t>("indices", {3, num_indices / 3}, indices);
+  test.AddOutput<float>("output", {3, num_indices / 3, row_size}, output);
+  test.Run();
+}
+
 TEST(GatherOpTest, Gather_axis1_neg_indices2d_int8) {
   OpTester test("Gather", 11);
   test.AddAttribute<int64_t>("axis", 1LL);
@@ -995,5 +995,36 @@ TEST(GridsampleTest, test_grid_sample_20_4D_bicubic_reflection_no_align_corners)
   RunTests(test, GetExecutionProviders(20));
 }
 
+// an identity grid with aligned corners samples the input pixels exactly, over several rows and channels
+TEST(GridsampleTest, test_grid_sample_20_4D_identity_grid) {
+  constexpr int64_t N = 2, C = 3, H = 8, W = 8;
+  std::vector<float> X_data(N * C * H * W);
+  for (size_t i = 0; i < X_data.size(); i++) {
+    X_data[i] = static_cast<float>(i % 17) - 8.0f;
+  }
+  std::vector<float> Grid_data;
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t h = 0; h < H; h++) {
+      for (int64_t w = 0; w < W; w++) {
+        Grid_data.push_back(static_cast<float>(2 * w) / (W - 1) - 1.0f);
+        Grid_data.push_back(static_cast<float>(2 * h) / (H - 1) - 1.0f);
+      }
+    }
+  }
+
+  for (const std::string mode : {"linear", "nearest"}) {
+    for (const std::string padding_mode : {"zeros", "border", "reflection"}) {
+      OpTester test("GridSample", 20);
+      test.AddInput<float>("X", {N, C, H, W}, X_data);
+      test.AddInput<float>("Grid", {N, H, W, 2}, Grid_data);
+      test.AddAttribute("mode", mode);
+      test.AddAttribute("padding_mode", padding_mode);
+      test.AddAttribute("align_corners", int64_t{1});
+      test.AddOutput<float>("Y", {N, C, H, W}, X_data);
+      RunTests(test, GetExecutionProviders(20));
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
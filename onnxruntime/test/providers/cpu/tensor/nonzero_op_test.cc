@@ -99,5 +99,28 @@ TEST(NonZeroOpTest, EmptyInput) {
   test.Run();
 }
 
+TEST(NonZeroOpTest, ManyElements) {
+  // large enough to be scanned in several blocks
+  constexpr int64_t rows = 300, cols = 200;
+  std::vector<float> X(rows * cols, 0.0f);
+  std::vector<int64_t> row_coords, col_coords;
+  for (int64_t r = 0; r < rows; ++r) {
+    for (int64_t c = 0; c < cols; ++c) {
+      if ((r * 7 + c * 3) % 11 == 0) {
+        X[r * cols + c] = 1.5f;
+        row_coords.push_back(r);
+        col_coords.push_back(c);
+      }
+    }
+  }
+  std::vector<int64_t> Y(row_coords);
+  Y.insert(Y.end(), col_coords.begin(), col_coords.end());
+
+  OpTester test{kOpName, kOpVersion};
+  test.AddInput<float>("X", {rows, cols}, X);
+  test.AddOutput<int64_t>("Y", {2, static_cast<int64_t>(row_coords.size())}, Y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -235,5 +237,35 @@ TEST(ScatterNDOpTest, ScatterND_18_max) {
   test1.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
 }
 
+// Many updates to the same rows are grouped by row so that the reduction of a row is never split across threads.
+TEST(ScatterNDOpTest, ScatterND_18_add_duplicate_indices) {
+  constexpr int64_t rows = 37;
+  constexpr int64_t cols = 16;
+  constexpr int64_t num_updates = 512;
+
+  std::vector<float> data(rows * cols);
+  std::vector<int64_t> indices(num_updates);
+  std::vector<float> updates(num_updates * cols);
+  for (int64_t i = 0; i < rows * cols; ++i) {
+    data[i] = static_cast<float>(i % 5);
+  }
+  std::vector<float> expected = data;
+  for (int64_t i = 0; i < num_updates; ++i) {
+    indices[i] = (i * 7) % rows;
+    for (int64_t j = 0; j < cols; ++j) {
+      updates[i * cols + j] = static_cast<float>((i + j) % 3);
+      expected[indices[i] * cols + j] += updates[i * cols + j];
+    }
+  }
+
+  OpTester test("ScatterND", 18);
+  test.AddAttribute("reduction", "add");
+  test.AddInput<float>("data", {rows, cols}, data);
+  test.AddInput<int64_t>("indices", {num_updates, 1}, indices);
+  test.AddInput<float>("updates", {num_updates, cols}, updates);
+  test.AddOutput<float>("output", {rows, cols}, expected);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
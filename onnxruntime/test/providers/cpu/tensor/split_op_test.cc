@@ -4,6 +4,9 @@
 #include "gtest/gtest.h"
 #include "core/framework/to_tensor_proto_element_type.h"
 #include "test/providers/provider_test_utils.h"
+#ifdef ENABLE_STRIDED_TENSORS
+#include "test/providers/kernel_compute_test_utils.h"
+#endif
 
 namespace onnxruntime {
 namespace test {
@@ -872,5 +875,31 @@ TEST(SplitOperatorTest, Split3Inner) {
   do_test(splits);
 }
 
+#ifdef ENABLE_STRIDED_TENSORS
+// The input is the transposed view of a 3x2 tensor.
+TEST(SplitOperatorTest, StridedInputCpu) {
+  // Split axis 1.
+  {
+    KernelComputeTester test("Split", kCpuExecutionProvider, 13);
+    test.AddInput<float>("input", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}, {1, 2});
+    test.AddInput<int64_t>("split", {2}, {1, 2}, {}, true);
+    test.AddAttribute("axis", static_cast<int64_t>(1));
+    test.AddOutput<float>("output_0", {2, 1}, {1.f, 2.f});
+    test.AddOutput<float>("output_1", {2, 2}, {3.f, 5.f, 4.f, 6.f});
+    test.Run();
+  }
+
+  // Split axis 0, which would be a view of a contiguous input.
+  {
+    KernelComputeTester test("Split", kCpuExecutionProvider, 13);
+    test.AddInput<float>("input", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}, {1, 2});
+    test.AddAttribute("axis", static_cast<int64_t>(0));
+    test.AddOutput<float>("output_0", {1, 3}, {1.f, 3.f, 5.f});
+    test.AddOutput<float>("output_1", {1, 3}, {2.f, 4.f, 6.f});
+    test.Run();
+  }
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -8,6 +8,9 @@
 #include "core/providers/cpu/tensor/transpose.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/asserts.h"
+#ifdef ENABLE_STRIDED_TENSORS
+#include "test/providers/kernel_compute_test_utils.h"
+#endif
 
 namespace onnxruntime {
 namespace test {
@@ -684,6 +687,60 @@ TEST(TransposeOpTest, NDim) {
   TransposeTest(input_shape, input_vals, &perm, input_shape, expected_vals2);
 }
 
+// Computes the expected output of a transpose with an element by element copy.
+template <typename T>
+static std::vector<T> NaiveTranspose(const std::vector<int64_t>& input_shape, const std::vector<T>& input_vals,
+                                     const std::vector<int64_t>& perm, std::vector<int64_t>& output_shape) {
+  const size_t rank = input_shape.size();
+  std::vector<int64_t> input_strides(rank, 1);
+  for (size_t i = rank - 1; i > 0; --i) {
+    input_strides[i - 1] = input_strides[i] * input_shape[i];
+  }
+  output_shape.resize(rank);
+  for (size_t k = 0; k < rank; ++k) {
+    output_shape[k] = input_shape[perm[k]];
+  }
+
+  std::vector<T> output_vals(input_vals.size());
+  for (size_t output_index = 0; output_index < output_vals.size(); ++output_index) {
+    int64_t remainder = static_cast<int64_t>(output_index);
+    int64_t input_index = 0;
+    for (size_t k = rank; k-- > 0;) {
+      input_index += (remainder % output_shape[k]) * input_strides[perm[k]];
+      remainder /= output_shape[k];
+    }
+    output_vals[output_index] = input_vals[input_index];
+  }
+  return output_vals;
+}
+
+// Permutations the blocked transpose handles after coalescing the axes, with sizes that aren't multiples of the tile.
+TEST(TransposeOpTest, BlockedTranspose) {
+  const std::vector<std::pair<std::vector<int64_t>, std::vector<int64_t>>> cases = {
+      {{3, 7, 2, 5}, {2, 1, 0, 3}},          // the innermost axis stays innermost, copies blocks of 5
+      {{2, 19, 3, 37}, {3, 0, 2, 1}},        // tiles with partial rows and columns
+      {{3, 1, 21, 2, 17}, {4, 2, 1, 0, 3}},  // size 1 axis and axes that don't stay together
+      {{5, 4, 3, 2, 9}, {1, 4, 2, 3, 0}},    // axes 2 and 3 are merged
+  };
+
+  for (const auto& [input_shape, perm] : cases) {
+    std::vector<float> input_vals(static_cast<size_t>(TensorShape(input_shape).Size()));
+    for (size_t i = 0; i < input_vals.size(); ++i) {
+      input_vals[i] = static_cast<float>(i);
+    }
+    std::vector<int64_t> expected_shape;
+    std::vector<float> expected_vals = NaiveTranspose(input_shape, input_vals, perm, expected_shape);
+    TransposeTest(input_shape, input_vals, &perm, expected_shape, expected_vals);
+
+    std::vector<uint8_t> input_vals_uint8(input_vals.size());
+    for (size_t i = 0; i < input_vals.size(); ++i) {
+      input_vals_uint8[i] = static_cast<uint8_t>(i * 7);
+    }
+    std::vector<uint8_t> expected_vals_uint8 = NaiveTranspose(input_shape, input_vals_uint8, perm, expected_shape);
+    TransposeTest(input_shape, input_vals_uint8, &perm, expected_shape, expected_vals_uint8);
+  }
+}
+
 TEST(TransposeOpTest, DoTransposeImpl) {
   std::vector<int64_t> input_shape({5, 2, 1, 3});
   std::vector<float> input_vals(30);
@@ -864,5 +921,27 @@ TEST(TransposeOpTest, TransposeBigMLFloat16) {  // Exercises CanUse_cublasTransp
 }
 #endif  // defined(USE_CUDA) || defined(USE_ROCM)
 
+#ifdef ENABLE_STRIDED_TENSORS
+TEST(TransposeOpTest, StridedCpu) {
+  // Contiguous output.
+  {
+    KernelComputeTester test("Transpose", kCpuExecutionProvider, 13);
+    test.AddInput<float>("X", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+    test.AddAttribute("perm", std::vector<int64_t>{1, 0});
+    test.AddOutput<float>("Y", {3, 2}, {1.f, 4.f, 2.f, 5.f, 3.f, 6.f});
+    test.Run();
+  }
+
+  // Strided output sharing the input buffer.
+  {
+    KernelComputeTester test("Transpose", kCpuExecutionProvider, 13);
+    test.AddInput<float>("X", {2, 3, 4}, std::vector<float>(24, 1.f));
+    test.AddAttribute("perm", std::vector<int64_t>{2, 0, 1});
+    test.AddOutput<float>("Y", {4, 2, 3}, std::vector<float>(24, 1.f), {1, 12, 4});
+    test.Run({0});
+  }
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
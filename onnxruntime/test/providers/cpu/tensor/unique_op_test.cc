@@ -1,6 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <map>
+#include <numeric>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -394,5 +398,52 @@ TEST(Unique, EmptyInput) {
   test.Run();
 }
 
+TEST(Unique, Flatten_ManyElements) {
+  // large enough to be hashed in several blocks and merged
+  constexpr int64_t n = 100000;
+  std::vector<int64_t> X(n);
+  for (int64_t i = 0; i < n; ++i) {
+    X[i] = (i * 7919) % 1000 - 500;
+  }
+
+  for (bool sorted : {false, true}) {
+    std::vector<int64_t> Y, indices, counts;
+    std::map<int64_t, size_t> positions;
+    for (int64_t i = 0; i < n; ++i) {
+      if (positions.emplace(X[i], Y.size()).second) {
+        Y.push_back(X[i]);
+        indices.push_back(i);
+        counts.push_back(0);
+      }
+      ++counts[positions[X[i]]];
+    }
+
+    if (sorted) {
+      std::vector<size_t> order(Y.size());
+      std::iota(order.begin(), order.end(), size_t{0});
+      std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return Y[a] < Y[b]; });
+      std::vector<int64_t> sorted_Y, sorted_indices, sorted_counts;
+      for (size_t i = 0; i < order.size(); ++i) {
+        sorted_Y.push_back(Y[order[i]]);
+        sorted_indices.push_back(indices[order[i]]);
+        sorted_counts.push_back(counts[order[i]]);
+        positions[Y[order[i]]] = i;
+      }
+      Y = std::move(sorted_Y);
+      indices = std::move(sorted_indices);
+      counts = std::move(sorted_counts);
+    }
+
+    std::vector<int64_t> inverse_indices;
+    for (int64_t x : X) {
+      inverse_indices.push_back(static_cast<int64_t>(positions[x]));
+    }
+
+    const std::vector<int64_t> unique_dims{static_cast<int64_t>(Y.size())};
+    RunUniqueTest<int64_t>({n}, X, nullptr, sorted, unique_dims, Y, unique_dims, indices, {n}, inverse_indices,
+                           unique_dims, counts);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -211,6 +211,28 @@ TEST(ContribOpTest, StringNormalizerSensitiveFilterOutUpperEmptyCase) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(ContribOpTest, StringNormalizerInsensitiveFilterOutLowerManyStrings) {
+  // - case-INSENSITIVE approach en_US locale
+  // - enough strings to be processed in several batches
+  // - a mix of ASCII and non-ASCII strings, filter out monday in any case
+  OpTester test("StringNormalizer", opset_ver, domain);
+  InitTestAttr(test, "LOWER", false, {"monday"}, test_locale);
+  const std::vector<std::string> words = {"MonDay", "TUESDAY", "Besançon", "ПОНЕДЕЛЬНИК", "Mixed Case 42", ""};
+  const std::vector<std::string> lower = {"", "tuesday", "besançon", "понедельник", "mixed case 42", ""};
+  std::vector<std::string> input;
+  std::vector<std::string> output;
+  for (size_t i = 0; i < 1000; ++i) {
+    const size_t w = i % words.size();
+    input.push_back(words[w]);
+    if (w != 0) {
+      output.push_back(lower[w]);
+    }
+  }
+  test.AddInput<std::string>("T", {static_cast<int64_t>(input.size())}, input);
+  test.AddOutput<std::string>("Y", {static_cast<int64_t>(output.size())}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 // Fails on iOS because necessary locales are not installed
 // MacOS runs fine.
 #ifndef ORT_IOS
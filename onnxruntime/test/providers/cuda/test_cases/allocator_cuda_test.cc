@@ -1,10 +1,13 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <limits>
+
 #include "core/framework/allocator_utils.h"
 #include "gtest/gtest.h"
 #include "cuda_runtime.h"
 #include "core/framework/allocator.h"
+#include "core/framework/stream_handles.h"
 #include "core/providers/cuda/cuda_allocator.h"
 #include "core/providers/cuda/cuda_common.h"
 
@@ -113,5 +116,57 @@ TEST(AllocatorTest, CUDAAllocatorFallbackTest) {
   auto last_error = cudaGetLastError();
   EXPECT_EQ(last_error, cudaSuccess) << "Last error should be cleared if handled gracefully";
 }
+
+// memory freed on a stream is reused by the next allocation of the same size on that stream
+TEST(AllocatorTest, CUDAMempoolAllocatorTest) {
+  OrtDevice::DeviceId cuda_device_id = 0;
+  CUDA_CALL_THROW(cudaSetDevice(cuda_device_id));
+
+  AllocatorCreationInfo default_memory_info(
+      {[](OrtDevice::DeviceId id) {
+         return std::make_unique<CUDAMempoolAllocator>(id, CUDA, std::numeric_limits<uint64_t>::max());
+       },
+       cuda_device_id, false});
+  auto cuda_allocator = CreateAllocator(default_memory_info);
+  EXPECT_EQ(cuda_allocator->Info().alloc_type, OrtDeviceAllocator);
+  EXPECT_TRUE(cuda_allocator->IsStreamOrdered());
+
+  cudaStream_t cuda_stream;
+  CUDA_CALL_THROW(cudaStreamCreateWithFlags(&cuda_stream, cudaStreamNonBlocking));
+  Stream stream(cuda_stream, cuda_allocator->Info().device);
+
+  size_t size = 1024;
+  void* cuda_addr_0 = AllocateBufferWithOptions(*cuda_allocator, size, false, &stream, nullptr);
+  EXPECT_TRUE(cuda_addr_0);
+  CUDA_CALL_THROW(cudaMemsetAsync(cuda_addr_0, -1, size, cuda_stream));
+  cuda_allocator->Free(cuda_addr_0);
+
+  void* cuda_addr_1 = AllocateBufferWithOptions(*cuda_allocator, size, false, &stream, nullptr);
+  EXPECT_EQ(cuda_addr_1, cuda_addr_0);
+  int value = 0;
+  CUDA_CALL_THROW(cudaMemcpyAsync(&value, cuda_addr_1, sizeof(value), cudaMemcpyDeviceToHost, cuda_stream));
+  CUDA_CALL_THROW(cudaStreamSynchronize(cuda_stream));
+  EXPECT_EQ(value, -1);
+
+  AllocatorStats stats;
+  cuda_allocator->GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 2);
+  EXPECT_GE(stats.bytes_in_use, static_cast<int64_t>(size));
+
+  // memory allocated without a stream is usable once Alloc() returns
+  void* cuda_addr_2 = cuda_allocator->Alloc(size);
+  EXPECT_TRUE(cuda_addr_2);
+  CUDA_CALL_THROW(cudaMemset(cuda_addr_2, 0, size));
+  cuda_allocator->Free(cuda_addr_2);
+
+  cuda_allocator->Free(cuda_addr_1);
+  CUDA_CALL_THROW(cudaDeviceSynchronize());
+  ASSERT_TRUE(cuda_allocator->Shrink().IsOK());
+  cuda_allocator->GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+
+  CUDA_CALL_THROW(cudaStreamDestroy(cuda_stream));
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -7,6 +7,7 @@
 //  2. increase binary size of ORT.
 
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <iostream>
 
 #include "core/framework/run_options.h"
@@ -90,6 +91,20 @@ TEST(TestDeferredRelease, WithoutArena) {
   ORT_THROW_IF_ERROR(ep.OnRunEnd(true, run_opts));
 }
 
+TEST(TestStreamPriority, ClampedToDeviceRange) {
+  int least_priority = 0;
+  int greatest_priority = 0;
+  ASSERT_EQ(cudaDeviceGetStreamPriorityRange(&least_priority, &greatest_priority), cudaSuccess);
+
+  for (int requested : {greatest_priority - 1, greatest_priority, least_priority, least_priority + 1}) {
+    cudaStream_t stream = CreateCudaStream(requested);
+    int priority = 0;
+    ASSERT_EQ(cudaStreamGetPriority(stream, &priority), cudaSuccess);
+    EXPECT_EQ(priority, std::clamp(requested, greatest_priority, least_priority));
+    ASSERT_EQ(cudaStreamDestroy(stream), cudaSuccess);
+  }
+}
+
 }  // namespace test
 }  // namespace cuda
 }  // namespace onnxruntime
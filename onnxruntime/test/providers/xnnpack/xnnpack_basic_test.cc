@@ -313,6 +313,55 @@ TEST(XnnpackEP, TestMaxPool) {
                });
 }
 
+// with enable_subgraph_compile the Conv, Relu and MaxPool should be compiled into a single xnn_runtime
+TEST(XnnpackEP, TestCompiledSubgraph) {
+  const std::vector<int64_t> input_shape = {1, 3, 12, 12};
+  auto build_test_case = [&input_shape](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>(input_shape, -1.f, 1.f);
+    auto* weight = builder.MakeInitializer<float>({8, 3, 3, 3}, -1.f, 1.f);
+    auto* bias = builder.MakeInitializer<float>({8}, -1.f, 1.f);
+    auto* conv_output = builder.MakeIntermediate();
+    auto* relu_output = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    Node& conv_node = builder.AddNode("Conv", {input_arg, weight, bias}, {conv_output});
+    conv_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    builder.AddNode("Relu", {conv_output}, {relu_output});
+    Node& pool_node = builder.AddNode("MaxPool", {relu_output}, {output_arg});
+    pool_node.AddAttribute("kernel_shape", std::vector<int64_t>{2, 2});
+    pool_node.AddAttribute("strides", std::vector<int64_t>{2, 2});
+  };
+
+  onnxruntime::Model model("xnnpack_test_graph_compiled_subgraph", false, DefaultLoggingManager().DefaultLogger());
+  ModelTestBuilder helper(model.MainGraph());
+  build_test_case(helper);
+  helper.SetGraphOutputs();
+  ASSERT_STATUS_OK(model.MainGraph().Resolve());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+  const auto model_data_span = AsByteSpan(model_data.data(), model_data.size());
+
+  std::function<void(const Graph&)> verify = [](const Graph& graph) -> void {
+    int num_xnnpack_nodes = 0;
+    for (const auto& node : graph.Nodes()) {
+      ASSERT_TRUE(node.OpType() != "Conv" && node.OpType() != "Relu" && node.OpType() != "MaxPool")
+          << node.OpType() << " should have been compiled";
+      num_xnnpack_nodes += node.GetExecutionProviderType() == kXnnpackExecutionProvider;
+    }
+    ASSERT_EQ(num_xnnpack_nodes, 1) << "Conv, Relu and MaxPool should be a single compiled node.";
+  };
+
+  EPVerificationParams params;
+  params.ep_node_assignment = ExpectedEPNodeAssignment::Some;
+  params.fp32_abs_err = 1e-4f;
+  params.graph_verifier = &verify;
+
+  ProviderOptions provider_options{{"enable_subgraph_compile", "1"}};
+  auto ep = std::make_unique<XnnpackExecutionProvider>(XnnpackExecutionProviderInfo(provider_options, nullptr));
+  RunAndVerifyOutputsWithEP(model_data_span, "XnnpackEP.TestCompiledSubgraph", std::move(ep), helper.feeds_, params);
+}
+
 TEST(XnnpackEP, DISABLED_TestQDQMaxPool_u8) {  //  [ONNXRuntimeError] : 9 : NOT_IMPLEMENTED : Could not find an implementation for QuantizeLinear(19) node with name 'node'
   RunModelTest(BuildQDQMaxPoolTestCase<uint8_t /* InputType */,
                                        uint8_t /* OutputType */>(
@@ -379,6 +428,28 @@ TEST(XnnpackEP, TestSoftMax_axisLast) {
                {ExpectedEPNodeAssignment::All});
 }
 
+TEST(XnnpackEP, TestBinaryElementwiseAndTranspose) {
+  auto modelBuilder = [](ModelTestBuilder& builder) {
+    auto* a = builder.MakeInput<float>({2, 3, 4}, -1.f, 1.f);
+    auto* b = builder.MakeInput<float>({3, 1}, -1.f, 1.f);
+    auto* c = builder.MakeInitializer<float>({4}, 1.f, 2.f);
+    auto* add_output = builder.MakeIntermediate();
+    auto* sub_output = builder.MakeIntermediate();
+    auto* mul_output = builder.MakeIntermediate();
+    auto* div_output = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Add", {a, b}, {add_output});
+    builder.AddNode("Sub", {add_output, c}, {sub_output});
+    builder.AddNode("Mul", {sub_output, a}, {mul_output});
+    builder.AddNode("Div", {mul_output, c}, {div_output});
+    Node& transpose_node = builder.AddNode("Transpose", {div_output}, {output_arg});
+    transpose_node.AddAttribute("perm", std::vector<int64_t>{2, 0, 1});
+  };
+  RunModelTest(modelBuilder, "xnnpack_test_graph_binary_elementwise_transpose",
+               {ExpectedEPNodeAssignment::All, 1e-5f /* fp32_abs_err */});
+}
+
 TEST(XnnpackEP, TestQDQSoftMax_axisLast) {
   RunModelTest(BuildQDQSoftMaxTestCase<uint8_t, uint8_t>(
                    {1, 2, 3, 5} /* input_shape */,
@@ -2693,6 +2693,31 @@ TEST(CApiTest, get_string_tensor_element) {
   ASSERT_EQ(expected_string_len, string_len);
 }
 
+TEST(CApiTest, get_string_tensor_element_views) {
+  const char* s[] = {"abc", "", "kmpq"};
+  constexpr int64_t expected_len = 3;
+  auto default_allocator = std::make_unique<MockedOrtAllocator>();
+
+  Ort::Value tensor = Ort::Value::CreateTensor(default_allocator.get(), &expected_len, 1,
+                                               ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING);
+  tensor.FillStringTensor(s, expected_len);
+
+  std::vector<const char*> data(expected_len);
+  std::vector<size_t> lengths(expected_len);
+  tensor.GetStringTensorElementViews(data.data(), lengths.data(), data.size());
+  for (size_t i = 0; i < expected_len; i++) {
+    ASSERT_EQ(std::string_view(data[i], lengths[i]), s[i]);
+  }
+
+  // The views point at the strings held by the tensor
+  auto* buffer = tensor.GetResizedStringTensorElementBuffer(2, 4);
+  memcpy(buffer, "wxyz", 4);
+  tensor.GetStringTensorElementViews(data.data(), lengths.data(), data.size());
+  ASSERT_EQ(std::string_view(data[2], lengths[2]), "wxyz");
+
+  ASSERT_THROW(tensor.GetStringTensorElementViews(data.data(), lengths.data(), 2), Ort::Exception);
+}
+
 TEST(CApiTest, create_tensor_with_data) {
   float values[] = {3.0f, 1.0f, 2.f, 0.f};
   constexpr size_t values_length = sizeof(values) / sizeof(values[0]);
@@ -4450,3 +4475,55 @@ TEST(CApiTest, OrtCustomOp_GetInPlace) {
   ASSERT_EQ(len, static_cast<size_t>(2));
   mock_gqa.ReleaseAliasMap(input_index, output_index);
 }
+
+struct InplaceCustomOp : Ort::CustomOpBase<InplaceCustomOp, MyCustomKernel> {
+  void* CreateKernel(const OrtApi& api, const OrtKernelInfo* info) const { return new MyCustomKernel(api, info); };
+  const char* GetName() const { return "InplaceFoo"; };
+
+  size_t GetInputTypeCount() const { return 2; };
+  ONNXTensorElementDataType GetInputType(size_t /*index*/) const { return ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT; };
+
+  size_t GetOutputTypeCount() const { return 1; };
+  ONNXTensorElementDataType GetOutputType(size_t /*index*/) const { return ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT; };
+
+  static std::vector<std::pair<int, int>> MayInplace() { return {{1, 0}}; }
+};
+
+struct LiteAliasOp {
+  LiteAliasOp(const OrtApi*, const OrtKernelInfo*) {}
+  Ort::Status Compute(const Ort::Custom::Tensor<float>& input, Ort::Custom::Tensor<float>* output) {
+    // The output aliases the input, so allocating it hands back the input buffer.
+    output->Allocate(input.Shape());
+    return Ort::Status(nullptr);
+  }
+  static std::vector<std::pair<int, int>> AliasMap() { return {{0, 0}}; }
+};
+
+TEST(CApiTest, CustomOpBase_DeclaredInPlaceAndAlias) {
+  InplaceCustomOp inplace_op;
+  int* input_index = nullptr;
+  int* output_index = nullptr;
+  ASSERT_NE(inplace_op.GetMayInplace, nullptr);
+  size_t len = inplace_op.GetMayInplace(&input_index, &output_index);
+  ASSERT_EQ(len, static_cast<size_t>(1));
+  ASSERT_EQ(input_index[0], 1);
+  ASSERT_EQ(output_index[0], 0);
+  inplace_op.ReleaseMayInplace(input_index, output_index);
+  ASSERT_EQ(inplace_op.GetAliasMap, nullptr);
+
+  // ops that declare nothing keep the callbacks unset
+  MyCustomOp plain_op{onnxruntime::kCpuExecutionProvider};
+  ASSERT_EQ(plain_op.GetMayInplace, nullptr);
+  ASSERT_EQ(plain_op.GetAliasMap, nullptr);
+
+  std::unique_ptr<Ort::Custom::OrtLiteCustomOp> alias_op{
+      Ort::Custom::CreateLiteCustomOp<LiteAliasOp>("LiteAlias", "CPUExecutionProvider")};
+  ASSERT_EQ(alias_op->GetMayInplace, nullptr);
+  ASSERT_NE(alias_op->GetAliasMap, nullptr);
+  input_index = output_index = nullptr;
+  len = alias_op->GetAliasMap(&input_index, &output_index);
+  ASSERT_EQ(len, static_cast<size_t>(1));
+  ASSERT_EQ(input_index[0], 0);
+  ASSERT_EQ(output_index[0], 0);
+  alias_op->ReleaseAliasMap(input_index, output_index);
+}
@@ -3,6 +3,8 @@
 
 #include "orttraining/core/graph/allreduce_optimizer_graph_builder.h"
 
+#include <numeric>
+
 #include "orttraining/core/framework/distributed_run_context.h"
 
 namespace onnxruntime {
@@ -17,6 +19,7 @@ static bool IsNcclAvailable() {
 }
 
 static Status AddNcclAllReduceForGradients(
+    const std::string& node_name,
     std::vector<ArgDef>& gradient_argdefs,
     std::vector<ArgDef>& input_gradient_argdef,
     GraphAugmenter::GraphDefs& graph_defs) {
@@ -35,12 +38,55 @@ static Status AddNcclAllReduceForGradients(
                                   allreduce_outputs,
                                   {ONNX_NAMESPACE::MakeAttribute("group_type",
                                                                  static_cast<int64_t>(WorkerGroupType::DataParallel))},
-                                  "NcclAllReduce")});
+                                  node_name)});
 
   gradient_argdefs = allreduce_outputs;
   return Status::OK();
 }
 
+// Splits the gradients into buckets of about bucket_size_bytes that are all-reduced together.
+// The backward pass produces the gradients of the last weights first, so the buckets are formed in reverse order
+// of the gradients. The all-reduce of a bucket then only depends on gradients that are final early, and can run
+// while the rest of the backward pass is computed.
+// A bucket_size_bytes of 0 puts all the gradients into a single bucket.
+static std::vector<std::vector<size_t>> BucketGradients(const std::vector<ArgDef>& gradient_argdefs,
+                                                        size_t bucket_size_bytes,
+                                                        size_t element_size) {
+  std::vector<std::vector<size_t>> buckets;
+  if (bucket_size_bytes == 0) {
+    buckets.emplace_back(gradient_argdefs.size());
+    std::iota(buckets.back().begin(), buckets.back().end(), size_t{0});
+    return buckets;
+  }
+
+  size_t current_bucket_bytes = 0;
+  for (size_t i = gradient_argdefs.size(); i-- > 0;) {
+    // Gradients with a symbolic shape are assumed to fill a bucket on their own.
+    size_t gradient_bytes = element_size;
+    const auto* type_proto = gradient_argdefs[i].type_proto;
+    if (type_proto != nullptr && type_proto->tensor_type().has_shape()) {
+      for (const auto& dim : type_proto->tensor_type().shape().dim()) {
+        if (!dim.has_dim_value()) {
+          gradient_bytes = bucket_size_bytes;
+          break;
+        }
+        gradient_bytes *= static_cast<size_t>(dim.dim_value());
+      }
+    } else {
+      gradient_bytes = bucket_size_bytes;
+    }
+
+    if (buckets.empty() || current_bucket_bytes >= bucket_size_bytes) {
+      buckets.emplace_back();
+      current_bucket_bytes = 0;
+    }
+    buckets.back().push_back(i);
+    current_bucket_bytes += gradient_bytes;
+  }
+
+  return buckets;
+}
+
 AllreduceOptimizerGraphBuilder::AllreduceOptimizerGraphBuilder(
     const OptimizerBuilderRegistry& opt_builder_registry,
     const OptimizerGraphConfig& opt_graph_config,
@@ -75,15 +121,34 @@ Status AllreduceOptimizerGraphBuilder::BuildInternal(
   };
 
   // add gradient scaling
-  std::vector<ArgDef> output_gradient_argdef;
   const auto total_num_accumulations =
       opt_graph_config_.gradient_accumulation_steps * opt_graph_config_.data_parallel_group_size;
   ORT_RETURN_IF_NOT(total_num_accumulations > 0, "total_num_accumulations <= 0");
   const float scale = 1.0f / total_num_accumulations;
-  ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, gradient_argdefs, output_gradient_argdef, graph_defs,
-                                              opt_graph_config_.AllReduceDataType()));
-
-  ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(gradient_argdefs, output_gradient_argdef, graph_defs));
+  const auto allreduce_data_type = opt_graph_config_.AllReduceDataType();
+  const size_t element_size = allreduce_data_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT ? 4 : 2;
+
+  // Each bucket is scaled and all-reduced by its own nodes, so that it does not wait for the other buckets.
+  std::vector<ArgDef> allreduced_gradient_argdefs(gradient_argdefs.size());
+  for (const auto& bucket : BucketGradients(gradient_argdefs, opt_graph_config_.allreduce_bucket_size_bytes,
+                                            element_size)) {
+    std::vector<ArgDef> bucket_gradient_argdefs;
+    bucket_gradient_argdefs.reserve(bucket.size());
+    for (size_t i : bucket) {
+      bucket_gradient_argdefs.push_back(gradient_argdefs[i]);
+    }
+
+    std::vector<ArgDef> output_gradient_argdef;
+    ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, bucket_gradient_argdefs,
+                                                output_gradient_argdef, graph_defs, allreduce_data_type));
+    ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(nodearg_name_generator("NcclAllReduce"),
+                                                     bucket_gradient_argdefs, output_gradient_argdef, graph_defs));
+
+    for (size_t j = 0; j < bucket.size(); ++j) {
+      allreduced_gradient_argdefs[bucket[j]] = bucket_gradient_argdefs[j];
+    }
+  }
+  gradient_argdefs = std::move(allreduced_gradient_argdefs);
 
   // check if all gradients are finite
   ArgDef global_grad_norm_argdef;
@@ -68,6 +68,8 @@ struct OptimizerGraphConfig {
   MixedPrecisionDataType mixed_precision_type{MixedPrecisionDataType::FP16};
   bool allreduce_in_mixed_precision_type{false};
   bool use_nccl{false};
+  // approximate size in bytes of the gradient buckets that are all-reduced together, 0 for a single bucket
+  size_t allreduce_bucket_size_bytes{0};
   ZeROConfig deepspeed_zero{0};
   int gradient_accumulation_steps{1};
   std::string loss_scale_input_name{};  // empty string means no loss scaling factor is applied
@@ -10,5 +10,15 @@ inline std::string RecomputeName(const std::string& name) {
   return name + "_recompute";
 }
 
+// Name of the host memory copy of an offloaded activation.
+inline std::string OffloadName(const std::string& name) {
+  return name + "_offload";
+}
+
+// Name of the device memory copy restored from an offloaded activation, consumed by backward nodes.
+inline std::string OffloadRestoreName(const std::string& name) {
+  return name + "_offload_restore";
+}
+
 }  // namespace graph_utils
 }  // namespace onnxruntime
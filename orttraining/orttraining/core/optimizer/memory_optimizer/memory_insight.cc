@@ -248,6 +248,13 @@ Status FindORTModuleMemoryOpportunity(const GraphViewer& graph_viewer,
         memory_opt_planner.AddNodeOptimizationPlan(p_node, std::move(recompute_with_compromise_plan));
       }
     }
+
+    // Offload does not depend on the subgraph probing result, any stashed activation living in device memory
+    // can be copied to host and back.
+    std::unique_ptr<NodeOffloadPlan> offload_plan = CheckNodeForOffload(*p_node, candidate_output_args_map, logger);
+    if (offload_plan != nullptr) {
+      memory_opt_planner.AddNodeOptimizationPlan(p_node, std::move(offload_plan));
+    }
   }
 
   return Status::OK();
@@ -285,6 +292,10 @@ void GetMemoryRecordsGroupedByNodeClusterId(const MemoryOptimizationPlanner& mem
             if (is_output_reusing_buffers) {
               record.output_port_reuse_recompute_count[output_index] += 1;
             }
+          } else if (plan->GetOptimizationType() == OptimizationType::Offload) {
+            if (is_output_reusing_buffers) {
+              record.output_port_reuse_offload_count[output_index] += 1;
+            }
           }
         }
       }
@@ -299,6 +310,8 @@ void GetMemoryRecordsGroupedByNodeClusterId(const MemoryOptimizationPlanner& mem
             dynamic_cast<NodeRecomputePlan*>(plan.get())->GetNodesInTopoOrderStr();
       } else if (plan->GetOptimizationType() == OptimizationType::Recompute) {
         record.recompute_subgraph_str = dynamic_cast<NodeRecomputePlan*>(plan.get())->GetNodesInTopoOrderStr();
+      } else if (plan->GetOptimizationType() == OptimizationType::Offload) {
+        record.offload_subgraph_str = plan->GetClusterId();
       }
 
       gsl::span<const size_t> output_indices = plan->GetActivationOutputIndices();
@@ -324,6 +337,11 @@ void GetMemoryRecordsGroupedByNodeClusterId(const MemoryOptimizationPlanner& mem
                                                  plan->GetActivationOutputDimParamString(output_index),
                                                  byte_count_per_element,
                                                  plan->GetSaveRatio());
+        } else if (plan->GetOptimizationType() == OptimizationType::Offload) {
+          record.offloaded_outputs.emplace_back(output_index,
+                                                plan->GetActivationOutputDimParamString(output_index),
+                                                byte_count_per_element,
+                                                plan->GetSaveRatio());
         }
       }
     }
@@ -370,6 +388,9 @@ void GetMemoryRecordsGroupedByNodeClusterId(const MemoryOptimizationPlanner& mem
         node_cluster_id_to_record_map[node_cluster_id]->actual_recompute_with_compromise_count += 1;
         node_cluster_id_to_record_map[node_cluster_id]->request_recompute_with_compromise_count =
             apply_context->requested_count;
+      } else if (apply_context->type == OptimizationType::Offload) {
+        node_cluster_id_to_record_map[node_cluster_id]->actual_offload_count += 1;
+        node_cluster_id_to_record_map[node_cluster_id]->request_offload_count = apply_context->requested_count;
       } else {
         ORT_THROW("Unsupported optimization type found.");
       }
@@ -573,25 +594,47 @@ std::string ToFixedLengthString(T value, int length) {
   return oss.str();
 }
 
-void FormatRecomputeMemoryRecords(int option_index,
-                                  const MemoryRecord& record,
-                                  bool compromise_recompute,
-                                  InlinedVector<std::string>& rows) {
-  const auto subgraph_str = compromise_recompute ? record.recompute_with_compromise_subgraph_str
-                                                 : record.recompute_subgraph_str;
-  const auto opt_type = compromise_recompute ? OptimizationType::RecomputeWithCompromise
-                                             : OptimizationType::Recompute;
-  const auto request_count = compromise_recompute ? record.request_recompute_with_compromise_count
-                                                  : record.request_recompute_count;
-  const auto actual_count = compromise_recompute ? record.actual_recompute_with_compromise_count
-                                                 : record.actual_recompute_count;
+void FormatMemoryRecords(int option_index,
+                         const MemoryRecord& record,
+                         OptimizationType opt_type,
+                         InlinedVector<std::string>& rows) {
+  const std::string* subgraph_str = nullptr;
+  int request_count = 0;
+  int actual_count = 0;
+  const InlinedHashMap<size_t, int>* reused_buffers = nullptr;
+  const InlinedVector<MemoryRecord::OutputStat>* outputs = nullptr;
+  switch (opt_type) {
+    case OptimizationType::Recompute:
+      subgraph_str = &record.recompute_subgraph_str;
+      request_count = record.request_recompute_count;
+      actual_count = record.actual_recompute_count;
+      reused_buffers = &record.output_port_reuse_recompute_count;
+      outputs = &record.recomputed_outputs;
+      break;
+    case OptimizationType::RecomputeWithCompromise:
+      subgraph_str = &record.recompute_with_compromise_subgraph_str;
+      request_count = record.request_recompute_with_compromise_count;
+      actual_count = record.actual_recompute_with_compromise_count;
+      reused_buffers = &record.output_port_reuse_recompute_with_compromise_count;
+      outputs = &record.compromise_recomputed_outputs;
+      break;
+    case OptimizationType::Offload:
+      subgraph_str = &record.offload_subgraph_str;
+      request_count = record.request_offload_count;
+      actual_count = record.actual_offload_count;
+      reused_buffers = &record.output_port_reuse_offload_count;
+      outputs = &record.offloaded_outputs;
+      break;
+    default:
+      ORT_THROW("Unsupported optimization type found.");
+  }
 
   const std::string empty_first_col = "|" + ToFixedLengthString(std::string(), kFirstColumnWidth) + "|";
 
   rows.push_back(empty_first_col);
   rows.push_back(empty_first_col +
                  ToFixedLengthString(">>Option " + std::to_string(option_index), kTitleWidthInSecondColumn) + ": " +
-                 OptimizationTypeToString(opt_type) + " subgraph " + subgraph_str);
+                 OptimizationTypeToString(opt_type) + " subgraph " + *subgraph_str);
 
   if (request_count) {
     // Only show this if user requested it.
@@ -608,32 +651,21 @@ void FormatRecomputeMemoryRecords(int option_index,
   std::string activation_str = empty_first_col + "  Stashed Activations: ";
   rows.push_back(activation_str);
 
-  const auto& reused_buffers = compromise_recompute ? record.output_port_reuse_recompute_with_compromise_count
-                                                    : record.output_port_reuse_recompute_count;
-  if (reused_buffers.size() > 0) {
+  if (reused_buffers->size() > 0) {
     std::string reused_buffers_summary = empty_first_col + ToFixedLengthString("   - ReuseFreq", kTitleWidthInSecondColumn) + ": ";
-    for (const auto& p : reused_buffers) {
+    for (const auto& p : *reused_buffers) {
       reused_buffers_summary += " Output " + std::to_string(p.first) + "(" + std::to_string(p.second) + "),";
     }
 
     rows.push_back(reused_buffers_summary);
   }
 
-  const auto activation_count = compromise_recompute ? record.compromise_recomputed_outputs.size()
-                                                     : record.recomputed_outputs.size();
-  for (size_t i = 0; i < activation_count; ++i) {
-    const MemoryRecord::OutputStat* stat;
-    if (compromise_recompute) {
-      stat = &record.compromise_recomputed_outputs[i];
-    } else {
-      stat = &record.recomputed_outputs[i];
-    }
-
+  for (const auto& stat : *outputs) {
     rows.push_back(empty_first_col +
-                   ToFixedLengthString("   - Output " + std::to_string(stat->output_index), kTitleWidthInSecondColumn) +
-                   ": [" + stat->output_shape_str + "], byte/elem: " +
-                   std::to_string(stat->output_byte_count_per_element) +
-                   ", " + std::to_string(static_cast<int>(stat->saving_ratio * 100)) +
+                   ToFixedLengthString("   - Output " + std::to_string(stat.output_index), kTitleWidthInSecondColumn) +
+                   ": [" + stat.output_shape_str + "], byte/elem: " +
+                   std::to_string(stat.output_byte_count_per_element) +
+                   ", " + std::to_string(static_cast<int>(stat.saving_ratio * 100)) +
                    "% saved");
   }
 }
@@ -655,12 +687,17 @@ std::string SerializeMemoryRecords(
 
     int option_index = 1;
     if (record.recomputed_outputs.size() > 0) {
-      FormatRecomputeMemoryRecords(option_index, record, false, rows);
+      FormatMemoryRecords(option_index, record, OptimizationType::Recompute, rows);
       option_index++;
     }
 
     if (record.compromise_recomputed_outputs.size() > 0) {
-      FormatRecomputeMemoryRecords(option_index, record, true, rows);
+      FormatMemoryRecords(option_index, record, OptimizationType::RecomputeWithCompromise, rows);
+      option_index++;
+    }
+
+    if (record.offloaded_outputs.size() > 0) {
+      FormatMemoryRecords(option_index, record, OptimizationType::Offload, rows);
       option_index++;
     }
     rows.push_back(kTableRowSeparator);
@@ -101,24 +101,12 @@ bool MemoryOptimizer::ModifyGraph(Graph& graph,
 
   if (apply_context->skip_count > skip_count) {
     apply_context->applied_count += 1;
-    Node* replacement_node_ptr = nullptr;
     LOGS(logger, INFO) << "Node " << node->Name() << "(" << node->OpType() << ") is applying following optimization:"
                        << "type [" << optimizer::memory_optimizer::OptimizationTypeToString(apply_context->type)
                        << "], request count [" << apply_context->requested_count << "]";
-    if (apply_context->type == optimizer::memory_optimizer::OptimizationType::Recompute ||
-        apply_context->type == optimizer::memory_optimizer::OptimizationType::RecomputeWithCompromise) {
-      optimizer::memory_optimizer::NodeRecomputePlan* recompute_plan =
-          dynamic_cast<optimizer::memory_optimizer::NodeRecomputePlan*>(node_plan.get());
-      ORT_ENFORCE(recompute_plan != nullptr);
-      ORT_ENFORCE(CreateRecomputeGraph(graph, recompute_plan->GetNodesInTopoOrder(), logger, replacement_node_ptr).IsOK());
-    } else {
-      ORT_THROW("unsupported optimization type found.");
-    }
-
-    ORT_ENFORCE(replacement_node_ptr);
-
-    graph_is_modified = true;
 
+    // Collect the edges only connecting to backward ops before the graph is modified, newly added nodes
+    // consuming the node outputs (e.g. the offload copy) must not be re-routed.
     std::vector<graph_utils::GraphEdge> output_edges;
     for (auto it = node->OutputEdgesBegin(), end = node->OutputEdgesEnd(); it != end; ++it) {
       auto tid = node_index_to_its_order_in_topological_sort_map.find(it->GetNode().Index());
@@ -137,6 +125,28 @@ bool MemoryOptimizer::ModifyGraph(Graph& graph,
       }
     }
 
+    if (apply_context->type == optimizer::memory_optimizer::OptimizationType::Offload) {
+      ORT_ENFORCE(CreateOffloadGraph(graph, *node, node_plan->GetActivationOutputIndices(), output_edges,
+                                     logger)
+                      .IsOK());
+      return true;
+    }
+
+    Node* replacement_node_ptr = nullptr;
+    if (apply_context->type == optimizer::memory_optimizer::OptimizationType::Recompute ||
+        apply_context->type == optimizer::memory_optimizer::OptimizationType::RecomputeWithCompromise) {
+      optimizer::memory_optimizer::NodeRecomputePlan* recompute_plan =
+          dynamic_cast<optimizer::memory_optimizer::NodeRecomputePlan*>(node_plan.get());
+      ORT_ENFORCE(recompute_plan != nullptr);
+      ORT_ENFORCE(CreateRecomputeGraph(graph, recompute_plan->GetNodesInTopoOrder(), logger, replacement_node_ptr).IsOK());
+    } else {
+      ORT_THROW("unsupported optimization type found.");
+    }
+
+    ORT_ENFORCE(replacement_node_ptr);
+
+    graph_is_modified = true;
+
     if (!output_edges.empty()) {
       // Create connections between the replacement node and the outgoing nodes.
       for (const auto& output_edge : output_edges) {
@@ -398,4 +408,84 @@ Status MemoryOptimizer::CreateRecomputeGraph(Graph& graph,
  ** Recompute related function implementation ends   **
  ******************************************************/
 
+/******************************************************
+ ** Offload related function implementation starts   **
+ ******************************************************/
+
+Status MemoryOptimizer::CreateOffloadGraph(Graph& graph,
+                                           Node& node,
+                                           gsl::span<const size_t> activation_output_indices,
+                                           const std::vector<graph_utils::GraphEdge>& backward_output_edges,
+                                           const logging::Logger& logger) const {
+  const std::string& provider_type = node.GetExecutionProviderType();
+  for (size_t output_index : activation_output_indices) {
+    NodeArg* activation_arg = node.MutableOutputDefs()[output_index];
+
+    // Check whether the output has been offloaded or not.
+    if (graph.GetNodeArg(graph_utils::OffloadName(activation_arg->Name())) != nullptr) {
+      continue;
+    }
+
+    NodeArg* host_arg = &graph.GetOrCreateNodeArg(graph_utils::OffloadName(activation_arg->Name()),
+                                                  activation_arg->TypeAsProto());
+    NodeArg* restore_arg = &graph.GetOrCreateNodeArg(graph_utils::OffloadRestoreName(activation_arg->Name()),
+                                                     activation_arg->TypeAsProto());
+
+    // The copy to host is launched right after the producer in forward pass, so the device buffer can be released
+    // once its forward consumers are done. The copy back is scheduled right before the first backward consumer.
+    Node& to_host_node = graph.AddNode(graph.GenerateNodeName(node.Name() + "_offload"),
+                                       "MemcpyToHost",
+                                       "Offload of " + activation_arg->Name(),
+                                       {activation_arg},
+                                       {host_arg});
+    to_host_node.SetExecutionProviderType(provider_type);
+    ORT_RETURN_IF_NOT(graph.SetOpSchemaFromRegistryForNode(to_host_node),
+                      "Failed to set op schema for added offload node.");
+
+    Node& from_host_node = graph.AddNode(graph.GenerateNodeName(node.Name() + "_offload_restore"),
+                                         "MemcpyFromHost",
+                                         "Restore of offloaded " + activation_arg->Name(),
+                                         {host_arg},
+                                         {restore_arg});
+    from_host_node.SetExecutionProviderType(provider_type);
+    ORT_RETURN_IF_NOT(graph.SetOpSchemaFromRegistryForNode(from_host_node),
+                      "Failed to set op schema for added offload restore node.");
+
+    graph.UpdateProducerNode(host_arg->Name(), to_host_node.Index());
+    graph.UpdateProducerNode(restore_arg->Name(), from_host_node.Index());
+
+    graph.AddEdge(node.Index(), to_host_node.Index(), static_cast<int>(output_index), 0);
+    graph.AddConsumerNode(activation_arg->Name(), &to_host_node);
+    graph.AddEdge(to_host_node.Index(), from_host_node.Index(), 0, 0);
+    graph.AddConsumerNode(host_arg->Name(), &from_host_node);
+
+    // Let the backward consumers read the restored copy instead of the original activation.
+    for (const auto& output_edge : backward_output_edges) {
+      if (output_edge.src_arg_index != static_cast<int>(output_index)) {
+        continue;
+      }
+
+      graph.RemoveEdge(output_edge.src_node,
+                       output_edge.dst_node,
+                       output_edge.src_arg_index,
+                       output_edge.dst_arg_index);
+
+      graph.RemoveConsumerNode(activation_arg->Name(), graph.GetNode(output_edge.dst_node));
+
+      // This also updates the destination node's input node args.
+      graph.AddEdge(from_host_node.Index(), output_edge.dst_node, 0, output_edge.dst_arg_index);
+      graph.AddConsumerNode(restore_arg->Name(), graph.GetNode(output_edge.dst_node));
+    }
+
+    LOGS(logger, VERBOSE) << "Offload output " << output_index << " of Node " << node.Name() << "("
+                          << node.OpType() << ") to host memory.";
+  }
+
+  return Status::OK();
+}
+
+/******************************************************
+ ** Offload related function implementation ends     **
+ ******************************************************/
+
 }  // namespace onnxruntime
@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <vector>
+
 #include "core/common/inlined_containers.h"
 #include "core/common/string_utils.h"
+#include "core/graph/graph_utils.h"
 #include "core/optimizer/graph_transformer.h"
 #include "orttraining/core/optimizer/memory_optimizer/common.h"
 #include "orttraining/core/optimizer/memory_optimizer/optimization_planner.h"
@@ -24,6 +27,9 @@ Find recompute subgraphs and enable them according to user configs. The way we c
   b. otherwise, stop collecting and return the subgraph (could be empty).
 3. Pick up the input node from the queue, and do 2 again. The process ends when the queue is empty or 2.b happens.
 4. Clone the recomputable subgraphs and insert them back to the original graph.
+
+Alternatively, stashed activations produced on device can be offloaded: a MemcpyToHost right after the producer
+keeps a host copy during forward pass, and a MemcpyFromHost feeds the backward consumers.
 */
 
 class MemoryOptimizer : public GraphTransformer {
@@ -101,6 +107,21 @@ class MemoryOptimizer : public GraphTransformer {
    ** Recompute-related function definition ends   **
    *************************************************/
 
+  /**
+   * @brief Insert copies to move stashed activations to host memory and back.
+   *
+   * @param graph Graph to modify.
+   * @param node The node producing the stashed activations.
+   * @param activation_output_indices Output indices of node to offload.
+   * @param backward_output_edges Output edges of node connecting to backward ops, re-routed to the restored copies.
+   * @return Status
+   */
+  Status CreateOffloadGraph(Graph& graph,
+                            Node& node,
+                            gsl::span<const size_t> activation_output_indices,
+                            const std::vector<graph_utils::GraphEdge>& backward_output_edges,
+                            const logging::Logger& logger) const;
+
   // User-enabled map of the subgraph string representation to the alleviation type.
   InlinedHashMap<std::string, optimizer::memory_optimizer::UserConfig> pattern_subgraph_to_user_optimizer_config_map_;
   std::string optimizer_config_file_path_;
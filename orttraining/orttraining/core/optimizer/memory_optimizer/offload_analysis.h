@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "orttraining/core/optimizer/memory_optimizer/common.h"
+#include "orttraining/core/optimizer/memory_optimizer/optimization_planner.h"
+
+namespace onnxruntime::optimizer::memory_optimizer {
+
+/**
+ * @brief A child class used for Offload optimization plan.
+ *
+ * For each node generating stashed activations on a non-CPU device, an offload plan can be created for it.
+ * Applying the plan copies the activations to host memory right after they are produced in forward pass,
+ * and copies them back to the device right before the backward consumers need them.
+ */
+class NodeOffloadPlan : public NodeOptimizationPlanBase {
+ public:
+  NodeOffloadPlan(const Node* node,
+                  const InlinedVector<size_t>& activation_output_indices)
+      : NodeOptimizationPlanBase(node, activation_output_indices, 1.0f) {}
+
+  OptimizationType GetOptimizationType() const override {
+    return OptimizationType::Offload;
+  }
+
+  /**
+   * @brief Get the cluster id for this offload plan.
+   * Use the same representation as a single-node recompute subgraph, e.g. "Gelu+", so user can switch between
+   * the optimization types without changing the subgraph string in the config.
+   */
+  std::string GetClusterId() const override;
+
+  std::string NormalizeForNodeClusterId() const override;
+
+  std::string GetMemorySavingSymbolicString() const override;
+};
+
+/**
+ * @brief For the node producing stashed activation, check whether the activations can be offloaded to host memory.
+ *
+ * @param node The node producing stashed activations.
+ * @param candidate_output_args_map A map from node to its candidate activations.
+ * @param logger Logger.
+ * @return nullptr if the node cannot be offloaded, otherwise the offload plan.
+ */
+std::unique_ptr<NodeOffloadPlan> CheckNodeForOffload(const Node& node,
+                                                     const InlinedHashMap<const Node*, InlinedVector<size_t>>&
+                                                         candidate_output_args_map,
+                                                     const logging::Logger& logger);
+
+}  // namespace onnxruntime::optimizer::memory_optimizer
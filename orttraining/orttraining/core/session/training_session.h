@@ -186,6 +186,9 @@ class TrainingSession : public InferenceSession {
       bool do_all_reduce_in_mixed_precision_type{};
       // Whether to use NCCL.
       bool use_nccl{};
+      // The approximate size in bytes of the gradient buckets that are all-reduced together with NCCL.
+      // 0 means a single all-reduce over all the gradients once the backward pass is complete.
+      size_t allreduce_bucket_size_bytes{};
       // Whether to partition the optimizer state.
       ZeROConfig deepspeed_zero{};
       // Selects the reduction algorithm for Adasum.
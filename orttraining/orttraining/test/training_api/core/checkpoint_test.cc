@@ -581,4 +581,69 @@ TEST(CheckpointApiTest, SaveOnnxModelAsCheckpoint_ThenLoad_WithExternalData) {
   }
 }
 
+
+/**
+ * Save parameters with external data asynchronously, update the parameters while the checkpoint is being written,
+ * then load the checkpoint and check that it holds the parameter values from the time of the save call.
+ */
+TEST(CheckpointApiTest, SaveCheckpointAsyncWithExternalData_ThenLoad) {
+  const std::vector<int64_t> weight_shape{64, 128};
+  const std::vector<int64_t> bias_shape{64};
+
+  onnxruntime::training::test::training_api::SyntheticDataLoader data_loader;
+  auto sample = onnxruntime::training::test::training_api::SyntheticSampleBatch();
+  sample.AddFloatInput(weight_shape);
+  sample.AddFloatInput(bias_shape);
+  data_loader.AddSyntheticSampleBatch(std::move(sample));
+
+  std::vector<Ort::Value> all_weights_values;
+  data_loader.GetNextSampleBatch(all_weights_values);
+  ASSERT_EQ(all_weights_values.size(), size_t{2});
+  NameMLValMap name_to_ort_value{
+      {"fc.weight", *all_weights_values[0]},
+      {"fc.bias", *all_weights_values[1]},
+  };
+
+  std::unordered_map<std::string, std::vector<float>> expected_values;
+  auto state = CheckpointState();
+  for (const auto& [name, ort_value] : name_to_ort_value) {
+    CpuOrtValueToVec(ort_value, expected_values[name]);
+    state.module_checkpoint_state.named_parameters.insert(
+        {name, std::make_shared<Parameter>(name, ort_value, true /*is_trainable*/)});
+  }
+  state.has_external_data = true;
+
+  auto ckpt_test_root_dir = ORT_TSTR("checkpointing_api_test_dir");
+  TemporaryDirectory tmp_dir{ckpt_test_root_dir};
+  PathString checkpoint_path{
+      ConcatPathComponent(tmp_dir.Path(), ORT_TSTR("async_ckpt_save_cpu"))};
+
+  auto save_result = SaveCheckpointAsync(state, checkpoint_path, false);
+
+  // The checkpoint is written from a snapshot, so updating the parameters must not affect it.
+  for (auto& [name, param] : state.module_checkpoint_state.named_parameters) {
+    Tensor* tensor = param->Data().GetMutable<Tensor>();
+    std::fill_n(tensor->MutableData<float>(), tensor->Shape().Size(), 0.0f);
+  }
+
+  ASSERT_STATUS_OK(save_result.get());
+  ASSERT_TRUE(std::filesystem::exists(checkpoint_path));
+  ASSERT_TRUE(std::filesystem::exists(ExternalCheckpointDataPath(checkpoint_path)));
+
+  CheckpointState checkpoint_state_to_load;
+  ASSERT_STATUS_OK(LoadCheckpoint(checkpoint_path, checkpoint_state_to_load));
+  ASSERT_TRUE(checkpoint_state_to_load.has_external_data);
+
+  const auto& restored_params = checkpoint_state_to_load.module_checkpoint_state.named_parameters;
+  ASSERT_EQ(restored_params.size(), expected_values.size());
+  for (const auto& [name, expected] : expected_values) {
+    auto it = restored_params.find(name);
+    ASSERT_NE(it, restored_params.end());
+    ASSERT_TRUE(it->second->RequiresGrad());
+    std::vector<float> restored;
+    CpuOrtValueToVec(it->second->Data(), restored);
+    ASSERT_EQ(restored, expected);
+  }
+}
+
 }  // namespace onnxruntime::training::test
@@ -8,6 +8,7 @@
 
 #include "test/util/include/asserts.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "orttraining/training_api/utils.h"
 #include "orttraining/training_api/module.h"
 #include "orttraining/training_api/optimizer.h"
@@ -312,6 +313,68 @@ TEST(TrainingApiTest, ModuleTrainStep) {
   }
 }
 
+TEST(TrainingApiTest, ModuleContiguousParameters) {
+  auto model_uri = MODEL_FOLDER "training_model.onnx";
+
+  onnxruntime::training::api::CheckpointState state;
+  auto checkpoint_to_load_path = MODEL_FOLDER "checkpoint.ckpt";
+  ASSERT_STATUS_OK(onnxruntime::training::api::LoadCheckpoint(checkpoint_to_load_path, state));
+
+  onnxruntime::SessionOptions session_option;
+  ASSERT_STATUS_OK(session_option.config_options.AddConfigEntry(kOrtSessionOptionsConfigTrainingContiguousParameters,
+                                                                "1"));
+  std::unique_ptr<Environment> env;
+  ASSERT_STATUS_OK(Environment::Create(nullptr, env));
+  auto model_identifier = ModelIdentifiers(onnxruntime::ToUTF8String(model_uri),
+                                           std::nullopt,
+                                           std::nullopt);
+  auto model = std::make_unique<onnxruntime::training::api::Module>(model_identifier,
+                                                                    &state, session_option,
+                                                                    *env, std::vector<std::shared_ptr<IExecutionProvider>>());
+
+  const int64_t params_size = static_cast<int64_t>(model->GetParametersSize());
+  const OrtValue& contiguous_params = model->ContiguousParameters();
+  const OrtValue& contiguous_grads = model->ContiguousGradients();
+  ASSERT_TRUE(contiguous_params.IsAllocated());
+  ASSERT_TRUE(contiguous_grads.IsAllocated());
+  ASSERT_EQ(contiguous_params.Get<Tensor>().Shape().Size(), params_size);
+  ASSERT_EQ(contiguous_grads.Get<Tensor>().Shape().Size(), params_size);
+
+  // The contiguous buffer has the same layout as CopyParametersToBuffer, and the parameters are views into it.
+  OrtValue output_params;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), {params_size},
+                       onnxruntime::test::TestCPUExecutionProvider()->CreatePreferredAllocators()[0],
+                       output_params);
+  ASSERT_STATUS_OK(model->CopyParametersToBuffer(output_params));
+  const float* expected = output_params.Get<Tensor>().Data<float>();
+  const float* actual = contiguous_params.Get<Tensor>().Data<float>();
+  for (int64_t i = 0; i < params_size; i++) {
+    ASSERT_EQ(actual[i], expected[i]);
+  }
+
+  const float* params_begin = actual;
+  const float* grads_begin = contiguous_grads.Get<Tensor>().Data<float>();
+  for (auto& param : model->Parameters()) {
+    const float* param_data = param->Data().Get<Tensor>().Data<float>();
+    const float* grad_data = param->Gradient().Get<Tensor>().Data<float>();
+    ASSERT_TRUE(param_data >= params_begin && param_data < params_begin + params_size);
+    ASSERT_EQ(grad_data - grads_begin, param_data - params_begin);
+  }
+
+  // Gradients are accumulated in place into the contiguous buffer.
+  OrtValue input, target;
+  GenerateRandomInput(std::array<int64_t, 2>{2, 784}, input);
+  target = onnxruntime::test::CreateInputOrtValueOnCPU<int32_t>(
+      std::array<int64_t, 1>{2}, std::vector<int32_t>(2, 1));
+  std::vector<OrtValue> inputs{input, target};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(model->TrainStep(inputs, fetches));
+
+  auto fc2_weight = model->NamedParameters()["fc2.weight"];
+  ASSERT_EQ(fc2_weight->Gradient().Get<Tensor>().Data<float>() - grads_begin,
+            fc2_weight->Data().Get<Tensor>().Data<float>() - params_begin);
+}
+
 TEST(TrainingApiTest, OptimizerCreatedWithOptimizerCheckpointState) {
   std::vector<bool> run_cuda_list{false};
   // #ifdef USE_CUDA
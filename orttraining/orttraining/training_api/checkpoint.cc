@@ -3,6 +3,8 @@
 
 #include "orttraining/training_api/checkpoint.h"
 
+#include <cstring>
+
 #include "core/flatbuffers/checkpoint_version.h"
 #include "core/flatbuffers/schema/ort_training_checkpoint.fbs.h"
 #include "core/framework/framework_common.h"
@@ -18,19 +20,40 @@ PathString ExternalCheckpointDataPath(const PathString& checkpoint_path) {
 namespace {
 
 /**
- * @brief Helper method to read data from an external file.
- * @param external_data_stream Stream that data will be read from.
+ * @brief Helper method to read data from a memory mapped external data file.
+ * @param external_data Contents of the memory mapped external data file.
  * @param offset Offset in the external data file to begin reading from.
  * @param output_buffer Buffer to store the read data.
  * @return Status of the operation.
  */
-Status ReadFromExternalFileHelper(std::ifstream& external_data_stream,
-                                  uint64_t offset, gsl::span<uint8_t> output_buffer) {
-  external_data_stream.seekg(offset);
-  external_data_stream.read(reinterpret_cast<char*>(output_buffer.data()), output_buffer.size());
+Status ReadFromMappedExternalDataHelper(gsl::span<const uint8_t> external_data,
+                                        uint64_t offset, gsl::span<uint8_t> output_buffer) {
+  ORT_RETURN_IF(offset > external_data.size() || output_buffer.size() > external_data.size() - offset,
+                "Failed reading external checkpoint data. Requested ", output_buffer.size(), " bytes at offset ",
+                offset, " but the external data file only has ", external_data.size(), " bytes.");
 
-  const auto [err, msg] = GetErrnoInfo();
-  ORT_RETURN_IF(external_data_stream.fail(), "Failed reading external checkpoint data. ", msg, " errno:", errno);
+  std::memcpy(output_buffer.data(), external_data.data() + offset, output_buffer.size());
+
+  return Status::OK();
+}
+
+/**
+ * @brief Memory map the external data file of a checkpoint.
+ *
+ * Tensor data is copied straight from the page cache into the tensor buffers instead of being staged through
+ * a file stream, and pages of parameters that have already been loaded can be dropped by the OS.
+ *
+ * @param data_path Path to the external data file.
+ * @param mapped_data Memory mapping of the file. Must outlive any reader using external_data.
+ * @param external_data Contents of the mapped file represented as a span.
+ * @return Status of the operation.
+ */
+Status MapExternalDataFile(const PathString& data_path, Env::MappedMemoryPtr& mapped_data,
+                           gsl::span<const uint8_t>& external_data) {
+  size_t num_bytes = 0;
+  ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(data_path.c_str(), num_bytes));
+  ORT_RETURN_IF_ERROR(Env::Default().MapFileIntoMemory(data_path.c_str(), 0, num_bytes, mapped_data));
+  external_data = gsl::make_span(reinterpret_cast<const uint8_t*>(mapped_data.get()), num_bytes);
 
   return Status::OK();
 }
@@ -75,6 +98,15 @@ Status WriteToExternalFileHelper(std::ofstream& external_data_stream,
   return Status::OK();
 }
 
+/**
+ * @brief Get the cpu allocator used for tensors owned by the checkpoint state.
+ */
+AllocatorPtr CpuAllocator() {
+  static CPUExecutionProviderInfo info;
+  static CPUExecutionProvider cpu_provider(info);
+  return cpu_provider.CreatePreferredAllocators()[0];
+}
+
 /**
  * @brief Sort keys of a hash map.
  * @param hash_map Hash map to sort.
@@ -144,9 +176,7 @@ Status OrtValueFromFlatbufferTensor(const fbs::Tensor& fbs_tensor,
   // The assumption is that the flatbuffer buffer will be destructed once the checkpoint has been loaded.
   // And so, we must allocate a buffer where the tensor data can be copied using the cpu allocator.
   // This buffer is owned by the OrtValue.
-  static CPUExecutionProviderInfo info;
-  static CPUExecutionProvider cpu_provider(info);
-  AllocatorPtr cpu_allocator = cpu_provider.CreatePreferredAllocators()[0];
+  AllocatorPtr cpu_allocator = CpuAllocator();
 
   std::unique_ptr<Tensor> ort_tensor = std::make_unique<Tensor>();
   ORT_RETURN_IF_ERROR(fbs::utils::LoadOrtTensorOrtFormat(fbs_tensor, cpu_allocator, tensor_name, *ort_tensor, external_data_reader));
@@ -438,11 +468,13 @@ Status FromModuleState(const ModuleCheckpointState& module_state,
  *                        and second order momentums ...).
  * @param builder Flatbuffer builder.
  * @param fbs_optimizer_groups Flatbuffer optimizer groups to be populated.
+ * @param external_data_writer Optional delegate to write tensor data to an external file.
  * @return Status of the operation.
  */
 Status FromOptimizerState(const OptimizerCheckpointState& optimizer_state,
                           flatbuffers::FlatBufferBuilder& builder,
-                          std::vector<flatbuffers::Offset<fbs::OptimizerGroup>>& fbs_optimizer_groups) {
+                          std::vector<flatbuffers::Offset<fbs::OptimizerGroup>>& fbs_optimizer_groups,
+                          fbs::utils::ExternalDataWriter external_data_writer = nullptr) {
   if (optimizer_state.group_named_optimizer_states.empty()) {
     return Status::OK();
   }
@@ -462,7 +494,7 @@ Status FromOptimizerState(const OptimizerCheckpointState& optimizer_state,
       ORT_RETURN_IF_ERROR(FlatbufferTensorsFromOrtValues(
           param_optimizer_state,
           optimizer_state.optimizer_session_data_transfer_mgr,
-          builder, momentums));
+          builder, momentums, external_data_writer));
 
       const auto fbs_param_name = builder.CreateString(param_name);
       const auto fbs_momentums = builder.CreateVector(momentums);
@@ -546,6 +578,104 @@ Status FromPropertyBag(const PropertyBag& property_bag, flatbuffers::FlatBufferB
   return Status::OK();
 }
 
+/**
+ * @brief Compute the number of bytes of tensor data that a checkpoint state will save.
+ *
+ * @param state parameter/optimizer and other user defined training states.
+ * @param include_optimizer_state Whether to include optimizer state in the computation.
+ * @return Size of the tensor data in bytes.
+ */
+size_t CheckpointTensorDataSize(const CheckpointState& state, const bool include_optimizer_state) {
+  size_t num_bytes = 0U;
+  for (const auto& [name, param] : state.module_checkpoint_state.named_parameters) {
+    num_bytes += param->Data().Get<Tensor>().SizeInBytes();
+  }
+
+  if (include_optimizer_state) {
+    for (const auto& [group_name, group_optimizer_state] :
+         state.optimizer_checkpoint_state.group_named_optimizer_states) {
+      for (const auto& [param_name, param_optimizer_state] : group_optimizer_state->param_named_optimizer_states) {
+        for (const auto& [momentum_name, momentum] : param_optimizer_state) {
+          num_bytes += momentum.Get<Tensor>().SizeInBytes();
+        }
+      }
+    }
+  }
+
+  return num_bytes;
+}
+
+/**
+ * @brief Copy an OrtValue tensor to a new OrtValue tensor in cpu memory.
+ *
+ * @param src OrtValue to copy.
+ * @param data_transfer_manager Data transfer manager used to copy tensors that do not live in cpu memory.
+ * @param dst OrtValue to be populated with the cpu copy.
+ * @return Status of the operation.
+ */
+Status CopyToCpuOrtValue(const OrtValue& src, const DataTransferManager* data_transfer_manager, OrtValue& dst) {
+  ORT_RETURN_IF_NOT(src.IsTensor(), "Only tensor OrtValues can be saved to a checkpoint.");
+  const Tensor& src_tensor = src.Get<Tensor>();
+  ORT_RETURN_IF(src_tensor.IsDataTypeString(), "String tensors cannot be saved asynchronously to a checkpoint.");
+
+  Tensor::InitOrtValue(src_tensor.DataType(), src_tensor.Shape(), CpuAllocator(), dst);
+  Tensor& dst_tensor = *dst.GetMutable<Tensor>();
+  if (src_tensor.Location().device.Type() == OrtDevice::CPU) {
+    std::memcpy(dst_tensor.MutableDataRaw(), src_tensor.DataRaw(), src_tensor.SizeInBytes());
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_NOT(data_transfer_manager,
+                    "Cannot save OrtValue to a checkpoint. Expected: A valid data transfer manager. ",
+                    "Actual: nullptr.");
+  return data_transfer_manager->CopyTensor(src_tensor, dst_tensor);
+}
+
+/**
+ * @brief Take a cpu snapshot of a checkpoint state that can be saved while training continues.
+ *
+ * @param state parameter/optimizer and other user defined training states.
+ * @param include_optimizer_state Whether to include optimizer state in the snapshot.
+ * @param snapshot Checkpoint state to be populated with cpu copies of all the tensors.
+ * @return Status of the operation.
+ */
+Status SnapshotCheckpointState(const CheckpointState& state, const bool include_optimizer_state,
+                               CheckpointState& snapshot) {
+  const auto& module_state = state.module_checkpoint_state;
+  snapshot.module_checkpoint_state.is_nominal_state = module_state.is_nominal_state;
+  snapshot.module_checkpoint_state.train_session_data_transfer_mgr = nullptr;
+  for (const auto& [name, param] : module_state.named_parameters) {
+    OrtValue cpu_value;
+    ORT_RETURN_IF_ERROR(CopyToCpuOrtValue(param->Data(), module_state.train_session_data_transfer_mgr, cpu_value));
+    snapshot.module_checkpoint_state.named_parameters.insert(
+        {name, std::make_shared<Parameter>(name, cpu_value, param->RequiresGrad())});
+  }
+
+  snapshot.optimizer_checkpoint_state.optimizer_session_data_transfer_mgr = nullptr;
+  if (include_optimizer_state) {
+    const auto& optimizer_state = state.optimizer_checkpoint_state;
+    for (const auto& [group_name, group_optimizer_state] : optimizer_state.group_named_optimizer_states) {
+      auto group_snapshot = std::make_shared<GroupOptimizerState>();
+      group_snapshot->step = group_optimizer_state->step;
+      group_snapshot->initial_lr = group_optimizer_state->initial_lr;
+      group_snapshot->learning_rate = group_optimizer_state->learning_rate;
+      for (const auto& [param_name, param_optimizer_state] : group_optimizer_state->param_named_optimizer_states) {
+        auto& param_snapshot = group_snapshot->param_named_optimizer_states[param_name];
+        for (const auto& [momentum_name, momentum] : param_optimizer_state) {
+          ORT_RETURN_IF_ERROR(CopyToCpuOrtValue(momentum, optimizer_state.optimizer_session_data_transfer_mgr,
+                                                param_snapshot[momentum_name]));
+        }
+      }
+      snapshot.optimizer_checkpoint_state.group_named_optimizer_states.insert({group_name, group_snapshot});
+    }
+  }
+
+  snapshot.property_bag = state.property_bag;
+  snapshot.has_external_data = state.has_external_data;
+
+  return Status::OK();
+}
+
 /**
  * @brief Save from a checkpoint state to a checkpoint file.
  *
@@ -556,11 +686,18 @@ Status FromPropertyBag(const PropertyBag& property_bag, flatbuffers::FlatBufferB
  */
 Status FromCheckpointState(
     const CheckpointState& state, const PathString& checkpoint_path, const bool include_optimizer_state) {
+  // Large checkpoints stream the tensor data to the external data file one tensor at a time, so the flatbuffer
+  // only holds the metadata and the complete checkpoint is never materialized in memory.
+  const bool use_external_data =
+      !state.module_checkpoint_state.named_parameters.empty() &&
+      (state.has_external_data ||
+       CheckpointTensorDataSize(state, include_optimizer_state) >= kDefaultExternalDataThreshold);
+
   flatbuffers::FlatBufferBuilder builder(1024);
 
   fbs::utils::ExternalDataWriter external_data_writer = nullptr;
   std::optional<std::ofstream> external_data_stream;
-  if (state.has_external_data) {
+  if (use_external_data) {
     auto data_path = ExternalCheckpointDataPath(checkpoint_path);
     external_data_stream = std::ofstream(data_path, std::ios::binary);
 
@@ -581,7 +718,13 @@ Status FromCheckpointState(
   // Write optimizer state tensors files.
   std::vector<flatbuffers::Offset<fbs::OptimizerGroup>> optimizer_groups;
   if (include_optimizer_state) {
-    ORT_RETURN_IF_ERROR(FromOptimizerState(state.optimizer_checkpoint_state, builder, optimizer_groups));
+    ORT_RETURN_IF_ERROR(FromOptimizerState(state.optimizer_checkpoint_state, builder, optimizer_groups,
+                                           external_data_writer));
+  }
+
+  if (external_data_stream) {
+    external_data_stream->close();
+    ORT_RETURN_IF(external_data_stream->fail(), "Failed writing external checkpoint data.");
   }
 
   flatbuffers::Offset<fbs::PropertyBag> property_bag;
@@ -806,16 +949,15 @@ Status ToModelProto(gsl::span<const uint8_t> checkpoint_bytes,
                 "Expected: Complete checkpoint. Actual: Nominal checkpoint.");
 
   fbs::utils::ExternalDataReader external_data_reader = nullptr;
-  std::optional<std::ifstream> external_data_stream;
+  Env::MappedMemoryPtr mapped_external_data;
+  gsl::span<const uint8_t> external_data;
 
   if (module_state->has_external_data()) {
     auto data_path = ExternalCheckpointDataPath(checkpoint_path);
-    external_data_stream = std::ifstream(data_path, std::ios::binary);
-    ORT_RETURN_IF(external_data_stream->fail(),
-                  "Failed to open checkpoint's external data file: ", ToUTF8String(data_path));
+    ORT_RETURN_IF_ERROR(MapExternalDataFile(data_path, mapped_external_data, external_data));
 
-    external_data_reader = [&external_data_stream](uint64_t offset, gsl::span<uint8_t> output_buffer) {
-      return ReadFromExternalFileHelper(external_data_stream.value(), offset, output_buffer);
+    external_data_reader = [&external_data](uint64_t offset, gsl::span<uint8_t> output_buffer) {
+      return ReadFromMappedExternalDataHelper(external_data, offset, output_buffer);
     };
   }
 
@@ -876,7 +1018,8 @@ Status ToCheckpointState(gsl::span<const uint8_t> checkpoint_bytes, CheckpointSt
   const auto* fbs_module_state = fbs_checkpoint->module_state();
 
   fbs::utils::ExternalDataReader external_data_reader = nullptr;
-  std::optional<std::ifstream> external_data_stream;
+  Env::MappedMemoryPtr mapped_external_data;
+  gsl::span<const uint8_t> external_data;
 
   state.has_external_data = false;
   if (nullptr != fbs_module_state && fbs_module_state->has_external_data()) {
@@ -884,17 +1027,15 @@ Status ToCheckpointState(gsl::span<const uint8_t> checkpoint_bytes, CheckpointSt
     ORT_RETURN_IF_NOT(checkpoint_path.has_value(),
                       "External data is present in the checkpoint but the checkpoint path is not provided. External data with loading from buffer is not supported yet.");
     auto data_path = ExternalCheckpointDataPath(*checkpoint_path);
-    external_data_stream = std::ifstream(data_path, std::ios::binary);
-
-    if (external_data_stream.value().fail()) {
-      const auto [err, errmsg] = GetErrnoInfo();
+    const auto status = MapExternalDataFile(data_path, mapped_external_data, external_data);
+    if (!status.IsOK()) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
                              "Failed to open checkpoint's external data file: ", ToUTF8String(data_path),
-                             " error:", errmsg, " errno:", err);
+                             " error:", status.ErrorMessage());
     }
 
-    external_data_reader = [&external_data_stream](uint64_t offset, gsl::span<uint8_t> output_buffer) {
-      return ReadFromExternalFileHelper(external_data_stream.value(), offset, output_buffer);
+    external_data_reader = [&external_data](uint64_t offset, gsl::span<uint8_t> output_buffer) {
+      return ReadFromMappedExternalDataHelper(external_data, offset, output_buffer);
     };
   }
 
@@ -954,6 +1095,29 @@ Status SaveCheckpoint(const CheckpointState& states, const PathString& checkpoin
   return save::FromCheckpointState(states, checkpoint_path, include_optimizer_state);
 }
 
+std::future<Status> SaveCheckpointAsync(const CheckpointState& state, const PathString& checkpoint_path,
+                                        const bool include_optimizer_state) {
+  if (!FLATBUFFERS_LITTLEENDIAN) {
+    std::promise<Status> result;
+    result.set_value(ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                                     "ORT training checkpoint format only supports little-endian machines"));
+    return result.get_future();
+  }
+
+  // The snapshot is taken on the calling thread so that training can safely update the states as soon as this
+  // function returns. Only the serialization and file I/O happen in the background.
+  auto snapshot = std::make_shared<CheckpointState>();
+  if (const auto status = save::SnapshotCheckpointState(state, include_optimizer_state, *snapshot); !status.IsOK()) {
+    std::promise<Status> result;
+    result.set_value(status);
+    return result.get_future();
+  }
+
+  return std::async(std::launch::async, [snapshot, checkpoint_path, include_optimizer_state]() {
+    return save::FromCheckpointState(*snapshot, checkpoint_path, include_optimizer_state);
+  });
+}
+
 Status LoadCheckpoint(const PathString& checkpoint_path, CheckpointState& checkpoint_states) {
   ORT_RETURN_IF_NOT(FLATBUFFERS_LITTLEENDIAN, "ORT training checkpoint format only supports little-endian machines");
 
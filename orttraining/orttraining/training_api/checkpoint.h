@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <future>
+
 #include "core/platform/path_lib.h"
 #include "orttraining/training_api/checkpoint_property.h"
 #include "orttraining/training_api/module.h"
@@ -20,6 +22,8 @@
  *
  * The checkpoint file is a single flatbuffer file containing all the states highlighted above.
  * The flatbuffer schema is defined in onnxruntime/core/flatbuffers/schema/ort_training_checkpoint.fbs
+ * For large checkpoints, the tensor data is streamed to an external data file next to the checkpoint file
+ * (see ExternalCheckpointDataPath) and memory mapped when the checkpoint is loaded.
  *
  */
 
@@ -40,6 +44,13 @@ struct CheckpointState {
  */
 PathString ExternalCheckpointDataPath(const PathString& checkpoint_path);
 
+/**
+ * @brief Size of the checkpoint tensor data in bytes beyond which the tensor data is streamed to an external data
+ *        file. Defaults to 1.8GB to avoid creating a checkpoint file that is >2GB (which would fail due to the usage
+ *        of 32-bit offsets).
+ */
+constexpr size_t kDefaultExternalDataThreshold = 1800 * 1024 * 1024;
+
 /**
  * @brief Save training states as ORT checkpoint.
  *
@@ -50,6 +61,20 @@ PathString ExternalCheckpointDataPath(const PathString& checkpoint_path);
 Status SaveCheckpoint(const CheckpointState& state, const PathString& checkpoint_path,
                       const bool include_optimizer_state);
 
+/**
+ * @brief Save training states as ORT checkpoint in the background.
+ *
+ * A cpu snapshot of the training states is taken before returning, so the caller may keep updating the states
+ * (for example run the next training step) while the snapshot is being written to the checkpoint file.
+ *
+ * @param state parameter/optimizer and other user defined training states.
+ * @param checkpoint_path file where checkpoint is saved.
+ * @param include_optimizer_state Whether to include optimizer state in the checkpoint.
+ * @return Future holding the status of the save once the checkpoint file has been written.
+ */
+std::future<Status> SaveCheckpointAsync(const CheckpointState& state, const PathString& checkpoint_path,
+                                        const bool include_optimizer_state);
+
 #if !defined(ORT_MINIMAL_BUILD)
 /**
  * @brief Save ONNX initializers as ORT checkpoint.
@@ -69,7 +94,7 @@ Status SaveCheckpoint(const CheckpointState& state, const PathString& checkpoint
 Status SaveCheckpoint(gsl::span<const ONNX_NAMESPACE::TensorProto> trainable_tensor_protos,
                       gsl::span<const ONNX_NAMESPACE::TensorProto> non_trainable_tensor_protos,
                       const PathString& checkpoint_path, const bool nominal_checkpoint,
-                      const size_t external_data_threshold = 1800 * 1024 * 1024);  // 1.8GB default
+                      const size_t external_data_threshold = kDefaultExternalDataThreshold);
 #endif
 
 /**
@@ -188,6 +188,37 @@ Status LoadParameter(const std::string& param_name, const Tensor& src_weight_ten
   return Status::OK();
 }
 
+// Allocate one buffer for all the given tensor values and replace each value with a view into it, keeping the data.
+// The views hold a reference to the buffer, so it stays alive as long as any parameter still points into it.
+Status MoveToContiguousBuffer(gsl::span<OrtValue* const> values, const AllocatorPtr& allocator,
+                              const DataTransferManager& data_transfer_manager, OrtValue& buffer) {
+  const auto element_type = values.front()->Get<Tensor>().DataType();
+  SafeInt<int64_t> total_elements = 0;
+  for (const OrtValue* value : values) {
+    total_elements += value->Get<Tensor>().Shape().Size();
+  }
+
+  Tensor::InitOrtValue(element_type, TensorShape({static_cast<int64_t>(total_elements)}), allocator, buffer);
+  auto* buffer_tensor = buffer.GetMutable<Tensor>();
+  auto* buffer_data = static_cast<char*>(buffer_tensor->MutableDataRaw());
+
+  auto ml_tensor_type = DataTypeImpl::GetType<Tensor>();
+  size_t offset = 0;
+  for (OrtValue* value : values) {
+    const Tensor& src_tensor = value->Get<Tensor>();
+    auto view = std::make_unique<Tensor>(element_type, src_tensor.Shape(), buffer_data + offset,
+                                         buffer_tensor->Location());
+    ORT_RETURN_IF_ERROR(data_transfer_manager.CopyTensor(src_tensor, *view));
+    offset += src_tensor.SizeInBytes();
+
+    OrtValue view_value;
+    view_value.Init(view.release(), ml_tensor_type, [buffer](void* p) { delete static_cast<Tensor*>(p); });
+    *value = std::move(view_value);
+  }
+
+  return Status::OK();
+}
+
 }  // namespace
 
 Status Parameter::CopyTo(const DataTransferManager* data_transfer_manager, OrtValue& data) const {
@@ -366,6 +397,12 @@ Module::Module(const ModelIdentifiers& model_identifiers,
     }
   }
 
+  use_contiguous_parameters_ =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigTrainingContiguousParameters, "0") == "1";
+  if (use_contiguous_parameters_ && !state_->module_checkpoint_state.is_nominal_state) {
+    ORT_THROW_IF_ERROR(LayOutParametersContiguously());
+  }
+
   if (model_identifiers.IsEvalModelAvailable()) {
     eval_sess_ = std::make_unique<onnxruntime::InferenceSession>(session_options, env);
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_MINIMAL_BUILD_CUSTOM_OPS)
@@ -607,6 +644,66 @@ Status Module::CopyBufferToParameters(OrtValue& parameters_buffer, const bool tr
   if (state_->module_checkpoint_state.is_nominal_state) {
     // Once the parameters are loaded, the state is no longer a nominal state.
     state_->module_checkpoint_state.is_nominal_state = false;
+
+    if (use_contiguous_parameters_) {
+      ORT_RETURN_IF_ERROR(LayOutParametersContiguously());
+    }
+  }
+
+  return Status::OK();
+}
+
+Status Module::LayOutParametersContiguously() {
+  InlinedVector<std::shared_ptr<Parameter>> trainable_params;
+  for (const auto& param_name : train_input_names_.WeightsInputNames()) {
+    const auto& param = state_->module_checkpoint_state.named_parameters.at(param_name);
+    if (param->RequiresGrad()) {
+      trainable_params.push_back(param);
+    }
+  }
+
+  if (trainable_params.empty()) {
+    return Status::OK();
+  }
+
+  const Tensor& first_weight = trainable_params.front()->Data().Get<Tensor>();
+  const OrtDevice device = first_weight.Location().device;
+  for (const auto& param : trainable_params) {
+    const Tensor& weight = param->Data().Get<Tensor>();
+    const Tensor& gradient = param->Gradient().Get<Tensor>();
+    if (weight.DataType() != first_weight.DataType() || gradient.DataType() != first_weight.DataType() ||
+        weight.Location().device != device || gradient.Location().device != device) {
+      LOGS_DEFAULT(WARNING) << "Trainable parameters have different element types or devices, "
+                            << "keeping them in separate buffers. Parameter: " << param->Name();
+      return Status::OK();
+    }
+  }
+
+  auto& session_state = train_sess_->GetSessionState();
+  auto allocator = session_state.GetAllocator(device);
+  ORT_RETURN_IF_NOT(allocator != nullptr, "No allocator found for device ", device.ToString());
+
+  InlinedVector<OrtValue*> weight_values, gradient_values;
+  weight_values.reserve(trainable_params.size());
+  gradient_values.reserve(trainable_params.size());
+  for (const auto& param : trainable_params) {
+    weight_values.push_back(&param->Data());
+    gradient_values.push_back(&param->gradient_);
+  }
+
+  const DataTransferManager& data_transfer_manager = train_sess_->GetDataTransferManager();
+  ORT_RETURN_IF_ERROR(MoveToContiguousBuffer(weight_values, allocator, data_transfer_manager, contiguous_parameters_));
+  ORT_RETURN_IF_ERROR(MoveToContiguousBuffer(gradient_values, allocator, data_transfer_manager, contiguous_gradients_));
+
+  // The session feeds still point at the old buffers, refresh them.
+  const auto param_to_grad_index = BuildParameterToGradInputIndexMap(train_input_names_.GradientInputNames());
+  const auto weight_names = train_input_names_.WeightsInputNames();
+  for (size_t i = 0; i < weight_names.size(); ++i) {
+    const auto& param = state_->module_checkpoint_state.named_parameters.at(weight_names[i]);
+    weights_[i] = param->Data();
+    if (param->RequiresGrad()) {
+      gradients_[param_to_grad_index.at(weight_names[i])] = param->Gradient();
+    }
   }
 
   return Status::OK();
@@ -137,6 +137,12 @@ struct Module {
   // state will no longer be nominal after the successful completion of this function.
   Status CopyBufferToParameters(OrtValue& parameters_buffer, const bool trainable_only = true);
 
+  // Return the contiguous buffers holding all trainable parameters and all their gradients, in the order of the
+  // training model inputs. The OrtValues are not allocated unless "training.contiguous_parameters" is enabled
+  // and the parameters could be laid out contiguously.
+  const OrtValue& ContiguousParameters() const noexcept { return contiguous_parameters_; }
+  const OrtValue& ContiguousGradients() const noexcept { return contiguous_gradients_; }
+
 #if !defined(ORT_MINIMAL_BUILD)
   // Load the eval model from eval_model_path_or_bytes and transform it for the purpose of
   // inferencing, and serialize to given path.
@@ -194,6 +200,13 @@ struct Module {
   InlinedVector<OrtValue> weights_;
   InlinedVector<OrtValue> gradients_;
 
+  // Move the trainable parameters and their gradients into contiguous_parameters_/contiguous_gradients_.
+  Status LayOutParametersContiguously();
+
+  OrtValue contiguous_parameters_;
+  OrtValue contiguous_gradients_;
+  bool use_contiguous_parameters_ = false;
+
   CheckpointState* state_;  // Non owning pointer to the state.
 
   bool accumulate_gradient_ = false;
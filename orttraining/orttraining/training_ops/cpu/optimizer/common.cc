@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <vector>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/TensorSeq.h"
@@ -10,6 +13,30 @@
 namespace onnxruntime {
 namespace contrib {
 
+void MultiTensorApply(concurrency::ThreadPool* tp, gsl::span<const int> tensor_sizes, const TensorOpCost& cost,
+                      const std::function<void(size_t, std::ptrdiff_t, std::ptrdiff_t)>& fn) {
+  // offsets[i] is the flat index of the first element of tensor i, offsets.back() is the total element count.
+  std::vector<std::ptrdiff_t> offsets(tensor_sizes.size() + 1, 0);
+  for (size_t i = 0; i < tensor_sizes.size(); ++i) {
+    offsets[i + 1] = offsets[i] + tensor_sizes[i];
+  }
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, offsets.back(), cost, [&offsets, &fn](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        // Find the tensor holding the first element of the range, then walk the following tensors.
+        size_t tensor_index = static_cast<size_t>(
+            std::upper_bound(offsets.begin(), offsets.end(), begin) - offsets.begin() - 1);
+        while (begin < end) {
+          const std::ptrdiff_t tensor_end = std::min(end, offsets[tensor_index + 1]);
+          if (tensor_end > begin) {
+            fn(tensor_index, begin - offsets[tensor_index], tensor_end - begin);
+          }
+          begin = tensor_end;
+          ++tensor_index;
+        }
+      });
+}
+
 Status CopyIfNotSameCPUBuffer(OpKernelContext* ctx, size_t number_of_values,
                               const TensorSeq* src_values, TensorSeq* dest_values) {
   if (src_values != dest_values) {
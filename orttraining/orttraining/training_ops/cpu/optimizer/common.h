@@ -5,7 +5,9 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
 #include <cmath>
+#include <functional>
 
 namespace onnxruntime {
 namespace contrib {
@@ -19,6 +21,22 @@ TC compute_bias_correction_coefficient(const TC momentum_update_coefficient, con
   }
 }
 
+/**
+ * @brief Apply an element-wise update to a group of tensors in one thread-parallel pass.
+ *
+ * The elements of all tensors are viewed as one flat buffer, which is partitioned by the thread pool regardless of
+ * the tensor boundaries. So a model with thousands of small parameters pays for one parallel dispatch instead of one
+ * per parameter, while a large parameter is still split across threads.
+ *
+ * @param tp Thread pool to run on, nullptr runs sequentially.
+ * @param tensor_sizes Element count of each tensor in the group.
+ * @param cost Cost to update one element.
+ * @param fn Functor called with (tensor index, first element index in the tensor, element count), the element range
+ * never crosses a tensor boundary.
+ */
+void MultiTensorApply(concurrency::ThreadPool* tp, gsl::span<const int> tensor_sizes, const TensorOpCost& cost,
+                      const std::function<void(size_t, std::ptrdiff_t, std::ptrdiff_t)>& fn);
+
 Status CopyIfNotSameCPUBuffer(OpKernelContext* ctx, size_t number_of_values, const TensorSeq* src_values,
                               TensorSeq* dest_values);
 